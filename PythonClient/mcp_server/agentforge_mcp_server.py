@@ -4,13 +4,22 @@ UEAgentForge MCP Server.
 Exposes curated UEAgentForge tools over the standard Model Context Protocol so
 Claude Desktop, Cursor, Windsurf, and other MCP clients can drive the Unreal
 Editor through the existing Remote Control HTTP bridge.
+
+Tool calls run concurrently. Each tool body runs on a worker thread and shares
+one PipelinedAgentForgeClient: independent queries from parallel tool calls
+are pipelined over keep-alive connections (or the socket transport) and merged
+into execute_batch, while edits keep the order in which they were issued.
+UEAGENTFORGE_PIPELINE=0 restores the plain one-request-at-a-time client.
 """
 
 from __future__ import annotations
 
+import asyncio
+import functools
 import json
 import os
 import sys
+import threading
 from pathlib import Path
 from typing import Any, Dict, List, Optional
 
@@ -27,6 +36,7 @@ if str(PYTHON_CLIENT_DIR) not in sys.path:
     sys.path.insert(0, str(PYTHON_CLIENT_DIR))
 
 from ueagentforge_client import AgentForgeClient, ForgeResult  # noqa: E402
+from ueagentforge_async_client import PipelinedAgentForgeClient  # noqa: E402
 
 
 SERVER_NAME = "UEAgentForge"
@@ -34,23 +44,52 @@ SERVER_VERSION = "0.5.0"
 DEFAULT_HOST = os.environ.get("UEAGENTFORGE_HOST", "127.0.0.1")
 DEFAULT_PORT = int(os.environ.get("UEAGENTFORGE_PORT", "30010"))
 DEFAULT_TIMEOUT = float(os.environ.get("UEAGENTFORGE_TIMEOUT", "60"))
+PIPELINE = os.environ.get("UEAGENTFORGE_PIPELINE", "1") != "0"
+TRANSPORT = os.environ.get("UEAGENTFORGE_TRANSPORT", "http")
+WS_PORT = int(os.environ.get("UEAGENTFORGE_WS_PORT", "30020"))
+CONNECTIONS = int(os.environ.get("UEAGENTFORGE_CONNECTIONS", "4"))
 
 mcp = FastMCP("UEAgentForge MCP Server", json_response=True)
 _client: Optional[AgentForgeClient] = None
+_client_lock = threading.Lock()
 
 
 def get_client() -> AgentForgeClient:
     global _client
-    if _client is None:
-        _client = AgentForgeClient(
-            host=DEFAULT_HOST,
-            port=DEFAULT_PORT,
-            timeout=DEFAULT_TIMEOUT,
-            verify=True,
-            max_retries=6,
-            retry_backoff_sec=1.0,
-        )
-    return _client
+    with _client_lock:
+        if _client is None:
+            if PIPELINE:
+                _client = PipelinedAgentForgeClient(
+                    host=DEFAULT_HOST,
+                    port=DEFAULT_PORT,
+                    timeout=DEFAULT_TIMEOUT,
+                    verify=True,
+                    max_retries=6,
+                    retry_backoff_sec=1.0,
+                    transport=TRANSPORT,
+                    ws_port=WS_PORT,
+                    connections=CONNECTIONS,
+                )
+            else:
+                _client = AgentForgeClient(
+                    host=DEFAULT_HOST,
+                    port=DEFAULT_PORT,
+                    timeout=DEFAULT_TIMEOUT,
+                    verify=True,
+                    max_retries=6,
+                    retry_backoff_sec=1.0,
+                )
+        return _client
+
+
+def tool():
+    """mcp.tool() for a blocking tool body: it runs on a worker thread so tool calls overlap."""
+    def register(fn):
+        @functools.wraps(fn)
+        async def run(*args: Any, **kwargs: Any) -> Any:
+            return await asyncio.to_thread(fn, *args, **kwargs)
+        return mcp.tool()(run)
+    return register
 
 
 def _payload(result: Any) -> Dict[str, Any]:
@@ -95,58 +134,119 @@ def build_room_prompt(theme: str = "horror", scale: str = "medium") -> str:
     )
 
 
-@mcp.tool()
+@tool()
 def ping() -> Dict[str, Any]:
     """Check that UEAgentForge is reachable before issuing any scene-editing tools."""
     return _stringify_result(get_client().ping())
 
 
-@mcp.tool()
+@tool()
+def list_commands(category: str = "") -> Dict[str, Any]:
+    """List every UEAgentForge bridge command with its argument schema, category, and verification routing. Optionally filter by category such as operators, spatial, or presets."""
+    return _stringify_result(get_client().list_commands(category=category))
+
+
+@tool()
+def execute_batch(
+    commands: List[Dict[str, Any]],
+    transactional: bool = True,
+    stop_on_error: bool = True,
+    verify: bool = True,
+) -> Dict[str, Any]:
+    """Run many {cmd, args} commands in one request, one undo transaction, and one verification pass. Prefer this over many single calls when building blockouts; a failing entry rolls back the whole transactional batch."""
+    return _stringify_result(get_client().execute_batch(
+        commands,
+        transactional=transactional,
+        stop_on_error=stop_on_error,
+        verify=verify,
+    ))
+
+
+@tool()
+def get_job_status(job_id: str = "", include_partial: bool = True) -> Dict[str, Any]:
+    """Poll an async job (commands sent with async=true return a job_id): state, stage, percent_complete, partial_results and the final result once finished. Omit job_id to list all jobs."""
+    return _stringify_result(get_client().get_job_status(job_id, include_partial=include_partial))
+
+
+@tool()
+def cancel_job(job_id: str) -> Dict[str, Any]:
+    """Cancel a queued or running async job; work it has done inside its undo transaction is rolled back."""
+    return _stringify_result(get_client().cancel_job(job_id))
+
+
+@tool()
 def get_current_level() -> Dict[str, Any]:
     """Return the currently loaded Unreal level package path and actor prefix for object lookups."""
     return _stringify_result(get_client().get_current_level())
 
 
-@mcp.tool()
-def get_all_level_actors() -> Dict[str, Any]:
-    """List current level actors with labels, classes, paths, transforms, and bounds for scene inspection."""
-    return {"actors": get_client().get_all_level_actors()}
-
-
-@mcp.tool()
+@tool()
+def get_all_level_actors(
+    fields: Optional[List[str]] = None,
+    class_name: str = "",
+    tag: str = "",
+    limit: int = 0,
+    cursor: str = "",
+) -> Dict[str, Any]:
+    """List current level actors with labels, classes, paths and transforms. Pass fields (e.g. ["label","location"]) and limit on large levels; follow next_cursor for more pages."""
+    args: Dict[str, Any] = {}
+    if fields:
+        args["fields"] = fields
+    if class_name:
+        args["class"] = class_name
+    if tag:
+        args["tag"] = tag
+    if limit > 0:
+        args["limit"] = limit
+    if cursor:
+        args["cursor"] = cursor
+    return _stringify_result(get_client().execute("get_all_level_actors", args).raw)
+
+
+@tool()
 def get_available_meshes(
     search_filter: str = "",
     path_filter: str = "",
     max_results: int = 50,
+    prefix: str = "",
+    tag: str = "",
 ) -> Dict[str, Any]:
     """Search the Content Browser for static meshes. Call this before placing geometry so you use real project assets instead of guessing mesh paths."""
     return _stringify_result(get_client().get_available_meshes(
         search_filter=search_filter,
         path_filter=path_filter,
         max_results=max_results,
+        prefix=prefix,
+        tag=tag,
     ))
 
 
-@mcp.tool()
+@tool()
 def get_available_materials(
     search_filter: str = "",
     path_filter: str = "",
     max_results: int = 50,
+    prefix: str = "",
+    tag: str = "",
 ) -> Dict[str, Any]:
     """Search the Content Browser for materials and material instances. Use this before applying materials so the tool call references valid assets."""
     return _stringify_result(get_client().get_available_materials(
         search_filter=search_filter,
         path_filter=path_filter,
         max_results=max_results,
+        prefix=prefix,
+        tag=tag,
     ))
 
 
-@mcp.tool()
+@tool()
 def get_available_blueprints(
     search_filter: str = "",
     parent_class: str = "",
     path_filter: str = "",
     max_results: int = 50,
+    prefix: str = "",
+    tag: str = "",
 ) -> Dict[str, Any]:
     """Search Blueprint assets, optionally filtered by parent class like Actor, Character, or AIController. Use this before trying to spawn project Blueprints so you reference real generated classes instead of guessing paths."""
     return _stringify_result(get_client().get_available_blueprints(
@@ -154,44 +254,54 @@ def get_available_blueprints(
         parent_class=parent_class,
         path_filter=path_filter,
         max_results=max_results,
+        prefix=prefix,
+        tag=tag,
     ))
 
 
-@mcp.tool()
+@tool()
 def get_available_textures(
     search_filter: str = "",
     path_filter: str = "",
     max_results: int = 50,
+    prefix: str = "",
+    tag: str = "",
 ) -> Dict[str, Any]:
     """Search texture assets for material authoring and surface replacement workflows."""
     return _stringify_result(get_client().get_available_textures(
         search_filter=search_filter,
         path_filter=path_filter,
         max_results=max_results,
+        prefix=prefix,
+        tag=tag,
     ))
 
 
-@mcp.tool()
+@tool()
 def get_available_sounds(
     search_filter: str = "",
     path_filter: str = "",
     max_results: int = 50,
+    prefix: str = "",
+    tag: str = "",
 ) -> Dict[str, Any]:
     """Search SoundWave and SoundCue assets so ambience and audio placement use valid project content."""
     return _stringify_result(get_client().get_available_sounds(
         search_filter=search_filter,
         path_filter=path_filter,
         max_results=max_results,
+        prefix=prefix,
+        tag=tag,
     ))
 
 
-@mcp.tool()
+@tool()
 def get_asset_details(asset_path: str) -> Dict[str, Any]:
     """Inspect one asset in detail before using it. Meshes report bounds and LOD count, materials report parameter names, textures report size, and sounds report duration when available."""
     return _stringify_result(get_client().get_asset_details(asset_path))
 
 
-@mcp.tool()
+@tool()
 def set_operator_policy(
     operator_only: Optional[bool] = None,
     allow_atomic_placement: Optional[bool] = None,
@@ -203,7 +313,7 @@ def set_operator_policy(
     ))
 
 
-@mcp.tool()
+@tool()
 def spawn_point_light(
     x: float,
     y: float,
@@ -229,7 +339,7 @@ def spawn_point_light(
     ))
 
 
-@mcp.tool()
+@tool()
 def spawn_rect_light(
     x: float,
     y: float,
@@ -263,7 +373,7 @@ def spawn_rect_light(
     ))
 
 
-@mcp.tool()
+@tool()
 def spawn_directional_light(
     rx: float = -45.0,
     ry: float = 0.0,
@@ -287,19 +397,19 @@ def spawn_directional_light(
     ))
 
 
-@mcp.tool()
+@tool()
 def set_static_mesh(actor_name: str, mesh_path: str) -> Dict[str, Any]:
     """Change which static mesh an actor displays. Common engine graybox meshes include /Engine/BasicShapes/Cube.Cube and Plane.Plane."""
     return _ensure_ok(get_client().set_static_mesh(actor_name, mesh_path))
 
 
-@mcp.tool()
+@tool()
 def set_actor_scale(actor_name: str, sx: float, sy: float, sz: float) -> Dict[str, Any]:
     """Set absolute actor scale. A Cube scaled to (10, 0.1, 3) forms a 1000cm x 10cm x 300cm wall-like element."""
     return _ensure_ok(get_client().set_actor_scale(actor_name, sx, sy, sz))
 
 
-@mcp.tool()
+@tool()
 def duplicate_actor(
     actor_name: str,
     offset_x: float = 0.0,
@@ -315,43 +425,43 @@ def duplicate_actor(
     ))
 
 
-@mcp.tool()
+@tool()
 def set_actor_label(actor_name: str, new_label: str) -> Dict[str, Any]:
     """Rename an actor to something descriptive like NorthWall_01 or PointLight_Hallway for clearer editor organization."""
     return _ensure_ok(get_client().set_actor_label(actor_name, new_label))
 
 
-@mcp.tool()
+@tool()
 def set_actor_mobility(actor_name: str, mobility: str) -> Dict[str, Any]:
     """Set component mobility to Static, Stationary, or Movable. Use Static for architecture, Stationary for fixed lights with dynamic shadowing, and Movable for runtime motion."""
     return _ensure_ok(get_client().set_actor_mobility(actor_name, mobility))
 
 
-@mcp.tool()
+@tool()
 def set_actor_visibility(actor_name: str, visible: bool) -> Dict[str, Any]:
     """Show or hide an actor without deleting it. Useful for scene variants, staging, and temporary iteration states."""
     return _ensure_ok(get_client().set_actor_visibility(actor_name, visible))
 
 
-@mcp.tool()
+@tool()
 def group_actors(actor_names: List[str], group_name: str) -> Dict[str, Any]:
     """Attach multiple actors under a new parent actor so they can be treated as one logical unit, such as a room shell or prop cluster."""
     return _ensure_ok(get_client().group_actors(actor_names, group_name))
 
 
-@mcp.tool()
+@tool()
 def get_actor_property(actor_name: str, property_name: str) -> Dict[str, Any]:
     """Read one reflected actor or component property using dot notation like LightComponent.Intensity or StaticMeshComponent.StaticMesh."""
     return _stringify_result(get_client().get_actor_property(actor_name, property_name))
 
 
-@mcp.tool()
+@tool()
 def set_actor_property(actor_name: str, property_name: str, value: str) -> Dict[str, Any]:
     """Write one reflected actor or component property using dot notation. This is the precise escape hatch for properties that do not have a dedicated tool yet."""
     return _ensure_ok(get_client().set_actor_property(actor_name, property_name, value))
 
 
-@mcp.tool()
+@tool()
 def set_mesh_material_color(
     actor_name: str,
     r: float,
@@ -371,7 +481,7 @@ def set_mesh_material_color(
     ))
 
 
-@mcp.tool()
+@tool()
 def apply_material_to_actor(actor_name: str, material_path: str, slot_index: int = 0) -> Dict[str, Any]:
     """Apply a specific material or material instance to an actor mesh slot. Use get_available_materials first if you do not know the asset path."""
     return _ensure_ok(get_client().apply_material_to_actor(
@@ -381,7 +491,7 @@ def apply_material_to_actor(actor_name: str, material_path: str, slot_index: int
     ))
 
 
-@mcp.tool()
+@tool()
 def create_wall(
     start_x: float,
     start_y: float,
@@ -413,7 +523,7 @@ def create_wall(
     ))
 
 
-@mcp.tool()
+@tool()
 def create_floor(
     center_x: float,
     center_y: float,
@@ -437,7 +547,7 @@ def create_floor(
     ))
 
 
-@mcp.tool()
+@tool()
 def create_room(
     center_x: float,
     center_y: float,
@@ -453,8 +563,9 @@ def create_room(
     window_walls: Optional[List[str]] = None,
     label: str = "Room",
     slab_thickness: float = 10.0,
+    output: str = "actors",
 ) -> Dict[str, Any]:
-    """Create a complete room shell with floor, ceiling, walls, optional windows, and an optional door opening. Use this when you need a whole architectural unit instead of hand-placing every segment."""
+    """Create a complete room shell with floor, ceiling, walls, optional windows, and an optional door opening. Use this when you need a whole architectural unit instead of hand-placing every segment. Set output="merged" for large blockouts: one mesh actor per room instead of one actor per wall segment."""
     return _ensure_ok(get_client().create_room(
         center_x=center_x,
         center_y=center_y,
@@ -470,10 +581,11 @@ def create_room(
         window_walls=window_walls or [],
         label=label,
         slab_thickness=slab_thickness,
+        output=output,
     ))
 
 
-@mcp.tool()
+@tool()
 def create_corridor(
     start_x: float,
     start_y: float,
@@ -486,8 +598,9 @@ def create_corridor(
     has_ceiling: bool = True,
     label: str = "Corridor",
     z: float = 0.0,
+    output: str = "actors",
 ) -> Dict[str, Any]:
-    """Create a hallway between two points with floor, side walls, and optional ceiling. Use this to connect room openings cleanly instead of hand-building corridor pieces."""
+    """Create a hallway between two points with floor, side walls, and optional ceiling. Use this to connect room openings cleanly instead of hand-building corridor pieces. Set output="merged" for one mesh actor per corridor."""
     return _ensure_ok(get_client().create_corridor(
         start_x=start_x,
         start_y=start_y,
@@ -500,10 +613,11 @@ def create_corridor(
         has_ceiling=has_ceiling,
         label=label,
         z=z,
+        output=output,
     ))
 
 
-@mcp.tool()
+@tool()
 def create_staircase(
     base_x: float,
     base_y: float,
@@ -531,7 +645,7 @@ def create_staircase(
     ))
 
 
-@mcp.tool()
+@tool()
 def create_pillar(
     x: float,
     y: float,
@@ -555,7 +669,7 @@ def create_pillar(
     ))
 
 
-@mcp.tool()
+@tool()
 def scatter_props(
     mesh_path: str,
     center_x: float,
@@ -569,8 +683,10 @@ def scatter_props(
     material_path: str = "",
     label_prefix: str = "ScatterProp",
     z: float = 0.0,
+    output: str = "actors",
+    tint_variation: float = 0.0,
 ) -> Dict[str, Any]:
-    """Scatter repeated mesh props inside a radius with randomized placement and scale. Use this for rocks, debris, crates, vegetation clumps, or loose furniture around a focal point."""
+    """Scatter repeated mesh props inside a radius with randomized placement and scale. Use this for rocks, debris, crates, vegetation clumps, or loose furniture around a focal point. Set output="instances" for large counts: one instanced component instead of one actor per prop."""
     return _ensure_ok(get_client().scatter_props(
         mesh_path=mesh_path,
         center_x=center_x,
@@ -584,10 +700,12 @@ def scatter_props(
         material_path=material_path,
         label_prefix=label_prefix,
         z=z,
+        output=output,
+        tint_variation=tint_variation,
     ))
 
 
-@mcp.tool()
+@tool()
 def set_fog(
     density: float = 0.02,
     height_falloff: float = 0.2,
@@ -607,7 +725,7 @@ def set_fog(
     ))
 
 
-@mcp.tool()
+@tool()
 def set_post_process(
     bloom_intensity: float = 0.3,
     exposure_compensation: float = 0.0,
@@ -629,31 +747,31 @@ def set_post_process(
     ))
 
 
-@mcp.tool()
+@tool()
 def set_sky_atmosphere(preset: str = "default_day") -> Dict[str, Any]:
     """Apply a whole-scene sky preset. Options are default_day, golden_hour, overcast, night_clear, night_cloudy, stormy, alien_red, and alien_green."""
     return _ensure_ok(get_client().set_sky_atmosphere(preset=preset))
 
 
-@mcp.tool()
+@tool()
 def focus_viewport_on_actor(actor_name: str) -> Dict[str, Any]:
     """Move the editor camera to frame one actor so the next screenshot or inspection step is centered on the thing you just changed."""
     return _stringify_result(get_client().focus_viewport_on_actor(actor_name))
 
 
-@mcp.tool()
+@tool()
 def get_viewport_info() -> Dict[str, Any]:
     """Read the current perspective viewport camera location, rotation, FOV, and dimensions."""
     return _stringify_result(get_client().get_viewport_info())
 
 
-@mcp.tool()
-def create_snapshot(snapshot_name: str = "") -> Dict[str, Any]:
-    """Create a level snapshot before larger edits so you can verify or recover from a generation pass."""
-    return _ensure_ok(get_client().create_snapshot(snapshot_name=snapshot_name))
+@tool()
+def create_snapshot(snapshot_name: str = "", json_export: bool = False) -> Dict[str, Any]:
+    """Create a level snapshot before larger edits so you can verify or recover from a generation pass. json_export also writes a JSON copy."""
+    return _ensure_ok(get_client().create_snapshot(snapshot_name=snapshot_name, json_export=json_export))
 
 
-@mcp.tool()
+@tool()
 def run_verification(phase_mask: int = 15) -> Dict[str, Any]:
     """Run the four-phase verification protocol. Use this before or after large edits when you want explicit safety feedback."""
     report = get_client().run_verification(phase_mask=phase_mask)
@@ -664,7 +782,7 @@ def run_verification(phase_mask: int = 15) -> Dict[str, Any]:
     }
 
 
-@mcp.tool()
+@tool()
 def observe_analyze_plan_act(
     description: str,
     max_iterations: int = 1,
@@ -678,7 +796,7 @@ def observe_analyze_plan_act(
     ))
 
 
-@mcp.tool()
+@tool()
 def llm_set_key(provider: str, key: str) -> Dict[str, Any]:
     """Store an API key in the active Unreal Editor session for one LLM provider. Provider values: Anthropic, OpenAI, DeepSeek, OpenAICompatible."""
     return _ensure_ok(get_client().execute("llm_set_key", {
@@ -687,13 +805,29 @@ def llm_set_key(provider: str, key: str) -> Dict[str, Any]:
     }))
 
 
-@mcp.tool()
+@tool()
+def validate_json(
+    value: Any = None,
+    schema: Optional[Dict[str, Any]] = None,
+    schema_name: str = "",
+    json_text: str = "",
+) -> Dict[str, Any]:
+    """Check a JSON payload (or JSON text such as an LLM answer) against a schema or a bundled schema_name like "npc_personality". Returns valid plus the first failing path in error."""
+    return _ensure_ok(get_client().validate_json(
+        value=value,
+        schema=schema,
+        schema_name=schema_name,
+        json_text=json_text,
+    ))
+
+
+@tool()
 def llm_get_models(provider: str) -> Dict[str, Any]:
     """List the built-in model names known for an LLM provider so you can choose a valid value for llm_chat or llm_structured."""
     return _stringify_result(get_client()._send("llm_get_models", {"provider": provider}))
 
 
-@mcp.tool()
+@tool()
 def llm_chat(
     provider: str,
     model: str,
@@ -702,9 +836,15 @@ def llm_chat(
     max_tokens: int = 1024,
     temperature: float = 0.7,
     custom_endpoint: str = "",
+    cache: str = "bypass",
+    prompt_cache: bool = False,
+    priority: str = "interactive",
+    fan_out: Optional[List[Dict[str, str]]] = None,
+    fan_out_mode: str = "first",
+    hedge_delay_ms: float = 0.0,
 ) -> Dict[str, Any]:
-    """Send a multi-provider chat completion request through the Unreal editor. Use this for NPC dialogue, design reasoning, naming, quest beats, and other text generation tasks."""
-    return _ensure_ok(get_client().execute("llm_chat", {
+    """Send a multi-provider chat completion request through the Unreal editor. Use this for NPC dialogue, design reasoning, naming, quest beats, and other text generation tasks. cache="prefer" replays an identical earlier request; prompt_cache=True lets the provider reuse a large static system prompt. fan_out=[{"provider", "model"}] races more providers against this one and returns the first good answer (fan_out_mode="all" waits for every one); hedge_delay_ms holds the extras back until the primary is slow."""
+    args: Dict[str, Any] = {
         "provider": provider,
         "model": model,
         "messages": messages,
@@ -712,10 +852,16 @@ def llm_chat(
         "max_tokens": max_tokens,
         "temperature": temperature,
         "custom_endpoint": custom_endpoint,
-    }))
+        "cache": cache,
+        "prompt_cache": prompt_cache,
+        "priority": priority,
+    }
+    if fan_out:
+        args.update(fan_out=fan_out, fan_out_mode=fan_out_mode, hedge_delay_ms=hedge_delay_ms)
+    return _ensure_ok(get_client().execute("llm_chat", args))
 
 
-@mcp.tool()
+@tool()
 def llm_stream(
     provider: str,
     model: str,
@@ -725,7 +871,7 @@ def llm_stream(
     temperature: float = 0.7,
     custom_endpoint: str = "",
 ) -> Dict[str, Any]:
-    """Request a stream-compatible response shape. UEAgentForge currently returns chunked compatibility output so MCP hosts can consume incremental-style payloads without custom transport glue."""
+    """Stream a completion from the provider (SSE). Returns the full content plus the chunks in arrival order and first_chunk_ms (time to first token)."""
     return _ensure_ok(get_client().llm_stream(
         provider=provider,
         model=model,
@@ -737,7 +883,7 @@ def llm_stream(
     ))
 
 
-@mcp.tool()
+@tool()
 def llm_structured(
     provider: str,
     model: str,
@@ -747,9 +893,15 @@ def llm_structured(
     max_tokens: int = 1024,
     temperature: float = 0.2,
     custom_endpoint: str = "",
+    cache: str = "bypass",
+    prompt_cache: bool = False,
+    priority: str = "interactive",
+    fan_out: Optional[List[Dict[str, str]]] = None,
+    fan_out_mode: str = "first",
+    hedge_delay_ms: float = 0.0,
 ) -> Dict[str, Any]:
-    """Request structured JSON output from a provider. Use this when you need machine-readable plans like NPC specs, quest payloads, room briefs, or content metadata."""
-    return _ensure_ok(get_client().execute("llm_structured", {
+    """Request structured JSON output from a provider. Use this when you need machine-readable plans like NPC specs, quest payloads, room briefs, or content metadata. cache="prefer" replays an identical earlier request; prompt_cache=True lets the provider reuse a large static system prompt. fan_out races more providers and returns the first schema-valid answer."""
+    args: Dict[str, Any] = {
         "provider": provider,
         "model": model,
         "prompt": prompt,
@@ -758,10 +910,16 @@ def llm_structured(
         "max_tokens": max_tokens,
         "temperature": temperature,
         "custom_endpoint": custom_endpoint,
-    }))
+        "cache": cache,
+        "prompt_cache": prompt_cache,
+        "priority": priority,
+    }
+    if fan_out:
+        args.update(fan_out=fan_out, fan_out_mode=fan_out_mode, hedge_delay_ms=hedge_delay_ms)
+    return _ensure_ok(get_client().execute("llm_structured", args))
 
 
-@mcp.tool()
+@tool()
 def generate_npc_personality(
     provider: str,
     model: str,
@@ -783,7 +941,7 @@ def generate_npc_personality(
     ))
 
 
-@mcp.tool()
+@tool()
 def generate_quest(
     provider: str,
     model: str,
@@ -805,7 +963,7 @@ def generate_quest(
     ))
 
 
-@mcp.tool()
+@tool()
 def generate_level_layout(
     provider: str,
     model: str,
@@ -827,12 +985,13 @@ def generate_level_layout(
     ))
 
 
-@mcp.tool()
+@tool()
 def vision_analyze(
     prompt: str = "",
     provider: str = "",
     model: str = "",
     multi_view: bool = False,
+    use_cache: bool = True,
 ) -> Dict[str, Any]:
     """Analyze the active Unreal viewport or a four-angle capture set through a multimodal model. Leave provider/model blank to use the editor's preferred vision-capable defaults."""
     return _ensure_ok(get_client().vision_analyze(
@@ -840,24 +999,33 @@ def vision_analyze(
         provider=provider,
         model=model,
         multi_view=multi_view,
+        use_cache=use_cache,
     ))
 
 
-@mcp.tool()
+@tool()
 def vision_quality_score(
     provider: str = "",
     model: str = "",
     multi_view: bool = False,
+    use_cache: bool = True,
+    fan_out: Optional[List[Dict[str, str]]] = None,
+    fan_out_mode: str = "first",
+    hedge_delay_ms: float = 0.0,
 ) -> Dict[str, Any]:
-    """Score the current scene from 0 to 100 with structured feedback, issues, and strengths. This is the vision loop used by higher-level OAPA refinement."""
+    """Score the current scene from 0 to 100 with structured feedback, issues, and strengths. This is the vision loop used by higher-level OAPA refinement. fan_out=[{"provider", "model"}] scores the same capture with more providers; fan_out_mode="all" reports their median score."""
     return _ensure_ok(get_client().vision_quality_score(
         provider=provider,
         model=model,
         multi_view=multi_view,
+        use_cache=use_cache,
+        fan_out=fan_out,
+        fan_out_mode=fan_out_mode,
+        hedge_delay_ms=hedge_delay_ms,
     ))
 
 
-@mcp.tool()
+@tool()
 def execute_forge_command(cmd: str, args: Optional[Dict[str, Any]] = None) -> Dict[str, Any]:
     """Low-level escape hatch for any UEAgentForge command not yet promoted to a dedicated MCP tool. Prefer the specific tools above when they exist."""
     return _ensure_ok(get_client().execute(cmd, args or {}))
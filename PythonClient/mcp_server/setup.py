@@ -7,7 +7,7 @@ setup(
     description="MCP server bridge for the UEAgentForge Unreal Editor plugin",
     package_dir={"": ".."},
     packages=find_packages(where="..", include=["mcp_server"]),
-    py_modules=["ueagentforge_client"],
+    py_modules=["ueagentforge_client", "ueagentforge_async_client"],
     include_package_data=True,
     package_data={
         "mcp_server": [
@@ -0,0 +1,671 @@
+"""
+UEAgentForge asyncio client
+===========================
+Pipelined counterpart of AgentForgeClient. Independent calls are in flight at
+the same time instead of each waiting for the previous round trip:
+
+    transport="http"  a pool of keep-alive Remote Control connections with one
+                      request in flight per connection. Replies are checked
+                      against the request_id the bridge echoes.
+    transport="ws"    one socket-transport connection (start_socket_server).
+                      Requests are pipelined and matched on their id.
+
+Pure queries (`coalescable` in list_commands) issued within batch_window_ms of
+each other are merged into one execute_batch (non-transactional, unverified),
+so N lookups cost one round trip and one game-thread hop. Every other command
+is a barrier: it waits for the calls issued before it, runs alone, and the
+calls issued after it wait for it, so a caller always sees its own writes.
+
+Transport failures are retried. Non-query commands carry an idempotency_key,
+so a retried mutation whose first attempt did reach the editor gets the stored
+response back ("idempotent_replay": true) instead of running twice.
+
+Usage:
+    import asyncio
+    from ueagentforge_async_client import AsyncAgentForgeClient
+
+    async def main():
+        async with AsyncAgentForgeClient() as client:
+            level, actors, meshes = await asyncio.gather(
+                client.call("get_current_level"),
+                client.call("get_all_level_actors", {"fields": ["label"]}),
+                client.call("get_available_meshes", {"search_filter": "wall"}),
+            )
+            await client.call("spawn_actor", {"class_path": "/Script/Engine.StaticMeshActor", "x": 0, "y": 0, "z": 100})
+
+    asyncio.run(main())
+
+PipelinedAgentForgeClient wraps the same machinery behind the blocking
+AgentForgeClient API for thread-based callers such as the MCP server.
+
+Requirements: Python 3.9+, no packages beyond those of ueagentforge_client.
+"""
+
+from __future__ import annotations
+
+import asyncio
+import base64
+import hashlib
+import json
+import os
+import struct
+import threading
+import uuid
+from collections import deque
+from typing import Any, Callable, Deque, Dict, List, Optional, Tuple
+
+from ueagentforge_client import (
+    DEFAULT_HOST,
+    DEFAULT_PORT,
+    DEFAULT_WS_PORT,
+    FUNCTION,
+    OBJECT_PATH,
+    AgentForgeClient,
+    ForgeResult,
+    _decode_response_encoding,
+    log,
+)
+
+
+class TransportError(ConnectionError):
+    """The request may not have reached the editor; it is safe to retry."""
+
+
+# ─── Keep-alive HTTP ──────────────────────────────────────────────────────────
+class _HttpConnection:
+    """One persistent HTTP/1.1 connection to the Remote Control server."""
+
+    def __init__(self, reader: asyncio.StreamReader, writer: asyncio.StreamWriter):
+        self.reader = reader
+        self.writer = writer
+        self.reusable = True
+
+    @classmethod
+    async def open(cls, host: str, port: int) -> "_HttpConnection":
+        try:
+            reader, writer = await asyncio.open_connection(host, port)
+        except OSError as exc:
+            raise TransportError(f"Cannot reach Unreal Editor at {host}:{port}: {exc}") from exc
+        return cls(reader, writer)
+
+    def close(self) -> None:
+        self.reusable = False
+        self.writer.close()
+
+    async def put(self, host: str, port: int, path: str, body: bytes) -> Tuple[int, bytes]:
+        head = (
+            f"PUT {path} HTTP/1.1\r\nHost: {host}:{port}\r\n"
+            "Content-Type: application/json\r\nConnection: keep-alive\r\n"
+            f"Content-Length: {len(body)}\r\n\r\n"
+        )
+        try:
+            self.writer.write(head.encode("ascii") + body)
+            await self.writer.drain()
+
+            status_line = await self.reader.readuntil(b"\r\n")
+            parts = status_line.split(None, 2)
+            status = int(parts[1]) if len(parts) > 1 else 0
+            headers: Dict[str, str] = {}
+            while True:
+                line = await self.reader.readuntil(b"\r\n")
+                if line == b"\r\n":
+                    break
+                name, _, value = line.decode("latin-1").partition(":")
+                headers[name.strip().lower()] = value.strip()
+
+            if headers.get("transfer-encoding", "").lower() == "chunked":
+                chunks: List[bytes] = []
+                while True:
+                    size = int((await self.reader.readuntil(b"\r\n")).split(b";", 1)[0], 16)
+                    if size == 0:
+                        await self.reader.readuntil(b"\r\n")
+                        break
+                    chunks.append(await self.reader.readexactly(size))
+                    await self.reader.readexactly(2)
+                payload = b"".join(chunks)
+            elif "content-length" in headers:
+                payload = await self.reader.readexactly(int(headers["content-length"]))
+            else:
+                payload = await self.reader.read()
+                self.reusable = False
+        except (OSError, asyncio.IncompleteReadError, asyncio.LimitOverrunError, ValueError) as exc:
+            self.close()
+            raise TransportError(f"HTTP connection to {host}:{port} failed: {exc}") from exc
+
+        if headers.get("connection", "").lower() == "close":
+            self.reusable = False
+        return status, payload
+
+
+class _HttpTransport:
+    """Pool of keep-alive connections; one request in flight per connection."""
+
+    PATH = "/remote/object/call"
+
+    def __init__(self, host: str, port: int, connections: int):
+        self.host = host
+        self.port = port
+        self.connections = max(1, int(connections))
+        self._idle: List[_HttpConnection] = []
+        self._slots: Optional[asyncio.Semaphore] = None
+
+    async def request(self, envelope: Dict[str, Any]) -> Dict[str, Any]:
+        if self._slots is None:
+            self._slots = asyncio.Semaphore(self.connections)
+        body = json.dumps({
+            "objectPath":   OBJECT_PATH,
+            "functionName": FUNCTION,
+            "parameters":   {"RequestJson": json.dumps(envelope)},
+        }).encode("utf-8")
+
+        async with self._slots:
+            conn = self._idle.pop() if self._idle else await _HttpConnection.open(self.host, self.port)
+            try:
+                status, payload = await conn.put(self.host, self.port, self.PATH, body)
+            except BaseException:
+                conn.close()                 # timed out or cancelled mid-reply
+                raise
+            if conn.reusable:
+                self._idle.append(conn)
+            else:
+                conn.close()
+
+        if status >= 500:
+            raise TransportError(f"HTTP {status} from Remote Control for cmd '{envelope.get('cmd')}'")
+        if status >= 400:
+            raise RuntimeError(f"HTTP {status} from Remote Control for cmd '{envelope.get('cmd')}': {payload[:200]!r}")
+
+        data = json.loads(payload.decode("utf-8"))
+        # Remote Control wraps the return value in {"ReturnValue": "..."}
+        result = data.get("ReturnValue", data) if isinstance(data, dict) else data
+        if isinstance(result, str):
+            try:
+                result = json.loads(result)
+            except json.JSONDecodeError:
+                result = {"raw": result}
+        if not isinstance(result, dict):
+            result = {"raw": result}
+        echoed = result.pop("request_id", envelope.get("request_id"))
+        if echoed != envelope.get("request_id"):
+            raise RuntimeError(f"Reply for request {echoed!r} arrived on request {envelope.get('request_id')!r}")
+        return result
+
+    async def close(self) -> None:
+        for conn in self._idle:
+            conn.close()
+        self._idle.clear()
+
+
+# ─── Socket transport ─────────────────────────────────────────────────────────
+def _mask(payload: bytes, mask: bytes) -> bytes:
+    if not payload:
+        return payload
+    count = len(payload)
+    key = (mask * (count // 4 + 1))[:count]
+    return (int.from_bytes(payload, "big") ^ int.from_bytes(key, "big")).to_bytes(count, "big")
+
+
+class _SocketTransport:
+    """
+    asyncio WebSocket client for the socket transport. Requests are written as
+    soon as they are issued; a reader task resolves each reply's future by id
+    and hands pushed events to `on_event`.
+    """
+
+    def __init__(self, host: str, port: int, events: Deque[Dict[str, Any]]):
+        self.host = host
+        self.port = port
+        self.events = events
+        self.on_event: Optional[Callable[[Dict[str, Any]], None]] = None
+        self._reader: Optional[asyncio.StreamReader] = None
+        self._writer: Optional[asyncio.StreamWriter] = None
+        self._reader_task: Optional[asyncio.Task] = None
+        self._waiters: Dict[Any, asyncio.Future] = {}
+        self._connecting: Optional[asyncio.Lock] = None
+
+    async def connect(self) -> None:
+        if self._connecting is None:
+            self._connecting = asyncio.Lock()
+        async with self._connecting:
+            if self._writer is not None:
+                return
+            try:
+                reader, writer = await asyncio.open_connection(self.host, self.port)
+            except OSError as exc:
+                raise TransportError(f"Cannot reach the socket transport at {self.host}:{self.port}: {exc}") from exc
+            key = base64.b64encode(os.urandom(16)).decode("ascii")
+            writer.write((
+                f"GET / HTTP/1.1\r\nHost: {self.host}:{self.port}\r\n"
+                "Upgrade: websocket\r\nConnection: Upgrade\r\n"
+                f"Sec-WebSocket-Key: {key}\r\nSec-WebSocket-Version: 13\r\n\r\n"
+            ).encode("ascii"))
+            try:
+                await writer.drain()
+                head = await reader.readuntil(b"\r\n\r\n")
+            except (OSError, asyncio.IncompleteReadError) as exc:
+                writer.close()
+                raise TransportError(f"Socket handshake with {self.host}:{self.port} failed: {exc}") from exc
+            if b" 101 " not in head.split(b"\r\n", 1)[0]:
+                writer.close()
+                raise RuntimeError(f"Socket handshake rejected: {head.splitlines()[0]!r}")
+            expected = base64.b64encode(
+                hashlib.sha1((key + "258EAFA5-E914-47DA-95CA-C5AB0DC85B11").encode("ascii")).digest()
+            )
+            if expected not in head:
+                writer.close()
+                raise RuntimeError("Socket handshake returned an invalid Sec-WebSocket-Accept")
+            self._reader, self._writer = reader, writer
+            self._reader_task = asyncio.ensure_future(self._read_loop())
+
+    async def request(self, request_id: int, envelope: Dict[str, Any]) -> Dict[str, Any]:
+        await self.connect()
+        future = asyncio.get_running_loop().create_future()
+        self._waiters[request_id] = future
+        message = {"id": request_id, **{k: v for k, v in envelope.items() if k != "request_id"}}
+        writer = self._writer
+        try:
+            self._send_frame(0x1, json.dumps(message).encode("utf-8"))
+            await writer.drain()
+            return await future
+        except OSError as exc:
+            raise TransportError(f"Socket connection to {self.host}:{self.port} failed: {exc}") from exc
+        finally:
+            self._waiters.pop(request_id, None)
+
+    async def close(self) -> None:
+        if self._writer is None:
+            return
+        try:
+            self._send_frame(0x8, b"")
+        except OSError:
+            pass
+        self._drop(TransportError("Socket transport closed"))
+
+    def _drop(self, exc: Exception) -> None:
+        if self._writer is not None:
+            self._writer.close()
+        self._reader = self._writer = None
+        if self._reader_task is not None and self._reader_task is not asyncio.current_task():
+            self._reader_task.cancel()
+        self._reader_task = None
+        for future in self._waiters.values():
+            if not future.done():
+                future.set_exception(exc)
+        self._waiters.clear()
+
+    def _send_frame(self, opcode: int, payload: bytes) -> None:
+        if self._writer is None:
+            raise TransportError("Socket transport is not connected")
+        header = bytearray([0x80 | opcode])
+        length = len(payload)
+        if length < 126:
+            header.append(0x80 | length)
+        elif length < 65536:
+            header.append(0x80 | 126)
+            header += struct.pack("!H", length)
+        else:
+            header.append(0x80 | 127)
+            header += struct.pack("!Q", length)
+        mask = os.urandom(4)
+        self._writer.write(bytes(header) + mask + _mask(payload, mask))
+
+    async def _read_loop(self) -> None:
+        reader = self._reader
+        fragments: List[bytes] = []
+        try:
+            while True:
+                b0, b1 = await reader.readexactly(2)
+                opcode = b0 & 0x0F
+                length = b1 & 0x7F
+                if length == 126:
+                    length = struct.unpack("!H", await reader.readexactly(2))[0]
+                elif length == 127:
+                    length = struct.unpack("!Q", await reader.readexactly(8))[0]
+                mask = await reader.readexactly(4) if b1 & 0x80 else b""
+                payload = await reader.readexactly(length)
+                if mask:
+                    payload = _mask(payload, mask)
+                if opcode == 0x9:            # ping
+                    self._send_frame(0xA, payload)
+                    continue
+                if opcode == 0xA:            # pong
+                    continue
+                if opcode == 0x8:            # close
+                    raise TransportError("Socket connection closed by the editor")
+                fragments.append(payload)
+                if b0 & 0x80:
+                    self._dispatch(b"".join(fragments).decode("utf-8"))
+                    fragments = []
+        except asyncio.CancelledError:
+            raise
+        except (OSError, asyncio.IncompleteReadError, TransportError) as exc:
+            self._drop(exc if isinstance(exc, TransportError) else TransportError(f"Socket connection lost: {exc}"))
+
+    def _dispatch(self, text: str) -> None:
+        message = json.loads(text)
+        if message.get("type") == "event":
+            self.events.append(message)
+            if self.on_event is not None:
+                self.on_event(message)
+            return
+        future = self._waiters.get(message.get("id"))
+        if future is None or future.done():
+            return                           # caller timed out or gave up
+        result = message.get("result")
+        future.set_result(result if isinstance(result, dict) else {"raw": result})
+
+
+# ─── Client ───────────────────────────────────────────────────────────────────
+class AsyncAgentForgeClient:
+    """
+    asyncio client for the UEAgentForge bridge. `call` returns the parsed
+    response dict, as AgentForgeClient._send does; `execute` wraps it in a
+    ForgeResult.
+    """
+
+    def __init__(
+        self,
+        host: str = DEFAULT_HOST,
+        port: int = DEFAULT_PORT,
+        timeout: float = 30.0,
+        transport: str = "http",
+        ws_port: int = DEFAULT_WS_PORT,
+        connections: int = 4,
+        batch_window_ms: float = 2.0,
+        max_batch: int = 64,
+        max_retries: int = 3,
+        retry_backoff_sec: float = 0.5,
+        profile: bool = False,
+    ):
+        self.timeout = timeout
+        # profile=True adds "profile": true to every request; such calls are never batched.
+        self.profile = profile
+        self.batch_window = max(0.0, float(batch_window_ms)) / 1000.0
+        self.max_batch = max(1, int(max_batch))
+        self.max_retries = max(1, int(max_retries))
+        self.retry_backoff_sec = max(0.0, float(retry_backoff_sec))
+        self.events: Deque[Dict[str, Any]] = deque(maxlen=1024)
+        self._http: Optional[_HttpTransport] = None
+        self._socket: Optional[_SocketTransport] = None
+        if transport == "http":
+            self._http = _HttpTransport(host, port, connections)
+        elif transport == "ws":
+            self._socket = _SocketTransport(host, ws_port, self.events)
+        else:
+            raise ValueError(f"Unknown transport: {transport!r} (expected 'http' or 'ws')")
+
+        self._next_id = 1
+        self._queries: Optional[frozenset] = None          # coalescable command names
+        self._queries_loading: Optional[asyncio.Future] = None
+        self._pending: List[Tuple[str, Dict[str, Any], asyncio.Future]] = []
+        self._flush_handle: Optional[asyncio.TimerHandle] = None
+        self._in_flight: List[asyncio.Future] = []         # queries issued since the last barrier
+        self._barrier: Optional[asyncio.Future] = None     # the last non-query call
+        self.stats: Dict[str, int] = {
+            "requests": 0, "batches": 0, "batched_calls": 0, "retries": 0, "idempotent_replays": 0,
+        }
+
+    async def __aenter__(self) -> "AsyncAgentForgeClient":
+        return self
+
+    async def __aexit__(self, *exc: Any) -> None:
+        await self.close()
+
+    async def close(self) -> None:
+        self._flush_now()
+        if self._http is not None:
+            await self._http.close()
+        if self._socket is not None:
+            await self._socket.close()
+
+    @property
+    def on_event(self) -> Optional[Callable[[Dict[str, Any]], None]]:
+        return self._socket.on_event if self._socket is not None else None
+
+    @on_event.setter
+    def on_event(self, handler: Optional[Callable[[Dict[str, Any]], None]]) -> None:
+        if self._socket is None:
+            raise RuntimeError("Pushed events need transport='ws'")
+        self._socket.on_event = handler
+
+    def poll_events(self) -> List[Dict[str, Any]]:
+        """Pushed socket events received so far (job_progress, job_finished, stream_chunk). Empty on HTTP."""
+        drained = list(self.events)
+        self.events.clear()
+        return drained
+
+    # ── Calls ────────────────────────────────────────────────────────────────
+    async def call(self, cmd: str, args: Optional[Dict[str, Any]] = None) -> Dict[str, Any]:
+        """Send one command; independent calls issued concurrently are pipelined."""
+        cmd = cmd.strip().lower()
+        args = dict(args or {})
+        if self.profile:
+            args["profile"] = True
+        queries = await self._load_queries()
+
+        if cmd in queries and not args.get("profile") and not args.get("async"):
+            # Registered before waiting, so a barrier issued later waits for it;
+            # waits only for the barrier issued before it.
+            future = asyncio.get_running_loop().create_future()
+            self._in_flight = [f for f in self._in_flight if not f.done()]
+            self._in_flight.append(future)
+            barrier = self._barrier
+            if barrier is not None and not barrier.done():
+                await asyncio.shield(barrier)
+            self._pending.append((cmd, args, future))
+            if len(self._pending) >= self.max_batch or self.batch_window <= 0.0:
+                self._flush_now()
+            elif self._flush_handle is None:
+                self._flush_handle = asyncio.get_running_loop().call_later(self.batch_window, self._flush_now)
+            return await future
+
+        # Barrier: after every call issued before it, before every call issued after it.
+        previous = [f for f in self._in_flight if not f.done()]
+        if self._barrier is not None:
+            previous.append(self._barrier)
+        done = asyncio.get_running_loop().create_future()
+        self._barrier = done
+        self._in_flight = []
+        self._flush_now()
+        try:
+            if previous:
+                await asyncio.gather(*previous, return_exceptions=True)
+            return await self._request(cmd, args, idempotency_key=uuid.uuid4().hex)
+        finally:
+            done.set_result(None)
+
+    async def execute(self, cmd: str, args: Optional[Dict[str, Any]] = None) -> ForgeResult:
+        return ForgeResult.from_response(await self.call(cmd, args))
+
+    async def call_many(self, commands: List[Dict[str, Any]]) -> List[Dict[str, Any]]:
+        """Issue [{cmd, args}] concurrently and return the responses in order."""
+        return list(await asyncio.gather(*(self.call(c.get("cmd", ""), c.get("args")) for c in commands)))
+
+    async def execute_batch(
+        self,
+        commands: List[Dict[str, Any]],
+        transactional: bool = True,
+        stop_on_error: bool = True,
+        verify: bool = True,
+    ) -> Dict[str, Any]:
+        """An explicit execute_batch, sent as one barrier call (see AgentForgeClient.execute_batch)."""
+        return await self.call("execute_batch", {
+            "commands": [{"cmd": c.get("cmd", ""), "args": c.get("args", {}) or {}} for c in commands],
+            "transactional": transactional,
+            "stop_on_error": stop_on_error,
+            "verify": verify,
+        })
+
+    async def ping(self) -> Dict[str, Any]:
+        return await self.call("ping")
+
+    async def list_commands(self, category: str = "") -> Dict[str, Any]:
+        return await self.call("list_commands", {"category": category} if category else {})
+
+    async def refresh_commands(self) -> None:
+        """Re-read which commands are pure queries (after a plugin rebuild, say)."""
+        self._queries = None
+        await self._load_queries()
+
+    # ── Internals ────────────────────────────────────────────────────────────
+    async def _load_queries(self) -> frozenset:
+        if self._queries is not None:
+            return self._queries
+        if self._queries_loading is None:
+            self._queries_loading = asyncio.ensure_future(self._fetch_queries())
+        try:
+            self._queries = await asyncio.shield(self._queries_loading)
+        finally:
+            self._queries_loading = None
+        return self._queries
+
+    async def _fetch_queries(self) -> frozenset:
+        listing = await self._request("list_commands", {})
+        commands = listing.get("commands")
+        if not isinstance(commands, list):
+            # An older plugin without the registry listing: run everything in order.
+            log.warning("list_commands unavailable; every call is sent as a barrier")
+            return frozenset()
+        return frozenset(c.get("name", "") for c in commands if isinstance(c, dict) and c.get("coalescable"))
+
+    def _flush_now(self) -> None:
+        if self._flush_handle is not None:
+            self._flush_handle.cancel()
+            self._flush_handle = None
+        if not self._pending:
+            return
+        pending, self._pending = self._pending, []
+        for start in range(0, len(pending), self.max_batch):
+            asyncio.ensure_future(self._send_queries(pending[start:start + self.max_batch]))
+
+    async def _send_queries(self, group: List[Tuple[str, Dict[str, Any], asyncio.Future]]) -> None:
+        try:
+            if len(group) == 1:
+                cmd, args, _ = group[0]
+                results = [await self._request(cmd, args)]
+            else:
+                results = await self._send_batch(group)
+        except BaseException as exc:  # noqa: BLE001 - handed to every waiter
+            for _, _, future in group:
+                if not future.done():
+                    future.set_exception(exc)
+            if not isinstance(exc, Exception):
+                raise
+            return
+        for (_, _, future), result in zip(group, results):
+            if not future.done():
+                future.set_result(result)
+
+    async def _send_batch(self, group: List[Tuple[str, Dict[str, Any], asyncio.Future]]) -> List[Dict[str, Any]]:
+        response = await self._request("execute_batch", {
+            "commands": [{"cmd": cmd, "args": args, "request_id": i} for i, (cmd, args, _) in enumerate(group)],
+            "transactional": False,
+            "stop_on_error": False,
+            "verify": False,
+        })
+        entries = response.get("results")
+        if not isinstance(entries, list) or len(entries) != len(group):
+            # Refused as a whole (memory guard, say): fall back to single requests.
+            return list(await asyncio.gather(*(self._request(cmd, args) for cmd, args, _ in group)))
+        self.stats["batches"] += 1
+        self.stats["batched_calls"] += len(group)
+
+        results: List[Dict[str, Any]] = [
+            {"ok": False, "error": f"{cmd} is missing from the batch response"} for cmd, _, _ in group
+        ]
+        for position, entry in enumerate(entries):
+            index = int(entry.get("request_id", entry.get("index", position)))
+            if not 0 <= index < len(group):
+                continue
+            if "result" in entry and isinstance(entry["result"], dict):
+                result = _decode_response_encoding(entry["result"])
+            elif "result_raw" in entry:
+                result = {"raw": entry["result_raw"]}
+            else:
+                result = {"ok": False, "error": f"{entry.get('cmd', '?')} did not run in the batch"}
+            results[index] = result
+        return results
+
+    async def _request(self, cmd: str, args: Dict[str, Any], idempotency_key: Optional[str] = None) -> Dict[str, Any]:
+        envelope: Dict[str, Any] = {"cmd": cmd, "args": args}
+        if idempotency_key:
+            envelope["idempotency_key"] = idempotency_key
+        for attempt in range(1, self.max_retries + 1):
+            request_id = self._next_id
+            self._next_id += 1
+            envelope["request_id"] = request_id
+            self.stats["requests"] += 1
+            log.debug(f"→ [{request_id}] {cmd} {args}")
+            try:
+                if self._socket is not None:
+                    coro = self._socket.request(request_id, envelope)
+                else:
+                    coro = self._http.request(envelope)
+                result = await asyncio.wait_for(coro, self.timeout)
+            except (TransportError, asyncio.TimeoutError) as exc:
+                if attempt >= self.max_retries:
+                    raise RuntimeError(f"cmd '{cmd}' failed after {self.max_retries} attempts: {exc}") from exc
+                self.stats["retries"] += 1
+                await asyncio.sleep(self.retry_backoff_sec * attempt)
+                continue
+            if result.pop("idempotent_replay", False):
+                self.stats["idempotent_replays"] += 1
+            log.debug(f"← [{request_id}] {cmd}")
+            return _decode_response_encoding(result)
+        raise RuntimeError(f"cmd '{cmd}' was not sent")
+
+
+# ─── Blocking facade ──────────────────────────────────────────────────────────
+class PipelinedAgentForgeClient(AgentForgeClient):
+    """
+    AgentForgeClient whose every command goes through one AsyncAgentForgeClient
+    on a background event loop. It is safe to share between threads: queries
+    made from several threads at once are pipelined and batched, and
+    everything else keeps the order in which the threads issued it.
+    """
+
+    def __init__(
+        self,
+        host: str = DEFAULT_HOST,
+        port: int = DEFAULT_PORT,
+        timeout: float = 30.0,
+        verify: bool = True,
+        max_retries: int = 3,
+        retry_backoff_sec: float = 0.5,
+        verbose: bool = False,
+        transport: str = "http",
+        ws_port: int = DEFAULT_WS_PORT,
+        profile: bool = False,
+        connections: int = 4,
+        batch_window_ms: float = 2.0,
+    ):
+        super().__init__(host=host, port=port, timeout=timeout, verify=verify, max_retries=max_retries,
+                         retry_backoff_sec=retry_backoff_sec, verbose=verbose, profile=profile)
+        self._async = AsyncAgentForgeClient(
+            host=host, port=port, timeout=timeout, transport=transport, ws_port=ws_port,
+            connections=connections, batch_window_ms=batch_window_ms,
+            max_retries=max_retries, retry_backoff_sec=retry_backoff_sec,
+        )
+        self._loop = asyncio.new_event_loop()
+        self._thread = threading.Thread(target=self._loop.run_forever, name="ueagentforge-pipeline", daemon=True)
+        self._thread.start()
+
+    def _send(self, cmd: str, args: Optional[Dict] = None) -> Dict[str, Any]:
+        if self.profile:
+            args = {**(args or {}), "profile": True}
+        future = asyncio.run_coroutine_threadsafe(self._async.call(cmd, args), self._loop)
+        return future.result()
+
+    def poll_events(self, timeout: float = 0.0) -> List[Dict[str, Any]]:
+        return self._async.poll_events()
+
+    @property
+    def pipeline_stats(self) -> Dict[str, int]:
+        return dict(self._async.stats)
+
+    def close(self) -> None:
+        if self._loop.is_running():
+            asyncio.run_coroutine_threadsafe(self._async.close(), self._loop).result(timeout=5.0)
+            self._loop.call_soon_threadsafe(self._loop.stop)
+            self._thread.join(timeout=5.0)
+        super().close()
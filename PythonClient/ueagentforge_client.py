@@ -18,12 +18,19 @@ Requirements:
 
 from __future__ import annotations
 
+import base64
+import hashlib
 import json
+import os
+import socket
+import struct
+import threading
 import time
 import logging
+from collections import deque
 from pathlib import Path
 from dataclasses import dataclass, field
-from typing import Any, Dict, List, Optional
+from typing import Any, Callable, Deque, Dict, List, Optional, Tuple
 
 try:
     import requests
@@ -34,6 +41,7 @@ except ImportError:
 # â”€â”€â”€ Configuration â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€
 DEFAULT_HOST = "127.0.0.1"
 DEFAULT_PORT = 30010
+DEFAULT_WS_PORT = 30020
 OBJECT_PATH  = "/Script/UEAgentForge.Default__AgentForgeLibrary"
 FUNCTION     = "ExecuteCommandJson"
 REPO_ROOT = Path(__file__).resolve().parents[1]
@@ -51,6 +59,107 @@ def _normalize_schema_name(schema_name: str) -> str:
     return value
 
 
+# Parsed bundled schemas by path, with the file's mtime so an edited schema is re-read.
+_SCHEMA_CACHE: Dict[str, Tuple[float, Dict[str, Any]]] = {}
+
+
+# â”€â”€â”€ CBOR responses â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€
+def _decode_cbor(data: bytes) -> Any:
+    """Minimal RFC 8949 decoder for the shapes the plugin emits (no tags, no bignums)."""
+    pos = 0
+
+    def read(n: int) -> bytes:
+        nonlocal pos
+        if pos + n > len(data):
+            raise ValueError("truncated CBOR payload")
+        chunk = data[pos:pos + n]
+        pos += n
+        return chunk
+
+    def item() -> Any:
+        initial = read(1)[0]
+        major, info = initial >> 5, initial & 0x1F
+        if major == 7:
+            if info == 20:
+                return False
+            if info == 21:
+                return True
+            if info in (22, 23):
+                return None
+            if info == 25:
+                return struct.unpack(">e", read(2))[0]
+            if info == 26:
+                return struct.unpack(">f", read(4))[0]
+            if info == 27:
+                return struct.unpack(">d", read(8))[0]
+            if info == 31:
+                return _BREAK
+            raise ValueError(f"unsupported CBOR simple value {info}")
+
+        if info < 24:
+            arg: Optional[int] = info
+        elif info in (24, 25, 26, 27):
+            arg = int.from_bytes(read(1 << (info - 24)), "big")
+        elif info == 31:
+            arg = None  # indefinite length
+        else:
+            raise ValueError(f"bad CBOR additional info {info}")
+
+        if major == 0:
+            return arg
+        if major == 1:
+            return -1 - arg
+        if major in (2, 3):
+            if arg is None:
+                chunks = []
+                while True:
+                    chunk = item()
+                    if chunk is _BREAK:
+                        break
+                    chunks.append(chunk if isinstance(chunk, bytes) else chunk.encode("utf-8"))
+                raw = b"".join(chunks)
+            else:
+                raw = read(arg)
+            return raw if major == 2 else raw.decode("utf-8")
+        if major == 4:
+            out: List[Any] = []
+            while arg is None or len(out) < arg:
+                value = item()
+                if value is _BREAK:
+                    break
+                out.append(value)
+            return out
+        if major == 5:
+            obj: Dict[Any, Any] = {}
+            while arg is None or len(obj) < arg:
+                key = item()
+                if key is _BREAK:
+                    break
+                obj[key] = item()
+            return obj
+        raise ValueError(f"unsupported CBOR major type {major}")
+
+    return item()
+
+
+_BREAK = object()
+
+
+def _actor_query_args(query: Dict[str, Any]) -> Dict[str, Any]:
+    """Actor query kwargs -> command args (class_name maps to the reserved word "class")."""
+    args = {k: v for k, v in query.items() if v is not None}
+    if "class_name" in args:
+        args["class"] = args.pop("class_name")
+    return args
+
+
+def _decode_response_encoding(data: Any) -> Any:
+    """Unwrap {"encoding":"cbor","data":"<base64>"} envelopes into the plain response dict."""
+    if isinstance(data, dict) and data.get("encoding") == "cbor" and isinstance(data.get("data"), str):
+        return _decode_cbor(base64.b64decode(data["data"]))
+    return data
+
+
 # â”€â”€â”€ Data types â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€
 @dataclass
 class ForgeResult:
@@ -100,6 +209,174 @@ class VerificationReport:
         return "\n".join(lines)
 
 
+# â”€â”€â”€ Socket transport â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€
+class AgentForgeSocketTransport:
+    """
+    Minimal stdlib WebSocket client for the plugin's optional socket transport
+    (start_socket_server / -AgentForgeSocketPort). One persistent connection,
+    no Remote Control envelope. Requests carry an id; responses are matched on
+    it, so pushed events and other replies may arrive in between. Events are
+    buffered in `events` and passed to `on_event` if set.
+    """
+
+    def __init__(self, host: str = DEFAULT_HOST, port: int = DEFAULT_WS_PORT, timeout: float = 30.0):
+        self.host = host
+        self.port = port
+        self.timeout = timeout
+        self.on_event: Optional[Callable[[Dict[str, Any]], None]] = None
+        self.events: Deque[Dict[str, Any]] = deque(maxlen=1024)
+        self._sock: Optional[socket.socket] = None
+        self._buffer = b""
+        self._next_id = 1
+        self._responses: Dict[Any, Dict[str, Any]] = {}
+        self._lock = threading.RLock()
+
+    # -- connection ----------------------------------------------------------
+    def connect(self) -> None:
+        with self._lock:
+            if self._sock is not None:
+                return
+            sock = socket.create_connection((self.host, self.port), timeout=self.timeout)
+            sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+            key = base64.b64encode(os.urandom(16)).decode("ascii")
+            request = (
+                f"GET / HTTP/1.1\r\nHost: {self.host}:{self.port}\r\n"
+                "Upgrade: websocket\r\nConnection: Upgrade\r\n"
+                f"Sec-WebSocket-Key: {key}\r\nSec-WebSocket-Version: 13\r\n\r\n"
+            )
+            sock.sendall(request.encode("ascii"))
+            header = b""
+            while b"\r\n\r\n" not in header:
+                chunk = sock.recv(4096)
+                if not chunk:
+                    sock.close()
+                    raise RuntimeError(f"Socket handshake with {self.host}:{self.port} closed early")
+                header += chunk
+            head, _, rest = header.partition(b"\r\n\r\n")
+            if b" 101 " not in head.split(b"\r\n", 1)[0]:
+                sock.close()
+                raise RuntimeError(f"Socket handshake rejected: {head.splitlines()[0]!r}")
+            expected = base64.b64encode(
+                hashlib.sha1((key + "258EAFA5-E914-47DA-95CA-C5AB0DC85B11").encode("ascii")).digest()
+            )
+            if expected not in head:
+                sock.close()
+                raise RuntimeError("Socket handshake returned an invalid Sec-WebSocket-Accept")
+            self._sock = sock
+            self._buffer = rest
+
+    def close(self) -> None:
+        with self._lock:
+            if self._sock is None:
+                return
+            try:
+                self._send_frame(0x8, b"")
+            except OSError:
+                pass
+            self._sock.close()
+            self._sock = None
+            self._buffer = b""
+
+    # -- requests ------------------------------------------------------------
+    def request(self, cmd: str, args: Optional[Dict] = None) -> Dict[str, Any]:
+        """Send {id, cmd, args} and block until the matching response arrives."""
+        with self._lock:
+            self.connect()
+            request_id = self._next_id
+            self._next_id += 1
+            message = json.dumps({"id": request_id, "cmd": cmd, "args": args or {}})
+            self._send_frame(0x1, message.encode("utf-8"))
+            while request_id not in self._responses:
+                self._dispatch(self._recv_message())
+            return self._responses.pop(request_id)
+
+    def poll_events(self, timeout: float = 0.0) -> List[Dict[str, Any]]:
+        """Read any pushed events already waiting (or arriving within timeout) and return them."""
+        with self._lock:
+            self.connect()
+            deadline = time.monotonic() + max(0.0, timeout)
+            self._sock.settimeout(max(0.001, timeout))
+            try:
+                while True:
+                    self._dispatch(self._recv_message())
+                    if time.monotonic() >= deadline:
+                        break
+            except socket.timeout:
+                pass
+            finally:
+                self._sock.settimeout(self.timeout)
+            drained = list(self.events)
+            self.events.clear()
+            return drained
+
+    def _dispatch(self, text: str) -> None:
+        message = json.loads(text)
+        if message.get("type") == "event":
+            self.events.append(message)
+            if self.on_event is not None:
+                self.on_event(message)
+            return
+        result = message.get("result")
+        if not isinstance(result, dict):
+            result = {"raw": result}
+        self._responses[message.get("id")] = result
+
+    # -- framing (RFC 6455, client side) -------------------------------------
+    def _send_frame(self, opcode: int, payload: bytes) -> None:
+        header = bytearray([0x80 | opcode])
+        length = len(payload)
+        if length < 126:
+            header.append(0x80 | length)
+        elif length < 65536:
+            header.append(0x80 | 126)
+            header += struct.pack("!H", length)
+        else:
+            header.append(0x80 | 127)
+            header += struct.pack("!Q", length)
+        mask = os.urandom(4)
+        header += mask
+        masked = bytes(b ^ mask[i & 3] for i, b in enumerate(payload))
+        self._sock.sendall(bytes(header) + masked)
+
+    def _read_exact(self, count: int) -> bytes:
+        while len(self._buffer) < count:
+            chunk = self._sock.recv(max(65536, count - len(self._buffer)))
+            if not chunk:
+                self._sock.close()
+                self._sock = None
+                raise RuntimeError("Socket connection closed by the editor")
+            self._buffer += chunk
+        data, self._buffer = self._buffer[:count], self._buffer[count:]
+        return data
+
+    def _recv_message(self) -> str:
+        fragments: List[bytes] = []
+        while True:
+            b0, b1 = self._read_exact(2)
+            opcode = b0 & 0x0F
+            length = b1 & 0x7F
+            if length == 126:
+                length = struct.unpack("!H", self._read_exact(2))[0]
+            elif length == 127:
+                length = struct.unpack("!Q", self._read_exact(8))[0]
+            mask = self._read_exact(4) if b1 & 0x80 else b""
+            payload = self._read_exact(length)
+            if mask:
+                payload = bytes(b ^ mask[i & 3] for i, b in enumerate(payload))
+            if opcode == 0x9:            # ping
+                self._send_frame(0xA, payload)
+                continue
+            if opcode == 0xA:            # pong
+                continue
+            if opcode == 0x8:            # close
+                self._sock.close()
+                self._sock = None
+                raise RuntimeError("Socket connection closed by the editor")
+            fragments.append(payload)
+            if b0 & 0x80:
+                return b"".join(fragments).decode("utf-8")
+
+
 # â”€â”€â”€ Client â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€
 class AgentForgeClient:
     """
@@ -121,14 +398,25 @@ class AgentForgeClient:
         max_retries: int = 3,
         retry_backoff_sec: float = 0.5,
         verbose: bool = False,
+        transport: str = "http",
+        ws_port: int = DEFAULT_WS_PORT,
+        profile: bool = False,
     ):
         self.base_url = f"http://{host}:{port}/remote/object/call"
         self.timeout  = timeout
+        # profile=True adds "profile": true to every request; responses carry "timings".
+        self.profile  = profile
         self.verify   = verify
         self.max_retries = max(1, int(max_retries))
         self.retry_backoff_sec = max(0.0, float(retry_backoff_sec))
         self._session = requests.Session()
         self._session.headers.update({"Content-Type": "application/json"})
+        # transport="ws": persistent socket (start_socket_server must be running).
+        self._socket: Optional[AgentForgeSocketTransport] = None
+        if transport == "ws":
+            self._socket = AgentForgeSocketTransport(host, ws_port, timeout)
+        elif transport != "http":
+            raise ValueError(f"Unknown transport: {transport!r} (expected 'http' or 'ws')")
 
         if verbose:
             logging.basicConfig(level=logging.DEBUG)
@@ -136,6 +424,12 @@ class AgentForgeClient:
     # â”€â”€ Core transport â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€
     def _send(self, cmd: str, args: Optional[Dict] = None) -> Dict[str, Any]:
         """Send a raw command JSON to the plugin and return the parsed response."""
+        if self.profile:
+            args = {**(args or {}), "profile": True}
+        if self._socket is not None:
+            log.debug(f"ws {cmd} {args}")
+            return _decode_response_encoding(self._socket.request(cmd, args))
+
         request_json = json.dumps({"cmd": cmd, "args": args or {}})
         payload = {
             "objectPath":   OBJECT_PATH,
@@ -180,7 +474,16 @@ class AgentForgeClient:
                 return_val = {"raw": return_val}
 
         log.debug(f"â† {return_val}")
-        return return_val
+        return _decode_response_encoding(return_val)
+
+    def poll_events(self, timeout: float = 0.0) -> List[Dict[str, Any]]:
+        """Pushed socket events (job_progress, job_finished, stream_chunk). Empty on HTTP."""
+        return self._socket.poll_events(timeout) if self._socket is not None else []
+
+    def close(self) -> None:
+        if self._socket is not None:
+            self._socket.close()
+        self._session.close()
 
     def execute(self, cmd: str, args: Optional[Dict] = None) -> ForgeResult:
         """Execute any command and return a ForgeResult."""
@@ -230,12 +533,123 @@ class AgentForgeClient:
             results.append(self.execute(cmd, item.get("args", {}) or {}))
         return results
 
+    def execute_batch(
+        self,
+        commands: List[Dict[str, Any]],
+        transactional: bool = True,
+        stop_on_error: bool = True,
+        verify: bool = True,
+    ) -> Dict:
+        """
+        Run many commands in one round trip via execute_batch: one game-thread hop,
+        optionally one undo transaction, and one PreFlight/PostVerify pass.
+        Returns {"ok", "results": [{"index", "cmd", "ok", "duration_ms", "result"}], ...}.
+        """
+        return self._send("execute_batch", {
+            "commands": [{"cmd": c.get("cmd", ""), "args": c.get("args", {}) or {}} for c in commands],
+            "transactional": transactional,
+            "stop_on_error": stop_on_error,
+            "verify": verify,
+        })
+
+    def get_job_status(self, job_id: str = "", include_partial: bool = True) -> Dict:
+        """
+        Poll an async job started with {"async": true}. Without job_id, list every
+        tracked job. Returns {"state", "stage", "percent_complete", "partial_results", "result"?}.
+        """
+        args: Dict[str, Any] = {"include_partial": include_partial}
+        if job_id:
+            args["job_id"] = job_id
+        return self._send("get_job_status", args)
+
+    def cancel_job(self, job_id: str) -> Dict:
+        """Cancel a queued or running async job; its open undo transaction is rolled back."""
+        return self._send("cancel_job", {"job_id": job_id})
+
+    def start_socket_server(self, port: int = DEFAULT_WS_PORT, bind_address: str = "127.0.0.1") -> Dict:
+        """Start the plugin's persistent WebSocket transport (then use transport="ws")."""
+        return self._send("start_socket_server", {"port": port, "bind_address": bind_address})
+
+    def stop_socket_server(self) -> Dict:
+        return self._send("stop_socket_server")
+
+    def start_command_trace(self, path: str = "", max_response_chars: int = 262144,
+                            exclude: Optional[List[str]] = None) -> Dict:
+        """Record every command to a compressed .aftrace file until stop_command_trace."""
+        args: Dict[str, Any] = {"max_response_chars": max_response_chars}
+        if path:
+            args["path"] = path
+        if exclude:
+            args["exclude"] = exclude
+        return self._send("start_command_trace", args)
+
+    def stop_command_trace(self) -> Dict:
+        return self._send("stop_command_trace")
+
+    def farm_precompute(
+        self,
+        jobs: List[Dict[str, Any]],
+        spool: Optional[str] = None,
+        map: Optional[str] = None,
+        timeout_seconds: Optional[float] = None,
+        cache: Optional[str] = None,
+        run_async: bool = False,
+    ) -> Dict:
+        """
+        Run the compute part of [{cmd, args}] procedural calls on AgentForgeWorker
+        commandlet processes and import their results; issue the same calls afterwards
+        and they only commit. With run_async=True, returns a job_id to poll.
+        """
+        args: Dict[str, Any] = {"jobs": list(jobs)}
+        if spool is not None:
+            args["spool"] = spool
+        if map is not None:
+            args["map"] = map
+        if timeout_seconds is not None:
+            args["timeout_seconds"] = float(timeout_seconds)
+        if cache is not None:
+            args["cache"] = cache
+        if run_async:
+            args["async"] = True
+        return self._send("farm_precompute", args)
+
+    def get_farm_status(self, spool: Optional[str] = None, job_ids: Optional[List[str]] = None,
+                        cache: Optional[str] = None) -> Dict:
+        """Import arrived farm results and list the spool queue and worker heartbeats."""
+        args: Dict[str, Any] = {}
+        if spool is not None:
+            args["spool"] = spool
+        if job_ids:
+            args["job_ids"] = list(job_ids)
+        if cache is not None:
+            args["cache"] = cache
+        return self._send("get_farm_status", args)
+
+    def wait_for_job(self, job_id: str, poll_interval: float = 0.5, timeout: float = 600.0) -> Dict:
+        """Poll get_job_status until the job finishes; returns the final status object."""
+        deadline = time.monotonic() + timeout
+        while True:
+            status = self.get_job_status(job_id, include_partial=False)
+            if status.get("finished") or "error" in status:
+                return status
+            if time.monotonic() >= deadline:
+                raise TimeoutError(f"Job {job_id} still {status.get('state')} after {timeout:.0f}s")
+            time.sleep(poll_interval)
+
     def load_schema(self, schema_name: str) -> Dict[str, Any]:
-        """Load a bundled JSON schema from Content/AgentForge/Schemas."""
+        """Load a bundled JSON schema from Content/AgentForge/Schemas.
+        Parsed once per file version and shared between callers; do not modify the result."""
         schema_path = DEFAULT_SCHEMA_DIR / _normalize_schema_name(schema_name)
-        if not schema_path.exists():
-            raise FileNotFoundError(f"Schema not found: {schema_path}")
-        return json.loads(schema_path.read_text(encoding="utf-8"))
+        try:
+            mtime = schema_path.stat().st_mtime
+        except OSError:
+            raise FileNotFoundError(f"Schema not found: {schema_path}") from None
+        key = str(schema_path)
+        cached = _SCHEMA_CACHE.get(key)
+        if cached is None or cached[0] != mtime:
+            cached = (mtime, json.loads(schema_path.read_text(encoding="utf-8")))
+            _SCHEMA_CACHE[key] = cached
+        return cached[1]
 
     # â”€â”€ Forge meta â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€
     def ping(self) -> Dict:
@@ -244,6 +658,14 @@ class AgentForgeClient:
     def get_forge_status(self) -> Dict:
         return self._send("get_forge_status")
 
+    def list_commands(self, category: str = "") -> Dict:
+        """
+        List the bridge command registry: name, category, arg schema and routing
+        metadata (mutating, operator_heavy, direct_placement, verification_mode).
+        """
+        args = {"category": category} if category else {}
+        return self._send("list_commands", args)
+
     def run_verification(self, phase_mask: int = 15) -> VerificationReport:
         """
         Run manual observational verification.
@@ -269,10 +691,27 @@ class AgentForgeClient:
                           {"action_description": action_description})
 
     # â”€â”€ Observation â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€
-    def get_all_level_actors(self) -> List[Dict]:
-        data = self._send("get_all_level_actors")
+    def get_all_level_actors(self, encoding: str = "json", **query: Any) -> List[Dict]:
+        """encoding="cbor" shrinks the payload on large levels; decoded transparently.
+
+        query: fields=[...], class_name=..., tag=..., bounds={min,max}, limit=..., cursor=...
+        """
+        data = self._send("get_all_level_actors", {"encoding": encoding, **_actor_query_args(query)})
         return data.get("actors", [])
 
+    def iter_level_actors(self, page_size: int = 500, **query: Any):
+        """Yield every matching actor, one page per round trip (follows next_cursor)."""
+        cursor: Optional[str] = None
+        while True:
+            args = {**_actor_query_args(query), "limit": int(page_size)}
+            if cursor is not None:
+                args["cursor"] = cursor
+            data = self._send("get_all_level_actors", args)
+            yield from data.get("actors", [])
+            cursor = data.get("next_cursor")
+            if not cursor:
+                return
+
     def get_actor_components(self, label: str) -> List[Dict]:
         data = self._send("get_actor_components", {"label": label})
         return data.get("components", [])
@@ -287,14 +726,25 @@ class AgentForgeClient:
         include_components: bool = False,
         include_screenshot: bool = True,
         screenshot_label: str = "world_context",
+        encoding: str = "json",
+        since_revision: Optional[int] = None,
+        **query: Any,
     ) -> Dict:
-        return self._send("get_world_context", {
+        """Full context packet, or — with since_revision from an earlier
+        packet's "revision" — only the actors added, modified or removed since.
+        A response with "delta": false is a full resend."""
+        args: Dict[str, Any] = {
             "max_actors": int(max_actors),
             "max_relationships": int(max_relationships),
             "include_components": bool(include_components),
             "include_screenshot": bool(include_screenshot),
             "screenshot_label": screenshot_label,
-        })
+            "encoding": encoding,
+            **_actor_query_args(query),
+        }
+        if since_revision is not None:
+            args["since_revision"] = int(since_revision)
+        return self._send("get_world_context", args)
 
     def assert_current_level(self, expected_level: str) -> Dict:
         return self._send("assert_current_level", {"expected_level": expected_level})
@@ -307,11 +757,15 @@ class AgentForgeClient:
         search_filter: str = "",
         path_filter: str = "",
         max_results: int = 50,
+        prefix: str = "",
+        tag: str = "",
     ) -> Dict:
         return self._send("get_available_meshes", {
             "search_filter": search_filter,
             "path_filter": path_filter,
             "max_results": max_results,
+            "prefix": prefix,
+            "tag": tag,
         })
 
     def get_available_materials(
@@ -319,11 +773,15 @@ class AgentForgeClient:
         search_filter: str = "",
         path_filter: str = "",
         max_results: int = 50,
+        prefix: str = "",
+        tag: str = "",
     ) -> Dict:
         return self._send("get_available_materials", {
             "search_filter": search_filter,
             "path_filter": path_filter,
             "max_results": max_results,
+            "prefix": prefix,
+            "tag": tag,
         })
 
     def get_available_blueprints(
@@ -332,12 +790,16 @@ class AgentForgeClient:
         parent_class: str = "",
         path_filter: str = "",
         max_results: int = 50,
+        prefix: str = "",
+        tag: str = "",
     ) -> Dict:
         return self._send("get_available_blueprints", {
             "search_filter": search_filter,
             "parent_class": parent_class,
             "path_filter": path_filter,
             "max_results": max_results,
+            "prefix": prefix,
+            "tag": tag,
         })
 
     def get_available_textures(
@@ -345,11 +807,15 @@ class AgentForgeClient:
         search_filter: str = "",
         path_filter: str = "",
         max_results: int = 50,
+        prefix: str = "",
+        tag: str = "",
     ) -> Dict:
         return self._send("get_available_textures", {
             "search_filter": search_filter,
             "path_filter": path_filter,
             "max_results": max_results,
+            "prefix": prefix,
+            "tag": tag,
         })
 
     def get_available_sounds(
@@ -357,11 +823,15 @@ class AgentForgeClient:
         search_filter: str = "",
         path_filter: str = "",
         max_results: int = 50,
+        prefix: str = "",
+        tag: str = "",
     ) -> Dict:
         return self._send("get_available_sounds", {
             "search_filter": search_filter,
             "path_filter": path_filter,
             "max_results": max_results,
+            "prefix": prefix,
+            "tag": tag,
         })
 
     def get_asset_details(self, asset_path: str) -> Dict:
@@ -376,8 +846,20 @@ class AgentForgeClient:
     def analyze_level_composition(self) -> Dict:
         return self._send("analyze_level_composition")
 
-    def get_actors_in_radius(self, x: float, y: float, z: float, radius: float = 1000.0) -> Dict:
-        return self._send("get_actors_in_radius", {"x": x, "y": y, "z": z, "radius": radius})
+    def get_actors_in_radius(self, x: float, y: float, z: float, radius: float = 1000.0, **query: Any) -> Dict:
+        return self._send("get_actors_in_radius",
+                          {"x": x, "y": y, "z": z, "radius": radius, **_actor_query_args(query)})
+
+    def get_actors_in_box(self, min_corner: Dict[str, float], max_corner: Dict[str, float], **query: Any) -> Dict:
+        return self._send("get_actors_in_box",
+                          {"min": min_corner, "max": max_corner, **_actor_query_args(query)})
+
+    def get_nearest_actors(self, x: float, y: float, z: float, k: int = 8,
+                           max_radius: Optional[float] = None, **query: Any) -> Dict:
+        args: Dict[str, Any] = {"x": x, "y": y, "z": z, "k": k, **_actor_query_args(query)}
+        if max_radius is not None:
+            args["max_radius"] = max_radius
+        return self._send("get_nearest_actors", args)
 
     # Deterministic procedural operator stack
     def get_procedural_capabilities(self, include_repo_urls: bool = True) -> Dict:
@@ -396,6 +878,10 @@ class AgentForgeClient:
         max_spawn_points: Optional[int] = None,
         max_cluster_count: Optional[int] = None,
         max_generation_time_ms: Optional[float] = None,
+        cache_memory_mb: Optional[float] = None,
+        max_shadow_light_overlap: Optional[int] = None,
+        max_particle_overdraw: Optional[float] = None,
+        max_audio_voices: Optional[int] = None,
     ) -> Dict:
         args: Dict[str, Any] = {}
         if operator_only is not None:
@@ -414,8 +900,55 @@ class AgentForgeClient:
             args["max_cluster_count"] = int(max_cluster_count)
         if max_generation_time_ms is not None:
             args["max_generation_time_ms"] = float(max_generation_time_ms)
+        if cache_memory_mb is not None:
+            args["cache_memory_mb"] = float(cache_memory_mb)
+        if max_shadow_light_overlap is not None:
+            args["max_shadow_light_overlap"] = int(max_shadow_light_overlap)
+        if max_particle_overdraw is not None:
+            args["max_particle_overdraw"] = float(max_particle_overdraw)
+        if max_audio_voices is not None:
+            args["max_audio_voices"] = int(max_audio_voices)
         return self._send("set_operator_policy", args)
 
+    def run_benchmarks(
+        self,
+        cases: Optional[List[str]] = None,
+        point_counts: Optional[List[int]] = None,
+        heightmap_sizes: Optional[List[int]] = None,
+        repeats: Optional[int] = None,
+        seed: Optional[int] = None,
+        label: Optional[str] = None,
+        output_dir: Optional[str] = None,
+        run_async: bool = False,
+    ) -> Dict:
+        """
+        Benchmark the Distribution and Terrain functions and write JSON/CSV reports
+        to Saved/AgentForgeBenchmarks. With run_async=True, returns a job_id to poll
+        with get_job_status.
+        """
+        args: Dict[str, Any] = {}
+        if cases is not None:
+            args["cases"] = list(cases)
+        if point_counts is not None:
+            args["point_counts"] = [int(v) for v in point_counts]
+        if heightmap_sizes is not None:
+            args["heightmap_sizes"] = [int(v) for v in heightmap_sizes]
+        if repeats is not None:
+            args["repeats"] = int(repeats)
+        if seed is not None:
+            args["seed"] = int(seed)
+        if label is not None:
+            args["label"] = label
+        if output_dir is not None:
+            args["output_dir"] = output_dir
+        if run_async:
+            args["async"] = True
+        return self._send("run_benchmarks", args)
+
+    def clear_operator_cache(self, include_disk: bool = False) -> Dict:
+        """Drop cached heightmaps and distribution point sets (include_disk also clears Saved/AgentForgeCache)."""
+        return self._send("clear_operator_cache", {"include_disk": bool(include_disk)})
+
     @staticmethod
     def _apply_distribution_visual_args(
         args: Dict[str, Any],
@@ -425,6 +958,7 @@ class AgentForgeClient:
         min_spacing: Optional[float] = None,
         height_range: Optional[List[float]] = None,
         slope_range: Optional[List[float]] = None,
+        surface_source: Optional[str] = None,
         distance_mask: Optional[Dict[str, Any]] = None,
         seed: Optional[int] = None,
         palette_id: Optional[str] = None,
@@ -433,6 +967,7 @@ class AgentForgeClient:
         max_cluster_count: Optional[int] = None,
         max_generation_time_ms: Optional[float] = None,
         use_density_gradient: Optional[bool] = None,
+        fused_masks: Optional[bool] = None,
         density_sigma: Optional[float] = None,
         density_noise: Optional[float] = None,
         density_field_resolution: Optional[int] = None,
@@ -441,6 +976,9 @@ class AgentForgeClient:
         clearing_count: Optional[int] = None,
         clearing_radius_min: Optional[float] = None,
         clearing_radius_max: Optional[float] = None,
+        clearing_falloff: Optional[float] = None,
+        clearing_inner_density: Optional[float] = None,
+        clearing_min_gap: Optional[float] = None,
         biome_count: Optional[int] = None,
         biome_types: Optional[List[str]] = None,
         allowed_biomes: Optional[List[str]] = None,
@@ -451,6 +989,7 @@ class AgentForgeClient:
         prefer_radius: Optional[float] = None,
         prefer_strength: Optional[float] = None,
         interaction_rules: Optional[Dict[str, Any]] = None,
+        cache: Optional[str] = None,
     ) -> None:
         if distribution_mode is not None:
             args["distribution_mode"] = distribution_mode
@@ -464,6 +1003,8 @@ class AgentForgeClient:
             args["height_range"] = height_range
         if slope_range is not None:
             args["slope_range"] = slope_range
+        if surface_source is not None:
+            args["surface_source"] = str(surface_source)
         if distance_mask is not None:
             args["distance_mask"] = distance_mask
         if seed is not None:
@@ -480,6 +1021,8 @@ class AgentForgeClient:
             args["max_generation_time_ms"] = float(max_generation_time_ms)
         if use_density_gradient is not None:
             args["use_density_gradient"] = bool(use_density_gradient)
+        if fused_masks is not None:
+            args["fused_masks"] = bool(fused_masks)
         if density_sigma is not None:
             args["density_sigma"] = float(density_sigma)
         if density_noise is not None:
@@ -496,6 +1039,12 @@ class AgentForgeClient:
             args["clearing_radius_min"] = float(clearing_radius_min)
         if clearing_radius_max is not None:
             args["clearing_radius_max"] = float(clearing_radius_max)
+        if clearing_falloff is not None:
+            args["clearing_falloff"] = float(clearing_falloff)
+        if clearing_inner_density is not None:
+            args["clearing_inner_density"] = float(clearing_inner_density)
+        if clearing_min_gap is not None:
+            args["clearing_min_gap"] = float(clearing_min_gap)
         if biome_count is not None:
             args["biome_count"] = int(biome_count)
         if biome_types is not None:
@@ -516,6 +1065,29 @@ class AgentForgeClient:
             args["prefer_strength"] = float(prefer_strength)
         if interaction_rules is not None:
             args["interaction_rules"] = interaction_rules
+        if cache is not None:
+            args["cache"] = str(cache)
+
+    @staticmethod
+    def _apply_placement_args(
+        args: Dict[str, Any],
+        placement: Optional[str] = None,
+        cell_size: Optional[float] = None,
+        cull_distance: Optional[float] = None,
+        align_to_normal: Optional[bool] = None,
+        categories: Optional[List[str]] = None,
+    ) -> None:
+        """placement="native" materializes the points as per-cell HISM actors instead of running PCG."""
+        if placement is not None:
+            args["placement"] = str(placement)
+        if cell_size is not None:
+            args["cell_size"] = float(cell_size)
+        if cull_distance is not None:
+            args["cull_distance"] = float(cull_distance)
+        if align_to_normal is not None:
+            args["align_to_normal"] = bool(align_to_normal)
+        if categories is not None:
+            args["categories"] = [str(c) for c in categories]
 
     def op_terrain_generate(
         self,
@@ -529,6 +1101,27 @@ class AgentForgeClient:
         erosion_strength: float = 0.35,
         sediment_strength: Optional[float] = None,
         spawn_landscape: bool = False,
+        noise_type: Optional[str] = None,
+        octaves: Optional[int] = None,
+        lacunarity: Optional[float] = None,
+        gain: Optional[float] = None,
+        warp_strength: Optional[float] = None,
+        warp_frequency: Optional[float] = None,
+        ridge_frequency: Optional[float] = None,
+        ridge_octaves: Optional[int] = None,
+        erosion_mode: Optional[str] = None,
+        erosion_droplets: Optional[int] = None,
+        erosion_radius: Optional[int] = None,
+        erosion_lifetime: Optional[int] = None,
+        erosion_convergence: Optional[float] = None,
+        backend: Optional[str] = None,
+        tiled: Optional[bool] = None,
+        tile_size: Optional[int] = None,
+        tile_blend: Optional[int] = None,
+        heightmap_precision: Optional[str] = None,
+        export_path: Optional[str] = None,
+        import_path: Optional[str] = None,
+        cache: Optional[str] = None,
     ) -> Dict:
         args = {
             "seed": int(seed),
@@ -543,19 +1136,57 @@ class AgentForgeClient:
         }
         if sediment_strength is not None:
             args["sediment_strength"] = float(sediment_strength)
+        if noise_type is not None:
+            args["noise_type"] = str(noise_type)
+        if erosion_mode is not None:
+            args["erosion_mode"] = str(erosion_mode)
+        if backend is not None:
+            args["backend"] = str(backend)
+        if tiled is not None:
+            args["tiled"] = bool(tiled)
+        for key, value in (
+            ("heightmap_precision", heightmap_precision),
+            ("export_path", export_path),
+            ("import_path", import_path),
+            ("cache", cache),
+        ):
+            if value is not None:
+                args[key] = str(value)
+        for key, value in (
+            ("octaves", octaves),
+            ("ridge_octaves", ridge_octaves),
+            ("erosion_droplets", erosion_droplets),
+            ("erosion_radius", erosion_radius),
+            ("erosion_lifetime", erosion_lifetime),
+            ("tile_size", tile_size),
+            ("tile_blend", tile_blend),
+        ):
+            if value is not None:
+                args[key] = int(value)
+        for key, value in (
+            ("lacunarity", lacunarity),
+            ("gain", gain),
+            ("warp_strength", warp_strength),
+            ("warp_frequency", warp_frequency),
+            ("ridge_frequency", ridge_frequency),
+            ("erosion_convergence", erosion_convergence),
+        ):
+            if value is not None:
+                args[key] = float(value)
         return self._send("op_terrain_generate", args)
 
     def op_surface_scatter(
         self,
         target_label: str,
         parameters: Optional[Dict[str, Any]] = None,
-        generate: bool = True,
+        generate: Optional[bool] = None,
         distribution_mode: Optional[str] = None,
         density: Optional[float] = None,
         cluster_radius: Optional[float] = None,
         min_spacing: Optional[float] = None,
         height_range: Optional[List[float]] = None,
         slope_range: Optional[List[float]] = None,
+        surface_source: Optional[str] = None,
         distance_mask: Optional[Dict[str, Any]] = None,
         seed: Optional[int] = None,
         palette_id: Optional[str] = None,
@@ -564,6 +1195,7 @@ class AgentForgeClient:
         max_cluster_count: Optional[int] = None,
         max_generation_time_ms: Optional[float] = None,
         use_density_gradient: Optional[bool] = None,
+        fused_masks: Optional[bool] = None,
         density_sigma: Optional[float] = None,
         density_noise: Optional[float] = None,
         density_field_resolution: Optional[int] = None,
@@ -572,6 +1204,9 @@ class AgentForgeClient:
         clearing_count: Optional[int] = None,
         clearing_radius_min: Optional[float] = None,
         clearing_radius_max: Optional[float] = None,
+        clearing_falloff: Optional[float] = None,
+        clearing_inner_density: Optional[float] = None,
+        clearing_min_gap: Optional[float] = None,
         biome_count: Optional[int] = None,
         biome_types: Optional[List[str]] = None,
         allowed_biomes: Optional[List[str]] = None,
@@ -582,12 +1217,19 @@ class AgentForgeClient:
         prefer_radius: Optional[float] = None,
         prefer_strength: Optional[float] = None,
         interaction_rules: Optional[Dict[str, Any]] = None,
+        cache: Optional[str] = None,
+        placement: Optional[str] = None,
+        cell_size: Optional[float] = None,
+        cull_distance: Optional[float] = None,
+        align_to_normal: Optional[bool] = None,
+        categories: Optional[List[str]] = None,
     ) -> Dict:
         args: Dict[str, Any] = {
             "target_label": target_label,
             "parameters": parameters or {},
-            "generate": generate,
         }
+        if generate is not None:
+            args["generate"] = bool(generate)
         self._apply_distribution_visual_args(
             args,
             distribution_mode=distribution_mode,
@@ -596,6 +1238,7 @@ class AgentForgeClient:
             min_spacing=min_spacing,
             height_range=height_range,
             slope_range=slope_range,
+            surface_source=surface_source,
             distance_mask=distance_mask,
             seed=seed,
             palette_id=palette_id,
@@ -604,6 +1247,7 @@ class AgentForgeClient:
             max_cluster_count=max_cluster_count,
             max_generation_time_ms=max_generation_time_ms,
             use_density_gradient=use_density_gradient,
+            fused_masks=fused_masks,
             density_sigma=density_sigma,
             density_noise=density_noise,
             density_field_resolution=density_field_resolution,
@@ -612,6 +1256,9 @@ class AgentForgeClient:
             clearing_count=clearing_count,
             clearing_radius_min=clearing_radius_min,
             clearing_radius_max=clearing_radius_max,
+            clearing_falloff=clearing_falloff,
+            clearing_inner_density=clearing_inner_density,
+            clearing_min_gap=clearing_min_gap,
             biome_count=biome_count,
             biome_types=biome_types,
             allowed_biomes=allowed_biomes,
@@ -622,6 +1269,15 @@ class AgentForgeClient:
             prefer_radius=prefer_radius,
             prefer_strength=prefer_strength,
             interaction_rules=interaction_rules,
+            cache=cache,
+        )
+        self._apply_placement_args(
+            args,
+            placement=placement,
+            cell_size=cell_size,
+            cull_distance=cull_distance,
+            align_to_normal=align_to_normal,
+            categories=categories,
         )
         return self._send("op_surface_scatter", args)
 
@@ -631,13 +1287,14 @@ class AgentForgeClient:
         control_points: Optional[List[Dict[str, float]]] = None,
         parameters: Optional[Dict[str, Any]] = None,
         closed_loop: bool = False,
-        generate: bool = True,
+        generate: Optional[bool] = None,
         distribution_mode: Optional[str] = None,
         density: Optional[float] = None,
         cluster_radius: Optional[float] = None,
         min_spacing: Optional[float] = None,
         height_range: Optional[List[float]] = None,
         slope_range: Optional[List[float]] = None,
+        surface_source: Optional[str] = None,
         distance_mask: Optional[Dict[str, Any]] = None,
         seed: Optional[int] = None,
         palette_id: Optional[str] = None,
@@ -646,6 +1303,7 @@ class AgentForgeClient:
         max_cluster_count: Optional[int] = None,
         max_generation_time_ms: Optional[float] = None,
         use_density_gradient: Optional[bool] = None,
+        fused_masks: Optional[bool] = None,
         density_sigma: Optional[float] = None,
         density_noise: Optional[float] = None,
         density_field_resolution: Optional[int] = None,
@@ -654,6 +1312,9 @@ class AgentForgeClient:
         clearing_count: Optional[int] = None,
         clearing_radius_min: Optional[float] = None,
         clearing_radius_max: Optional[float] = None,
+        clearing_falloff: Optional[float] = None,
+        clearing_inner_density: Optional[float] = None,
+        clearing_min_gap: Optional[float] = None,
         biome_count: Optional[int] = None,
         biome_types: Optional[List[str]] = None,
         allowed_biomes: Optional[List[str]] = None,
@@ -664,13 +1325,20 @@ class AgentForgeClient:
         prefer_radius: Optional[float] = None,
         prefer_strength: Optional[float] = None,
         interaction_rules: Optional[Dict[str, Any]] = None,
+        cache: Optional[str] = None,
+        placement: Optional[str] = None,
+        cell_size: Optional[float] = None,
+        cull_distance: Optional[float] = None,
+        align_to_normal: Optional[bool] = None,
+        categories: Optional[List[str]] = None,
     ) -> Dict:
         args: Dict[str, Any] = {
             "spline_actor_label": spline_actor_label,
             "parameters": parameters or {},
             "closed_loop": closed_loop,
-            "generate": generate,
         }
+        if generate is not None:
+            args["generate"] = bool(generate)
         if control_points:
             args["control_points"] = control_points
         self._apply_distribution_visual_args(
@@ -681,6 +1349,7 @@ class AgentForgeClient:
             min_spacing=min_spacing,
             height_range=height_range,
             slope_range=slope_range,
+            surface_source=surface_source,
             distance_mask=distance_mask,
             seed=seed,
             palette_id=palette_id,
@@ -689,6 +1358,7 @@ class AgentForgeClient:
             max_cluster_count=max_cluster_count,
             max_generation_time_ms=max_generation_time_ms,
             use_density_gradient=use_density_gradient,
+            fused_masks=fused_masks,
             density_sigma=density_sigma,
             density_noise=density_noise,
             density_field_resolution=density_field_resolution,
@@ -697,6 +1367,9 @@ class AgentForgeClient:
             clearing_count=clearing_count,
             clearing_radius_min=clearing_radius_min,
             clearing_radius_max=clearing_radius_max,
+            clearing_falloff=clearing_falloff,
+            clearing_inner_density=clearing_inner_density,
+            clearing_min_gap=clearing_min_gap,
             biome_count=biome_count,
             biome_types=biome_types,
             allowed_biomes=allowed_biomes,
@@ -707,6 +1380,15 @@ class AgentForgeClient:
             prefer_radius=prefer_radius,
             prefer_strength=prefer_strength,
             interaction_rules=interaction_rules,
+            cache=cache,
+        )
+        self._apply_placement_args(
+            args,
+            placement=placement,
+            cell_size=cell_size,
+            cull_distance=cull_distance,
+            align_to_normal=align_to_normal,
+            categories=categories,
         )
         return self._send("op_spline_scatter", args)
 
@@ -741,6 +1423,7 @@ class AgentForgeClient:
         min_spacing: Optional[float] = None,
         height_range: Optional[List[float]] = None,
         slope_range: Optional[List[float]] = None,
+        surface_source: Optional[str] = None,
         distance_mask: Optional[Dict[str, Any]] = None,
         seed: Optional[int] = None,
         palette_id: Optional[str] = None,
@@ -749,6 +1432,7 @@ class AgentForgeClient:
         max_cluster_count: Optional[int] = None,
         max_generation_time_ms: Optional[float] = None,
         use_density_gradient: Optional[bool] = None,
+        fused_masks: Optional[bool] = None,
         density_sigma: Optional[float] = None,
         density_noise: Optional[float] = None,
         density_field_resolution: Optional[int] = None,
@@ -757,6 +1441,9 @@ class AgentForgeClient:
         clearing_count: Optional[int] = None,
         clearing_radius_min: Optional[float] = None,
         clearing_radius_max: Optional[float] = None,
+        clearing_falloff: Optional[float] = None,
+        clearing_inner_density: Optional[float] = None,
+        clearing_min_gap: Optional[float] = None,
         biome_count: Optional[int] = None,
         biome_types: Optional[List[str]] = None,
         allowed_biomes: Optional[List[str]] = None,
@@ -767,6 +1454,7 @@ class AgentForgeClient:
         prefer_radius: Optional[float] = None,
         prefer_strength: Optional[float] = None,
         interaction_rules: Optional[Dict[str, Any]] = None,
+        cache: Optional[str] = None,
     ) -> Dict:
         args: Dict[str, Any] = {"target_label": target_label, "generate": generate}
         if layers:
@@ -781,6 +1469,7 @@ class AgentForgeClient:
             min_spacing=min_spacing,
             height_range=height_range,
             slope_range=slope_range,
+            surface_source=surface_source,
             distance_mask=distance_mask,
             seed=seed,
             palette_id=palette_id,
@@ -789,6 +1478,7 @@ class AgentForgeClient:
             max_cluster_count=max_cluster_count,
             max_generation_time_ms=max_generation_time_ms,
             use_density_gradient=use_density_gradient,
+            fused_masks=fused_masks,
             density_sigma=density_sigma,
             density_noise=density_noise,
             density_field_resolution=density_field_resolution,
@@ -797,6 +1487,9 @@ class AgentForgeClient:
             clearing_count=clearing_count,
             clearing_radius_min=clearing_radius_min,
             clearing_radius_max=clearing_radius_max,
+            clearing_falloff=clearing_falloff,
+            clearing_inner_density=clearing_inner_density,
+            clearing_min_gap=clearing_min_gap,
             biome_count=biome_count,
             biome_types=biome_types,
             allowed_biomes=allowed_biomes,
@@ -807,6 +1500,7 @@ class AgentForgeClient:
             prefer_radius=prefer_radius,
             prefer_strength=prefer_strength,
             interaction_rules=interaction_rules,
+            cache=cache,
         )
         return self._send("op_biome_layers", args)
 
@@ -848,12 +1542,14 @@ class AgentForgeClient:
         min_spacing: Optional[float] = None,
         height_range: Optional[List[float]] = None,
         slope_range: Optional[List[float]] = None,
+        surface_source: Optional[str] = None,
         distance_mask: Optional[Dict[str, Any]] = None,
         cluster_count: Optional[int] = None,
         max_spawn_points: Optional[int] = None,
         max_cluster_count: Optional[int] = None,
         max_generation_time_ms: Optional[float] = None,
         use_density_gradient: Optional[bool] = None,
+        fused_masks: Optional[bool] = None,
         density_sigma: Optional[float] = None,
         density_noise: Optional[float] = None,
         density_field_resolution: Optional[int] = None,
@@ -862,6 +1558,9 @@ class AgentForgeClient:
         clearing_count: Optional[int] = None,
         clearing_radius_min: Optional[float] = None,
         clearing_radius_max: Optional[float] = None,
+        clearing_falloff: Optional[float] = None,
+        clearing_inner_density: Optional[float] = None,
+        clearing_min_gap: Optional[float] = None,
         biome_count: Optional[int] = None,
         biome_types: Optional[List[str]] = None,
         allowed_biomes: Optional[List[str]] = None,
@@ -872,15 +1571,23 @@ class AgentForgeClient:
         prefer_radius: Optional[float] = None,
         prefer_strength: Optional[float] = None,
         interaction_rules: Optional[Dict[str, Any]] = None,
+        cache: Optional[str] = None,
         stop_on_error: bool = True,
         max_actor_delta: Optional[int] = None,
         max_memory_used_mb: Optional[float] = None,
         allow_menu_level: bool = False,
+        undo_mode: Optional[str] = None,
     ) -> Dict:
+        """
+        undo_mode: "full" (default, one editor transaction), "snapshot" (record
+        the spawned actors; undo with undo_operator_pipeline) or "none".
+        """
         args: Dict[str, Any] = {
             "stop_on_error": stop_on_error,
             "allow_menu_level": bool(allow_menu_level),
         }
+        if undo_mode is not None:
+            args["undo_mode"] = undo_mode
         if terrain is not None:
             args["terrain"] = terrain
         if surface is not None:
@@ -905,12 +1612,14 @@ class AgentForgeClient:
             min_spacing=min_spacing,
             height_range=height_range,
             slope_range=slope_range,
+            surface_source=surface_source,
             distance_mask=distance_mask,
             cluster_count=cluster_count,
             max_spawn_points=max_spawn_points,
             max_cluster_count=max_cluster_count,
             max_generation_time_ms=max_generation_time_ms,
             use_density_gradient=use_density_gradient,
+            fused_masks=fused_masks,
             density_sigma=density_sigma,
             density_noise=density_noise,
             density_field_resolution=density_field_resolution,
@@ -919,6 +1628,9 @@ class AgentForgeClient:
             clearing_count=clearing_count,
             clearing_radius_min=clearing_radius_min,
             clearing_radius_max=clearing_radius_max,
+            clearing_falloff=clearing_falloff,
+            clearing_inner_density=clearing_inner_density,
+            clearing_min_gap=clearing_min_gap,
             biome_count=biome_count,
             biome_types=biome_types,
             allowed_biomes=allowed_biomes,
@@ -929,6 +1641,7 @@ class AgentForgeClient:
             prefer_radius=prefer_radius,
             prefer_strength=prefer_strength,
             interaction_rules=interaction_rules,
+            cache=cache,
         )
         if max_actor_delta is not None:
             args["max_actor_delta"] = int(max_actor_delta)
@@ -936,6 +1649,13 @@ class AgentForgeClient:
             args["max_memory_used_mb"] = float(max_memory_used_mb)
         return self._send("run_operator_pipeline", args)
 
+    def undo_operator_pipeline(self, pipeline_id: Optional[str] = None) -> Dict:
+        """Destroy the actors of an undo_mode="snapshot" pipeline run (default: the latest)."""
+        args: Dict[str, Any] = {}
+        if pipeline_id:
+            args["pipeline_id"] = pipeline_id
+        return self._send("undo_operator_pipeline", args)
+
     # â”€â”€ Actor control â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€
     def spawn_actor(
         self,
@@ -1097,6 +1817,7 @@ class AgentForgeClient:
         window_walls: Optional[List[str]] = None,
         label: str = "Room",
         slab_thickness: float = 10.0,
+        output: str = "actors",
     ) -> ForgeResult:
         return self.execute("create_room", {
             "center_x": center_x,
@@ -1113,6 +1834,7 @@ class AgentForgeClient:
             "window_walls": window_walls or [],
             "label": label,
             "slab_thickness": slab_thickness,
+            "output": output,
         })
 
     def create_corridor(
@@ -1130,6 +1852,7 @@ class AgentForgeClient:
         z: float = 0.0,
         wall_thickness: float = 20.0,
         slab_thickness: float = 10.0,
+        output: str = "actors",
     ) -> ForgeResult:
         return self.execute("create_corridor", {
             "start_x": start_x,
@@ -1145,6 +1868,7 @@ class AgentForgeClient:
             "z": z,
             "wall_thickness": wall_thickness,
             "slab_thickness": slab_thickness,
+            "output": output,
         })
 
     def create_staircase(
@@ -1209,8 +1933,12 @@ class AgentForgeClient:
         material_path: str = "",
         label_prefix: str = "ScatterProp",
         z: float = 0.0,
+        output: str = "actors",
+        tint: Optional[Dict[str, float]] = None,
+        tint_variation: float = 0.0,
     ) -> ForgeResult:
-        return self.execute("scatter_props", {
+        """output="instances" writes one HISM per mesh/material instead of one actor per prop."""
+        args: Dict[str, Any] = {
             "mesh_path": mesh_path,
             "center_x": center_x,
             "center_y": center_y,
@@ -1223,7 +1951,13 @@ class AgentForgeClient:
             "material_path": material_path,
             "label_prefix": label_prefix,
             "z": z,
-        })
+            "output": output,
+        }
+        if output == "instances":
+            if tint is not None:
+                args["tint"] = tint
+            args["tint_variation"] = tint_variation
+        return self.execute("scatter_props", args)
 
     def delete_actor(self, label: str) -> ForgeResult:
         return self.execute("delete_actor", {"label": label})
@@ -1565,7 +2299,12 @@ unreal.EditorAssetLibrary.save_asset(asset_path)
         center_x: Optional[float] = None,
         center_y: Optional[float] = None,
         center_z: Optional[float] = None,
+        render: bool = False,
+        width: Optional[int] = None,
+        height: Optional[int] = None,
+        fov: Optional[float] = None,
     ) -> Dict:
+        """render=True captures off-screen (angle="all" for every preset) and returns image_paths."""
         args: Dict[str, Any] = {"angle": angle, "orbit_radius": orbit_radius}
         if center_x is not None:
             args["center_x"] = center_x
@@ -1573,10 +2312,20 @@ unreal.EditorAssetLibrary.save_asset(asset_path)
             args["center_y"] = center_y
         if center_z is not None:
             args["center_z"] = center_z
+        if render:
+            args["render"] = True
+        if width is not None:
+            args["width"] = width
+        if height is not None:
+            args["height"] = height
+        if fov is not None:
+            args["fov"] = fov
         return self._send("get_multi_view_capture", args)
 
-    def get_semantic_env_snapshot(self) -> Dict:
-        return self._send("get_semantic_env_snapshot")
+    def get_semantic_env_snapshot(self, since_revision: Optional[int] = None) -> Dict:
+        if since_revision is None:
+            return self._send("get_semantic_env_snapshot")
+        return self._send("get_semantic_env_snapshot", {"since_revision": int(since_revision)})
 
     def place_asset_thematically(
         self,
@@ -1627,8 +2376,20 @@ unreal.EditorAssetLibrary.save_asset(asset_path)
         max_tokens: int = 1024,
         temperature: float = 0.7,
         custom_endpoint: str = "",
+        cache: str = "bypass",
+        prompt_cache: bool = False,
+        priority: str = "interactive",
+        fan_out: Optional[List[Dict[str, str]]] = None,
+        fan_out_mode: str = "first",
+        hedge_delay_ms: float = 0.0,
     ) -> ForgeResult:
-        return self.execute("llm_chat", {
+        """cache: "bypass" | "prefer" (replay an identical earlier request) | "only" (never call the provider).
+        prompt_cache: let the provider cache the system prompt and messages flagged "cache_breakpoint".
+        priority: "interactive" | "background" scheduler lane.
+        fan_out: extra [{"provider", "model"?, "custom_endpoint"?}] candidates raced against provider/model;
+        fan_out_mode "first" keeps the first acceptable answer, "all" waits for every candidate.
+        hedge_delay_ms holds the extra candidates back so a fast primary cancels them unsent."""
+        args: Dict[str, Any] = {
             "provider": provider,
             "model": model,
             "messages": messages,
@@ -1636,7 +2397,13 @@ unreal.EditorAssetLibrary.save_asset(asset_path)
             "max_tokens": int(max_tokens),
             "temperature": float(temperature),
             "custom_endpoint": custom_endpoint,
-        })
+            "cache": cache,
+            "prompt_cache": bool(prompt_cache),
+            "priority": priority,
+        }
+        if fan_out:
+            args.update(fan_out=list(fan_out), fan_out_mode=fan_out_mode, hedge_delay_ms=float(hedge_delay_ms))
+        return self.execute("llm_chat", args)
 
     def llm_stream(
         self,
@@ -1647,8 +2414,18 @@ unreal.EditorAssetLibrary.save_asset(asset_path)
         max_tokens: int = 1024,
         temperature: float = 0.7,
         custom_endpoint: str = "",
+        run_async: bool = False,
+        cache: str = "bypass",
+        prompt_cache: bool = False,
+        priority: str = "interactive",
     ) -> ForgeResult:
-        return self.execute("llm_stream", {
+        """
+        Provider SSE streaming. Over the socket transport each delta arrives as a
+        stream_chunk event (see poll_events) while the request runs; with
+        run_async=True the call returns a job_id and the chunks also collect in
+        the job's partial_results.
+        """
+        args: Dict[str, Any] = {
             "provider": provider,
             "model": model,
             "messages": messages,
@@ -1656,7 +2433,13 @@ unreal.EditorAssetLibrary.save_asset(asset_path)
             "max_tokens": int(max_tokens),
             "temperature": float(temperature),
             "custom_endpoint": custom_endpoint,
-        })
+            "cache": cache,
+            "prompt_cache": bool(prompt_cache),
+            "priority": priority,
+        }
+        if run_async:
+            args["async"] = True
+        return self.execute("llm_stream", args)
 
     def llm_structured(
         self,
@@ -1668,8 +2451,15 @@ unreal.EditorAssetLibrary.save_asset(asset_path)
         max_tokens: int = 1024,
         temperature: float = 0.2,
         custom_endpoint: str = "",
+        cache: str = "bypass",
+        prompt_cache: bool = False,
+        priority: str = "interactive",
+        fan_out: Optional[List[Dict[str, str]]] = None,
+        fan_out_mode: str = "first",
+        hedge_delay_ms: float = 0.0,
     ) -> ForgeResult:
-        return self.execute("llm_structured", {
+        """fan_out / fan_out_mode / hedge_delay_ms as in llm_chat; only schema-valid answers win."""
+        args: Dict[str, Any] = {
             "provider": provider,
             "model": model,
             "prompt": prompt,
@@ -1678,7 +2468,13 @@ unreal.EditorAssetLibrary.save_asset(asset_path)
             "max_tokens": int(max_tokens),
             "temperature": float(temperature),
             "custom_endpoint": custom_endpoint,
-        })
+            "cache": cache,
+            "prompt_cache": bool(prompt_cache),
+            "priority": priority,
+        }
+        if fan_out:
+            args.update(fan_out=list(fan_out), fan_out_mode=fan_out_mode, hedge_delay_ms=float(hedge_delay_ms))
+        return self.execute("llm_structured", args)
 
     def llm_structured_from_schema(
         self,
@@ -1690,6 +2486,12 @@ unreal.EditorAssetLibrary.save_asset(asset_path)
         max_tokens: int = 1024,
         temperature: float = 0.2,
         custom_endpoint: str = "",
+        cache: str = "bypass",
+        prompt_cache: bool = False,
+        priority: str = "interactive",
+        fan_out: Optional[List[Dict[str, str]]] = None,
+        fan_out_mode: str = "first",
+        hedge_delay_ms: float = 0.0,
     ) -> ForgeResult:
         return self.llm_structured(
             provider=provider,
@@ -1700,6 +2502,12 @@ unreal.EditorAssetLibrary.save_asset(asset_path)
             max_tokens=max_tokens,
             temperature=temperature,
             custom_endpoint=custom_endpoint,
+            cache=cache,
+            prompt_cache=prompt_cache,
+            priority=priority,
+            fan_out=fan_out,
+            fan_out_mode=fan_out_mode,
+            hedge_delay_ms=hedge_delay_ms,
         )
 
     def generate_npc_personality(
@@ -1771,8 +2579,11 @@ unreal.EditorAssetLibrary.save_asset(asset_path)
         provider: str = "",
         model: str = "",
         multi_view: bool = False,
+        use_cache: bool = True,
     ) -> ForgeResult:
         args: Dict[str, Any] = {"multi_view": bool(multi_view)}
+        if not use_cache:
+            args["use_cache"] = False
         if prompt:
             args["prompt"] = prompt
         if provider:
@@ -1786,14 +2597,58 @@ unreal.EditorAssetLibrary.save_asset(asset_path)
         provider: str = "",
         model: str = "",
         multi_view: bool = False,
+        use_cache: bool = True,
+        fan_out: Optional[List[Dict[str, str]]] = None,
+        fan_out_mode: str = "first",
+        hedge_delay_ms: float = 0.0,
     ) -> ForgeResult:
+        """fan_out scores the same capture with more providers; fan_out_mode="all" reports the median score."""
         args: Dict[str, Any] = {"multi_view": bool(multi_view)}
+        if not use_cache:
+            args["use_cache"] = False
         if provider:
             args["provider"] = provider
         if model:
             args["model"] = model
+        if fan_out:
+            args.update(fan_out=list(fan_out), fan_out_mode=fan_out_mode, hedge_delay_ms=float(hedge_delay_ms))
         return self.execute("vision_quality_score", args)
 
+    def set_vision_cache_policy(self, **policy: Any) -> ForgeResult:
+        """enabled, min_similarity, max_hash_distance, max_age_seconds, capacity, clear."""
+        return self.execute("set_vision_cache_policy", dict(policy))
+
+    def set_llm_cache_policy(self, **policy: Any) -> ForgeResult:
+        """ttl_seconds, memory_entries, disk_budget_mb, disk, clear, clear_disk."""
+        return self.execute("set_llm_cache_policy", dict(policy))
+
+    def set_llm_scheduler_policy(self, **policy: Any) -> ForgeResult:
+        """provider, max_concurrent, max_retries, backoff_base_ms, backoff_max_ms."""
+        return self.execute("set_llm_scheduler_policy", dict(policy))
+
+    def validate_json(
+        self,
+        value: Any = None,
+        schema: Optional[Dict[str, Any]] = None,
+        schema_name: str = "",
+        json_text: str = "",
+        reload: bool = False,
+    ) -> ForgeResult:
+        """Validate a payload (or JSON text) against a schema or a bundled schema_name with the
+        editor's compiled validators. Returns valid and error (the first failing path)."""
+        args: Dict[str, Any] = {}
+        if json_text:
+            args["json"] = json_text
+        else:
+            args["value"] = value
+        if schema_name:
+            args["schema_name"] = schema_name
+        else:
+            args["schema"] = schema or {}
+        if reload:
+            args["reload"] = True
+        return self.execute("validate_json", args)
+
     # â”€â”€ Material instancing â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€
     def create_material_instance(
         self, parent_material: str, instance_name: str, output_path: str
@@ -1881,8 +2736,19 @@ unreal.EditorAssetLibrary.save_asset(asset_path)
     def undo_transaction(self) -> ForgeResult:
         return self.execute("undo_transaction")
 
-    def create_snapshot(self, snapshot_name: str = "") -> ForgeResult:
-        return self.execute("create_snapshot", {"snapshot_name": snapshot_name})
+    def create_snapshot(self, snapshot_name: str = "", json_export: bool = False) -> ForgeResult:
+        """Binary .afsnap snapshot of every actor; json_export also writes the JSON form."""
+        args: Dict[str, Any] = {"snapshot_name": snapshot_name}
+        if json_export:
+            args["json"] = True
+        return self.execute("create_snapshot", args)
+
+    def set_verification_policy(self, rollback_scope: str = "") -> ForgeResult:
+        """rollback_scope: "scoped" checks only the actors a command touched, "full" the whole level."""
+        args: Dict[str, Any] = {}
+        if rollback_scope:
+            args["rollback_scope"] = rollback_scope
+        return self.execute("set_verification_policy", args)
 
     # â”€â”€ Python scripting â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€
     def execute_python(self, script: str) -> ForgeResult:
@@ -1982,6 +2848,17 @@ unreal.EditorAssetLibrary.save_asset(asset_path)
     def get_perf_stats(self) -> Dict:
         return self._send("get_perf_stats")
 
+    def get_command_metrics(self, cmd: str = "", reset: bool = False) -> Dict:
+        """
+        Per-command latency metrics: {"bucket_le_ms", "window_size", "commands":
+        {name: {"calls", "errors", "mean_ms", "p50_ms", "p95_ms", "p99_ms", "histogram", ...}}}.
+        reset=True clears them after reporting.
+        """
+        args: Dict[str, Any] = {"reset": reset}
+        if cmd:
+            args["cmd"] = cmd
+        return self._send("get_command_metrics", args)
+
     # â”€â”€ Scene setup â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€â”€
     def setup_test_level(self, floor_size: float = 10000.0) -> ForgeResult:
         return self.execute("setup_test_level", {"floor_size": floor_size})
@@ -0,0 +1,961 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeActorIndex.cpp — event-maintained actor lookup maps and spatial grid.
+
+#include "AgentForgeActorIndex.h"
+
+#include "Components/ActorComponent.h"
+#include "Dom/JsonValue.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Actor.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/Crc.h"
+#include "Misc/DateTime.h"
+#include "UObject/UObjectGlobals.h"
+
+#if WITH_EDITOR
+#include "Editor.h"
+#endif
+
+namespace
+{
+	static UWorld* GetIndexEditorWorld()
+	{
+#if WITH_EDITOR
+		return GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+#else
+		return nullptr;
+#endif
+	}
+
+	template <typename KeyType>
+	static void AddToList(TMap<KeyType, TArray<TWeakObjectPtr<AActor>, TInlineAllocator<1>>>& Map, const KeyType& Key, const TWeakObjectPtr<AActor>& Actor)
+	{
+		Map.FindOrAdd(Key).Add(Actor);
+	}
+
+	template <typename KeyType>
+	static void RemoveFromList(TMap<KeyType, TArray<TWeakObjectPtr<AActor>, TInlineAllocator<1>>>& Map, const KeyType& Key, const TWeakObjectPtr<AActor>& Actor)
+	{
+		if (auto* List = Map.Find(Key))
+		{
+			List->RemoveSingleSwap(Actor, EAllowShrinking::No);
+			if (List->Num() == 0)
+			{
+				Map.Remove(Key);
+			}
+		}
+	}
+}
+
+FAgentForgeActorIndex& FAgentForgeActorIndex::Get()
+{
+	static FAgentForgeActorIndex Index;
+	return Index;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Lifetime
+// ─────────────────────────────────────────────────────────────────────────────
+void FAgentForgeActorIndex::Initialize()
+{
+	check(IsInGameThread());
+	if (bInitialized)
+	{
+		return;
+	}
+	bInitialized = true;
+	bDirty = true;
+
+	// Revisions count up from the session start in ms, so a token from an
+	// earlier editor session always lands below this session's floor.
+	Revision = FMath::Max(Revision, FDateTime::UtcNow().ToUnixTimestamp() * 1000);
+	HistoryFloor = Revision;
+
+#if WITH_EDITOR
+	LabelChangedHandle   = FCoreDelegates::OnActorLabelChanged.AddRaw(this, &FAgentForgeActorIndex::HandleActorChanged);
+	ObjectModifiedHandle = FCoreUObjectDelegates::OnObjectModified.AddRaw(this, &FAgentForgeActorIndex::HandleObjectModified);
+	UndoRedoHandle       = FEditorDelegates::PostUndoRedo.AddRaw(this, &FAgentForgeActorIndex::HandleUndoRedo);
+	MapChangeHandle      = FEditorDelegates::MapChange.AddRaw(this, &FAgentForgeActorIndex::HandleMapChange);
+#endif
+	LevelAddedHandle     = FWorldDelegates::LevelAddedToWorld.AddRaw(this, &FAgentForgeActorIndex::HandleLevelChanged);
+	LevelRemovedHandle   = FWorldDelegates::LevelRemovedFromWorld.AddRaw(this, &FAgentForgeActorIndex::HandleLevelChanged);
+	HookEngineEvents();
+}
+
+void FAgentForgeActorIndex::HookEngineEvents()
+{
+	if (bEngineHooked || !GEngine)
+	{
+		return;
+	}
+	bEngineHooked      = true;
+	ActorAddedHandle   = GEngine->OnLevelActorAdded().AddRaw(this, &FAgentForgeActorIndex::HandleActorAdded);
+	ActorDeletedHandle = GEngine->OnLevelActorDeleted().AddRaw(this, &FAgentForgeActorIndex::HandleActorDeleted);
+#if WITH_EDITOR
+	if (GEditor)
+	{
+		ActorMovedHandle = GEditor->OnActorMoved().AddRaw(this, &FAgentForgeActorIndex::HandleActorChanged);
+	}
+#endif
+	bDirty = true;   // anything spawned before the hook was missed
+}
+
+void FAgentForgeActorIndex::Shutdown()
+{
+	if (!bInitialized)
+	{
+		return;
+	}
+	bInitialized = false;
+
+#if WITH_EDITOR
+	FCoreDelegates::OnActorLabelChanged.Remove(LabelChangedHandle);
+	FCoreUObjectDelegates::OnObjectModified.Remove(ObjectModifiedHandle);
+	FEditorDelegates::PostUndoRedo.Remove(UndoRedoHandle);
+	FEditorDelegates::MapChange.Remove(MapChangeHandle);
+#endif
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+	if (bEngineHooked && GEngine)
+	{
+		GEngine->OnLevelActorAdded().Remove(ActorAddedHandle);
+		GEngine->OnLevelActorDeleted().Remove(ActorDeletedHandle);
+	}
+#if WITH_EDITOR
+	if (bEngineHooked && GEditor)
+	{
+		GEditor->OnActorMoved().Remove(ActorMovedHandle);
+	}
+#endif
+	bEngineHooked = false;
+
+	Entries.Reset();
+	ByLabel.Reset();
+	ByName.Reset();
+	ByPath.Reset();
+	ByTag.Reset();
+	Cells.Reset();
+	Stale.Reset();
+	Changes.Reset();
+	IndexedWorld.Reset();
+	bDirty = true;
+	bLevelBoundsDirty = true;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Maintenance
+// ─────────────────────────────────────────────────────────────────────────────
+UWorld* FAgentForgeActorIndex::Prepare()
+{
+	check(IsInGameThread());
+	HookEngineEvents();
+
+	UWorld* World = GetIndexEditorWorld();
+	if (!World)
+	{
+		return nullptr;
+	}
+	if (!bInitialized || !bEngineHooked)
+	{
+		// Events are not flowing; an index would go stale silently.
+		return nullptr;
+	}
+	if (bDirty || IndexedWorld.Get() != World)
+	{
+		Rebuild(World);
+	}
+	else if (Stale.Num() > 0)
+	{
+		FlushStale();
+	}
+	return World;
+}
+
+void FAgentForgeActorIndex::Rebuild(UWorld* World)
+{
+	const double Start = FPlatformTime::Seconds();
+
+	// Same world (undo/redo, streaming): diff against the old entries so the
+	// rebuild still yields per-actor changes.
+	const bool bSameWorld = IndexedWorld.IsValid() && IndexedWorld.Get() == World;
+	TMap<TWeakObjectPtr<AActor>, FEntry> Previous = MoveTemp(Entries);
+	Entries.Reset();
+	ByLabel.Reset();
+	ByName.Reset();
+	ByPath.Reset();
+	ByTag.Reset();
+	Cells.Reset();
+	Stale.Reset();
+	IndexedWorld = World;
+	bLevelBoundsDirty = true;
+
+	for (TActorIterator<AActor> It(World); It; ++It)
+	{
+		if (IsIndexable(*It))
+		{
+			AddActor(*It);
+		}
+	}
+
+	if (bSameWorld)
+	{
+		for (const TPair<TWeakObjectPtr<AActor>, FEntry>& Pair : Previous)
+		{
+			const FEntry* Now = Entries.Find(Pair.Key);
+			if (!Now)
+			{
+				NoteChange(Pair.Key, EChange::Removed, &Pair.Value);
+			}
+			else if (Now->Signature != Pair.Value.Signature)
+			{
+				NoteChange(Pair.Key, EChange::Modified, Now);
+			}
+		}
+		for (const TPair<TWeakObjectPtr<AActor>, FEntry>& Pair : Entries)
+		{
+			if (!Previous.Contains(Pair.Key))
+			{
+				NoteChange(Pair.Key, EChange::Added, &Pair.Value);
+			}
+		}
+	}
+	else
+	{
+		ResetHistory();
+	}
+
+	bDirty = false;
+	++Rebuilds;
+	LastRebuildMs = (FPlatformTime::Seconds() - Start) * 1000.0;
+}
+
+void FAgentForgeActorIndex::FlushStale()
+{
+	TSet<TWeakObjectPtr<AActor>> Pending = MoveTemp(Stale);
+	Stale.Reset();
+	for (const TWeakObjectPtr<AActor>& Weak : Pending)
+	{
+		FEntry Previous;
+		const bool bWasIndexed = RemoveActor(Weak, &Previous);
+		AActor* Actor = Weak.Get();
+		if (IsIndexable(Actor))
+		{
+			AddActor(Actor);
+		}
+		else if (bWasIndexed)
+		{
+			// Gone without a delete event (GC, level unload).
+			NoteChange(Weak, EChange::Removed, &Previous);
+		}
+		++Rekeys;
+	}
+}
+
+bool FAgentForgeActorIndex::IsIndexable(const AActor* Actor) const
+{
+	return Actor && IsValid(Actor) && !Actor->IsActorBeingDestroyed() && Actor->GetWorld() == IndexedWorld.Get();
+}
+
+void FAgentForgeActorIndex::AddActor(AActor* Actor)
+{
+	const TWeakObjectPtr<AActor> Weak(Actor);
+	RemoveActor(Weak);
+
+	FEntry Entry;
+	Entry.Label = Actor->GetActorLabel();
+	Entry.Name  = Actor->GetName();
+	Entry.Path  = Actor->GetPathName();
+	Entry.Tags  = Actor->Tags;
+	Entry.Cell  = CellOf(Actor->GetActorLocation());
+	Entry.Signature = SignatureOf(Actor);
+
+	FVector Origin, Extent;
+	Actor->GetActorBounds(false, Origin, Extent);
+	if (!Extent.IsNearlyZero())
+	{
+		Entry.Bounds = FBox::BuildAABB(Origin, Extent);
+	}
+
+	if (!Entry.Label.IsEmpty()) { AddToList(ByLabel, Entry.Label, Weak); }
+	AddToList(ByName, Entry.Name, Weak);
+	AddToList(ByPath, Entry.Path, Weak);
+	for (const FName& Tag : Entry.Tags)
+	{
+		AddToList(ByTag, Tag, Weak);
+	}
+	AddToList(Cells, Entry.Cell, Weak);
+	Entries.Add(Weak, MoveTemp(Entry));
+	bLevelBoundsDirty = true;
+}
+
+bool FAgentForgeActorIndex::RemoveActor(const TWeakObjectPtr<AActor>& Actor, FEntry* OutEntry)
+{
+	FEntry Entry;
+	if (!Entries.RemoveAndCopyValue(Actor, Entry))
+	{
+		return false;
+	}
+	RemoveFromList(ByLabel, Entry.Label, Actor);
+	RemoveFromList(ByName, Entry.Name, Actor);
+	RemoveFromList(ByPath, Entry.Path, Actor);
+	for (const FName& Tag : Entry.Tags)
+	{
+		RemoveFromList(ByTag, Tag, Actor);
+	}
+	RemoveFromList(Cells, Entry.Cell, Actor);
+	bLevelBoundsDirty = true;
+	if (OutEntry)
+	{
+		*OutEntry = MoveTemp(Entry);
+	}
+	return true;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Events
+// ─────────────────────────────────────────────────────────────────────────────
+void FAgentForgeActorIndex::HandleActorAdded(AActor* Actor)
+{
+	NoteChange(Actor, EChange::Added);
+	// Deferred: spawn commands set the label right after the actor is added.
+	if (!bDirty && IsIndexable(Actor))
+	{
+		Stale.Add(Actor);
+	}
+}
+
+void FAgentForgeActorIndex::HandleActorDeleted(AActor* Actor)
+{
+	if (Actor && Actor->GetWorld() == IndexedWorld.Get())
+	{
+		// The weak pointer may already refuse to resolve; capture identity from the raw actor.
+		FEntry Gone;
+		Gone.Label = Actor->GetActorLabel();
+		Gone.Name  = Actor->GetName();
+		Gone.Path  = Actor->GetPathName();
+		NoteChange(Actor, EChange::Removed, &Gone);
+	}
+	if (!bDirty && Actor)
+	{
+		const TWeakObjectPtr<AActor> Weak(Actor);
+		Stale.Remove(Weak);
+		RemoveActor(Weak);
+	}
+}
+
+void FAgentForgeActorIndex::HandleActorChanged(AActor* Actor)
+{
+	NoteChange(Actor, EChange::Modified);
+	if (!bDirty && Actor && Actor->GetWorld() == IndexedWorld.Get())
+	{
+		Stale.Add(Actor);
+	}
+}
+
+void FAgentForgeActorIndex::HandleObjectModified(UObject* Object)
+{
+	// Modify() precedes tag / name / outer / transform changes; re-key at the next lookup.
+	if (AActor* Actor = Cast<AActor>(Object))
+	{
+		HandleActorChanged(Actor);
+	}
+	else if (const UActorComponent* Component = Cast<UActorComponent>(Object))
+	{
+		HandleActorChanged(Component->GetOwner());
+	}
+}
+
+void FAgentForgeActorIndex::HandleLevelChanged(ULevel* Level, UWorld* World)
+{
+	if (World && World == IndexedWorld.Get())
+	{
+		Invalidate();
+	}
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Lookups
+// ─────────────────────────────────────────────────────────────────────────────
+AActor* FAgentForgeActorIndex::FindInMap(EKey Key, const FString& Value)
+{
+	TMap<FString, FActorList>& Map =
+		Key == EKey::Label ? ByLabel :
+		Key == EKey::Name  ? ByName  : ByPath;
+
+	// A mismatch means the actor changed without an event we track; re-key it
+	// and look once more.
+	for (int32 Attempt = 0; Attempt < 2; ++Attempt)
+	{
+		const FActorList* List = Map.Find(Value);
+		if (!List)
+		{
+			return nullptr;
+		}
+
+		bool bFoundStale = false;
+		for (const TWeakObjectPtr<AActor>& Weak : *List)
+		{
+			AActor* Actor = Weak.Get();
+			if (!IsIndexable(Actor))
+			{
+				Stale.Add(Weak);
+				bFoundStale = true;
+				continue;
+			}
+			const FString Live =
+				Key == EKey::Label ? Actor->GetActorLabel() :
+				Key == EKey::Name  ? Actor->GetName()       : Actor->GetPathName();
+			if (Live.Equals(Value, ESearchCase::IgnoreCase))
+			{
+				return Actor;
+			}
+			Stale.Add(Weak);
+			bFoundStale = true;
+		}
+
+		if (!bFoundStale)
+		{
+			return nullptr;
+		}
+		FlushStale();
+	}
+	return nullptr;
+}
+
+AActor* FAgentForgeActorIndex::FindByLabel(const FString& Label)
+{
+	if (Label.IsEmpty()) { return nullptr; }
+	++Lookups;
+	if (!Prepare())
+	{
+		++FallbackScans;
+		UWorld* World = GetIndexEditorWorld();
+		if (!World) { return nullptr; }
+		for (TActorIterator<AActor> It(World); It; ++It)
+		{
+			if (IsValid(*It) && It->GetActorLabel().Equals(Label, ESearchCase::IgnoreCase)) { return *It; }
+		}
+		return nullptr;
+	}
+	return FindInMap(EKey::Label, Label);
+}
+
+AActor* FAgentForgeActorIndex::FindByName(const FString& Name)
+{
+	if (Name.IsEmpty()) { return nullptr; }
+	++Lookups;
+	if (!Prepare())
+	{
+		++FallbackScans;
+		return ScanWorld(GetIndexEditorWorld(), Name);
+	}
+	return FindInMap(EKey::Name, Name);
+}
+
+AActor* FAgentForgeActorIndex::FindByPath(const FString& Path)
+{
+	if (Path.IsEmpty()) { return nullptr; }
+	++Lookups;
+	if (!Prepare())
+	{
+		++FallbackScans;
+		return ScanWorld(GetIndexEditorWorld(), Path);
+	}
+	return FindInMap(EKey::Path, Path);
+}
+
+AActor* FAgentForgeActorIndex::FindByLabelOrName(const FString& LabelOrName)
+{
+	if (LabelOrName.IsEmpty()) { return nullptr; }
+	++Lookups;
+	if (!Prepare())
+	{
+		++FallbackScans;
+		return ScanWorld(GetIndexEditorWorld(), LabelOrName);
+	}
+	if (AActor* ByLabelHit = FindInMap(EKey::Label, LabelOrName))
+	{
+		return ByLabelHit;
+	}
+	return FindInMap(EKey::Name, LabelOrName);
+}
+
+AActor* FAgentForgeActorIndex::FindByAnyId(const FString& Id, UWorld* World)
+{
+	if (Id.IsEmpty()) { return nullptr; }
+	++Lookups;
+
+	// Only full object paths can resolve through the UObject hash.
+	if (Id.Contains(TEXT(".")))
+	{
+		if (AActor* ByObjectPath = Cast<AActor>(StaticFindObject(AActor::StaticClass(), nullptr, *Id)))
+		{
+			if (IsValid(ByObjectPath) && !ByObjectPath->IsActorBeingDestroyed())
+			{
+				return ByObjectPath;
+			}
+		}
+	}
+
+	UWorld* Indexed = Prepare();
+	UWorld* Target  = World ? World : GetIndexEditorWorld();
+	if (!Indexed || Target != Indexed)
+	{
+		++FallbackScans;
+		return ScanWorld(Target, Id);
+	}
+
+	if (AActor* Hit = FindInMap(EKey::Label, Id)) { return Hit; }
+	if (AActor* Hit = FindInMap(EKey::Name, Id))  { return Hit; }
+	return FindInMap(EKey::Path, Id);
+}
+
+void FAgentForgeActorIndex::FindByTag(FName Tag, TArray<AActor*>& OutActors)
+{
+	OutActors.Reset();
+	if (Tag == NAME_None) { return; }
+	++Lookups;
+
+	UWorld* World = Prepare();
+	if (!World)
+	{
+		++FallbackScans;
+		if (UWorld* EditorWorld = GetIndexEditorWorld())
+		{
+			for (TActorIterator<AActor> It(EditorWorld); It; ++It)
+			{
+				if (IsValid(*It) && It->ActorHasTag(Tag)) { OutActors.Add(*It); }
+			}
+		}
+		return;
+	}
+
+	if (const FActorList* List = ByTag.Find(Tag))
+	{
+		for (const TWeakObjectPtr<AActor>& Weak : *List)
+		{
+			AActor* Actor = Weak.Get();
+			if (IsIndexable(Actor) && Actor->ActorHasTag(Tag))
+			{
+				OutActors.Add(Actor);
+			}
+			else
+			{
+				Stale.Add(Weak);
+			}
+		}
+	}
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Spatial
+// ─────────────────────────────────────────────────────────────────────────────
+FIntPoint FAgentForgeActorIndex::CellOf(const FVector& Location)
+{
+	// Clamped so unbounded query extents stay representable.
+	constexpr double MaxCell = 1.0e9;
+	return FIntPoint(
+		FMath::FloorToInt32(FMath::Clamp(Location.X / GridCellSize, -MaxCell, MaxCell)),
+		FMath::FloorToInt32(FMath::Clamp(Location.Y / GridCellSize, -MaxCell, MaxCell)));
+}
+
+template <typename FunctorType>
+void FAgentForgeActorIndex::ForEachInCells(const FVector& Min, const FVector& Max, const UClass* Class, FunctorType&& Visit)
+{
+	const FIntPoint Lo = CellOf(Min);
+	const FIntPoint Hi = CellOf(Max);
+	const int64 Span = (int64)(Hi.X - Lo.X + 1) * (int64)(Hi.Y - Lo.Y + 1);
+
+	auto VisitList = [&](const FIntPoint& Cell, const FActorList& List)
+	{
+		for (const TWeakObjectPtr<AActor>& Weak : List)
+		{
+			AActor* Actor = Weak.Get();
+			if (!IsIndexable(Actor))
+			{
+				Stale.Add(Weak);
+				continue;
+			}
+			// Moved without an event we saw: still answer from the live location,
+			// and re-bucket it at the next query.
+			const FVector Location = Actor->GetActorLocation();
+			if (CellOf(Location) != Cell)
+			{
+				Stale.Add(Weak);
+			}
+			if (Class && !Actor->IsA(Class))
+			{
+				continue;
+			}
+			Visit(Actor, Location);
+		}
+	};
+
+	if (Span > Cells.Num())
+	{
+		// Query wider than the occupied grid: walk occupied cells instead.
+		for (const TPair<FIntPoint, FActorList>& Pair : Cells)
+		{
+			if (Pair.Key.X >= Lo.X && Pair.Key.X <= Hi.X && Pair.Key.Y >= Lo.Y && Pair.Key.Y <= Hi.Y)
+			{
+				VisitList(Pair.Key, Pair.Value);
+			}
+		}
+		return;
+	}
+	for (int32 Y = Lo.Y; Y <= Hi.Y; ++Y)
+	{
+		for (int32 X = Lo.X; X <= Hi.X; ++X)
+		{
+			const FIntPoint Cell(X, Y);
+			if (const FActorList* List = Cells.Find(Cell))
+			{
+				VisitList(Cell, *List);
+			}
+		}
+	}
+}
+
+void FAgentForgeActorIndex::QueryRadius(const FVector& Center, float Radius, TArray<TPair<float, AActor*>>& OutActors, const UClass* Class)
+{
+	OutActors.Reset();
+	++SpatialQueries;
+	const float RadiusSq = Radius * Radius;
+
+	if (!Prepare())
+	{
+		++FallbackScans;
+		if (UWorld* World = GetIndexEditorWorld())
+		{
+			for (TActorIterator<AActor> It(World); It; ++It)
+			{
+				AActor* Actor = *It;
+				if (!Actor || !IsValid(Actor) || (Class && !Actor->IsA(Class))) { continue; }
+				const float DistSq = FVector::DistSquared(Center, Actor->GetActorLocation());
+				if (DistSq <= RadiusSq) { OutActors.Emplace(DistSq, Actor); }
+			}
+		}
+		return;
+	}
+
+	const FVector Reach(Radius, Radius, 0.0);
+	ForEachInCells(Center - Reach, Center + Reach, Class, [&](AActor* Actor, const FVector& Location)
+	{
+		const float DistSq = FVector::DistSquared(Center, Location);
+		if (DistSq <= RadiusSq)
+		{
+			OutActors.Emplace(DistSq, Actor);
+		}
+	});
+}
+
+void FAgentForgeActorIndex::QueryBox(const FBox& Box, TArray<AActor*>& OutActors, const UClass* Class)
+{
+	OutActors.Reset();
+	++SpatialQueries;
+
+	if (!Prepare())
+	{
+		++FallbackScans;
+		if (UWorld* World = GetIndexEditorWorld())
+		{
+			for (TActorIterator<AActor> It(World); It; ++It)
+			{
+				AActor* Actor = *It;
+				if (!Actor || !IsValid(Actor) || (Class && !Actor->IsA(Class))) { continue; }
+				if (Box.IsInsideOrOn(Actor->GetActorLocation())) { OutActors.Add(Actor); }
+			}
+		}
+		return;
+	}
+
+	ForEachInCells(Box.Min, Box.Max, Class, [&](AActor* Actor, const FVector& Location)
+	{
+		if (Box.IsInsideOrOn(Location))
+		{
+			OutActors.Add(Actor);
+		}
+	});
+}
+
+void FAgentForgeActorIndex::QueryNearest(const FVector& Point, int32 K, float MaxRadius, TArray<TPair<float, AActor*>>& OutActors, const UClass* Class)
+{
+	OutActors.Reset();
+	if (K <= 0)
+	{
+		return;
+	}
+
+	auto ByDistance = [](const TPair<float, AActor*>& A, const TPair<float, AActor*>& B) { return A.Key < B.Key; };
+
+	// Grow the search circle until it holds K actors: everything within the
+	// final radius has been seen, so the K closest of them are exact.
+	// Without the index every query is a full scan, so search the whole limit once.
+	float Limit = MaxRadius > 0.0f ? MaxRadius : 1.0e9f;
+	const bool bIndexed = Prepare() != nullptr;
+	if (bIndexed && Cells.Num() > 0)
+	{
+		// Nothing lies beyond the farthest occupied cell corner.
+		FIntPoint Lo(MAX_int32, MAX_int32), Hi(MIN_int32, MIN_int32);
+		for (const TPair<FIntPoint, FActorList>& Pair : Cells)
+		{
+			Lo = FIntPoint(FMath::Min(Lo.X, Pair.Key.X), FMath::Min(Lo.Y, Pair.Key.Y));
+			Hi = FIntPoint(FMath::Max(Hi.X, Pair.Key.X), FMath::Max(Hi.Y, Pair.Key.Y));
+		}
+		const double FarX = FMath::Max(FMath::Abs(Point.X - Lo.X * GridCellSize), FMath::Abs(Point.X - (Hi.X + 1) * GridCellSize));
+		const double FarY = FMath::Max(FMath::Abs(Point.Y - Lo.Y * GridCellSize), FMath::Abs(Point.Y - (Hi.Y + 1) * GridCellSize));
+		Limit = FMath::Min(Limit, (float)FMath::Sqrt(FarX * FarX + FarY * FarY) + GridCellSize);
+	}
+	float Radius = bIndexed ? FMath::Min(GridCellSize, Limit) : Limit;
+	for (;;)
+	{
+		QueryRadius(Point, Radius, OutActors, Class);
+		if (OutActors.Num() >= K || Radius >= Limit)
+		{
+			break;
+		}
+		Radius = FMath::Min(Radius * 2.0f, Limit);
+	}
+
+	OutActors.Sort(ByDistance);
+	if (OutActors.Num() > K)
+	{
+		OutActors.SetNum(K);
+	}
+}
+
+FBox FAgentForgeActorIndex::GetLevelBounds()
+{
+	if (!Prepare())
+	{
+		++FallbackScans;
+		FBox Bounds(ForceInit);
+		if (UWorld* World = GetIndexEditorWorld())
+		{
+			for (TActorIterator<AActor> It(World); It; ++It)
+			{
+				if (!IsValid(*It)) { continue; }
+				FVector Origin, Extent;
+				It->GetActorBounds(false, Origin, Extent);
+				if (!Extent.IsNearlyZero()) { Bounds += FBox::BuildAABB(Origin, Extent); }
+			}
+		}
+		return Bounds;
+	}
+
+	if (bLevelBoundsDirty)
+	{
+		CachedLevelBounds = FBox(ForceInit);
+		for (const TPair<TWeakObjectPtr<AActor>, FEntry>& Pair : Entries)
+		{
+			if (Pair.Value.Bounds.IsValid)
+			{
+				CachedLevelBounds += Pair.Value.Bounds;
+			}
+		}
+		bLevelBoundsDirty = false;
+	}
+	return CachedLevelBounds;
+}
+
+AActor* FAgentForgeActorIndex::ScanWorld(UWorld* World, const FString& Id)
+{
+	if (!World) { return nullptr; }
+	for (TActorIterator<AActor> It(World); It; ++It)
+	{
+		AActor* Actor = *It;
+		if (!Actor || !IsValid(Actor))
+		{
+			continue;
+		}
+		if (Actor->GetActorLabel().Equals(Id, ESearchCase::IgnoreCase) ||
+			Actor->GetName().Equals(Id, ESearchCase::IgnoreCase) ||
+			Actor->GetPathName().Equals(Id, ESearchCase::IgnoreCase))
+		{
+			return Actor;
+		}
+	}
+	return nullptr;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Revisions
+// ─────────────────────────────────────────────────────────────────────────────
+uint32 FAgentForgeActorIndex::SignatureOf(const AActor* Actor)
+{
+	const FTransform Xf    = Actor->GetActorTransform();
+	const FVector    Loc   = Xf.GetLocation();
+	const FQuat      Rot   = Xf.GetRotation();
+	const FVector    Scale = Xf.GetScale3D();
+	const double Packed[10] = { Loc.X, Loc.Y, Loc.Z, Rot.X, Rot.Y, Rot.Z, Rot.W, Scale.X, Scale.Y, Scale.Z };
+
+	uint32 Hash = FCrc::MemCrc32(Packed, sizeof(Packed));
+	Hash = HashCombine(Hash, GetTypeHash(Actor->GetActorLabel()));
+	Hash = HashCombine(Hash, Actor->IsHidden() ? 1u : 0u);
+	for (const FName& Tag : Actor->Tags)
+	{
+		Hash = HashCombine(Hash, GetTypeHash(Tag));
+	}
+	return Hash;
+}
+
+void FAgentForgeActorIndex::NoteChange(const TWeakObjectPtr<AActor>& Actor, EChange Kind, const FEntry* Known)
+{
+	UWorld* World = IndexedWorld.Get();
+	const AActor* Live = Actor.Get();
+	if (!World || (Live && Live->GetWorld() != World))
+	{
+		// Nothing indexed yet (the first build resets history) or not our world.
+		return;
+	}
+
+	FChange& Change = Changes.FindOrAdd(Actor);
+	Change.Revision = ++Revision;
+	if (Kind == EChange::Added)
+	{
+		Change.AddedRevision = Change.Revision;
+	}
+	if (Kind == EChange::Removed || Change.Identity.Path.IsEmpty())
+	{
+		const FEntry* Entry = Known ? Known : Entries.Find(Actor);
+		if (Entry)
+		{
+			Change.Identity = { Entry->Label, Entry->Name, Entry->Path };
+		}
+		else if (Live)
+		{
+			Change.Identity = { Live->GetActorLabel(), Live->GetName(), Live->GetPathName() };
+		}
+	}
+
+	if (Changes.Num() > MaxChangeHistory)
+	{
+		TrimHistory();
+	}
+}
+
+void FAgentForgeActorIndex::ResetHistory()
+{
+	Changes.Reset();
+	HistoryFloor = ++Revision;
+}
+
+void FAgentForgeActorIndex::TrimHistory()
+{
+	// Drop the older half; deltas from before the cut need a full resend.
+	TArray<int64> Revisions;
+	Revisions.Reserve(Changes.Num());
+	for (const TPair<TWeakObjectPtr<AActor>, FChange>& Pair : Changes)
+	{
+		Revisions.Add(Pair.Value.Revision);
+	}
+	Revisions.Sort();
+	const int64 Cutoff = Revisions[Revisions.Num() / 2];
+	for (auto It = Changes.CreateIterator(); It; ++It)
+	{
+		if (It.Value().Revision <= Cutoff)
+		{
+			It.RemoveCurrent();
+		}
+	}
+	HistoryFloor = FMath::Max(HistoryFloor, Cutoff);
+}
+
+void FAgentForgeActorIndex::SweepSignatures()
+{
+	// Catches edits made without Modify() or a move / label event.
+	for (TPair<TWeakObjectPtr<AActor>, FEntry>& Pair : Entries)
+	{
+		AActor* Actor = Pair.Key.Get();
+		if (!IsIndexable(Actor))
+		{
+			Stale.Add(Pair.Key);
+			continue;
+		}
+		const uint32 Signature = SignatureOf(Actor);
+		if (Signature != Pair.Value.Signature)
+		{
+			Pair.Value.Signature = Signature;
+			NoteChange(Pair.Key, EChange::Modified, &Pair.Value);
+			Stale.Add(Pair.Key);
+		}
+	}
+	if (Stale.Num() > 0)
+	{
+		FlushStale();
+	}
+}
+
+int64 FAgentForgeActorIndex::GetRevision()
+{
+	return Prepare() ? Revision : 0;
+}
+
+bool FAgentForgeActorIndex::GetChangesSince(int64 Since, FWorldDelta& OutDelta)
+{
+	OutDelta = FWorldDelta();
+	if (!Prepare())
+	{
+		return false;
+	}
+	SweepSignatures();
+	OutDelta.Revision = Revision;
+	if (Since < HistoryFloor || Since > Revision)
+	{
+		return false;
+	}
+
+	TArray<const TPair<TWeakObjectPtr<AActor>, FChange>*> Ordered;
+	for (const TPair<TWeakObjectPtr<AActor>, FChange>& Pair : Changes)
+	{
+		if (Pair.Value.Revision > Since)
+		{
+			Ordered.Add(&Pair);
+		}
+	}
+	Ordered.Sort([](const TPair<TWeakObjectPtr<AActor>, FChange>& A, const TPair<TWeakObjectPtr<AActor>, FChange>& B)
+	{
+		return A.Value.Revision < B.Value.Revision;
+	});
+
+	for (const TPair<TWeakObjectPtr<AActor>, FChange>* Pair : Ordered)
+	{
+		const FChange& Change = Pair->Value;
+		const bool bNew = Change.AddedRevision > Since;
+		AActor* Actor = Pair->Key.Get();
+		if (IsIndexable(Actor))
+		{
+			(bNew ? OutDelta.Added : OutDelta.Modified).Add(Actor);
+		}
+		else if (!bNew)
+		{
+			// Appeared and vanished after Since: the caller never saw it.
+			OutDelta.Removed.Add(Change.Identity);
+		}
+	}
+	return true;
+}
+
+TSharedPtr<FJsonObject> FAgentForgeActorIndex::GetStatsJson() const
+{
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetBoolField  (TEXT("active"),          bInitialized && bEngineHooked && !bDirty && IndexedWorld.IsValid());
+	Obj->SetNumberField(TEXT("actors"),          Entries.Num());
+	Obj->SetNumberField(TEXT("labels"),          ByLabel.Num());
+	Obj->SetNumberField(TEXT("tags"),            ByTag.Num());
+	Obj->SetNumberField(TEXT("stale"),           Stale.Num());
+	Obj->SetNumberField(TEXT("lookups"),         static_cast<double>(Lookups));
+	Obj->SetNumberField(TEXT("rebuilds"),        static_cast<double>(Rebuilds));
+	Obj->SetNumberField(TEXT("rekeys"),          static_cast<double>(Rekeys));
+	Obj->SetNumberField(TEXT("fallback_scans"),  static_cast<double>(FallbackScans));
+	Obj->SetNumberField(TEXT("spatial_queries"), static_cast<double>(SpatialQueries));
+	Obj->SetNumberField(TEXT("grid_cells"),      Cells.Num());
+	Obj->SetNumberField(TEXT("last_rebuild_ms"), LastRebuildMs);
+	Obj->SetNumberField(TEXT("revision"),        static_cast<double>(Revision));
+	Obj->SetNumberField(TEXT("history_floor"),   static_cast<double>(HistoryFloor));
+	Obj->SetNumberField(TEXT("history"),         Changes.Num());
+	return Obj;
+}
@@ -0,0 +1,243 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeActorQuery.cpp — projection / filter / paging parsing and shared actor field writer.
+
+#include "AgentForgeActorQuery.h"
+
+#include "AgentForgeResponseWriter.h"
+#include "Dom/JsonValue.h"
+#include "GameFramework/Actor.h"
+
+namespace
+{
+	struct FFieldName
+	{
+		const TCHAR*          Name;
+		EAgentForgeActorField Field;
+	};
+
+	static const FFieldName GActorFieldNames[] =
+	{
+		{ TEXT("name"),                  EAgentForgeActorField::Name           },
+		{ TEXT("label"),                 EAgentForgeActorField::Label          },
+		{ TEXT("class"),                 EAgentForgeActorField::Class          },
+		{ TEXT("object_path"),           EAgentForgeActorField::ObjectPath     },
+		{ TEXT("location"),              EAgentForgeActorField::Location       },
+		{ TEXT("rotation"),              EAgentForgeActorField::Rotation       },
+		{ TEXT("scale"),                 EAgentForgeActorField::Scale          },
+		{ TEXT("tags"),                  EAgentForgeActorField::Tags           },
+		{ TEXT("bounds"),                EAgentForgeActorField::Bounds         },
+		{ TEXT("parent"),                EAgentForgeActorField::Parent         },
+		{ TEXT("is_visible"),            EAgentForgeActorField::Visible        },
+		{ TEXT("category"),              EAgentForgeActorField::Category       },
+		{ TEXT("distance"),              EAgentForgeActorField::Distance       },
+		{ TEXT("distance_to_center_cm"), EAgentForgeActorField::Distance       },
+		{ TEXT("component_count"),       EAgentForgeActorField::ComponentCount },
+	};
+
+	static bool ReadVector(const TSharedPtr<FJsonObject>& Obj, const TCHAR* Key, FVector& Out)
+	{
+		const TSharedPtr<FJsonObject>* VecObj = nullptr;
+		if (!Obj->TryGetObjectField(Key, VecObj) || !VecObj || !(*VecObj).IsValid())
+		{
+			return false;
+		}
+		double X = 0.0, Y = 0.0, Z = 0.0;
+		if (!(*VecObj)->TryGetNumberField(TEXT("x"), X) ||
+			!(*VecObj)->TryGetNumberField(TEXT("y"), Y) ||
+			!(*VecObj)->TryGetNumberField(TEXT("z"), Z))
+		{
+			return false;
+		}
+		Out = FVector(X, Y, Z);
+		return true;
+	}
+}
+
+bool FAgentForgeActorQuery::Parse(
+	const TSharedPtr<FJsonObject>& Args,
+	EAgentForgeActorField Supported,
+	EAgentForgeActorField Defaults,
+	FString& OutError)
+{
+	Fields = Defaults;
+	if (!Args.IsValid())
+	{
+		return true;
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* FieldArr = nullptr;
+	if (Args->TryGetArrayField(TEXT("fields"), FieldArr) && FieldArr && FieldArr->Num() > 0)
+	{
+		Fields = EAgentForgeActorField::None;
+		for (const TSharedPtr<FJsonValue>& Value : *FieldArr)
+		{
+			const FString Requested = Value.IsValid() ? Value->AsString() : FString();
+			EAgentForgeActorField Field = EAgentForgeActorField::None;
+			for (const FFieldName& Entry : GActorFieldNames)
+			{
+				if (Requested.Equals(Entry.Name, ESearchCase::IgnoreCase))
+				{
+					Field = Entry.Field;
+					break;
+				}
+			}
+			if (Field == EAgentForgeActorField::None || !EnumHasAnyFlags(Supported, Field))
+			{
+				OutError = FString::Printf(TEXT("Unsupported field '%s' in args.fields."), *Requested);
+				return false;
+			}
+			Fields |= Field;
+		}
+	}
+
+	FString ClassName;
+	if (Args->TryGetStringField(TEXT("class"), ClassName) && !ClassName.IsEmpty())
+	{
+		ClassFilter = FName(*ClassName);
+	}
+	FString Tag;
+	if (Args->TryGetStringField(TEXT("tag"), Tag) && !Tag.IsEmpty())
+	{
+		TagFilter = FName(*Tag);
+	}
+
+	if (Args->HasField(TEXT("bounds")))
+	{
+		const TSharedPtr<FJsonObject>* BoundsObj = nullptr;
+		FVector Min, Max;
+		if (!Args->TryGetObjectField(TEXT("bounds"), BoundsObj) || !BoundsObj ||
+			!ReadVector(*BoundsObj, TEXT("min"), Min) || !ReadVector(*BoundsObj, TEXT("max"), Max))
+		{
+			OutError = TEXT("args.bounds must be {min:{x,y,z}, max:{x,y,z}}.");
+			return false;
+		}
+		BoundsFilter  = FBox(Min.ComponentMin(Max), Min.ComponentMax(Max));
+		bBoundsFilter = true;
+	}
+
+	double LimitValue = 0.0;
+	if (Args->TryGetNumberField(TEXT("limit"), LimitValue))
+	{
+		Limit = FMath::Clamp((int32)LimitValue, 0, 100000);
+	}
+
+	if (Args->HasField(TEXT("cursor")))
+	{
+		FString Cursor;
+		double CursorNumber = 0.0;
+		if (Args->TryGetStringField(TEXT("cursor"), Cursor))
+		{
+			if (!Cursor.IsEmpty() && !Cursor.IsNumeric())
+			{
+				OutError = FString::Printf(TEXT("Malformed cursor '%s'."), *Cursor);
+				return false;
+			}
+			Offset = Cursor.IsEmpty() ? 0 : FCString::Atoi(*Cursor);
+		}
+		else if (Args->TryGetNumberField(TEXT("cursor"), CursorNumber))
+		{
+			Offset = (int32)CursorNumber;
+		}
+		Offset = FMath::Clamp(Offset, 0, 1 << 30);
+	}
+	return true;
+}
+
+bool FAgentForgeActorQuery::Matches(const AActor* Actor) const
+{
+	if (!Actor)
+	{
+		return false;
+	}
+	if (bBoundsFilter && !BoundsFilter.IsInsideOrOn(Actor->GetActorLocation()))
+	{
+		return false;
+	}
+	if (TagFilter != NAME_None && !Actor->ActorHasTag(TagFilter))
+	{
+		return false;
+	}
+	if (ClassFilter != NAME_None)
+	{
+		bool bClassMatch = false;
+		for (const UClass* Class = Actor->GetClass(); Class && !bClassMatch; Class = Class->GetSuperClass())
+		{
+			bClassMatch = Class->GetFName() == ClassFilter;
+		}
+		if (!bClassMatch)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+int32 FAgentForgeActorQuery::GetEnd(int32 Total) const
+{
+	if (Offset >= Total)
+	{
+		return Total;
+	}
+	return Limit > 0 ? FMath::Min(Total, Offset + Limit) : Total;
+}
+
+void FAgentForgeActorQuery::WritePaging(FAgentForgeResponseWriter& Writer, int32 Total) const
+{
+	if (!IsPaged())
+	{
+		return;
+	}
+	Writer.WriteValue(TEXT("total"), Total);
+	const int32 End = GetEnd(Total);
+	if (End < Total)
+	{
+		Writer.WriteValue(TEXT("next_cursor"), FString::FromInt(End));
+	}
+	else
+	{
+		Writer.WriteNull(TEXT("next_cursor"));
+	}
+}
+
+void FAgentForgeActorQuery::WriteActorFields(FAgentForgeResponseWriter& Writer, const AActor* Actor) const
+{
+	if (Wants(EAgentForgeActorField::Name))       { Writer.WriteValue(TEXT("name"), Actor->GetName()); }
+	if (Wants(EAgentForgeActorField::Label))      { Writer.WriteValue(TEXT("label"), Actor->GetActorLabel()); }
+	if (Wants(EAgentForgeActorField::Class))      { Writer.WriteValue(TEXT("class"), Actor->GetClass()->GetName()); }
+	if (Wants(EAgentForgeActorField::ObjectPath)) { Writer.WriteValue(TEXT("object_path"), Actor->GetPathName()); }
+	if (Wants(EAgentForgeActorField::Location))   { Writer.WriteVector(TEXT("location"), Actor->GetActorLocation()); }
+	if (Wants(EAgentForgeActorField::Rotation))
+	{
+		const FRotator Rot = Actor->GetActorRotation();
+		Writer.WriteObjectStart(TEXT("rotation"));
+		Writer.WriteValue(TEXT("pitch"), Rot.Pitch);
+		Writer.WriteValue(TEXT("yaw"),   Rot.Yaw);
+		Writer.WriteValue(TEXT("roll"),  Rot.Roll);
+		Writer.WriteObjectEnd();
+	}
+	if (Wants(EAgentForgeActorField::Scale))      { Writer.WriteVector(TEXT("scale"), Actor->GetActorScale3D()); }
+	if (Wants(EAgentForgeActorField::Parent))
+	{
+		const AActor* ParentActor = Actor->GetAttachParentActor();
+		Writer.WriteValue(TEXT("parent"), ParentActor ? ParentActor->GetActorLabel() : FString());
+	}
+	if (Wants(EAgentForgeActorField::Visible))    { Writer.WriteValue(TEXT("is_visible"), !Actor->IsHidden()); }
+	if (Wants(EAgentForgeActorField::Tags))
+	{
+		Writer.WriteArrayStart(TEXT("tags"));
+		for (const FName& Tag : Actor->Tags)
+		{
+			Writer.WriteValue(Tag.ToString());
+		}
+		Writer.WriteArrayEnd();
+	}
+	if (Wants(EAgentForgeActorField::Bounds))
+	{
+		FVector Origin, Extent;
+		Actor->GetActorBounds(false, Origin, Extent);
+		Writer.WriteObjectStart(TEXT("bounds"));
+		Writer.WriteVector(TEXT("origin"), Origin);
+		Writer.WriteVector(TEXT("extent"), Extent);
+		Writer.WriteObjectEnd();
+	}
+}
@@ -0,0 +1,66 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeArgs.cpp — name tables, value conversion, report fields.
+
+#include "AgentForgeArgs.h"
+
+void FAgentForgeArgReport::AppendTo(const TSharedPtr<FJsonObject>& Obj) const
+{
+	if (!Obj.IsValid())
+	{
+		return;
+	}
+	auto AddList = [&Obj](const TCHAR* Field, const TArray<FString>& Names)
+	{
+		if (Names.Num() == 0)
+		{
+			return;
+		}
+		TArray<TSharedPtr<FJsonValue>> Arr;
+		Arr.Reserve(Names.Num());
+		for (const FString& Name : Names)
+		{
+			Arr.Add(MakeShared<FJsonValueString>(Name));
+		}
+		Obj->SetArrayField(Field, Arr);
+	};
+	AddList(TEXT("unknown_fields"), Unknown);
+	AddList(TEXT("invalid_fields"), Invalid);
+}
+
+FAgentForgeArgNames& FAgentForgeArgNames::Add(const FAgentForgeArgKeys& InNames)
+{
+	for (const TCHAR* Name : InNames.Names)
+	{
+		Entries.FindOrAdd(Name);
+	}
+	return *this;
+}
+
+FAgentForgeArgNames& FAgentForgeArgNames::Add(const FAgentForgeArgNames& Other)
+{
+	for (const TPair<FString, FEntry>& Pair : Other.Entries)
+	{
+		Entries.FindOrAdd(Pair.Key);
+	}
+	return *this;
+}
+
+bool FAgentForgeArgNames::IsDispatchArg(const FString& Name)
+{
+	return Name == TEXT("profile") || Name == TEXT("async");
+}
+
+bool FAgentForgeArgNames::ReadNumber(const TSharedPtr<FJsonValue>& Value, double& Out)
+{
+	return Value.IsValid() && Value->TryGetNumber(Out);
+}
+
+bool FAgentForgeArgNames::ReadBool(const TSharedPtr<FJsonValue>& Value, bool& Out)
+{
+	return Value.IsValid() && Value->TryGetBool(Out);
+}
+
+bool FAgentForgeArgNames::ReadString(const TSharedPtr<FJsonValue>& Value, FString& Out)
+{
+	return Value.IsValid() && Value->TryGetString(Out);
+}
@@ -0,0 +1,585 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeAssetCatalog.cpp — per-kind asset indices, trigram search and registry event upkeep.
+
+#include "AgentForgeAssetCatalog.h"
+
+#include "Algo/BinarySearch.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Dom/JsonValue.h"
+#include "Engine/Blueprint.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/Texture2D.h"
+#include "HAL/PlatformTime.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialInstanceConstant.h"
+#include "Modules/ModuleManager.h"
+#include "Sound/SoundCue.h"
+#include "Sound/SoundWave.h"
+
+namespace
+{
+	static const TCHAR* KindName(int32 Kind)
+	{
+		switch ((EAgentForgeAssetKind)Kind)
+		{
+		case EAgentForgeAssetKind::StaticMesh: return TEXT("static_mesh");
+		case EAgentForgeAssetKind::Material:   return TEXT("material");
+		case EAgentForgeAssetKind::Blueprint:  return TEXT("blueprint");
+		case EAgentForgeAssetKind::Texture:    return TEXT("texture");
+		case EAgentForgeAssetKind::Sound:      return TEXT("sound");
+		default:                               return TEXT("unknown");
+		}
+	}
+
+	static IAssetRegistry* GetRegistry()
+	{
+		FAssetRegistryModule* Module = FModuleManager::GetModulePtr<FAssetRegistryModule>(TEXT("AssetRegistry"));
+		return Module ? &Module->Get() : nullptr;
+	}
+
+	/** Lowercased, without a trailing slash; empty means no filter. */
+	static FString NormalizePath(const FString& Path)
+	{
+		FString Out = Path.ToLower();
+		while (Out.Len() > 1 && Out.EndsWith(TEXT("/")))
+		{
+			Out.LeftChopInline(1, EAllowShrinking::No);
+		}
+		return Out;
+	}
+
+	/** Recursive package path match, as FARFilter::PackagePaths with bRecursivePaths. */
+	static bool MatchesPath(const FString& LowerPath, const FString& LowerPrefix)
+	{
+		if (LowerPrefix.IsEmpty() || LowerPrefix == TEXT("/"))
+		{
+			return true;
+		}
+		if (!LowerPath.StartsWith(LowerPrefix, ESearchCase::CaseSensitive))
+		{
+			return false;
+		}
+		return LowerPath.Len() == LowerPrefix.Len() || LowerPath[LowerPrefix.Len()] == TEXT('/');
+	}
+}
+
+FAgentForgeAssetCatalog& FAgentForgeAssetCatalog::Get()
+{
+	static FAgentForgeAssetCatalog Catalog;
+	return Catalog;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Lifetime
+// ─────────────────────────────────────────────────────────────────────────────
+void FAgentForgeAssetCatalog::Initialize()
+{
+	check(IsInGameThread());
+	if (bInitialized)
+	{
+		return;
+	}
+
+	IAssetRegistry* Registry = GetRegistry();
+	if (!Registry)
+	{
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
+		Registry = GetRegistry();
+	}
+	if (!Registry)
+	{
+		return;
+	}
+	bInitialized = true;
+
+	auto SetClasses = [this](EAgentForgeAssetKind Kind, std::initializer_list<UClass*> Classes)
+	{
+		FKindIndex& Index = Indices[(int32)Kind];
+		Index.ClassPaths.Reset();
+		for (UClass* Class : Classes)
+		{
+			Index.ClassPaths.Add(Class->GetClassPathName());
+		}
+	};
+	SetClasses(EAgentForgeAssetKind::StaticMesh, { UStaticMesh::StaticClass() });
+	SetClasses(EAgentForgeAssetKind::Material,   { UMaterial::StaticClass(), UMaterialInstanceConstant::StaticClass() });
+	SetClasses(EAgentForgeAssetKind::Blueprint,  { UBlueprint::StaticClass() });
+	SetClasses(EAgentForgeAssetKind::Texture,    { UTexture2D::StaticClass() });
+	SetClasses(EAgentForgeAssetKind::Sound,      { USoundWave::StaticClass(), USoundCue::StaticClass() });
+
+	AssetAddedHandle   = Registry->OnAssetAdded().AddRaw(this, &FAgentForgeAssetCatalog::HandleAssetAdded);
+	AssetRemovedHandle = Registry->OnAssetRemoved().AddRaw(this, &FAgentForgeAssetCatalog::HandleAssetRemoved);
+	AssetRenamedHandle = Registry->OnAssetRenamed().AddRaw(this, &FAgentForgeAssetCatalog::HandleAssetRenamed);
+	AssetUpdatedHandle = Registry->OnAssetUpdated().AddRaw(this, &FAgentForgeAssetCatalog::HandleAssetUpdated);
+}
+
+void FAgentForgeAssetCatalog::Shutdown()
+{
+	if (!bInitialized)
+	{
+		return;
+	}
+	bInitialized = false;
+
+	if (IAssetRegistry* Registry = GetRegistry())
+	{
+		Registry->OnAssetAdded().Remove(AssetAddedHandle);
+		Registry->OnAssetRemoved().Remove(AssetRemovedHandle);
+		Registry->OnAssetRenamed().Remove(AssetRenamedHandle);
+		Registry->OnAssetUpdated().Remove(AssetUpdatedHandle);
+	}
+	Invalidate();
+}
+
+void FAgentForgeAssetCatalog::Invalidate()
+{
+	for (FKindIndex& Index : Indices)
+	{
+		Index.Entries.Reset();
+		Index.Order.Reset();
+		Index.Trigrams.Reset();
+		Index.ByPath.Reset();
+		Index.Dead = 0;
+		Index.bBuilt = false;
+	}
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Index maintenance
+// ─────────────────────────────────────────────────────────────────────────────
+uint64 FAgentForgeAssetCatalog::TrigramKey(const TCHAR* Chars)
+{
+	// 21 bits per code point; wider TCHAR values only alias, and every hit is verified.
+	return ((uint64)(Chars[0] & 0x1FFFFF) << 42) | ((uint64)(Chars[1] & 0x1FFFFF) << 21) | (uint64)(Chars[2] & 0x1FFFFF);
+}
+
+int32 FAgentForgeAssetCatalog::AddEntry(FKindIndex& Index, const FAssetData& Asset)
+{
+	const int32 Id = Index.Entries.Num();
+	FEntry& Entry = Index.Entries.AddDefaulted_GetRef();
+	Entry.Asset = Asset;
+	Entry.LowerName = Asset.AssetName.ToString().ToLower();
+	Entry.LowerPath = Asset.PackagePath.ToString().ToLower();
+	Index.ByPath.Add(Asset.GetSoftObjectPath(), Id);
+
+	const TCHAR* Chars = *Entry.LowerName;
+	for (int32 Pos = 0; Pos + 3 <= Entry.LowerName.Len(); ++Pos)
+	{
+		TArray<int32>& Posting = Index.Trigrams.FindOrAdd(TrigramKey(Chars + Pos));
+		if (Posting.Num() == 0 || Posting.Last() != Id)   // repeated trigram within one name
+		{
+			Posting.Add(Id);
+		}
+	}
+	return Id;
+}
+
+void FAgentForgeAssetCatalog::InsertEntry(FKindIndex& Index, const FAssetData& Asset)
+{
+	if (const int32* Existing = Index.ByPath.Find(Asset.GetSoftObjectPath()))
+	{
+		RemoveEntry(Index, *Existing);
+	}
+	const int32 Id = AddEntry(Index, Asset);
+	Index.Order.Insert(Id, LowerBound(Index, Index.Entries[Id].LowerName, Id));
+}
+
+void FAgentForgeAssetCatalog::RemoveEntry(FKindIndex& Index, int32 Id)
+{
+	FEntry& Entry = Index.Entries[Id];
+	if (!Entry.bAlive)
+	{
+		return;
+	}
+
+	const int32 Pos = LowerBound(Index, Entry.LowerName, Id);
+	if (Index.Order.IsValidIndex(Pos) && Index.Order[Pos] == Id)
+	{
+		Index.Order.RemoveAt(Pos, 1, EAllowShrinking::No);
+	}
+	Index.ByPath.Remove(Entry.Asset.GetSoftObjectPath());
+	Entry.bAlive = false;
+	++Index.Dead;
+
+	// Postings keep the tombstone until compaction.
+	if (Index.Dead > 64 && Index.Dead * 4 > Index.Entries.Num())
+	{
+		Compact(Index);
+	}
+}
+
+void FAgentForgeAssetCatalog::SortOrder(FKindIndex& Index)
+{
+	const TArray<FEntry>& Entries = Index.Entries;
+	Index.Order.Sort([&Entries](int32 A, int32 B)
+	{
+		const int32 Cmp = Entries[A].LowerName.Compare(Entries[B].LowerName, ESearchCase::CaseSensitive);
+		return Cmp != 0 ? Cmp < 0 : A < B;
+	});
+}
+
+int32 FAgentForgeAssetCatalog::LowerBound(const FKindIndex& Index, const FString& LowerName, int32 Id)
+{
+	return Algo::LowerBound(Index.Order, Id, [&Index, &LowerName](int32 Element, int32 Target)
+	{
+		const int32 Cmp = Index.Entries[Element].LowerName.Compare(LowerName, ESearchCase::CaseSensitive);
+		return Cmp != 0 ? Cmp < 0 : Element < Target;
+	});
+}
+
+void FAgentForgeAssetCatalog::Compact(FKindIndex& Index)
+{
+	TArray<FAssetData> Live;
+	Live.Reserve(Index.Entries.Num() - Index.Dead);
+	for (FEntry& Entry : Index.Entries)
+	{
+		if (Entry.bAlive)
+		{
+			Live.Add(MoveTemp(Entry.Asset));
+		}
+	}
+
+	Index.Entries.Reset(Live.Num());
+	Index.Order.Reset(Live.Num());
+	Index.Trigrams.Reset();
+	Index.ByPath.Reset();
+	Index.Dead = 0;
+	for (const FAssetData& Asset : Live)
+	{
+		Index.Order.Add(AddEntry(Index, Asset));
+	}
+	SortOrder(Index);
+}
+
+void FAgentForgeAssetCatalog::Build(EAgentForgeAssetKind Kind)
+{
+	const double Start = FPlatformTime::Seconds();
+	FKindIndex& Index = Indices[(int32)Kind];
+
+	TArray<FAssetData> Assets;
+	if (IAssetRegistry* Registry = GetRegistry())
+	{
+		FARFilter Filter;
+		Filter.ClassPaths = Index.ClassPaths;
+		Registry->GetAssets(Filter, Assets);
+	}
+
+	Index.Entries.Reset(Assets.Num());
+	Index.Order.Reset(Assets.Num());
+	Index.Trigrams.Reset();
+	Index.ByPath.Reset();
+	Index.ByPath.Reserve(Assets.Num());
+	Index.Dead = 0;
+	for (const FAssetData& Asset : Assets)
+	{
+		if (!Index.ByPath.Contains(Asset.GetSoftObjectPath()))
+		{
+			Index.Order.Add(AddEntry(Index, Asset));
+		}
+	}
+	SortOrder(Index);
+	Index.bBuilt = true;
+
+	++Builds;
+	LastBuildMs = (FPlatformTime::Seconds() - Start) * 1000.0;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Queries
+// ─────────────────────────────────────────────────────────────────────────────
+bool FAgentForgeAssetCatalog::ParseTagQuery(const FString& Text, TArray<TPair<FName, FString>>& OutTags, FString& OutError)
+{
+	OutTags.Reset();
+	TArray<FString> Terms;
+	Text.ParseIntoArray(Terms, TEXT(","), /*InCullEmpty*/ true);
+	for (const FString& Term : Terms)
+	{
+		FString Key = Term;
+		FString Value;
+		Term.Split(TEXT("="), &Key, &Value);
+		Key.TrimStartAndEndInline();
+		Value.TrimStartAndEndInline();
+		if (Key.IsEmpty())
+		{
+			OutError = FString::Printf(TEXT("Empty tag key in '%s'."), *Term);
+			return false;
+		}
+		OutTags.Emplace(FName(*Key), Value);
+	}
+	return true;
+}
+
+bool FAgentForgeAssetCatalog::MatchesFilters(const FAssetData& Asset, const FAgentForgeAssetQuery& Request)
+{
+	for (const TPair<FName, FString>& Tag : Request.Tags)
+	{
+		FString Value;
+		if (!Asset.GetTagValue(Tag.Key, Value))
+		{
+			return false;
+		}
+		if (!Tag.Value.IsEmpty() && !Value.Contains(Tag.Value, ESearchCase::IgnoreCase))
+		{
+			return false;
+		}
+	}
+	return !Request.Filter || Request.Filter(Asset);
+}
+
+void FAgentForgeAssetCatalog::QueryRegistry(const FKindIndex& Index, const FAgentForgeAssetQuery& Request, TArray<FAssetData>& OutAssets)
+{
+	IAssetRegistry* Registry = GetRegistry();
+	if (!Registry)
+	{
+		return;
+	}
+
+	FARFilter Filter;
+	Filter.bRecursivePaths = true;
+	Filter.ClassPaths = Index.ClassPaths;
+	if (!Request.PackagePath.IsEmpty())
+	{
+		Filter.PackagePaths.Add(*Request.PackagePath);
+	}
+
+	TArray<FAssetData> Assets;
+	Registry->GetAssets(Filter, Assets);
+	Assets.Sort([](const FAssetData& A, const FAssetData& B)
+	{
+		return A.AssetName.LexicalLess(B.AssetName);
+	});
+
+	for (FAssetData& Asset : Assets)
+	{
+		const FString Name = Asset.AssetName.ToString();
+		if ((!Request.Prefix.IsEmpty() && !Name.StartsWith(Request.Prefix, ESearchCase::IgnoreCase))
+			|| (!Request.Search.IsEmpty() && !Name.Contains(Request.Search, ESearchCase::IgnoreCase))
+			|| !MatchesFilters(Asset, Request))
+		{
+			continue;
+		}
+		OutAssets.Add(MoveTemp(Asset));
+		if (Request.MaxResults > 0 && OutAssets.Num() >= Request.MaxResults)
+		{
+			break;
+		}
+	}
+}
+
+void FAgentForgeAssetCatalog::Query(EAgentForgeAssetKind Kind, const FAgentForgeAssetQuery& Request, TArray<FAssetData>& OutAssets)
+{
+	check(IsInGameThread());
+	OutAssets.Reset();
+	if (Kind >= EAgentForgeAssetKind::Num)
+	{
+		return;
+	}
+	if (!bInitialized)
+	{
+		Initialize();
+	}
+
+	const double Start = FPlatformTime::Seconds();
+	++Queries;
+	FKindIndex& Index = Indices[(int32)Kind];
+
+	if (!Index.bBuilt)
+	{
+		IAssetRegistry* Registry = GetRegistry();
+		if (!bInitialized || !Registry || Registry->IsLoadingAssets())
+		{
+			// Building now would index a partial scan; answer from the registry until it settles.
+			++RegistryFallbacks;
+			QueryRegistry(Index, Request, OutAssets);
+			LastQueryMs = (FPlatformTime::Seconds() - Start) * 1000.0;
+			return;
+		}
+		Build(Kind);
+	}
+
+	const FString Search = Request.Search.ToLower();
+	const FString Prefix = Request.Prefix.ToLower();
+	const FString PathPrefix = NormalizePath(Request.PackagePath);
+	const int32 Limit = Request.MaxResults > 0 ? Request.MaxResults : MAX_int32;
+
+	auto Accept = [&](const FEntry& Entry)
+	{
+		return Entry.bAlive
+			&& (Prefix.IsEmpty() || Entry.LowerName.StartsWith(Prefix, ESearchCase::CaseSensitive))
+			&& (Search.IsEmpty() || Entry.LowerName.Contains(Search, ESearchCase::CaseSensitive))
+			&& MatchesPath(Entry.LowerPath, PathPrefix)
+			&& MatchesFilters(Entry.Asset, Request);
+	};
+
+	// Smallest posting list among the needle's trigrams (the prefix counts too).
+	const TArray<int32>* Candidates = nullptr;
+	bool bNoMatch = false;
+	for (const FString* Needle : { &Search, &Prefix })
+	{
+		for (int32 Pos = 0; Pos + 3 <= Needle->Len() && !bNoMatch; ++Pos)
+		{
+			const TArray<int32>* Posting = Index.Trigrams.Find(TrigramKey(**Needle + Pos));
+			if (!Posting)
+			{
+				bNoMatch = true;
+			}
+			else if (!Candidates || Posting->Num() < Candidates->Num())
+			{
+				Candidates = Posting;
+			}
+		}
+	}
+
+	if (bNoMatch)
+	{
+		++TrigramQueries;
+	}
+	else if (!Prefix.IsEmpty() && (!Candidates || Candidates->Num() > 256))
+	{
+		// Name order is prefix order: every match is in one contiguous run.
+		++PrefixQueries;
+		for (int32 Pos = LowerBound(Index, Prefix, MIN_int32); Pos < Index.Order.Num() && OutAssets.Num() < Limit; ++Pos)
+		{
+			const FEntry& Entry = Index.Entries[Index.Order[Pos]];
+			if (!Entry.LowerName.StartsWith(Prefix, ESearchCase::CaseSensitive))
+			{
+				break;
+			}
+			if (Accept(Entry))
+			{
+				OutAssets.Add(Entry.Asset);
+			}
+		}
+	}
+	else if (Candidates)
+	{
+		++TrigramQueries;
+		TArray<int32> Hits;
+		for (const int32 Id : *Candidates)
+		{
+			if (Accept(Index.Entries[Id]))
+			{
+				Hits.Add(Id);
+			}
+		}
+
+		const TArray<FEntry>& Entries = Index.Entries;
+		Hits.Sort([&Entries](int32 A, int32 B)
+		{
+			const int32 Cmp = Entries[A].LowerName.Compare(Entries[B].LowerName, ESearchCase::CaseSensitive);
+			return Cmp != 0 ? Cmp < 0 : A < B;
+		});
+		for (int32 Hit = 0; Hit < Hits.Num() && OutAssets.Num() < Limit; ++Hit)
+		{
+			OutAssets.Add(Entries[Hits[Hit]].Asset);
+		}
+	}
+	else
+	{
+		// Needle shorter than a trigram, or none: walk in name order and stop at the limit.
+		++ScanQueries;
+		for (int32 Pos = 0; Pos < Index.Order.Num() && OutAssets.Num() < Limit; ++Pos)
+		{
+			const FEntry& Entry = Index.Entries[Index.Order[Pos]];
+			if (Accept(Entry))
+			{
+				OutAssets.Add(Entry.Asset);
+			}
+		}
+	}
+
+	LastQueryMs = (FPlatformTime::Seconds() - Start) * 1000.0;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Registry events
+// ─────────────────────────────────────────────────────────────────────────────
+FAgentForgeAssetCatalog::FKindIndex* FAgentForgeAssetCatalog::FindBuiltIndex(const FAssetData& Asset)
+{
+	for (FKindIndex& Index : Indices)
+	{
+		if (Index.bBuilt && Index.ClassPaths.Contains(Asset.AssetClassPath))
+		{
+			return &Index;
+		}
+	}
+	return nullptr;
+}
+
+void FAgentForgeAssetCatalog::HandleAssetAdded(const FAssetData& Asset)
+{
+	if (FKindIndex* Index = FindBuiltIndex(Asset))
+	{
+		++Events;
+		InsertEntry(*Index, Asset);
+	}
+}
+
+void FAgentForgeAssetCatalog::HandleAssetRemoved(const FAssetData& Asset)
+{
+	if (FKindIndex* Index = FindBuiltIndex(Asset))
+	{
+		++Events;
+		if (const int32* Id = Index->ByPath.Find(Asset.GetSoftObjectPath()))
+		{
+			RemoveEntry(*Index, *Id);
+		}
+	}
+}
+
+void FAgentForgeAssetCatalog::HandleAssetRenamed(const FAssetData& Asset, const FString& OldObjectPath)
+{
+	if (FKindIndex* Index = FindBuiltIndex(Asset))
+	{
+		++Events;
+		if (const int32* Id = Index->ByPath.Find(FSoftObjectPath(OldObjectPath)))
+		{
+			RemoveEntry(*Index, *Id);
+		}
+		InsertEntry(*Index, Asset);
+	}
+}
+
+void FAgentForgeAssetCatalog::HandleAssetUpdated(const FAssetData& Asset)
+{
+	if (FKindIndex* Index = FindBuiltIndex(Asset))
+	{
+		++Events;
+		if (const int32* Id = Index->ByPath.Find(Asset.GetSoftObjectPath()))
+		{
+			// Same path, same name: only the tags can have changed.
+			Index->Entries[*Id].Asset = Asset;
+		}
+	}
+}
+
+TSharedPtr<FJsonObject> FAgentForgeAssetCatalog::GetStatsJson() const
+{
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetBoolField(TEXT("active"), bInitialized);
+
+	TSharedPtr<FJsonObject> Kinds = MakeShared<FJsonObject>();
+	for (int32 Kind = 0; Kind < (int32)EAgentForgeAssetKind::Num; ++Kind)
+	{
+		const FKindIndex& Index = Indices[Kind];
+		TSharedPtr<FJsonObject> K = MakeShared<FJsonObject>();
+		K->SetBoolField  (TEXT("built"),      Index.bBuilt);
+		K->SetNumberField(TEXT("assets"),     Index.Order.Num());
+		K->SetNumberField(TEXT("trigrams"),   Index.Trigrams.Num());
+		K->SetNumberField(TEXT("tombstones"), Index.Dead);
+		Kinds->SetObjectField(KindName(Kind), K);
+	}
+	Obj->SetObjectField(TEXT("indices"), Kinds);
+
+	Obj->SetNumberField(TEXT("queries"),            static_cast<double>(Queries));
+	Obj->SetNumberField(TEXT("trigram_queries"),    static_cast<double>(TrigramQueries));
+	Obj->SetNumberField(TEXT("prefix_queries"),     static_cast<double>(PrefixQueries));
+	Obj->SetNumberField(TEXT("scan_queries"),       static_cast<double>(ScanQueries));
+	Obj->SetNumberField(TEXT("registry_fallbacks"), static_cast<double>(RegistryFallbacks));
+	Obj->SetNumberField(TEXT("builds"),             static_cast<double>(Builds));
+	Obj->SetNumberField(TEXT("events"),             static_cast<double>(Events));
+	Obj->SetNumberField(TEXT("last_build_ms"),      LastBuildMs);
+	Obj->SetNumberField(TEXT("last_query_ms"),      LastQueryMs);
+	return Obj;
+}
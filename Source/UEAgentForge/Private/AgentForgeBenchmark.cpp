@@ -0,0 +1,629 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeBenchmark.cpp — case table, memory sampling and report writer.
+
+#include "AgentForgeBenchmark.h"
+
+#include "AgentForgeJobManager.h"
+#include "Distribution/BiomePartition.h"
+#include "Distribution/Clearings.h"
+#include "Distribution/CounterRng.h"
+#include "Distribution/DensityField.h"
+#include "Distribution/DistributionEngine.h"
+#include "Distribution/InteractionRules.h"
+#include "Distribution/PointCloud.h"
+#include "Terrain/ErosionSim.h"
+#include "Terrain/TerrainGenerator.h"
+#include "Visual/SceneEvaluator.h"
+
+#include "Async/Async.h"
+#include "Dom/JsonValue.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformMisc.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformProperties.h"
+#include "HAL/PlatformTime.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/DateTime.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/UObjectArray.h"
+#include <atomic>
+
+namespace
+{
+	static FString ToJson(const TSharedPtr<FJsonObject>& Obj)
+	{
+		FString Out;
+		TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Out);
+		FJsonSerializer::Serialize(Obj.ToSharedRef(), Writer);
+		return Out;
+	}
+
+	// ─── Memory sampling ────────────────────────────────────────────────────
+
+	/**
+	 * Resident memory and live UObject count around the timed region. Both are
+	 * process-wide: other threads' allocations land in the delta too, so the
+	 * numbers are approximate and meant for comparing runs on an idle editor.
+	 * The allocator itself is never swapped out (GMalloc is shared by every
+	 * thread and must not change after startup), so allocation counts are not
+	 * measured at all.
+	 */
+	struct FMemorySample
+	{
+		uint64 UsedPhysical = 0;
+		int32  UObjects = 0;
+
+		static FMemorySample Take()
+		{
+			FMemorySample Sample;
+			Sample.UsedPhysical = FPlatformMemory::GetStats().UsedPhysical;
+			Sample.UObjects = GUObjectArray.GetObjectArrayNumMinusAvailable();
+			return Sample;
+		}
+	};
+
+	/**
+	 * Highest resident memory while a case runs, above the level it started
+	 * from. A sampler thread reads UsedPhysical about once a millisecond, so a
+	 * shorter spike can slip between samples; when the case also raises the
+	 * OS high-water mark (PeakUsedPhysical), that mark is used instead.
+	 * Process-wide, like FMemorySample.
+	 */
+	class FPeakMemorySampler
+	{
+	public:
+		FPeakMemorySampler()
+		{
+			const FPlatformMemoryStats Stats = FPlatformMemory::GetStats();
+			Baseline = Stats.UsedPhysical;
+			PeakBefore = Stats.PeakUsedPhysical;
+			Peak.store(Baseline, std::memory_order_relaxed);
+			Sampler = Async(EAsyncExecution::Thread, [this]()
+			{
+				while (!bStop.load(std::memory_order_relaxed))
+				{
+					const uint64 Used = FPlatformMemory::GetStats().UsedPhysical;
+					uint64 Prev = Peak.load(std::memory_order_relaxed);
+					while (Used > Prev && !Peak.compare_exchange_weak(Prev, Used, std::memory_order_relaxed))
+					{
+					}
+					FPlatformProcess::SleepNoStats(0.001f);
+				}
+			});
+		}
+
+		/** Stop sampling; the peak above the starting level, in MB. */
+		double StopMB()
+		{
+			bStop.store(true, std::memory_order_relaxed);
+			Sampler.Wait();
+			const FPlatformMemoryStats Stats = FPlatformMemory::GetStats();
+			uint64 Max = FMath::Max(Peak.load(std::memory_order_relaxed), (uint64)Stats.UsedPhysical);
+			if (Stats.PeakUsedPhysical > PeakBefore)
+			{
+				Max = FMath::Max(Max, (uint64)Stats.PeakUsedPhysical);
+			}
+			return Max > Baseline ? (double)(Max - Baseline) / (1024.0 * 1024.0) : 0.0;
+		}
+
+	private:
+		uint64              Baseline = 0;
+		uint64              PeakBefore = 0;
+		std::atomic<uint64> Peak { 0 };
+		std::atomic<bool>   bStop { false };
+		TFuture<void>       Sampler;
+	};
+
+	// ─── Cases ──────────────────────────────────────────────────────────────
+
+	/** Input and scratch state shared by a case's setup and timed run. */
+	struct FBenchState
+	{
+		int32 Size = 0;
+		int32 Seed = 1337;
+
+		// Distribution
+		FBox Bounds = FBox(ForceInit);
+		TArray<FVector> Points;          // uniform input, built once per size
+		TArray<FVector> Attractors;      // 256 points for avoidance / attractor cases
+		FPointCloud Cloud;               // rebuilt from Points before every repeat
+		FBiomePartitionData Biomes;
+		TArray<FClearingRegion> Clearings;
+
+		// Terrain
+		FHeightmapNoiseSettings Noise;
+		TArray<float> BaseHeightmap;     // built once per size
+		TArray<float> Heightmap;         // copy of BaseHeightmap before every repeat
+	};
+
+	using FBenchSetup = void (*)(FBenchState&);
+	using FBenchRun = int64 (*)(FBenchState&);   // returns the case's output count
+
+	struct FBenchCase
+	{
+		const TCHAR* Name;
+		bool bTerrain;
+		FBenchSetup Setup;   // per repeat, untimed; may be null
+		FBenchRun Run;
+	};
+
+	static constexpr float BenchMinSpacing = 50.0f;
+	static constexpr float BenchClusterRadius = 400.0f;
+
+	static void ResetCloud(FBenchState& S) { S.Cloud = FPointCloud(S.Points); }
+
+	static FDensityFieldConfig MakeBenchDensityConfig(const FBenchState& S)
+	{
+		FDensityFieldConfig Config;
+		Config.Sigma = (float)(S.Bounds.GetExtent().X * 0.75);
+		Config.Center = S.Bounds.GetCenter();
+		Config.Seed = S.Seed;
+		return Config;
+	}
+
+	static const FBenchCase GBenchCases[] =
+	{
+		{ TEXT("blue_noise"), false, nullptr, [](FBenchState& S) -> int64
+		{
+			return FDistributionEngine::GenerateBlueNoisePoints(S.Bounds, S.Size, S.Seed, BenchMinSpacing).Num();
+		}},
+		{ TEXT("poisson_disk"), false, nullptr, [](FBenchState& S) -> int64
+		{
+			return FDistributionEngine::GeneratePoissonDiskPoints(S.Bounds, S.Size, BenchMinSpacing, S.Seed).Num();
+		}},
+		{ TEXT("cluster"), false, nullptr, [](FBenchState& S) -> int64
+		{
+			const int32 Clusters = FMath::Max(1, FMath::RoundToInt(FMath::Sqrt((float)S.Size) * 0.35f));
+			return FDistributionEngine::GenerateClusterPoints(S.Bounds, S.Size, Clusters, BenchClusterRadius, S.Seed).Num();
+		}},
+		{ TEXT("height_filter"), false, &ResetCloud, [](FBenchState& S) -> int64
+		{
+			FDistributionEngine::ApplyHeightFilter(S.Cloud, 250.0f, 750.0f);
+			return S.Cloud.NumAlive();
+		}},
+		{ TEXT("distance_mask"), false, &ResetCloud, [](FBenchState& S) -> int64
+		{
+			FDistributionEngine::ApplyDistanceMask(S.Cloud, S.Bounds.GetCenter(), 0.0f, (float)(S.Bounds.GetExtent().X * 0.8));
+			return S.Cloud.NumAlive();
+		}},
+		{ TEXT("avoidance"), false, &ResetCloud, [](FBenchState& S) -> int64
+		{
+			FInteractionRules::ApplyAvoidance(S.Cloud, S.Attractors, 200.0f);
+			return S.Cloud.NumAlive();
+		}},
+		{ TEXT("attractor_bias"), false, &ResetCloud, [](FBenchState& S) -> int64
+		{
+			FInteractionRules::ApplyAttractorBias(S.Cloud, S.Attractors, 500.0f, 0.5f, S.Seed);
+			return S.Cloud.NumAlive();
+		}},
+		{ TEXT("self_spacing"), false, &ResetCloud, [](FBenchState& S) -> int64
+		{
+			FInteractionRules::ApplySelfSpacing(S.Cloud, BenchMinSpacing);
+			return S.Cloud.NumAlive();
+		}},
+		{ TEXT("density_gradient"), false, &ResetCloud, [](FBenchState& S) -> int64
+		{
+			const TArray<float> Field = FDensityField::GenerateDensityField(S.Bounds, 64, 64, MakeBenchDensityConfig(S));
+			FDensityField::ApplyDensityGradient(S.Cloud, Field, 64, 64, S.Bounds, S.Seed, 0.03f);
+			return S.Cloud.NumAlive();
+		}},
+		{ TEXT("density_raster"), false, &ResetCloud, [](FBenchState& S) -> int64
+		{
+			FDensityCompositeMasks Masks;
+			Masks.MinKeepProbability = 0.03f;
+			const FDensityRaster Raster = FDensityField::GenerateCompositeField(S.Bounds, 64, 64, MakeBenchDensityConfig(S), Masks);
+			FDensityField::ApplyDensityRaster(S.Cloud, Raster, S.Seed);
+			return S.Cloud.NumAlive();
+		}},
+		{ TEXT("biome_partition"), false, nullptr, [](FBenchState& S) -> int64
+		{
+			return FBiomePartition::GenerateVoronoiBiomes(S.Bounds, 8, TArray<FString>(), S.Seed, 300.0f).Seeds.Num();
+		}},
+		{ TEXT("biome_classify"), false, [](FBenchState& S)
+		{
+			if (S.Biomes.Seeds.Num() == 0)
+			{
+				S.Biomes = FBiomePartition::GenerateVoronoiBiomes(S.Bounds, 8, TArray<FString>(), S.Seed, 300.0f);
+			}
+		}, [](FBenchState& S) -> int64
+		{
+			int64 Blended = 0;
+			for (const FVector& Point : S.Points)
+			{
+				Blended += FBiomePartition::BlendBiomeIds(S.Biomes, Point).BlendAlpha > 0.0f ? 1 : 0;
+			}
+			return Blended;
+		}},
+		{ TEXT("clearings"), false, nullptr, [](FBenchState& S) -> int64
+		{
+			return FClearings::GenerateClearings(S.Bounds, FMath::Clamp(S.Size / 1000, 1, 2048), 200.0f, 800.0f, S.Seed, 0.0f).Num();
+		}},
+		{ TEXT("clearing_mask"), false, [](FBenchState& S)
+		{
+			ResetCloud(S);
+			S.Clearings = FClearings::GenerateClearings(S.Bounds, FMath::Clamp(S.Size / 1000, 1, 2048), 200.0f, 800.0f, S.Seed);
+		}, [](FBenchState& S) -> int64
+		{
+			FClearings::ApplyClearingMask(S.Cloud, S.Clearings);
+			return S.Cloud.NumAlive();
+		}},
+		{ TEXT("clearing_sdf"), false, [](FBenchState& S)
+		{
+			ResetCloud(S);
+			S.Clearings = FClearings::GenerateClearings(S.Bounds, FMath::Clamp(S.Size / 1000, 1, 2048), 200.0f, 800.0f, S.Seed);
+		}, [](FBenchState& S) -> int64
+		{
+			FClearingMaskSettings Settings;
+			Settings.Falloff = 200.0f;
+			const FClearingSdf Sdf = FClearings::BuildClearingSdf(S.Clearings, S.Bounds, Settings);
+			FClearings::ApplyClearingMask(S.Cloud, Sdf, Settings, S.Seed);
+			return S.Cloud.NumAlive();
+		}},
+		{ TEXT("scene_evaluate"), false, nullptr, [](FBenchState& S) -> int64
+		{
+			const FSceneEvaluationMetrics Metrics = FSceneEvaluator::EvaluateScene(S.Points, S.Bounds, BenchClusterRadius);
+			return Metrics.CombinedScore > 0.0f ? S.Points.Num() : 0;
+		}},
+
+		{ TEXT("heightmap_noise"), true, nullptr, [](FBenchState& S) -> int64
+		{
+			return FTerrainGenerator::GenerateHeightmap(S.Size, S.Size, S.Noise).Num();
+		}},
+		{ TEXT("ridged_noise"), true, [](FBenchState& S) { S.Heightmap = S.BaseHeightmap; }, [](FBenchState& S) -> int64
+		{
+			FHeightmapNoiseSettings Ridge = S.Noise;
+			Ridge.Type = EHeightmapNoiseType::Ridged;
+			FTerrainGenerator::ApplyRidgedNoise(S.Heightmap, S.Size, S.Size, Ridge, 0.35f);
+			return S.Heightmap.Num();
+		}},
+		{ TEXT("thermal_erosion"), true, [](FBenchState& S) { S.Heightmap = S.BaseHeightmap; }, [](FBenchState& S) -> int64
+		{
+			// Convergence threshold 0: always run the full 8 passes so sizes compare.
+			return FErosionSim::ApplyThermalErosion(S.Heightmap, S.Size, S.Size, 8, 0.01f, 0.5f, 0.0f);
+		}},
+		{ TEXT("hydraulic_erosion"), true, [](FBenchState& S) { S.Heightmap = S.BaseHeightmap; }, [](FBenchState& S) -> int64
+		{
+			FHydraulicErosionSettings Settings;
+			Settings.Seed = S.Seed;
+			Settings.Droplets = FMath::Max(1, (S.Size * S.Size) / 16);
+			return FTerrainGenerator::ApplyHydraulicErosion(S.Heightmap, S.Size, S.Size, Settings);
+		}},
+		{ TEXT("normalize"), true, [](FBenchState& S) { S.Heightmap = S.BaseHeightmap; }, [](FBenchState& S) -> int64
+		{
+			FTerrainGenerator::NormalizeHeightmap(S.Heightmap);
+			return S.Heightmap.Num();
+		}},
+	};
+
+	static const FBenchCase* FindCase(const FString& Name)
+	{
+		for (const FBenchCase& Case : GBenchCases)
+		{
+			if (Name.Equals(Case.Name, ESearchCase::IgnoreCase))
+			{
+				return &Case;
+			}
+		}
+		return nullptr;
+	}
+
+	static void PrepareState(const FBenchCase& Case, int32 Size, int32 Seed, FBenchState& S)
+	{
+		S.Size = Size;
+		S.Seed = Seed;
+		if (Case.bTerrain)
+		{
+			S.Noise.Seed = Seed;
+			S.Noise.Frequency = 4.0f / (float)Size;
+			S.BaseHeightmap = FTerrainGenerator::GenerateHeightmap(Size, Size, S.Noise);
+			return;
+		}
+
+		// One point per square metre.
+		const double Half = FMath::Sqrt((double)Size) * 50.0;
+		S.Bounds = FBox(FVector(-Half, -Half, 0.0), FVector(Half, Half, 1000.0));
+		const FCounterRng Rng(Seed, CounterRngStream::BenchmarkInput);
+		S.Points.SetNumUninitialized(Size);
+		for (int32 Index = 0; Index < Size; ++Index)
+		{
+			S.Points[Index] = FVector(
+				Rng.FRandRange(FCounterRng::Slot(Index, 0, 3), -Half, Half),
+				Rng.FRandRange(FCounterRng::Slot(Index, 1, 3), -Half, Half),
+				Rng.FRandRange(FCounterRng::Slot(Index, 2, 3), 0.0, 1000.0));
+		}
+		const FCounterRng AttractorRng(Seed, CounterRngStream::BenchmarkInput, 1);
+		S.Attractors.SetNumUninitialized(256);
+		for (int32 Index = 0; Index < S.Attractors.Num(); ++Index)
+		{
+			S.Attractors[Index] = FVector(
+				AttractorRng.FRandRange(FCounterRng::Slot(Index, 0, 2), -Half, Half),
+				AttractorRng.FRandRange(FCounterRng::Slot(Index, 1, 2), -Half, Half),
+				500.0);
+		}
+	}
+
+	static TArray<int32> ReadIntArray(const TSharedPtr<FJsonObject>& Args, const TCHAR* Field, int32 Min, int32 Max)
+	{
+		TArray<int32> Values;
+		const TArray<TSharedPtr<FJsonValue>>* Arr = nullptr;
+		if (Args->TryGetArrayField(Field, Arr))
+		{
+			for (const TSharedPtr<FJsonValue>& Value : *Arr)
+			{
+				double Number = 0.0;
+				if (Value.IsValid() && Value->TryGetNumber(Number))
+				{
+					Values.AddUnique(FMath::Clamp((int32)Number, Min, Max));
+				}
+			}
+		}
+		return Values;
+	}
+
+	static FString CsvField(const FString& In)
+	{
+		return In.Contains(TEXT(",")) || In.Contains(TEXT("\"")) ? FString::Printf(TEXT("\"%s\""), *In.Replace(TEXT("\""), TEXT("\"\""))) : In;
+	}
+}
+
+// ─── Settings / results ─────────────────────────────────────────────────────
+
+FBenchmarkSettings FBenchmarkSettings::FromJson(const TSharedPtr<FJsonObject>& Args)
+{
+	FBenchmarkSettings Settings;
+	if (!Args.IsValid())
+	{
+		return Settings;
+	}
+	const TArray<TSharedPtr<FJsonValue>>* CasesArr = nullptr;
+	if (Args->TryGetArrayField(TEXT("cases"), CasesArr))
+	{
+		for (const TSharedPtr<FJsonValue>& Value : *CasesArr)
+		{
+			FString Name;
+			if (Value.IsValid() && Value->TryGetString(Name) && !Name.IsEmpty())
+			{
+				Settings.Cases.AddUnique(Name.ToLower());
+			}
+		}
+	}
+	const TArray<int32> Points = ReadIntArray(Args, TEXT("point_counts"), 1, FDistributionEngine::MaxPoints);
+	if (Points.Num() > 0)
+	{
+		Settings.PointCounts = Points;
+	}
+	const TArray<int32> Sizes = ReadIntArray(Args, TEXT("heightmap_sizes"), 2, 4096);
+	if (Sizes.Num() > 0)
+	{
+		Settings.HeightmapSizes = Sizes;
+	}
+	if (Args->HasField(TEXT("repeats")))
+	{
+		Settings.Repeats = FMath::Clamp((int32)Args->GetNumberField(TEXT("repeats")), 1, 100);
+	}
+	if (Args->HasField(TEXT("seed")))
+	{
+		Settings.Seed = (int32)Args->GetNumberField(TEXT("seed"));
+	}
+	Args->TryGetStringField(TEXT("output_dir"), Settings.OutputDir);
+	Args->TryGetStringField(TEXT("label"), Settings.Label);
+	return Settings;
+}
+
+TSharedPtr<FJsonObject> FBenchmarkResult::ToJson() const
+{
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetStringField(TEXT("case"),         Case);
+	Obj->SetStringField(TEXT("module"),       Module);
+	Obj->SetStringField(TEXT("unit"),         Unit);
+	Obj->SetNumberField(TEXT("size"),         Size);
+	Obj->SetNumberField(TEXT("units"),        (double)Units);
+	Obj->SetNumberField(TEXT("repeats"),      Repeats);
+	Obj->SetNumberField(TEXT("best_ms"),      BestMs);
+	Obj->SetNumberField(TEXT("median_ms"),    MedianMs);
+	Obj->SetNumberField(TEXT("ns_per_unit"),  NsPerUnit);
+	Obj->SetNumberField(TEXT("used_physical_delta_mb"), UsedPhysicalDeltaMB);
+	Obj->SetNumberField(TEXT("peak_used_physical_mb"), PeakUsedPhysicalMB);
+	Obj->SetNumberField(TEXT("uobjects_delta"), UObjectsDelta);
+	Obj->SetNumberField(TEXT("output_count"), (double)OutputCount);
+	return Obj;
+}
+
+// ─── Runner ─────────────────────────────────────────────────────────────────
+
+TArray<FString> FAgentForgeBenchmark::GetCaseNames()
+{
+	TArray<FString> Names;
+	for (const FBenchCase& Case : GBenchCases)
+	{
+		Names.Add(Case.Name);
+	}
+	return Names;
+}
+
+bool FAgentForgeBenchmark::RunCase(const FString& CaseName, int32 Size, const FBenchmarkSettings& Settings, FBenchmarkResult& OutResult)
+{
+	const FBenchCase* Case = FindCase(CaseName);
+	if (!Case)
+	{
+		return false;
+	}
+
+	FBenchState State;
+	PrepareState(*Case, Size, Settings.Seed, State);
+
+	struct FRun
+	{
+		double Ms = 0.0;
+		double UsedDeltaMB = 0.0;
+		double PeakMB = 0.0;
+		int32 UObjectsDelta = 0;
+		int64 Output = 0;
+	};
+	TArray<FRun> Runs;
+	const int32 Repeats = FMath::Max(1, Settings.Repeats);
+	for (int32 Repeat = 0; Repeat < Repeats; ++Repeat)
+	{
+		if (Case->Setup)
+		{
+			Case->Setup(State);
+		}
+		FRun& Run = Runs.AddDefaulted_GetRef();
+		{
+			const FMemorySample Before = FMemorySample::Take();
+			FPeakMemorySampler PeakSampler;
+			const double StartSeconds = FPlatformTime::Seconds();
+			Run.Output = Case->Run(State);
+			Run.Ms = (FPlatformTime::Seconds() - StartSeconds) * 1000.0;
+			Run.PeakMB = PeakSampler.StopMB();
+			const FMemorySample After = FMemorySample::Take();
+			Run.UsedDeltaMB = ((double)After.UsedPhysical - (double)Before.UsedPhysical) / (1024.0 * 1024.0);
+			Run.UObjectsDelta = After.UObjects - Before.UObjects;
+		}
+	}
+
+	Runs.Sort([](const FRun& A, const FRun& B) { return A.Ms < B.Ms; });
+	const FRun& Median = Runs[Runs.Num() / 2];
+
+	OutResult = FBenchmarkResult();
+	OutResult.Case = Case->Name;
+	OutResult.Module = Case->bTerrain ? TEXT("terrain") : TEXT("distribution");
+	OutResult.Unit = Case->bTerrain ? TEXT("texel") : TEXT("point");
+	OutResult.Size = Size;
+	OutResult.Units = Case->bTerrain ? (int64)Size * Size : (int64)Size;
+	OutResult.Repeats = Repeats;
+	OutResult.BestMs = Runs[0].Ms;
+	OutResult.MedianMs = Median.Ms;
+	OutResult.NsPerUnit = OutResult.Units > 0 ? (Median.Ms * 1.0e6) / (double)OutResult.Units : 0.0;
+	OutResult.UsedPhysicalDeltaMB = Median.UsedDeltaMB;
+	OutResult.PeakUsedPhysicalMB = Median.PeakMB;
+	OutResult.UObjectsDelta = Median.UObjectsDelta;
+	OutResult.OutputCount = Median.Output;
+	return true;
+}
+
+FString FAgentForgeBenchmark::GetDefaultOutputDir()
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("AgentForgeBenchmarks"));
+}
+
+bool FAgentForgeBenchmark::WriteReport(
+	const TArray<FBenchmarkResult>& Results,
+	const FBenchmarkSettings& Settings,
+	FString& OutJsonPath,
+	FString& OutCsvPath,
+	TSharedPtr<FJsonObject>& OutReport)
+{
+	FString PluginVersion = TEXT("unknown");
+	if (const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("UEAgentForge")))
+	{
+		PluginVersion = Plugin->GetDescriptor().VersionName;
+	}
+	const FString Timestamp = FDateTime::UtcNow().ToString(TEXT("%Y%m%d-%H%M%S"));
+
+	OutReport = MakeShared<FJsonObject>();
+	OutReport->SetStringField(TEXT("plugin_version"), PluginVersion);
+	OutReport->SetStringField(TEXT("engine_version"), FEngineVersion::Current().ToString());
+	OutReport->SetStringField(TEXT("platform"),       FPlatformProperties::IniPlatformName());
+	OutReport->SetStringField(TEXT("cpu"),            FPlatformMisc::GetCPUBrand().TrimStartAndEnd());
+	OutReport->SetNumberField(TEXT("cores"),          FPlatformMisc::NumberOfCoresIncludingHyperthreads());
+	OutReport->SetStringField(TEXT("timestamp_utc"),  Timestamp);
+	OutReport->SetStringField(TEXT("label"),          Settings.Label);
+	OutReport->SetNumberField(TEXT("seed"),           Settings.Seed);
+	OutReport->SetNumberField(TEXT("repeats"),        Settings.Repeats);
+
+	TArray<TSharedPtr<FJsonValue>> ResultsArr;
+	FString Csv = TEXT("plugin_version,label,case,module,unit,size,units,repeats,best_ms,median_ms,ns_per_unit,used_physical_delta_mb,peak_used_physical_mb,uobjects_delta,output_count\n");
+	for (const FBenchmarkResult& Result : Results)
+	{
+		ResultsArr.Add(MakeShared<FJsonValueObject>(Result.ToJson()));
+		Csv += FString::Printf(TEXT("%s,%s,%s,%s,%s,%d,%lld,%d,%.4f,%.4f,%.3f,%.3f,%.3f,%d,%lld\n"),
+			*CsvField(PluginVersion), *CsvField(Settings.Label), *Result.Case, *Result.Module, *Result.Unit,
+			Result.Size, Result.Units, Result.Repeats, Result.BestMs, Result.MedianMs, Result.NsPerUnit,
+			Result.UsedPhysicalDeltaMB, Result.PeakUsedPhysicalMB, Result.UObjectsDelta, Result.OutputCount);
+	}
+	OutReport->SetArrayField(TEXT("results"), ResultsArr);
+
+	const FString Dir = Settings.OutputDir.IsEmpty() ? GetDefaultOutputDir() : Settings.OutputDir;
+	const FString Base = FPaths::Combine(Dir, FString::Printf(TEXT("bench_%s_%s"), *PluginVersion, *Timestamp));
+	OutJsonPath = FPaths::ConvertRelativePathToFull(Base + TEXT(".json"));
+	OutCsvPath = FPaths::ConvertRelativePathToFull(Base + TEXT(".csv"));
+	const bool bJson = FFileHelper::SaveStringToFile(ToJson(OutReport), *OutJsonPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+	const bool bCsv = FFileHelper::SaveStringToFile(Csv, *OutCsvPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+	return bJson && bCsv;
+}
+
+TSharedRef<FAgentForgeJob> FAgentForgeBenchmark::MakeBenchmarkJob(const TSharedPtr<FJsonObject>& Args)
+{
+	TSharedRef<FAgentForgeJob> Job = MakeShared<FAgentForgeJob>(TEXT("run_benchmarks"));
+
+	struct FBenchmarkRun
+	{
+		FBenchmarkSettings Settings;
+		TArray<FBenchmarkResult> Results;
+	};
+	TSharedRef<FBenchmarkRun> Run = MakeShared<FBenchmarkRun>();
+	Run->Settings = FBenchmarkSettings::FromJson(Args);
+
+	for (const FString& Name : Run->Settings.Cases)
+	{
+		if (!FindCase(Name))
+		{
+			const FString Error = FString::Printf(TEXT("Unknown benchmark case '%s'. Known: %s"), *Name, *FString::Join(GetCaseNames(), TEXT(", ")));
+			Job->AddStage(TEXT("prepare"), [Error](FAgentForgeJob& J)
+			{
+				TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+				Obj->SetBoolField(TEXT("ok"), false);
+				Obj->SetStringField(TEXT("error"), Error);
+				J.Finish(ToJson(Obj));
+				return true;
+			});
+			return Job;
+		}
+	}
+
+	for (const FBenchCase& Case : GBenchCases)
+	{
+		if (Run->Settings.Cases.Num() > 0 && !Run->Settings.Cases.Contains(FString(Case.Name).ToLower()))
+		{
+			continue;
+		}
+		const TArray<int32>& Sizes = Case.bTerrain ? Run->Settings.HeightmapSizes : Run->Settings.PointCounts;
+		for (const int32 Size : Sizes)
+		{
+			// Weight by work so percent_complete tracks wall time roughly.
+			const float Weight = (float)FMath::Max(1.0, (Case.bTerrain ? (double)Size * Size : (double)Size) / 1000.0);
+			const FString CaseName = Case.Name;
+			Job->AddStage(FString::Printf(TEXT("%s@%d"), Case.Name, Size), [Run, CaseName, Size](FAgentForgeJob& J)
+			{
+				FBenchmarkResult Result;
+				if (FAgentForgeBenchmark::RunCase(CaseName, Size, Run->Settings, Result))
+				{
+					UE_LOG(LogTemp, Log, TEXT("[UEAgentForge] Benchmark %s@%d: median %.3f ms, %.2f ns/%s, %+.2f MB resident, %.2f MB peak"),
+						*Result.Case, Size, Result.MedianMs, Result.NsPerUnit, *Result.Unit, Result.UsedPhysicalDeltaMB, Result.PeakUsedPhysicalMB);
+					J.AddPartialResult(Result.ToJson());
+					Run->Results.Add(MoveTemp(Result));
+				}
+				return true;
+			}, Weight);
+		}
+	}
+
+	Job->SetFinalizer([Run](FAgentForgeJob&)
+	{
+		FString JsonPath;
+		FString CsvPath;
+		TSharedPtr<FJsonObject> Report;
+		const bool bWritten = FAgentForgeBenchmark::WriteReport(Run->Results, Run->Settings, JsonPath, CsvPath, Report);
+		Report->SetBoolField(TEXT("ok"), true);
+		Report->SetBoolField(TEXT("written"), bWritten);
+		Report->SetStringField(TEXT("json_path"), JsonPath);
+		Report->SetStringField(TEXT("csv_path"), CsvPath);
+		return ToJson(Report);
+	});
+	return Job;
+}
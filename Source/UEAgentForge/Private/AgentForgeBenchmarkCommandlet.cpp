@@ -0,0 +1,90 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeBenchmarkCommandlet.cpp — command-line parsing around FAgentForgeBenchmark.
+
+#include "AgentForgeBenchmarkCommandlet.h"
+
+#include "AgentForgeBenchmark.h"
+#include "AgentForgeJobManager.h"
+
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Misc/Parse.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace
+{
+	/** -Key=a,b,c as a JSON array; numbers when bNumeric. */
+	static void AddListParam(const FString& Params, const TCHAR* Key, const TCHAR* Field, bool bNumeric, const TSharedPtr<FJsonObject>& Args)
+	{
+		FString Value;
+		if (!FParse::Value(*Params, Key, Value, false))
+		{
+			return;
+		}
+		TArray<FString> Items;
+		Value.ParseIntoArray(Items, TEXT(","), true);
+		TArray<TSharedPtr<FJsonValue>> Arr;
+		for (const FString& Item : Items)
+		{
+			const FString Trimmed = Item.TrimStartAndEnd();
+			if (bNumeric)
+			{
+				Arr.Add(MakeShared<FJsonValueNumber>(FCString::Atod(*Trimmed)));
+			}
+			else
+			{
+				Arr.Add(MakeShared<FJsonValueString>(Trimmed));
+			}
+		}
+		Args->SetArrayField(Field, Arr);
+	}
+}
+
+UAgentForgeBenchmarkCommandlet::UAgentForgeBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UAgentForgeBenchmarkCommandlet::Main(const FString& Params)
+{
+	TSharedPtr<FJsonObject> Args = MakeShared<FJsonObject>();
+	AddListParam(Params, TEXT("cases="), TEXT("cases"), false, Args);
+	AddListParam(Params, TEXT("points="), TEXT("point_counts"), true, Args);
+	AddListParam(Params, TEXT("sizes="), TEXT("heightmap_sizes"), true, Args);
+
+	int32 IntValue = 0;
+	if (FParse::Value(*Params, TEXT("repeats="), IntValue))
+	{
+		Args->SetNumberField(TEXT("repeats"), IntValue);
+	}
+	if (FParse::Value(*Params, TEXT("seed="), IntValue))
+	{
+		Args->SetNumberField(TEXT("seed"), IntValue);
+	}
+	FString StringValue;
+	if (FParse::Value(*Params, TEXT("label="), StringValue))
+	{
+		Args->SetStringField(TEXT("label"), StringValue);
+	}
+	if (FParse::Value(*Params, TEXT("output="), StringValue))
+	{
+		Args->SetStringField(TEXT("output_dir"), StringValue);
+	}
+
+	const FString Result = FAgentForgeBenchmark::MakeBenchmarkJob(Args)->RunToCompletion();
+
+	TSharedPtr<FJsonObject> ResultObj;
+	const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Result);
+	if (!FJsonSerializer::Deserialize(Reader, ResultObj) || !ResultObj.IsValid() || !ResultObj->GetBoolField(TEXT("ok")))
+	{
+		UE_LOG(LogTemp, Error, TEXT("[UEAgentForge] Benchmark failed: %s"), *Result);
+		return 1;
+	}
+	UE_LOG(LogTemp, Display, TEXT("[UEAgentForge] Benchmark report: %s"), *ResultObj->GetStringField(TEXT("json_path")));
+	UE_LOG(LogTemp, Display, TEXT("[UEAgentForge] Benchmark report: %s"), *ResultObj->GetStringField(TEXT("csv_path")));
+	return ResultObj->GetBoolField(TEXT("written")) ? 0 : 1;
+}
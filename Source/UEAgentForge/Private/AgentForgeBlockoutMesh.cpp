@@ -0,0 +1,138 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeBlockoutMesh.cpp — box accumulation, merged FDynamicMesh3 build and the mesh actor.
+
+#include "AgentForgeBlockoutMesh.h"
+#include "AgentForgeSpawnBatch.h"
+
+#include "Components/DynamicMeshComponent.h"
+#include "DynamicMesh/DynamicMesh3.h"
+#include "DynamicMesh/DynamicMeshAttributeSet.h"
+#include "GameFramework/Actor.h"
+#include "Materials/MaterialInterface.h"
+#include "UObject/UObjectGlobals.h"
+
+using UE::Geometry::FDynamicMesh3;
+using UE::Geometry::FDynamicMeshNormalOverlay;
+using UE::Geometry::FDynamicMeshUVOverlay;
+using UE::Geometry::FIndex3i;
+
+void FAgentForgeBlockoutMesh::AddBox(const FVector& Center, const FVector& DimensionsCm, const FRotator& Rotation, UMaterialInterface* Material)
+{
+	int32 MaterialIndex = Materials.Find(Material);
+	if (MaterialIndex == INDEX_NONE)
+	{
+		MaterialIndex = Materials.Add(Material);
+	}
+
+	FBlockoutBox& Box = Boxes.AddDefaulted_GetRef();
+	Box.Center = Center;
+	Box.HalfExtent = DimensionsCm * 0.5;
+	Box.Rotation = Rotation;
+	Box.MaterialIndex = MaterialIndex;
+}
+
+AActor* FAgentForgeBlockoutMesh::BuildActor(UWorld* World, const FString& Label, const FVector& Origin, FString& OutError) const
+{
+	OutError.Reset();
+	if (Boxes.Num() == 0)
+	{
+		OutError = TEXT("Merged blockout mesh has no boxes.");
+		return nullptr;
+	}
+
+	FDynamicMesh3 Mesh;
+	Mesh.EnableAttributes();
+	Mesh.Attributes()->EnableMaterialID();
+	FDynamicMeshUVOverlay* UVs = Mesh.Attributes()->PrimaryUV();
+	FDynamicMeshNormalOverlay* Normals = Mesh.Attributes()->PrimaryNormals();
+
+	// Each face gets its own four vertices: hard edges, and per-face world-aligned UVs.
+	auto AppendFace = [&](const FVector& FaceCenter, const FVector& Normal, const FVector& U, const FVector& V, int32 MaterialIndex)
+	{
+		// U x V points along Normal, so (0,1,2) and (0,2,3) wind outward.
+		const FVector Corners[4] =
+		{
+			FaceCenter - U - V,
+			FaceCenter + U - V,
+			FaceCenter + U + V,
+			FaceCenter - U + V,
+		};
+
+		// Top and bottom project on XY; sides on their horizontal axis and Z.
+		const bool bHorizontal = FMath::Abs(Normal.Z) > 0.7071;
+		const FVector Across = bHorizontal ? FVector::XAxisVector : FVector::CrossProduct(FVector::UpVector, Normal).GetSafeNormal();
+
+		int32 VertexIds[4];
+		int32 UVIds[4];
+		int32 NormalIds[4];
+		for (int32 Corner = 0; Corner < 4; ++Corner)
+		{
+			const FVector& P = Corners[Corner];
+			const FVector2f UV = bHorizontal
+				? FVector2f((float)(P.X * UVScale), (float)(P.Y * UVScale))
+				: FVector2f((float)(FVector::DotProduct(P, Across) * UVScale), (float)(-P.Z * UVScale));
+			VertexIds[Corner] = Mesh.AppendVertex(FVector3d(P - Origin));
+			UVIds[Corner] = UVs->AppendElement(UV);
+			NormalIds[Corner] = Normals->AppendElement(FVector3f(Normal));
+		}
+
+		const FIndex3i Tris[2] = { FIndex3i(0, 1, 2), FIndex3i(0, 2, 3) };
+		for (const FIndex3i& Tri : Tris)
+		{
+			const int32 TriangleId = Mesh.AppendTriangle(VertexIds[Tri.A], VertexIds[Tri.B], VertexIds[Tri.C]);
+			if (TriangleId < 0)
+			{
+				continue;
+			}
+			UVs->SetTriangle(TriangleId, FIndex3i(UVIds[Tri.A], UVIds[Tri.B], UVIds[Tri.C]));
+			Normals->SetTriangle(TriangleId, FIndex3i(NormalIds[Tri.A], NormalIds[Tri.B], NormalIds[Tri.C]));
+			Mesh.Attributes()->GetMaterialID()->SetValue(TriangleId, MaterialIndex);
+		}
+	};
+
+	for (const FBlockoutBox& Box : Boxes)
+	{
+		const FQuat Q = Box.Rotation.Quaternion();
+		const FVector X = Q.GetAxisX() * Box.HalfExtent.X;
+		const FVector Y = Q.GetAxisY() * Box.HalfExtent.Y;
+		const FVector Z = Q.GetAxisZ() * Box.HalfExtent.Z;
+		const FVector NX = Q.GetAxisX();
+		const FVector NY = Q.GetAxisY();
+		const FVector NZ = Q.GetAxisZ();
+
+		AppendFace(Box.Center + X,  NX, Y, Z, Box.MaterialIndex);
+		AppendFace(Box.Center - X, -NX, Z, Y, Box.MaterialIndex);
+		AppendFace(Box.Center + Y,  NY, Z, X, Box.MaterialIndex);
+		AppendFace(Box.Center - Y, -NY, X, Z, Box.MaterialIndex);
+		AppendFace(Box.Center + Z,  NZ, X, Y, Box.MaterialIndex);
+		AppendFace(Box.Center - Z, -NZ, Y, X, Box.MaterialIndex);
+	}
+
+	AActor* Actor = FAgentForgeSpawnBatch::SpawnGroupActor(World, Origin, Label, OutError);
+	if (!Actor)
+	{
+		return nullptr;
+	}
+
+	UDynamicMeshComponent* Component = NewObject<UDynamicMeshComponent>(
+		Actor,
+		MakeUniqueObjectName(Actor, UDynamicMeshComponent::StaticClass(), TEXT("AgentForgeBlockoutMesh")),
+		RF_Transactional);
+	if (!Component)
+	{
+		OutError = TEXT("Failed to create dynamic mesh component.");
+		return nullptr;
+	}
+
+	// Configured before registration, so render and collision state build once.
+	Component->CreationMethod = EComponentCreationMethod::Instance;
+	Component->SetMobility(EComponentMobility::Static);
+	Component->SetMesh(MoveTemp(Mesh));
+	Component->ConfigureMaterialSet(Materials);
+	Component->SetComplexAsSimpleCollisionEnabled(true, /*bImmediateUpdate*/ false);
+	Component->SetCollisionProfileName(TEXT("BlockAll"));
+	Component->SetupAttachment(Actor->GetRootComponent());
+	Actor->AddInstanceComponent(Component);
+	Component->RegisterComponent();
+	return Actor;
+}
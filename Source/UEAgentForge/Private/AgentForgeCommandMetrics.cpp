@@ -0,0 +1,120 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeCommandMetrics.cpp — recording, rolling percentiles, JSON; AgentForge trace channel.
+
+#include "AgentForgeCommandMetrics.h"
+
+#include "AgentForgeTrace.h"
+#include "Dom/JsonValue.h"
+
+UE_TRACE_CHANNEL_DEFINE(AgentForgeChannel);
+
+FAgentForgeCommandMetrics& FAgentForgeCommandMetrics::Get()
+{
+	static FAgentForgeCommandMetrics Instance;
+	return Instance;
+}
+
+void FAgentForgeCommandMetrics::Record(const FString& Cmd, double Ms, int64 BytesIn, int64 BytesOut, bool bError)
+{
+	check(IsInGameThread());
+	FCommandMetrics& M = Commands.FindOrAdd(Cmd);
+	++M.Calls;
+	M.Errors   += bError ? 1 : 0;
+	M.BytesIn  += BytesIn;
+	M.BytesOut += BytesOut;
+	M.TotalMs  += Ms;
+	M.MaxMs     = FMath::Max(M.MaxMs, Ms);
+
+	int32 Bucket = 0;
+	while (Bucket < NumBoundedBuckets && Ms > BucketUpperMs[Bucket])
+	{
+		++Bucket;
+	}
+	++M.Buckets[Bucket];
+
+	if (M.Window.Num() < WindowSize)
+	{
+		M.Window.Add(static_cast<float>(Ms));
+	}
+	else
+	{
+		M.Window[M.NextSlot] = static_cast<float>(Ms);
+		M.NextSlot = (M.NextSlot + 1) % WindowSize;
+	}
+}
+
+TSharedPtr<FJsonObject> FAgentForgeCommandMetrics::ToJson(const FCommandMetrics& M)
+{
+	TArray<float> Sorted = M.Window;
+	Sorted.Sort();
+	auto Percentile = [&Sorted](double P) -> double
+	{
+		if (Sorted.IsEmpty()) { return 0.0; }
+		const int32 Rank = FMath::Clamp(FMath::CeilToInt(P * Sorted.Num()) - 1, 0, Sorted.Num() - 1);
+		return Sorted[Rank];
+	};
+
+	TArray<TSharedPtr<FJsonValue>> Histogram;
+	for (const int64 Count : M.Buckets)
+	{
+		Histogram.Add(MakeShared<FJsonValueNumber>(static_cast<double>(Count)));
+	}
+
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetNumberField(TEXT("calls"),     (double)M.Calls);
+	Obj->SetNumberField(TEXT("errors"),    (double)M.Errors);
+	Obj->SetNumberField(TEXT("bytes_in"),  (double)M.BytesIn);
+	Obj->SetNumberField(TEXT("bytes_out"), (double)M.BytesOut);
+	Obj->SetNumberField(TEXT("mean_ms"),   M.Calls > 0 ? M.TotalMs / M.Calls : 0.0);
+	Obj->SetNumberField(TEXT("max_ms"),    M.MaxMs);
+	Obj->SetNumberField(TEXT("p50_ms"),    Percentile(0.50));
+	Obj->SetNumberField(TEXT("p95_ms"),    Percentile(0.95));
+	Obj->SetNumberField(TEXT("p99_ms"),    Percentile(0.99));
+	Obj->SetNumberField(TEXT("window"),    Sorted.Num());
+	Obj->SetArrayField (TEXT("histogram"), Histogram);
+	return Obj;
+}
+
+TSharedPtr<FJsonObject> FAgentForgeCommandMetrics::GetMetricsJson(const FString& Only) const
+{
+	TArray<TSharedPtr<FJsonValue>> Bounds;
+	for (const double UpperMs : BucketUpperMs)
+	{
+		Bounds.Add(MakeShared<FJsonValueNumber>(UpperMs));
+	}
+
+	TSharedPtr<FJsonObject> PerCommand = MakeShared<FJsonObject>();
+	for (const TPair<FString, FCommandMetrics>& Pair : Commands)
+	{
+		if (Only.IsEmpty() || Pair.Key == Only)
+		{
+			PerCommand->SetObjectField(Pair.Key, ToJson(Pair.Value));
+		}
+	}
+
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetArrayField (TEXT("bucket_le_ms"), Bounds);
+	Obj->SetNumberField(TEXT("window_size"),  WindowSize);
+	Obj->SetObjectField(TEXT("commands"),     PerCommand);
+	return Obj;
+}
+
+TSharedPtr<FJsonObject> FAgentForgeCommandMetrics::GetStatsJson() const
+{
+	int64 Calls = 0, Errors = 0, BytesIn = 0, BytesOut = 0;
+	for (const TPair<FString, FCommandMetrics>& Pair : Commands)
+	{
+		Calls    += Pair.Value.Calls;
+		Errors   += Pair.Value.Errors;
+		BytesIn  += Pair.Value.BytesIn;
+		BytesOut += Pair.Value.BytesOut;
+	}
+
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetNumberField(TEXT("commands"),  Commands.Num());
+	Obj->SetNumberField(TEXT("calls"),     (double)Calls);
+	Obj->SetNumberField(TEXT("errors"),    (double)Errors);
+	Obj->SetNumberField(TEXT("bytes_in"),  (double)BytesIn);
+	Obj->SetNumberField(TEXT("bytes_out"), (double)BytesOut);
+	return Obj;
+}
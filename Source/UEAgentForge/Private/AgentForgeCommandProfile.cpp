@@ -0,0 +1,196 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeCommandProfile.cpp — stage timing, UObject creation count, timings splice.
+
+#include "AgentForgeCommandProfile.h"
+
+#include "Dom/JsonValue.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/UObjectArray.h"
+#include <atomic>
+
+FAgentForgeCommandProfile* FAgentForgeCommandProfile::Active = nullptr;
+double FAgentForgeCommandProfile::PendingWaitMs = 0.0;
+
+// Async loading may construct objects off the game thread, hence the atomic.
+struct FAgentForgeCommandProfile::FObjectCounter : public FUObjectArray::FUObjectCreateListener
+{
+	std::atomic<int64> Created { 0 };
+	bool bRegistered = false;
+
+	FObjectCounter()
+	{
+		GUObjectArray.AddUObjectCreateListener(this);
+		bRegistered = true;
+	}
+
+	virtual ~FObjectCounter() override
+	{
+		if (bRegistered)
+		{
+			GUObjectArray.RemoveUObjectCreateListener(this);
+		}
+	}
+
+	virtual void NotifyUObjectCreated(const UObjectBase* Object, int32 Index) override
+	{
+		Created.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	virtual void OnUObjectArrayShutdown() override
+	{
+		GUObjectArray.RemoveUObjectCreateListener(this);
+		bRegistered = false;
+	}
+};
+
+FAgentForgeCommandProfile::FAgentForgeCommandProfile()
+	: UsedPhysicalAtStart(FPlatformMemory::GetStats().UsedPhysical)
+	, ObjectCounter(MakeUnique<FObjectCounter>())
+	, Previous(Active)
+{
+	check(IsInGameThread());
+	Active = this;
+}
+
+FAgentForgeCommandProfile::~FAgentForgeCommandProfile()
+{
+	Active = Previous;
+}
+
+double FAgentForgeCommandProfile::TakePendingWaitMs()
+{
+	const double Ms = PendingWaitMs;
+	PendingWaitMs = 0.0;
+	return Ms;
+}
+
+FString FAgentForgeCommandProfile::CategoryOf(const FString& Name)
+{
+	int32 Dot = INDEX_NONE;
+	return Name.FindChar(TEXT('.'), Dot) ? Name.Left(Dot) : Name;
+}
+
+int32 FAgentForgeCommandProfile::EnterStage(const FString& Name)
+{
+	for (int32 Index = 0; Index < Stages.Num(); ++Index)
+	{
+		if (Stages[Index].Depth == Depth && Stages[Index].Name == Name)
+		{
+			++Stages[Index].Calls;
+			return Index;
+		}
+	}
+	FStage& Stage = Stages.AddDefaulted_GetRef();
+	Stage.Name  = Name;
+	Stage.Depth = Depth;
+	Stage.Calls = 1;
+	return Stages.Num() - 1;
+}
+
+FAgentForgeCommandProfile::FStageScope::FStageScope(const TCHAR* Name)
+	: Profile(GetActive())
+{
+	if (!Profile)
+	{
+		return;
+	}
+	FString StageName = Name;
+	StageName.RemoveFromStart(TEXT("AgentForge."), ESearchCase::CaseSensitive);
+	Stage = Profile->EnterStage(StageName);
+	bOutermostOfCategory = Profile->OpenCategories.FindOrAdd(CategoryOf(StageName))++ == 0;
+	++Profile->Depth;
+	StartSeconds = FPlatformTime::Seconds();
+}
+
+FAgentForgeCommandProfile::FStageScope::~FStageScope()
+{
+	if (!Profile)
+	{
+		return;
+	}
+	const double Ms = (FPlatformTime::Seconds() - StartSeconds) * 1000.0;
+	--Profile->Depth;
+	FStage& Entry = Profile->Stages[Stage];
+	Entry.Ms += Ms;
+
+	const FString Category = CategoryOf(Entry.Name);
+	--Profile->OpenCategories.FindChecked(Category);
+	if (bOutermostOfCategory)
+	{
+		Profile->Categories.FindOrAdd(Category) += Ms;
+	}
+}
+
+TSharedPtr<FJsonObject> FAgentForgeCommandProfile::ToJson(double TotalMs) const
+{
+	TArray<TSharedPtr<FJsonValue>> StagesArr;
+	StagesArr.Reserve(Stages.Num());
+	for (const FStage& Stage : Stages)
+	{
+		TSharedPtr<FJsonObject> Entry = MakeShared<FJsonObject>();
+		Entry->SetStringField(TEXT("name"),  Stage.Name);
+		Entry->SetNumberField(TEXT("depth"), Stage.Depth);
+		Entry->SetNumberField(TEXT("calls"), Stage.Calls);
+		Entry->SetNumberField(TEXT("ms"),    Stage.Ms);
+		StagesArr.Add(MakeShared<FJsonValueObject>(Entry));
+	}
+
+	TSharedPtr<FJsonObject> CategoriesObj = MakeShared<FJsonObject>();
+	for (const TPair<FString, double>& Pair : Categories)
+	{
+		CategoriesObj->SetNumberField(Pair.Key, Pair.Value);
+	}
+
+	const double UsedDeltaMB = (static_cast<double>(FPlatformMemory::GetStats().UsedPhysical) - static_cast<double>(UsedPhysicalAtStart)) / (1024.0 * 1024.0);
+	TSharedPtr<FJsonObject> Allocations = MakeShared<FJsonObject>();
+	Allocations->SetNumberField(TEXT("uobjects_created"),      (double)ObjectCounter->Created.load(std::memory_order_relaxed));
+	Allocations->SetNumberField(TEXT("used_physical_delta_mb"), UsedDeltaMB);
+
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetNumberField(TEXT("total_ms"),        TotalMs);
+	Obj->SetNumberField(TEXT("queue_wait_ms"),   QueueWaitMs);
+	Obj->SetNumberField(TEXT("parse_ms"),        ParseMs);
+	Obj->SetNumberField(TEXT("handler_ms"),      HandlerMs);
+	Obj->SetNumberField(TEXT("verification_ms"), Categories.FindRef(TEXT("Verification")));
+	Obj->SetNumberField(TEXT("serialize_ms"),    Categories.FindRef(TEXT("Serialize")));
+	Obj->SetObjectField(TEXT("categories"),      CategoriesObj);
+	Obj->SetArrayField (TEXT("stages"),          StagesArr);
+	Obj->SetObjectField(TEXT("allocations"),     Allocations);
+	return Obj;
+}
+
+FString FAgentForgeCommandProfile::AttachTimings(const FString& ResponseJson, const TSharedPtr<FJsonObject>& Timings)
+{
+	// Splice before the closing brace instead of re-parsing a possibly large response.
+	int32 Close = ResponseJson.Len() - 1;
+	while (Close >= 0 && FChar::IsWhitespace(ResponseJson[Close]))
+	{
+		--Close;
+	}
+	if (Close < 1 || ResponseJson[Close] != TEXT('}'))
+	{
+		return ResponseJson;
+	}
+	int32 Last = Close - 1;
+	while (Last >= 0 && FChar::IsWhitespace(ResponseJson[Last]))
+	{
+		--Last;
+	}
+
+	FString TimingsJson;
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer =
+		TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&TimingsJson);
+	FJsonSerializer::Serialize(Timings.ToSharedRef(), Writer);
+
+	FString Out;
+	Out.Reserve(ResponseJson.Len() + TimingsJson.Len() + 16);
+	Out.Append(*ResponseJson, Last + 1);
+	Out += (Last >= 0 && ResponseJson[Last] == TEXT('{')) ? TEXT("\"timings\":") : TEXT(",\"timings\":");
+	Out += TimingsJson;
+	Out += TEXT("}");
+	return Out;
+}
@@ -0,0 +1,233 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeCommandQueue.cpp — MPSC request queue drained by the core ticker.
+
+#include "AgentForgeCommandQueue.h"
+
+#include "AgentForgeCommandProfile.h"
+#include "AgentForgeCommandRegistry.h"
+#include "AgentForgeLibrary.h"
+#include "AgentForgeRequestEnvelope.h"
+#include "AgentForgeStringKeys.h"
+#include "Dom/JsonValue.h"
+#include "HAL/PlatformTime.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace
+{
+	static FString QueueErrorJson(const FString& Msg)
+	{
+		TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+		Obj->SetBoolField(TEXT("ok"), false);
+		Obj->SetStringField(TEXT("error"), Msg);
+		FString Out;
+		TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Out);
+		FJsonSerializer::Serialize(Obj.ToSharedRef(), Writer);
+		return Out;
+	}
+}
+
+FAgentForgeCommandQueue& FAgentForgeCommandQueue::Get()
+{
+	static FAgentForgeCommandQueue Queue;
+	return Queue;
+}
+
+void FAgentForgeCommandQueue::Initialize()
+{
+	check(IsInGameThread());
+	if (!TickHandle.IsValid())
+	{
+		TickHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateRaw(this, &FAgentForgeCommandQueue::Tick));
+	}
+	bAccepting.store(true, std::memory_order_release);
+}
+
+void FAgentForgeCommandQueue::Shutdown()
+{
+	check(IsInGameThread());
+	bAccepting.store(false, std::memory_order_release);
+	if (TickHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+		TickHandle.Reset();
+	}
+
+	TUniquePtr<FRequest> Request;
+	while (Inbox.Dequeue(Request))
+	{
+		Fail(*Request, TEXT("Engine shutdown in progress; command rejected."));
+	}
+}
+
+TFuture<FString> FAgentForgeCommandQueue::Enqueue(const FString& RequestJson)
+{
+	if (!IsAcceptingRequests())
+	{
+		return MakeFulfilledPromise<FString>(QueueErrorJson(TEXT("Command queue is not running; command rejected."))).GetFuture();
+	}
+
+	// Parsed on the caller's thread; the game thread only dispatches.
+	TUniquePtr<FRequest> Request = MakeUnique<FRequest>();
+	Request->Json = RequestJson;
+	const double ParseStartSeconds = FPlatformTime::Seconds();
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(RequestJson);
+	if (!FJsonSerializer::Deserialize(Reader, Request->Root) || !Request->Root.IsValid())
+	{
+		Request->Root.Reset();
+	}
+	Request->EnqueueSeconds = FPlatformTime::Seconds();
+	Request->ParseMs        = (Request->EnqueueSeconds - ParseStartSeconds) * 1000.0;
+	TFuture<FString> Future = Request->Promise.GetFuture();
+
+	const int32 NewDepth = Depth.fetch_add(1, std::memory_order_relaxed) + 1;
+	int32 PrevMax = MaxDepth.load(std::memory_order_relaxed);
+	while (NewDepth > PrevMax && !MaxDepth.compare_exchange_weak(PrevMax, NewDepth, std::memory_order_relaxed))
+	{
+	}
+	TotalEnqueued.fetch_add(1, std::memory_order_relaxed);
+
+	Inbox.Enqueue(MoveTemp(Request));
+	return Future;
+}
+
+bool FAgentForgeCommandQueue::MakeCoalesceKey(const TSharedPtr<FJsonObject>& Root, FString& OutKey, FString& OutRequestIdJson)
+{
+	if (!Root.IsValid())
+	{
+		return false;
+	}
+
+	FString Cmd;
+	if (!Root->TryGetStringField(TEXT("cmd"), Cmd))
+	{
+		return false;
+	}
+	Cmd.ToLowerInline();
+	const FAgentForgeCommandInfo* Info = FAgentForgeCommandRegistry::Get().Find(Cmd);
+	if (!Info || !Info->HasFlag(EAgentForgeCommandFlags::Coalescable))
+	{
+		return false;
+	}
+
+	// Args go into their own string: whether a string writer appends to or
+	// replaces its target is not something to rely on across engine versions.
+	FString ArgsJson;
+	const TSharedPtr<FJsonObject>* Args = nullptr;
+	if (Root->TryGetObjectField(TEXT("args"), Args))
+	{
+		TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer =
+			TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&ArgsJson);
+		FJsonSerializer::Serialize(Args->ToSharedRef(), Writer);
+	}
+	OutKey = Cmd + ArgsJson;
+	OutRequestIdJson = FAgentForgeRequestEnvelope::ReadRequestId(Root);
+	return true;
+}
+
+void FAgentForgeCommandQueue::SetFrameBudgetMs(float InBudgetMs)
+{
+	FrameBudgetMs.store(FMath::Clamp(InBudgetMs, 0.5f, 100.0f), std::memory_order_relaxed);
+}
+
+void FAgentForgeCommandQueue::Fail(FRequest& Request, const FString& Message)
+{
+	Depth.fetch_sub(1, std::memory_order_relaxed);
+	++TotalRejected;
+	Request.Promise.SetValue(QueueErrorJson(Message));
+}
+
+bool FAgentForgeCommandQueue::Tick(float DeltaTime)
+{
+	const double Start         = FPlatformTime::Seconds();
+	const double BudgetSeconds = GetFrameBudgetMs() / 1000.0;
+	const bool   bCoalesceNow  = IsCoalesceEnabled();
+
+	// Results of pure queries run during this drain. Any other command may have
+	// changed the world, so it clears the cache. Keys hold client args, so
+	// they compare case-sensitively: label "Wall" is not label "wall".
+	TMap<FString, FString, FDefaultSetAllocator, TAgentForgeCaseSensitiveKeyFuncs<FString>> QueryResults;
+	int32 Count = 0;
+
+	TUniquePtr<FRequest> Request;
+	while ((Count == 0 || FPlatformTime::Seconds() - Start < BudgetSeconds) && Inbox.Dequeue(Request))
+	{
+		const double WaitMs = (FPlatformTime::Seconds() - Request->EnqueueSeconds) * 1000.0;
+		TotalWaitMs += WaitMs;
+		MaxWaitMs = FMath::Max(MaxWaitMs, WaitMs);
+
+		// Unparsable requests go through ExecuteCommandJson for its usual error.
+		auto Execute = [&Request]()
+		{
+			return Request->Root.IsValid()
+				? UAgentForgeLibrary::ExecuteParsedCommandJson(Request->Json, Request->Root, Request->ParseMs)
+				: UAgentForgeLibrary::ExecuteCommandJson(Request->Json);
+		};
+
+		FString Response;
+		FString CoalesceKey;
+		FString RequestIdJson;
+		if (bCoalesceNow && MakeCoalesceKey(Request->Root, CoalesceKey, RequestIdJson))
+		{
+			// Shared results are kept without the request_id of the caller that ran them.
+			if (const FString* Cached = QueryResults.Find(CoalesceKey))
+			{
+				Response = FAgentForgeRequestEnvelope::StampRequestId(*Cached, RequestIdJson);
+				++TotalCoalesced;
+			}
+			else
+			{
+				FAgentForgeCommandProfile::SetPendingWaitMs(WaitMs);
+				Response = Execute();
+				QueryResults.Add(CoalesceKey, FAgentForgeRequestEnvelope::UnstampRequestId(Response, RequestIdJson));
+			}
+		}
+		else
+		{
+			QueryResults.Reset();
+			FAgentForgeCommandProfile::SetPendingWaitMs(WaitMs);
+			Response = Execute();
+		}
+
+		++Count;
+		++TotalExecuted;
+		Depth.fetch_sub(1, std::memory_order_relaxed);
+		Request->Promise.SetValue(MoveTemp(Response));
+	}
+
+	if (Count > 0)
+	{
+		LastDrainMs    = (FPlatformTime::Seconds() - Start) * 1000.0;
+		LastDrainCount = Count;
+		++Drains;
+		if (LastDrainMs > BudgetSeconds * 1000.0)
+		{
+			++DrainsOverBudget;
+		}
+	}
+	return true;
+}
+
+TSharedPtr<FJsonObject> FAgentForgeCommandQueue::GetStatsJson() const
+{
+	const int64 Executed = TotalExecuted;
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetBoolField  (TEXT("running"),            IsAcceptingRequests());
+	Obj->SetNumberField(TEXT("depth"),              FMath::Max(0, Depth.load(std::memory_order_relaxed)));
+	Obj->SetNumberField(TEXT("max_depth"),          MaxDepth.load(std::memory_order_relaxed));
+	Obj->SetNumberField(TEXT("frame_budget_ms"),    GetFrameBudgetMs());
+	Obj->SetBoolField  (TEXT("coalesce_read_only"), IsCoalesceEnabled());
+	Obj->SetNumberField(TEXT("enqueued"),           static_cast<double>(TotalEnqueued.load(std::memory_order_relaxed)));
+	Obj->SetNumberField(TEXT("executed"),           static_cast<double>(Executed));
+	Obj->SetNumberField(TEXT("coalesced"),          static_cast<double>(TotalCoalesced));
+	Obj->SetNumberField(TEXT("rejected"),           static_cast<double>(TotalRejected));
+	Obj->SetNumberField(TEXT("avg_wait_ms"),        Executed > 0 ? TotalWaitMs / static_cast<double>(Executed) : 0.0);
+	Obj->SetNumberField(TEXT("max_wait_ms"),        MaxWaitMs);
+	Obj->SetNumberField(TEXT("drains"),             static_cast<double>(Drains));
+	Obj->SetNumberField(TEXT("drains_over_budget"), static_cast<double>(DrainsOverBudget));
+	Obj->SetNumberField(TEXT("last_drain_ms"),      LastDrainMs);
+	Obj->SetNumberField(TEXT("last_drain_count"),   LastDrainCount);
+	return Obj;
+}
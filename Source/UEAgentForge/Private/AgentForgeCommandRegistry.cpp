@@ -0,0 +1,161 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeCommandRegistry.cpp — hashed command table implementation.
+
+#include "AgentForgeCommandRegistry.h"
+
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  FAgentForgeCommandInfo
+// ─────────────────────────────────────────────────────────────────────────────
+FString FAgentForgeCommandInfo::GetVerificationMode() const
+{
+	if (HasFlag(EAgentForgeCommandFlags::SelfTransacting))
+	{
+		return TEXT("batch_partial_no_snapshot");
+	}
+	if (HasFlag(EAgentForgeCommandFlags::ManualVerification))
+	{
+		return TEXT("bypass_manual_verification");
+	}
+	if (HasFlag(EAgentForgeCommandFlags::Bypass))
+	{
+		return TEXT("bypass_unverified");
+	}
+	if (IsMutating())
+	{
+		if (HasFlag(EAgentForgeCommandFlags::SkipSnapshotRollback))
+		{
+			return HasFlag(EAgentForgeCommandFlags::RollbackLeaky)
+				? TEXT("main_path_partial_compensating_cleanup")
+				: TEXT("main_path_partial_no_snapshot");
+		}
+		return TEXT("main_path_partial");
+	}
+	return TEXT("not_applicable");
+}
+
+FAgentForgeVerificationPlan FAgentForgeCommandInfo::PlanVerification() const
+{
+	FAgentForgeVerificationPlan Plan;
+	if (!IsMutating())
+	{
+		return Plan;
+	}
+	Plan.bPreFlight              = true;
+	Plan.bSnapshotRollback       = !HasFlag(EAgentForgeCommandFlags::SkipSnapshotRollback);
+	Plan.bCompensatingCleanup    = HasFlag(EAgentForgeCommandFlags::RollbackLeaky);
+	Plan.bPostVerify             = true;
+	Plan.bCommandAwarePostVerify = HasPostVerifyContract();
+	Plan.bBuildCheck             = HasFlag(EAgentForgeCommandFlags::EditsBlueprints);
+	return Plan;
+}
+
+int32 FAgentForgeVerificationPlan::GetPhaseMask() const
+{
+	int32 Mask = 0;
+	if (bPreFlight)        { Mask |= static_cast<int32>(EVerificationPhase::PreFlight); }
+	if (bSnapshotRollback) { Mask |= static_cast<int32>(EVerificationPhase::Snapshot); }
+	if (bPostVerify)       { Mask |= static_cast<int32>(EVerificationPhase::PostVerify); }
+	if (bBuildCheck)       { Mask |= static_cast<int32>(EVerificationPhase::BuildCheck); }
+	return Mask;
+}
+
+TSharedPtr<FJsonObject> FAgentForgeVerificationPlan::ToJson() const
+{
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetNumberField(TEXT("phase_mask"), GetPhaseMask());
+	Obj->SetBoolField(TEXT("preflight"), bPreFlight);
+	Obj->SetBoolField(TEXT("snapshot_rollback"), bSnapshotRollback);
+	Obj->SetBoolField(TEXT("compensating_cleanup"), bCompensatingCleanup);
+	Obj->SetBoolField(TEXT("post_verify"), bPostVerify);
+	Obj->SetBoolField(TEXT("command_aware_post_verify"), bCommandAwarePostVerify);
+	Obj->SetBoolField(TEXT("build_check"), bBuildCheck);
+	return Obj;
+}
+
+TSharedPtr<FJsonObject> FAgentForgeCommandInfo::ToJson() const
+{
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetStringField(TEXT("name"), Name.ToString());
+	Obj->SetStringField(TEXT("category"), Category);
+	Obj->SetStringField(TEXT("args"), ArgSchema);
+	Obj->SetBoolField(TEXT("mutating"), IsMutating());
+	Obj->SetBoolField(TEXT("operator_heavy"), IsOperatorHeavy());
+	Obj->SetBoolField(TEXT("direct_placement"), IsDirectPlacement());
+	Obj->SetBoolField(TEXT("memory_guarded"), RequiresMemoryGuard());
+	Obj->SetBoolField(TEXT("self_transacting"), HasFlag(EAgentForgeCommandFlags::SelfTransacting));
+	Obj->SetBoolField(TEXT("bypass"), HasFlag(EAgentForgeCommandFlags::Bypass));
+	Obj->SetBoolField(TEXT("snapshot_rollback"), IsMutating() && !HasFlag(EAgentForgeCommandFlags::SkipSnapshotRollback));
+	Obj->SetBoolField(TEXT("post_verify_contract"), HasPostVerifyContract());
+	Obj->SetBoolField(TEXT("supports_async"), SupportsAsync());
+	Obj->SetBoolField(TEXT("coalescable"), HasFlag(EAgentForgeCommandFlags::Coalescable));
+	Obj->SetStringField(TEXT("verification_mode"), GetVerificationMode());
+	Obj->SetObjectField(TEXT("verification_plan"), PlanVerification().ToJson());
+	return Obj;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  FAgentForgeCommandRegistry
+// ─────────────────────────────────────────────────────────────────────────────
+FAgentForgeCommandRegistry& FAgentForgeCommandRegistry::Get()
+{
+	static FAgentForgeCommandRegistry Registry;
+	return Registry;
+}
+
+void FAgentForgeCommandRegistry::Register(FAgentForgeCommandInfo&& Info)
+{
+	check(IsInGameThread());
+	if (Info.Name.IsNone() || !Info.Handler)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[UEAgentForge] Ignoring command registration without name or handler."));
+		return;
+	}
+
+	const FName Name = Info.Name;
+	if (!Commands.Contains(Name))
+	{
+		Order.Add(Name);
+	}
+	Commands.Add(Name, MoveTemp(Info));
+}
+
+const FAgentForgeCommandInfo* FAgentForgeCommandRegistry::Find(FName Name) const
+{
+	return Name.IsNone() ? nullptr : Commands.Find(Name);
+}
+
+const FAgentForgeCommandInfo* FAgentForgeCommandRegistry::Find(const FString& Cmd) const
+{
+	// FName comparison is case-insensitive; FNAME_Find keeps unknown/garbage
+	// commands from growing the global name table.
+	return Find(FName(*Cmd, FNAME_Find));
+}
+
+void FAgentForgeCommandRegistry::Reset()
+{
+	Commands.Reset();
+	Order.Reset();
+}
+
+TArray<const FAgentForgeCommandInfo*> FAgentForgeCommandRegistry::GetCommands(const FString& CategoryFilter) const
+{
+	TArray<const FAgentForgeCommandInfo*> Out;
+	Out.Reserve(Order.Num());
+	for (const FName& Name : Order)
+	{
+		const FAgentForgeCommandInfo* Info = Commands.Find(Name);
+		if (!Info)
+		{
+			continue;
+		}
+		if (!CategoryFilter.IsEmpty() && !Info->Category.Equals(CategoryFilter, ESearchCase::IgnoreCase))
+		{
+			continue;
+		}
+		Out.Add(Info);
+	}
+	return Out;
+}
@@ -0,0 +1,344 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeCommandTrace.cpp — record buffering, zlib blocks, trace loading.
+
+#include "AgentForgeCommandTrace.h"
+
+#include "AgentForgeActorIndex.h"
+
+#include "Dom/JsonValue.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/Compression.h"
+#include "Misc/Crc.h"
+#include "Misc/DateTime.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/Package.h"
+
+#if WITH_EDITOR
+#include "Editor.h"
+#endif
+
+namespace
+{
+	static constexpr uint32 BlockMagic = 0x31544641;   // "AFT1"
+	static constexpr int32  BlockHeaderBytes = 12;
+	static constexpr int32  FormatVersion = 1;
+
+	/** A block holds one BlockBytes batch plus the record that crossed it; anything far larger is corrupt. */
+	static constexpr int32  MaxBlockRawBytes = 256 * 1024 * 1024;
+
+	static FString ToCondensedJson(const TSharedRef<FJsonObject>& Obj)
+	{
+		FString Out;
+		TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer =
+			TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Out);
+		FJsonSerializer::Serialize(Obj, Writer);
+		return Out;
+	}
+
+	static FString GetEditorMapName()
+	{
+#if WITH_EDITOR
+		const UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+		return World && World->GetOutermost() ? World->GetOutermost()->GetName() : FString();
+#else
+		return FString();
+#endif
+	}
+
+	static void ParseRecord(const FJsonObject& Obj, FAgentForgeTraceRecord& Out)
+	{
+		double Number = 0.0;
+		Out.Sequence = Obj.TryGetNumberField(TEXT("seq"), Number) ? (int64)Number : 0;
+		Obj.TryGetNumberField(TEXT("t"), Out.TimeSeconds);
+		Obj.TryGetStringField(TEXT("cmd"), Out.Cmd);
+		Obj.TryGetStringField(TEXT("request"), Out.Request);
+		Obj.TryGetStringField(TEXT("response"), Out.Response);
+		Out.ResponseBytes = Obj.TryGetNumberField(TEXT("response_bytes"), Number) ? (int64)Number : 0;
+		Out.ResponseCrc = Obj.TryGetNumberField(TEXT("response_crc"), Number) ? (uint32)Number : 0;
+		Obj.TryGetBoolField(TEXT("response_truncated"), Out.bResponseTruncated);
+		Obj.TryGetBoolField(TEXT("error"), Out.bError);
+		Obj.TryGetNumberField(TEXT("queue_wait_ms"), Out.QueueWaitMs);
+		Obj.TryGetNumberField(TEXT("parse_ms"), Out.ParseMs);
+		Obj.TryGetNumberField(TEXT("handler_ms"), Out.HandlerMs);
+		Out.RevisionBefore = Obj.TryGetNumberField(TEXT("revision_before"), Number) ? (int64)Number : 0;
+		Out.RevisionAfter = Obj.TryGetNumberField(TEXT("revision_after"), Number) ? (int64)Number : 0;
+	}
+}
+
+FAgentForgeTraceRecordSettings FAgentForgeTraceRecordSettings::FromJson(const TSharedPtr<FJsonObject>& Args)
+{
+	FAgentForgeTraceRecordSettings Settings;
+	if (!Args.IsValid())
+	{
+		return Settings;
+	}
+	Args->TryGetStringField(TEXT("path"), Settings.Path);
+	double Number = 0.0;
+	if (Args->TryGetNumberField(TEXT("max_response_chars"), Number))
+	{
+		Settings.MaxResponseChars = FMath::Clamp((int32)Number, 0, 64 * 1024 * 1024);
+	}
+	const TArray<TSharedPtr<FJsonValue>>* ExcludeArr = nullptr;
+	if (Args->TryGetArrayField(TEXT("exclude"), ExcludeArr))
+	{
+		for (const TSharedPtr<FJsonValue>& Value : *ExcludeArr)
+		{
+			FString Cmd;
+			if (Value.IsValid() && Value->TryGetString(Cmd) && !Cmd.IsEmpty())
+			{
+				Settings.Exclude.Add(Cmd.ToLower());
+			}
+		}
+	}
+	return Settings;
+}
+
+FAgentForgeCommandTrace& FAgentForgeCommandTrace::Get()
+{
+	static FAgentForgeCommandTrace Instance;
+	return Instance;
+}
+
+FString FAgentForgeCommandTrace::GetDefaultDir()
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("AgentForgeTraces"));
+}
+
+bool FAgentForgeCommandTrace::Start(const FAgentForgeTraceRecordSettings& InSettings, FString& OutError)
+{
+	check(IsInGameThread());
+	Stop();
+
+	FString NewPath = InSettings.Path;
+	if (NewPath.IsEmpty())
+	{
+		NewPath = FPaths::Combine(GetDefaultDir(), FString::Printf(TEXT("trace_%s.aftrace"), *FDateTime::UtcNow().ToString(TEXT("%Y%m%d-%H%M%S"))));
+	}
+	else if (FPaths::IsRelative(NewPath))
+	{
+		NewPath = FPaths::Combine(GetDefaultDir(), NewPath);
+	}
+	NewPath = FPaths::ConvertRelativePathToFull(NewPath);
+
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(NewPath), true);
+	FArchive* File = IFileManager::Get().CreateFileWriter(*NewPath, FILEWRITE_Append | FILEWRITE_AllowRead);
+	if (!File)
+	{
+		OutError = FString::Printf(TEXT("Cannot open trace file %s for writing."), *NewPath);
+		return false;
+	}
+
+	Writer.Reset(File);
+	Settings = InSettings;
+	Path = NewPath;
+	Pending.Reset();
+	StartSeconds = FPlatformTime::Seconds();
+	NextSequence = 1;
+	RecordsWritten = 0;
+	RawBytesWritten = 0;
+	CompressedBytesWritten = 0;
+	BlocksWritten = 0;
+
+	FString PluginVersion = TEXT("unknown");
+	if (const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("UEAgentForge")))
+	{
+		PluginVersion = Plugin->GetDescriptor().VersionName;
+	}
+	TSharedRef<FJsonObject> Header = MakeShared<FJsonObject>();
+	Header->SetStringField(TEXT("type"),           TEXT("session"));
+	Header->SetNumberField(TEXT("version"),        FormatVersion);
+	Header->SetStringField(TEXT("map"),            GetEditorMapName());
+	Header->SetStringField(TEXT("plugin_version"), PluginVersion);
+	Header->SetStringField(TEXT("engine_version"), FEngineVersion::Current().ToString());
+	Header->SetStringField(TEXT("started_utc"),    FDateTime::UtcNow().ToIso8601());
+	Header->SetNumberField(TEXT("revision"),       (double)FAgentForgeActorIndex::Get().GetRevision());
+	AppendLine(Header);
+	// The header goes out at once, so a session that records nothing still shows up.
+	FlushBlock();
+
+	UE_LOG(LogTemp, Log, TEXT("[UEAgentForge] Recording command trace to %s"), *Path);
+	return true;
+}
+
+void FAgentForgeCommandTrace::Stop()
+{
+	if (!Writer.IsValid())
+	{
+		return;
+	}
+	FlushBlock();
+	Writer->Close();
+	Writer.Reset();
+	UE_LOG(LogTemp, Log, TEXT("[UEAgentForge] Command trace stopped: %lld records, %lld bytes in %s"),
+		RecordsWritten, CompressedBytesWritten, *Path);
+}
+
+void FAgentForgeCommandTrace::Record(const FString& Cmd, const FString& Request, const FString& Response, bool bError,
+	double QueueWaitMs, double ParseMs, double HandlerMs, int64 RevisionBefore, int64 RevisionAfter)
+{
+	if (!Writer.IsValid() || Depth != 1 || Settings.Exclude.Contains(Cmd))
+	{
+		return;
+	}
+
+	const bool bTruncated = Response.Len() > Settings.MaxResponseChars;
+	TSharedRef<FJsonObject> Line = MakeShared<FJsonObject>();
+	Line->SetStringField(TEXT("type"),               TEXT("call"));
+	Line->SetNumberField(TEXT("seq"),                (double)NextSequence++);
+	Line->SetNumberField(TEXT("t"),                  FPlatformTime::Seconds() - StartSeconds);
+	Line->SetStringField(TEXT("cmd"),                Cmd);
+	Line->SetStringField(TEXT("request"),            Request);
+	Line->SetStringField(TEXT("response"),           bTruncated ? Response.Left(Settings.MaxResponseChars) : Response);
+	Line->SetNumberField(TEXT("response_bytes"),     (double)FPlatformString::ConvertedLength<UTF8CHAR>(*Response, Response.Len()));
+	Line->SetNumberField(TEXT("response_crc"),       (double)FCrc::StrCrc32(*Response));
+	Line->SetBoolField  (TEXT("response_truncated"), bTruncated);
+	Line->SetBoolField  (TEXT("error"),              bError);
+	Line->SetNumberField(TEXT("queue_wait_ms"),      QueueWaitMs);
+	Line->SetNumberField(TEXT("parse_ms"),           ParseMs);
+	Line->SetNumberField(TEXT("handler_ms"),         HandlerMs);
+	Line->SetNumberField(TEXT("revision_before"),    (double)RevisionBefore);
+	Line->SetNumberField(TEXT("revision_after"),     (double)RevisionAfter);
+	AppendLine(Line);
+	++RecordsWritten;
+
+	if (Pending.Num() >= BlockBytes)
+	{
+		FlushBlock();
+	}
+}
+
+void FAgentForgeCommandTrace::AppendLine(const TSharedRef<FJsonObject>& Line)
+{
+	const FString Text = ToCondensedJson(Line);
+	const FTCHARToUTF8 Utf8(*Text, Text.Len());
+	Pending.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+	Pending.Add('\n');
+}
+
+void FAgentForgeCommandTrace::FlushBlock()
+{
+	if (!Writer.IsValid() || Pending.Num() == 0)
+	{
+		return;
+	}
+
+	int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, Pending.Num());
+	TArray<uint8> Compressed;
+	Compressed.SetNumUninitialized(CompressedSize);
+	if (!FCompression::CompressMemory(NAME_Zlib, Compressed.GetData(), CompressedSize, Pending.GetData(), Pending.Num()))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[UEAgentForge] Command trace block compression failed; %d bytes dropped."), Pending.Num());
+		Pending.Reset();
+		return;
+	}
+
+	uint32 Magic = BlockMagic;
+	uint32 RawSize = (uint32)Pending.Num();
+	uint32 PackedSize = (uint32)CompressedSize;
+	*Writer << Magic << RawSize << PackedSize;
+	Writer->Serialize(Compressed.GetData(), CompressedSize);
+	Writer->Flush();
+
+	RawBytesWritten += Pending.Num();
+	CompressedBytesWritten += BlockHeaderBytes + CompressedSize;
+	++BlocksWritten;
+	Pending.Reset();
+}
+
+TSharedPtr<FJsonObject> FAgentForgeCommandTrace::GetStatsJson() const
+{
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetBoolField  (TEXT("recording"),        IsRecording());
+	Obj->SetStringField(TEXT("path"),             Path);
+	Obj->SetNumberField(TEXT("records"),          (double)RecordsWritten);
+	Obj->SetNumberField(TEXT("blocks"),           (double)BlocksWritten);
+	Obj->SetNumberField(TEXT("raw_bytes"),        (double)RawBytesWritten);
+	Obj->SetNumberField(TEXT("compressed_bytes"), (double)CompressedBytesWritten);
+	Obj->SetNumberField(TEXT("pending_bytes"),    Pending.Num());
+	return Obj;
+}
+
+bool FAgentForgeCommandTrace::Load(const FString& InPath, TArray<FAgentForgeTraceSession>& OutSessions, FString& OutError)
+{
+	OutSessions.Reset();
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *InPath))
+	{
+		OutError = FString::Printf(TEXT("Cannot read trace file %s."), *InPath);
+		return false;
+	}
+
+	int64 Offset = 0;
+	TArray<uint8> Raw;
+	while (Offset + BlockHeaderBytes <= Bytes.Num())
+	{
+		uint32 Header[3];
+		FMemory::Memcpy(Header, Bytes.GetData() + Offset, BlockHeaderBytes);
+		if (Header[0] != BlockMagic)
+		{
+			OutError = FString::Printf(TEXT("Bad block magic at byte %lld of %s."), Offset, *InPath);
+			return false;
+		}
+		if (Header[1] > (uint32)MaxBlockRawBytes)
+		{
+			OutError = FString::Printf(TEXT("Oversized block at byte %lld of %s."), Offset, *InPath);
+			return false;
+		}
+		if (Offset + BlockHeaderBytes + (int64)Header[2] > (int64)Bytes.Num())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[UEAgentForge] Trace %s ends in a truncated block; it was skipped."), *InPath);
+			break;
+		}
+
+		Raw.SetNumUninitialized((int32)Header[1]);
+		if (!FCompression::UncompressMemory(NAME_Zlib, Raw.GetData(), (int32)Header[1], Bytes.GetData() + Offset + BlockHeaderBytes, (int32)Header[2]))
+		{
+			OutError = FString::Printf(TEXT("Corrupt block at byte %lld of %s."), Offset, *InPath);
+			return false;
+		}
+		Offset += BlockHeaderBytes + (int64)Header[2];
+
+		const FUTF8ToTCHAR Text(reinterpret_cast<const UTF8CHAR*>(Raw.GetData()), Raw.Num());
+		TArray<FString> Lines;
+		FString(Text.Length(), Text.Get()).ParseIntoArrayLines(Lines);
+		for (const FString& Line : Lines)
+		{
+			TSharedPtr<FJsonObject> Obj;
+			const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Line);
+			if (!FJsonSerializer::Deserialize(Reader, Obj) || !Obj.IsValid())
+			{
+				continue;
+			}
+			FString Type;
+			Obj->TryGetStringField(TEXT("type"), Type);
+			if (Type == TEXT("session"))
+			{
+				FAgentForgeTraceSession& Session = OutSessions.AddDefaulted_GetRef();
+				Obj->TryGetStringField(TEXT("map"), Session.Map);
+				Obj->TryGetStringField(TEXT("plugin_version"), Session.PluginVersion);
+				Obj->TryGetStringField(TEXT("engine_version"), Session.EngineVersion);
+				Obj->TryGetStringField(TEXT("started_utc"), Session.StartedUtc);
+				double Revision = 0.0;
+				Session.Revision = Obj->TryGetNumberField(TEXT("revision"), Revision) ? (int64)Revision : 0;
+			}
+			else if (Type == TEXT("call"))
+			{
+				if (OutSessions.Num() == 0)
+				{
+					OutSessions.AddDefaulted();
+				}
+				ParseRecord(*Obj, OutSessions.Last().Records.AddDefaulted_GetRef());
+			}
+		}
+	}
+	return true;
+}
@@ -0,0 +1,150 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeInstancedScatter.cpp — HISM lookup/creation and batched instance insertion.
+
+#include "AgentForgeInstancedScatter.h"
+
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "GameFramework/Actor.h"
+#include "Materials/MaterialInterface.h"
+#include "UObject/UObjectGlobals.h"
+
+void FAgentForgeInstanceBatch::Reserve(int32 Num)
+{
+	Transforms.Reserve(Num);
+	Tints.Reserve(Num);
+	Scales.Reserve(Num);
+}
+
+void FAgentForgeInstanceBatch::Add(const FTransform& Transform, const FLinearColor& Tint, float Scale)
+{
+	Transforms.Add(Transform);
+	Tints.Add(Tint);
+	Scales.Add(Scale);
+}
+
+bool FAgentForgeInstancedScatter::ParseOutput(const FString& Name, EAgentForgeScatterOutput& OutMode)
+{
+	if (Name.IsEmpty())
+	{
+		return true;
+	}
+	if (Name.Equals(TEXT("actors"), ESearchCase::IgnoreCase))
+	{
+		OutMode = EAgentForgeScatterOutput::Actors;
+		return true;
+	}
+	if (Name.Equals(TEXT("instances"), ESearchCase::IgnoreCase))
+	{
+		OutMode = EAgentForgeScatterOutput::Instances;
+		return true;
+	}
+	return false;
+}
+
+const TCHAR* FAgentForgeInstancedScatter::OutputName(EAgentForgeScatterOutput Mode)
+{
+	return Mode == EAgentForgeScatterOutput::Instances ? TEXT("instances") : TEXT("actors");
+}
+
+UHierarchicalInstancedStaticMeshComponent* FAgentForgeInstancedScatter::FindOrAddComponent(AActor* Owner, UStaticMesh* Mesh, UMaterialInterface* Material)
+{
+	if (!Owner || !Mesh)
+	{
+		return nullptr;
+	}
+
+	TInlineComponentArray<UHierarchicalInstancedStaticMeshComponent*> Existing(Owner);
+	for (UHierarchicalInstancedStaticMeshComponent* Component : Existing)
+	{
+		if (!Component || Component->GetStaticMesh() != Mesh)
+		{
+			continue;
+		}
+		UMaterialInterface* Override = Component->OverrideMaterials.IsValidIndex(0) ? Component->OverrideMaterials[0].Get() : nullptr;
+		if (Override == Material)
+		{
+			return Component;
+		}
+	}
+
+	const FName ComponentName = MakeUniqueObjectName(
+		Owner,
+		UHierarchicalInstancedStaticMeshComponent::StaticClass(),
+		*FString::Printf(TEXT("AgentForgeInstances_%s"), *Mesh->GetName()));
+	UHierarchicalInstancedStaticMeshComponent* Component =
+		NewObject<UHierarchicalInstancedStaticMeshComponent>(Owner, ComponentName, RF_Transactional);
+	if (!Component)
+	{
+		return nullptr;
+	}
+
+	Component->CreationMethod = EComponentCreationMethod::Instance;
+	Component->SetMobility(EComponentMobility::Static);
+	Component->SetStaticMesh(Mesh);
+	if (Material)
+	{
+		Component->SetMaterial(0, Material);
+	}
+	Component->SetNumCustomDataFloats(NumCustomData);
+
+	if (USceneComponent* Root = Owner->GetRootComponent())
+	{
+		Component->SetupAttachment(Root);
+	}
+	else
+	{
+		Owner->SetRootComponent(Component);
+	}
+	Owner->AddInstanceComponent(Component);
+	Component->RegisterComponent();
+	return Component;
+}
+
+int32 FAgentForgeInstancedScatter::AddInstances(UHierarchicalInstancedStaticMeshComponent* Component, const FAgentForgeInstanceBatch& Batch)
+{
+	if (!Component || Batch.Num() == 0)
+	{
+		return INDEX_NONE;
+	}
+
+	Component->Modify();
+	if (Component->NumCustomDataFloats != NumCustomData)
+	{
+		Component->SetNumCustomDataFloats(NumCustomData);
+	}
+
+	// One insertion: the HISM tree is rebuilt once instead of per instance.
+	const int32 FirstIndex = Component->GetInstanceCount();
+	Component->AddInstances(Batch.Transforms, /*bShouldReturnIndices*/ false, /*bWorldSpace*/ true);
+
+	float CustomData[NumCustomData];
+	for (int32 Index = 0; Index < Batch.Num(); ++Index)
+	{
+		const FLinearColor Tint = Batch.Tints.IsValidIndex(Index) ? Batch.Tints[Index] : FLinearColor::White;
+		CustomData[0] = Tint.R;
+		CustomData[1] = Tint.G;
+		CustomData[2] = Tint.B;
+		CustomData[3] = Batch.Scales.IsValidIndex(Index) ? Batch.Scales[Index] : (float)Batch.Transforms[Index].GetScale3D().X;
+		Component->SetCustomData(FirstIndex + Index, MakeArrayView(CustomData, NumCustomData), /*bMarkRenderStateDirty*/ false);
+	}
+	Component->MarkRenderStateDirty();
+	return FirstIndex;
+}
+
+int32 FAgentForgeInstancedScatter::CountInstances(const AActor* Owner)
+{
+	int32 Count = 0;
+	if (Owner)
+	{
+		TInlineComponentArray<UHierarchicalInstancedStaticMeshComponent*> Components(Owner);
+		for (const UHierarchicalInstancedStaticMeshComponent* Component : Components)
+		{
+			if (Component)
+			{
+				Count += Component->GetInstanceCount();
+			}
+		}
+	}
+	return Count;
+}
@@ -0,0 +1,397 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeJobManager.cpp — staged job execution and the tick-driven job queue.
+
+#include "AgentForgeJobManager.h"
+
+#include "AgentForgeTrace.h"
+#include "Dom/JsonValue.h"
+#include "HAL/PlatformTime.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace
+{
+	static TSharedPtr<FJsonObject> ParseJobJson(const FString& In)
+	{
+		TSharedPtr<FJsonObject> Obj;
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(In);
+		if (FJsonSerializer::Deserialize(Reader, Obj) && Obj.IsValid())
+		{
+			return Obj;
+		}
+		return nullptr;
+	}
+
+	static FString JobErrorJson(const FString& Msg, bool bCancelled)
+	{
+		TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+		Obj->SetBoolField(TEXT("ok"), false);
+		Obj->SetStringField(TEXT("error"), Msg);
+		if (bCancelled) { Obj->SetBoolField(TEXT("cancelled"), true); }
+		FString Out;
+		TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Out);
+		FJsonSerializer::Serialize(Obj.ToSharedRef(), Writer);
+		return Out;
+	}
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  FAgentForgeJob
+// ─────────────────────────────────────────────────────────────────────────────
+FAgentForgeJob::FAgentForgeJob(const FString& InCommand)
+	: Command(InCommand)
+{
+	SubmitSeconds = FPlatformTime::Seconds();
+}
+
+FAgentForgeJob& FAgentForgeJob::AddStage(const FString& Name, FStep Step, float Weight)
+{
+	FStage& Stage = Stages.AddDefaulted_GetRef();
+	Stage.Name   = Name;
+	Stage.Step   = MoveTemp(Step);
+	Stage.Weight = FMath::Max(Weight, 0.01f);
+	return *this;
+}
+
+FAgentForgeJob& FAgentForgeJob::SetFinalizer(FFinalizer InFinalizer)
+{
+	Finalizer = MoveTemp(InFinalizer);
+	return *this;
+}
+
+FAgentForgeJob& FAgentForgeJob::SetCancelHandler(FCancelHandler InHandler)
+{
+	CancelHandler = MoveTemp(InHandler);
+	return *this;
+}
+
+FAgentForgeJob& FAgentForgeJob::AddResultFilter(FResultFilter InFilter)
+{
+	if (InFilter) { ResultFilters.Add(MoveTemp(InFilter)); }
+	return *this;
+}
+
+void FAgentForgeJob::SetStageProgress(float Fraction)
+{
+	StageProgress = FMath::Clamp(Fraction, 0.0f, 1.0f);
+}
+
+void FAgentForgeJob::AddPartialResult(const TSharedPtr<FJsonObject>& Partial)
+{
+	if (!Partial.IsValid()) { return; }
+	if (!Partial->HasField(TEXT("stage")))
+	{
+		Partial->SetStringField(TEXT("stage"), GetCurrentStageName());
+	}
+	PartialResults.Add(MakeShared<FJsonValueObject>(Partial));
+}
+
+void FAgentForgeJob::Finish(const FString& ResultJson)
+{
+	bFinishRequested = true;
+	Result = ResultJson;
+}
+
+bool FAgentForgeJob::IsFinished() const
+{
+	return State == EAgentForgeJobState::Succeeded
+		|| State == EAgentForgeJobState::Failed
+		|| State == EAgentForgeJobState::Cancelled;
+}
+
+void FAgentForgeJob::Complete(const FString& RawResult, EAgentForgeJobState FinalState)
+{
+	FString Filtered = RawResult;
+	if (FinalState != EAgentForgeJobState::Cancelled)
+	{
+		for (const FResultFilter& Filter : ResultFilters)
+		{
+			Filtered = Filter(Filtered);
+		}
+
+		const TSharedPtr<FJsonObject> Parsed = ParseJobJson(Filtered);
+		bool bOk = Parsed.IsValid() && !Parsed->HasField(TEXT("error"));
+		if (bOk && Parsed->HasTypedField<EJson::Boolean>(TEXT("ok")))
+		{
+			bOk = Parsed->GetBoolField(TEXT("ok"));
+		}
+		FinalState = bOk ? EAgentForgeJobState::Succeeded : EAgentForgeJobState::Failed;
+	}
+
+	Result     = MoveTemp(Filtered);
+	State      = FinalState;
+	EndSeconds = FPlatformTime::Seconds();
+	if (FinalState == EAgentForgeJobState::Succeeded)
+	{
+		StageIndex    = Stages.Num();
+		StageProgress = 0.0f;
+	}
+}
+
+bool FAgentForgeJob::Step()
+{
+	if (IsFinished())
+	{
+		return true;
+	}
+
+	AGENTFORGE_TRACE_SCOPE_TEXT(*Command);
+	const double StepStart = FPlatformTime::Seconds();
+	if (State == EAgentForgeJobState::Queued)
+	{
+		State        = EAgentForgeJobState::Running;
+		StartSeconds = StepStart;
+	}
+	++Slices;
+
+	if (Stages.IsValidIndex(StageIndex))
+	{
+		AGENTFORGE_TRACE_SCOPE_TEXT(*Stages[StageIndex].Name);
+		if (Stages[StageIndex].Step(*this))
+		{
+			++StageIndex;
+			StageProgress = 0.0f;
+		}
+	}
+
+	if (bFinishRequested)
+	{
+		Complete(Result, EAgentForgeJobState::Succeeded);
+	}
+	else if (!Stages.IsValidIndex(StageIndex))
+	{
+		AGENTFORGE_TRACE_SCOPE("AgentForge.Job.Finalize");
+		Complete(Finalizer ? Finalizer(*this) : JobErrorJson(TEXT("Job has no finalizer."), false), EAgentForgeJobState::Succeeded);
+	}
+
+	BusyMs += (FPlatformTime::Seconds() - StepStart) * 1000.0;
+	return IsFinished();
+}
+
+FString FAgentForgeJob::RunToCompletion()
+{
+	while (!Step())
+	{
+	}
+	return Result;
+}
+
+void FAgentForgeJob::Cancel()
+{
+	if (IsFinished())
+	{
+		return;
+	}
+	if (State == EAgentForgeJobState::Running && CancelHandler)
+	{
+		CancelHandler(*this);
+	}
+	Complete(JobErrorJson(TEXT("Job cancelled."), true), EAgentForgeJobState::Cancelled);
+}
+
+float FAgentForgeJob::GetPercentComplete() const
+{
+	if (State == EAgentForgeJobState::Succeeded) { return 100.0f; }
+
+	float Total = 0.0f;
+	float Done  = 0.0f;
+	for (int32 i = 0; i < Stages.Num(); ++i)
+	{
+		Total += Stages[i].Weight;
+		if (i < StageIndex)       { Done += Stages[i].Weight; }
+		else if (i == StageIndex) { Done += Stages[i].Weight * StageProgress; }
+	}
+	return Total > 0.0f ? FMath::Clamp(100.0f * Done / Total, 0.0f, 100.0f) : 0.0f;
+}
+
+FString FAgentForgeJob::GetCurrentStageName() const
+{
+	if (State == EAgentForgeJobState::Queued)    { return TEXT("queued"); }
+	if (State == EAgentForgeJobState::Succeeded) { return TEXT("done"); }
+	return Stages.IsValidIndex(StageIndex) ? Stages[StageIndex].Name : FString(TEXT("finalize"));
+}
+
+const TCHAR* FAgentForgeJob::StateToString(EAgentForgeJobState InState)
+{
+	switch (InState)
+	{
+	case EAgentForgeJobState::Queued:    return TEXT("queued");
+	case EAgentForgeJobState::Running:   return TEXT("running");
+	case EAgentForgeJobState::Succeeded: return TEXT("succeeded");
+	case EAgentForgeJobState::Failed:    return TEXT("failed");
+	case EAgentForgeJobState::Cancelled: return TEXT("cancelled");
+	default:                             return TEXT("unknown");
+	}
+}
+
+TSharedPtr<FJsonObject> FAgentForgeJob::ToJson(bool bIncludePartialResults, bool bIncludeResult) const
+{
+	const double Now = FPlatformTime::Seconds();
+	const double ElapsedEnd = IsFinished() ? EndSeconds : Now;
+
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetStringField(TEXT("job_id"),           Id);
+	Obj->SetStringField(TEXT("cmd"),              Command);
+	Obj->SetStringField(TEXT("state"),            StateToString(State));
+	Obj->SetBoolField  (TEXT("finished"),         IsFinished());
+	Obj->SetStringField(TEXT("stage"),            GetCurrentStageName());
+	Obj->SetNumberField(TEXT("stage_index"),      FMath::Min(StageIndex, Stages.Num()));
+	Obj->SetNumberField(TEXT("stage_count"),      Stages.Num());
+	Obj->SetNumberField(TEXT("percent_complete"), GetPercentComplete());
+	Obj->SetNumberField(TEXT("slices"),           Slices);
+	Obj->SetNumberField(TEXT("busy_ms"),          BusyMs);
+	Obj->SetNumberField(TEXT("frame_budget_ms"),  FrameBudgetMs);
+	Obj->SetNumberField(TEXT("queued_ms"),        ((StartSeconds > 0.0 ? StartSeconds : ElapsedEnd) - SubmitSeconds) * 1000.0);
+	Obj->SetNumberField(TEXT("elapsed_ms"),       StartSeconds > 0.0 ? (ElapsedEnd - StartSeconds) * 1000.0 : 0.0);
+
+	if (bIncludePartialResults)
+	{
+		Obj->SetArrayField(TEXT("partial_results"), PartialResults);
+	}
+	if (bIncludeResult && IsFinished())
+	{
+		const TSharedPtr<FJsonObject> Parsed = ParseJobJson(Result);
+		if (Parsed.IsValid()) { Obj->SetObjectField(TEXT("result"), Parsed); }
+		else                  { Obj->SetStringField(TEXT("result_raw"), Result); }
+	}
+	return Obj;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  FAgentForgeJobManager
+// ─────────────────────────────────────────────────────────────────────────────
+FAgentForgeJobManager& FAgentForgeJobManager::Get()
+{
+	static FAgentForgeJobManager Manager;
+	return Manager;
+}
+
+FString FAgentForgeJobManager::Submit(const TSharedRef<FAgentForgeJob>& Job, float FrameBudgetMs)
+{
+	check(IsInGameThread());
+	Job->Id            = FString::Printf(TEXT("job_%d"), NextJobSerial++);
+	Job->FrameBudgetMs = FMath::Clamp(FrameBudgetMs, 1.0f, 100.0f);
+	Queue.Add(Job);
+
+	if (!TickHandle.IsValid())
+	{
+		TickHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateRaw(this, &FAgentForgeJobManager::Tick));
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[UEAgentForge] Job %s queued (%s, %d pending)."),
+	       *Job->Id, *Job->Command, Queue.Num());
+	return Job->Id;
+}
+
+TSharedPtr<FAgentForgeJob> FAgentForgeJobManager::Find(const FString& JobId) const
+{
+	for (const TSharedRef<FAgentForgeJob>& Job : Queue)
+	{
+		if (Job->Id == JobId) { return Job; }
+	}
+	for (const TSharedRef<FAgentForgeJob>& Job : Finished)
+	{
+		if (Job->Id == JobId) { return Job; }
+	}
+	return nullptr;
+}
+
+bool FAgentForgeJobManager::Cancel(const FString& JobId, FString& OutError)
+{
+	const int32 Index = Queue.IndexOfByPredicate(
+		[&JobId](const TSharedRef<FAgentForgeJob>& Job) { return Job->Id == JobId; });
+	if (Index == INDEX_NONE)
+	{
+		OutError = Find(JobId).IsValid()
+			? FString::Printf(TEXT("Job %s has already finished."), *JobId)
+			: FString::Printf(TEXT("Unknown job: %s"), *JobId);
+		return false;
+	}
+
+	TSharedRef<FAgentForgeJob> Job = Queue[Index];
+	Queue.RemoveAt(Index);
+	Job->Cancel();
+	Retire(Job);
+	JobEvent.Broadcast(*Job, true);
+	UE_LOG(LogTemp, Log, TEXT("[UEAgentForge] Job %s cancelled."), *JobId);
+	return true;
+}
+
+TArray<TSharedRef<FAgentForgeJob>> FAgentForgeJobManager::GetJobs() const
+{
+	TArray<TSharedRef<FAgentForgeJob>> Out = Queue;
+	for (int32 i = Finished.Num() - 1; i >= 0; --i)
+	{
+		Out.Add(Finished[i]);
+	}
+	return Out;
+}
+
+void FAgentForgeJobManager::Shutdown()
+{
+	if (TickHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+		TickHandle.Reset();
+	}
+	while (!Queue.IsEmpty())
+	{
+		TSharedRef<FAgentForgeJob> Job = Queue.Pop();
+		Job->Cancel();
+		Retire(Job);
+	}
+}
+
+void FAgentForgeJobManager::Retire(const TSharedRef<FAgentForgeJob>& Job)
+{
+	Finished.Add(Job);
+	if (Finished.Num() > MaxFinishedJobsRetained)
+	{
+		Finished.RemoveAt(0, Finished.Num() - MaxFinishedJobsRetained);
+	}
+}
+
+bool FAgentForgeJobManager::Tick(float /*DeltaTime*/)
+{
+	const double SliceStart = FPlatformTime::Seconds();
+	while (!Queue.IsEmpty())
+	{
+		TSharedRef<FAgentForgeJob> Job = Queue[0];
+		const double BudgetSeconds = Job->FrameBudgetMs / 1000.0;
+
+		// At least one step per tick so a job whose steps exceed the budget still advances.
+		bool bDone = false;
+		Job->bYieldRequested = false;
+		do
+		{
+			bDone = Job->Step();
+		}
+		while (!bDone && !Job->bYieldRequested && (FPlatformTime::Seconds() - SliceStart) < BudgetSeconds);
+
+		if (!bDone)
+		{
+			JobEvent.Broadcast(*Job, false);
+			break;
+		}
+
+		Queue.RemoveAt(0);
+		Retire(Job);
+		JobEvent.Broadcast(*Job, true);
+		UE_LOG(LogTemp, Log, TEXT("[UEAgentForge] Job %s %s after %d slices (%.1f ms busy)."),
+		       *Job->Id, FAgentForgeJob::StateToString(Job->State), Job->Slices, Job->BusyMs);
+
+		if ((FPlatformTime::Seconds() - SliceStart) >= BudgetSeconds)
+		{
+			break;
+		}
+	}
+
+	if (Queue.IsEmpty())
+	{
+		TickHandle.Reset();
+		return false;   // unregister until the next Submit
+	}
+	return true;
+}
@@ -12,8 +12,37 @@
 #include "LevelPipelineModule.h"    // v0.4.0 Five-Phase AAA Level Pipeline
 #include "Operators/ProceduralOpsModule.h"    // v0.5.0 Deterministic Operator Pipeline
 #include "LLM/AgentForgeLLMSubsystem.h"
+#include "LLM/AgentForgeSchemaRegistry.h"
 #include "LLM/AgentForgeSchemaService.h"
 #include "LLM/AgentForgeVisionAnalyzer.h"
+#include "LLM/AgentForgeImageEncoder.h"
+#include "LLM/AgentForgeVisionCache.h"
+#include "LLM/AgentForgeLLMCache.h"
+#include "AgentForgeCommandRegistry.h"
+#include "AgentForgeCommandMetrics.h"
+#include "AgentForgeCommandTrace.h"
+#include "AgentForgeMemoryMonitor.h"
+#include "AgentForgeWorkerFarm.h"
+#include "AgentForgeCommandProfile.h"
+#include "AgentForgeTrace.h"
+#include "AgentForgeJobManager.h"
+#include "AgentForgeCommandQueue.h"
+#include "AgentForgeRequestEnvelope.h"
+#include "AgentForgeSocketServer.h"
+#include "AgentForgeResponseWriter.h"
+#include "AgentForgeActorQuery.h"
+#include "AgentForgeActorIndex.h"
+#include "AgentForgeArgs.h"
+#include "AgentForgeProceduralCache.h"
+#include "AgentForgeBenchmark.h"
+#include "AgentForgeSurfaceTrace.h"
+#include "AgentForgeLightGrid.h"
+#include "AgentForgeWorldStats.h"
+#include "AgentForgeWorldSnapshot.h"
+#include "AgentForgeSpawnBatch.h"
+#include "AgentForgeBlockoutMesh.h"
+#include "AgentForgeAssetCatalog.h"
+#include "Palette/PaletteManager.h"
 #include "Dom/JsonObject.h"
 #include "Dom/JsonValue.h"
 #include "Serialization/JsonReader.h"
@@ -36,9 +65,11 @@
 #include "HAL/FileManager.h"
 #include "Engine/StaticMesh.h"
 #include "Engine/StaticMeshActor.h"
+#include "AgentForgeInstancedScatter.h"
 #include "Engine/SpotLight.h"
 #include "Engine/RectLight.h"
 #include "Components/StaticMeshComponent.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
 #include "Components/MeshComponent.h"
 #include "Components/SceneComponent.h"
 #include "Components/LightComponent.h"
@@ -91,6 +122,7 @@
 #include "RHIStats.h"
 #include "HAL/PlatformMemory.h"
 #include "EngineUtils.h"
+#include "GameFramework/WorldSettings.h"
 // Python scripting
 #include "IPythonScriptPlugin.h"
 // Transaction safety — explicit with NoPCHs
@@ -130,17 +162,6 @@ static TUniquePtr<FScopedTransaction> GOpenTransaction;
 // Shutdown barrier for close-time command rejection.
 static FThreadSafeBool GForgeShutdownRequested(false);
 
-static bool IsLowMemory(float& OutUsedPercent, float& OutAvailableMB)
-{
-	const FPlatformMemoryStats Mem = FPlatformMemory::GetStats();
-	const double TotalMB = static_cast<double>(Mem.TotalPhysical) / (1024.0 * 1024.0);
-	const double UsedMB = static_cast<double>(Mem.UsedPhysical) / (1024.0 * 1024.0);
-	OutAvailableMB = static_cast<float>(static_cast<double>(Mem.AvailablePhysical) / (1024.0 * 1024.0));
-	OutUsedPercent = (TotalMB > 0.0) ? static_cast<float>((UsedMB / TotalMB) * 100.0) : 0.0f;
-	// Conservative thresholds to avoid hard OOM/editor freeze under heavy generation.
-	return (OutAvailableMB < 2048.0f) || (OutUsedPercent >= 92.0f);
-}
-
 static void SaveNewPackage(UPackage* Package, UObject* Asset)
 {
 	FString PackageFilename;
@@ -416,48 +437,7 @@ static void AddActorSummary(TArray<TSharedPtr<FJsonValue>>& OutArray, AActor* Ac
 
 static AActor* SpawnGroupActor(UWorld* World, const FString& Label, const FVector& Location, FString& OutError)
 {
-	if (!World)
-	{
-		OutError = TEXT("No editor world.");
-		return nullptr;
-	}
-
-	FActorSpawnParameters Params;
-	PrepareWorldForTransactionalSpawn(World);
-	Params.ObjectFlags |= RF_Transactional;
-	Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-	AActor* GroupActor = World->SpawnActor<AActor>(AActor::StaticClass(), Location, FRotator::ZeroRotator, Params);
-	if (!GroupActor)
-	{
-		OutError = TEXT("Failed to spawn group actor.");
-		return nullptr;
-	}
-
-	MarkActorTransactionalRecursive(GroupActor);
-	if (!Label.IsEmpty())
-	{
-		GroupActor->SetActorLabel(Label);
-	}
-
-	if (!GroupActor->GetRootComponent())
-	{
-		USceneComponent* Root = NewObject<USceneComponent>(GroupActor, TEXT("AgentForgeRoot"), RF_Transactional);
-		if (!Root)
-		{
-			OutError = TEXT("Failed to create group root component.");
-			return nullptr;
-		}
-
-		Root->CreationMethod = EComponentCreationMethod::Instance;
-		MarkObjectTransactional(Root);
-		Root->SetMobility(EComponentMobility::Static);
-		GroupActor->SetRootComponent(Root);
-		GroupActor->AddInstanceComponent(Root);
-		Root->RegisterComponent();
-	}
-
-	GroupActor->SetActorLocation(Location);
-	return GroupActor;
+	return FAgentForgeSpawnBatch::SpawnGroupActor(World, Location, Label, OutError);
 }
 
 static AStaticMeshActor* SpawnBoxActor(
@@ -495,56 +475,67 @@ static AStaticMeshActor* SpawnBoxActor(
 		return nullptr;
 	}
 
-	FActorSpawnParameters Params;
-	PrepareWorldForTransactionalSpawn(World);
-	Params.ObjectFlags |= RF_Transactional;
-	Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-	AStaticMeshActor* Actor = World->SpawnActor<AStaticMeshActor>(AStaticMeshActor::StaticClass(), Center, Rotation, Params);
-	if (!Actor)
-	{
-		OutError = TEXT("Failed to spawn static mesh actor.");
-		return nullptr;
-	}
+	FAgentForgeStaticMeshSpawn Spawn;
+	Spawn.Mesh = CubeMesh;
+	Spawn.Material = Material;
+	Spawn.Transform = FTransform(Rotation, Center, DimensionsCm / 100.0);
+	Spawn.Label = Label;
+	return FAgentForgeSpawnBatch::SpawnStaticMeshActor(World, Spawn, OutError);
+}
 
-	MarkActorTransactionalRecursive(Actor);
-	if (!Label.IsEmpty())
-	{
-		Actor->SetActorLabel(Label);
-	}
+static bool AttachActorToParent(AActor* Child, AActor* Parent)
+{
+	return FAgentForgeSpawnBatch::Attach(Child, Parent);
+}
 
-	UStaticMeshComponent* MeshComp = Actor->GetStaticMeshComponent();
-	if (!MeshComp)
+// output: "actors" (default, one cube actor per box) or "merged" (one dynamic mesh per group).
+static bool ParseBlockoutOutput(const TSharedPtr<FJsonObject>& Args, bool& bOutMerged, FString& OutError)
+{
+	bOutMerged = false;
+	FString OutputName;
+	if (!Args.IsValid() || !Args->TryGetStringField(TEXT("output"), OutputName) || OutputName.IsEmpty()
+		|| OutputName.Equals(TEXT("actors"), ESearchCase::IgnoreCase))
 	{
-		OutError = TEXT("Spawned static mesh actor has no static mesh component.");
-		return nullptr;
+		return true;
 	}
-
-	MarkObjectTransactional(MeshComp);
-	MeshComp->SetMobility(EComponentMobility::Static);
-	MeshComp->SetStaticMesh(CubeMesh);
-	Actor->SetActorScale3D(FVector(
-		DimensionsCm.X / 100.0f,
-		DimensionsCm.Y / 100.0f,
-		DimensionsCm.Z / 100.0f));
-
-	if (Material)
+	if (OutputName.Equals(TEXT("merged"), ESearchCase::IgnoreCase))
 	{
-		MeshComp->SetMaterial(0, Material);
+		bOutMerged = true;
+		return true;
 	}
-
-	return Actor;
+	OutError = FString::Printf(TEXT("Unknown output '%s' (expected actors or merged)."), *OutputName);
+	return false;
 }
 
-static bool AttachActorToParent(AActor* Child, AActor* Parent)
+static bool AddMergedBox(
+	FAgentForgeBlockoutMesh& Merged,
+	const FVector& Center,
+	const FVector& DimensionsCm,
+	const FRotator& Rotation,
+	const FString& MaterialPath,
+	FString& OutError)
 {
-	if (!Child || !Parent)
+	if (DimensionsCm.X <= KINDA_SMALL_NUMBER || DimensionsCm.Y <= KINDA_SMALL_NUMBER || DimensionsCm.Z <= KINDA_SMALL_NUMBER)
+	{
+		OutError = TEXT("Box dimensions must be greater than zero.");
+		return false;
+	}
+	UMaterialInterface* Material = nullptr;
+	if (!LoadOptionalMaterial(MaterialPath, Material, OutError))
 	{
 		return false;
 	}
+	Merged.AddBox(Center, DimensionsCm, Rotation, Material);
+	return true;
+}
 
-	MarkActorTransactionalRecursive(Child);
-	MarkActorTransactionalRecursive(Parent);
-	return Child->AttachToActor(Parent, FAttachmentTransformRules::KeepWorldTransform);
+static TSharedPtr<FJsonObject> MakeMergedBlockoutJson(const FAgentForgeBlockoutMesh& Merged)
+{
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetNumberField(TEXT("boxes"),          Merged.NumBoxes());
+	Obj->SetNumberField(TEXT("triangles"),      Merged.NumTriangles());
+	Obj->SetNumberField(TEXT("material_slots"), Merged.NumMaterials());
+	return Obj;
 }
 
 static FString SpawnLinearWallSegments(
@@ -560,7 +551,8 @@ static FString SpawnLinearWallSegments(
 	float WindowSpacing,
 	float WindowHeight,
 	AActor* ParentActor,
-	TArray<AActor*>& OutSegments)
+	TArray<AActor*>& OutSegments,
+	FAgentForgeBlockoutMesh* MergeInto = nullptr)
 {
 	const FVector Delta = End - Start;
 	const float Length = Delta.Size();
@@ -591,6 +583,10 @@ static FString SpawnLinearWallSegments(
 			FVector(0.0f, 0.0f, SegmentBottomZ + (SegmentHeight * 0.5f));
 
 		FString SpawnError;
+		if (MergeInto)
+		{
+			return AddMergedBox(*MergeInto, SegmentCenter, FVector(SegmentLength, Thickness, SegmentHeight), Rotation, MaterialPath, SpawnError);
+		}
 		AStaticMeshActor* SegmentActor = SpawnBoxActor(
 			World,
 			SegmentCenter,
@@ -717,39 +713,12 @@ static AStaticMeshActor* SpawnStaticMeshPrimitiveActor(
 		return nullptr;
 	}
 
-	FActorSpawnParameters Params;
-	PrepareWorldForTransactionalSpawn(World);
-	Params.ObjectFlags |= RF_Transactional;
-	Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-	AStaticMeshActor* Actor = World->SpawnActor<AStaticMeshActor>(AStaticMeshActor::StaticClass(), Center, Rotation, Params);
-	if (!Actor)
-	{
-		OutError = TEXT("Failed to spawn static mesh actor.");
-		return nullptr;
-	}
-
-	MarkActorTransactionalRecursive(Actor);
-	if (!Label.IsEmpty())
-	{
-		Actor->SetActorLabel(Label);
-	}
-
-	UStaticMeshComponent* MeshComp = Actor->GetStaticMeshComponent();
-	if (!MeshComp)
-	{
-		OutError = TEXT("Spawned static mesh actor has no static mesh component.");
-		return nullptr;
-	}
-
-	MarkObjectTransactional(MeshComp);
-	MeshComp->SetMobility(EComponentMobility::Static);
-	MeshComp->SetStaticMesh(Mesh);
-	Actor->SetActorScale3D(Scale3D);
-	if (Material)
-	{
-		MeshComp->SetMaterial(0, Material);
-	}
-	return Actor;
+	FAgentForgeStaticMeshSpawn Spawn;
+	Spawn.Mesh = Mesh;
+	Spawn.Material = Material;
+	Spawn.Transform = FTransform(Rotation, Center, Scale3D);
+	Spawn.Label = Label;
+	return FAgentForgeSpawnBatch::SpawnStaticMeshActor(World, Spawn, OutError);
 }
 
 template<typename TActor>
@@ -845,26 +814,6 @@ static bool ParseCardinalDirection(const FString& DirectionInput, FVector& OutFo
 	return false;
 }
 
-static bool RaycastDownToSurface(UWorld* World, const FVector& XYLocation, float QueryZ, FVector& OutHitLocation)
-{
-	if (!World)
-	{
-		return false;
-	}
-
-	const FVector Start(XYLocation.X, XYLocation.Y, QueryZ + 5000.0f);
-	const FVector End(XYLocation.X, XYLocation.Y, QueryZ - 5000.0f);
-	FHitResult Hit;
-	FCollisionQueryParams Params(SCENE_QUERY_STAT(AgentForgeScatterSurfaceTrace), true);
-	if (!World->LineTraceSingleByChannel(Hit, Start, End, ECC_Visibility, Params))
-	{
-		return false;
-	}
-
-	OutHitLocation = Hit.ImpactPoint;
-	return true;
-}
-
 static UActorComponent* FindActorComponentByNameOrClass(AActor* Actor, const FString& Segment)
 {
 	if (!Actor || Segment.IsEmpty())
@@ -1162,6 +1111,7 @@ static bool ParseChatMessages(
 			FAgentForgeChatMessage Message;
 			(*MessageObj)->TryGetStringField(TEXT("role"), Message.Role);
 			(*MessageObj)->TryGetStringField(TEXT("content"), Message.Content);
+			(*MessageObj)->TryGetBoolField(TEXT("cache_breakpoint"), Message.bCacheBreakpoint);
 
 			const TArray<TSharedPtr<FJsonValue>>* ImageDataValues = nullptr;
 			if ((*MessageObj)->TryGetArrayField(TEXT("image_data"), ImageDataValues) && ImageDataValues)
@@ -1220,46 +1170,136 @@ static TSharedPtr<FJsonObject> BuildLLMResponseObject(
 	Obj->SetStringField(TEXT("raw_json"), Response.RawJSON);
 	Obj->SetStringField(TEXT("reasoning_content"), Response.ReasoningContent);
 	Obj->SetNumberField(TEXT("prompt_tokens"), Response.PromptTokens);
+	Obj->SetNumberField(TEXT("cached_prompt_tokens"), Response.CachedPromptTokens);
+	Obj->SetNumberField(TEXT("cache_write_tokens"), Response.CacheWriteTokens);
 	Obj->SetNumberField(TEXT("completion_tokens"), Response.CompletionTokens);
+	Obj->SetBoolField(TEXT("from_cache"), Response.bFromCache);
 	return Obj;
 }
 
-static TArray<FString> ChunkTextForStream(const FString& Content, int32 TargetChars = 160)
+/** "cache" (response cache mode), "prompt_cache" (provider-side prompt prefix caching) and "priority" (scheduler lane). */
+static bool ParseLLMRequestOptions(const TSharedPtr<FJsonObject>& Args, FAgentForgeLLMSettings& OutSettings, FString& OutError)
 {
-	TArray<FString> Chunks;
-	if (Content.IsEmpty())
+	if (!Args.IsValid())
+	{
+		return true;
+	}
+	Args->TryGetBoolField(TEXT("prompt_cache"), OutSettings.bCachePrompt);
+
+	FString PriorityName;
+	if (Args->TryGetStringField(TEXT("priority"), PriorityName))
+	{
+		if (PriorityName.Equals(TEXT("interactive"), ESearchCase::IgnoreCase))
+		{
+			OutSettings.Priority = EAgentForgeLLMPriority::Interactive;
+		}
+		else if (PriorityName.Equals(TEXT("background"), ESearchCase::IgnoreCase))
+		{
+			OutSettings.Priority = EAgentForgeLLMPriority::Background;
+		}
+		else
+		{
+			OutError = FString::Printf(TEXT("Unknown priority '%s' (interactive | background)."), *PriorityName);
+			return false;
+		}
+	}
+
+	FString CacheName;
+	if (!Args->TryGetStringField(TEXT("cache"), CacheName))
+	{
+		return true;
+	}
+	if (!FAgentForgeLLMResponseCache::ParseMode(CacheName, OutSettings.CacheMode))
 	{
-		return Chunks;
+		OutError = FString::Printf(TEXT("Unknown cache mode '%s' (bypass | prefer | only)."), *CacheName);
+		return false;
 	}
+	return true;
+}
 
-	TArray<FString> Words;
-	Content.ParseIntoArray(Words, TEXT(" "), true);
-	FString CurrentChunk;
-	for (const FString& Word : Words)
+// One llm_stream request: text deltas in arrival order, pushed to socket clients
+// (and the job's partial_results when run with "async":true) as they come in.
+struct FLLMStreamRun
+{
+	FAgentForgeLLMSettings Settings;
+	FAgentForgeLLMResponse Response;
+	TArray<TSharedPtr<FJsonValue>> Chunks;
+	double StartSeconds = 0.0;
+	double FirstChunkMs = -1.0;
+	int32 RequestId = 0;
+	bool bDispatched = false;
+	bool bDone = false;
+
+	void AddChunk(const FString& Text, FAgentForgeJob* Job)
 	{
-		const FString Candidate = CurrentChunk.IsEmpty() ? Word : CurrentChunk + TEXT(" ") + Word;
-		if (!CurrentChunk.IsEmpty() && Candidate.Len() > TargetChars)
+		if (FirstChunkMs < 0.0)
+		{
+			FirstChunkMs = (FPlatformTime::Seconds() - StartSeconds) * 1000.0;
+		}
+		TSharedPtr<FJsonObject> ChunkEvent = MakeShared<FJsonObject>();
+		ChunkEvent->SetStringField(TEXT("cmd"),   TEXT("llm_stream"));
+		ChunkEvent->SetNumberField(TEXT("index"), Chunks.Num());
+		ChunkEvent->SetStringField(TEXT("text"),  Text);
+		if (Job)
 		{
-			Chunks.Add(CurrentChunk);
-			CurrentChunk = Word;
+			FAgentForgeSocketServer::Get().PushJobEvent(Job->GetId(), TEXT("stream_chunk"), ChunkEvent);
+			Job->AddPartialResult(ChunkEvent);
 		}
 		else
 		{
-			CurrentChunk = Candidate;
+			FAgentForgeSocketServer::Get().PushEvent(TEXT("stream_chunk"), ChunkEvent);
 		}
+		Chunks.Add(MakeShared<FJsonValueString>(Text));
+	}
+
+	TSharedPtr<FJsonObject> ToJson() const
+	{
+		TSharedPtr<FJsonObject> Obj = BuildLLMResponseObject(Response, Settings.Provider, Settings.Model);
+		Obj->SetBoolField(TEXT("streamed"), true);
+		Obj->SetNumberField(TEXT("chunk_count"), Chunks.Num());
+		Obj->SetArrayField(TEXT("chunks"), Chunks);
+		Obj->SetNumberField(TEXT("first_chunk_ms"), FirstChunkMs);
+		Obj->SetNumberField(TEXT("total_ms"), (FPlatformTime::Seconds() - StartSeconds) * 1000.0);
+		return Obj;
 	}
+};
 
-	if (!CurrentChunk.IsEmpty())
+static bool ParseLLMStreamArgs(const TSharedPtr<FJsonObject>& Args, FAgentForgeLLMSettings& OutSettings, FString& OutError)
+{
+	FString ProviderString;
+	if (!Args.IsValid() || !Args->TryGetStringField(TEXT("provider"), ProviderString))
+	{
+		OutError = TEXT("llm_stream requires 'provider'.");
+		return false;
+	}
+	if (!Args->TryGetStringField(TEXT("model"), OutSettings.Model))
 	{
-		Chunks.Add(CurrentChunk);
+		OutError = TEXT("llm_stream requires 'model'.");
+		return false;
 	}
+	Args->TryGetStringField(TEXT("system"), OutSettings.SystemPrompt);
+	Args->TryGetStringField(TEXT("custom_endpoint"), OutSettings.CustomEndpoint);
 
-	if (Chunks.Num() == 0)
+	if (!ParseLLMProviderName(ProviderString, OutSettings.Provider))
+	{
+		OutError = FString::Printf(TEXT("Unknown LLM provider: %s"), *ProviderString);
+		return false;
+	}
+	if (!ParseChatMessages(Args, OutSettings.Messages, OutError) || !ParseLLMRequestOptions(Args, OutSettings, OutError))
 	{
-		Chunks.Add(Content);
+		return false;
 	}
 
-	return Chunks;
+	OutSettings.bStreamResponse = true;
+	if (Args->HasField(TEXT("max_tokens")))
+	{
+		OutSettings.MaxTokens = (int32)Args->GetNumberField(TEXT("max_tokens"));
+	}
+	if (Args->HasField(TEXT("temperature")))
+	{
+		OutSettings.Temperature = (float)Args->GetNumberField(TEXT("temperature"));
+	}
+	return true;
 }
 
 static bool ParseVisionQualityPayload(
@@ -1363,6 +1403,214 @@ static bool ResolvePreferredVisionProviderAndModel(
 	return !OutModel.IsEmpty();
 }
 
+/**
+ * "fan_out": [{provider, [model], [custom_endpoint]}] — candidates raced against the primary
+ * (Primary becomes candidate 0). A missing model resolves to the provider's first model.
+ * "fan_out_mode" is first | all, "hedge_delay_ms" holds every candidate after the primary.
+ */
+static bool ParseLLMFanOutArgs(
+	const TSharedPtr<FJsonObject>& Args,
+	const FAgentForgeLLMCandidate& Primary,
+	TArray<FAgentForgeLLMCandidate>& OutCandidates,
+	EAgentForgeLLMFanOutMode& OutMode,
+	double& OutHedgeDelaySeconds,
+	FString& OutError)
+{
+	OutCandidates.Reset();
+	OutMode = EAgentForgeLLMFanOutMode::First;
+	OutHedgeDelaySeconds = 0.0;
+
+	const TArray<TSharedPtr<FJsonValue>>* Entries = nullptr;
+	if (!Args.IsValid() || !Args->TryGetArrayField(TEXT("fan_out"), Entries) || !Entries || Entries->Num() == 0)
+	{
+		return true;
+	}
+
+	OutCandidates.Add(Primary);
+	for (const TSharedPtr<FJsonValue>& Entry : *Entries)
+	{
+		const TSharedPtr<FJsonObject>* EntryObject = nullptr;
+		FString ProviderString;
+		if (!Entry.IsValid() || !Entry->TryGetObject(EntryObject) || !EntryObject || !(*EntryObject)->TryGetStringField(TEXT("provider"), ProviderString))
+		{
+			OutError = TEXT("Each fan_out entry must be an object with 'provider'.");
+			return false;
+		}
+
+		FAgentForgeLLMCandidate Candidate;
+		FString Model;
+		(*EntryObject)->TryGetStringField(TEXT("model"), Model);
+		(*EntryObject)->TryGetStringField(TEXT("custom_endpoint"), Candidate.CustomEndpoint);
+		if (!ParseLLMProviderName(ProviderString, Candidate.Provider))
+		{
+			OutError = FString::Printf(TEXT("Unknown LLM provider in fan_out: %s"), *ProviderString);
+			return false;
+		}
+		if (!ResolvePreferredVisionProviderAndModel(ProviderString, Model, Candidate.Provider, Candidate.Model))
+		{
+			OutError = FString::Printf(TEXT("No model for fan_out provider %s."), *ProviderString);
+			return false;
+		}
+		OutCandidates.Add(MoveTemp(Candidate));
+	}
+
+	FString ModeName;
+	if (Args->TryGetStringField(TEXT("fan_out_mode"), ModeName))
+	{
+		if (ModeName.Equals(TEXT("first"), ESearchCase::IgnoreCase))
+		{
+			OutMode = EAgentForgeLLMFanOutMode::First;
+		}
+		else if (ModeName.Equals(TEXT("all"), ESearchCase::IgnoreCase))
+		{
+			OutMode = EAgentForgeLLMFanOutMode::All;
+		}
+		else
+		{
+			OutError = FString::Printf(TEXT("Unknown fan_out_mode '%s' (first | all)."), *ModeName);
+			return false;
+		}
+	}
+
+	double HedgeDelayMs = 0.0;
+	if (Args->TryGetNumberField(TEXT("hedge_delay_ms"), HedgeDelayMs))
+	{
+		OutHedgeDelaySeconds = FMath::Max(0.0, HedgeDelayMs / 1000.0);
+	}
+	return true;
+}
+
+/** One copy of Settings per candidate; only the provider, model and endpoint differ. */
+static TArray<FAgentForgeLLMSettings> MakeFanOutSettings(const FAgentForgeLLMSettings& Settings, const TArray<FAgentForgeLLMCandidate>& Candidates)
+{
+	TArray<FAgentForgeLLMSettings> Result;
+	Result.Reserve(Candidates.Num());
+	for (const FAgentForgeLLMCandidate& Candidate : Candidates)
+	{
+		FAgentForgeLLMSettings& CandidateSettings = Result.Add_GetRef(Settings);
+		CandidateSettings.Provider = Candidate.Provider;
+		CandidateSettings.Model = Candidate.Model;
+		CandidateSettings.CustomEndpoint = Candidate.CustomEndpoint;
+	}
+	return Result;
+}
+
+/** The winner's (or, with none accepted, the primary's) response object plus winner_index, fan_out_mode and a fan_out[] row per candidate. */
+static TSharedPtr<FJsonObject> BuildLLMFanOutObject(
+	const FAgentForgeLLMFanOutResult& Result,
+	const TArray<FAgentForgeLLMCandidate>& Candidates,
+	EAgentForgeLLMFanOutMode Mode)
+{
+	const int32 ReportIndex = Result.HasWinner() ? Result.WinnerIndex : 0;
+	const FAgentForgeLLMCandidate& Reported = Candidates[ReportIndex];
+	TSharedPtr<FJsonObject> Obj = BuildLLMResponseObject(
+		Result.Responses.IsValidIndex(ReportIndex) ? Result.Responses[ReportIndex] : FAgentForgeLLMResponse(), Reported.Provider, Reported.Model);
+	Obj->SetNumberField(TEXT("winner_index"), Result.WinnerIndex);
+	Obj->SetStringField(TEXT("fan_out_mode"), Mode == EAgentForgeLLMFanOutMode::All ? TEXT("all") : TEXT("first"));
+
+	TArray<TSharedPtr<FJsonValue>> Rows;
+	for (int32 Index = 0; Index < Candidates.Num() && Index < Result.Responses.Num(); ++Index)
+	{
+		const FAgentForgeLLMResponse& Response = Result.Responses[Index];
+		TSharedPtr<FJsonObject> Row = MakeShared<FJsonObject>();
+		Row->SetStringField(TEXT("provider"), GetLLMProviderName(Candidates[Index].Provider));
+		Row->SetStringField(TEXT("model"), Candidates[Index].Model);
+		Row->SetBoolField(TEXT("ok"), Response.bSuccess);
+		Row->SetBoolField(TEXT("accepted"), Result.Accepted[Index]);
+		Row->SetBoolField(TEXT("cancelled"), Result.Cancelled[Index]);
+		Row->SetBoolField(TEXT("from_cache"), Response.bFromCache);
+		Row->SetNumberField(TEXT("latency_ms"), Result.LatencyMs[Index]);
+		Row->SetStringField(TEXT("error_message"), Response.ErrorMessage);
+		Row->SetStringField(TEXT("content"), Response.Content);
+		Rows.Add(MakeShared<FJsonValueObject>(Row));
+	}
+	Obj->SetArrayField(TEXT("fan_out"), Rows);
+	return Obj;
+}
+
+/**
+ * Shared body of the get_available_* commands: search_filter, prefix, path_filter,
+ * tag and max_results against the asset catalog. Blueprints add parent_class and
+ * the FBlueprintTags class paths on each entry.
+ */
+static bool QueryAvailableAssets(const TSharedPtr<FJsonObject>& Args, EAgentForgeAssetKind Kind, TSharedPtr<FJsonObject>& OutRoot, FString& OutError)
+{
+	const bool bBlueprints = Kind == EAgentForgeAssetKind::Blueprint;
+	FAgentForgeAssetQuery Query;
+	FString ParentClassFilter;
+	FString TagFilter;
+	if (Args.IsValid())
+	{
+		Args->TryGetStringField(TEXT("search_filter"), Query.Search);
+		Args->TryGetStringField(TEXT("prefix"), Query.Prefix);
+		Args->TryGetStringField(TEXT("path_filter"), Query.PackagePath);
+		Args->TryGetStringField(TEXT("tag"), TagFilter);
+		if (bBlueprints)
+		{
+			Args->TryGetStringField(TEXT("parent_class"), ParentClassFilter);
+		}
+		if (Args->HasField(TEXT("max_results")))
+		{
+			Query.MaxResults = FMath::Max(1, (int32)Args->GetNumberField(TEXT("max_results")));
+		}
+	}
+	if (!FAgentForgeAssetCatalog::ParseTagQuery(TagFilter, Query.Tags, OutError))
+	{
+		return false;
+	}
+
+	if (!ParentClassFilter.IsEmpty())
+	{
+		Query.Filter = [ParentNeedle = ParentClassFilter](const FAssetData& Asset)
+		{
+			return Asset.GetTagValueRef<FString>(FBlueprintTags::ParentClassPath).Contains(ParentNeedle)
+				|| Asset.GetTagValueRef<FString>(FBlueprintTags::NativeParentClassPath).Contains(ParentNeedle)
+				|| Asset.GetTagValueRef<FString>(FBlueprintTags::GeneratedClassPath).Contains(ParentNeedle);
+		};
+	}
+
+	TArray<FAssetData> Assets;
+	FAgentForgeAssetCatalog::Get().Query(Kind, Query, Assets);
+
+	TArray<TSharedPtr<FJsonValue>> Results;
+	Results.Reserve(Assets.Num());
+	for (const FAssetData& Asset : Assets)
+	{
+		TSharedPtr<FJsonObject> Entry = MakeShared<FJsonObject>();
+		Entry->SetStringField(TEXT("asset_name"), Asset.AssetName.ToString());
+		Entry->SetStringField(TEXT("asset_path"), Asset.GetSoftObjectPath().ToString());
+		Entry->SetStringField(TEXT("package_path"), Asset.PackagePath.ToString());
+		Entry->SetStringField(TEXT("class"), Asset.AssetClassPath.GetAssetName().ToString());
+		if (bBlueprints)
+		{
+			Entry->SetStringField(TEXT("parent_class_path"), Asset.GetTagValueRef<FString>(FBlueprintTags::ParentClassPath));
+			Entry->SetStringField(TEXT("native_parent_class_path"), Asset.GetTagValueRef<FString>(FBlueprintTags::NativeParentClassPath));
+			Entry->SetStringField(TEXT("generated_class_path"), Asset.GetTagValueRef<FString>(FBlueprintTags::GeneratedClassPath));
+		}
+		Results.Add(MakeShared<FJsonValueObject>(Entry));
+	}
+
+	OutRoot = MakeShared<FJsonObject>();
+	OutRoot->SetBoolField(TEXT("ok"), true);
+	OutRoot->SetStringField(TEXT("search_filter"), Query.Search);
+	OutRoot->SetStringField(TEXT("path_filter"), Query.PackagePath);
+	if (bBlueprints)
+	{
+		OutRoot->SetStringField(TEXT("parent_class"), ParentClassFilter);
+	}
+	if (!Query.Prefix.IsEmpty())
+	{
+		OutRoot->SetStringField(TEXT("prefix"), Query.Prefix);
+	}
+	if (!TagFilter.IsEmpty())
+	{
+		OutRoot->SetStringField(TEXT("tag"), TagFilter);
+	}
+	OutRoot->SetNumberField(TEXT("count"), Results.Num());
+	OutRoot->SetArrayField(TEXT("assets"), Results);
+	return true;
+}
+
 #endif // WITH_EDITOR
 
 // ============================================================================
@@ -1415,6 +1663,7 @@ static bool ParseJsonObjectLocal(const FString& In, TSharedPtr<FJsonObject>& Out
 
 static FString ToJsonStringLocal(const TSharedPtr<FJsonObject>& Obj)
 {
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Serialize");
 	FString Out;
 	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Out);
 	FJsonSerializer::Serialize(Obj.ToSharedRef(), Writer);
@@ -1486,42 +1735,11 @@ static TArray<TSharedPtr<FJsonValue>> PhaseResultsToJsonArray(const TArray<FVeri
 static AActor* FindActorByPathLabelOrNameLocal(const FString& PathLabelOrName)
 {
 #if WITH_EDITOR
-	if (PathLabelOrName.IsEmpty())
-	{
-		return nullptr;
-	}
-
-	if (AActor* ByPath = Cast<AActor>(StaticFindObject(AActor::StaticClass(), nullptr, *PathLabelOrName)))
-	{
-		if (IsValid(ByPath) && !ByPath->IsActorBeingDestroyed())
-		{
-			return ByPath;
-		}
-	}
-
-	UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
-	if (!World)
-	{
-		return nullptr;
-	}
-
-	for (TActorIterator<AActor> It(World); It; ++It)
-	{
-		AActor* Actor = *It;
-		if (!Actor || !IsValid(Actor))
-		{
-			continue;
-		}
-		if (Actor->GetActorLabel().Equals(PathLabelOrName, ESearchCase::IgnoreCase) ||
-			Actor->GetName().Equals(PathLabelOrName, ESearchCase::IgnoreCase) ||
-			Actor->GetPathName().Equals(PathLabelOrName, ESearchCase::IgnoreCase))
-		{
-			return Actor;
-		}
-	}
-#endif
-	return nullptr;
-}
+	return FAgentForgeActorIndex::Get().FindByAnyId(PathLabelOrName);
+#else
+	return nullptr;
+#endif
+}
 
 static bool IsVectorNearlyEqual(const FVector& A, const FVector& B, const float Tolerance = 0.05f)
 {
@@ -1541,20 +1759,7 @@ static int32 CountCurrentActors()
 {
 #if WITH_EDITOR
 	UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
-	int32 Count = 0;
-	if (!World)
-	{
-		return 0;
-	}
-
-	for (TActorIterator<AActor> It(World); It; ++It)
-	{
-		if (*It && IsValid(*It))
-		{
-			++Count;
-		}
-	}
-	return Count;
+	return World ? FAgentForgeWorldStats::Get().Gather(World).Actors : 0;
 #else
 	return 0;
 #endif
@@ -1620,451 +1825,505 @@ static void MarkActorTransactionalRecursive(AActor* Actor)
 #endif
 }
 
-static bool RunCommandAwarePostVerify(
+// ─── Command-aware post verification hooks ──────────────────────────────────
+// Each hook is attached to its command(s) in RegisterBuiltinCommands; having a hook
+// is the command-aware post-verify contract for that command.
+static void FinishPostVerify(FVerificationPhaseResult& OutResult, const bool bPassed, const FString& Detail)
+{
+	OutResult.Passed = bPassed;
+	OutResult.Detail = Detail;
+}
+
+// spawn_actor
+static void PostVerifySpawnedActor(
 	const FString& Cmd,
 	const TSharedPtr<FJsonObject>& Args,
-	const FString& CommandResult,
+	const TSharedPtr<FJsonObject>& ResultObj,
 	FVerificationPhaseResult& OutResult)
 {
-	OutResult = FVerificationPhaseResult();
-	OutResult.PhaseName = TEXT("PostVerify.CommandAware");
-	const double StartTime = FPlatformTime::Seconds();
-
-	auto Finish = [&](const bool bPassed, const FString& Detail) -> bool
-	{
-		OutResult.Passed = bPassed;
-		OutResult.Detail = Detail;
-		OutResult.DurationMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
-		return true;
-	};
-
-	TSharedPtr<FJsonObject> ResultObj;
-	FString ParseErr;
-	if (!ParseJsonObjectLocal(CommandResult, ResultObj, ParseErr) || !ResultObj.IsValid())
+	FString SpawnedPath;
+	ResultObj->TryGetStringField(TEXT("spawned_object_path"), SpawnedPath);
+	AActor* Actor = FindActorByPathLabelOrNameLocal(SpawnedPath);
+	if (!Actor)
 	{
-		return false;
+		return FinishPostVerify(OutResult, false, FString::Printf(TEXT("Spawned actor missing after command: %s"), *SpawnedPath));
 	}
 
-	if (Cmd == TEXT("spawn_actor"))
+	FString ClassPath;
+	Args->TryGetStringField(TEXT("class_path"), ClassPath);
+	if (!ClassPath.IsEmpty())
 	{
-		FString SpawnedPath;
-		ResultObj->TryGetStringField(TEXT("spawned_object_path"), SpawnedPath);
-		AActor* Actor = FindActorByPathLabelOrNameLocal(SpawnedPath);
-		if (!Actor)
+		if (UClass* ExpectedClass = LoadObject<UClass>(nullptr, *ClassPath))
 		{
-			return Finish(false, FString::Printf(TEXT("Spawned actor missing after command: %s"), *SpawnedPath));
-		}
-
-		FString ClassPath;
-		Args->TryGetStringField(TEXT("class_path"), ClassPath);
-		if (!ClassPath.IsEmpty())
-		{
-			if (UClass* ExpectedClass = LoadObject<UClass>(nullptr, *ClassPath))
+			if (!Actor->IsA(ExpectedClass))
 			{
-				if (!Actor->IsA(ExpectedClass))
-				{
-					return Finish(false, FString::Printf(TEXT("Spawned actor class mismatch. Expected %s, got %s."), *ExpectedClass->GetName(), *Actor->GetClass()->GetName()));
-				}
+				return FinishPostVerify(OutResult, false, FString::Printf(TEXT("Spawned actor class mismatch. Expected %s, got %s."), *ExpectedClass->GetName(), *Actor->GetClass()->GetName()));
 			}
 		}
-		return Finish(true, FString::Printf(TEXT("Actor exists at %s and matches requested class."), *SpawnedPath));
 	}
+	return FinishPostVerify(OutResult, true, FString::Printf(TEXT("Actor exists at %s and matches requested class."), *SpawnedPath));
+}
 
-	if (Cmd == TEXT("spawn_point_light") || Cmd == TEXT("spawn_spot_light"))
+// spawn_point_light, spawn_spot_light
+static void PostVerifyPointOrSpotLight(
+	const FString& Cmd,
+	const TSharedPtr<FJsonObject>& Args,
+	const TSharedPtr<FJsonObject>& ResultObj,
+	FVerificationPhaseResult& OutResult)
+{
+	FString SpawnedPath;
+	ResultObj->TryGetStringField(TEXT("spawned_object_path"), SpawnedPath);
+	AActor* Actor = FindActorByPathLabelOrNameLocal(SpawnedPath);
+	if (!Actor)
 	{
-		FString SpawnedPath;
-		ResultObj->TryGetStringField(TEXT("spawned_object_path"), SpawnedPath);
-		AActor* Actor = FindActorByPathLabelOrNameLocal(SpawnedPath);
-		if (!Actor)
-		{
-			return Finish(false, FString::Printf(TEXT("Spawned light missing after command: %s"), *SpawnedPath));
-		}
+		return FinishPostVerify(OutResult, false, FString::Printf(TEXT("Spawned light missing after command: %s"), *SpawnedPath));
+	}
 
-		const bool bClassOk =
-			(Cmd == TEXT("spawn_point_light") && Actor->IsA(APointLight::StaticClass())) ||
-			(Cmd == TEXT("spawn_spot_light") && Actor->IsA(ASpotLight::StaticClass()));
-		if (!bClassOk)
-		{
-			return Finish(false, FString::Printf(TEXT("Spawned light class mismatch for %s. Got %s."), *Cmd, *Actor->GetClass()->GetName()));
-		}
-		return Finish(true, FString::Printf(TEXT("Light actor exists at %s with expected class."), *SpawnedPath));
+	const bool bClassOk =
+		(Cmd == TEXT("spawn_point_light") && Actor->IsA(APointLight::StaticClass())) ||
+		(Cmd == TEXT("spawn_spot_light") && Actor->IsA(ASpotLight::StaticClass()));
+	if (!bClassOk)
+	{
+		return FinishPostVerify(OutResult, false, FString::Printf(TEXT("Spawned light class mismatch for %s. Got %s."), *Cmd, *Actor->GetClass()->GetName()));
 	}
+	return FinishPostVerify(OutResult, true, FString::Printf(TEXT("Light actor exists at %s with expected class."), *SpawnedPath));
+}
 
-	if (Cmd == TEXT("spawn_rect_light") || Cmd == TEXT("spawn_directional_light"))
+// spawn_rect_light, spawn_directional_light
+static void PostVerifyRectOrDirectionalLight(
+	const FString& Cmd,
+	const TSharedPtr<FJsonObject>& Args,
+	const TSharedPtr<FJsonObject>& ResultObj,
+	FVerificationPhaseResult& OutResult)
+{
+	FString SpawnedPath;
+	ResultObj->TryGetStringField(TEXT("spawned_object_path"), SpawnedPath);
+	AActor* Actor = FindActorByPathLabelOrNameLocal(SpawnedPath);
+	if (!Actor)
 	{
-		FString SpawnedPath;
-		ResultObj->TryGetStringField(TEXT("spawned_object_path"), SpawnedPath);
-		AActor* Actor = FindActorByPathLabelOrNameLocal(SpawnedPath);
-		if (!Actor)
-		{
-			return Finish(false, FString::Printf(TEXT("Spawned light missing after command: %s"), *SpawnedPath));
-		}
+		return FinishPostVerify(OutResult, false, FString::Printf(TEXT("Spawned light missing after command: %s"), *SpawnedPath));
+	}
 
-		const bool bClassOk =
-			(Cmd == TEXT("spawn_rect_light") && Actor->IsA(ARectLight::StaticClass())) ||
-			(Cmd == TEXT("spawn_directional_light") && Actor->IsA(ADirectionalLight::StaticClass()));
-		if (!bClassOk)
-		{
-			return Finish(false, FString::Printf(TEXT("Spawned light class mismatch for %s. Got %s."), *Cmd, *Actor->GetClass()->GetName()));
-		}
-		return Finish(true, FString::Printf(TEXT("Light actor exists at %s with expected class."), *SpawnedPath));
+	const bool bClassOk =
+		(Cmd == TEXT("spawn_rect_light") && Actor->IsA(ARectLight::StaticClass())) ||
+		(Cmd == TEXT("spawn_directional_light") && Actor->IsA(ADirectionalLight::StaticClass()));
+	if (!bClassOk)
+	{
+		return FinishPostVerify(OutResult, false, FString::Printf(TEXT("Spawned light class mismatch for %s. Got %s."), *Cmd, *Actor->GetClass()->GetName()));
 	}
+	return FinishPostVerify(OutResult, true, FString::Printf(TEXT("Light actor exists at %s with expected class."), *SpawnedPath));
+}
 
-	if (Cmd == TEXT("compile_blueprint"))
+// compile_blueprint
+static void PostVerifyCompileBlueprint(
+	const FString& Cmd,
+	const TSharedPtr<FJsonObject>& Args,
+	const TSharedPtr<FJsonObject>& ResultObj,
+	FVerificationPhaseResult& OutResult)
+{
+	FString BlueprintPath;
+	Args->TryGetStringField(TEXT("blueprint_path"), BlueprintPath);
+	UBlueprint* BP = LoadObject<UBlueprint>(nullptr, *BlueprintPath);
+	if (!BP)
 	{
-		FString BlueprintPath;
-		Args->TryGetStringField(TEXT("blueprint_path"), BlueprintPath);
-		UBlueprint* BP = LoadObject<UBlueprint>(nullptr, *BlueprintPath);
-		if (!BP)
-		{
-			return Finish(false, FString::Printf(TEXT("Blueprint missing after compile_blueprint: %s"), *BlueprintPath));
-		}
-		if (BP->Status == BS_Error)
-		{
-			return Finish(false, FString::Printf(TEXT("Blueprint compile status is BS_Error after compile_blueprint: %s"), *BlueprintPath));
-		}
-		return Finish(true, FString::Printf(TEXT("Blueprint compiled without BS_Error status: %s."), *BlueprintPath));
+		return FinishPostVerify(OutResult, false, FString::Printf(TEXT("Blueprint missing after compile_blueprint: %s"), *BlueprintPath));
+	}
+	if (BP->Status == BS_Error)
+	{
+		return FinishPostVerify(OutResult, false, FString::Printf(TEXT("Blueprint compile status is BS_Error after compile_blueprint: %s"), *BlueprintPath));
 	}
+	return FinishPostVerify(OutResult, true, FString::Printf(TEXT("Blueprint compiled without BS_Error status: %s."), *BlueprintPath));
+}
+
+// edit_blueprint_node
+static void PostVerifyEditBlueprintNode(
+	const FString& Cmd,
+	const TSharedPtr<FJsonObject>& Args,
+	const TSharedPtr<FJsonObject>& ResultObj,
+	FVerificationPhaseResult& OutResult)
+{
+	FString BlueprintPath;
+	FString NodeGuidString;
+	Args->TryGetStringField(TEXT("blueprint_path"), BlueprintPath);
+	ResultObj->TryGetStringField(TEXT("node_guid"), NodeGuidString);
 
-	if (Cmd == TEXT("edit_blueprint_node"))
+	UBlueprint* BP = LoadObject<UBlueprint>(nullptr, *BlueprintPath);
+	if (!BP)
+	{
+		return FinishPostVerify(OutResult, false, FString::Printf(TEXT("Blueprint missing after edit_blueprint_node: %s"), *BlueprintPath));
+	}
+	if (BP->Status == BS_Error)
 	{
-		FString BlueprintPath;
-		FString NodeGuidString;
-		Args->TryGetStringField(TEXT("blueprint_path"), BlueprintPath);
-		ResultObj->TryGetStringField(TEXT("node_guid"), NodeGuidString);
+		return FinishPostVerify(OutResult, false, FString::Printf(TEXT("Blueprint compile status is BS_Error after edit_blueprint_node: %s"), *BlueprintPath));
+	}
 
-		UBlueprint* BP = LoadObject<UBlueprint>(nullptr, *BlueprintPath);
-		if (!BP)
-		{
-			return Finish(false, FString::Printf(TEXT("Blueprint missing after edit_blueprint_node: %s"), *BlueprintPath));
-		}
-		if (BP->Status == BS_Error)
-		{
-			return Finish(false, FString::Printf(TEXT("Blueprint compile status is BS_Error after edit_blueprint_node: %s"), *BlueprintPath));
-		}
+	FGuid ExpectedGuid;
+	if (!FGuid::Parse(NodeGuidString, ExpectedGuid))
+	{
+		return FinishPostVerify(OutResult, false, FString::Printf(TEXT("edit_blueprint_node returned invalid node_guid: %s"), *NodeGuidString));
+	}
 
-		FGuid ExpectedGuid;
-		if (!FGuid::Parse(NodeGuidString, ExpectedGuid))
+	bool bFoundNode = false;
+	for (UEdGraph* Graph : BP->UbergraphPages)
+	{
+		if (!Graph)
 		{
-			return Finish(false, FString::Printf(TEXT("edit_blueprint_node returned invalid node_guid: %s"), *NodeGuidString));
+			continue;
 		}
-
-		bool bFoundNode = false;
-		for (UEdGraph* Graph : BP->UbergraphPages)
+		for (UEdGraphNode* Node : Graph->Nodes)
 		{
-			if (!Graph)
-			{
-				continue;
-			}
-			for (UEdGraphNode* Node : Graph->Nodes)
-			{
-				if (Node && Node->NodeGuid == ExpectedGuid)
-				{
-					bFoundNode = true;
-					break;
-				}
-			}
-			if (bFoundNode)
+			if (Node && Node->NodeGuid == ExpectedGuid)
 			{
+				bFoundNode = true;
 				break;
 			}
 		}
-
-		if (!bFoundNode)
+		if (bFoundNode)
 		{
-			return Finish(false, FString::Printf(TEXT("Edited node guid no longer exists after edit_blueprint_node: %s"), *NodeGuidString));
+			break;
 		}
-		return Finish(true, FString::Printf(TEXT("Blueprint node edit verified for %s."), *BlueprintPath));
 	}
 
-	if (Cmd == TEXT("set_actor_transform"))
+	if (!bFoundNode)
 	{
-		FString ActorPath;
-		ResultObj->TryGetStringField(TEXT("actor_object_path"), ActorPath);
-		AActor* Actor = FindActorByPathLabelOrNameLocal(ActorPath);
-		if (!Actor)
-		{
-			return Finish(false, FString::Printf(TEXT("Actor missing after transform update: %s"), *ActorPath));
-		}
+		return FinishPostVerify(OutResult, false, FString::Printf(TEXT("Edited node guid no longer exists after edit_blueprint_node: %s"), *NodeGuidString));
+	}
+	return FinishPostVerify(OutResult, true, FString::Printf(TEXT("Blueprint node edit verified for %s."), *BlueprintPath));
+}
+
+// set_actor_transform
+static void PostVerifyActorTransform(
+	const FString& Cmd,
+	const TSharedPtr<FJsonObject>& Args,
+	const TSharedPtr<FJsonObject>& ResultObj,
+	FVerificationPhaseResult& OutResult)
+{
+	FString ActorPath;
+	ResultObj->TryGetStringField(TEXT("actor_object_path"), ActorPath);
+	AActor* Actor = FindActorByPathLabelOrNameLocal(ActorPath);
+	if (!Actor)
+	{
+		return FinishPostVerify(OutResult, false, FString::Printf(TEXT("Actor missing after transform update: %s"), *ActorPath));
+	}
 
-		const FVector ExpectedLocation(
-			Args->HasField(TEXT("x")) ? (float)Args->GetNumberField(TEXT("x")) : Actor->GetActorLocation().X,
-			Args->HasField(TEXT("y")) ? (float)Args->GetNumberField(TEXT("y")) : Actor->GetActorLocation().Y,
-			Args->HasField(TEXT("z")) ? (float)Args->GetNumberField(TEXT("z")) : Actor->GetActorLocation().Z);
-		const FRotator ExpectedRotation(
-			Args->HasField(TEXT("pitch")) ? (float)Args->GetNumberField(TEXT("pitch")) : Actor->GetActorRotation().Pitch,
-			Args->HasField(TEXT("yaw")) ? (float)Args->GetNumberField(TEXT("yaw")) : Actor->GetActorRotation().Yaw,
-			Args->HasField(TEXT("roll")) ? (float)Args->GetNumberField(TEXT("roll")) : Actor->GetActorRotation().Roll);
+	const FVector ExpectedLocation(
+		Args->HasField(TEXT("x")) ? (float)Args->GetNumberField(TEXT("x")) : Actor->GetActorLocation().X,
+		Args->HasField(TEXT("y")) ? (float)Args->GetNumberField(TEXT("y")) : Actor->GetActorLocation().Y,
+		Args->HasField(TEXT("z")) ? (float)Args->GetNumberField(TEXT("z")) : Actor->GetActorLocation().Z);
+	const FRotator ExpectedRotation(
+		Args->HasField(TEXT("pitch")) ? (float)Args->GetNumberField(TEXT("pitch")) : Actor->GetActorRotation().Pitch,
+		Args->HasField(TEXT("yaw")) ? (float)Args->GetNumberField(TEXT("yaw")) : Actor->GetActorRotation().Yaw,
+		Args->HasField(TEXT("roll")) ? (float)Args->GetNumberField(TEXT("roll")) : Actor->GetActorRotation().Roll);
 
-		if (!IsVectorNearlyEqual(Actor->GetActorLocation(), ExpectedLocation) ||
-			!IsRotatorNearlyEqual(Actor->GetActorRotation(), ExpectedRotation))
-		{
-			return Finish(false, FString::Printf(TEXT("Actor transform mismatch after set_actor_transform for %s."), *ActorPath));
-		}
-		return Finish(true, FString::Printf(TEXT("Actor transform matches requested values for %s."), *ActorPath));
+	if (!IsVectorNearlyEqual(Actor->GetActorLocation(), ExpectedLocation) ||
+		!IsRotatorNearlyEqual(Actor->GetActorRotation(), ExpectedRotation))
+	{
+		return FinishPostVerify(OutResult, false, FString::Printf(TEXT("Actor transform mismatch after set_actor_transform for %s."), *ActorPath));
 	}
+	return FinishPostVerify(OutResult, true, FString::Printf(TEXT("Actor transform matches requested values for %s."), *ActorPath));
+}
 
-	if (Cmd == TEXT("set_actor_scale"))
+// set_actor_scale
+static void PostVerifyActorScale(
+	const FString& Cmd,
+	const TSharedPtr<FJsonObject>& Args,
+	const TSharedPtr<FJsonObject>& ResultObj,
+	FVerificationPhaseResult& OutResult)
+{
+	FString ActorName;
+	ResultObj->TryGetStringField(TEXT("actor_name"), ActorName);
+	AActor* Actor = FindActorByPathLabelOrNameLocal(ActorName);
+	if (!Actor)
 	{
-		FString ActorName;
-		ResultObj->TryGetStringField(TEXT("actor_name"), ActorName);
-		AActor* Actor = FindActorByPathLabelOrNameLocal(ActorName);
-		if (!Actor)
-		{
-			return Finish(false, FString::Printf(TEXT("Actor missing after scale update: %s"), *ActorName));
-		}
+		return FinishPostVerify(OutResult, false, FString::Printf(TEXT("Actor missing after scale update: %s"), *ActorName));
+	}
 
-		const FVector ExpectedScale(
-			Args->HasField(TEXT("sx")) ? (float)Args->GetNumberField(TEXT("sx")) : Actor->GetActorScale3D().X,
-			Args->HasField(TEXT("sy")) ? (float)Args->GetNumberField(TEXT("sy")) : Actor->GetActorScale3D().Y,
-			Args->HasField(TEXT("sz")) ? (float)Args->GetNumberField(TEXT("sz")) : Actor->GetActorScale3D().Z);
-		if (!IsVectorNearlyEqual(Actor->GetActorScale3D(), ExpectedScale))
-		{
-			return Finish(false, FString::Printf(TEXT("Actor scale mismatch after set_actor_scale for %s."), *ActorName));
-		}
-		return Finish(true, FString::Printf(TEXT("Actor scale matches requested values for %s."), *ActorName));
+	const FVector ExpectedScale(
+		Args->HasField(TEXT("sx")) ? (float)Args->GetNumberField(TEXT("sx")) : Actor->GetActorScale3D().X,
+		Args->HasField(TEXT("sy")) ? (float)Args->GetNumberField(TEXT("sy")) : Actor->GetActorScale3D().Y,
+		Args->HasField(TEXT("sz")) ? (float)Args->GetNumberField(TEXT("sz")) : Actor->GetActorScale3D().Z);
+	if (!IsVectorNearlyEqual(Actor->GetActorScale3D(), ExpectedScale))
+	{
+		return FinishPostVerify(OutResult, false, FString::Printf(TEXT("Actor scale mismatch after set_actor_scale for %s."), *ActorName));
 	}
+	return FinishPostVerify(OutResult, true, FString::Printf(TEXT("Actor scale matches requested values for %s."), *ActorName));
+}
 
-	if (Cmd == TEXT("set_actor_label"))
+// set_actor_label
+static void PostVerifyActorLabel(
+	const FString& Cmd,
+	const TSharedPtr<FJsonObject>& Args,
+	const TSharedPtr<FJsonObject>& ResultObj,
+	FVerificationPhaseResult& OutResult)
+{
+	FString ActorPath;
+	FString ActorName;
+	ResultObj->TryGetStringField(TEXT("actor_object_path"), ActorPath);
+	ResultObj->TryGetStringField(TEXT("actor_name"), ActorName);
+	AActor* Actor = FindActorByPathLabelOrNameLocal(ActorPath);
+	if (!Actor)
 	{
-		FString ActorPath;
-		FString ActorName;
-		ResultObj->TryGetStringField(TEXT("actor_object_path"), ActorPath);
-		ResultObj->TryGetStringField(TEXT("actor_name"), ActorName);
-		AActor* Actor = FindActorByPathLabelOrNameLocal(ActorPath);
-		if (!Actor)
-		{
-			Actor = FindActorByPathLabelOrNameLocal(ActorName);
-		}
-		if (!Actor)
-		{
-			return Finish(false, FString::Printf(TEXT("Actor missing after label update: %s"), *ActorName));
-		}
-		if (!Actor->GetActorLabel().Equals(ActorName, ESearchCase::IgnoreCase))
-		{
-			return Finish(false, FString::Printf(TEXT("Actor label mismatch after set_actor_label for %s."), *ActorPath));
-		}
-		return Finish(true, FString::Printf(TEXT("Actor label matches requested value for %s."), *ActorName));
+		Actor = FindActorByPathLabelOrNameLocal(ActorName);
+	}
+	if (!Actor)
+	{
+		return FinishPostVerify(OutResult, false, FString::Printf(TEXT("Actor missing after label update: %s"), *ActorName));
+	}
+	if (!Actor->GetActorLabel().Equals(ActorName, ESearchCase::IgnoreCase))
+	{
+		return FinishPostVerify(OutResult, false, FString::Printf(TEXT("Actor label mismatch after set_actor_label for %s."), *ActorPath));
 	}
+	return FinishPostVerify(OutResult, true, FString::Printf(TEXT("Actor label matches requested value for %s."), *ActorName));
+}
 
-	if (Cmd == TEXT("set_static_mesh"))
+// set_static_mesh
+static void PostVerifyStaticMesh(
+	const FString& Cmd,
+	const TSharedPtr<FJsonObject>& Args,
+	const TSharedPtr<FJsonObject>& ResultObj,
+	FVerificationPhaseResult& OutResult)
+{
+	FString ActorName;
+	FString MeshPath;
+	ResultObj->TryGetStringField(TEXT("actor_name"), ActorName);
+	ResultObj->TryGetStringField(TEXT("mesh_path"), MeshPath);
+	AActor* Actor = FindActorByPathLabelOrNameLocal(ActorName);
+	if (!Actor)
 	{
-		FString ActorName;
-		FString MeshPath;
-		ResultObj->TryGetStringField(TEXT("actor_name"), ActorName);
-		ResultObj->TryGetStringField(TEXT("mesh_path"), MeshPath);
-		AActor* Actor = FindActorByPathLabelOrNameLocal(ActorName);
-		if (!Actor)
-		{
-			return Finish(false, FString::Printf(TEXT("Actor missing after set_static_mesh: %s"), *ActorName));
-		}
+		return FinishPostVerify(OutResult, false, FString::Printf(TEXT("Actor missing after set_static_mesh: %s"), *ActorName));
+	}
 
-		UStaticMeshComponent* MeshComp = FindStaticMeshComponentOnActor(Actor);
-		if (!MeshComp || !MeshComp->GetStaticMesh())
-		{
-			return Finish(false, FString::Printf(TEXT("Static mesh component missing or empty after set_static_mesh for %s."), *ActorName));
-		}
-		if (!MeshComp->GetStaticMesh()->GetPathName().Equals(MeshPath, ESearchCase::IgnoreCase))
-		{
-			return Finish(false, FString::Printf(TEXT("Static mesh mismatch after set_static_mesh for %s."), *ActorName));
-		}
-		return Finish(true, FString::Printf(TEXT("Static mesh assignment verified for %s."), *ActorName));
+	UStaticMeshComponent* MeshComp = FindStaticMeshComponentOnActor(Actor);
+	if (!MeshComp || !MeshComp->GetStaticMesh())
+	{
+		return FinishPostVerify(OutResult, false, FString::Printf(TEXT("Static mesh component missing or empty after set_static_mesh for %s."), *ActorName));
 	}
+	if (!MeshComp->GetStaticMesh()->GetPathName().Equals(MeshPath, ESearchCase::IgnoreCase))
+	{
+		return FinishPostVerify(OutResult, false, FString::Printf(TEXT("Static mesh mismatch after set_static_mesh for %s."), *ActorName));
+	}
+	return FinishPostVerify(OutResult, true, FString::Printf(TEXT("Static mesh assignment verified for %s."), *ActorName));
+}
 
-	if (Cmd == TEXT("apply_material_to_actor"))
+// apply_material_to_actor
+static void PostVerifyMaterialAssignment(
+	const FString& Cmd,
+	const TSharedPtr<FJsonObject>& Args,
+	const TSharedPtr<FJsonObject>& ResultObj,
+	FVerificationPhaseResult& OutResult)
+{
+	FString ActorName;
+	FString MaterialPath;
+	double SlotIndexValue = 0.0;
+	ResultObj->TryGetStringField(TEXT("actor_name"), ActorName);
+	ResultObj->TryGetStringField(TEXT("material_path"), MaterialPath);
+	ResultObj->TryGetNumberField(TEXT("slot_index"), SlotIndexValue);
+	const int32 SlotIndex = FMath::TruncToInt(SlotIndexValue);
+	AActor* Actor = FindActorByPathLabelOrNameLocal(ActorName);
+	if (!Actor)
 	{
-		FString ActorName;
-		FString MaterialPath;
-		double SlotIndexValue = 0.0;
-		ResultObj->TryGetStringField(TEXT("actor_name"), ActorName);
-		ResultObj->TryGetStringField(TEXT("material_path"), MaterialPath);
-		ResultObj->TryGetNumberField(TEXT("slot_index"), SlotIndexValue);
-		const int32 SlotIndex = FMath::TruncToInt(SlotIndexValue);
-		AActor* Actor = FindActorByPathLabelOrNameLocal(ActorName);
-		if (!Actor)
-		{
-			return Finish(false, FString::Printf(TEXT("Actor missing after apply_material_to_actor: %s"), *ActorName));
-		}
+		return FinishPostVerify(OutResult, false, FString::Printf(TEXT("Actor missing after apply_material_to_actor: %s"), *ActorName));
+	}
 
-		UMeshComponent* MeshComp = FindMeshComponentOnActor(Actor);
-		UMaterialInterface* Material = MeshComp ? MeshComp->GetMaterial(SlotIndex) : nullptr;
-		if (!Material)
-		{
-			return Finish(false, FString::Printf(TEXT("Material slot %d is empty after apply_material_to_actor for %s."), SlotIndex, *ActorName));
-		}
-		if (!Material->GetPathName().Equals(MaterialPath, ESearchCase::IgnoreCase))
-		{
-			return Finish(false, FString::Printf(TEXT("Material mismatch after apply_material_to_actor for %s slot %d."), *ActorName, SlotIndex));
-		}
-		return Finish(true, FString::Printf(TEXT("Material assignment verified for %s slot %d."), *ActorName, SlotIndex));
+	UMeshComponent* MeshComp = FindMeshComponentOnActor(Actor);
+	UMaterialInterface* Material = MeshComp ? MeshComp->GetMaterial(SlotIndex) : nullptr;
+	if (!Material)
+	{
+		return FinishPostVerify(OutResult, false, FString::Printf(TEXT("Material slot %d is empty after apply_material_to_actor for %s."), SlotIndex, *ActorName));
 	}
+	if (!Material->GetPathName().Equals(MaterialPath, ESearchCase::IgnoreCase))
+	{
+		return FinishPostVerify(OutResult, false, FString::Printf(TEXT("Material mismatch after apply_material_to_actor for %s slot %d."), *ActorName, SlotIndex));
+	}
+	return FinishPostVerify(OutResult, true, FString::Printf(TEXT("Material assignment verified for %s slot %d."), *ActorName, SlotIndex));
+}
 
-	if (Cmd == TEXT("spawn_actor_at_surface"))
+// spawn_actor_at_surface
+static void PostVerifySurfaceSpawn(
+	const FString& Cmd,
+	const TSharedPtr<FJsonObject>& Args,
+	const TSharedPtr<FJsonObject>& ResultObj,
+	FVerificationPhaseResult& OutResult)
+{
+	FString ActorPath;
+	ResultObj->TryGetStringField(TEXT("actor_path"), ActorPath);
+	AActor* Actor = FindActorByPathLabelOrNameLocal(ActorPath);
+	if (!Actor)
 	{
-		FString ActorPath;
-		ResultObj->TryGetStringField(TEXT("actor_path"), ActorPath);
-		AActor* Actor = FindActorByPathLabelOrNameLocal(ActorPath);
-		if (!Actor)
-		{
-			return Finish(false, FString::Printf(TEXT("Spawned actor missing after surface spawn: %s"), *ActorPath));
-		}
+		return FinishPostVerify(OutResult, false, FString::Printf(TEXT("Spawned actor missing after surface spawn: %s"), *ActorPath));
+	}
 
-		const TSharedPtr<FJsonObject>* LocationObj = nullptr;
-		if (!ResultObj->TryGetObjectField(TEXT("location"), LocationObj) || !LocationObj || !LocationObj->IsValid())
+	const TSharedPtr<FJsonObject>* LocationObj = nullptr;
+	if (!ResultObj->TryGetObjectField(TEXT("location"), LocationObj) || !LocationObj || !LocationObj->IsValid())
+	{
+		return FinishPostVerify(OutResult, false, TEXT("Surface spawn response missing location payload."));
+	}
+
+	const FVector ExpectedLocation(
+		(float)(*LocationObj)->GetNumberField(TEXT("x")),
+		(float)(*LocationObj)->GetNumberField(TEXT("y")),
+		(float)(*LocationObj)->GetNumberField(TEXT("z")));
+	if (!IsVectorNearlyEqual(Actor->GetActorLocation(), ExpectedLocation))
+	{
+		return FinishPostVerify(OutResult, false, FString::Printf(TEXT("Surface spawn location mismatch for %s."), *ActorPath));
+	}
+	return FinishPostVerify(OutResult, true, FString::Printf(TEXT("Surface-spawned actor exists at requested hit location for %s."), *ActorPath));
+}
+
+// align_actors_to_surface
+static void PostVerifySurfaceAlignment(
+	const FString& Cmd,
+	const TSharedPtr<FJsonObject>& Args,
+	const TSharedPtr<FJsonObject>& ResultObj,
+	FVerificationPhaseResult& OutResult)
+{
+	const TArray<TSharedPtr<FJsonValue>>* ResultsArray = nullptr;
+	if (!ResultObj->TryGetArrayField(TEXT("results"), ResultsArray) || !ResultsArray)
+	{
+		return FinishPostVerify(OutResult, false, TEXT("align_actors_to_surface response missing results array."));
+	}
+
+	for (const TSharedPtr<FJsonValue>& EntryValue : *ResultsArray)
+	{
+		const TSharedPtr<FJsonObject> EntryObj = EntryValue.IsValid() ? EntryValue->AsObject() : nullptr;
+		if (!EntryObj.IsValid())
 		{
-			return Finish(false, TEXT("Surface spawn response missing location payload."));
+			return FinishPostVerify(OutResult, false, TEXT("align_actors_to_surface returned a non-object result entry."));
 		}
 
-		const FVector ExpectedLocation(
-			(float)(*LocationObj)->GetNumberField(TEXT("x")),
-			(float)(*LocationObj)->GetNumberField(TEXT("y")),
-			(float)(*LocationObj)->GetNumberField(TEXT("z")));
-		if (!IsVectorNearlyEqual(Actor->GetActorLocation(), ExpectedLocation))
+		FString Label;
+		EntryObj->TryGetStringField(TEXT("label"), Label);
+		const bool bEntryOk = !EntryObj->HasField(TEXT("ok")) || EntryObj->GetBoolField(TEXT("ok"));
+		if (!bEntryOk)
 		{
-			return Finish(false, FString::Printf(TEXT("Surface spawn location mismatch for %s."), *ActorPath));
+			return FinishPostVerify(OutResult, false, FString::Printf(TEXT("align_actors_to_surface reported a failed entry for %s."), *Label));
 		}
-		return Finish(true, FString::Printf(TEXT("Surface-spawned actor exists at requested hit location for %s."), *ActorPath));
-	}
 
-	if (Cmd == TEXT("align_actors_to_surface"))
-	{
-		const TArray<TSharedPtr<FJsonValue>>* ResultsArray = nullptr;
-		if (!ResultObj->TryGetArrayField(TEXT("results"), ResultsArray) || !ResultsArray)
+		AActor* Actor = FindActorByPathLabelOrNameLocal(Label);
+		if (!Actor)
 		{
-			return Finish(false, TEXT("align_actors_to_surface response missing results array."));
+			return FinishPostVerify(OutResult, false, FString::Printf(TEXT("Aligned actor missing after align_actors_to_surface: %s"), *Label));
 		}
 
-		for (const TSharedPtr<FJsonValue>& EntryValue : *ResultsArray)
+		const float ExpectedZ = EntryObj->HasField(TEXT("new_z"))
+			? (float)EntryObj->GetNumberField(TEXT("new_z"))
+			: Actor->GetActorLocation().Z;
+		if (!FMath::IsNearlyEqual(Actor->GetActorLocation().Z, ExpectedZ, 0.05f))
 		{
-			const TSharedPtr<FJsonObject> EntryObj = EntryValue.IsValid() ? EntryValue->AsObject() : nullptr;
-			if (!EntryObj.IsValid())
-			{
-				return Finish(false, TEXT("align_actors_to_surface returned a non-object result entry."));
-			}
+			return FinishPostVerify(OutResult, false, FString::Printf(TEXT("Aligned actor Z mismatch after align_actors_to_surface for %s."), *Label));
+		}
+	}
 
-			FString Label;
-			EntryObj->TryGetStringField(TEXT("label"), Label);
-			const bool bEntryOk = !EntryObj->HasField(TEXT("ok")) || EntryObj->GetBoolField(TEXT("ok"));
-			if (!bEntryOk)
-			{
-				return Finish(false, FString::Printf(TEXT("align_actors_to_surface reported a failed entry for %s."), *Label));
-			}
+	return FinishPostVerify(OutResult, true, TEXT("All aligned actors match the reported surface-adjusted Z location."));
+}
 
-			AActor* Actor = FindActorByPathLabelOrNameLocal(Label);
-			if (!Actor)
-			{
-				return Finish(false, FString::Printf(TEXT("Aligned actor missing after align_actors_to_surface: %s"), *Label));
-			}
+// create_floor
+static void PostVerifyCreateFloor(
+	const FString& Cmd,
+	const TSharedPtr<FJsonObject>& Args,
+	const TSharedPtr<FJsonObject>& ResultObj,
+	FVerificationPhaseResult& OutResult)
+{
+	FString ActorPath;
+	FString ActorName;
+	ResultObj->TryGetStringField(TEXT("actor_object_path"), ActorPath);
+	ResultObj->TryGetStringField(TEXT("actor_name"), ActorName);
+	AActor* Actor = FindActorByPathLabelOrNameLocal(ActorPath);
+	if (!Actor)
+	{
+		return FinishPostVerify(OutResult, false, FString::Printf(TEXT("Floor actor missing after create_floor: %s"), *ActorName));
+	}
+	return FinishPostVerify(OutResult, true, FString::Printf(TEXT("Floor actor exists after create_floor: %s."), *Actor->GetActorLabel()));
+}
 
-			const float ExpectedZ = EntryObj->HasField(TEXT("new_z"))
-				? (float)EntryObj->GetNumberField(TEXT("new_z"))
-				: Actor->GetActorLocation().Z;
-			if (!FMath::IsNearlyEqual(Actor->GetActorLocation().Z, ExpectedZ, 0.05f))
-			{
-				return Finish(false, FString::Printf(TEXT("Aligned actor Z mismatch after align_actors_to_surface for %s."), *Label));
-			}
-		}
+// create_room, create_corridor
+static void PostVerifyGroupedGeometry(
+	const FString& Cmd,
+	const TSharedPtr<FJsonObject>& Args,
+	const TSharedPtr<FJsonObject>& ResultObj,
+	FVerificationPhaseResult& OutResult)
+{
+	FString GroupPath;
+	double ChildCountValue = 0.0;
+	ResultObj->TryGetStringField(TEXT("group_object_path"), GroupPath);
+	ResultObj->TryGetNumberField(TEXT("child_count"), ChildCountValue);
 
-		return Finish(true, TEXT("All aligned actors match the reported surface-adjusted Z location."));
+	AActor* GroupActor = FindActorByPathLabelOrNameLocal(GroupPath);
+	if (!GroupActor)
+	{
+		return FinishPostVerify(OutResult, false, FString::Printf(TEXT("Group actor missing after %s: %s"), *Cmd, *GroupPath));
 	}
 
-	if (Cmd == TEXT("create_floor"))
+	const TArray<TSharedPtr<FJsonValue>>* ChildrenArray = nullptr;
+	if (!ResultObj->TryGetArrayField(TEXT("children"), ChildrenArray) || !ChildrenArray)
 	{
-		FString ActorPath;
-		FString ActorName;
-		ResultObj->TryGetStringField(TEXT("actor_object_path"), ActorPath);
-		ResultObj->TryGetStringField(TEXT("actor_name"), ActorName);
-		AActor* Actor = FindActorByPathLabelOrNameLocal(ActorPath);
-		if (!Actor)
-		{
-			return Finish(false, FString::Printf(TEXT("Floor actor missing after create_floor: %s"), *ActorName));
-		}
-		return Finish(true, FString::Printf(TEXT("Floor actor exists after create_floor: %s."), *Actor->GetActorLabel()));
+		return FinishPostVerify(OutResult, false, FString::Printf(TEXT("%s response missing children array."), *Cmd));
 	}
 
-	if (Cmd == TEXT("create_room") || Cmd == TEXT("create_corridor"))
+	int32 ExistingChildren = 0;
+	for (const TSharedPtr<FJsonValue>& ChildValue : *ChildrenArray)
 	{
-		FString GroupPath;
-		double ChildCountValue = 0.0;
-		ResultObj->TryGetStringField(TEXT("group_object_path"), GroupPath);
-		ResultObj->TryGetNumberField(TEXT("child_count"), ChildCountValue);
-
-		AActor* GroupActor = FindActorByPathLabelOrNameLocal(GroupPath);
-		if (!GroupActor)
+		const TSharedPtr<FJsonObject> ChildObj = ChildValue.IsValid() ? ChildValue->AsObject() : nullptr;
+		if (!ChildObj.IsValid())
 		{
-			return Finish(false, FString::Printf(TEXT("Group actor missing after %s: %s"), *Cmd, *GroupPath));
-		}
-
-		const TArray<TSharedPtr<FJsonValue>>* ChildrenArray = nullptr;
-		if (!ResultObj->TryGetArrayField(TEXT("children"), ChildrenArray) || !ChildrenArray)
-		{
-			return Finish(false, FString::Printf(TEXT("%s response missing children array."), *Cmd));
+			continue;
 		}
 
-		int32 ExistingChildren = 0;
-		for (const TSharedPtr<FJsonValue>& ChildValue : *ChildrenArray)
+		FString ObjectPath;
+		if (!ChildObj->TryGetStringField(TEXT("object_path"), ObjectPath))
 		{
-			const TSharedPtr<FJsonObject> ChildObj = ChildValue.IsValid() ? ChildValue->AsObject() : nullptr;
-			if (!ChildObj.IsValid())
-			{
-				continue;
-			}
-
-			FString ObjectPath;
-			if (!ChildObj->TryGetStringField(TEXT("object_path"), ObjectPath))
-			{
-				continue;
-			}
-
-			if (FindActorByPathLabelOrNameLocal(ObjectPath))
-			{
-				++ExistingChildren;
-			}
+			continue;
 		}
 
-		const int32 ExpectedChildren = FMath::TruncToInt(ChildCountValue);
-		if (ExistingChildren != ExpectedChildren)
+		if (FindActorByPathLabelOrNameLocal(ObjectPath))
 		{
-			return Finish(false, FString::Printf(TEXT("%s child-count mismatch. Expected %d, found %d actors."), *Cmd, ExpectedChildren, ExistingChildren));
+			++ExistingChildren;
 		}
-		return Finish(true, FString::Printf(TEXT("%s group exists and all %d reported children are present."), *Cmd, ExpectedChildren));
 	}
 
-	return false;
+	const int32 ExpectedChildren = FMath::TruncToInt(ChildCountValue);
+	if (ExistingChildren != ExpectedChildren)
+	{
+		return FinishPostVerify(OutResult, false, FString::Printf(TEXT("%s child-count mismatch. Expected %d, found %d actors."), *Cmd, ExpectedChildren, ExistingChildren));
+	}
+	return FinishPostVerify(OutResult, true, FString::Printf(TEXT("%s group exists and all %d reported children are present."), *Cmd, ExpectedChildren));
 }
 
-static bool HasCommandAwarePostVerifyContract(const FString& Cmd)
+static bool RunCommandAwarePostVerify(
+	const FString& Cmd,
+	const TSharedPtr<FJsonObject>& Args,
+	const FString& CommandResult,
+	FVerificationPhaseResult& OutResult)
 {
-	static const TArray<FString> CommandAwareCmds =
+	OutResult = FVerificationPhaseResult();
+	OutResult.PhaseName = TEXT("PostVerify.CommandAware");
+	const double StartTime = FPlatformTime::Seconds();
+
+	const FAgentForgeCommandInfo* Info = FAgentForgeCommandRegistry::Get().Find(Cmd);
+	if (!Info || !Info->HasPostVerifyContract())
 	{
-		TEXT("spawn_actor"),
-		TEXT("spawn_point_light"), TEXT("spawn_spot_light"),
-		TEXT("spawn_rect_light"), TEXT("spawn_directional_light"),
-		TEXT("compile_blueprint"), TEXT("edit_blueprint_node"),
-		TEXT("set_actor_transform"), TEXT("set_actor_scale"),
-		TEXT("set_actor_label"),
-		TEXT("set_static_mesh"),
-		TEXT("apply_material_to_actor"),
-		TEXT("spawn_actor_at_surface"), TEXT("align_actors_to_surface"),
-		TEXT("create_floor"), TEXT("create_room"), TEXT("create_corridor"),
-	};
-	return CommandAwareCmds.Contains(Cmd);
+		return false;
+	}
+
+	TSharedPtr<FJsonObject> ResultObj;
+	FString ParseErr;
+	if (!ParseJsonObjectLocal(CommandResult, ResultObj, ParseErr) || !ResultObj.IsValid())
+	{
+		return false;
+	}
+
+	Info->PostVerify(Cmd, Args, ResultObj, OutResult);
+	OutResult.DurationMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+	return true;
 }
 
 AActor* UAgentForgeLibrary::FindActorByLabelOrName(const FString& LabelOrName)
 {
 #if WITH_EDITOR
-	UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
-	if (!World) { return nullptr; }
-	for (TActorIterator<AActor> It(World); It; ++It)
-	{
-		AActor* A = *It;
-		if (!A || !IsValid(A)) { continue; }
-		if (A->GetActorLabel().Equals(LabelOrName, ESearchCase::IgnoreCase)) { return A; }
-		if (A->GetName().Equals(LabelOrName, ESearchCase::IgnoreCase)) { return A; }
-	}
-#endif
+	return FAgentForgeActorIndex::Get().FindByLabelOrName(LabelOrName);
+#else
 	return nullptr;
+#endif
 }
 
 TSharedPtr<FJsonObject> UAgentForgeLibrary::VecToJson(const FVector& V)
@@ -2076,30 +2335,16 @@ TSharedPtr<FJsonObject> UAgentForgeLibrary::VecToJson(const FVector& V)
 	return Obj;
 }
 
+static bool HasCommandFlag(const FString& Cmd, const EAgentForgeCommandFlags Flag)
+{
+	const FAgentForgeCommandInfo* Info = FAgentForgeCommandRegistry::Get().Find(Cmd);
+	return Info && Info->HasFlag(Flag);
+}
+
 static bool IsMainPathMutatingCommand(const FString& Cmd)
 {
-	static const TArray<FString> MutatingCmds =
-	{
-		TEXT("spawn_actor"), TEXT("set_actor_transform"), TEXT("delete_actor"),
-		TEXT("duplicate_actor"),
-		TEXT("spawn_actor_at_surface"), TEXT("align_actors_to_surface"),
-		TEXT("spawn_point_light"), TEXT("spawn_spot_light"),
-		TEXT("spawn_rect_light"), TEXT("spawn_directional_light"),
-		TEXT("set_static_mesh"), TEXT("set_actor_scale"),
-		TEXT("set_actor_label"), TEXT("set_actor_mobility"), TEXT("set_actor_visibility"),
-		TEXT("group_actors"), TEXT("set_actor_property"),
-		TEXT("create_wall"), TEXT("create_floor"), TEXT("create_room"),
-		TEXT("create_corridor"), TEXT("create_staircase"), TEXT("create_pillar"),
-		TEXT("scatter_props"), TEXT("set_fog"), TEXT("set_post_process"), TEXT("set_sky_atmosphere"),
-		TEXT("create_blueprint"), TEXT("compile_blueprint"), TEXT("set_bp_cdo_property"),
-		TEXT("edit_blueprint_node"), TEXT("create_material_instance"), TEXT("set_material_params"),
-		TEXT("apply_material_to_actor"), TEXT("set_mesh_material_color"),
-		TEXT("set_material_scalar_param"),
-		TEXT("rename_asset"), TEXT("move_asset"), TEXT("delete_asset"),
-		TEXT("setup_test_level"),
-		// NOTE: execute_python is NOT here — it routes directly (see ExecuteCommandJson).
-	};
-	return MutatingCmds.Contains(Cmd);
+	// NOTE: execute_python is NOT main-path mutating — it routes directly (see ExecuteCommandJson).
+	return HasCommandFlag(Cmd, EAgentForgeCommandFlags::Mutating);
 }
 
 bool UAgentForgeLibrary::IsMutatingCommand(const FString& Cmd)
@@ -2113,33 +2358,16 @@ bool UAgentForgeLibrary::IsMutatingCommand(const FString& Cmd)
 // - main_path_partial_no_snapshot: ExecuteSafeTransaction with Snapshot/Rollback skipped
 // - bypass_manual_verification: bypasses ExecuteSafeTransaction and performs ad hoc verification internally
 // - bypass_unverified: bypasses ExecuteSafeTransaction with no shared verification contract
+// - batch_partial_no_snapshot: execute_batch — one PreFlight/PostVerify around the whole batch
+// Per-command membership is declared once via EAgentForgeCommandFlags in RegisterBuiltinCommands.
 static bool DoesCommandSkipSnapshotRollback(const FString& Cmd)
 {
-	static const TArray<FString> SkipSnapshotRollbackCmds =
-	{
-		TEXT("spawn_actor"), TEXT("duplicate_actor"), TEXT("spawn_actor_at_surface"),
-		TEXT("spawn_point_light"), TEXT("spawn_spot_light"),
-		TEXT("spawn_rect_light"), TEXT("spawn_directional_light"),
-		TEXT("group_actors"),
-		TEXT("create_wall"), TEXT("create_floor"), TEXT("create_room"),
-		TEXT("create_corridor"), TEXT("create_staircase"), TEXT("create_pillar"),
-		TEXT("scatter_props"), TEXT("set_fog"), TEXT("set_post_process"), TEXT("set_sky_atmosphere"),
-		TEXT("create_blueprint"), TEXT("create_material_instance"),
-		TEXT("rename_asset"), TEXT("move_asset"), TEXT("delete_asset"),
-	};
-	return SkipSnapshotRollbackCmds.Contains(Cmd);
+	return HasCommandFlag(Cmd, EAgentForgeCommandFlags::SkipSnapshotRollback);
 }
 
 static bool IsKnownRollbackLeakyCommand(const FString& Cmd)
 {
-	static const TArray<FString> KnownRollbackLeakCmds =
-	{
-		TEXT("spawn_actor_at_surface"),
-		TEXT("create_floor"),
-		TEXT("create_room"),
-		TEXT("create_corridor"),
-	};
-	return KnownRollbackLeakCmds.Contains(Cmd);
+	return HasCommandFlag(Cmd, EAgentForgeCommandFlags::RollbackLeaky);
 }
 
 static bool CollectRecoveryActorPaths(const FString& Cmd, const FString& CommandResult, TArray<FString>& OutActorPaths, FString& OutError)
@@ -2329,69 +2557,18 @@ static bool RunCompensatingCleanupProbe(
 
 static bool IsBypassMutatingCommandWithManualVerification(const FString& Cmd)
 {
-	static const TArray<FString> ManualVerificationBypassCmds =
-	{
-		TEXT("enhance_current_level"),
-		TEXT("observe_analyze_plan_act"),
-		TEXT("enhance_horror_scene"),
-	};
-	return ManualVerificationBypassCmds.Contains(Cmd);
+	return HasCommandFlag(Cmd, EAgentForgeCommandFlags::ManualVerification);
 }
 
 static bool IsBypassMutatingCommand(const FString& Cmd)
 {
-	static const TArray<FString> BypassMutatingCmds =
-	{
-		TEXT("execute_python"),
-		TEXT("set_bt_blackboard"),
-		TEXT("wire_aicontroller_bt"),
-		TEXT("setup_flashlight_scs"),
-		TEXT("import_local_asset"),
-		TEXT("place_asset_thematically"),
-		TEXT("refine_level_section"),
-		TEXT("apply_genre_rules"),
-		TEXT("create_in_editor_asset"),
-		TEXT("enhance_current_level"),
-		TEXT("observe_analyze_plan_act"),
-		TEXT("enhance_horror_scene"),
-		TEXT("create_blockout_level"),
-		TEXT("convert_to_whitebox_modular"),
-		TEXT("apply_set_dressing"),
-		TEXT("apply_professional_lighting"),
-		TEXT("add_living_systems"),
-		TEXT("generate_full_quality_level"),
-		TEXT("op_terrain_generate"),
-		TEXT("op_surface_scatter"),
-		TEXT("op_spline_scatter"),
-		TEXT("op_road_layout"),
-		TEXT("op_biome_layers"),
-		TEXT("op_stamp_poi"),
-		TEXT("run_operator_pipeline"),
-	};
-	return BypassMutatingCmds.Contains(Cmd);
+	return HasCommandFlag(Cmd, EAgentForgeCommandFlags::Bypass);
 }
 
 static FString GetVerificationModeForCommand(const FString& Cmd)
 {
-	if (IsBypassMutatingCommandWithManualVerification(Cmd))
-	{
-		return TEXT("bypass_manual_verification");
-	}
-	if (IsBypassMutatingCommand(Cmd))
-	{
-		return TEXT("bypass_unverified");
-	}
-	if (IsMainPathMutatingCommand(Cmd))
-	{
-		if (DoesCommandSkipSnapshotRollback(Cmd))
-		{
-			return IsKnownRollbackLeakyCommand(Cmd)
-				? TEXT("main_path_partial_compensating_cleanup")
-				: TEXT("main_path_partial_no_snapshot");
-		}
-		return TEXT("main_path_partial");
-	}
-	return TEXT("not_applicable");
+	const FAgentForgeCommandInfo* Info = FAgentForgeCommandRegistry::Get().Find(Cmd);
+	return Info ? Info->GetVerificationMode() : FString(TEXT("not_applicable"));
 }
 
 static FString ResolveExecutedVerificationMode(const FString& Cmd, const bool bHasCommandAwarePostVerify)
@@ -2427,27 +2604,8 @@ static FString ResolveExecutedVerificationMode(const FString& Cmd, const bool bH
 
 static FString BuildPreFlightActionDescription(const FString& Cmd)
 {
-	if (Cmd == TEXT("spawn_actor_at_surface"))
-	{
-		return TEXT("surface placement spawn");
-	}
-	if (Cmd == TEXT("align_actors_to_surface"))
-	{
-		return TEXT("surface alignment transform");
-	}
-	if (Cmd == TEXT("spawn_directional_light"))
-	{
-		return TEXT("sunlight actor placement");
-	}
-	if (Cmd == TEXT("compile_blueprint"))
-	{
-		return TEXT("validation script graph build pass");
-	}
-	if (Cmd == TEXT("edit_blueprint_node"))
-	{
-		return TEXT("visual script node edit in validation sandbox");
-	}
-	return Cmd;
+	const FAgentForgeCommandInfo* Info = FAgentForgeCommandRegistry::Get().Find(Cmd);
+	return (Info && !Info->PreFlightDescription.IsEmpty()) ? Info->PreFlightDescription : Cmd;
 }
 
 static int32 DetermineExpectedActorDelta(const FString& Cmd, const FString& CommandResult)
@@ -2885,6 +3043,10 @@ static FString VerifyApplySetDressingAndAnnotate(const FString& Cmd, const TShar
 			{
 				++MatchingProps;
 			}
+			else if (Label.StartsWith(TEXT("Prop_Instances_")) && Label.Contains(ThemePrefix))
+			{
+				MatchingProps += FAgentForgeInstancedScatter::CountInstances(Actor);
+			}
 		}
 	}
 
@@ -3234,6 +3396,10 @@ void UAgentForgeLibrary::MarkEngineShuttingDown()
 {
 #if WITH_EDITOR
 	GForgeShutdownRequested = true;
+	FAgentForgeSocketServer::Get().Stop();
+	FAgentForgeCommandQueue::Get().Shutdown();
+	FAgentForgeJobManager::Get().Shutdown();
+	FAgentForgeActorIndex::Get().Shutdown();
 	if (GOpenTransaction.IsValid())
 	{
 		GOpenTransaction->Cancel();
@@ -3251,6 +3417,337 @@ bool UAgentForgeLibrary::IsEngineShuttingDown()
 #endif
 }
 
+// ============================================================================
+//  COMMAND REGISTRY
+// ============================================================================
+void UAgentForgeLibrary::RegisterBuiltinCommands()
+{
+#if WITH_EDITOR
+	using EFlags = EAgentForgeCommandFlags;
+	FAgentForgeCommandRegistry& Registry = FAgentForgeCommandRegistry::Get();
+	Registry.Reset();
+
+	// Routing profiles — see the verification coverage inventory above.
+	const EFlags ReadOnly       = EFlags::None;
+	const EFlags Query          = EFlags::Coalescable;   // side-effect free; see AgentForgeCommandQueue
+	const EFlags MainPath       = EFlags::Mutating;
+	const EFlags MainNoSnapshot = EFlags::Mutating | EFlags::SkipSnapshotRollback;
+	const EFlags MainLeaky      = MainNoSnapshot | EFlags::RollbackLeaky;
+	const EFlags MainBlueprint  = MainPath | EFlags::EditsBlueprints;   // + cached BuildCheck
+	const EFlags Bypass         = EFlags::Bypass | EFlags::FinalizeResponse;
+	const EFlags BypassSelf     = EFlags::Bypass;   // handler annotates via Verify*AndAnnotate
+	const EFlags BypassManual   = EFlags::Bypass | EFlags::ManualVerification | EFlags::FinalizeResponse;
+	const EFlags Operator       = EFlags::OperatorHeavy | Bypass;
+
+	auto Add = [&Registry](
+		const TCHAR* Name,
+		const TCHAR* Category,
+		const EFlags Flags,
+		const TCHAR* ArgSchema,
+		FAgentForgeCommandHandler Handler,
+		FAgentForgePostVerifyHook PostVerify = nullptr,
+		const TCHAR* PreFlightDescription = TEXT(""))
+	{
+		FAgentForgeCommandInfo Info;
+		Info.Name                 = FName(Name);
+		Info.Category             = Category;
+		Info.ArgSchema            = ArgSchema;
+		Info.PreFlightDescription = PreFlightDescription;
+		Info.Flags                = Flags;
+		Info.Handler              = MoveTemp(Handler);
+		Info.PostVerify           = PostVerify;
+		Registry.Register(MoveTemp(Info));
+	};
+	auto NoArgs = [](FString (*Fn)()) -> FAgentForgeCommandHandler
+	{
+		return [Fn](const TSharedPtr<FJsonObject>&) { return Fn(); };
+	};
+	// Time-sliced commands: the synchronous handler runs the same staged job inline;
+	// "async":true submits it to FAgentForgeJobManager instead. Filter (optional)
+	// post-processes the final response on both paths.
+	using FJobResultFilter = FString (*)(const TSharedPtr<FJsonObject>& Args, const FString& Raw);
+	auto AddAsync = [&Registry](
+		const TCHAR* Name,
+		const TCHAR* Category,
+		const EFlags Flags,
+		const TCHAR* ArgSchema,
+		TSharedRef<FAgentForgeJob> (*Factory)(const TSharedPtr<FJsonObject>&),
+		FJobResultFilter Filter = nullptr)
+	{
+		FAgentForgeCommandInfo Info;
+		Info.Name      = FName(Name);
+		Info.Category  = Category;
+		Info.ArgSchema = FString(ArgSchema) + TEXT(", [async=false], [frame_budget_ms=8]");
+		Info.Flags     = Flags;
+		Info.Handler   = [Factory, Filter](const TSharedPtr<FJsonObject>& Args)
+		{
+			const FString Raw = Factory(Args)->RunToCompletion();
+			return Filter ? Filter(Args, Raw) : Raw;
+		};
+		Info.JobFactory = [Factory, Filter](const TSharedPtr<FJsonObject>& Args)
+		{
+			TSharedRef<FAgentForgeJob> Job = Factory(Args);
+			if (Filter)
+			{
+				Job->AddResultFilter([Filter, Args](const FString& Raw) { return Filter(Args, Raw); });
+			}
+			return Job;
+		};
+		Registry.Register(MoveTemp(Info));
+	};
+
+	// ── Observation ──────────────────────────────────────────────────────────
+	Add(TEXT("ping"),                     TEXT("observation"), Query, TEXT(""), &Cmd_Ping);
+	Add(TEXT("get_all_level_actors"),     TEXT("observation"), Query, TEXT("[fields[]], [class], [tag], [bounds{min,max}], [limit], [cursor], [encoding=json|cbor]"), &Cmd_GetAllLevelActors);
+	Add(TEXT("get_actor_components"),     TEXT("observation"), Query, TEXT("label"), &Cmd_GetActorComponents);
+	Add(TEXT("get_current_level"),        TEXT("observation"), Query, TEXT(""), NoArgs(&Cmd_GetCurrentLevel));
+	Add(TEXT("assert_current_level"),     TEXT("observation"), Query, TEXT("expected_level"), &Cmd_AssertCurrentLevel);
+	Add(TEXT("get_actor_bounds"),         TEXT("observation"), Query, TEXT("label"), &Cmd_GetActorBounds);
+	Add(TEXT("get_world_context"),        TEXT("observation"), Query, TEXT("[max_actors=120], [max_relationships=48], [include_components=false], [include_screenshot=true], [screenshot_label], [since_revision], [fields[]], [class], [tag], [bounds{min,max}], [limit], [cursor], [encoding=json|cbor]"), &Cmd_GetWorldContext);
+	Add(TEXT("get_available_meshes"),     TEXT("observation"), Query, TEXT("[search_filter], [prefix], [path_filter], [tag], [max_results=50]"), &Cmd_GetAvailableMeshes);
+	Add(TEXT("get_available_materials"),  TEXT("observation"), Query, TEXT("[search_filter], [prefix], [path_filter], [tag], [max_results=50]"), &Cmd_GetAvailableMaterials);
+	Add(TEXT("get_available_blueprints"), TEXT("observation"), Query, TEXT("[search_filter], [prefix], [parent_class], [path_filter], [tag], [max_results=50]"), &Cmd_GetAvailableBlueprints);
+	Add(TEXT("get_available_textures"),   TEXT("observation"), Query, TEXT("[search_filter], [prefix], [path_filter], [tag], [max_results=50]"), &Cmd_GetAvailableTextures);
+	Add(TEXT("get_available_sounds"),     TEXT("observation"), Query, TEXT("[search_filter], [prefix], [path_filter], [tag], [max_results=50]"), &Cmd_GetAvailableSounds);
+	Add(TEXT("get_asset_details"),        TEXT("observation"), Query, TEXT("asset_path"), &Cmd_GetAssetDetails);
+	Add(TEXT("focus_viewport_on_actor"),  TEXT("observation"), ReadOnly, TEXT("actor_name"), &Cmd_FocusViewportOnActor);
+	Add(TEXT("get_viewport_info"),        TEXT("observation"), Query, TEXT(""), NoArgs(&Cmd_GetViewportInfo));
+	Add(TEXT("set_viewport_camera"),      TEXT("observation"), ReadOnly, TEXT("x, y, z, [pitch=0], [yaw=0], [roll=0]"), &Cmd_SetViewportCamera);
+	Add(TEXT("redraw_viewports"),         TEXT("observation"), ReadOnly, TEXT(""), NoArgs(&Cmd_RedrawViewports));
+	Add(TEXT("get_actor_property"),       TEXT("observation"), Query, TEXT("actor_name, property_name"), &Cmd_GetActorProperty);
+	Add(TEXT("take_screenshot"),          TEXT("observation"), ReadOnly, TEXT("[filename]"), &Cmd_TakeScreenshot);
+
+	// ── Actor control (main path) ────────────────────────────────────────────
+	Add(TEXT("spawn_actor"),              TEXT("actor_control"), MainNoSnapshot | EFlags::DirectPlacement, TEXT("class_path, x, y, z, [pitch], [yaw], [roll]"), &Cmd_SpawnActor, &PostVerifySpawnedActor);
+	Add(TEXT("duplicate_actor"),          TEXT("actor_control"), MainNoSnapshot, TEXT("actor_name, [offset_x], [offset_y], [offset_z]"), &Cmd_DuplicateActor);
+	Add(TEXT("spawn_point_light"),        TEXT("actor_control"), MainNoSnapshot, TEXT("x, y, z, [intensity], [color_r], [color_g], [color_b], [attenuation_radius], [label]"), &Cmd_SpawnPointLight, &PostVerifyPointOrSpotLight);
+	Add(TEXT("spawn_spot_light"),         TEXT("actor_control"), MainNoSnapshot, TEXT("x, y, z, [rx], [ry], [rz], [intensity], [color_r], [color_g], [color_b], [inner_cone_angle], [outer_cone_angle], [label]"), &Cmd_SpawnSpotLight, &PostVerifyPointOrSpotLight);
+	Add(TEXT("spawn_rect_light"),         TEXT("actor_control"), MainNoSnapshot, TEXT("x, y, z, [rx], [ry], [rz], [intensity], [width], [height], [color_r], [color_g], [color_b], [label]"), &Cmd_SpawnRectLight, &PostVerifyRectOrDirectionalLight);
+	Add(TEXT("spawn_directional_light"),  TEXT("actor_control"), MainNoSnapshot, TEXT("[rx], [ry], [rz], [intensity], [color_r], [color_g], [color_b], [label]"), &Cmd_SpawnDirectionalLight, &PostVerifyRectOrDirectionalLight, TEXT("sunlight actor placement"));
+	Add(TEXT("set_actor_transform"),      TEXT("actor_control"), MainPath | EFlags::DirectPlacement, TEXT("object_path, x, y, z, pitch, yaw, roll"), &Cmd_SetActorTransform, &PostVerifyActorTransform);
+	Add(TEXT("set_static_mesh"),          TEXT("actor_control"), MainPath, TEXT("actor_name, mesh_path"), &Cmd_SetStaticMesh, &PostVerifyStaticMesh);
+	Add(TEXT("set_actor_scale"),          TEXT("actor_control"), MainPath, TEXT("actor_name, sx, sy, sz"), &Cmd_SetActorScale, &PostVerifyActorScale);
+	Add(TEXT("set_actor_label"),          TEXT("actor_control"), MainPath, TEXT("actor_name, new_label"), &Cmd_SetActorLabel, &PostVerifyActorLabel);
+	Add(TEXT("set_actor_mobility"),       TEXT("actor_control"), MainPath, TEXT("actor_name, mobility"), &Cmd_SetActorMobility);
+	Add(TEXT("set_actor_visibility"),     TEXT("actor_control"), MainPath, TEXT("actor_name, visible"), &Cmd_SetActorVisibility);
+	Add(TEXT("group_actors"),             TEXT("actor_control"), MainNoSnapshot, TEXT("actor_names[], group_name"), &Cmd_GroupActors);
+	Add(TEXT("set_actor_property"),       TEXT("actor_control"), MainPath, TEXT("actor_name, property_name, value"), &Cmd_SetActorProperty);
+	Add(TEXT("delete_actor"),             TEXT("actor_control"), MainPath | EFlags::DirectPlacement, TEXT("label"), &Cmd_DeleteActor);
+	Add(TEXT("create_wall"),              TEXT("actor_control"), MainNoSnapshot, TEXT("start_x, start_y, end_x, end_y, [height], [thickness], [z], [has_windows], [window_spacing], [window_height], [material_path], [label]"), &Cmd_CreateWall);
+	Add(TEXT("create_floor"),             TEXT("actor_control"), MainLeaky, TEXT("center_x, center_y, [z], width, length, [thickness], [material_path], [label]"), &Cmd_CreateFloor, &PostVerifyCreateFloor);
+	Add(TEXT("create_room"),              TEXT("actor_control"), MainLeaky, TEXT("center_x, center_y, [z], width, length, height, [wall_thickness], [slab_thickness], [floor_material], [wall_material], [ceiling_material], [door_wall], [window_walls], [label], [output]"), &Cmd_CreateRoom, &PostVerifyGroupedGeometry);
+	Add(TEXT("create_corridor"),          TEXT("actor_control"), MainLeaky, TEXT("start_x, start_y, end_x, end_y, [z], [width], [height], [wall_thickness], [slab_thickness], [has_ceiling], [wall_material], [floor_material], [label], [output]"), &Cmd_CreateCorridor, &PostVerifyGroupedGeometry);
+	Add(TEXT("create_staircase"),         TEXT("actor_control"), MainNoSnapshot, TEXT("base_x, base_y, base_z, [step_count], [step_width], [step_depth], [step_height], [direction], [material_path], [label]"), &Cmd_CreateStaircase);
+	Add(TEXT("create_pillar"),            TEXT("actor_control"), MainNoSnapshot, TEXT("x, y, z, [radius], [height], [sides], [material_path], [label]"), &Cmd_CreatePillar);
+	Add(TEXT("scatter_props"),            TEXT("actor_control"), MainNoSnapshot, TEXT("mesh_path, center_x, center_y, [z], [radius], [count], [min_scale], [max_scale], [random_rotation], [snap_to_surface], [material_path], [label_prefix], [output=actors|instances], [tint{r,g,b}], [tint_variation]"), &Cmd_ScatterProps);
+	Add(TEXT("set_fog"),                  TEXT("actor_control"), MainNoSnapshot, TEXT("[density], [height_falloff], [start_distance], [color_r], [color_g], [color_b]"), &Cmd_SetFog);
+	Add(TEXT("set_post_process"),         TEXT("actor_control"), MainNoSnapshot, TEXT("[bloom_intensity], [exposure_compensation], [ambient_occlusion_intensity], [vignette_intensity], [saturation], [contrast], [color_temp]"), &Cmd_SetPostProcess);
+	Add(TEXT("set_sky_atmosphere"),       TEXT("actor_control"), MainNoSnapshot, TEXT("[preset=default_day]"), &Cmd_SetSkyAtmosphere);
+	Add(TEXT("save_current_level"),       TEXT("actor_control"), ReadOnly, TEXT(""), NoArgs(&Cmd_SaveCurrentLevel));
+
+	// ── Spatial queries / intelligence ───────────────────────────────────────
+	Add(TEXT("cast_ray"),                  TEXT("spatial"), Query, TEXT("start{x,y,z}, end{x,y,z}, [trace_complex=true]"), &Cmd_CastRay);
+	Add(TEXT("query_navmesh"),             TEXT("spatial"), Query, TEXT("x, y, z, [extent_x=100], [extent_y=100], [extent_z=200]"), &Cmd_QueryNavMesh);
+	Add(TEXT("spawn_actor_at_surface"),    TEXT("spatial"), MainLeaky, TEXT("class_path, origin{x,y,z}, direction{x,y,z}, [max_distance=5000], [align_to_normal=true], [label]"), &FSpatialControlModule::SpawnActorAtSurface, &PostVerifySurfaceSpawn, TEXT("surface placement spawn"));
+	Add(TEXT("align_actors_to_surface"),   TEXT("spatial"), MainPath, TEXT("actor_labels[], [down_trace_extent=2000]"), &FSpatialControlModule::AlignActorsToSurface, &PostVerifySurfaceAlignment, TEXT("surface alignment transform"));
+	Add(TEXT("get_surface_normal_at"),     TEXT("spatial"), Query, TEXT("x, y, z"), &FSpatialControlModule::GetSurfaceNormalAt);
+	Add(TEXT("analyze_level_composition"), TEXT("spatial"), Query, TEXT(""), NoArgs(&FSpatialControlModule::AnalyzeLevelComposition));
+	Add(TEXT("get_actors_in_radius"),      TEXT("spatial"), Query, TEXT("x, y, z, radius, [fields[]], [class], [tag], [bounds{min,max}], [limit], [cursor], [encoding=json|cbor]"), &FSpatialControlModule::GetActorsInRadius);
+	Add(TEXT("get_actors_in_box"),         TEXT("spatial"), Query, TEXT("min{x,y,z}, max{x,y,z}, [fields[]], [class], [tag], [limit], [cursor], [encoding=json|cbor]"), &FSpatialControlModule::GetActorsInBox);
+	Add(TEXT("get_nearest_actors"),        TEXT("spatial"), Query, TEXT("x, y, z, [k=8], [max_radius], [fields[]], [class], [tag], [bounds{min,max}], [limit], [cursor], [encoding=json|cbor]"), &FSpatialControlModule::GetNearestActors);
+
+	// ── Blueprint manipulation ───────────────────────────────────────────────
+	Add(TEXT("create_blueprint"),     TEXT("blueprint"), MainNoSnapshot, TEXT("name, parent_class, output_path"), &Cmd_CreateBlueprint);
+	Add(TEXT("compile_blueprint"),    TEXT("blueprint"), MainPath, TEXT("blueprint_path"), &Cmd_CompileBlueprint, &PostVerifyCompileBlueprint, TEXT("validation script graph build pass"));
+	Add(TEXT("set_bp_cdo_property"),  TEXT("blueprint"), MainBlueprint, TEXT("blueprint_path, property_name, type(float|int|bool|string|name|vector), value"), &Cmd_SetBlueprintCDOProperty);
+	Add(TEXT("edit_blueprint_node"),  TEXT("blueprint"), MainBlueprint, TEXT("blueprint_path, node_spec{type,title,pins[{name,value}]}"), &Cmd_EditBlueprintNode, &PostVerifyEditBlueprintNode, TEXT("visual script node edit in validation sandbox"));
+	Add(TEXT("set_bt_blackboard"),    TEXT("blueprint"), Bypass, TEXT("bt_path, bb_path"), &Cmd_SetBtBlackboard);
+	Add(TEXT("wire_aicontroller_bt"), TEXT("blueprint"), Bypass, TEXT("aicontroller_path, bt_path"), &Cmd_WireAIControllerBT);
+	Add(TEXT("setup_flashlight_scs"), TEXT("blueprint"), Bypass, TEXT("blueprint_path"), &Cmd_SetupFlashlightSCS);
+
+	// ── Materials / content ──────────────────────────────────────────────────
+	Add(TEXT("create_material_instance"),  TEXT("material"), MainNoSnapshot, TEXT("parent_material, instance_name, output_path"), &Cmd_CreateMaterialInstance);
+	Add(TEXT("set_material_params"),       TEXT("material"), MainPath, TEXT("instance_path, [scalar_params{name:float}], [vector_params{name:{r,g,b,a}}]"), &Cmd_SetMaterialParams);
+	Add(TEXT("apply_material_to_actor"),   TEXT("material"), MainPath, TEXT("actor_name, material_path, [slot_index=0]"), &Cmd_ApplyMaterialToActor, &PostVerifyMaterialAssignment);
+	Add(TEXT("set_mesh_material_color"),   TEXT("material"), MainPath, TEXT("actor_name, r, g, b, [a=1], [slot_index=0]"), &Cmd_SetMeshMaterialColor);
+	Add(TEXT("set_material_scalar_param"), TEXT("material"), MainPath, TEXT("actor_name, param_name, value, [slot_index=0]"), &Cmd_SetMaterialScalarParam);
+	Add(TEXT("rename_asset"),              TEXT("content"), MainNoSnapshot, TEXT("asset_path, new_name"), &Cmd_RenameAsset);
+	Add(TEXT("move_asset"),                TEXT("content"), MainNoSnapshot, TEXT("asset_path, destination_path"), &Cmd_MoveAsset);
+	Add(TEXT("delete_asset"),              TEXT("content"), MainNoSnapshot, TEXT("asset_path"), &Cmd_DeleteAsset);
+
+	// ── Transactions / scripting / forge meta ───────────────────────────────
+	Add(TEXT("begin_transaction"),    TEXT("transaction"), ReadOnly, TEXT("[label=AgentForge]"), &Cmd_BeginTransaction);
+	Add(TEXT("end_transaction"),      TEXT("transaction"), ReadOnly, TEXT(""), NoArgs(&Cmd_EndTransaction));
+	Add(TEXT("undo_transaction"),     TEXT("transaction"), ReadOnly, TEXT(""), NoArgs(&Cmd_UndoTransaction));
+	Add(TEXT("create_snapshot"),      TEXT("transaction"), ReadOnly, TEXT("[snapshot_name], [json=false]"), &Cmd_CreateSnapshot);
+	// execute_python bypasses ExecuteSafeTransaction — Python scripts may perform
+	// non-undoable operations (new_level, load_level, file I/O) that break rollback
+	// verification. Route directly so the script runs once without a test phase.
+	Add(TEXT("execute_python"),       TEXT("python"), Bypass | EFlags::MemoryGuarded, TEXT("script, [force_ue_gc=false]"), &Cmd_ExecutePython);
+	Add(TEXT("get_perf_stats"),       TEXT("forge"), ReadOnly, TEXT(""), NoArgs(&Cmd_GetPerfStats));
+	Add(TEXT("get_command_metrics"),  TEXT("forge"), ReadOnly, TEXT("[cmd], [reset=false]"), &Cmd_GetCommandMetrics);
+	Add(TEXT("start_command_trace"),  TEXT("forge"), ReadOnly, TEXT("[path], [max_response_chars=262144], [exclude[]]"), &Cmd_StartCommandTrace);
+	Add(TEXT("stop_command_trace"),   TEXT("forge"), ReadOnly, TEXT(""), NoArgs(&Cmd_StopCommandTrace));
+	AddAsync(TEXT("farm_precompute"), TEXT("forge"), ReadOnly, TEXT("jobs[{cmd,args}], [spool], [map], [timeout_seconds=1800], [cache=disk]"), &FAgentForgeWorkerFarm::MakePrecomputeJob);
+	Add(TEXT("get_farm_status"),      TEXT("forge"), ReadOnly, TEXT("[spool], [job_ids[]], [cache=disk]"), &Cmd_GetFarmStatus);
+	Add(TEXT("run_verification"),     TEXT("forge"), ReadOnly, TEXT("[phase_mask=15]"), &Cmd_RunVerification);
+	Add(TEXT("enforce_constitution"), TEXT("forge"), Query, TEXT("action_description"), &Cmd_EnforceConstitution);
+	Add(TEXT("get_forge_status"),     TEXT("forge"), ReadOnly, TEXT(""), NoArgs(&Cmd_GetForgeStatus));
+	Add(TEXT("list_commands"),        TEXT("forge"), Query, TEXT("[category]"), &Cmd_ListCommands);
+	Add(TEXT("execute_batch"),        TEXT("forge"), EFlags::SelfTransacting, TEXT("commands[{cmd,args}], [transactional=true], [stop_on_error=true], [verify=true]"), &Cmd_ExecuteBatch);
+	Add(TEXT("get_job_status"),       TEXT("forge"), ReadOnly, TEXT("[job_id], [include_partial=true]"), &Cmd_GetJobStatus);
+	Add(TEXT("cancel_job"),           TEXT("forge"), ReadOnly, TEXT("job_id"), &Cmd_CancelJob);
+	Add(TEXT("set_command_queue_policy"), TEXT("forge"), ReadOnly, TEXT("[frame_budget_ms=10], [coalesce_read_only=true]"), &Cmd_SetCommandQueuePolicy);
+	Add(TEXT("set_verification_policy"), TEXT("forge"), ReadOnly, TEXT("[rollback_scope=scoped|full]"), &Cmd_SetVerificationPolicy);
+	Add(TEXT("start_socket_server"),  TEXT("forge"), ReadOnly, TEXT("[port=30020], [bind_address=127.0.0.1]"), &Cmd_StartSocketServer);
+	Add(TEXT("stop_socket_server"),   TEXT("forge"), ReadOnly, TEXT(""), &Cmd_StopSocketServer);
+	AddAsync(TEXT("run_benchmarks"),  TEXT("forge"), ReadOnly, TEXT("[cases[]], [point_counts[]], [heightmap_sizes[]], [repeats=3], [seed=1337], [label], [output_dir]"), &FAgentForgeBenchmark::MakeBenchmarkJob);
+	Add(TEXT("setup_test_level"),     TEXT("scene_setup"), MainPath, TEXT("[floor_size=10000]"), &Cmd_SetupTestLevel);
+
+	// ── LLM + vision ─────────────────────────────────────────────────────────
+	Add(TEXT("llm_chat"),             TEXT("llm"), ReadOnly, TEXT("provider, [model], messages[]|prompt, [system], [custom_endpoint], [max_tokens], [temperature], [cache=bypass|prefer|only], [prompt_cache=false], [priority=interactive|background], [fan_out[{provider,model,custom_endpoint}]], [fan_out_mode=first|all], [hedge_delay_ms=0]"), &Cmd_LLMChat);
+	{
+		// llm_stream: inline it waits on its own request, pushing stream_chunk events as
+		// deltas arrive; "async":true runs it as a job whose partial_results are the chunks.
+		FAgentForgeCommandInfo Info;
+		Info.Name       = FName(TEXT("llm_stream"));
+		Info.Category   = TEXT("llm");
+		Info.ArgSchema  = TEXT("provider, [model], messages[]|prompt, [system], [custom_endpoint], [max_tokens], [temperature], [cache=bypass|prefer|only], [prompt_cache=false], [priority=interactive|background], [async=false]");
+		Info.Flags      = ReadOnly;
+		Info.Handler    = &Cmd_LLMStream;
+		Info.JobFactory = &MakeLLMStreamJob;
+		Registry.Register(MoveTemp(Info));
+	}
+	Add(TEXT("llm_structured"),       TEXT("llm"), ReadOnly, TEXT("provider, [model], prompt, schema, [system], [custom_endpoint], [max_tokens], [temperature], [cache=bypass|prefer|only], [prompt_cache=false], [priority=interactive|background], [fan_out[{provider,model,custom_endpoint}]], [fan_out_mode=first|all], [hedge_delay_ms=0]"), &Cmd_LLMStructured);
+	Add(TEXT("set_llm_cache_policy"), TEXT("llm"), ReadOnly, TEXT("[ttl_seconds=604800], [memory_entries=256], [disk_budget_mb=256], [disk=true], [clear=false], [clear_disk=false]"), &Cmd_SetLLMCachePolicy);
+	Add(TEXT("validate_json"),        TEXT("llm"), Query, TEXT("value|json, schema|schema_name, [reload=false]"), &Cmd_ValidateJson);
+	Add(TEXT("set_llm_scheduler_policy"), TEXT("llm"), ReadOnly, TEXT("[provider], [max_concurrent=4], [max_retries=4], [backoff_base_ms=1000], [backoff_max_ms=60000]"), &Cmd_SetLLMSchedulerPolicy);
+	Add(TEXT("llm_set_key"),          TEXT("llm"), ReadOnly, TEXT("provider, key"), &Cmd_LLMSetKey);
+	Add(TEXT("llm_get_models"),       TEXT("llm"), ReadOnly, TEXT("provider"), &Cmd_LLMGetModels);
+	Add(TEXT("vision_analyze"),       TEXT("vision"), ReadOnly, TEXT("prompt, [provider], [model], [multi_view=false], [use_cache=true]"), &Cmd_VisionAnalyze);
+	Add(TEXT("vision_quality_score"), TEXT("vision"), ReadOnly, TEXT("[provider], [model], [multi_view=false], [use_cache=true], [fan_out[{provider,model}]], [fan_out_mode=first|all], [hedge_delay_ms=0]"), &Cmd_VisionQualityScore);
+	Add(TEXT("set_vision_cache_policy"), TEXT("vision"), ReadOnly, TEXT("[enabled=true], [min_similarity=0.985], [max_hash_distance=6], [max_age_seconds=600], [capacity=32], [clear=false]"), &Cmd_SetVisionCachePolicy);
+
+	// ── v0.2.0 FAB + orchestration ───────────────────────────────────────────
+	Add(TEXT("search_fab_assets"),     TEXT("fab"), ReadOnly, TEXT("query, [max_results=20], [free_only=true], [cache_ttl_seconds=300]"), &FFabIntegrationModule::SearchFabAssets);
+	Add(TEXT("download_fab_asset"),    TEXT("fab"), ReadOnly, TEXT(""), &FFabIntegrationModule::DownloadFabAsset);
+	Add(TEXT("import_local_asset"),    TEXT("fab"), Bypass, TEXT("file_path, [destination_path=/Game/FabImports]"), &FFabIntegrationModule::ImportLocalAsset);
+	{
+		// import_asset_batch: inline it pumps HTTP itself while the downloads run;
+		// "async":true runs download and import as job stages.
+		FAgentForgeCommandInfo Info;
+		Info.Name       = FName(TEXT("import_asset_batch"));
+		Info.Category   = TEXT("fab");
+		Info.ArgSchema  = TEXT("assets[{url|file_path, [file_name], [destination_path]}], [destination_path=/Game/FabImports], [max_concurrent=4], [chunk_mb=8], [save=true], [replace_existing=true], [timeout_seconds=600], [async=false], [frame_budget_ms=8]");
+		Info.Flags      = Bypass;
+		Info.Handler    = &FFabIntegrationModule::ImportAssetBatch;
+		Info.JobFactory = &FFabIntegrationModule::MakeImportAssetBatchJob;
+		Registry.Register(MoveTemp(Info));
+	}
+	Add(TEXT("list_imported_assets"),  TEXT("fab"), Query, TEXT("[content_path=/Game/FabImports]"), &FFabIntegrationModule::ListImportedAssets);
+	Add(TEXT("enhance_current_level"), TEXT("orchestration"), BypassManual, TEXT("description"), &Cmd_EnhanceCurrentLevel);
+
+	// ── v0.3.0 data access / semantic / closed loop ─────────────────────────
+	{
+		// get_multi_view_capture: render=true inline runs its capture job back to back;
+		// "async":true submits it so readbacks are polled between frames.
+		FAgentForgeCommandInfo Info;
+		Info.Name       = FName(TEXT("get_multi_view_capture"));
+		Info.Category   = TEXT("data_access");
+		Info.ArgSchema  = TEXT("[angle=top|front|side|tension|all], [center_x], [center_y], [center_z], [orbit_radius=3000], [render=false], [width=1280], [height=720], [fov=90], [async=false]");
+		Info.Flags      = ReadOnly;
+		Info.Handler    = &FDataAccessModule::GetMultiViewCapture;
+		Info.JobFactory = &FDataAccessModule::MakeMultiViewCaptureJob;
+		Registry.Register(MoveTemp(Info));
+	}
+	Add(TEXT("get_level_hierarchy"),       TEXT("data_access"), Query, TEXT("[encoding=json|cbor]"), &FDataAccessModule::GetLevelHierarchy);
+	Add(TEXT("get_deep_properties"),       TEXT("data_access"), Query, TEXT("label"), &FDataAccessModule::GetDeepProperties);
+	Add(TEXT("get_semantic_env_snapshot"), TEXT("data_access"), Query, TEXT("[since_revision]"), &FDataAccessModule::GetSemanticEnvironmentSnapshot);
+	Add(TEXT("place_asset_thematically"),  TEXT("semantic"), BypassSelf, TEXT("class_path, [count=3], [theme_rules{prefer_dark,prefer_corners,prefer_occluded,min_spacing}], [reference_area{x,y,z,radius}], [label_prefix]"),
+		[](const TSharedPtr<FJsonObject>& Args) { return VerifyPlaceAssetThematicallyAndAnnotate(TEXT("place_asset_thematically"), Args, FSemanticCommandModule::PlaceAssetThematically(Args)); });
+	Add(TEXT("refine_level_section"),      TEXT("semantic"), Bypass, TEXT("[description], [target_area{x,y,z,radius}], [max_iterations=3], [class_path]"), &FSemanticCommandModule::RefineLevelSection);
+	Add(TEXT("apply_genre_rules"),         TEXT("semantic"), BypassSelf, TEXT("genre(horror|dark|thriller|neutral), [intensity=1.0]"),
+		[](const TSharedPtr<FJsonObject>& Args) { return VerifyApplyGenreRulesAndAnnotate(TEXT("apply_genre_rules"), Args); });
+	Add(TEXT("create_in_editor_asset"),    TEXT("semantic"), Bypass, TEXT("type, description"), &FSemanticCommandModule::CreateInEditorAsset);
+	Add(TEXT("observe_analyze_plan_act"),  TEXT("orchestration"), BypassManual, TEXT("description, [max_iterations=1], [score_target=60]"), &Cmd_ObserveAnalyzePlanAct);
+	AddAsync(TEXT("enhance_horror_scene"), TEXT("orchestration"), BypassManual, TEXT("description, [intensity=1.0], [prop_count=5]"), &MakeEnhanceHorrorSceneJob);
+
+	// ── v0.4.0 presets + five-phase pipeline ────────────────────────────────
+	Add(TEXT("load_preset"),        TEXT("presets"), ReadOnly, TEXT("preset_name"),
+		[](const TSharedPtr<FJsonObject>& Args) { return VerifyPresetStateAndAnnotate(TEXT("load_preset"), Args, FLevelPresetSystem::LoadPreset(Args)); });
+	Add(TEXT("save_preset"),        TEXT("presets"), ReadOnly, TEXT("preset_name, [preset fields]"),
+		[](const TSharedPtr<FJsonObject>& Args) { return VerifyPresetStateAndAnnotate(TEXT("save_preset"), Args, FLevelPresetSystem::SavePreset(Args)); });
+	Add(TEXT("list_presets"),       TEXT("presets"), Query, TEXT(""), NoArgs(&FLevelPresetSystem::ListPresets));
+	Add(TEXT("suggest_preset"),     TEXT("presets"), ReadOnly, TEXT(""), NoArgs(&FLevelPresetSystem::SuggestPresetForProject));
+	Add(TEXT("get_current_preset"), TEXT("presets"), Query, TEXT(""), NoArgs(&FLevelPresetSystem::GetCurrentPreset));
+
+	AddAsync(TEXT("create_blockout_level"),  TEXT("pipeline"), BypassSelf, TEXT("[mission], [preset], [room_count], [grid_size], [layout], [seed]"), &FLevelPipelineModule::MakeCreateBlockoutLevelJob,
+		[](const TSharedPtr<FJsonObject>& Args, const FString& Raw) { return VerifyCreateBlockoutLevelAndAnnotate(TEXT("create_blockout_level"), Args, Raw); });
+	AddAsync(TEXT("convert_to_whitebox_modular"), TEXT("pipeline"), Bypass, TEXT("[kit_path], [snap_grid]"), &FLevelPipelineModule::MakeConvertToWhiteboxModularJob);
+	Add(TEXT("apply_set_dressing"),          TEXT("pipeline"), BypassSelf, TEXT("[story_theme], [prop_density], [output=actors|instances]"),
+		[](const TSharedPtr<FJsonObject>& Args) { return VerifyApplySetDressingAndAnnotate(TEXT("apply_set_dressing"), Args, FLevelPipelineModule::ApplySetDressingAndStorytelling(Args)); });
+	Add(TEXT("apply_professional_lighting"), TEXT("pipeline"), BypassSelf, TEXT("[time_of_day], [mood]"),
+		[](const TSharedPtr<FJsonObject>& Args) { return VerifyApplyProfessionalLightingAndAnnotate(TEXT("apply_professional_lighting"), Args, FLevelPipelineModule::ApplyProfessionalLightingAndAtmosphere(Args)); });
+	Add(TEXT("add_living_systems"),          TEXT("pipeline"), Bypass, TEXT("[ambient_vfx], [soundscape]"), &FLevelPipelineModule::AddLivingSystemsAndPolish);
+	AddAsync(TEXT("generate_full_quality_level"), TEXT("pipeline"), Bypass, TEXT("[mission], [preset], [max_iterations], [quality_threshold], [room_count], [grid_size], [time_of_day], [mood], [ambient_vfx], [soundscape], [kit_path], [save_level], [prop_output=actors|instances]"), &FLevelPipelineModule::MakeGenerateFullQualityLevelJob);
+
+	// ── v0.5.0 operators ─────────────────────────────────────────────────────
+	Add(TEXT("get_procedural_capabilities"), TEXT("operators"), Query, TEXT("[include_repo_urls=true]"), &FProceduralOpsModule::GetProceduralCapabilities);
+	Add(TEXT("get_operator_policy"),         TEXT("operators"), Query, TEXT(""), NoArgs(&FProceduralOpsModule::GetOperatorPolicy));
+	Add(TEXT("set_operator_policy"),         TEXT("operators"), ReadOnly, TEXT("[operator_only], [allow_atomic_placement], [max_poi_per_call], [max_actor_delta_per_pipeline], [max_memory_used_mb], [max_spawn_points], [max_cluster_count], [max_generation_time_ms], [cache_memory_mb]"), &FProceduralOpsModule::SetOperatorPolicy);
+	Add(TEXT("clear_operator_cache"),        TEXT("operators"), ReadOnly, TEXT("[include_disk=false]"), &FProceduralOpsModule::ClearOperatorCache);
+	Add(TEXT("op_terrain_generate"),         TEXT("operators"), Operator, TEXT("[backend], [seed], [width], [height], [frequency], [amplitude], [noise_type], [octaves], [lacunarity], [gain], [warp_strength], [warp_frequency], [ridge_strength], [ridge_frequency], [ridge_octaves], [erosion_mode], [erosion_iterations], [erosion_convergence], [erosion_droplets], [erosion_radius], [erosion_lifetime], [erosion_strength], [sediment_strength], [tiled], [tile_size], [tile_blend], [heightmap_precision], [export_path], [import_path], [cache], [spawn_landscape]"), &FProceduralOpsModule::TerrainGenerate);
+	Add(TEXT("op_surface_scatter"),          TEXT("operators"), Operator, TEXT("[seed], [palette_id], [distribution_mode], [density], [bounds], [generate=true], [placement=pcg|native], [cell_size], [cull_distance], [align_to_normal], [categories[]], [distribution fields]"), &FProceduralOpsModule::SurfaceScatter);
+	Add(TEXT("op_spline_scatter"),           TEXT("operators"), Operator, TEXT("spline_points[]|control_points[], [closed_loop=false], [generate=true], [placement=pcg|native], [cell_size], [cull_distance], [align_to_normal], [categories[]], [distribution fields]"), &FProceduralOpsModule::SplineScatter);
+	Add(TEXT("op_road_layout"),              TEXT("operators"), Operator, TEXT("centerline_points[]|control_points[], [road_class_path], [road_label], [closed_loop=false], [generate=true]"), &FProceduralOpsModule::RoadLayout);
+	Add(TEXT("op_biome_layers"),             TEXT("operators"), Operator, TEXT("layers[], [generate=true]"), &FProceduralOpsModule::BiomeLayers);
+	Add(TEXT("op_stamp_poi"),                TEXT("operators"), Operator, TEXT("poi_class_paths[]|poi_class_path, anchors[]|anchor_points[], [seed], [align_to_surface], [align_to_normal], [label_prefix], [max_count]"), &FProceduralOpsModule::StampPOI);
+	AddAsync(TEXT("run_operator_pipeline"),  TEXT("operators"), Operator, TEXT("[seed], [palette_id], [stages...], [stop_on_error=true], [max_actor_delta], [max_memory_used_mb], [max_generation_time_ms], [allow_menu_level], [undo_mode=full|snapshot|none]"), &FProceduralOpsModule::MakeOperatorPipelineJob);
+	Add(TEXT("undo_operator_pipeline"),      TEXT("operators"), Bypass,   TEXT("[pipeline_id]"), &FProceduralOpsModule::UndoOperatorPipeline);
+
+	UE_LOG(LogTemp, Log, TEXT("[UEAgentForge] Command registry built: %d commands."), Registry.Num());
+#endif
+}
+
+// ============================================================================
+//  ASYNC JOB SUBMISSION
+// ============================================================================
+FString UAgentForgeLibrary::SubmitCommandJob(const FAgentForgeCommandInfo& Info, const FString& Cmd, const TSharedPtr<FJsonObject>& Args)
+{
+#if WITH_EDITOR
+	FAgentForgeJobManager& Jobs = FAgentForgeJobManager::Get();
+
+	// Jobs run strictly in order; cap the backlog so a runaway client cannot
+	// queue hours of editor work.
+	if (Jobs.NumPendingJobs() >= FAgentForgeJobManager::MaxPendingJobs)
+	{
+		return ErrorResponse(FString::Printf(TEXT("Job queue full (%d pending)."), Jobs.NumPendingJobs()));
+	}
+
+	double BudgetMs = FAgentForgeJobManager::DefaultFrameBudgetMs;
+	Args->TryGetNumberField(TEXT("frame_budget_ms"), BudgetMs);
+	BudgetMs = FMath::Clamp(BudgetMs, 1.0, 100.0);
+
+	TSharedRef<FAgentForgeJob> Job = Info.JobFactory(Args);
+	if (Info.HasFlag(EAgentForgeCommandFlags::FinalizeResponse))
+	{
+		Job->AddResultFilter([Cmd](const FString& Raw) { return AnnotateResponseWithVerificationMetadata(Raw, Cmd); });
+	}
+	const FString JobId = Jobs.Submit(Job, static_cast<float>(BudgetMs));
+
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetBoolField  (TEXT("ok"),              true);
+	Obj->SetStringField(TEXT("job_id"),          JobId);
+	Obj->SetStringField(TEXT("cmd"),             Cmd);
+	Obj->SetStringField(TEXT("state"),           FAgentForgeJob::StateToString(Job->GetState()));
+	Obj->SetNumberField(TEXT("frame_budget_ms"), BudgetMs);
+	Obj->SetNumberField(TEXT("pending_jobs"),    Jobs.NumPendingJobs());
+	return ToJsonString(Obj);
+#else
+	return ErrorResponse(TEXT("UEAgentForge requires WITH_EDITOR."));
+#endif
+}
+
 // ============================================================================
 //  BLUEPRINT CALLABLE ENTRY POINTS
 // ============================================================================
@@ -3264,196 +3761,223 @@ FString UAgentForgeLibrary::ExecuteCommandJson(const FString& RequestJson)
 
 	if (!IsInGameThread())
 	{
-		FString Result;
-		FEvent* DoneEvent = FPlatformProcess::GetSynchEventFromPool(true);
-		AsyncTask(ENamedThreads::GameThread, [RequestJson, &Result, DoneEvent]()
+		// Off-thread callers join the per-tick command queue and wait on the
+		// future; the game thread drains it once per frame under a budget.
+		TFuture<FString> Future = FAgentForgeCommandQueue::Get().Enqueue(RequestJson);
+		while (!Future.WaitFor(FTimespan::FromMilliseconds(100.0)))
 		{
-			Result = UAgentForgeLibrary::ExecuteCommandJson(RequestJson);
-			DoneEvent->Trigger();
-		});
-
-		DoneEvent->Wait();
-		FPlatformProcess::ReturnSynchEventToPool(DoneEvent);
-		return Result;
+			if (IsEngineShuttingDown() && !FAgentForgeCommandQueue::Get().IsAcceptingRequests())
+			{
+				return ErrorResponse(TEXT("Engine shutdown in progress; command rejected."));
+			}
+		}
+		return Future.Get();
 	}
 
+	const double ParseStartSeconds = FPlatformTime::Seconds();
 	TSharedPtr<FJsonObject> Root;
 	FString ParseErr;
 	if (!ParseJsonObject(RequestJson, Root, ParseErr))
 	{
 		return ErrorResponse(FString::Printf(TEXT("Invalid JSON: %s"), *ParseErr));
 	}
+	return ExecuteParsedCommandJson(RequestJson, Root, (FPlatformTime::Seconds() - ParseStartSeconds) * 1000.0);
+#else
+	return ErrorResponse(TEXT("UEAgentForge requires WITH_EDITOR."));
+#endif
+}
+
+FString UAgentForgeLibrary::ExecuteParsedCommandJson(const FString& RequestJson, const TSharedPtr<FJsonObject>& Root, double ParseMs)
+{
+#if WITH_EDITOR
+	check(IsInGameThread());
+	if (IsEngineShuttingDown())
+	{
+		return ErrorResponse(TEXT("Engine shutdown in progress; command rejected."));
+	}
+	if (!Root.IsValid())
+	{
+		return ErrorResponse(TEXT("Invalid JSON: request was not parsed."));
+	}
+
+	// Only the outermost call is traced; execute_python may re-enter the bridge.
+	FAgentForgeCommandTrace::FCallScope TraceCall;
+
+	const double QueueWaitMs = FAgentForgeCommandProfile::TakePendingWaitMs();
+	// The "timings" total counts the parse even when the caller did it.
+	const double ParseStartSeconds = FPlatformTime::Seconds() - ParseMs / 1000.0;
+
+	// Client request id, echoed first in every response from here on
+	// (AgentForgeRequestEnvelope.h).
+	const FString RequestIdJson = FAgentForgeRequestEnvelope::ReadRequestId(Root);
 
 	FString Cmd;
 	if (!Root->TryGetStringField(TEXT("cmd"), Cmd) || Cmd.IsEmpty())
 	{
-		return ErrorResponse(TEXT("Missing 'cmd' field."));
+		return FAgentForgeRequestEnvelope::StampRequestId(ErrorResponse(TEXT("Missing 'cmd' field.")), RequestIdJson);
 	}
 	Cmd.ToLowerInline();
 
-	const bool bOperatorHeavyCommand =
-		Cmd == TEXT("run_operator_pipeline") ||
-		Cmd == TEXT("op_terrain_generate") ||
-		Cmd == TEXT("op_surface_scatter") ||
-		Cmd == TEXT("op_spline_scatter") ||
-		Cmd == TEXT("op_road_layout") ||
-		Cmd == TEXT("op_biome_layers") ||
-		Cmd == TEXT("op_stamp_poi");
+	if (FAgentForgeCommandRegistry::Get().IsEmpty())
+	{
+		RegisterBuiltinCommands();
+	}
+	const FAgentForgeCommandInfo* Info = FAgentForgeCommandRegistry::Get().Find(Cmd);
+	if (!Info)
+	{
+		return FAgentForgeRequestEnvelope::StampRequestId(ErrorResponse(FString::Printf(TEXT("Unknown command: %s"), *Cmd)), RequestIdJson);
+	}
 
-	const bool bDirectPlacementCommand =
-		Cmd == TEXT("spawn_actor") ||
-		Cmd == TEXT("set_actor_transform") ||
-		Cmd == TEXT("delete_actor");
+	// idempotency_key: a retried mutation or job submission gets the stored
+	// response instead of running twice. Read-only commands simply run again.
+	FString IdempotencyKey;
+	uint32 IdempotencyHash = 0;
+	if (Root->TryGetStringField(TEXT("idempotency_key"), IdempotencyKey) && !IdempotencyKey.IsEmpty())
+	{
+		if (IdempotencyKey.Len() > FAgentForgeRequestEnvelope::MaxIdempotencyKeyLen)
+		{
+			return FAgentForgeRequestEnvelope::StampRequestId(ErrorResponse(FString::Printf(
+				TEXT("idempotency_key is longer than %d characters."), FAgentForgeRequestEnvelope::MaxIdempotencyKeyLen)), RequestIdJson);
+		}
+		const TSharedPtr<FJsonObject>* KeyArgs = nullptr;
+		const bool bKeyArgs = Root->TryGetObjectField(TEXT("args"), KeyArgs);
+		bool bAsyncRequest = false;
+		if (bKeyArgs)
+		{
+			(*KeyArgs)->TryGetBoolField(TEXT("async"), bAsyncRequest);
+		}
+		if (Info->IsMutating() || Info->HasFlag(EAgentForgeCommandFlags::Bypass | EAgentForgeCommandFlags::SelfTransacting) || bAsyncRequest)
+		{
+			IdempotencyHash = FAgentForgeRequestEnvelope::HashBody(Cmd, bKeyArgs ? *KeyArgs : nullptr);
+			FString StoredResponse;
+			if (FAgentForgeRequestEnvelope::Get().Lookup(IdempotencyKey, IdempotencyHash, StoredResponse)
+				!= FAgentForgeRequestEnvelope::ELookup::Miss)
+			{
+				return FAgentForgeRequestEnvelope::StampRequestId(StoredResponse, RequestIdJson);
+			}
+		}
+		else
+		{
+			IdempotencyKey.Reset();
+		}
+	}
 
-	if (bDirectPlacementCommand && FProceduralOpsModule::IsOperatorOnlyMode())
+	// args.profile: collect a stage breakdown and attach it as "timings"
+	// (AgentForgeCommandProfile.h).
+	TUniquePtr<FAgentForgeCommandProfile> Profile;
+	const TSharedPtr<FJsonObject>* ProfileArgs = nullptr;
+	bool bProfile = false;
+	if (Root->TryGetObjectField(TEXT("args"), ProfileArgs) && (*ProfileArgs)->TryGetBoolField(TEXT("profile"), bProfile) && bProfile)
 	{
-		return ErrorResponse(TEXT("Operator-only mode blocks direct actor placement. Use op_* commands or run_operator_pipeline."));
+		Profile = MakeUnique<FAgentForgeCommandProfile>();
+		Profile->SetQueueWaitMs(QueueWaitMs);
+		Profile->SetParseMs(ParseMs);
 	}
 
-	if (Cmd == TEXT("execute_python") || IsMutatingCommand(Cmd) || bOperatorHeavyCommand)
+	// Recorded with the world revision around the call; see AgentForgeCommandTrace.h.
+	FAgentForgeCommandTrace& CommandTrace = FAgentForgeCommandTrace::Get();
+	const bool bRecordTrace = CommandTrace.IsRecording() && TraceCall.IsOutermost();
+	const int64 RevisionBefore = bRecordTrace ? FAgentForgeActorIndex::Get().GetRevision() : 0;
+
+	// Timed and traced from lookup to response; see AgentForgeCommandMetrics.h.
+	AGENTFORGE_TRACE_SCOPE_TEXT(*Cmd);
+	const double StartSeconds = FPlatformTime::Seconds();
+	FAgentForgeMemorySample MemoryBefore;   // set for guarded commands that run inline
+	auto Dispatch = [&]() -> FString
 	{
-		float UsedPct = 0.0f;
-		float AvailableMB = 0.0f;
-		if (IsLowMemory(UsedPct, AvailableMB))
+		if (Info->IsDirectPlacement() && FProceduralOpsModule::IsOperatorOnlyMode())
+		{
+			return ErrorResponse(TEXT("Operator-only mode blocks direct actor placement. Use op_* commands or run_operator_pipeline."));
+		}
+
+		// Sampled pressure with hysteresis; any GC it asks for runs between
+		// commands (AgentForgeMemoryMonitor.h).
+		FAgentForgeMemorySample GuardSample;
+		if (Info->RequiresMemoryGuard())
 		{
-			CollectGarbage(RF_NoFlags, true);
-			if (IsLowMemory(UsedPct, AvailableMB))
+			const FAgentForgeMemoryVerdict Memory = FAgentForgeMemoryMonitor::Get().Check(Cmd);
+			if (!Memory.bAllowed)
 			{
-				return ErrorResponse(FString::Printf(
-					TEXT("Memory guard triggered: available memory %.0f MB, used %.1f%%. Aborting %s to prevent OOM."),
-					AvailableMB, UsedPct, *Cmd));
+				return ErrorResponse(Memory.Error);
 			}
+			GuardSample = Memory.Sample;
 		}
-	}
 
-	TSharedPtr<FJsonObject> Args = MakeShared<FJsonObject>();
-	const TSharedPtr<FJsonObject>* ArgsPtr;
-	if (Root->TryGetObjectField(TEXT("args"), ArgsPtr))
+		TSharedPtr<FJsonObject> Args = MakeShared<FJsonObject>();
+		const TSharedPtr<FJsonObject>* ArgsPtr;
+		if (Root->TryGetObjectField(TEXT("args"), ArgsPtr))
+		{
+			Args = *ArgsPtr;
+		}
+
+		// Long-running commands can be submitted as time-sliced jobs.
+		bool bAsync = false;
+		Args->TryGetBoolField(TEXT("async"), bAsync);
+		if (bAsync)
+		{
+			if (!Info->SupportsAsync())
+			{
+				return ErrorResponse(FString::Printf(TEXT("Command '%s' does not support async execution."), *Cmd));
+			}
+			return SubmitCommandJob(*Info, Cmd, Args);
+		}
+		MemoryBefore = GuardSample;
+
+		// A running job may hold an open transaction and expects the world to stay
+		// put between slices; only read-only commands run alongside it.
+		// execute_batch applies the same rule to its entries, so a batch of
+		// queries still runs while a job is pending.
+		const bool bCommandMutates = Info->IsMutating() || Info->HasFlag(EAgentForgeCommandFlags::Bypass);
+		if (bCommandMutates && FAgentForgeJobManager::Get().HasPendingJobs())
+		{
+			return ErrorResponse(FString::Printf(
+				TEXT("%d job(s) pending; '%s' mutates the level and is blocked until they finish. Poll get_job_status or cancel_job."),
+				FAgentForgeJobManager::Get().NumPendingJobs(), *Cmd));
+		}
+
+		// Mutating commands run inside a full safe transaction with verification.
+		if (Info->IsMutating())
+		{
+			FString Result;
+			RunSafeTransaction(*Info, Cmd, Args, Result);
+			return AnnotateResponseWithVerificationMetadata(Result, Cmd);
+		}
+
+		// Everything else routes directly. Bypass commands (execute_python, pipelines,
+		// op_*) get verification metadata attached; commands with their own
+		// Verify*AndAnnotate wrapper annotate inside the registered handler.
+		const FString Response = Info->Handler(Args);
+		return Info->HasFlag(EAgentForgeCommandFlags::FinalizeResponse)
+			? AnnotateResponseWithVerificationMetadata(Response, Cmd)
+			: Response;
+	};
+	FString Response = Dispatch();
+	const double EndSeconds = FPlatformTime::Seconds();
+	if (MemoryBefore.Sequence != 0)
 	{
-		Args = *ArgsPtr;
+		FAgentForgeMemoryMonitor::Get().RecordCost(Cmd, MemoryBefore);
 	}
 
-	auto FinalizeCommandResponse = [&](const FString& RawResponse) -> FString
+	const bool bError = FAgentForgeRequestEnvelope::IsErrorResponse(Response);
+	if (!IdempotencyKey.IsEmpty() && !bError)
 	{
-		return AnnotateResponseWithVerificationMetadata(RawResponse, Cmd);
-	};
-
-	// execute_python bypasses ExecuteSafeTransaction — Python scripts may perform
-	// non-undoable operations (new_level, load_level, file I/O) that break rollback
-	// verification. Route directly so the script runs once without a test phase.
-	if (Cmd == TEXT("execute_python"))        { return FinalizeCommandResponse(Cmd_ExecutePython(Args)); }
-	// set_bt_blackboard bypasses Python CPF_Protected restriction on BehaviorTree::BlackboardAsset
-	if (Cmd == TEXT("set_bt_blackboard"))     { return FinalizeCommandResponse(Cmd_SetBtBlackboard(Args)); }
-
-	// Mutating commands run inside a full safe transaction with verification.
-	if (IsMutatingCommand(Cmd))
-	{
-		FString Result;
-		ExecuteSafeTransaction(RequestJson, Result);
-		return FinalizeCommandResponse(Result);
-	}
-
-	// Read-only / meta commands route directly.
-	if (Cmd == TEXT("ping"))                  { return Cmd_Ping(Args); }
-	if (Cmd == TEXT("get_all_level_actors"))  { return Cmd_GetAllLevelActors(); }
-	if (Cmd == TEXT("get_actor_components"))  { return Cmd_GetActorComponents(Args); }
-	if (Cmd == TEXT("get_current_level"))     { return Cmd_GetCurrentLevel(); }
-	if (Cmd == TEXT("assert_current_level"))  { return Cmd_AssertCurrentLevel(Args); }
-	if (Cmd == TEXT("get_actor_bounds"))      { return Cmd_GetActorBounds(Args); }
-	if (Cmd == TEXT("get_world_context"))     { return Cmd_GetWorldContext(Args); }
-	if (Cmd == TEXT("get_available_meshes"))  { return Cmd_GetAvailableMeshes(Args); }
-	if (Cmd == TEXT("get_available_materials")) { return Cmd_GetAvailableMaterials(Args); }
-	if (Cmd == TEXT("get_available_blueprints")) { return Cmd_GetAvailableBlueprints(Args); }
-	if (Cmd == TEXT("get_available_textures")) { return Cmd_GetAvailableTextures(Args); }
-	if (Cmd == TEXT("get_available_sounds")) { return Cmd_GetAvailableSounds(Args); }
-	if (Cmd == TEXT("get_asset_details"))    { return Cmd_GetAssetDetails(Args); }
-	if (Cmd == TEXT("focus_viewport_on_actor")) { return Cmd_FocusViewportOnActor(Args); }
-	if (Cmd == TEXT("get_viewport_info"))    { return Cmd_GetViewportInfo(); }
-	if (Cmd == TEXT("get_actor_property"))   { return Cmd_GetActorProperty(Args); }
-	if (Cmd == TEXT("cast_ray"))              { return Cmd_CastRay(Args); }
-	if (Cmd == TEXT("query_navmesh"))         { return Cmd_QueryNavMesh(Args); }
-	if (Cmd == TEXT("begin_transaction"))     { return Cmd_BeginTransaction(Args); }
-	if (Cmd == TEXT("end_transaction"))       { return Cmd_EndTransaction(); }
-	if (Cmd == TEXT("undo_transaction"))      { return Cmd_UndoTransaction(); }
-	if (Cmd == TEXT("create_snapshot"))       { return Cmd_CreateSnapshot(Args); }
-	if (Cmd == TEXT("get_perf_stats"))        { return Cmd_GetPerfStats(); }
-	if (Cmd == TEXT("save_current_level"))    { return Cmd_SaveCurrentLevel(); }
-	if (Cmd == TEXT("take_screenshot"))       { return Cmd_TakeScreenshot(Args); }
-	if (Cmd == TEXT("run_verification"))      { return Cmd_RunVerification(Args); }
-	if (Cmd == TEXT("enforce_constitution"))  { return Cmd_EnforceConstitution(Args); }
-	if (Cmd == TEXT("get_forge_status"))      { return Cmd_GetForgeStatus(); }
-	if (Cmd == TEXT("llm_chat"))              { return Cmd_LLMChat(Args); }
-	if (Cmd == TEXT("llm_stream"))            { return Cmd_LLMStream(Args); }
-	if (Cmd == TEXT("llm_structured"))        { return Cmd_LLMStructured(Args); }
-	if (Cmd == TEXT("llm_set_key"))           { return Cmd_LLMSetKey(Args); }
-	if (Cmd == TEXT("llm_get_models"))        { return Cmd_LLMGetModels(Args); }
-	if (Cmd == TEXT("vision_analyze"))        { return Cmd_VisionAnalyze(Args); }
-	if (Cmd == TEXT("vision_quality_score"))  { return Cmd_VisionQualityScore(Args); }
-	if (Cmd == TEXT("set_viewport_camera"))   { return Cmd_SetViewportCamera(Args); }
-	if (Cmd == TEXT("redraw_viewports"))      { return Cmd_RedrawViewports(); }
-	// wire_aicontroller_bt: creates BeginPlay→RunBehaviorTree in an AIController Blueprint
-	if (Cmd == TEXT("wire_aicontroller_bt"))  { return FinalizeCommandResponse(Cmd_WireAIControllerBT(Args)); }
-	// setup_flashlight_scs: adds/configures Movable SpotLight SCS node in a Blueprint
-	if (Cmd == TEXT("setup_flashlight_scs"))  { return FinalizeCommandResponse(Cmd_SetupFlashlightSCS(Args)); }
-
-	// ── v0.2.0 Spatial Intelligence Layer ────────────────────────────────────
-	if (Cmd == TEXT("spawn_actor_at_surface"))   { return FinalizeCommandResponse(FSpatialControlModule::SpawnActorAtSurface(Args)); }
-	if (Cmd == TEXT("align_actors_to_surface"))  { return FinalizeCommandResponse(FSpatialControlModule::AlignActorsToSurface(Args)); }
-	if (Cmd == TEXT("get_surface_normal_at"))    { return FSpatialControlModule::GetSurfaceNormalAt(Args); }
-	if (Cmd == TEXT("analyze_level_composition")){ return FSpatialControlModule::AnalyzeLevelComposition(); }
-	if (Cmd == TEXT("get_actors_in_radius"))     { return FSpatialControlModule::GetActorsInRadius(Args); }
-
-	// ── v0.2.0 FAB Integration ────────────────────────────────────────────────
-	if (Cmd == TEXT("search_fab_assets"))        { return FFabIntegrationModule::SearchFabAssets(Args); }
-	if (Cmd == TEXT("download_fab_asset"))       { return FFabIntegrationModule::DownloadFabAsset(Args); }
-	if (Cmd == TEXT("import_local_asset"))       { return FinalizeCommandResponse(FFabIntegrationModule::ImportLocalAsset(Args)); }
-	if (Cmd == TEXT("list_imported_assets"))     { return FFabIntegrationModule::ListImportedAssets(Args); }
-
-	// ── v0.2.0 Unified Orchestration ─────────────────────────────────────────
-	if (Cmd == TEXT("enhance_current_level"))    { return FinalizeCommandResponse(Cmd_EnhanceCurrentLevel(Args)); }
-
-	// ── v0.3.0 Rich Multi-Modal Data Access ──────────────────────────────────
-	if (Cmd == TEXT("get_multi_view_capture"))         { return FDataAccessModule::GetMultiViewCapture(Args); }
-	if (Cmd == TEXT("get_level_hierarchy"))            { return FDataAccessModule::GetLevelHierarchy(); }
-	if (Cmd == TEXT("get_deep_properties"))            { return FDataAccessModule::GetDeepProperties(Args); }
-	if (Cmd == TEXT("get_semantic_env_snapshot"))      { return FDataAccessModule::GetSemanticEnvironmentSnapshot(); }
-
-	// ── v0.3.0 Advanced Semantic Commands ────────────────────────────────────
-	if (Cmd == TEXT("place_asset_thematically"))  { return VerifyPlaceAssetThematicallyAndAnnotate(Cmd, Args, FSemanticCommandModule::PlaceAssetThematically(Args)); }
-	if (Cmd == TEXT("refine_level_section"))      { return FinalizeCommandResponse(FSemanticCommandModule::RefineLevelSection(Args)); }
-	if (Cmd == TEXT("apply_genre_rules"))         { return VerifyApplyGenreRulesAndAnnotate(Cmd, Args); }
-	if (Cmd == TEXT("create_in_editor_asset"))    { return FinalizeCommandResponse(FSemanticCommandModule::CreateInEditorAsset(Args)); }
-
-	// ── v0.3.0 Closed-Loop Reasoning & Horror Orchestration ──────────────────
-	if (Cmd == TEXT("observe_analyze_plan_act"))  { return FinalizeCommandResponse(Cmd_ObserveAnalyzePlanAct(Args)); }
-	if (Cmd == TEXT("enhance_horror_scene"))      { return FinalizeCommandResponse(Cmd_EnhanceHorrorScene(Args)); }
-
-	// ── v0.4.0 Level Preset System ────────────────────────────────────────────
-	if (Cmd == TEXT("load_preset"))              { return VerifyPresetStateAndAnnotate(Cmd, Args, FLevelPresetSystem::LoadPreset(Args)); }
-	if (Cmd == TEXT("save_preset"))              { return VerifyPresetStateAndAnnotate(Cmd, Args, FLevelPresetSystem::SavePreset(Args)); }
-	if (Cmd == TEXT("list_presets"))             { return FLevelPresetSystem::ListPresets(); }
-	if (Cmd == TEXT("suggest_preset"))           { return FLevelPresetSystem::SuggestPresetForProject(); }
-	if (Cmd == TEXT("get_current_preset"))       { return FLevelPresetSystem::GetCurrentPreset(); }
-
-	// ── v0.4.0 Five-Phase AAA Level Pipeline ─────────────────────────────────
-	if (Cmd == TEXT("create_blockout_level"))         { return VerifyCreateBlockoutLevelAndAnnotate(Cmd, Args, FLevelPipelineModule::CreateBlockoutLevel(Args)); }
-	if (Cmd == TEXT("convert_to_whitebox_modular"))   { return FinalizeCommandResponse(FLevelPipelineModule::ConvertToWhiteboxModular(Args)); }
-	if (Cmd == TEXT("apply_set_dressing"))            { return VerifyApplySetDressingAndAnnotate(Cmd, Args, FLevelPipelineModule::ApplySetDressingAndStorytelling(Args)); }
-	if (Cmd == TEXT("apply_professional_lighting"))   { return VerifyApplyProfessionalLightingAndAnnotate(Cmd, Args, FLevelPipelineModule::ApplyProfessionalLightingAndAtmosphere(Args)); }
-	if (Cmd == TEXT("add_living_systems"))            { return FinalizeCommandResponse(FLevelPipelineModule::AddLivingSystemsAndPolish(Args)); }
-	if (Cmd == TEXT("generate_full_quality_level"))   { return FinalizeCommandResponse(FLevelPipelineModule::GenerateFullQualityLevel(Args)); }
-	if (Cmd == TEXT("get_procedural_capabilities"))   { return FProceduralOpsModule::GetProceduralCapabilities(Args); }
-	if (Cmd == TEXT("get_operator_policy"))           { return FProceduralOpsModule::GetOperatorPolicy(); }
-	if (Cmd == TEXT("set_operator_policy"))           { return FProceduralOpsModule::SetOperatorPolicy(Args); }
-	if (Cmd == TEXT("op_terrain_generate"))           { return FinalizeCommandResponse(FProceduralOpsModule::TerrainGenerate(Args)); }
-	if (Cmd == TEXT("op_surface_scatter"))            { return FinalizeCommandResponse(FProceduralOpsModule::SurfaceScatter(Args)); }
-	if (Cmd == TEXT("op_spline_scatter"))             { return FinalizeCommandResponse(FProceduralOpsModule::SplineScatter(Args)); }
-	if (Cmd == TEXT("op_road_layout"))                { return FinalizeCommandResponse(FProceduralOpsModule::RoadLayout(Args)); }
-	if (Cmd == TEXT("op_biome_layers"))               { return FinalizeCommandResponse(FProceduralOpsModule::BiomeLayers(Args)); }
-	if (Cmd == TEXT("op_stamp_poi"))                  { return FinalizeCommandResponse(FProceduralOpsModule::StampPOI(Args)); }
-	if (Cmd == TEXT("run_operator_pipeline"))         { return FinalizeCommandResponse(FProceduralOpsModule::RunOperatorPipeline(Args)); }
-
-	return ErrorResponse(FString::Printf(TEXT("Unknown command: %s"), *Cmd));
+		FAgentForgeRequestEnvelope::Get().Remember(IdempotencyKey, IdempotencyHash, Response);
+	}
+	if (Profile.IsValid())
+	{
+		Profile->SetHandlerMs((EndSeconds - StartSeconds) * 1000.0);
+		Response = FAgentForgeCommandProfile::AttachTimings(Response, Profile->ToJson((EndSeconds - ParseStartSeconds) * 1000.0));
+		Profile.Reset();
+	}
+	FAgentForgeCommandMetrics::Get().Record(Cmd, (EndSeconds - StartSeconds) * 1000.0,
+		FPlatformString::ConvertedLength<UTF8CHAR>(*RequestJson, RequestJson.Len()),
+		FPlatformString::ConvertedLength<UTF8CHAR>(*Response, Response.Len()), bError);
+	if (bRecordTrace)
+	{
+		CommandTrace.Record(Cmd, RequestJson, Response, bError, QueueWaitMs, ParseMs, (EndSeconds - StartSeconds) * 1000.0,
+			RevisionBefore, FAgentForgeActorIndex::Get().GetRevision());
+	}
+	return FAgentForgeRequestEnvelope::StampRequestId(Response, RequestIdJson);
 #else
 	return ErrorResponse(TEXT("UEAgentForge requires WITH_EDITOR."));
 #endif
@@ -3477,15 +4001,38 @@ bool UAgentForgeLibrary::ExecuteSafeTransaction(const FString& CommandJson, FStr
 	const TSharedPtr<FJsonObject>* ArgsPtr;
 	if (Root->TryGetObjectField(TEXT("args"), ArgsPtr)) { Args = *ArgsPtr; }
 
+	if (FAgentForgeCommandRegistry::Get().IsEmpty())
+	{
+		RegisterBuiltinCommands();
+	}
+	const FAgentForgeCommandInfo* Info = FAgentForgeCommandRegistry::Get().Find(Cmd);
+	if (!Info || !Info->IsMutating())
+	{
+		OutResult = ErrorResponse(FString::Printf(TEXT("Unrouted mutating command: %s"), *Cmd));
+		return false;
+	}
+	return RunSafeTransaction(*Info, Cmd, Args, OutResult);
+#else
+	OutResult = ErrorResponse(TEXT("UEAgentForge requires WITH_EDITOR."));
+	return false;
+#endif
+}
+
+bool UAgentForgeLibrary::RunSafeTransaction(const FAgentForgeCommandInfo& InInfo, const FString& Cmd, const TSharedPtr<FJsonObject>& Args, FString& OutResult)
+{
+#if WITH_EDITOR
+	const FAgentForgeCommandInfo* Info = &InInfo;
+
+	// The phases come from the command's registry flags, resolved once here.
+	const FAgentForgeVerificationPlan Plan = Info->PlanVerification();
+
 	// Phase 1: PreFlight (constitution + pre-state)
 	UVerificationEngine* VE = UVerificationEngine::Get();
 	TArray<FVerificationPhaseResult> ExecutedVerificationResults;
 	TArray<FVerificationPhaseResult> RequestedButNotRunResults;
-	const FString PreFlightActionDesc = BuildPreFlightActionDescription(Cmd);
-	const int32 VerificationPhaseMask =
-		static_cast<int32>(EVerificationPhase::PreFlight) |
-		static_cast<int32>(EVerificationPhase::Snapshot) |
-		static_cast<int32>(EVerificationPhase::PostVerify);
+	const FString PreFlightActionDesc = Info->PreFlightDescription.IsEmpty() ? Cmd : Info->PreFlightDescription;
+	// Snapshot stays requested when the plan skips it, so the report lists it as not run.
+	const int32 VerificationPhaseMask = Plan.GetPhaseMask() | static_cast<int32>(EVerificationPhase::Snapshot);
 	if (VE)
 	{
 		FVerificationPhaseResult PreFlight = VE->RunPreFlight(PreFlightActionDesc);
@@ -3509,8 +4056,8 @@ bool UAgentForgeLibrary::ExecuteSafeTransaction(const FString& CommandJson, FStr
 	// snapshot testing (e.g. Blueprint asset creation can persist objects in package
 	// memory and trigger duplicate-name assertions on the second pass). For those
 	// commands we intentionally skip Phase 2 and rely on preflight + real execution.
-	const bool bSkipSnapshotRollbackForCommand = DoesCommandSkipSnapshotRollback(Cmd);
-	const bool bUseCompensatingCleanupProbe = IsKnownRollbackLeakyCommand(Cmd);
+	const bool bSkipSnapshotRollbackForCommand = !Plan.bSnapshotRollback;
+	const bool bUseCompensatingCleanupProbe = Plan.bCompensatingCleanup;
 	bool bCompensatingCleanupUsed = false;
 	FString CompensatingCleanupDetail;
 	int32 CompensatingCleanupActorCount = 0;
@@ -3527,47 +4074,7 @@ bool UAgentForgeLibrary::ExecuteSafeTransaction(const FString& CommandJson, FStr
 			{
 				// Executes inside a temporary cancelled sub-transaction (rollback test).
 				// Changes are intentionally undone — this is the safety proof.
-				FString Dummy;
-				if (Cmd == TEXT("spawn_actor"))                  { Dummy = Cmd_SpawnActor(Args); }
-				else if (Cmd == TEXT("duplicate_actor"))        { Dummy = Cmd_DuplicateActor(Args); }
-				else if (Cmd == TEXT("spawn_point_light"))       { Dummy = Cmd_SpawnPointLight(Args); }
-				else if (Cmd == TEXT("spawn_spot_light"))        { Dummy = Cmd_SpawnSpotLight(Args); }
-				else if (Cmd == TEXT("spawn_rect_light"))        { Dummy = Cmd_SpawnRectLight(Args); }
-				else if (Cmd == TEXT("spawn_directional_light")) { Dummy = Cmd_SpawnDirectionalLight(Args); }
-				else if (Cmd == TEXT("spawn_actor_at_surface"))  { Dummy = FSpatialControlModule::SpawnActorAtSurface(Args); }
-				else if (Cmd == TEXT("align_actors_to_surface")) { Dummy = FSpatialControlModule::AlignActorsToSurface(Args); }
-				else if (Cmd == TEXT("set_actor_transform"))     { Dummy = Cmd_SetActorTransform(Args); }
-				else if (Cmd == TEXT("set_static_mesh"))         { Dummy = Cmd_SetStaticMesh(Args); }
-				else if (Cmd == TEXT("set_actor_scale"))         { Dummy = Cmd_SetActorScale(Args); }
-				else if (Cmd == TEXT("set_actor_label"))         { Dummy = Cmd_SetActorLabel(Args); }
-				else if (Cmd == TEXT("set_actor_mobility"))      { Dummy = Cmd_SetActorMobility(Args); }
-				else if (Cmd == TEXT("set_actor_visibility"))    { Dummy = Cmd_SetActorVisibility(Args); }
-				else if (Cmd == TEXT("group_actors"))            { Dummy = Cmd_GroupActors(Args); }
-				else if (Cmd == TEXT("set_actor_property"))      { Dummy = Cmd_SetActorProperty(Args); }
-				else if (Cmd == TEXT("create_wall"))             { Dummy = Cmd_CreateWall(Args); }
-				else if (Cmd == TEXT("create_floor"))            { Dummy = Cmd_CreateFloor(Args); }
-				else if (Cmd == TEXT("create_room"))             { Dummy = Cmd_CreateRoom(Args); }
-				else if (Cmd == TEXT("create_corridor"))         { Dummy = Cmd_CreateCorridor(Args); }
-				else if (Cmd == TEXT("create_staircase"))        { Dummy = Cmd_CreateStaircase(Args); }
-				else if (Cmd == TEXT("create_pillar"))           { Dummy = Cmd_CreatePillar(Args); }
-				else if (Cmd == TEXT("scatter_props"))           { Dummy = Cmd_ScatterProps(Args); }
-				else if (Cmd == TEXT("set_fog"))                 { Dummy = Cmd_SetFog(Args); }
-				else if (Cmd == TEXT("set_post_process"))        { Dummy = Cmd_SetPostProcess(Args); }
-				else if (Cmd == TEXT("set_sky_atmosphere"))      { Dummy = Cmd_SetSkyAtmosphere(Args); }
-				else if (Cmd == TEXT("delete_actor"))            { Dummy = Cmd_DeleteActor(Args); }
-				else if (Cmd == TEXT("create_blueprint"))        { Dummy = Cmd_CreateBlueprint(Args); }
-				else if (Cmd == TEXT("compile_blueprint"))       { Dummy = Cmd_CompileBlueprint(Args); }
-				else if (Cmd == TEXT("set_bp_cdo_property"))     { Dummy = Cmd_SetBlueprintCDOProperty(Args); }
-				else if (Cmd == TEXT("edit_blueprint_node"))     { Dummy = Cmd_EditBlueprintNode(Args); }
-				else if (Cmd == TEXT("create_material_instance")){ Dummy = Cmd_CreateMaterialInstance(Args); }
-				else if (Cmd == TEXT("set_material_params"))     { Dummy = Cmd_SetMaterialParams(Args); }
-				else if (Cmd == TEXT("apply_material_to_actor")) { Dummy = Cmd_ApplyMaterialToActor(Args); }
-				else if (Cmd == TEXT("set_mesh_material_color")) { Dummy = Cmd_SetMeshMaterialColor(Args); }
-				else if (Cmd == TEXT("set_material_scalar_param")) { Dummy = Cmd_SetMaterialScalarParam(Args); }
-				else if (Cmd == TEXT("rename_asset"))            { Dummy = Cmd_RenameAsset(Args); }
-				else if (Cmd == TEXT("move_asset"))              { Dummy = Cmd_MoveAsset(Args); }
-				else if (Cmd == TEXT("delete_asset"))            { Dummy = Cmd_DeleteAsset(Args); }
-				else if (Cmd == TEXT("setup_test_level"))        { Dummy = Cmd_SetupTestLevel(Args); }
+				const FString Dummy = Info->Handler(Args);
 				return !Dummy.Contains(TEXT("\"error\""));
 			},
 			Cmd);
@@ -3592,7 +4099,7 @@ bool UAgentForgeLibrary::ExecuteSafeTransaction(const FString& CommandJson, FStr
 		FVerificationPhaseResult SkipResult;
 		SkipResult.PhaseName = TEXT("Snapshot+Rollback");
 		SkipResult.Passed = false;
-		SkipResult.Detail = IsKnownRollbackLeakyCommand(Cmd)
+		SkipResult.Detail = Plan.bCompensatingCleanup
 			? TEXT("Skipped in ExecuteSafeTransaction because rollback repro leaked spawned actors for this command. Compensating cleanup probe is used instead.")
 			: TEXT("Skipped in ExecuteSafeTransaction because this command is marked not rollback-safe.");
 		SkipResult.DurationMs = 0.f;
@@ -3607,11 +4114,7 @@ bool UAgentForgeLibrary::ExecuteSafeTransaction(const FString& CommandJson, FStr
 			Cmd,
 			[&]() -> FString
 			{
-				if (Cmd == TEXT("spawn_actor_at_surface")) { return FSpatialControlModule::SpawnActorAtSurface(Args); }
-				if (Cmd == TEXT("create_floor"))           { return Cmd_CreateFloor(Args); }
-				if (Cmd == TEXT("create_room"))            { return Cmd_CreateRoom(Args); }
-				if (Cmd == TEXT("create_corridor"))        { return Cmd_CreateCorridor(Args); }
-				return ErrorResponse(FString::Printf(TEXT("Compensating cleanup probe not wired for command: %s"), *Cmd));
+				return Info->Handler(Args);
 			},
 			CleanupProbe,
 			&CompensatingCleanupActorCount,
@@ -3644,48 +4147,7 @@ bool UAgentForgeLibrary::ExecuteSafeTransaction(const FString& CommandJson, FStr
 
 	// Execute for real (the snapshot rollback lambda already ran it inside a cancelled tx;
 	// now we execute again inside the real open transaction).
-	FString CommandResult;
-	if (Cmd == TEXT("spawn_actor"))              { CommandResult = Cmd_SpawnActor(Args); }
-	else if (Cmd == TEXT("duplicate_actor"))     { CommandResult = Cmd_DuplicateActor(Args); }
-	else if (Cmd == TEXT("spawn_point_light"))   { CommandResult = Cmd_SpawnPointLight(Args); }
-	else if (Cmd == TEXT("spawn_spot_light"))    { CommandResult = Cmd_SpawnSpotLight(Args); }
-	else if (Cmd == TEXT("spawn_rect_light"))    { CommandResult = Cmd_SpawnRectLight(Args); }
-	else if (Cmd == TEXT("spawn_directional_light")) { CommandResult = Cmd_SpawnDirectionalLight(Args); }
-	else if (Cmd == TEXT("spawn_actor_at_surface")) { CommandResult = FSpatialControlModule::SpawnActorAtSurface(Args); }
-	else if (Cmd == TEXT("align_actors_to_surface")) { CommandResult = FSpatialControlModule::AlignActorsToSurface(Args); }
-	else if (Cmd == TEXT("set_actor_transform")) { CommandResult = Cmd_SetActorTransform(Args); }
-	else if (Cmd == TEXT("set_static_mesh"))     { CommandResult = Cmd_SetStaticMesh(Args); }
-	else if (Cmd == TEXT("set_actor_scale"))     { CommandResult = Cmd_SetActorScale(Args); }
-	else if (Cmd == TEXT("set_actor_label"))     { CommandResult = Cmd_SetActorLabel(Args); }
-	else if (Cmd == TEXT("set_actor_mobility"))  { CommandResult = Cmd_SetActorMobility(Args); }
-	else if (Cmd == TEXT("set_actor_visibility")) { CommandResult = Cmd_SetActorVisibility(Args); }
-	else if (Cmd == TEXT("group_actors"))        { CommandResult = Cmd_GroupActors(Args); }
-	else if (Cmd == TEXT("set_actor_property"))  { CommandResult = Cmd_SetActorProperty(Args); }
-	else if (Cmd == TEXT("create_wall"))         { CommandResult = Cmd_CreateWall(Args); }
-	else if (Cmd == TEXT("create_floor"))        { CommandResult = Cmd_CreateFloor(Args); }
-	else if (Cmd == TEXT("create_room"))         { CommandResult = Cmd_CreateRoom(Args); }
-	else if (Cmd == TEXT("create_corridor"))     { CommandResult = Cmd_CreateCorridor(Args); }
-	else if (Cmd == TEXT("create_staircase"))    { CommandResult = Cmd_CreateStaircase(Args); }
-	else if (Cmd == TEXT("create_pillar"))       { CommandResult = Cmd_CreatePillar(Args); }
-	else if (Cmd == TEXT("scatter_props"))       { CommandResult = Cmd_ScatterProps(Args); }
-	else if (Cmd == TEXT("set_fog"))             { CommandResult = Cmd_SetFog(Args); }
-	else if (Cmd == TEXT("set_post_process"))    { CommandResult = Cmd_SetPostProcess(Args); }
-	else if (Cmd == TEXT("set_sky_atmosphere"))  { CommandResult = Cmd_SetSkyAtmosphere(Args); }
-	else if (Cmd == TEXT("delete_actor"))        { CommandResult = Cmd_DeleteActor(Args); }
-	else if (Cmd == TEXT("create_blueprint"))    { CommandResult = Cmd_CreateBlueprint(Args); }
-	else if (Cmd == TEXT("compile_blueprint"))   { CommandResult = Cmd_CompileBlueprint(Args); }
-	else if (Cmd == TEXT("set_bp_cdo_property")) { CommandResult = Cmd_SetBlueprintCDOProperty(Args); }
-	else if (Cmd == TEXT("edit_blueprint_node")) { CommandResult = Cmd_EditBlueprintNode(Args); }
-	else if (Cmd == TEXT("create_material_instance")){ CommandResult = Cmd_CreateMaterialInstance(Args); }
-	else if (Cmd == TEXT("set_material_params")) { CommandResult = Cmd_SetMaterialParams(Args); }
-	else if (Cmd == TEXT("apply_material_to_actor")) { CommandResult = Cmd_ApplyMaterialToActor(Args); }
-	else if (Cmd == TEXT("set_mesh_material_color")) { CommandResult = Cmd_SetMeshMaterialColor(Args); }
-	else if (Cmd == TEXT("set_material_scalar_param")) { CommandResult = Cmd_SetMaterialScalarParam(Args); }
-	else if (Cmd == TEXT("rename_asset"))        { CommandResult = Cmd_RenameAsset(Args); }
-	else if (Cmd == TEXT("move_asset"))          { CommandResult = Cmd_MoveAsset(Args); }
-	else if (Cmd == TEXT("delete_asset"))        { CommandResult = Cmd_DeleteAsset(Args); }
-	else if (Cmd == TEXT("setup_test_level"))    { CommandResult = Cmd_SetupTestLevel(Args); }
-	else { CommandResult = ErrorResponse(FString::Printf(TEXT("Unrouted mutating command: %s"), *Cmd)); }
+	const FString CommandResult = Info->Handler(Args);
 
 	bCommandSuccess = !CommandResult.Contains(TEXT("\"error\""));
 
@@ -3742,9 +4204,22 @@ bool UAgentForgeLibrary::ExecuteSafeTransaction(const FString& CommandJson, FStr
 		}
 	}
 
+	// Phase 4: BuildCheck for commands that edit Blueprints. Cached by the dirty
+	// Blueprint set, so a repeat edit that compiles clean costs one scan. Reported,
+	// not blocking: the compile errors belong to the asset, not to this transaction.
+	if (VE && Plan.bBuildCheck)
+	{
+		FVerificationPhaseResult BuildResult = VE->RunBuildCheck();
+		ExecutedVerificationResults.Add(BuildResult);
+		if (!BuildResult.Passed)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[UEAgentForge] BuildCheck warning: %s"), *BuildResult.Detail);
+		}
+	}
+
 	if (VE)
 	{
-		const bool bHasCommandAwarePostVerify = HasCommandAwarePostVerifyContract(Cmd);
+		const bool bHasCommandAwarePostVerify = Plan.bCommandAwarePostVerify;
 		const FString FinalVerificationMode = ResolveExecutedVerificationMode(Cmd, bHasCommandAwarePostVerify);
 		bool bAllVerificationPassed = true;
 		for (const FVerificationPhaseResult& Result : ExecutedVerificationResults)
@@ -3788,6 +4263,311 @@ bool UAgentForgeLibrary::ExecuteSafeTransaction(const FString& CommandJson, FStr
 #endif
 }
 
+// ============================================================================
+//  BATCH EXECUTION
+// ============================================================================
+// execute_batch runs many {cmd,args} entries in one ExecuteCommandJson call:
+// one JSON parse, one game-thread hop, optionally one FScopedTransaction, and a
+// single PreFlight/PostVerify pass around the whole batch. Per-entry snapshot
+// rollback tests are skipped — the batch transaction is the rollback boundary.
+static constexpr int32 MaxBatchEntries = 2048;
+
+FString UAgentForgeLibrary::Cmd_ExecuteBatch(const TSharedPtr<FJsonObject>& Args)
+{
+#if WITH_EDITOR
+	const TArray<TSharedPtr<FJsonValue>>* EntriesPtr = nullptr;
+	if (!Args.IsValid() || !Args->TryGetArrayField(TEXT("commands"), EntriesPtr) || !EntriesPtr)
+	{
+		return ErrorResponse(TEXT("execute_batch requires a 'commands' array of {cmd,args} entries."));
+	}
+	if (EntriesPtr->Num() > MaxBatchEntries)
+	{
+		return ErrorResponse(FString::Printf(TEXT("execute_batch accepts at most %d entries (got %d)."), MaxBatchEntries, EntriesPtr->Num()));
+	}
+
+	bool bTransactional = true;
+	bool bStopOnError   = true;
+	bool bVerify        = true;
+	Args->TryGetBoolField(TEXT("transactional"), bTransactional);
+	Args->TryGetBoolField(TEXT("stop_on_error"), bStopOnError);
+	Args->TryGetBoolField(TEXT("verify"),        bVerify);
+
+	struct FBatchEntry
+	{
+		FString                       Cmd;
+		TSharedPtr<FJsonObject>       Args;
+		TSharedPtr<FJsonValue>        RequestId;   // echoed so clients can merge batched calls
+		const FAgentForgeCommandInfo* Info = nullptr;
+		FString                       Result;
+		bool                          bRan = false;
+		bool                          bOk  = false;
+		double                        DurationMs = 0.0;
+	};
+
+	// ── Resolve every entry up front so a bad entry fails before anything mutates.
+	const FAgentForgeCommandRegistry& Registry = FAgentForgeCommandRegistry::Get();
+	TArray<FBatchEntry> Entries;
+	Entries.Reserve(EntriesPtr->Num());
+	TArray<FString> ActionDescs;
+	for (int32 i = 0; i < EntriesPtr->Num(); ++i)
+	{
+		const TSharedPtr<FJsonObject>* EntryObj = nullptr;
+		if (!(*EntriesPtr)[i].IsValid() || !(*EntriesPtr)[i]->TryGetObject(EntryObj) || !EntryObj)
+		{
+			return ErrorResponse(FString::Printf(TEXT("commands[%d] is not an object."), i));
+		}
+
+		FBatchEntry& Entry = Entries.AddDefaulted_GetRef();
+		if (!(*EntryObj)->TryGetStringField(TEXT("cmd"), Entry.Cmd) || Entry.Cmd.IsEmpty())
+		{
+			return ErrorResponse(FString::Printf(TEXT("commands[%d] is missing 'cmd'."), i));
+		}
+		Entry.Cmd.ToLowerInline();
+
+		const TSharedPtr<FJsonObject>* EntryArgs = nullptr;
+		Entry.Args = (*EntryObj)->TryGetObjectField(TEXT("args"), EntryArgs) && EntryArgs
+			? *EntryArgs
+			: MakeShared<FJsonObject>();
+		Entry.RequestId = (*EntryObj)->TryGetField(TEXT("request_id"));
+
+		Entry.Info = Registry.Find(Entry.Cmd);
+		if (!Entry.Info)
+		{
+			return ErrorResponse(FString::Printf(TEXT("commands[%d]: unknown command '%s'."), i, *Entry.Cmd));
+		}
+		if (Entry.Info->HasFlag(EAgentForgeCommandFlags::SelfTransacting))
+		{
+			return ErrorResponse(FString::Printf(TEXT("commands[%d]: '%s' cannot be nested inside execute_batch."), i, *Entry.Cmd));
+		}
+		if (Entry.Info->IsDirectPlacement() && FProceduralOpsModule::IsOperatorOnlyMode())
+		{
+			return ErrorResponse(FString::Printf(TEXT("commands[%d]: operator-only mode blocks direct actor placement (%s)."), i, *Entry.Cmd));
+		}
+		// Bypass commands (execute_python, pipelines, op_*) may load levels or do
+		// non-undoable work, which would corrupt a shared batch transaction.
+		if (bTransactional && Entry.Info->HasFlag(EAgentForgeCommandFlags::Bypass))
+		{
+			return ErrorResponse(FString::Printf(
+				TEXT("commands[%d]: '%s' bypasses the transaction pipeline and cannot run in a transactional batch. Set transactional=false."),
+				i, *Entry.Cmd));
+		}
+		if ((Entry.Info->IsMutating() || Entry.Info->HasFlag(EAgentForgeCommandFlags::Bypass))
+			&& FAgentForgeJobManager::Get().HasPendingJobs())
+		{
+			return ErrorResponse(FString::Printf(
+				TEXT("commands[%d]: %d job(s) pending; '%s' mutates the level and is blocked until they finish. Poll get_job_status or cancel_job."),
+				i, FAgentForgeJobManager::Get().NumPendingJobs(), *Entry.Cmd));
+		}
+		if (Entry.Info->IsMutating())
+		{
+			ActionDescs.AddUnique(BuildPreFlightActionDescription(Entry.Cmd));
+		}
+	}
+
+	UVerificationEngine* VE = bVerify ? UVerificationEngine::Get() : nullptr;
+	TArray<FVerificationPhaseResult> ExecutedVerificationResults;
+	TArray<FVerificationPhaseResult> RequestedButNotRunResults;
+	const int32 VerificationPhaseMask =
+		static_cast<int32>(EVerificationPhase::PreFlight) |
+		static_cast<int32>(EVerificationPhase::PostVerify);
+
+	// ── Phase 1: one PreFlight for the whole batch (constitution + pre-state).
+	if (VE)
+	{
+		const FString PreFlightActionDesc = ActionDescs.IsEmpty()
+			? FString(TEXT("execute_batch"))
+			: FString::Join(ActionDescs, TEXT("; "));
+		FVerificationPhaseResult PreFlight = VE->RunPreFlight(PreFlightActionDesc);
+		ExecutedVerificationResults.Add(PreFlight);
+		if (!PreFlight.Passed)
+		{
+			VE->LastVerificationResult = SerializeVerificationSummaryJson(
+				TEXT("execute_batch"), VerificationPhaseMask, false,
+				ExecutedVerificationResults, RequestedButNotRunResults, TEXT("batch_partial_no_snapshot"));
+			return ErrorResponse(FString::Printf(TEXT("PreFlight FAILED: %s"), *PreFlight.Detail));
+		}
+
+		FVerificationPhaseResult SkipResult;
+		SkipResult.PhaseName = TEXT("Snapshot+Rollback");
+		SkipResult.Passed = false;
+		SkipResult.Detail = TEXT("Skipped for execute_batch; the batch transaction is the rollback boundary.");
+		RequestedButNotRunResults.Add(SkipResult);
+	}
+
+	// ── Execute every entry in this single game-thread visit.
+	const double BatchStart = FPlatformTime::Seconds();
+	TUniquePtr<FScopedTransaction> BatchTransaction;
+	if (bTransactional)
+	{
+		BatchTransaction = MakeUnique<FScopedTransaction>(FText::FromString(
+			FString::Printf(TEXT("AgentForge: execute_batch (%d commands)"), Entries.Num())));
+	}
+
+	int32 Succeeded = 0;
+	int32 Failed = 0;
+	int32 ExpectedActorDelta = 0;
+	for (FBatchEntry& Entry : Entries)
+	{
+		const double EntryStart = FPlatformTime::Seconds();
+		if (!bTransactional && Entry.Info->IsMutating())
+		{
+			// Non-transactional batches still keep each mutation individually undoable.
+			FScopedTransaction EntryTransaction(FText::FromString(FString::Printf(TEXT("AgentForge: %s"), *Entry.Cmd)));
+			Entry.Result = Entry.Info->Handler(Entry.Args);
+			if (Entry.Result.Contains(TEXT("\"error\"")))
+			{
+				EntryTransaction.Cancel();
+			}
+		}
+		else
+		{
+			Entry.Result = Entry.Info->Handler(Entry.Args);
+		}
+		if (Entry.Info->HasFlag(EAgentForgeCommandFlags::FinalizeResponse))
+		{
+			Entry.Result = AnnotateResponseWithVerificationMetadata(Entry.Result, Entry.Cmd);
+		}
+		Entry.DurationMs = (FPlatformTime::Seconds() - EntryStart) * 1000.0;
+		Entry.bRan = true;
+		Entry.bOk = !Entry.Result.Contains(TEXT("\"error\""));
+
+		if (Entry.bOk)
+		{
+			++Succeeded;
+			if (Entry.Info->IsMutating())
+			{
+				ExpectedActorDelta += DetermineExpectedActorDelta(Entry.Cmd, Entry.Result);
+			}
+		}
+		else
+		{
+			++Failed;
+			if (bStopOnError) { break; }
+		}
+	}
+
+	bool bRolledBack = false;
+	FString BatchError;
+	if (Failed > 0 && bTransactional && bStopOnError)
+	{
+		BatchTransaction->Cancel();
+		bRolledBack = true;
+		BatchError = TEXT("Batch aborted: an entry failed and the batch transaction was rolled back.");
+	}
+
+	// ── Phase 3: one PostVerify for the whole batch plus per-entry contracts.
+	bool bAllVerificationPassed = RequestedButNotRunResults.IsEmpty();
+	bool bPostVerifyPassed = false;
+	bool bAnyCommandAwareVerify = false;
+	if (VE && !bRolledBack)
+	{
+		FVerificationPhaseResult PostResult = VE->RunPostVerify(ExpectedActorDelta);
+		bool bContractsPassed = true;
+		TArray<FString> ContractFailures;
+		for (int32 i = 0; i < Entries.Num(); ++i)
+		{
+			const FBatchEntry& Entry = Entries[i];
+			if (!Entry.bRan || !Entry.bOk || !Entry.Info->IsMutating())
+			{
+				continue;
+			}
+			FVerificationPhaseResult EntryPost;
+			if (RunCommandAwarePostVerify(Entry.Cmd, Entry.Args, Entry.Result, EntryPost))
+			{
+				bAnyCommandAwareVerify = true;
+				PostResult.DurationMs += EntryPost.DurationMs;
+				if (!EntryPost.Passed)
+				{
+					bContractsPassed = false;
+					ContractFailures.Add(FString::Printf(TEXT("[%d] %s: %s"), i, *Entry.Cmd, *EntryPost.Detail));
+				}
+			}
+		}
+		if (!ContractFailures.IsEmpty())
+		{
+			PostResult.Detail = FString::Printf(TEXT("%s | %s"), *PostResult.Detail, *FString::Join(ContractFailures, TEXT(" | ")));
+		}
+		PostResult.Passed = PostResult.Passed && bContractsPassed;
+		bPostVerifyPassed = PostResult.Passed;
+		ExecutedVerificationResults.Add(PostResult);
+
+		if (!bContractsPassed && bTransactional)
+		{
+			BatchTransaction->Cancel();
+			bRolledBack = true;
+			BatchError = FString::Printf(TEXT("PostVerify FAILED: %s"), *PostResult.Detail);
+		}
+		else if (!PostResult.Passed)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[UEAgentForge] execute_batch PostVerify warning: %s"), *PostResult.Detail);
+		}
+
+		for (const FVerificationPhaseResult& Result : ExecutedVerificationResults)
+		{
+			bAllVerificationPassed &= Result.Passed;
+		}
+	}
+	BatchTransaction.Reset();
+
+	const FString VerificationMode = bAnyCommandAwareVerify
+		? TEXT("batch_post_state_verified_no_snapshot")
+		: TEXT("batch_partial_no_snapshot");
+	if (VE)
+	{
+		VE->LastVerificationResult = SerializeVerificationSummaryJson(
+			TEXT("execute_batch"), VerificationPhaseMask, bAllVerificationPassed && !bRolledBack,
+			ExecutedVerificationResults, RequestedButNotRunResults, VerificationMode);
+	}
+
+	TArray<TSharedPtr<FJsonValue>> ResultArr;
+	for (int32 i = 0; i < Entries.Num(); ++i)
+	{
+		const FBatchEntry& Entry = Entries[i];
+		TSharedPtr<FJsonObject> EntryObj = MakeShared<FJsonObject>();
+		EntryObj->SetNumberField(TEXT("index"), i);
+		if (Entry.RequestId.IsValid())
+		{
+			EntryObj->SetField(TEXT("request_id"), Entry.RequestId);
+		}
+		EntryObj->SetStringField(TEXT("cmd"),   Entry.Cmd);
+		EntryObj->SetBoolField  (TEXT("ran"),   Entry.bRan);
+		EntryObj->SetBoolField  (TEXT("ok"),    Entry.bRan && Entry.bOk && !bRolledBack);
+		EntryObj->SetNumberField(TEXT("duration_ms"), Entry.DurationMs);
+		if (Entry.bRan)
+		{
+			TSharedPtr<FJsonObject> ResultObj;
+			FString ParseErr;
+			if (ParseJsonObject(Entry.Result, ResultObj, ParseErr))
+			{
+				EntryObj->SetObjectField(TEXT("result"), ResultObj);
+			}
+			else
+			{
+				EntryObj->SetStringField(TEXT("result_raw"), Entry.Result);
+			}
+		}
+		ResultArr.Add(MakeShared<FJsonValueObject>(EntryObj));
+	}
+
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetBoolField  (TEXT("ok"),                Failed == 0 && !bRolledBack);
+	if (!BatchError.IsEmpty()) { Obj->SetStringField(TEXT("error"), BatchError); }
+	Obj->SetNumberField(TEXT("count"),             Entries.Num());
+	Obj->SetNumberField(TEXT("succeeded"),         bRolledBack ? 0 : Succeeded);
+	Obj->SetNumberField(TEXT("failed"),            Failed);
+	Obj->SetBoolField  (TEXT("transactional"),     bTransactional);
+	Obj->SetBoolField  (TEXT("rolled_back"),       bRolledBack);
+	Obj->SetNumberField(TEXT("total_ms"),          (FPlatformTime::Seconds() - BatchStart) * 1000.0);
+	Obj->SetStringField(TEXT("verification_mode"), VerificationMode);
+	Obj->SetBoolField  (TEXT("verified"),          VE != nullptr);
+	Obj->SetBoolField  (TEXT("post_verify_passed"), bPostVerifyPassed && !bRolledBack);
+	Obj->SetArrayField (TEXT("results"),           ResultArr);
+	return ToJsonString(Obj);
+#else
+	return ErrorResponse(TEXT("Editor only."));
+#endif
+}
+
 // ============================================================================
 bool UAgentForgeLibrary::RunVerificationProtocol(int32 PhaseMask)
 {
@@ -3801,6 +4581,7 @@ bool UAgentForgeLibrary::EnforceConstitution(const FString& ActionDesc, TArray<F
 {
 	UConstitutionParser* Parser = UConstitutionParser::Get();
 	if (!Parser) { return true; }
+	Parser->ReloadIfChanged();
 	return Parser->ValidateAction(ActionDesc, OutViolations);
 }
 
@@ -3840,39 +4621,48 @@ FString UAgentForgeLibrary::Cmd_Ping(const TSharedPtr<FJsonObject>& Args)
 	return ToJsonString(Obj);
 }
 
-FString UAgentForgeLibrary::Cmd_GetAllLevelActors()
+FString UAgentForgeLibrary::Cmd_GetAllLevelActors(const TSharedPtr<FJsonObject>& Args)
 {
 #if WITH_EDITOR
 	UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
 	if (!World) { return ErrorResponse(TEXT("No editor world.")); }
 
-	TArray<TSharedPtr<FJsonValue>> ActorArray;
+	using EField = EAgentForgeActorField;
+	const EField Defaults =
+		EField::Name | EField::Label | EField::Class | EField::ObjectPath |
+		EField::Location | EField::Rotation | EField::Scale;
+	FAgentForgeActorQuery Query;
+	FString QueryError;
+	if (!Query.Parse(Args, Defaults | EField::Tags | EField::Bounds | EField::Parent | EField::Visible, Defaults, QueryError))
+	{
+		return ErrorResponse(QueryError);
+	}
+
+	// Streamed straight into a reserved buffer: no per-field DOM allocations on
+	// 40k-actor levels. ~400 chars per actor with paths and three vectors.
+	const int32 Begin = Query.GetBegin();
+	const int32 End   = Query.GetEnd(MAX_int32);
+	const int32 ReserveActors = FMath::Min(World->GetActorCount(), End - Begin);
+	FAgentForgeResponseWriter Writer(FAgentForgeResponseWriter::EncodingFromArgs(Args), ReserveActors * 400);
+	Writer.WriteObjectStart();
+	Writer.WriteArrayStart(TEXT("actors"));
+	int32 MatchIndex = 0;
 	for (TActorIterator<AActor> It(World); It; ++It)
 	{
 		AActor* A = *It;
-		if (!A || !IsValid(A)) { continue; }
-
-		TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
-		Obj->SetStringField(TEXT("name"),        A->GetName());
-		Obj->SetStringField(TEXT("label"),       A->GetActorLabel());
-		Obj->SetStringField(TEXT("class"),       A->GetClass()->GetName());
-		Obj->SetStringField(TEXT("object_path"), A->GetPathName());
-		Obj->SetObjectField(TEXT("location"),    VecToJson(A->GetActorLocation()));
-		Obj->SetObjectField(TEXT("scale"),       VecToJson(A->GetActorScale3D()));
+		if (!A || !IsValid(A) || !Query.Matches(A)) { continue; }
 
-		const FRotator Rot = A->GetActorRotation();
-		TSharedPtr<FJsonObject> RotObj = MakeShared<FJsonObject>();
-		RotObj->SetNumberField(TEXT("pitch"), Rot.Pitch);
-		RotObj->SetNumberField(TEXT("yaw"),   Rot.Yaw);
-		RotObj->SetNumberField(TEXT("roll"),  Rot.Roll);
-		Obj->SetObjectField(TEXT("rotation"), RotObj);
+		const int32 Index = MatchIndex++;
+		if (Index < Begin || Index >= End) { continue; }
 
-		ActorArray.Add(MakeShared<FJsonValueObject>(Obj));
+		Writer.WriteObjectStart();
+		Query.WriteActorFields(Writer, A);
+		Writer.WriteObjectEnd();
 	}
-
-	TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
-	Root->SetArrayField(TEXT("actors"), ActorArray);
-	return ToJsonString(Root);
+	Writer.WriteArrayEnd();
+	Query.WritePaging(Writer, MatchIndex);
+	Writer.WriteObjectEnd();
+	return Writer.Finish();
 #else
 	return ErrorResponse(TEXT("Editor only."));
 #endif
@@ -3954,17 +4744,178 @@ FString UAgentForgeLibrary::Cmd_GetWorldContext(const TSharedPtr<FJsonObject>& A
 		{
 			ScreenshotLabel = Args->GetStringField(TEXT("screenshot_label"));
 		}
-	}
+	}
+
+	// fields projects the per-actor packets; class/tag/bounds filter the source
+	// actors; limit pages like max_actors, cursor walks the priority order.
+	using EField = EAgentForgeActorField;
+	const EField ContextFields =
+		EField::Label | EField::Class | EField::Category | EField::Parent | EField::Visible |
+		EField::Location | EField::Distance | EField::Tags;
+	FAgentForgeActorQuery Query;
+	FString QueryError;
+	if (!Query.Parse(Args, ContextFields | EField::ComponentCount,
+		ContextFields | (bIncludeComponents ? EField::ComponentCount : EField::None), QueryError))
+	{
+		return ErrorResponse(QueryError);
+	}
+	if (Query.GetLimit() > 0)
+	{
+		MaxActors = FMath::Clamp(Query.GetLimit(), 1, 500);
+	}
+	bIncludeComponents = Query.Wants(EField::ComponentCount);
+
+	UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+	if (!World) { return ErrorResponse(TEXT("No editor world.")); }
+
+	struct FContextActor
+	{
+		FString Label;
+		FString ClassName;
+		FString Category;
+		FVector Location = FVector::ZeroVector;
+		FString Parent;
+		bool bVisible = true;
+		bool bGameplayAnchor = false;
+		float DistanceToCenter = 0.0f;
+		float DistanceSq = 0.0f;
+		int32 ComponentCount = 0;
+		TArray<FString> Tags;
+		int32 Priority = 0;
+	};
+
+	// False for filtered-out and system actors.
+	auto GatherContextActor = [&Query, bIncludeComponents](AActor* WorldActor, FContextActor& Entry) -> bool
+	{
+		if (!WorldActor || WorldActor->IsA<AWorldSettings>() || !Query.Matches(WorldActor)) { return false; }
+
+		Entry.Label = WorldActor->GetActorLabel();
+		Entry.ClassName = WorldActor->GetClass()->GetName();
+		if (IsLikelySystemActorForContext(Entry.Label, Entry.ClassName))
+		{
+			return false;
+		}
+		if (Query.Wants(EField::Parent))
+		{
+			const AActor* ParentActor = WorldActor->GetAttachParentActor();
+			Entry.Parent = ParentActor ? ParentActor->GetActorLabel() : FString();
+		}
+		Entry.bVisible = !WorldActor->IsHidden();
+		Entry.Location = WorldActor->GetActorLocation();
+
+		if (Query.Wants(EField::Tags))
+		{
+			for (const FName& Tag : WorldActor->Tags)
+			{
+				if (Entry.Tags.Num() >= 6) { break; }
+				Entry.Tags.Add(Tag.ToString());
+			}
+		}
+
+		if (bIncludeComponents)
+		{
+			Entry.ComponentCount = WorldActor->GetComponents().Num();
+		}
+
+		Entry.Category = ClassifyActorForContext(Entry.Label, Entry.ClassName);
+		Entry.Priority = ContextPriorityForCategory(Entry.Category);
+		Entry.bGameplayAnchor =
+			Entry.Category == TEXT("player") ||
+			Entry.Category == TEXT("objective") ||
+			Entry.Category == TEXT("ai");
+		return true;
+	};
+
+	auto WriteContextActor = [&Query, bIncludeComponents](FAgentForgeResponseWriter& Writer, const FContextActor& Actor)
+	{
+		Writer.WriteObjectStart();
+		if (Query.Wants(EField::Label))    { Writer.WriteValue(TEXT("label"), Actor.Label); }
+		if (Query.Wants(EField::Class))    { Writer.WriteValue(TEXT("class"), Actor.ClassName); }
+		if (Query.Wants(EField::Category)) { Writer.WriteValue(TEXT("category"), Actor.Category); }
+		if (Query.Wants(EField::Parent))   { Writer.WriteValue(TEXT("parent"), Actor.Parent); }
+		if (Query.Wants(EField::Visible))  { Writer.WriteValue(TEXT("is_visible"), Actor.bVisible); }
+		if (Query.Wants(EField::Location)) { Writer.WriteVector(TEXT("location"), Actor.Location); }
+		if (Query.Wants(EField::Distance)) { Writer.WriteValue(TEXT("distance_to_center_cm"), (double)Actor.DistanceToCenter); }
+		if (bIncludeComponents)
+		{
+			Writer.WriteValue(TEXT("component_count"), Actor.ComponentCount);
+		}
+		if (Query.Wants(EField::Tags))
+		{
+			Writer.WriteArrayStart(TEXT("tags"));
+			for (const FString& Tag : Actor.Tags)
+			{
+				Writer.WriteValue(Tag);
+			}
+			Writer.WriteArrayEnd();
+		}
+		Writer.WriteObjectEnd();
+	};
+
+	// since_revision: only the context actors that changed, from the actor
+	// index's change history. Level, semantic and composition summaries are
+	// not recomputed; distances are measured from the cached level bounds.
+	double SinceValue = 0.0;
+	const bool bSinceGiven = Args.IsValid() && Args->TryGetNumberField(TEXT("since_revision"), SinceValue);
+	FAgentForgeActorIndex::FWorldDelta Delta;
+	if (bSinceGiven && FAgentForgeActorIndex::Get().GetChangesSince((int64)SinceValue, Delta))
+	{
+		const FBox LevelBounds = FAgentForgeActorIndex::Get().GetLevelBounds();
+		const FVector DeltaCenter = LevelBounds.IsValid ? LevelBounds.GetCenter() : FVector::ZeroVector;
+
+		// An actor that changed out of the filter (or into a system actor) is
+		// reported as removed, so the caller's copy stays consistent.
+		TArray<FAgentForgeActorIndex::FRemovedActor> Removed = Delta.Removed;
+		auto WriteChanged = [&](const TCHAR* Name, const TArray<AActor*>& Changed, FAgentForgeResponseWriter& Writer)
+		{
+			Writer.WriteArrayStart(Name);
+			for (AActor* ChangedActor : Changed)
+			{
+				FContextActor Entry;
+				if (!GatherContextActor(ChangedActor, Entry))
+				{
+					Removed.Add({ ChangedActor->GetActorLabel(), ChangedActor->GetName(), ChangedActor->GetPathName() });
+					continue;
+				}
+				Entry.DistanceToCenter = LevelBounds.IsValid ? (float)FVector::Dist(Entry.Location, DeltaCenter) : 0.0f;
+				WriteContextActor(Writer, Entry);
+			}
+			Writer.WriteArrayEnd();
+		};
+
+		FAgentForgeResponseWriter Writer(FAgentForgeResponseWriter::EncodingFromArgs(Args),
+			1024 + (Delta.Added.Num() + Delta.Modified.Num()) * 320 + Delta.Removed.Num() * 160);
+		Writer.WriteObjectStart();
+		Writer.WriteValue(TEXT("ok"), true);
+		Writer.WriteValue(TEXT("schema"), TEXT("world_context_delta_v1"));
+		Writer.WriteValue(TEXT("generated_at_utc"), FDateTime::UtcNow().ToIso8601());
+		Writer.WriteValue(TEXT("revision"), Delta.Revision);
+		Writer.WriteValue(TEXT("since_revision"), (int64)SinceValue);
+		Writer.WriteValue(TEXT("delta"), true);
+		WriteChanged(TEXT("added"), Delta.Added, Writer);
+		WriteChanged(TEXT("modified"), Delta.Modified, Writer);
+		Writer.WriteArrayStart(TEXT("removed"));
+		for (const FAgentForgeActorIndex::FRemovedActor& Gone : Removed)
+		{
+			Writer.WriteObjectStart();
+			Writer.WriteValue(TEXT("label"), Gone.Label);
+			Writer.WriteValue(TEXT("name"), Gone.Name);
+			Writer.WriteValue(TEXT("object_path"), Gone.Path);
+			Writer.WriteObjectEnd();
+		}
+		Writer.WriteArrayEnd();
+		Writer.WriteObjectEnd();
+		return Writer.Finish();
+	}
+	const int64 Revision = bSinceGiven ? Delta.Revision : FAgentForgeActorIndex::Get().GetRevision();
 
 	const FString LevelRaw = Cmd_GetCurrentLevel();
 	const FString CompositionRaw = FSpatialControlModule::AnalyzeLevelComposition();
 	const FString SemanticRaw = FDataAccessModule::GetSemanticEnvironmentSnapshot();
-	const FString HierarchyRaw = FDataAccessModule::GetLevelHierarchy();
 
 	TSharedPtr<FJsonObject> LevelObj;
 	TSharedPtr<FJsonObject> CompositionObj;
 	TSharedPtr<FJsonObject> SemanticObj;
-	TSharedPtr<FJsonObject> HierarchyObj;
 	FString ParseErr;
 
 	if (!ParseJsonObject(LevelRaw, LevelObj, ParseErr))
@@ -3979,32 +4930,6 @@ FString UAgentForgeLibrary::Cmd_GetWorldContext(const TSharedPtr<FJsonObject>& A
 	{
 		return ErrorResponse(FString::Printf(TEXT("get_world_context: failed to parse semantic payload (%s)"), *ParseErr));
 	}
-	if (!ParseJsonObject(HierarchyRaw, HierarchyObj, ParseErr))
-	{
-		return ErrorResponse(FString::Printf(TEXT("get_world_context: failed to parse hierarchy payload (%s)"), *ParseErr));
-	}
-
-	const TArray<TSharedPtr<FJsonValue>>* HierarchyActors = nullptr;
-	if (!HierarchyObj->TryGetArrayField(TEXT("actors"), HierarchyActors) || !HierarchyActors)
-	{
-		return ErrorResponse(TEXT("get_world_context: hierarchy payload missing actors array"));
-	}
-
-	struct FContextActor
-	{
-		FString Label;
-		FString ClassName;
-		FString Category;
-		FVector Location = FVector::ZeroVector;
-		FString Parent;
-		bool bVisible = true;
-		bool bGameplayAnchor = false;
-		float DistanceToCenter = 0.0f;
-		float DistanceSq = 0.0f;
-		int32 ComponentCount = 0;
-		TArray<FString> Tags;
-		int32 Priority = 0;
-	};
 
 	FVector Center = FVector::ZeroVector;
 	bool bHasCenter = false;
@@ -4029,65 +4954,22 @@ FString UAgentForgeLibrary::Cmd_GetWorldContext(const TSharedPtr<FJsonObject>& A
 	}
 
 	TArray<FContextActor> AllActors;
-	AllActors.Reserve(HierarchyActors->Num());
+	AllActors.Reserve(World->GetActorCount());
 
 	TMap<FString, int32> CategoryCounts;
 	TArray<FString> Warnings;
 	FVector MeanAccumulator = FVector::ZeroVector;
 	int32 MeanCount = 0;
 
-	for (const TSharedPtr<FJsonValue>& Value : *HierarchyActors)
+	// Actors are read straight from the world; serializing the full level
+	// hierarchy only to parse it back was most of this command's cost.
+	for (TActorIterator<AActor> It(World); It; ++It)
 	{
-		const TSharedPtr<FJsonObject>* ActorObj = nullptr;
-		if (!Value.IsValid() || !Value->TryGetObject(ActorObj) || !ActorObj || !(*ActorObj).IsValid())
-		{
-			continue;
-		}
-
 		FContextActor Entry;
-		Entry.Label = (*ActorObj)->GetStringField(TEXT("label"));
-		Entry.ClassName = (*ActorObj)->GetStringField(TEXT("class"));
-		if (IsLikelySystemActorForContext(Entry.Label, Entry.ClassName))
-		{
-			continue;
-		}
-		Entry.Parent = (*ActorObj)->GetStringField(TEXT("parent"));
-		Entry.bVisible = !(*ActorObj)->HasField(TEXT("is_visible")) || (*ActorObj)->GetBoolField(TEXT("is_visible"));
-
-		const TSharedPtr<FJsonObject>* LocObj = nullptr;
-		if ((*ActorObj)->TryGetObjectField(TEXT("location"), LocObj) && *LocObj)
-		{
-			Entry.Location.X = (float)(*LocObj)->GetNumberField(TEXT("x"));
-			Entry.Location.Y = (float)(*LocObj)->GetNumberField(TEXT("y"));
-			Entry.Location.Z = (float)(*LocObj)->GetNumberField(TEXT("z"));
-			MeanAccumulator += Entry.Location;
-			++MeanCount;
-		}
-
-		const TArray<TSharedPtr<FJsonValue>>* TagsArr = nullptr;
-		if ((*ActorObj)->TryGetArrayField(TEXT("tags"), TagsArr) && TagsArr)
-		{
-			for (const TSharedPtr<FJsonValue>& TagValue : *TagsArr)
-			{
-				if (!TagValue.IsValid()) { continue; }
-				if (Entry.Tags.Num() >= 6) { break; }
-				Entry.Tags.Add(TagValue->AsString());
-			}
-		}
-
-		const TArray<TSharedPtr<FJsonValue>>* ComponentsArr = nullptr;
-		if ((*ActorObj)->TryGetArrayField(TEXT("components"), ComponentsArr) && ComponentsArr)
-		{
-			Entry.ComponentCount = ComponentsArr->Num();
-		}
-
-		Entry.Category = ClassifyActorForContext(Entry.Label, Entry.ClassName);
-		Entry.Priority = ContextPriorityForCategory(Entry.Category);
-		Entry.bGameplayAnchor =
-			Entry.Category == TEXT("player") ||
-			Entry.Category == TEXT("objective") ||
-			Entry.Category == TEXT("ai");
+		if (!GatherContextActor(*It, Entry)) { continue; }
 
+		MeanAccumulator += Entry.Location;
+		++MeanCount;
 		CategoryCounts.FindOrAdd(Entry.Category) += 1;
 		AllActors.Add(MoveTemp(Entry));
 	}
@@ -4138,10 +5020,11 @@ FString UAgentForgeLibrary::Cmd_GetWorldContext(const TSharedPtr<FJsonObject>& A
 		return ErrorResponse(TEXT("get_world_context: no context actors found after filtering"));
 	}
 
-	const int32 SelectedCount = FMath::Min(MaxActors, AllActors.Num());
+	const int32 SelectedBegin = FMath::Min(Query.GetBegin(), AllActors.Num());
+	const int32 SelectedEnd   = FMath::Min(SelectedBegin + MaxActors, AllActors.Num());
 	TArray<FContextActor> SelectedActors;
-	SelectedActors.Reserve(SelectedCount);
-	for (int32 Idx = 0; Idx < SelectedCount; ++Idx)
+	SelectedActors.Reserve(SelectedEnd - SelectedBegin);
+	for (int32 Idx = SelectedBegin; Idx < SelectedEnd; ++Idx)
 	{
 		SelectedActors.Add(AllActors[Idx]);
 	}
@@ -4321,41 +5204,10 @@ FString UAgentForgeLibrary::Cmd_GetWorldContext(const TSharedPtr<FJsonObject>& A
 		}
 	}
 
-	// Build selected actor payload and gameplay anchor payload.
-	TArray<TSharedPtr<FJsonValue>> ActorsArr;
-	TArray<TSharedPtr<FJsonValue>> GameplayAnchorsArr;
+	int32 GameplayAnchorCount = 0;
 	for (const FContextActor& Actor : SelectedActors)
 	{
-		TSharedPtr<FJsonObject> ActorObj = MakeShared<FJsonObject>();
-		ActorObj->SetStringField(TEXT("label"), Actor.Label);
-		ActorObj->SetStringField(TEXT("class"), Actor.ClassName);
-		ActorObj->SetStringField(TEXT("category"), Actor.Category);
-		ActorObj->SetStringField(TEXT("parent"), Actor.Parent);
-		ActorObj->SetBoolField(TEXT("is_visible"), Actor.bVisible);
-		ActorObj->SetObjectField(TEXT("location"), VecToJson(Actor.Location));
-		ActorObj->SetNumberField(TEXT("distance_to_center_cm"), Actor.DistanceToCenter);
-		if (bIncludeComponents)
-		{
-			ActorObj->SetNumberField(TEXT("component_count"), Actor.ComponentCount);
-		}
-
-		TArray<TSharedPtr<FJsonValue>> TagsJson;
-		for (const FString& Tag : Actor.Tags)
-		{
-			TagsJson.Add(MakeShared<FJsonValueString>(Tag));
-		}
-		ActorObj->SetArrayField(TEXT("tags"), TagsJson);
-		ActorsArr.Add(MakeShared<FJsonValueObject>(ActorObj));
-
-		if (Actor.bGameplayAnchor)
-		{
-			TSharedPtr<FJsonObject> AnchorObj = MakeShared<FJsonObject>();
-			AnchorObj->SetStringField(TEXT("label"), Actor.Label);
-			AnchorObj->SetStringField(TEXT("class"), Actor.ClassName);
-			AnchorObj->SetStringField(TEXT("category"), Actor.Category);
-			AnchorObj->SetObjectField(TEXT("location"), VecToJson(Actor.Location));
-			GameplayAnchorsArr.Add(MakeShared<FJsonValueObject>(AnchorObj));
-		}
+		GameplayAnchorCount += Actor.bGameplayAnchor ? 1 : 0;
 	}
 
 	TSharedPtr<FJsonObject> CategoryCountsObj = MakeShared<FJsonObject>();
@@ -4383,7 +5235,7 @@ FString UAgentForgeLibrary::Cmd_GetWorldContext(const TSharedPtr<FJsonObject>& A
 	BriefArr.Add(MakeShared<FJsonValueString>(
 		FString::Printf(TEXT("Atmosphere: horror_score %.1f (%s)"), HorrorScore, *HorrorRating)));
 	BriefArr.Add(MakeShared<FJsonValueString>(
-		FString::Printf(TEXT("Gameplay anchors: %d, inferred relationships: %d"), GameplayAnchorsArr.Num(), RelationshipArr.Num())));
+		FString::Printf(TEXT("Gameplay anchors: %d, inferred relationships: %d"), GameplayAnchorCount, RelationshipArr.Num())));
 	BriefArr.Add(MakeShared<FJsonValueString>(
 		FString::Printf(TEXT("Top hotspot count: %d actors"), Hotspots.Num() > 0 ? Hotspots[0].Count : 0)));
 
@@ -4421,6 +5273,15 @@ FString UAgentForgeLibrary::Cmd_GetWorldContext(const TSharedPtr<FJsonObject>& A
 	BudgetObj->SetBoolField(TEXT("truncated"), AllActors.Num() > SelectedActors.Num());
 	BudgetObj->SetNumberField(TEXT("max_relationships"), MaxRelationships);
 	BudgetObj->SetBoolField(TEXT("include_components"), bIncludeComponents);
+	BudgetObj->SetNumberField(TEXT("cursor"), SelectedBegin);
+	if (SelectedEnd < AllActors.Num())
+	{
+		BudgetObj->SetStringField(TEXT("next_cursor"), FString::FromInt(SelectedEnd));
+	}
+	else
+	{
+		BudgetObj->SetField(TEXT("next_cursor"), MakeShared<FJsonValueNull>());
+	}
 
 	TSharedPtr<FJsonObject> ScreenshotObj = MakeShared<FJsonObject>();
 	ScreenshotObj->SetBoolField(TEXT("requested"), bIncludeScreenshot);
@@ -4431,24 +5292,54 @@ FString UAgentForgeLibrary::Cmd_GetWorldContext(const TSharedPtr<FJsonObject>& A
 		BriefArr.Add(MakeShared<FJsonValueString>(FString::Printf(TEXT("Screenshot queued: %s"), *ScreenshotPath)));
 	}
 
-	TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
-	Root->SetBoolField(TEXT("ok"), true);
-	Root->SetStringField(TEXT("schema"), TEXT("world_context_v1"));
-	Root->SetStringField(TEXT("generated_at_utc"), FDateTime::UtcNow().ToIso8601());
-	Root->SetObjectField(TEXT("budget"), BudgetObj);
-	Root->SetObjectField(TEXT("level"), LevelObj);
-	Root->SetObjectField(TEXT("semantic"), SemanticObj);
-	Root->SetObjectField(TEXT("composition"), CompositionObj);
-	Root->SetObjectField(TEXT("category_counts"), CategoryCountsObj);
-	Root->SetArrayField(TEXT("actors"), ActorsArr);
-	Root->SetArrayField(TEXT("gameplay_anchors"), GameplayAnchorsArr);
-	Root->SetArrayField(TEXT("relationships"), RelationshipArr);
-	Root->SetArrayField(TEXT("spatial_hotspots"), HotspotArr);
-	Root->SetArrayField(TEXT("llm_brief"), BriefArr);
-	Root->SetArrayField(TEXT("warnings"), WarningsArr);
-	Root->SetArrayField(TEXT("suggested_next_cmds"), SuggestedNextCmds);
-	Root->SetObjectField(TEXT("screenshot"), ScreenshotObj);
-	return ToJsonString(Root);
+	// The selected actor and anchor arrays are streamed from SelectedActors;
+	// the small summary objects above are embedded as-is.
+	FAgentForgeResponseWriter Writer(FAgentForgeResponseWriter::EncodingFromArgs(Args), 16384 + SelectedActors.Num() * 320);
+	Writer.WriteObjectStart();
+	Writer.WriteValue(TEXT("ok"), true);
+	Writer.WriteValue(TEXT("schema"), TEXT("world_context_v1"));
+	Writer.WriteValue(TEXT("generated_at_utc"), FDateTime::UtcNow().ToIso8601());
+	Writer.WriteValue(TEXT("revision"), Revision);
+	if (bSinceGiven)
+	{
+		// Too old to diff (map change, history trimmed): this is a full resend.
+		Writer.WriteValue(TEXT("since_revision"), (int64)SinceValue);
+		Writer.WriteValue(TEXT("delta"), false);
+	}
+	Writer.WriteJsonObject(TEXT("budget"), BudgetObj);
+	Writer.WriteJsonObject(TEXT("level"), LevelObj);
+	Writer.WriteJsonObject(TEXT("semantic"), SemanticObj);
+	Writer.WriteJsonObject(TEXT("composition"), CompositionObj);
+	Writer.WriteJsonObject(TEXT("category_counts"), CategoryCountsObj);
+
+	Writer.WriteArrayStart(TEXT("actors"));
+	for (const FContextActor& Actor : SelectedActors)
+	{
+		WriteContextActor(Writer, Actor);
+	}
+	Writer.WriteArrayEnd();
+
+	Writer.WriteArrayStart(TEXT("gameplay_anchors"));
+	for (const FContextActor& Actor : SelectedActors)
+	{
+		if (!Actor.bGameplayAnchor) { continue; }
+		Writer.WriteObjectStart();
+		Writer.WriteValue(TEXT("label"), Actor.Label);
+		Writer.WriteValue(TEXT("class"), Actor.ClassName);
+		Writer.WriteValue(TEXT("category"), Actor.Category);
+		Writer.WriteVector(TEXT("location"), Actor.Location);
+		Writer.WriteObjectEnd();
+	}
+	Writer.WriteArrayEnd();
+
+	Writer.WriteJsonValue(TEXT("relationships"), MakeShared<FJsonValueArray>(RelationshipArr));
+	Writer.WriteJsonValue(TEXT("spatial_hotspots"), MakeShared<FJsonValueArray>(HotspotArr));
+	Writer.WriteJsonValue(TEXT("llm_brief"), MakeShared<FJsonValueArray>(BriefArr));
+	Writer.WriteJsonValue(TEXT("warnings"), MakeShared<FJsonValueArray>(WarningsArr));
+	Writer.WriteJsonValue(TEXT("suggested_next_cmds"), MakeShared<FJsonValueArray>(SuggestedNextCmds));
+	Writer.WriteJsonObject(TEXT("screenshot"), ScreenshotObj);
+	Writer.WriteObjectEnd();
+	return Writer.Finish();
 #else
 	return ErrorResponse(TEXT("Editor only."));
 #endif
@@ -4498,66 +5389,12 @@ FString UAgentForgeLibrary::Cmd_GetActorBounds(const TSharedPtr<FJsonObject>& Ar
 FString UAgentForgeLibrary::Cmd_GetAvailableMeshes(const TSharedPtr<FJsonObject>& Args)
 {
 #if WITH_EDITOR
-	FString SearchFilter;
-	FString PathFilter;
-	int32 MaxResults = 50;
-	if (Args.IsValid())
-	{
-		Args->TryGetStringField(TEXT("search_filter"), SearchFilter);
-		Args->TryGetStringField(TEXT("path_filter"), PathFilter);
-		if (Args->HasField(TEXT("max_results")))
-		{
-			MaxResults = FMath::Max(1, (int32)Args->GetNumberField(TEXT("max_results")));
-		}
-	}
-
-	FAssetRegistryModule& RegistryModule =
-		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
-
-	FARFilter Filter;
-	Filter.bRecursivePaths = true;
-	Filter.ClassPaths.Add(UStaticMesh::StaticClass()->GetClassPathName());
-	if (!PathFilter.IsEmpty())
-	{
-		Filter.PackagePaths.Add(*PathFilter);
-	}
-
-	TArray<FAssetData> Assets;
-	RegistryModule.Get().GetAssets(Filter, Assets);
-	Assets.Sort([](const FAssetData& A, const FAssetData& B)
-	{
-		return A.AssetName.LexicalLess(B.AssetName);
-	});
-
-	const FString SearchNeedle = SearchFilter.ToLower();
-	TArray<TSharedPtr<FJsonValue>> Results;
-	for (const FAssetData& Asset : Assets)
+	TSharedPtr<FJsonObject> Root;
+	FString Error;
+	if (!QueryAvailableAssets(Args, EAgentForgeAssetKind::StaticMesh, Root, Error))
 	{
-		const FString AssetName = Asset.AssetName.ToString();
-		if (!SearchNeedle.IsEmpty() && !AssetName.ToLower().Contains(SearchNeedle))
-		{
-			continue;
-		}
-
-		TSharedPtr<FJsonObject> Entry = MakeShared<FJsonObject>();
-		Entry->SetStringField(TEXT("asset_name"), AssetName);
-		Entry->SetStringField(TEXT("asset_path"), Asset.GetSoftObjectPath().ToString());
-		Entry->SetStringField(TEXT("package_path"), Asset.PackagePath.ToString());
-		Entry->SetStringField(TEXT("class"), Asset.AssetClassPath.GetAssetName().ToString());
-		Results.Add(MakeShared<FJsonValueObject>(Entry));
-
-		if (Results.Num() >= MaxResults)
-		{
-			break;
-		}
+		return ErrorResponse(Error);
 	}
-
-	TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
-	Root->SetBoolField(TEXT("ok"), true);
-	Root->SetStringField(TEXT("search_filter"), SearchFilter);
-	Root->SetStringField(TEXT("path_filter"), PathFilter);
-	Root->SetNumberField(TEXT("count"), Results.Num());
-	Root->SetArrayField(TEXT("assets"), Results);
 	return ToJsonString(Root);
 #else
 	return ErrorResponse(TEXT("Editor only."));
@@ -4567,67 +5404,12 @@ FString UAgentForgeLibrary::Cmd_GetAvailableMeshes(const TSharedPtr<FJsonObject>
 FString UAgentForgeLibrary::Cmd_GetAvailableMaterials(const TSharedPtr<FJsonObject>& Args)
 {
 #if WITH_EDITOR
-	FString SearchFilter;
-	FString PathFilter;
-	int32 MaxResults = 50;
-	if (Args.IsValid())
-	{
-		Args->TryGetStringField(TEXT("search_filter"), SearchFilter);
-		Args->TryGetStringField(TEXT("path_filter"), PathFilter);
-		if (Args->HasField(TEXT("max_results")))
-		{
-			MaxResults = FMath::Max(1, (int32)Args->GetNumberField(TEXT("max_results")));
-		}
-	}
-
-	FAssetRegistryModule& RegistryModule =
-		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
-
-	FARFilter Filter;
-	Filter.bRecursivePaths = true;
-	Filter.ClassPaths.Add(UMaterial::StaticClass()->GetClassPathName());
-	Filter.ClassPaths.Add(UMaterialInstanceConstant::StaticClass()->GetClassPathName());
-	if (!PathFilter.IsEmpty())
-	{
-		Filter.PackagePaths.Add(*PathFilter);
-	}
-
-	TArray<FAssetData> Assets;
-	RegistryModule.Get().GetAssets(Filter, Assets);
-	Assets.Sort([](const FAssetData& A, const FAssetData& B)
-	{
-		return A.AssetName.LexicalLess(B.AssetName);
-	});
-
-	const FString SearchNeedle = SearchFilter.ToLower();
-	TArray<TSharedPtr<FJsonValue>> Results;
-	for (const FAssetData& Asset : Assets)
+	TSharedPtr<FJsonObject> Root;
+	FString Error;
+	if (!QueryAvailableAssets(Args, EAgentForgeAssetKind::Material, Root, Error))
 	{
-		const FString AssetName = Asset.AssetName.ToString();
-		if (!SearchNeedle.IsEmpty() && !AssetName.ToLower().Contains(SearchNeedle))
-		{
-			continue;
-		}
-
-		TSharedPtr<FJsonObject> Entry = MakeShared<FJsonObject>();
-		Entry->SetStringField(TEXT("asset_name"), AssetName);
-		Entry->SetStringField(TEXT("asset_path"), Asset.GetSoftObjectPath().ToString());
-		Entry->SetStringField(TEXT("package_path"), Asset.PackagePath.ToString());
-		Entry->SetStringField(TEXT("class"), Asset.AssetClassPath.GetAssetName().ToString());
-		Results.Add(MakeShared<FJsonValueObject>(Entry));
-
-		if (Results.Num() >= MaxResults)
-		{
-			break;
-		}
+		return ErrorResponse(Error);
 	}
-
-	TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
-	Root->SetBoolField(TEXT("ok"), true);
-	Root->SetStringField(TEXT("search_filter"), SearchFilter);
-	Root->SetStringField(TEXT("path_filter"), PathFilter);
-	Root->SetNumberField(TEXT("count"), Results.Num());
-	Root->SetArrayField(TEXT("assets"), Results);
 	return ToJsonString(Root);
 #else
 	return ErrorResponse(TEXT("Editor only."));
@@ -4637,88 +5419,12 @@ FString UAgentForgeLibrary::Cmd_GetAvailableMaterials(const TSharedPtr<FJsonObje
 FString UAgentForgeLibrary::Cmd_GetAvailableBlueprints(const TSharedPtr<FJsonObject>& Args)
 {
 #if WITH_EDITOR
-	FString SearchFilter;
-	FString ParentClassFilter;
-	FString PathFilter;
-	int32 MaxResults = 50;
-	if (Args.IsValid())
-	{
-		Args->TryGetStringField(TEXT("search_filter"), SearchFilter);
-		Args->TryGetStringField(TEXT("parent_class"), ParentClassFilter);
-		Args->TryGetStringField(TEXT("path_filter"), PathFilter);
-		if (Args->HasField(TEXT("max_results")))
-		{
-			MaxResults = FMath::Max(1, (int32)Args->GetNumberField(TEXT("max_results")));
-		}
-	}
-
-	FString ParentNeedle = ParentClassFilter;
-	ParentNeedle.ToLowerInline();
-
-	FAssetRegistryModule& RegistryModule =
-		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
-
-	FARFilter Filter;
-	Filter.bRecursivePaths = true;
-	Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
-	if (!PathFilter.IsEmpty())
-	{
-		Filter.PackagePaths.Add(*PathFilter);
-	}
-
-	TArray<FAssetData> Assets;
-	RegistryModule.Get().GetAssets(Filter, Assets);
-	Assets.Sort([](const FAssetData& A, const FAssetData& B)
-	{
-		return A.AssetName.LexicalLess(B.AssetName);
-	});
-
-	const FString SearchNeedle = SearchFilter.ToLower();
-	TArray<TSharedPtr<FJsonValue>> Results;
-	for (const FAssetData& Asset : Assets)
+	TSharedPtr<FJsonObject> Root;
+	FString Error;
+	if (!QueryAvailableAssets(Args, EAgentForgeAssetKind::Blueprint, Root, Error))
 	{
-		const FString AssetName = Asset.AssetName.ToString();
-		if (!SearchNeedle.IsEmpty() && !AssetName.ToLower().Contains(SearchNeedle))
-		{
-			continue;
-		}
-
-		const FString ParentClassPath = Asset.GetTagValueRef<FString>(FBlueprintTags::ParentClassPath);
-		const FString NativeParentClassPath = Asset.GetTagValueRef<FString>(FBlueprintTags::NativeParentClassPath);
-		const FString GeneratedClassPath = Asset.GetTagValueRef<FString>(FBlueprintTags::GeneratedClassPath);
-		if (!ParentNeedle.IsEmpty())
-		{
-			FString Haystack = ParentClassPath + TEXT(" ") + NativeParentClassPath + TEXT(" ") + GeneratedClassPath;
-			Haystack.ToLowerInline();
-			if (!Haystack.Contains(ParentNeedle))
-			{
-				continue;
-			}
-		}
-
-		TSharedPtr<FJsonObject> Entry = MakeShared<FJsonObject>();
-		Entry->SetStringField(TEXT("asset_name"), AssetName);
-		Entry->SetStringField(TEXT("asset_path"), Asset.GetSoftObjectPath().ToString());
-		Entry->SetStringField(TEXT("package_path"), Asset.PackagePath.ToString());
-		Entry->SetStringField(TEXT("class"), Asset.AssetClassPath.GetAssetName().ToString());
-		Entry->SetStringField(TEXT("parent_class_path"), ParentClassPath);
-		Entry->SetStringField(TEXT("native_parent_class_path"), NativeParentClassPath);
-		Entry->SetStringField(TEXT("generated_class_path"), GeneratedClassPath);
-		Results.Add(MakeShared<FJsonValueObject>(Entry));
-
-		if (Results.Num() >= MaxResults)
-		{
-			break;
-		}
+		return ErrorResponse(Error);
 	}
-
-	TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
-	Root->SetBoolField(TEXT("ok"), true);
-	Root->SetStringField(TEXT("search_filter"), SearchFilter);
-	Root->SetStringField(TEXT("path_filter"), PathFilter);
-	Root->SetStringField(TEXT("parent_class"), ParentClassFilter);
-	Root->SetNumberField(TEXT("count"), Results.Num());
-	Root->SetArrayField(TEXT("assets"), Results);
 	return ToJsonString(Root);
 #else
 	return ErrorResponse(TEXT("Editor only."));
@@ -4728,134 +5434,27 @@ FString UAgentForgeLibrary::Cmd_GetAvailableBlueprints(const TSharedPtr<FJsonObj
 FString UAgentForgeLibrary::Cmd_GetAvailableTextures(const TSharedPtr<FJsonObject>& Args)
 {
 #if WITH_EDITOR
-	FString SearchFilter;
-	FString PathFilter;
-	int32 MaxResults = 50;
-	if (Args.IsValid())
-	{
-		Args->TryGetStringField(TEXT("search_filter"), SearchFilter);
-		Args->TryGetStringField(TEXT("path_filter"), PathFilter);
-		if (Args->HasField(TEXT("max_results")))
-		{
-			MaxResults = FMath::Max(1, (int32)Args->GetNumberField(TEXT("max_results")));
-		}
-	}
-
-	FAssetRegistryModule& RegistryModule =
-		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
-
-	FARFilter Filter;
-	Filter.bRecursivePaths = true;
-	Filter.ClassPaths.Add(UTexture2D::StaticClass()->GetClassPathName());
-	if (!PathFilter.IsEmpty())
-	{
-		Filter.PackagePaths.Add(*PathFilter);
-	}
-
-	TArray<FAssetData> Assets;
-	RegistryModule.Get().GetAssets(Filter, Assets);
-	Assets.Sort([](const FAssetData& A, const FAssetData& B)
-	{
-		return A.AssetName.LexicalLess(B.AssetName);
-	});
-
-	const FString SearchNeedle = SearchFilter.ToLower();
-	TArray<TSharedPtr<FJsonValue>> Results;
-	for (const FAssetData& Asset : Assets)
+	TSharedPtr<FJsonObject> Root;
+	FString Error;
+	if (!QueryAvailableAssets(Args, EAgentForgeAssetKind::Texture, Root, Error))
 	{
-		const FString AssetName = Asset.AssetName.ToString();
-		if (!SearchNeedle.IsEmpty() && !AssetName.ToLower().Contains(SearchNeedle))
-		{
-			continue;
-		}
-
-		TSharedPtr<FJsonObject> Entry = MakeShared<FJsonObject>();
-		Entry->SetStringField(TEXT("asset_name"), AssetName);
-		Entry->SetStringField(TEXT("asset_path"), Asset.GetSoftObjectPath().ToString());
-		Entry->SetStringField(TEXT("package_path"), Asset.PackagePath.ToString());
-		Entry->SetStringField(TEXT("class"), Asset.AssetClassPath.GetAssetName().ToString());
-		Results.Add(MakeShared<FJsonValueObject>(Entry));
-		if (Results.Num() >= MaxResults)
-		{
-			break;
-		}
+		return ErrorResponse(Error);
 	}
-
-	TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
-	Root->SetBoolField(TEXT("ok"), true);
-	Root->SetStringField(TEXT("search_filter"), SearchFilter);
-	Root->SetStringField(TEXT("path_filter"), PathFilter);
-	Root->SetNumberField(TEXT("count"), Results.Num());
-	Root->SetArrayField(TEXT("assets"), Results);
 	return ToJsonString(Root);
 #else
-	return ErrorResponse(TEXT("Editor only."));
-#endif
-}
-
-FString UAgentForgeLibrary::Cmd_GetAvailableSounds(const TSharedPtr<FJsonObject>& Args)
-{
-#if WITH_EDITOR
-	FString SearchFilter;
-	FString PathFilter;
-	int32 MaxResults = 50;
-	if (Args.IsValid())
-	{
-		Args->TryGetStringField(TEXT("search_filter"), SearchFilter);
-		Args->TryGetStringField(TEXT("path_filter"), PathFilter);
-		if (Args->HasField(TEXT("max_results")))
-		{
-			MaxResults = FMath::Max(1, (int32)Args->GetNumberField(TEXT("max_results")));
-		}
-	}
-
-	FAssetRegistryModule& RegistryModule =
-		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
-
-	FARFilter Filter;
-	Filter.bRecursivePaths = true;
-	Filter.ClassPaths.Add(USoundWave::StaticClass()->GetClassPathName());
-	Filter.ClassPaths.Add(USoundCue::StaticClass()->GetClassPathName());
-	if (!PathFilter.IsEmpty())
-	{
-		Filter.PackagePaths.Add(*PathFilter);
-	}
-
-	TArray<FAssetData> Assets;
-	RegistryModule.Get().GetAssets(Filter, Assets);
-	Assets.Sort([](const FAssetData& A, const FAssetData& B)
-	{
-		return A.AssetName.LexicalLess(B.AssetName);
-	});
+	return ErrorResponse(TEXT("Editor only."));
+#endif
+}
 
-	const FString SearchNeedle = SearchFilter.ToLower();
-	TArray<TSharedPtr<FJsonValue>> Results;
-	for (const FAssetData& Asset : Assets)
+FString UAgentForgeLibrary::Cmd_GetAvailableSounds(const TSharedPtr<FJsonObject>& Args)
+{
+#if WITH_EDITOR
+	TSharedPtr<FJsonObject> Root;
+	FString Error;
+	if (!QueryAvailableAssets(Args, EAgentForgeAssetKind::Sound, Root, Error))
 	{
-		const FString AssetName = Asset.AssetName.ToString();
-		if (!SearchNeedle.IsEmpty() && !AssetName.ToLower().Contains(SearchNeedle))
-		{
-			continue;
-		}
-
-		TSharedPtr<FJsonObject> Entry = MakeShared<FJsonObject>();
-		Entry->SetStringField(TEXT("asset_name"), AssetName);
-		Entry->SetStringField(TEXT("asset_path"), Asset.GetSoftObjectPath().ToString());
-		Entry->SetStringField(TEXT("package_path"), Asset.PackagePath.ToString());
-		Entry->SetStringField(TEXT("class"), Asset.AssetClassPath.GetAssetName().ToString());
-		Results.Add(MakeShared<FJsonValueObject>(Entry));
-		if (Results.Num() >= MaxResults)
-		{
-			break;
-		}
+		return ErrorResponse(Error);
 	}
-
-	TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
-	Root->SetBoolField(TEXT("ok"), true);
-	Root->SetStringField(TEXT("search_filter"), SearchFilter);
-	Root->SetStringField(TEXT("path_filter"), PathFilter);
-	Root->SetNumberField(TEXT("count"), Results.Num());
-	Root->SetArrayField(TEXT("assets"), Results);
 	return ToJsonString(Root);
 #else
 	return ErrorResponse(TEXT("Editor only."));
@@ -5663,6 +6262,7 @@ FString UAgentForgeLibrary::Cmd_CreateWall(const TSharedPtr<FJsonObject>& Args)
 
 	UWorld* World = GetEditorWorld();
 	if (!World) { return ErrorResponse(TEXT("No editor world.")); }
+	FAgentForgeSpawnBatch SpawnBatch(World);
 
 	TArray<AActor*> Segments;
 	const FString WallError = SpawnLinearWallSegments(
@@ -5788,19 +6388,38 @@ FString UAgentForgeLibrary::Cmd_CreateRoom(const TSharedPtr<FJsonObject>& Args)
 		}
 	}
 
+	bool bMerged = false;
+	FString OutputError;
+	if (!ParseBlockoutOutput(Args, bMerged, OutputError))
+	{
+		return ErrorResponse(OutputError);
+	}
+
 	UWorld* World = GetEditorWorld();
 	if (!World) { return ErrorResponse(TEXT("No editor world.")); }
+	FAgentForgeSpawnBatch SpawnBatch(World);
 
+	// Merged output builds the group actor last, once every box is known.
+	FAgentForgeBlockoutMesh Merged;
+	FAgentForgeBlockoutMesh* MergeInto = bMerged ? &Merged : nullptr;
 	FString GroupError;
-	AActor* GroupActor = SpawnGroupActor(World, Label, FVector(CenterX, CenterY, BaseZ), GroupError);
-	if (!GroupActor)
+	AActor* GroupActor = nullptr;
+	if (!MergeInto)
 	{
-		return ErrorResponse(GroupError);
+		GroupActor = SpawnGroupActor(World, Label, FVector(CenterX, CenterY, BaseZ), GroupError);
+		if (!GroupActor)
+		{
+			return ErrorResponse(GroupError);
+		}
 	}
 
 	TArray<AActor*> RoomActors;
 	auto SpawnRoomBox = [&](const FString& ChildLabel, const FVector& Center, const FVector& Dimensions, const FRotator& Rotation, const FString& MaterialPath) -> bool
 	{
+		if (MergeInto)
+		{
+			return AddMergedBox(*MergeInto, Center, Dimensions, Rotation, MaterialPath, GroupError);
+		}
 		FString SpawnError;
 		AStaticMeshActor* ChildActor = SpawnBoxActor(World, Center, Dimensions, Rotation, ChildLabel, MaterialPath, SpawnError);
 		if (!ChildActor)
@@ -5893,7 +6512,8 @@ FString UAgentForgeLibrary::Cmd_CreateRoom(const TSharedPtr<FJsonObject>& Args)
 			220.0f,
 			120.0f,
 			GroupActor,
-			WallSegments);
+			WallSegments,
+			MergeInto);
 		if (!WallError.IsEmpty())
 		{
 			GroupError = WallError;
@@ -5950,6 +6570,15 @@ FString UAgentForgeLibrary::Cmd_CreateRoom(const TSharedPtr<FJsonObject>& Args)
 		return ErrorResponse(GroupError);
 	}
 
+	if (MergeInto)
+	{
+		GroupActor = Merged.BuildActor(World, Label, FVector(CenterX, CenterY, BaseZ), GroupError);
+		if (!GroupActor)
+		{
+			return ErrorResponse(GroupError);
+		}
+	}
+
 	TArray<TSharedPtr<FJsonValue>> ActorArray;
 	for (AActor* Actor : RoomActors)
 	{
@@ -5958,10 +6587,15 @@ FString UAgentForgeLibrary::Cmd_CreateRoom(const TSharedPtr<FJsonObject>& Args)
 
 	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
 	Obj->SetBoolField(TEXT("ok"), true);
+	Obj->SetStringField(TEXT("output"), bMerged ? TEXT("merged") : TEXT("actors"));
 	Obj->SetStringField(TEXT("group_name"), GroupActor->GetActorLabel());
 	Obj->SetStringField(TEXT("group_object_path"), GroupActor->GetPathName());
 	Obj->SetNumberField(TEXT("child_count"), RoomActors.Num());
 	Obj->SetArrayField(TEXT("children"), ActorArray);
+	if (MergeInto)
+	{
+		Obj->SetObjectField(TEXT("merged"), MakeMergedBlockoutJson(Merged));
+	}
 	return ToJsonString(Obj);
 #else
 	return ErrorResponse(TEXT("Editor only."));
@@ -5997,8 +6631,16 @@ FString UAgentForgeLibrary::Cmd_CreateCorridor(const TSharedPtr<FJsonObject>& Ar
 		return ErrorResponse(TEXT("Corridor start/end points are identical."));
 	}
 
+	bool bMerged = false;
+	FString OutputError;
+	if (!ParseBlockoutOutput(Args, bMerged, OutputError))
+	{
+		return ErrorResponse(OutputError);
+	}
+
 	UWorld* World = GetEditorWorld();
 	if (!World) { return ErrorResponse(TEXT("No editor world.")); }
+	FAgentForgeSpawnBatch SpawnBatch(World);
 
 	const FVector Direction = Delta / Length;
 	const FVector MidPoint = Start + (Delta * 0.5f);
@@ -6006,16 +6648,25 @@ FString UAgentForgeLibrary::Cmd_CreateCorridor(const TSharedPtr<FJsonObject>& Ar
 	const float YawDeg = FMath::RadiansToDegrees(FMath::Atan2(Direction.Y, Direction.X));
 	const FRotator Rotation(0.0f, YawDeg, 0.0f);
 
+	FAgentForgeBlockoutMesh Merged;
 	FString GroupError;
-	AActor* GroupActor = SpawnGroupActor(World, Label, FVector(MidPoint.X, MidPoint.Y, BaseZ), GroupError);
-	if (!GroupActor)
+	AActor* GroupActor = nullptr;
+	if (!bMerged)
 	{
-		return ErrorResponse(GroupError);
+		GroupActor = SpawnGroupActor(World, Label, FVector(MidPoint.X, MidPoint.Y, BaseZ), GroupError);
+		if (!GroupActor)
+		{
+			return ErrorResponse(GroupError);
+		}
 	}
 
 	TArray<AActor*> CorridorActors;
 	auto SpawnChild = [&](const FString& ChildLabel, const FVector& Center, const FVector& Dimensions, const FString& MaterialPath) -> bool
 	{
+		if (bMerged)
+		{
+			return AddMergedBox(Merged, Center, Dimensions, Rotation, MaterialPath, GroupError);
+		}
 		FString SpawnError;
 		AStaticMeshActor* ChildActor = SpawnBoxActor(World, Center, Dimensions, Rotation, ChildLabel, MaterialPath, SpawnError);
 		if (!ChildActor)
@@ -6068,6 +6719,15 @@ FString UAgentForgeLibrary::Cmd_CreateCorridor(const TSharedPtr<FJsonObject>& Ar
 		return ErrorResponse(GroupError);
 	}
 
+	if (bMerged)
+	{
+		GroupActor = Merged.BuildActor(World, Label, FVector(MidPoint.X, MidPoint.Y, BaseZ), GroupError);
+		if (!GroupActor)
+		{
+			return ErrorResponse(GroupError);
+		}
+	}
+
 	TArray<TSharedPtr<FJsonValue>> ActorArray;
 	for (AActor* Actor : CorridorActors)
 	{
@@ -6076,10 +6736,15 @@ FString UAgentForgeLibrary::Cmd_CreateCorridor(const TSharedPtr<FJsonObject>& Ar
 
 	TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
 	Root->SetBoolField(TEXT("ok"), true);
+	Root->SetStringField(TEXT("output"), bMerged ? TEXT("merged") : TEXT("actors"));
 	Root->SetStringField(TEXT("group_name"), GroupActor->GetActorLabel());
 	Root->SetStringField(TEXT("group_object_path"), GroupActor->GetPathName());
 	Root->SetNumberField(TEXT("child_count"), CorridorActors.Num());
 	Root->SetArrayField(TEXT("children"), ActorArray);
+	if (bMerged)
+	{
+		Root->SetObjectField(TEXT("merged"), MakeMergedBlockoutJson(Merged));
+	}
 	return ToJsonString(Root);
 #else
 	return ErrorResponse(TEXT("Editor only."));
@@ -6121,6 +6786,7 @@ FString UAgentForgeLibrary::Cmd_CreateStaircase(const TSharedPtr<FJsonObject>& A
 
 	UWorld* World = GetEditorWorld();
 	if (!World) { return ErrorResponse(TEXT("No editor world.")); }
+	FAgentForgeSpawnBatch SpawnBatch(World);
 
 	FString GroupError;
 	AActor* GroupActor = SpawnGroupActor(World, Label, FVector(BaseX, BaseY, BaseZ), GroupError);
@@ -6179,29 +6845,93 @@ FString UAgentForgeLibrary::Cmd_CreateStaircase(const TSharedPtr<FJsonObject>& A
 #endif
 }
 
+struct FScatterPropsArgs
+{
+	FString MeshPath;
+	float CenterX = 0.0f;
+	float CenterY = 0.0f;
+	float BaseZ = 0.0f;
+	float Radius = 250.0f;
+	int32 Count = 8;
+	float MinScale = 0.85f;
+	float MaxScale = 1.15f;
+	bool bRandomRotation = true;
+	bool bSnapToSurface = true;
+	FString MaterialPath;
+	FString LabelPrefix = TEXT("ScatterProp");
+	FString OutputName;
+	FLinearColor BaseTint = FLinearColor::White;
+	float TintVariation = 0.0f;
+};
+
+static const TAgentForgeArgSchema<FScatterPropsArgs>& ScatterPropsArgSchema()
+{
+	using A = FScatterPropsArgs;
+	static const TAgentForgeArgSchema<A> Schema = TAgentForgeArgSchema<A>()
+		.String(TEXT("mesh_path"), &A::MeshPath)
+		.Float(TEXT("center_x"), &A::CenterX)
+		.Float(TEXT("center_y"), &A::CenterY)
+		.Float(TEXT("z"), &A::BaseZ)
+		.Float(TEXT("radius"), &A::Radius)
+		.Int(TEXT("count"), &A::Count)
+		.Float(TEXT("min_scale"), &A::MinScale)
+		.Float(TEXT("max_scale"), &A::MaxScale)
+		.Bool(TEXT("random_rotation"), &A::bRandomRotation)
+		.Bool(TEXT("snap_to_surface"), &A::bSnapToSurface)
+		.String(TEXT("material_path"), &A::MaterialPath)
+		.String(TEXT("label_prefix"), &A::LabelPrefix)
+		.String(TEXT("output"), &A::OutputName)
+		.Custom(TEXT("tint"), [](A& Out, const TSharedPtr<FJsonValue>& Value)
+		{
+			const TSharedPtr<FJsonObject>* TintObj = nullptr;
+			if (!Value.IsValid() || !Value->TryGetObject(TintObj) || !TintObj || !TintObj->IsValid())
+			{
+				return false;
+			}
+			double R = 1.0, G = 1.0, B = 1.0;
+			(*TintObj)->TryGetNumberField(TEXT("r"), R);
+			(*TintObj)->TryGetNumberField(TEXT("g"), G);
+			(*TintObj)->TryGetNumberField(TEXT("b"), B);
+			Out.BaseTint = FLinearColor((float)R, (float)G, (float)B);
+			return true;
+		})
+		.Float(TEXT("tint_variation"), &A::TintVariation).Range(0.0, 1.0);
+	return Schema;
+}
+
 FString UAgentForgeLibrary::Cmd_ScatterProps(const TSharedPtr<FJsonObject>& Args)
 {
 #if WITH_EDITOR
-	FString MeshPath;
-	Args->TryGetStringField(TEXT("mesh_path"), MeshPath);
+	FScatterPropsArgs Parsed;
+	FAgentForgeArgReport ArgReport;
+	ScatterPropsArgSchema().Bind(Args, Parsed, &ArgReport);
+	const FString& MeshPath = Parsed.MeshPath;
 	if (MeshPath.IsEmpty())
 	{
 		return ErrorResponse(TEXT("scatter_props requires mesh_path."));
 	}
 
-	const float CenterX = Args->HasField(TEXT("center_x")) ? (float)Args->GetNumberField(TEXT("center_x")) : 0.0f;
-	const float CenterY = Args->HasField(TEXT("center_y")) ? (float)Args->GetNumberField(TEXT("center_y")) : 0.0f;
-	const float BaseZ = Args->HasField(TEXT("z")) ? (float)Args->GetNumberField(TEXT("z")) : 0.0f;
-	const float Radius = Args->HasField(TEXT("radius")) ? (float)Args->GetNumberField(TEXT("radius")) : 250.0f;
-	const int32 Count = Args->HasField(TEXT("count")) ? (int32)Args->GetNumberField(TEXT("count")) : 8;
-	const float MinScale = Args->HasField(TEXT("min_scale")) ? (float)Args->GetNumberField(TEXT("min_scale")) : 0.85f;
-	const float MaxScale = Args->HasField(TEXT("max_scale")) ? (float)Args->GetNumberField(TEXT("max_scale")) : 1.15f;
-	const bool bRandomRotation = !Args->HasField(TEXT("random_rotation")) || Args->GetBoolField(TEXT("random_rotation"));
-	const bool bSnapToSurface = !Args->HasField(TEXT("snap_to_surface")) || Args->GetBoolField(TEXT("snap_to_surface"));
-	FString MaterialPath;
-	FString LabelPrefix = TEXT("ScatterProp");
-	Args->TryGetStringField(TEXT("material_path"), MaterialPath);
-	Args->TryGetStringField(TEXT("label_prefix"), LabelPrefix);
+	const float CenterX = Parsed.CenterX;
+	const float CenterY = Parsed.CenterY;
+	const float BaseZ = Parsed.BaseZ;
+	const float Radius = Parsed.Radius;
+	const int32 Count = Parsed.Count;
+	const float MinScale = Parsed.MinScale;
+	const float MaxScale = Parsed.MaxScale;
+	const bool bRandomRotation = Parsed.bRandomRotation;
+	const bool bSnapToSurface = Parsed.bSnapToSurface;
+	const FString& MaterialPath = Parsed.MaterialPath;
+	const FString& LabelPrefix = Parsed.LabelPrefix;
+
+	EAgentForgeScatterOutput Output = EAgentForgeScatterOutput::Actors;
+	if (!FAgentForgeInstancedScatter::ParseOutput(Parsed.OutputName, Output))
+	{
+		return ErrorResponse(FString::Printf(TEXT("Unknown output '%s' (expected actors or instances)."), *Parsed.OutputName));
+	}
+
+	// Per-instance tint (instances output only): base colour, randomly darkened by up to tint_variation.
+	const FLinearColor BaseTint = Parsed.BaseTint;
+	const float TintVariation = Parsed.TintVariation;
 
 	if (Radius <= KINDA_SMALL_NUMBER)
 	{
@@ -6224,6 +6954,7 @@ FString UAgentForgeLibrary::Cmd_ScatterProps(const TSharedPtr<FJsonObject>& Args
 
 	UWorld* World = GetEditorWorld();
 	if (!World) { return ErrorResponse(TEXT("No editor world.")); }
+	FAgentForgeSpawnBatch SpawnBatch(World);
 
 	FString GroupError;
 	AActor* GroupActor = SpawnGroupActor(
@@ -6242,28 +6973,102 @@ FString UAgentForgeLibrary::Cmd_ScatterProps(const TSharedPtr<FJsonObject>& Args
 	SpawnedActors.Reserve(Count);
 	int32 SnappedCount = 0;
 
+	// Draw every placement first so the surface queries go out as one batch.
+	TArray<FVector> Offsets;
+	TArray<float> Scales;
+	TArray<FRotator> Rotations;
+	Offsets.Reserve(Count);
+	Scales.Reserve(Count);
+	Rotations.Reserve(Count);
 	for (int32 Index = 0; Index < Count; ++Index)
 	{
 		const float Angle = FMath::FRandRange(0.0f, 2.0f * PI);
 		const float Distance = FMath::Sqrt(FMath::FRand()) * Radius;
-		const FVector XYOffset(FMath::Cos(Angle) * Distance, FMath::Sin(Angle) * Distance, 0.0f);
-		const float UniformScale = FMath::FRandRange(MinScale, MaxScale);
-		const float HalfHeight = BaseExtentZ * UniformScale;
+		Offsets.Add(FVector(FMath::Cos(Angle) * Distance, FMath::Sin(Angle) * Distance, 0.0f));
+		Scales.Add(FMath::FRandRange(MinScale, MaxScale));
+		Rotations.Add(bRandomRotation
+			? FRotator(0.0f, FMath::FRandRange(0.0f, 360.0f), 0.0f)
+			: FRotator::ZeroRotator);
+	}
 
-		FVector SpawnLocation = ScatterCenter + XYOffset + FVector(0.0f, 0.0f, HalfHeight);
-		if (bSnapToSurface)
+	TArray<FSurfaceSample> Surface;
+	if (bSnapToSurface)
+	{
+		TArray<FVector> Queries;
+		Queries.Reserve(Count);
+		for (const FVector& XYOffset : Offsets)
 		{
-			FVector HitLocation;
-			if (RaycastDownToSurface(World, ScatterCenter + XYOffset, BaseZ, HitLocation))
-			{
-				SpawnLocation = HitLocation + FVector(0.0f, 0.0f, HalfHeight);
-				++SnappedCount;
-			}
+			Queries.Add(ScatterCenter + XYOffset);
 		}
+		FSurfaceTraceSettings Settings;
+		Settings.UpExtent = 5000.0f;
+		Settings.DownExtent = 5000.0f;
+		FAgentForgeSurfaceTrace::Get().TraceDown(World, Queries, Settings, FCollisionQueryParams(SCENE_QUERY_STAT(AgentForgeScatterSurfaceTrace), true), Surface);
+	}
 
-		const FRotator Rotation = bRandomRotation
-			? FRotator(0.0f, FMath::FRandRange(0.0f, 360.0f), 0.0f)
-			: FRotator::ZeroRotator;
+	TArray<FVector> SpawnLocations;
+	SpawnLocations.Reserve(Count);
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		const float HalfHeight = BaseExtentZ * Scales[Index];
+		FVector SpawnLocation = ScatterCenter + Offsets[Index] + FVector(0.0f, 0.0f, HalfHeight);
+		if (bSnapToSurface && Surface[Index].bHit)
+		{
+			SpawnLocation = Surface[Index].Location + FVector(0.0f, 0.0f, HalfHeight);
+			++SnappedCount;
+		}
+		SpawnLocations.Add(SpawnLocation);
+	}
+
+	if (Output == EAgentForgeScatterOutput::Instances)
+	{
+		UMaterialInterface* Material = nullptr;
+		FString MaterialError;
+		if (!LoadOptionalMaterial(MaterialPath, Material, MaterialError))
+		{
+			return ErrorResponse(MaterialError);
+		}
+
+		UHierarchicalInstancedStaticMeshComponent* Instances =
+			FAgentForgeInstancedScatter::FindOrAddComponent(GroupActor, Mesh, Material);
+		if (!Instances)
+		{
+			return ErrorResponse(TEXT("Failed to create instanced static mesh component."));
+		}
+
+		FAgentForgeInstanceBatch Batch;
+		Batch.Reserve(Count);
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			const float Shade = 1.0f - FMath::FRandRange(0.0f, TintVariation);
+			Batch.Add(
+				FTransform(Rotations[Index], SpawnLocations[Index], FVector(Scales[Index])),
+				FLinearColor(BaseTint.R * Shade, BaseTint.G * Shade, BaseTint.B * Shade),
+				Scales[Index]);
+		}
+		FAgentForgeInstancedScatter::AddInstances(Instances, Batch);
+
+		TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
+		Root->SetBoolField(TEXT("ok"), true);
+		Root->SetStringField(TEXT("output"), FAgentForgeInstancedScatter::OutputName(Output));
+		Root->SetStringField(TEXT("group_name"), GroupActor->GetActorLabel());
+		Root->SetStringField(TEXT("group_object_path"), GroupActor->GetPathName());
+		Root->SetStringField(TEXT("mesh_path"), MeshPath);
+		Root->SetStringField(TEXT("component_name"), Instances->GetName());
+		Root->SetNumberField(TEXT("instance_count"), Batch.Num());
+		Root->SetNumberField(TEXT("custom_data_floats"), FAgentForgeInstancedScatter::NumCustomData);
+		Root->SetNumberField(TEXT("child_count"), 0);
+		Root->SetNumberField(TEXT("radius"), Radius);
+		Root->SetNumberField(TEXT("snapped_count"), SnappedCount);
+		ArgReport.AppendTo(Root);
+		return ToJsonString(Root);
+	}
+
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		const float UniformScale = Scales[Index];
+		const FVector& SpawnLocation = SpawnLocations[Index];
+		const FRotator& Rotation = Rotations[Index];
 
 		FString SpawnError;
 		AStaticMeshActor* PropActor = SpawnStaticMeshPrimitiveActor(
@@ -6292,6 +7097,7 @@ FString UAgentForgeLibrary::Cmd_ScatterProps(const TSharedPtr<FJsonObject>& Args
 
 	TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
 	Root->SetBoolField(TEXT("ok"), true);
+	Root->SetStringField(TEXT("output"), FAgentForgeInstancedScatter::OutputName(Output));
 	Root->SetStringField(TEXT("group_name"), GroupActor->GetActorLabel());
 	Root->SetStringField(TEXT("group_object_path"), GroupActor->GetPathName());
 	Root->SetStringField(TEXT("mesh_path"), MeshPath);
@@ -6299,6 +7105,7 @@ FString UAgentForgeLibrary::Cmd_ScatterProps(const TSharedPtr<FJsonObject>& Args
 	Root->SetNumberField(TEXT("radius"), Radius);
 	Root->SetNumberField(TEXT("snapped_count"), SnappedCount);
 	Root->SetArrayField(TEXT("children"), ActorArray);
+	ArgReport.AppendTo(Root);
 	return ToJsonString(Root);
 #else
 	return ErrorResponse(TEXT("Editor only."));
@@ -7462,31 +8269,32 @@ FString UAgentForgeLibrary::Cmd_CreateSnapshot(const TSharedPtr<FJsonObject>& Ar
 {
 #if WITH_EDITOR
 	FString SnapshotName;
-	if (Args.IsValid()) { Args->TryGetStringField(TEXT("snapshot_name"), SnapshotName); }
+	bool bExportJson = false;
+	if (Args.IsValid())
+	{
+		Args->TryGetStringField(TEXT("snapshot_name"), SnapshotName);
+		Args->TryGetBoolField(TEXT("json"), bExportJson);
+	}
 	if (SnapshotName.IsEmpty()) { SnapshotName = TEXT("snapshot"); }
 
-	UVerificationEngine* VE = UVerificationEngine::Get();
-	const FString Path = VE ? VE->CreateSnapshot(SnapshotName) : FString();
+	UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+	if (!World) { return ErrorResponse(TEXT("Snapshot creation failed.")); }
 
+	FAgentForgeWorldSnapshotPtr Snapshot = MakeShared<FAgentForgeWorldSnapshot, ESPMode::ThreadSafe>(
+		FAgentForgeWorldSnapshot::Capture(World, SnapshotName));
+	FString JsonPath;
+	const FString Path = FAgentForgeSnapshotStore::Get().Write(Snapshot, bExportJson, &JsonPath);
 	if (Path.IsEmpty()) { return ErrorResponse(TEXT("Snapshot creation failed.")); }
 
-	// Count actors
-	int32 ActorCount = 0;
-#if WITH_EDITOR
-	UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
-	if (World)
-	{
-		for (TActorIterator<AActor> It(World); It; ++It)
-		{
-			if (*It && IsValid(*It)) { ++ActorCount; }
-		}
-	}
-#endif
-
 	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
 	Obj->SetBoolField  (TEXT("ok"),          true);
 	Obj->SetStringField(TEXT("path"),        Path);
-	Obj->SetNumberField(TEXT("actor_count"), ActorCount);
+	Obj->SetNumberField(TEXT("actor_count"), Snapshot->Actors.Num());
+	Obj->SetNumberField(TEXT("strings"),     Snapshot->Strings.Num());
+	if (bExportJson)
+	{
+		Obj->SetStringField(TEXT("json_path"), JsonPath);
+	}
 	return ToJsonString(Obj);
 #else
 	return ErrorResponse(TEXT("Editor only."));
@@ -7514,17 +8322,15 @@ FString UAgentForgeLibrary::Cmd_ExecutePython(const TSharedPtr<FJsonObject>& Arg
 		return ErrorResponse(TEXT("execute_python script too large (>500000 chars). Use smaller chunked scripts."));
 	}
 
-	float UsedPctBefore = 0.0f;
-	float AvailMBBefore = 0.0f;
-	if (IsLowMemory(UsedPctBefore, AvailMBBefore))
+	// ExecuteCommandJson already guarded this call; this covers execute_batch entries.
+	FAgentForgeMemoryMonitor& Memory = FAgentForgeMemoryMonitor::Get();
+	if (Memory.IsUnderPressure())
 	{
-		CollectGarbage(RF_NoFlags, true);
-		if (IsLowMemory(UsedPctBefore, AvailMBBefore))
-		{
-			return ErrorResponse(FString::Printf(
-				TEXT("Memory guard triggered before execute_python: available %.0f MB, used %.1f%%."),
-				AvailMBBefore, UsedPctBefore));
-		}
+		Memory.RequestGarbageCollection();
+		const FAgentForgeMemorySample Sample = Memory.GetSample();
+		return ErrorResponse(FString::Printf(
+			TEXT("Memory guard triggered before execute_python: available %.0f MB, used %.1f%%. A garbage collection is scheduled between commands; retry after it."),
+			Sample.AvailableMB, Sample.UsedPercent()));
 	}
 
 	IPythonScriptPlugin* Python = IPythonScriptPlugin::Get();
@@ -7554,17 +8360,15 @@ FString UAgentForgeLibrary::Cmd_ExecutePython(const TSharedPtr<FJsonObject>& Arg
 		bDidPyGc = Python->ExecPythonCommandEx(GcCmd);
 	}
 
+	// UE garbage collection is scheduled between commands, never run inline.
 	bool bForceUeGc = false;
 	if (Args.IsValid()) { Args->TryGetBoolField(TEXT("force_ue_gc"), bForceUeGc); }
-	float UsedPctAfter = 0.0f;
-	float AvailMBAfter = 0.0f;
-	const bool bLowAfter = IsLowMemory(UsedPctAfter, AvailMBAfter);
-	bool bDidUeGc = false;
-	if (bOk && !IsEngineShuttingDown() && (bForceUeGc || bLowAfter))
+	const FAgentForgeMemorySample After = Memory.GetSample();
+	bool bUeGcScheduled = false;
+	if (bOk && !IsEngineShuttingDown() && (bForceUeGc || Memory.IsUnderPressure()))
 	{
-		CollectGarbage(RF_NoFlags, true);
-		bDidUeGc = true;
-		IsLowMemory(UsedPctAfter, AvailMBAfter);
+		Memory.RequestGarbageCollection();
+		bUeGcScheduled = true;
 	}
 
 	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
@@ -7572,9 +8376,9 @@ FString UAgentForgeLibrary::Cmd_ExecutePython(const TSharedPtr<FJsonObject>& Arg
 	Obj->SetStringField(TEXT("output"), bOk ? PyCmd.CommandResult : TEXT(""));
 	Obj->SetStringField(TEXT("errors"), bOk ? TEXT("") : PyCmd.CommandResult);
 	Obj->SetBoolField  (TEXT("py_gc_after"), bDidPyGc);
-	Obj->SetBoolField  (TEXT("ue_gc_after"), bDidUeGc);
-	Obj->SetNumberField(TEXT("mem_used_percent"), UsedPctAfter);
-	Obj->SetNumberField(TEXT("mem_available_mb"), AvailMBAfter);
+	Obj->SetBoolField  (TEXT("ue_gc_scheduled"), bUeGcScheduled);
+	Obj->SetNumberField(TEXT("mem_used_percent"), After.UsedPercent());
+	Obj->SetNumberField(TEXT("mem_available_mb"), After.AvailableMB);
 	return ToJsonString(Obj);
 #else
 	return ErrorResponse(TEXT("Editor only."));
@@ -7584,6 +8388,87 @@ FString UAgentForgeLibrary::Cmd_ExecutePython(const TSharedPtr<FJsonObject>& Arg
 // ============================================================================
 //  PERFORMANCE PROFILING
 // ============================================================================
+FString UAgentForgeLibrary::Cmd_GetCommandMetrics(const TSharedPtr<FJsonObject>& Args)
+{
+	FString Only;
+	bool bReset = false;
+	if (Args.IsValid())
+	{
+		Args->TryGetStringField(TEXT("cmd"), Only);
+		Args->TryGetBoolField(TEXT("reset"), bReset);
+	}
+	Only.ToLowerInline();
+
+	FAgentForgeCommandMetrics& Metrics = FAgentForgeCommandMetrics::Get();
+	TSharedPtr<FJsonObject> Obj = Metrics.GetMetricsJson(Only);
+	Obj->SetBoolField(TEXT("ok"), true);
+	if (bReset)
+	{
+		// This call is recorded after the reset, as the first entry of the new period.
+		Metrics.Reset();
+		Obj->SetBoolField(TEXT("reset"), true);
+	}
+	return ToJsonString(Obj);
+}
+
+FString UAgentForgeLibrary::Cmd_StartCommandTrace(const TSharedPtr<FJsonObject>& Args)
+{
+	FString Error;
+	if (!FAgentForgeCommandTrace::Get().Start(FAgentForgeTraceRecordSettings::FromJson(Args), Error))
+	{
+		return ErrorResponse(Error);
+	}
+	TSharedPtr<FJsonObject> Obj = FAgentForgeCommandTrace::Get().GetStatsJson();
+	Obj->SetBoolField(TEXT("ok"), true);
+	return ToJsonString(Obj);
+}
+
+FString UAgentForgeLibrary::Cmd_StopCommandTrace()
+{
+	FAgentForgeCommandTrace& Trace = FAgentForgeCommandTrace::Get();
+	const bool bWasRecording = Trace.IsRecording();
+	Trace.Stop();
+	TSharedPtr<FJsonObject> Obj = Trace.GetStatsJson();
+	Obj->SetBoolField(TEXT("ok"), true);
+	Obj->SetBoolField(TEXT("was_recording"), bWasRecording);
+	return ToJsonString(Obj);
+}
+
+FString UAgentForgeLibrary::Cmd_GetFarmStatus(const TSharedPtr<FJsonObject>& Args)
+{
+	FString Spool = FAgentForgeWorkerFarm::GetDefaultSpool();
+	FString CacheName;
+	EProceduralCacheMode ImportMode = EProceduralCacheMode::Disk;
+	if (Args.IsValid())
+	{
+		Args->TryGetStringField(TEXT("spool"), Spool);
+		Args->TryGetStringField(TEXT("cache"), CacheName);
+	}
+	if (!CacheName.IsEmpty() && (!FAgentForgeProceduralCache::ParseMode(CacheName, ImportMode) || ImportMode == EProceduralCacheMode::Off))
+	{
+		return ErrorResponse(FString::Printf(TEXT("Unknown cache '%s' (memory|disk)."), *CacheName));
+	}
+
+	FAgentForgeWorkerFarm& Farm = FAgentForgeWorkerFarm::Get();
+	const int32 Imported = Farm.Collect(Spool, ImportMode);
+	TSharedPtr<FJsonObject> Obj = FAgentForgeWorkerFarm::GetSpoolJson(Spool);
+	Obj->SetBoolField(TEXT("ok"), true);
+	Obj->SetNumberField(TEXT("imported_now"), Imported);
+
+	const TArray<TSharedPtr<FJsonValue>>* JobIds = nullptr;
+	if (Args.IsValid() && Args->TryGetArrayField(TEXT("job_ids"), JobIds))
+	{
+		TArray<TSharedPtr<FJsonValue>> Jobs;
+		for (const TSharedPtr<FJsonValue>& Id : *JobIds)
+		{
+			Jobs.Add(MakeShared<FJsonValueObject>(Farm.GetJobJson(Id.IsValid() ? Id->AsString() : FString())));
+		}
+		Obj->SetArrayField(TEXT("jobs"), Jobs);
+	}
+	Obj->SetObjectField(TEXT("session"), Farm.GetStatsJson());
+	return ToJsonString(Obj);
+}
+
 FString UAgentForgeLibrary::Cmd_GetPerfStats()
 {
 #if WITH_EDITOR
@@ -7592,14 +8477,9 @@ FString UAgentForgeLibrary::Cmd_GetPerfStats()
 	int32 ActorCount = 0, ComponentCount = 0;
 	if (World)
 	{
-		for (TActorIterator<AActor> It(World); It; ++It)
-		{
-			if (*It && IsValid(*It))
-			{
-				++ActorCount;
-				ComponentCount += (*It)->GetComponents().Num();
-			}
-		}
+		const FAgentForgeWorldStats::FStats Stats = FAgentForgeWorldStats::Get().Gather(World);
+		ActorCount     = Stats.Actors;
+		ComponentCount = Stats.Components;
 	}
 
 	const FPlatformMemoryStats MemStats = FPlatformMemory::GetStats();
@@ -7681,42 +8561,225 @@ FString UAgentForgeLibrary::Cmd_RunVerification(const TSharedPtr<FJsonObject>& A
 		Obj->SetStringField(TEXT("error"), TEXT("No runnable manual verification phases were selected."));
 	}
 
-	VE->LastVerificationResult = ToJsonString(Obj);
-	return VE->LastVerificationResult;
+	VE->LastVerificationResult = ToJsonString(Obj);
+	return VE->LastVerificationResult;
+}
+
+FString UAgentForgeLibrary::Cmd_EnforceConstitution(const TSharedPtr<FJsonObject>& Args)
+{
+	FString ActionDesc;
+	if (Args.IsValid()) { Args->TryGetStringField(TEXT("action_description"), ActionDesc); }
+
+	TArray<FString> Violations;
+	TArray<FString> ViolationList;
+	const bool bAllowed = EnforceConstitution(ActionDesc, ViolationList);
+
+	TArray<TSharedPtr<FJsonValue>> VArr;
+	for (const FString& V : ViolationList)
+	{
+		VArr.Add(MakeShared<FJsonValueString>(V));
+	}
+
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetBoolField (TEXT("allowed"),    bAllowed);
+	Obj->SetArrayField(TEXT("violations"), VArr);
+	return ToJsonString(Obj);
+}
+
+FString UAgentForgeLibrary::Cmd_GetForgeStatus()
+{
+	UConstitutionParser* Parser = UConstitutionParser::Get();
+	UVerificationEngine* VE     = UVerificationEngine::Get();
+
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetStringField(TEXT("version"),                   TEXT("0.5.0"));
+	Obj->SetBoolField  (TEXT("constitution_loaded"),       Parser && Parser->IsLoaded());
+	Obj->SetNumberField(TEXT("constitution_rules_loaded"), Parser ? Parser->GetRules().Num() : 0);
+	Obj->SetStringField(TEXT("constitution_path"),         Parser ? Parser->GetConstitutionPath() : TEXT(""));
+	Obj->SetNumberField(TEXT("constitution_matcher_states"), Parser ? Parser->GetMatcherStateCount() : 0);
+	Obj->SetNumberField(TEXT("constitution_reloads"),      Parser ? Parser->GetReloadCount() : 0);
+	Obj->SetStringField(TEXT("last_verification"),         VE ? VE->LastVerificationResult : TEXT(""));
+	if (VE)
+	{
+		Obj->SetObjectField(TEXT("verification"),          VE->GetStatsJson());
+	}
+	Obj->SetNumberField(TEXT("pending_jobs"),              FAgentForgeJobManager::Get().NumPendingJobs());
+	Obj->SetObjectField(TEXT("command_queue"),             FAgentForgeCommandQueue::Get().GetStatsJson());
+	Obj->SetObjectField(TEXT("idempotency"),               FAgentForgeRequestEnvelope::Get().GetStatsJson());
+	Obj->SetObjectField(TEXT("command_metrics"),           FAgentForgeCommandMetrics::Get().GetStatsJson());
+	Obj->SetObjectField(TEXT("command_trace"),             FAgentForgeCommandTrace::Get().GetStatsJson());
+	Obj->SetObjectField(TEXT("memory_guard"),              FAgentForgeMemoryMonitor::Get().GetStatsJson());
+	Obj->SetObjectField(TEXT("worker_farm"),               FAgentForgeWorkerFarm::Get().GetStatsJson());
+	Obj->SetObjectField(TEXT("socket_server"),             FAgentForgeSocketServer::Get().GetStatusJson());
+	Obj->SetObjectField(TEXT("actor_index"),               FAgentForgeActorIndex::Get().GetStatsJson());
+	Obj->SetObjectField(TEXT("procedural_cache"),          FAgentForgeProceduralCache::Get().GetStatsJson());
+	Obj->SetObjectField(TEXT("surface_trace"),             FAgentForgeSurfaceTrace::Get().GetStatsJson());
+	Obj->SetObjectField(TEXT("light_grid"),                FAgentForgeLightGrid::Get().GetStatsJson());
+	Obj->SetObjectField(TEXT("world_stats"),               FAgentForgeWorldStats::Get().GetStatsJson());
+	Obj->SetObjectField(TEXT("spawn_batch"),               FAgentForgeSpawnBatch::GetStatsJson());
+	Obj->SetObjectField(TEXT("asset_catalog"),             FAgentForgeAssetCatalog::Get().GetStatsJson());
+	Obj->SetObjectField(TEXT("palette_cache"),             FPaletteManager::GetStatsJson());
+	Obj->SetObjectField(TEXT("preset_store"),              FLevelPresetSystem::GetStatsJson());
+	Obj->SetObjectField(TEXT("fab"),                       FFabIntegrationModule::GetStatsJson());
+	Obj->SetObjectField(TEXT("vision_images"),             FAgentForgeImageEncoder::Get().GetStatsJson());
+	Obj->SetObjectField(TEXT("vision_cache"),              FAgentForgeVisionCache::Get().GetStatsJson());
+	if (UAgentForgeLLMSubsystem* LLM = GEditor ? GEditor->GetEditorSubsystem<UAgentForgeLLMSubsystem>() : nullptr)
+	{
+		Obj->SetObjectField(TEXT("llm"),                   LLM->GetStatsJson());
+	}
+	Obj->SetObjectField(TEXT("llm_cache"),                 FAgentForgeLLMResponseCache::Get().GetStatsJson());
+	Obj->SetObjectField(TEXT("schema_registry"),           FAgentForgeSchemaRegistry::Get().GetStatsJson());
+	Obj->SetObjectField(TEXT("snapshots"),                 FAgentForgeSnapshotStore::Get().GetStatsJson());
+	return ToJsonString(Obj);
+}
+
+FString UAgentForgeLibrary::Cmd_StartSocketServer(const TSharedPtr<FJsonObject>& Args)
+{
+	int32 Port = FAgentForgeSocketServer::DefaultPort;
+	FString BindAddress = TEXT("127.0.0.1");
+	if (Args.IsValid())
+	{
+		if (Args->HasField(TEXT("port"))) { Port = (int32)Args->GetNumberField(TEXT("port")); }
+		Args->TryGetStringField(TEXT("bind_address"), BindAddress);
+	}
+
+	FString Error;
+	if (!FAgentForgeSocketServer::Get().Start(Port, BindAddress, Error))
+	{
+		return ErrorResponse(Error);
+	}
+	TSharedPtr<FJsonObject> Obj = FAgentForgeSocketServer::Get().GetStatusJson();
+	Obj->SetBoolField(TEXT("ok"), true);
+	return ToJsonString(Obj);
+}
+
+FString UAgentForgeLibrary::Cmd_StopSocketServer(const TSharedPtr<FJsonObject>& Args)
+{
+	FAgentForgeSocketServer::Get().Stop();
+	return OkResponse(TEXT("Socket server stopping."));
+}
+
+FString UAgentForgeLibrary::Cmd_SetCommandQueuePolicy(const TSharedPtr<FJsonObject>& Args)
+{
+	FAgentForgeCommandQueue& Queue = FAgentForgeCommandQueue::Get();
+	if (Args.IsValid())
+	{
+		double BudgetMs = 0.0;
+		if (Args->TryGetNumberField(TEXT("frame_budget_ms"), BudgetMs))
+		{
+			Queue.SetFrameBudgetMs(static_cast<float>(BudgetMs));
+		}
+		bool bCoalesce = true;
+		if (Args->TryGetBoolField(TEXT("coalesce_read_only"), bCoalesce))
+		{
+			Queue.SetCoalesceEnabled(bCoalesce);
+		}
+	}
+
+	TSharedPtr<FJsonObject> Obj = Queue.GetStatsJson();
+	Obj->SetBoolField(TEXT("ok"), true);
+	return ToJsonString(Obj);
+}
+
+FString UAgentForgeLibrary::Cmd_SetVerificationPolicy(const TSharedPtr<FJsonObject>& Args)
+{
+	UVerificationEngine* VE = UVerificationEngine::Get();
+	if (!VE) { return ErrorResponse(TEXT("Verification engine unavailable.")); }
+
+	FString ScopeName;
+	if (Args.IsValid() && Args->TryGetStringField(TEXT("rollback_scope"), ScopeName))
+	{
+		EVerificationRollbackScope Scope;
+		if (!UVerificationEngine::ParseRollbackScope(ScopeName, Scope))
+		{
+			return ErrorResponse(FString::Printf(TEXT("Unknown rollback_scope '%s' (scoped|full)."), *ScopeName));
+		}
+		VE->SetRollbackScope(Scope);
+	}
+
+	TSharedPtr<FJsonObject> Obj = VE->GetStatsJson();
+	Obj->SetBoolField(TEXT("ok"), true);
+	return ToJsonString(Obj);
 }
 
-FString UAgentForgeLibrary::Cmd_EnforceConstitution(const TSharedPtr<FJsonObject>& Args)
+FString UAgentForgeLibrary::Cmd_GetJobStatus(const TSharedPtr<FJsonObject>& Args)
 {
-	FString ActionDesc;
-	if (Args.IsValid()) { Args->TryGetStringField(TEXT("action_description"), ActionDesc); }
+	FString JobId;
+	bool bIncludePartial = true;
+	if (Args.IsValid())
+	{
+		Args->TryGetStringField(TEXT("job_id"), JobId);
+		Args->TryGetBoolField(TEXT("include_partial"), bIncludePartial);
+	}
 
-	TArray<FString> Violations;
-	TArray<FString> ViolationList;
-	const bool bAllowed = EnforceConstitution(ActionDesc, ViolationList);
+	FAgentForgeJobManager& Jobs = FAgentForgeJobManager::Get();
+	if (!JobId.IsEmpty())
+	{
+		const TSharedPtr<FAgentForgeJob> Job = Jobs.Find(JobId);
+		if (!Job.IsValid())
+		{
+			return ErrorResponse(FString::Printf(TEXT("Unknown job_id: %s"), *JobId));
+		}
+		TSharedPtr<FJsonObject> Obj = Job->ToJson(bIncludePartial, true);
+		Obj->SetBoolField(TEXT("ok"), true);
+		return ToJsonString(Obj);
+	}
 
-	TArray<TSharedPtr<FJsonValue>> VArr;
-	for (const FString& V : ViolationList)
+	// No job_id: compact listing without partial results or final payloads.
+	TArray<TSharedPtr<FJsonValue>> JobArr;
+	for (const TSharedRef<FAgentForgeJob>& Job : Jobs.GetJobs())
 	{
-		VArr.Add(MakeShared<FJsonValueString>(V));
+		JobArr.Add(MakeShared<FJsonValueObject>(Job->ToJson(false, false)));
 	}
 
 	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
-	Obj->SetBoolField (TEXT("allowed"),    bAllowed);
-	Obj->SetArrayField(TEXT("violations"), VArr);
+	Obj->SetBoolField  (TEXT("ok"),           true);
+	Obj->SetNumberField(TEXT("pending_jobs"), Jobs.NumPendingJobs());
+	Obj->SetNumberField(TEXT("count"),        JobArr.Num());
+	Obj->SetArrayField (TEXT("jobs"),         JobArr);
 	return ToJsonString(Obj);
 }
 
-FString UAgentForgeLibrary::Cmd_GetForgeStatus()
+FString UAgentForgeLibrary::Cmd_CancelJob(const TSharedPtr<FJsonObject>& Args)
 {
-	UConstitutionParser* Parser = UConstitutionParser::Get();
-	UVerificationEngine* VE     = UVerificationEngine::Get();
+	FString JobId;
+	if (!Args.IsValid() || !Args->TryGetStringField(TEXT("job_id"), JobId) || JobId.IsEmpty())
+	{
+		return ErrorResponse(TEXT("Missing 'job_id' field."));
+	}
+
+	FString Error;
+	if (!FAgentForgeJobManager::Get().Cancel(JobId, Error))
+	{
+		return ErrorResponse(Error);
+	}
+
+	const TSharedPtr<FAgentForgeJob> Job = FAgentForgeJobManager::Get().Find(JobId);
+	TSharedPtr<FJsonObject> Obj = Job.IsValid() ? Job->ToJson(true, false) : MakeShared<FJsonObject>();
+	Obj->SetBoolField  (TEXT("ok"),     true);
+	Obj->SetStringField(TEXT("job_id"), JobId);
+	return ToJsonString(Obj);
+}
+
+FString UAgentForgeLibrary::Cmd_ListCommands(const TSharedPtr<FJsonObject>& Args)
+{
+	FString Category;
+	if (Args.IsValid()) { Args->TryGetStringField(TEXT("category"), Category); }
+
+	FAgentForgeCommandRegistry& Registry = FAgentForgeCommandRegistry::Get();
+	if (Registry.IsEmpty()) { RegisterBuiltinCommands(); }
+
+	TArray<TSharedPtr<FJsonValue>> CmdArr;
+	for (const FAgentForgeCommandInfo* Info : Registry.GetCommands(Category))
+	{
+		CmdArr.Add(MakeShared<FJsonValueObject>(Info->ToJson()));
+	}
 
 	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
-	Obj->SetStringField(TEXT("version"),                   TEXT("0.5.0"));
-	Obj->SetBoolField  (TEXT("constitution_loaded"),       Parser && Parser->IsLoaded());
-	Obj->SetNumberField(TEXT("constitution_rules_loaded"), Parser ? Parser->GetRules().Num() : 0);
-	Obj->SetStringField(TEXT("constitution_path"),         Parser ? Parser->GetConstitutionPath() : TEXT(""));
-	Obj->SetStringField(TEXT("last_verification"),         VE ? VE->LastVerificationResult : TEXT(""));
+	Obj->SetBoolField  (TEXT("ok"),       true);
+	Obj->SetNumberField(TEXT("count"),    CmdArr.Num());
+	Obj->SetStringField(TEXT("category"), Category);
+	Obj->SetArrayField (TEXT("commands"), CmdArr);
 	return ToJsonString(Obj);
 }
 
@@ -7878,6 +8941,22 @@ FString UAgentForgeLibrary::Cmd_LLMChat(const TSharedPtr<FJsonObject>& Args)
 	{
 		Settings.Temperature = (float)Args->GetNumberField(TEXT("temperature"));
 	}
+	if (!ParseLLMRequestOptions(Args, Settings, ParseError))
+	{
+		return ErrorResponse(ParseError);
+	}
+
+	FAgentForgeLLMCandidate Primary;
+	Primary.Provider = Provider;
+	Primary.Model = Model;
+	Primary.CustomEndpoint = CustomEndpoint;
+	TArray<FAgentForgeLLMCandidate> Candidates;
+	EAgentForgeLLMFanOutMode FanOutMode;
+	double HedgeDelaySeconds;
+	if (!ParseLLMFanOutArgs(Args, Primary, Candidates, FanOutMode, HedgeDelaySeconds, ParseError))
+	{
+		return ErrorResponse(ParseError);
+	}
 
 	UAgentForgeLLMSubsystem* LLM = GEditor->GetEditorSubsystem<UAgentForgeLLMSubsystem>();
 	if (!LLM)
@@ -7885,6 +8964,12 @@ FString UAgentForgeLibrary::Cmd_LLMChat(const TSharedPtr<FJsonObject>& Args)
 		return ErrorResponse(TEXT("LLM subsystem unavailable."));
 	}
 
+	if (Candidates.Num() > 0)
+	{
+		const FAgentForgeLLMFanOutResult Result = LLM->SendFanOutRequestBlocking(MakeFanOutSettings(Settings, Candidates), FanOutMode, HedgeDelaySeconds);
+		return ToJsonString(BuildLLMFanOutObject(Result, Candidates, FanOutMode));
+	}
+
 	const FAgentForgeLLMResponse Response = LLM->SendChatRequestBlocking(Settings);
 	return ToJsonString(BuildLLMResponseObject(Response, Provider, Model));
 #else
@@ -7955,6 +9040,23 @@ FString UAgentForgeLibrary::Cmd_LLMStructured(const TSharedPtr<FJsonObject>& Arg
 	{
 		Settings.Temperature = (float)Args->GetNumberField(TEXT("temperature"));
 	}
+	FString CacheError;
+	if (!ParseLLMRequestOptions(Args, Settings, CacheError))
+	{
+		return ErrorResponse(CacheError);
+	}
+
+	FAgentForgeLLMCandidate Primary;
+	Primary.Provider = Provider;
+	Primary.Model = Model;
+	Primary.CustomEndpoint = CustomEndpoint;
+	TArray<FAgentForgeLLMCandidate> Candidates;
+	EAgentForgeLLMFanOutMode FanOutMode;
+	double HedgeDelaySeconds;
+	if (!ParseLLMFanOutArgs(Args, Primary, Candidates, FanOutMode, HedgeDelaySeconds, CacheError))
+	{
+		return ErrorResponse(CacheError);
+	}
 
 	UAgentForgeLLMSubsystem* LLM = GEditor->GetEditorSubsystem<UAgentForgeLLMSubsystem>();
 	if (!LLM)
@@ -7962,8 +9064,26 @@ FString UAgentForgeLibrary::Cmd_LLMStructured(const TSharedPtr<FJsonObject>& Arg
 		return ErrorResponse(TEXT("LLM subsystem unavailable."));
 	}
 
-	const FAgentForgeLLMResponse Response = LLM->SendStructuredRequestBlocking(Prompt, SchemaString, Settings);
-	TSharedPtr<FJsonObject> Obj = BuildLLMResponseObject(Response, Provider, Model);
+	FAgentForgeLLMResponse Response;
+	TSharedPtr<FJsonObject> Obj;
+	if (Candidates.Num() > 0)
+	{
+		// The fan-out only accepts responses that validate against the schema.
+		Settings.ResponseSchema = SchemaString;
+		FAgentForgeChatMessage PromptMessage;
+		PromptMessage.Role = TEXT("user");
+		PromptMessage.Content = Prompt;
+		Settings.Messages.Add(PromptMessage);
+
+		const FAgentForgeLLMFanOutResult Result = LLM->SendFanOutRequestBlocking(MakeFanOutSettings(Settings, Candidates), FanOutMode, HedgeDelaySeconds);
+		Response = Result.HasWinner() ? Result.Responses[Result.WinnerIndex] : Result.Responses[0];
+		Obj = BuildLLMFanOutObject(Result, Candidates, FanOutMode);
+	}
+	else
+	{
+		Response = LLM->SendStructuredRequestBlocking(Prompt, SchemaString, Settings);
+		Obj = BuildLLMResponseObject(Response, Provider, Model);
+	}
 
 	TSharedPtr<FJsonObject> StructuredObject;
 	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Response.Content);
@@ -7983,73 +9103,91 @@ FString UAgentForgeLibrary::Cmd_LLMStream(const TSharedPtr<FJsonObject>& Args)
 #if WITH_EDITOR
 	if (!GEditor) { return ErrorResponse(TEXT("GEditor null.")); }
 
-	FString ProviderString;
-	FString Model;
-	FString SystemPrompt;
-	FString CustomEndpoint;
-	if (!Args.IsValid() || !Args->TryGetStringField(TEXT("provider"), ProviderString))
-	{
-		return ErrorResponse(TEXT("llm_stream requires 'provider'."));
-	}
-	if (!Args->TryGetStringField(TEXT("model"), Model))
-	{
-		return ErrorResponse(TEXT("llm_stream requires 'model'."));
-	}
-	Args->TryGetStringField(TEXT("system"), SystemPrompt);
-	Args->TryGetStringField(TEXT("custom_endpoint"), CustomEndpoint);
-
-	EAgentForgeLLMProvider Provider;
-	if (!ParseLLMProviderName(ProviderString, Provider))
-	{
-		return ErrorResponse(FString::Printf(TEXT("Unknown LLM provider: %s"), *ProviderString));
-	}
-
-	TArray<FAgentForgeChatMessage> Messages;
+	TSharedRef<FLLMStreamRun> Run = MakeShared<FLLMStreamRun>();
 	FString ParseError;
-	if (!ParseChatMessages(Args, Messages, ParseError))
+	if (!ParseLLMStreamArgs(Args, Run->Settings, ParseError))
 	{
 		return ErrorResponse(ParseError);
 	}
 
-	FAgentForgeLLMSettings Settings;
-	Settings.Provider = Provider;
-	Settings.Model = Model;
-	Settings.SystemPrompt = SystemPrompt;
-	Settings.Messages = Messages;
-	Settings.CustomEndpoint = CustomEndpoint;
-	Settings.bStreamResponse = true;
-	if (Args->HasField(TEXT("max_tokens")))
-	{
-		Settings.MaxTokens = (int32)Args->GetNumberField(TEXT("max_tokens"));
-	}
-	if (Args->HasField(TEXT("temperature")))
-	{
-		Settings.Temperature = (float)Args->GetNumberField(TEXT("temperature"));
-	}
-
 	UAgentForgeLLMSubsystem* LLM = GEditor->GetEditorSubsystem<UAgentForgeLLMSubsystem>();
 	if (!LLM)
 	{
 		return ErrorResponse(TEXT("LLM subsystem unavailable."));
 	}
 
-	const FAgentForgeLLMResponse Response = LLM->SendChatRequestBlocking(Settings);
-	TSharedPtr<FJsonObject> Obj = BuildLLMResponseObject(Response, Provider, Model);
-	Obj->SetBoolField(TEXT("streamed"), true);
-
-	TArray<TSharedPtr<FJsonValue>> ChunkValues;
-	for (const FString& Chunk : ChunkTextForStream(Response.Content))
+	// Socket clients get each stream_chunk event while the request is still running.
+	Run->StartSeconds = FPlatformTime::Seconds();
+	Run->Response = LLM->SendChatRequestBlocking(Run->Settings, [Run](const FString& Chunk)
 	{
-		ChunkValues.Add(MakeShared<FJsonValueString>(Chunk));
-	}
-	Obj->SetNumberField(TEXT("chunk_count"), ChunkValues.Num());
-	Obj->SetArrayField(TEXT("chunks"), ChunkValues);
-	return ToJsonString(Obj);
+		Run->AddChunk(Chunk, nullptr);
+	});
+	return ToJsonString(Run->ToJson());
 #else
 	return ErrorResponse(TEXT("Editor only."));
 #endif
 }
 
+TSharedRef<FAgentForgeJob> UAgentForgeLibrary::MakeLLMStreamJob(const TSharedPtr<FJsonObject>& Args)
+{
+	TSharedRef<FAgentForgeJob> Job = MakeShared<FAgentForgeJob>(TEXT("llm_stream"));
+#if WITH_EDITOR
+	TSharedRef<FLLMStreamRun> Run = MakeShared<FLLMStreamRun>();
+	FString ParseError;
+	const bool bParsed = ParseLLMStreamArgs(Args, Run->Settings, ParseError);
+
+	Job->AddStage(TEXT("stream"), [Run, bParsed, ParseError](FAgentForgeJob& J)
+	{
+		if (!Run->bDispatched)
+		{
+			UAgentForgeLLMSubsystem* LLM = GEditor ? GEditor->GetEditorSubsystem<UAgentForgeLLMSubsystem>() : nullptr;
+			if (!bParsed || !LLM)
+			{
+				J.Finish(ErrorResponse(bParsed ? TEXT("LLM subsystem unavailable.") : ParseError));
+				return true;
+			}
+
+			Run->bDispatched = true;
+			Run->StartSeconds = FPlatformTime::Seconds();
+			TWeakPtr<FAgentForgeJob> WeakJob = J.AsShared();
+			Run->RequestId = LLM->SendChatRequestAsync(
+				Run->Settings,
+				[Run](const FAgentForgeLLMResponse& Response)
+				{
+					Run->Response = Response;
+					Run->bDone = true;
+				},
+				[Run, WeakJob](const FString& Chunk)
+				{
+					const TSharedPtr<FAgentForgeJob> PinnedJob = WeakJob.Pin();
+					Run->AddChunk(Chunk, PinnedJob.Get());
+				});
+		}
+
+		// Chunks and the completion arrive from the HTTP tick; nothing to do until then.
+		if (!Run->bDone)
+		{
+			J.YieldSlice();
+		}
+		return Run->bDone;
+	});
+	Job->SetCancelHandler([Run](FAgentForgeJob&)
+	{
+		if (UAgentForgeLLMSubsystem* LLM = GEditor ? GEditor->GetEditorSubsystem<UAgentForgeLLMSubsystem>() : nullptr)
+		{
+			LLM->CancelRequest(Run->RequestId);
+		}
+	});
+	Job->SetFinalizer([Run](FAgentForgeJob&) -> FString
+	{
+		return ToJsonString(Run->ToJson());
+	});
+#else
+	Job->AddStage(TEXT("stream"), [](FAgentForgeJob& J) { J.Finish(ErrorResponse(TEXT("Editor only."))); return true; });
+#endif
+	return Job;
+}
+
 FString UAgentForgeLibrary::Cmd_VisionAnalyze(const TSharedPtr<FJsonObject>& Args)
 {
 #if WITH_EDITOR
@@ -8064,6 +9202,7 @@ FString UAgentForgeLibrary::Cmd_VisionAnalyze(const TSharedPtr<FJsonObject>& Arg
 	}
 
 	const bool bMultiView = Args.IsValid() && Args->HasField(TEXT("multi_view")) && Args->GetBoolField(TEXT("multi_view"));
+	const bool bUseCache = !Args.IsValid() || !Args->HasField(TEXT("use_cache")) || Args->GetBoolField(TEXT("use_cache"));
 	EAgentForgeLLMProvider Provider;
 	FString ResolvedModel;
 	if (!ResolvePreferredVisionProviderAndModel(ProviderString, Model, Provider, ResolvedModel))
@@ -8072,11 +9211,12 @@ FString UAgentForgeLibrary::Cmd_VisionAnalyze(const TSharedPtr<FJsonObject>& Arg
 	}
 
 	const FAgentForgeLLMResponse Response = bMultiView
-		? UAgentForgeVisionAnalyzer::AnalyzeMultiViewBlocking(Prompt, Provider, ResolvedModel)
-		: UAgentForgeVisionAnalyzer::AnalyzeViewportBlocking(Prompt, Provider, ResolvedModel);
+		? UAgentForgeVisionAnalyzer::AnalyzeMultiViewBlocking(Prompt, Provider, ResolvedModel, bUseCache)
+		: UAgentForgeVisionAnalyzer::AnalyzeViewportBlocking(Prompt, Provider, ResolvedModel, bUseCache);
 
 	TSharedPtr<FJsonObject> Obj = BuildLLMResponseObject(Response, Provider, ResolvedModel);
 	Obj->SetBoolField(TEXT("multi_view"), bMultiView);
+	Obj->SetBoolField(TEXT("from_cache"), Response.bFromCache);
 	return ToJsonString(Obj);
 #else
 	return ErrorResponse(TEXT("Editor only."));
@@ -8094,6 +9234,7 @@ FString UAgentForgeLibrary::Cmd_VisionQualityScore(const TSharedPtr<FJsonObject>
 		Args->TryGetStringField(TEXT("model"), Model);
 	}
 	const bool bMultiView = Args.IsValid() && Args->HasField(TEXT("multi_view")) && Args->GetBoolField(TEXT("multi_view"));
+	const bool bUseCache = !Args.IsValid() || !Args->HasField(TEXT("use_cache")) || Args->GetBoolField(TEXT("use_cache"));
 
 	EAgentForgeLLMProvider Provider;
 	FString ResolvedModel;
@@ -8102,9 +9243,59 @@ FString UAgentForgeLibrary::Cmd_VisionQualityScore(const TSharedPtr<FJsonObject>
 		return ErrorResponse(TEXT("Unable to resolve a valid vision provider/model."));
 	}
 
-	const FAgentForgeLLMResponse Response = UAgentForgeVisionAnalyzer::RequestQualityScoreBlocking(Provider, ResolvedModel, bMultiView);
-	TSharedPtr<FJsonObject> Obj = BuildLLMResponseObject(Response, Provider, ResolvedModel);
+	FAgentForgeLLMCandidate Primary;
+	Primary.Provider = Provider;
+	Primary.Model = ResolvedModel;
+	TArray<FAgentForgeLLMCandidate> Candidates;
+	EAgentForgeLLMFanOutMode FanOutMode;
+	double HedgeDelaySeconds;
+	FString FanOutError;
+	if (!ParseLLMFanOutArgs(Args, Primary, Candidates, FanOutMode, HedgeDelaySeconds, FanOutError))
+	{
+		return ErrorResponse(FanOutError);
+	}
+
+	FAgentForgeLLMResponse Response;
+	TSharedPtr<FJsonObject> Obj;
+	TOptional<float> AggregateScore;
+	if (Candidates.Num() > 0)
+	{
+		const FAgentForgeLLMFanOutResult Result = UAgentForgeVisionAnalyzer::RequestQualityScoreFanOutBlocking(
+			Candidates, FanOutMode, HedgeDelaySeconds, bMultiView, bUseCache);
+		Response = Result.HasWinner() ? Result.Responses[Result.WinnerIndex] : Result.Responses[0];
+		Obj = BuildLLMFanOutObject(Result, Candidates, FanOutMode);
+
+		// Every accepted score goes on its row; in all mode the reported score is their median.
+		TArray<float> Scores;
+		const TArray<TSharedPtr<FJsonValue>>& Rows = Obj->GetArrayField(TEXT("fan_out"));
+		for (int32 Index = 0; Index < Rows.Num(); ++Index)
+		{
+			float CandidateScore = 0.0f;
+			FString CandidateFeedback;
+			TArray<FString> CandidateIssues;
+			TArray<FString> CandidateStrengths;
+			if (Result.Accepted[Index] && ParseVisionQualityPayload(Result.Responses[Index].Content, CandidateScore, CandidateFeedback, CandidateIssues, CandidateStrengths))
+			{
+				Rows[Index]->AsObject()->SetNumberField(TEXT("score"), CandidateScore);
+				Scores.Add(CandidateScore);
+			}
+		}
+		if (FanOutMode == EAgentForgeLLMFanOutMode::All && Scores.Num() > 0)
+		{
+			Scores.Sort();
+			const int32 Mid = Scores.Num() / 2;
+			AggregateScore = Scores.Num() % 2 ? Scores[Mid] : 0.5f * (Scores[Mid - 1] + Scores[Mid]);
+			Obj->SetStringField(TEXT("aggregate"), TEXT("median"));
+			Obj->SetNumberField(TEXT("scored_candidates"), Scores.Num());
+		}
+	}
+	else
+	{
+		Response = UAgentForgeVisionAnalyzer::RequestQualityScoreBlocking(Provider, ResolvedModel, bMultiView, bUseCache);
+		Obj = BuildLLMResponseObject(Response, Provider, ResolvedModel);
+	}
 	Obj->SetBoolField(TEXT("multi_view"), bMultiView);
+	Obj->SetBoolField(TEXT("from_cache"), Response.bFromCache);
 
 	float Score = 0.0f;
 	FString Feedback;
@@ -8112,7 +9303,7 @@ FString UAgentForgeLibrary::Cmd_VisionQualityScore(const TSharedPtr<FJsonObject>
 	TArray<FString> Strengths;
 	if (Response.bSuccess && ParseVisionQualityPayload(Response.Content, Score, Feedback, Issues, Strengths))
 	{
-		Obj->SetNumberField(TEXT("score"), Score);
+		Obj->SetNumberField(TEXT("score"), AggregateScore.Get(Score));
 		Obj->SetStringField(TEXT("feedback"), Feedback);
 
 		TArray<TSharedPtr<FJsonValue>> IssueValues;
@@ -8143,6 +9334,136 @@ FString UAgentForgeLibrary::Cmd_VisionQualityScore(const TSharedPtr<FJsonObject>
 #endif
 }
 
+FString UAgentForgeLibrary::Cmd_SetLLMCachePolicy(const TSharedPtr<FJsonObject>& Args)
+{
+	FAgentForgeLLMResponseCache& Cache = FAgentForgeLLMResponseCache::Get();
+	Cache.ApplyPolicy(Args);
+	bool bClear = false;
+	bool bClearDisk = false;
+	if (Args.IsValid())
+	{
+		Args->TryGetBoolField(TEXT("clear"), bClear);
+		Args->TryGetBoolField(TEXT("clear_disk"), bClearDisk);
+	}
+	if (bClear || bClearDisk)
+	{
+		Cache.Clear(bClearDisk);
+	}
+
+	TSharedPtr<FJsonObject> Obj = Cache.GetStatsJson();
+	Obj->SetBoolField(TEXT("ok"), true);
+	return ToJsonString(Obj);
+}
+
+FString UAgentForgeLibrary::Cmd_SetLLMSchedulerPolicy(const TSharedPtr<FJsonObject>& Args)
+{
+#if WITH_EDITOR
+	if (!GEditor) { return ErrorResponse(TEXT("GEditor null.")); }
+
+	UAgentForgeLLMSubsystem* LLM = GEditor->GetEditorSubsystem<UAgentForgeLLMSubsystem>();
+	if (!LLM)
+	{
+		return ErrorResponse(TEXT("LLM subsystem unavailable."));
+	}
+
+	FString ProviderString;
+	EAgentForgeLLMProvider Provider = EAgentForgeLLMProvider::Anthropic;
+	const bool bHasProvider = Args.IsValid() && Args->TryGetStringField(TEXT("provider"), ProviderString);
+	if (bHasProvider && !ParseLLMProviderName(ProviderString, Provider))
+	{
+		return ErrorResponse(FString::Printf(TEXT("Unknown LLM provider: %s"), *ProviderString));
+	}
+	LLM->ApplySchedulerPolicy(Args, bHasProvider ? &Provider : nullptr);
+
+	TSharedPtr<FJsonObject> Obj = LLM->GetStatsJson()->GetObjectField(TEXT("scheduler"));
+	Obj->SetBoolField(TEXT("ok"), true);
+	return ToJsonString(Obj);
+#else
+	return ErrorResponse(TEXT("Editor only."));
+#endif
+}
+
+FString UAgentForgeLibrary::Cmd_ValidateJson(const TSharedPtr<FJsonObject>& Args)
+{
+	if (!Args.IsValid())
+	{
+		return ErrorResponse(TEXT("validate_json requires 'value' or 'json', and 'schema' or 'schema_name'."));
+	}
+
+	FAgentForgeSchemaRegistry& Registry = FAgentForgeSchemaRegistry::Get();
+	bool bReload = false;
+	if (Args->TryGetBoolField(TEXT("reload"), bReload) && bReload)
+	{
+		Registry.Clear();
+	}
+
+	FString SchemaName;
+	FString SchemaString;
+	FString SchemaError;
+	FAgentForgeCompiledSchemaPtr Schema;
+	const TSharedPtr<FJsonObject>* SchemaObject = nullptr;
+	if (Args->TryGetStringField(TEXT("schema_name"), SchemaName))
+	{
+		Schema = Registry.FindByName(SchemaName, &SchemaError);
+	}
+	else if (Args->TryGetStringField(TEXT("schema"), SchemaString))
+	{
+		Schema = Registry.Compile(SchemaString, &SchemaError);
+	}
+	else if (Args->TryGetObjectField(TEXT("schema"), SchemaObject) && SchemaObject && (*SchemaObject).IsValid())
+	{
+		Schema = Registry.Compile(ToJsonString(*SchemaObject), &SchemaError);
+	}
+	else
+	{
+		return ErrorResponse(TEXT("validate_json requires 'schema' (object or string) or 'schema_name'."));
+	}
+	if (!Schema.IsValid())
+	{
+		return ErrorResponse(SchemaError);
+	}
+
+	// "value" is the parsed payload itself; "json" is JSON text (e.g. an LLM completion).
+	TSharedPtr<FJsonValue> Value = Args->TryGetField(TEXT("value"));
+	FString JsonText;
+	if (!Value.IsValid() && Args->TryGetStringField(TEXT("json"), JsonText))
+	{
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonText);
+		if (!FJsonSerializer::Deserialize(Reader, Value) || !Value.IsValid())
+		{
+			return ErrorResponse(FString::Printf(TEXT("'json' is not valid JSON: %s"), *Reader->GetErrorMessage()));
+		}
+	}
+	if (!Value.IsValid())
+	{
+		return ErrorResponse(TEXT("validate_json requires 'value' or 'json'."));
+	}
+
+	FString ValidationError;
+	const bool bValid = Schema->Validate(Value, &ValidationError);
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetBoolField(TEXT("ok"), true);
+	Obj->SetBoolField(TEXT("valid"), bValid);
+	Obj->SetStringField(TEXT("error"), ValidationError);
+	Obj->SetNumberField(TEXT("schema_nodes"), Schema->NumNodes());
+	return ToJsonString(Obj);
+}
+
+FString UAgentForgeLibrary::Cmd_SetVisionCachePolicy(const TSharedPtr<FJsonObject>& Args)
+{
+	FAgentForgeVisionCache& Cache = FAgentForgeVisionCache::Get();
+	Cache.ApplyPolicy(Args);
+	bool bClear = false;
+	if (Args.IsValid() && Args->TryGetBoolField(TEXT("clear"), bClear) && bClear)
+	{
+		Cache.Clear();
+	}
+
+	TSharedPtr<FJsonObject> Obj = Cache.GetStatsJson();
+	Obj->SetBoolField(TEXT("ok"), true);
+	return ToJsonString(Obj);
+}
+
 // ============================================================================
 //  AI ASSET WIRING
 // ============================================================================
@@ -8502,13 +9823,26 @@ FString UAgentForgeLibrary::Cmd_ObserveAnalyzePlanAct(const TSharedPtr<FJsonObje
 
 	TArray<TSharedPtr<FJsonValue>> IterLog;
 
+	// The snapshot is reused while the world revision is unchanged, so a pass
+	// whose actions touched nothing does not pay for a fresh Observe.
+	FString SnapRaw;
+	int64   SnapRevision = 0;
+
 	for (int32 Iter = 0; Iter < MaxIter; ++Iter)
 	{
 		auto IterObj = MakeShared<FJsonObject>();
 		IterObj->SetNumberField(TEXT("iteration"), Iter + 1);
 
 		// ── Observe ──────────────────────────────────────────────────────────
-		const FString SnapRaw = FDataAccessModule::GetSemanticEnvironmentSnapshot();
+		const int64 ObservedRevision = FAgentForgeActorIndex::Get().GetRevision();
+		const bool bReuseSnapshot = !SnapRaw.IsEmpty() && ObservedRevision != 0 && ObservedRevision == SnapRevision;
+		if (!bReuseSnapshot)
+		{
+			SnapRaw = FDataAccessModule::GetSemanticEnvironmentSnapshot();
+			SnapRevision = ObservedRevision;
+		}
+		IterObj->SetNumberField(TEXT("world_revision"), static_cast<double>(ObservedRevision));
+		IterObj->SetBoolField(TEXT("observation_reused"), bReuseSnapshot);
 		TSharedPtr<FJsonObject> Snapshot;
 		TSharedRef<TJsonReader<>> SR = TJsonReaderFactory<>::Create(SnapRaw);
 		FJsonSerializer::Deserialize(SR, Snapshot);
@@ -8633,6 +9967,17 @@ FString UAgentForgeLibrary::Cmd_ObserveAnalyzePlanAct(const TSharedPtr<FJsonObje
 		}());
 		IterObj->SetArrayField(TEXT("action_results"), ActionResults);
 
+		FAgentForgeActorIndex::FWorldDelta ActDelta;
+		if (ObservedRevision != 0 && FAgentForgeActorIndex::Get().GetChangesSince(ObservedRevision, ActDelta))
+		{
+			auto ChangesObj = MakeShared<FJsonObject>();
+			ChangesObj->SetNumberField(TEXT("revision"), static_cast<double>(ActDelta.Revision));
+			ChangesObj->SetNumberField(TEXT("added"),    ActDelta.Added.Num());
+			ChangesObj->SetNumberField(TEXT("modified"), ActDelta.Modified.Num());
+			ChangesObj->SetNumberField(TEXT("removed"),  ActDelta.Removed.Num());
+			IterObj->SetObjectField(TEXT("world_changes"), ChangesObj);
+		}
+
 		IterLog.Add(MakeShared<FJsonValueObject>(IterObj));
 
 		// ── Check convergence ────────────────────────────────────────────────
@@ -8665,74 +10010,114 @@ FString UAgentForgeLibrary::Cmd_ObserveAnalyzePlanAct(const TSharedPtr<FJsonObje
 
 FString UAgentForgeLibrary::Cmd_EnhanceHorrorScene(const TSharedPtr<FJsonObject>& Args)
 {
-#if WITH_EDITOR
-	const FString Description = Args && Args->HasField(TEXT("description"))
-	                          ? Args->GetStringField(TEXT("description")) : TEXT("enhance horror atmosphere");
-	const float   Intensity   = Args && Args->HasField(TEXT("intensity"))
-	                          ? FMath::Clamp((float)Args->GetNumberField(TEXT("intensity")), 0.f, 1.f)
-	                          : 1.f;
-	const int32   PropCount   = Args && Args->HasField(TEXT("prop_count"))
-	                          ? (int32)Args->GetNumberField(TEXT("prop_count")) : 5;
+	return MakeEnhanceHorrorSceneJob(Args)->RunToCompletion();
+}
 
-	TArray<TSharedPtr<FJsonValue>> ActionsTaken;
+TSharedRef<FAgentForgeJob> UAgentForgeLibrary::MakeEnhanceHorrorSceneJob(const TSharedPtr<FJsonObject>& Args)
+{
+	TSharedRef<FAgentForgeJob> Job = MakeShared<FAgentForgeJob>(TEXT("enhance_horror_scene"));
+#if WITH_EDITOR
+	struct FHorrorRun
+	{
+		FString Description;
+		float   Intensity = 1.f;
+		int32   PropCount = 5;
+		FString GenreResult;
+		FString PlaceResult;
+		TArray<TSharedPtr<FJsonValue>> ActionsTaken;
+	};
+	TSharedRef<FHorrorRun> Run = MakeShared<FHorrorRun>();
+	Run->Description = Args && Args->HasField(TEXT("description"))
+	                 ? Args->GetStringField(TEXT("description")) : TEXT("enhance horror atmosphere");
+	Run->Intensity   = Args && Args->HasField(TEXT("intensity"))
+	                 ? FMath::Clamp((float)Args->GetNumberField(TEXT("intensity")), 0.f, 1.f)
+	                 : 1.f;
+	Run->PropCount   = Args && Args->HasField(TEXT("prop_count"))
+	                 ? (int32)Args->GetNumberField(TEXT("prop_count")) : 5;
+
+	auto AddAction = [Run](FAgentForgeJob& J, const FString& Action)
+	{
+		Run->ActionsTaken.Add(MakeShared<FJsonValueString>(Action));
+		TSharedPtr<FJsonObject> Partial = MakeShared<FJsonObject>();
+		Partial->SetStringField(TEXT("action"), Action);
+		J.AddPartialResult(Partial);
+	};
 
 	// Step 1: Observe.
-	const FString SnapshotBefore = FDataAccessModule::GetSemanticEnvironmentSnapshot();
-	ActionsTaken.Add(MakeShared<FJsonValueString>(TEXT("Observed: GetSemanticEnvironmentSnapshot")));
+	Job->AddStage(TEXT("observe"), [AddAction](FAgentForgeJob& J)
+	{
+		FDataAccessModule::GetSemanticEnvironmentSnapshot();
+		AddAction(J, TEXT("Observed: GetSemanticEnvironmentSnapshot"));
+		return true;
+	});
 
 	// Step 2: Apply horror genre rules.
-	auto GenreArgs = MakeShared<FJsonObject>();
-	GenreArgs->SetStringField(TEXT("genre"), TEXT("horror"));
-	GenreArgs->SetNumberField(TEXT("intensity"), Intensity);
-	const FString GenreResult = FSemanticCommandModule::ApplyGenreRules(GenreArgs);
-	ActionsTaken.Add(MakeShared<FJsonValueString>(
-		FString::Printf(TEXT("Applied horror genre rules (intensity=%.2f)"), Intensity)));
+	Job->AddStage(TEXT("genre_rules"), [Run, AddAction](FAgentForgeJob& J)
+	{
+		auto GenreArgs = MakeShared<FJsonObject>();
+		GenreArgs->SetStringField(TEXT("genre"), TEXT("horror"));
+		GenreArgs->SetNumberField(TEXT("intensity"), Run->Intensity);
+		Run->GenreResult = FSemanticCommandModule::ApplyGenreRules(GenreArgs);
+		AddAction(J, FString::Printf(TEXT("Applied horror genre rules (intensity=%.2f)"), Run->Intensity));
+		return true;
+	});
 
 	// Step 3: Place props thematically.
-	auto PlaceArgs = MakeShared<FJsonObject>();
-	PlaceArgs->SetStringField(TEXT("class_path"), TEXT("/Script/Engine.StaticMeshActor"));
-	PlaceArgs->SetNumberField(TEXT("count"), PropCount);
-	PlaceArgs->SetStringField(TEXT("label_prefix"), TEXT("HorrorProp"));
-	auto ThemeRules = MakeShared<FJsonObject>();
-	ThemeRules->SetBoolField(TEXT("prefer_dark"),     true);
-	ThemeRules->SetBoolField(TEXT("prefer_corners"),  true);
-	ThemeRules->SetBoolField(TEXT("prefer_occluded"), true);
-	ThemeRules->SetNumberField(TEXT("min_spacing"), 400.f);
-	PlaceArgs->SetObjectField(TEXT("theme_rules"), ThemeRules);
-	const FString PlaceResult = FSemanticCommandModule::PlaceAssetThematically(PlaceArgs);
-	ActionsTaken.Add(MakeShared<FJsonValueString>(
-		FString::Printf(TEXT("Placed %d horror props in dark corners"), PropCount)));
+	Job->AddStage(TEXT("place_props"), [Run, AddAction](FAgentForgeJob& J)
+	{
+		auto PlaceArgs = MakeShared<FJsonObject>();
+		PlaceArgs->SetStringField(TEXT("class_path"), TEXT("/Script/Engine.StaticMeshActor"));
+		PlaceArgs->SetNumberField(TEXT("count"), Run->PropCount);
+		PlaceArgs->SetStringField(TEXT("label_prefix"), TEXT("HorrorProp"));
+		auto ThemeRules = MakeShared<FJsonObject>();
+		ThemeRules->SetBoolField(TEXT("prefer_dark"),     true);
+		ThemeRules->SetBoolField(TEXT("prefer_corners"),  true);
+		ThemeRules->SetBoolField(TEXT("prefer_occluded"), true);
+		ThemeRules->SetNumberField(TEXT("min_spacing"), 400.f);
+		PlaceArgs->SetObjectField(TEXT("theme_rules"), ThemeRules);
+		Run->PlaceResult = FSemanticCommandModule::PlaceAssetThematically(PlaceArgs);
+		AddAction(J, FString::Printf(TEXT("Placed %d horror props in dark corners"), Run->PropCount));
+		return true;
+	}, 2.0f);
 
 	// Step 4: Verify.
-	TSharedPtr<FJsonObject> VerifyArgs = MakeShared<FJsonObject>();
-	VerifyArgs->SetNumberField(TEXT("phase_mask"), 13); // PreFlight + PostVerify + BuildCheck
-	const FString VerifyResult = Cmd_RunVerification(VerifyArgs);
-	ActionsTaken.Add(MakeShared<FJsonValueString>(TEXT("Ran 3-phase verification (mask=13)")));
-
-	// Step 5: Screenshot.
-	FScreenshotRequest::RequestScreenshot(TEXT("enhance_horror_result"), false, false);
-	const FString ScreenshotPath = TEXT("Saved/Screenshots/WindowsEditor/enhance_horror_result.png");
-	ActionsTaken.Add(MakeShared<FJsonValueString>(
-		FString::Printf(TEXT("Screenshot queued: %s"), *ScreenshotPath)));
-
-	// Observe after.
-	const FString SnapshotAfter = FDataAccessModule::GetSemanticEnvironmentSnapshot();
-	TSharedPtr<FJsonObject> AfterObj;
-	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(SnapshotAfter);
-	FJsonSerializer::Deserialize(Reader, AfterObj);
-	float FinalHorrorScore = 0.f;
-	if (AfterObj.IsValid()) { FinalHorrorScore = (float)AfterObj->GetNumberField(TEXT("horror_score")); }
+	Job->AddStage(TEXT("verify"), [AddAction](FAgentForgeJob& J)
+	{
+		TSharedPtr<FJsonObject> VerifyArgs = MakeShared<FJsonObject>();
+		VerifyArgs->SetNumberField(TEXT("phase_mask"), 13); // PreFlight + PostVerify + BuildCheck
+		Cmd_RunVerification(VerifyArgs);
+		AddAction(J, TEXT("Ran 3-phase verification (mask=13)"));
+		return true;
+	});
 
-	auto Root = MakeShared<FJsonObject>();
-	Root->SetBoolField(TEXT("ok"), true);
-	Root->SetStringField(TEXT("description"), Description);
-	Root->SetArrayField(TEXT("actions_taken"), ActionsTaken);
-	Root->SetNumberField(TEXT("final_horror_score"), FinalHorrorScore);
-	Root->SetStringField(TEXT("screenshot_path"), ScreenshotPath);
-	Root->SetStringField(TEXT("genre_result"), GenreResult.Left(200));
-	Root->SetStringField(TEXT("placement_result"), PlaceResult.Left(200));
-	return ToJsonString(Root);
+	// Step 5: Screenshot, observe after, build the response.
+	Job->SetFinalizer([Run](FAgentForgeJob&) -> FString
+	{
+		FScreenshotRequest::RequestScreenshot(TEXT("enhance_horror_result"), false, false);
+		const FString ScreenshotPath = TEXT("Saved/Screenshots/WindowsEditor/enhance_horror_result.png");
+		Run->ActionsTaken.Add(MakeShared<FJsonValueString>(
+			FString::Printf(TEXT("Screenshot queued: %s"), *ScreenshotPath)));
+
+		// Observe after.
+		const FString SnapshotAfter = FDataAccessModule::GetSemanticEnvironmentSnapshot();
+		TSharedPtr<FJsonObject> AfterObj;
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(SnapshotAfter);
+		FJsonSerializer::Deserialize(Reader, AfterObj);
+		float FinalHorrorScore = 0.f;
+		if (AfterObj.IsValid()) { FinalHorrorScore = (float)AfterObj->GetNumberField(TEXT("horror_score")); }
+
+		auto Root = MakeShared<FJsonObject>();
+		Root->SetBoolField(TEXT("ok"), true);
+		Root->SetStringField(TEXT("description"), Run->Description);
+		Root->SetArrayField(TEXT("actions_taken"), Run->ActionsTaken);
+		Root->SetNumberField(TEXT("final_horror_score"), FinalHorrorScore);
+		Root->SetStringField(TEXT("screenshot_path"), ScreenshotPath);
+		Root->SetStringField(TEXT("genre_result"), Run->GenreResult.Left(200));
+		Root->SetStringField(TEXT("placement_result"), Run->PlaceResult.Left(200));
+		return ToJsonString(Root);
+	});
 #else
-	return ErrorResponse(TEXT("Editor only."));
+	Job->AddStage(TEXT("observe"), [](FAgentForgeJob& J) { J.Finish(ErrorResponse(TEXT("Editor only."))); return true; });
 #endif
+	return Job;
 }
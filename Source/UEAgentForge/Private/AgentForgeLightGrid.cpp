@@ -0,0 +1,206 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeLightGrid.cpp — light snapshot, parallel slab accumulation, trilinear samples.
+
+#include "AgentForgeLightGrid.h"
+
+#include "AgentForgeActorIndex.h"
+#include "Async/ParallelFor.h"
+#include "Components/LocalLightComponent.h"
+#include "Engine/Light.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/PlatformTime.h"
+
+namespace
+{
+	// Slack around the queried points, so nearby follow-up queries reuse the grid.
+	static constexpr float RegionMarginFraction = 0.1f;
+}
+
+FAgentForgeLightGrid& FAgentForgeLightGrid::Get()
+{
+	static FAgentForgeLightGrid Instance;
+	return Instance;
+}
+
+void FAgentForgeLightGrid::Sample(UWorld* World, TArrayView<const FVector> Points, TArray<float>& OutInfluence)
+{
+	check(IsInGameThread());
+	OutInfluence.Reset(Points.Num());
+	OutInfluence.SetNumZeroed(Points.Num());
+	if (!World || Points.Num() == 0)
+	{
+		return;
+	}
+
+	FBox Wanted(ForceInit);
+	for (const FVector& Point : Points)
+	{
+		Wanted += Point;
+	}
+
+	if (IsCurrent(World) && Region.IsInsideOrOn(Wanted.Min) && Region.IsInsideOrOn(Wanted.Max))
+	{
+		++Reuses;
+	}
+	else
+	{
+		const FVector Margin = FVector(MinCellSize) + Wanted.GetSize() * RegionMarginFraction;
+		Build(World, Wanted.ExpandBy(Margin));
+	}
+
+	for (int32 Index = 0; Index < Points.Num(); ++Index)
+	{
+		OutInfluence[Index] = SampleAt(Points[Index]);
+	}
+	PointsSampled += Points.Num();
+}
+
+bool FAgentForgeLightGrid::IsCurrent(UWorld* World)
+{
+	if (!bValid || BuiltWorld.Get() != World)
+	{
+		return false;
+	}
+
+	FAgentForgeActorIndex& ActorIndex = FAgentForgeActorIndex::Get();
+	const int64 Revision = ActorIndex.GetRevision();
+	if (Revision == 0)
+	{
+		return false;   // no change tracking: every query rebuilds
+	}
+	if (Revision == BuiltRevision)
+	{
+		return true;
+	}
+
+	FAgentForgeActorIndex::FWorldDelta Delta;
+	if (!ActorIndex.GetChangesSince(BuiltRevision, Delta))
+	{
+		return false;
+	}
+	auto IsLight = [](const AActor* Actor) { return Actor && Actor->IsA<ALight>(); };
+	if (Delta.Added.ContainsByPredicate(IsLight) || Delta.Modified.ContainsByPredicate(IsLight))
+	{
+		return false;
+	}
+	for (const FAgentForgeActorIndex::FRemovedActor& Removed : Delta.Removed)
+	{
+		if (LightPaths.Contains(Removed.Path))
+		{
+			return false;
+		}
+	}
+
+	// Only non-light actors changed.
+	BuiltRevision = Delta.Revision;
+	return true;
+}
+
+void FAgentForgeLightGrid::Build(UWorld* World, const FBox& InRegion)
+{
+	const double StartSeconds = FPlatformTime::Seconds();
+
+	Lights.Reset();
+	LightPaths.Reset();
+	for (TActorIterator<ALight> It(World); It; ++It)
+	{
+		const ALight* Light = *It;
+		const ULocalLightComponent* LC = Cast<ULocalLightComponent>(Light->GetLightComponent());
+		if (!LC || LC->AttenuationRadius <= 0.0f)
+		{
+			continue;
+		}
+		FLightSample& Sample = Lights.AddDefaulted_GetRef();
+		Sample.Location = LC->GetComponentLocation();
+		Sample.Intensity = LC->Intensity;
+		Sample.Radius = LC->AttenuationRadius;
+		LightPaths.Add(Light->GetPathName());
+	}
+
+	const FVector Size = InRegion.GetSize();
+	CellSize = FMath::Max(MinCellSize, static_cast<float>(Size.GetMax()) / (MaxCellsPerAxis - 1));
+	auto CornersAlong = [this](double Extent)
+	{
+		return FMath::Clamp(FMath::CeilToInt(Extent / CellSize) + 1, 2, MaxCellsPerAxis);
+	};
+	Dims = FIntVector(CornersAlong(Size.X), CornersAlong(Size.Y), CornersAlong(Size.Z));
+	Origin = InRegion.Min;
+	Region = FBox(Origin, Origin + FVector(Dims - FIntVector(1)) * CellSize);
+
+	Corners.Reset(Dims.X * Dims.Y * Dims.Z);
+	Corners.SetNumZeroed(Dims.X * Dims.Y * Dims.Z);
+
+	// One Z slab per work item; each slab only touches its own corners.
+	ParallelFor(Dims.Z, [this](int32 Z)
+	{
+		const double CornerZ = Origin.Z + Z * CellSize;
+		float* Slab = Corners.GetData() + Z * Dims.X * Dims.Y;
+		for (const FLightSample& Light : Lights)
+		{
+			const double DZ = CornerZ - Light.Location.Z;
+			if (FMath::Abs(DZ) >= Light.Radius)
+			{
+				continue;
+			}
+			const int32 MinX = FMath::Max(0, FMath::FloorToInt((Light.Location.X - Light.Radius - Origin.X) / CellSize));
+			const int32 MaxX = FMath::Min(Dims.X - 1, FMath::CeilToInt((Light.Location.X + Light.Radius - Origin.X) / CellSize));
+			const int32 MinY = FMath::Max(0, FMath::FloorToInt((Light.Location.Y - Light.Radius - Origin.Y) / CellSize));
+			const int32 MaxY = FMath::Min(Dims.Y - 1, FMath::CeilToInt((Light.Location.Y + Light.Radius - Origin.Y) / CellSize));
+			for (int32 Y = MinY; Y <= MaxY; ++Y)
+			{
+				const double DY = Origin.Y + Y * CellSize - Light.Location.Y;
+				for (int32 X = MinX; X <= MaxX; ++X)
+				{
+					const double DX = Origin.X + X * CellSize - Light.Location.X;
+					const double Dist = FMath::Sqrt(DX * DX + DY * DY + DZ * DZ);
+					if (Dist < Light.Radius)
+					{
+						Slab[Y * Dims.X + X] += Light.Intensity * static_cast<float>(1.0 - Dist / Light.Radius);
+					}
+				}
+			}
+		}
+	}, Lights.Num() == 0 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+	BuiltWorld = World;
+	BuiltRevision = FAgentForgeActorIndex::Get().GetRevision();
+	bValid = true;
+	++Builds;
+	LastBuildMs = (FPlatformTime::Seconds() - StartSeconds) * 1000.0;
+}
+
+float FAgentForgeLightGrid::SampleAt(const FVector& Point) const
+{
+	const FVector Local = (Point - Origin) / CellSize;
+	auto Axis = [](double Value, int32 Count, int32& OutIndex) -> float
+	{
+		const double Clamped = FMath::Clamp(Value, 0.0, static_cast<double>(Count - 1));
+		OutIndex = FMath::Min(FMath::FloorToInt(Clamped), Count - 2);
+		return static_cast<float>(Clamped - OutIndex);
+	};
+	int32 X, Y, Z;
+	const float FX = Axis(Local.X, Dims.X, X);
+	const float FY = Axis(Local.Y, Dims.Y, Y);
+	const float FZ = Axis(Local.Z, Dims.Z, Z);
+
+	auto At = [this](int32 CX, int32 CY, int32 CZ) { return Corners[(CZ * Dims.Y + CY) * Dims.X + CX]; };
+	const float Z0 = FMath::Lerp(FMath::Lerp(At(X, Y, Z),     At(X + 1, Y, Z),     FX),
+	                             FMath::Lerp(At(X, Y + 1, Z), At(X + 1, Y + 1, Z), FX), FY);
+	const float Z1 = FMath::Lerp(FMath::Lerp(At(X, Y, Z + 1),     At(X + 1, Y, Z + 1),     FX),
+	                             FMath::Lerp(At(X, Y + 1, Z + 1), At(X + 1, Y + 1, Z + 1), FX), FY);
+	return FMath::Lerp(Z0, Z1, FZ);
+}
+
+TSharedPtr<FJsonObject> FAgentForgeLightGrid::GetStatsJson() const
+{
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetNumberField(TEXT("builds"),        (double)Builds);
+	Obj->SetNumberField(TEXT("reuses"),        (double)Reuses);
+	Obj->SetNumberField(TEXT("samples"),       (double)PointsSampled);
+	Obj->SetNumberField(TEXT("lights"),        Lights.Num());
+	Obj->SetNumberField(TEXT("cells"),         Corners.Num());
+	Obj->SetNumberField(TEXT("cell_size"),     CellSize);
+	Obj->SetNumberField(TEXT("last_build_ms"), LastBuildMs);
+	return Obj;
+}
@@ -0,0 +1,226 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeMemoryMonitor.cpp — pooled sampling, hysteresis, cost estimates, GC scheduling.
+
+#include "AgentForgeMemoryMonitor.h"
+
+#include "Async/Async.h"
+#include "Dom/JsonValue.h"
+#include "Engine/Engine.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CoreMisc.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace
+{
+	static constexpr double BytesPerMB = 1024.0 * 1024.0;
+}
+
+FAgentForgeMemoryMonitor& FAgentForgeMemoryMonitor::Get()
+{
+	static FAgentForgeMemoryMonitor Instance;
+	return Instance;
+}
+
+void FAgentForgeMemoryMonitor::Initialize()
+{
+	if (bActive.exchange(true))
+	{
+		return;
+	}
+	TakeSample();
+	TickHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateRaw(this, &FAgentForgeMemoryMonitor::Tick));
+	PostGcHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &FAgentForgeMemoryMonitor::HandlePostGarbageCollect);
+}
+
+void FAgentForgeMemoryMonitor::Shutdown()
+{
+	if (!bActive.exchange(false))
+	{
+		return;
+	}
+	FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+	TickHandle.Reset();
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGcHandle);
+	PostGcHandle.Reset();
+}
+
+void FAgentForgeMemoryMonitor::TakeSample()
+{
+	const FPlatformMemoryStats Mem = FPlatformMemory::GetStats();
+	Publish((double)Mem.UsedPhysical / BytesPerMB, (double)Mem.AvailablePhysical / BytesPerMB, (double)Mem.TotalPhysical / BytesPerMB);
+}
+
+void FAgentForgeMemoryMonitor::Publish(double InUsedMB, double InAvailableMB, double InTotalMB)
+{
+	UsedMB.store(InUsedMB, std::memory_order_relaxed);
+	AvailableMB.store(InAvailableMB, std::memory_order_relaxed);
+	TotalMB.store(InTotalMB, std::memory_order_relaxed);
+	SampleSeconds.store(FPlatformTime::Seconds(), std::memory_order_relaxed);
+
+	const double UsedPercent = InTotalMB > 0.0 ? InUsedMB / InTotalMB * 100.0 : 0.0;
+	if (!bPressure.load(std::memory_order_relaxed))
+	{
+		if (InAvailableMB < EnterAvailableMB || UsedPercent >= EnterUsedPercent)
+		{
+			PressureSinceSeconds.store(FPlatformTime::Seconds(), std::memory_order_relaxed);
+			PressureEntries.fetch_add(1, std::memory_order_relaxed);
+			bPressure.store(true, std::memory_order_release);
+			RequestGarbageCollection();
+		}
+	}
+	else if (InAvailableMB >= ExitAvailableMB && UsedPercent < ExitUsedPercent)
+	{
+		bPressure.store(false, std::memory_order_release);
+	}
+	Sequence.fetch_add(1, std::memory_order_release);
+}
+
+FAgentForgeMemorySample FAgentForgeMemoryMonitor::GetSample()
+{
+	if (FPlatformTime::Seconds() - SampleSeconds.load(std::memory_order_relaxed) > 2.0 * SampleIntervalSeconds)
+	{
+		TakeSample();
+	}
+	FAgentForgeMemorySample Sample;
+	Sample.Sequence    = Sequence.load(std::memory_order_acquire);
+	Sample.UsedMB      = UsedMB.load(std::memory_order_relaxed);
+	Sample.AvailableMB = AvailableMB.load(std::memory_order_relaxed);
+	Sample.TotalMB     = TotalMB.load(std::memory_order_relaxed);
+	Sample.Seconds     = SampleSeconds.load(std::memory_order_relaxed);
+	return Sample;
+}
+
+void FAgentForgeMemoryMonitor::RequestGarbageCollection()
+{
+	if (!bGcWanted.exchange(true, std::memory_order_acq_rel))
+	{
+		GcRequests.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+FAgentForgeMemoryVerdict FAgentForgeMemoryMonitor::Check(const FString& Cmd)
+{
+	++Checks;
+	FAgentForgeMemoryVerdict Verdict;
+	Verdict.Sample = GetSample();
+	if (const double* Cost = CostMB.Find(Cmd))
+	{
+		Verdict.PredictedMB = *Cost;
+	}
+
+	if (IsUnderPressure())
+	{
+		++Blocked;
+		RequestGarbageCollection();
+		Verdict.bAllowed = false;
+		Verdict.bGcRequested = true;
+		const bool bCollectedSince = LastGcSeconds > PressureSinceSeconds.load(std::memory_order_relaxed);
+		Verdict.Error = FString::Printf(
+			TEXT("Memory guard: available memory %.0f MB, used %.1f%%. %s %s was not run; retry after the collection."),
+			Verdict.Sample.AvailableMB, Verdict.Sample.UsedPercent(),
+			bCollectedSince ? TEXT("Pressure persisted after a garbage collection; another is scheduled between commands.")
+			                : TEXT("A garbage collection is scheduled between commands."),
+			*Cmd);
+		return Verdict;
+	}
+
+	// Would this command's usual growth carry the process into pressure?
+	const FAgentForgeMemorySample& S = Verdict.Sample;
+	if (Verdict.PredictedMB > 0.0 && S.TotalMB > 0.0
+		&& (S.AvailableMB - Verdict.PredictedMB < EnterAvailableMB
+			|| (S.UsedMB + Verdict.PredictedMB) / S.TotalMB * 100.0 >= EnterUsedPercent))
+	{
+		++Predicted;
+		RequestGarbageCollection();
+		Verdict.bGcRequested = true;
+	}
+	return Verdict;
+}
+
+void FAgentForgeMemoryMonitor::RecordCost(const FString& Cmd, const FAgentForgeMemorySample& Before)
+{
+	const FAgentForgeMemorySample After = GetSample();
+	if (Before.Sequence == 0 || After.Sequence == Before.Sequence)
+	{
+		// No sample landed during the call: it was shorter than the interval.
+		return;
+	}
+	const double GrowthMB = FMath::Max(0.0, After.UsedMB - Before.UsedMB);
+	if (double* Cost = CostMB.Find(Cmd))
+	{
+		*Cost += CostBlend * (GrowthMB - *Cost);
+	}
+	else
+	{
+		CostMB.Add(Cmd, GrowthMB);
+	}
+}
+
+bool FAgentForgeMemoryMonitor::Tick(float DeltaTime)
+{
+	const double Now = FPlatformTime::Seconds();
+	if (Now - LastTickSampleSeconds >= SampleIntervalSeconds && !bSampleInFlight.exchange(true))
+	{
+		LastTickSampleSeconds = Now;
+		Async(EAsyncExecution::ThreadPool, [this]()
+		{
+			TakeSample();
+			bSampleInFlight.store(false, std::memory_order_release);
+		});
+	}
+
+	// Tickers run between commands, never inside one. A commandlet has no
+	// engine GC slot, so it collects here instead.
+	if (bGcWanted.load(std::memory_order_acquire) && GEngine && !IsGarbageCollecting())
+	{
+		bGcWanted.store(false, std::memory_order_release);
+		++GcScheduled;
+		if (IsRunningCommandlet())
+		{
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		}
+		else
+		{
+			GEngine->ForceGarbageCollection(/*bFullPurge=*/false);
+		}
+	}
+	return true;
+}
+
+void FAgentForgeMemoryMonitor::HandlePostGarbageCollect()
+{
+	++GcCompleted;
+	LastGcSeconds = FPlatformTime::Seconds();
+	// Resample on the next tick rather than inside the collector.
+	LastTickSampleSeconds = 0.0;
+}
+
+TSharedPtr<FJsonObject> FAgentForgeMemoryMonitor::GetStatsJson() const
+{
+	const double Used = UsedMB.load(std::memory_order_relaxed);
+	const double Total = TotalMB.load(std::memory_order_relaxed);
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetBoolField  (TEXT("sampling"),            bActive.load(std::memory_order_relaxed));
+	Obj->SetNumberField(TEXT("sample_interval_ms"),  SampleIntervalSeconds * 1000.0);
+	Obj->SetNumberField(TEXT("samples"),             (double)Sequence.load(std::memory_order_relaxed));
+	Obj->SetNumberField(TEXT("sample_age_ms"),       (FPlatformTime::Seconds() - SampleSeconds.load(std::memory_order_relaxed)) * 1000.0);
+	Obj->SetNumberField(TEXT("used_mb"),             Used);
+	Obj->SetNumberField(TEXT("available_mb"),        AvailableMB.load(std::memory_order_relaxed));
+	Obj->SetNumberField(TEXT("used_percent"),        Total > 0.0 ? Used / Total * 100.0 : 0.0);
+	Obj->SetBoolField  (TEXT("pressure"),            IsUnderPressure());
+	Obj->SetNumberField(TEXT("pressure_entries"),    (double)PressureEntries.load(std::memory_order_relaxed));
+	Obj->SetNumberField(TEXT("enter_available_mb"),  EnterAvailableMB);
+	Obj->SetNumberField(TEXT("enter_used_percent"),  EnterUsedPercent);
+	Obj->SetNumberField(TEXT("exit_available_mb"),   ExitAvailableMB);
+	Obj->SetNumberField(TEXT("exit_used_percent"),   ExitUsedPercent);
+	Obj->SetNumberField(TEXT("checks"),              (double)Checks);
+	Obj->SetNumberField(TEXT("blocked"),             (double)Blocked);
+	Obj->SetNumberField(TEXT("predicted"),           (double)Predicted);
+	Obj->SetNumberField(TEXT("learned_commands"),    CostMB.Num());
+	Obj->SetNumberField(TEXT("gc_requests"),         (double)GcRequests.load(std::memory_order_relaxed));
+	Obj->SetNumberField(TEXT("gcs_scheduled"),       (double)GcScheduled);
+	Obj->SetNumberField(TEXT("gcs_completed"),       (double)GcCompleted);
+	return Obj;
+}
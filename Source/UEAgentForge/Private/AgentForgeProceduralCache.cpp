@@ -0,0 +1,242 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeProceduralCache.cpp — LRU memory tier + optional disk tier.
+
+#include "AgentForgeProceduralCache.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/SecureHash.h"
+
+FAgentForgeProceduralCache& FAgentForgeProceduralCache::Get()
+{
+	static FAgentForgeProceduralCache Instance;
+	return Instance;
+}
+
+FString FAgentForgeProceduralCache::MakeKey(const TCHAR* Kind, const FString& Inputs)
+{
+	const FTCHARToUTF8 Utf8(*(FString(Kind) + TEXT("|") + Inputs));
+	FSHAHash Hash;
+	FSHA1::HashBuffer(Utf8.Get(), Utf8.Length(), Hash.Hash);
+	return Hash.ToString().ToLower();
+}
+
+bool FAgentForgeProceduralCache::ParseMode(const FString& Name, EProceduralCacheMode& OutMode)
+{
+	if (Name.Equals(TEXT("off"), ESearchCase::IgnoreCase))
+	{
+		OutMode = EProceduralCacheMode::Off;
+		return true;
+	}
+	if (Name.Equals(TEXT("memory"), ESearchCase::IgnoreCase))
+	{
+		OutMode = EProceduralCacheMode::Memory;
+		return true;
+	}
+	if (Name.Equals(TEXT("disk"), ESearchCase::IgnoreCase))
+	{
+		OutMode = EProceduralCacheMode::Disk;
+		return true;
+	}
+	return false;
+}
+
+const TCHAR* FAgentForgeProceduralCache::ModeName(EProceduralCacheMode Mode)
+{
+	switch (Mode)
+	{
+	case EProceduralCacheMode::Off:  return TEXT("off");
+	case EProceduralCacheMode::Disk: return TEXT("disk");
+	default:                         return TEXT("memory");
+	}
+}
+
+FString FAgentForgeProceduralCache::GetDiskRoot()
+{
+	return FPaths::ProjectSavedDir() / TEXT("AgentForgeCache");
+}
+
+FString FAgentForgeProceduralCache::DiskPath(const TCHAR* Kind, const FString& Key) const
+{
+	return GetDiskRoot() / Kind / (Key + TEXT(".bin"));
+}
+
+FAgentForgeProceduralCache::FPayload FAgentForgeProceduralCache::Find(const TCHAR* Kind, const FString& Key, EProceduralCacheMode Mode, bool* OutFromDisk)
+{
+	if (OutFromDisk)
+	{
+		*OutFromDisk = false;
+	}
+	if (Mode == EProceduralCacheMode::Off)
+	{
+		return nullptr;
+	}
+
+	const FString EntryKey = FString(Kind) / Key;
+	{
+		FScopeLock ScopeLock(&Lock);
+		if (FEntry* Entry = Entries.Find(EntryKey))
+		{
+			Entry->LastUse = ++UseClock;
+			++MemoryHits;
+			CaptureLocked(EntryKey, Kind, Key, Entry->Payload);
+			return Entry->Payload;
+		}
+	}
+
+	if (Mode == EProceduralCacheMode::Disk)
+	{
+		TArray<uint8> Bytes;
+		if (FFileHelper::LoadFileToArray(Bytes, *DiskPath(Kind, Key), FILEREAD_Silent))
+		{
+			FPayload Payload = MakeShared<const TArray<uint8>, ESPMode::ThreadSafe>(MoveTemp(Bytes));
+			FScopeLock ScopeLock(&Lock);
+			++DiskHits;
+			FEntry& Entry = Entries.FindOrAdd(EntryKey);
+			if (!Entry.Payload.IsValid())
+			{
+				Entry.Payload = Payload;
+				MemoryBytes += Payload->Num();
+			}
+			Entry.LastUse = ++UseClock;
+			CaptureLocked(EntryKey, Kind, Key, Payload);
+			EvictToBudget();
+			if (OutFromDisk)
+			{
+				*OutFromDisk = true;
+			}
+			return Payload;
+		}
+	}
+
+	FScopeLock ScopeLock(&Lock);
+	++Misses;
+	return nullptr;
+}
+
+void FAgentForgeProceduralCache::Store(const TCHAR* Kind, const FString& Key, TArray<uint8>&& Payload, EProceduralCacheMode Mode)
+{
+	if (Mode == EProceduralCacheMode::Off)
+	{
+		return;
+	}
+
+	FPayload Shared = MakeShared<const TArray<uint8>, ESPMode::ThreadSafe>(MoveTemp(Payload));
+	if (Mode == EProceduralCacheMode::Disk)
+	{
+		const FString Path = DiskPath(Kind, Key);
+		IFileManager::Get().MakeDirectory(*FPaths::GetPath(Path), true);
+		if (FFileHelper::SaveArrayToFile(*Shared, *Path))
+		{
+			FScopeLock ScopeLock(&Lock);
+			++DiskWrites;
+		}
+	}
+
+	const FString EntryKey = FString(Kind) / Key;
+	FScopeLock ScopeLock(&Lock);
+	++Stores;
+	FEntry& Entry = Entries.FindOrAdd(EntryKey);
+	if (Entry.Payload.IsValid())
+	{
+		MemoryBytes -= Entry.Payload->Num();
+	}
+	Entry.Payload = Shared;
+	Entry.LastUse = ++UseClock;
+	MemoryBytes += Shared->Num();
+	CaptureLocked(EntryKey, Kind, Key, Shared);
+	EvictToBudget();
+}
+
+void FAgentForgeProceduralCache::CaptureLocked(const FString& EntryKey, const TCHAR* Kind, const FString& Key, const FPayload& Payload)
+{
+	// Caller holds Lock. The captured reference outlives an eviction.
+	if (!bCapturing || CapturedKeys.Contains(EntryKey))
+	{
+		return;
+	}
+	CapturedKeys.Add(EntryKey);
+	Captured.Add({ FString(Kind), Key, Payload });
+}
+
+void FAgentForgeProceduralCache::BeginCapture()
+{
+	FScopeLock ScopeLock(&Lock);
+	bCapturing = true;
+	Captured.Reset();
+	CapturedKeys.Reset();
+}
+
+TArray<FAgentForgeProceduralCache::FCapturedEntry> FAgentForgeProceduralCache::EndCapture()
+{
+	FScopeLock ScopeLock(&Lock);
+	bCapturing = false;
+	CapturedKeys.Reset();
+	return MoveTemp(Captured);
+}
+
+void FAgentForgeProceduralCache::EvictToBudget()
+{
+	// Caller holds Lock. Entries are few (one per distinct operator call), so a scan is fine.
+	while (MemoryBytes > MemoryBudgetBytes && Entries.Num() > 0)
+	{
+		auto Oldest = Entries.CreateIterator();
+		for (auto It = Entries.CreateIterator(); It; ++It)
+		{
+			if (It->Value.LastUse < Oldest->Value.LastUse)
+			{
+				Oldest = It;
+			}
+		}
+		MemoryBytes -= Oldest->Value.Payload.IsValid() ? Oldest->Value.Payload->Num() : 0;
+		Oldest.RemoveCurrent();
+		++Evictions;
+	}
+}
+
+void FAgentForgeProceduralCache::Clear(bool bIncludeDisk)
+{
+	{
+		FScopeLock ScopeLock(&Lock);
+		Entries.Empty();
+		MemoryBytes = 0;
+	}
+	if (bIncludeDisk)
+	{
+		IFileManager::Get().DeleteDirectory(*GetDiskRoot(), false, true);
+	}
+}
+
+void FAgentForgeProceduralCache::SetMemoryBudgetBytes(int64 Bytes)
+{
+	FScopeLock ScopeLock(&Lock);
+	MemoryBudgetBytes = FMath::Max<int64>(Bytes, 0);
+	EvictToBudget();
+}
+
+int64 FAgentForgeProceduralCache::GetMemoryBudgetBytes() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return MemoryBudgetBytes;
+}
+
+TSharedPtr<FJsonObject> FAgentForgeProceduralCache::GetStatsJson() const
+{
+	FScopeLock ScopeLock(&Lock);
+	const int64 Lookups = MemoryHits + DiskHits + Misses;
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetNumberField(TEXT("entries"),          Entries.Num());
+	Obj->SetNumberField(TEXT("memory_mb"),        MemoryBytes / (1024.0 * 1024.0));
+	Obj->SetNumberField(TEXT("memory_budget_mb"), MemoryBudgetBytes / (1024.0 * 1024.0));
+	Obj->SetNumberField(TEXT("memory_hits"),      static_cast<double>(MemoryHits));
+	Obj->SetNumberField(TEXT("disk_hits"),        static_cast<double>(DiskHits));
+	Obj->SetNumberField(TEXT("misses"),           static_cast<double>(Misses));
+	Obj->SetNumberField(TEXT("hit_rate"),         Lookups > 0 ? (double)(MemoryHits + DiskHits) / (double)Lookups : 0.0);
+	Obj->SetNumberField(TEXT("stores"),           static_cast<double>(Stores));
+	Obj->SetNumberField(TEXT("disk_writes"),      static_cast<double>(DiskWrites));
+	Obj->SetNumberField(TEXT("evictions"),        static_cast<double>(Evictions));
+	Obj->SetStringField(TEXT("disk_root"),        GetDiskRoot());
+	return Obj;
+}
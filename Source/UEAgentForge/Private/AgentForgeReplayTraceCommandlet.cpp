@@ -0,0 +1,79 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeReplayTraceCommandlet.cpp — command-line parsing around FAgentForgeTraceReplay.
+
+#include "AgentForgeReplayTraceCommandlet.h"
+
+#include "AgentForgeTraceReplay.h"
+
+#include "Dom/JsonObject.h"
+#include "Misc/Parse.h"
+
+namespace
+{
+	/** -Key=a,b,c into Out. */
+	static void AddSetParam(const FString& Params, const TCHAR* Key, TSet<FString>& Out)
+	{
+		FString Value;
+		if (!FParse::Value(*Params, Key, Value, false))
+		{
+			return;
+		}
+		TArray<FString> Items;
+		Value.ParseIntoArray(Items, TEXT(","), true);
+		for (const FString& Item : Items)
+		{
+			Out.Add(Item.TrimStartAndEnd().ToLower());
+		}
+	}
+}
+
+UAgentForgeReplayTraceCommandlet::UAgentForgeReplayTraceCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UAgentForgeReplayTraceCommandlet::Main(const FString& Params)
+{
+	FTraceReplaySettings Settings;
+	if (!FParse::Value(*Params, TEXT("trace="), Settings.TracePath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("[UEAgentForge] Trace replay needs -trace=<file.aftrace>."));
+		return 1;
+	}
+	FParse::Value(*Params, TEXT("session="), Settings.Session);
+	FParse::Value(*Params, TEXT("map="), Settings.Map);
+	FParse::Value(*Params, TEXT("repeats="), Settings.Repeats);
+	FParse::Value(*Params, TEXT("tolerance="), Settings.Tolerance);
+	FParse::Value(*Params, TEXT("min_delta_ms="), Settings.MinDeltaMs);
+	FParse::Value(*Params, TEXT("job_timeout="), Settings.JobTimeoutSeconds);
+	FParse::Value(*Params, TEXT("label="), Settings.Label);
+	FParse::Value(*Params, TEXT("output="), Settings.OutputDir);
+	AddSetParam(Params, TEXT("skip="), Settings.Skip);
+	AddSetParam(Params, TEXT("ignore_keys="), Settings.IgnoreKeys);
+	const bool bReportOnly = FParse::Param(*Params, TEXT("report_only"));
+
+	TSharedPtr<FJsonObject> Report;
+	FString Error;
+	if (!FAgentForgeTraceReplay::Run(Settings, Report, Error))
+	{
+		UE_LOG(LogTemp, Error, TEXT("[UEAgentForge] Trace replay failed: %s"), *Error);
+		return 1;
+	}
+
+	const bool bPassed = Report->GetBoolField(TEXT("passed"));
+	UE_LOG(LogTemp, Display, TEXT("[UEAgentForge] Trace replay: %d replayed, %d skipped, %d unchecked, %d divergent, %d regressed, %d job timeouts."),
+		(int32)Report->GetNumberField(TEXT("replayed")), (int32)Report->GetNumberField(TEXT("skipped")),
+		(int32)Report->GetNumberField(TEXT("unchecked")), (int32)Report->GetNumberField(TEXT("divergences")),
+		(int32)Report->GetNumberField(TEXT("regressions")), (int32)Report->GetNumberField(TEXT("job_timeouts")));
+	UE_LOG(LogTemp, Display, TEXT("[UEAgentForge] Trace replay report: %s"), *Report->GetStringField(TEXT("json_path")));
+	UE_LOG(LogTemp, Display, TEXT("[UEAgentForge] Trace replay report: %s"), *Report->GetStringField(TEXT("csv_path")));
+	if (bPassed || bReportOnly)
+	{
+		return 0;
+	}
+	UE_LOG(LogTemp, Error, TEXT("[UEAgentForge] Trace replay did not pass; see the report."));
+	return 1;
+}
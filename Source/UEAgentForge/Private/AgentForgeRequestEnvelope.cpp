@@ -0,0 +1,206 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeRequestEnvelope.cpp — request_id stamping and the idempotency key store.
+
+#include "AgentForgeRequestEnvelope.h"
+
+#include "Dom/JsonValue.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Crc.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace
+{
+	static FString EnvelopeJsonToString(const TSharedPtr<FJsonObject>& Obj)
+	{
+		FString Out;
+		TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer =
+			TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Out);
+		FJsonSerializer::Serialize(Obj.ToSharedRef(), Writer);
+		return Out;
+	}
+
+	static const TCHAR* const RequestIdPrefix = TEXT("\"request_id\":");
+}
+
+FAgentForgeRequestEnvelope& FAgentForgeRequestEnvelope::Get()
+{
+	static FAgentForgeRequestEnvelope Instance;
+	return Instance;
+}
+
+FString FAgentForgeRequestEnvelope::ReadRequestId(const TSharedPtr<FJsonObject>& Root)
+{
+	const TSharedPtr<FJsonValue> IdValue = Root.IsValid() ? Root->TryGetField(TEXT("request_id")) : nullptr;
+	if (!IdValue.IsValid())
+	{
+		return FString();
+	}
+	switch (IdValue->Type)
+	{
+	case EJson::Number:
+	{
+		const double Number = IdValue->AsNumber();
+		return FMath::IsNearlyEqual(Number, FMath::RoundToDouble(Number))
+			? FString::Printf(TEXT("%lld"), static_cast<int64>(Number))
+			: FString::SanitizeFloat(Number);
+	}
+	case EJson::String:
+	{
+		// Reuse the serializer for escaping.
+		TSharedPtr<FJsonObject> Wrapper = MakeShared<FJsonObject>();
+		Wrapper->SetField(TEXT("v"), IdValue);
+		const FString Wrapped = EnvelopeJsonToString(Wrapper);   // {"v":"..."}
+		return Wrapped.Mid(5, Wrapped.Len() - 6);
+	}
+	default:
+		return FString();
+	}
+}
+
+FString FAgentForgeRequestEnvelope::PrependField(const FString& ResponseJson, const FString& FieldJson)
+{
+	// Splice after the opening brace instead of re-parsing a possibly large response.
+	int32 Open = 0;
+	while (Open < ResponseJson.Len() && FChar::IsWhitespace(ResponseJson[Open]))
+	{
+		++Open;
+	}
+	if (Open >= ResponseJson.Len() || ResponseJson[Open] != TEXT('{'))
+	{
+		return ResponseJson;
+	}
+	int32 Next = Open + 1;
+	while (Next < ResponseJson.Len() && FChar::IsWhitespace(ResponseJson[Next]))
+	{
+		++Next;
+	}
+	const bool bEmpty = Next < ResponseJson.Len() && ResponseJson[Next] == TEXT('}');
+
+	FString Out;
+	Out.Reserve(ResponseJson.Len() + FieldJson.Len() + 2);
+	Out += TEXT("{");
+	Out += FieldJson;
+	if (!bEmpty)
+	{
+		Out += TEXT(",");
+	}
+	Out.Append(*ResponseJson + Next, ResponseJson.Len() - Next);
+	return Out;
+}
+
+FString FAgentForgeRequestEnvelope::StampRequestId(const FString& ResponseJson, const FString& RequestIdJson)
+{
+	return RequestIdJson.IsEmpty()
+		? ResponseJson
+		: PrependField(ResponseJson, FString(RequestIdPrefix) + RequestIdJson);
+}
+
+FString FAgentForgeRequestEnvelope::UnstampRequestId(const FString& ResponseJson, const FString& RequestIdJson)
+{
+	if (RequestIdJson.IsEmpty())
+	{
+		return ResponseJson;
+	}
+	const FString Stamp = FString(TEXT("{")) + RequestIdPrefix + RequestIdJson;
+	if (!ResponseJson.StartsWith(Stamp, ESearchCase::CaseSensitive) || ResponseJson.Len() <= Stamp.Len())
+	{
+		return ResponseJson;
+	}
+	const TCHAR After = ResponseJson[Stamp.Len()];
+	if (After == TEXT('}'))
+	{
+		return TEXT("{}");
+	}
+	return After == TEXT(',')
+		? TEXT("{") + ResponseJson.Mid(Stamp.Len() + 1)
+		: ResponseJson;
+}
+
+bool FAgentForgeRequestEnvelope::IsErrorResponse(const FString& ResponseJson)
+{
+	// Handlers write the status first, so only the head is searched.
+	const FString Head = ResponseJson.Left(256);
+	return Head.Contains(TEXT("\"error\"")) || Head.Contains(TEXT("\"ok\": false")) || Head.Contains(TEXT("\"ok\":false"));
+}
+
+uint32 FAgentForgeRequestEnvelope::HashBody(const FString& Cmd, const TSharedPtr<FJsonObject>& Args)
+{
+	const uint32 CmdHash = FCrc::StrCrc32(*Cmd);
+	return Args.IsValid() ? FCrc::StrCrc32(*EnvelopeJsonToString(Args), CmdHash) : CmdHash;
+}
+
+void FAgentForgeRequestEnvelope::Prune(double Now)
+{
+	int32 Drop = 0;
+	while (Drop < Order.Num())
+	{
+		const FEntry* Entry = Entries.Find(Order[Drop]);
+		const bool bExpired = !Entry || Now - Entry->StoredSeconds > IdempotencyTtlSeconds;
+		if (!bExpired && Order.Num() - Drop < MaxIdempotencyKeys)
+		{
+			break;
+		}
+		if (Entry)
+		{
+			Entries.Remove(Order[Drop]);
+			++Evicted;
+		}
+		++Drop;
+	}
+	Order.RemoveAt(0, Drop, EAllowShrinking::No);
+}
+
+FAgentForgeRequestEnvelope::ELookup FAgentForgeRequestEnvelope::Lookup(const FString& Key, uint32 BodyHash, FString& OutResponse)
+{
+	const FEntry* Entry = Entries.Find(Key);
+	if (!Entry || FPlatformTime::Seconds() - Entry->StoredSeconds > IdempotencyTtlSeconds)
+	{
+		return ELookup::Miss;
+	}
+	if (Entry->BodyHash != BodyHash)
+	{
+		++Conflicts;
+		TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+		Obj->SetBoolField  (TEXT("ok"),    false);
+		Obj->SetStringField(TEXT("error"), FString::Printf(
+			TEXT("idempotency_key '%s' was already used for a different command body; use a new key for a new request."), *Key));
+		OutResponse = EnvelopeJsonToString(Obj);
+		return ELookup::Conflict;
+	}
+	++Replays;
+	OutResponse = PrependField(Entry->Response, TEXT("\"idempotent_replay\":true"));
+	return ELookup::Replay;
+}
+
+void FAgentForgeRequestEnvelope::Remember(const FString& Key, uint32 BodyHash, const FString& Response)
+{
+	const double Now = FPlatformTime::Seconds();
+	if (Entries.Contains(Key))
+	{
+		// An expired key being reused: drop the old slot so Order stays unique.
+		Entries.Remove(Key);
+		Order.RemoveAll([&Key](const FString& Stored) { return Stored.Equals(Key, ESearchCase::CaseSensitive); });
+	}
+	Prune(Now);
+
+	FEntry& Entry = Entries.Add(Key);
+	Entry.BodyHash      = BodyHash;
+	Entry.Response      = Response;
+	Entry.StoredSeconds = Now;
+	Order.Add(Key);
+	++Stored;
+}
+
+TSharedPtr<FJsonObject> FAgentForgeRequestEnvelope::GetStatsJson() const
+{
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetNumberField(TEXT("keys"),        Entries.Num());
+	Obj->SetNumberField(TEXT("max_keys"),    MaxIdempotencyKeys);
+	Obj->SetNumberField(TEXT("ttl_seconds"), IdempotencyTtlSeconds);
+	Obj->SetNumberField(TEXT("stored"),      static_cast<double>(Stored));
+	Obj->SetNumberField(TEXT("replays"),     static_cast<double>(Replays));
+	Obj->SetNumberField(TEXT("conflicts"),   static_cast<double>(Conflicts));
+	Obj->SetNumberField(TEXT("evicted"),     static_cast<double>(Evicted));
+	return Obj;
+}
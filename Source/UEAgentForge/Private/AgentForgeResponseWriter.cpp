@@ -0,0 +1,277 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeResponseWriter.cpp — JSON / CBOR streaming backends.
+
+#include "AgentForgeResponseWriter.h"
+
+#include "Misc/Base64.h"
+#include "Serialization/CborWriter.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/MemoryWriter.h"
+
+struct FAgentForgeResponseWriter::FCborState
+{
+	TArray<uint8> Bytes;
+	FMemoryWriter Archive;
+	FCborWriter   Writer;
+
+	explicit FCborState(int32 ReserveBytes)
+		: Archive(Bytes)
+		, Writer(&Archive, ECborEndianness::StandardCompliant)
+	{
+		Bytes.Reserve(ReserveBytes);
+	}
+};
+
+EAgentForgeResponseEncoding FAgentForgeResponseWriter::EncodingFromArgs(const TSharedPtr<FJsonObject>& Args)
+{
+	FString Encoding;
+	if (Args.IsValid() && Args->TryGetStringField(TEXT("encoding"), Encoding) && Encoding.Equals(TEXT("cbor"), ESearchCase::IgnoreCase))
+	{
+		return EAgentForgeResponseEncoding::Cbor;
+	}
+	return EAgentForgeResponseEncoding::Json;
+}
+
+FAgentForgeResponseWriter::FAgentForgeResponseWriter(EAgentForgeResponseEncoding InEncoding, int32 ReserveHint)
+	: Encoding(InEncoding)
+{
+	ReserveHint = FMath::Max(ReserveHint, 256);
+	if (Encoding == EAgentForgeResponseEncoding::Cbor)
+	{
+		Cbor = MakeUnique<FCborState>(ReserveHint / 2);
+	}
+	else
+	{
+		Text.Reserve(ReserveHint);
+		Json = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Text);
+	}
+}
+
+FAgentForgeResponseWriter::~FAgentForgeResponseWriter() = default;
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Containers
+// ─────────────────────────────────────────────────────────────────────────────
+void FAgentForgeResponseWriter::WriteKey(const FString& Name)
+{
+	// JSON takes the identifier with the value; CBOR map entries are key then value.
+	Cbor->Writer.WriteValue(Name);
+}
+
+void FAgentForgeResponseWriter::WriteObjectStart()
+{
+	if (Json.IsValid()) { Json->WriteObjectStart(); return; }
+	Cbor->Writer.WriteContainerStart(ECborCode::Map, -1);
+}
+
+void FAgentForgeResponseWriter::WriteObjectStart(const FString& Name)
+{
+	if (Json.IsValid()) { Json->WriteObjectStart(Name); return; }
+	WriteKey(Name);
+	Cbor->Writer.WriteContainerStart(ECborCode::Map, -1);
+}
+
+void FAgentForgeResponseWriter::WriteObjectEnd()
+{
+	if (Json.IsValid()) { Json->WriteObjectEnd(); return; }
+	Cbor->Writer.WriteContainerEnd();
+}
+
+void FAgentForgeResponseWriter::WriteArrayStart()
+{
+	if (Json.IsValid()) { Json->WriteArrayStart(); return; }
+	Cbor->Writer.WriteContainerStart(ECborCode::Array, -1);
+}
+
+void FAgentForgeResponseWriter::WriteArrayStart(const FString& Name)
+{
+	if (Json.IsValid()) { Json->WriteArrayStart(Name); return; }
+	WriteKey(Name);
+	Cbor->Writer.WriteContainerStart(ECborCode::Array, -1);
+}
+
+void FAgentForgeResponseWriter::WriteArrayEnd()
+{
+	if (Json.IsValid()) { Json->WriteArrayEnd(); return; }
+	Cbor->Writer.WriteContainerEnd();
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Named fields
+// ─────────────────────────────────────────────────────────────────────────────
+void FAgentForgeResponseWriter::WriteValue(const FString& Name, const FString& Value)
+{
+	if (Json.IsValid()) { Json->WriteValue(Name, Value); return; }
+	WriteKey(Name);
+	Cbor->Writer.WriteValue(Value);
+}
+
+void FAgentForgeResponseWriter::WriteValue(const FString& Name, const TCHAR* Value)
+{
+	WriteValue(Name, FString(Value));
+}
+
+void FAgentForgeResponseWriter::WriteValue(const FString& Name, double Value)
+{
+	if (Json.IsValid()) { Json->WriteValue(Name, Value); return; }
+	WriteKey(Name);
+	Cbor->Writer.WriteValue(Value);
+}
+
+void FAgentForgeResponseWriter::WriteValue(const FString& Name, int32 Value)
+{
+	WriteValue(Name, static_cast<int64>(Value));
+}
+
+void FAgentForgeResponseWriter::WriteValue(const FString& Name, int64 Value)
+{
+	if (Json.IsValid()) { Json->WriteValue(Name, Value); return; }
+	WriteKey(Name);
+	Cbor->Writer.WriteValue(Value);
+}
+
+void FAgentForgeResponseWriter::WriteValue(const FString& Name, bool Value)
+{
+	if (Json.IsValid()) { Json->WriteValue(Name, Value); return; }
+	WriteKey(Name);
+	Cbor->Writer.WriteValue(Value);
+}
+
+void FAgentForgeResponseWriter::WriteNull(const FString& Name)
+{
+	if (Json.IsValid()) { Json->WriteNull(Name); return; }
+	WriteKey(Name);
+	Cbor->Writer.WriteNull();
+}
+
+void FAgentForgeResponseWriter::WriteVector(const FString& Name, const FVector& Value)
+{
+	WriteObjectStart(Name);
+	WriteValue(TEXT("x"), Value.X);
+	WriteValue(TEXT("y"), Value.Y);
+	WriteValue(TEXT("z"), Value.Z);
+	WriteObjectEnd();
+}
+
+void FAgentForgeResponseWriter::WriteJsonValue(const FString& Name, const TSharedPtr<FJsonValue>& Value)
+{
+	if (!Value.IsValid())
+	{
+		WriteNull(Name);
+		return;
+	}
+	if (Json.IsValid())
+	{
+		FJsonSerializer::Serialize(Value, Name, Json.ToSharedRef(), false);
+		return;
+	}
+	WriteKey(Name);
+	WriteCborJsonValue(Value);
+}
+
+void FAgentForgeResponseWriter::WriteJsonObject(const FString& Name, const TSharedPtr<FJsonObject>& Value)
+{
+	WriteJsonValue(Name, Value.IsValid() ? MakeShared<FJsonValueObject>(Value) : TSharedPtr<FJsonValue>());
+}
+
+void FAgentForgeResponseWriter::WriteCborJsonValue(const TSharedPtr<FJsonValue>& Value)
+{
+	FCborWriter& Writer = Cbor->Writer;
+	switch (Value.IsValid() ? Value->Type : EJson::Null)
+	{
+	case EJson::String:
+		Writer.WriteValue(Value->AsString());
+		break;
+	case EJson::Number:
+	{
+		const double Number = Value->AsNumber();
+		const double Whole  = FMath::RoundToDouble(Number);
+		if (Number == Whole && FMath::Abs(Number) < 9007199254740992.0)   // exact in a double
+		{
+			Writer.WriteValue(static_cast<int64>(Whole));
+		}
+		else
+		{
+			Writer.WriteValue(Number);
+		}
+		break;
+	}
+	case EJson::Boolean:
+		Writer.WriteValue(Value->AsBool());
+		break;
+	case EJson::Array:
+		Writer.WriteContainerStart(ECborCode::Array, -1);
+		for (const TSharedPtr<FJsonValue>& Element : Value->AsArray())
+		{
+			WriteCborJsonValue(Element);
+		}
+		Writer.WriteContainerEnd();
+		break;
+	case EJson::Object:
+	{
+		Writer.WriteContainerStart(ECborCode::Map, -1);
+		const TSharedPtr<FJsonObject> Obj = Value->AsObject();
+		if (Obj.IsValid())
+		{
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : Obj->Values)
+			{
+				Writer.WriteValue(Pair.Key);
+				WriteCborJsonValue(Pair.Value);
+			}
+		}
+		Writer.WriteContainerEnd();
+		break;
+	}
+	default:
+		Writer.WriteNull();
+		break;
+	}
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Array elements
+// ─────────────────────────────────────────────────────────────────────────────
+void FAgentForgeResponseWriter::WriteValue(const FString& Value)
+{
+	if (Json.IsValid()) { Json->WriteValue(Value); return; }
+	Cbor->Writer.WriteValue(Value);
+}
+
+void FAgentForgeResponseWriter::WriteValue(const TCHAR* Value)
+{
+	WriteValue(FString(Value));
+}
+
+void FAgentForgeResponseWriter::WriteValue(double Value)
+{
+	if (Json.IsValid()) { Json->WriteValue(Value); return; }
+	Cbor->Writer.WriteValue(Value);
+}
+
+void FAgentForgeResponseWriter::WriteValue(int32 Value)
+{
+	if (Json.IsValid()) { Json->WriteValue(Value); return; }
+	Cbor->Writer.WriteValue(static_cast<int64>(Value));
+}
+
+void FAgentForgeResponseWriter::WriteValue(bool Value)
+{
+	if (Json.IsValid()) { Json->WriteValue(Value); return; }
+	Cbor->Writer.WriteValue(Value);
+}
+
+FString FAgentForgeResponseWriter::Finish()
+{
+	if (Json.IsValid())
+	{
+		check(!bFinished);
+		Json->Close();
+		bFinished = true;
+		return MoveTemp(Text);
+	}
+
+	bFinished = true;
+	return FString::Printf(
+		TEXT("{\"ok\":true,\"encoding\":\"cbor\",\"bytes\":%d,\"data\":\"%s\"}"),
+		Cbor->Bytes.Num(), *FBase64::Encode(Cbor->Bytes));
+}
@@ -0,0 +1,343 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeRuntimeCost.cpp — world snapshot, neighbour counts, placement admission.
+
+#include "AgentForgeRuntimeCost.h"
+
+#include "Components/LocalLightComponent.h"
+#include "Engine/Light.h"
+#include "Engine/PointLight.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "LevelPresetSystem.h"
+#include "Sound/AmbientSound.h"
+
+namespace
+{
+	// Label prefixes of the Phase V stand-ins ("VFX_<effect>_NN", "Audio_<soundscape>_NN").
+	static const TCHAR* EmitterPrefix = TEXT("VFX_");
+	static const TCHAR* AudioPrefix   = TEXT("Audio_");
+
+	// Audio proxies are unit cubes scaled to cover their room: half-extent = scale * 50.
+	static constexpr float AudioProxyHalfExtent = 50.0f;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Budgets and reports
+// ─────────────────────────────────────────────────────────────────────────────
+FAgentForgeRuntimeCost& FAgentForgeRuntimeCost::Get()
+{
+	static FAgentForgeRuntimeCost Instance;
+	return Instance;
+}
+
+FAgentForgeRuntimeCost::FBudget FAgentForgeRuntimeCost::GetBudget(const FLevelPreset& Preset) const
+{
+	FBudget B;
+	B.MaxShadowLightOverlap = FMath::Max(1, FMath::Min(Preset.MaxShadowLightOverlap, PolicyCaps.MaxShadowLightOverlap));
+	B.MaxParticleOverdraw   = FMath::Max(0.0f, FMath::Min(Preset.MaxParticleOverdraw, PolicyCaps.MaxParticleOverdraw));
+	B.MaxAudioVoices        = FMath::Max(1, FMath::Min(Preset.MaxAudioVoices, PolicyCaps.MaxAudioVoices));
+	return B;
+}
+
+float FAgentForgeRuntimeCost::GetEmitterWeight(const FString& Effect)
+{
+	if (Effect.Contains(TEXT("smoke")) || Effect.Contains(TEXT("fog")))    { return 2.0f; }
+	if (Effect.Contains(TEXT("steam")))                                   { return 1.5f; }
+	if (Effect.Contains(TEXT("ember")) || Effect.Contains(TEXT("spark")) ||
+	    Effect.Contains(TEXT("leaves")))                                  { return 0.5f; }
+	return 1.0f;
+}
+
+TSharedPtr<FJsonObject> FAgentForgeRuntimeCost::FBudget::ToJson() const
+{
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetNumberField(TEXT("max_shadow_light_overlap"), MaxShadowLightOverlap);
+	Obj->SetNumberField(TEXT("max_particle_overdraw"),    MaxParticleOverdraw);
+	Obj->SetNumberField(TEXT("max_audio_voices"),         MaxAudioVoices);
+	return Obj;
+}
+
+bool FAgentForgeRuntimeCost::FEstimate::WithinBudget() const
+{
+	return ShadowOverlapPeak <= Budget.MaxShadowLightOverlap
+	    && OverdrawPeak      <= Budget.MaxParticleOverdraw + KINDA_SMALL_NUMBER
+	    && AudioVoicesPeak   <= Budget.MaxAudioVoices;
+}
+
+TSharedPtr<FJsonObject> FAgentForgeRuntimeCost::FEstimate::ToJson() const
+{
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetNumberField(TEXT("shadow_lights"),       ShadowLights);
+	Obj->SetNumberField(TEXT("shadow_overlap_peak"), ShadowOverlapPeak);
+	Obj->SetNumberField(TEXT("emitters"),            Emitters);
+	Obj->SetNumberField(TEXT("overdraw_peak"),       OverdrawPeak);
+	Obj->SetNumberField(TEXT("audio_emitters"),      AudioEmitters);
+	Obj->SetNumberField(TEXT("audio_voices_peak"),   AudioVoicesPeak);
+	Obj->SetBoolField  (TEXT("within_budget"),       WithinBudget());
+	Obj->SetObjectField(TEXT("budget"),              Budget.ToJson());
+	return Obj;
+}
+
+void FAgentForgeRuntimeCost::FActions::WriteTo(const TSharedPtr<FJsonObject>& Obj) const
+{
+	Obj->SetNumberField(TEXT("lights_downgraded"), LightsDowngraded);
+	Obj->SetNumberField(TEXT("lights_merged"),     LightsMerged);
+	Obj->SetNumberField(TEXT("lights_culled"),     LightsCulled);
+	Obj->SetNumberField(TEXT("vfx_culled"),        EmittersCulled);
+	Obj->SetNumberField(TEXT("audio_merged"),      AudioMerged);
+	Obj->SetNumberField(TEXT("audio_culled"),      AudioCulled);
+}
+
+FAgentForgeRuntimeCost::FEstimate FAgentForgeRuntimeCost::Estimate(UWorld* World, const FBudget& Budget)
+{
+	return FPlanner(World, Budget).GetEstimate();
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  FPlanner — seeded from the world
+// ─────────────────────────────────────────────────────────────────────────────
+FAgentForgeRuntimeCost::FPlanner::FPlanner(UWorld* World, const FBudget& InBudget)
+	: Budget(InBudget)
+{
+	check(IsInGameThread());
+	if (!World) { return; }
+
+	for (TActorIterator<ALight> It(World); It; ++It)
+	{
+		ALight* Light = *It;
+		const ULocalLightComponent* LC = IsValid(Light) ? Cast<ULocalLightComponent>(Light->GetLightComponent()) : nullptr;
+		// Static lights are baked and cost nothing at runtime.
+		if (!LC || LC->Mobility == EComponentMobility::Static || LC->AttenuationRadius <= 0.0f) { continue; }
+		PushLight(LC->GetComponentLocation(), LC->AttenuationRadius, LC->CastShadows, Light->IsA<APointLight>(), Light);
+	}
+
+#if WITH_EDITOR
+	for (TActorIterator<AActor> It(World); It; ++It)
+	{
+		AActor* Actor = *It;
+		if (!IsValid(Actor)) { continue; }
+		const FString Label = Actor->GetActorLabel();
+		if (Label.StartsWith(EmitterPrefix))
+		{
+			// "VFX_<effect>_NN"
+			FString Effect = Label.Mid(FCString::Strlen(EmitterPrefix));
+			int32 Underscore = INDEX_NONE;
+			if (Effect.FindLastChar(TEXT('_'), Underscore)) { Effect.LeftInline(Underscore); }
+			PushEmitter(Actor->GetActorLocation(), GetEmitterWeight(Effect));
+		}
+		else if (Label.StartsWith(AudioPrefix))
+		{
+			PushAudio(FBox::BuildAABB(Actor->GetActorLocation(), Actor->GetActorScale3D().GetAbs() * AudioProxyHalfExtent), Actor);
+		}
+		else if (Actor->IsA<AAmbientSound>())
+		{
+			PushAudio(FBox::BuildAABB(Actor->GetActorLocation(), FVector::ZeroVector), Actor);
+		}
+	}
+#endif
+}
+
+void FAgentForgeRuntimeCost::FPlanner::PushLight(const FVector& Location, float Radius, bool bShadowed,
+                                                  bool bMergeable, AActor* Actor)
+{
+	FLightSource New;
+	New.Location   = Location;
+	New.Radius     = Radius;
+	New.bShadowed  = bShadowed;
+	New.bMergeable = bMergeable;
+	New.Actor      = Actor;
+	for (FLightSource& L : Lights)
+	{
+		if (FVector::Dist(L.Location, Location) < L.Radius + Radius)
+		{
+			++New.Neighbours;
+			++L.Neighbours;
+			New.ShadowNeighbours += L.bShadowed ? 1 : 0;
+			L.ShadowNeighbours   += bShadowed ? 1 : 0;
+		}
+	}
+	Lights.Add(New);
+}
+
+void FAgentForgeRuntimeCost::FPlanner::PushEmitter(const FVector& Location, float Weight)
+{
+	FEmitterSource New;
+	New.Location = Location;
+	New.Weight   = Weight;
+	New.Overdraw = Weight;
+	for (FEmitterSource& E : Emitters)
+	{
+		if (FVector::DistSquared(E.Location, Location) < FMath::Square(OverdrawRadius))
+		{
+			New.Overdraw += E.Weight;
+			E.Overdraw   += Weight;
+		}
+	}
+	Emitters.Add(New);
+}
+
+void FAgentForgeRuntimeCost::FPlanner::PushAudio(const FBox& Bounds, AActor* Actor)
+{
+	FAudioSource New;
+	New.Audible = Bounds.ExpandBy(AudibleMargin);
+	New.Actor   = Actor;
+	for (FAudioSource& A : Audio)
+	{
+		if (A.Audible.Intersect(New.Audible))
+		{
+			++New.Voices;
+			++A.Voices;
+		}
+	}
+	Audio.Add(New);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  FPlanner — admission
+// ─────────────────────────────────────────────────────────────────────────────
+FAgentForgeRuntimeCost::EPlacement FAgentForgeRuntimeCost::FPlanner::AddLight(
+	const FVector& Location, float Radius, bool bAllowMerge, AActor*& OutMergeInto)
+{
+	OutMergeInto = nullptr;
+	Last = ELast::None;
+
+	if (bAllowMerge)
+	{
+		double BestDist = TNumericLimits<double>::Max();
+		for (const FLightSource& L : Lights)
+		{
+			const double Dist = FVector::Dist(L.Location, Location);
+			if (L.bMergeable && L.Actor.IsValid() && Dist < MergeFraction * FMath::Max(L.Radius, Radius) && Dist < BestDist)
+			{
+				BestDist = Dist;
+				OutMergeInto = L.Actor.Get();
+			}
+		}
+		if (OutMergeInto) { return EPlacement::Merge; }
+	}
+
+	// Shadowed: no shadow overlap, this light's or a neighbour's, may pass the budget.
+	// Unshadowed: the same for every light against twice the budget.
+	const int32 ShadowCap = Budget.MaxShadowLightOverlap;
+	const int32 LightCap  = Budget.MaxShadowLightOverlap * 2;
+	int32 Shadow = 0, All = 0;
+	bool  bShadowFits = true, bLightFits = true;
+	for (const FLightSource& L : Lights)
+	{
+		if (FVector::Dist(L.Location, Location) >= L.Radius + Radius) { continue; }
+		++All;
+		bLightFits &= L.Neighbours + 2 <= LightCap;
+		if (L.bShadowed)
+		{
+			++Shadow;
+			bShadowFits &= L.ShadowNeighbours + 2 <= ShadowCap;
+		}
+	}
+	bShadowFits &= Shadow + 1 <= ShadowCap;
+	bLightFits  &= All + 1 <= LightCap;
+
+	if (!bLightFits) { return EPlacement::Cull; }
+	PushLight(Location, Radius, bShadowFits, true, nullptr);
+	Last = ELast::Light;
+	return bShadowFits ? EPlacement::Place : EPlacement::Downgrade;
+}
+
+bool FAgentForgeRuntimeCost::FPlanner::AddEmitter(const FVector& Location, const FString& Effect)
+{
+	Last = ELast::None;
+	const float Weight = GetEmitterWeight(Effect);
+	const float Cap = Budget.MaxParticleOverdraw + KINDA_SMALL_NUMBER;
+	float Overdraw = Weight;
+	for (const FEmitterSource& E : Emitters)
+	{
+		if (FVector::DistSquared(E.Location, Location) < FMath::Square(OverdrawRadius))
+		{
+			if (E.Overdraw + Weight > Cap) { return false; }
+			Overdraw += E.Weight;
+		}
+	}
+	if (Overdraw > Cap) { return false; }
+	PushEmitter(Location, Weight);
+	return true;
+}
+
+FAgentForgeRuntimeCost::EPlacement FAgentForgeRuntimeCost::FPlanner::AddAudio(
+	const FBox& Bounds, AActor*& OutMergeInto, FBox& OutMergedBounds)
+{
+	OutMergeInto = nullptr;
+	Last = ELast::None;
+
+	const FBox Audible = Bounds.ExpandBy(AudibleMargin);
+	int32 Voices = 1;
+	bool  bFits = true;
+	int32 Nearest = INDEX_NONE;
+	double NearestDist = TNumericLimits<double>::Max();
+	for (int32 i = 0; i < Audio.Num(); ++i)
+	{
+		const FAudioSource& A = Audio[i];
+		if (!A.Audible.Intersect(Audible)) { continue; }
+		++Voices;
+		bFits &= A.Voices + 1 <= Budget.MaxAudioVoices;
+		const double Dist = FVector::Dist(A.Audible.GetCenter(), Audible.GetCenter());
+		if (A.Actor.IsValid() && Dist < NearestDist)
+		{
+			NearestDist = Dist;
+			Nearest = i;
+		}
+	}
+	bFits &= Voices <= Budget.MaxAudioVoices;
+
+	if (bFits)
+	{
+		PushAudio(Bounds, nullptr);
+		Last = ELast::Audio;
+		return EPlacement::Place;
+	}
+	if (Nearest == INDEX_NONE) { return EPlacement::Cull; }
+
+	// One voice covers both: grow the nearest emitter, counting the sources it now reaches.
+	FAudioSource& Target = Audio[Nearest];
+	const FBox OldAudible = Target.Audible;
+	Target.Audible = OldAudible + Audible;
+	for (int32 i = 0; i < Audio.Num(); ++i)
+	{
+		if (i != Nearest && !Audio[i].Audible.Intersect(OldAudible) && Audio[i].Audible.Intersect(Target.Audible))
+		{
+			++Audio[i].Voices;
+			++Target.Voices;
+		}
+	}
+	OutMergeInto    = Target.Actor.Get();
+	OutMergedBounds = Target.Audible.ExpandBy(-AudibleMargin);
+	return EPlacement::Merge;
+}
+
+void FAgentForgeRuntimeCost::FPlanner::BindLast(AActor* Actor)
+{
+	if (Last == ELast::Light)      { Lights.Last().Actor = Actor; }
+	else if (Last == ELast::Audio) { Audio.Last().Actor = Actor; }
+	Last = ELast::None;
+}
+
+FAgentForgeRuntimeCost::FEstimate FAgentForgeRuntimeCost::FPlanner::GetEstimate() const
+{
+	FEstimate Out;
+	Out.Budget = Budget;
+	for (const FLightSource& L : Lights)
+	{
+		if (!L.bShadowed) { continue; }
+		++Out.ShadowLights;
+		Out.ShadowOverlapPeak = FMath::Max(Out.ShadowOverlapPeak, L.ShadowNeighbours + 1);
+	}
+	Out.Emitters = Emitters.Num();
+	for (const FEmitterSource& E : Emitters)
+	{
+		Out.OverdrawPeak = FMath::Max(Out.OverdrawPeak, E.Overdraw);
+	}
+	Out.AudioEmitters = Audio.Num();
+	for (const FAudioSource& A : Audio)
+	{
+		Out.AudioVoicesPeak = FMath::Max(Out.AudioVoicesPeak, A.Voices);
+	}
+	return Out;
+}
@@ -0,0 +1,549 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeSocketServer.cpp — WebSocket transport: connections, request drain, events.
+
+#include "AgentForgeSocketServer.h"
+
+#include "AgentForgeCommandProfile.h"
+#include "AgentForgeCommandQueue.h"
+#include "AgentForgeJobManager.h"
+#include "AgentForgeLibrary.h"
+#include "AgentForgeRequestEnvelope.h"
+#include "AgentForgeStringKeys.h"
+#include "Dom/JsonValue.h"
+#include "HAL/PlatformTime.h"
+#include "INetworkingWebSocket.h"
+#include "IWebSocketNetworkingModule.h"
+#include "IWebSocketServer.h"
+#include "Modules/ModuleManager.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "WebSocketNetworkingDelegates.h"
+
+namespace
+{
+	/** Minimum interval between job_progress events for the same job. */
+	static constexpr double JobProgressIntervalSeconds = 0.1;
+
+	static FString SocketJsonToString(const TSharedPtr<FJsonObject>& Obj)
+	{
+		FString Out;
+		TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer =
+			TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Out);
+		FJsonSerializer::Serialize(Obj.ToSharedRef(), Writer);
+		return Out;
+	}
+
+	static FString SocketErrorJson(const FString& Msg)
+	{
+		TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+		Obj->SetBoolField(TEXT("ok"), false);
+		Obj->SetStringField(TEXT("error"), Msg);
+		return SocketJsonToString(Obj);
+	}
+
+	/** Serialize a scalar request id back to JSON text ("null" for anything else). */
+	static FString SerializeRequestId(const TSharedPtr<FJsonValue>& IdValue)
+	{
+		if (!IdValue.IsValid())
+		{
+			return TEXT("null");
+		}
+		switch (IdValue->Type)
+		{
+		case EJson::Number:
+		{
+			const double Number = IdValue->AsNumber();
+			return FMath::IsNearlyEqual(Number, FMath::RoundToDouble(Number))
+				? FString::Printf(TEXT("%lld"), static_cast<int64>(Number))
+				: FString::SanitizeFloat(Number);
+		}
+		case EJson::String:
+		{
+			// Reuse the serializer for escaping.
+			TSharedPtr<FJsonObject> Wrapper = MakeShared<FJsonObject>();
+			Wrapper->SetField(TEXT("v"), IdValue);
+			const FString Wrapped = SocketJsonToString(Wrapper);   // {"v":"..."}
+			return Wrapped.Mid(5, Wrapped.Len() - 6);
+		}
+		default:
+			return TEXT("null");
+		}
+	}
+}
+
+FAgentForgeSocketServer& FAgentForgeSocketServer::Get()
+{
+	static FAgentForgeSocketServer Instance;
+	return Instance;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Lifecycle
+// ─────────────────────────────────────────────────────────────────────────────
+bool FAgentForgeSocketServer::Start(int32 Port, const FString& InBindAddress, FString& OutError)
+{
+	check(IsInGameThread());
+	if (IsRunning())
+	{
+		if (Port == ListenPort)
+		{
+			return true;
+		}
+		OutError = FString::Printf(TEXT("Socket server already listening on port %d; stop it first."), ListenPort);
+		return false;
+	}
+	if (Port <= 0 || Port > 65535)
+	{
+		OutError = FString::Printf(TEXT("Invalid port: %d"), Port);
+		return false;
+	}
+
+	IWebSocketNetworkingModule* Module = FModuleManager::LoadModulePtr<IWebSocketNetworkingModule>(TEXT("WebSocketNetworking"));
+	if (!Module)
+	{
+		OutError = TEXT("WebSocketNetworking module unavailable; enable the WebSocketNetworking plugin.");
+		return false;
+	}
+
+	TUniquePtr<IWebSocketServer> NewServer = Module->CreateServer();
+	if (!NewServer.IsValid())
+	{
+		OutError = TEXT("WebSocketNetworking failed to create a server.");
+		return false;
+	}
+
+	FWebSocketClientConnectedCallBack OnConnected;
+	OnConnected.BindRaw(this, &FAgentForgeSocketServer::HandleClientConnected);
+	const FString Address = InBindAddress.IsEmpty() ? TEXT("127.0.0.1") : InBindAddress;
+	if (!NewServer->Init(static_cast<uint32>(Port), OnConnected, Address))
+	{
+		OutError = FString::Printf(TEXT("Could not listen on %s:%d."), *Address, Port);
+		return false;
+	}
+
+	Server         = MoveTemp(NewServer);
+	ListenPort     = Port;
+	BindAddress    = Address;
+	bStopRequested = false;
+
+	TickHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateRaw(this, &FAgentForgeSocketServer::Tick));
+	JobEventHandle = FAgentForgeJobManager::Get().OnJobEvent().AddRaw(this, &FAgentForgeSocketServer::HandleJobEvent);
+
+	UE_LOG(LogTemp, Log, TEXT("[UEAgentForge] Socket server listening on ws://%s:%d"), *BindAddress, ListenPort);
+	return true;
+}
+
+void FAgentForgeSocketServer::Stop()
+{
+	check(IsInGameThread());
+	if (CurrentConnectionId != 0)
+	{
+		// Called from a command arriving over the socket itself; finish the drain first.
+		bStopRequested = true;
+		return;
+	}
+	StopNow();
+}
+
+void FAgentForgeSocketServer::StopNow()
+{
+	if (TickHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+		TickHandle.Reset();
+	}
+	if (JobEventHandle.IsValid())
+	{
+		FAgentForgeJobManager::Get().OnJobEvent().Remove(JobEventHandle);
+		JobEventHandle.Reset();
+	}
+
+	const bool bWasRunning = Server.IsValid();
+	Pending.Reset();
+	Connections.Reset();
+	JobOwners.Reset();
+	JobLastProgressSent.Reset();
+	Server.Reset();
+	ListenPort     = 0;
+	bStopRequested = false;
+
+	if (bWasRunning)
+	{
+		UE_LOG(LogTemp, Log, TEXT("[UEAgentForge] Socket server stopped."));
+	}
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Connections and requests
+// ─────────────────────────────────────────────────────────────────────────────
+void FAgentForgeSocketServer::HandleClientConnected(INetworkingWebSocket* Socket)
+{
+	if (!Socket)
+	{
+		return;
+	}
+
+	TUniquePtr<FConnection> Connection = MakeUnique<FConnection>();
+	Connection->Id             = NextConnectionId++;
+	Connection->Socket         = TUniquePtr<INetworkingWebSocket>(Socket);
+	Connection->RemoteEndPoint = Socket->RemoteEndPoint(true);
+
+	const int32 ConnectionId = Connection->Id;
+	FWebSocketPacketReceivedCallBack OnReceive;
+	OnReceive.BindLambda([this, ConnectionId](void* Data, int32 Count)
+	{
+		if (!Data || Count <= 0)
+		{
+			return;
+		}
+		const FUTF8ToTCHAR Converted(static_cast<const ANSICHAR*>(Data), Count);
+		HandleMessage(ConnectionId, FString(Converted.Length(), Converted.Get()));
+	});
+	Socket->SetReceiveCallBack(OnReceive);
+
+	FWebSocketInfoCallBack OnClosed;
+	OnClosed.BindLambda([this, ConnectionId]()
+	{
+		// Removed after the server tick; the socket must outlive its own callback.
+		if (FConnection* Closed = FindConnection(ConnectionId))
+		{
+			Closed->bClosed = true;
+		}
+	});
+	Socket->SetSocketClosedCallBack(OnClosed);
+
+	UE_LOG(LogTemp, Log, TEXT("[UEAgentForge] Socket client %d connected from %s."), ConnectionId, *Connection->RemoteEndPoint);
+	Connections.Add(MoveTemp(Connection));
+}
+
+void FAgentForgeSocketServer::HandleMessage(int32 ConnectionId, const FString& Message)
+{
+	++MessagesReceived;
+	FConnection* Connection = FindConnection(ConnectionId);
+	if (!Connection)
+	{
+		return;
+	}
+
+	const double ParseStartSeconds = FPlatformTime::Seconds();
+	TSharedPtr<FJsonObject> Root;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Message);
+	if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid())
+	{
+		++RequestsRejected;
+		SendResponse(ConnectionId, TEXT("null"), SocketErrorJson(TEXT("Invalid JSON message.")));
+		return;
+	}
+
+	const FString IdJson = SerializeRequestId(Root->TryGetField(TEXT("id")));
+
+	FString Cmd;
+	Root->TryGetStringField(TEXT("cmd"), Cmd);
+	if (Cmd.Equals(TEXT("subscribe"), ESearchCase::IgnoreCase) || Cmd.Equals(TEXT("unsubscribe"), ESearchCase::IgnoreCase))
+	{
+		const TSharedPtr<FJsonObject>* ArgsPtr = nullptr;
+		Root->TryGetObjectField(TEXT("args"), ArgsPtr);
+		HandleSubscription(*Connection, IdJson, ArgsPtr ? *ArgsPtr : nullptr, Cmd.Equals(TEXT("subscribe"), ESearchCase::IgnoreCase));
+		return;
+	}
+
+	if (Pending.Num() >= MaxPendingRequests)
+	{
+		++RequestsRejected;
+		SendResponse(ConnectionId, IdJson, SocketErrorJson(TEXT("Socket request queue full; retry later.")));
+		return;
+	}
+
+	FPendingRequest& Request = Pending.AddDefaulted_GetRef();
+	Request.ConnectionId = ConnectionId;
+	Request.IdJson       = IdJson;
+	Request.Message      = Message;
+	Request.Root         = Root;
+	Request.ReceivedSeconds = FPlatformTime::Seconds();
+	Request.ParseMs      = (Request.ReceivedSeconds - ParseStartSeconds) * 1000.0;
+}
+
+void FAgentForgeSocketServer::HandleSubscription(FConnection& Connection, const FString& IdJson, const TSharedPtr<FJsonObject>& Args, bool bSubscribe)
+{
+	TArray<FString> Events;
+	const TArray<TSharedPtr<FJsonValue>>* EventArr = nullptr;
+	if (Args.IsValid() && Args->TryGetArrayField(TEXT("events"), EventArr))
+	{
+		for (const TSharedPtr<FJsonValue>& Value : *EventArr)
+		{
+			FString Name;
+			if (Value.IsValid() && Value->TryGetString(Name) && !Name.IsEmpty())
+			{
+				Events.Add(Name.ToLower());
+			}
+		}
+	}
+	if (Events.IsEmpty())
+	{
+		Events.Add(TEXT("*"));
+	}
+
+	for (const FString& Name : Events)
+	{
+		if (bSubscribe) { Connection.Subscriptions.Add(Name); }
+		else            { Connection.Subscriptions.Remove(Name); }
+	}
+
+	TArray<TSharedPtr<FJsonValue>> Current;
+	for (const FString& Name : Connection.Subscriptions)
+	{
+		Current.Add(MakeShared<FJsonValueString>(Name));
+	}
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetBoolField (TEXT("ok"),            true);
+	Obj->SetArrayField(TEXT("subscriptions"), Current);
+	SendResponse(Connection.Id, IdJson, SocketJsonToString(Obj));
+}
+
+bool FAgentForgeSocketServer::Tick(float /*DeltaTime*/)
+{
+	if (!Server.IsValid())
+	{
+		return false;
+	}
+
+	// Pumps accept/receive/close callbacks (all on this thread).
+	Server->Tick();
+
+	// Drain in arrival order within the shared command-queue frame budget.
+	const double Start         = FPlatformTime::Seconds();
+	const double BudgetSeconds = FAgentForgeCommandQueue::Get().GetFrameBudgetMs() / 1000.0;
+	const bool   bCoalesceNow  = FAgentForgeCommandQueue::Get().IsCoalesceEnabled();
+	TMap<FString, FString, FDefaultSetAllocator, TAgentForgeCaseSensitiveKeyFuncs<FString>> QueryResults;   // cleared by any non-query, as in the command queue
+	int32 Processed = 0;
+	while (Processed < Pending.Num() && (Processed == 0 || FPlatformTime::Seconds() - Start < BudgetSeconds))
+	{
+		const FPendingRequest Request = MoveTemp(Pending[Processed++]);
+		FConnection* Connection = FindConnection(Request.ConnectionId);
+		if (!Connection || Connection->bClosed)
+		{
+			continue;
+		}
+
+		CurrentConnectionId  = Request.ConnectionId;
+		CurrentRequestIdJson = Request.IdJson;
+		FString Result;
+		FString CoalesceKey;
+		FString RequestIdJson;
+		if (bCoalesceNow && FAgentForgeCommandQueue::MakeCoalesceKey(Request.Root, CoalesceKey, RequestIdJson))
+		{
+			if (const FString* Cached = QueryResults.Find(CoalesceKey))
+			{
+				Result = FAgentForgeRequestEnvelope::StampRequestId(*Cached, RequestIdJson);
+				++RequestsCoalesced;
+			}
+			else
+			{
+				FAgentForgeCommandProfile::SetPendingWaitMs((FPlatformTime::Seconds() - Request.ReceivedSeconds) * 1000.0);
+				Result = UAgentForgeLibrary::ExecuteParsedCommandJson(Request.Message, Request.Root, Request.ParseMs);
+				QueryResults.Add(CoalesceKey, FAgentForgeRequestEnvelope::UnstampRequestId(Result, RequestIdJson));
+			}
+		}
+		else
+		{
+			QueryResults.Reset();
+			FAgentForgeCommandProfile::SetPendingWaitMs((FPlatformTime::Seconds() - Request.ReceivedSeconds) * 1000.0);
+			Result = UAgentForgeLibrary::ExecuteParsedCommandJson(Request.Message, Request.Root, Request.ParseMs);
+		}
+		CurrentConnectionId  = 0;
+		CurrentRequestIdJson.Reset();
+
+		// Async submissions: route that job's events back to this connection.
+		if (Result.Contains(TEXT("\"job_id\"")))
+		{
+			TSharedPtr<FJsonObject> ResultObj;
+			TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Result);
+			FString JobId;
+			if (FJsonSerializer::Deserialize(Reader, ResultObj) && ResultObj.IsValid()
+				&& ResultObj->TryGetStringField(TEXT("job_id"), JobId))
+			{
+				JobOwners.Add(JobId, Request.ConnectionId);
+			}
+		}
+
+		SendResponse(Request.ConnectionId, Request.IdJson, Result);
+	}
+	Pending.RemoveAt(0, Processed, EAllowShrinking::No);
+
+	Connections.RemoveAll([](const TUniquePtr<FConnection>& Connection) { return Connection->bClosed; });
+
+	if (bStopRequested)
+	{
+		StopNow();
+		return false;
+	}
+	return true;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Events
+// ─────────────────────────────────────────────────────────────────────────────
+void FAgentForgeSocketServer::PushEvent(const FString& EventName, const TSharedPtr<FJsonObject>& Data)
+{
+	if (!Server.IsValid() || !Data.IsValid())
+	{
+		return;
+	}
+
+	const FString Name     = EventName.ToLower();
+	const FString DataJson = SocketJsonToString(Data);
+	if (CurrentConnectionId != 0)
+	{
+		SendEvent(CurrentConnectionId, Name, FString::Printf(TEXT(",\"request_id\":%s"), *CurrentRequestIdJson), DataJson);
+	}
+	for (const TUniquePtr<FConnection>& Connection : Connections)
+	{
+		if (Connection->Id != CurrentConnectionId && !Connection->bClosed
+			&& (Connection->Subscriptions.Contains(Name) || Connection->Subscriptions.Contains(TEXT("*"))))
+		{
+			SendEvent(Connection->Id, Name, FString(), DataJson);
+		}
+	}
+}
+
+void FAgentForgeSocketServer::PushJobEvent(const FString& JobId, const FString& EventName, const TSharedPtr<FJsonObject>& Data)
+{
+	if (!Server.IsValid() || !Data.IsValid())
+	{
+		return;
+	}
+
+	const FString Name     = EventName.ToLower();
+	const FString DataJson = SocketJsonToString(Data);
+	const int32*  Owner    = JobOwners.Find(JobId);
+	const int32   OwnerId  = Owner ? *Owner : 0;
+	if (OwnerId != 0)
+	{
+		SendEvent(OwnerId, Name, FString::Printf(TEXT(",\"job_id\":\"%s\""), *JobId), DataJson);
+	}
+	for (const TUniquePtr<FConnection>& Connection : Connections)
+	{
+		if (Connection->Id != OwnerId && !Connection->bClosed
+			&& (Connection->Subscriptions.Contains(Name) || Connection->Subscriptions.Contains(TEXT("*"))))
+		{
+			SendEvent(Connection->Id, Name, FString(), DataJson);
+		}
+	}
+}
+
+void FAgentForgeSocketServer::HandleJobEvent(const FAgentForgeJob& Job, bool bFinished)
+{
+	const FString& JobId = Job.GetId();
+	const double   Now   = FPlatformTime::Seconds();
+	if (!bFinished)
+	{
+		const double* LastSent = JobLastProgressSent.Find(JobId);
+		if (LastSent && Now - *LastSent < JobProgressIntervalSeconds)
+		{
+			return;
+		}
+		JobLastProgressSent.Add(JobId, Now);
+	}
+
+	const FString Name     = bFinished ? TEXT("job_finished") : TEXT("job_progress");
+	const FString DataJson = SocketJsonToString(Job.ToJson(false, bFinished));
+	const FString Extra    = FString::Printf(TEXT(",\"job_id\":\"%s\""), *JobId);
+
+	const int32* Owner = JobOwners.Find(JobId);
+	const int32  OwnerId = Owner ? *Owner : 0;
+	if (OwnerId != 0)
+	{
+		SendEvent(OwnerId, Name, Extra, DataJson);
+	}
+	for (const TUniquePtr<FConnection>& Connection : Connections)
+	{
+		if (Connection->Id != OwnerId && !Connection->bClosed
+			&& (Connection->Subscriptions.Contains(Name) || Connection->Subscriptions.Contains(TEXT("*"))))
+		{
+			SendEvent(Connection->Id, Name, Extra, DataJson);
+		}
+	}
+
+	if (bFinished)
+	{
+		JobOwners.Remove(JobId);
+		JobLastProgressSent.Remove(JobId);
+	}
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Framing
+// ─────────────────────────────────────────────────────────────────────────────
+void FAgentForgeSocketServer::SendResponse(int32 ConnectionId, const FString& IdJson, const FString& ResultJson)
+{
+	FConnection* Connection = FindConnection(ConnectionId);
+	if (!Connection)
+	{
+		return;
+	}
+	// Splice the command's JSON in verbatim rather than re-encoding it.
+	const FString Body = ResultJson.IsEmpty() ? FString(TEXT("null")) : ResultJson;
+	if (SendText(*Connection, FString::Printf(TEXT("{\"type\":\"response\",\"id\":%s,\"result\":%s}"), *IdJson, *Body)))
+	{
+		++ResponsesSent;
+	}
+}
+
+void FAgentForgeSocketServer::SendEvent(int32 ConnectionId, const FString& EventName, const FString& Extra, const FString& DataJson)
+{
+	FConnection* Connection = FindConnection(ConnectionId);
+	if (!Connection)
+	{
+		return;
+	}
+	if (SendText(*Connection, FString::Printf(TEXT("{\"type\":\"event\",\"event\":\"%s\"%s,\"data\":%s}"), *EventName, *Extra, *DataJson)))
+	{
+		++EventsSent;
+	}
+}
+
+bool FAgentForgeSocketServer::SendText(FConnection& Connection, const FString& Text)
+{
+	if (Connection.bClosed || !Connection.Socket.IsValid())
+	{
+		return false;
+	}
+	const FTCHARToUTF8 Utf8(*Text);
+	return Connection.Socket->Send(reinterpret_cast<const uint8*>(Utf8.Get()), static_cast<uint32>(Utf8.Length()), false);
+}
+
+FAgentForgeSocketServer::FConnection* FAgentForgeSocketServer::FindConnection(int32 ConnectionId)
+{
+	for (const TUniquePtr<FConnection>& Connection : Connections)
+	{
+		if (Connection->Id == ConnectionId)
+		{
+			return Connection.Get();
+		}
+	}
+	return nullptr;
+}
+
+TSharedPtr<FJsonObject> FAgentForgeSocketServer::GetStatusJson() const
+{
+	int32 Open = 0;
+	for (const TUniquePtr<FConnection>& Connection : Connections)
+	{
+		if (!Connection->bClosed) { ++Open; }
+	}
+
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetBoolField  (TEXT("running"),           IsRunning());
+	Obj->SetStringField(TEXT("url"),               IsRunning() ? FString::Printf(TEXT("ws://%s:%d"), *BindAddress, ListenPort) : FString());
+	Obj->SetNumberField(TEXT("port"),              ListenPort);
+	Obj->SetNumberField(TEXT("connections"),       Open);
+	Obj->SetNumberField(TEXT("pending_requests"),  Pending.Num());
+	Obj->SetNumberField(TEXT("messages_received"), static_cast<double>(MessagesReceived));
+	Obj->SetNumberField(TEXT("responses_sent"),    static_cast<double>(ResponsesSent));
+	Obj->SetNumberField(TEXT("events_sent"),       static_cast<double>(EventsSent));
+	Obj->SetNumberField(TEXT("requests_rejected"), static_cast<double>(RequestsRejected));
+	Obj->SetNumberField(TEXT("requests_coalesced"), static_cast<double>(RequestsCoalesced));
+	return Obj;
+}
@@ -0,0 +1,293 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeSpawnBatch.cpp — deferred spawning, queued attachments and the batch flush.
+
+#include "AgentForgeSpawnBatch.h"
+
+#include "Components/SceneComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Editor.h"
+#include "Engine/Level.h"
+#include "Engine/LevelBounds.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/PlatformTime.h"
+#include "Materials/MaterialInterface.h"
+
+namespace
+{
+	// Game thread only, like the batches themselves.
+	FAgentForgeSpawnBatch* GActiveBatch = nullptr;
+
+	struct FSpawnBatchStats
+	{
+		int64  Batches = 0;
+		int64  ActorsSpawned = 0;
+		int64  Attachments = 0;
+		int32  LastBatchActors = 0;
+		double LastBatchMs = 0.0;
+	};
+	FSpawnBatchStats GSpawnBatchStats;
+
+	static ULevel* GetSpawnLevel(UWorld* World)
+	{
+		if (!World)
+		{
+			return nullptr;
+		}
+		ULevel* Level = World->GetCurrentLevel();
+		return Level ? Level : World->PersistentLevel.Get();
+	}
+
+	/** Deferred spawn parameters; RF_Transactional propagates to the default subobjects. */
+	static FActorSpawnParameters MakeDeferredParams(ESpawnActorCollisionHandlingMethod Collision)
+	{
+		FActorSpawnParameters Params;
+		Params.ObjectFlags |= RF_Transactional;
+		Params.SpawnCollisionHandlingOverride = Collision;
+		Params.bDeferConstruction = true;
+		return Params;
+	}
+}
+
+FAgentForgeSpawnBatch::FAgentForgeSpawnBatch(UWorld* InWorld)
+	: World(InWorld)
+	, Outer(GActiveBatch)
+	, StartSeconds(FPlatformTime::Seconds())
+{
+	if (Outer)
+	{
+		return;
+	}
+	GActiveBatch = this;
+
+	// Bounds would otherwise be recomputed on every spawn and attach.
+	if (ULevel* Level = GetSpawnLevel(InWorld))
+	{
+		ALevelBounds* Bounds = Level->LevelBoundsActor.Get();
+		if (Bounds && Bounds->bAutoUpdateBounds)
+		{
+			Bounds->bAutoUpdateBounds = false;
+			SuspendedBounds = Bounds;
+		}
+	}
+}
+
+FAgentForgeSpawnBatch::~FAgentForgeSpawnBatch()
+{
+	if (Outer)
+	{
+		return;
+	}
+	Flush();
+	GActiveBatch = nullptr;
+}
+
+FAgentForgeSpawnBatch* FAgentForgeSpawnBatch::GetActive()
+{
+	return GActiveBatch;
+}
+
+void FAgentForgeSpawnBatch::PrepareWorld()
+{
+	if (bWorldPrepared)
+	{
+		return;
+	}
+	bWorldPrepared = true;
+
+	UWorld* BatchWorld = World.Get();
+	if (!BatchWorld)
+	{
+		return;
+	}
+	BatchWorld->SetFlags(RF_Transactional);
+	BatchWorld->Modify();
+	if (ULevel* Level = GetSpawnLevel(BatchWorld))
+	{
+		Level->SetFlags(RF_Transactional);
+		Level->Modify();
+	}
+}
+
+void FAgentForgeSpawnBatch::Flush()
+{
+	// One sweep: each parent is modified once, then its children attach.
+	TSet<AActor*> ModifiedParents;
+	int32 Attached = 0;
+	for (const TPair<TWeakObjectPtr<AActor>, TWeakObjectPtr<AActor>>& Pending : PendingAttachments)
+	{
+		AActor* Child = Pending.Key.Get();
+		AActor* Parent = Pending.Value.Get();
+		if (!Child || !Parent)
+		{
+			continue;
+		}
+		bool bAlreadyModified = false;
+		ModifiedParents.Add(Parent, &bAlreadyModified);
+		if (!bAlreadyModified)
+		{
+			Parent->Modify();
+		}
+		Child->Modify();
+		Attached += Child->AttachToActor(Parent, FAttachmentTransformRules::KeepWorldTransform) ? 1 : 0;
+	}
+	PendingAttachments.Reset();
+
+	if (ALevelBounds* Bounds = SuspendedBounds.Get())
+	{
+		Bounds->bAutoUpdateBounds = true;
+		if (ActorsSpawned > 0)
+		{
+			Bounds->UpdateLevelBoundsImmediately();
+		}
+	}
+	SuspendedBounds.Reset();
+
+	if (ActorsSpawned > 0 && GEditor)
+	{
+		GEditor->RedrawLevelEditingViewports(true);
+	}
+
+	++GSpawnBatchStats.Batches;
+	GSpawnBatchStats.ActorsSpawned += ActorsSpawned;
+	GSpawnBatchStats.Attachments += Attached;
+	GSpawnBatchStats.LastBatchActors = ActorsSpawned;
+	GSpawnBatchStats.LastBatchMs = (FPlatformTime::Seconds() - StartSeconds) * 1000.0;
+}
+
+AStaticMeshActor* FAgentForgeSpawnBatch::SpawnStaticMeshActor(UWorld* World, const FAgentForgeStaticMeshSpawn& Spawn, FString& OutError)
+{
+	OutError.Reset();
+	if (!World)
+	{
+		OutError = TEXT("No editor world.");
+		return nullptr;
+	}
+	if (!Spawn.Mesh)
+	{
+		OutError = TEXT("Static mesh is null.");
+		return nullptr;
+	}
+
+	TOptional<FAgentForgeSpawnBatch> LocalBatch;
+	if (!GActiveBatch)
+	{
+		LocalBatch.Emplace(World);
+	}
+	FAgentForgeSpawnBatch& Batch = *GActiveBatch;
+	Batch.PrepareWorld();
+
+	AStaticMeshActor* Actor = World->SpawnActor<AStaticMeshActor>(
+		AStaticMeshActor::StaticClass(), Spawn.Transform, MakeDeferredParams(Spawn.Collision));
+	if (!Actor)
+	{
+		OutError = TEXT("Failed to spawn static mesh actor.");
+		return nullptr;
+	}
+
+	// Components are not registered yet, so none of this touches render or physics state.
+	if (UStaticMeshComponent* MeshComp = Actor->GetStaticMeshComponent())
+	{
+		MeshComp->SetMobility(EComponentMobility::Static);
+		MeshComp->SetStaticMesh(Spawn.Mesh);
+		if (Spawn.Material)
+		{
+			MeshComp->SetMaterial(0, Spawn.Material);
+		}
+		if (!Spawn.CollisionProfile.IsNone())
+		{
+			MeshComp->SetCollisionProfileName(Spawn.CollisionProfile);
+		}
+	}
+	if (!Spawn.Label.IsEmpty())
+	{
+		Actor->SetActorLabel(Spawn.Label, /*bMarkDirty*/ false);
+	}
+	Actor->FinishSpawning(Spawn.Transform);
+
+	if (!Actor->GetStaticMeshComponent())
+	{
+		OutError = TEXT("Spawned static mesh actor has no static mesh component.");
+		return nullptr;
+	}
+	++Batch.ActorsSpawned;
+	return Actor;
+}
+
+AActor* FAgentForgeSpawnBatch::SpawnGroupActor(UWorld* World, const FVector& Location, const FString& Label, FString& OutError)
+{
+	OutError.Reset();
+	if (!World)
+	{
+		OutError = TEXT("No editor world.");
+		return nullptr;
+	}
+
+	TOptional<FAgentForgeSpawnBatch> LocalBatch;
+	if (!GActiveBatch)
+	{
+		LocalBatch.Emplace(World);
+	}
+	FAgentForgeSpawnBatch& Batch = *GActiveBatch;
+	Batch.PrepareWorld();
+
+	const FTransform Transform(Location);
+	AActor* GroupActor = World->SpawnActor<AActor>(
+		AActor::StaticClass(), Transform, MakeDeferredParams(ESpawnActorCollisionHandlingMethod::AlwaysSpawn));
+	if (!GroupActor)
+	{
+		OutError = TEXT("Failed to spawn group actor.");
+		return nullptr;
+	}
+
+	// The root is registered by FinishSpawning along with the actor.
+	USceneComponent* Root = NewObject<USceneComponent>(GroupActor, TEXT("AgentForgeRoot"), RF_Transactional);
+	if (!Root)
+	{
+		OutError = TEXT("Failed to create group root component.");
+		return nullptr;
+	}
+	Root->CreationMethod = EComponentCreationMethod::Instance;
+	Root->SetMobility(EComponentMobility::Static);
+	GroupActor->SetRootComponent(Root);
+	GroupActor->AddInstanceComponent(Root);
+	if (!Label.IsEmpty())
+	{
+		GroupActor->SetActorLabel(Label, /*bMarkDirty*/ false);
+	}
+	GroupActor->FinishSpawning(Transform);
+
+	++Batch.ActorsSpawned;
+	return GroupActor;
+}
+
+bool FAgentForgeSpawnBatch::Attach(AActor* Child, AActor* Parent)
+{
+	if (!Child || !Parent)
+	{
+		return false;
+	}
+	if (GActiveBatch)
+	{
+		GActiveBatch->PendingAttachments.Emplace(Child, Parent);
+		return true;
+	}
+	Child->Modify();
+	Parent->Modify();
+	const bool bAttached = Child->AttachToActor(Parent, FAttachmentTransformRules::KeepWorldTransform);
+	GSpawnBatchStats.Attachments += bAttached ? 1 : 0;
+	return bAttached;
+}
+
+TSharedPtr<FJsonObject> FAgentForgeSpawnBatch::GetStatsJson()
+{
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetNumberField(TEXT("batches"),           (double)GSpawnBatchStats.Batches);
+	Obj->SetNumberField(TEXT("actors_spawned"),    (double)GSpawnBatchStats.ActorsSpawned);
+	Obj->SetNumberField(TEXT("attachments"),       (double)GSpawnBatchStats.Attachments);
+	Obj->SetNumberField(TEXT("last_batch_actors"), GSpawnBatchStats.LastBatchActors);
+	Obj->SetNumberField(TEXT("last_batch_ms"),     GSpawnBatchStats.LastBatchMs);
+	return Obj;
+}
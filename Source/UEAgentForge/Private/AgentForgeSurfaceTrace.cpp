@@ -0,0 +1,253 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeSurfaceTrace.cpp — parallel physics traces + landscape heightfield fast path.
+
+#include "AgentForgeSurfaceTrace.h"
+
+#include "Async/ParallelFor.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/PlatformTime.h"
+#include "LandscapeHeightfieldCollisionComponent.h"
+#include "LandscapeProxy.h"
+
+#include <atomic>
+
+namespace
+{
+	// Points per ParallelFor work item; a trace is cheap enough that per-item overhead matters.
+	static constexpr int32 TraceChunkSize = 256;
+
+	struct FLandscapeSampler
+	{
+		const ALandscapeProxy* Proxy = nullptr;
+		FBox2D Rect;
+		double Step = 100.0;   // one landscape quad
+	};
+
+	static TArray<FLandscapeSampler> CollectLandscapes(UWorld* World)
+	{
+		TArray<FLandscapeSampler> Samplers;
+		for (TActorIterator<ALandscapeProxy> It(World); It; ++It)
+		{
+			const ALandscapeProxy* Proxy = *It;
+			const FBox Box = Proxy->GetComponentsBoundingBox(true);
+			if (!Box.IsValid)
+			{
+				continue;
+			}
+			FLandscapeSampler& Sampler = Samplers.AddDefaulted_GetRef();
+			Sampler.Proxy = Proxy;
+			Sampler.Rect = FBox2D(FVector2D(Box.Min), FVector2D(Box.Max));
+			Sampler.Step = FMath::Max(1.0, (double)Proxy->GetActorScale3D().X);
+		}
+		return Samplers;
+	}
+
+	static bool SampleLandscapes(
+		const TArray<FLandscapeSampler>& Samplers,
+		const FVector& Point,
+		double MinZ,
+		double MaxZ,
+		FSurfaceSample& Out)
+	{
+		const FVector2D XY(Point.X, Point.Y);
+		for (const FLandscapeSampler& Sampler : Samplers)
+		{
+			if (!Sampler.Rect.IsInside(XY))
+			{
+				continue;
+			}
+			const TOptional<float> Center = Sampler.Proxy->GetHeightAtLocation(Point, EHeightfieldSource::Complex);
+			if (!Center.IsSet() || Center.GetValue() < MinZ || Center.GetValue() > MaxZ)
+			{
+				continue;
+			}
+
+			// Central differences, one-sided at the landscape edge.
+			const double S = Sampler.Step;
+			auto HeightAt = [&](double DX, double DY, double& OutOffset) -> double
+			{
+				const TOptional<float> H = Sampler.Proxy->GetHeightAtLocation(Point + FVector(DX, DY, 0.0), EHeightfieldSource::Complex);
+				OutOffset = H.IsSet() ? (DX + DY) : 0.0;
+				return H.IsSet() ? H.GetValue() : Center.GetValue();
+			};
+			double OffL, OffR, OffD, OffU;
+			const double HL = HeightAt(-S, 0.0, OffL);
+			const double HR = HeightAt(S, 0.0, OffR);
+			const double HD = HeightAt(0.0, -S, OffD);
+			const double HU = HeightAt(0.0, S, OffU);
+			const double SpanX = OffR - OffL;
+			const double SpanY = OffU - OffD;
+			const double DHDX = SpanX > 0.0 ? (HR - HL) / SpanX : 0.0;
+			const double DHDY = SpanY > 0.0 ? (HU - HD) / SpanY : 0.0;
+
+			Out.Location = FVector(Point.X, Point.Y, Center.GetValue());
+			Out.Normal = FVector3f(FVector(-DHDX, -DHDY, 1.0).GetSafeNormal());
+			Out.Actor = nullptr;
+			Out.bHit = true;
+			return true;
+		}
+		return false;
+	}
+}
+
+FAgentForgeSurfaceTrace& FAgentForgeSurfaceTrace::Get()
+{
+	static FAgentForgeSurfaceTrace Instance;
+	return Instance;
+}
+
+bool FAgentForgeSurfaceTrace::ParseSource(const FString& Name, ESurfaceTraceSource& OutSource)
+{
+	if (Name.Equals(TEXT("physics"), ESearchCase::IgnoreCase))
+	{
+		OutSource = ESurfaceTraceSource::Physics;
+		return true;
+	}
+	if (Name.Equals(TEXT("landscape"), ESearchCase::IgnoreCase))
+	{
+		OutSource = ESurfaceTraceSource::Landscape;
+		return true;
+	}
+	return false;
+}
+
+const TCHAR* FAgentForgeSurfaceTrace::SourceName(ESurfaceTraceSource Source)
+{
+	return Source == ESurfaceTraceSource::Landscape ? TEXT("landscape") : TEXT("physics");
+}
+
+void FAgentForgeSurfaceTrace::TraceDown(
+	UWorld* World,
+	TArrayView<const FVector> Points,
+	const FSurfaceTraceSettings& Settings,
+	const FCollisionQueryParams& Params,
+	TArray<FSurfaceSample>& OutSamples)
+{
+	check(IsInGameThread());
+	OutSamples.Reset(Points.Num());
+	OutSamples.SetNum(Points.Num());
+	if (!World || Points.Num() == 0)
+	{
+		return;
+	}
+
+	const double StartSeconds = FPlatformTime::Seconds();
+	const TArray<FLandscapeSampler> Landscapes = Settings.Source == ESurfaceTraceSource::Landscape
+		? CollectLandscapes(World)
+		: TArray<FLandscapeSampler>();
+
+	std::atomic<int64> LandscapeCount{0};
+	std::atomic<int64> PhysicsCount{0};
+	std::atomic<int64> HitCount{0};
+
+	const int32 NumChunks = FMath::DivideAndRoundUp(Points.Num(), TraceChunkSize);
+	ParallelFor(NumChunks, [&](int32 Chunk)
+	{
+		const int32 Begin = Chunk * TraceChunkSize;
+		const int32 End = FMath::Min(Begin + TraceChunkSize, Points.Num());
+		int64 LocalLandscape = 0;
+		int64 LocalPhysics = 0;
+		int64 LocalHits = 0;
+		for (int32 Index = Begin; Index < End; ++Index)
+		{
+			const FVector& Point = Points[Index];
+			FSurfaceSample& Sample = OutSamples[Index];
+			const double MinZ = Point.Z - Settings.DownExtent;
+			const double MaxZ = Point.Z + Settings.UpExtent;
+
+			if (Landscapes.Num() > 0 && SampleLandscapes(Landscapes, Point, MinZ, MaxZ, Sample))
+			{
+				++LocalLandscape;
+				++LocalHits;
+				continue;
+			}
+
+			FHitResult Hit;
+			++LocalPhysics;
+			if (World->LineTraceSingleByChannel(Hit, FVector(Point.X, Point.Y, MaxZ), FVector(Point.X, Point.Y, MinZ), Settings.Channel, Params))
+			{
+				Sample.Location = Hit.ImpactPoint;
+				Sample.Normal = FVector3f(Hit.ImpactNormal.GetSafeNormal());
+				Sample.Actor = Hit.GetActor();
+				Sample.bHit = true;
+				++LocalHits;
+			}
+		}
+		LandscapeCount += LocalLandscape;
+		PhysicsCount += LocalPhysics;
+		HitCount += LocalHits;
+	}, Points.Num() < MinParallelBatch ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+	LastBatchMs = (FPlatformTime::Seconds() - StartSeconds) * 1000.0;
+	TotalMs += LastBatchMs;
+	++Batches;
+	PointsTraced += Points.Num();
+	LandscapeSamples += LandscapeCount.load();
+	PhysicsTraces += PhysicsCount.load();
+	Hits += HitCount.load();
+}
+
+void FAgentForgeSurfaceTrace::TraceSegments(
+	UWorld* World,
+	TArrayView<const FVector> Starts,
+	TArrayView<const FVector> Ends,
+	ECollisionChannel Channel,
+	const FCollisionQueryParams& Params,
+	TArray<FSurfaceSample>& OutSamples)
+{
+	check(IsInGameThread());
+	check(Starts.Num() == Ends.Num());
+	OutSamples.Reset(Starts.Num());
+	OutSamples.SetNum(Starts.Num());
+	if (!World || Starts.Num() == 0)
+	{
+		return;
+	}
+
+	const double StartSeconds = FPlatformTime::Seconds();
+	std::atomic<int64> HitCount{0};
+
+	const int32 NumChunks = FMath::DivideAndRoundUp(Starts.Num(), TraceChunkSize);
+	ParallelFor(NumChunks, [&](int32 Chunk)
+	{
+		const int32 Begin = Chunk * TraceChunkSize;
+		const int32 End = FMath::Min(Begin + TraceChunkSize, Starts.Num());
+		int64 LocalHits = 0;
+		for (int32 Index = Begin; Index < End; ++Index)
+		{
+			FHitResult Hit;
+			if (World->LineTraceSingleByChannel(Hit, Starts[Index], Ends[Index], Channel, Params))
+			{
+				FSurfaceSample& Sample = OutSamples[Index];
+				Sample.Location = Hit.ImpactPoint;
+				Sample.Normal = FVector3f(Hit.ImpactNormal.GetSafeNormal());
+				Sample.Actor = Hit.GetActor();
+				Sample.bHit = true;
+				++LocalHits;
+			}
+		}
+		HitCount += LocalHits;
+	}, Starts.Num() < MinParallelBatch ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+	LastBatchMs = (FPlatformTime::Seconds() - StartSeconds) * 1000.0;
+	TotalMs += LastBatchMs;
+	++Batches;
+	Segments += Starts.Num();
+	PhysicsTraces += Starts.Num();
+	Hits += HitCount.load();
+}
+
+TSharedPtr<FJsonObject> FAgentForgeSurfaceTrace::GetStatsJson() const
+{
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetNumberField(TEXT("batches"),           (double)Batches);
+	Obj->SetNumberField(TEXT("points"),            (double)PointsTraced);
+	Obj->SetNumberField(TEXT("landscape_samples"), (double)LandscapeSamples);
+	Obj->SetNumberField(TEXT("physics_traces"),    (double)PhysicsTraces);
+	Obj->SetNumberField(TEXT("segments"),          (double)Segments);
+	Obj->SetNumberField(TEXT("hits"),              (double)Hits);
+	Obj->SetNumberField(TEXT("total_ms"),          TotalMs);
+	Obj->SetNumberField(TEXT("last_batch_ms"),     LastBatchMs);
+	return Obj;
+}
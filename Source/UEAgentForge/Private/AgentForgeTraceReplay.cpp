@@ -0,0 +1,545 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeTraceReplay.cpp — trace replay, response canonicalization, report.
+
+#include "AgentForgeTraceReplay.h"
+
+#include "AgentForgeActorIndex.h"
+#include "AgentForgeCommandTrace.h"
+#include "AgentForgeJobManager.h"
+#include "AgentForgeLibrary.h"
+#include "AgentForgeRequestEnvelope.h"
+
+#include "Containers/Ticker.h"
+#include "Dom/JsonValue.h"
+#include "HAL/PlatformTime.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/Crc.h"
+#include "Misc/DateTime.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+#if WITH_EDITOR
+#include "FileHelpers.h"
+#endif
+
+namespace
+{
+	/** Responses that describe session state rather than the world; status-checked only. */
+	static const TCHAR* const VolatileCommands[] =
+	{
+		TEXT("get_job_status"), TEXT("list_jobs"), TEXT("cancel_job"),
+		TEXT("get_command_metrics"), TEXT("get_forge_status"), TEXT("get_perf_stats"),
+	};
+
+	/** Never replayed: they would start or stop a recording of the replay itself. */
+	static const TCHAR* const TraceCommands[] =
+	{
+		TEXT("start_command_trace"), TEXT("stop_command_trace"),
+	};
+
+	/** Seconds per job tick while draining async submissions. */
+	static constexpr float JobTickSeconds = 1.0f / 60.0f;
+
+	/** Characters of context kept either side of the first difference. */
+	static constexpr int32 DiffContextChars = 80;
+
+	static FString ToJson(const TSharedPtr<FJsonObject>& Obj)
+	{
+		FString Out;
+		TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Out);
+		FJsonSerializer::Serialize(Obj.ToSharedRef(), Writer);
+		return Out;
+	}
+
+	static FString ToCondensedJson(const TSharedRef<FJsonObject>& Obj)
+	{
+		FString Out;
+		TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer =
+			TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Out);
+		FJsonSerializer::Serialize(Obj, Writer);
+		return Out;
+	}
+
+	static FString CsvField(const FString& In)
+	{
+		return In.Contains(TEXT(",")) || In.Contains(TEXT("\"")) ? FString::Printf(TEXT("\"%s\""), *In.Replace(TEXT("\""), TEXT("\"\""))) : In;
+	}
+
+	static bool IsListed(const TCHAR* const* Names, int32 Num, const FString& Cmd)
+	{
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			if (Cmd == Names[Index])
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	static bool IsVolatileKey(const FString& Key, const TSet<FString>& IgnoreKeys)
+	{
+		return Key == TEXT("timings") || Key == TEXT("job_id")
+			|| Key.EndsWith(TEXT("_ms")) || Key.EndsWith(TEXT("_seconds")) || Key.EndsWith(TEXT("_utc"))
+			|| Key.Contains(TEXT("revision"))
+			|| IgnoreKeys.Contains(Key);
+	}
+
+	static void AppendCanonical(const TSharedPtr<FJsonValue>& Value, const TSet<FString>& IgnoreKeys, FString& Out)
+	{
+		if (!Value.IsValid())
+		{
+			Out += TEXT("null");
+			return;
+		}
+		switch (Value->Type)
+		{
+		case EJson::Object:
+		{
+			const TSharedPtr<FJsonObject> Obj = Value->AsObject();
+			TArray<FString> Keys;
+			if (Obj.IsValid())
+			{
+				for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : Obj->Values)
+				{
+					if (!IsVolatileKey(Pair.Key, IgnoreKeys))
+					{
+						Keys.Add(Pair.Key);
+					}
+				}
+			}
+			Keys.Sort([](const FString& A, const FString& B) { return A.Compare(B, ESearchCase::CaseSensitive) < 0; });
+			Out += TEXT("{");
+			for (int32 Index = 0; Index < Keys.Num(); ++Index)
+			{
+				Out += FString::Printf(TEXT("%s\"%s\":"), Index > 0 ? TEXT(",") : TEXT(""), *Keys[Index].ReplaceCharWithEscapedChar());
+				AppendCanonical(Obj->Values.FindRef(Keys[Index]), IgnoreKeys, Out);
+			}
+			Out += TEXT("}");
+			break;
+		}
+		case EJson::Array:
+		{
+			const TArray<TSharedPtr<FJsonValue>>& Items = Value->AsArray();
+			Out += TEXT("[");
+			for (int32 Index = 0; Index < Items.Num(); ++Index)
+			{
+				if (Index > 0)
+				{
+					Out += TEXT(",");
+				}
+				AppendCanonical(Items[Index], IgnoreKeys, Out);
+			}
+			Out += TEXT("]");
+			break;
+		}
+		case EJson::Number:
+		{
+			// 6 significant digits; -0 and 0 print alike.
+			const double Number = Value->AsNumber();
+			Out += FString::Printf(TEXT("%.6g"), Number == 0.0 ? 0.0 : Number);
+			break;
+		}
+		case EJson::String:
+			Out += FString::Printf(TEXT("\"%s\""), *Value->AsString().ReplaceCharWithEscapedChar());
+			break;
+		case EJson::Boolean:
+			Out += Value->AsBool() ? TEXT("true") : TEXT("false");
+			break;
+		default:
+			Out += TEXT("null");
+			break;
+		}
+	}
+
+	static double Median(TArray<double> Values)
+	{
+		if (Values.Num() == 0)
+		{
+			return 0.0;
+		}
+		Values.Sort();
+		const int32 Mid = Values.Num() / 2;
+		return (Values.Num() % 2) ? Values[Mid] : 0.5 * (Values[Mid - 1] + Values[Mid]);
+	}
+
+	/** Context around the first character where A and B differ. */
+	static void FirstDifference(const FString& A, const FString& B, FString& OutA, FString& OutB, int32& OutOffset)
+	{
+		const int32 Common = FMath::Min(A.Len(), B.Len());
+		int32 Index = 0;
+		while (Index < Common && A[Index] == B[Index])
+		{
+			++Index;
+		}
+		OutOffset = Index;
+		const int32 Start = FMath::Max(0, Index - DiffContextChars);
+		OutA = A.Mid(Start, 2 * DiffContextChars);
+		OutB = B.Mid(Start, 2 * DiffContextChars);
+	}
+
+	/** One recorded call, parsed once for every pass. */
+	struct FReplayCall
+	{
+		const FAgentForgeTraceRecord* Record = nullptr;
+		TSharedPtr<FJsonObject> Root;          // set when args.since_revision needs rewriting
+		int64 SinceRevision = 0;
+		bool  bAsync = false;
+		bool  bSkipped = false;
+		bool  bVolatile = false;
+		bool  bDivergent = false;              // first pass
+		bool  bUnchecked = false;              // first pass
+		TArray<double> ReplayMs;               // one per pass
+		double JobMs = 0.0;                    // first pass
+	};
+
+	struct FCommandStats
+	{
+		int32 Calls = 0;
+		int32 Divergent = 0;
+		int32 Unchecked = 0;
+		TArray<double> RecordedMs;
+		TArray<double> ReplayMs;
+		double JobMs = 0.0;
+	};
+
+	static void PrepareCall(FReplayCall& Call, const FTraceReplaySettings& Settings)
+	{
+		const FAgentForgeTraceRecord& Record = *Call.Record;
+		Call.bSkipped = Settings.Skip.Contains(Record.Cmd) || IsListed(TraceCommands, UE_ARRAY_COUNT(TraceCommands), Record.Cmd);
+		Call.bVolatile = IsListed(VolatileCommands, UE_ARRAY_COUNT(VolatileCommands), Record.Cmd);
+		if (Call.bSkipped)
+		{
+			return;
+		}
+
+		TSharedPtr<FJsonObject> Root;
+		const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Record.Request);
+		const TSharedPtr<FJsonObject>* Args = nullptr;
+		if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid() || !Root->TryGetObjectField(TEXT("args"), Args))
+		{
+			return;
+		}
+		(*Args)->TryGetBoolField(TEXT("async"), Call.bAsync);
+		double Since = 0.0;
+		if ((*Args)->TryGetNumberField(TEXT("since_revision"), Since))
+		{
+			Call.Root = Root;
+			Call.SinceRevision = (int64)Since;
+		}
+	}
+
+	/** The request text for this pass, with since_revision moved onto the replay's revisions. */
+	static FString BuildRequest(const FReplayCall& Call, const TMap<int64, int64>& RevisionMap)
+	{
+		const int64* Mapped = Call.Root.IsValid() ? RevisionMap.Find(Call.SinceRevision) : nullptr;
+		if (!Mapped)
+		{
+			return Call.Record->Request;
+		}
+		const TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>(*Call.Root);
+		const TSharedPtr<FJsonObject> Args = MakeShared<FJsonObject>(*Root->GetObjectField(TEXT("args")));
+		Args->SetNumberField(TEXT("since_revision"), (double)*Mapped);
+		Root->SetObjectField(TEXT("args"), Args);
+		return ToCondensedJson(Root.ToSharedRef());
+	}
+
+	/** Ticks the job queue until it is empty. False when TimeoutSeconds ran out first. */
+	static bool DrainJobs(double TimeoutSeconds)
+	{
+		FAgentForgeJobManager& Jobs = FAgentForgeJobManager::Get();
+		const double Deadline = FPlatformTime::Seconds() + TimeoutSeconds;
+		while (Jobs.HasPendingJobs())
+		{
+			if (FPlatformTime::Seconds() > Deadline)
+			{
+				return false;
+			}
+			FTSTicker::GetCoreTicker().Tick(JobTickSeconds);
+		}
+		return true;
+	}
+
+	static bool LoadReplayMap(const FString& MapName, FString& OutError)
+	{
+#if WITH_EDITOR
+		FString Filename;
+		if (!FPackageName::TryConvertLongPackageNameToFilename(MapName, Filename, FPackageName::GetMapPackageExtension())
+			|| !FPaths::FileExists(Filename))
+		{
+			OutError = FString::Printf(TEXT("Map '%s' not found."), *MapName);
+			return false;
+		}
+		if (!FEditorFileUtils::LoadMap(Filename, /*LoadAsTemplate=*/false, /*bShowProgress=*/false))
+		{
+			OutError = FString::Printf(TEXT("Failed to load map '%s'."), *MapName);
+			return false;
+		}
+		return true;
+#else
+		OutError = TEXT("Trace replay requires WITH_EDITOR.");
+		return false;
+#endif
+	}
+}
+
+FString FAgentForgeTraceReplay::GetDefaultOutputDir()
+{
+	return FPaths::Combine(FAgentForgeCommandTrace::GetDefaultDir(), TEXT("Replays"));
+}
+
+FString FAgentForgeTraceReplay::CanonicalizeResponse(const FString& ResponseJson, const TSet<FString>& IgnoreKeys)
+{
+	TSharedPtr<FJsonValue> Value;
+	const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ResponseJson);
+	if (!FJsonSerializer::Deserialize(Reader, Value) || !Value.IsValid())
+	{
+		return ResponseJson;
+	}
+	FString Out;
+	Out.Reserve(ResponseJson.Len());
+	AppendCanonical(Value, IgnoreKeys, Out);
+	return Out;
+}
+
+bool FAgentForgeTraceReplay::Run(const FTraceReplaySettings& Settings, TSharedPtr<FJsonObject>& OutReport, FString& OutError)
+{
+	TArray<FAgentForgeTraceSession> Sessions;
+	if (!FAgentForgeCommandTrace::Load(Settings.TracePath, Sessions, OutError))
+	{
+		return false;
+	}
+	if (Sessions.Num() == 0)
+	{
+		OutError = FString::Printf(TEXT("No sessions in '%s'."), *Settings.TracePath);
+		return false;
+	}
+	const int32 SessionIndex = Settings.Session < 0 ? Sessions.Num() + Settings.Session : Settings.Session;
+	if (!Sessions.IsValidIndex(SessionIndex))
+	{
+		OutError = FString::Printf(TEXT("Session %d out of range; the trace holds %d."), Settings.Session, Sessions.Num());
+		return false;
+	}
+	const FAgentForgeTraceSession& Session = Sessions[SessionIndex];
+
+	const FString MapName = Settings.Map.IsEmpty() ? Session.Map : Settings.Map;
+	const bool bLoadMap = !MapName.IsEmpty() && MapName != TEXT("none");
+
+	TArray<FReplayCall> Calls;
+	Calls.SetNum(Session.Records.Num());
+	for (int32 Index = 0; Index < Calls.Num(); ++Index)
+	{
+		Calls[Index].Record = &Session.Records[Index];
+		PrepareCall(Calls[Index], Settings);
+	}
+
+	// Jobs left over from before the replay would block its mutating commands.
+	DrainJobs(Settings.JobTimeoutSeconds);
+
+	const int32 Repeats = FMath::Max(1, Settings.Repeats);
+	int32 Replayed = 0;
+	int32 Skipped = 0;
+	int32 Divergences = 0;
+	int32 Unchecked = 0;
+	int32 JobTimeouts = 0;
+	TArray<TSharedPtr<FJsonValue>> DivergentArr;
+
+	for (int32 Pass = 0; Pass < Repeats; ++Pass)
+	{
+		if (bLoadMap && !LoadReplayMap(MapName, OutError))
+		{
+			return false;
+		}
+
+		// Recorded revision -> replay revision, seeded with the session start.
+		TMap<int64, int64> RevisionMap;
+		RevisionMap.Add(Session.Revision, FAgentForgeActorIndex::Get().GetRevision());
+
+		for (FReplayCall& Call : Calls)
+		{
+			const FAgentForgeTraceRecord& Record = *Call.Record;
+			if (Call.bSkipped)
+			{
+				Skipped += Pass == 0 ? 1 : 0;
+				continue;
+			}
+
+			const FString Request = BuildRequest(Call, RevisionMap);
+			const double StartSeconds = FPlatformTime::Seconds();
+			const FString Response = UAgentForgeLibrary::ExecuteCommandJson(Request);
+			Call.ReplayMs.Add((FPlatformTime::Seconds() - StartSeconds) * 1000.0);
+
+			const bool bError = FAgentForgeRequestEnvelope::IsErrorResponse(Response);
+			if (Call.bAsync && !bError)
+			{
+				const double JobStartSeconds = FPlatformTime::Seconds();
+				if (!DrainJobs(Settings.JobTimeoutSeconds))
+				{
+					UE_LOG(LogTemp, Warning, TEXT("[UEAgentForge] Replay: job from call %lld (%s) still pending after %.0f s."),
+						Record.Sequence, *Record.Cmd, Settings.JobTimeoutSeconds);
+					++JobTimeouts;
+				}
+				if (Pass == 0)
+				{
+					Call.JobMs = (FPlatformTime::Seconds() - JobStartSeconds) * 1000.0;
+				}
+			}
+			RevisionMap.Add(Record.RevisionAfter, FAgentForgeActorIndex::Get().GetRevision());
+
+			if (Pass > 0)
+			{
+				continue;
+			}
+			++Replayed;
+
+			const TCHAR* Kind = nullptr;
+			FString RecordedText;
+			FString ReplayText;
+			int32 Offset = 0;
+			if (bError != Record.bError)
+			{
+				Kind = TEXT("status");
+				RecordedText = Record.Response.Left(2 * DiffContextChars);
+				ReplayText = Response.Left(2 * DiffContextChars);
+			}
+			else if (Call.bVolatile || Record.bResponseTruncated)
+			{
+				Call.bUnchecked = true;
+				++Unchecked;
+			}
+			else if (FCrc::StrCrc32(*Response) != Record.ResponseCrc)
+			{
+				const FString RecordedCanonical = CanonicalizeResponse(Record.Response, Settings.IgnoreKeys);
+				const FString ReplayCanonical = CanonicalizeResponse(Response, Settings.IgnoreKeys);
+				if (!RecordedCanonical.Equals(ReplayCanonical, ESearchCase::CaseSensitive))
+				{
+					Kind = TEXT("content");
+					FirstDifference(RecordedCanonical, ReplayCanonical, RecordedText, ReplayText, Offset);
+				}
+			}
+			if (!Kind)
+			{
+				continue;
+			}
+
+			Call.bDivergent = true;
+			++Divergences;
+			if (DivergentArr.Num() < Settings.MaxListedDivergences)
+			{
+				TSharedPtr<FJsonObject> Entry = MakeShared<FJsonObject>();
+				Entry->SetNumberField(TEXT("seq"),       (double)Record.Sequence);
+				Entry->SetStringField(TEXT("cmd"),       Record.Cmd);
+				Entry->SetStringField(TEXT("kind"),      Kind);
+				Entry->SetNumberField(TEXT("offset"),    Offset);
+				Entry->SetStringField(TEXT("recorded"),  RecordedText);
+				Entry->SetStringField(TEXT("replay"),    ReplayText);
+				DivergentArr.Add(MakeShared<FJsonValueObject>(Entry));
+			}
+		}
+	}
+
+	// ── Per-command aggregate ────────────────────────────────────────────────
+
+	TMap<FString, FCommandStats> Stats;   // first-seen order
+	for (const FReplayCall& Call : Calls)
+	{
+		if (Call.bSkipped)
+		{
+			continue;
+		}
+		FCommandStats& Cmd = Stats.FindOrAdd(Call.Record->Cmd);
+		++Cmd.Calls;
+		Cmd.Divergent += Call.bDivergent ? 1 : 0;
+		Cmd.Unchecked += Call.bUnchecked ? 1 : 0;
+		Cmd.RecordedMs.Add(Call.Record->ParseMs + Call.Record->HandlerMs);
+		Cmd.ReplayMs.Add(Median(Call.ReplayMs));
+		Cmd.JobMs += Call.JobMs;
+	}
+
+	FString PluginVersion = TEXT("unknown");
+	if (const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("UEAgentForge")))
+	{
+		PluginVersion = Plugin->GetDescriptor().VersionName;
+	}
+	const FString Timestamp = FDateTime::UtcNow().ToString(TEXT("%Y%m%d-%H%M%S"));
+
+	int32 Regressions = 0;
+	TArray<TSharedPtr<FJsonValue>> CommandsArr;
+	TArray<TSharedPtr<FJsonValue>> RegressionsArr;
+	FString Csv = TEXT("plugin_version,label,cmd,calls,recorded_median_ms,replay_median_ms,ratio,regressed,divergent,unchecked,job_ms\n");
+	for (const TPair<FString, FCommandStats>& Pair : Stats)
+	{
+		const FCommandStats& Cmd = Pair.Value;
+		const double RecordedMedian = Median(Cmd.RecordedMs);
+		const double ReplayMedian = Median(Cmd.ReplayMs);
+		const double Ratio = ReplayMedian / FMath::Max(RecordedMedian, 1.0e-3);
+		const bool bRegressed = ReplayMedian > RecordedMedian * (1.0 + Settings.Tolerance)
+			&& ReplayMedian - RecordedMedian >= Settings.MinDeltaMs;
+
+		TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+		Obj->SetStringField(TEXT("cmd"),                Pair.Key);
+		Obj->SetNumberField(TEXT("calls"),              Cmd.Calls);
+		Obj->SetNumberField(TEXT("recorded_median_ms"), RecordedMedian);
+		Obj->SetNumberField(TEXT("replay_median_ms"),   ReplayMedian);
+		Obj->SetNumberField(TEXT("ratio"),              Ratio);
+		Obj->SetBoolField  (TEXT("regressed"),          bRegressed);
+		Obj->SetNumberField(TEXT("divergent"),          Cmd.Divergent);
+		Obj->SetNumberField(TEXT("unchecked"),          Cmd.Unchecked);
+		Obj->SetNumberField(TEXT("job_ms"),             Cmd.JobMs);
+		CommandsArr.Add(MakeShared<FJsonValueObject>(Obj));
+		if (bRegressed)
+		{
+			++Regressions;
+			RegressionsArr.Add(MakeShared<FJsonValueString>(Pair.Key));
+		}
+		Csv += FString::Printf(TEXT("%s,%s,%s,%d,%.4f,%.4f,%.3f,%d,%d,%d,%.3f\n"),
+			*CsvField(PluginVersion), *CsvField(Settings.Label), *Pair.Key, Cmd.Calls, RecordedMedian, ReplayMedian,
+			Ratio, bRegressed ? 1 : 0, Cmd.Divergent, Cmd.Unchecked, Cmd.JobMs);
+	}
+
+	OutReport = MakeShared<FJsonObject>();
+	OutReport->SetStringField(TEXT("plugin_version"),          PluginVersion);
+	OutReport->SetStringField(TEXT("engine_version"),          FEngineVersion::Current().ToString());
+	OutReport->SetStringField(TEXT("recorded_plugin_version"), Session.PluginVersion);
+	OutReport->SetStringField(TEXT("recorded_engine_version"), Session.EngineVersion);
+	OutReport->SetStringField(TEXT("recorded_utc"),            Session.StartedUtc);
+	OutReport->SetStringField(TEXT("timestamp_utc"),           Timestamp);
+	OutReport->SetStringField(TEXT("label"),                   Settings.Label);
+	OutReport->SetStringField(TEXT("trace_path"),              FPaths::ConvertRelativePathToFull(Settings.TracePath));
+	OutReport->SetNumberField(TEXT("session"),                 SessionIndex);
+	OutReport->SetStringField(TEXT("map"),                     bLoadMap ? MapName : FString());
+	OutReport->SetNumberField(TEXT("repeats"),                 Repeats);
+	OutReport->SetNumberField(TEXT("tolerance"),               Settings.Tolerance);
+	OutReport->SetNumberField(TEXT("min_delta_ms"),            Settings.MinDeltaMs);
+	OutReport->SetNumberField(TEXT("records"),                 Session.Records.Num());
+	OutReport->SetNumberField(TEXT("replayed"),                Replayed);
+	OutReport->SetNumberField(TEXT("skipped"),                 Skipped);
+	OutReport->SetNumberField(TEXT("divergences"),             Divergences);
+	OutReport->SetNumberField(TEXT("unchecked"),               Unchecked);
+	OutReport->SetNumberField(TEXT("job_timeouts"),            JobTimeouts);
+	OutReport->SetNumberField(TEXT("regressions"),             Regressions);
+	OutReport->SetBoolField  (TEXT("passed"),                  Divergences == 0 && Regressions == 0 && JobTimeouts == 0);
+	OutReport->SetArrayField (TEXT("divergent"),               DivergentArr);
+	OutReport->SetArrayField (TEXT("regressed"),               RegressionsArr);
+	OutReport->SetArrayField (TEXT("commands"),                CommandsArr);
+
+	const FString Dir = Settings.OutputDir.IsEmpty() ? GetDefaultOutputDir() : Settings.OutputDir;
+	const FString Base = FPaths::Combine(Dir, FString::Printf(TEXT("replay_%s_%s"), *PluginVersion, *Timestamp));
+	const FString JsonPath = FPaths::ConvertRelativePathToFull(Base + TEXT(".json"));
+	const FString CsvPath = FPaths::ConvertRelativePathToFull(Base + TEXT(".csv"));
+	OutReport->SetStringField(TEXT("json_path"), JsonPath);
+	OutReport->SetStringField(TEXT("csv_path"),  CsvPath);
+	if (!FFileHelper::SaveStringToFile(ToJson(OutReport), *JsonPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM)
+		|| !FFileHelper::SaveStringToFile(Csv, *CsvPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+	{
+		OutError = FString::Printf(TEXT("Failed to write the replay report to '%s'."), *Dir);
+		return false;
+	}
+	return true;
+}
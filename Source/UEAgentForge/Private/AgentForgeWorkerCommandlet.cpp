@@ -0,0 +1,35 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeWorkerCommandlet.cpp — command-line parsing around FAgentForgeWorkerFarm::RunWorker.
+
+#include "AgentForgeWorkerCommandlet.h"
+
+#include "AgentForgeWorkerFarm.h"
+
+#include "Misc/Parse.h"
+
+UAgentForgeWorkerCommandlet::UAgentForgeWorkerCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UAgentForgeWorkerCommandlet::Main(const FString& Params)
+{
+	FFarmWorkerSettings Settings;
+	FParse::Value(*Params, TEXT("spool="), Settings.Spool);
+	FParse::Value(*Params, TEXT("worker="), Settings.WorkerId);
+	FParse::Value(*Params, TEXT("poll="), Settings.PollSeconds);
+	FParse::Value(*Params, TEXT("idle_exit="), Settings.IdleExitSeconds);
+	FParse::Value(*Params, TEXT("max_jobs="), Settings.MaxJobs);
+	Settings.PollSeconds = FMath::Clamp(Settings.PollSeconds, 0.05, 10.0);
+
+	const int32 FailedJobs = FAgentForgeWorkerFarm::RunWorker(Settings);
+	if (FailedJobs > 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("[UEAgentForge] Farm worker: %d job(s) failed; see the log above."), FailedJobs);
+		return 1;
+	}
+	return 0;
+}
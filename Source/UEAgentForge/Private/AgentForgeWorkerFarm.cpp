@@ -0,0 +1,1008 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeWorkerFarm.cpp — spool protocol, worker loop, result import, farm_precompute.
+
+#include "AgentForgeWorkerFarm.h"
+
+#include "AgentForgeJobManager.h"
+#include "AgentForgeLibrary.h"
+#include "AgentForgeRequestEnvelope.h"
+#include "Terrain/TerrainTileCache.h"
+
+#include "Async/Async.h"
+#include "Containers/Ticker.h"
+#include "CoreGlobals.h"
+#include "Dom/JsonValue.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Compression.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Guid.h"
+#include "Misc/PackageName.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include <atomic>
+
+#if WITH_EDITOR
+#include "Editor.h"
+#include "Engine/World.h"
+#include "FileHelpers.h"
+#endif
+
+namespace
+{
+	static constexpr uint32 ResultMagic = 0x31574641;   // "AFW1"
+	static constexpr int32  ResultVersion = 1;
+	static const TCHAR* JobSchema = TEXT("agentforge_farm_job_v1");
+	static const TCHAR* TileManifestName = TEXT("manifest.json");
+
+	static const TCHAR* const FarmableCommands[] =
+	{
+		TEXT("op_terrain_generate"), TEXT("op_surface_scatter"), TEXT("op_spline_scatter"), TEXT("op_biome_layers"),
+		TEXT("run_operator_pipeline"), TEXT("create_blockout_level"),
+	};
+
+	static FString ToJson(const TSharedPtr<FJsonObject>& Obj)
+	{
+		FString Out;
+		TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer =
+			TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Out);
+		FJsonSerializer::Serialize(Obj.ToSharedRef(), Writer);
+		return Out;
+	}
+
+	static TSharedPtr<FJsonObject> ParseJson(const FString& Text)
+	{
+		TSharedPtr<FJsonObject> Obj;
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Text);
+		return FJsonSerializer::Deserialize(Reader, Obj) ? Obj : nullptr;
+	}
+
+	static FString ErrorJson(const FString& Message)
+	{
+		TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+		Obj->SetBoolField(TEXT("ok"), false);
+		Obj->SetStringField(TEXT("error"), Message);
+		return ToJson(Obj);
+	}
+
+	static FString GetPluginVersion()
+	{
+		if (const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("UEAgentForge")))
+		{
+			return Plugin->GetDescriptor().VersionName;
+		}
+		return TEXT("unknown");
+	}
+
+	static FString JobsDir(const FString& Spool)    { return Spool / TEXT("jobs"); }
+	static FString ClaimedDir(const FString& Spool) { return Spool / TEXT("claimed"); }
+	static FString ResultsDir(const FString& Spool) { return Spool / TEXT("results"); }
+	static FString WorkersDir(const FString& Spool) { return Spool / TEXT("workers"); }
+
+	static void MakeSpoolDirs(const FString& Spool)
+	{
+		for (const FString& Dir : { JobsDir(Spool), ClaimedDir(Spool), ResultsDir(Spool), WorkersDir(Spool) })
+		{
+			IFileManager::Get().MakeDirectory(*Dir, true);
+		}
+	}
+
+	/** File names in Dir matching Wildcard, sorted; job ids start with a UTC stamp, so this is submit order. */
+	static TArray<FString> ListFiles(const FString& Dir, const TCHAR* Wildcard)
+	{
+		TArray<FString> Names;
+		IFileManager::Get().FindFiles(Names, *(Dir / Wildcard), /*Files=*/true, /*Directories=*/false);
+		Names.Sort();
+		return Names;
+	}
+
+	/** Write-then-rename, so a reader on another node never sees a partial file. */
+	static bool SaveAtomically(const TArray<uint8>& Bytes, const FString& Path)
+	{
+		const FString TempPath = Path + TEXT(".tmp");
+		if (!FFileHelper::SaveArrayToFile(Bytes, *TempPath))
+		{
+			return false;
+		}
+		if (!IFileManager::Get().Move(*Path, *TempPath, /*Replace=*/true, /*EvenIfReadOnly=*/false, /*Attributes=*/false, /*bDoNotRetryOrError=*/true))
+		{
+			IFileManager::Get().Delete(*TempPath, false, false, true);
+			return false;
+		}
+		return true;
+	}
+
+	static bool SaveStringAtomically(const FString& Text, const FString& Path)
+	{
+		const FTCHARToUTF8 Utf8(*Text);
+		TArray<uint8> Bytes;
+		Bytes.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+		return SaveAtomically(Bytes, Path);
+	}
+
+	/** Kinds and keys become paths on the importing machine: no separators, drives or parent steps. */
+	static bool IsSafeName(const FString& Name, bool bAllowOneSlash)
+	{
+		if (Name.IsEmpty() || Name.Contains(TEXT("..")) || Name.Contains(TEXT(":")) || Name.Contains(TEXT("\\")) || Name.StartsWith(TEXT("/")))
+		{
+			return false;
+		}
+		int32 Slashes = 0;
+		for (const TCHAR Ch : Name)
+		{
+			Slashes += Ch == TEXT('/') ? 1 : 0;
+		}
+		return bAllowOneSlash ? Slashes <= 1 : Slashes == 0;
+	}
+
+	// ── Result files ────────────────────────────────────────────────────────
+
+	struct FResultEntry
+	{
+		FString Kind;
+		FString Key;
+		TArray<uint8> Raw;
+	};
+
+	static bool WriteResult(const FString& Path, const TSharedPtr<FJsonObject>& Header,
+		const TArray<FAgentForgeProceduralCache::FCapturedEntry>& CacheEntries, const TArray<FResultEntry>& FileEntries,
+		int64& OutRawBytes, int64& OutPackedBytes)
+	{
+		OutRawBytes = 0;
+		OutPackedBytes = 0;
+		TArray<uint8> Bytes;
+		FMemoryWriter Writer(Bytes);
+		uint32 Magic = ResultMagic;
+		int32 Version = ResultVersion;
+		FString HeaderText = ToJson(Header);
+		int32 EntryCount = CacheEntries.Num() + FileEntries.Num();
+		Writer << Magic << Version << HeaderText << EntryCount;
+
+		auto WriteEntry = [&Writer, &OutRawBytes, &OutPackedBytes](FString Kind, FString Key, const TArray<uint8>& Raw)
+		{
+			int32 RawSize = Raw.Num();
+			int32 PackedSize = FCompression::CompressMemoryBound(NAME_Zlib, RawSize);
+			TArray<uint8> Packed;
+			Packed.SetNumUninitialized(PackedSize);
+			if (!FCompression::CompressMemory(NAME_Zlib, Packed.GetData(), PackedSize, Raw.GetData(), RawSize))
+			{
+				return false;
+			}
+			Packed.SetNum(PackedSize);
+			Writer << Kind << Key << RawSize << Packed;
+			OutRawBytes += RawSize;
+			OutPackedBytes += PackedSize;
+			return true;
+		};
+		for (const FAgentForgeProceduralCache::FCapturedEntry& Entry : CacheEntries)
+		{
+			if (!WriteEntry(Entry.Kind, Entry.Key, *Entry.Payload))
+			{
+				return false;
+			}
+		}
+		for (const FResultEntry& Entry : FileEntries)
+		{
+			if (!WriteEntry(Entry.Kind, Entry.Key, Entry.Raw))
+			{
+				return false;
+			}
+		}
+		return SaveAtomically(Bytes, Path);
+	}
+
+	static bool ReadResult(const FString& Path, TSharedPtr<FJsonObject>& OutHeader, TArray<FResultEntry>& OutEntries, int64& OutPackedBytes, FString& OutError)
+	{
+		TArray<uint8> Bytes;
+		if (!FFileHelper::LoadFileToArray(Bytes, *Path, FILEREAD_Silent))
+		{
+			OutError = FString::Printf(TEXT("Cannot read %s."), *Path);
+			return false;
+		}
+		FMemoryReader Reader(Bytes);
+		uint32 Magic = 0;
+		int32 Version = 0;
+		FString HeaderText;
+		int32 EntryCount = 0;
+		Reader << Magic << Version;
+		if (Reader.IsError() || Magic != ResultMagic || Version != ResultVersion)
+		{
+			OutError = FString::Printf(TEXT("%s is not a version %d farm result."), *Path, ResultVersion);
+			return false;
+		}
+		Reader << HeaderText << EntryCount;
+		OutHeader = ParseJson(HeaderText);
+		if (Reader.IsError() || !OutHeader.IsValid() || EntryCount < 0)
+		{
+			OutError = FString::Printf(TEXT("%s has a damaged header."), *Path);
+			return false;
+		}
+
+		OutPackedBytes = 0;
+		for (int32 Index = 0; Index < EntryCount; ++Index)
+		{
+			FResultEntry& Entry = OutEntries.AddDefaulted_GetRef();
+			int32 RawSize = 0;
+			TArray<uint8> Packed;
+			Reader << Entry.Kind << Entry.Key << RawSize << Packed;
+			if (Reader.IsError() || RawSize < 0)
+			{
+				OutError = FString::Printf(TEXT("%s is truncated at entry %d."), *Path, Index);
+				return false;
+			}
+			const bool bTileFile = Entry.Kind == FAgentForgeWorkerFarm::TileFileKind;
+			if (!IsSafeName(Entry.Kind, false) || !IsSafeName(Entry.Key, bTileFile))
+			{
+				OutError = FString::Printf(TEXT("%s entry %d has an invalid name '%s/%s'."), *Path, Index, *Entry.Kind, *Entry.Key);
+				return false;
+			}
+			Entry.Raw.SetNumUninitialized(RawSize);
+			if (!FCompression::UncompressMemory(NAME_Zlib, Entry.Raw.GetData(), RawSize, Packed.GetData(), Packed.Num()))
+			{
+				OutError = FString::Printf(TEXT("%s entry %d does not decompress."), *Path, Index);
+				return false;
+			}
+			OutPackedBytes += Packed.Num();
+		}
+		return true;
+	}
+
+	// ── Worker helpers ──────────────────────────────────────────────────────
+
+	/** Workers always capture: every stage's cache mode becomes memory, and the command runs inline. */
+	static void PrepareWorkerArgs(const TSharedPtr<FJsonObject>& Args)
+	{
+		Args->RemoveField(TEXT("async"));
+		Args->SetStringField(TEXT("cache"), TEXT("memory"));
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : Args->Values)
+		{
+			const TSharedPtr<FJsonObject>* Stage = nullptr;
+			if (Pair.Value.IsValid() && Pair.Value->TryGetObject(Stage) && (*Stage)->HasField(TEXT("cache")))
+			{
+				(*Stage)->SetStringField(TEXT("cache"), TEXT("memory"));
+			}
+		}
+	}
+
+	/** Every "tile_cache_dir" string anywhere in the response (pipelines nest them per stage). */
+	static void FindTileDirs(const TSharedPtr<FJsonValue>& Value, TArray<FString>& Out)
+	{
+		if (!Value.IsValid())
+		{
+			return;
+		}
+		if (Value->Type == EJson::Object)
+		{
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : Value->AsObject()->Values)
+			{
+				FString Dir;
+				if (Pair.Key == TEXT("tile_cache_dir") && Pair.Value.IsValid() && Pair.Value->TryGetString(Dir) && !Dir.IsEmpty())
+				{
+					Out.AddUnique(Dir);
+				}
+				else
+				{
+					FindTileDirs(Pair.Value, Out);
+				}
+			}
+		}
+		else if (Value->Type == EJson::Array)
+		{
+			for (const TSharedPtr<FJsonValue>& Item : Value->AsArray())
+			{
+				FindTileDirs(Item, Out);
+			}
+		}
+	}
+
+	/** A tile directory's files, manifest last so the importer completes it only after every tile. */
+	static bool CollectTileFiles(const FString& Dir, TArray<FResultEntry>& Out)
+	{
+		const FString DirKey = FPaths::GetCleanFilename(Dir);
+		TArray<FString> Names = ListFiles(Dir, TEXT("*"));
+		Names.Remove(TileManifestName);
+		Names.Add(TileManifestName);
+		for (const FString& Name : Names)
+		{
+			FResultEntry& Entry = Out.AddDefaulted_GetRef();
+			Entry.Kind = FAgentForgeWorkerFarm::TileFileKind;
+			Entry.Key = DirKey / Name;
+			if (!FFileHelper::LoadFileToArray(Entry.Raw, *(Dir / Name), FILEREAD_Silent))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	static bool LoadWorkerMap(const FString& MapName, FString& OutError)
+	{
+#if WITH_EDITOR
+		FString Filename;
+		if (!FPackageName::TryConvertLongPackageNameToFilename(MapName, Filename, FPackageName::GetMapPackageExtension())
+			|| !FPaths::FileExists(Filename))
+		{
+			OutError = FString::Printf(TEXT("Map '%s' not found on this worker."), *MapName);
+			return false;
+		}
+		if (!FEditorFileUtils::LoadMap(Filename, /*LoadAsTemplate=*/false, /*bShowProgress=*/false))
+		{
+			OutError = FString::Printf(TEXT("Failed to load map '%s'."), *MapName);
+			return false;
+		}
+		return true;
+#else
+		OutError = TEXT("Farm workers require WITH_EDITOR.");
+		return false;
+#endif
+	}
+
+	struct FWorkerState
+	{
+		FString Spool;
+		FString WorkerId;
+		FString PluginVersion;
+		FString StartedUtc;
+		FString CurrentJob;
+		int32   JobsDone = 0;
+		int32   JobsFailed = 0;
+
+		FString HeartbeatPath() const { return WorkersDir(Spool) / (WorkerId + TEXT(".json")); }
+
+		/** Rewrites the heartbeat on a state change; the pulse thread keeps its time stamp fresh in between. */
+		void Heartbeat() const
+		{
+			TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+			Obj->SetStringField(TEXT("worker"),         WorkerId);
+			Obj->SetStringField(TEXT("host"),           FPlatformProcess::ComputerName());
+			Obj->SetNumberField(TEXT("pid"),            FPlatformProcess::GetCurrentProcessId());
+			Obj->SetStringField(TEXT("plugin_version"), PluginVersion);
+			Obj->SetStringField(TEXT("state"),          CurrentJob.IsEmpty() ? TEXT("idle") : TEXT("busy"));
+			Obj->SetStringField(TEXT("job_id"),         CurrentJob);
+			Obj->SetNumberField(TEXT("jobs_done"),      JobsDone);
+			Obj->SetNumberField(TEXT("jobs_failed"),    JobsFailed);
+			Obj->SetStringField(TEXT("started_utc"),    StartedUtc);
+			Obj->SetStringField(TEXT("heartbeat_utc"),  FDateTime::UtcNow().ToIso8601());
+			SaveStringAtomically(ToJson(Obj), HeartbeatPath());
+		}
+	};
+
+	/** Renames the oldest queued job into claimed/. False when the queue is empty or every claim lost a race. */
+	static bool ClaimNextJob(const FWorkerState& Worker, FString& OutJobId, FString& OutClaimedPath)
+	{
+		for (const FString& Name : ListFiles(JobsDir(Worker.Spool), TEXT("*.json")))
+		{
+			const FString JobId = FPaths::GetBaseFilename(Name);
+			const FString Claimed = ClaimedDir(Worker.Spool) / FString::Printf(TEXT("%s.%s.json"), *JobId, *Worker.WorkerId);
+			if (IFileManager::Get().Move(*Claimed, *(JobsDir(Worker.Spool) / Name), /*Replace=*/false, /*EvenIfReadOnly=*/false, /*Attributes=*/false, /*bDoNotRetryOrError=*/true))
+			{
+				OutJobId = JobId;
+				OutClaimedPath = Claimed;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/** Runs one claimed job and writes its result. False when the job failed. */
+	static bool RunClaimedJob(FWorkerState& Worker, const FString& JobId, const FString& ClaimedPath)
+	{
+		TSharedPtr<FJsonObject> Header = MakeShared<FJsonObject>();
+		Header->SetStringField(TEXT("job_id"), JobId);
+		Header->SetStringField(TEXT("worker"), Worker.WorkerId);
+		Header->SetStringField(TEXT("host"),   FPlatformProcess::ComputerName());
+
+		TArray<FAgentForgeProceduralCache::FCapturedEntry> CacheEntries;
+		TArray<FResultEntry> FileEntries;
+		FString Error;
+		const double StartSeconds = FPlatformTime::Seconds();
+
+		FString JobText;
+		const TSharedPtr<FJsonObject> Job = FFileHelper::LoadFileToString(JobText, *ClaimedPath) ? ParseJson(JobText) : nullptr;
+		FString Cmd;
+		FString Map;
+		FString JobPluginVersion;
+		const TSharedPtr<FJsonObject>* ArgsPtr = nullptr;
+		if (Job.IsValid())
+		{
+			Job->TryGetStringField(TEXT("plugin_version"), JobPluginVersion);
+		}
+		if (!Job.IsValid() || Job->GetStringField(TEXT("schema")) != JobSchema
+			|| !Job->TryGetStringField(TEXT("cmd"), Cmd) || !Job->TryGetObjectField(TEXT("args"), ArgsPtr))
+		{
+			Error = TEXT("Unreadable job file.");
+		}
+		else if (JobPluginVersion != Worker.PluginVersion)
+		{
+			Error = FString::Printf(TEXT("Job was submitted by plugin %s; this worker runs %s."), *JobPluginVersion, *Worker.PluginVersion);
+		}
+		else if (!FAgentForgeWorkerFarm::IsFarmable(Cmd))
+		{
+			Error = FString::Printf(TEXT("'%s' does not run on farm workers."), *Cmd);
+		}
+		else if (Job->TryGetStringField(TEXT("map"), Map) && !Map.IsEmpty() && Map != TEXT("none") && !LoadWorkerMap(Map, Error))
+		{
+			// Error set by LoadWorkerMap.
+		}
+		else
+		{
+			Header->SetStringField(TEXT("cmd"), Cmd);
+			const TSharedPtr<FJsonObject> Args = MakeShared<FJsonObject>(**ArgsPtr);
+			PrepareWorkerArgs(Args);
+			TSharedPtr<FJsonObject> Request = MakeShared<FJsonObject>();
+			Request->SetStringField(TEXT("cmd"), Cmd);
+			Request->SetObjectField(TEXT("args"), Args);
+
+			FAgentForgeProceduralCache::Get().BeginCapture();
+			const FString Response = UAgentForgeLibrary::ExecuteCommandJson(ToJson(Request));
+			CacheEntries = FAgentForgeProceduralCache::Get().EndCapture();
+
+			if (FAgentForgeRequestEnvelope::IsErrorResponse(Response))
+			{
+				const TSharedPtr<FJsonObject> ResponseObj = ParseJson(Response);
+				if (!ResponseObj.IsValid() || !ResponseObj->TryGetStringField(TEXT("error"), Error) || Error.IsEmpty())
+				{
+					Error = Response.Left(512);
+				}
+			}
+			else if (const TSharedPtr<FJsonObject> ResponseObj = ParseJson(Response))
+			{
+				TArray<FString> TileDirs;
+				FindTileDirs(MakeShared<FJsonValueObject>(ResponseObj), TileDirs);
+				for (const FString& Dir : TileDirs)
+				{
+					if (!CollectTileFiles(Dir, FileEntries))
+					{
+						Error = FString::Printf(TEXT("Cannot read terrain tiles in %s."), *Dir);
+						break;
+					}
+				}
+			}
+		}
+
+		const bool bOk = Error.IsEmpty();
+		if (!bOk)
+		{
+			// A failed job ships nothing; the editor computes it itself.
+			CacheEntries.Reset();
+			FileEntries.Reset();
+		}
+		Header->SetBoolField  (TEXT("ok"),          bOk);
+		Header->SetStringField(TEXT("error"),       Error);
+		Header->SetNumberField(TEXT("compute_ms"),  (FPlatformTime::Seconds() - StartSeconds) * 1000.0);
+		Header->SetStringField(TEXT("finished_utc"), FDateTime::UtcNow().ToIso8601());
+
+		int64 RawBytes = 0;
+		int64 PackedBytes = 0;
+		const FString ResultPath = ResultsDir(Worker.Spool) / (JobId + TEXT(".afres"));
+		if (!WriteResult(ResultPath, Header, CacheEntries, FileEntries, RawBytes, PackedBytes))
+		{
+			UE_LOG(LogTemp, Error, TEXT("[UEAgentForge] Farm worker %s: cannot write %s; job %s goes back to the queue."), *Worker.WorkerId, *ResultPath, *JobId);
+			IFileManager::Get().Move(*(JobsDir(Worker.Spool) / (JobId + TEXT(".json"))), *ClaimedPath, false, false, false, true);
+			return false;
+		}
+		IFileManager::Get().Delete(*ClaimedPath, false, false, true);
+
+		if (bOk)
+		{
+			UE_LOG(LogTemp, Display, TEXT("[UEAgentForge] Farm worker %s: %s (%s) done in %.0f ms, %d entries, %.1f MB packed."),
+				*Worker.WorkerId, *JobId, *Cmd, Header->GetNumberField(TEXT("compute_ms")), CacheEntries.Num() + FileEntries.Num(), PackedBytes / (1024.0 * 1024.0));
+		}
+		else
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[UEAgentForge] Farm worker %s: %s failed: %s"), *Worker.WorkerId, *JobId, *Error);
+		}
+		return bOk;
+	}
+}
+
+const TCHAR* const FAgentForgeWorkerFarm::TileFileKind = TEXT("terrain_tiles");
+
+FAgentForgeWorkerFarm& FAgentForgeWorkerFarm::Get()
+{
+	static FAgentForgeWorkerFarm Instance;
+	return Instance;
+}
+
+FString FAgentForgeWorkerFarm::GetDefaultSpool()
+{
+	FString Spool;
+	if (FParse::Value(FCommandLine::Get(), TEXT("AgentForgeFarmSpool="), Spool) && !Spool.IsEmpty())
+	{
+		return Spool;
+	}
+	return FPaths::ProjectSavedDir() / TEXT("AgentForgeFarm");
+}
+
+bool FAgentForgeWorkerFarm::IsFarmable(const FString& Cmd)
+{
+	for (const TCHAR* Name : FarmableCommands)
+	{
+		if (Cmd == Name)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+// ── Editor side ─────────────────────────────────────────────────────────────
+
+bool FAgentForgeWorkerFarm::Submit(const FString& Spool, const FString& Map, const TArray<FFarmJobSpec>& Jobs, TArray<FString>& OutJobIds, FString& OutError)
+{
+	for (const FFarmJobSpec& Spec : Jobs)
+	{
+		if (!IsFarmable(Spec.Cmd))
+		{
+			TArray<FString> Names;
+			for (const TCHAR* Name : FarmableCommands)
+			{
+				Names.Add(Name);
+			}
+			OutError = FString::Printf(TEXT("'%s' does not run on farm workers (%s)."), *Spec.Cmd, *FString::Join(Names, TEXT(", ")));
+			return false;
+		}
+	}
+
+	MakeSpoolDirs(Spool);
+	const FString Stamp = FDateTime::UtcNow().ToString(TEXT("%Y%m%d-%H%M%S"));
+	const FString Batch = FGuid::NewGuid().ToString(EGuidFormats::Digits).Left(8).ToLower();
+	const FString PluginVersion = GetPluginVersion();
+	OutJobIds.Reset();
+	for (int32 Index = 0; Index < Jobs.Num(); ++Index)
+	{
+		const FString JobId = FString::Printf(TEXT("%s-%s-%03d"), *Stamp, *Batch, Index);
+		TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+		Obj->SetStringField(TEXT("schema"),         JobSchema);
+		Obj->SetStringField(TEXT("job_id"),         JobId);
+		Obj->SetStringField(TEXT("cmd"),            Jobs[Index].Cmd);
+		Obj->SetObjectField(TEXT("args"),           Jobs[Index].Args.IsValid() ? Jobs[Index].Args : TSharedPtr<FJsonObject>(MakeShared<FJsonObject>()));
+		Obj->SetStringField(TEXT("map"),            Map);
+		Obj->SetStringField(TEXT("plugin_version"), PluginVersion);
+		Obj->SetStringField(TEXT("submitted_by"),   FPlatformProcess::ComputerName());
+		Obj->SetStringField(TEXT("submitted_utc"),  FDateTime::UtcNow().ToIso8601());
+		if (!SaveStringAtomically(ToJson(Obj), JobsDir(Spool) / (JobId + TEXT(".json"))))
+		{
+			Withdraw(OutJobIds);
+			OutError = FString::Printf(TEXT("Cannot write jobs into %s."), *JobsDir(Spool));
+			return false;
+		}
+		FTrackedJob& Job = Tracked.Add(JobId);
+		Job.Cmd = Jobs[Index].Cmd;
+		Job.Spool = Spool;
+		OutJobIds.Add(JobId);
+		++Submitted;
+	}
+	return true;
+}
+
+void FAgentForgeWorkerFarm::RequeueStaleClaims(const FString& Spool)
+{
+	const FDateTime Now = FDateTime::UtcNow();
+	for (const FString& Name : ListFiles(ClaimedDir(Spool), TEXT("*.json")))
+	{
+		// <job id>.<worker>.json; job ids carry no dots.
+		FString JobId;
+		FString WorkerId;
+		if (!FPaths::GetBaseFilename(Name).Split(TEXT("."), &JobId, &WorkerId))
+		{
+			continue;
+		}
+		const FDateTime Beat = IFileManager::Get().GetTimeStamp(*(WorkersDir(Spool) / (WorkerId + TEXT(".json"))));
+		if (Beat != FDateTime::MinValue() && (Now - Beat).GetTotalSeconds() < StaleWorkerSeconds)
+		{
+			continue;
+		}
+		if (IFileManager::Get().Move(*(JobsDir(Spool) / (JobId + TEXT(".json"))), *(ClaimedDir(Spool) / Name), false, false, false, true))
+		{
+			++Requeued;
+			UE_LOG(LogTemp, Warning, TEXT("[UEAgentForge] Farm: worker %s stopped sending heartbeats; job %s is queued again."), *WorkerId, *JobId);
+		}
+	}
+}
+
+int32 FAgentForgeWorkerFarm::Collect(const FString& Spool, EProceduralCacheMode ImportMode)
+{
+	RequeueStaleClaims(Spool);
+
+	int32 Finished = 0;
+	FAgentForgeProceduralCache& Cache = FAgentForgeProceduralCache::Get();
+	for (TPair<FString, FTrackedJob>& Pair : Tracked)
+	{
+		FTrackedJob& Job = Pair.Value;
+		const FString ResultPath = ResultsDir(Spool) / (Pair.Key + TEXT(".afres"));
+		if (Job.Status != TEXT("queued") || Job.Spool != Spool || !IFileManager::Get().FileExists(*ResultPath))
+		{
+			continue;
+		}
+
+		TSharedPtr<FJsonObject> Header;
+		TArray<FResultEntry> Entries;
+		FString Error;
+		if (ReadResult(ResultPath, Header, Entries, Job.PackedBytes, Error))
+		{
+			Header->TryGetStringField(TEXT("worker"), Job.Worker);
+			Header->TryGetNumberField(TEXT("compute_ms"), Job.ComputeMs);
+			if (!Header->GetBoolField(TEXT("ok")))
+			{
+				Header->TryGetStringField(TEXT("error"), Error);
+			}
+		}
+
+		if (Error.IsEmpty())
+		{
+			const FString TileRoot = FTerrainTileCache::DefaultRoot();
+			for (FResultEntry& Entry : Entries)
+			{
+				Job.RawBytes += Entry.Raw.Num();
+				if (Entry.Kind == TileFileKind)
+				{
+					const FString Path = TileRoot / Entry.Key;
+					IFileManager::Get().MakeDirectory(*FPaths::GetPath(Path), true);
+					if (!FFileHelper::SaveArrayToFile(Entry.Raw, *Path))
+					{
+						Error = FString::Printf(TEXT("Cannot write %s."), *Path);
+						break;
+					}
+				}
+				else
+				{
+					Cache.Store(*Entry.Kind, Entry.Key, MoveTemp(Entry.Raw), ImportMode);
+				}
+				++Job.Entries;
+			}
+		}
+
+		Job.Error = Error;
+		if (Error.IsEmpty())
+		{
+			Job.Status = TEXT("done");
+			++Completed;
+		}
+		else
+		{
+			Job.Status = TEXT("failed");
+			++Failed;
+		}
+		ImportedEntries += Job.Entries;
+		ImportedBytes += Job.RawBytes;
+		IFileManager::Get().Delete(*ResultPath, false, false, true);
+		++Finished;
+	}
+	return Finished;
+}
+
+bool FAgentForgeWorkerFarm::IsFinished(const FString& JobId) const
+{
+	const FTrackedJob* Job = Tracked.Find(JobId);
+	return !Job || Job->Status != TEXT("queued");
+}
+
+void FAgentForgeWorkerFarm::Withdraw(const TArray<FString>& JobIds)
+{
+	for (const FString& JobId : JobIds)
+	{
+		if (FTrackedJob* Job = Tracked.Find(JobId))
+		{
+			if (Job->Status == TEXT("queued") && IFileManager::Get().Delete(*(JobsDir(Job->Spool) / (JobId + TEXT(".json"))), false, false, true))
+			{
+				Tracked.Remove(JobId);
+			}
+		}
+	}
+}
+
+TSharedPtr<FJsonObject> FAgentForgeWorkerFarm::GetJobJson(const FString& JobId) const
+{
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetStringField(TEXT("job_id"), JobId);
+	const FTrackedJob* Job = Tracked.Find(JobId);
+	if (!Job)
+	{
+		Obj->SetStringField(TEXT("status"), TEXT("unknown"));
+		return Obj;
+	}
+	Obj->SetStringField(TEXT("cmd"),          Job->Cmd);
+	Obj->SetStringField(TEXT("status"),       Job->Status);
+	Obj->SetStringField(TEXT("worker"),       Job->Worker);
+	Obj->SetNumberField(TEXT("compute_ms"),   Job->ComputeMs);
+	Obj->SetNumberField(TEXT("entries"),      Job->Entries);
+	Obj->SetNumberField(TEXT("raw_mb"),       Job->RawBytes / (1024.0 * 1024.0));
+	Obj->SetNumberField(TEXT("packed_mb"),    Job->PackedBytes / (1024.0 * 1024.0));
+	if (!Job->Error.IsEmpty())
+	{
+		Obj->SetStringField(TEXT("error"), Job->Error);
+	}
+	return Obj;
+}
+
+TSharedPtr<FJsonObject> FAgentForgeWorkerFarm::GetSpoolJson(const FString& Spool)
+{
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetStringField(TEXT("spool"),   Spool);
+	Obj->SetNumberField(TEXT("queued"),  ListFiles(JobsDir(Spool), TEXT("*.json")).Num());
+	Obj->SetNumberField(TEXT("claimed"), ListFiles(ClaimedDir(Spool), TEXT("*.json")).Num());
+	Obj->SetNumberField(TEXT("results"), ListFiles(ResultsDir(Spool), TEXT("*.afres")).Num());
+
+	const FDateTime Now = FDateTime::UtcNow();
+	TArray<TSharedPtr<FJsonValue>> Workers;
+	for (const FString& Name : ListFiles(WorkersDir(Spool), TEXT("*.json")))
+	{
+		const FString Path = WorkersDir(Spool) / Name;
+		FString Text;
+		TSharedPtr<FJsonObject> Beat = FFileHelper::LoadFileToString(Text, *Path) ? ParseJson(Text) : nullptr;
+		if (!Beat.IsValid())
+		{
+			continue;
+		}
+		const double AgeSeconds = (Now - IFileManager::Get().GetTimeStamp(*Path)).GetTotalSeconds();
+		Beat->SetNumberField(TEXT("heartbeat_age_seconds"), AgeSeconds);
+		Beat->SetBoolField  (TEXT("stale"),                 AgeSeconds >= StaleWorkerSeconds);
+		Workers.Add(MakeShared<FJsonValueObject>(Beat));
+	}
+	Obj->SetArrayField(TEXT("workers"), Workers);
+	return Obj;
+}
+
+TSharedPtr<FJsonObject> FAgentForgeWorkerFarm::GetStatsJson() const
+{
+	int32 Pending = 0;
+	for (const TPair<FString, FTrackedJob>& Pair : Tracked)
+	{
+		Pending += Pair.Value.Status == TEXT("queued") ? 1 : 0;
+	}
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetStringField(TEXT("default_spool"),     GetDefaultSpool());
+	Obj->SetNumberField(TEXT("submitted"),         (double)Submitted);
+	Obj->SetNumberField(TEXT("pending"),           Pending);
+	Obj->SetNumberField(TEXT("completed"),         (double)Completed);
+	Obj->SetNumberField(TEXT("failed"),            (double)Failed);
+	Obj->SetNumberField(TEXT("requeued"),          (double)Requeued);
+	Obj->SetNumberField(TEXT("imported_entries"),  (double)ImportedEntries);
+	Obj->SetNumberField(TEXT("imported_mb"),       ImportedBytes / (1024.0 * 1024.0));
+	return Obj;
+}
+
+TSharedRef<FAgentForgeJob> FAgentForgeWorkerFarm::MakePrecomputeJob(const TSharedPtr<FJsonObject>& Args)
+{
+	TSharedRef<FAgentForgeJob> Job = MakeShared<FAgentForgeJob>(TEXT("farm_precompute"));
+
+	struct FPrecomputeRun
+	{
+		FString Spool;
+		FString Map;
+		bool    bLevelDirty = false;
+		double  TimeoutSeconds = 1800.0;
+		EProceduralCacheMode ImportMode = EProceduralCacheMode::Disk;
+		TArray<FFarmJobSpec> Specs;
+		TArray<FString> JobIds;
+		double  StartSeconds = 0.0;
+		double  LastCollectSeconds = 0.0;
+		bool    bTimedOut = false;
+	};
+	TSharedRef<FPrecomputeRun> Run = MakeShared<FPrecomputeRun>();
+
+	Job->AddStage(TEXT("submit"), [Run, Args](FAgentForgeJob& J)
+	{
+		Run->StartSeconds = FPlatformTime::Seconds();
+		Run->Spool = GetDefaultSpool();
+		FString CacheName;
+		if (Args.IsValid())
+		{
+			Args->TryGetStringField(TEXT("spool"), Run->Spool);
+			Args->TryGetStringField(TEXT("map"), Run->Map);
+			Args->TryGetNumberField(TEXT("timeout_seconds"), Run->TimeoutSeconds);
+			Args->TryGetStringField(TEXT("cache"), CacheName);
+		}
+		if (!CacheName.IsEmpty() && (!FAgentForgeProceduralCache::ParseMode(CacheName, Run->ImportMode) || Run->ImportMode == EProceduralCacheMode::Off))
+		{
+			J.Finish(ErrorJson(FString::Printf(TEXT("Unknown cache '%s' (memory|disk)."), *CacheName)));
+			return true;
+		}
+
+		const TArray<TSharedPtr<FJsonValue>>* JobValues = nullptr;
+		if (!Args.IsValid() || !Args->TryGetArrayField(TEXT("jobs"), JobValues) || JobValues->Num() == 0)
+		{
+			J.Finish(ErrorJson(TEXT("farm_precompute needs jobs[{cmd,args}].")));
+			return true;
+		}
+		for (const TSharedPtr<FJsonValue>& Value : *JobValues)
+		{
+			const TSharedPtr<FJsonObject>* JobObj = nullptr;
+			FFarmJobSpec& Spec = Run->Specs.AddDefaulted_GetRef();
+			if (!Value.IsValid() || !Value->TryGetObject(JobObj) || !(*JobObj)->TryGetStringField(TEXT("cmd"), Spec.Cmd))
+			{
+				J.Finish(ErrorJson(TEXT("Every entry of jobs[] needs a cmd.")));
+				return true;
+			}
+			const TSharedPtr<FJsonObject>* JobArgs = nullptr;
+			Spec.Args = (*JobObj)->TryGetObjectField(TEXT("args"), JobArgs) ? *JobArgs : TSharedPtr<FJsonObject>(MakeShared<FJsonObject>());
+		}
+
+#if WITH_EDITOR
+		if (Run->Map.IsEmpty())
+		{
+			UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+			UPackage* Package = World ? World->GetOutermost() : nullptr;
+			if (!Package || !FPackageName::DoesPackageExist(Package->GetName()))
+			{
+				J.Finish(ErrorJson(TEXT("The current level has never been saved, so workers cannot load it. Save it first or pass map=\"none\".")));
+				return true;
+			}
+			Run->Map = Package->GetName();
+			Run->bLevelDirty = Package->IsDirty();
+		}
+#endif
+
+		FString Error;
+		if (!Get().Submit(Run->Spool, Run->Map, Run->Specs, Run->JobIds, Error))
+		{
+			J.Finish(ErrorJson(Error));
+		}
+		return true;
+	}, 0.1f);
+
+	Job->AddStage(TEXT("collect"), [Run](FAgentForgeJob& J)
+	{
+		FAgentForgeWorkerFarm& Farm = Get();
+		const double Now = FPlatformTime::Seconds();
+		if (Now - Run->LastCollectSeconds >= CollectIntervalSeconds)
+		{
+			Run->LastCollectSeconds = Now;
+			Farm.Collect(Run->Spool, Run->ImportMode);
+		}
+
+		int32 Finished = 0;
+		for (const FString& JobId : Run->JobIds)
+		{
+			Finished += Farm.IsFinished(JobId) ? 1 : 0;
+		}
+		J.SetStageProgress(Run->JobIds.Num() > 0 ? (float)Finished / Run->JobIds.Num() : 1.0f);
+		if (Finished == Run->JobIds.Num())
+		{
+			return true;
+		}
+		if (Now - Run->StartSeconds > Run->TimeoutSeconds)
+		{
+			Run->bTimedOut = true;
+			return true;
+		}
+		J.YieldSlice();
+		return false;
+	}, 1.0f);
+
+	Job->SetCancelHandler([Run](FAgentForgeJob&) { Get().Withdraw(Run->JobIds); });
+
+	Job->SetFinalizer([Run](FAgentForgeJob&)
+	{
+		const FAgentForgeWorkerFarm& Farm = Get();
+		TArray<TSharedPtr<FJsonValue>> Jobs;
+		int32 Done = 0;
+		int32 FailedJobs = 0;
+		int32 Entries = 0;
+		double RawMB = 0.0;
+		double PackedMB = 0.0;
+		for (const FString& JobId : Run->JobIds)
+		{
+			const TSharedPtr<FJsonObject> JobObj = Farm.GetJobJson(JobId);
+			const FString Status = JobObj->GetStringField(TEXT("status"));
+			Done += Status == TEXT("done") ? 1 : 0;
+			FailedJobs += Status == TEXT("failed") ? 1 : 0;
+			double Value = 0.0;
+			Entries += JobObj->TryGetNumberField(TEXT("entries"), Value) ? (int32)Value : 0;
+			RawMB += JobObj->TryGetNumberField(TEXT("raw_mb"), Value) ? Value : 0.0;
+			PackedMB += JobObj->TryGetNumberField(TEXT("packed_mb"), Value) ? Value : 0.0;
+			Jobs.Add(MakeShared<FJsonValueObject>(JobObj));
+		}
+
+		TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
+		Root->SetBoolField  (TEXT("ok"),               true);
+		Root->SetStringField(TEXT("spool"),            Run->Spool);
+		Root->SetStringField(TEXT("map"),              Run->Map);
+		Root->SetStringField(TEXT("cache"),            FAgentForgeProceduralCache::ModeName(Run->ImportMode));
+		Root->SetNumberField(TEXT("submitted"),        Run->JobIds.Num());
+		Root->SetNumberField(TEXT("completed"),        Done);
+		Root->SetNumberField(TEXT("failed"),           FailedJobs);
+		Root->SetNumberField(TEXT("pending"),          Run->JobIds.Num() - Done - FailedJobs);
+		Root->SetBoolField  (TEXT("timed_out"),        Run->bTimedOut);
+		Root->SetNumberField(TEXT("imported_entries"), Entries);
+		Root->SetNumberField(TEXT("imported_mb"),      RawMB);
+		Root->SetNumberField(TEXT("transferred_mb"),   PackedMB);
+		Root->SetNumberField(TEXT("elapsed_ms"),       (FPlatformTime::Seconds() - Run->StartSeconds) * 1000.0);
+		Root->SetArrayField (TEXT("jobs"),             Jobs);
+		if (Run->bLevelDirty)
+		{
+			Root->SetStringField(TEXT("warning"), TEXT("The level has unsaved changes. Workers used the saved map, so results that depend on the changed actors will not be hit."));
+		}
+		return ToJson(Root);
+	});
+	return Job;
+}
+
+// ── Worker side ─────────────────────────────────────────────────────────────
+
+int32 FAgentForgeWorkerFarm::RunWorker(const FFarmWorkerSettings& Settings)
+{
+	FWorkerState Worker;
+	Worker.Spool = Settings.Spool.IsEmpty() ? GetDefaultSpool() : Settings.Spool;
+	Worker.WorkerId = Settings.WorkerId.IsEmpty()
+		? FString::Printf(TEXT("%s-%u"), FPlatformProcess::ComputerName(), FPlatformProcess::GetCurrentProcessId())
+		: Settings.WorkerId;
+	// The worker id is part of claim file names, split at the first dot.
+	Worker.WorkerId.ReplaceCharInline(TEXT('.'), TEXT('_'));
+	Worker.WorkerId.ReplaceCharInline(TEXT('/'), TEXT('_'));
+	Worker.WorkerId.ReplaceCharInline(TEXT('\\'), TEXT('_'));
+	Worker.PluginVersion = GetPluginVersion();
+	Worker.StartedUtc = FDateTime::UtcNow().ToIso8601();
+
+	MakeSpoolDirs(Worker.Spool);
+	UE_LOG(LogTemp, Display, TEXT("[UEAgentForge] Farm worker %s polling %s."), *Worker.WorkerId, *Worker.Spool);
+	Worker.Heartbeat();
+
+	// Commands block the game thread for as long as they compute, so the
+	// heartbeat's time stamp is refreshed from a thread of its own.
+	std::atomic<bool> bStopPulse { false };
+	const FString PulsePath = Worker.HeartbeatPath();
+	TFuture<void> Pulse = Async(EAsyncExecution::Thread, [&bStopPulse, PulsePath]()
+	{
+		double LastPulseSeconds = FPlatformTime::Seconds();
+		while (!bStopPulse.load(std::memory_order_acquire))
+		{
+			FPlatformProcess::Sleep(0.25f);
+			if (FPlatformTime::Seconds() - LastPulseSeconds >= HeartbeatSeconds)
+			{
+				LastPulseSeconds = FPlatformTime::Seconds();
+				IFileManager::Get().SetTimeStamp(*PulsePath, FDateTime::UtcNow());
+			}
+		}
+	});
+
+	double IdleSinceSeconds = FPlatformTime::Seconds();
+	while (!IsEngineExitRequested() && (Settings.MaxJobs <= 0 || Worker.JobsDone + Worker.JobsFailed < Settings.MaxJobs))
+	{
+		FString JobId;
+		FString ClaimedPath;
+		if (!ClaimNextJob(Worker, JobId, ClaimedPath))
+		{
+			if (Settings.IdleExitSeconds > 0.0 && FPlatformTime::Seconds() - IdleSinceSeconds > Settings.IdleExitSeconds)
+			{
+				break;
+			}
+			FPlatformProcess::Sleep((float)Settings.PollSeconds);
+			FTSTicker::GetCoreTicker().Tick((float)Settings.PollSeconds);
+			continue;
+		}
+
+		Worker.CurrentJob = JobId;
+		Worker.Heartbeat();
+		if (RunClaimedJob(Worker, JobId, ClaimedPath))
+		{
+			++Worker.JobsDone;
+		}
+		else
+		{
+			++Worker.JobsFailed;
+		}
+		Worker.CurrentJob.Reset();
+		Worker.Heartbeat();
+		// Tickers between jobs: the memory monitor may collect garbage here.
+		FTSTicker::GetCoreTicker().Tick(0.0f);
+		IdleSinceSeconds = FPlatformTime::Seconds();
+	}
+
+	bStopPulse.store(true, std::memory_order_release);
+	Pulse.Wait();
+	IFileManager::Get().Delete(*PulsePath, false, false, true);
+	UE_LOG(LogTemp, Display, TEXT("[UEAgentForge] Farm worker %s stopped: %d done, %d failed."), *Worker.WorkerId, Worker.JobsDone, Worker.JobsFailed);
+	return Worker.JobsFailed;
+}
@@ -0,0 +1,485 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeWorldSnapshot.cpp — binary snapshot capture, serialization, diff and background writes.
+
+#include "AgentForgeWorldSnapshot.h"
+
+#include "AgentForgeStringKeys.h"
+#include "Async/Async.h"
+#include "Dom/JsonValue.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Actor.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Hash/CityHash.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+	struct FStringInterner
+	{
+		TArray<FString>& Strings;
+		TMap<FString, int32, FDefaultSetAllocator, TAgentForgeCaseSensitiveKeyFuncs<int32>> Indices;
+
+		explicit FStringInterner(TArray<FString>& InStrings) : Strings(InStrings) {}
+
+		int32 Intern(const FString& Value)
+		{
+			if (const int32* Found = Indices.Find(Value))
+			{
+				return *Found;
+			}
+			const int32 Index = Strings.Add(Value);
+			Indices.Add(Value, Index);
+			return Index;
+		}
+	};
+
+	// Older JSON snapshots may lack paths; the label is the next best identity.
+	const FString& DiffKey(const FAgentForgeWorldSnapshot& Snapshot, const FAgentForgeWorldSnapshot::FActorRecord& Actor)
+	{
+		const FString& Path = Snapshot.GetPath(Actor);
+		return Path.IsEmpty() ? Snapshot.GetLabel(Actor) : Path;
+	}
+
+	// Bytes per record on disk: three indices, the transform and the hash.
+	constexpr int64 SerializedRecordBytes = 3 * sizeof(int32) + 3 * sizeof(double) + 6 * sizeof(float) + sizeof(uint64);
+}
+
+static_assert(sizeof(FAgentForgeWorldSnapshot::FTransformData) == 3 * sizeof(double) + 6 * sizeof(float),
+	"FTransformData is hashed as raw bytes and must not contain padding.");
+
+// ============================================================================
+// Snapshot
+// ============================================================================
+
+FAgentForgeWorldSnapshot FAgentForgeWorldSnapshot::Capture(UWorld* World, const FString& SnapshotName)
+{
+	FAgentForgeWorldSnapshot Snapshot;
+	Snapshot.Name      = SnapshotName;
+	Snapshot.Timestamp = FDateTime::Now();
+
+#if WITH_EDITOR
+	if (!World) { return Snapshot; }
+
+	FStringInterner Interner(Snapshot.Strings);
+	for (TActorIterator<AActor> It(World); It; ++It)
+	{
+		AActor* Actor = *It;
+		if (!Actor || !IsValid(Actor)) { continue; }
+
+		const FString Label = Actor->GetActorLabel();
+		const FString Class = Actor->GetClass()->GetName();
+
+		FActorRecord& Record = Snapshot.Actors.AddDefaulted_GetRef();
+		Record.PathIndex  = Interner.Intern(Actor->GetPathName());
+		Record.LabelIndex = Interner.Intern(Label);
+		Record.ClassIndex = Interner.Intern(Class);
+		Record.Transform.Location = Actor->GetActorLocation();
+		Record.Transform.Rotation = FRotator3f(Actor->GetActorRotation());
+		Record.Transform.Scale    = FVector3f(Actor->GetActorScale3D());
+		Record.Hash = HashActor(Label, Class, Record.Transform);
+	}
+#endif
+
+	return Snapshot;
+}
+
+FAgentForgeWorldSnapshot::FDiff FAgentForgeWorldSnapshot::Diff(const FAgentForgeWorldSnapshot& A, const FAgentForgeWorldSnapshot& B)
+{
+	FDiff Result;
+
+	// Label keys (older snapshots) can repeat, so a key holds every A record
+	// still unmatched, in capture order.
+	TMap<FString, TArray<int32>, FDefaultSetAllocator, TAgentForgeCaseSensitiveKeyFuncs<TArray<int32>>> IndexA;
+	IndexA.Reserve(A.Actors.Num());
+	for (int32 i = 0; i < A.Actors.Num(); ++i)
+	{
+		IndexA.FindOrAdd(DiffKey(A, A.Actors[i])).Add(i);
+	}
+
+	TBitArray<> Matched(false, A.Actors.Num());
+	for (int32 j = 0; j < B.Actors.Num(); ++j)
+	{
+		const FActorRecord& Actor = B.Actors[j];
+		TArray<int32>* Candidates = IndexA.Find(DiffKey(B, Actor));
+		if (!Candidates || Candidates->IsEmpty())
+		{
+			Result.Added.Add(j);
+			continue;
+		}
+		// Among duplicates prefer an unchanged record, so reordering alone reports nothing.
+		int32 Pick = 0;
+		for (int32 c = 0; c < Candidates->Num(); ++c)
+		{
+			if (A.Actors[(*Candidates)[c]].Hash == Actor.Hash)
+			{
+				Pick = c;
+				break;
+			}
+		}
+		const int32 Found = (*Candidates)[Pick];
+		Candidates->RemoveAt(Pick, EAllowShrinking::No);
+		Matched[Found] = true;
+		if (A.Actors[Found].Hash != Actor.Hash)
+		{
+			Result.Changed.Add(j);
+		}
+	}
+
+	for (int32 i = 0; i < A.Actors.Num(); ++i)
+	{
+		if (!Matched[i])
+		{
+			Result.Removed.Add(i);
+		}
+	}
+	return Result;
+}
+
+const FString& FAgentForgeWorldSnapshot::GetString(int32 Index) const
+{
+	static const FString Empty;
+	return Strings.IsValidIndex(Index) ? Strings[Index] : Empty;
+}
+
+uint64 FAgentForgeWorldSnapshot::HashActor(const FString& Label, const FString& Class, const FTransformData& Transform)
+{
+	uint64 Hash = CityHash64(reinterpret_cast<const char*>(*Label), Label.Len() * sizeof(TCHAR));
+	Hash = CityHash64WithSeed(reinterpret_cast<const char*>(*Class), Class.Len() * sizeof(TCHAR), Hash);
+	return CityHash64WithSeed(reinterpret_cast<const char*>(&Transform), sizeof(FTransformData), Hash);
+}
+
+void FAgentForgeWorldSnapshot::Serialize(FArchive& Ar)
+{
+	uint32 Magic   = FileMagic;
+	uint32 Version = FileVersion;
+	Ar << Magic << Version;
+	if (Ar.IsLoading() && (Magic != FileMagic || Version != FileVersion))
+	{
+		Ar.SetError();
+		return;
+	}
+
+	int64 Ticks = Timestamp.GetTicks();
+	Ar << Name << Ticks;
+	Ar << Strings;
+
+	int32 NumActors = Actors.Num();
+	Ar << NumActors;
+	if (Ar.IsLoading())
+	{
+		if (Ar.IsError() || NumActors < 0 || NumActors * SerializedRecordBytes > Ar.TotalSize() - Ar.Tell())
+		{
+			Ar.SetError();
+			return;
+		}
+		Timestamp = FDateTime(Ticks);
+		Actors.SetNum(NumActors);
+	}
+
+	for (FActorRecord& Actor : Actors)
+	{
+		Ar << Actor.PathIndex << Actor.LabelIndex << Actor.ClassIndex;
+		Ar << Actor.Transform.Location << Actor.Transform.Rotation << Actor.Transform.Scale;
+		Ar << Actor.Hash;
+	}
+}
+
+TArray<uint8> FAgentForgeWorldSnapshot::ToBytes() const
+{
+	TArray<uint8> Bytes;
+	Bytes.Reserve(64 + Actors.Num() * SerializedRecordBytes);
+	FMemoryWriter Writer(Bytes);
+	const_cast<FAgentForgeWorldSnapshot*>(this)->Serialize(Writer);   // saving does not modify
+	return Bytes;
+}
+
+bool FAgentForgeWorldSnapshot::FromBytes(const TArray<uint8>& Bytes, FString* OutError)
+{
+	FMemoryReader Reader(Bytes);
+	Serialize(Reader);
+	if (Reader.IsError())
+	{
+		if (OutError) { *OutError = TEXT("Not a valid AgentForge snapshot (bad header, version or truncated data)."); }
+		return false;
+	}
+
+	for (const FActorRecord& Actor : Actors)
+	{
+		if (!Strings.IsValidIndex(Actor.PathIndex) || !Strings.IsValidIndex(Actor.LabelIndex) || !Strings.IsValidIndex(Actor.ClassIndex))
+		{
+			if (OutError) { *OutError = TEXT("Snapshot references a string outside its string table."); }
+			return false;
+		}
+	}
+	return true;
+}
+
+TSharedPtr<FJsonObject> FAgentForgeWorldSnapshot::ToJson() const
+{
+	TArray<TSharedPtr<FJsonValue>> ActorArray;
+	ActorArray.Reserve(Actors.Num());
+	for (const FActorRecord& Actor : Actors)
+	{
+		TSharedPtr<FJsonObject> ActorObj = MakeShared<FJsonObject>();
+		ActorObj->SetStringField(TEXT("label"), GetLabel(Actor));
+		ActorObj->SetStringField(TEXT("class"), GetClass(Actor));
+		ActorObj->SetStringField(TEXT("path"),  GetPath(Actor));
+
+		TSharedPtr<FJsonObject> LocObj = MakeShared<FJsonObject>();
+		LocObj->SetNumberField(TEXT("x"), Actor.Transform.Location.X);
+		LocObj->SetNumberField(TEXT("y"), Actor.Transform.Location.Y);
+		LocObj->SetNumberField(TEXT("z"), Actor.Transform.Location.Z);
+		ActorObj->SetObjectField(TEXT("location"), LocObj);
+
+		TSharedPtr<FJsonObject> RotObj = MakeShared<FJsonObject>();
+		RotObj->SetNumberField(TEXT("pitch"), Actor.Transform.Rotation.Pitch);
+		RotObj->SetNumberField(TEXT("yaw"),   Actor.Transform.Rotation.Yaw);
+		RotObj->SetNumberField(TEXT("roll"),  Actor.Transform.Rotation.Roll);
+		ActorObj->SetObjectField(TEXT("rotation"), RotObj);
+
+		TSharedPtr<FJsonObject> ScaleObj = MakeShared<FJsonObject>();
+		ScaleObj->SetNumberField(TEXT("x"), Actor.Transform.Scale.X);
+		ScaleObj->SetNumberField(TEXT("y"), Actor.Transform.Scale.Y);
+		ScaleObj->SetNumberField(TEXT("z"), Actor.Transform.Scale.Z);
+		ActorObj->SetObjectField(TEXT("scale"), ScaleObj);
+
+		ActorObj->SetStringField(TEXT("hash"), FString::Printf(TEXT("%016llx"), Actor.Hash));
+		ActorArray.Add(MakeShared<FJsonValueObject>(ActorObj));
+	}
+
+	TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetStringField(TEXT("snapshot_name"), Name);
+	Root->SetStringField(TEXT("timestamp"),     Timestamp.ToString());
+	Root->SetNumberField(TEXT("actor_count"),   static_cast<double>(Actors.Num()));
+	Root->SetArrayField (TEXT("actors"),        ActorArray);
+	return Root;
+}
+
+bool FAgentForgeWorldSnapshot::FromJson(const TSharedPtr<FJsonObject>& Root, FString* OutError)
+{
+	const TArray<TSharedPtr<FJsonValue>>* ActorArray = nullptr;
+	if (!Root.IsValid() || !Root->TryGetArrayField(TEXT("actors"), ActorArray))
+	{
+		if (OutError) { *OutError = TEXT("Snapshot JSON has no 'actors' array."); }
+		return false;
+	}
+
+	Root->TryGetStringField(TEXT("snapshot_name"), Name);
+	FString TimestampText;
+	if (Root->TryGetStringField(TEXT("timestamp"), TimestampText))
+	{
+		FDateTime::Parse(TimestampText, Timestamp);
+	}
+
+	auto ReadVector = [](const TSharedPtr<FJsonObject>& ActorObj, const TCHAR* Field, const TCHAR* X, const TCHAR* Y, const TCHAR* Z, FVector& InOut)
+	{
+		const TSharedPtr<FJsonObject>* Obj = nullptr;
+		if (ActorObj->TryGetObjectField(Field, Obj))
+		{
+			(*Obj)->TryGetNumberField(X, InOut.X);
+			(*Obj)->TryGetNumberField(Y, InOut.Y);
+			(*Obj)->TryGetNumberField(Z, InOut.Z);
+		}
+	};
+
+	Strings.Reset();
+	Actors.Reset(ActorArray->Num());
+	FStringInterner Interner(Strings);
+	for (const TSharedPtr<FJsonValue>& Value : *ActorArray)
+	{
+		const TSharedPtr<FJsonObject>* ActorObj = nullptr;
+		if (!Value.IsValid() || !Value->TryGetObject(ActorObj)) { continue; }
+
+		FString Label, Class, Path;
+		(*ActorObj)->TryGetStringField(TEXT("label"), Label);
+		(*ActorObj)->TryGetStringField(TEXT("class"), Class);
+		(*ActorObj)->TryGetStringField(TEXT("path"),  Path);
+
+		FVector Location = FVector::ZeroVector;
+		FVector Rotation = FVector::ZeroVector;   // pitch, yaw, roll
+		FVector Scale    = FVector::OneVector;
+		ReadVector(*ActorObj, TEXT("location"), TEXT("x"), TEXT("y"), TEXT("z"), Location);
+		ReadVector(*ActorObj, TEXT("rotation"), TEXT("pitch"), TEXT("yaw"), TEXT("roll"), Rotation);
+		ReadVector(*ActorObj, TEXT("scale"), TEXT("x"), TEXT("y"), TEXT("z"), Scale);
+
+		FActorRecord& Record = Actors.AddDefaulted_GetRef();
+		Record.PathIndex  = Interner.Intern(Path);
+		Record.LabelIndex = Interner.Intern(Label);
+		Record.ClassIndex = Interner.Intern(Class);
+		Record.Transform.Location = Location;
+		Record.Transform.Rotation = FRotator3f(Rotation.X, Rotation.Y, Rotation.Z);
+		Record.Transform.Scale    = FVector3f(Scale);
+		Record.Hash = HashActor(Label, Class, Record.Transform);
+	}
+	return true;
+}
+
+// ============================================================================
+// Store
+// ============================================================================
+
+FAgentForgeSnapshotStore& FAgentForgeSnapshotStore::Get()
+{
+	static FAgentForgeSnapshotStore Instance;
+	return Instance;
+}
+
+FString FAgentForgeSnapshotStore::GetDirectory()
+{
+	return FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir() / TEXT("AgentForgeSnapshots"));
+}
+
+FString FAgentForgeSnapshotStore::Write(FAgentForgeWorldSnapshotPtr Snapshot, bool bExportJson, FString* OutJsonPath)
+{
+	if (!Snapshot.IsValid()) { return FString(); }
+
+	const FString Dir = GetDirectory();
+	IFileManager::Get().MakeDirectory(*Dir, true);
+
+	const FString SafeName = Snapshot->Name.IsEmpty() ? FString(TEXT("snapshot")) : Snapshot->Name;
+	const FString BasePath = Dir / FString::Printf(TEXT("%s_%s"), *SafeName, *Snapshot->Timestamp.ToString(TEXT("%Y%m%d_%H%M%S")));
+	const FString Path     = BasePath + TEXT(".afsnap");
+	const FString JsonPath = BasePath + TEXT(".json");
+
+	{
+		FScopeLock ScopeLock(&Lock);
+		Pending.Add(Path, Snapshot);
+		++PendingWrites;
+		if (bExportJson)
+		{
+			Pending.Add(JsonPath, Snapshot);
+			++PendingWrites;
+		}
+	}
+
+	Async(EAsyncExecution::ThreadPool, [this, Snapshot, Path]()
+	{
+		const double Start = FPlatformTime::Seconds();
+		const TArray<uint8> Bytes = Snapshot->ToBytes();
+		const bool bSaved = FFileHelper::SaveArrayToFile(Bytes, *Path);
+		FinishWrite(Path, Snapshot, bSaved, Bytes.Num(), FPlatformTime::Seconds() - Start, false);
+	});
+
+	if (bExportJson)
+	{
+		Async(EAsyncExecution::ThreadPool, [this, Snapshot, JsonPath]()
+		{
+			const double Start = FPlatformTime::Seconds();
+			FString JsonStr;
+			TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonStr);
+			FJsonSerializer::Serialize(Snapshot->ToJson().ToSharedRef(), Writer);
+			const bool bSaved = FFileHelper::SaveStringToFile(JsonStr, *JsonPath);
+			FinishWrite(JsonPath, Snapshot, bSaved, JsonStr.Len(), FPlatformTime::Seconds() - Start, true);
+		});
+		if (OutJsonPath) { *OutJsonPath = JsonPath; }
+	}
+
+	return Path;
+}
+
+void FAgentForgeSnapshotStore::FinishWrite(const FString& Path, const FAgentForgeWorldSnapshotPtr& Snapshot, bool bSucceeded, int64 Bytes, double Seconds, bool bJson)
+{
+	if (!bSucceeded)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[UEAgentForge] Failed to write snapshot: %s"), *Path);
+	}
+
+	FScopeLock ScopeLock(&Lock);
+	// A newer snapshot with the same name and second owns the entry now.
+	const FAgentForgeWorldSnapshotPtr* Entry = Pending.Find(Path);
+	if (Entry && *Entry == Snapshot)
+	{
+		Pending.Remove(Path);
+	}
+	--PendingWrites;
+	if (bSucceeded)
+	{
+		++Written;
+		BytesWritten += Bytes;
+		LastWriteSeconds = Seconds;
+		if (bJson) { ++JsonExports; }
+	}
+	else
+	{
+		++WriteErrors;
+	}
+}
+
+FAgentForgeWorldSnapshotPtr FAgentForgeSnapshotStore::Load(const FString& Path, FString* OutError)
+{
+	const FString FullPath = FPaths::ConvertRelativePathToFull(Path);
+	{
+		FScopeLock ScopeLock(&Lock);
+		if (const FAgentForgeWorldSnapshotPtr* Found = Pending.Find(FullPath))
+		{
+			return *Found;
+		}
+	}
+
+	TSharedPtr<FAgentForgeWorldSnapshot, ESPMode::ThreadSafe> Snapshot = MakeShared<FAgentForgeWorldSnapshot, ESPMode::ThreadSafe>();
+	if (FPaths::GetExtension(FullPath).Equals(TEXT("json"), ESearchCase::IgnoreCase))
+	{
+		FString JsonStr;
+		TSharedPtr<FJsonObject> Root;
+		if (!FFileHelper::LoadFileToString(JsonStr, *FullPath))
+		{
+			if (OutError) { *OutError = FString::Printf(TEXT("Cannot read snapshot: %s"), *FullPath); }
+			return nullptr;
+		}
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonStr);
+		if (!FJsonSerializer::Deserialize(Reader, Root) || !Snapshot->FromJson(Root, OutError))
+		{
+			if (OutError && OutError->IsEmpty()) { *OutError = FString::Printf(TEXT("Invalid snapshot JSON: %s"), *FullPath); }
+			return nullptr;
+		}
+		return Snapshot;
+	}
+
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *FullPath))
+	{
+		if (OutError) { *OutError = FString::Printf(TEXT("Cannot read snapshot: %s"), *FullPath); }
+		return nullptr;
+	}
+	if (!Snapshot->FromBytes(Bytes, OutError))
+	{
+		return nullptr;
+	}
+	return Snapshot;
+}
+
+void FAgentForgeSnapshotStore::Flush()
+{
+	for (;;)
+	{
+		{
+			FScopeLock ScopeLock(&Lock);
+			if (PendingWrites <= 0) { return; }
+		}
+		FPlatformProcess::Sleep(0.001f);
+	}
+}
+
+TSharedPtr<FJsonObject> FAgentForgeSnapshotStore::GetStatsJson() const
+{
+	FScopeLock ScopeLock(&Lock);
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetNumberField(TEXT("written"),       static_cast<double>(Written));
+	Obj->SetNumberField(TEXT("pending"),       PendingWrites);
+	Obj->SetNumberField(TEXT("write_errors"),  static_cast<double>(WriteErrors));
+	Obj->SetNumberField(TEXT("bytes_written"), static_cast<double>(BytesWritten));
+	Obj->SetNumberField(TEXT("last_write_ms"), LastWriteSeconds * 1000.0);
+	Obj->SetNumberField(TEXT("json_exports"),  static_cast<double>(JsonExports));
+	return Obj;
+}
@@ -0,0 +1,297 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeWorldStats.cpp — per-actor contributions, delta application, live light reads.
+
+#include "AgentForgeWorldStats.h"
+
+#include "AgentForgeActorIndex.h"
+#include "AgentForgeInstancedScatter.h"
+#include "Components/ExponentialHeightFogComponent.h"
+#include "Components/LightComponent.h"
+#include "Components/PointLightComponent.h"
+#include "Engine/DirectionalLight.h"
+#include "Engine/ExponentialHeightFog.h"
+#include "Engine/Light.h"
+#include "Engine/PointLight.h"
+#include "Engine/SkyLight.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/PlayerStart.h"
+#include "HAL/PlatformTime.h"
+#include "NavMesh/NavMeshBoundsVolume.h"
+
+#if WITH_EDITOR
+#include "Editor.h"
+#endif
+
+namespace
+{
+	static UWorld* GetStatsEditorWorld()
+	{
+#if WITH_EDITOR
+		return GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+#else
+		return nullptr;
+#endif
+	}
+}
+
+FAgentForgeWorldStats& FAgentForgeWorldStats::Get()
+{
+	static FAgentForgeWorldStats Instance;
+	return Instance;
+}
+
+FAgentForgeWorldStats::FContribution FAgentForgeWorldStats::Describe(AActor* Actor)
+{
+	FContribution C;
+	C.Actor = Actor;
+	C.Components = Actor->GetComponents().Num();
+
+	// Composition buckets, as analyze_level_composition names them.
+	const FString ClassName = Actor->GetClass()->GetName();
+	if (ClassName.Contains(TEXT("StaticMesh"))    ||
+	    ClassName.Contains(TEXT("Brush"))          ||
+	    ClassName.Contains(TEXT("Landscape")))     { C.Flags |= Flag_Static; }
+	else if (ClassName.Contains(TEXT("Light"))    ||
+	         ClassName.Contains(TEXT("Sky")))      { C.Flags |= Flag_LightBucket; }
+	else if (ClassName.Contains(TEXT("Character"))||
+	         ClassName.Contains(TEXT("AI"))        ||
+	         ClassName.Contains(TEXT("Warden")))   { C.Flags |= Flag_AI; }
+	else                                           { C.Flags |= Flag_Other; }
+
+	if (Actor->IsA<APointLight>())           { C.Flags |= Flag_PointLight; }
+	if (Actor->IsA<ALight>())                { C.Flags |= Flag_Light; }
+	if (Actor->IsA<ASkyLight>())             { C.Flags |= Flag_SkyLight; }
+	if (Actor->IsA<AExponentialHeightFog>()) { C.Flags |= Flag_Fog; }
+	if (Actor->IsA<APlayerStart>())          { C.Flags |= Flag_PlayerStart; }
+	if (Actor->IsA<ANavMeshBoundsVolume>())  { C.Flags |= Flag_NavMesh; }
+
+#if WITH_EDITOR
+	const FString Label = Actor->GetActorLabel();
+	if (Actor->IsA<AStaticMeshActor>() && Label.StartsWith(TEXT("Prop_"))) { C.Flags |= Flag_PropMesh; }
+	if (Label.StartsWith(TEXT("Prop_Instances_")))                         { C.Flags |= Flag_PropInstances; }
+#endif
+	return C;
+}
+
+void FAgentForgeWorldStats::FTally::Add(AActor* Actor)
+{
+	const FString Path = Actor->GetPathName();
+	Remove(Path);
+
+	const FContribution C = Describe(Actor);
+	for (int32 Bit = 0; Bit < NumFlags; ++Bit)
+	{
+		FlagCounts[Bit] += (C.Flags >> Bit) & 1;
+	}
+	Components += C.Components;
+	if (C.Flags & (Flag_Light | Flag_Fog | Flag_PropInstances))
+	{
+		Live.Add(C.Actor);
+	}
+	ByPath.Add(Path, C);
+}
+
+void FAgentForgeWorldStats::FTally::Remove(const FString& Path)
+{
+	FContribution C;
+	if (!ByPath.RemoveAndCopyValue(Path, C))
+	{
+		return;
+	}
+	for (int32 Bit = 0; Bit < NumFlags; ++Bit)
+	{
+		FlagCounts[Bit] -= (C.Flags >> Bit) & 1;
+	}
+	Components -= C.Components;
+	Live.Remove(C.Actor);
+}
+
+void FAgentForgeWorldStats::FTally::Reset()
+{
+	ByPath.Reset();
+	Live.Reset();
+	FMemory::Memzero(FlagCounts);
+	Components = 0;
+}
+
+void FAgentForgeWorldStats::Scan(UWorld* World, FTally& Out)
+{
+	Out.Reset();
+	for (TActorIterator<AActor> It(World); It; ++It)
+	{
+		if (*It && IsValid(*It) && !(*It)->IsActorBeingDestroyed())
+		{
+			Out.Add(*It);
+		}
+	}
+}
+
+void FAgentForgeWorldStats::Rebuild(UWorld* World, int64 Revision)
+{
+	const double StartSeconds = FPlatformTime::Seconds();
+	Scan(World, Cached);
+	CachedWorld = World;
+	CachedRevision = Revision;
+	bValid = true;
+	++Rebuilds;
+	LastRebuildMs = (FPlatformTime::Seconds() - StartSeconds) * 1000.0;
+}
+
+FAgentForgeWorldStats::FStats FAgentForgeWorldStats::Gather(UWorld* World)
+{
+	check(IsInGameThread());
+	++Gathers;
+	if (!World)
+	{
+		return FStats();
+	}
+
+	const bool bEditorWorld = World == GetStatsEditorWorld();
+	FAgentForgeActorIndex& ActorIndex = FAgentForgeActorIndex::Get();
+	const int64 Revision = bEditorWorld ? ActorIndex.GetRevision() : 0;
+	if (Revision == 0)
+	{
+		// Untracked world: one pass, nothing kept.
+		++FullScans;
+		FTally Once;
+		Scan(World, Once);
+		return Compose(Once, bEditorWorld);
+	}
+
+	if (!bValid || CachedWorld.Get() != World)
+	{
+		Rebuild(World, Revision);
+	}
+	else if (Revision == CachedRevision)
+	{
+		++CacheHits;
+	}
+	else
+	{
+		FAgentForgeActorIndex::FWorldDelta Delta;
+		if (!ActorIndex.GetChangesSince(CachedRevision, Delta))
+		{
+			Rebuild(World, ActorIndex.GetRevision());
+		}
+		else
+		{
+			for (const FAgentForgeActorIndex::FRemovedActor& Removed : Delta.Removed)
+			{
+				Cached.Remove(Removed.Path);
+			}
+			auto Apply = [this](AActor* Actor)
+			{
+				if (Actor && IsValid(Actor) && !Actor->IsActorBeingDestroyed())
+				{
+					Cached.Add(Actor);
+				}
+				else if (Actor)
+				{
+					Cached.Remove(Actor->GetPathName());
+				}
+			};
+			for (AActor* Actor : Delta.Added)    { Apply(Actor); }
+			for (AActor* Actor : Delta.Modified) { Apply(Actor); }
+
+			ActorsUpdated += Delta.Added.Num() + Delta.Modified.Num() + Delta.Removed.Num();
+			CachedRevision = Delta.Revision;
+			++IncrementalUpdates;
+		}
+	}
+	return Compose(Cached, bEditorWorld);
+}
+
+FAgentForgeWorldStats::FStats FAgentForgeWorldStats::Compose(const FTally& Tally, bool bEditorWorld)
+{
+	auto Count = [&Tally](EActorFlag Flag)
+	{
+		return Tally.FlagCounts[FMath::FloorLog2(static_cast<uint32>(Flag))];
+	};
+
+	FStats S;
+	S.Actors         = Tally.ByPath.Num();
+	S.Components     = Tally.Components;
+	S.StaticActors   = Count(Flag_Static);
+	S.LightActors    = Count(Flag_LightBucket);
+	S.AIActors       = Count(Flag_AI);
+	S.OtherActors    = Count(Flag_Other);
+	S.PointLights    = Count(Flag_PointLight);
+	S.PlayerStarts   = Count(Flag_PlayerStart);
+	S.NavMeshVolumes = Count(Flag_NavMesh);
+	S.Props          = Count(Flag_PropMesh);
+	S.bHasSkyLight   = Count(Flag_SkyLight) > 0;
+
+	// Light, fog and instance values are read now, not at insert time.
+	for (const TWeakObjectPtr<AActor>& Weak : Tally.Live)
+	{
+		AActor* Actor = Weak.Get();
+		if (!Actor)
+		{
+			continue;
+		}
+		if (const ALight* Light = Cast<ALight>(Actor))
+		{
+			if (Light->IsA<ADirectionalLight>())
+			{
+				S.bHasDirectionalLight = true;
+				continue;
+			}
+			const ULightComponent* LC = Light->GetLightComponent();
+			if (!LC)
+			{
+				continue;
+			}
+			++S.Lights;
+			S.LightIntensitySum += LC->Intensity;
+			S.LightIntensityMax  = FMath::Max(S.LightIntensityMax, LC->Intensity);
+			S.LightColorSum     += FLinearColor(LC->LightColor) * (LC->Intensity / 10000.f);
+			if (Light->IsA<APointLight>())
+			{
+				if (const UPointLightComponent* PLC = Cast<UPointLightComponent>(LC))
+				{
+					++S.PointLightComponents;
+					S.PointLightIntensity += PLC->Intensity;
+				}
+			}
+		}
+		else if (const AExponentialHeightFog* Fog = Cast<AExponentialHeightFog>(Actor))
+		{
+			if (!S.bHasFog)
+			{
+				if (const UExponentialHeightFogComponent* FC = Fog->GetComponent())
+				{
+					S.bHasFog = true;
+					S.FogDensity = FC->FogDensity;
+				}
+			}
+		}
+#if WITH_EDITOR
+		if (Actor->GetActorLabel().StartsWith(TEXT("Prop_Instances_")))
+		{
+			S.Props += FAgentForgeInstancedScatter::CountInstances(Actor);
+		}
+#endif
+	}
+
+	if (bEditorWorld)
+	{
+		S.Bounds = FAgentForgeActorIndex::Get().GetLevelBounds();
+	}
+	return S;
+}
+
+TSharedPtr<FJsonObject> FAgentForgeWorldStats::GetStatsJson() const
+{
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetNumberField(TEXT("gathers"),             (double)Gathers);
+	Obj->SetNumberField(TEXT("cache_hits"),          (double)CacheHits);
+	Obj->SetNumberField(TEXT("incremental_updates"), (double)IncrementalUpdates);
+	Obj->SetNumberField(TEXT("actors_updated"),      (double)ActorsUpdated);
+	Obj->SetNumberField(TEXT("rebuilds"),            (double)Rebuilds);
+	Obj->SetNumberField(TEXT("full_scans"),          (double)FullScans);
+	Obj->SetNumberField(TEXT("actors"),              Cached.ByPath.Num());
+	Obj->SetNumberField(TEXT("last_rebuild_ms"),     LastRebuildMs);
+	return Obj;
+}
@@ -5,6 +5,7 @@
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
 #include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
 
 UConstitutionParser* UConstitutionParser::Singleton = nullptr;
 
@@ -57,6 +58,10 @@ int32 UConstitutionParser::LoadConstitution(const FString& MarkdownFilePath)
 {
 	Rules.Empty();
 	LoadedFilePath.Empty();
+	MatcherNodes.Empty();
+
+	// Read the timestamp before the contents so a write landing in between is picked up on the next check.
+	const FDateTime FileTimestamp = IFileManager::Get().GetTimeStamp(*MarkdownFilePath);
 
 	TArray<FString> Lines;
 	if (!FFileHelper::LoadFileToStringArray(Lines, *MarkdownFilePath))
@@ -111,12 +116,133 @@ int32 UConstitutionParser::LoadConstitution(const FString& MarkdownFilePath)
 
 	if (Rules.Num() > 0)
 	{
-		LoadedFilePath = MarkdownFilePath;
+		LoadedFilePath      = MarkdownFilePath;
+		LoadedFileTimestamp = FileTimestamp;
+		LastReloadCheck     = FPlatformTime::Seconds();
 	}
 
+	BuildMatcher();
 	return Rules.Num();
 }
 
+// ============================================================================
+bool UConstitutionParser::ReloadIfChanged()
+{
+	if (LoadedFilePath.IsEmpty())
+	{
+		return false;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	if (Now - LastReloadCheck < ReloadCheckIntervalSeconds)
+	{
+		return false;
+	}
+	LastReloadCheck = Now;
+
+	const FDateTime Timestamp = IFileManager::Get().GetTimeStamp(*LoadedFilePath);
+	if (Timestamp == FDateTime::MinValue() || Timestamp == LoadedFileTimestamp)
+	{
+		return false;
+	}
+
+	// Keep the current rules if the edited file is unreadable or has no rules yet
+	// (e.g. caught mid-save); the next changed timestamp will try again.
+	TArray<FConstitutionRule> PreviousRules    = Rules;
+	const FString             PreviousPath     = LoadedFilePath;
+	const FDateTime           PreviousTimestamp = LoadedFileTimestamp;
+
+	if (LoadConstitution(PreviousPath) <= 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[UEAgentForge] Constitution reload found no rules, keeping %d previous rules: %s"),
+			PreviousRules.Num(), *PreviousPath);
+		Rules               = MoveTemp(PreviousRules);
+		LoadedFilePath      = PreviousPath;
+		LoadedFileTimestamp = Timestamp;
+		LastReloadCheck     = Now;
+		BuildMatcher();
+		return false;
+	}
+
+	++ReloadCount;
+	UE_LOG(LogTemp, Log, TEXT("[UEAgentForge] Constitution reloaded (%d rules): %s"), Rules.Num(), *LoadedFilePath);
+	return true;
+}
+
+// ============================================================================
+void UConstitutionParser::BuildMatcher()
+{
+	MatcherNodes.Empty();
+	if (Rules.Num() == 0)
+	{
+		return;
+	}
+	MatcherNodes.AddDefaulted();
+
+	// Trie of every lowercased keyword; the terminal state records the owning rule.
+	for (int32 RuleIndex = 0; RuleIndex < Rules.Num(); ++RuleIndex)
+	{
+		for (const FString& Keyword : Rules[RuleIndex].TriggerKeywords)
+		{
+			const FString KeywordLower = Keyword.ToLower();
+			if (KeywordLower.IsEmpty())
+			{
+				continue;
+			}
+
+			int32 State = 0;
+			for (const TCHAR C : KeywordLower)
+			{
+				const int32* NextState = MatcherNodes[State].Next.Find(C);
+				if (NextState)
+				{
+					State = *NextState;
+				}
+				else
+				{
+					const int32 NewState = MatcherNodes.AddDefaulted();
+					MatcherNodes[State].Next.Add(C, NewState);
+					State = NewState;
+				}
+			}
+			MatcherNodes[State].Matches.AddUnique(RuleIndex);
+		}
+	}
+
+	// Breadth-first fail links. A state inherits the matches of its fail state,
+	// so a scan only has to look at the state it lands on.
+	TArray<int32> Queue;
+	for (const TPair<TCHAR, int32>& Pair : MatcherNodes[0].Next)
+	{
+		MatcherNodes[Pair.Value].Fail = 0;
+		Queue.Add(Pair.Value);
+	}
+
+	for (int32 Head = 0; Head < Queue.Num(); ++Head)
+	{
+		const int32 State = Queue[Head];
+		for (const TPair<TCHAR, int32>& Pair : MatcherNodes[State].Next)
+		{
+			const TCHAR C     = Pair.Key;
+			const int32 Child = Pair.Value;
+
+			int32 Fallback = MatcherNodes[State].Fail;
+			while (Fallback != 0 && !MatcherNodes[Fallback].Next.Contains(C))
+			{
+				Fallback = MatcherNodes[Fallback].Fail;
+			}
+			const int32* Target = MatcherNodes[Fallback].Next.Find(C);
+			MatcherNodes[Child].Fail = (Target && *Target != Child) ? *Target : 0;
+
+			for (const int32 RuleIndex : MatcherNodes[MatcherNodes[Child].Fail].Matches)
+			{
+				MatcherNodes[Child].Matches.AddUnique(RuleIndex);
+			}
+			Queue.Add(Child);
+		}
+	}
+}
+
 // ============================================================================
 FConstitutionRule UConstitutionParser::ParseBulletLine(const FString& Line, int32 RuleIndex) const
 {
@@ -191,27 +317,42 @@ TArray<FString> UConstitutionParser::ExtractKeywords(const FString& Description)
 bool UConstitutionParser::ValidateAction(const FString& ActionDesc, TArray<FString>& OutViolations) const
 {
 	OutViolations.Empty();
+	if (MatcherNodes.Num() == 0)
+	{
+		return true;
+	}
+
+	// One pass over the action text finds every rule with a keyword in it.
 	const FString ActionLower = ActionDesc.ToLower();
+	TBitArray<> Matched(false, Rules.Num());
 
-	for (const FConstitutionRule& Rule : Rules)
+	int32 State = 0;
+	for (const TCHAR C : ActionLower)
 	{
-		for (const FString& Keyword : Rule.TriggerKeywords)
+		const int32* NextState = MatcherNodes[State].Next.Find(C);
+		while (!NextState && State != 0)
 		{
-			if (ActionLower.Contains(Keyword.ToLower()))
-			{
-				const FString Violation = FString::Printf(
-					TEXT("[%s] %s"), *Rule.RuleId, *Rule.Description);
-				OutViolations.AddUnique(Violation);
-				break; // One violation report per rule
-			}
+			State     = MatcherNodes[State].Fail;
+			NextState = MatcherNodes[State].Next.Find(C);
+		}
+		State = NextState ? *NextState : 0;
+
+		for (const int32 RuleIndex : MatcherNodes[State].Matches)
+		{
+			Matched[RuleIndex] = true;
 		}
 	}
 
-	// Return true only if no blocking violations
-	for (const FString& V : OutViolations)
+	// Report in rule order, one violation per rule.
+	for (int32 RuleIndex = 0; RuleIndex < Rules.Num(); ++RuleIndex)
 	{
-		// All violations are blocking in this version
-		return false;
+		if (Matched[RuleIndex])
+		{
+			const FConstitutionRule& Rule = Rules[RuleIndex];
+			OutViolations.AddUnique(FString::Printf(TEXT("[%s] %s"), *Rule.RuleId, *Rule.Description));
+		}
 	}
-	return true;
+
+	// All violations are blocking in this version
+	return OutViolations.Num() == 0;
 }
@@ -1,6 +1,10 @@
 // Copyright UEAgentForge Project. All Rights Reserved.
 
 #include "DataAccessModule.h"
+#include "AgentForgeActorIndex.h"
+#include "AgentForgeJobManager.h"
+#include "AgentForgeWorldStats.h"
+#include "AgentForgeResponseWriter.h"
 #include "Dom/JsonObject.h"
 #include "Dom/JsonValue.h"
 #include "Serialization/JsonSerializer.h"
@@ -22,6 +26,8 @@
 #include "Engine/SkyLight.h"
 #include "Engine/ExponentialHeightFog.h"
 #include "GameFramework/Pawn.h"          // APawn — required for IsA<APawn>()
+#include "Misc/Paths.h"
+#include "Visual/SceneCapture.h"
 #include "UnrealClient.h"  // FScreenshotRequest is in UnrealClient in UE 5.7 (not Misc/ScreenshotRequest.h)
 
 #if WITH_EDITOR
@@ -57,16 +63,37 @@ static FString ErrResp(const FString& Msg)
 	return ToJsonStr(O);
 }
 
+// Preset angles: Name, camera offset from centre, rotation (Pitch,Yaw,Roll).
+struct FMultiViewPreset { FString Name; FVector Offset; FRotator Rot; };
 
-// ─── GetMultiViewCapture ──────────────────────────────────────────────────────
+static TArray<FMultiViewPreset> MakeMultiViewPresets(float Radius)
+{
+	return {
+		{ TEXT("top"),     FVector(   0,     0, Radius),  FRotator(-89.f, 0.f, 0.f) },
+		{ TEXT("front"),   FVector(-Radius,  0, Radius * 0.3f), FRotator(-15.f,   0.f, 0.f) },
+		{ TEXT("side"),    FVector(   0, -Radius, Radius * 0.3f), FRotator(-15.f,  90.f, 0.f) },
+		{ TEXT("tension"), FVector(-Radius * 0.5f, 0, Radius * 0.07f), FRotator(-5.f, 0.f, 0.f) },
+	};
+}
 
-FString FDataAccessModule::GetMultiViewCapture(const TSharedPtr<FJsonObject>& Args)
+static float MultiViewRadius(const TSharedPtr<FJsonObject>& Args)
 {
-#if WITH_EDITOR
-	UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
-	if (!World) { return ErrResp(TEXT("No editor world")); }
+	return Args && Args->HasField(TEXT("orbit_radius"))
+	     ? (float)Args->GetNumberField(TEXT("orbit_radius")) : 3000.f;
+}
 
-	// Determine orbit centre: explicit args or level bounding box centre.
+static FString MultiViewAngle(const TSharedPtr<FJsonObject>& Args)
+{
+	return Args && Args->HasField(TEXT("angle"))
+	     ? Args->GetStringField(TEXT("angle")) : TEXT("top");
+}
+
+
+// ─── GetMultiViewCapture ──────────────────────────────────────────────────────
+
+FVector FDataAccessModule::ComputeMultiViewCentre(UWorld* World, const TSharedPtr<FJsonObject>& Args)
+{
+	// Explicit args or level bounding box centre.
 	FVector Centre = ComputeLevelCenter(World);
 	if (Args)
 	{
@@ -74,24 +101,126 @@ FString FDataAccessModule::GetMultiViewCapture(const TSharedPtr<FJsonObject>& Ar
 		if (Args->HasField(TEXT("center_y"))) { Centre.Y = Args->GetNumberField(TEXT("center_y")); }
 		if (Args->HasField(TEXT("center_z"))) { Centre.Z = Args->GetNumberField(TEXT("center_z")); }
 	}
-	const float Radius  = Args && Args->HasField(TEXT("orbit_radius"))
-	                    ? (float)Args->GetNumberField(TEXT("orbit_radius")) : 3000.f;
+	return Centre;
+}
 
-	// Preset angles: Name, camera offset from centre, rotation (Pitch,Yaw,Roll).
-	struct FPreset { FString Name; FVector Offset; FRotator Rot; };
-	const TArray<FPreset> Presets = {
-		{ TEXT("top"),     FVector(   0,     0, Radius),  FRotator(-89.f, 0.f, 0.f) },
-		{ TEXT("front"),   FVector(-Radius,  0, Radius * 0.3f), FRotator(-15.f,   0.f, 0.f) },
-		{ TEXT("side"),    FVector(   0, -Radius, Radius * 0.3f), FRotator(-15.f,  90.f, 0.f) },
-		{ TEXT("tension"), FVector(-Radius * 0.5f, 0, Radius * 0.07f), FRotator(-5.f, 0.f, 0.f) },
+TSharedRef<FAgentForgeJob> FDataAccessModule::MakeMultiViewCaptureJob(const TSharedPtr<FJsonObject>& Args)
+{
+	TSharedRef<FAgentForgeJob> Job = MakeShared<FAgentForgeJob>(TEXT("get_multi_view_capture"));
+#if WITH_EDITOR
+	const bool bRender = Args && Args->HasField(TEXT("render")) && Args->GetBoolField(TEXT("render"));
+	if (!bRender)
+	{
+		// Moving the viewport and queuing a screenshot is one short step.
+		Job->AddStage(TEXT("capture"), [Args](FAgentForgeJob& J)
+		{
+			J.Finish(GetMultiViewCapture(Args));
+			return true;
+		});
+		return Job;
+	}
+
+	struct FMultiViewRun
+	{
+		TUniquePtr<FSceneCaptureRun>   Capture;
+		FString                        AngleName;
+		TArray<TSharedPtr<FJsonValue>> AngleArr;
 	};
+	TSharedRef<FMultiViewRun> Run = MakeShared<FMultiViewRun>();
+
+	// render=true: SceneCapture2D passes into Saved/AgentForgeCaptures, viewport untouched.
+	// angle=all renders every preset in one batch. The readbacks are polled
+	// once per slice, so the stage yields while the GPU copies land.
+	Job->AddStage(TEXT("render"), [Run, Args](FAgentForgeJob& J)
+	{
+		if (!Run->Capture.IsValid())
+		{
+			UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+			if (!World) { J.Finish(ErrResp(TEXT("No editor world"))); return true; }
+
+			const FVector Centre = ComputeMultiViewCentre(World, Args);
+			Run->AngleName = MultiViewAngle(Args);
+			TArray<FTransform> Cameras;
+			for (const FMultiViewPreset& P : MakeMultiViewPresets(MultiViewRadius(Args)))
+			{
+				if (Run->AngleName == TEXT("all") || P.Name == Run->AngleName)
+				{
+					Cameras.Add(FTransform(P.Rot, Centre + P.Offset));
+					Run->AngleArr.Add(MakeShared<FJsonValueString>(P.Name));
+				}
+			}
+			if (Cameras.Num() == 0) { J.Finish(ErrResp(FString::Printf(TEXT("Unknown angle '%s'"), *Run->AngleName))); return true; }
+
+			FSceneCaptureSettings Settings;
+			Settings.BaseName = TEXT("multiview_") + Run->AngleName;
+			if (Args->HasField(TEXT("width")))  { Settings.Width = (int32)Args->GetNumberField(TEXT("width")); }
+			if (Args->HasField(TEXT("height"))) { Settings.Height = (int32)Args->GetNumberField(TEXT("height")); }
+			if (Args->HasField(TEXT("fov")))    { Settings.FOVDegrees = (float)Args->GetNumberField(TEXT("fov")); }
+
+			const FString OutputDir = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("AgentForgeCaptures"));
+			Run->Capture = MakeUnique<FSceneCaptureRun>(World, Cameras, OutputDir, Settings);
+		}
+
+		switch (Run->Capture->Poll())
+		{
+		case FSceneCaptureRun::EStatus::Pending:
+			J.SetStageProgress(Run->Capture->GetProgress());
+			J.YieldSlice();
+			return false;
+		case FSceneCaptureRun::EStatus::Failed:
+			J.Finish(ErrResp(Run->Capture->GetError()));
+			return true;
+		default:
+			return true;
+		}
+	});
+
+	Job->SetFinalizer([Run](FAgentForgeJob&) -> FString
+	{
+		TArray<TSharedPtr<FJsonValue>> PathArr;
+		for (const FString& Path : Run->Capture->GetImagePaths())
+		{
+			PathArr.Add(MakeShared<FJsonValueString>(FPaths::ConvertRelativePathToFull(Path)));
+		}
+		auto Root = MakeShared<FJsonObject>();
+		Root->SetBoolField(TEXT("ok"), true);
+		Root->SetStringField(TEXT("angle"), Run->AngleName);
+		Root->SetArrayField(TEXT("angles"), Run->AngleArr);
+		Root->SetArrayField(TEXT("image_paths"), PathArr);
+		return ToJsonStr(Root);
+	});
+	Job->SetCancelHandler([Run](FAgentForgeJob&)
+	{
+		Run->Capture.Reset();
+	});
+#else
+	Job->AddStage(TEXT("capture"), [](FAgentForgeJob& J) { J.Finish(ErrResp(TEXT("GetMultiViewCapture requires WITH_EDITOR"))); return true; });
+#endif
+	return Job;
+}
+
+FString FDataAccessModule::GetMultiViewCapture(const TSharedPtr<FJsonObject>& Args)
+{
+#if WITH_EDITOR
+	// Inline, the render job runs every slice back to back; "async":true
+	// submits it so the editor keeps ticking while the GPU copies land.
+	const bool bRender = Args && Args->HasField(TEXT("render")) && Args->GetBoolField(TEXT("render"));
+	if (bRender)
+	{
+		return MakeMultiViewCaptureJob(Args)->RunToCompletion();
+	}
+
+	UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+	if (!World) { return ErrResp(TEXT("No editor world")); }
+
+	const FVector Centre = ComputeMultiViewCentre(World, Args);
+	const TArray<FMultiViewPreset> Presets = MakeMultiViewPresets(MultiViewRadius(Args));
 
 	// Choose requested angle (or all presets info if no angle specified).
-	FString AngleName = Args && Args->HasField(TEXT("angle"))
-	                  ? Args->GetStringField(TEXT("angle")) : TEXT("top");
+	const FString AngleName = MultiViewAngle(Args);
 
-	const FPreset* Chosen = Presets.FindByPredicate(
-		[&AngleName](const FPreset& P){ return P.Name == AngleName; });
+	const FMultiViewPreset* Chosen = Presets.FindByPredicate(
+		[&AngleName](const FMultiViewPreset& P){ return P.Name == AngleName; });
 	if (!Chosen) { return ErrResp(FString::Printf(TEXT("Unknown angle '%s'"), *AngleName)); }
 
 	// Move viewport camera.
@@ -131,7 +260,7 @@ FString FDataAccessModule::GetMultiViewCapture(const TSharedPtr<FJsonObject>& Ar
 
 	// Include the full preset table so the agent knows all available angles.
 	TArray<TSharedPtr<FJsonValue>> PresetArr;
-	for (const FPreset& P : Presets)
+	for (const FMultiViewPreset& P : Presets)
 	{
 		auto PO = MakeShared<FJsonObject>();
 		PO->SetStringField(TEXT("angle"), P.Name);
@@ -150,73 +279,78 @@ FString FDataAccessModule::GetMultiViewCapture(const TSharedPtr<FJsonObject>& Ar
 
 // ─── GetLevelHierarchy ────────────────────────────────────────────────────────
 
-FString FDataAccessModule::GetLevelHierarchy()
+FString FDataAccessModule::GetLevelHierarchy(const TSharedPtr<FJsonObject>& Args)
 {
 #if WITH_EDITOR
 	UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
 	if (!World) { return ErrResp(TEXT("No editor world")); }
 
-	TArray<TSharedPtr<FJsonValue>> ActorArray;
-	int32 ActorCount = 0;
+	// Streamed — the per-actor DOM (bounds, components, tags) dominated the cost
+	// on large levels. actor_count follows the array so it needs no second pass.
+	FAgentForgeResponseWriter Writer(FAgentForgeResponseWriter::EncodingFromArgs(Args), World->GetActorCount() * 700);
+	Writer.WriteObjectStart();
+	Writer.WriteValue(TEXT("ok"), true);
+	Writer.WriteArrayStart(TEXT("actors"));
 
+	int32 ActorCount = 0;
+	TArray<UActorComponent*> Comps;
 	for (TActorIterator<AActor> It(World); It; ++It)
 	{
 		AActor* Actor = *It;
 		if (!Actor || Actor->IsA<AWorldSettings>()) { continue; }
 		++ActorCount;
 
-		auto AO = MakeShared<FJsonObject>();
-		AO->SetStringField(TEXT("label"), Actor->GetActorLabel());
-		AO->SetStringField(TEXT("class"), Actor->GetClass()->GetName());
-		AO->SetBoolField(TEXT("is_visible"), !Actor->IsHidden());
+		Writer.WriteObjectStart();
+		Writer.WriteValue(TEXT("label"), Actor->GetActorLabel());
+		Writer.WriteValue(TEXT("class"), Actor->GetClass()->GetName());
+		Writer.WriteValue(TEXT("is_visible"), !Actor->IsHidden());
 
 		// Parent actor label (folders not tracked here — only attach parent).
 		AActor* ParentActor = Actor->GetAttachParentActor();
-		AO->SetStringField(TEXT("parent"), ParentActor ? ParentActor->GetActorLabel() : TEXT(""));
+		Writer.WriteValue(TEXT("parent"), ParentActor ? ParentActor->GetActorLabel() : FString());
 
 		// Tags.
-		TArray<TSharedPtr<FJsonValue>> TagArr;
+		Writer.WriteArrayStart(TEXT("tags"));
 		for (const FName& Tag : Actor->Tags)
 		{
-			TagArr.Add(MakeShared<FJsonValueString>(Tag.ToString()));
+			Writer.WriteValue(Tag.ToString());
 		}
-		AO->SetArrayField(TEXT("tags"), TagArr);
+		Writer.WriteArrayEnd();
 
 		// Location.
-		AO->SetObjectField(TEXT("location"), VecToObj(Actor->GetActorLocation()));
+		Writer.WriteVector(TEXT("location"), Actor->GetActorLocation());
 
 		// Bounds (world-space box).
 		FVector BoundsOrigin, BoundsExtent;
 		Actor->GetActorBounds(false, BoundsOrigin, BoundsExtent);
-		auto BoundsObj = MakeShared<FJsonObject>();
-		BoundsObj->SetObjectField(TEXT("center"), VecToObj(BoundsOrigin));
-		BoundsObj->SetObjectField(TEXT("extent"), VecToObj(BoundsExtent));
-		BoundsObj->SetObjectField(TEXT("min"), VecToObj(BoundsOrigin - BoundsExtent));
-		BoundsObj->SetObjectField(TEXT("max"), VecToObj(BoundsOrigin + BoundsExtent));
-		AO->SetObjectField(TEXT("bounds"), BoundsObj);
+		Writer.WriteObjectStart(TEXT("bounds"));
+		Writer.WriteVector(TEXT("center"), BoundsOrigin);
+		Writer.WriteVector(TEXT("extent"), BoundsExtent);
+		Writer.WriteVector(TEXT("min"), BoundsOrigin - BoundsExtent);
+		Writer.WriteVector(TEXT("max"), BoundsOrigin + BoundsExtent);
+		Writer.WriteObjectEnd();
 
 		// Components.
-		TArray<TSharedPtr<FJsonValue>> CompArr;
-		TArray<UActorComponent*> Comps;
+		Comps.Reset();
 		Actor->GetComponents(Comps);
+		Writer.WriteArrayStart(TEXT("components"));
 		for (UActorComponent* Comp : Comps)
 		{
 			if (!Comp) { continue; }
-			auto CO = MakeShared<FJsonObject>();
-			CO->SetStringField(TEXT("name"), Comp->GetName());
-			CO->SetStringField(TEXT("class"), Comp->GetClass()->GetName());
-			CompArr.Add(MakeShared<FJsonValueObject>(CO));
+			Writer.WriteObjectStart();
+			Writer.WriteValue(TEXT("name"), Comp->GetName());
+			Writer.WriteValue(TEXT("class"), Comp->GetClass()->GetName());
+			Writer.WriteObjectEnd();
 		}
-		AO->SetArrayField(TEXT("components"), CompArr);
+		Writer.WriteArrayEnd();
 
-		ActorArray.Add(MakeShared<FJsonValueObject>(AO));
+		Writer.WriteObjectEnd();
 	}
 
-	auto Root = MakeShared<FJsonObject>();
-	Root->SetBoolField(TEXT("ok"), true);
-	Root->SetNumberField(TEXT("actor_count"), ActorCount);
-	Root->SetArrayField(TEXT("actors"), ActorArray);
-	return ToJsonStr(Root);
+	Writer.WriteArrayEnd();
+	Writer.WriteValue(TEXT("actor_count"), ActorCount);
+	Writer.WriteObjectEnd();
+	return Writer.Finish();
 #else
 	return ErrResp(TEXT("GetLevelHierarchy requires WITH_EDITOR"));
 #endif
@@ -238,15 +372,7 @@ FString FDataAccessModule::GetDeepProperties(const TSharedPtr<FJsonObject>& Args
 	if (!World) { return ErrResp(TEXT("No editor world")); }
 
 	// Find the actor.
-	AActor* FoundActor = nullptr;
-	for (TActorIterator<AActor> It(World); It; ++It)
-	{
-		if ((*It)->GetActorLabel() == Label || (*It)->GetName() == Label)
-		{
-			FoundActor = *It;
-			break;
-		}
-	}
+	AActor* FoundActor = FAgentForgeActorIndex::Get().FindByLabelOrName(Label);
 	if (!FoundActor)
 	{
 		return ErrResp(FString::Printf(TEXT("Actor '%s' not found"), *Label));
@@ -290,12 +416,47 @@ FString FDataAccessModule::GetDeepProperties(const TSharedPtr<FJsonObject>& Args
 
 // ─── GetSemanticEnvironmentSnapshot ──────────────────────────────────────────
 
-FString FDataAccessModule::GetSemanticEnvironmentSnapshot()
+#if WITH_EDITOR
+static TArray<TSharedPtr<FJsonValue>> LabelsOf(const TArray<AActor*>& Actors)
+{
+	TArray<TSharedPtr<FJsonValue>> Arr;
+	Arr.Reserve(Actors.Num());
+	for (const AActor* Actor : Actors)
+	{
+		Arr.Add(MakeShared<FJsonValueString>(Actor->GetActorLabel()));
+	}
+	return Arr;
+}
+#endif
+
+FString FDataAccessModule::GetSemanticEnvironmentSnapshot(const TSharedPtr<FJsonObject>& Args)
 {
 #if WITH_EDITOR
 	UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
 	if (!World) { return ErrResp(TEXT("No editor world")); }
 
+	// ── since_revision: skip the whole recompute when nothing changed ──
+	FAgentForgeActorIndex::FWorldDelta Delta;
+	bool   bSinceGiven = false;
+	bool   bDelta      = false;
+	double SinceValue  = 0.0;
+	if (Args.IsValid() && Args->TryGetNumberField(TEXT("since_revision"), SinceValue))
+	{
+		bSinceGiven = true;
+		bDelta = FAgentForgeActorIndex::Get().GetChangesSince((int64)SinceValue, Delta);
+		if (bDelta && Delta.Added.Num() == 0 && Delta.Modified.Num() == 0 && Delta.Removed.Num() == 0)
+		{
+			auto Unchanged = MakeShared<FJsonObject>();
+			Unchanged->SetBoolField(TEXT("ok"), true);
+			Unchanged->SetNumberField(TEXT("revision"), (double)Delta.Revision);
+			Unchanged->SetNumberField(TEXT("since_revision"), SinceValue);
+			Unchanged->SetBoolField(TEXT("delta"), true);
+			Unchanged->SetBoolField(TEXT("unchanged"), true);
+			return ToJsonStr(Unchanged);
+		}
+	}
+	const int64 Revision = bSinceGiven ? Delta.Revision : FAgentForgeActorIndex::Get().GetRevision();
+
 	// ── Lighting analysis ──
 	int32 LightCount = 0;
 	float TotalIntensity = 0.f;
@@ -417,6 +578,25 @@ FString FDataAccessModule::GetSemanticEnvironmentSnapshot()
 	Root->SetStringField(TEXT("horror_rating"),
 		HorrorScore >= 70.f ? TEXT("High") :
 		HorrorScore >= 40.f ? TEXT("Medium") : TEXT("Low"));
+	Root->SetNumberField(TEXT("revision"), (double)Revision);
+	if (bSinceGiven)
+	{
+		Root->SetNumberField(TEXT("since_revision"), SinceValue);
+		Root->SetBoolField(TEXT("delta"), bDelta);
+		if (bDelta)
+		{
+			TArray<TSharedPtr<FJsonValue>> RemovedArr;
+			for (const FAgentForgeActorIndex::FRemovedActor& Gone : Delta.Removed)
+			{
+				RemovedArr.Add(MakeShared<FJsonValueString>(Gone.Label.IsEmpty() ? Gone.Name : Gone.Label));
+			}
+			auto ChangesObj = MakeShared<FJsonObject>();
+			ChangesObj->SetArrayField(TEXT("added"),    LabelsOf(Delta.Added));
+			ChangesObj->SetArrayField(TEXT("modified"), LabelsOf(Delta.Modified));
+			ChangesObj->SetArrayField(TEXT("removed"),  RemovedArr);
+			Root->SetObjectField(TEXT("changes"), ChangesObj);
+		}
+	}
 	return ToJsonStr(Root);
 #else
 	return ErrResp(TEXT("GetSemanticEnvironmentSnapshot requires WITH_EDITOR"));
@@ -446,34 +626,13 @@ void FDataAccessModule::GatherLightingStats(UWorld* World,
                                              FLinearColor& OutDominantColor,
                                              bool& bHasDir, bool& bHasSky)
 {
-	OutCount = 0; OutAvg = 0.f; OutMax = 0.f;
-	OutDominantColor = FLinearColor::Black;
-	bHasDir = false; bHasSky = false;
-
-	float TotalIntensity = 0.f;
-	FLinearColor AccColor(0, 0, 0);
-
-	// Check for SkyLight separately (ASkyLight does NOT derive from ALight)
-	for (TActorIterator<ASkyLight> SkyIt(World); SkyIt; ++SkyIt) { bHasSky = true; break; }
-
-	for (TActorIterator<ALight> It(World); It; ++It)
-	{
-		if (Cast<ADirectionalLight>(*It)) { bHasDir = true; continue; }
-
-		if (ULightComponent* LC = (*It)->GetLightComponent())
-		{
-			const float Intensity = LC->Intensity;
-			TotalIntensity += Intensity;
-			OutMax = FMath::Max(OutMax, Intensity);
-			AccColor += FLinearColor(LC->LightColor) * (Intensity / 10000.f);
-			++OutCount;
-		}
-	}
-
-	OutAvg = OutCount > 0 ? TotalIntensity / OutCount : 0.f;
-	if (OutCount > 0)
-	{
-		AccColor /= (float)OutCount;
-		OutDominantColor = AccColor;
-	}
+	// Shared, revision-cached world stats; lights are read live from their components.
+	const FAgentForgeWorldStats::FStats Stats = FAgentForgeWorldStats::Get().Gather(World);
+
+	OutCount = Stats.Lights;
+	OutMax   = Stats.LightIntensityMax;
+	OutAvg   = OutCount > 0 ? Stats.LightIntensitySum / OutCount : 0.f;
+	OutDominantColor = OutCount > 0 ? Stats.LightColorSum / (float)OutCount : FLinearColor::Black;
+	bHasDir  = Stats.bHasDirectionalLight;
+	bHasSky  = Stats.bHasSkyLight;
 }
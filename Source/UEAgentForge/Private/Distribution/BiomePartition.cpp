@@ -3,7 +3,10 @@
 
 #include "Distribution/BiomePartition.h"
 
-#include "Math/RandomStream.h"
+#include "AgentForgeTrace.h"
+#include "Distribution/CounterRng.h"
+
+#include "Async/ParallelFor.h"
 
 namespace
 {
@@ -24,6 +27,35 @@ namespace
 		return Result;
 	}
 
+	// Raster cells per seed; more cells mean shorter candidate lists.
+	static constexpr int32 RasterCellsPerSeed = 16;
+	static constexpr int32 MinRasterCells = 256;
+	static constexpr int32 MaxRasterCells = 65536;
+
+	static void ConsiderSeed(
+		const FBiomePartitionData& Partition,
+		int32 Index,
+		const FVector& Location,
+		int32& OutNearest,
+		int32& OutSecondNearest,
+		float& OutNearestDistSq,
+		float& OutSecondNearestDistSq)
+	{
+		const float DistSq = FVector::DistSquared2D(Partition.Seeds[Index].Position, Location);
+		if (DistSq < OutNearestDistSq)
+		{
+			OutSecondNearestDistSq = OutNearestDistSq;
+			OutSecondNearest = OutNearest;
+			OutNearestDistSq = DistSq;
+			OutNearest = Index;
+		}
+		else if (DistSq < OutSecondNearestDistSq)
+		{
+			OutSecondNearestDistSq = DistSq;
+			OutSecondNearest = Index;
+		}
+	}
+
 	static void FindClosestSeeds(
 		const FBiomePartitionData& Partition,
 		const FVector& Location,
@@ -37,22 +69,27 @@ namespace
 		OutNearestDistSq = TNumericLimits<float>::Max();
 		OutSecondNearestDistSq = TNumericLimits<float>::Max();
 
-		for (int32 Index = 0; Index < Partition.Seeds.Num(); ++Index)
+		// Candidates are stored in seed order, so visiting only them reproduces the full scan.
+		const FBiomeRaster& Raster = Partition.Raster;
+		if (Raster.IsBuilt())
 		{
-			const float DistSq = FVector::DistSquared2D(Partition.Seeds[Index].Position, Location);
-			if (DistSq < OutNearestDistSq)
-			{
-				OutSecondNearestDistSq = OutNearestDistSq;
-				OutSecondNearest = OutNearest;
-				OutNearestDistSq = DistSq;
-				OutNearest = Index;
-			}
-			else if (DistSq < OutSecondNearestDistSq)
+			const int32 CX = FMath::FloorToInt32((Location.X - Raster.Origin.X) * Raster.InvCellSize);
+			const int32 CY = FMath::FloorToInt32((Location.Y - Raster.Origin.Y) * Raster.InvCellSize);
+			if (CX >= 0 && CX < Raster.Width && CY >= 0 && CY < Raster.Height)
 			{
-				OutSecondNearestDistSq = DistSq;
-				OutSecondNearest = Index;
+				const int32 Cell = CY * Raster.Width + CX;
+				for (int32 C = Raster.CellStart[Cell]; C < Raster.CellStart[Cell + 1]; ++C)
+				{
+					ConsiderSeed(Partition, Raster.Candidates[C], Location, OutNearest, OutSecondNearest, OutNearestDistSq, OutSecondNearestDistSq);
+				}
+				return;
 			}
 		}
+
+		for (int32 Index = 0; Index < Partition.Seeds.Num(); ++Index)
+		{
+			ConsiderSeed(Partition, Index, Location, OutNearest, OutSecondNearest, OutNearestDistSq, OutSecondNearestDistSq);
+		}
 	}
 }
 
@@ -63,6 +100,7 @@ FBiomePartitionData FBiomePartition::GenerateVoronoiBiomes(
 	int32 Seed,
 	float BlendDistance)
 {
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Distribution.Biome.GenerateVoronoiBiomes");
 	FBiomePartitionData Partition;
 	Partition.Bounds = Bounds;
 	Partition.BlendDistance = FMath::Max(0.0f, BlendDistance);
@@ -75,23 +113,119 @@ FBiomePartitionData FBiomePartition::GenerateVoronoiBiomes(
 
 	const TArray<FString> ResolvedBiomes = BuildBiomeList(BiomeTypes);
 	const int32 Count = FMath::Clamp(BiomeCount, 1, 256);
+	TArray<int32> ResolvedIds;
+	for (const FString& Name : ResolvedBiomes)
+	{
+		ResolvedIds.Add(Partition.BiomeNames.AddUnique(Name));
+	}
 
-	FRandomStream Rng(Seed);
+	const FCounterRng Rng(Seed, CounterRngStream::BiomeSeeds);
 	Partition.Seeds.Reserve(Count);
 	for (int32 Index = 0; Index < Count; ++Index)
 	{
 		FBiomeSeedPoint Cell;
 		Cell.Position = FVector(
-			Rng.FRandRange(Bounds.Min.X, Bounds.Max.X),
-			Rng.FRandRange(Bounds.Min.Y, Bounds.Max.Y),
+			Rng.FRandRange(FCounterRng::Slot(Index, 0, 2), Bounds.Min.X, Bounds.Max.X),
+			Rng.FRandRange(FCounterRng::Slot(Index, 1, 2), Bounds.Min.Y, Bounds.Max.Y),
 			Bounds.Min.Z);
 		Cell.BiomeType = ResolvedBiomes[Index % ResolvedBiomes.Num()];
+		Cell.BiomeId = ResolvedIds[Index % ResolvedIds.Num()];
 		Partition.Seeds.Add(Cell);
 	}
 
+	BuildRaster(Partition);
 	return Partition;
 }
 
+void FBiomePartition::BuildRaster(FBiomePartitionData& Partition)
+{
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Distribution.Biome.BuildRaster");
+	FBiomeRaster& Raster = Partition.Raster;
+	Raster = FBiomeRaster();
+
+	const int32 NumSeeds = Partition.Seeds.Num();
+	const FVector2D Size(Partition.Bounds.Max.X - Partition.Bounds.Min.X, Partition.Bounds.Max.Y - Partition.Bounds.Min.Y);
+	if (!Partition.Bounds.IsValid || NumSeeds == 0 || NumSeeds > 256 || Size.X <= KINDA_SMALL_NUMBER || Size.Y <= KINDA_SMALL_NUMBER)
+	{
+		return;
+	}
+
+	const int32 TargetCells = FMath::Clamp(NumSeeds * RasterCellsPerSeed, MinRasterCells, MaxRasterCells);
+	Raster.CellSize = FMath::Sqrt(Size.X * Size.Y / (double)TargetCells);
+	Raster.InvCellSize = 1.0 / Raster.CellSize;
+	Raster.Origin = FVector2D(Partition.Bounds.Min.X, Partition.Bounds.Min.Y);
+	Raster.Width = FMath::Clamp(FMath::CeilToInt32(Size.X * Raster.InvCellSize), 1, MaxRasterCells);
+	Raster.Height = FMath::Clamp(FMath::CeilToInt32(Size.Y * Raster.InvCellSize), 1, MaxRasterCells / Raster.Width);
+
+	// A seed is nearest or second nearest somewhere in a cell only if its distance to the
+	// centre is within the centre's second-nearest distance plus the cell diameter.
+	const double HalfDiagonal = Raster.CellSize * UE_HALF_SQRT_2;
+	const double Slack = 2.0 * HalfDiagonal + Raster.CellSize * 1.0e-3;
+	TArray<TArray<uint8>> RowCandidates;
+	TArray<TArray<int32>> RowCounts;
+	RowCandidates.SetNum(Raster.Height);
+	RowCounts.SetNum(Raster.Height);
+	ParallelFor(Raster.Height, [&](int32 Y)
+	{
+		TArray<double> Dist;
+		Dist.SetNumUninitialized(NumSeeds);
+		TArray<uint8>& Candidates = RowCandidates[Y];
+		TArray<int32>& Counts = RowCounts[Y];
+		Counts.SetNumZeroed(Raster.Width);
+		for (int32 X = 0; X < Raster.Width; ++X)
+		{
+			const FVector2D Center = Raster.Origin + FVector2D(X + 0.5, Y + 0.5) * Raster.CellSize;
+			double D0 = TNumericLimits<double>::Max();
+			double D1 = TNumericLimits<double>::Max();
+			for (int32 Index = 0; Index < NumSeeds; ++Index)
+			{
+				const FVector& P = Partition.Seeds[Index].Position;
+				Dist[Index] = FVector2D::Distance(Center, FVector2D(P.X, P.Y));
+				if (Dist[Index] < D0)
+				{
+					D1 = D0;
+					D0 = Dist[Index];
+				}
+				else if (Dist[Index] < D1)
+				{
+					D1 = Dist[Index];
+				}
+			}
+			const double Limit = NumSeeds > 1 ? D1 + Slack : TNumericLimits<double>::Max();
+			for (int32 Index = 0; Index < NumSeeds; ++Index)
+			{
+				if (Dist[Index] <= Limit)
+				{
+					Candidates.Add((uint8)Index);
+					++Counts[X];
+				}
+			}
+		}
+	});
+
+	const int32 NumCells = Raster.Width * Raster.Height;
+	Raster.CellStart.SetNumUninitialized(NumCells + 1);
+	int32 Offset = 0;
+	for (int32 Y = 0; Y < Raster.Height; ++Y)
+	{
+		for (int32 X = 0; X < Raster.Width; ++X)
+		{
+			Raster.CellStart[Y * Raster.Width + X] = Offset;
+			Offset += RowCounts[Y][X];
+		}
+		Raster.Candidates.Append(RowCandidates[Y]);
+	}
+	Raster.CellStart[NumCells] = Offset;
+}
+
+int32 FBiomePartition::FindBiomeId(const FBiomePartitionData& Partition, const FString& Name)
+{
+	return Partition.BiomeNames.IndexOfByPredicate([&Name](const FString& Biome)
+	{
+		return Biome.Equals(Name, ESearchCase::IgnoreCase);
+	});
+}
+
 FString FBiomePartition::SampleBiomeAtLocation(
 	const FBiomePartitionData& Partition,
 	const FVector& Location)
@@ -151,3 +285,39 @@ FBiomeBlendSample FBiomePartition::BlendBiomeEdges(
 
 	return Sample;
 }
+
+FBiomeIdSample FBiomePartition::BlendBiomeIds(
+	const FBiomePartitionData& Partition,
+	const FVector& Location)
+{
+	FBiomeIdSample Sample;
+	if (Partition.Seeds.Num() == 0)
+	{
+		return Sample;
+	}
+
+	int32 Nearest = INDEX_NONE;
+	int32 SecondNearest = INDEX_NONE;
+	float NearestDistSq = 0.0f;
+	float SecondNearestDistSq = 0.0f;
+	FindClosestSeeds(Partition, Location, Nearest, SecondNearest, NearestDistSq, SecondNearestDistSq);
+
+	if (Partition.Seeds.IsValidIndex(Nearest))
+	{
+		Sample.PrimaryBiome = Partition.Seeds[Nearest].BiomeId;
+	}
+	if (Partition.Seeds.IsValidIndex(SecondNearest))
+	{
+		Sample.SecondaryBiome = Partition.Seeds[SecondNearest].BiomeId;
+	}
+
+	if (Sample.SecondaryBiome != INDEX_NONE && Partition.BlendDistance > KINDA_SMALL_NUMBER)
+	{
+		const float D0 = FMath::Sqrt(FMath::Max(0.0f, NearestDistSq));
+		const float D1 = FMath::Sqrt(FMath::Max(0.0f, SecondNearestDistSq));
+		const float EdgeDistance = FMath::Abs(D1 - D0);
+		Sample.BlendAlpha = FMath::Clamp((Partition.BlendDistance - EdgeDistance) / Partition.BlendDistance, 0.0f, 1.0f);
+	}
+
+	return Sample;
+}
@@ -3,16 +3,23 @@
 
 #include "Distribution/Clearings.h"
 
+#include "AgentForgeTrace.h"
+#include "Distribution/CounterRng.h"
 #include "Distribution/DistributionEngine.h"
-#include "Math/RandomStream.h"
+#include "Distribution/PointCloud.h"
+#include "Distribution/SpatialFilters.h"
+
+#include "Async/ParallelFor.h"
 
 TArray<FClearingRegion> FClearings::GenerateClearings(
 	const FBox& Bounds,
 	int32 ClearingCount,
 	float MinRadius,
 	float MaxRadius,
-	int32 Seed)
+	int32 Seed,
+	float MinGap)
 {
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Distribution.Clearings.GenerateClearings");
 	TArray<FClearingRegion> Regions;
 	if (!Bounds.IsValid)
 	{
@@ -35,48 +42,206 @@ TArray<FClearingRegion> FClearings::GenerateClearings(
 		Seed ^ 0x3C6EF35F,
 		FMath::Max(80.0f, MeanRadius * 1.5f));
 
-	FRandomStream Rng(Seed ^ 0x7F4A7C15);
+	const FCounterRng Rng(Seed, CounterRngStream::ClearingRadius);
 	Regions.Reserve(Centers.Num());
-	for (const FVector& Center : Centers)
+	for (int32 Index = 0; Index < Centers.Num(); ++Index)
 	{
 		FClearingRegion Region;
-		Region.Center = Center;
-		Region.Radius = Rng.FRandRange(RadiusLow, RadiusHigh);
+		Region.Center = Centers[Index];
+		Region.Radius = Rng.FRandRange(Index, RadiusLow, RadiusHigh);
 		Regions.Add(Region);
 	}
 
+	if (MinGap >= 0.0f && Regions.Num() > 1)
+	{
+		// Shrink against the clearings already kept, in generation order, so the result is deterministic.
+		const float Reach = 2.0f * RadiusHigh + MinGap;
+		FPointSpatialIndex Kept;
+		Kept.Init(FBox2D(FVector2D(Bounds.Min), FVector2D(Bounds.Max)), Reach, Regions.Num());
+		TArray<FClearingRegion> Separated;
+		Separated.Reserve(Regions.Num());
+		for (FClearingRegion& Region : Regions)
+		{
+			Kept.ForEachWithin(Region.Center, Reach, [&](int32 KeptIndex, float DistSq)
+			{
+				Region.Radius = FMath::Min(Region.Radius, FMath::Sqrt(DistSq) - Separated[KeptIndex].Radius - MinGap);
+				return true;
+			});
+			if (Region.Radius >= 0.5f * RadiusLow)
+			{
+				Kept.Add(Region.Center);
+				Separated.Add(Region);
+			}
+		}
+		Regions = MoveTemp(Separated);
+	}
+
 	return Regions;
 }
 
+float FClearingSdf::Sample(const FVector& Location) const
+{
+	if (!IsValid())
+	{
+		return Band;
+	}
+	const double FX = FMath::Clamp((Location.X - Origin.X) * InvCellSize, 0.0, (double)(Width - 1));
+	const double FY = FMath::Clamp((Location.Y - Origin.Y) * InvCellSize, 0.0, (double)(Height - 1));
+	const int32 X0 = FMath::Min(FMath::FloorToInt32(FX), Width - 1);
+	const int32 Y0 = FMath::Min(FMath::FloorToInt32(FY), Height - 1);
+	const int32 X1 = FMath::Min(X0 + 1, Width - 1);
+	const int32 Y1 = FMath::Min(Y0 + 1, Height - 1);
+	const float Tx = (float)(FX - X0);
+	const float Ty = (float)(FY - Y0);
+	const float A = FMath::Lerp(Distance[Y0 * Width + X0], Distance[Y0 * Width + X1], Tx);
+	const float B = FMath::Lerp(Distance[Y1 * Width + X0], Distance[Y1 * Width + X1], Tx);
+	return FMath::Lerp(A, B, Ty);
+}
+
+FClearingSdf FClearings::BuildClearingSdf(
+	const TArray<FClearingRegion>& Clearings,
+	const FBox& Bounds,
+	const FClearingMaskSettings& Settings,
+	float CellSize)
+{
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Distribution.Clearings.BuildClearingSdf");
+	FClearingSdf Sdf;
+	if (!Bounds.IsValid || Clearings.Num() == 0)
+	{
+		return Sdf;
+	}
+
+	float MinRadius = TNumericLimits<float>::Max();
+	float MaxRadius = 1.0f;
+	TArray<FVector> Centers;
+	Centers.Reserve(Clearings.Num());
+	for (const FClearingRegion& Region : Clearings)
+	{
+		Centers.Add(Region.Center);
+		MinRadius = FMath::Min(MinRadius, FMath::Max(1.0f, Region.Radius));
+		MaxRadius = FMath::Max(MaxRadius, Region.Radius);
+	}
+
+	const FVector2D Size(FMath::Max(1.0, Bounds.Max.X - Bounds.Min.X), FMath::Max(1.0, Bounds.Max.Y - Bounds.Min.Y));
+	double Cell = CellSize > 0.0f ? (double)CellSize : FMath::Max(1.0, 0.25 * MinRadius);
+	const double Nodes = (Size.X / Cell + 1.0) * (Size.Y / Cell + 1.0);
+	if (Nodes > (double)MaxSdfNodes)
+	{
+		Cell *= FMath::Sqrt(Nodes / (double)MaxSdfNodes);
+	}
+	Sdf.Origin = FVector2D(Bounds.Min.X, Bounds.Min.Y);
+	Sdf.CellSize = Cell;
+	Sdf.InvCellSize = 1.0 / Cell;
+	Sdf.Width = FMath::CeilToInt32(Size.X * Sdf.InvCellSize) + 1;
+	Sdf.Height = FMath::CeilToInt32(Size.Y * Sdf.InvCellSize) + 1;
+	Sdf.Band = FMath::Max(Settings.Falloff, 0.0f) + 2.0f * (float)Cell;
+	Sdf.Distance.SetNumUninitialized(Sdf.Width * Sdf.Height);
+
+	// Only clearings whose edge is within Band of a node can beat the clamp.
+	const FPointSpatialIndex CenterIndex(Centers, MaxRadius + Sdf.Band);
+	const float SearchRadius = MaxRadius + Sdf.Band;
+	ParallelFor(Sdf.Height, [&](int32 Y)
+	{
+		for (int32 X = 0; X < Sdf.Width; ++X)
+		{
+			const FVector Node(Sdf.Origin.X + X * Cell, Sdf.Origin.Y + Y * Cell, 0.0);
+			float Best = Sdf.Band;
+			CenterIndex.ForEachWithin(Node, SearchRadius, [&](int32 ClearingIndex, float DistSq)
+			{
+				Best = FMath::Min(Best, FMath::Sqrt(DistSq) - FMath::Max(1.0f, Clearings[ClearingIndex].Radius));
+				return true;
+			});
+			Sdf.Distance[Y * Sdf.Width + X] = Best;
+		}
+	});
+	return Sdf;
+}
+
+float FClearings::KeepFactor(float SignedDistance, const FClearingMaskSettings& Settings)
+{
+	if (SignedDistance > 0.0f)
+	{
+		return 1.0f;
+	}
+	const float Inner = FMath::Clamp(Settings.InnerDensity, 0.0f, 1.0f);
+	if (Settings.Falloff <= KINDA_SMALL_NUMBER)
+	{
+		return Inner;
+	}
+	const float Depth = FMath::Clamp(-SignedDistance / Settings.Falloff, 0.0f, 1.0f);
+	return FMath::Lerp(1.0f, Inner, FMath::SmoothStep(0.0f, 1.0f, Depth));
+}
+
 TArray<FVector> FClearings::ApplyClearingMask(
 	const TArray<FVector>& Points,
 	const TArray<FClearingRegion>& Clearings)
 {
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Distribution.Clearings.ApplyClearingMask");
 	if (Points.Num() == 0 || Clearings.Num() == 0)
 	{
 		return Points;
 	}
+	FPointCloud Cloud(Points);
+	ApplyClearingMask(Cloud, Clearings);
+	return Cloud.ToPoints();
+}
 
-	TArray<FVector> Filtered;
-	Filtered.Reserve(Points.Num());
+void FClearings::ApplyClearingMask(
+	FPointCloud& Cloud,
+	const TArray<FClearingRegion>& Clearings)
+{
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Distribution.Clearings.ApplyClearingMask");
+	if (Cloud.NumAlive() == 0 || Clearings.Num() == 0)
+	{
+		return;
+	}
 
-	for (const FVector& Point : Points)
+	// Index the centres and query with the largest radius; each hit is checked against its own radius.
+	TArray<FVector> Centers;
+	Centers.Reserve(Clearings.Num());
+	float MaxRadius = 1.0f;
+	for (const FClearingRegion& Region : Clearings)
 	{
-		bool bInsideClearing = false;
-		for (const FClearingRegion& Region : Clearings)
+		Centers.Add(Region.Center);
+		MaxRadius = FMath::Max(MaxRadius, Region.Radius);
+	}
+	const FPointSpatialIndex CenterIndex(Centers, MaxRadius);
+
+	for (int32 Index = 0; Index < Cloud.Num(); ++Index)
+	{
+		if (!Cloud.IsAlive(Index))
 		{
-			if (FVector::DistSquared2D(Point, Region.Center) <= FMath::Square(FMath::Max(1.0f, Region.Radius)))
-			{
-				bInsideClearing = true;
-				break;
-			}
+			continue;
 		}
-
-		if (!bInsideClearing)
+		bool bInsideClearing = false;
+		CenterIndex.ForEachWithin(Cloud.GetPosition(Index), MaxRadius, [&](int32 ClearingIndex, float DistSq)
+		{
+			bInsideClearing = DistSq <= FMath::Square(FMath::Max(1.0f, Clearings[ClearingIndex].Radius));
+			return !bInsideClearing;
+		});
+		if (bInsideClearing)
 		{
-			Filtered.Add(Point);
+			Cloud.Kill(Index);
 		}
 	}
+}
 
-	return Filtered;
+void FClearings::ApplyClearingMask(
+	FPointCloud& Cloud,
+	const FClearingSdf& Sdf,
+	const FClearingMaskSettings& Settings,
+	int32 Seed)
+{
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Distribution.Clearings.ApplyClearingMask");
+	if (Cloud.NumAlive() == 0 || !Sdf.IsValid())
+	{
+		return;
+	}
+
+	const FCounterRng Rng(Seed, CounterRngStream::ClearingMask);
+	Cloud.ParallelFilter([&](int32 Index)
+	{
+		const float Keep = KeepFactor(Sdf.Sample(Cloud.GetPosition(Index)), Settings);
+		return Keep >= 1.0f || (Keep > 0.0f && Rng.FRand(Index) < Keep);
+	});
 }
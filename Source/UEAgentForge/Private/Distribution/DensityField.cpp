@@ -3,7 +3,13 @@
 
 #include "Distribution/DensityField.h"
 
-#include "Math/RandomStream.h"
+#include "AgentForgeTrace.h"
+#include "Distribution/BiomePartition.h"
+#include "Distribution/Clearings.h"
+#include "Distribution/CounterRng.h"
+#include "Distribution/PointCloud.h"
+
+#include "Async/ParallelFor.h"
 
 namespace
 {
@@ -16,57 +22,144 @@ namespace
 	{
 		return FMath::Clamp(Value, 0.0f, 1.0f);
 	}
-}
 
-TArray<float> FDensityField::GenerateDensityField(
-	const FBox& Bounds,
-	int32 Width,
-	int32 Height,
-	const FDensityFieldConfig& Config)
-{
-	Width = FMath::Clamp(Width, 2, 1024);
-	Height = FMath::Clamp(Height, 2, 1024);
+	/** Per-call constants of the radial density field. */
+	struct FDensityRowParams
+	{
+		FBox Bounds;
+		int32 Width = 2;
+		int32 Height = 2;
+		FVector2D Center = FVector2D::ZeroVector;
+		float Sigma2 = 1.0f;
+		float BaseDensity = 1.0f;
+		float NoiseBlend = 0.0f;
+		float NoiseOffsetX = 0.0f;
+		float NoiseOffsetY = 0.0f;
+		float NoiseScale = 0.0015f;
+		double FringeRangeSq = 1.0;
 
-	TArray<float> Field;
-	Field.SetNumZeroed(Width * Height);
+		FDensityRowParams(const FBox& InBounds, int32 InWidth, int32 InHeight, const FDensityFieldConfig& Config)
+			: Bounds(InBounds)
+			, Width(InWidth)
+			, Height(InHeight)
+			, Center(Config.Center.X, Config.Center.Y)
+		{
+			const FVector2D Extent2D(FMath::Max(1.0f, Bounds.Max.X - Bounds.Min.X), FMath::Max(1.0f, Bounds.Max.Y - Bounds.Min.Y));
+			const float Sigma = FMath::Max(1.0f, Config.Sigma);
+			Sigma2 = Sigma * Sigma;
+			BaseDensity = FMath::Max(0.0f, Config.BaseDensity);
+			NoiseBlend = SafeSaturate(Config.NoiseBlend);
+			FringeRangeSq = FMath::Square(FMath::Max(Extent2D.X, Extent2D.Y));
 
-	const FVector2D Extent2D(FMath::Max(1.0f, Bounds.Max.X - Bounds.Min.X), FMath::Max(1.0f, Bounds.Max.Y - Bounds.Min.Y));
-	const float Sigma = FMath::Max(1.0f, Config.Sigma);
-	const float Sigma2 = Sigma * Sigma;
-	const float BaseDensity = FMath::Max(0.0f, Config.BaseDensity);
-	const float NoiseBlend = SafeSaturate(Config.NoiseBlend);
+			const FCounterRng Rng(Config.Seed, CounterRngStream::DensityNoise);
+			NoiseOffsetX = Rng.FRandRange(0, -100000.0f, 100000.0f);
+			NoiseOffsetY = Rng.FRandRange(1, -100000.0f, 100000.0f);
+		}
 
-	FRandomStream Rng(Config.Seed);
-	const float NoiseOffsetX = Rng.FRandRange(-100000.0f, 100000.0f);
-	const float NoiseOffsetY = Rng.FRandRange(-100000.0f, 100000.0f);
-	const float NoiseScale = 0.0015f;
+		float WorldX(int32 X) const { return FMath::Lerp(Bounds.Min.X, Bounds.Max.X, (float)X / (float)(Width - 1)); }
+		float WorldY(int32 Y) const { return FMath::Lerp(Bounds.Min.Y, Bounds.Max.Y, (float)Y / (float)(Height - 1)); }
+	};
 
-	for (int32 Y = 0; Y < Height; ++Y)
+	/** Density of one grid row; rows are independent, so callers fill them in parallel. */
+	static void EvaluateDensityRow(const FDensityRowParams& Params, int32 Y, float* RESTRICT OutRow)
 	{
-		const float V = (float)Y / (float)(Height - 1);
-		const float WY = FMath::Lerp(Bounds.Min.Y, Bounds.Max.Y, V);
-
-		for (int32 X = 0; X < Width; ++X)
+		const float WY = Params.WorldY(Y);
+		for (int32 X = 0; X < Params.Width; ++X)
 		{
-			const float U = (float)X / (float)(Width - 1);
-			const float WX = FMath::Lerp(Bounds.Min.X, Bounds.Max.X, U);
+			const float WX = Params.WorldX(X);
 			const FVector2D P(WX, WY);
 
-			const FVector2D Center(Config.Center.X, Config.Center.Y);
-			const float DistSq = FVector2D::DistSquared(P, Center);
-			const float Falloff = FMath::Exp(-DistSq / (2.0f * Sigma2));
-			float Density = BaseDensity * Falloff;
+			const float DistSq = FVector2D::DistSquared(P, Params.Center);
+			const float Falloff = FMath::Exp(-DistSq / (2.0f * Params.Sigma2));
+			float Density = Params.BaseDensity * Falloff;
 
-			const float Noise = FMath::PerlinNoise2D(FVector2D((WX * NoiseScale) + NoiseOffsetX, (WY * NoiseScale) + NoiseOffsetY));
-			const float NoiseFactor = FMath::Lerp(1.0f, 0.75f + (Noise * 0.25f), NoiseBlend);
+			const float Noise = FMath::PerlinNoise2D(FVector2D((WX * Params.NoiseScale) + Params.NoiseOffsetX, (WY * Params.NoiseScale) + Params.NoiseOffsetY));
+			const float NoiseFactor = FMath::Lerp(1.0f, 0.75f + (Noise * 0.25f), Params.NoiseBlend);
 			Density *= NoiseFactor;
 
 			// Keep slight support outside the high-density center for natural fringe growth.
-			const float Fringe = FMath::Clamp(1.0f - (DistSq / FMath::Square(FMath::Max(Extent2D.X, Extent2D.Y))), 0.0f, 1.0f) * 0.15f;
-			Field[FieldIndex(X, Y, Width)] = SafeSaturate(Density + Fringe);
+			const float Fringe = FMath::Clamp(1.0f - (DistSq / Params.FringeRangeSq), 0.0f, 1.0f) * 0.15f;
+			OutRow[X] = SafeSaturate(Density + Fringe);
 		}
 	}
 
+	static float SampleGrid(const TArray<float>& Grid, int32 Width, int32 Height, const FBox& Bounds, const FVector& Location)
+	{
+		const float U = FMath::Clamp((Location.X - Bounds.Min.X) / FMath::Max(1.0f, Bounds.Max.X - Bounds.Min.X), 0.0f, 1.0f);
+		const float V = FMath::Clamp((Location.Y - Bounds.Min.Y) / FMath::Max(1.0f, Bounds.Max.Y - Bounds.Min.Y), 0.0f, 1.0f);
+
+		const float FX = U * (float)FMath::Max(0, Width - 1);
+		const float FY = V * (float)FMath::Max(0, Height - 1);
+		const int32 X0 = FMath::Clamp(FMath::FloorToInt(FX), 0, Width - 1);
+		const int32 Y0 = FMath::Clamp(FMath::FloorToInt(FY), 0, Height - 1);
+		const int32 X1 = FMath::Clamp(X0 + 1, 0, Width - 1);
+		const int32 Y1 = FMath::Clamp(Y0 + 1, 0, Height - 1);
+
+		const float Tx = FMath::Frac(FX);
+		const float Ty = FMath::Frac(FY);
+		const float A = FMath::Lerp(Grid[FieldIndex(X0, Y0, Width)], Grid[FieldIndex(X1, Y0, Width)], Tx);
+		const float B = FMath::Lerp(Grid[FieldIndex(X0, Y1, Width)], Grid[FieldIndex(X1, Y1, Width)], Tx);
+		return SafeSaturate(FMath::Lerp(A, B, Ty));
+	}
+
+	/** Append 2x2 box-filtered levels until the last one is 1x1. */
+	static void BuildMipChain(FDensityRaster& Raster)
+	{
+		while (Raster.MipSizes.Last() != FIntPoint(1, 1))
+		{
+			const FIntPoint Src = Raster.MipSizes.Last();
+			const FIntPoint Dst(FMath::Max(1, (Src.X + 1) / 2), FMath::Max(1, (Src.Y + 1) / 2));
+			TArray<float> Level;
+			Level.SetNumUninitialized(Dst.X * Dst.Y);
+			const TArray<float>& Parent = Raster.Mips.Last();
+			for (int32 Y = 0; Y < Dst.Y; ++Y)
+			{
+				const int32 Y0 = FMath::Min(Y * 2, Src.Y - 1);
+				const int32 Y1 = FMath::Min(Y * 2 + 1, Src.Y - 1);
+				for (int32 X = 0; X < Dst.X; ++X)
+				{
+					const int32 X0 = FMath::Min(X * 2, Src.X - 1);
+					const int32 X1 = FMath::Min(X * 2 + 1, Src.X - 1);
+					Level[FieldIndex(X, Y, Dst.X)] = 0.25f * (
+						Parent[FieldIndex(X0, Y0, Src.X)] + Parent[FieldIndex(X1, Y0, Src.X)] +
+						Parent[FieldIndex(X0, Y1, Src.X)] + Parent[FieldIndex(X1, Y1, Src.X)]);
+				}
+			}
+			Raster.MipSizes.Add(Dst);
+			Raster.Mips.Add(MoveTemp(Level));
+		}
+	}
+}
+
+float FDensityRaster::Sample(const FVector& Location, int32 Level) const
+{
+	if (!IsValid())
+	{
+		return 1.0f;
+	}
+	const int32 L = FMath::Clamp(Level, 0, Mips.Num() - 1);
+	return SampleGrid(Mips[L], MipSizes[L].X, MipSizes[L].Y, Bounds, Location);
+}
+
+TArray<float> FDensityField::GenerateDensityField(
+	const FBox& Bounds,
+	int32 Width,
+	int32 Height,
+	const FDensityFieldConfig& Config)
+{
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Distribution.Density.GenerateDensityField");
+	Width = FMath::Clamp(Width, 2, 1024);
+	Height = FMath::Clamp(Height, 2, 1024);
+
+	TArray<float> Field;
+	Field.SetNumZeroed(Width * Height);
+
+	const FDensityRowParams Params(Bounds, Width, Height, Config);
+	ParallelFor(Height, [&](int32 Y)
+	{
+		EvaluateDensityRow(Params, Y, Field.GetData() + FieldIndex(0, Y, Width));
+	});
+
 	return Field;
 }
 
@@ -83,21 +176,7 @@ float FDensityField::SampleDensity(
 		return SafeSaturate(FallbackDensity);
 	}
 
-	const float U = FMath::Clamp((Location.X - Bounds.Min.X) / FMath::Max(1.0f, Bounds.Max.X - Bounds.Min.X), 0.0f, 1.0f);
-	const float V = FMath::Clamp((Location.Y - Bounds.Min.Y) / FMath::Max(1.0f, Bounds.Max.Y - Bounds.Min.Y), 0.0f, 1.0f);
-
-	const float FX = U * (float)(Width - 1);
-	const float FY = V * (float)(Height - 1);
-	const int32 X0 = FMath::Clamp(FMath::FloorToInt(FX), 0, Width - 1);
-	const int32 Y0 = FMath::Clamp(FMath::FloorToInt(FY), 0, Height - 1);
-	const int32 X1 = FMath::Clamp(X0 + 1, 0, Width - 1);
-	const int32 Y1 = FMath::Clamp(Y0 + 1, 0, Height - 1);
-
-	const float Tx = FMath::Frac(FX);
-	const float Ty = FMath::Frac(FY);
-	const float A = FMath::Lerp(Field[FieldIndex(X0, Y0, Width)], Field[FieldIndex(X1, Y0, Width)], Tx);
-	const float B = FMath::Lerp(Field[FieldIndex(X0, Y1, Width)], Field[FieldIndex(X1, Y1, Width)], Tx);
-	return SafeSaturate(FMath::Lerp(A, B, Ty));
+	return SampleGrid(Field, Width, Height, Bounds, Location);
 }
 
 TArray<FVector> FDensityField::ApplyDensityGradient(
@@ -109,24 +188,122 @@ TArray<FVector> FDensityField::ApplyDensityGradient(
 	int32 Seed,
 	float MinKeepProbability)
 {
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Distribution.Density.ApplyDensityGradient");
 	if (Points.Num() == 0)
 	{
 		return Points;
 	}
+	FPointCloud Cloud(Points);
+	ApplyDensityGradient(Cloud, Field, Width, Height, Bounds, Seed, MinKeepProbability);
+	return Cloud.ToPoints();
+}
 
-	FRandomStream Rng(Seed ^ 0x2F1A6D93);
+void FDensityField::ApplyDensityGradient(
+	FPointCloud& Cloud,
+	const TArray<float>& Field,
+	int32 Width,
+	int32 Height,
+	const FBox& Bounds,
+	int32 Seed,
+	float MinKeepProbability)
+{
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Distribution.Density.ApplyDensityGradient");
+	if (Cloud.NumAlive() == 0)
+	{
+		return;
+	}
+
+	const FCounterRng Rng(Seed, CounterRngStream::DensityGradient);
 	const float MinKeep = SafeSaturate(MinKeepProbability);
+	Cloud.AddChannel(Cloud.Density, 1.0f);
 
-	TArray<FVector> Filtered;
-	Filtered.Reserve(Points.Num());
-	for (const FVector& Point : Points)
+	Cloud.ParallelFilter([&](int32 Index)
 	{
-		const float Density = SampleDensity(Field, Width, Height, Bounds, Point, 1.0f);
+		const float Density = SampleDensity(Field, Width, Height, Bounds, Cloud.GetPosition(Index), 1.0f);
+		Cloud.Density[Index] = Density;
 		const float KeepProb = FMath::Max(MinKeep, Density);
-		if (Rng.FRand() <= KeepProb)
+		return Rng.FRand(Index) <= KeepProb;
+	});
+}
+
+FDensityRaster FDensityField::GenerateCompositeField(
+	const FBox& Bounds,
+	int32 Width,
+	int32 Height,
+	const FDensityFieldConfig& Config,
+	const FDensityCompositeMasks& Masks)
+{
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Distribution.Density.GenerateCompositeField");
+	FDensityRaster Raster;
+	if (!Bounds.IsValid)
+	{
+		return Raster;
+	}
+	Width = FMath::Clamp(Width, 2, 1024);
+	Height = FMath::Clamp(Height, 2, 1024);
+	Raster.Bounds = Bounds;
+	Raster.MipSizes.Add(FIntPoint(Width, Height));
+	TArray<float>& Field = Raster.Mips.AddDefaulted_GetRef();
+	Field.SetNumUninitialized(Width * Height);
+
+	const FClearingSdf* ClearingSdf = (Masks.ClearingSdf && Masks.ClearingSdf->IsValid()) ? Masks.ClearingSdf : nullptr;
+	const FBiomePartitionData* Biomes = (Masks.Biomes && Masks.AllowedBiomeIds.Num() > 0) ? Masks.Biomes : nullptr;
+	const float MinKeep = SafeSaturate(Masks.MinKeepProbability);
+
+	const FDensityRowParams Params(Bounds, Width, Height, Config);
+	ParallelFor(Height, [&](int32 Y)
+	{
+		float* RESTRICT Row = Field.GetData() + FieldIndex(0, Y, Width);
+		EvaluateDensityRow(Params, Y, Row);
+		for (int32 X = 0; X < Width; ++X)
 		{
-			Filtered.Add(Point);
+			Row[X] = FMath::Max(MinKeep, Row[X]);
 		}
+		if (!ClearingSdf && !Biomes)
+		{
+			return;
+		}
+
+		const float WY = Params.WorldY(Y);
+		for (int32 X = 0; X < Width; ++X)
+		{
+			const FVector Texel(Params.WorldX(X), WY, 0.0f);
+			if (ClearingSdf)
+			{
+				Row[X] *= FClearings::KeepFactor(ClearingSdf->Sample(Texel), Masks.ClearingSettings);
+			}
+			bool bMasked = false;
+			if (Biomes)
+			{
+				const FBiomeIdSample Blend = FBiomePartition::BlendBiomeIds(*Biomes, Texel);
+				const auto IsAllowed = [&](int32 Id) { return Masks.AllowedBiomeIds.IsValidIndex(Id) && Masks.AllowedBiomeIds[Id]; };
+				bMasked = !(IsAllowed(Blend.PrimaryBiome) || (IsAllowed(Blend.SecondaryBiome) && Blend.BlendAlpha >= 0.5f));
+			}
+			if (bMasked)
+			{
+				Row[X] = 0.0f;
+			}
+		}
+	});
+
+	BuildMipChain(Raster);
+	return Raster;
+}
+
+void FDensityField::ApplyDensityRaster(FPointCloud& Cloud, const FDensityRaster& Raster, int32 Seed)
+{
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Distribution.Density.ApplyDensityRaster");
+	if (Cloud.NumAlive() == 0 || !Raster.IsValid())
+	{
+		return;
 	}
-	return Filtered;
+
+	const FCounterRng Rng(Seed, CounterRngStream::DensityGradient);
+	Cloud.AddChannel(Cloud.Density, 1.0f);
+	Cloud.ParallelFilter([&](int32 Index)
+	{
+		const float KeepProb = Raster.Sample(Cloud.GetPosition(Index));
+		Cloud.Density[Index] = KeepProb;
+		return Rng.FRand(Index) <= KeepProb;
+	});
 }
@@ -3,13 +3,17 @@
 
 #include "Distribution/DistributionEngine.h"
 
+#include "AgentForgeTrace.h"
+#include "Distribution/CounterRng.h"
+#include "Distribution/PointCloud.h"
+
+#include "Async/ParallelFor.h"
 #include "CollisionQueryParams.h"
 #include "Engine/World.h"
-#include "Math/RandomStream.h"
 
 namespace
 {
-	static FVector SamplePointInBounds(const FBox& Bounds, FRandomStream& Rng)
+	static FVector SamplePointInBounds(const FBox& Bounds, FCounterRngSequence& Rng)
 	{
 		return FVector(
 			Rng.FRandRange(Bounds.Min.X, Bounds.Max.X),
@@ -22,6 +26,111 @@ namespace
 		return Point.X >= Bounds.Min.X && Point.X <= Bounds.Max.X &&
 			   Point.Y >= Bounds.Min.Y && Point.Y <= Bounds.Max.Y;
 	}
+
+	/**
+	 * Flat Bridson acceleration grid. Cells are Radius / sqrt(2) wide, so each
+	 * holds at most one point; the point itself is stored in the cell (relative
+	 * to the bounds minimum), so a neighbour probe is one contiguous read.
+	 */
+	struct FPoissonGrid
+	{
+		static constexpr float EmptyCell = TNumericLimits<float>::Max();
+		static constexpr int64 MaxCells = 16 * 1024 * 1024;   // 128 MB of cells
+		static constexpr int32 CandidatesPerActivePoint = 30;
+
+		FVector2D Origin = FVector2D::ZeroVector;
+		float Radius = 1.0f;
+		float RadiusSq = 1.0f;
+		float CellSize = 1.0f;
+		float InvCellSize = 1.0f;
+		int32 Width = 1;
+		int32 Height = 1;
+		TArray<FVector2f> Cells;
+
+		void Init(const FBox& Bounds, float MinSpacing)
+		{
+			const double SizeX = Bounds.Max.X - Bounds.Min.X;
+			const double SizeY = Bounds.Max.Y - Bounds.Min.Y;
+			Radius = FMath::Max(1.0f, MinSpacing);
+
+			// A grid past MaxCells would hold several times MaxPoints, so widening the
+			// spacing to fit only matters for requests that could never fill it.
+			const double Cells2D = (SizeX * SizeY * 2.0) / ((double)Radius * Radius);
+			if (Cells2D > (double)MaxCells)
+			{
+				Radius = (float)(Radius * FMath::Sqrt(Cells2D / (double)MaxCells));
+			}
+
+			RadiusSq = Radius * Radius;
+			CellSize = Radius / UE_SQRT_2;
+			InvCellSize = 1.0f / CellSize;
+			Origin = FVector2D(Bounds.Min.X, Bounds.Min.Y);
+			Width = FMath::Max(1, FMath::CeilToInt(SizeX / CellSize));
+			Height = FMath::Max(1, FMath::CeilToInt(SizeY / CellSize));
+			Cells.Init(FVector2f(EmptyCell, EmptyCell), Width * Height);
+		}
+
+		FVector2f ToLocal(const FVector& World) const
+		{
+			return FVector2f((float)(World.X - Origin.X), (float)(World.Y - Origin.Y));
+		}
+
+		FVector ToWorld(const FVector2f& Local, double Z) const
+		{
+			return FVector(Origin.X + Local.X, Origin.Y + Local.Y, Z);
+		}
+
+		int32 CellX(float LocalX) const { return FMath::Clamp((int32)(LocalX * InvCellSize), 0, Width - 1); }
+		int32 CellY(float LocalY) const { return FMath::Clamp((int32)(LocalY * InvCellSize), 0, Height - 1); }
+
+		void Insert(const FVector2f& Local)
+		{
+			Cells[CellY(Local.Y) * Width + CellX(Local.X)] = Local;
+		}
+
+		bool IsFarEnough(const FVector2f& Candidate) const
+		{
+			const int32 CX = CellX(Candidate.X);
+			const int32 CY = CellY(Candidate.Y);
+			const int32 X0 = FMath::Max(CX - 2, 0);
+			const int32 X1 = FMath::Min(CX + 2, Width - 1);
+			for (int32 Y = FMath::Max(CY - 2, 0); Y <= FMath::Min(CY + 2, Height - 1); ++Y)
+			{
+				const FVector2f* Row = Cells.GetData() + (int64)Y * Width;
+				for (int32 X = X0; X <= X1; ++X)
+				{
+					const FVector2f& Existing = Row[X];
+					if (Existing.X != EmptyCell && FVector2f::DistSquared(Candidate, Existing) < RadiusSq)
+					{
+						return false;
+					}
+				}
+			}
+			return true;
+		}
+
+		/** Up to CandidatesPerActivePoint annulus samples around Base, kept inside [RegionMin, RegionMax]. */
+		bool TrySpawnAround(const FVector2f& Base, const FVector2f& RegionMin, const FVector2f& RegionMax, FCounterRngSequence& Rng, FVector2f& OutCandidate) const
+		{
+			for (int32 Attempt = 0; Attempt < CandidatesPerActivePoint; ++Attempt)
+			{
+				const float Angle = Rng.FRandRange(0.0f, 2.0f * PI);
+				const float Distance = Rng.FRandRange(Radius, 2.0f * Radius);
+				const FVector2f Candidate = Base + FVector2f(FMath::Cos(Angle), FMath::Sin(Angle)) * Distance;
+				if (Candidate.X < RegionMin.X || Candidate.X >= RegionMax.X ||
+					Candidate.Y < RegionMin.Y || Candidate.Y >= RegionMax.Y)
+				{
+					continue;
+				}
+				if (IsFarEnough(Candidate))
+				{
+					OutCandidate = Candidate;
+					return true;
+				}
+			}
+			return false;
+		}
+	};
 }
 
 TArray<FVector> FDistributionEngine::GenerateBlueNoisePoints(
@@ -30,6 +139,7 @@ TArray<FVector> FDistributionEngine::GenerateBlueNoisePoints(
 	int32 Seed,
 	float MinSpacing)
 {
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Distribution.GenerateBlueNoisePoints");
 	return GeneratePoissonDiskPoints(Bounds, TargetCount, MinSpacing, Seed);
 }
 
@@ -40,41 +150,46 @@ TArray<FVector> FDistributionEngine::GenerateClusterPoints(
 	float ClusterRadius,
 	int32 Seed)
 {
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Distribution.GenerateClusterPoints");
 	TArray<FVector> Points;
-	TargetCount = FMath::Clamp(TargetCount, 0, 50000);
+	TargetCount = FMath::Clamp(TargetCount, 0, MaxPoints);
 	ClusterCount = FMath::Clamp(ClusterCount, 1, 1024);
 	if (!Bounds.IsValid || TargetCount <= 0)
 	{
 		return Points;
 	}
 
-	FRandomStream Rng(Seed);
+	FCounterRngSequence CenterRng(Seed, CounterRngStream::ClusterCenters);
 	TArray<FVector> ClusterCenters;
 	ClusterCenters.Reserve(ClusterCount);
 	for (int32 Index = 0; Index < ClusterCount; ++Index)
 	{
-		ClusterCenters.Add(SamplePointInBounds(Bounds, Rng));
+		ClusterCenters.Add(SamplePointInBounds(Bounds, CenterRng));
 	}
 
+	// Each point's four draws are addressed by its index, so points are independent.
+	static constexpr uint32 DrawsPerPoint = 4;
+	const FCounterRng Rng(Seed, CounterRngStream::ClusterPoints);
 	const float Radius = FMath::Max(1.0f, ClusterRadius);
-	for (int32 Index = 0; Index < TargetCount; ++Index)
+	Points.SetNumUninitialized(TargetCount);
+	ParallelFor(TargetCount, [&](int32 Index)
 	{
-		const FVector& Center = ClusterCenters[Rng.RandRange(0, ClusterCenters.Num() - 1)];
-		const float Angle = Rng.FRandRange(0.0f, 2.0f * PI);
-		const float Distance = Radius * FMath::Sqrt(Rng.FRand());
+		const FVector& Center = ClusterCenters[Rng.RandRange(FCounterRng::Slot(Index, 0, DrawsPerPoint), 0, ClusterCenters.Num() - 1)];
+		const float Angle = Rng.FRandRange(FCounterRng::Slot(Index, 1, DrawsPerPoint), 0.0f, 2.0f * PI);
+		const float Distance = Radius * FMath::Sqrt(Rng.FRand(FCounterRng::Slot(Index, 2, DrawsPerPoint)));
 
 		FVector Candidate = Center;
 		Candidate.X += FMath::Cos(Angle) * Distance;
 		Candidate.Y += FMath::Sin(Angle) * Distance;
-		Candidate.Z = Rng.FRandRange(Bounds.Min.Z, Bounds.Max.Z);
+		Candidate.Z = Rng.FRandRange(FCounterRng::Slot(Index, 3, DrawsPerPoint), Bounds.Min.Z, Bounds.Max.Z);
 
 		if (!IsPointWithinBounds2D(Candidate, Bounds))
 		{
 			Candidate.X = FMath::Clamp(Candidate.X, Bounds.Min.X, Bounds.Max.X);
 			Candidate.Y = FMath::Clamp(Candidate.Y, Bounds.Min.Y, Bounds.Max.Y);
 		}
-		Points.Add(Candidate);
-	}
+		Points[Index] = Candidate;
+	}, TargetCount < 4096 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
 
 	return Points;
 }
@@ -85,116 +200,186 @@ TArray<FVector> FDistributionEngine::GeneratePoissonDiskPoints(
 	float MinSpacing,
 	int32 Seed)
 {
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Distribution.GeneratePoissonDiskPoints");
 	TArray<FVector> Points;
-	TargetCount = FMath::Clamp(TargetCount, 0, 50000);
+	TargetCount = FMath::Clamp(TargetCount, 0, MaxPoints);
 	if (!Bounds.IsValid || TargetCount <= 0)
 	{
 		return Points;
 	}
+	if (TargetCount > TiledPoissonThreshold)
+	{
+		return GeneratePoissonDiskPointsTiled(Bounds, TargetCount, MinSpacing, Seed);
+	}
 
-	const float Radius = FMath::Max(1.0f, MinSpacing);
-	const float CellSize = Radius / FMath::Sqrt(2.0f);
-	const int32 GridWidth = FMath::Max(1, FMath::CeilToInt((Bounds.Max.X - Bounds.Min.X) / CellSize));
-	const int32 GridHeight = FMath::Max(1, FMath::CeilToInt((Bounds.Max.Y - Bounds.Min.Y) / CellSize));
+	FPoissonGrid Grid;
+	Grid.Init(Bounds, MinSpacing);
 
-	FRandomStream Rng(Seed);
-	TMap<int64, int32> Grid;
+	// Draw order: seed X, Y, Z, then per step the active index, angle and distance per
+	// attempt, and Z for an accepted candidate.
+	FCounterRngSequence Rng(Seed, CounterRngStream::PoissonDisk);
+	const FVector SeedPoint = SamplePointInBounds(Bounds, Rng);
+	Points.Reserve(TargetCount);
+	Points.Add(SeedPoint);
+	Grid.Insert(Grid.ToLocal(SeedPoint));
+
+	TArray<FVector2f> Local;
+	Local.Reserve(TargetCount);
+	Local.Add(Grid.ToLocal(SeedPoint));
 	TArray<int32> ActiveList;
+	ActiveList.Add(0);
+	const FVector2f RegionMin(0.0f, 0.0f);
+	const FVector2f RegionMax = Grid.ToLocal(Bounds.Max);
 
-	auto GridKey = [](int32 X, int32 Y) -> int64
+	while (ActiveList.Num() > 0 && Points.Num() < TargetCount)
 	{
-		return (((int64)X) << 32) | (uint32)Y;
-	};
+		const int32 ActiveIndex = Rng.RandRange(0, ActiveList.Num() - 1);
+		FVector2f Candidate;
+		if (Grid.TrySpawnAround(Local[ActiveList[ActiveIndex]], RegionMin, RegionMax, Rng, Candidate))
+		{
+			const int32 NewIndex = Local.Add(Candidate);
+			ActiveList.Add(NewIndex);
+			Grid.Insert(Candidate);
+			Points.Add(Grid.ToWorld(Candidate, Rng.FRandRange(Bounds.Min.Z, Bounds.Max.Z)));
+		}
+		else
+		{
+			ActiveList.RemoveAtSwap(ActiveIndex);
+		}
+	}
+
+	return Points;
+}
+
+TArray<FVector> FDistributionEngine::GeneratePoissonDiskPointsTiled(
+	const FBox& Bounds,
+	int32 TargetCount,
+	float MinSpacing,
+	int32 Seed)
+{
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Distribution.GeneratePoissonDiskPointsTiled");
+	TArray<FVector> Points;
+	TargetCount = FMath::Clamp(TargetCount, 0, MaxPoints);
+	if (!Bounds.IsValid || TargetCount <= 0)
+	{
+		return Points;
+	}
 
-	auto ToGridCoord = [&](const FVector2D& P) -> FIntPoint
+	FPoissonGrid Grid;
+	Grid.Init(Bounds, MinSpacing);
+
+	// About 1024 points per tile at the requested count. Tiles are at least four radii
+	// wide, so a tile's 5x5 neighbourhood search never reaches a tile of the same phase.
+	const int64 TotalCells = (int64)Grid.Width * Grid.Height;
+	const int32 MinTileCells = FMath::CeilToInt(4.0f * Grid.Radius / Grid.CellSize);
+	int32 TileCells = FMath::Max(MinTileCells, FMath::CeilToInt(FMath::Sqrt((double)TotalCells * 1024.0 / (double)TargetCount)));
+	int32 TilesX = FMath::DivideAndRoundUp(Grid.Width, TileCells);
+	int32 TilesY = FMath::DivideAndRoundUp(Grid.Height, TileCells);
+	while ((int64)TilesX * TilesY > 16384)
 	{
-		const int32 GX = FMath::Clamp(FMath::FloorToInt((P.X - Bounds.Min.X) / CellSize), 0, GridWidth - 1);
-		const int32 GY = FMath::Clamp(FMath::FloorToInt((P.Y - Bounds.Min.Y) / CellSize), 0, GridHeight - 1);
-		return FIntPoint(GX, GY);
-	};
+		TileCells *= 2;
+		TilesX = FMath::DivideAndRoundUp(Grid.Width, TileCells);
+		TilesY = FMath::DivideAndRoundUp(Grid.Height, TileCells);
+	}
+	const int32 NumTiles = TilesX * TilesY;
+
+	// Area-proportional quotas with cumulative rounding, so they sum to TargetCount.
+	TArray<int32> Quotas;
+	Quotas.SetNumUninitialized(NumTiles);
+	int64 CellsSoFar = 0;
+	int64 AssignedSoFar = 0;
+	for (int32 Tile = 0; Tile < NumTiles; ++Tile)
+	{
+		const int32 TX = Tile % TilesX;
+		const int32 TY = Tile / TilesX;
+		const int64 TileArea =
+			(int64)(FMath::Min((TX + 1) * TileCells, Grid.Width) - TX * TileCells) *
+			(int64)(FMath::Min((TY + 1) * TileCells, Grid.Height) - TY * TileCells);
+		CellsSoFar += TileArea;
+		const int64 AssignedAfter = (int64)TargetCount * CellsSoFar / TotalCells;
+		Quotas[Tile] = (int32)(AssignedAfter - AssignedSoFar);
+		AssignedSoFar = AssignedAfter;
+	}
 
-	auto IsFarEnough = [&](const FVector2D& Candidate2D) -> bool
+	const FVector2f GridMax = Grid.ToLocal(Bounds.Max);
+	TArray<TArray<FVector>> TilePoints;
+	TilePoints.SetNum(NumTiles);
+	TArray<int32> PhaseTiles;
+	PhaseTiles.Reserve(NumTiles / 4 + TilesX + TilesY + 1);
+	for (int32 Phase = 0; Phase < 4; ++Phase)
 	{
-		const FIntPoint Cell = ToGridCoord(Candidate2D);
-		const int32 SearchRadius = 2;
-		for (int32 DY = -SearchRadius; DY <= SearchRadius; ++DY)
+		PhaseTiles.Reset();
+		for (int32 TY = Phase >> 1; TY < TilesY; TY += 2)
 		{
-			for (int32 DX = -SearchRadius; DX <= SearchRadius; ++DX)
+			for (int32 TX = Phase & 1; TX < TilesX; TX += 2)
 			{
-				const int32 NX = Cell.X + DX;
-				const int32 NY = Cell.Y + DY;
-				if (NX < 0 || NX >= GridWidth || NY < 0 || NY >= GridHeight)
-				{
-					continue;
-				}
-
-				const int32* ExistingIndex = Grid.Find(GridKey(NX, NY));
-				if (!ExistingIndex || !Points.IsValidIndex(*ExistingIndex))
-				{
-					continue;
-				}
-
-				const FVector& Existing = Points[*ExistingIndex];
-				if (FVector2D::Distance(Candidate2D, FVector2D(Existing.X, Existing.Y)) < Radius)
-				{
-					return false;
-				}
+				PhaseTiles.Add(TY * TilesX + TX);
 			}
 		}
-		return true;
-	};
-
-	const FVector SeedPoint = SamplePointInBounds(Bounds, Rng);
-	Points.Add(SeedPoint);
-	ActiveList.Add(0);
-	const FIntPoint SeedCell = ToGridCoord(FVector2D(SeedPoint.X, SeedPoint.Y));
-	Grid.Add(GridKey(SeedCell.X, SeedCell.Y), 0);
 
-	const int32 CandidatesPerActivePoint = 30;
-	while (ActiveList.Num() > 0 && Points.Num() < TargetCount)
-	{
-		const int32 ActiveIndex = Rng.RandRange(0, ActiveList.Num() - 1);
-		const int32 PointIndex = ActiveList[ActiveIndex];
-		const FVector BasePoint = Points[PointIndex];
-		const FVector2D Base2D(BasePoint.X, BasePoint.Y);
-
-		bool bAccepted = false;
-		for (int32 Attempt = 0; Attempt < CandidatesPerActivePoint; ++Attempt)
+		ParallelFor(PhaseTiles.Num(), [&](int32 PhaseIndex)
 		{
-			const float Angle = Rng.FRandRange(0.0f, 2.0f * PI);
-			const float Distance = Rng.FRandRange(Radius, 2.0f * Radius);
-			const FVector2D Candidate2D = Base2D + FVector2D(FMath::Cos(Angle), FMath::Sin(Angle)) * Distance;
-
-			if (Candidate2D.X < Bounds.Min.X || Candidate2D.X > Bounds.Max.X ||
-				Candidate2D.Y < Bounds.Min.Y || Candidate2D.Y > Bounds.Max.Y)
+			const int32 Tile = PhaseTiles[PhaseIndex];
+			const int32 Quota = Quotas[Tile];
+			if (Quota <= 0)
 			{
-				continue;
+				return;
 			}
-
-			if (!IsFarEnough(Candidate2D))
+			const int32 TX = Tile % TilesX;
+			const int32 TY = Tile / TilesX;
+			const FVector2f RegionMin(TX * TileCells * Grid.CellSize, TY * TileCells * Grid.CellSize);
+			const FVector2f RegionMax(
+				FMath::Min((TX + 1) * TileCells * Grid.CellSize, GridMax.X),
+				FMath::Min((TY + 1) * TileCells * Grid.CellSize, GridMax.Y));
+			FCounterRngSequence Rng(Seed, CounterRngStream::PoissonTile, (uint64)Tile);
+
+			TArray<FVector>& Out = TilePoints[Tile];
+			Out.Reserve(Quota);
+			TArray<FVector2f> Local;
+			Local.Reserve(Quota);
+			TArray<int32> ActiveList;
+
+			// Several seeds per tile, so a tile that stops at its quota is spread out rather than one disc.
+			const int32 SeedCount = FMath::Max(1, Quota / 32);
+			for (int32 SeedIndex = 0; SeedIndex < SeedCount && Local.Num() < Quota; ++SeedIndex)
 			{
-				continue;
+				const FVector2f Candidate(Rng.FRandRange(RegionMin.X, RegionMax.X), Rng.FRandRange(RegionMin.Y, RegionMax.Y));
+				if (Grid.IsFarEnough(Candidate))
+				{
+					ActiveList.Add(Local.Add(Candidate));
+					Grid.Insert(Candidate);
+					Out.Add(Grid.ToWorld(Candidate, Rng.FRandRange(Bounds.Min.Z, Bounds.Max.Z)));
+				}
 			}
 
-			const FVector Candidate(
-				Candidate2D.X,
-				Candidate2D.Y,
-				Rng.FRandRange(Bounds.Min.Z, Bounds.Max.Z));
-
-			const int32 NewIndex = Points.Add(Candidate);
-			ActiveList.Add(NewIndex);
-			const FIntPoint Cell = ToGridCoord(Candidate2D);
-			Grid.Add(GridKey(Cell.X, Cell.Y), NewIndex);
-			bAccepted = true;
-			break;
-		}
-
-		if (!bAccepted)
-		{
-			ActiveList.RemoveAtSwap(ActiveIndex);
-		}
+			while (ActiveList.Num() > 0 && Local.Num() < Quota)
+			{
+				const int32 ActiveIndex = Rng.RandRange(0, ActiveList.Num() - 1);
+				FVector2f Candidate;
+				if (Grid.TrySpawnAround(Local[ActiveList[ActiveIndex]], RegionMin, RegionMax, Rng, Candidate))
+				{
+					ActiveList.Add(Local.Add(Candidate));
+					Grid.Insert(Candidate);
+					Out.Add(Grid.ToWorld(Candidate, Rng.FRandRange(Bounds.Min.Z, Bounds.Max.Z)));
+				}
+				else
+				{
+					ActiveList.RemoveAtSwap(ActiveIndex);
+				}
+			}
+		});
 	}
 
+	int32 Total = 0;
+	for (const TArray<FVector>& Tile : TilePoints)
+	{
+		Total += Tile.Num();
+	}
+	Points.Reserve(Total);
+	for (const TArray<FVector>& Tile : TilePoints)
+	{
+		Points.Append(Tile);
+	}
 	return Points;
 }
 
@@ -204,6 +389,7 @@ TArray<FVector> FDistributionEngine::GeneratePoissonPoints(
 	float MinSpacing,
 	int32 Seed)
 {
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Distribution.GeneratePoissonPoints");
 	return GeneratePoissonDiskPoints(Bounds, TargetCount, MinSpacing, Seed);
 }
 
@@ -211,78 +397,128 @@ TArray<FVector> FDistributionEngine::ApplySlopeFilter(
 	const TArray<FVector>& Points,
 	UWorld* World,
 	float MinSlopeDegrees,
-	float MaxSlopeDegrees)
+	float MaxSlopeDegrees,
+	ESurfaceTraceSource Source)
 {
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Distribution.ApplySlopeFilter");
 	if (!World || Points.Num() == 0)
 	{
 		return Points;
 	}
+	FPointCloud Cloud(Points);
+	ApplySlopeFilter(Cloud, World, MinSlopeDegrees, MaxSlopeDegrees, Source);
+	return Cloud.ToPoints();
+}
+
+TArray<FVector> FDistributionEngine::ApplyHeightFilter(
+	const TArray<FVector>& Points,
+	float MinHeight,
+	float MaxHeight)
+{
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Distribution.ApplyHeightFilter");
+	FPointCloud Cloud(Points);
+	ApplyHeightFilter(Cloud, MinHeight, MaxHeight);
+	return Cloud.ToPoints();
+}
+
+TArray<FVector> FDistributionEngine::ApplyDistanceMask(
+	const TArray<FVector>& Points,
+	const FVector& Origin,
+	float MinDistance,
+	float MaxDistance)
+{
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Distribution.ApplyDistanceMask");
+	FPointCloud Cloud(Points);
+	ApplyDistanceMask(Cloud, Origin, MinDistance, MaxDistance);
+	return Cloud.ToPoints();
+}
+
+void FDistributionEngine::ApplySlopeFilter(FPointCloud& Cloud, UWorld* World, float MinSlopeDegrees, float MaxSlopeDegrees, ESurfaceTraceSource Source)
+{
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Distribution.ApplySlopeFilter");
+	if (!World || Cloud.NumAlive() == 0)
+	{
+		return;
+	}
 
 	const float MinSlope = FMath::Clamp(MinSlopeDegrees, 0.0f, 89.9f);
 	const float MaxSlope = FMath::Clamp(MaxSlopeDegrees, MinSlope, 89.9f);
-	TArray<FVector> Filtered;
-	Filtered.Reserve(Points.Num());
+	Cloud.AddChannel(Cloud.Normal, FVector3f::UpVector);
+
+	TArray<int32> Indices;
+	TArray<FVector> Queries;
+	Indices.Reserve(Cloud.NumAlive());
+	Queries.Reserve(Cloud.NumAlive());
+	Cloud.ForEachAlive([&](int32 Index)
+	{
+		Indices.Add(Index);
+		Queries.Add(Cloud.GetPosition(Index));
+	});
 
-	FCollisionQueryParams Params(SCENE_QUERY_STAT(UEAgentForgeSlopeFilter), false);
-	for (const FVector& Point : Points)
+	FSurfaceTraceSettings Settings;
+	Settings.Source = Source;
+	TArray<FSurfaceSample> Samples;
+	FAgentForgeSurfaceTrace::Get().TraceDown(World, Queries, Settings, FCollisionQueryParams(SCENE_QUERY_STAT(UEAgentForgeSlopeFilter), false), Samples);
+
+	for (int32 Q = 0; Q < Indices.Num(); ++Q)
 	{
-		const FVector Start(Point.X, Point.Y, Point.Z + 10000.0f);
-		const FVector End(Point.X, Point.Y, Point.Z - 10000.0f);
-		FHitResult Hit;
-		if (!World->LineTraceSingleByChannel(Hit, Start, End, ECC_Visibility, Params))
+		const int32 Index = Indices[Q];
+		const FSurfaceSample& Sample = Samples[Q];
+		if (!Sample.bHit)
 		{
+			Cloud.Kill(Index);
 			continue;
 		}
 
-		const float Dot = FMath::Clamp(FVector::DotProduct(Hit.ImpactNormal.GetSafeNormal(), FVector::UpVector), -1.0f, 1.0f);
+		const float Dot = FMath::Clamp(FVector3f::DotProduct(Sample.Normal, FVector3f::UpVector), -1.0f, 1.0f);
 		const float SlopeDegrees = FMath::RadiansToDegrees(FMath::Acos(Dot));
 		if (SlopeDegrees >= MinSlope && SlopeDegrees <= MaxSlope)
 		{
-			Filtered.Add(Hit.ImpactPoint);
+			Cloud.SetPosition(Index, Sample.Location);
+			Cloud.Normal[Index] = Sample.Normal;
+		}
+		else
+		{
+			Cloud.Kill(Index);
 		}
 	}
-
-	return Filtered;
 }
 
-TArray<FVector> FDistributionEngine::ApplyHeightFilter(
-	const TArray<FVector>& Points,
-	float MinHeight,
-	float MaxHeight)
+void FDistributionEngine::ApplyHeightFilter(FPointCloud& Cloud, float MinHeight, float MaxHeight)
 {
-	const float Low = FMath::Min(MinHeight, MaxHeight);
-	const float High = FMath::Max(MinHeight, MaxHeight);
-
-	TArray<FVector> Filtered;
-	Filtered.Reserve(Points.Num());
-	for (const FVector& Point : Points)
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Distribution.ApplyHeightFilter");
+	const FVector::FReal Low = FMath::Min(MinHeight, MaxHeight);
+	const FVector::FReal High = FMath::Max(MinHeight, MaxHeight);
+
+	const int32 Count = Cloud.Num();
+	const FVector::FReal* RESTRICT Z = Cloud.Z.GetData();
+	uint8* RESTRICT Alive = Cloud.Alive.GetData();
+	for (int32 Index = 0; Index < Count; ++Index)
 	{
-		if (Point.Z >= Low && Point.Z <= High)
-		{
-			Filtered.Add(Point);
-		}
+		Alive[Index] &= (uint8)(Z[Index] >= Low && Z[Index] <= High);
 	}
-	return Filtered;
+	Cloud.RecountAlive();
 }
 
-TArray<FVector> FDistributionEngine::ApplyDistanceMask(
-	const TArray<FVector>& Points,
-	const FVector& Origin,
-	float MinDistance,
-	float MaxDistance)
+void FDistributionEngine::ApplyDistanceMask(FPointCloud& Cloud, const FVector& Origin, float MinDistance, float MaxDistance)
 {
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Distribution.ApplyDistanceMask");
 	const float Low = FMath::Max(0.0f, FMath::Min(MinDistance, MaxDistance));
 	const float High = FMath::Max(Low, FMath::Max(MinDistance, MaxDistance));
-
-	TArray<FVector> Filtered;
-	Filtered.Reserve(Points.Num());
-	for (const FVector& Point : Points)
+	const FVector::FReal LowSq = (FVector::FReal)Low * Low;
+	const FVector::FReal HighSq = (FVector::FReal)High * High;
+
+	// Compared squared, skipping the square root per point.
+	const int32 Count = Cloud.Num();
+	const FVector::FReal* RESTRICT X = Cloud.X.GetData();
+	const FVector::FReal* RESTRICT Y = Cloud.Y.GetData();
+	uint8* RESTRICT Alive = Cloud.Alive.GetData();
+	for (int32 Index = 0; Index < Count; ++Index)
 	{
-		const float Distance = FVector::Dist2D(Point, Origin);
-		if (Distance >= Low && Distance <= High)
-		{
-			Filtered.Add(Point);
-		}
+		const FVector::FReal DX = X[Index] - Origin.X;
+		const FVector::FReal DY = Y[Index] - Origin.Y;
+		const FVector::FReal DistSq = DX * DX + DY * DY;
+		Alive[Index] &= (uint8)(DistSq >= LowSq && DistSq <= HighSq);
 	}
-	return Filtered;
+	Cloud.RecountAlive();
 }
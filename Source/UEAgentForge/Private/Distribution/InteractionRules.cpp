@@ -3,118 +3,152 @@
 
 #include "Distribution/InteractionRules.h"
 
-#include "Math/RandomStream.h"
+#include "AgentForgeTrace.h"
+#include "Distribution/CounterRng.h"
+#include "Distribution/PointCloud.h"
+#include "Distribution/SpatialFilters.h"
 
 TArray<FVector> FInteractionRules::ApplyAvoidance(
 	const TArray<FVector>& CandidatePoints,
 	const TArray<FVector>& BlockingPoints,
 	float MinDistance)
 {
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Distribution.Interaction.ApplyAvoidance");
 	if (CandidatePoints.Num() == 0 || BlockingPoints.Num() == 0)
 	{
 		return CandidatePoints;
 	}
+	FPointCloud Cloud(CandidatePoints);
+	ApplyAvoidance(Cloud, BlockingPoints, MinDistance);
+	return Cloud.ToPoints();
+}
 
-	const float RadiusSq = FMath::Square(FMath::Max(1.0f, MinDistance));
-	TArray<FVector> Filtered;
-	Filtered.Reserve(CandidatePoints.Num());
+TArray<FVector> FInteractionRules::ApplyAttractorBias(
+	const TArray<FVector>& CandidatePoints,
+	const TArray<FVector>& AttractorPoints,
+	float AttractionRadius,
+	float AttractionStrength,
+	int32 Seed)
+{
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Distribution.Interaction.ApplyAttractorBias");
+	if (CandidatePoints.Num() == 0 || AttractorPoints.Num() == 0)
+	{
+		return CandidatePoints;
+	}
+	FPointCloud Cloud(CandidatePoints);
+	ApplyAttractorBias(Cloud, AttractorPoints, AttractionRadius, AttractionStrength, Seed);
+	return Cloud.ToPoints();
+}
 
-	for (const FVector& Candidate : CandidatePoints)
+TArray<FVector> FInteractionRules::ApplySelfSpacing(
+	const TArray<FVector>& CandidatePoints,
+	float MinDistance)
+{
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Distribution.Interaction.ApplySelfSpacing");
+	if (CandidatePoints.Num() == 0)
 	{
-		bool bBlocked = false;
-		for (const FVector& Blocking : BlockingPoints)
-		{
-			if (FVector::DistSquared2D(Candidate, Blocking) < RadiusSq)
-			{
-				bBlocked = true;
-				break;
-			}
-		}
+		return CandidatePoints;
+	}
+	FPointCloud Cloud(CandidatePoints);
+	ApplySelfSpacing(Cloud, MinDistance);
+	return Cloud.ToPoints();
+}
+
+void FInteractionRules::ApplyAvoidance(
+	FPointCloud& Cloud,
+	const TArray<FVector>& BlockingPoints,
+	float MinDistance)
+{
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Distribution.Interaction.ApplyAvoidance");
+	if (Cloud.NumAlive() == 0 || BlockingPoints.Num() == 0)
+	{
+		return;
+	}
 
-		if (!bBlocked)
+	const float Radius = FMath::Max(1.0f, MinDistance);
+	const FPointSpatialIndex Blockers(BlockingPoints, Radius);
+	for (int32 Index = 0; Index < Cloud.Num(); ++Index)
+	{
+		if (Cloud.IsAlive(Index) && Blockers.AnyWithin(Cloud.GetPosition(Index), Radius))
 		{
-			Filtered.Add(Candidate);
+			Cloud.Kill(Index);
 		}
 	}
-
-	return Filtered;
 }
 
-TArray<FVector> FInteractionRules::ApplyAttractorBias(
-	const TArray<FVector>& CandidatePoints,
+void FInteractionRules::ApplyAttractorBias(
+	FPointCloud& Cloud,
 	const TArray<FVector>& AttractorPoints,
 	float AttractionRadius,
 	float AttractionStrength,
 	int32 Seed)
 {
-	if (CandidatePoints.Num() == 0 || AttractorPoints.Num() == 0)
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Distribution.Interaction.ApplyAttractorBias");
+	if (Cloud.NumAlive() == 0 || AttractorPoints.Num() == 0)
 	{
-		return CandidatePoints;
+		return;
 	}
 
 	const float Radius = FMath::Max(1.0f, AttractionRadius);
 	const float RadiusSq = Radius * Radius;
 	const float Strength = FMath::Clamp(AttractionStrength, 0.0f, 1.0f);
-	FRandomStream Rng(Seed ^ 0x51F15E3D);
+	const FCounterRng Rng(Seed, CounterRngStream::AttractorBias);
 
-	TArray<FVector> Filtered;
-	Filtered.Reserve(CandidatePoints.Num());
+	// The falloff reaches zero at twice the radius, so farther attractors never change the outcome.
+	const float FalloffRadius = 2.0f * Radius;
+	const FPointSpatialIndex Attractors(AttractorPoints, FalloffRadius);
 
-	for (const FVector& Candidate : CandidatePoints)
+	// One draw per point, addressed by point index, so points are tested in parallel.
+	Cloud.ParallelFilter([&](int32 Index)
 	{
 		float BestDistSq = TNumericLimits<float>::Max();
-		for (const FVector& Attractor : AttractorPoints)
-		{
-			BestDistSq = FMath::Min(BestDistSq, FVector::DistSquared2D(Candidate, Attractor));
-		}
-
+		Attractors.FindNearest(Cloud.GetPosition(Index), FalloffRadius, BestDistSq);
 		if (BestDistSq <= RadiusSq)
 		{
-			Filtered.Add(Candidate);
-			continue;
+			return true;
 		}
 
 		const float Dist = FMath::Sqrt(FMath::Max(0.0f, BestDistSq));
 		const float Falloff = FMath::Clamp(1.0f - ((Dist - Radius) / FMath::Max(1.0f, Radius)), 0.0f, 1.0f);
 		const float KeepProbability = FMath::Lerp(1.0f - Strength, 1.0f, Falloff);
-		if (Rng.FRand() <= KeepProbability)
-		{
-			Filtered.Add(Candidate);
-		}
-	}
-
-	return Filtered;
+		return Rng.FRand(Index) <= KeepProbability;
+	});
 }
 
-TArray<FVector> FInteractionRules::ApplySelfSpacing(
-	const TArray<FVector>& CandidatePoints,
+void FInteractionRules::ApplySelfSpacing(
+	FPointCloud& Cloud,
 	float MinDistance)
 {
-	if (CandidatePoints.Num() == 0)
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Distribution.Interaction.ApplySelfSpacing");
+	if (Cloud.NumAlive() == 0)
 	{
-		return CandidatePoints;
+		return;
 	}
 
-	const float RadiusSq = FMath::Square(FMath::Max(1.0f, MinDistance));
-	TArray<FVector> Filtered;
-	Filtered.Reserve(CandidatePoints.Num());
+	const float Radius = FMath::Max(1.0f, MinDistance);
+	FBox2D Rect(ForceInit);
+	Cloud.ForEachAlive([&](int32 Index)
+	{
+		Rect += FVector2D(Cloud.X[Index], Cloud.Y[Index]);
+	});
 
-	for (const FVector& Candidate : CandidatePoints)
+	// Survivors are indexed as they are kept; candidates are tested in order, as before.
+	FPointSpatialIndex Accepted;
+	Accepted.Init(Rect, Radius, Cloud.NumAlive());
+	for (int32 Index = 0; Index < Cloud.Num(); ++Index)
 	{
-		bool bTooClose = false;
-		for (const FVector& Existing : Filtered)
+		if (!Cloud.IsAlive(Index))
+		{
+			continue;
+		}
+		const FVector Candidate = Cloud.GetPosition(Index);
+		if (Accepted.AnyWithin(Candidate, Radius))
 		{
-			if (FVector::DistSquared2D(Candidate, Existing) < RadiusSq)
-			{
-				bTooClose = true;
-				break;
-			}
+			Cloud.Kill(Index);
 		}
-		if (!bTooClose)
+		else
 		{
-			Filtered.Add(Candidate);
+			Accepted.Add(Candidate);
 		}
 	}
-
-	return Filtered;
 }
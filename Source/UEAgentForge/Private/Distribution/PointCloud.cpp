@@ -0,0 +1,143 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// PointCloud.cpp - survivor-mask bookkeeping and compaction.
+
+#include "Distribution/PointCloud.h"
+
+namespace
+{
+	template <typename T>
+	static void CompactChannel(TArray<T>& Channel, const TArray<uint8>& Alive, int32 AliveCount)
+	{
+		if (Channel.Num() != Alive.Num())
+		{
+			return;
+		}
+		int32 Write = 0;
+		for (int32 Read = 0; Read < Channel.Num(); ++Read)
+		{
+			if (Alive[Read])
+			{
+				if (Write != Read)
+				{
+					Channel[Write] = MoveTemp(Channel[Read]);
+				}
+				++Write;
+			}
+		}
+		check(Write == AliveCount);
+		Channel.SetNum(Write, EAllowShrinking::No);
+	}
+}
+
+FPointCloud::FPointCloud(const TArray<FVector>& Points)
+{
+	Reset(Points.Num());
+	for (const FVector& Point : Points)
+	{
+		Add(Point);
+	}
+}
+
+void FPointCloud::Reset(int32 ReserveCount)
+{
+	X.Reset(ReserveCount);
+	Y.Reset(ReserveCount);
+	Z.Reset(ReserveCount);
+	Alive.Reset(ReserveCount);
+	BiomeId.Reset();
+	BiomeNames.Reset();
+	Density.Reset();
+	Scale.Reset();
+	Normal.Reset();
+	AliveCount = 0;
+}
+
+int32 FPointCloud::Add(const FVector& Point)
+{
+	// Channels that are already filled grow with the positions.
+	const int32 Index = X.Add(Point.X);
+	Y.Add(Point.Y);
+	Z.Add(Point.Z);
+	Alive.Add(1);
+	++AliveCount;
+	if (Index > 0 && BiomeId.Num() == Index) { BiomeId.Add(INDEX_NONE); }
+	if (Index > 0 && Density.Num() == Index) { Density.Add(1.0f); }
+	if (Index > 0 && Scale.Num() == Index)   { Scale.Add(1.0f); }
+	if (Index > 0 && Normal.Num() == Index)  { Normal.Add(FVector3f::UpVector); }
+	return Index;
+}
+
+void FPointCloud::SetPosition(int32 Index, const FVector& Point)
+{
+	X[Index] = Point.X;
+	Y[Index] = Point.Y;
+	Z[Index] = Point.Z;
+}
+
+void FPointCloud::RecountAlive()
+{
+	int32 Count = 0;
+	for (const uint8 Flag : Alive)
+	{
+		Count += Flag;
+	}
+	AliveCount = Count;
+}
+
+void FPointCloud::TruncateAlive(int32 Count)
+{
+	int32 Kept = 0;
+	for (int32 Index = 0; Index < Num() && AliveCount > Count; ++Index)
+	{
+		if (Alive[Index])
+		{
+			if (Kept < Count)
+			{
+				++Kept;
+			}
+			else
+			{
+				Kill(Index);
+			}
+		}
+	}
+}
+
+void FPointCloud::Compact()
+{
+	if (AliveCount == Num())
+	{
+		return;
+	}
+	CompactChannel(X, Alive, AliveCount);
+	CompactChannel(Y, Alive, AliveCount);
+	CompactChannel(Z, Alive, AliveCount);
+	CompactChannel(BiomeId, Alive, AliveCount);
+	CompactChannel(Density, Alive, AliveCount);
+	CompactChannel(Scale, Alive, AliveCount);
+	CompactChannel(Normal, Alive, AliveCount);
+	Alive.Init(1, AliveCount);
+}
+
+TArray<FVector> FPointCloud::ToPoints() const
+{
+	TArray<FVector> Points;
+	Points.Reserve(AliveCount);
+	ForEachAlive([&](int32 Index)
+	{
+		Points.Add(GetPosition(Index));
+	});
+	return Points;
+}
+
+SIZE_T FPointCloud::GetAllocatedSize() const
+{
+	SIZE_T Bytes = X.GetAllocatedSize() + Y.GetAllocatedSize() + Z.GetAllocatedSize() + Alive.GetAllocatedSize()
+		+ BiomeId.GetAllocatedSize() + BiomeNames.GetAllocatedSize() + Density.GetAllocatedSize()
+		+ Scale.GetAllocatedSize() + Normal.GetAllocatedSize();
+	for (const FString& Name : BiomeNames)
+	{
+		Bytes += Name.GetAllocatedSize();
+	}
+	return Bytes;
+}
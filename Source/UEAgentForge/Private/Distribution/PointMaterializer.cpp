@@ -0,0 +1,397 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// PointMaterializer.cpp - palette resolution, parallel point mapping and per-cell HISM output.
+
+#include "Distribution/PointMaterializer.h"
+
+#include "AgentForgeTrace.h"
+#include "AgentForgeInstancedScatter.h"
+#include "AgentForgeSurfaceTrace.h"
+#include "Distribution/CounterRng.h"
+#include "Palette/PaletteManager.h"
+
+#include "Async/ParallelFor.h"
+#include "CollisionQueryParams.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Dom/JsonValue.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Actor.h"
+#include "HAL/PlatformTime.h"
+
+namespace
+{
+	static constexpr uint32 DrawsPerPoint = 4;   // category, mesh, yaw, scale
+
+	struct FMaterializeCategory
+	{
+		FString Name;
+		FVector2f ScaleRange = FVector2f(1.0f, 1.0f);
+		TArray<int32> Meshes;   // into FMaterializePalette::Meshes
+	};
+
+	struct FMaterializePalette
+	{
+		TArray<UStaticMesh*> Meshes;
+		TArray<FMaterializeCategory> Categories;
+		TArray<int32> AllCategories;
+		TArray<TArray<int32>> BiomeCategories;   // by biome id; empty entry = AllCategories
+	};
+
+	struct FMappedPoint
+	{
+		FTransform Transform;
+		FIntPoint Cell = FIntPoint::ZeroValue;
+		int32 Mesh = INDEX_NONE;
+		int32 Category = INDEX_NONE;
+		float Scale = 1.0f;
+	};
+
+	static bool ResolvePalette(
+		const TSharedPtr<FJsonObject>& Palette,
+		const FDistributionPointAttributes& Attributes,
+		const FPointMaterializeSettings& Settings,
+		FMaterializePalette& Out,
+		FPointMaterializeResult& Result)
+	{
+		if (!Palette.IsValid())
+		{
+			return false;
+		}
+
+		const TSharedPtr<FJsonObject>* ScaleRanges = nullptr;
+		Palette->TryGetObjectField(TEXT("scale_range"), ScaleRanges);
+
+		TMap<FString, int32> MeshByPath;
+		TMap<FString, int32> CategoryByName;
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Palette->Values)
+		{
+			const TArray<TSharedPtr<FJsonValue>>* Paths = nullptr;
+			if (FPaletteManager::IsMetadataField(Field.Key) || !Field.Value.IsValid() || !Field.Value->TryGetArray(Paths))
+			{
+				continue;
+			}
+			if (Settings.Categories.Num() > 0 && !Settings.Categories.Contains(Field.Key))
+			{
+				continue;
+			}
+
+			FMaterializeCategory Category;
+			Category.Name = Field.Key;
+			for (const TSharedPtr<FJsonValue>& PathValue : *Paths)
+			{
+				FString Path;
+				if (!PathValue.IsValid() || !PathValue->TryGetString(Path) || Path.IsEmpty())
+				{
+					continue;
+				}
+				if (const int32* Existing = MeshByPath.Find(Path))
+				{
+					Category.Meshes.Add(*Existing);
+					continue;
+				}
+				// Resident when the palette's preload finished; LoadObject waits on it otherwise.
+				const FSoftObjectPath MeshPath(FPaletteManager::ToObjectPath(Path));
+				UStaticMesh* Mesh = Cast<UStaticMesh>(MeshPath.ResolveObject());
+				if (!Mesh)
+				{
+					Mesh = LoadObject<UStaticMesh>(nullptr, *MeshPath.ToString());
+				}
+				if (!Mesh)
+				{
+					Result.MissingMeshes.AddUnique(Path);
+					continue;
+				}
+				const int32 MeshIndex = Out.Meshes.Add(Mesh);
+				MeshByPath.Add(Path, MeshIndex);
+				Category.Meshes.Add(MeshIndex);
+			}
+			if (Category.Meshes.IsEmpty())
+			{
+				continue;
+			}
+
+			const TArray<TSharedPtr<FJsonValue>>* Range = nullptr;
+			if (ScaleRanges && (*ScaleRanges)->TryGetArrayField(Field.Key, Range) && Range->Num() >= 2)
+			{
+				const float Min = (float)(*Range)[0]->AsNumber();
+				const float Max = (float)(*Range)[1]->AsNumber();
+				Category.ScaleRange = FVector2f(FMath::Min(Min, Max), FMath::Max(Min, Max));
+			}
+
+			const int32 CategoryIndex = Out.Categories.Add(MoveTemp(Category));
+			CategoryByName.Add(Field.Key, CategoryIndex);
+			Out.AllCategories.Add(CategoryIndex);
+		}
+
+		// Optional { "biomes": { "<biome name>": ["trees", "shrubs"] } }
+		const TSharedPtr<FJsonObject>* Biomes = nullptr;
+		Out.BiomeCategories.SetNum(Attributes.BiomeNames.Num());
+		if (Palette->TryGetObjectField(TEXT("biomes"), Biomes))
+		{
+			for (int32 BiomeId = 0; BiomeId < Attributes.BiomeNames.Num(); ++BiomeId)
+			{
+				const TArray<TSharedPtr<FJsonValue>>* Names = nullptr;
+				if (!(*Biomes)->TryGetArrayField(Attributes.BiomeNames[BiomeId], Names))
+				{
+					continue;
+				}
+				for (const TSharedPtr<FJsonValue>& NameValue : *Names)
+				{
+					FString Name;
+					if (NameValue.IsValid() && NameValue->TryGetString(Name))
+					{
+						if (const int32* CategoryIndex = CategoryByName.Find(Name))
+						{
+							Out.BiomeCategories[BiomeId].AddUnique(*CategoryIndex);
+						}
+					}
+				}
+			}
+		}
+
+		Result.Meshes = Out.Meshes.Num();
+		return Out.Meshes.Num() > 0;
+	}
+
+	static FQuat AlignToNormal(const FVector3f& Normal, float MaxAngleDegrees)
+	{
+		const FVector Up = FVector::UpVector;
+		const FVector N = FVector(Normal).GetSafeNormal();
+		if (N.IsNearlyZero())
+		{
+			return FQuat::Identity;
+		}
+		const FQuat Align = FQuat::FindBetweenNormals(Up, N);
+		const double MaxAngle = FMath::DegreesToRadians((double)FMath::Clamp(MaxAngleDegrees, 0.0f, 90.0f));
+		FVector Axis;
+		double Angle = 0.0;
+		Align.ToAxisAndAngle(Axis, Angle);
+		return Angle > MaxAngle ? FQuat(Axis, MaxAngle) : Align;
+	}
+
+	static FIntPoint CellOf(const FVector& Location, double CellSize)
+	{
+		if (CellSize <= 0.0)
+		{
+			return FIntPoint::ZeroValue;
+		}
+		return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+	}
+
+	static FString CellLabel(const FString& Prefix, const FIntPoint& Cell)
+	{
+		return FString::Printf(TEXT("%s_Cell_%d_%d"), *Prefix, Cell.X, Cell.Y);
+	}
+}
+
+TSharedPtr<FJsonObject> FPointMaterializeResult::ToJson() const
+{
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetNumberField(TEXT("instances"), Instances);
+	Obj->SetNumberField(TEXT("cells"), Cells);
+	Obj->SetNumberField(TEXT("components"), Components);
+	Obj->SetNumberField(TEXT("meshes"), Meshes);
+	Obj->SetNumberField(TEXT("removed_cells"), RemovedCells);
+	Obj->SetNumberField(TEXT("traced_normals"), TracedNormals);
+	Obj->SetNumberField(TEXT("map_ms"), MapMs);
+	Obj->SetNumberField(TEXT("build_ms"), BuildMs);
+
+	TSharedPtr<FJsonObject> CategoriesObj = MakeShared<FJsonObject>();
+	for (const TPair<FString, int32>& Pair : CategoryCounts)
+	{
+		CategoriesObj->SetNumberField(Pair.Key, Pair.Value);
+	}
+	Obj->SetObjectField(TEXT("categories"), CategoriesObj);
+
+	TArray<TSharedPtr<FJsonValue>> MissingArr;
+	for (const FString& Path : MissingMeshes)
+	{
+		MissingArr.Add(MakeShared<FJsonValueString>(Path));
+	}
+	Obj->SetArrayField(TEXT("missing_meshes"), MissingArr);
+	return Obj;
+}
+
+bool FPointMaterializer::Materialize(
+	UWorld* World,
+	const TArray<FVector>& Points,
+	const FDistributionPointAttributes& Attributes,
+	const TSharedPtr<FJsonObject>& Palette,
+	const FPointMaterializeSettings& Settings,
+	FPointMaterializeResult& OutResult,
+	FString& OutError)
+{
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Distribution.Materializer.Materialize");
+	OutResult = FPointMaterializeResult();
+	if (!World)
+	{
+		OutError = TEXT("No world to materialize into.");
+		return false;
+	}
+	if (Settings.Prefix.IsEmpty())
+	{
+		OutError = TEXT("Materialization needs an actor label prefix.");
+		return false;
+	}
+
+	FMaterializePalette Resolved;
+	if (!ResolvePalette(Palette, Attributes, Settings, Resolved, OutResult))
+	{
+		OutError = OutResult.MissingMeshes.Num() > 0
+			? FString::Printf(TEXT("No palette mesh could be loaded (%d missing)."), OutResult.MissingMeshes.Num())
+			: TEXT("The palette has no mesh categories to materialize.");
+		return false;
+	}
+
+	OutResult.RemovedCells = RemoveCells(World, Settings.Prefix);
+	const int32 Count = Points.Num();
+	if (Count == 0)
+	{
+		return true;
+	}
+
+	// Normals come from the slope filter; without one, trace them (and snap to the hit).
+	TArray<FSurfaceSample> Samples;
+	const bool bHaveNormals = Attributes.Normal.Num() == Count;
+	if (Settings.bAlignToNormal && !bHaveNormals)
+	{
+		FAgentForgeSurfaceTrace::Get().TraceDown(World, Points, FSurfaceTraceSettings(), FCollisionQueryParams(SCENE_QUERY_STAT(UEAgentForgeMaterialize), false), Samples);
+		for (const FSurfaceSample& Sample : Samples)
+		{
+			OutResult.TracedNormals += Sample.bHit ? 1 : 0;
+		}
+	}
+
+	// Map: every point is independent, so this is a flat parallel loop.
+	const double MapStart = FPlatformTime::Seconds();
+	const bool bHaveDensity = Attributes.Density.Num() == Count;
+	const bool bHaveBiomes = Attributes.BiomeId.Num() == Count;
+	const FCounterRng Rng(Settings.Seed, CounterRngStream::Materialize);
+	TArray<FMappedPoint> Mapped;
+	Mapped.SetNum(Count);
+	ParallelFor(Count, [&](int32 Index)
+	{
+		const TArray<int32>* Allowed = &Resolved.AllCategories;
+		if (bHaveBiomes && Resolved.BiomeCategories.IsValidIndex(Attributes.BiomeId[Index]) && Resolved.BiomeCategories[Attributes.BiomeId[Index]].Num() > 0)
+		{
+			Allowed = &Resolved.BiomeCategories[Attributes.BiomeId[Index]];
+		}
+		if (Allowed->IsEmpty())
+		{
+			return;
+		}
+
+		FMappedPoint& Out = Mapped[Index];
+		Out.Category = (*Allowed)[Rng.RandRange(FCounterRng::Slot(Index, 0, DrawsPerPoint), 0, Allowed->Num() - 1)];
+		const FMaterializeCategory& Category = Resolved.Categories[Out.Category];
+		Out.Mesh = Category.Meshes[Rng.RandRange(FCounterRng::Slot(Index, 1, DrawsPerPoint), 0, Category.Meshes.Num() - 1)];
+
+		const float Yaw = Rng.FRandRange(FCounterRng::Slot(Index, 2, DrawsPerPoint), 0.0f, 2.0f * PI);
+		const float DensityFactor = bHaveDensity
+			? FMath::Lerp(Settings.DensityScale.X, Settings.DensityScale.Y, FMath::Clamp(Attributes.Density[Index], 0.0f, 1.0f))
+			: 1.0f;
+		Out.Scale = Rng.FRandRange(FCounterRng::Slot(Index, 3, DrawsPerPoint), Category.ScaleRange.X, Category.ScaleRange.Y) * DensityFactor;
+
+		FVector Location = Points[Index];
+		FQuat Rotation = FQuat(FVector::UpVector, Yaw);
+		if (Settings.bAlignToNormal)
+		{
+			if (bHaveNormals)
+			{
+				Rotation = AlignToNormal(Attributes.Normal[Index], Settings.MaxAlignAngle) * Rotation;
+			}
+			else if (Samples.IsValidIndex(Index) && Samples[Index].bHit)
+			{
+				Location = Samples[Index].Location;
+				Rotation = AlignToNormal(Samples[Index].Normal, Settings.MaxAlignAngle) * Rotation;
+			}
+		}
+		Out.Transform = FTransform(Rotation, Location, FVector(Out.Scale));
+		Out.Cell = CellOf(Location, Settings.CellSize);
+	});
+	OutResult.MapMs = (FPlatformTime::Seconds() - MapStart) * 1000.0;
+
+	// Bucket in point order so each batch is deterministic.
+	const double BuildStart = FPlatformTime::Seconds();
+	TMap<FIntPoint, TMap<int32, FAgentForgeInstanceBatch>> Cells;
+	for (const FMappedPoint& Point : Mapped)
+	{
+		if (Point.Mesh == INDEX_NONE)
+		{
+			continue;
+		}
+		Cells.FindOrAdd(Point.Cell).FindOrAdd(Point.Mesh).Add(Point.Transform, FLinearColor::White, Point.Scale);
+		++OutResult.CategoryCounts.FindOrAdd(Resolved.Categories[Point.Category].Name);
+	}
+
+	TArray<FIntPoint> CellKeys;
+	Cells.GetKeys(CellKeys);
+	CellKeys.Sort([](const FIntPoint& A, const FIntPoint& B) { return A.Y != B.Y ? A.Y < B.Y : A.X < B.X; });
+
+	for (const FIntPoint& Cell : CellKeys)
+	{
+		TMap<int32, FAgentForgeInstanceBatch>& Batches = Cells[Cell];
+		Batches.KeySort(TLess<int32>());
+
+		const FVector Origin = Batches.CreateConstIterator()->Value.Transforms[0].GetLocation();
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		AActor* CellActor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform(Origin), SpawnParams);
+		if (!CellActor)
+		{
+			continue;
+		}
+		CellActor->SetActorLabel(CellLabel(Settings.Prefix, Cell));
+		if (!Settings.Tag.IsNone())
+		{
+			CellActor->Tags.AddUnique(Settings.Tag);
+		}
+
+		for (TPair<int32, FAgentForgeInstanceBatch>& Pair : Batches)
+		{
+			UHierarchicalInstancedStaticMeshComponent* Component =
+				FAgentForgeInstancedScatter::FindOrAddComponent(CellActor, Resolved.Meshes[Pair.Key], nullptr);
+			if (!Component)
+			{
+				continue;
+			}
+			if (Settings.CullDistance > 0.0f)
+			{
+				Component->SetCullDistances(FMath::RoundToInt(Settings.CullDistance * 0.8f), FMath::RoundToInt(Settings.CullDistance));
+			}
+			FAgentForgeInstancedScatter::AddInstances(Component, Pair.Value);
+			OutResult.Instances += Pair.Value.Num();
+			++OutResult.Components;
+		}
+		++OutResult.Cells;
+	}
+	OutResult.BuildMs = (FPlatformTime::Seconds() - BuildStart) * 1000.0;
+	return true;
+}
+
+int32 FPointMaterializer::RemoveCells(UWorld* World, const FString& Prefix)
+{
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Distribution.Materializer.RemoveCells");
+	if (!World || Prefix.IsEmpty())
+	{
+		return 0;
+	}
+
+	const FString CellPrefix = Prefix + TEXT("_Cell_");
+	TArray<AActor*> Doomed;
+	for (TActorIterator<AActor> It(World); It; ++It)
+	{
+		if (IsValid(*It) && It->GetActorLabel().StartsWith(CellPrefix))
+		{
+			Doomed.Add(*It);
+		}
+	}
+
+	int32 Removed = 0;
+	for (AActor* Actor : Doomed)
+	{
+		Removed += World->DestroyActor(Actor) ? 1 : 0;
+	}
+	return Removed;
+}
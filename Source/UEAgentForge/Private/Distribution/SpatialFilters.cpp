@@ -1,3 +1,157 @@
 // Copyright UEAgentForge Project. All Rights Reserved.
-// SpatialFilters.cpp - reserved for reusable spatial filter implementations.
+// SpatialFilters.cpp - uniform-grid point index for radius and nearest queries.
 
+#include "Distribution/SpatialFilters.h"
+
+namespace
+{
+	// Cells per expected point before the cell size is widened; keeps sparse sets from allocating huge grids.
+	static constexpr int64 MaxCellsPerPoint = 4;
+	static constexpr int64 MinCellBudget = 1024;
+}
+
+FPointSpatialIndex::FPointSpatialIndex(const TArray<FVector>& InPoints, float InCellSize)
+{
+	FBox2D Rect(ForceInit);
+	for (const FVector& Point : InPoints)
+	{
+		Rect += FVector2D(Point.X, Point.Y);
+	}
+	Init(Rect, InCellSize, InPoints.Num());
+	for (const FVector& Point : InPoints)
+	{
+		Add(Point);
+	}
+}
+
+void FPointSpatialIndex::Init(const FBox2D& Rect, float InCellSize, int32 ExpectedPoints)
+{
+	const FVector2D Min = Rect.bIsValid ? Rect.Min : FVector2D::ZeroVector;
+	const FVector2D Size = Rect.bIsValid ? (Rect.Max - Rect.Min) : FVector2D::ZeroVector;
+
+	CellSize = FMath::Max(1.0, (double)InCellSize);
+	const double CellBudget = (double)FMath::Max<int64>(MinCellBudget, (int64)FMath::Max(ExpectedPoints, 0) * MaxCellsPerPoint);
+	const double Cells = FMath::Max(1.0, Size.X / CellSize) * FMath::Max(1.0, Size.Y / CellSize);
+	if (Cells > CellBudget)
+	{
+		CellSize *= FMath::Sqrt(Cells / CellBudget);
+	}
+	InvCellSize = 1.0 / CellSize;
+	Origin = Min;
+	Width = FMath::Max(1, FMath::FloorToInt32(Size.X * InvCellSize) + 1);
+	Height = FMath::Max(1, FMath::FloorToInt32(Size.Y * InvCellSize) + 1);
+
+	Heads.Init(INDEX_NONE, Width * Height);
+	Next.Reset(ExpectedPoints);
+	Points.Reset(ExpectedPoints);
+}
+
+int32 FPointSpatialIndex::Add(const FVector& Point)
+{
+	if (Width == 0)
+	{
+		Init(FBox2D(FVector2D(Point.X, Point.Y), FVector2D(Point.X, Point.Y)), 1.0f, 0);
+	}
+	const int32 Index = Points.Add(FVector2D(Point.X, Point.Y));
+	int32& Head = Heads[CellY(Point.Y) * Width + CellX(Point.X)];
+	Next.Add(Head);
+	Head = Index;
+	return Index;
+}
+
+bool FPointSpatialIndex::AnyWithin(const FVector& Query, float Radius) const
+{
+	if (Points.Num() == 0)
+	{
+		return false;
+	}
+	const FVector2D Q(Query.X, Query.Y);
+	const double RadiusSq = (double)Radius * Radius;
+	const int32 X0 = CellX(Q.X - Radius);
+	const int32 X1 = CellX(Q.X + Radius);
+	const int32 Y1 = CellY(Q.Y + Radius);
+	for (int32 Y = CellY(Q.Y - Radius); Y <= Y1; ++Y)
+	{
+		for (int32 X = X0; X <= X1; ++X)
+		{
+			for (int32 Index = Heads[Y * Width + X]; Index != INDEX_NONE; Index = Next[Index])
+			{
+				if (FVector2D::DistSquared(Q, Points[Index]) < RadiusSq)
+				{
+					return true;
+				}
+			}
+		}
+	}
+	return false;
+}
+
+int32 FPointSpatialIndex::FindNearest(const FVector& Query, float MaxRadius, float& OutDistSq, int32 IgnoreIndex) const
+{
+	OutDistSq = TNumericLimits<float>::Max();
+	if (Points.Num() == 0)
+	{
+		return INDEX_NONE;
+	}
+
+	const FVector2D Q(Query.X, Query.Y);
+	const int32 CX = CellX(Q.X);
+	const int32 CY = CellY(Q.Y);
+	const double LimitSq = MaxRadius >= 0.0f ? (double)MaxRadius * MaxRadius : TNumericLimits<double>::Max();
+	const int32 MaxRing = MaxRadius >= 0.0f
+		? FMath::Min(FMath::Max(Width, Height), FMath::CeilToInt32(MaxRadius * InvCellSize) + 1)
+		: FMath::Max(Width, Height);
+
+	double BestSq = LimitSq;
+	int32 Best = INDEX_NONE;
+	auto VisitCell = [&](int32 X, int32 Y)
+	{
+		for (int32 Index = Heads[Y * Width + X]; Index != INDEX_NONE; Index = Next[Index])
+		{
+			const double DistSq = FVector2D::DistSquared(Q, Points[Index]);
+			if (Index != IgnoreIndex && (DistSq < BestSq || (DistSq == BestSq && Best == INDEX_NONE)))
+			{
+				BestSq = DistSq;
+				Best = Index;
+			}
+		}
+	};
+
+	// Rings of cells around the query cell; every point in ring R is at least (R - 1) cells away.
+	for (int32 Ring = 0; Ring <= MaxRing; ++Ring)
+	{
+		if (Best != INDEX_NONE && FMath::Square((Ring - 1) * CellSize) > BestSq)
+		{
+			break;
+		}
+		const int32 X0 = CX - Ring;
+		const int32 X1 = CX + Ring;
+		const int32 Y0 = CY - Ring;
+		const int32 Y1 = CY + Ring;
+		for (int32 Y = FMath::Max(Y0, 0); Y <= FMath::Min(Y1, Height - 1); ++Y)
+		{
+			if (Y == Y0 || Y == Y1)
+			{
+				for (int32 X = FMath::Max(X0, 0); X <= FMath::Min(X1, Width - 1); ++X)
+				{
+					VisitCell(X, Y);
+				}
+				continue;
+			}
+			if (X0 >= 0)
+			{
+				VisitCell(X0, Y);
+			}
+			if (X1 < Width)
+			{
+				VisitCell(X1, Y);
+			}
+		}
+	}
+
+	if (Best != INDEX_NONE)
+	{
+		OutDistSq = (float)BestSq;
+	}
+	return Best;
+}
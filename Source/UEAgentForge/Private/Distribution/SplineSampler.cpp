@@ -0,0 +1,199 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// SplineSampler.cpp - curve capture, arc-length table, parallel sampling.
+
+#include "Distribution/SplineSampler.h"
+
+#include "AgentForgeTrace.h"
+#include "Distribution/PointCloud.h"
+
+#include "Algo/BinarySearch.h"
+#include "Async/ParallelFor.h"
+#include "Components/SplineComponent.h"
+#include "Misc/SecureHash.h"
+
+namespace
+{
+	static constexpr float MinSpacing = 1.0f;
+
+	/** Samples below this count are evaluated on the calling thread. */
+	static constexpr int32 ParallelThreshold = 2048;
+}
+
+FSplineSampler FSplineSampler::FromComponent(const USplineComponent& Spline)
+{
+	FSplineSampler Sampler;
+	const FTransform& ToWorld = Spline.GetComponentTransform();
+	Sampler.Curve = Spline.GetSplinePointsPosition();
+	for (FInterpCurvePoint<FVector>& Point : Sampler.Curve.Points)
+	{
+		Point.OutVal = ToWorld.TransformPosition(Point.OutVal);
+		Point.ArriveTangent = ToWorld.TransformVector(Point.ArriveTangent);
+		Point.LeaveTangent = ToWorld.TransformVector(Point.LeaveTangent);
+	}
+	Sampler.BuildTable();
+	return Sampler;
+}
+
+FSplineSampler FSplineSampler::FromPoints(const TArray<FVector>& Points, bool bClosedLoop)
+{
+	FSplineSampler Sampler;
+	Sampler.Curve.Points.Reserve(Points.Num());
+	for (int32 Index = 0; Index < Points.Num(); ++Index)
+	{
+		Sampler.Curve.Points.Emplace((float)Index, Points[Index], FVector::ZeroVector, FVector::ZeroVector, CIM_CurveAuto);
+	}
+	if (bClosedLoop && Points.Num() > 1)
+	{
+		Sampler.Curve.SetLoopKey((float)Points.Num());
+	}
+	Sampler.Curve.AutoSetTangents(0.0f, false);
+	Sampler.BuildTable();
+	return Sampler;
+}
+
+void FSplineSampler::BuildTable()
+{
+	Keys.Reset();
+	Distances.Reset();
+	Bounds = FBox(ForceInit);
+
+	const TArray<FInterpCurvePoint<FVector>>& Points = Curve.Points;
+	const int32 NumSegments = Curve.bIsLooped ? Points.Num() : Points.Num() - 1;
+	if (Points.Num() < 2 || NumSegments < 1)
+	{
+		return;
+	}
+
+	Keys.Reserve(NumSegments * StepsPerSegment + 1);
+	Distances.Reserve(NumSegments * StepsPerSegment + 1);
+	FVector Previous = Curve.Eval(Points[0].InVal, FVector::ZeroVector);
+	float Length = 0.0f;
+	Keys.Add(Points[0].InVal);
+	Distances.Add(0.0f);
+	Bounds += Previous;
+	for (int32 Segment = 0; Segment < NumSegments; ++Segment)
+	{
+		const float StartKey = Points[Segment].InVal;
+		const float EndKey = Segment + 1 < Points.Num() ? Points[Segment + 1].InVal : Points[0].InVal + Curve.LoopKeyOffset;
+		for (int32 Step = 1; Step <= StepsPerSegment; ++Step)
+		{
+			const float Key = FMath::Lerp(StartKey, EndKey, (float)Step / (float)StepsPerSegment);
+			const FVector Position = Curve.Eval(Key, FVector::ZeroVector);
+			Length += (float)FVector::Dist(Previous, Position);
+			Keys.Add(Key);
+			Distances.Add(Length);
+			Bounds += Position;
+			Previous = Position;
+		}
+	}
+}
+
+FString FSplineSampler::GetFingerprint() const
+{
+	FSHA1 Sha;
+	auto AddVector = [&Sha](const FVector& Value)
+	{
+		const double Components[3] = { Value.X, Value.Y, Value.Z };
+		Sha.Update(reinterpret_cast<const uint8*>(Components), sizeof(Components));
+	};
+	for (const FInterpCurvePoint<FVector>& Point : Curve.Points)
+	{
+		Sha.Update(reinterpret_cast<const uint8*>(&Point.InVal), sizeof(Point.InVal));
+		AddVector(Point.OutVal);
+		AddVector(Point.ArriveTangent);
+		AddVector(Point.LeaveTangent);
+		const uint8 Mode = (uint8)Point.InterpMode;
+		Sha.Update(&Mode, 1);
+	}
+	const float LoopOffset = Curve.bIsLooped ? Curve.LoopKeyOffset : -1.0f;
+	Sha.Update(reinterpret_cast<const uint8*>(&LoopOffset), sizeof(LoopOffset));
+	Sha.Final();
+
+	FSHAHash Hash;
+	Sha.GetHash(Hash.Hash);
+	return Hash.ToString().ToLower();
+}
+
+float FSplineSampler::KeyAtDistance(float Distance) const
+{
+	if (!IsValid())
+	{
+		return Keys.Num() > 0 ? Keys[0] : 0.0f;
+	}
+	Distance = FMath::Clamp(Distance, 0.0f, GetLength());
+	const int32 Upper = FMath::Clamp(Algo::UpperBound(Distances, Distance), 1, Distances.Num() - 1);
+	const float Span = Distances[Upper] - Distances[Upper - 1];
+	const float Alpha = Span > KINDA_SMALL_NUMBER ? (Distance - Distances[Upper - 1]) / Span : 0.0f;
+	return FMath::Lerp(Keys[Upper - 1], Keys[Upper], Alpha);
+}
+
+FSplineSample FSplineSampler::SampleAtDistance(float Distance) const
+{
+	const float Key = KeyAtDistance(Distance);
+
+	FSplineSample Sample;
+	Sample.Distance = FMath::Clamp(Distance, 0.0f, GetLength());
+	Sample.Position = Curve.Eval(Key, FVector::ZeroVector);
+	Sample.Tangent = Curve.EvalDerivative(Key, FVector::ZeroVector).GetSafeNormal(UE_SMALL_NUMBER, FVector::ForwardVector);
+	const FVector Up = FMath::Abs(Sample.Tangent.Z) > 0.999f ? FVector::ForwardVector : FVector::UpVector;
+	Sample.Right = FVector::CrossProduct(Up, Sample.Tangent).GetSafeNormal();
+	Sample.Normal = FVector::CrossProduct(Sample.Tangent, Sample.Right);
+	return Sample;
+}
+
+int32 FSplineSampler::NumSamples(const FSplineSampleSettings& Settings) const
+{
+	const float Length = GetLength();
+	const float Start = FMath::Max(0.0f, Settings.StartOffset);
+	if (!IsValid() || Start > Length)
+	{
+		return 0;
+	}
+	const float Spacing = FMath::Max(MinSpacing, Settings.Spacing);
+	int32 Count = FMath::FloorToInt((Length - Start) / Spacing) + 1;
+	// A closed loop's end is its start; do not sample it twice.
+	if (Curve.bIsLooped && Count > 1 && Start + (Count - 1) * Spacing >= Length - KINDA_SMALL_NUMBER)
+	{
+		--Count;
+	}
+	const int32 Lanes = FMath::Max(1, Settings.LaneOffsets.Num());
+	return FMath::Min(Count, FMath::Max(0, Settings.MaxSamples) / Lanes) * Lanes;
+}
+
+TArray<FSplineSample> FSplineSampler::Sample(const FSplineSampleSettings& Settings) const
+{
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Distribution.SampleSpline");
+	const int32 Lanes = FMath::Max(1, Settings.LaneOffsets.Num());
+	const int32 Count = NumSamples(Settings) / Lanes;
+	const float Start = FMath::Max(0.0f, Settings.StartOffset);
+	const float Spacing = FMath::Max(MinSpacing, Settings.Spacing);
+
+	TArray<FSplineSample> Samples;
+	Samples.SetNum(Count * Lanes);
+	ParallelFor(Count, [&](int32 Index)
+	{
+		const FSplineSample Center = SampleAtDistance(Start + Index * Spacing);
+		for (int32 Lane = 0; Lane < Lanes; ++Lane)
+		{
+			FSplineSample& Out = Samples[Index * Lanes + Lane];
+			Out = Center;
+			Out.Lane = Lane;
+			if (Settings.LaneOffsets.Num() > 0)
+			{
+				Out.Position += Center.Right * Settings.LaneOffsets[Lane];
+			}
+		}
+	}, Count < ParallelThreshold ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+	return Samples;
+}
+
+FPointCloud FSplineSampler::ToPointCloud(const TArray<FSplineSample>& Samples)
+{
+	FPointCloud Cloud;
+	Cloud.Reset(Samples.Num());
+	for (const FSplineSample& Sample : Samples)
+	{
+		Cloud.Add(Sample.Position);
+	}
+	return Cloud;
+}
@@ -1,7 +1,8 @@
 // UEAgentForge — FabIntegrationModule.cpp
-// Fab.com marketplace search + local asset import pipeline.
+// Fab.com marketplace search + local asset import pipeline + batched download/import.
 
 #include "FabIntegrationModule.h"
+#include "AgentForgeJobManager.h"
 #include "Dom/JsonObject.h"
 #include "Dom/JsonValue.h"
 #include "Serialization/JsonReader.h"
@@ -20,6 +21,10 @@
 #include "Factories/TextureFactory.h"
 #include "Factories/SoundFactory.h"
 #include "EditorFramework/AssetImportData.h"
+#include "AssetImportTask.h"
+#include "FileHelpers.h"                              // UEditorLoadingAndSavingUtils::SavePackages
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
 // HTTP for Fab search
@@ -51,6 +56,70 @@ static FString FabJson(const TSharedPtr<FJsonObject>& O)
 	return Out;
 }
 
+namespace
+{
+	struct FFabSearchCacheEntry
+	{
+		TSharedPtr<FJsonObject> Response;
+		double StoredSeconds = 0.0;
+	};
+
+	struct FFabState
+	{
+		TMap<FString, FFabSearchCacheEntry> SearchCache;   // by lowercased query|max_results|free_only
+		int64 SearchQueries = 0;
+		int64 SearchCacheHits = 0;
+		int64 Batches = 0;
+		int64 Downloads = 0;
+		int64 DownloadsResumed = 0;
+		int64 DownloadFailures = 0;
+		int64 BytesDownloaded = 0;
+		int64 Imports = 0;
+		int64 ImportFailures = 0;
+	};
+
+	static FFabState& GetFabState()
+	{
+		static FFabState State;
+		return State;
+	}
+
+	static constexpr int32  MaxSearchCacheEntries = 64;
+	static constexpr double DefaultSearchCacheTtlSeconds = 300.0;
+}
+
+#if WITH_EDITOR
+/** Import factory by file extension; null lets AssetTools pick one. */
+static UFactory* MakeImportFactory(const FString& Ext)
+{
+	if (Ext == TEXT("fbx") || Ext == TEXT("obj"))
+	{
+		UFbxFactory* FbxFact = NewObject<UFbxFactory>(GetTransientPackage());
+		if (FbxFact)
+		{
+			UFbxImportUI* ImportUI = NewObject<UFbxImportUI>(FbxFact);
+			ImportUI->bImportMesh            = true;
+			ImportUI->bImportAnimations      = false;
+			ImportUI->bImportMaterials       = true;
+			ImportUI->bImportTextures        = true;
+			ImportUI->StaticMeshImportData->bCombineMeshes = true;
+			FbxFact->ImportUI = ImportUI;
+		}
+		return FbxFact;
+	}
+	if (Ext == TEXT("png") || Ext == TEXT("jpg") || Ext == TEXT("jpeg") ||
+	    Ext == TEXT("tga") || Ext == TEXT("bmp") || Ext == TEXT("exr"))
+	{
+		return NewObject<UTextureFactory>(GetTransientPackage());
+	}
+	if (Ext == TEXT("wav"))
+	{
+		return NewObject<USoundFactory>(GetTransientPackage());
+	}
+	return nullptr;
+}
+#endif
+
 // ============================================================================
 //  SEARCH_FAB_ASSETS
 // ============================================================================
@@ -69,6 +138,26 @@ FString FFabIntegrationModule::SearchFabAssets(const TSharedPtr<FJsonObject>& Ar
 		? (int32)Args->GetNumberField(TEXT("max_results")) : 20;
 	const bool bFreeOnly = Args->HasField(TEXT("free_only"))
 		? Args->GetBoolField(TEXT("free_only")) : true;
+	double CacheTtlSeconds = DefaultSearchCacheTtlSeconds;
+	Args->TryGetNumberField(TEXT("cache_ttl_seconds"), CacheTtlSeconds);
+
+	// ── Result cache — browsing repeats the same queries ─────────────────────
+	FFabState& State = GetFabState();
+	++State.SearchQueries;
+	const FString CacheKey = FString::Printf(TEXT("%s|%d|%d"), *Query.ToLower(), MaxResults, bFreeOnly ? 1 : 0);
+	if (const FFabSearchCacheEntry* Cached = State.SearchCache.Find(CacheKey))
+	{
+		const double AgeSeconds = FPlatformTime::Seconds() - Cached->StoredSeconds;
+		if (CacheTtlSeconds > 0.0 && AgeSeconds < CacheTtlSeconds)
+		{
+			++State.SearchCacheHits;
+			TSharedPtr<FJsonObject> Hit = MakeShared<FJsonObject>();
+			Hit->Values = Cached->Response->Values;
+			Hit->SetBoolField  (TEXT("cached"),            true);
+			Hit->SetNumberField(TEXT("cache_age_seconds"), AgeSeconds);
+			return FabJson(Hit);
+		}
+	}
 
 	// ── Synchronous HTTP request to Fab.com listing search ───────────────────
 	// NOTE: Fab.com does not have a public documented API. This uses their
@@ -188,6 +277,7 @@ FString FFabIntegrationModule::SearchFabAssets(const TSharedPtr<FJsonObject>& Ar
 	Out->SetNumberField(TEXT("count"),      ResultsArr.Num());
 	Out->SetBoolField  (TEXT("free_only"),  bFreeOnly);
 	Out->SetArrayField (TEXT("results"),    ResultsArr);
+	Out->SetBoolField  (TEXT("cached"),     false);
 
 	if (ResultsArr.IsEmpty())
 	{
@@ -196,6 +286,24 @@ FString FFabIntegrationModule::SearchFabAssets(const TSharedPtr<FJsonObject>& Ar
 			     "have changed. Try searching at https://www.fab.com directly."));
 	}
 
+	// Only answers the server actually gave are cached; failures retry next call.
+	if (ResponseCode == 200)
+	{
+		if (State.SearchCache.Num() >= MaxSearchCacheEntries && !State.SearchCache.Contains(CacheKey))
+		{
+			FString Oldest;
+			double OldestSeconds = TNumericLimits<double>::Max();
+			for (const TPair<FString, FFabSearchCacheEntry>& Entry : State.SearchCache)
+			{
+				if (Entry.Value.StoredSeconds < OldestSeconds) { OldestSeconds = Entry.Value.StoredSeconds; Oldest = Entry.Key; }
+			}
+			State.SearchCache.Remove(Oldest);
+		}
+		FFabSearchCacheEntry& Entry = State.SearchCache.FindOrAdd(CacheKey);
+		Entry.Response      = Out;
+		Entry.StoredSeconds = FPlatformTime::Seconds();
+	}
+
 	return FabJson(Out);
 #else
 	return FabError(TEXT("Editor only."));
@@ -248,33 +356,7 @@ FString FFabIntegrationModule::ImportLocalAsset(const TSharedPtr<FJsonObject>& A
 		return FabError(FString::Printf(TEXT("File not found: %s"), *FilePath));
 
 	// Determine factory by file extension
-	FString Ext = FPaths::GetExtension(FilePath).ToLower();
-	UFactory* Factory = nullptr;
-
-	if (Ext == TEXT("fbx") || Ext == TEXT("obj"))
-	{
-		UFbxFactory* FbxFact = NewObject<UFbxFactory>(GetTransientPackage());
-		if (FbxFact)
-		{
-			UFbxImportUI* ImportUI = NewObject<UFbxImportUI>(FbxFact);
-			ImportUI->bImportMesh            = true;
-			ImportUI->bImportAnimations      = false;
-			ImportUI->bImportMaterials       = true;
-			ImportUI->bImportTextures        = true;
-			ImportUI->StaticMeshImportData->bCombineMeshes = true;
-			FbxFact->ImportUI = ImportUI;
-			Factory = FbxFact;
-		}
-	}
-	else if (Ext == TEXT("png") || Ext == TEXT("jpg") || Ext == TEXT("jpeg") ||
-	         Ext == TEXT("tga") || Ext == TEXT("bmp") || Ext == TEXT("exr"))
-	{
-		Factory = NewObject<UTextureFactory>(GetTransientPackage());
-	}
-	else if (Ext == TEXT("wav"))
-	{
-		Factory = NewObject<USoundFactory>(GetTransientPackage());
-	}
+	UFactory* Factory = MakeImportFactory(FPaths::GetExtension(FilePath).ToLower());
 
 	// Use AssetTools to import
 	FAssetToolsModule& AssetToolsModule =
@@ -311,6 +393,500 @@ FString FFabIntegrationModule::ImportLocalAsset(const TSharedPtr<FJsonObject>& A
 #endif
 }
 
+// ============================================================================
+//  IMPORT_ASSET_BATCH
+// ============================================================================
+#if WITH_EDITOR
+namespace
+{
+	static constexpr int32  MaxBatchAssets        = 256;
+	static constexpr int32  MaxChunkAttempts      = 4;
+	static constexpr float  ChunkTimeoutSeconds   = 120.0f;
+
+	struct FFabBatchItem
+	{
+		FString Url;              // empty for local files
+		FString LocalFile;        // download target, or the caller's file
+		FString PartFile;         // download in progress; kept on failure so a rerun resumes
+		FString DestPath;
+		int64   Received = 0;
+		int64   Total = -1;       // from Content-Range; -1 until the server reports it
+		int32   Attempts = 0;
+		bool    bStarted = false;
+		bool    bResumed = false;
+		bool    bReused = false;  // finished download from an earlier batch
+		bool    bDone = false;    // on disk and ready to import
+		bool    bFailed = false;
+		FString Error;
+		FHttpRequestPtr Request;
+		TArray<FString> ImportedPaths;
+	};
+
+	class FFabBatchRun : public TSharedFromThis<FFabBatchRun>
+	{
+	public:
+		TArray<FFabBatchItem> Items;   // fixed after Parse; HTTP callbacks hold indices
+		int32  MaxConcurrent = 4;
+		int64  ChunkBytes = 8ll * 1024 * 1024;
+		double TimeoutSeconds = 600.0;
+		bool   bSave = true;
+		bool   bReplaceExisting = true;
+		bool   bInline = false;
+		double StartSeconds = 0.0;
+		int64  BytesDownloaded = 0;
+		int32  InFlight = 0;
+		TArray<FString> SavedPackages;
+
+		bool Parse(const TSharedPtr<FJsonObject>& Args, FString& OutError)
+		{
+			if (!Args.IsValid())
+			{
+				OutError = TEXT("import_asset_batch: invalid args.");
+				return false;
+			}
+			const TArray<TSharedPtr<FJsonValue>>* Assets = nullptr;
+			if (!Args->TryGetArrayField(TEXT("assets"), Assets) || Assets->IsEmpty())
+			{
+				OutError = TEXT("import_asset_batch requires a non-empty 'assets' array.");
+				return false;
+			}
+			if (Assets->Num() > MaxBatchAssets)
+			{
+				OutError = FString::Printf(TEXT("import_asset_batch: at most %d assets per batch."), MaxBatchAssets);
+				return false;
+			}
+
+			FString DefaultDest = TEXT("/Game/FabImports");
+			Args->TryGetStringField(TEXT("destination_path"), DefaultDest);
+			double Number = 0.0;
+			if (Args->TryGetNumberField(TEXT("max_concurrent"), Number))  { MaxConcurrent = FMath::Clamp(static_cast<int32>(Number), 1, 16); }
+			if (Args->TryGetNumberField(TEXT("chunk_mb"), Number))        { ChunkBytes = static_cast<int64>(FMath::Clamp(Number, 1.0, 256.0) * 1024.0 * 1024.0); }
+			if (Args->TryGetNumberField(TEXT("timeout_seconds"), Number)) { TimeoutSeconds = FMath::Max(Number, 1.0); }
+			Args->TryGetBoolField(TEXT("save"),             bSave);
+			Args->TryGetBoolField(TEXT("replace_existing"), bReplaceExisting);
+
+			const FString DownloadDir = FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir() / TEXT("AgentForge/Downloads"));
+			for (const TSharedPtr<FJsonValue>& Value : *Assets)
+			{
+				FFabBatchItem& Item = Items.AddDefaulted_GetRef();
+				Item.DestPath = DefaultDest;
+
+				FString FilePath, FileName;
+				const TSharedPtr<FJsonObject>* Entry = nullptr;
+				if (Value->TryGetObject(Entry))
+				{
+					(*Entry)->TryGetStringField(TEXT("url"),              Item.Url);
+					(*Entry)->TryGetStringField(TEXT("file_path"),        FilePath);
+					(*Entry)->TryGetStringField(TEXT("file_name"),        FileName);
+					(*Entry)->TryGetStringField(TEXT("destination_path"), Item.DestPath);
+				}
+				else if (Value->TryGetString(FilePath) &&
+				         (FilePath.StartsWith(TEXT("http://")) || FilePath.StartsWith(TEXT("https://"))))
+				{
+					Item.Url = FilePath;
+					FilePath.Reset();
+				}
+
+				if (!Item.Url.IsEmpty())
+				{
+					if (FileName.IsEmpty())
+					{
+						FString UrlPath = Item.Url;
+						int32 QueryStart = INDEX_NONE;
+						if (UrlPath.FindChar(TEXT('?'), QueryStart)) { UrlPath.LeftInline(QueryStart); }
+						FileName = FPaths::GetCleanFilename(UrlPath);
+					}
+					FileName = FPaths::MakeValidFileName(FileName);
+					if (FPaths::GetExtension(FileName).IsEmpty())
+					{
+						Item.bFailed = true;
+						Item.Error   = TEXT("Cannot tell the file type from the URL; pass file_name with an extension.");
+						continue;
+					}
+					// One folder per URL: equal file names from different sources cannot collide,
+					// and a rerun of the same batch finds its .part files.
+					Item.LocalFile = DownloadDir / FString::Printf(TEXT("%08x"), FCrc::StrCrc32(*Item.Url)) / FileName;
+					Item.PartFile  = Item.LocalFile + TEXT(".part");
+				}
+				else if (!FilePath.IsEmpty())
+				{
+					Item.LocalFile = FilePath;
+					Item.bDone     = FPaths::FileExists(FilePath);
+					Item.bFailed   = !Item.bDone;
+					if (Item.bFailed) { Item.Error = FString::Printf(TEXT("File not found: %s"), *FilePath); }
+				}
+				else
+				{
+					Item.bFailed = true;
+					Item.Error   = TEXT("Entry needs 'url' or 'file_path'.");
+				}
+			}
+
+			++GetFabState().Batches;
+			StartSeconds = FPlatformTime::Seconds();
+			return true;
+		}
+
+		/** Fills free request slots; true once every item is downloaded or has failed. */
+		bool PumpDownloads()
+		{
+			const bool bTimedOut = FPlatformTime::Seconds() - StartSeconds > TimeoutSeconds;
+			bool bAllDone = true;
+			for (int32 Index = 0; Index < Items.Num(); ++Index)
+			{
+				FFabBatchItem& Item = Items[Index];
+				if (Item.bDone || Item.bFailed) { continue; }
+				if (bTimedOut)
+				{
+					CancelRequest(Item);
+					FailItem(Item, FString::Printf(TEXT("Batch timed out after %.0f s; rerun to resume."), TimeoutSeconds));
+					continue;
+				}
+				bAllDone = false;
+				if (!Item.bStarted && InFlight < MaxConcurrent)
+				{
+					BeginDownload(Index);
+				}
+			}
+			return bAllDone;
+		}
+
+		float DownloadProgress() const
+		{
+			float Done = 0.0f;
+			for (const FFabBatchItem& Item : Items)
+			{
+				if (Item.bDone || Item.bFailed) { Done += 1.0f; }
+				else if (Item.Total > 0)        { Done += static_cast<float>(static_cast<double>(Item.Received) / static_cast<double>(Item.Total)); }
+			}
+			return Items.Num() > 0 ? Done / Items.Num() : 1.0f;
+		}
+
+		/** In-flight requests are dropped; their .part files stay for the next run. */
+		void CancelDownloads()
+		{
+			for (FFabBatchItem& Item : Items)
+			{
+				CancelRequest(Item);
+			}
+		}
+
+		/** Every ready file in one ImportAssetTasks call, then one save pass over the new packages. */
+		void ImportAll()
+		{
+			TArray<UAssetImportTask*> Tasks;
+			TArray<int32> TaskItems;
+			for (int32 Index = 0; Index < Items.Num(); ++Index)
+			{
+				const FFabBatchItem& Item = Items[Index];
+				if (!Item.bDone) { continue; }
+
+				UAssetImportTask* Task = NewObject<UAssetImportTask>();
+				Task->AddToRoot();   // nothing else references the tasks while the import runs
+				Task->Filename         = Item.LocalFile;
+				Task->DestinationPath  = Item.DestPath;
+				Task->bAutomated       = true;
+				Task->bSave            = false;   // saved together below
+				Task->bReplaceExisting = bReplaceExisting;
+				Task->Factory          = MakeImportFactory(FPaths::GetExtension(Item.LocalFile).ToLower());
+				Tasks.Add(Task);
+				TaskItems.Add(Index);
+			}
+			if (Tasks.IsEmpty()) { return; }
+
+			IAssetTools& AssetTools = FModuleManager::LoadModuleChecked<FAssetToolsModule>(TEXT("AssetTools")).Get();
+			AssetTools.ImportAssetTasks(Tasks);
+
+			FFabState& State = GetFabState();
+			TArray<UPackage*> Packages;
+			for (int32 TaskIndex = 0; TaskIndex < Tasks.Num(); ++TaskIndex)
+			{
+				FFabBatchItem& Item = Items[TaskItems[TaskIndex]];
+				for (UObject* Object : Tasks[TaskIndex]->GetObjects())
+				{
+					if (!Object) { continue; }
+					Item.ImportedPaths.Add(Object->GetPathName());
+					Packages.AddUnique(Object->GetOutermost());
+				}
+				if (Item.ImportedPaths.IsEmpty())
+				{
+					Item.bFailed = true;
+					Item.Error   = FString::Printf(TEXT("Import failed for '%s'. Check the file format and destination path."), *Item.LocalFile);
+					++State.ImportFailures;
+				}
+				else
+				{
+					++State.Imports;
+				}
+				Tasks[TaskIndex]->RemoveFromRoot();
+			}
+
+			if (bSave && Packages.Num() > 0)
+			{
+				UEditorLoadingAndSavingUtils::SavePackages(Packages, /*bOnlyDirty=*/false);
+				for (const UPackage* Package : Packages)
+				{
+					SavedPackages.Add(Package->GetName());
+				}
+			}
+		}
+
+		TSharedPtr<FJsonObject> ToJson() const
+		{
+			int32 Imported = 0, Failed = 0, Resumed = 0;
+			TArray<TSharedPtr<FJsonValue>> ItemArr;
+			for (const FFabBatchItem& Item : Items)
+			{
+				Imported += Item.ImportedPaths.IsEmpty() ? 0 : 1;
+				Failed   += Item.bFailed ? 1 : 0;
+				Resumed  += Item.bResumed ? 1 : 0;
+
+				TSharedPtr<FJsonObject> Entry = MakeShared<FJsonObject>();
+				Entry->SetStringField(TEXT("source"),     Item.Url.IsEmpty() ? Item.LocalFile : Item.Url);
+				Entry->SetStringField(TEXT("local_file"), Item.LocalFile);
+				Entry->SetStringField(TEXT("status"),     Item.bFailed ? TEXT("failed") : (Item.ImportedPaths.IsEmpty() ? TEXT("pending") : TEXT("imported")));
+				if (!Item.Url.IsEmpty())
+				{
+					Entry->SetNumberField(TEXT("bytes"),   static_cast<double>(Item.Received));
+					Entry->SetBoolField  (TEXT("resumed"), Item.bResumed);
+					Entry->SetBoolField  (TEXT("reused"),  Item.bReused);
+				}
+				TArray<TSharedPtr<FJsonValue>> PathArr;
+				for (const FString& Path : Item.ImportedPaths)
+				{
+					PathArr.Add(MakeShared<FJsonValueString>(Path));
+				}
+				Entry->SetArrayField(TEXT("assets"), PathArr);
+				if (!Item.Error.IsEmpty()) { Entry->SetStringField(TEXT("error"), Item.Error); }
+				ItemArr.Add(MakeShared<FJsonValueObject>(Entry));
+			}
+
+			TArray<TSharedPtr<FJsonValue>> PackageArr;
+			for (const FString& Package : SavedPackages)
+			{
+				PackageArr.Add(MakeShared<FJsonValueString>(Package));
+			}
+
+			TSharedPtr<FJsonObject> Out = MakeShared<FJsonObject>();
+			Out->SetBoolField  (TEXT("ok"),               Failed == 0);
+			Out->SetNumberField(TEXT("count"),            Items.Num());
+			Out->SetNumberField(TEXT("imported"),         Imported);
+			Out->SetNumberField(TEXT("failed"),           Failed);
+			Out->SetNumberField(TEXT("resumed"),          Resumed);
+			Out->SetNumberField(TEXT("bytes_downloaded"), static_cast<double>(BytesDownloaded));
+			Out->SetNumberField(TEXT("max_concurrent"),   MaxConcurrent);
+			Out->SetArrayField (TEXT("saved_packages"),   PackageArr);
+			Out->SetNumberField(TEXT("elapsed_ms"),       (FPlatformTime::Seconds() - StartSeconds) * 1000.0);
+			Out->SetArrayField (TEXT("items"),            ItemArr);
+			return Out;
+		}
+
+	private:
+		void BeginDownload(int32 Index)
+		{
+			FFabBatchItem& Item = Items[Index];
+			Item.bStarted = true;
+
+			IFileManager& FileManager = IFileManager::Get();
+			if (FileManager.FileExists(*Item.LocalFile))
+			{
+				Item.bReused  = true;
+				Item.bDone    = true;
+				Item.Received = FileManager.FileSize(*Item.LocalFile);
+				return;
+			}
+			FileManager.MakeDirectory(*FPaths::GetPath(Item.LocalFile), /*Tree=*/true);
+			const int64 PartSize = FileManager.FileSize(*Item.PartFile);
+			if (PartSize > 0)
+			{
+				Item.Received = PartSize;
+				Item.bResumed = true;
+				++GetFabState().DownloadsResumed;
+			}
+			RequestChunk(Index);
+		}
+
+		void RequestChunk(int32 Index)
+		{
+			FFabBatchItem& Item = Items[Index];
+			FHttpRequestRef Request = FHttpModule::Get().CreateRequest();
+			Request->SetURL(Item.Url);
+			Request->SetVerb(TEXT("GET"));
+			Request->SetHeader(TEXT("User-Agent"), TEXT("UEAgentForge/0.2.0 (Unreal Engine Editor)"));
+			Request->SetHeader(TEXT("Range"), FString::Printf(TEXT("bytes=%lld-%lld"), Item.Received, Item.Received + ChunkBytes - 1));
+			Request->SetTimeout(ChunkTimeoutSeconds);
+
+			TWeakPtr<FFabBatchRun> WeakRun = AsShared();
+			Request->OnProcessRequestComplete().BindLambda(
+				[WeakRun, Index](FHttpRequestPtr, FHttpResponsePtr Response, bool bSucceeded)
+				{
+					if (const TSharedPtr<FFabBatchRun> Run = WeakRun.Pin())
+					{
+						Run->HandleChunk(Index, Response, bSucceeded);
+					}
+				});
+			Item.Request = Request;
+			++InFlight;
+			Request->ProcessRequest();
+		}
+
+		void HandleChunk(int32 Index, const FHttpResponsePtr& Response, bool bSucceeded)
+		{
+			FFabBatchItem& Item = Items[Index];
+			if (!Item.Request.IsValid()) { return; }   // cancelled or timed out meanwhile
+			Item.Request.Reset();
+			--InFlight;
+
+			const int32 Code = (bSucceeded && Response.IsValid()) ? Response->GetResponseCode() : 0;
+			if (Code == 200 || Code == 206)
+			{
+				// 200: the server ignored Range and sent the whole file, replacing any partial data.
+				const TArray<uint8>& Content = Response->GetContent();
+				if (!FFileHelper::SaveArrayToFile(Content, *Item.PartFile, &IFileManager::Get(), Code == 206 ? FILEWRITE_Append : FILEWRITE_None))
+				{
+					FailItem(Item, FString::Printf(TEXT("Could not write %s."), *Item.PartFile));
+					return;
+				}
+				Item.Received = (Code == 206 ? Item.Received : 0) + Content.Num();
+				Item.Attempts = 0;
+				BytesDownloaded += Content.Num();
+				GetFabState().BytesDownloaded += Content.Num();
+
+				if (Code == 206)
+				{
+					// Content-Range: bytes <first>-<last>/<total>
+					const FString Range = Response->GetHeader(TEXT("Content-Range"));
+					int32 Slash = INDEX_NONE;
+					if (Range.FindLastChar(TEXT('/'), Slash) && Range.Mid(Slash + 1).IsNumeric())
+					{
+						Item.Total = FCString::Atoi64(*Range.Mid(Slash + 1));
+					}
+				}
+				const bool bComplete = Code == 200 ||
+					(Item.Total >= 0 ? Item.Received >= Item.Total : Content.Num() < ChunkBytes);
+				if (bComplete) { FinishDownload(Item); }
+				else           { RequestChunk(Index); }
+				return;
+			}
+
+			// The .part already holds the whole file: an earlier run stopped between the last chunk and the rename.
+			if (Code == 416 && Item.Received > 0)
+			{
+				FinishDownload(Item);
+				return;
+			}
+
+			const bool bTransient = Code == 0 || Code == 408 || Code == 429 || Code >= 500;
+			if (bTransient && ++Item.Attempts < MaxChunkAttempts)
+			{
+				RequestChunk(Index);
+				return;
+			}
+			FailItem(Item, Code == 0 ? TEXT("No response; rerun to resume.") : FString::Printf(TEXT("HTTP %d."), Code));
+		}
+
+		void FinishDownload(FFabBatchItem& Item)
+		{
+			if (!IFileManager::Get().Move(*Item.LocalFile, *Item.PartFile, /*bReplace=*/true))
+			{
+				FailItem(Item, FString::Printf(TEXT("Could not move %s into place."), *Item.PartFile));
+				return;
+			}
+			Item.bDone = true;
+			++GetFabState().Downloads;
+		}
+
+		void CancelRequest(FFabBatchItem& Item)
+		{
+			if (!Item.Request.IsValid()) { return; }
+			const FHttpRequestPtr Request = MoveTemp(Item.Request);
+			Item.Request.Reset();
+			--InFlight;
+			Request->OnProcessRequestComplete().Unbind();
+			Request->CancelRequest();
+		}
+
+		void FailItem(FFabBatchItem& Item, const FString& Error)
+		{
+			Item.bFailed = true;
+			Item.Error   = Error;
+			++GetFabState().DownloadFailures;
+		}
+	};
+}
+
+static TSharedRef<FAgentForgeJob> BuildImportAssetBatchJob(const TSharedPtr<FJsonObject>& Args, bool bInline)
+{
+	TSharedRef<FAgentForgeJob> Job = MakeShared<FAgentForgeJob>(TEXT("import_asset_batch"));
+	TSharedRef<FFabBatchRun> Run = MakeShared<FFabBatchRun>();
+	Run->bInline = bInline;
+	FString ParseError;
+	const bool bParsed = Run->Parse(Args, ParseError);
+
+	// ── Stage: download — every url entry, max_concurrent at a time ──────────
+	Job->AddStage(TEXT("download"), [Run, bParsed, ParseError](FAgentForgeJob& J)
+	{
+		if (!bParsed)
+		{
+			J.Finish(FabError(ParseError));
+			return true;
+		}
+		if (Run->PumpDownloads())
+		{
+			return true;
+		}
+		J.SetStageProgress(Run->DownloadProgress());
+		if (Run->bInline)
+		{
+			// The command is blocking the game thread, so nothing else ticks HTTP.
+			FHttpModule::Get().GetHttpManager().Tick(0.05f);
+			FPlatformProcess::Sleep(0.05f);
+		}
+		else
+		{
+			J.YieldSlice();
+		}
+		return false;
+	}, 3.0f);
+
+	// ── Stage: import — one AssetTools batch and one save pass ───────────────
+	Job->AddStage(TEXT("import"), [Run](FAgentForgeJob&)
+	{
+		Run->ImportAll();
+		return true;
+	});
+	Job->SetCancelHandler([Run](FAgentForgeJob&)
+	{
+		Run->CancelDownloads();
+	});
+	Job->SetFinalizer([Run](FAgentForgeJob&) -> FString
+	{
+		return FabJson(Run->ToJson());
+	});
+	return Job;
+}
+#endif
+
+FString FFabIntegrationModule::ImportAssetBatch(const TSharedPtr<FJsonObject>& Args)
+{
+#if WITH_EDITOR
+	return BuildImportAssetBatchJob(Args, /*bInline=*/true)->RunToCompletion();
+#else
+	return FabError(TEXT("Editor only."));
+#endif
+}
+
+TSharedRef<FAgentForgeJob> FFabIntegrationModule::MakeImportAssetBatchJob(const TSharedPtr<FJsonObject>& Args)
+{
+#if WITH_EDITOR
+	return BuildImportAssetBatchJob(Args, /*bInline=*/false);
+#else
+	TSharedRef<FAgentForgeJob> Job = MakeShared<FAgentForgeJob>(TEXT("import_asset_batch"));
+	Job->AddStage(TEXT("download"), [](FAgentForgeJob& J) { J.Finish(FabError(TEXT("Editor only."))); return true; });
+	return Job;
+#endif
+}
+
 // ============================================================================
 //  LIST_IMPORTED_ASSETS
 // ============================================================================
@@ -347,3 +923,20 @@ FString FFabIntegrationModule::ListImportedAssets(const TSharedPtr<FJsonObject>&
 	return FabError(TEXT("Editor only."));
 #endif
 }
+
+TSharedPtr<FJsonObject> FFabIntegrationModule::GetStatsJson()
+{
+	const FFabState& State = GetFabState();
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetNumberField(TEXT("search_queries"),     static_cast<double>(State.SearchQueries));
+	Obj->SetNumberField(TEXT("search_cache_hits"),  static_cast<double>(State.SearchCacheHits));
+	Obj->SetNumberField(TEXT("search_cache_size"),  State.SearchCache.Num());
+	Obj->SetNumberField(TEXT("batches"),            static_cast<double>(State.Batches));
+	Obj->SetNumberField(TEXT("downloads"),          static_cast<double>(State.Downloads));
+	Obj->SetNumberField(TEXT("downloads_resumed"),  static_cast<double>(State.DownloadsResumed));
+	Obj->SetNumberField(TEXT("download_failures"),  static_cast<double>(State.DownloadFailures));
+	Obj->SetNumberField(TEXT("bytes_downloaded"),   static_cast<double>(State.BytesDownloaded));
+	Obj->SetNumberField(TEXT("imports"),            static_cast<double>(State.Imports));
+	Obj->SetNumberField(TEXT("import_failures"),    static_cast<double>(State.ImportFailures));
+	return Obj;
+}
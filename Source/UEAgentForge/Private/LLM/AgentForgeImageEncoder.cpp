@@ -0,0 +1,196 @@
+#include "LLM/AgentForgeImageEncoder.h"
+#include "Visual/SceneCapture.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformTime.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "ImageUtils.h"
+#include "Misc/Base64.h"
+#include "Misc/FileHelper.h"
+#include "Modules/ModuleManager.h"
+
+namespace
+{
+	static IImageWrapperModule& GetImageWrapperModule()
+	{
+		// Loaded once from the game thread (see EncodeAll / DecodeFile) before any worker asks for it.
+		return FModuleManager::LoadModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"));
+	}
+
+	static FIntPoint FitSize(const FIntPoint& Size, int32 MaxLongEdge, int32 MaxShortEdge)
+	{
+		double Scale = 1.0;
+		const int32 LongEdge = FMath::Max(Size.X, Size.Y);
+		const int32 ShortEdge = FMath::Min(Size.X, Size.Y);
+		if (MaxLongEdge > 0 && LongEdge > MaxLongEdge)
+		{
+			Scale = FMath::Min(Scale, (double)MaxLongEdge / LongEdge);
+		}
+		if (MaxShortEdge > 0 && ShortEdge > MaxShortEdge)
+		{
+			Scale = FMath::Min(Scale, (double)MaxShortEdge / ShortEdge);
+		}
+		return FIntPoint(
+			FMath::Max(1, FMath::RoundToInt32(Size.X * Scale)),
+			FMath::Max(1, FMath::RoundToInt32(Size.Y * Scale)));
+	}
+}
+
+FAgentForgeImageEncodeSettings FAgentForgeImageEncodeSettings::ForProvider(EAgentForgeLLMProvider Provider)
+{
+	FAgentForgeImageEncodeSettings Settings;
+	switch (Provider)
+	{
+	case EAgentForgeLLMProvider::Anthropic:
+		Settings.MaxLongEdge = 1568;
+		break;
+	case EAgentForgeLLMProvider::OpenAI:
+		// High-detail images are fitted to 2048 and then to a 768 short side.
+		Settings.MaxLongEdge = 2048;
+		Settings.MaxShortEdge = 768;
+		break;
+	default:
+		// Self-hosted / compatible endpoints: keep requests small.
+		Settings.MaxLongEdge = 1024;
+		break;
+	}
+	return Settings;
+}
+
+FAgentForgeImageEncoder& FAgentForgeImageEncoder::Get()
+{
+	static FAgentForgeImageEncoder Instance;
+	return Instance;
+}
+
+bool FAgentForgeImageEncoder::Encode(
+	TArray<FColor> Pixels,
+	const FIntPoint& Size,
+	const FAgentForgeImageEncodeSettings& Settings,
+	FAgentForgeEncodedImage& OutImage,
+	FString& OutError)
+{
+	const double StartTime = FPlatformTime::Seconds();
+	OutImage = FAgentForgeEncodedImage();
+	if (Size.X <= 0 || Size.Y <= 0 || Pixels.Num() != Size.X * Size.Y)
+	{
+		++Failures;
+		OutError = TEXT("Image encode failed: pixel buffer does not match its size.");
+		return false;
+	}
+	SourceBytes += (int64)Pixels.Num() * sizeof(FColor);
+
+	const FIntPoint Target = FitSize(Size, Settings.MaxLongEdge, Settings.MaxShortEdge);
+	if (Target != Size)
+	{
+		TArray<FColor> Resized;
+		Resized.SetNumUninitialized(Target.X * Target.Y);
+		FImageUtils::ImageResize(Size.X, Size.Y, Pixels, Target.X, Target.Y, Resized, false, true);
+		Pixels = MoveTemp(Resized);
+	}
+	else
+	{
+		for (FColor& Pixel : Pixels)
+		{
+			Pixel.A = 255;
+		}
+	}
+
+	const bool bJpeg = Settings.Format == EAgentForgeImageFormat::Jpeg;
+	TSharedPtr<IImageWrapper> Wrapper = GetImageWrapperModule().CreateImageWrapper(bJpeg ? EImageFormat::JPEG : EImageFormat::PNG);
+	if (!Wrapper.IsValid() ||
+		!Wrapper->SetRaw(Pixels.GetData(), (int64)Pixels.Num() * sizeof(FColor), Target.X, Target.Y, ERGBFormat::BGRA, 8))
+	{
+		++Failures;
+		OutError = TEXT("Image encode failed: image wrapper rejected the pixels.");
+		return false;
+	}
+	const TArray64<uint8> Compressed = Wrapper->GetCompressed(bJpeg ? FMath::Clamp(Settings.Quality, 1, 100) : 0);
+	if (Compressed.Num() == 0)
+	{
+		++Failures;
+		OutError = TEXT("Image encode failed: compressor returned no data.");
+		return false;
+	}
+
+	OutImage.Base64 = FBase64::Encode(Compressed.GetData(), (uint32)Compressed.Num());
+	OutImage.MediaType = bJpeg ? TEXT("image/jpeg") : TEXT("image/png");
+	OutImage.Size = Target;
+	OutImage.Bytes = Compressed.Num();
+	OutImage.EncodeMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	const int64 Micros = (int64)(OutImage.EncodeMs * 1000.0);
+	++Images;
+	EncodedBytes += OutImage.Bytes;
+	EncodeMicros += Micros;
+	LastEncodeMicros = Micros;
+	return true;
+}
+
+bool FAgentForgeImageEncoder::EncodeAll(
+	TArray<FSceneCaptureImage>& InImages,
+	const FAgentForgeImageEncodeSettings& Settings,
+	TArray<FAgentForgeEncodedImage>& OutImages,
+	FString& OutError)
+{
+	GetImageWrapperModule();
+	OutImages.Reset();
+	OutImages.SetNum(InImages.Num());
+	TArray<FString> Errors;
+	Errors.SetNum(InImages.Num());
+
+	ParallelFor(InImages.Num(), [&](int32 Index)
+	{
+		FSceneCaptureImage& Image = InImages[Index];
+		Encode(MoveTemp(Image.Pixels), Image.Size, Settings, OutImages[Index], Errors[Index]);
+	}, InImages.Num() < 2 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+	for (const FString& Error : Errors)
+	{
+		if (!Error.IsEmpty())
+		{
+			OutImages.Reset();
+			OutError = Error;
+			return false;
+		}
+	}
+	return true;
+}
+
+bool FAgentForgeImageEncoder::DecodeFile(const FString& Path, TArray<FColor>& OutPixels, FIntPoint& OutSize, FString& OutError)
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *Path))
+	{
+		OutError = FString::Printf(TEXT("Failed to read screenshot: %s"), *Path);
+		return false;
+	}
+
+	IImageWrapperModule& Module = GetImageWrapperModule();
+	const EImageFormat Format = Module.DetectImageFormat(Bytes.GetData(), Bytes.Num());
+	TSharedPtr<IImageWrapper> Wrapper = Format != EImageFormat::Invalid ? Module.CreateImageWrapper(Format) : nullptr;
+	TArray64<uint8> Raw;
+	if (!Wrapper.IsValid() || !Wrapper->SetCompressed(Bytes.GetData(), Bytes.Num()) || !Wrapper->GetRaw(ERGBFormat::BGRA, 8, Raw))
+	{
+		OutError = FString::Printf(TEXT("Failed to decode screenshot: %s"), *Path);
+		return false;
+	}
+
+	OutSize = FIntPoint((int32)Wrapper->GetWidth(), (int32)Wrapper->GetHeight());
+	OutPixels.SetNumUninitialized(OutSize.X * OutSize.Y);
+	FMemory::Memcpy(OutPixels.GetData(), Raw.GetData(), FMath::Min<int64>(Raw.Num(), (int64)OutPixels.Num() * sizeof(FColor)));
+	return true;
+}
+
+TSharedPtr<FJsonObject> FAgentForgeImageEncoder::GetStatsJson() const
+{
+	const int64 Count = Images.load();
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetNumberField(TEXT("images"),          (double)Count);
+	Obj->SetNumberField(TEXT("failures"),        (double)Failures.load());
+	Obj->SetNumberField(TEXT("source_mb"),       (double)SourceBytes.load() / (1024.0 * 1024.0));
+	Obj->SetNumberField(TEXT("encoded_mb"),      (double)EncodedBytes.load() / (1024.0 * 1024.0));
+	Obj->SetNumberField(TEXT("avg_encode_ms"),   Count > 0 ? (double)EncodeMicros.load() / 1000.0 / (double)Count : 0.0);
+	Obj->SetNumberField(TEXT("last_encode_ms"),  (double)LastEncodeMicros.load() / 1000.0);
+	return Obj;
+}
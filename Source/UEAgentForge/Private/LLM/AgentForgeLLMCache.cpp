@@ -0,0 +1,378 @@
+#include "LLM/AgentForgeLLMCache.h"
+#include "HAL/FileManager.h"
+#include "JsonObjectConverter.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/SecureHash.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace
+{
+	static int64 NowUnixSeconds()
+	{
+		return FDateTime::UtcNow().ToUnixTimestamp();
+	}
+
+	static FString SerializeEntry(const FAgentForgeLLMResponse& Response, int64 StoredAt)
+	{
+		TSharedRef<FJsonObject> Obj = MakeShared<FJsonObject>();
+		FJsonObjectConverter::UStructToJsonObject(FAgentForgeLLMResponse::StaticStruct(), &Response, Obj);
+		Obj->SetNumberField(TEXT("stored_at"), (double)StoredAt);
+
+		FString Output;
+		TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Output);
+		FJsonSerializer::Serialize(Obj, Writer);
+		return Output;
+	}
+
+	static bool DeserializeEntry(const FString& Text, FAgentForgeLLMResponse& OutResponse, int64& OutStoredAt)
+	{
+		TSharedPtr<FJsonObject> Obj;
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Text);
+		if (!FJsonSerializer::Deserialize(Reader, Obj) || !Obj.IsValid()
+			|| !FJsonObjectConverter::JsonObjectToUStruct(Obj.ToSharedRef(), &OutResponse))
+		{
+			return false;
+		}
+		double StoredAt = 0.0;
+		Obj->TryGetNumberField(TEXT("stored_at"), StoredAt);
+		OutStoredAt = (int64)StoredAt;
+		return OutResponse.bSuccess;
+	}
+}
+
+FAgentForgeLLMResponseCache& FAgentForgeLLMResponseCache::Get()
+{
+	static FAgentForgeLLMResponseCache Instance;
+	return Instance;
+}
+
+bool FAgentForgeLLMResponseCache::ParseMode(const FString& Name, EAgentForgeLLMCacheMode& OutMode)
+{
+	if (Name.Equals(TEXT("bypass"), ESearchCase::IgnoreCase))
+	{
+		OutMode = EAgentForgeLLMCacheMode::Bypass;
+		return true;
+	}
+	if (Name.Equals(TEXT("prefer"), ESearchCase::IgnoreCase))
+	{
+		OutMode = EAgentForgeLLMCacheMode::Prefer;
+		return true;
+	}
+	if (Name.Equals(TEXT("only"), ESearchCase::IgnoreCase))
+	{
+		OutMode = EAgentForgeLLMCacheMode::Only;
+		return true;
+	}
+	return false;
+}
+
+const TCHAR* FAgentForgeLLMResponseCache::ModeName(EAgentForgeLLMCacheMode Mode)
+{
+	switch (Mode)
+	{
+	case EAgentForgeLLMCacheMode::Prefer: return TEXT("prefer");
+	case EAgentForgeLLMCacheMode::Only:   return TEXT("only");
+	default:                              return TEXT("bypass");
+	}
+}
+
+FString FAgentForgeLLMResponseCache::MakeKey(const FAgentForgeLLMSettings& Settings)
+{
+	// Every field is length-prefixed so adjacent values cannot run into each other.
+	FSHA1 Sha;
+	auto AddString = [&Sha](const FString& Value)
+	{
+		const FTCHARToUTF8 Utf8(*Value);
+		const int32 Length = Utf8.Length();
+		Sha.Update(reinterpret_cast<const uint8*>(&Length), sizeof(Length));
+		Sha.Update(reinterpret_cast<const uint8*>(Utf8.Get()), Length);
+	};
+
+	AddString(FString::FromInt((int32)Settings.Provider));
+	AddString(Settings.Model);
+	AddString(Settings.CustomEndpoint);
+	AddString(Settings.SystemPrompt);
+	AddString(Settings.ResponseSchema);
+	AddString(FString::Printf(TEXT("%.4f"), Settings.Temperature));
+	AddString(FString::FromInt(Settings.MaxTokens));
+	for (const FAgentForgeChatMessage& Message : Settings.Messages)
+	{
+		AddString(Message.Role);
+		AddString(Message.Content);
+		for (int32 Index = 0; Index < Message.ImageData.Num(); ++Index)
+		{
+			AddString(Message.ImageMediaTypes.IsValidIndex(Index) ? Message.ImageMediaTypes[Index] : FString());
+			AddString(Message.ImageData[Index]);
+		}
+	}
+
+	FSHAHash Hash;
+	Sha.Final();
+	Sha.GetHash(Hash.Hash);
+	return Hash.ToString().ToLower();
+}
+
+FString FAgentForgeLLMResponseCache::GetDiskRoot()
+{
+	return FPaths::ProjectSavedDir() / TEXT("AgentForgeLLMCache");
+}
+
+FString FAgentForgeLLMResponseCache::DiskPath(const FString& Key) const
+{
+	return GetDiskRoot() / (Key + TEXT(".json"));
+}
+
+bool FAgentForgeLLMResponseCache::IsExpired(int64 StoredAt) const
+{
+	return TtlSeconds > 0.0 && (double)(NowUnixSeconds() - StoredAt) > TtlSeconds;
+}
+
+bool FAgentForgeLLMResponseCache::Find(const FString& Key, FAgentForgeLLMResponse& OutResponse, bool* OutFromDisk)
+{
+	if (OutFromDisk)
+	{
+		*OutFromDisk = false;
+	}
+
+	bool bTryDisk = false;
+	{
+		FScopeLock ScopeLock(&Lock);
+		if (FEntry* Entry = Entries.Find(Key))
+		{
+			if (!IsExpired(Entry->StoredAt))
+			{
+				Entry->LastUse = ++UseClock;
+				++MemoryHits;
+				OutResponse = Entry->Response;
+				OutResponse.bFromCache = true;
+				return true;
+			}
+			Entries.Remove(Key);
+			++Expired;
+		}
+		ScanDisk();
+		bTryDisk = bDiskEnabled && DiskEntries.Contains(Key);
+	}
+
+	FString Text;
+	FAgentForgeLLMResponse Loaded;
+	int64 StoredAt = 0;
+	if (bTryDisk && FFileHelper::LoadFileToString(Text, *DiskPath(Key)) && DeserializeEntry(Text, Loaded, StoredAt))
+	{
+		FScopeLock ScopeLock(&Lock);
+		if (!IsExpired(StoredAt))
+		{
+			++DiskHits;
+			FEntry& Entry = Entries.FindOrAdd(Key);
+			Entry.Response = Loaded;
+			Entry.StoredAt = StoredAt;
+			Entry.LastUse = ++UseClock;
+			EvictMemory();
+			if (OutFromDisk)
+			{
+				*OutFromDisk = true;
+			}
+			OutResponse = MoveTemp(Loaded);
+			OutResponse.bFromCache = true;
+			return true;
+		}
+		++Expired;
+	}
+
+	if (bTryDisk)
+	{
+		// Expired or unreadable.
+		IFileManager::Get().Delete(*DiskPath(Key), false, false, true);
+		FScopeLock ScopeLock(&Lock);
+		if (const FDiskEntry* DiskEntry = DiskEntries.Find(Key))
+		{
+			DiskBytes -= DiskEntry->Bytes;
+			DiskEntries.Remove(Key);
+		}
+	}
+
+	FScopeLock ScopeLock(&Lock);
+	++Misses;
+	return false;
+}
+
+void FAgentForgeLLMResponseCache::Store(const FString& Key, const FAgentForgeLLMResponse& Response)
+{
+	if (!Response.bSuccess || Response.bFromCache)
+	{
+		return;
+	}
+
+	const int64 StoredAt = NowUnixSeconds();
+	bool bWriteDisk = false;
+	{
+		FScopeLock ScopeLock(&Lock);
+		++Stores;
+		FEntry& Entry = Entries.FindOrAdd(Key);
+		Entry.Response = Response;
+		Entry.StoredAt = StoredAt;
+		Entry.LastUse = ++UseClock;
+		EvictMemory();
+		bWriteDisk = bDiskEnabled && DiskBudgetBytes > 0;
+	}
+	if (!bWriteDisk)
+	{
+		return;
+	}
+
+	const FString Text = SerializeEntry(Response, StoredAt);
+	const FString Path = DiskPath(Key);
+	IFileManager::Get().MakeDirectory(*GetDiskRoot(), true);
+	if (FFileHelper::SaveStringToFile(Text, *Path, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+	{
+		FScopeLock ScopeLock(&Lock);
+		ScanDisk();
+		FDiskEntry& DiskEntry = DiskEntries.FindOrAdd(Key);
+		DiskBytes -= DiskEntry.Bytes;
+		DiskEntry.Bytes = IFileManager::Get().FileSize(*Path);
+		DiskEntry.StoredAt = StoredAt;
+		DiskBytes += DiskEntry.Bytes;
+		EvictDisk();
+	}
+}
+
+void FAgentForgeLLMResponseCache::ScanDisk()
+{
+	// Caller holds Lock. Once per session; afterwards the index is kept in step with writes.
+	if (bDiskScanned)
+	{
+		return;
+	}
+	bDiskScanned = true;
+	IFileManager::Get().IterateDirectoryStat(*GetDiskRoot(), [this](const TCHAR* Path, const FFileStatData& Stat)
+	{
+		if (!Stat.bIsDirectory && FPaths::GetExtension(Path) == TEXT("json"))
+		{
+			FDiskEntry& DiskEntry = DiskEntries.FindOrAdd(FPaths::GetBaseFilename(Path));
+			DiskEntry.Bytes = Stat.FileSize;
+			DiskEntry.StoredAt = Stat.ModificationTime.ToUnixTimestamp();
+			DiskBytes += Stat.FileSize;
+		}
+		return true;
+	});
+	EvictDisk();
+}
+
+void FAgentForgeLLMResponseCache::EvictMemory()
+{
+	// Caller holds Lock. Bounded by MemoryEntries, so a scan is fine.
+	while (Entries.Num() > MemoryEntries && Entries.Num() > 0)
+	{
+		auto Oldest = Entries.CreateIterator();
+		for (auto It = Entries.CreateIterator(); It; ++It)
+		{
+			if (It->Value.LastUse < Oldest->Value.LastUse)
+			{
+				Oldest = It;
+			}
+		}
+		Oldest.RemoveCurrent();
+		++Evictions;
+	}
+}
+
+void FAgentForgeLLMResponseCache::EvictDisk()
+{
+	// Caller holds Lock. Expired files first, then oldest until under budget.
+	for (auto It = DiskEntries.CreateIterator(); It; ++It)
+	{
+		if (IsExpired(It->Value.StoredAt))
+		{
+			IFileManager::Get().Delete(*DiskPath(It->Key), false, false, true);
+			DiskBytes -= It->Value.Bytes;
+			It.RemoveCurrent();
+			++Expired;
+		}
+	}
+	if (DiskBytes <= DiskBudgetBytes)
+	{
+		return;
+	}
+
+	DiskEntries.ValueSort([](const FDiskEntry& A, const FDiskEntry& B) { return A.StoredAt < B.StoredAt; });
+	for (auto It = DiskEntries.CreateIterator(); It && DiskBytes > DiskBudgetBytes; ++It)
+	{
+		IFileManager::Get().Delete(*DiskPath(It->Key), false, false, true);
+		DiskBytes -= It->Value.Bytes;
+		It.RemoveCurrent();
+		++Evictions;
+	}
+}
+
+void FAgentForgeLLMResponseCache::Clear(bool bIncludeDisk)
+{
+	FScopeLock ScopeLock(&Lock);
+	Entries.Empty();
+	if (bIncludeDisk)
+	{
+		IFileManager::Get().DeleteDirectory(*GetDiskRoot(), false, true);
+		DiskEntries.Empty();
+		DiskBytes = 0;
+	}
+}
+
+void FAgentForgeLLMResponseCache::ApplyPolicy(const TSharedPtr<FJsonObject>& Args)
+{
+	if (!Args.IsValid())
+	{
+		return;
+	}
+
+	FScopeLock ScopeLock(&Lock);
+	double Number = 0.0;
+	bool bFlag = false;
+	if (Args->TryGetNumberField(TEXT("ttl_seconds"), Number))
+	{
+		TtlSeconds = FMath::Max(0.0, Number);
+	}
+	if (Args->TryGetNumberField(TEXT("memory_entries"), Number))
+	{
+		MemoryEntries = FMath::Max(0, (int32)Number);
+	}
+	if (Args->TryGetNumberField(TEXT("disk_budget_mb"), Number))
+	{
+		DiskBudgetBytes = (int64)(FMath::Max(0.0, Number) * 1024.0 * 1024.0);
+	}
+	if (Args->TryGetBoolField(TEXT("disk"), bFlag))
+	{
+		bDiskEnabled = bFlag;
+	}
+	EvictMemory();
+	if (bDiskScanned)
+	{
+		EvictDisk();
+	}
+}
+
+TSharedPtr<FJsonObject> FAgentForgeLLMResponseCache::GetStatsJson() const
+{
+	FScopeLock ScopeLock(&Lock);
+	const int64 Lookups = MemoryHits + DiskHits + Misses;
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetNumberField(TEXT("entries"),        Entries.Num());
+	Obj->SetNumberField(TEXT("memory_entries"), MemoryEntries);
+	Obj->SetBoolField  (TEXT("disk"),           bDiskEnabled);
+	Obj->SetNumberField(TEXT("disk_entries"),   DiskEntries.Num());
+	Obj->SetNumberField(TEXT("disk_mb"),        DiskBytes / (1024.0 * 1024.0));
+	Obj->SetNumberField(TEXT("disk_budget_mb"), DiskBudgetBytes / (1024.0 * 1024.0));
+	Obj->SetNumberField(TEXT("ttl_seconds"),    TtlSeconds);
+	Obj->SetNumberField(TEXT("memory_hits"),    (double)MemoryHits);
+	Obj->SetNumberField(TEXT("disk_hits"),      (double)DiskHits);
+	Obj->SetNumberField(TEXT("misses"),         (double)Misses);
+	Obj->SetNumberField(TEXT("hit_rate"),       Lookups > 0 ? (double)(MemoryHits + DiskHits) / (double)Lookups : 0.0);
+	Obj->SetNumberField(TEXT("stores"),         (double)Stores);
+	Obj->SetNumberField(TEXT("expired"),        (double)Expired);
+	Obj->SetNumberField(TEXT("evictions"),      (double)Evictions);
+	Obj->SetStringField(TEXT("disk_root"),      GetDiskRoot());
+	return Obj;
+}
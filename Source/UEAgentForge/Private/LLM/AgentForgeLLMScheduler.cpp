@@ -0,0 +1,393 @@
+#include "LLM/AgentForgeLLMScheduler.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/DateTime.h"
+#include "Misc/ScopeLock.h"
+#include "UObject/Class.h"
+
+namespace
+{
+	// Local servers usually run one model at a time; more concurrent requests only queue on their side.
+	static constexpr int32 CompatibleMaxConcurrent = 2;
+
+	// Provider request limits are per minute.
+	static constexpr double LimitWindowSeconds = 60.0;
+
+	static FString GetLaneName(EAgentForgeLLMProvider Provider)
+	{
+		return StaticEnum<EAgentForgeLLMProvider>()->GetNameStringByValue((int64)Provider);
+	}
+
+	/**
+	 * Seconds until a reset, from any of the forms providers send: plain seconds
+	 * (Retry-After), Go-style durations ("6m0s", "20ms"; OpenAI), RFC 3339
+	 * timestamps (Anthropic) or HTTP dates. Negative when absent or unreadable.
+	 */
+	static double ParseResetSeconds(const FString& Value)
+	{
+		const FString Trimmed = Value.TrimStartAndEnd();
+		if (Trimmed.IsEmpty())
+		{
+			return -1.0;
+		}
+		if (Trimmed.IsNumeric())
+		{
+			return FMath::Max(0.0, FCString::Atod(*Trimmed));
+		}
+
+		FDateTime Date;
+		if (FDateTime::ParseIso8601(*Trimmed, Date) || FDateTime::ParseHttpDate(Trimmed, Date))
+		{
+			return FMath::Max(0.0, (Date - FDateTime::UtcNow()).GetTotalSeconds());
+		}
+
+		double Total = 0.0;
+		int32 Index = 0;
+		bool bAny = false;
+		while (Index < Trimmed.Len())
+		{
+			const int32 NumberStart = Index;
+			while (Index < Trimmed.Len() && (FChar::IsDigit(Trimmed[Index]) || Trimmed[Index] == TEXT('.')))
+			{
+				++Index;
+			}
+			const int32 UnitStart = Index;
+			while (Index < Trimmed.Len() && FChar::IsAlpha(Trimmed[Index]))
+			{
+				++Index;
+			}
+			if (NumberStart == UnitStart || UnitStart == Index)
+			{
+				return -1.0;
+			}
+
+			const double Number = FCString::Atod(*Trimmed.Mid(NumberStart, UnitStart - NumberStart));
+			const FString Unit = Trimmed.Mid(UnitStart, Index - UnitStart);
+			if (Unit == TEXT("ms"))      { Total += Number / 1000.0; }
+			else if (Unit == TEXT("s"))  { Total += Number; }
+			else if (Unit == TEXT("m"))  { Total += Number * 60.0; }
+			else if (Unit == TEXT("h"))  { Total += Number * 3600.0; }
+			else                         { return -1.0; }
+			bAny = true;
+		}
+		return bAny ? Total : -1.0;
+	}
+
+	static bool IsRetryableStatus(int32 Code)
+	{
+		// 529: Anthropic "overloaded".
+		return Code == 408 || Code == 429 || Code == 500 || Code == 502 || Code == 503 || Code == 504 || Code == 529;
+	}
+}
+
+FAgentForgeLLMScheduler::FAgentForgeLLMScheduler()
+{
+	Lanes.Add(EAgentForgeLLMProvider::OpenAICompatible).MaxConcurrent = CompatibleMaxConcurrent;
+}
+
+FAgentForgeLLMScheduler::FLane& FAgentForgeLLMScheduler::GetLane(EAgentForgeLLMProvider Provider)
+{
+	return Lanes.FindOrAdd(Provider);
+}
+
+void FAgentForgeLLMScheduler::Enqueue(
+	int32 RequestId,
+	EAgentForgeLLMProvider Provider,
+	EAgentForgeLLMPriority Priority,
+	TFunction<void()> Start,
+	TFunction<void()> Abort,
+	double DelaySeconds)
+{
+	FScopeLock ScopeLock(&Lock);
+	const double Now = FPlatformTime::Seconds();
+
+	FQueued Entry;
+	Entry.RequestId = RequestId;
+	Entry.Provider = Provider;
+	Entry.Priority = Priority;
+	Entry.EnqueuedAt = Now;
+	Entry.NotBefore = Now + FMath::Max(0.0, DelaySeconds);
+	Entry.Sequence = NextSequence++;
+	Entry.Start = MoveTemp(Start);
+	Entry.Abort = MoveTemp(Abort);
+
+	// Kept ordered by lane, then arrival: insert after the last entry of the same or a more urgent lane.
+	int32 Insert = Queue.Num();
+	while (Insert > 0 && Queue[Insert - 1].Priority > Priority)
+	{
+		--Insert;
+	}
+	Queue.Insert(MoveTemp(Entry), Insert);
+}
+
+bool FAgentForgeLLMScheduler::CanAdmit(FLane& Lane, EAgentForgeLLMPriority Priority, double Now)
+{
+	if (Now < Lane.PausedUntil)
+	{
+		return false;
+	}
+
+	const int32 Reserve = (Priority == EAgentForgeLLMPriority::Background && Lane.MaxConcurrent > 1) ? 1 : 0;
+	if (Lane.InFlight + Reserve >= Lane.MaxConcurrent)
+	{
+		return false;
+	}
+
+	if (Lane.BucketCapacity > 0.0)
+	{
+		Lane.BucketTokens = FMath::Min(Lane.BucketCapacity, Lane.BucketTokens + (Now - Lane.LastRefill) * Lane.RefillPerSecond);
+		Lane.LastRefill = Now;
+		if (Lane.BucketTokens < 1.0 + Reserve)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+void FAgentForgeLLMScheduler::Pump()
+{
+	TArray<TFunction<void()>> ToStart;
+	{
+		FScopeLock ScopeLock(&Lock);
+		const double Now = FPlatformTime::Seconds();
+		for (int32 Index = 0; Index < Queue.Num();)
+		{
+			FQueued& Entry = Queue[Index];
+			FLane& Lane = GetLane(Entry.Provider);
+			if (Entry.NotBefore > Now || !CanAdmit(Lane, Entry.Priority, Now))
+			{
+				++Index;
+				continue;
+			}
+
+			++Lane.InFlight;
+			++Lane.Started;
+			if (Lane.BucketCapacity > 0.0)
+			{
+				Lane.BucketTokens -= 1.0;
+			}
+			++InFlight;
+			MaxInFlight = FMath::Max(MaxInFlight, InFlight);
+			MaxQueueWaitSeconds = FMath::Max(MaxQueueWaitSeconds, Now - Entry.EnqueuedAt);
+			ToStart.Add(MoveTemp(Entry.Start));
+			Queue.RemoveAt(Index);
+		}
+	}
+
+	for (TFunction<void()>& Start : ToStart)
+	{
+		Start();
+	}
+}
+
+void FAgentForgeLLMScheduler::ReadRateLimitHeaders(FLane& Lane, const FHttpResponsePtr& Response, double Now)
+{
+	auto Header = [&Response](const TCHAR* Anthropic, const TCHAR* OpenAI)
+	{
+		const FString Value = Response->GetHeader(Anthropic);
+		return Value.IsEmpty() ? Response->GetHeader(OpenAI) : Value;
+	};
+
+	const FString Limit = Header(TEXT("anthropic-ratelimit-requests-limit"), TEXT("x-ratelimit-limit-requests"));
+	if (Limit.IsNumeric() && FCString::Atod(*Limit) > 0.0)
+	{
+		Lane.BucketCapacity = FCString::Atod(*Limit);
+		Lane.RefillPerSecond = Lane.BucketCapacity / LimitWindowSeconds;
+	}
+	const FString Remaining = Header(TEXT("anthropic-ratelimit-requests-remaining"), TEXT("x-ratelimit-remaining-requests"));
+	if (Lane.BucketCapacity > 0.0 && Remaining.IsNumeric())
+	{
+		// The server's count already includes requests still in flight.
+		Lane.BucketTokens = FMath::Min(Lane.BucketCapacity, FCString::Atod(*Remaining));
+		Lane.LastRefill = Now;
+	}
+
+	// An exhausted request or token budget holds the lane until the provider says it resets.
+	static const TCHAR* const Budgets[][2] = {
+		{ TEXT("anthropic-ratelimit-requests-remaining"),      TEXT("anthropic-ratelimit-requests-reset") },
+		{ TEXT("anthropic-ratelimit-tokens-remaining"),        TEXT("anthropic-ratelimit-tokens-reset") },
+		{ TEXT("anthropic-ratelimit-input-tokens-remaining"),  TEXT("anthropic-ratelimit-input-tokens-reset") },
+		{ TEXT("anthropic-ratelimit-output-tokens-remaining"), TEXT("anthropic-ratelimit-output-tokens-reset") },
+		{ TEXT("x-ratelimit-remaining-requests"),              TEXT("x-ratelimit-reset-requests") },
+		{ TEXT("x-ratelimit-remaining-tokens"),                TEXT("x-ratelimit-reset-tokens") },
+	};
+	for (const auto& Budget : Budgets)
+	{
+		const FString Left = Response->GetHeader(Budget[0]);
+		if (Left.IsNumeric() && FCString::Atod(*Left) <= 0.0)
+		{
+			const double ResetSeconds = ParseResetSeconds(Response->GetHeader(Budget[1]));
+			if (ResetSeconds > 0.0)
+			{
+				Lane.PausedUntil = FMath::Max(Lane.PausedUntil, Now + FMath::Min(ResetSeconds, BackoffMaxSeconds));
+			}
+		}
+	}
+}
+
+void FAgentForgeLLMScheduler::OnFinished(EAgentForgeLLMProvider Provider, const FHttpResponsePtr& Response)
+{
+	FScopeLock ScopeLock(&Lock);
+	FLane& Lane = GetLane(Provider);
+	Lane.InFlight = FMath::Max(0, Lane.InFlight - 1);
+	InFlight = FMath::Max(0, InFlight - 1);
+	if (Response.IsValid())
+	{
+		ReadRateLimitHeaders(Lane, Response, FPlatformTime::Seconds());
+	}
+}
+
+double FAgentForgeLLMScheduler::GetRetryDelay(
+	EAgentForgeLLMProvider Provider,
+	const FHttpResponsePtr& Response,
+	bool bSucceeded,
+	int32 Attempt)
+{
+	const int32 Code = Response.IsValid() ? Response->GetResponseCode() : 0;
+	const bool bConnectionError = !bSucceeded && Code == 0;
+	if (!bConnectionError && !IsRetryableStatus(Code))
+	{
+		return -1.0;
+	}
+
+	FScopeLock ScopeLock(&Lock);
+	FLane& Lane = GetLane(Provider);
+	const bool bRateLimited = Code == 429 || Code == 529;
+	if (bRateLimited)
+	{
+		++Lane.RateLimited;
+		++TotalRateLimited;
+	}
+	if (Attempt >= MaxRetries)
+	{
+		return -1.0;
+	}
+
+	// Equal jitter: half the exponential step is fixed, half random, so callers that failed together spread out.
+	const double Step = FMath::Min(BackoffMaxSeconds, BackoffBaseSeconds * FMath::Pow(2.0, (double)Attempt));
+	double Delay = Step * (0.5 + 0.5 * FMath::FRand());
+	if (Response.IsValid())
+	{
+		const double RetryAfter = ParseResetSeconds(Response->GetHeader(TEXT("retry-after")));
+		if (RetryAfter >= 0.0)
+		{
+			Delay = FMath::Max(Delay, FMath::Min(RetryAfter, BackoffMaxSeconds));
+		}
+	}
+
+	if (bRateLimited)
+	{
+		Lane.PausedUntil = FMath::Max(Lane.PausedUntil, FPlatformTime::Seconds() + Delay);
+	}
+	++Lane.Retries;
+	++TotalRetries;
+	return Delay;
+}
+
+bool FAgentForgeLLMScheduler::Cancel(int32 RequestId)
+{
+	TFunction<void()> Abort;
+	{
+		FScopeLock ScopeLock(&Lock);
+		const int32 Index = Queue.IndexOfByPredicate([RequestId](const FQueued& Entry) { return Entry.RequestId == RequestId; });
+		if (Index == INDEX_NONE)
+		{
+			return false;
+		}
+		Abort = MoveTemp(Queue[Index].Abort);
+		Queue.RemoveAt(Index);
+	}
+	if (Abort)
+	{
+		Abort();
+	}
+	return true;
+}
+
+void FAgentForgeLLMScheduler::Reset()
+{
+	FScopeLock ScopeLock(&Lock);
+	Queue.Empty();
+}
+
+bool FAgentForgeLLMScheduler::HasQueued() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return Queue.Num() > 0;
+}
+
+void FAgentForgeLLMScheduler::ApplyPolicy(const TSharedPtr<FJsonObject>& Args, const EAgentForgeLLMProvider* Provider)
+{
+	if (!Args.IsValid())
+	{
+		return;
+	}
+
+	FScopeLock ScopeLock(&Lock);
+	double Number = 0.0;
+	if (Args->TryGetNumberField(TEXT("max_concurrent"), Number))
+	{
+		const int32 MaxConcurrent = FMath::Max(1, (int32)Number);
+		if (Provider)
+		{
+			GetLane(*Provider).MaxConcurrent = MaxConcurrent;
+		}
+		else
+		{
+			for (EAgentForgeLLMProvider Each : { EAgentForgeLLMProvider::Anthropic, EAgentForgeLLMProvider::OpenAI,
+				EAgentForgeLLMProvider::DeepSeek, EAgentForgeLLMProvider::OpenAICompatible })
+			{
+				GetLane(Each).MaxConcurrent = MaxConcurrent;
+			}
+		}
+	}
+	if (Args->TryGetNumberField(TEXT("max_retries"), Number))
+	{
+		MaxRetries = FMath::Max(0, (int32)Number);
+	}
+	if (Args->TryGetNumberField(TEXT("backoff_base_ms"), Number))
+	{
+		BackoffBaseSeconds = FMath::Max(0.0, Number / 1000.0);
+	}
+	if (Args->TryGetNumberField(TEXT("backoff_max_ms"), Number))
+	{
+		BackoffMaxSeconds = FMath::Max(BackoffBaseSeconds, Number / 1000.0);
+	}
+}
+
+TSharedPtr<FJsonObject> FAgentForgeLLMScheduler::GetStatsJson() const
+{
+	FScopeLock ScopeLock(&Lock);
+	const double Now = FPlatformTime::Seconds();
+
+	TSharedPtr<FJsonObject> LanesObj = MakeShared<FJsonObject>();
+	for (const TPair<EAgentForgeLLMProvider, FLane>& Pair : Lanes)
+	{
+		const FLane& Lane = Pair.Value;
+		const EAgentForgeLLMProvider Provider = Pair.Key;
+		TSharedPtr<FJsonObject> LaneObj = MakeShared<FJsonObject>();
+		LaneObj->SetNumberField(TEXT("max_concurrent"), Lane.MaxConcurrent);
+		LaneObj->SetNumberField(TEXT("in_flight"),      Lane.InFlight);
+		LaneObj->SetNumberField(TEXT("queued"),         Queue.FilterByPredicate([Provider](const FQueued& Entry) { return Entry.Provider == Provider; }).Num());
+		LaneObj->SetNumberField(TEXT("started"),        (double)Lane.Started);
+		LaneObj->SetNumberField(TEXT("retries"),        (double)Lane.Retries);
+		LaneObj->SetNumberField(TEXT("rate_limited"),   (double)Lane.RateLimited);
+		LaneObj->SetNumberField(TEXT("paused_s"),       FMath::Max(0.0, Lane.PausedUntil - Now));
+		LaneObj->SetNumberField(TEXT("request_limit"),  Lane.BucketCapacity);
+		LaneObj->SetNumberField(TEXT("bucket_tokens"),  Lane.BucketTokens);
+		LanesObj->SetObjectField(GetLaneName(Provider), LaneObj);
+	}
+
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetNumberField(TEXT("queued"),            Queue.Num());
+	Obj->SetNumberField(TEXT("in_flight"),         InFlight);
+	Obj->SetNumberField(TEXT("max_in_flight"),     MaxInFlight);
+	Obj->SetNumberField(TEXT("retries"),           (double)TotalRetries);
+	Obj->SetNumberField(TEXT("rate_limited"),      (double)TotalRateLimited);
+	Obj->SetNumberField(TEXT("max_queue_wait_ms"), MaxQueueWaitSeconds * 1000.0);
+	Obj->SetNumberField(TEXT("max_retries"),       MaxRetries);
+	Obj->SetNumberField(TEXT("backoff_base_ms"),   BackoffBaseSeconds * 1000.0);
+	Obj->SetNumberField(TEXT("backoff_max_ms"),    BackoffMaxSeconds * 1000.0);
+	Obj->SetObjectField(TEXT("lanes"), LanesObj);
+	return Obj;
+}
@@ -1,12 +1,25 @@
 #include "LLM/AgentForgeLLMSubsystem.h"
+#include "AgentForgeTrace.h"
+#include "LLM/AgentForgeLLMCache.h"
+#include "LLM/AgentForgeLLMScheduler.h"
+#include "LLM/AgentForgeSchemaService.h"
 #include "LLM/IAgentForgeLLMProvider.h"
 #include "LLM/Providers/AnthropicProvider.h"
 #include "LLM/Providers/DeepSeekProvider.h"
 #include "LLM/Providers/OpenAICompatibleProvider.h"
 #include "LLM/Providers/OpenAIProvider.h"
+#include "Async/Async.h"
+#include "Containers/StringConv.h"
 #include "HttpModule.h"
 #include "HttpManager.h"
 #include "HAL/PlatformMisc.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Misc/EngineVersionComparison.h"
+#include "Misc/ScopeLock.h"
+
+#include <atomic>
 
 namespace
 {
@@ -36,6 +49,143 @@ namespace
 		}
 	}
 
+	// Upper bound for a blocking wait; the request is cancelled (and completes as failed) after this.
+	static constexpr double BlockingTimeoutSeconds = 300.0;
+
+	// Incremental reader over a text/event-stream body that is still arriving. Only
+	// bytes up to the last newline are decoded, so a UTF-8 sequence is never split.
+	struct FSSEReader
+	{
+		int32 Consumed = 0;
+		FString EventName;
+		FString Data;
+		bool bHasData = false;
+
+		template <typename FnType>
+		void Read(const TArray<uint8>& Body, int32 Available, bool bFinal, FnType&& OnEvent)
+		{
+			Available = FMath::Min(Available, Body.Num());
+			int32 End = Available;
+			if (!bFinal)
+			{
+				while (End > Consumed && Body[End - 1] != '\n')
+				{
+					--End;
+				}
+			}
+			if (End > Consumed)
+			{
+				const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Body.GetData() + Consumed), End - Consumed);
+				const FString Text(Converted.Length(), Converted.Get());
+				Consumed = End;
+
+				TArray<FString> Lines;
+				Text.ParseIntoArray(Lines, TEXT("\n"), false);
+				for (FString& Line : Lines)
+				{
+					Line.RemoveFromEnd(TEXT("\r"));
+					ReadLine(Line, OnEvent);
+				}
+			}
+			if (bFinal)
+			{
+				ReadLine(FString(), OnEvent);
+			}
+		}
+
+	private:
+		template <typename FnType>
+		void ReadLine(const FString& Line, FnType& OnEvent)
+		{
+			if (Line.IsEmpty())
+			{
+				if (bHasData)
+				{
+					OnEvent(EventName, Data);
+				}
+				EventName.Reset();
+				Data.Reset();
+				bHasData = false;
+				return;
+			}
+			if (Line.StartsWith(TEXT(":")))
+			{
+				return;
+			}
+
+			FString Field = Line;
+			FString Value;
+			int32 Colon = INDEX_NONE;
+			if (Line.FindChar(TEXT(':'), Colon))
+			{
+				Field = Line.Left(Colon);
+				Value = Line.Mid(Colon + 1);
+				Value.RemoveFromStart(TEXT(" "));
+			}
+
+			if (Field == TEXT("event"))
+			{
+				EventName = Value;
+			}
+			else if (Field == TEXT("data"))
+			{
+				if (bHasData)
+				{
+					Data += TEXT("\n");
+				}
+				Data += Value;
+				bHasData = true;
+			}
+		}
+	};
+
+	/** Inline for blocking waits (whichever thread the HTTP callback fires on), otherwise on the game thread. */
+	static void DeliverOn(bool bInline, TFunction<void()>&& Fn)
+	{
+		if (bInline || IsInGameThread())
+		{
+			Fn();
+		}
+		else
+		{
+			AsyncTask(ENamedThreads::GameThread, MoveTemp(Fn));
+		}
+	}
+
+	struct FStreamContext
+	{
+		FSSEReader Reader;
+		FAgentForgeLLMStreamState State;
+	};
+
+	// Shared by a fan-out's candidate completions. Once settled the result is final and later completions are ignored.
+	struct FFanOutState
+	{
+		FCriticalSection Lock;
+		FAgentForgeLLMFanOutResult Result;
+		TArray<int32> RequestIds;
+		TArray<bool> Done;
+		int32 Remaining = 0;
+		bool bSettled = false;
+		double StartTime = 0.0;
+	};
+
+	static FAgentForgeLLMSettings MakeStructuredSettings(
+		const FString& Prompt,
+		const FString& JsonSchema,
+		const FAgentForgeLLMSettings& Settings)
+	{
+		FAgentForgeLLMSettings StructuredSettings = Settings;
+		StructuredSettings.ResponseSchema = JsonSchema;
+		StructuredSettings.Messages.Empty();
+
+		FAgentForgeChatMessage PromptMessage;
+		PromptMessage.Role = TEXT("user");
+		PromptMessage.Content = Prompt;
+		StructuredSettings.Messages.Add(PromptMessage);
+		return StructuredSettings;
+	}
+
 	static TSharedPtr<IAgentForgeLLMProvider> MakeProvider(EAgentForgeLLMProvider Provider)
 	{
 		switch (Provider)
@@ -57,11 +207,45 @@ namespace
 void UAgentForgeLLMSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
+	Scheduler = MakeShared<FAgentForgeLLMScheduler, ESPMode::ThreadSafe>();
+	TickHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateUObject(this, &UAgentForgeLLMSubsystem::Tick));
 	UE_LOG(LogTemp, Log, TEXT("[UEAgentForge] LLM subsystem initialized."));
 }
 
 void UAgentForgeLLMSubsystem::Deinitialize()
 {
+	if (TickHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+		TickHandle.Reset();
+	}
+
+	// Completions hold a weak pointer, but unbinding first keeps cancelled requests from reporting at all.
+	if (Scheduler.IsValid())
+	{
+		Scheduler->Reset();
+	}
+	TArray<FHttpRequestPtr> Pending;
+	{
+		FScopeLock Lock(&InFlightLock);
+		for (const TPair<int32, FRequestContextRef>& Pair : InFlight)
+		{
+			Pair.Value->bCancelRequested = true;
+			if (Pair.Value->HttpRequest.IsValid())
+			{
+				Pending.Add(Pair.Value->HttpRequest);
+			}
+		}
+		Cancelled += InFlight.Num();
+		InFlight.Empty();
+	}
+	for (const FHttpRequestPtr& Request : Pending)
+	{
+		Request->OnProcessRequestComplete().Unbind();
+		Request->CancelRequest();
+	}
+
 	Providers.Empty();
 	Super::Deinitialize();
 	UE_LOG(LogTemp, Log, TEXT("[UEAgentForge] LLM subsystem deinitialized."));
@@ -71,8 +255,10 @@ void UAgentForgeLLMSubsystem::SendChatRequest(
 	const FAgentForgeLLMSettings& Settings,
 	const FOnLLMResponseReceived& OnComplete)
 {
-	const FAgentForgeLLMResponse Response = SendChatRequestBlocking(Settings);
-	OnComplete.ExecuteIfBound(Response);
+	SendChatRequestAsync(Settings, [OnComplete](const FAgentForgeLLMResponse& Response)
+	{
+		OnComplete.ExecuteIfBound(Response);
+	});
 }
 
 void UAgentForgeLLMSubsystem::SendStreamingChatRequest(
@@ -80,12 +266,18 @@ void UAgentForgeLLMSubsystem::SendStreamingChatRequest(
 	const FOnLLMStreamChunk& OnChunk,
 	const FOnLLMResponseReceived& OnComplete)
 {
-	const FAgentForgeLLMResponse Response = SendChatRequestBlocking(Settings);
-	if (Response.bSuccess && !Response.Content.IsEmpty())
-	{
-		OnChunk.ExecuteIfBound(Response.Content);
-	}
-	OnComplete.ExecuteIfBound(Response);
+	FAgentForgeLLMSettings StreamSettings = Settings;
+	StreamSettings.bStreamResponse = true;
+	SendChatRequestAsync(
+		StreamSettings,
+		[OnComplete](const FAgentForgeLLMResponse& Response)
+		{
+			OnComplete.ExecuteIfBound(Response);
+		},
+		[OnChunk](const FString& Chunk)
+		{
+			OnChunk.ExecuteIfBound(Chunk);
+		});
 }
 
 void UAgentForgeLLMSubsystem::SendStructuredRequest(
@@ -94,8 +286,10 @@ void UAgentForgeLLMSubsystem::SendStructuredRequest(
 	const FAgentForgeLLMSettings& Settings,
 	const FOnLLMResponseReceived& OnComplete)
 {
-	const FAgentForgeLLMResponse Response = SendStructuredRequestBlocking(Prompt, JsonSchema, Settings);
-	OnComplete.ExecuteIfBound(Response);
+	SendChatRequestAsync(MakeStructuredSettings(Prompt, JsonSchema, Settings), [OnComplete](const FAgentForgeLLMResponse& Response)
+	{
+		OnComplete.ExecuteIfBound(Response);
+	});
 }
 
 void UAgentForgeLLMSubsystem::SetApiKeyRuntime(EAgentForgeLLMProvider Provider, const FString& Key)
@@ -154,9 +348,19 @@ TArray<FString> UAgentForgeLLMSubsystem::GetAvailableModels(EAgentForgeLLMProvid
 	return {};
 }
 
-FAgentForgeLLMResponse UAgentForgeLLMSubsystem::SendChatRequestBlocking(const FAgentForgeLLMSettings& Settings)
+int32 UAgentForgeLLMSubsystem::SendChatRequestAsync(
+	const FAgentForgeLLMSettings& Settings,
+	FAgentForgeLLMCompletion OnComplete,
+	FAgentForgeLLMChunkHandler OnChunk)
 {
-	return ExecuteBlockingRequest(Settings);
+	return DispatchRequest(Settings, MoveTemp(OnComplete), MoveTemp(OnChunk), false);
+}
+
+FAgentForgeLLMResponse UAgentForgeLLMSubsystem::SendChatRequestBlocking(
+	const FAgentForgeLLMSettings& Settings,
+	FAgentForgeLLMChunkHandler OnChunk)
+{
+	return ExecuteBlockingRequest(Settings, MoveTemp(OnChunk));
 }
 
 FAgentForgeLLMResponse UAgentForgeLLMSubsystem::SendStructuredRequestBlocking(
@@ -164,16 +368,109 @@ FAgentForgeLLMResponse UAgentForgeLLMSubsystem::SendStructuredRequestBlocking(
 	const FString& JsonSchema,
 	const FAgentForgeLLMSettings& Settings)
 {
-	FAgentForgeLLMSettings StructuredSettings = Settings;
-	StructuredSettings.ResponseSchema = JsonSchema;
-	StructuredSettings.Messages.Empty();
+	return ExecuteBlockingRequest(MakeStructuredSettings(Prompt, JsonSchema, Settings));
+}
+
+void UAgentForgeLLMSubsystem::SendFanOutRequestAsync(
+	const TArray<FAgentForgeLLMSettings>& Candidates,
+	EAgentForgeLLMFanOutMode Mode,
+	double HedgeDelaySeconds,
+	FAgentForgeLLMFanOutCompletion OnComplete,
+	FAgentForgeLLMAcceptor Acceptor)
+{
+	DispatchFanOut(Candidates, Mode, HedgeDelaySeconds, MoveTemp(OnComplete), MoveTemp(Acceptor), false);
+}
+
+FAgentForgeLLMFanOutResult UAgentForgeLLMSubsystem::SendFanOutRequestBlocking(
+	const TArray<FAgentForgeLLMSettings>& Candidates,
+	EAgentForgeLLMFanOutMode Mode,
+	double HedgeDelaySeconds,
+	FAgentForgeLLMAcceptor Acceptor)
+{
+	struct FBlockingState
+	{
+		FAgentForgeLLMFanOutResult Result;
+		std::atomic<bool> bDone { false };
+	};
+	TSharedRef<FBlockingState, ESPMode::ThreadSafe> State = MakeShared<FBlockingState, ESPMode::ThreadSafe>();
+
+	const TArray<int32> RequestIds = DispatchFanOut(Candidates, Mode, HedgeDelaySeconds, [State](const FAgentForgeLLMFanOutResult& Result)
+	{
+		State->Result = Result;
+		State->bDone = true;
+	}, MoveTemp(Acceptor), true);
+
+	if (!WaitForRequests(RequestIds, [State]() { return State->bDone.load(); }))
+	{
+		FAgentForgeLLMFanOutResult TimedOut;
+		TimedOut.Responses.SetNum(Candidates.Num());
+		TimedOut.LatencyMs.Init(BlockingTimeoutSeconds * 1000.0, Candidates.Num());
+		TimedOut.Accepted.Init(false, Candidates.Num());
+		TimedOut.Cancelled.Init(true, Candidates.Num());
+		for (FAgentForgeLLMResponse& Response : TimedOut.Responses)
+		{
+			Response.ErrorMessage = FString::Printf(TEXT("LLM request timed out after %.0f s."), BlockingTimeoutSeconds);
+		}
+		return TimedOut;
+	}
+	return State->Result;
+}
+
+void UAgentForgeLLMSubsystem::CancelRequest(int32 RequestId)
+{
+	FHttpRequestPtr Request;
+	{
+		FScopeLock Lock(&InFlightLock);
+		const FRequestContextRef* Context = InFlight.Find(RequestId);
+		if (!Context)
+		{
+			return;
+		}
+		(*Context)->bCancelRequested = true;
+		Request = (*Context)->HttpRequest;
+	}
+	// Still queued (first attempt or waiting out a backoff): complete it without sending.
+	if (!Scheduler->Cancel(RequestId) && Request.IsValid())
+	{
+		Request->CancelRequest();
+	}
+}
+
+int32 UAgentForgeLLMSubsystem::GetNumInFlightRequests() const
+{
+	FScopeLock Lock(&InFlightLock);
+	return InFlight.Num();
+}
+
+void UAgentForgeLLMSubsystem::ApplySchedulerPolicy(const TSharedPtr<FJsonObject>& Args, const EAgentForgeLLMProvider* Provider)
+{
+	if (Scheduler.IsValid())
+	{
+		Scheduler->ApplyPolicy(Args, Provider);
+	}
+}
 
-	FAgentForgeChatMessage PromptMessage;
-	PromptMessage.Role = TEXT("user");
-	PromptMessage.Content = Prompt;
-	StructuredSettings.Messages.Add(PromptMessage);
+TSharedPtr<FJsonObject> UAgentForgeLLMSubsystem::GetStatsJson() const
+{
+	const TSharedPtr<FJsonObject> SchedulerStats = Scheduler.IsValid() ? Scheduler->GetStatsJson() : MakeShared<FJsonObject>();
 
-	return ExecuteBlockingRequest(StructuredSettings);
+	FScopeLock Lock(&InFlightLock);
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetNumberField(TEXT("in_flight"),     SchedulerStats->GetNumberField(TEXT("in_flight")));
+	Obj->SetNumberField(TEXT("queued"),        SchedulerStats->GetNumberField(TEXT("queued")));
+	Obj->SetNumberField(TEXT("max_in_flight"), SchedulerStats->GetNumberField(TEXT("max_in_flight")));
+	Obj->SetNumberField(TEXT("dispatched"),    (double)Dispatched);
+	Obj->SetNumberField(TEXT("streamed"),      (double)Streamed);
+	Obj->SetNumberField(TEXT("completed"),     (double)Completed);
+	Obj->SetNumberField(TEXT("failed"),        (double)Failed);
+	Obj->SetNumberField(TEXT("cancelled"),     (double)Cancelled);
+	Obj->SetNumberField(TEXT("fan_outs"),      (double)FanOuts);
+	Obj->SetNumberField(TEXT("fan_out_cancelled"), (double)FanOutCancelled);
+	Obj->SetNumberField(TEXT("prompt_tokens"),        (double)PromptTokens);
+	Obj->SetNumberField(TEXT("cached_prompt_tokens"), (double)CachedPromptTokens);
+	Obj->SetNumberField(TEXT("cache_write_tokens"),   (double)CacheWriteTokens);
+	Obj->SetObjectField(TEXT("scheduler"), SchedulerStats);
+	return Obj;
 }
 
 TSharedPtr<IAgentForgeLLMProvider> UAgentForgeLLMSubsystem::GetOrCreateProvider(EAgentForgeLLMProvider Provider)
@@ -191,49 +488,514 @@ TSharedPtr<IAgentForgeLLMProvider> UAgentForgeLLMSubsystem::GetOrCreateProvider(
 	return Created;
 }
 
-FAgentForgeLLMResponse UAgentForgeLLMSubsystem::ExecuteBlockingRequest(const FAgentForgeLLMSettings& Settings)
+struct UAgentForgeLLMSubsystem::FRequestContext
 {
-	FAgentForgeLLMResponse Response;
+	int32 RequestId = 0;
+	int32 Attempt = 0;
+	bool bCompleteInline = false;
+	std::atomic<bool> bCancelRequested { false };
+	TSharedPtr<IAgentForgeLLMProvider> Provider;
+	TSharedPtr<FAgentForgeLLMScheduler, ESPMode::ThreadSafe> Scheduler;
+	FAgentForgeLLMSettings Settings;   // bStreamResponse resolved against the provider
+	FString ApiKey;
+	FString CacheKey;
+	FHttpRequestPtr HttpRequest;       // current attempt; the first is built at dispatch so setup errors surface there
+	FAgentForgeLLMCompletion OnComplete;
+	TSharedRef<FAgentForgeLLMChunkHandler, ESPMode::ThreadSafe> OnChunk = MakeShared<FAgentForgeLLMChunkHandler, ESPMode::ThreadSafe>();
+};
+
+bool UAgentForgeLLMSubsystem::Tick(float DeltaTime)
+{
+	// Backoff delays and rate-limit pauses expire between completions.
+	if (Scheduler.IsValid() && Scheduler->HasQueued())
+	{
+		Scheduler->Pump();
+	}
+	return true;
+}
+
+int32 UAgentForgeLLMSubsystem::DispatchRequest(
+	const FAgentForgeLLMSettings& Settings,
+	FAgentForgeLLMCompletion OnComplete,
+	FAgentForgeLLMChunkHandler OnChunk,
+	bool bCompleteInline,
+	double StartDelaySeconds)
+{
+	AGENTFORGE_TRACE_SCOPE("AgentForge.LLM.DispatchRequest");
+	auto FailNow = [&OnComplete](const FString& Error)
+	{
+		FAgentForgeLLMResponse Response;
+		Response.ErrorMessage = Error;
+		if (OnComplete)
+		{
+			OnComplete(Response);
+		}
+		return 0;
+	};
 
 	TSharedPtr<IAgentForgeLLMProvider> Provider = GetOrCreateProvider(Settings.Provider);
-	if (!Provider.IsValid())
+	if (!Provider.IsValid() || !Scheduler.IsValid())
+	{
+		return FailNow(TEXT("Unsupported LLM provider."));
+	}
+
+	// Cache lookups come before the key check so "only" replays work offline.
+	FString CacheKey;
+	if (Settings.CacheMode != EAgentForgeLLMCacheMode::Bypass)
 	{
-		Response.ErrorMessage = TEXT("Unsupported LLM provider.");
-		return Response;
+		CacheKey = FAgentForgeLLMResponseCache::MakeKey(Settings);
+		FAgentForgeLLMResponse Cached;
+		if (FAgentForgeLLMResponseCache::Get().Find(CacheKey, Cached))
+		{
+			if (OnChunk)
+			{
+				OnChunk(Cached.Content);
+			}
+			if (OnComplete)
+			{
+				OnComplete(Cached);
+			}
+			return 0;
+		}
+		if (Settings.CacheMode == EAgentForgeLLMCacheMode::Only)
+		{
+			return FailNow(TEXT("No cached response for this request (cache: only)."));
+		}
 	}
 
 	const FString ApiKey = GetApiKey(Settings.Provider);
 	if (ApiKey.IsEmpty() && Settings.Provider != EAgentForgeLLMProvider::OpenAICompatible)
 	{
-		Response.ErrorMessage = TEXT("No API key configured for the selected provider.");
-		return Response;
+		return FailNow(TEXT("No API key configured for the selected provider."));
 	}
 
+	FRequestContextRef Context = MakeShared<FRequestContext, ESPMode::ThreadSafe>();
+	Context->bCompleteInline = bCompleteInline;
+	Context->Provider = Provider;
+	Context->Scheduler = Scheduler;
+	Context->Settings = Settings;
+	Context->Settings.bStreamResponse = Settings.bStreamResponse && Provider->SupportsStreaming();
+	Context->ApiKey = ApiKey;
+	Context->CacheKey = MoveTemp(CacheKey);
+
 	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
 	FString PrepareError;
-	if (!Provider->PrepareRequest(Settings, ApiKey, Request, PrepareError))
+	if (!Provider->PrepareRequest(Context->Settings, ApiKey, Request, PrepareError))
 	{
-		Response.ErrorMessage = PrepareError;
-		return Response;
+		return FailNow(PrepareError);
+	}
+	Context->HttpRequest = Request;
+	Context->OnComplete = MoveTemp(OnComplete);
+	*Context->OnChunk = MoveTemp(OnChunk);
+
+	{
+		FScopeLock Lock(&InFlightLock);
+		Context->RequestId = NextRequestId++;
+		InFlight.Add(Context->RequestId, Context);
+		++Dispatched;
+		Streamed += Context->Settings.bStreamResponse ? 1 : 0;
+	}
+
+	const int32 RequestId = Context->RequestId;
+	EnqueueAttempt(this, Context, FMath::Max(0.0, StartDelaySeconds));
+	// An idle lane starts the request now rather than on the next tick.
+	Scheduler->Pump();
+	return RequestId;
+}
+
+void UAgentForgeLLMSubsystem::EnqueueAttempt(TWeakObjectPtr<UAgentForgeLLMSubsystem> WeakThis, const FRequestContextRef& Context, double DelaySeconds)
+{
+	Context->Scheduler->Enqueue(
+		Context->RequestId,
+		Context->Settings.Provider,
+		Context->Settings.Priority,
+		[WeakThis, Context]()
+		{
+			if (UAgentForgeLLMSubsystem* Self = WeakThis.Get())
+			{
+				Self->StartAttempt(Context);
+			}
+		},
+		[WeakThis, Context]()
+		{
+			FAgentForgeLLMResponse Response;
+			Response.ErrorMessage = TEXT("LLM request cancelled before it was sent.");
+			FinishRequest(WeakThis, Context, MoveTemp(Response), false);
+		},
+		DelaySeconds);
+}
+
+void UAgentForgeLLMSubsystem::FinishRequest(
+	TWeakObjectPtr<UAgentForgeLLMSubsystem> WeakThis,
+	const FRequestContextRef& Context,
+	FAgentForgeLLMResponse&& Response,
+	bool bWholeChunk)
+{
+	AGENTFORGE_TRACE_SCOPE("AgentForge.LLM.FinishRequest");
+	DeliverOn(Context->bCompleteInline, [WeakThis, Context, bWholeChunk, Response = MoveTemp(Response)]()
+	{
+		// The request's completion delegate holds the context; dropping the request breaks the cycle.
+		if (UAgentForgeLLMSubsystem* Self = WeakThis.Get())
+		{
+			FScopeLock Lock(&Self->InFlightLock);
+			Self->InFlight.Remove(Context->RequestId);
+			Context->HttpRequest.Reset();
+			++(Response.bSuccess ? Self->Completed : Self->Failed);
+			Self->PromptTokens += Response.PromptTokens;
+			Self->CachedPromptTokens += Response.CachedPromptTokens;
+			Self->CacheWriteTokens += Response.CacheWriteTokens;
+		}
+		else
+		{
+			Context->HttpRequest.Reset();
+		}
+		if (bWholeChunk && Response.bSuccess && *Context->OnChunk)
+		{
+			(*Context->OnChunk)(Response.Content);
+		}
+		if (Context->OnComplete)
+		{
+			Context->OnComplete(Response);
+		}
+	});
+}
+
+void UAgentForgeLLMSubsystem::StartAttempt(const FRequestContextRef& Context)
+{
+	AGENTFORGE_TRACE_SCOPE("AgentForge.LLM.StartAttempt");
+	TWeakObjectPtr<UAgentForgeLLMSubsystem> WeakThis(this);
+	const TSharedPtr<IAgentForgeLLMProvider> Provider = Context->Provider;
+	const TSharedPtr<FAgentForgeLLMScheduler, ESPMode::ThreadSafe> LaneScheduler = Context->Scheduler;
+
+	auto FailAttempt = [&](const FString& Error)
+	{
+		LaneScheduler->OnFinished(Context->Settings.Provider, nullptr);
+		FAgentForgeLLMResponse Response;
+		Response.ErrorMessage = Error;
+		FinishRequest(WeakThis, Context, MoveTemp(Response), false);
+	};
+
+	if (Context->bCancelRequested)
+	{
+		FailAttempt(TEXT("LLM request cancelled before it was sent."));
+		return;
+	}
+
+	// Retries need a fresh request; the prepared body is rebuilt from the same settings.
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = Context->Attempt == 0 && Context->HttpRequest.IsValid()
+		? Context->HttpRequest.ToSharedRef()
+		: FHttpModule::Get().CreateRequest();
+	if (Context->Attempt > 0)
+	{
+		FString PrepareError;
+		if (!Provider->PrepareRequest(Context->Settings, Context->ApiKey, Request, PrepareError))
+		{
+			FailAttempt(PrepareError);
+			return;
+		}
+		FScopeLock Lock(&InFlightLock);
+		Context->HttpRequest = Request;
+	}
+
+	// Chunks follow the same threading rule as the completion, so their order is kept.
+	const bool bCompleteInline = Context->bCompleteInline;
+	TSharedRef<FAgentForgeLLMChunkHandler, ESPMode::ThreadSafe> ChunkHandler = Context->OnChunk;
+	auto ReadStream = [Provider, ChunkHandler, bCompleteInline](FStreamContext& Stream, const TArray<uint8>& Body, int32 Available, bool bFinal)
+	{
+		Stream.Reader.Read(Body, Available, bFinal, [&](const FString& EventName, const FString& Data)
+		{
+			FString Delta;
+			Provider->ParseStreamEvent(EventName, Data, Stream.State, Delta);
+			if (!Delta.IsEmpty() && *ChunkHandler)
+			{
+				DeliverOn(bCompleteInline, [ChunkHandler, Delta = MoveTemp(Delta)]() { (*ChunkHandler)(Delta); });
+			}
+		});
+	};
+
+	// Only 2xx bodies are read as a stream, so a retried attempt has delivered no chunks.
+	TSharedPtr<FStreamContext, ESPMode::ThreadSafe> Stream;
+	if (Context->Settings.bStreamResponse)
+	{
+		Stream = MakeShared<FStreamContext, ESPMode::ThreadSafe>();
+		auto OnProgress = [Stream, ReadStream](FHttpRequestPtr HttpRequest, uint64 /*BytesSent*/, uint64 BytesReceived)
+		{
+			const FHttpResponsePtr HttpResponse = HttpRequest.IsValid() ? HttpRequest->GetResponse() : nullptr;
+			if (!HttpResponse.IsValid() || HttpResponse->GetResponseCode() < 200 || HttpResponse->GetResponseCode() >= 300)
+			{
+				return;
+			}
+			ReadStream(*Stream, HttpResponse->GetContent(), (int32)BytesReceived, false);
+		};
+#if UE_VERSION_OLDER_THAN(5, 4, 0)
+		Request->OnRequestProgress().BindLambda([OnProgress](FHttpRequestPtr HttpRequest, int32 BytesSent, int32 BytesReceived)
+		{
+			OnProgress(HttpRequest, (uint64)BytesSent, (uint64)BytesReceived);
+		});
+#else
+		Request->OnRequestProgress64().BindLambda(OnProgress);
+#endif
 	}
 
 	Request->OnProcessRequestComplete().BindLambda(
-		[&Response, Provider](FHttpRequestPtr /*Unused*/, FHttpResponsePtr HttpResponse, bool bSucceeded)
+		[WeakThis, Context, Stream, ReadStream]
+		(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded)
 		{
-			Response = Provider->ParseResponse(HttpResponse, bSucceeded);
+			FAgentForgeLLMScheduler& LaneScheduler = *Context->Scheduler;
+			LaneScheduler.OnFinished(Context->Settings.Provider, HttpResponse);
+
+			if (!Context->bCancelRequested)
+			{
+				const double RetryDelay = LaneScheduler.GetRetryDelay(Context->Settings.Provider, HttpResponse, bSucceeded, Context->Attempt);
+				if (RetryDelay >= 0.0)
+				{
+					UE_LOG(LogTemp, Log, TEXT("[UEAgentForge] LLM request %d: HTTP %d, retry %d in %.1f s."),
+						Context->RequestId, HttpResponse.IsValid() ? HttpResponse->GetResponseCode() : 0, Context->Attempt + 1, RetryDelay);
+					++Context->Attempt;
+					EnqueueAttempt(WeakThis, Context, RetryDelay);
+					DeliverOn(Context->bCompleteInline, [Scheduler = Context->Scheduler]() { Scheduler->Pump(); });
+					return;
+				}
+			}
+
+			// Parsing can be heavy for long completions; it runs wherever the HTTP module delivers the callback.
+			FAgentForgeLLMResponse Response;
+			const bool bStreamBody = Stream.IsValid() && bSucceeded && HttpResponse.IsValid()
+				&& HttpResponse->GetResponseCode() >= 200 && HttpResponse->GetResponseCode() < 300;
+			if (bStreamBody)
+			{
+				// Frames that arrived after the last progress callback.
+				ReadStream(*Stream, HttpResponse->GetContent(), HttpResponse->GetContent().Num(), true);
+				const FAgentForgeLLMStreamState& State = Stream->State;
+				Response.RawJSON = HttpResponse->GetContentAsString();
+				Response.Content = State.Content;
+				Response.ReasoningContent = State.ReasoningContent;
+				Response.PromptTokens = State.PromptTokens;
+				Response.CachedPromptTokens = State.CachedPromptTokens;
+				Response.CacheWriteTokens = State.CacheWriteTokens;
+				Response.CompletionTokens = State.CompletionTokens;
+				Response.ErrorMessage = State.ErrorMessage;
+				Response.bSuccess = State.ErrorMessage.IsEmpty() && !State.Content.IsEmpty();
+				if (!Response.bSuccess && Response.ErrorMessage.IsEmpty())
+				{
+					Response.ErrorMessage = TEXT("Stream ended without text content.");
+				}
+			}
+			else
+			{
+				Response = Context->Provider->ParseResponse(HttpResponse, bSucceeded);
+			}
+			if (!Response.bSuccess && Response.ErrorMessage.IsEmpty() && Response.RawJSON.IsEmpty())
+			{
+				Response.ErrorMessage = TEXT("HTTP request completed without a parsed response.");
+			}
+			if (!Context->CacheKey.IsEmpty())
+			{
+				FAgentForgeLLMResponseCache::Get().Store(Context->CacheKey, Response);
+			}
+
+			FinishRequest(WeakThis, Context, MoveTemp(Response), !Stream.IsValid());
+
+			// The freed slot may admit the next queued request.
+			DeliverOn(Context->bCompleteInline, [Scheduler = Context->Scheduler]() { Scheduler->Pump(); });
 		});
 
 	if (!Request->ProcessRequest())
 	{
-		Response.ErrorMessage = TEXT("Failed to dispatch HTTP request.");
-		return Response;
+		Request->OnProcessRequestComplete().Unbind();
+		FailAttempt(TEXT("Failed to dispatch HTTP request."));
+	}
+}
+
+TArray<int32> UAgentForgeLLMSubsystem::DispatchFanOut(
+	const TArray<FAgentForgeLLMSettings>& Candidates,
+	EAgentForgeLLMFanOutMode Mode,
+	double HedgeDelaySeconds,
+	FAgentForgeLLMFanOutCompletion OnComplete,
+	FAgentForgeLLMAcceptor Acceptor,
+	bool bCompleteInline)
+{
+	AGENTFORGE_TRACE_SCOPE("AgentForge.LLM.DispatchFanOut");
+	const int32 Num = Candidates.Num();
+	TSharedRef<FFanOutState, ESPMode::ThreadSafe> State = MakeShared<FFanOutState, ESPMode::ThreadSafe>();
+	State->Result.Responses.SetNum(Num);
+	State->Result.LatencyMs.Init(0.0, Num);
+	State->Result.Accepted.Init(false, Num);
+	State->Result.Cancelled.Init(false, Num);
+	State->RequestIds.Init(0, Num);
+	State->Done.Init(false, Num);
+	State->Remaining = Num;
+	State->StartTime = FPlatformTime::Seconds();
+	{
+		FScopeLock Lock(&InFlightLock);
+		++FanOuts;
+	}
+	if (Num == 0)
+	{
+		if (OnComplete)
+		{
+			OnComplete(State->Result);
+		}
+		return {};
+	}
+
+	TWeakObjectPtr<UAgentForgeLLMSubsystem> WeakThis(this);
+	TSharedRef<FAgentForgeLLMFanOutCompletion, ESPMode::ThreadSafe> Completion =
+		MakeShared<FAgentForgeLLMFanOutCompletion, ESPMode::ThreadSafe>(MoveTemp(OnComplete));
+
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		{
+			// A cache hit or a synchronous failure can settle the race before every candidate is sent.
+			FScopeLock Lock(&State->Lock);
+			if (State->bSettled)
+			{
+				break;
+			}
+		}
+
+		const FString Schema = Candidates[Index].ResponseSchema;
+		auto OnCandidateComplete = [WeakThis, State, Completion, Acceptor, Schema, Mode, Index](const FAgentForgeLLMResponse& Response)
+		{
+			const bool bAccepted = Acceptor
+				? Acceptor(Response)
+				: Response.bSuccess && (Schema.IsEmpty() || UAgentForgeSchemaService::ValidateJsonAgainstSchema(Response.Content, Schema));
+
+			TArray<int32> ToCancel;
+			{
+				FScopeLock Lock(&State->Lock);
+				if (State->bSettled)
+				{
+					return;
+				}
+				FAgentForgeLLMFanOutResult& Result = State->Result;
+				State->Done[Index] = true;
+				--State->Remaining;
+				Result.Responses[Index] = Response;
+				Result.LatencyMs[Index] = (FPlatformTime::Seconds() - State->StartTime) * 1000.0;
+				Result.Accepted[Index] = bAccepted;
+				if (bAccepted && Result.WinnerIndex == INDEX_NONE)
+				{
+					Result.WinnerIndex = Index;
+				}
+				if (State->Remaining > 0 && !(bAccepted && Mode == EAgentForgeLLMFanOutMode::First))
+				{
+					return;
+				}
+
+				State->bSettled = true;
+				for (int32 Other = 0; Other < State->Done.Num(); ++Other)
+				{
+					if (State->Done[Other])
+					{
+						continue;
+					}
+					Result.Cancelled[Other] = true;
+					Result.LatencyMs[Other] = Result.LatencyMs[Index];
+					Result.Responses[Other].ErrorMessage = FString::Printf(TEXT("Cancelled: candidate %d answered first."), Index);
+					if (State->RequestIds[Other] != 0)
+					{
+						ToCancel.Add(State->RequestIds[Other]);
+					}
+				}
+			}
+
+			// Cancelled candidates complete into the settled state above, so the lock is not held here.
+			if (UAgentForgeLLMSubsystem* Self = WeakThis.Get())
+			{
+				{
+					FScopeLock Lock(&Self->InFlightLock);
+					Self->FanOutCancelled += ToCancel.Num();
+				}
+				for (const int32 RequestId : ToCancel)
+				{
+					Self->CancelRequest(RequestId);
+				}
+			}
+			if (*Completion)
+			{
+				(*Completion)(State->Result);
+			}
+		};
+
+		// Backups wait out the hedge delay in the scheduler; cancelling them there sends nothing.
+		const int32 RequestId = DispatchRequest(
+			Candidates[Index],
+			MoveTemp(OnCandidateComplete),
+			nullptr,
+			bCompleteInline,
+			Index == 0 ? 0.0 : HedgeDelaySeconds);
+
+		bool bCancelNow = false;
+		{
+			FScopeLock Lock(&State->Lock);
+			State->RequestIds[Index] = RequestId;
+			bCancelNow = RequestId != 0 && State->bSettled && !State->Done[Index];
+		}
+		if (bCancelNow)
+		{
+			{
+				FScopeLock Lock(&InFlightLock);
+				++FanOutCancelled;
+			}
+			CancelRequest(RequestId);
+		}
 	}
 
-	FHttpModule::Get().GetHttpManager().Flush(EHttpFlushReason::FullFlush);
-	if (!Response.bSuccess && Response.ErrorMessage.IsEmpty() && Response.RawJSON.IsEmpty())
+	FScopeLock Lock(&State->Lock);
+	return State->RequestIds;
+}
+
+FAgentForgeLLMResponse UAgentForgeLLMSubsystem::ExecuteBlockingRequest(const FAgentForgeLLMSettings& Settings, FAgentForgeLLMChunkHandler OnChunk)
+{
+	AGENTFORGE_TRACE_SCOPE("AgentForge.LLM.ExecuteBlockingRequest");
+	struct FBlockingState
+	{
+		FAgentForgeLLMResponse Response;
+		std::atomic<bool> bDone { false };
+	};
+	TSharedRef<FBlockingState, ESPMode::ThreadSafe> State = MakeShared<FBlockingState, ESPMode::ThreadSafe>();
+
+	const int32 RequestId = DispatchRequest(Settings, [State](const FAgentForgeLLMResponse& Response)
+	{
+		State->Response = Response;
+		State->bDone = true;
+	}, MoveTemp(OnChunk), true);
+
+	// Setup errors complete synchronously; otherwise wait for this request only.
+	if (!WaitForRequests({ RequestId }, [State]() { return State->bDone.load(); }))
 	{
-		Response.ErrorMessage = TEXT("HTTP request completed without a parsed response.");
+		State->Response.ErrorMessage = FString::Printf(TEXT("LLM request timed out after %.0f s."), BlockingTimeoutSeconds);
 	}
 
-	return Response;
+	return State->Response;
+}
+
+bool UAgentForgeLLMSubsystem::WaitForRequests(const TArray<int32>& RequestIds, const TFunction<bool()>& IsDone)
+{
+	// The game-thread ticker is not running during the wait, so queued requests (these included)
+	// are admitted from here.
+	const double StartTime = FPlatformTime::Seconds();
+	FHttpManager& HttpManager = FHttpModule::Get().GetHttpManager();
+	while (!IsDone())
+	{
+		Scheduler->Pump();
+		HttpManager.Tick(0.0f);
+		if (IsDone())
+		{
+			break;
+		}
+		if (FPlatformTime::Seconds() - StartTime > BlockingTimeoutSeconds)
+		{
+			// Cancelling fires the completions as failures on the next tick.
+			for (const int32 RequestId : RequestIds)
+			{
+				CancelRequest(RequestId);
+			}
+			HttpManager.Tick(0.0f);
+			return IsDone();
+		}
+		FPlatformProcess::SleepNoStats(0.002f);
+	}
+	return true;
 }
@@ -0,0 +1,467 @@
+#include "LLM/AgentForgeSchemaRegistry.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace
+{
+	// Guards against $ref chains that point at each other without ever reaching a schema body.
+	static constexpr int32 MaxRefDepth = 32;
+
+	static FString NormalizeSchemaFileName(const FString& SchemaFileName)
+	{
+		FString FileName = SchemaFileName;
+		FileName.TrimStartAndEndInline();
+		if (!FileName.EndsWith(TEXT(".json"), ESearchCase::IgnoreCase))
+		{
+			FileName += TEXT(".json");
+		}
+		return FileName;
+	}
+
+	static TArray<FString> GetSchemaSearchPaths(const FString& FileName)
+	{
+		TArray<FString> Paths;
+		Paths.Add(FPaths::Combine(FPaths::ProjectContentDir(), TEXT("AgentForge"), TEXT("Schemas"), FileName));
+
+		if (TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("UEAgentForge")))
+		{
+			Paths.Add(FPaths::Combine(Plugin->GetContentDir(), TEXT("AgentForge"), TEXT("Schemas"), FileName));
+		}
+
+		return Paths;
+	}
+
+	static bool JsonValueEquals(const TSharedPtr<FJsonValue>& Left, const TSharedPtr<FJsonValue>& Right)
+	{
+		if (!Left.IsValid() || !Right.IsValid() || Left->Type != Right->Type)
+		{
+			return false;
+		}
+
+		switch (Left->Type)
+		{
+		case EJson::String:
+			return Left->AsString() == Right->AsString();
+		case EJson::Number:
+			return FMath::IsNearlyEqual(Left->AsNumber(), Right->AsNumber());
+		case EJson::Boolean:
+			return Left->AsBool() == Right->AsBool();
+		case EJson::Null:
+			return true;
+		default:
+			return Left->AsString() == Right->AsString();
+		}
+	}
+}
+
+struct FAgentForgeSchemaCompiler
+{
+	using FNode = FAgentForgeCompiledSchema::FNode;
+	using EType = FAgentForgeCompiledSchema::EType;
+
+	FAgentForgeCompiledSchema& Out;
+	TSharedPtr<FJsonObject> Root;
+	TMap<const FJsonObject*, int32> Compiled;   // schema object -> node, so shared and recursive $refs reuse one node
+
+	/** Local JSON pointer ("#", "#/definitions/foo"); null for anything else. */
+	TSharedPtr<FJsonObject> ResolveRef(const FString& Ref) const
+	{
+		if (!Ref.StartsWith(TEXT("#")))
+		{
+			return nullptr;
+		}
+
+		TArray<FString> Segments;
+		Ref.Mid(1).ParseIntoArray(Segments, TEXT("/"), true);
+		TSharedPtr<FJsonObject> Current = Root;
+		for (FString& Segment : Segments)
+		{
+			Segment.ReplaceInline(TEXT("~1"), TEXT("/"));
+			Segment.ReplaceInline(TEXT("~0"), TEXT("~"));
+			const TSharedPtr<FJsonObject>* Next = nullptr;
+			if (!Current.IsValid() || !Current->TryGetObjectField(Segment, Next) || !Next)
+			{
+				return nullptr;
+			}
+			Current = *Next;
+		}
+		return Current;
+	}
+
+	int32 CompileNode(TSharedPtr<FJsonObject> Schema, int32 RefDepth = 0)
+	{
+		// Siblings of $ref are ignored, as in draft-07. An unresolved $ref accepts anything.
+		FString Ref;
+		while (Schema.IsValid() && Schema->TryGetStringField(TEXT("$ref"), Ref))
+		{
+			if (++RefDepth > MaxRefDepth)
+			{
+				Schema.Reset();
+				break;
+			}
+			Schema = ResolveRef(Ref);
+		}
+
+		if (const int32* Existing = Schema.IsValid() ? Compiled.Find(Schema.Get()) : nullptr)
+		{
+			return *Existing;
+		}
+
+		const int32 Index = Out.Nodes.AddDefaulted();
+		if (!Schema.IsValid())
+		{
+			return Index;
+		}
+		Compiled.Add(Schema.Get(), Index);
+
+		// Children are compiled into locals first: compiling them grows Out.Nodes.
+		FNode Node;
+		const TArray<TSharedPtr<FJsonValue>>* EnumValues = nullptr;
+		if (Schema->TryGetArrayField(TEXT("enum"), EnumValues) && EnumValues && EnumValues->Num() > 0)
+		{
+			Node.bHasEnum = true;
+			for (const TSharedPtr<FJsonValue>& Allowed : *EnumValues)
+			{
+				if (Allowed.IsValid() && Allowed->Type == EJson::String)
+				{
+					Node.EnumStrings.Add(Allowed->AsString());
+				}
+				else
+				{
+					Node.EnumOthers.Add(Allowed);
+				}
+			}
+		}
+
+		FString TypeString;
+		Schema->TryGetStringField(TEXT("type"), TypeString);
+		TypeString.ToLowerInline();
+		if (TypeString.IsEmpty())
+		{
+			if (Schema->HasField(TEXT("properties")))
+			{
+				TypeString = TEXT("object");
+			}
+			else if (Schema->HasField(TEXT("items")))
+			{
+				TypeString = TEXT("array");
+			}
+		}
+
+		if (TypeString == TEXT("object"))
+		{
+			Node.Type = EType::Object;
+			const TArray<TSharedPtr<FJsonValue>>* RequiredFields = nullptr;
+			if (Schema->TryGetArrayField(TEXT("required"), RequiredFields) && RequiredFields)
+			{
+				for (const TSharedPtr<FJsonValue>& RequiredValue : *RequiredFields)
+				{
+					const FString FieldName = RequiredValue.IsValid() ? RequiredValue->AsString() : FString();
+					if (!FieldName.IsEmpty())
+					{
+						Node.Required.AddUnique(FieldName);
+					}
+				}
+			}
+
+			const TSharedPtr<FJsonObject>* PropertySchemas = nullptr;
+			if (Schema->TryGetObjectField(TEXT("properties"), PropertySchemas) && PropertySchemas && (*PropertySchemas).IsValid())
+			{
+				for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : (*PropertySchemas)->Values)
+				{
+					const TSharedPtr<FJsonObject>* FieldSchema = nullptr;
+					if (Pair.Value.IsValid() && Pair.Value->TryGetObject(FieldSchema) && FieldSchema && (*FieldSchema).IsValid())
+					{
+						Node.Properties.Add(Pair.Key, CompileNode(*FieldSchema));
+					}
+					else
+					{
+						// Listed but not a schema: the name still counts for additionalProperties.
+						Node.Properties.Add(Pair.Key, INDEX_NONE);
+					}
+				}
+				Node.bClosed = Schema->HasTypedField<EJson::Boolean>(TEXT("additionalProperties")) &&
+					!Schema->GetBoolField(TEXT("additionalProperties"));
+			}
+		}
+		else if (TypeString == TEXT("array"))
+		{
+			Node.Type = EType::Array;
+			const TSharedPtr<FJsonObject>* ItemSchema = nullptr;
+			if (Schema->TryGetObjectField(TEXT("items"), ItemSchema) && ItemSchema && (*ItemSchema).IsValid())
+			{
+				Node.Items = CompileNode(*ItemSchema);
+			}
+		}
+		else if (TypeString == TEXT("string"))
+		{
+			Node.Type = EType::String;
+		}
+		else if (TypeString == TEXT("number"))
+		{
+			Node.Type = EType::Number;
+		}
+		else if (TypeString == TEXT("integer"))
+		{
+			Node.Type = EType::Integer;
+		}
+		else if (TypeString == TEXT("boolean"))
+		{
+			Node.Type = EType::Boolean;
+		}
+
+		Out.Nodes[Index] = MoveTemp(Node);
+		return Index;
+	}
+};
+
+bool FAgentForgeCompiledSchema::Validate(const TSharedPtr<FJsonValue>& Value, FString* OutError) const
+{
+	if (Nodes.Num() == 0 || ValidateNode(0, Value, nullptr, nullptr))
+	{
+		return true;
+	}
+	// Paths cost an allocation per level, so they are only built to describe a failure.
+	if (OutError)
+	{
+		const FString RootPath = TEXT("$");
+		ValidateNode(0, Value, &RootPath, OutError);
+	}
+	return false;
+}
+
+bool FAgentForgeCompiledSchema::Validate(const TSharedPtr<FJsonObject>& Object, FString* OutError) const
+{
+	TSharedPtr<FJsonValue> Value;
+	if (Object.IsValid())
+	{
+		Value = MakeShared<FJsonValueObject>(Object);
+	}
+	return Validate(Value, OutError);
+}
+
+bool FAgentForgeCompiledSchema::ValidateNode(int32 NodeIndex, const TSharedPtr<FJsonValue>& Value, const FString* Path, FString* OutError) const
+{
+	if (!Nodes.IsValidIndex(NodeIndex))
+	{
+		return true;
+	}
+	const FNode& Node = Nodes[NodeIndex];
+
+	auto Fail = [Path, OutError](const FString& Message)
+	{
+		if (Path && OutError)
+		{
+			*OutError = *Path + Message;
+		}
+		return false;
+	};
+
+	if (Node.bHasEnum)
+	{
+		const bool bEnumMatched = Value.IsValid() && Value->Type == EJson::String
+			? Node.EnumStrings.Contains(Value->AsString())
+			: Node.EnumOthers.ContainsByPredicate([&Value](const TSharedPtr<FJsonValue>& Allowed) { return JsonValueEquals(Value, Allowed); });
+		if (!bEnumMatched)
+		{
+			return Fail(TEXT(" is not one of the allowed enum values."));
+		}
+	}
+
+	switch (Node.Type)
+	{
+	case EType::Object:
+	{
+		const TSharedPtr<FJsonObject>* ObjectValue = nullptr;
+		if (!Value.IsValid() || !Value->TryGetObject(ObjectValue) || !ObjectValue || !(*ObjectValue).IsValid())
+		{
+			return Fail(TEXT(" must be an object."));
+		}
+		const TMap<FString, TSharedPtr<FJsonValue>>& Fields = (*ObjectValue)->Values;
+
+		for (const FString& FieldName : Node.Required)
+		{
+			if (!Fields.Contains(FieldName))
+			{
+				return Fail(FString::Printf(TEXT(" is missing required field '%s'."), *FieldName));
+			}
+		}
+
+		for (const TPair<FString, int32>& Property : Node.Properties)
+		{
+			const TSharedPtr<FJsonValue>* FieldValue = Fields.Find(Property.Key);
+			if (!FieldValue || Property.Value == INDEX_NONE)
+			{
+				continue;
+			}
+			const FString ChildPath = Path ? *Path + TEXT(".") + Property.Key : FString();
+			if (!ValidateNode(Property.Value, *FieldValue, Path ? &ChildPath : nullptr, OutError))
+			{
+				return false;
+			}
+		}
+
+		if (Node.bClosed)
+		{
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : Fields)
+			{
+				if (!Node.Properties.Contains(Pair.Key))
+				{
+					return Fail(FString::Printf(TEXT(" contains unexpected field '%s'."), *Pair.Key));
+				}
+			}
+		}
+		return true;
+	}
+
+	case EType::Array:
+	{
+		const TArray<TSharedPtr<FJsonValue>>* ArrayValue = nullptr;
+		if (!Value.IsValid() || !Value->TryGetArray(ArrayValue) || !ArrayValue)
+		{
+			return Fail(TEXT(" must be an array."));
+		}
+		if (Node.Items != INDEX_NONE)
+		{
+			for (int32 Index = 0; Index < ArrayValue->Num(); ++Index)
+			{
+				const FString ChildPath = Path ? FString::Printf(TEXT("%s[%d]"), **Path, Index) : FString();
+				if (!ValidateNode(Node.Items, (*ArrayValue)[Index], Path ? &ChildPath : nullptr, OutError))
+				{
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	case EType::String:
+		return Value.IsValid() && Value->Type == EJson::String ? true : Fail(TEXT(" must be a string."));
+
+	case EType::Number:
+		return Value.IsValid() && Value->Type == EJson::Number ? true : Fail(TEXT(" must be a number."));
+
+	case EType::Integer:
+	{
+		const bool bInteger = Value.IsValid() && Value->Type == EJson::Number
+			&& FMath::IsNearlyEqual(Value->AsNumber(), FMath::RoundToDouble(Value->AsNumber()));
+		return bInteger ? true : Fail(TEXT(" must be an integer."));
+	}
+
+	case EType::Boolean:
+		return Value.IsValid() && Value->Type == EJson::Boolean ? true : Fail(TEXT(" must be a boolean."));
+
+	default:
+		return true;
+	}
+}
+
+FAgentForgeSchemaRegistry& FAgentForgeSchemaRegistry::Get()
+{
+	static FAgentForgeSchemaRegistry Instance;
+	return Instance;
+}
+
+FAgentForgeCompiledSchemaPtr FAgentForgeSchemaRegistry::Compile(const FString& SchemaString, FString* OutError)
+{
+	{
+		FScopeLock ScopeLock(&Lock);
+		if (const FAgentForgeCompiledSchemaPtr* Existing = Compiled.Find(SchemaString))
+		{
+			++Hits;
+			return *Existing;
+		}
+		++Misses;
+	}
+
+	// Compiled outside the lock; two threads racing on a new schema both build it and one copy is kept.
+	TSharedPtr<FJsonObject> Root;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(SchemaString);
+	if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid())
+	{
+		FScopeLock ScopeLock(&Lock);
+		++CompileErrors;
+		if (OutError)
+		{
+			*OutError = FString::Printf(TEXT("Schema is not a JSON object: %s"), *Reader->GetErrorMessage());
+		}
+		return nullptr;
+	}
+
+	TSharedRef<FAgentForgeCompiledSchema, ESPMode::ThreadSafe> Schema = MakeShared<FAgentForgeCompiledSchema, ESPMode::ThreadSafe>();
+	FAgentForgeSchemaCompiler Compiler { *Schema, Root };
+	Compiler.CompileNode(Root);
+
+	FScopeLock ScopeLock(&Lock);
+	// Schemas built at runtime (fan-out candidates, ad-hoc llm_structured calls) should not pile up.
+	if (Compiled.Num() >= DefaultCapacity)
+	{
+		Compiled.Empty();
+	}
+	return Compiled.Add(SchemaString, Schema);
+}
+
+FAgentForgeCompiledSchemaPtr FAgentForgeSchemaRegistry::FindByName(const FString& SchemaFileName, FString* OutError)
+{
+	FString Text;
+	if (!LoadSchemaText(SchemaFileName, Text))
+	{
+		if (OutError)
+		{
+			*OutError = FString::Printf(TEXT("Schema not found: %s"), *NormalizeSchemaFileName(SchemaFileName));
+		}
+		return nullptr;
+	}
+	return Compile(Text, OutError);
+}
+
+bool FAgentForgeSchemaRegistry::LoadSchemaText(const FString& SchemaFileName, FString& OutText)
+{
+	const FString FileName = NormalizeSchemaFileName(SchemaFileName);
+	{
+		FScopeLock ScopeLock(&Lock);
+		if (const FString* Existing = Files.Find(FileName))
+		{
+			OutText = *Existing;
+			return true;
+		}
+	}
+
+	// Missing files are not remembered, so a schema added later is picked up.
+	for (const FString& Candidate : GetSchemaSearchPaths(FileName))
+	{
+		if (FFileHelper::LoadFileToString(OutText, *Candidate))
+		{
+			FScopeLock ScopeLock(&Lock);
+			Files.Add(FileName, OutText);
+			return true;
+		}
+	}
+	return false;
+}
+
+void FAgentForgeSchemaRegistry::Clear()
+{
+	FScopeLock ScopeLock(&Lock);
+	Compiled.Empty();
+	Files.Empty();
+}
+
+TSharedPtr<FJsonObject> FAgentForgeSchemaRegistry::GetStatsJson() const
+{
+	FScopeLock ScopeLock(&Lock);
+	const int64 Lookups = Hits + Misses;
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetNumberField(TEXT("compiled"),       Compiled.Num());
+	Obj->SetNumberField(TEXT("capacity"),       DefaultCapacity);
+	Obj->SetNumberField(TEXT("files"),          Files.Num());
+	Obj->SetNumberField(TEXT("hits"),           (double)Hits);
+	Obj->SetNumberField(TEXT("misses"),         (double)Misses);
+	Obj->SetNumberField(TEXT("hit_rate"),       Lookups > 0 ? (double)Hits / (double)Lookups : 0.0);
+	Obj->SetNumberField(TEXT("compile_errors"), (double)CompileErrors);
+	return Obj;
+}
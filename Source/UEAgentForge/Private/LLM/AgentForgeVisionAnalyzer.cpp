@@ -1,17 +1,15 @@
 #include "LLM/AgentForgeVisionAnalyzer.h"
 #include "LLM/AgentForgeLLMSubsystem.h"
+#include "LLM/AgentForgeImageEncoder.h"
 #include "LLM/AgentForgeSchemaService.h"
+#include "LLM/AgentForgeVisionCache.h"
+#include "Visual/SceneCapture.h"
+#include "Async/ParallelFor.h"
 #include "Dom/JsonObject.h"
 #include "Dom/JsonValue.h"
 #include "Serialization/JsonSerializer.h"
 #include "Serialization/JsonWriter.h"
-#include "Misc/Base64.h"
-#include "Misc/DateTime.h"
-#include "Misc/FileHelper.h"
-#include "Misc/Paths.h"
 #include "HAL/FileManager.h"
-#include "HAL/PlatformProcess.h"
-#include "ImageUtils.h"
 #include "UnrealClient.h"
 #include "RenderingThread.h"
 
@@ -27,22 +25,6 @@
 
 namespace
 {
-	static FString BuildScreenshotPath(const FString& RequestedBaseName)
-	{
-		FString BaseName = RequestedBaseName;
-		BaseName.TrimStartAndEndInline();
-		if (BaseName.IsEmpty())
-		{
-			BaseName = TEXT("AgentForgeVision");
-		}
-		BaseName = BaseName.Replace(TEXT(" "), TEXT("_"));
-
-		const FString Dir = TEXT("C:/HGShots");
-		IFileManager::Get().MakeDirectory(*Dir, true);
-		const FString Timestamp = FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S_%s"));
-		return FPaths::Combine(Dir, FString::Printf(TEXT("%s_%s.png"), *BaseName, *Timestamp));
-	}
-
 #if WITH_EDITOR
 	static FLevelEditorViewportClient* GetFirstPerspectiveViewportClient()
 	{
@@ -87,12 +69,9 @@ namespace
 		return Bounds.IsValid ? Bounds.GetCenter() : FVector::ZeroVector;
 	}
 
-	static bool CaptureConfiguredViewportScreenshot(const FString& BaseName, FString& OutPath, FString& OutError)
+	static bool CaptureViewportPixels(FSceneCaptureImage& OutImage, FString& OutError)
 	{
 		OutError.Reset();
-		OutPath = BuildScreenshotPath(BaseName);
-		IFileManager::Get().Delete(*OutPath, false, true, true);
-
 		FLevelEditorViewportClient* ViewportClient = GetFirstPerspectiveViewportClient();
 		if (!ViewportClient || !ViewportClient->Viewport)
 		{
@@ -108,179 +87,286 @@ namespace
 		FlushRenderingCommands();
 
 		FViewport* Viewport = ViewportClient->Viewport;
-		const FIntPoint Size = Viewport->GetSizeXY();
-		if (Size.X <= 0 || Size.Y <= 0)
+		OutImage.Size = Viewport->GetSizeXY();
+		if (OutImage.Size.X <= 0 || OutImage.Size.Y <= 0)
 		{
 			OutError = TEXT("Viewport size is invalid for screenshot capture.");
 			return false;
 		}
 
-		TArray<FColor> Bitmap;
 		FReadSurfaceDataFlags ReadFlags(RCM_UNorm);
 		ReadFlags.SetLinearToGamma(true);
-		if (!Viewport->ReadPixels(Bitmap, ReadFlags))
+		if (!Viewport->ReadPixels(OutImage.Pixels, ReadFlags))
 		{
 			OutError = TEXT("Viewport pixel readback failed.");
 			return false;
 		}
+		return true;
+	}
 
-		for (FColor& Pixel : Bitmap)
-		{
-			Pixel.A = 255;
-		}
+	/** Resize and compress for the provider on worker threads; the result goes straight into the request body. */
+	static bool EncodeForProvider(
+		TArray<FSceneCaptureImage>& Images,
+		EAgentForgeLLMProvider Provider,
+		TArray<FAgentForgeEncodedImage>& OutImages,
+		FString& OutError)
+	{
+		return FAgentForgeImageEncoder::Get().EncodeAll(
+			Images, FAgentForgeImageEncodeSettings::ForProvider(Provider), OutImages, OutError);
+	}
 
-		TArray64<uint8> CompressedPng;
-		FImageUtils::PNGCompressImageArray(
-			Size.X,
-			Size.Y,
-			TArrayView64<const FColor>(Bitmap.GetData(), Bitmap.Num()),
-			CompressedPng);
-		if (CompressedPng.Num() == 0 || !FFileHelper::SaveArrayToFile(CompressedPng, *OutPath))
+	static FAgentForgeLLMFanOutResult MakeFailedResult(int32 NumCandidates, const FString& Error)
+	{
+		NumCandidates = FMath::Max(NumCandidates, 1);
+		FAgentForgeLLMFanOutResult Result;
+		Result.Responses.SetNum(NumCandidates);
+		Result.LatencyMs.Init(0.0, NumCandidates);
+		Result.Accepted.Init(false, NumCandidates);
+		Result.Cancelled.Init(false, NumCandidates);
+		for (FAgentForgeLLMResponse& Response : Result.Responses)
 		{
-			OutError = FString::Printf(TEXT("Failed to save screenshot: %s"), *OutPath);
-			return false;
+			Response.ErrorMessage = Error;
 		}
+		return Result;
+	}
 
-		return true;
+	static TArray<FAgentForgeLLMCandidate> SingleCandidate(EAgentForgeLLMProvider Provider, const FString& Model)
+	{
+		FAgentForgeLLMCandidate Candidate;
+		Candidate.Provider = Provider;
+		Candidate.Model = Model;
+		return { Candidate };
 	}
 
-	static bool LoadFileAsBase64(const FString& FilePath, FString& OutBase64, FString& OutError)
+	/** The winner, or the first candidate's response when none was accepted. */
+	static FAgentForgeLLMResponse GetFanOutResponse(const FAgentForgeLLMFanOutResult& Result)
 	{
-		TArray<uint8> Bytes;
-		if (!FFileHelper::LoadFileToArray(Bytes, *FilePath))
+		if (Result.HasWinner())
 		{
-			OutError = FString::Printf(TEXT("Failed to read screenshot: %s"), *FilePath);
-			return false;
+			return Result.Responses[Result.WinnerIndex];
 		}
-
-		OutBase64 = FBase64::Encode(Bytes);
-		return true;
+		return Result.Responses.Num() > 0 ? Result.Responses[0] : FAgentForgeLLMResponse();
 	}
 
-	static FAgentForgeLLMResponse ExecuteVisionRequest(
-		const TArray<FString>& ImagePaths,
+	/**
+	 * Sends one frame set to every candidate through the subsystem's fan-out. The frames are
+	 * fingerprinted once; each candidate checks the vision cache under its own request key and
+	 * is only sent on a miss. A cache hit wins a First race without any request going out.
+	 */
+	static FAgentForgeLLMFanOutResult ExecuteVisionRequest(
+		TArray<FSceneCaptureImage>& Images,
 		const FString& Prompt,
-		EAgentForgeLLMProvider Provider,
-		const FString& Model,
-		const FString& ResponseSchema)
+		const TArray<FAgentForgeLLMCandidate>& Candidates,
+		const FString& ResponseSchema,
+		bool bUseCache,
+		EAgentForgeLLMFanOutMode Mode = EAgentForgeLLMFanOutMode::First,
+		double HedgeDelaySeconds = 0.0)
 	{
-		FAgentForgeLLMResponse Response;
+		const int32 NumCandidates = Candidates.Num();
 		if (!GEditor)
 		{
-			Response.ErrorMessage = TEXT("GEditor null.");
-			return Response;
+			return MakeFailedResult(NumCandidates, TEXT("GEditor null."));
 		}
 
-		if (ImagePaths.Num() == 0)
+		if (Images.Num() == 0)
 		{
-			Response.ErrorMessage = TEXT("No screenshots were supplied for vision analysis.");
-			return Response;
+			return MakeFailedResult(NumCandidates, TEXT("No screenshots were supplied for vision analysis."));
 		}
 
-		if (Model.IsEmpty())
+		if (NumCandidates == 0 || Candidates.ContainsByPredicate([](const FAgentForgeLLMCandidate& Candidate) { return Candidate.Model.IsEmpty(); }))
 		{
-			Response.ErrorMessage = TEXT("Vision analysis requires a model.");
-			return Response;
+			return MakeFailedResult(NumCandidates, TEXT("Vision analysis requires a model."));
 		}
 
-		if (Provider != EAgentForgeLLMProvider::OpenAICompatible &&
-			UAgentForgeLLMSubsystem::GetApiKey(Provider).IsEmpty())
+		// Fingerprint before encoding consumes the pixels.
+		FAgentForgeVisionCache& Cache = FAgentForgeVisionCache::Get();
+		TArray<FAgentForgeFrameFingerprint> Fingerprints;
+		if (Cache.IsEnabled())
 		{
-			Response.ErrorMessage = TEXT("No API key configured for the selected provider.");
-			return Response;
+			Fingerprints.SetNum(Images.Num());
+			ParallelFor(Images.Num(), [&](int32 Index)
+			{
+				FSceneCapture::ComputeImageFeatures(Images[Index].Pixels, Images[Index].Size, Fingerprints[Index].Features);
+				Fingerprints[Index].Hash = FSceneCapture::ComputePerceptualHash(Fingerprints[Index].Features);
+			});
+		}
+
+		FAgentForgeLLMFanOutResult Result = MakeFailedResult(NumCandidates, FString());
+		TArray<FString> CacheKeys;
+		TArray<int32> Pending;   // candidates that go to their provider
+		for (int32 Index = 0; Index < NumCandidates; ++Index)
+		{
+			const FAgentForgeLLMCandidate& Candidate = Candidates[Index];
+			CacheKeys.Add(FAgentForgeVisionCache::MakeRequestKey(Candidate.Provider, Candidate.Model, Prompt, ResponseSchema));
+			if (bUseCache && Fingerprints.Num() > 0 && Cache.Find(CacheKeys[Index], Fingerprints, Result.Responses[Index]))
+			{
+				Result.Accepted[Index] = true;
+				if (!Result.HasWinner())
+				{
+					Result.WinnerIndex = Index;
+				}
+				continue;
+			}
+			if (Candidate.Provider != EAgentForgeLLMProvider::OpenAICompatible &&
+				UAgentForgeLLMSubsystem::GetApiKey(Candidate.Provider).IsEmpty())
+			{
+				Result.Responses[Index].ErrorMessage = TEXT("No API key configured for the selected provider.");
+				continue;
+			}
+			Pending.Add(Index);
+		}
+
+		if (Result.HasWinner() && Mode == EAgentForgeLLMFanOutMode::First)
+		{
+			for (const int32 Index : Pending)
+			{
+				Result.Cancelled[Index] = true;
+				Result.Responses[Index].ErrorMessage = FString::Printf(TEXT("Cancelled: candidate %d answered first."), Result.WinnerIndex);
+			}
+			return Result;
+		}
+		if (Pending.Num() == 0)
+		{
+			return Result;
 		}
 
-		TArray<FString> EncodedImages;
-		EncodedImages.Reserve(ImagePaths.Num());
-		for (const FString& ImagePath : ImagePaths)
+		// Encoding consumes the pixels, so every provider but the last encodes a copy.
+		TArray<EAgentForgeLLMProvider> Providers;
+		for (const int32 Index : Pending)
 		{
-			FString EncodedImage;
-			FString ReadError;
-			if (!LoadFileAsBase64(ImagePath, EncodedImage, ReadError))
+			Providers.AddUnique(Candidates[Index].Provider);
+		}
+		TMap<EAgentForgeLLMProvider, TArray<FAgentForgeEncodedImage>> EncodedByProvider;
+		for (int32 ProviderIndex = 0; ProviderIndex < Providers.Num(); ++ProviderIndex)
+		{
+			TArray<FSceneCaptureImage> Copy;
+			if (ProviderIndex + 1 < Providers.Num())
 			{
-				Response.ErrorMessage = ReadError;
-				return Response;
+				Copy = Images;
+			}
+			TArray<FAgentForgeEncodedImage> EncodedImages;
+			FString EncodeError;
+			if (EncodeForProvider(ProviderIndex + 1 < Providers.Num() ? Copy : Images, Providers[ProviderIndex], EncodedImages, EncodeError))
+			{
+				EncodedByProvider.Add(Providers[ProviderIndex], MoveTemp(EncodedImages));
+				continue;
 			}
-			EncodedImages.Add(MoveTemp(EncodedImage));
+			Pending.RemoveAll([&](int32 Index)
+			{
+				if (Candidates[Index].Provider != Providers[ProviderIndex])
+				{
+					return false;
+				}
+				Result.Responses[Index].ErrorMessage = EncodeError;
+				return true;
+			});
 		}
 
 		UAgentForgeLLMSubsystem* LLM = GEditor->GetEditorSubsystem<UAgentForgeLLMSubsystem>();
 		if (!LLM)
 		{
-			Response.ErrorMessage = TEXT("LLM subsystem unavailable.");
-			return Response;
+			for (const int32 Index : Pending)
+			{
+				Result.Responses[Index].ErrorMessage = TEXT("LLM subsystem unavailable.");
+			}
+			return Result;
+		}
+		if (Pending.Num() == 0)
+		{
+			return Result;
 		}
 
-		FAgentForgeChatMessage Message;
-		Message.Role = TEXT("user");
-		Message.Content = Prompt;
-		Message.ImageData = EncodedImages;
-		for (int32 Index = 0; Index < EncodedImages.Num(); ++Index)
+		TArray<FAgentForgeLLMSettings> Requests;
+		for (const int32 Index : Pending)
 		{
-			Message.ImageMediaTypes.Add(TEXT("image/png"));
+			const FAgentForgeLLMCandidate& Candidate = Candidates[Index];
+			FAgentForgeChatMessage Message;
+			Message.Role = TEXT("user");
+			Message.Content = Prompt;
+			for (const FAgentForgeEncodedImage& Image : EncodedByProvider.FindChecked(Candidate.Provider))
+			{
+				Message.ImageData.Add(Image.Base64);
+				Message.ImageMediaTypes.Add(Image.MediaType);
+			}
+
+			FAgentForgeLLMSettings& Settings = Requests.AddDefaulted_GetRef();
+			Settings.Provider = Candidate.Provider;
+			Settings.Model = Candidate.Model;
+			Settings.CustomEndpoint = Candidate.CustomEndpoint;
+			Settings.MaxTokens = 1024;
+			Settings.Temperature = 0.2f;
+			Settings.Messages.Add(MoveTemp(Message));
+			Settings.ResponseSchema = ResponseSchema;
+			// Quality scoring (the only schema-bound vision call) feeds the refinement loops; it yields to interactive requests.
+			Settings.Priority = ResponseSchema.IsEmpty() ? EAgentForgeLLMPriority::Interactive : EAgentForgeLLMPriority::Background;
 		}
 
-		FAgentForgeLLMSettings Settings;
-		Settings.Provider = Provider;
-		Settings.Model = Model;
-		Settings.MaxTokens = 1024;
-		Settings.Temperature = 0.2f;
-		Settings.Messages.Add(MoveTemp(Message));
-		Settings.ResponseSchema = ResponseSchema;
-
-		Response = LLM->SendChatRequestBlocking(Settings);
-		if (Response.bSuccess && !ResponseSchema.IsEmpty() &&
-			!UAgentForgeSchemaService::ValidateJsonAgainstSchema(Response.Content, ResponseSchema))
+		// The default acceptor validates against Settings.ResponseSchema.
+		const FAgentForgeLLMFanOutResult Sent = LLM->SendFanOutRequestBlocking(Requests, Mode, HedgeDelaySeconds);
+		for (int32 SentIndex = 0; SentIndex < Pending.Num() && SentIndex < Sent.Responses.Num(); ++SentIndex)
 		{
-			Response.bSuccess = false;
-			Response.ErrorMessage = TEXT("Vision response did not satisfy the expected schema.");
+			const int32 Index = Pending[SentIndex];
+			FAgentForgeLLMResponse& Response = Result.Responses[Index];
+			Response = Sent.Responses[SentIndex];
+			Result.LatencyMs[Index] = Sent.LatencyMs[SentIndex];
+			Result.Accepted[Index] = Sent.Accepted[SentIndex];
+			Result.Cancelled[Index] = Sent.Cancelled[SentIndex];
+			if (Response.bSuccess && !Result.Accepted[Index])
+			{
+				Response.bSuccess = false;
+				Response.ErrorMessage = TEXT("Vision response did not satisfy the expected schema.");
+			}
+			if (Result.Accepted[Index] && Fingerprints.Num() > 0)
+			{
+				Cache.Store(CacheKeys[Index], Fingerprints, Response);
+			}
+		}
+		if (!Result.HasWinner() && Sent.HasWinner())
+		{
+			Result.WinnerIndex = Pending[Sent.WinnerIndex];
 		}
 
-		return Response;
+		return Result;
 	}
 
-	static FAgentForgeLLMResponse CaptureAndAnalyzeCurrentViewport(
+	static FAgentForgeLLMFanOutResult CaptureAndAnalyzeCurrentViewport(
 		const FString& Prompt,
-		EAgentForgeLLMProvider Provider,
-		const FString& Model,
-		const FString& ResponseSchema)
+		const TArray<FAgentForgeLLMCandidate>& Candidates,
+		const FString& ResponseSchema,
+		bool bUseCache,
+		EAgentForgeLLMFanOutMode Mode = EAgentForgeLLMFanOutMode::First,
+		double HedgeDelaySeconds = 0.0)
 	{
-		FString ScreenshotPath;
+		TArray<FSceneCaptureImage> Images;
 		FString CaptureError;
-		if (!CaptureConfiguredViewportScreenshot(TEXT("vision_viewport"), ScreenshotPath, CaptureError))
+		if (!CaptureViewportPixels(Images.AddDefaulted_GetRef(), CaptureError))
 		{
-			FAgentForgeLLMResponse Response;
-			Response.ErrorMessage = CaptureError;
-			return Response;
+			return MakeFailedResult(Candidates.Num(), CaptureError);
 		}
 
-		return ExecuteVisionRequest({ ScreenshotPath }, Prompt, Provider, Model, ResponseSchema);
+		return ExecuteVisionRequest(Images, Prompt, Candidates, ResponseSchema, bUseCache, Mode, HedgeDelaySeconds);
 	}
 
-	static FAgentForgeLLMResponse CaptureAndAnalyzeMultiView(
+	static FAgentForgeLLMFanOutResult CaptureAndAnalyzeMultiView(
 		const FString& Prompt,
-		EAgentForgeLLMProvider Provider,
-		const FString& Model,
-		const FString& ResponseSchema)
+		const TArray<FAgentForgeLLMCandidate>& Candidates,
+		const FString& ResponseSchema,
+		bool bUseCache,
+		EAgentForgeLLMFanOutMode Mode = EAgentForgeLLMFanOutMode::First,
+		double HedgeDelaySeconds = 0.0)
 	{
-		FAgentForgeLLMResponse Response;
-
 		FLevelEditorViewportClient* ViewportClient = GetFirstPerspectiveViewportClient();
 		if (!ViewportClient)
 		{
-			Response.ErrorMessage = TEXT("No perspective viewport is available for multi-view capture.");
-			return Response;
+			return MakeFailedResult(Candidates.Num(), TEXT("No perspective viewport is available for multi-view capture."));
 		}
 
 		UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
 		if (!World)
 		{
-			Response.ErrorMessage = TEXT("No editor world.");
-			return Response;
+			return MakeFailedResult(Candidates.Num(), TEXT("No editor world."));
 		}
 
-		const FVector OriginalLocation = ViewportClient->GetViewLocation();
-		const FRotator OriginalRotation = ViewportClient->GetViewRotation();
 		const FVector Center = ComputeLevelCenter(World);
 		const float Radius = 2600.0f;
 
@@ -298,34 +384,34 @@ namespace
 			{ TEXT("tension"), FVector(-Radius * 0.55f, Radius * 0.2f, Radius * 0.12f), FRotator(-6.0f, -18.0f, 0.0f) },
 		};
 
-		TArray<FString> ImagePaths;
-		ImagePaths.Reserve(Presets.Num());
-
+		// All four views render off-screen in one batch; the editor viewport stays where it is.
+		TArray<FTransform> Cameras;
+		Cameras.Reserve(Presets.Num());
 		for (const FViewPreset& Preset : Presets)
 		{
-			ViewportClient->SetViewLocation(Center + Preset.Offset);
-			ViewportClient->SetViewRotation(Preset.Rotation);
-			ViewportClient->Invalidate();
+			Cameras.Add(FTransform(Preset.Rotation, Center + Preset.Offset));
+		}
 
-			FString ScreenshotPath;
-			FString CaptureError;
-			if (!CaptureConfiguredViewportScreenshot(TEXT("vision_") + Preset.Name, ScreenshotPath, CaptureError))
+		FSceneCaptureSettings CaptureSettings;
+		CaptureSettings.FOVDegrees = ViewportClient->ViewFOV;
+		if (ViewportClient->Viewport)
+		{
+			const FIntPoint ViewportSize = ViewportClient->Viewport->GetSizeXY();
+			if (ViewportSize.X > 0 && ViewportSize.Y > 0)
 			{
-				ViewportClient->SetViewLocation(OriginalLocation);
-				ViewportClient->SetViewRotation(OriginalRotation);
-				ViewportClient->Invalidate();
-				Response.ErrorMessage = CaptureError;
-				return Response;
+				CaptureSettings.Width = ViewportSize.X;
+				CaptureSettings.Height = ViewportSize.Y;
 			}
-
-			ImagePaths.Add(ScreenshotPath);
 		}
 
-		ViewportClient->SetViewLocation(OriginalLocation);
-		ViewportClient->SetViewRotation(OriginalRotation);
-		ViewportClient->Invalidate();
+		TArray<FSceneCaptureImage> Images;
+		FString CaptureError;
+		if (!FSceneCapture::CaptureScenePixels(World, Cameras, CaptureSettings, Images, CaptureError))
+		{
+			return MakeFailedResult(Candidates.Num(), CaptureError);
+		}
 
-		return ExecuteVisionRequest(ImagePaths, Prompt, Provider, Model, ResponseSchema);
+		return ExecuteVisionRequest(Images, Prompt, Candidates, ResponseSchema, bUseCache, Mode, HedgeDelaySeconds);
 	}
 
 	static const FString& GetVisionQualitySchema()
@@ -393,7 +479,8 @@ void UAgentForgeVisionAnalyzer::AnalyzeMultiView(
 FAgentForgeLLMResponse UAgentForgeVisionAnalyzer::AnalyzeViewportBlocking(
 	const FString& AnalysisPrompt,
 	EAgentForgeLLMProvider Provider,
-	const FString& Model)
+	const FString& Model,
+	bool bUseCaptureCache)
 {
 	FAgentForgeLLMResponse Response;
 
@@ -401,7 +488,7 @@ FAgentForgeLLMResponse UAgentForgeVisionAnalyzer::AnalyzeViewportBlocking(
 	const FString Prompt = AnalysisPrompt.IsEmpty()
 		? TEXT("Analyze this Unreal Engine level screenshot and describe composition, lighting, atmosphere, set dressing quality, and obvious visual issues.")
 		: AnalysisPrompt;
-	Response = CaptureAndAnalyzeCurrentViewport(Prompt, Provider, Model, FString());
+	Response = GetFanOutResponse(CaptureAndAnalyzeCurrentViewport(Prompt, SingleCandidate(Provider, Model), FString(), bUseCaptureCache));
 #else
 	Response.ErrorMessage = TEXT("Editor only.");
 #endif
@@ -413,7 +500,8 @@ FAgentForgeLLMResponse UAgentForgeVisionAnalyzer::AnalyzeScreenshotBlocking(
 	const FString& ScreenshotPath,
 	const FString& AnalysisPrompt,
 	EAgentForgeLLMProvider Provider,
-	const FString& Model)
+	const FString& Model,
+	bool bUseCaptureCache)
 {
 	FAgentForgeLLMResponse Response;
 
@@ -427,7 +515,13 @@ FAgentForgeLLMResponse UAgentForgeVisionAnalyzer::AnalyzeScreenshotBlocking(
 	const FString Prompt = AnalysisPrompt.IsEmpty()
 		? TEXT("Analyze this Unreal Engine level screenshot and describe composition, lighting, atmosphere, set dressing quality, and obvious visual issues.")
 		: AnalysisPrompt;
-	Response = ExecuteVisionRequest({ ScreenshotPath }, Prompt, Provider, Model, FString());
+	TArray<FSceneCaptureImage> Images;
+	FSceneCaptureImage& Image = Images.AddDefaulted_GetRef();
+	if (!FAgentForgeImageEncoder::DecodeFile(ScreenshotPath, Image.Pixels, Image.Size, Response.ErrorMessage))
+	{
+		return Response;
+	}
+	Response = GetFanOutResponse(ExecuteVisionRequest(Images, Prompt, SingleCandidate(Provider, Model), FString(), bUseCaptureCache));
 #else
 	Response.ErrorMessage = TEXT("Editor only.");
 #endif
@@ -438,7 +532,8 @@ FAgentForgeLLMResponse UAgentForgeVisionAnalyzer::AnalyzeScreenshotBlocking(
 FAgentForgeLLMResponse UAgentForgeVisionAnalyzer::AnalyzeMultiViewBlocking(
 	const FString& AnalysisPrompt,
 	EAgentForgeLLMProvider Provider,
-	const FString& Model)
+	const FString& Model,
+	bool bUseCaptureCache)
 {
 	FAgentForgeLLMResponse Response;
 
@@ -446,7 +541,7 @@ FAgentForgeLLMResponse UAgentForgeVisionAnalyzer::AnalyzeMultiViewBlocking(
 	const FString Prompt = AnalysisPrompt.IsEmpty()
 		? TEXT("Analyze these four Unreal Engine level screenshots from different angles and describe composition, lighting, atmosphere, spatial readability, and obvious visual issues.")
 		: AnalysisPrompt;
-	Response = CaptureAndAnalyzeMultiView(Prompt, Provider, Model, FString());
+	Response = GetFanOutResponse(CaptureAndAnalyzeMultiView(Prompt, SingleCandidate(Provider, Model), FString(), bUseCaptureCache));
 #else
 	Response.ErrorMessage = TEXT("Editor only.");
 #endif
@@ -457,17 +552,35 @@ FAgentForgeLLMResponse UAgentForgeVisionAnalyzer::AnalyzeMultiViewBlocking(
 FAgentForgeLLMResponse UAgentForgeVisionAnalyzer::RequestQualityScoreBlocking(
 	EAgentForgeLLMProvider Provider,
 	const FString& Model,
-	bool bMultiView)
+	bool bMultiView,
+	bool bUseCaptureCache)
 {
-	FAgentForgeLLMResponse Response;
-
 #if WITH_EDITOR
-	Response = bMultiView
-		? CaptureAndAnalyzeMultiView(GetVisionQualityPrompt(), Provider, Model, GetVisionQualitySchema())
-		: CaptureAndAnalyzeCurrentViewport(GetVisionQualityPrompt(), Provider, Model, GetVisionQualitySchema());
+	return GetFanOutResponse(RequestQualityScoreFanOutBlocking(SingleCandidate(Provider, Model), EAgentForgeLLMFanOutMode::First, 0.0, bMultiView, bUseCaptureCache));
 #else
+	FAgentForgeLLMResponse Response;
 	Response.ErrorMessage = TEXT("Editor only.");
+	return Response;
 #endif
+}
 
-	return Response;
+FAgentForgeLLMFanOutResult UAgentForgeVisionAnalyzer::RequestQualityScoreFanOutBlocking(
+	const TArray<FAgentForgeLLMCandidate>& Candidates,
+	EAgentForgeLLMFanOutMode Mode,
+	double HedgeDelaySeconds,
+	bool bMultiView,
+	bool bUseCaptureCache)
+{
+#if WITH_EDITOR
+	return bMultiView
+		? CaptureAndAnalyzeMultiView(GetVisionQualityPrompt(), Candidates, GetVisionQualitySchema(), bUseCaptureCache, Mode, HedgeDelaySeconds)
+		: CaptureAndAnalyzeCurrentViewport(GetVisionQualityPrompt(), Candidates, GetVisionQualitySchema(), bUseCaptureCache, Mode, HedgeDelaySeconds);
+#else
+	FAgentForgeLLMFanOutResult Result;
+	Result.Responses.AddDefaulted_GetRef().ErrorMessage = TEXT("Editor only.");
+	Result.LatencyMs.Add(0.0);
+	Result.Accepted.Add(false);
+	Result.Cancelled.Add(false);
+	return Result;
+#endif
 }
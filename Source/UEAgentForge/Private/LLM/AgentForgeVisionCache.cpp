@@ -0,0 +1,161 @@
+#include "LLM/AgentForgeVisionCache.h"
+#include "Visual/SceneCapture.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+
+FAgentForgeVisionCache& FAgentForgeVisionCache::Get()
+{
+	static FAgentForgeVisionCache Instance;
+	return Instance;
+}
+
+FString FAgentForgeVisionCache::MakeRequestKey(
+	EAgentForgeLLMProvider Provider,
+	const FString& Model,
+	const FString& Prompt,
+	const FString& ResponseSchema)
+{
+	// Kept verbatim: prompts and schemas are short, and exact text cannot collide.
+	return FString::Printf(TEXT("%d\n%s\n%s\n%s"), (int32)Provider, *Model, *Prompt, *ResponseSchema);
+}
+
+bool FAgentForgeVisionCache::Find(
+	const FString& RequestKey,
+	const TArray<FAgentForgeFrameFingerprint>& Frames,
+	FAgentForgeLLMResponse& OutResponse)
+{
+	FScopeLock ScopeLock(&Lock);
+	if (!bEnabled || Frames.Num() == 0)
+	{
+		return false;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	Entries.RemoveAll([Now, this](const FEntry& Entry) { return Now - Entry.StoredAt > MaxAgeSeconds; });
+
+	// Newest first: in a quality loop the previous iteration is the likeliest match.
+	for (int32 Index = Entries.Num() - 1; Index >= 0; --Index)
+	{
+		const FEntry& Entry = Entries[Index];
+		if (Entry.RequestKey != RequestKey || Entry.Frames.Num() != Frames.Num())
+		{
+			continue;
+		}
+
+		float Worst = 1.0f;
+		for (int32 Frame = 0; Frame < Frames.Num() && Worst >= MinSimilarity; ++Frame)
+		{
+			// The hash rejects clearly different frames before the full correlation.
+			if ((int32)FMath::CountBits(Entry.Frames[Frame].Hash ^ Frames[Frame].Hash) > MaxHashDistance)
+			{
+				Worst = 0.0f;
+				break;
+			}
+			Worst = FMath::Min(Worst, FSceneCapture::ComputeImageSimilarity(Entry.Frames[Frame].Features, Frames[Frame].Features));
+		}
+		if (Worst >= MinSimilarity)
+		{
+			++Hits;
+			LastSimilarity = Worst;
+			OutResponse = Entry.Response;
+			OutResponse.bFromCache = true;
+			return true;
+		}
+	}
+
+	++Misses;
+	return false;
+}
+
+void FAgentForgeVisionCache::Store(
+	const FString& RequestKey,
+	TArray<FAgentForgeFrameFingerprint> Frames,
+	const FAgentForgeLLMResponse& Response)
+{
+	FScopeLock ScopeLock(&Lock);
+	if (!bEnabled || !Response.bSuccess || Frames.Num() == 0)
+	{
+		return;
+	}
+
+	FEntry& Entry = Entries.AddDefaulted_GetRef();
+	Entry.RequestKey = RequestKey;
+	Entry.Frames = MoveTemp(Frames);
+	Entry.Response = Response;
+	Entry.StoredAt = FPlatformTime::Seconds();
+	++Stores;
+	if (Entries.Num() > Capacity)
+	{
+		Entries.RemoveAt(0, Entries.Num() - Capacity);
+	}
+}
+
+void FAgentForgeVisionCache::Clear()
+{
+	FScopeLock ScopeLock(&Lock);
+	Entries.Reset();
+}
+
+void FAgentForgeVisionCache::ApplyPolicy(const TSharedPtr<FJsonObject>& Args)
+{
+	if (!Args.IsValid())
+	{
+		return;
+	}
+	FScopeLock ScopeLock(&Lock);
+	double Number = 0.0;
+	bool bFlag = false;
+	if (Args->TryGetBoolField(TEXT("enabled"), bFlag))
+	{
+		bEnabled = bFlag;
+		if (!bEnabled)
+		{
+			Entries.Reset();
+		}
+	}
+	if (Args->TryGetNumberField(TEXT("min_similarity"), Number))
+	{
+		MinSimilarity = FMath::Clamp((float)Number, 0.0f, 1.0f);
+	}
+	if (Args->TryGetNumberField(TEXT("max_hash_distance"), Number))
+	{
+		MaxHashDistance = FMath::Clamp((int32)Number, 0, 64);
+	}
+	if (Args->TryGetNumberField(TEXT("max_age_seconds"), Number))
+	{
+		MaxAgeSeconds = FMath::Max(0.0, Number);
+	}
+	if (Args->TryGetNumberField(TEXT("capacity"), Number))
+	{
+		Capacity = FMath::Clamp((int32)Number, 1, 1024);
+		if (Entries.Num() > Capacity)
+		{
+			Entries.RemoveAt(0, Entries.Num() - Capacity);
+		}
+	}
+}
+
+bool FAgentForgeVisionCache::IsEnabled() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return bEnabled;
+}
+
+TSharedPtr<FJsonObject> FAgentForgeVisionCache::GetStatsJson() const
+{
+	FScopeLock ScopeLock(&Lock);
+	const int64 Lookups = Hits + Misses;
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetBoolField  (TEXT("enabled"),           bEnabled);
+	Obj->SetNumberField(TEXT("entries"),           Entries.Num());
+	Obj->SetNumberField(TEXT("capacity"),          Capacity);
+	Obj->SetNumberField(TEXT("hits"),              (double)Hits);
+	Obj->SetNumberField(TEXT("misses"),            (double)Misses);
+	Obj->SetNumberField(TEXT("hit_rate"),          Lookups > 0 ? (double)Hits / (double)Lookups : 0.0);
+	Obj->SetNumberField(TEXT("stores"),            (double)Stores);
+	Obj->SetNumberField(TEXT("min_similarity"),    MinSimilarity);
+	Obj->SetNumberField(TEXT("max_hash_distance"), MaxHashDistance);
+	Obj->SetNumberField(TEXT("max_age_seconds"),   MaxAgeSeconds);
+	Obj->SetNumberField(TEXT("last_hit_similarity"), LastSimilarity);
+	return Obj;
+}
@@ -1,4 +1,5 @@
 #include "LLM/Providers/AnthropicProvider.h"
+#include "AgentForgeTrace.h"
 #include "Dom/JsonObject.h"
 #include "Dom/JsonValue.h"
 #include "Serialization/JsonSerializer.h"
@@ -28,6 +29,26 @@ namespace
 			? StructuredSuffix.TrimStartAndEnd()
 			: Settings.SystemPrompt + StructuredSuffix;
 	}
+
+	// The API honours at most four cache_control blocks per request.
+	static constexpr int32 MaxCacheBreakpoints = 4;
+
+	static void MarkCacheBreakpoint(const TSharedPtr<FJsonObject>& Block)
+	{
+		TSharedPtr<FJsonObject> CacheControl = MakeShared<FJsonObject>();
+		CacheControl->SetStringField(TEXT("type"), TEXT("ephemeral"));
+		Block->SetObjectField(TEXT("cache_control"), CacheControl);
+	}
+
+	/** input_tokens excludes cache reads and writes; PromptTokens reports the sum, as the OpenAI API does. */
+	static void ReadAnthropicUsage(const TSharedPtr<FJsonObject>& UsageObj, int32& OutPrompt, int32& OutCached, int32& OutWrite)
+	{
+		int32 Input = 0;
+		UsageObj->TryGetNumberField(TEXT("input_tokens"), Input);
+		UsageObj->TryGetNumberField(TEXT("cache_read_input_tokens"), OutCached);
+		UsageObj->TryGetNumberField(TEXT("cache_creation_input_tokens"), OutWrite);
+		OutPrompt = Input + OutCached + OutWrite;
+	}
 }
 
 bool FAnthropicProvider::PrepareRequest(
@@ -36,6 +57,7 @@ bool FAnthropicProvider::PrepareRequest(
 	const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& Request,
 	FString& OutError) const
 {
+	AGENTFORGE_TRACE_SCOPE("AgentForge.LLM.Anthropic.PrepareRequest");
 	OutError.Reset();
 	if (Settings.Model.IsEmpty())
 	{
@@ -53,20 +75,49 @@ bool FAnthropicProvider::PrepareRequest(
 	Root->SetStringField(TEXT("model"), Settings.Model);
 	Root->SetNumberField(TEXT("max_tokens"), Settings.MaxTokens);
 	Root->SetNumberField(TEXT("temperature"), Settings.Temperature);
+	if (Settings.bStreamResponse)
+	{
+		Root->SetBoolField(TEXT("stream"), true);
+		Request->SetHeader(TEXT("Accept"), TEXT("text/event-stream"));
+	}
 
+	int32 BreakpointsLeft = Settings.bCachePrompt ? MaxCacheBreakpoints : 0;
 	const FString SystemPrompt = BuildAnthropicSystemPrompt(Settings);
-	if (!SystemPrompt.IsEmpty())
+	if (!SystemPrompt.IsEmpty() && BreakpointsLeft > 0)
+	{
+		TSharedPtr<FJsonObject> SystemBlock = MakeShared<FJsonObject>();
+		SystemBlock->SetStringField(TEXT("type"), TEXT("text"));
+		SystemBlock->SetStringField(TEXT("text"), SystemPrompt);
+		MarkCacheBreakpoint(SystemBlock);
+		TArray<TSharedPtr<FJsonValue>> SystemBlocks;
+		SystemBlocks.Add(MakeShared<FJsonValueObject>(SystemBlock));
+		Root->SetArrayField(TEXT("system"), SystemBlocks);
+		--BreakpointsLeft;
+	}
+	else if (!SystemPrompt.IsEmpty())
 	{
 		Root->SetStringField(TEXT("system"), SystemPrompt);
 	}
 
+	// Keep the latest flagged messages when there are more than the API allows.
+	TSet<int32> Breakpoints;
+	for (int32 Index = Settings.Messages.Num() - 1; Index >= 0 && Breakpoints.Num() < BreakpointsLeft; --Index)
+	{
+		const FAgentForgeChatMessage& Message = Settings.Messages[Index];
+		if (Message.bCacheBreakpoint && (!Message.Content.IsEmpty() || Message.ImageData.Num() > 0))
+		{
+			Breakpoints.Add(Index);
+		}
+	}
+
 	TArray<TSharedPtr<FJsonValue>> Messages;
-	for (const FAgentForgeChatMessage& Message : Settings.Messages)
+	for (int32 MessageIndex = 0; MessageIndex < Settings.Messages.Num(); ++MessageIndex)
 	{
+		const FAgentForgeChatMessage& Message = Settings.Messages[MessageIndex];
 		TSharedPtr<FJsonObject> MessageObj = MakeShared<FJsonObject>();
 		MessageObj->SetStringField(TEXT("role"), Message.Role.IsEmpty() ? TEXT("user") : Message.Role);
 
-		if (Message.ImageData.Num() == 0)
+		if (Message.ImageData.Num() == 0 && !Breakpoints.Contains(MessageIndex))
 		{
 			MessageObj->SetStringField(TEXT("content"), Message.Content);
 		}
@@ -99,6 +150,10 @@ bool FAnthropicProvider::PrepareRequest(
 				ContentArray.Add(MakeShared<FJsonValueObject>(TextObj));
 			}
 
+			if (Breakpoints.Contains(MessageIndex))
+			{
+				MarkCacheBreakpoint(ContentArray.Last()->AsObject());
+			}
 			MessageObj->SetArrayField(TEXT("content"), ContentArray);
 		}
 
@@ -114,6 +169,7 @@ FAgentForgeLLMResponse FAnthropicProvider::ParseResponse(
 	const FHttpResponsePtr& HttpResponse,
 	bool bSucceeded) const
 {
+	AGENTFORGE_TRACE_SCOPE("AgentForge.LLM.Anthropic.ParseResponse");
 	FAgentForgeLLMResponse Response;
 	Response.bSuccess = false;
 
@@ -162,10 +218,7 @@ FAgentForgeLLMResponse FAnthropicProvider::ParseResponse(
 	const TSharedPtr<FJsonObject>* UsageObj = nullptr;
 	if (Root->TryGetObjectField(TEXT("usage"), UsageObj) && UsageObj && (*UsageObj).IsValid())
 	{
-		if ((*UsageObj)->HasTypedField<EJson::Number>(TEXT("input_tokens")))
-		{
-			Response.PromptTokens = (int32)(*UsageObj)->GetNumberField(TEXT("input_tokens"));
-		}
+		ReadAnthropicUsage(*UsageObj, Response.PromptTokens, Response.CachedPromptTokens, Response.CacheWriteTokens);
 		if ((*UsageObj)->HasTypedField<EJson::Number>(TEXT("output_tokens")))
 		{
 			Response.CompletionTokens = (int32)(*UsageObj)->GetNumberField(TEXT("output_tokens"));
@@ -180,6 +233,89 @@ FAgentForgeLLMResponse FAnthropicProvider::ParseResponse(
 	return Response;
 }
 
+void FAnthropicProvider::ParseStreamEvent(
+	const FString& EventName,
+	const FString& Data,
+	FAgentForgeLLMStreamState& State,
+	FString& OutDelta) const
+{
+	AGENTFORGE_TRACE_SCOPE("AgentForge.LLM.Anthropic.ParseStreamEvent");
+	OutDelta.Reset();
+	TSharedPtr<FJsonObject> Root;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Data);
+	if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid())
+	{
+		return;
+	}
+
+	FString Type = EventName;
+	Root->TryGetStringField(TEXT("type"), Type);
+
+	if (Type == TEXT("content_block_delta"))
+	{
+		const TSharedPtr<FJsonObject>* DeltaObj = nullptr;
+		if (Root->TryGetObjectField(TEXT("delta"), DeltaObj) && DeltaObj && (*DeltaObj).IsValid())
+		{
+			FString DeltaType;
+			(*DeltaObj)->TryGetStringField(TEXT("type"), DeltaType);
+			FString Text;
+			if (DeltaType == TEXT("text_delta") && (*DeltaObj)->TryGetStringField(TEXT("text"), Text))
+			{
+				State.Content += Text;
+				OutDelta = MoveTemp(Text);
+			}
+			else if (DeltaType == TEXT("thinking_delta") && (*DeltaObj)->TryGetStringField(TEXT("thinking"), Text))
+			{
+				State.ReasoningContent += Text;
+			}
+		}
+	}
+	else if (Type == TEXT("content_block_start"))
+	{
+		// A new text block after an earlier one; the non-streamed parser joins blocks with a newline.
+		int32 Index = 0;
+		if (Root->TryGetNumberField(TEXT("index"), Index) && Index > 0 && !State.Content.IsEmpty())
+		{
+			State.Content += TEXT("\n");
+			OutDelta = TEXT("\n");
+		}
+	}
+	else if (Type == TEXT("message_start"))
+	{
+		const TSharedPtr<FJsonObject>* MessageObj = nullptr;
+		const TSharedPtr<FJsonObject>* UsageObj = nullptr;
+		if (Root->TryGetObjectField(TEXT("message"), MessageObj) && MessageObj && (*MessageObj).IsValid()
+			&& (*MessageObj)->TryGetObjectField(TEXT("usage"), UsageObj) && UsageObj && (*UsageObj).IsValid())
+		{
+			ReadAnthropicUsage(*UsageObj, State.PromptTokens, State.CachedPromptTokens, State.CacheWriteTokens);
+			(*UsageObj)->TryGetNumberField(TEXT("output_tokens"), State.CompletionTokens);
+		}
+	}
+	else if (Type == TEXT("message_delta"))
+	{
+		const TSharedPtr<FJsonObject>* UsageObj = nullptr;
+		if (Root->TryGetObjectField(TEXT("usage"), UsageObj) && UsageObj && (*UsageObj).IsValid())
+		{
+			(*UsageObj)->TryGetNumberField(TEXT("output_tokens"), State.CompletionTokens);
+		}
+	}
+	else if (Type == TEXT("message_stop"))
+	{
+		State.bDone = true;
+	}
+	else if (Type == TEXT("error"))
+	{
+		const TSharedPtr<FJsonObject>* ErrorObj = nullptr;
+		FString Message;
+		if (Root->TryGetObjectField(TEXT("error"), ErrorObj) && ErrorObj && (*ErrorObj).IsValid())
+		{
+			(*ErrorObj)->TryGetStringField(TEXT("message"), Message);
+		}
+		State.ErrorMessage = FString::Printf(TEXT("Anthropic stream error: %s"), Message.IsEmpty() ? *Data : *Message);
+		State.bDone = true;
+	}
+}
+
 FString FAnthropicProvider::GetDefaultEndpoint(const FAgentForgeLLMSettings& Settings) const
 {
 	if (!Settings.CustomEndpoint.IsEmpty())
@@ -15,6 +15,13 @@ public:
 		const FHttpResponsePtr& HttpResponse,
 		bool bSucceeded) const override;
 
+	virtual bool SupportsStreaming() const override { return true; }
+	virtual void ParseStreamEvent(
+		const FString& EventName,
+		const FString& Data,
+		FAgentForgeLLMStreamState& State,
+		FString& OutDelta) const override;
+
 	virtual FString GetDefaultEndpoint(const FAgentForgeLLMSettings& Settings) const override;
 	virtual TArray<FString> GetAvailableModels() const override;
 };
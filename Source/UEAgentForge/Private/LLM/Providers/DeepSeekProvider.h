@@ -7,4 +7,7 @@ class FDeepSeekProvider : public FOpenAIProvider
 public:
 	virtual FString GetDefaultEndpoint(const FAgentForgeLLMSettings& Settings) const override;
 	virtual TArray<FString> GetAvailableModels() const override;
+
+protected:
+	virtual bool SendsPromptCacheKey() const override { return false; }
 };
@@ -7,4 +7,8 @@ class FOpenAICompatibleProvider : public FOpenAIProvider
 public:
 	virtual FString GetDefaultEndpoint(const FAgentForgeLLMSettings& Settings) const override;
 	virtual TArray<FString> GetAvailableModels() const override;
+
+protected:
+	virtual bool RequestsStreamUsage() const override { return false; }
+	virtual bool SendsPromptCacheKey() const override { return false; }
 };
@@ -1,6 +1,8 @@
 #include "LLM/Providers/OpenAIProvider.h"
+#include "AgentForgeTrace.h"
 #include "Dom/JsonObject.h"
 #include "Dom/JsonValue.h"
+#include "Misc/SecureHash.h"
 #include "Serialization/JsonSerializer.h"
 #include "Serialization/JsonWriter.h"
 
@@ -62,6 +64,30 @@ namespace
 		return MakeShared<FJsonValueArray>(ContentArray);
 	}
 
+	/** Routes requests sharing a static prefix to the same prompt cache. */
+	static FString MakePromptCacheKey(const FAgentForgeLLMSettings& Settings)
+	{
+		const FString Prefix = Settings.Model + TEXT("\n") + Settings.SystemPrompt + TEXT("\n") + Settings.ResponseSchema;
+		FTCHARToUTF8 Utf8(*Prefix);
+		FSHAHash Hash;
+		FSHA1::HashBuffer(Utf8.Get(), Utf8.Length(), Hash.Hash);
+		return FString::Printf(TEXT("agentforge-%s"), *Hash.ToString().Left(16).ToLower());
+	}
+
+	/** OpenAI reports prompt_tokens_details.cached_tokens; DeepSeek reports prompt_cache_hit_tokens. */
+	static void ReadOpenAIUsage(const TSharedPtr<FJsonObject>& UsageObj, int32& OutPrompt, int32& OutCached, int32& OutCompletion)
+	{
+		UsageObj->TryGetNumberField(TEXT("prompt_tokens"), OutPrompt);
+		UsageObj->TryGetNumberField(TEXT("completion_tokens"), OutCompletion);
+
+		const TSharedPtr<FJsonObject>* DetailsObj = nullptr;
+		if (UsageObj->TryGetObjectField(TEXT("prompt_tokens_details"), DetailsObj) && DetailsObj && (*DetailsObj).IsValid())
+		{
+			(*DetailsObj)->TryGetNumberField(TEXT("cached_tokens"), OutCached);
+		}
+		UsageObj->TryGetNumberField(TEXT("prompt_cache_hit_tokens"), OutCached);
+	}
+
 	static FString ExtractOpenAIContent(const TSharedPtr<FJsonObject>& Root)
 	{
 		const TArray<TSharedPtr<FJsonValue>>* Choices = nullptr;
@@ -115,6 +141,7 @@ bool FOpenAIProvider::PrepareRequest(
 	const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& Request,
 	FString& OutError) const
 {
+	AGENTFORGE_TRACE_SCOPE("AgentForge.LLM.OpenAI.PrepareRequest");
 	OutError.Reset();
 	if (Settings.Model.IsEmpty())
 	{
@@ -152,6 +179,23 @@ bool FOpenAIProvider::PrepareRequest(
 	}
 	Root->SetArrayField(TEXT("messages"), MessageArray);
 
+	if (Settings.bCachePrompt && SendsPromptCacheKey())
+	{
+		Root->SetStringField(TEXT("prompt_cache_key"), MakePromptCacheKey(Settings));
+	}
+
+	if (Settings.bStreamResponse)
+	{
+		Root->SetBoolField(TEXT("stream"), true);
+		if (RequestsStreamUsage())
+		{
+			TSharedPtr<FJsonObject> StreamOptions = MakeShared<FJsonObject>();
+			StreamOptions->SetBoolField(TEXT("include_usage"), true);
+			Root->SetObjectField(TEXT("stream_options"), StreamOptions);
+		}
+		Request->SetHeader(TEXT("Accept"), TEXT("text/event-stream"));
+	}
+
 	if (!Settings.ResponseSchema.IsEmpty())
 	{
 		TSharedPtr<FJsonObject> SchemaObj;
@@ -183,6 +227,7 @@ FAgentForgeLLMResponse FOpenAIProvider::ParseResponse(
 	const FHttpResponsePtr& HttpResponse,
 	bool bSucceeded) const
 {
+	AGENTFORGE_TRACE_SCOPE("AgentForge.LLM.OpenAI.ParseResponse");
 	FAgentForgeLLMResponse Response;
 	Response.bSuccess = false;
 
@@ -213,14 +258,7 @@ FAgentForgeLLMResponse FOpenAIProvider::ParseResponse(
 	const TSharedPtr<FJsonObject>* UsageObj = nullptr;
 	if (Root->TryGetObjectField(TEXT("usage"), UsageObj) && UsageObj && (*UsageObj).IsValid())
 	{
-		if ((*UsageObj)->HasTypedField<EJson::Number>(TEXT("prompt_tokens")))
-		{
-			Response.PromptTokens = (int32)(*UsageObj)->GetNumberField(TEXT("prompt_tokens"));
-		}
-		if ((*UsageObj)->HasTypedField<EJson::Number>(TEXT("completion_tokens")))
-		{
-			Response.CompletionTokens = (int32)(*UsageObj)->GetNumberField(TEXT("completion_tokens"));
-		}
+		ReadOpenAIUsage(*UsageObj, Response.PromptTokens, Response.CachedPromptTokens, Response.CompletionTokens);
 	}
 
 	Response.bSuccess = !Response.Content.IsEmpty();
@@ -231,6 +269,64 @@ FAgentForgeLLMResponse FOpenAIProvider::ParseResponse(
 	return Response;
 }
 
+void FOpenAIProvider::ParseStreamEvent(
+	const FString& EventName,
+	const FString& Data,
+	FAgentForgeLLMStreamState& State,
+	FString& OutDelta) const
+{
+	AGENTFORGE_TRACE_SCOPE("AgentForge.LLM.OpenAI.ParseStreamEvent");
+	OutDelta.Reset();
+	if (Data == TEXT("[DONE]"))
+	{
+		State.bDone = true;
+		return;
+	}
+
+	TSharedPtr<FJsonObject> Root;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Data);
+	if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid())
+	{
+		return;
+	}
+
+	const TSharedPtr<FJsonObject>* ErrorObj = nullptr;
+	if (Root->TryGetObjectField(TEXT("error"), ErrorObj) && ErrorObj && (*ErrorObj).IsValid())
+	{
+		FString Message;
+		(*ErrorObj)->TryGetStringField(TEXT("message"), Message);
+		State.ErrorMessage = FString::Printf(TEXT("OpenAI stream error: %s"), Message.IsEmpty() ? *Data : *Message);
+		State.bDone = true;
+		return;
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* Choices = nullptr;
+	const TSharedPtr<FJsonObject>* ChoiceObj = nullptr;
+	const TSharedPtr<FJsonObject>* DeltaObj = nullptr;
+	if (Root->TryGetArrayField(TEXT("choices"), Choices) && Choices && Choices->Num() > 0
+		&& (*Choices)[0]->TryGetObject(ChoiceObj) && ChoiceObj && (*ChoiceObj).IsValid()
+		&& (*ChoiceObj)->TryGetObjectField(TEXT("delta"), DeltaObj) && DeltaObj && (*DeltaObj).IsValid())
+	{
+		FString Text;
+		if ((*DeltaObj)->TryGetStringField(TEXT("content"), Text) && !Text.IsEmpty())
+		{
+			State.Content += Text;
+			OutDelta = MoveTemp(Text);
+		}
+		FString Reasoning;
+		if ((*DeltaObj)->TryGetStringField(TEXT("reasoning_content"), Reasoning))
+		{
+			State.ReasoningContent += Reasoning;
+		}
+	}
+
+	const TSharedPtr<FJsonObject>* UsageObj = nullptr;
+	if (Root->TryGetObjectField(TEXT("usage"), UsageObj) && UsageObj && (*UsageObj).IsValid())
+	{
+		ReadOpenAIUsage(*UsageObj, State.PromptTokens, State.CachedPromptTokens, State.CompletionTokens);
+	}
+}
+
 FString FOpenAIProvider::GetDefaultEndpoint(const FAgentForgeLLMSettings& Settings) const
 {
 	if (!Settings.CustomEndpoint.IsEmpty())
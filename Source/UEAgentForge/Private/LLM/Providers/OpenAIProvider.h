@@ -15,6 +15,20 @@ public:
 		const FHttpResponsePtr& HttpResponse,
 		bool bSucceeded) const override;
 
+	virtual bool SupportsStreaming() const override { return true; }
+	virtual void ParseStreamEvent(
+		const FString& EventName,
+		const FString& Data,
+		FAgentForgeLLMStreamState& State,
+		FString& OutDelta) const override;
+
 	virtual FString GetDefaultEndpoint(const FAgentForgeLLMSettings& Settings) const override;
 	virtual TArray<FString> GetAvailableModels() const override;
+
+protected:
+	/** Sends stream_options.include_usage; not every OpenAI-compatible server accepts it. */
+	virtual bool RequestsStreamUsage() const { return true; }
+
+	/** Sends prompt_cache_key with Settings.bCachePrompt; other servers cache prefixes without it. */
+	virtual bool SendsPromptCacheKey() const { return true; }
 };
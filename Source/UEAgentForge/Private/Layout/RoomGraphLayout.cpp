@@ -0,0 +1,804 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// RoomGraphLayout.cpp — occupancy-grid placement, Bowyer-Watson, Kruskal and grid A*.
+
+#include "Layout/RoomGraphLayout.h"
+
+#include "AgentForgeProceduralCache.h"
+
+#include "Algo/Reverse.h"
+#include "HAL/PlatformTime.h"
+#include "Math/Box2D.h"
+#include "Math/RandomStream.h"
+
+namespace
+{
+	constexpr int32 MaxPlacementTries = 200;
+	constexpr int32 LayoutCacheVersion = 1;
+	constexpr int32 GridMargin = 2;   // free cells around the layout so corridors can route around its edge
+
+	// 0:+X  1:+Y  2:-X  3:-Y
+	const FIntPoint GStepDirs[4] = { FIntPoint(1, 0), FIntPoint(0, 1), FIntPoint(-1, 0), FIntPoint(0, -1) };
+
+	FVector2D RectCenter(const FIntRect& Rect)
+	{
+		return FVector2D((Rect.Min.X + Rect.Max.X) * 0.5, (Rect.Min.Y + Rect.Max.Y) * 0.5);
+	}
+
+	FVector2D CellCenter(const FIntPoint& Cell)
+	{
+		return FVector2D(Cell.X + 0.5, Cell.Y + 0.5);
+	}
+
+	uint64 EdgeKey(int32 A, int32 B)
+	{
+		const uint64 Lo = (uint32)FMath::Min(A, B);
+		const uint64 Hi = (uint32)FMath::Max(A, B);
+		return (Lo << 32) | Hi;
+	}
+
+	struct FGraphEdge
+	{
+		int32  A = 0;
+		int32  B = 0;
+		double Length = 0.0;
+		bool   bLoop = false;
+	};
+
+	struct FUnionFind
+	{
+		TArray<int32> Parent;
+
+		explicit FUnionFind(int32 Num)
+		{
+			Parent.SetNumUninitialized(Num);
+			for (int32 Index = 0; Index < Num; ++Index)
+			{
+				Parent[Index] = Index;
+			}
+		}
+
+		int32 Find(int32 X)
+		{
+			while (Parent[X] != X)
+			{
+				Parent[X] = Parent[Parent[X]];
+				X = Parent[X];
+			}
+			return X;
+		}
+
+		bool Union(int32 A, int32 B)
+		{
+			A = Find(A);
+			B = Find(B);
+			if (A == B)
+			{
+				return false;
+			}
+			Parent[A] = B;
+			return true;
+		}
+	};
+
+	// ── Place ────────────────────────────────────────────────────────────────
+
+	/** Rooms at random free spots; the grid grows by a quarter whenever a room finds none. */
+	void PlaceRooms(const FRoomLayoutSettings& Settings, FRandomStream& Rng, TArray<FIntRect>& OutRooms, FIntPoint& OutGrid, int32& OutGrowths)
+	{
+		const int32 MinSide = FMath::Max(1, Settings.RoomCells.X);
+		const int32 MaxSide = FMath::Max(MinSide, Settings.RoomCells.Y);
+		const int32 Padding = Settings.Padding;
+
+		// About half the grid ends up covered by rooms and their padding.
+		const double Footprint = FMath::Square((MinSide + MaxSide) * 0.5 + Padding);
+		const int32 Side = FMath::CeilToInt(FMath::Sqrt(Settings.RoomCount * Footprint * 2.0)) + MaxSide;
+		FIntPoint Grid(Side, Side);
+
+		TArray<int32> Occupied;
+		auto Rebuild = [&]()
+		{
+			Occupied.Init(INDEX_NONE, Grid.X * Grid.Y);
+			for (int32 Room = 0; Room < OutRooms.Num(); ++Room)
+			{
+				const FIntRect& Rect = OutRooms[Room];
+				for (int32 Y = Rect.Min.Y; Y < Rect.Max.Y; ++Y)
+				{
+					for (int32 X = Rect.Min.X; X < Rect.Max.X; ++X)
+					{
+						Occupied[Y * Grid.X + X] = Room;
+					}
+				}
+			}
+		};
+		auto IsFree = [&](const FIntRect& Rect)
+		{
+			const int32 MinX = FMath::Max(0, Rect.Min.X - Padding);
+			const int32 MinY = FMath::Max(0, Rect.Min.Y - Padding);
+			const int32 MaxX = FMath::Min(Grid.X, Rect.Max.X + Padding);
+			const int32 MaxY = FMath::Min(Grid.Y, Rect.Max.Y + Padding);
+			for (int32 Y = MinY; Y < MaxY; ++Y)
+			{
+				for (int32 X = MinX; X < MaxX; ++X)
+				{
+					if (Occupied[Y * Grid.X + X] != INDEX_NONE)
+					{
+						return false;
+					}
+				}
+			}
+			return true;
+		};
+
+		Rebuild();
+		OutRooms.Reserve(Settings.RoomCount);
+		for (int32 Room = 0; Room < Settings.RoomCount; ++Room)
+		{
+			const FIntPoint Size(Rng.RandRange(MinSide, MaxSide), Rng.RandRange(MinSide, MaxSide));
+			for (;;)
+			{
+				bool bPlaced = false;
+				for (int32 Try = 0; Try < MaxPlacementTries && !bPlaced; ++Try)
+				{
+					const FIntPoint Min(Rng.RandRange(0, Grid.X - Size.X), Rng.RandRange(0, Grid.Y - Size.Y));
+					const FIntRect Candidate(Min, Min + Size);
+					if (IsFree(Candidate))
+					{
+						OutRooms.Add(Candidate);
+						for (int32 Y = Candidate.Min.Y; Y < Candidate.Max.Y; ++Y)
+						{
+							for (int32 X = Candidate.Min.X; X < Candidate.Max.X; ++X)
+							{
+								Occupied[Y * Grid.X + X] = Room;
+							}
+						}
+						bPlaced = true;
+					}
+				}
+				if (bPlaced)
+				{
+					break;
+				}
+				Grid += FIntPoint(Grid.X / 4 + 1, Grid.Y / 4 + 1);
+				++OutGrowths;
+				Rebuild();
+			}
+		}
+
+		// Crop to the rooms plus a routing margin.
+		FIntPoint BoundsMin(MAX_int32, MAX_int32);
+		FIntPoint BoundsMax(MIN_int32, MIN_int32);
+		for (const FIntRect& Rect : OutRooms)
+		{
+			BoundsMin = FIntPoint(FMath::Min(BoundsMin.X, Rect.Min.X), FMath::Min(BoundsMin.Y, Rect.Min.Y));
+			BoundsMax = FIntPoint(FMath::Max(BoundsMax.X, Rect.Max.X), FMath::Max(BoundsMax.Y, Rect.Max.Y));
+		}
+		const FIntPoint Shift = FIntPoint(GridMargin) - BoundsMin;
+		for (FIntRect& Rect : OutRooms)
+		{
+			Rect.Min += Shift;
+			Rect.Max += Shift;
+		}
+		OutGrid = BoundsMax - BoundsMin + FIntPoint(GridMargin * 2);
+	}
+
+	// ── Connect ──────────────────────────────────────────────────────────────
+
+	/** Bowyer-Watson. Degenerate (collinear) triangles never capture a point; Kruskal's fallback covers any edge they hide. */
+	void Triangulate(const TArray<FVector2D>& Points, TSet<uint64>& OutEdges)
+	{
+		const int32 Num = Points.Num();
+		if (Num == 2)
+		{
+			OutEdges.Add(EdgeKey(0, 1));
+		}
+		if (Num < 3)
+		{
+			return;
+		}
+
+		struct FTriangle
+		{
+			int32     V[3];
+			FVector2D Circumcenter;
+			double    RadiusSq;
+		};
+
+		const FBox2D Bounds(Points);
+		const double Span = FMath::Max(Bounds.GetSize().GetMax(), 1.0);
+		const FVector2D Center = Bounds.GetCenter();
+		TArray<FVector2D> Verts = Points;
+		Verts.Add(Center + FVector2D(-20.0 * Span, -10.0 * Span));
+		Verts.Add(Center + FVector2D( 20.0 * Span, -10.0 * Span));
+		Verts.Add(Center + FVector2D(  0.0,         20.0 * Span));
+
+		auto MakeTriangle = [&Verts](int32 A, int32 B, int32 C)
+		{
+			FTriangle Tri{ { A, B, C }, FVector2D::ZeroVector, -1.0 };
+			const FVector2D& P = Verts[A];
+			const FVector2D& Q = Verts[B];
+			const FVector2D& R = Verts[C];
+			const double D = 2.0 * (P.X * (Q.Y - R.Y) + Q.X * (R.Y - P.Y) + R.X * (P.Y - Q.Y));
+			if (FMath::Abs(D) > UE_DOUBLE_SMALL_NUMBER)
+			{
+				const double P2 = P.SizeSquared();
+				const double Q2 = Q.SizeSquared();
+				const double R2 = R.SizeSquared();
+				Tri.Circumcenter = FVector2D(
+					(P2 * (Q.Y - R.Y) + Q2 * (R.Y - P.Y) + R2 * (P.Y - Q.Y)) / D,
+					(P2 * (R.X - Q.X) + Q2 * (P.X - R.X) + R2 * (Q.X - P.X)) / D);
+				Tri.RadiusSq = FVector2D::DistSquared(Tri.Circumcenter, P);
+			}
+			return Tri;
+		};
+
+		TArray<FTriangle> Triangles;
+		Triangles.Add(MakeTriangle(Num, Num + 1, Num + 2));
+		TArray<FTriangle> Kept;
+		TArray<TPair<int32, int32>> CavityEdges;
+		TMap<uint64, int32> EdgeUses;
+		for (int32 Point = 0; Point < Num; ++Point)
+		{
+			const FVector2D& P = Verts[Point];
+			Kept.Reset();
+			CavityEdges.Reset();
+			EdgeUses.Reset();
+			for (const FTriangle& Tri : Triangles)
+			{
+				if (FVector2D::DistSquared(P, Tri.Circumcenter) < Tri.RadiusSq)
+				{
+					for (int32 Edge = 0; Edge < 3; ++Edge)
+					{
+						const int32 A = Tri.V[Edge];
+						const int32 B = Tri.V[(Edge + 1) % 3];
+						CavityEdges.Emplace(A, B);
+						++EdgeUses.FindOrAdd(EdgeKey(A, B));
+					}
+				}
+				else
+				{
+					Kept.Add(Tri);
+				}
+			}
+			// The cavity boundary is every edge used by exactly one removed triangle.
+			for (const TPair<int32, int32>& Edge : CavityEdges)
+			{
+				if (EdgeUses.FindChecked(EdgeKey(Edge.Key, Edge.Value)) == 1)
+				{
+					Kept.Add(MakeTriangle(Edge.Key, Edge.Value, Point));
+				}
+			}
+			Swap(Triangles, Kept);
+		}
+
+		for (const FTriangle& Tri : Triangles)
+		{
+			if (Tri.V[0] < Num && Tri.V[1] < Num && Tri.V[2] < Num)
+			{
+				OutEdges.Add(EdgeKey(Tri.V[0], Tri.V[1]));
+				OutEdges.Add(EdgeKey(Tri.V[1], Tri.V[2]));
+				OutEdges.Add(EdgeKey(Tri.V[2], Tri.V[0]));
+			}
+		}
+	}
+
+	/** Minimum spanning tree over the Delaunay edges plus a random share of the rest as loops. */
+	TArray<FGraphEdge> BuildGraph(const TArray<FVector2D>& Centers, const TSet<uint64>& Delaunay, float LoopFraction, FRandomStream& Rng, int32& OutTreeEdges)
+	{
+		const int32 Num = Centers.Num();
+		auto MakeEdge = [&Centers](int32 A, int32 B)
+		{
+			FGraphEdge Edge;
+			Edge.A = A;
+			Edge.B = B;
+			Edge.Length = FVector2D::Distance(Centers[A], Centers[B]);
+			return Edge;
+		};
+		auto ByLength = [](const FGraphEdge& L, const FGraphEdge& R)
+		{
+			return L.Length < R.Length || (L.Length == R.Length && EdgeKey(L.A, L.B) < EdgeKey(R.A, R.B));
+		};
+
+		TArray<FGraphEdge> Candidates;
+		Candidates.Reserve(Delaunay.Num());
+		for (const uint64 Key : Delaunay)
+		{
+			Candidates.Add(MakeEdge((int32)(Key >> 32), (int32)(Key & 0xffffffffull)));
+		}
+		Candidates.Sort(ByLength);
+
+		FUnionFind Sets(Num);
+		TArray<FGraphEdge> Graph;
+		TArray<FGraphEdge> Spare;
+		for (const FGraphEdge& Edge : Candidates)
+		{
+			(Sets.Union(Edge.A, Edge.B) ? Graph : Spare).Add(Edge);
+		}
+
+		// Collinear input can leave the triangulation disconnected: join what is left over all pairs.
+		if (Graph.Num() < Num - 1)
+		{
+			TArray<FGraphEdge> AllPairs;
+			for (int32 A = 0; A < Num; ++A)
+			{
+				for (int32 B = A + 1; B < Num; ++B)
+				{
+					if (Sets.Find(A) != Sets.Find(B))
+					{
+						AllPairs.Add(MakeEdge(A, B));
+					}
+				}
+			}
+			AllPairs.Sort(ByLength);
+			for (const FGraphEdge& Edge : AllPairs)
+			{
+				if (Sets.Union(Edge.A, Edge.B))
+				{
+					Graph.Add(Edge);
+				}
+			}
+		}
+		OutTreeEdges = Graph.Num();
+
+		for (int32 Index = Spare.Num() - 1; Index > 0; --Index)
+		{
+			Spare.Swap(Index, Rng.RandRange(0, Index));
+		}
+		const int32 Loops = FMath::Clamp(FMath::RoundToInt(Spare.Num() * LoopFraction), 0, Spare.Num());
+		for (int32 Index = 0; Index < Loops; ++Index)
+		{
+			FGraphEdge Edge = Spare[Index];
+			Edge.bLoop = true;
+			Graph.Add(Edge);
+		}
+		return Graph;
+	}
+
+	TArray<int32> HopDepths(const TArray<TArray<int32>>& Adjacency, int32 From)
+	{
+		TArray<int32> Depth;
+		Depth.Init(INDEX_NONE, Adjacency.Num());
+		TArray<int32> Frontier;
+		Frontier.Add(From);
+		Depth[From] = 0;
+		for (int32 Head = 0; Head < Frontier.Num(); ++Head)
+		{
+			const int32 Node = Frontier[Head];
+			for (const int32 Next : Adjacency[Node])
+			{
+				if (Depth[Next] == INDEX_NONE)
+				{
+					Depth[Next] = Depth[Node] + 1;
+					Frontier.Add(Next);
+				}
+			}
+		}
+		return Depth;
+	}
+
+	int32 Deepest(const TArray<int32>& Depth)
+	{
+		int32 Best = 0;
+		for (int32 Index = 1; Index < Depth.Num(); ++Index)
+		{
+			if (Depth[Index] > Depth[Best])
+			{
+				Best = Index;
+			}
+		}
+		return Best;
+	}
+
+	// ── Route ────────────────────────────────────────────────────────────────
+
+	struct FCorridorRouter
+	{
+		FIntPoint            Grid;
+		const TArray<int32>& RoomAt;
+		TArray<uint8>        CorridorAt;
+		float                TurnCost;
+		float                ReuseCost;
+
+		struct FOpen
+		{
+			float F;
+			int32 State;   // cell * 4 + arrival direction
+		};
+
+		TArray<float>  Cost;
+		TArray<int32>  Parent;
+		TArray<uint32> Stamp;
+		TArray<FOpen>  Open;
+		uint32         Search = 0;
+
+		FCorridorRouter(const FIntPoint& InGrid, const TArray<int32>& InRoomAt, float InTurnCost, float InReuseCost)
+			: Grid(InGrid), RoomAt(InRoomAt), TurnCost(InTurnCost), ReuseCost(InReuseCost)
+		{
+			const int32 States = Grid.X * Grid.Y * 4;
+			CorridorAt.SetNumZeroed(Grid.X * Grid.Y);
+			Cost.SetNumUninitialized(States);
+			Parent.SetNumUninitialized(States);
+			Stamp.SetNumZeroed(States);
+		}
+
+		/**
+		 * Cells from Start to Goal, inclusive. Other rooms block. The heuristic
+		 * is plain Manhattan distance, which overestimates once reused cells
+		 * are cheaper: near-shortest paths for far fewer expansions.
+		 */
+		bool Route(int32 RoomA, int32 RoomB, const FIntPoint& Start, const FIntPoint& Goal, TArray<FIntPoint>& OutCells)
+		{
+			++Search;
+			Open.Reset();
+			auto Less = [](const FOpen& L, const FOpen& R) { return L.F < R.F; };
+			auto Heuristic = [&Goal](const FIntPoint& Cell) { return (float)(FMath::Abs(Cell.X - Goal.X) + FMath::Abs(Cell.Y - Goal.Y)); };
+
+			const int32 StartCell = Start.Y * Grid.X + Start.X;
+			const int32 GoalCell = Goal.Y * Grid.X + Goal.X;
+			for (int32 Dir = 0; Dir < 4; ++Dir)
+			{
+				const int32 State = StartCell * 4 + Dir;
+				Stamp[State] = Search;
+				Cost[State] = 0.0f;
+				Parent[State] = INDEX_NONE;
+				Open.HeapPush(FOpen{ Heuristic(Start), State }, Less);
+			}
+
+			int32 Reached = INDEX_NONE;
+			while (Open.Num() > 0)
+			{
+				FOpen Top;
+				Open.HeapPop(Top, Less, EAllowShrinking::No);
+				const int32 Cell = Top.State / 4;
+				const int32 Dir = Top.State % 4;
+				const FIntPoint At(Cell % Grid.X, Cell / Grid.X);
+				const float G = Cost[Top.State];
+				if (Top.F > G + Heuristic(At) + KINDA_SMALL_NUMBER)
+				{
+					continue;   // stale entry
+				}
+				if (Cell == GoalCell)
+				{
+					Reached = Top.State;
+					break;
+				}
+
+				for (int32 NextDir = 0; NextDir < 4; ++NextDir)
+				{
+					const FIntPoint Next = At + GStepDirs[NextDir];
+					if (Next.X < 0 || Next.Y < 0 || Next.X >= Grid.X || Next.Y >= Grid.Y)
+					{
+						continue;
+					}
+					const int32 NextCell = Next.Y * Grid.X + Next.X;
+					const int32 Occupant = RoomAt[NextCell];
+					if (Occupant != INDEX_NONE && Occupant != RoomA && Occupant != RoomB)
+					{
+						continue;
+					}
+					float Step = (Occupant == INDEX_NONE && CorridorAt[NextCell]) ? ReuseCost : 1.0f;
+					if (NextDir != Dir)
+					{
+						Step += TurnCost;
+					}
+					const int32 NextState = NextCell * 4 + NextDir;
+					const float NextCost = G + Step;
+					if (Stamp[NextState] != Search || NextCost < Cost[NextState])
+					{
+						Stamp[NextState] = Search;
+						Cost[NextState] = NextCost;
+						Parent[NextState] = Top.State;
+						Open.HeapPush(FOpen{ NextCost + Heuristic(Next), NextState }, Less);
+					}
+				}
+			}
+
+			OutCells.Reset();
+			if (Reached == INDEX_NONE)
+			{
+				return false;
+			}
+			for (int32 State = Reached; State != INDEX_NONE; State = Parent[State])
+			{
+				const int32 Cell = State / 4;
+				OutCells.Add(FIntPoint(Cell % Grid.X, Cell / Grid.X));
+			}
+			Algo::Reverse(OutCells);
+			return true;
+		}
+	};
+
+	/** Cell centres to a wall-to-wall polyline that keeps only its bends. */
+	TArray<FVector2D> ToPolyline(const TArray<FIntPoint>& Path, int32 First, int32 Last)
+	{
+		TArray<FVector2D> Raw;
+		Raw.Reserve(Last - First + 3);
+		Raw.Add((CellCenter(Path[First - 1]) + CellCenter(Path[First])) * 0.5);
+		for (int32 Index = First; Index <= Last; ++Index)
+		{
+			Raw.Add(CellCenter(Path[Index]));
+		}
+		Raw.Add((CellCenter(Path[Last]) + CellCenter(Path[Last + 1])) * 0.5);
+
+		TArray<FVector2D> Points;
+		Points.Add(Raw[0]);
+		for (int32 Index = 1; Index < Raw.Num() - 1; ++Index)
+		{
+			const FVector2D In = (Raw[Index] - Raw[Index - 1]).GetSignVector();
+			const FVector2D Out = (Raw[Index + 1] - Raw[Index]).GetSignVector();
+			if (In != Out)
+			{
+				Points.Add(Raw[Index]);
+			}
+		}
+		Points.Add(Raw.Last());
+		return Points;
+	}
+}
+
+FVector FRoomLayout::ToWorld(const FVector2D& Cell) const
+{
+	return FVector((Cell.X - OriginCell.X) * CellSize, (Cell.Y - OriginCell.Y) * CellSize, 0.0);
+}
+
+FVector FRoomLayout::RoomCenter(int32 Room) const
+{
+	return Rooms.IsValidIndex(Room) ? ToWorld(RectCenter(Rooms[Room].Cells)) : FVector::ZeroVector;
+}
+
+FVector2D FRoomLayout::RoomSize(int32 Room) const
+{
+	if (!Rooms.IsValidIndex(Room))
+	{
+		return FVector2D::ZeroVector;
+	}
+	const FIntPoint Size = Rooms[Room].Cells.Size();
+	return FVector2D(Size.X * CellSize, Size.Y * CellSize);
+}
+
+TSharedPtr<FJsonObject> FRoomLayout::GetStatsJson() const
+{
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetNumberField(TEXT("grid_w"),         GridSize.X);
+	Obj->SetNumberField(TEXT("grid_h"),         GridSize.Y);
+	Obj->SetNumberField(TEXT("cell_size"),      CellSize);
+	Obj->SetNumberField(TEXT("rooms"),          Rooms.Num());
+	Obj->SetNumberField(TEXT("delaunay_edges"), DelaunayEdges);
+	Obj->SetNumberField(TEXT("tree_edges"),     TreeEdges);
+	Obj->SetNumberField(TEXT("loop_edges"),     LoopEdges);
+	Obj->SetNumberField(TEXT("corridors"),      Corridors.Num());
+	Obj->SetNumberField(TEXT("unrouted"),       Unrouted);
+	Obj->SetNumberField(TEXT("corridor_cells"), CorridorCells);
+	Obj->SetNumberField(TEXT("grid_growths"),   GridGrowths);
+	Obj->SetNumberField(TEXT("place_ms"),       PlaceMs);
+	Obj->SetNumberField(TEXT("graph_ms"),       GraphMs);
+	Obj->SetNumberField(TEXT("route_ms"),       RouteMs);
+	return Obj;
+}
+
+const TCHAR* const FRoomGraphLayout::CacheKind = TEXT("room_layout");
+
+FString FRoomGraphLayout::MakeCacheKey(const FRoomLayoutSettings& Settings)
+{
+	return FAgentForgeProceduralCache::MakeKey(CacheKind, FString::Printf(
+		TEXT("v%d|%d|%d|%.9g|%d,%d|%d|%.9g|%.9g|%.9g"),
+		LayoutCacheVersion, Settings.RoomCount, Settings.Seed, Settings.CellSize,
+		Settings.RoomCells.X, Settings.RoomCells.Y, Settings.Padding,
+		Settings.LoopFraction, Settings.TurnCost, Settings.ReuseCost));
+}
+
+void FRoomGraphLayout::Serialize(FArchive& Ar, FRoomLayout& Layout)
+{
+	int32 Version = LayoutCacheVersion;
+	Ar << Version;
+	if (Version != LayoutCacheVersion)
+	{
+		Ar.SetError();
+		return;
+	}
+
+	int32 RoomNum = Layout.Rooms.Num();
+	Ar << RoomNum;
+	if (Ar.IsLoading())
+	{
+		Layout.Rooms.SetNum(FMath::Max(0, RoomNum));
+	}
+	for (FLayoutRoom& Room : Layout.Rooms)
+	{
+		Ar << Room.Cells.Min << Room.Cells.Max << Room.Role << Room.Depth;
+	}
+
+	int32 CorridorNum = Layout.Corridors.Num();
+	Ar << CorridorNum;
+	if (Ar.IsLoading())
+	{
+		Layout.Corridors.SetNum(FMath::Max(0, CorridorNum));
+	}
+	for (FLayoutCorridor& Corridor : Layout.Corridors)
+	{
+		Ar << Corridor.RoomA << Corridor.RoomB << Corridor.bLoop << Corridor.Points;
+	}
+
+	Ar << Layout.GridSize << Layout.CellSize << Layout.OriginCell;
+	Ar << Layout.DelaunayEdges << Layout.TreeEdges << Layout.LoopEdges << Layout.Unrouted;
+	Ar << Layout.CorridorCells << Layout.GridGrowths;
+	Ar << Layout.PlaceMs << Layout.GraphMs << Layout.RouteMs;
+}
+
+bool FRoomGraphLayout::Generate(const FRoomLayoutSettings& InSettings, FRoomLayout& OutLayout, FString& OutError)
+{
+	OutLayout = FRoomLayout();
+	if (InSettings.RoomCount < 1)
+	{
+		OutError = TEXT("Room layout needs at least one room.");
+		return false;
+	}
+	if (InSettings.CellSize <= KINDA_SMALL_NUMBER)
+	{
+		OutError = TEXT("Room layout cell size must be greater than zero.");
+		return false;
+	}
+
+	FRoomLayoutSettings Settings = InSettings;
+	Settings.Padding = FMath::Max(1, Settings.Padding);
+	FRandomStream Rng(Settings.Seed);
+	OutLayout.CellSize = Settings.CellSize;
+
+	// ── Place ──
+	double Start = FPlatformTime::Seconds();
+	TArray<FIntRect> Rects;
+	PlaceRooms(Settings, Rng, Rects, OutLayout.GridSize, OutLayout.GridGrowths);
+	const int32 Num = Rects.Num();
+	OutLayout.PlaceMs = (FPlatformTime::Seconds() - Start) * 1000.0;
+
+	// ── Connect + order ──
+	Start = FPlatformTime::Seconds();
+	TArray<FVector2D> Centers;
+	Centers.Reserve(Num);
+	for (const FIntRect& Rect : Rects)
+	{
+		Centers.Add(RectCenter(Rect));
+	}
+	TSet<uint64> Delaunay;
+	Triangulate(Centers, Delaunay);
+	OutLayout.DelaunayEdges = Delaunay.Num();
+	TArray<FGraphEdge> Edges = BuildGraph(Centers, Delaunay, Settings.LoopFraction, Rng, OutLayout.TreeEdges);
+	OutLayout.LoopEdges = Edges.Num() - OutLayout.TreeEdges;
+
+	TArray<TArray<int32>> Adjacency;
+	Adjacency.SetNum(Num);
+	for (const FGraphEdge& Edge : Edges)
+	{
+		Adjacency[Edge.A].Add(Edge.B);
+		Adjacency[Edge.B].Add(Edge.A);
+	}
+	const int32 Entry = Deepest(HopDepths(Adjacency, 0));
+	const TArray<int32> Depth = HopDepths(Adjacency, Entry);
+	const int32 Exit = Deepest(Depth);
+	int32 Climax = INDEX_NONE;
+	if (Num > 2)
+	{
+		for (const int32 Neighbour : Adjacency[Exit])
+		{
+			if (Neighbour != Entry && (Climax == INDEX_NONE || Depth[Neighbour] > Depth[Climax]))
+			{
+				Climax = Neighbour;
+			}
+		}
+		for (int32 Room = 0; Climax == INDEX_NONE && Room < Num; ++Room)
+		{
+			Climax = (Room != Entry && Room != Exit) ? Room : INDEX_NONE;
+		}
+	}
+
+	TArray<int32> Order;
+	Order.Reserve(Num);
+	for (int32 Room = 0; Room < Num; ++Room)
+	{
+		if (Room != Entry && Room != Exit && Room != Climax)
+		{
+			Order.Add(Room);
+		}
+	}
+	Order.StableSort([&Depth](int32 L, int32 R) { return Depth[L] < Depth[R]; });
+	Order.Insert(Entry, 0);
+	if (Climax != INDEX_NONE)
+	{
+		Order.Add(Climax);
+	}
+	if (Exit != Entry)
+	{
+		Order.Add(Exit);
+	}
+
+	TArray<int32> NewIndex;
+	NewIndex.SetNumUninitialized(Num);
+	OutLayout.Rooms.Reserve(Num);
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		const int32 Old = Order[Index];
+		NewIndex[Old] = Index;
+		FLayoutRoom& Room = OutLayout.Rooms.AddDefaulted_GetRef();
+		Room.Cells = Rects[Old];
+		Room.Depth = Depth[Old];
+		Room.Role = Index == 0                   ? TEXT("Entry")
+		          : Index == Num - 1             ? TEXT("Exit")
+		          : (Index == Num - 2 && Num > 2) ? TEXT("Climax")
+		          : TEXT("Exploration");
+	}
+	OutLayout.OriginCell = RectCenter(OutLayout.Rooms[0].Cells);
+	for (FGraphEdge& Edge : Edges)
+	{
+		Edge.A = NewIndex[Edge.A];
+		Edge.B = NewIndex[Edge.B];
+	}
+	OutLayout.GraphMs = (FPlatformTime::Seconds() - Start) * 1000.0;
+
+	// ── Route: tree edges first so connectivity never depends on a loop, shortest first within each ──
+	Start = FPlatformTime::Seconds();
+	Edges.StableSort([](const FGraphEdge& L, const FGraphEdge& R)
+	{
+		return L.bLoop != R.bLoop ? !L.bLoop : L.Length < R.Length;
+	});
+
+	const FIntPoint Grid = OutLayout.GridSize;
+	TArray<int32> RoomAt;
+	RoomAt.Init(INDEX_NONE, Grid.X * Grid.Y);
+	for (int32 Room = 0; Room < Num; ++Room)
+	{
+		const FIntRect& Rect = OutLayout.Rooms[Room].Cells;
+		for (int32 Y = Rect.Min.Y; Y < Rect.Max.Y; ++Y)
+		{
+			for (int32 X = Rect.Min.X; X < Rect.Max.X; ++X)
+			{
+				RoomAt[Y * Grid.X + X] = Room;
+			}
+		}
+	}
+
+	FCorridorRouter Router(Grid, RoomAt, Settings.TurnCost, Settings.ReuseCost);
+	TArray<FIntPoint> Path;
+	for (const FGraphEdge& Edge : Edges)
+	{
+		const FIntRect& RectA = OutLayout.Rooms[Edge.A].Cells;
+		const FIntRect& RectB = OutLayout.Rooms[Edge.B].Cells;
+		const FIntPoint StartCell((RectA.Min.X + RectA.Max.X) / 2, (RectA.Min.Y + RectA.Max.Y) / 2);
+		const FIntPoint GoalCell((RectB.Min.X + RectB.Max.X) / 2, (RectB.Min.Y + RectB.Max.Y) / 2);
+		if (!Router.Route(Edge.A, Edge.B, StartCell, GoalCell, Path))
+		{
+			++OutLayout.Unrouted;
+			continue;
+		}
+
+		// The corridor is the stretch between the last cell in A and the first cell in B.
+		int32 FirstInB = 0;
+		while (FirstInB < Path.Num() && RoomAt[Path[FirstInB].Y * Grid.X + Path[FirstInB].X] != Edge.B)
+		{
+			++FirstInB;
+		}
+		int32 LastInA = FirstInB - 1;
+		while (LastInA > 0 && RoomAt[Path[LastInA].Y * Grid.X + Path[LastInA].X] != Edge.A)
+		{
+			--LastInA;
+		}
+		const int32 First = LastInA + 1;
+		const int32 Last = FirstInB - 1;
+		if (Last < First)
+		{
+			continue;   // rooms touch (padding keeps this from happening)
+		}
+
+		FLayoutCorridor& Corridor = OutLayout.Corridors.AddDefaulted_GetRef();
+		Corridor.RoomA = Edge.A;
+		Corridor.RoomB = Edge.B;
+		Corridor.bLoop = Edge.bLoop;
+		Corridor.Points = ToPolyline(Path, First, Last);
+		for (int32 Index = First; Index <= Last; ++Index)
+		{
+			uint8& Used = Router.CorridorAt[Path[Index].Y * Grid.X + Path[Index].X];
+			OutLayout.CorridorCells += Used ? 0 : 1;
+			Used = 1;
+		}
+	}
+	OutLayout.RouteMs = (FPlatformTime::Seconds() - Start) * 1000.0;
+	return true;
+}
@@ -2,14 +2,28 @@
 // LevelPipelineModule.cpp — v0.4.0 Five-Phase Professional Level Generation Pipeline.
 
 #include "LevelPipelineModule.h"
+#include "AgentForgeActorIndex.h"
+#include "AgentForgeAssetCatalog.h"
+#include "AgentForgeJobManager.h"
+#include "AgentForgeInstancedScatter.h"
+#include "AgentForgeProceduralCache.h"
+#include "AgentForgeRuntimeCost.h"
+#include "AgentForgeSpawnBatch.h"
+#include "AgentForgeTrace.h"
+#include "AgentForgeWorldStats.h"
 #include "LevelPresetSystem.h"
+#include "Layout/RoomGraphLayout.h"
 #include "SemanticCommandModule.h"    // PlaceAssetThematically
 
+#include "Async/Async.h"
+
 #include "Dom/JsonObject.h"
 #include "Dom/JsonValue.h"
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonWriter.h"
 #include "Serialization/JsonSerializer.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
 #include "HAL/FileManager.h"
@@ -23,6 +37,7 @@
 #include "Subsystems/EditorActorSubsystem.h"
 #include "Engine/StaticMeshActor.h"
 #include "Components/StaticMeshComponent.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
 #include "Engine/DirectionalLight.h"
 #include "Components/DirectionalLightComponent.h"
 #include "Engine/PointLight.h"
@@ -36,6 +51,8 @@
 #include "Engine/SkyLight.h"
 #include "NavMesh/NavMeshBoundsVolume.h"
 #include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
 #include "UObject/UnrealType.h"
 #include "UnrealClient.h"  // FScreenshotRequest
 #endif
@@ -47,6 +64,7 @@ namespace
 {
 	static FString ToJson(const TSharedPtr<FJsonObject>& Obj)
 	{
+		AGENTFORGE_TRACE_SCOPE("AgentForge.Serialize");
 		FString Out;
 		TSharedRef<TJsonWriter<>> W = TJsonWriterFactory<>::Create(&Out);
 		FJsonSerializer::Serialize(Obj.ToSharedRef(), W);
@@ -69,28 +87,282 @@ namespace
 		return O;
 	}
 
+	static bool IsRoomLabel(const FString& Label)
+	{
+		return Label.StartsWith(TEXT("Blockout_Room_")) || Label.StartsWith(TEXT("Arch_Room_"));
+	}
+
+	// args.rooms: room actor labels a Phase III / IV pass is limited to. Empty: every room.
+	static void ReadRoomFilter(const TSharedPtr<FJsonObject>& Args, TSet<FString>& OutRooms)
+	{
+		const TArray<TSharedPtr<FJsonValue>>* Arr = nullptr;
+		if (Args.IsValid() && Args->TryGetArrayField(TEXT("rooms"), Arr))
+		{
+			for (const TSharedPtr<FJsonValue>& V : *Arr)
+			{
+				FString Label;
+				if (V.IsValid() && V->TryGetString(Label)) { OutRooms.Add(Label); }
+			}
+		}
+	}
+
+	// Copy of Args limited to Rooms (see ReadRoomFilter).
+	static TSharedPtr<FJsonObject> WithRooms(const TSharedPtr<FJsonObject>& Args, const TArray<FString>& Rooms)
+	{
+		TSharedPtr<FJsonObject> Out = Args.IsValid() ? MakeShared<FJsonObject>(*Args) : MakeShared<FJsonObject>();
+		TArray<TSharedPtr<FJsonValue>> Arr;
+		for (const FString& Room : Rooms) { Arr.Add(MakeShared<FJsonValueString>(Room)); }
+		Out->SetArrayField(TEXT("rooms"), Arr);
+		return Out;
+	}
+
 #if WITH_EDITOR
+	static UStaticMesh* LoadCubeMesh()
+	{
+		return Cast<UStaticMesh>(
+			StaticLoadObject(UStaticMesh::StaticClass(), nullptr,
+			                 TEXT("/Engine/BasicShapes/Cube.Cube")));
+	}
+
+	// Deferred StaticMeshActor spawn (see FAgentForgeSpawnBatch).
+	static AStaticMeshActor* SpawnMeshActor(UWorld* World, UStaticMesh* Mesh, const FTransform& Transform,
+	                                        const FString& Label, FName CollisionProfile = NAME_None)
+	{
+		FAgentForgeStaticMeshSpawn Spawn;
+		Spawn.Mesh      = Mesh;
+		Spawn.Transform = Transform;
+		Spawn.Label     = Label;
+		Spawn.CollisionProfile = CollisionProfile;
+		Spawn.Collision = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+		FString Error;
+		return FAgentForgeSpawnBatch::SpawnStaticMeshActor(World, Spawn, Error);
+	}
+
 	// Spawn a unit-cube StaticMeshActor scaled to the given extents.
 	static AActor* SpawnCubeAt(UWorld* World, const FVector& Center,
 	                            const FVector& Scale, const FString& Label)
 	{
-		UStaticMesh* CubeMesh = Cast<UStaticMesh>(
-			StaticLoadObject(UStaticMesh::StaticClass(), nullptr,
-			                 TEXT("/Engine/BasicShapes/Cube.Cube")));
+		return SpawnMeshActor(World, LoadCubeMesh(), FTransform(FRotator::ZeroRotator, Center, Scale), Label);
+	}
+
+	// Blockout rooms spawned per job slice, under one spawn batch.
+	constexpr int32 BlockoutRoomsPerSlice = 8;
 
-		FActorSpawnParameters P;
-		P.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
-		AStaticMeshActor* SMA = World->SpawnActor<AStaticMeshActor>(
-			AStaticMeshActor::StaticClass(), FTransform(FRotator::ZeroRotator, Center), P);
-		if (!SMA) { return nullptr; }
-		if (CubeMesh && SMA->GetStaticMeshComponent())
+	struct FRoomLayoutTask
+	{
+		FRoomLayout Layout;
+		FString     Error;
+		bool        bOk = false;
+		bool        bCacheHit = false;
+	};
+
+	// Job state for create_blockout_level (see MakeCreateBlockoutLevelJob).
+	struct FBlockoutRun
+	{
+		TWeakObjectPtr<UWorld>         World;
+		FString                        Mission    = TEXT("Create a level");
+		FString                        PresetName = TEXT("Default");
+		FLevelPreset                   Preset;
+		FString                        LayoutMode = TEXT("chain");
+		int32                          Seed = 1337;
+		int32                          RoomCount = 3;
+		float                          GridSize  = 400.f;
+		float                          RoomW = 0.f;
+		float                          RoomD = 0.f;
+		float                          RoomH = 0.f;
+		TArray<FVector>                RoomCenters;
+		TArray<FVector2D>              RoomSizes;       // width, depth per room (graph layout)
+		TArray<TArray<FVector>>        CorridorPaths;   // graph layout polylines, world cm
+		TSharedPtr<FJsonObject>        LayoutStats;
+		TFuture<FRoomLayoutTask>       PendingLayout;
+		int32                          NextRoom = 0;
+		int32                          RoomsPlaced = 0;
+		int32                          CorridorsPlaced = 0;
+		double                         TotalAreaSqCm = 0.0;
+		bool                           bPlayerStartPlaced = false;
+		bool                           bNavMeshPlaced = false;
+		TArray<TSharedPtr<FJsonValue>> RoomPosArr;
+		TUniquePtr<FScopedTransaction> Transaction;
+
+		void CancelTransaction()
 		{
-			SMA->GetStaticMeshComponent()->SetStaticMesh(CubeMesh);
+			if (Transaction.IsValid())
+			{
+				Transaction->Cancel();
+				Transaction.Reset();
+			}
+		}
+	};
+
+	// What a quality shortfall depends on, and where (see FindQualityShortfall).
+	struct FQualityShortfall
+	{
+		TArray<FString> Reasons;
+		TArray<FString> DressRooms;   // Phase III reruns on these rooms
+		TArray<FString> LightRooms;   // Phase IV reruns on these rooms
+
+		bool CanRerun() const { return DressRooms.Num() > 0 || LightRooms.Num() > 0; }
+	};
+
+	// Job state for generate_full_quality_level (see MakeGenerateFullQualityLevelJob).
+	struct FFullQualityRun
+	{
+		TWeakObjectPtr<UWorld>     World;
+		TSharedPtr<FJsonObject>    Args;
+		FString                    Mission    = TEXT("Create a level");
+		FString                    PresetName = TEXT("Default");
+		FLevelPreset               Preset;
+		int32                      MaxIter    = 2;
+		float                      QualThresh = 0.75f;
+		TSharedPtr<FJsonObject>    P1Args, P3Args, P4Args, P5Args;
+		TSharedPtr<FJsonObject>    P1Json, P2Json, P3Json, P4Json, P5Json;
+		TSharedPtr<FAgentForgeJob> SubJob;
+		float                      QualScore = 0.f;
+		int32                      Iteration = 0;
+		TMap<FString, int32>       RoomProps;        // room label -> props from every Phase III pass
+		int32                      PropTarget = 1;   // props per room of one Phase III pass
+		FQualityShortfall          Pending;          // what the next iteration reruns
+		FString                    StopReason;
+		TArray<TSharedPtr<FJsonValue>> IterationLog;
+	};
+
+	// Whitebox swaps spawned per job slice, under one spawn batch.
+	constexpr int32 ModularSwapsPerSlice = 32;
+	// Async loading flushed per job slice while kit meshes stream in.
+	constexpr float ModularLoadWaitSeconds = 0.004f;
+
+	struct FModularKitMesh
+	{
+		FSoftObjectPath Path;
+		FVector         Size = FVector::ZeroVector;   // cm, from the ApproxSize tag; zero when unknown
+	};
+
+	struct FModularSwap
+	{
+		int32      Piece = INDEX_NONE;   // index into FModularRun::Pieces
+		int32      Mesh  = INDEX_NONE;   // index into FModularRun::Kit; INDEX_NONE = engine cube
+		FTransform Transform;
+		FVector    Size = FVector::ZeroVector;   // snapped piece size, cm
+		bool       bSizeMatched = false;
+	};
+
+	/** "100x200x50" -> (100, 200, 50); false if the tag is missing or malformed. */
+	static bool ParseApproxSize(const FAssetData& Asset, FVector& OutSize)
+	{
+		FString Text;
+		if (!Asset.GetTagValue(FName(TEXT("ApproxSize")), Text)) { return false; }
+		TArray<FString> Parts;
+		if (Text.ParseIntoArray(Parts, TEXT("x")) != 3) { return false; }
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			if (!Parts[Axis].IsNumeric()) { return false; }
+			OutSize[Axis] = FMath::Max(FCString::Atod(*Parts[Axis]), 1.0);   // flat planes still scale
+		}
+		return true;
+	}
+
+	/**
+	 * Snapped transform and kit mesh for every blockout piece. Pure computation
+	 * (runs on the thread pool): a piece takes the kit mesh, at yaw 0 or 90,
+	 * whose per-axis scale to the snapped size is the most uniform, ties going
+	 * to the mesh closest in size. Kits without size tags cycle their meshes
+	 * at unit-cube scale, as the single-pass conversion did.
+	 */
+	static TArray<FModularSwap> PlanModularSwaps(const TArray<FBox>& Pieces, const TArray<FModularKitMesh>& Kit, float SnapGrid)
+	{
+		const double Grid = SnapGrid;
+		const auto Snap = [Grid](double Value) { return FMath::RoundToDouble(Value / Grid) * Grid; };
+
+		bool bAnySized = false;
+		for (const FModularKitMesh& Mesh : Kit) { bAnySized |= !Mesh.Size.IsZero(); }
+
+		TArray<FModularSwap> Swaps;
+		Swaps.Reserve(Pieces.Num());
+		for (int32 PieceIdx = 0; PieceIdx < Pieces.Num(); ++PieceIdx)
+		{
+			const FVector Center = Pieces[PieceIdx].GetCenter();
+			const FVector Extent = Pieces[PieceIdx].GetExtent();
+			const FVector Size(
+				FMath::Max(Snap(Extent.X * 2.0), Grid),
+				FMath::Max(Snap(Extent.Y * 2.0), Grid),
+				FMath::Max(Snap(Extent.Z * 2.0), Grid));
+			const FVector Origin(Snap(Center.X), Snap(Center.Y), Snap(Center.Z));
+
+			FModularSwap& Swap = Swaps.AddDefaulted_GetRef();
+			Swap.Piece = PieceIdx;
+			Swap.Size  = Size;
+			Swap.Transform = FTransform(FRotator::ZeroRotator, Origin, Size / 100.0);
+			if (Kit.IsEmpty()) { continue; }
+			if (!bAnySized)
+			{
+				Swap.Mesh = PieceIdx % Kit.Num();
+				continue;
+			}
+
+			double BestScore = TNumericLimits<double>::Max();
+			for (int32 MeshIdx = 0; MeshIdx < Kit.Num(); ++MeshIdx)
+			{
+				const FVector& MeshSize = Kit[MeshIdx].Size;
+				if (MeshSize.IsZero()) { continue; }
+				for (int32 Turn = 0; Turn < 2; ++Turn)
+				{
+					// A quarter turn lays the mesh's X along the piece's Y.
+					const FVector Local = Turn == 0 ? Size : FVector(Size.Y, Size.X, Size.Z);
+					const FVector LogScale(
+						FMath::Loge(Local.X / MeshSize.X),
+						FMath::Loge(Local.Y / MeshSize.Y),
+						FMath::Loge(Local.Z / MeshSize.Z));
+					const double Mean = (LogScale.X + LogScale.Y + LogScale.Z) / 3.0;
+					const double Distortion = FMath::Square(LogScale.X - Mean) + FMath::Square(LogScale.Y - Mean) + FMath::Square(LogScale.Z - Mean);
+					const double Score = Distortion + 0.01 * Mean * Mean;
+					if (Score < BestScore)
+					{
+						BestScore = Score;
+						Swap.Mesh = MeshIdx;
+						Swap.bSizeMatched = true;
+						Swap.Transform = FTransform(FRotator(0.0, Turn == 0 ? 0.0 : 90.0, 0.0), Origin, Local / MeshSize);
+					}
+				}
+			}
 		}
-		SMA->SetActorScale3D(Scale);
-		SMA->SetActorLabel(Label);
-		return SMA;
+		return Swaps;
 	}
+
+	// Job state for convert_to_whitebox_modular (see MakeConvertToWhiteboxModularJob).
+	struct FModularRun
+	{
+		TWeakObjectPtr<UWorld>          World;
+		FString                         KitPath = TEXT("/Game/");
+		float                           SnapGrid = 50.f;
+		TArray<TWeakObjectPtr<AActor>>  BlockoutActors;
+		TArray<FBox>                    Pieces;
+		TArray<FModularKitMesh>         Kit;
+		TFuture<TArray<FModularSwap>>   PendingPlan;
+		TArray<FModularSwap>            Swaps;
+		TSharedPtr<FStreamableHandle>   LoadHandle;
+		TArray<UStaticMesh*>            Meshes;          // by kit index after the load; null falls back to the cube
+		UStaticMesh*                    CubeMesh = nullptr;
+		int32                           MeshesRequested = 0;
+		int32                           MeshesLoaded = 0;
+		int32                           NextSwap = 0;
+		int32                           PiecesPlaced = 0;
+		int32                           SizeMatched = 0;
+		int32                           CubeFallbacks = 0;
+		double                          StageStartSeconds = 0.0;
+		double                          PlanMs = 0.0;
+		double                          LoadMs = 0.0;
+		double                          SwapMs = 0.0;
+		TUniquePtr<FScopedTransaction>  Transaction;
+
+		void CancelTransaction()
+		{
+			if (Transaction.IsValid())
+			{
+				Transaction->Cancel();
+				Transaction.Reset();
+			}
+		}
+	};
 #endif
 }
 
@@ -127,11 +399,8 @@ bool FLevelPipelineModule::PlaceBlockoutRoom(UWorld* World, const FVector& Cente
 #if WITH_EDITOR
 	// UE unit cube is 100x100x100 cm — scale accordingly.
 	const FVector Scale(Width / 100.f, Depth / 100.f, Height / 100.f);
-	AActor* A = SpawnCubeAt(World, Center, Scale, Label);
-	if (!A) { return false; }
-	// Raise so the floor sits at Z=0.
-	A->SetActorLocation(Center + FVector(0.f, 0.f, Height * 0.5f));
-	return true;
+	// Raised so the floor sits at Z=0.
+	return SpawnCubeAt(World, Center + FVector(0.f, 0.f, Height * 0.5f), Scale, Label) != nullptr;
 #else
 	return false;
 #endif
@@ -146,6 +415,8 @@ void FLevelPipelineModule::ConnectRoomsWithCorridors(UWorld* World,
                                                       float CeilingHeight)
 {
 #if WITH_EDITOR
+	FAgentForgeSpawnBatch SpawnBatch(World);
+	UStaticMesh* CubeMesh = LoadCubeMesh();
 	for (int32 i = 0; i < RoomCenters.Num() - 1; ++i)
 	{
 		const FVector A   = RoomCenters[i];
@@ -158,24 +429,49 @@ void FLevelPipelineModule::ConnectRoomsWithCorridors(UWorld* World,
 		const float Yaw     = FMath::Atan2(Dir2D.Y, Dir2D.X) * (180.f / PI);
 		const FVector Scale(Len / 100.f, CorridorWidth / 100.f, CeilingHeight / 100.f);
 
-		UStaticMesh* CubeMesh = Cast<UStaticMesh>(
-			StaticLoadObject(UStaticMesh::StaticClass(), nullptr,
-			                 TEXT("/Engine/BasicShapes/Cube.Cube")));
+		const FTransform T(FRotator(0.f, Yaw, 0.f), Mid + FVector(0.f, 0.f, CeilingHeight * 0.5f), Scale);
+		SpawnMeshActor(World, CubeMesh, T, FString::Printf(TEXT("Blockout_Corridor_%02d"), i + 1));
+	}
+#endif
+}
 
-		FActorSpawnParameters P;
-		P.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
-		FTransform T(FRotator(0.f, Yaw, 0.f), Mid + FVector(0.f, 0.f, CeilingHeight * 0.5f));
-		AStaticMeshActor* SMA = World->SpawnActor<AStaticMeshActor>(
-			AStaticMeshActor::StaticClass(), T, P);
-		if (SMA)
+// ─────────────────────────────────────────────────────────────────────────────
+//  Phase I — PlaceLayoutCorridors (graph layout)
+// ─────────────────────────────────────────────────────────────────────────────
+int32 FLevelPipelineModule::PlaceLayoutCorridors(UWorld* World,
+                                                 const TArray<TArray<FVector>>& Paths,
+                                                 float CorridorWidth,
+                                                 float CeilingHeight)
+{
+	int32 Placed = 0;
+#if WITH_EDITOR
+	FAgentForgeSpawnBatch SpawnBatch(World);
+	UStaticMesh* CubeMesh = LoadCubeMesh();
+	for (int32 PathIdx = 0; PathIdx < Paths.Num(); ++PathIdx)
+	{
+		const TArray<FVector>& Path = Paths[PathIdx];
+		int32 Segments = 0;
+		for (int32 i = 0; i + 1 < Path.Num(); ++i)
 		{
-			if (CubeMesh && SMA->GetStaticMeshComponent())
-				SMA->GetStaticMeshComponent()->SetStaticMesh(CubeMesh);
-			SMA->SetActorScale3D(Scale);
-			SMA->SetActorLabel(FString::Printf(TEXT("Blockout_Corridor_%02d"), i + 1));
+			const FVector A = Path[i];
+			const FVector B = Path[i + 1];
+			const float Len = FVector::Dist2D(A, B);
+			if (Len <= KINDA_SMALL_NUMBER) { continue; }
+
+			// Axis-aligned run; one corridor width longer so consecutive runs overlap at bends.
+			const FVector Dir2D = (B - A).GetSafeNormal2D();
+			const float Yaw     = FMath::Atan2(Dir2D.Y, Dir2D.X) * (180.f / PI);
+			const FVector Scale((Len + CorridorWidth) / 100.f, CorridorWidth / 100.f, CeilingHeight / 100.f);
+			const FTransform T(FRotator(0.f, Yaw, 0.f), (A + B) * 0.5f + FVector(0.f, 0.f, CeilingHeight * 0.5f), Scale);
+			if (SpawnMeshActor(World, CubeMesh, T, FString::Printf(TEXT("Blockout_Corridor_%02d_%02d"), PathIdx + 1, Segments + 1)))
+			{
+				++Segments;
+			}
 		}
+		Placed += Segments > 0 ? 1 : 0;
 	}
 #endif
+	return Placed;
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
@@ -183,156 +479,321 @@ void FLevelPipelineModule::ConnectRoomsWithCorridors(UWorld* World,
 // ─────────────────────────────────────────────────────────────────────────────
 FString FLevelPipelineModule::CreateBlockoutLevel(const TSharedPtr<FJsonObject>& Args)
 {
-#if WITH_EDITOR
-	if (!GEditor)
-	{
-		return ToJson(ErrObj(TEXT("GEditor not available.")));
-	}
-	UWorld* World = GEditor->GetEditorWorldContext().World();
-	if (!World)
-	{
-		return ToJson(ErrObj(TEXT("No editor world.")));
-	}
+	return MakeCreateBlockoutLevelJob(Args)->RunToCompletion();
+}
 
-	// ── Parse arguments ──────────────────────────────────────────────────────
-	FString Mission  = TEXT("Create a level");
-	FString PresetNm = TEXT("Default");
-	double  RoomCountD = 3.0;
-	double  GridSizeD  = 400.0;
+TSharedRef<FAgentForgeJob> FLevelPipelineModule::MakeCreateBlockoutLevelJob(const TSharedPtr<FJsonObject>& Args)
+{
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Pipeline.MakeCreateBlockoutLevelJob");
+	TSharedRef<FAgentForgeJob> Job = MakeShared<FAgentForgeJob>(TEXT("create_blockout_level"));
+#if WITH_EDITOR
+	TSharedRef<FBlockoutRun> Run = MakeShared<FBlockoutRun>();
 
-	if (Args.IsValid())
+	// ── Stage: layout — parse arguments, open the transaction, plan rooms ────
+	Job->AddStage(TEXT("layout"), [Run, Args](FAgentForgeJob& J)
 	{
-		Args->TryGetStringField(TEXT("mission"),    Mission);
-		Args->TryGetStringField(TEXT("preset"),     PresetNm);
-		Args->TryGetNumberField(TEXT("room_count"), RoomCountD);
-		Args->TryGetNumberField(TEXT("grid_size"),  GridSizeD);
-	}
+		if (!GEditor)
+		{
+			J.Finish(ToJson(ErrObj(TEXT("GEditor not available."))));
+			return true;
+		}
+		UWorld* World = GEditor->GetEditorWorldContext().World();
+		if (!World)
+		{
+			J.Finish(ToJson(ErrObj(TEXT("No editor world."))));
+			return true;
+		}
+		Run->World = World;
 
-	if (!FLevelPresetSystem::LoadedPresets.Contains(PresetNm))
-		FLevelPresetSystem::RegisterBuiltinPresets();
+		double RoomCountD = 3.0;
+		double GridSizeD  = 400.0;
+		if (Args.IsValid())
+		{
+			Args->TryGetStringField(TEXT("mission"),    Run->Mission);
+			Args->TryGetStringField(TEXT("preset"),     Run->PresetName);
+			Args->TryGetNumberField(TEXT("room_count"), RoomCountD);
+			Args->TryGetNumberField(TEXT("grid_size"),  GridSizeD);
+			Args->TryGetStringField(TEXT("layout"),     Run->LayoutMode);
+			Args->TryGetNumberField(TEXT("seed"),       Run->Seed);
+		}
+		Run->LayoutMode.ToLowerInline();
+		const bool bGraph = Run->LayoutMode == TEXT("graph");
+		if (!bGraph && Run->LayoutMode != TEXT("chain"))
+		{
+			J.Finish(ToJson(ErrObj(FString::Printf(TEXT("Unknown layout '%s' (expected chain or graph)."), *Run->LayoutMode))));
+			return true;
+		}
 
-	FLevelPresetSystem::SetCurrentPreset(PresetNm);
-	const FLevelPreset& Preset = FLevelPresetSystem::GetCurrentPresetData();
+		FLevelPresetSystem::SetCurrentPreset(Run->PresetName);
+		Run->Preset = FLevelPresetSystem::GetCurrentPresetData();
 
-	const int32 RoomCount = FMath::Clamp(static_cast<int32>(RoomCountD), 1, 20);
-	const float GridSize  = FMath::Clamp(static_cast<float>(GridSizeD), 100.f, 5000.f);
+		Run->RoomCount = FMath::Clamp(static_cast<int32>(RoomCountD), 1, bGraph ? 500 : 20);
+		Run->GridSize  = FMath::Clamp(static_cast<float>(GridSizeD), 100.f, 5000.f);
+		Run->RoomW = Run->GridSize * 2.5f;
+		Run->RoomD = Run->GridSize * 2.0f;
+		Run->RoomH = Run->Preset.StandardCeilingHeightCm;
 
-	FScopedTransaction Transaction(NSLOCTEXT("UEAgentForge", "CreateBlockout", "AgentForge: Create Blockout Level"));
+		Run->Transaction = MakeUnique<FScopedTransaction>(NSLOCTEXT("UEAgentForge", "CreateBlockout", "AgentForge: Create Blockout Level"));
 
-	// ── Generate room positions ───────────────────────────────────────────────
-	TArray<FVector> RoomCenters = GenerateRoomLayout(RoomCount, GridSize, Preset);
+		if (!bGraph)
+		{
+			Run->RoomCenters = GenerateRoomLayout(Run->RoomCount, Run->GridSize, Run->Preset);
+			return true;
+		}
 
-	const float RoomW = GridSize * 2.5f;
-	const float RoomD = GridSize * 2.0f;
-	const float RoomH = Preset.StandardCeilingHeightCm;
+		// Graph layouts are planned on the thread pool; the next stage waits for them.
+		// A layout already in the procedural cache (an earlier run, or a farm
+		// worker) is deserialized instead.
+		FRoomLayoutSettings Settings;
+		Settings.RoomCount = Run->RoomCount;
+		Settings.Seed      = Run->Seed;
+		Settings.CellSize  = Run->GridSize;
+		Run->PendingLayout = Async(EAsyncExecution::ThreadPool, [Settings]()
+		{
+			FRoomLayoutTask Task;
+			FAgentForgeProceduralCache& Cache = FAgentForgeProceduralCache::Get();
+			const FString Key = FRoomGraphLayout::MakeCacheKey(Settings);
+			if (const FAgentForgeProceduralCache::FPayload Payload = Cache.Find(FRoomGraphLayout::CacheKind, Key, EProceduralCacheMode::Memory))
+			{
+				FMemoryReader Reader(*Payload);
+				FRoomGraphLayout::Serialize(Reader, Task.Layout);
+				if (!Reader.IsError())
+				{
+					Task.bOk = true;
+					Task.bCacheHit = true;
+					return Task;
+				}
+				Task.Layout = FRoomLayout();
+			}
+			Task.bOk = FRoomGraphLayout::Generate(Settings, Task.Layout, Task.Error);
+			if (Task.bOk)
+			{
+				TArray<uint8> Bytes;
+				FMemoryWriter Writer(Bytes);
+				FRoomGraphLayout::Serialize(Writer, Task.Layout);
+				Cache.Store(FRoomGraphLayout::CacheKind, Key, MoveTemp(Bytes), EProceduralCacheMode::Memory);
+			}
+			return Task;
+		});
+		return true;
+	}, 0.5f);
 
-	int32 RoomsPlaced    = 0;
-	int32 CorridorsPlaced = 0;
+	// ── Stage: plan — collect the background graph layout (chain layouts skip) ──
+	Job->AddStage(TEXT("plan"), [Run](FAgentForgeJob& J)
+	{
+		if (!Run->PendingLayout.IsValid())
+		{
+			return true;
+		}
+		if (!Run->PendingLayout.IsReady())
+		{
+			J.YieldSlice();
+			return false;
+		}
 
-	TArray<TSharedPtr<FJsonValue>> RoomPosArr;
+		const FRoomLayoutTask Task = Run->PendingLayout.Get();
+		Run->PendingLayout.Reset();
+		if (!Task.bOk)
+		{
+			Run->CancelTransaction();
+			J.Finish(ToJson(ErrObj(Task.Error)));
+			return true;
+		}
 
-	for (int32 i = 0; i < RoomCenters.Num(); ++i)
+		const FRoomLayout& Layout = Task.Layout;
+		for (int32 Room = 0; Room < Layout.Rooms.Num(); ++Room)
+		{
+			Run->RoomCenters.Add(Layout.RoomCenter(Room));
+			Run->RoomSizes.Add(Layout.RoomSize(Room));
+		}
+		for (const FLayoutCorridor& Corridor : Layout.Corridors)
+		{
+			TArray<FVector>& Path = Run->CorridorPaths.AddDefaulted_GetRef();
+			for (const FVector2D& Point : Corridor.Points)
+			{
+				Path.Add(Layout.ToWorld(Point));
+			}
+		}
+		Run->LayoutStats = Layout.GetStatsJson();
+		Run->LayoutStats->SetStringField(TEXT("cache"), Task.bCacheHit ? TEXT("memory") : TEXT("miss"));
+		J.AddPartialResult(Run->LayoutStats);
+		return true;
+	}, 0.5f);
+
+	// ── Stage: rooms — BlockoutRoomsPerSlice blockout rooms per slice ────────
+	Job->AddStage(TEXT("rooms"), [Run](FAgentForgeJob& J)
 	{
-		const FString RoleLabel = (i == 0)                    ? TEXT("Entry")
-		                        : (i == RoomCenters.Num() - 1) ? TEXT("Exit")
-		                        : (i == RoomCenters.Num() - 2  && RoomCenters.Num() > 2) ? TEXT("Climax")
-		                        : TEXT("Exploration");
-		const FString Label = FString::Printf(TEXT("Blockout_Room_%02d_%s"), i + 1, *RoleLabel);
-		if (PlaceBlockoutRoom(World, RoomCenters[i], RoomW, RoomD, RoomH, Label))
+		UWorld* World = Run->World.Get();
+		if (!World)
 		{
-			++RoomsPlaced;
-			TSharedPtr<FJsonObject> RoomJ = MakeShared<FJsonObject>();
-			RoomJ->SetStringField(TEXT("label"), Label);
-			RoomJ->SetNumberField(TEXT("x"),     RoomCenters[i].X);
-			RoomJ->SetNumberField(TEXT("y"),     RoomCenters[i].Y);
-			RoomJ->SetNumberField(TEXT("z"),     RoomCenters[i].Z);
-			RoomJ->SetNumberField(TEXT("width"),  RoomW);
-			RoomJ->SetNumberField(TEXT("depth"),  RoomD);
-			RoomJ->SetNumberField(TEXT("height"), RoomH);
-			RoomJ->SetStringField(TEXT("role"),  RoleLabel);
-			RoomPosArr.Add(MakeShared<FJsonValueObject>(RoomJ));
+			Run->CancelTransaction();
+			J.Finish(ToJson(ErrObj(TEXT("Editor world changed while create_blockout_level was running."))));
+			return true;
+		}
+		if (!Run->RoomCenters.IsValidIndex(Run->NextRoom))
+		{
+			return true;
+		}
+
+		const TArray<FVector>& RoomCenters = Run->RoomCenters;
+		FAgentForgeSpawnBatch SpawnBatch(World);
+		const int32 SliceEnd = FMath::Min(Run->NextRoom + BlockoutRoomsPerSlice, RoomCenters.Num());
+		while (Run->NextRoom < SliceEnd)
+		{
+			const int32 i = Run->NextRoom++;
+			const FString RoleLabel = (i == 0)                    ? TEXT("Entry")
+			                        : (i == RoomCenters.Num() - 1) ? TEXT("Exit")
+			                        : (i == RoomCenters.Num() - 2  && RoomCenters.Num() > 2) ? TEXT("Climax")
+			                        : TEXT("Exploration");
+			const FString Label = FString::Printf(TEXT("Blockout_Room_%02d_%s"), i + 1, *RoleLabel);
+			const float RoomW = Run->RoomSizes.IsValidIndex(i) ? static_cast<float>(Run->RoomSizes[i].X) : Run->RoomW;
+			const float RoomD = Run->RoomSizes.IsValidIndex(i) ? static_cast<float>(Run->RoomSizes[i].Y) : Run->RoomD;
+			if (PlaceBlockoutRoom(World, RoomCenters[i], RoomW, RoomD, Run->RoomH, Label))
+			{
+				++Run->RoomsPlaced;
+				Run->TotalAreaSqCm += RoomW * RoomD;
+				TSharedPtr<FJsonObject> RoomJ = MakeShared<FJsonObject>();
+				RoomJ->SetStringField(TEXT("label"), Label);
+				RoomJ->SetNumberField(TEXT("x"),     RoomCenters[i].X);
+				RoomJ->SetNumberField(TEXT("y"),     RoomCenters[i].Y);
+				RoomJ->SetNumberField(TEXT("z"),     RoomCenters[i].Z);
+				RoomJ->SetNumberField(TEXT("width"),  RoomW);
+				RoomJ->SetNumberField(TEXT("depth"),  RoomD);
+				RoomJ->SetNumberField(TEXT("height"), Run->RoomH);
+				RoomJ->SetStringField(TEXT("role"),  RoleLabel);
+				Run->RoomPosArr.Add(MakeShared<FJsonValueObject>(RoomJ));
+				J.AddPartialResult(RoomJ);
+			}
 		}
-	}
 
-	// ── Corridors ─────────────────────────────────────────────────────────────
-	ConnectRoomsWithCorridors(World, RoomCenters, Preset.MinCorridorWidthCm, RoomH);
-	CorridorsPlaced = FMath::Max(0, RoomCenters.Num() - 1);
+		J.SetStageProgress(static_cast<float>(Run->NextRoom) / static_cast<float>(RoomCenters.Num()));
+		return Run->NextRoom >= RoomCenters.Num();
+	}, 3.0f);
 
-	// ── PlayerStart at entry room ─────────────────────────────────────────────
-	bool bPlayerStartPlaced = false;
-	if (!RoomCenters.IsEmpty())
+	// ── Stage: corridors ─────────────────────────────────────────────────────
+	Job->AddStage(TEXT("corridors"), [Run](FAgentForgeJob& J)
 	{
-		const FVector PSLoc = RoomCenters[0] + FVector(0.f, 0.f, Preset.PlayerEyeHeightCm);
-		FActorSpawnParameters PSP;
-		PSP.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
-		AActor* PS = World->SpawnActor<APlayerStart>(APlayerStart::StaticClass(),
-			FTransform(FRotator::ZeroRotator, PSLoc), PSP);
-		if (PS) { PS->SetActorLabel(TEXT("PlayerStart")); bPlayerStartPlaced = true; }
-	}
+		UWorld* World = Run->World.Get();
+		if (!World)
+		{
+			Run->CancelTransaction();
+			J.Finish(ToJson(ErrObj(TEXT("Editor world changed while create_blockout_level was running."))));
+			return true;
+		}
+		if (Run->LayoutStats.IsValid())
+		{
+			Run->CorridorsPlaced = PlaceLayoutCorridors(World, Run->CorridorPaths, Run->Preset.MinCorridorWidthCm, Run->RoomH);
+			return true;
+		}
+		ConnectRoomsWithCorridors(World, Run->RoomCenters, Run->Preset.MinCorridorWidthCm, Run->RoomH);
+		Run->CorridorsPlaced = FMath::Max(0, Run->RoomCenters.Num() - 1);
+		return true;
+	}, 1.0f);
 
-	// ── NavMeshBoundsVolume covering the whole blockout ───────────────────────
-	bool bNavMeshPlaced = false;
-	if (!RoomCenters.IsEmpty())
+	// ── Stage: navigation — PlayerStart + NavMeshBoundsVolume ────────────────
+	Job->AddStage(TEXT("navigation"), [Run](FAgentForgeJob& J)
 	{
-		FVector BoundsCenter = FVector::ZeroVector;
-		for (const FVector& C : RoomCenters) { BoundsCenter += C; }
-		BoundsCenter /= static_cast<float>(RoomCenters.Num());
+		UWorld* World = Run->World.Get();
+		if (!World)
+		{
+			Run->CancelTransaction();
+			J.Finish(ToJson(ErrObj(TEXT("Editor world changed while create_blockout_level was running."))));
+			return true;
+		}
+		const TArray<FVector>& RoomCenters = Run->RoomCenters;
 
-		const float NavExtent = GridSize * static_cast<float>(RoomCount) * 1.5f;
-		FActorSpawnParameters NavP;
-		NavP.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
-		ANavMeshBoundsVolume* Nav = World->SpawnActor<ANavMeshBoundsVolume>(
-			ANavMeshBoundsVolume::StaticClass(),
-			FTransform(FRotator::ZeroRotator, BoundsCenter + FVector(0.f, 0.f, RoomH * 0.5f)), NavP);
-		if (Nav)
+		// PlayerStart at entry room.
+		if (!RoomCenters.IsEmpty())
 		{
-			Nav->SetActorScale3D(FVector(NavExtent / 100.f, NavExtent / 100.f, RoomH / 50.f));
-			Nav->SetActorLabel(TEXT("NavMeshBoundsVolume_Pipeline"));
-			bNavMeshPlaced = true;
+			const FVector PSLoc = RoomCenters[0] + FVector(0.f, 0.f, Run->Preset.PlayerEyeHeightCm);
+			FActorSpawnParameters PSP;
+			PSP.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+			AActor* PS = World->SpawnActor<APlayerStart>(APlayerStart::StaticClass(),
+				FTransform(FRotator::ZeroRotator, PSLoc), PSP);
+			if (PS) { PS->SetActorLabel(TEXT("PlayerStart")); Run->bPlayerStartPlaced = true; }
 		}
-	}
 
-	// ── Total area ────────────────────────────────────────────────────────────
-	const float TotalAreaSqM = (RoomW * RoomD * static_cast<float>(RoomsPlaced)) / (100.f * 100.f);
+		// NavMeshBoundsVolume covering the whole blockout.
+		if (!RoomCenters.IsEmpty())
+		{
+			FVector BoundsCenter = FVector::ZeroVector;
+			for (const FVector& C : RoomCenters) { BoundsCenter += C; }
+			BoundsCenter /= static_cast<float>(RoomCenters.Num());
 
-	// ── Build response ────────────────────────────────────────────────────────
-	TSharedPtr<FJsonObject> Resp = MakeShared<FJsonObject>();
-	Resp->SetBoolField  (TEXT("ok"),                  true);
-	Resp->SetStringField(TEXT("mission"),             Mission);
-	Resp->SetStringField(TEXT("preset"),              PresetNm);
-	Resp->SetNumberField(TEXT("rooms_placed"),        static_cast<double>(RoomsPlaced));
-	Resp->SetNumberField(TEXT("corridors_placed"),    static_cast<double>(CorridorsPlaced));
-	Resp->SetNumberField(TEXT("total_area_sqm"),      TotalAreaSqM);
-	Resp->SetArrayField (TEXT("room_positions"),      RoomPosArr);
-	Resp->SetBoolField  (TEXT("navmesh_placed"),      bNavMeshPlaced);
-	Resp->SetBoolField  (TEXT("player_start_placed"), bPlayerStartPlaced);
-	Resp->SetNumberField(TEXT("grid_size"),           GridSize);
-	return ToJson(Resp);
+			float NavExtent = Run->GridSize * static_cast<float>(Run->RoomCount) * 1.5f;
+			if (Run->LayoutStats.IsValid())
+			{
+				// Graph layouts are roughly square: cover their bounds instead of a chain length.
+				FBox Bounds(ForceInit);
+				for (int32 Room = 0; Room < RoomCenters.Num(); ++Room)
+				{
+					const FVector Half(Run->RoomSizes[Room] * 0.5, 0.0);
+					Bounds += RoomCenters[Room] - Half;
+					Bounds += RoomCenters[Room] + Half;
+				}
+				BoundsCenter = Bounds.GetCenter();
+				NavExtent = static_cast<float>(Bounds.GetSize().GetMax()) + Run->GridSize * 2.f;
+			}
+			FActorSpawnParameters NavP;
+			NavP.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+			ANavMeshBoundsVolume* Nav = World->SpawnActor<ANavMeshBoundsVolume>(
+				ANavMeshBoundsVolume::StaticClass(),
+				FTransform(FRotator::ZeroRotator, BoundsCenter + FVector(0.f, 0.f, Run->RoomH * 0.5f)), NavP);
+			if (Nav)
+			{
+				Nav->SetActorScale3D(FVector(NavExtent / 100.f, NavExtent / 100.f, Run->RoomH / 50.f));
+				Nav->SetActorLabel(TEXT("NavMeshBoundsVolume_Pipeline"));
+				Run->bNavMeshPlaced = true;
+			}
+		}
+		return true;
+	}, 0.5f);
+
+	// ── Finalize — close the transaction and build the response ──────────────
+	Job->SetFinalizer([Run](FAgentForgeJob&)
+	{
+		Run->Transaction.Reset();
+
+		const float TotalAreaSqM = static_cast<float>(Run->TotalAreaSqCm / (100.0 * 100.0));
+
+		TSharedPtr<FJsonObject> Resp = MakeShared<FJsonObject>();
+		Resp->SetBoolField  (TEXT("ok"),                  true);
+		Resp->SetStringField(TEXT("mission"),             Run->Mission);
+		Resp->SetStringField(TEXT("preset"),              Run->PresetName);
+		Resp->SetNumberField(TEXT("rooms_placed"),        static_cast<double>(Run->RoomsPlaced));
+		Resp->SetNumberField(TEXT("corridors_placed"),    static_cast<double>(Run->CorridorsPlaced));
+		Resp->SetNumberField(TEXT("total_area_sqm"),      TotalAreaSqM);
+		Resp->SetArrayField (TEXT("room_positions"),      Run->RoomPosArr);
+		Resp->SetBoolField  (TEXT("navmesh_placed"),      Run->bNavMeshPlaced);
+		Resp->SetBoolField  (TEXT("player_start_placed"), Run->bPlayerStartPlaced);
+		Resp->SetNumberField(TEXT("grid_size"),           Run->GridSize);
+		Resp->SetStringField(TEXT("layout"),              Run->LayoutMode);
+		if (Run->LayoutStats.IsValid())
+		{
+			Resp->SetObjectField(TEXT("layout_stats"),    Run->LayoutStats);
+		}
+		return ToJson(Resp);
+	});
+	Job->SetCancelHandler([Run](FAgentForgeJob&) { Run->CancelTransaction(); });
 #else
-	return ToJson(ErrObj(TEXT("WITH_EDITOR required.")));
+	Job->AddStage(TEXT("layout"), [](FAgentForgeJob& J) { J.Finish(ToJson(ErrObj(TEXT("WITH_EDITOR required.")))); return true; });
 #endif
+	return Job;
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
 //  Phase II — FindModularKitMeshes
 // ─────────────────────────────────────────────────────────────────────────────
-TArray<FString> FLevelPipelineModule::FindModularKitMeshes(const FString& KitPath)
+TArray<FAssetData> FLevelPipelineModule::FindModularKitMeshes(const FString& KitPath)
 {
-	TArray<FString> Results;
-#if WITH_EDITOR
-	FAssetRegistryModule& ARM = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
 	TArray<FAssetData> Assets;
-	FARFilter Filter;
-	Filter.PackagePaths.Add(*KitPath);
-	Filter.bRecursivePaths = true;
-	Filter.ClassPaths.Add(UStaticMesh::StaticClass()->GetClassPathName());
-	ARM.Get().GetAssets(Filter, Assets);
-	for (const FAssetData& AD : Assets)
-	{
-		Results.Add(AD.GetObjectPathString());
-	}
+#if WITH_EDITOR
+	FAgentForgeAssetQuery Query;
+	Query.PackagePath = KitPath;
+	Query.MaxResults = 0;
+	FAgentForgeAssetCatalog::Get().Query(EAgentForgeAssetKind::StaticMesh, Query, Assets);
 #endif
-	return Results;
+	return Assets;
 }
 
 float FLevelPipelineModule::SnapToGrid(float Value, float GridSize)
@@ -341,123 +802,230 @@ float FLevelPipelineModule::SnapToGrid(float Value, float GridSize)
 	return FMath::RoundToFloat(Value / GridSize) * GridSize;
 }
 
-int32 FLevelPipelineModule::ReplaceBlockoutWithModular(UWorld* World,
-                                                        const FString& KitPath,
-                                                        float SnapGrid)
+// ─────────────────────────────────────────────────────────────────────────────
+//  Phase II — ConvertToWhiteboxModular
+// ─────────────────────────────────────────────────────────────────────────────
+FString FLevelPipelineModule::ConvertToWhiteboxModular(const TSharedPtr<FJsonObject>& Args)
 {
-#if WITH_EDITOR
-	TArray<FString> Meshes = FindModularKitMeshes(KitPath);
-	int32 PiecesPlaced = 0;
+	return MakeConvertToWhiteboxModularJob(Args)->RunToCompletion();
+}
 
-	// Collect all Blockout_Room_* actors.
-	TArray<AActor*> BlockoutActors;
-	for (TActorIterator<AActor> It(World); It; ++It)
+TSharedRef<FAgentForgeJob> FLevelPipelineModule::MakeConvertToWhiteboxModularJob(const TSharedPtr<FJsonObject>& Args)
+{
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Pipeline.MakeConvertToWhiteboxModularJob");
+	TSharedRef<FAgentForgeJob> Job = MakeShared<FAgentForgeJob>(TEXT("convert_to_whitebox_modular"));
+#if WITH_EDITOR
+	TSharedRef<FModularRun> Run = MakeShared<FModularRun>();
+	auto WorldLost = [Run](FAgentForgeJob& J)
 	{
-		AActor* A = *It;
-		if (IsValid(A) && A->GetActorLabel().StartsWith(TEXT("Blockout_Room_")))
-			BlockoutActors.Add(A);
-	}
+		Run->CancelTransaction();
+		J.Finish(ToJson(ErrObj(TEXT("Editor world changed while convert_to_whitebox_modular was running."))));
+		return true;
+	};
 
-	for (int32 RoomIdx = 0; RoomIdx < BlockoutActors.Num(); ++RoomIdx)
+	// ── Stage: collect — blockout bounds and kit sizes, then plan off-thread ─
+	Job->AddStage(TEXT("collect"), [Run, Args](FAgentForgeJob& J)
 	{
-		AActor* BlkActor = BlockoutActors[RoomIdx];
-		FVector Origin, Extent;
-		BlkActor->GetActorBounds(false, Origin, Extent);
+		if (!GEditor)
+		{
+			J.Finish(ToJson(ErrObj(TEXT("GEditor not available."))));
+			return true;
+		}
+		UWorld* World = GEditor->GetEditorWorldContext().World();
+		if (!World)
+		{
+			J.Finish(ToJson(ErrObj(TEXT("No editor world."))));
+			return true;
+		}
+		Run->World = World;
 
-		// Snap dimensions.
-		const float SnapW = SnapToGrid(Extent.X * 2.f, SnapGrid);
-		const float SnapD = SnapToGrid(Extent.Y * 2.f, SnapGrid);
-		const float SnapH = SnapToGrid(Extent.Z * 2.f, SnapGrid);
-		const FVector SnapOrigin(
-			SnapToGrid(Origin.X, SnapGrid),
-			SnapToGrid(Origin.Y, SnapGrid),
-			SnapToGrid(Origin.Z, SnapGrid));
+		double SnapGridD = 50.0;
+		if (Args.IsValid())
+		{
+			Args->TryGetStringField(TEXT("kit_path"),  Run->KitPath);
+			Args->TryGetNumberField(TEXT("snap_grid"), SnapGridD);
+		}
+		Run->SnapGrid = FMath::Clamp(static_cast<float>(SnapGridD), 1.f, 2000.f);
 
-		// Load a mesh from the kit (cycle through available meshes).
-		UStaticMesh* Mesh = nullptr;
-		if (!Meshes.IsEmpty())
+		for (TActorIterator<AActor> It(World); It; ++It)
 		{
-			const FString& MeshPath = Meshes[RoomIdx % Meshes.Num()];
-			Mesh = Cast<UStaticMesh>(StaticLoadObject(UStaticMesh::StaticClass(), nullptr, *MeshPath));
+			AActor* A = *It;
+			if (IsValid(A) && A->GetActorLabel().StartsWith(TEXT("Blockout_Room_")))
+			{
+				FVector Origin, Extent;
+				A->GetActorBounds(false, Origin, Extent);
+				Run->BlockoutActors.Add(A);
+				Run->Pieces.Add(FBox(Origin - Extent, Origin + Extent));
+			}
 		}
-		// Fallback to engine cube.
-		if (!Mesh)
+		for (const FAssetData& Asset : FindModularKitMeshes(Run->KitPath))
 		{
-			Mesh = Cast<UStaticMesh>(StaticLoadObject(UStaticMesh::StaticClass(), nullptr,
-			                                           TEXT("/Engine/BasicShapes/Cube.Cube")));
+			FModularKitMesh& Mesh = Run->Kit.AddDefaulted_GetRef();
+			Mesh.Path = Asset.GetSoftObjectPath();
+			ParseApproxSize(Asset, Mesh.Size);
 		}
 
-		FActorSpawnParameters SP;
-		SP.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
-		AStaticMeshActor* SMA = World->SpawnActor<AStaticMeshActor>(
-			AStaticMeshActor::StaticClass(),
-			FTransform(FRotator::ZeroRotator, SnapOrigin), SP);
-		if (SMA)
+		Run->Transaction = MakeUnique<FScopedTransaction>(NSLOCTEXT("UEAgentForge", "WhiteboxModular", "AgentForge: Whitebox Modular Pass"));
+		Run->StageStartSeconds = FPlatformTime::Seconds();
+		Run->PendingPlan = Async(EAsyncExecution::ThreadPool,
+			[Pieces = Run->Pieces, Kit = Run->Kit, SnapGrid = Run->SnapGrid]()
+			{
+				return PlanModularSwaps(Pieces, Kit, SnapGrid);
+			});
+		return true;
+	}, 0.5f);
+
+	// ── Stage: plan — collect the assignments, request every distinct mesh ───
+	Job->AddStage(TEXT("plan"), [Run](FAgentForgeJob& J)
+	{
+		if (!Run->PendingPlan.IsReady())
+		{
+			J.YieldSlice();
+			return false;
+		}
+		Run->Swaps = Run->PendingPlan.Get();
+		Run->PendingPlan.Reset();
+		Run->PlanMs = (FPlatformTime::Seconds() - Run->StageStartSeconds) * 1000.0;
+
+		TSet<int32> Used;
+		for (const FModularSwap& Swap : Run->Swaps)
 		{
-			if (Mesh && SMA->GetStaticMeshComponent())
+			if (Swap.Mesh != INDEX_NONE) { Used.Add(Swap.Mesh); }
+		}
+		TArray<FSoftObjectPath> Paths;
+		for (const int32 MeshIdx : Used)
+		{
+			Paths.Add(Run->Kit[MeshIdx].Path);
+		}
+		Paths.Add(FSoftObjectPath(TEXT("/Engine/BasicShapes/Cube.Cube")));
+		Run->MeshesRequested = Used.Num();
+
+		// One streaming batch instead of a synchronous load per room.
+		Run->StageStartSeconds = FPlatformTime::Seconds();
+		if (UAssetManager::IsInitialized())
+		{
+			Run->LoadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+				Paths, FStreamableDelegate(), FStreamableManager::AsyncLoadHighPriority);
+		}
+		return true;
+	}, 0.5f);
+
+	// ── Stage: load — flush async loading a few ms per slice until resident ──
+	Job->AddStage(TEXT("load"), [Run](FAgentForgeJob& J)
+	{
+		const TSharedPtr<FStreamableHandle>& Handle = Run->LoadHandle;
+		if (Handle.IsValid() && !Handle->HasLoadCompleted() && !Handle->WasCanceled())
+		{
+			// Waiting here also drives the load when the job runs inline.
+			Handle->WaitUntilComplete(ModularLoadWaitSeconds);
+			if (!Handle->HasLoadCompleted())
 			{
-				SMA->GetStaticMeshComponent()->SetStaticMesh(Mesh);
-				SMA->GetStaticMeshComponent()->SetCollisionProfileName(TEXT("BlockAll"));
+				int32 Loaded = 0, Requested = 0;
+				Handle->GetLoadedCount(Loaded, Requested);
+				J.SetStageProgress(Requested > 0 ? static_cast<float>(Loaded) / Requested : 0.f);
+				J.YieldSlice();
+				return false;
 			}
-			SMA->SetActorScale3D(FVector(SnapW / 100.f, SnapD / 100.f, SnapH / 100.f));
-			SMA->SetActorLabel(FString::Printf(TEXT("Arch_Room_%02d_Modular"), RoomIdx + 1));
-			++PiecesPlaced;
 		}
 
-		// Destroy original blockout actor.
-		BlkActor->Destroy();
-	}
-	return PiecesPlaced;
-#else
-	return 0;
-#endif
-}
+		Run->Meshes.SetNumZeroed(Run->Kit.Num());
+		for (const FModularSwap& Swap : Run->Swaps)
+		{
+			if (Swap.Mesh == INDEX_NONE || Run->Meshes[Swap.Mesh]) { continue; }
+			// Resolves once streamed; a handle-less load (no asset manager) falls back to LoadObject.
+			UStaticMesh* Mesh = Cast<UStaticMesh>(Run->Kit[Swap.Mesh].Path.ResolveObject());
+			if (!Mesh) { Mesh = Cast<UStaticMesh>(Run->Kit[Swap.Mesh].Path.TryLoad()); }
+			Run->Meshes[Swap.Mesh] = Mesh;
+			Run->MeshesLoaded += Mesh ? 1 : 0;
+		}
+		Run->CubeMesh = LoadCubeMesh();
+		Run->LoadMs = (FPlatformTime::Seconds() - Run->StageStartSeconds) * 1000.0;
+		Run->StageStartSeconds = FPlatformTime::Seconds();
+		return true;
+	}, 1.0f);
+
+	// ── Stage: swap — ModularSwapsPerSlice pieces per slice, one spawn batch ──
+	Job->AddStage(TEXT("swap"), [Run, WorldLost](FAgentForgeJob& J)
+	{
+		UWorld* World = Run->World.Get();
+		if (!World) { return WorldLost(J); }
 
-// ─────────────────────────────────────────────────────────────────────────────
-//  Phase II — ConvertToWhiteboxModular
-// ─────────────────────────────────────────────────────────────────────────────
-FString FLevelPipelineModule::ConvertToWhiteboxModular(const TSharedPtr<FJsonObject>& Args)
-{
-#if WITH_EDITOR
-	if (!GEditor) { return ToJson(ErrObj(TEXT("GEditor not available."))); }
-	UWorld* World = GEditor->GetEditorWorldContext().World();
-	if (!World)   { return ToJson(ErrObj(TEXT("No editor world."))); }
+		FAgentForgeSpawnBatch SpawnBatch(World);
+		const int32 SliceEnd = FMath::Min(Run->NextSwap + ModularSwapsPerSlice, Run->Swaps.Num());
+		while (Run->NextSwap < SliceEnd)
+		{
+			const FModularSwap& Swap = Run->Swaps[Run->NextSwap++];
+			UStaticMesh* Mesh = Swap.Mesh != INDEX_NONE ? Run->Meshes[Swap.Mesh] : nullptr;
+			FTransform Transform = Swap.Transform;
+			if (!Mesh)
+			{
+				// Engine cube at the snapped size.
+				Mesh = Run->CubeMesh;
+				Transform = FTransform(FRotator::ZeroRotator, Swap.Transform.GetLocation(), Swap.Size / 100.0);
+				++Run->CubeFallbacks;
+			}
+			else if (Swap.bSizeMatched)
+			{
+				++Run->SizeMatched;
+			}
 
-	FString KitPath  = TEXT("/Game/");
-	double  SnapGridD = 50.0;
-	if (Args.IsValid())
-	{
-		Args->TryGetStringField(TEXT("kit_path"),   KitPath);
-		Args->TryGetNumberField(TEXT("snap_grid"),  SnapGridD);
-	}
-	const float SnapGrid = FMath::Clamp(static_cast<float>(SnapGridD), 1.f, 2000.f);
+			if (SpawnMeshActor(World, Mesh, Transform, FString::Printf(TEXT("Arch_Room_%02d_Modular"), Swap.Piece + 1), TEXT("BlockAll")))
+			{
+				++Run->PiecesPlaced;
+			}
+			if (AActor* Blockout = Run->BlockoutActors[Swap.Piece].Get())
+			{
+				Blockout->Destroy();
+			}
+		}
 
-	FScopedTransaction Transaction(NSLOCTEXT("UEAgentForge", "WhiteboxModular", "AgentForge: Whitebox Modular Pass"));
+		J.SetStageProgress(Run->Swaps.Num() > 0 ? static_cast<float>(Run->NextSwap) / Run->Swaps.Num() : 1.f);
+		return Run->NextSwap >= Run->Swaps.Num();
+	}, 2.0f);
 
-	const int32 Pieces = ReplaceBlockoutWithModular(World, KitPath, SnapGrid);
+	Job->SetCancelHandler([Run](FAgentForgeJob&)
+	{
+		if (Run->LoadHandle.IsValid()) { Run->LoadHandle->CancelHandle(); }
+		Run->CancelTransaction();
+	});
 
-	// Count remaining Arch_ actors.
-	TArray<FString> ArchLabels;
-	for (TActorIterator<AActor> It(World); It; ++It)
+	Job->SetFinalizer([Run](FAgentForgeJob&) -> FString
 	{
-		if (IsValid(*It) && (*It)->GetActorLabel().StartsWith(TEXT("Arch_")))
-			ArchLabels.Add((*It)->GetActorLabel());
-	}
-	TArray<TSharedPtr<FJsonValue>> LabelArr;
-	for (const FString& L : ArchLabels)
-		LabelArr.Add(MakeShared<FJsonValueString>(L));
+		Run->SwapMs = (FPlatformTime::Seconds() - Run->StageStartSeconds) * 1000.0;
+		Run->Transaction.Reset();   // commit
 
-	TSharedPtr<FJsonObject> Resp = MakeShared<FJsonObject>();
-	Resp->SetBoolField  (TEXT("ok"),               true);
-	Resp->SetNumberField(TEXT("pieces_placed"),     static_cast<double>(Pieces));
-	Resp->SetNumberField(TEXT("blockout_replaced"), static_cast<double>(Pieces));
-	Resp->SetNumberField(TEXT("snap_grid"),         SnapGrid);
-	Resp->SetStringField(TEXT("kit_path"),          KitPath);
-	Resp->SetArrayField (TEXT("arch_labels"),       LabelArr);
-	return ToJson(Resp);
+		// Count remaining Arch_ actors.
+		TArray<TSharedPtr<FJsonValue>> LabelArr;
+		if (UWorld* World = Run->World.Get())
+		{
+			for (TActorIterator<AActor> It(World); It; ++It)
+			{
+				if (IsValid(*It) && (*It)->GetActorLabel().StartsWith(TEXT("Arch_")))
+					LabelArr.Add(MakeShared<FJsonValueString>((*It)->GetActorLabel()));
+			}
+		}
+
+		TSharedPtr<FJsonObject> Resp = MakeShared<FJsonObject>();
+		Resp->SetBoolField  (TEXT("ok"),               true);
+		Resp->SetNumberField(TEXT("pieces_placed"),     static_cast<double>(Run->PiecesPlaced));
+		Resp->SetNumberField(TEXT("blockout_replaced"), static_cast<double>(Run->PiecesPlaced));
+		Resp->SetNumberField(TEXT("snap_grid"),         Run->SnapGrid);
+		Resp->SetStringField(TEXT("kit_path"),          Run->KitPath);
+		Resp->SetNumberField(TEXT("kit_meshes"),        Run->Kit.Num());
+		Resp->SetNumberField(TEXT("meshes_requested"),  Run->MeshesRequested);
+		Resp->SetNumberField(TEXT("meshes_loaded"),     Run->MeshesLoaded);
+		Resp->SetNumberField(TEXT("size_matched"),      Run->SizeMatched);
+		Resp->SetNumberField(TEXT("cube_fallbacks"),    Run->CubeFallbacks);
+		Resp->SetNumberField(TEXT("plan_ms"),           Run->PlanMs);
+		Resp->SetNumberField(TEXT("load_ms"),           Run->LoadMs);
+		Resp->SetNumberField(TEXT("swap_ms"),           Run->SwapMs);
+		Resp->SetArrayField (TEXT("arch_labels"),       LabelArr);
+		return ToJson(Resp);
+	});
 #else
-	return ToJson(ErrObj(TEXT("WITH_EDITOR required.")));
+	Job->AddStage(TEXT("collect"), [](FAgentForgeJob& J) { J.Finish(ToJson(ErrObj(TEXT("WITH_EDITOR required.")))); return true; });
 #endif
+	return Job;
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
@@ -497,31 +1065,42 @@ int32 FLevelPipelineModule::ScatterPropsInRoom(UWorld* World,
                                                 const FVector& RoomCenter,
                                                 float Radius, float Density,
                                                 const FString& StoryTheme,
-                                                int32 RoomIndex)
+                                                int32 RoomIndex,
+                                                FAgentForgeInstanceBatch* OutInstances)
 {
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Pipeline.ScatterPropsInRoom");
 #if WITH_EDITOR
 	const int32 PropCount = FMath::Clamp(FMath::RoundToInt(Density * 8.f), 1, 12);
-	UStaticMesh* CubeMesh = Cast<UStaticMesh>(
-		StaticLoadObject(UStaticMesh::StaticClass(), nullptr,
-		                 TEXT("/Engine/BasicShapes/Cube.Cube")));
+	UStaticMesh* CubeMesh = OutInstances ? nullptr : LoadCubeMesh();
+
+	auto PropLabel = [RoomIndex, &StoryTheme](int32 N)
+	{
+		return FString::Printf(TEXT("Prop_Room%02d_%s_%02d"), RoomIndex + 1, *StoryTheme.Left(8), N);
+	};
+	// A refinement pass continues the room's numbering instead of reusing labels.
+	int32 FirstProp = 0;
+	if (!OutInstances)
+	{
+		while (FAgentForgeActorIndex::Get().FindByLabel(PropLabel(FirstProp + 1))) { ++FirstProp; }
+	}
 
 	int32 Placed = 0;
 	for (int32 i = 0; i < PropCount; ++i)
 	{
 		FVector Loc = FindPropPlacementPoint(World, RoomCenter, Radius);
-		FActorSpawnParameters SP;
-		SP.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
-		AStaticMeshActor* SMA = World->SpawnActor<AStaticMeshActor>(
-			AStaticMeshActor::StaticClass(),
-			FTransform(FRotator::ZeroRotator, Loc), SP);
-		if (SMA)
-		{
-			if (CubeMesh && SMA->GetStaticMeshComponent())
-				SMA->GetStaticMeshComponent()->SetStaticMesh(CubeMesh);
-			// Props are small (50x50x50 cm).
-			SMA->SetActorScale3D(FVector(0.5f, 0.5f, 0.5f));
-			SMA->SetActorLabel(
-				FString::Printf(TEXT("Prop_Room%02d_%s_%02d"), RoomIndex + 1, *StoryTheme.Left(8), i + 1));
+		if (OutInstances)
+		{
+			// Same 50 cm stand-in, shaded a little per prop so neighbours read apart.
+			const float Shade = FMath::FRandRange(0.8f, 1.f);
+			OutInstances->Add(FTransform(FRotator::ZeroRotator, Loc, FVector(0.5f)),
+			                  FLinearColor(Shade, Shade, Shade), 0.5f);
+			++Placed;
+			continue;
+		}
+		// Props are small (50x50x50 cm).
+		if (SpawnMeshActor(World, CubeMesh, FTransform(FRotator::ZeroRotator, Loc, FVector(0.5f)),
+		                   PropLabel(FirstProp + i + 1)))
+		{
 			++Placed;
 		}
 	}
@@ -536,6 +1115,7 @@ int32 FLevelPipelineModule::ScatterPropsInRoom(UWorld* World,
 // ─────────────────────────────────────────────────────────────────────────────
 FString FLevelPipelineModule::ApplySetDressingAndStorytelling(const TSharedPtr<FJsonObject>& Args)
 {
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Pipeline.ApplySetDressingAndStorytelling");
 #if WITH_EDITOR
 	if (!GEditor) { return ToJson(ErrObj(TEXT("GEditor not available."))); }
 	UWorld* World = GEditor->GetEditorWorldContext().World();
@@ -543,40 +1123,90 @@ FString FLevelPipelineModule::ApplySetDressingAndStorytelling(const TSharedPtr<F
 
 	FString StoryTheme = TEXT("generic");
 	double  PropDensity = 0.5;
+	FString OutputName;
+	TSet<FString> RoomFilter;
 	if (Args.IsValid())
 	{
 		Args->TryGetStringField(TEXT("story_theme"),  StoryTheme);
 		Args->TryGetNumberField(TEXT("prop_density"), PropDensity);
+		Args->TryGetStringField(TEXT("output"),       OutputName);
+		ReadRoomFilter(Args, RoomFilter);
 	}
 	const float Density = FMath::Clamp(static_cast<float>(PropDensity), 0.f, 1.f);
+	EAgentForgeScatterOutput Output = EAgentForgeScatterOutput::Actors;
+	if (!FAgentForgeInstancedScatter::ParseOutput(OutputName, Output))
+	{
+		return ToJson(ErrObj(FString::Printf(TEXT("Unknown output '%s' (expected actors or instances)."), *OutputName)));
+	}
 
 	FScopedTransaction Transaction(NSLOCTEXT("UEAgentForge", "SetDressing", "AgentForge: Set Dressing Pass"));
 
-	// Find all room-type actors (Blockout_Room_* or Arch_Room_*).
-	TArray<AActor*> RoomActors;
+	// Find all room-type actors (Blockout_Room_* or Arch_Room_*), as (index among all rooms, actor).
+	TArray<TPair<int32, AActor*>> RoomActors;
+	int32 RoomIndex = 0;
 	for (TActorIterator<AActor> It(World); It; ++It)
 	{
 		AActor* A = *It;
 		if (!IsValid(A)) { continue; }
 		const FString Lbl = A->GetActorLabel();
-		if (Lbl.StartsWith(TEXT("Blockout_Room_")) || Lbl.StartsWith(TEXT("Arch_Room_")))
-			RoomActors.Add(A);
+		if (IsRoomLabel(Lbl))
+		{
+			if (RoomFilter.IsEmpty() || RoomFilter.Contains(Lbl)) { RoomActors.Add({ RoomIndex, A }); }
+			++RoomIndex;
+		}
 	}
 
 	int32 TotalProps     = 0;
 	int32 MicroStories   = 0;
 	int32 RoomsDressed   = 0;
 
-	for (int32 i = 0; i < RoomActors.Num(); ++i)
+	FAgentForgeInstanceBatch Instances;
+	FAgentForgeInstanceBatch* InstancesOut = Output == EAgentForgeScatterOutput::Instances ? &Instances : nullptr;
+	TOptional<FAgentForgeSpawnBatch> SpawnBatch;
+	if (!InstancesOut)
+	{
+		SpawnBatch.Emplace(World);
+	}
+	TArray<TSharedPtr<FJsonValue>> RoomArr;
+	for (const TPair<int32, AActor*>& Room : RoomActors)
 	{
 		FVector Origin, Extent;
-		RoomActors[i]->GetActorBounds(false, Origin, Extent);
+		Room.Value->GetActorBounds(false, Origin, Extent);
 		const float Radius = FMath::Max(Extent.X, Extent.Y);
 
-		const int32 PropsInRoom = ScatterPropsInRoom(World, Origin, Radius, Density, StoryTheme, i);
+		const int32 PropsInRoom = ScatterPropsInRoom(World, Origin, Radius, Density, StoryTheme, Room.Key, InstancesOut);
 		TotalProps += PropsInRoom;
 		if (PropsInRoom >= 3) { ++MicroStories; }
 		++RoomsDressed;
+
+		TSharedPtr<FJsonObject> RoomObj = MakeShared<FJsonObject>();
+		RoomObj->SetStringField(TEXT("label"), Room.Value->GetActorLabel());
+		RoomObj->SetNumberField(TEXT("props"), static_cast<double>(PropsInRoom));
+		RoomArr.Add(MakeShared<FJsonValueObject>(RoomObj));
+	}
+
+	// Every room's props go into one component, inserted in one call.
+	AActor* InstanceActor = nullptr;
+	if (InstancesOut && Instances.Num() > 0)
+	{
+		UStaticMesh* CubeMesh = Cast<UStaticMesh>(
+			StaticLoadObject(UStaticMesh::StaticClass(), nullptr,
+			                 TEXT("/Engine/BasicShapes/Cube.Cube")));
+		FActorSpawnParameters SP;
+		SP.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		InstanceActor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SP);
+		if (!InstanceActor || !CubeMesh)
+		{
+			return ToJson(ErrObj(TEXT("Failed to create the set dressing instance actor.")));
+		}
+		InstanceActor->SetActorLabel(FString::Printf(TEXT("Prop_Instances_%s"), *StoryTheme.Left(8)));
+		UHierarchicalInstancedStaticMeshComponent* Component =
+			FAgentForgeInstancedScatter::FindOrAddComponent(InstanceActor, CubeMesh, nullptr);
+		if (!Component)
+		{
+			return ToJson(ErrObj(TEXT("Failed to create instanced static mesh component.")));
+		}
+		FAgentForgeInstancedScatter::AddInstances(Component, Instances);
 	}
 
 	TSharedPtr<FJsonObject> Resp = MakeShared<FJsonObject>();
@@ -585,7 +1215,13 @@ FString FLevelPipelineModule::ApplySetDressingAndStorytelling(const TSharedPtr<F
 	Resp->SetNumberField(TEXT("props_placed"), static_cast<double>(TotalProps));
 	Resp->SetNumberField(TEXT("micro_stories"), static_cast<double>(MicroStories));
 	Resp->SetNumberField(TEXT("rooms_dressed"), static_cast<double>(RoomsDressed));
+	Resp->SetArrayField (TEXT("rooms"),        RoomArr);
 	Resp->SetNumberField(TEXT("prop_density"), PropDensity);
+	Resp->SetStringField(TEXT("output"), FAgentForgeInstancedScatter::OutputName(Output));
+	if (InstanceActor)
+	{
+		Resp->SetStringField(TEXT("instance_actor"), InstanceActor->GetActorLabel());
+	}
 	return ToJson(Resp);
 #else
 	return ToJson(ErrObj(TEXT("WITH_EDITOR required.")));
@@ -597,14 +1233,21 @@ FString FLevelPipelineModule::ApplySetDressingAndStorytelling(const TSharedPtr<F
 // ─────────────────────────────────────────────────────────────────────────────
 int32 FLevelPipelineModule::SetupKeyLighting(UWorld* World, const FString& TimeOfDay,
                                               const FString& Mood,
-                                              const FLevelPreset& Preset)
+                                              const FLevelPreset& Preset,
+                                              const TSet<FString>& RoomFilter,
+                                              const FAgentForgeRuntimeCost::FBudget& Budget,
+                                              FAgentForgeRuntimeCost::FActions& OutActions)
 {
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Pipeline.SetupKeyLighting");
 #if WITH_EDITOR
 	int32 LightsPlaced = 0;
 	const bool bNight = TimeOfDay.Contains(TEXT("night")) || TimeOfDay.Contains(TEXT("midnight"));
 	const bool bFearful = Mood.Contains(TEXT("fear")) || Mood.Contains(TEXT("horror")) || Mood.Contains(TEXT("dark"));
+	// A room-limited pass adds only what is missing; level-wide lights stay as they are.
+	const bool bRoomPass = !RoomFilter.IsEmpty();
 
 	// Key directional / sky light.
+	if (!bRoomPass || !FAgentForgeActorIndex::Get().FindByLabel(TEXT("Pipeline_KeyLight")))
 	{
 		FActorSpawnParameters SP;
 		SP.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
@@ -627,13 +1270,19 @@ int32 FLevelPipelineModule::SetupKeyLighting(UWorld* World, const FString& TimeO
 		}
 	}
 
+	// Local lights are admitted against the runtime budget, existing ones included.
+	FAgentForgeRuntimeCost::FPlanner Planner(World, Budget);
+	auto Downgrade = [](ULightComponent* LC)
+	{
+		LC->SetMobility(EComponentMobility::Stationary);
+		LC->SetCastShadows(false);
+	};
+
 	// Fill point lights — one per room.
 	TArray<AActor*> RoomActors;
 	for (TActorIterator<AActor> It(World); It; ++It)
 	{
-		if (IsValid(*It) &&
-		    ((*It)->GetActorLabel().StartsWith(TEXT("Blockout_Room_")) ||
-		     (*It)->GetActorLabel().StartsWith(TEXT("Arch_Room_"))))
+		if (IsValid(*It) && IsRoomLabel((*It)->GetActorLabel()))
 		{
 			RoomActors.Add(*It);
 		}
@@ -641,9 +1290,30 @@ int32 FLevelPipelineModule::SetupKeyLighting(UWorld* World, const FString& TimeO
 
 	for (int32 i = 0; i < RoomActors.Num(); ++i)
 	{
+		if (bRoomPass && !RoomFilter.Contains(RoomActors[i]->GetActorLabel())) { continue; }
 		FVector Origin, Extent;
 		RoomActors[i]->GetActorBounds(false, Origin, Extent);
 		const FVector LightPos = Origin + FVector(0.f, 0.f, Extent.Z * 0.6f);
+		const float   Radius   = FMath::Max(Extent.X, Extent.Y) * 1.5f;
+		const float   Intensity = (bNight ? 800.f : 2000.f) * Preset.AmbientIntensityMultiplier;
+
+		AActor* MergeInto = nullptr;
+		const FAgentForgeRuntimeCost::EPlacement Placement = Planner.AddLight(LightPos, Radius, true, MergeInto);
+		if (Placement == FAgentForgeRuntimeCost::EPlacement::Cull)
+		{
+			++OutActions.LightsCulled;
+			continue;
+		}
+		if (Placement == FAgentForgeRuntimeCost::EPlacement::Merge)
+		{
+			// The two lights covered mostly the same space; the survivor takes half the newcomer's output.
+			if (UPointLightComponent* Target = Cast<UPointLightComponent>(CastChecked<APointLight>(MergeInto)->GetLightComponent()))
+			{
+				Target->SetIntensity(Target->Intensity + Intensity * 0.5f);
+			}
+			++OutActions.LightsMerged;
+			continue;
+		}
 
 		FActorSpawnParameters SP;
 		SP.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
@@ -655,9 +1325,8 @@ int32 FLevelPipelineModule::SetupKeyLighting(UWorld* World, const FString& TimeO
 			// GetLightComponent() returns ULightComponent* — cast down to UPointLightComponent*
 			if (UPointLightComponent* PLC = Cast<UPointLightComponent>(PL->GetLightComponent()))
 			{
-				const float BaseIntensity = bNight ? 800.f : 2000.f;
-				PLC->Intensity         = BaseIntensity * Preset.AmbientIntensityMultiplier;
-				PLC->AttenuationRadius = FMath::Max(Extent.X, Extent.Y) * 1.5f;
+				PLC->Intensity         = Intensity;
+				PLC->AttenuationRadius = Radius;
 				// Apply ambient tint from preset.
 				const FLinearColor& AC = Preset.AmbientLightColor;
 				PLC->LightColor = FColor(
@@ -665,23 +1334,40 @@ int32 FLevelPipelineModule::SetupKeyLighting(UWorld* World, const FString& TimeO
 					FMath::Clamp(static_cast<int32>(AC.G * 255.f + (bFearful ? 0 : 50)), 0, 255),
 					FMath::Clamp(static_cast<int32>(AC.B * 255.f + (bFearful ? 30 : 50)), 0, 255));
 				PLC->SetCastShadows(true); // UE 5.7: use setter, not bCastShadows directly
+				if (Placement == FAgentForgeRuntimeCost::EPlacement::Downgrade)
+				{
+					Downgrade(PLC);
+					++OutActions.LightsDowngraded;
+				}
 			}
 			PL->SetActorLabel(FString::Printf(TEXT("Pipeline_FillLight_%02d"), i + 1));
+			Planner.BindLast(PL);
 			++LightsPlaced;
 		}
 	}
 
 	// God-ray spot if requested.
-	if (Preset.bEnableGodRays)
+	if (Preset.bEnableGodRays && (!bRoomPass || !FAgentForgeActorIndex::Get().FindByLabel(TEXT("Pipeline_GodRay"))))
 	{
 		FActorSpawnParameters SP;
 		SP.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
 		FVector GodRayPos = RoomActors.IsEmpty()
 		                    ? FVector(0.f, 0.f, 800.f)
 		                    : RoomActors[0]->GetActorLocation() + FVector(0.f, 0.f, 700.f);
-		ASpotLight* SL = World->SpawnActor<ASpotLight>(
-			ASpotLight::StaticClass(),
-			FTransform(FRotator(-90.f, 0.f, 0.f), GodRayPos), SP);
+		AActor* MergeInto = nullptr;
+		const FAgentForgeRuntimeCost::EPlacement Placement = Planner.AddLight(
+			GodRayPos, GetDefault<USpotLightComponent>()->AttenuationRadius, false, MergeInto);
+		ASpotLight* SL = nullptr;
+		if (Placement == FAgentForgeRuntimeCost::EPlacement::Cull)
+		{
+			++OutActions.LightsCulled;
+		}
+		else
+		{
+			SL = World->SpawnActor<ASpotLight>(
+				ASpotLight::StaticClass(),
+				FTransform(FRotator(-90.f, 0.f, 0.f), GodRayPos), SP);
+		}
 		if (SL)
 		{
 			if (USpotLightComponent* SLC = Cast<USpotLightComponent>(SL->GetLightComponent()))
@@ -691,6 +1377,11 @@ int32 FLevelPipelineModule::SetupKeyLighting(UWorld* World, const FString& TimeO
 				SLC->OuterConeAngle     = 20.f;
 				SLC->bUseInverseSquaredFalloff = true;
 				SLC->LightColor         = FColor(220, 220, 255);
+				if (Placement == FAgentForgeRuntimeCost::EPlacement::Downgrade)
+				{
+					Downgrade(SLC);
+					++OutActions.LightsDowngraded;
+				}
 			}
 			SL->SetActorLabel(TEXT("Pipeline_GodRay"));
 			++LightsPlaced;
@@ -731,47 +1422,43 @@ void FLevelPipelineModule::ApplyAtmosphericScattering(UWorld* World,
 #endif
 }
 
-float FLevelPipelineModule::ComputeHorrorScore(UWorld* World)
+namespace
 {
-#if WITH_EDITOR
-	float Score = 0.f;
-
-	// Count lights and sum their intensity.
-	float TotalIntensity = 0.f;
-	int32 LightCount     = 0;
-	for (TActorIterator<APointLight> It(World); It; ++It)
+	// The three terms of ComputeHorrorScore, kept apart so a shortfall can be traced to its phase.
+	struct FHorrorTerms
 	{
-		// Cast from ULightComponent* to UPointLightComponent*
-		if (UPointLightComponent* PLC = Cast<UPointLightComponent>((*It)->GetLightComponent()))
-		{
-			TotalIntensity += PLC->Intensity;
-			++LightCount;
-		}
-	}
+		float Darkness = 0.f;   // 0–40, Phase IV point lights
+		float Fog      = 0.f;   // 0–30, Phase IV height fog
+		float Props    = 0.f;   // 0–30, Phase III props
 
-	// Darker levels → higher horror score (up to 40 points).
-	const float AvgIntensity = LightCount > 0 ? TotalIntensity / static_cast<float>(LightCount) : 2000.f;
-	Score += FMath::Clamp((2000.f - AvgIntensity) / 2000.f * 40.f, 0.f, 40.f);
+		float Total() const { return FMath::Clamp(Darkness + Fog + Props, 0.f, 100.f); }
+	};
 
-	// Fog presence (up to 30 points).
-	for (TActorIterator<AExponentialHeightFog> It(World); It; ++It)
+	static FHorrorTerms ComputeHorrorTerms(const FAgentForgeWorldStats::FStats& Stats)
 	{
-		if (UExponentialHeightFogComponent* FC = (*It)->GetComponent())
+		FHorrorTerms Terms;
+
+		// Darker levels → higher horror score, from point light intensity.
+		const int32 LightCount   = Stats.PointLightComponents;
+		const float AvgIntensity = LightCount > 0 ? Stats.PointLightIntensity / static_cast<float>(LightCount) : 2000.f;
+		Terms.Darkness = FMath::Clamp((2000.f - AvgIntensity) / 2000.f * 40.f, 0.f, 40.f);
+
+		// Fog presence.
+		if (Stats.bHasFog)
 		{
-			Score += FMath::Clamp(FC->FogDensity / 0.05f * 30.f, 0.f, 30.f);
+			Terms.Fog = FMath::Clamp(Stats.FogDensity / 0.05f * 30.f, 0.f, 30.f);
 		}
-		break;
-	}
 
-	// Props in level (up to 30 points).
-	int32 PropCount = 0;
-	for (TActorIterator<AStaticMeshActor> It(World); It; ++It)
-	{
-		if ((*It)->GetActorLabel().StartsWith(TEXT("Prop_"))) { ++PropCount; }
+		// Props in level.
+		Terms.Props = FMath::Clamp(static_cast<float>(Stats.Props) / 30.f * 30.f, 0.f, 30.f);
+		return Terms;
 	}
-	Score += FMath::Clamp(static_cast<float>(PropCount) / 30.f * 30.f, 0.f, 30.f);
+}
 
-	return FMath::Clamp(Score, 0.f, 100.f);
+float FLevelPipelineModule::ComputeHorrorScore(UWorld* World)
+{
+#if WITH_EDITOR
+	return ComputeHorrorTerms(FAgentForgeWorldStats::Get().Gather(World)).Total();
 #else
 	return 0.f;
 #endif
@@ -783,6 +1470,7 @@ float FLevelPipelineModule::ComputeHorrorScore(UWorld* World)
 FString FLevelPipelineModule::ApplyProfessionalLightingAndAtmosphere(
 	const TSharedPtr<FJsonObject>& Args)
 {
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Pipeline.ApplyProfessionalLightingAndAtmosphere");
 #if WITH_EDITOR
 	if (!GEditor) { return ToJson(ErrObj(TEXT("GEditor not available."))); }
 	UWorld* World = GEditor->GetEditorWorldContext().World();
@@ -791,11 +1479,13 @@ FString FLevelPipelineModule::ApplyProfessionalLightingAndAtmosphere(
 	FString TimeOfDay    = TEXT("midnight");
 	FString Mood         = TEXT("fearful");
 	bool    bGodRays     = false;
+	TSet<FString> RoomFilter;
 	if (Args.IsValid())
 	{
 		Args->TryGetStringField(TEXT("time_of_day"),      TimeOfDay);
 		Args->TryGetStringField(TEXT("mood"),             Mood);
 		Args->TryGetBoolField  (TEXT("enable_god_rays"),  bGodRays);
+		ReadRoomFilter(Args, RoomFilter);
 	}
 
 	const FLevelPreset& Preset = FLevelPresetSystem::GetCurrentPresetData();
@@ -806,7 +1496,9 @@ FString FLevelPipelineModule::ApplyProfessionalLightingAndAtmosphere(
 
 	FScopedTransaction Transaction(NSLOCTEXT("UEAgentForge", "LightingAtmos", "AgentForge: Lighting & Atmosphere Pass"));
 
-	const int32 LightsPlaced = SetupKeyLighting(World, TimeOfDay, Mood, PPreset);
+	const FAgentForgeRuntimeCost::FBudget Budget = FAgentForgeRuntimeCost::Get().GetBudget(PPreset);
+	FAgentForgeRuntimeCost::FActions BudgetActions;
+	const int32 LightsPlaced = SetupKeyLighting(World, TimeOfDay, Mood, PPreset, RoomFilter, Budget, BudgetActions);
 
 	// Fog density: night fearful = heavy.
 	const bool bNight   = TimeOfDay.Contains(TEXT("night")) || TimeOfDay.Contains(TEXT("midnight"));
@@ -833,6 +1525,8 @@ FString FLevelPipelineModule::ApplyProfessionalLightingAndAtmosphere(
 	Resp->SetStringField(TEXT("atmosphere"),    AtmosphereStr);
 	Resp->SetNumberField(TEXT("fog_density"),   FogDensity);
 	Resp->SetBoolField  (TEXT("god_rays"),      PPreset.bEnableGodRays);
+	BudgetActions.WriteTo(Resp);
+	Resp->SetObjectField(TEXT("runtime_cost"),  FAgentForgeRuntimeCost::Estimate(World, Budget).ToJson());
 	return ToJson(Resp);
 #else
 	return ToJson(ErrObj(TEXT("WITH_EDITOR required.")));
@@ -844,8 +1538,11 @@ FString FLevelPipelineModule::ApplyProfessionalLightingAndAtmosphere(
 // ─────────────────────────────────────────────────────────────────────────────
 int32 FLevelPipelineModule::SpawnAmbientParticles(UWorld* World,
                                                    const TArray<FString>& VfxNames,
-                                                   float Density)
+                                                   float Density,
+                                                   const FAgentForgeRuntimeCost::FBudget& Budget,
+                                                   FAgentForgeRuntimeCost::FActions& OutActions)
 {
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Pipeline.SpawnAmbientParticles");
 #if WITH_EDITOR
 	// Collect room centres.
 	TArray<FVector> RoomCenters;
@@ -860,19 +1557,28 @@ int32 FLevelPipelineModule::SpawnAmbientParticles(UWorld* World,
 
 	const int32 PerRoom  = FMath::Max(1, FMath::RoundToInt(Density * 3.f));
 	int32 TotalSpawned   = 0;
+	int32 Planned        = 0;
 	FRandomStream RS(12345);
+	FAgentForgeRuntimeCost::FPlanner Planner(World, Budget);
 
 	for (const FVector& Center : RoomCenters)
 	{
 		for (int32 p = 0; p < PerRoom; ++p)
 		{
-			const int32  VfxIdx  = (VfxNames.IsEmpty()) ? 0 : (TotalSpawned % VfxNames.Num());
+			const int32  VfxIdx  = (VfxNames.IsEmpty()) ? 0 : (Planned++ % VfxNames.Num());
 			const FString VfxName = VfxNames.IsEmpty() ? TEXT("dust") : VfxNames[VfxIdx];
 			const FVector Loc(
 				Center.X + RS.FRandRange(-300.f, 300.f),
 				Center.Y + RS.FRandRange(-300.f, 300.f),
 				Center.Z + RS.FRandRange(50.f, 200.f));
 
+			// Over the overdraw budget here: this emitter would only add cost.
+			if (!Planner.AddEmitter(Loc, VfxName))
+			{
+				++OutActions.EmittersCulled;
+				continue;
+			}
+
 			// Spawn as a StaticMeshActor stand-in (sphere) labeled VFX_name_NN.
 			// A real project would use ANiagaraActor — that requires Niagara includes
 			// and a specific Niagara system asset.  We label it clearly so the pipeline
@@ -903,10 +1609,16 @@ int32 FLevelPipelineModule::SpawnAmbientParticles(UWorld* World,
 }
 
 int32 FLevelPipelineModule::PlaceAmbientAudioEmitters(UWorld* World,
-                                                       const FString& Soundscape)
+                                                       const FString& Soundscape,
+                                                       const FAgentForgeRuntimeCost::FBudget& Budget,
+                                                       FAgentForgeRuntimeCost::FActions& OutActions)
 {
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Pipeline.PlaceAmbientAudioEmitters");
 #if WITH_EDITOR
 	int32 Placed = 0;
+	FAgentForgeRuntimeCost::FPlanner Planner(World, Budget);
+	// Proxies are spawned while iterating; collect rooms first.
+	TArray<AActor*> Rooms;
 	// Place one AudioVolume-proxy (StaticMeshActor, cube) per room.
 	for (TActorIterator<AActor> It(World); It; ++It)
 	{
@@ -915,21 +1627,47 @@ int32 FLevelPipelineModule::PlaceAmbientAudioEmitters(UWorld* World,
 		if (A->GetActorLabel().StartsWith(TEXT("Blockout_Room_")) ||
 		    A->GetActorLabel().StartsWith(TEXT("Arch_Room_")))
 		{
-			FVector Origin, Extent;
-			A->GetActorBounds(false, Origin, Extent);
+			Rooms.Add(A);
+		}
+	}
 
-			FActorSpawnParameters SP;
-			SP.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-			AActor* AudioProxy = World->SpawnActor<AStaticMeshActor>(
-				AStaticMeshActor::StaticClass(),
-				FTransform(FRotator::ZeroRotator, Origin), SP);
-			if (AudioProxy)
-			{
-				AudioProxy->SetActorScale3D(FVector(Extent.X / 50.f, Extent.Y / 50.f, 1.f));
-				AudioProxy->SetActorLabel(
-					FString::Printf(TEXT("Audio_%s_%02d"), *Soundscape.Left(12), Placed + 1));
-				++Placed;
-			}
+	for (AActor* A : Rooms)
+	{
+		FVector Origin, Extent;
+		A->GetActorBounds(false, Origin, Extent);
+		const FVector ProxyExtent(Extent.X, Extent.Y, 50.f);
+
+		AActor* MergeInto = nullptr;
+		FBox    Merged(ForceInit);
+		const FAgentForgeRuntimeCost::EPlacement Placement =
+			Planner.AddAudio(FBox::BuildAABB(Origin, ProxyExtent), MergeInto, Merged);
+		if (Placement == FAgentForgeRuntimeCost::EPlacement::Cull)
+		{
+			++OutActions.AudioCulled;
+			continue;
+		}
+		if (Placement == FAgentForgeRuntimeCost::EPlacement::Merge)
+		{
+			// One voice covers both rooms: stretch the nearest proxy over them.
+			const FVector MergedExtent = Merged.GetExtent();
+			MergeInto->SetActorLocation(Merged.GetCenter());
+			MergeInto->SetActorScale3D(FVector(MergedExtent.X / 50.f, MergedExtent.Y / 50.f, MergedExtent.Z / 50.f));
+			++OutActions.AudioMerged;
+			continue;
+		}
+
+		FActorSpawnParameters SP;
+		SP.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		AActor* AudioProxy = World->SpawnActor<AStaticMeshActor>(
+			AStaticMeshActor::StaticClass(),
+			FTransform(FRotator::ZeroRotator, Origin), SP);
+		if (AudioProxy)
+		{
+			AudioProxy->SetActorScale3D(FVector(Extent.X / 50.f, Extent.Y / 50.f, 1.f));
+			AudioProxy->SetActorLabel(
+				FString::Printf(TEXT("Audio_%s_%02d"), *Soundscape.Left(12), Placed + 1));
+			Planner.BindLast(AudioProxy);
+			++Placed;
 		}
 	}
 	return Placed;
@@ -943,6 +1681,7 @@ int32 FLevelPipelineModule::PlaceAmbientAudioEmitters(UWorld* World,
 // ─────────────────────────────────────────────────────────────────────────────
 FString FLevelPipelineModule::AddLivingSystemsAndPolish(const TSharedPtr<FJsonObject>& Args)
 {
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Pipeline.AddLivingSystemsAndPolish");
 #if WITH_EDITOR
 	if (!GEditor) { return ToJson(ErrObj(TEXT("GEditor not available."))); }
 	UWorld* World = GEditor->GetEditorWorldContext().World();
@@ -967,12 +1706,14 @@ FString FLevelPipelineModule::AddLivingSystemsAndPolish(const TSharedPtr<FJsonOb
 
 	int32 VfxPlaced   = 0;
 	int32 AudioPlaced = 0;
+	const FAgentForgeRuntimeCost::FBudget Budget = FAgentForgeRuntimeCost::Get().GetBudget(Preset);
+	FAgentForgeRuntimeCost::FActions BudgetActions;
 
 	if (Preset.bEnableAmbientParticles)
-		VfxPlaced = SpawnAmbientParticles(World, VfxNames, Preset.ParticleDensity);
+		VfxPlaced = SpawnAmbientParticles(World, VfxNames, Preset.ParticleDensity, Budget, BudgetActions);
 
 	if (Preset.bEnableAmbientSound)
-		AudioPlaced = PlaceAmbientAudioEmitters(World, Soundscape);
+		AudioPlaced = PlaceAmbientAudioEmitters(World, Soundscape, Budget, BudgetActions);
 
 	TArray<TSharedPtr<FJsonValue>> VfxArr2;
 	for (const FString& V : VfxNames) VfxArr2.Add(MakeShared<FJsonValueString>(V));
@@ -983,6 +1724,8 @@ FString FLevelPipelineModule::AddLivingSystemsAndPolish(const TSharedPtr<FJsonOb
 	Resp->SetNumberField(TEXT("audio_placed"), static_cast<double>(AudioPlaced));
 	Resp->SetArrayField (TEXT("vfx_names"),    VfxArr2);
 	Resp->SetStringField(TEXT("soundscape"),   Soundscape);
+	BudgetActions.WriteTo(Resp);
+	Resp->SetObjectField(TEXT("runtime_cost"), FAgentForgeRuntimeCost::Estimate(World, Budget).ToJson());
 	return ToJson(Resp);
 #else
 	return ToJson(ErrObj(TEXT("WITH_EDITOR required.")));
@@ -994,38 +1737,24 @@ FString FLevelPipelineModule::AddLivingSystemsAndPolish(const TSharedPtr<FJsonOb
 // ─────────────────────────────────────────────────────────────────────────────
 float FLevelPipelineModule::EvaluateLevelQuality(UWorld* World, const FLevelPreset& Preset)
 {
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Pipeline.EvaluateLevelQuality");
 #if WITH_EDITOR
 	float Score = 0.f;
 	constexpr float TotalWeight = 5.f;
+	const FAgentForgeWorldStats::FStats Stats = FAgentForgeWorldStats::Get().Gather(World);
 
 	// 1. Actor count in valid range (1 point).
-	int32 ActorCount = 0;
-	for (TActorIterator<AActor> It(World); It; ++It)
-	{
-		if (IsValid(*It)) { ++ActorCount; }
-	}
-	if (ActorCount >= Preset.MinActorCount && ActorCount <= Preset.MaxActorCount)
+	if (Stats.Actors >= Preset.MinActorCount && Stats.Actors <= Preset.MaxActorCount)
 		Score += 1.f;
 
 	// 2. Lighting — at least one fill light (1 point).
-	int32 LightCount = 0;
-	for (TActorIterator<APointLight> It(World); It; ++It)
-	{
-		if (IsValid(*It)) { ++LightCount; }
-	}
-	if (LightCount > 0) { Score += 1.f; }
+	if (Stats.PointLights > 0) { Score += 1.f; }
 
 	// 3. PlayerStart present (1 point).
-	for (TActorIterator<APlayerStart> It(World); It; ++It)
-	{
-		if (IsValid(*It)) { Score += 1.f; break; }
-	}
+	if (Stats.PlayerStarts > 0) { Score += 1.f; }
 
 	// 4. NavMesh volume present (1 point).
-	for (TActorIterator<ANavMeshBoundsVolume> It(World); It; ++It)
-	{
-		if (IsValid(*It)) { Score += 1.f; break; }
-	}
+	if (Stats.NavMeshVolumes > 0) { Score += 1.f; }
 
 	// 5. Horror score meets preset minimum (1 point).
 	if (Preset.MinHorrorScore > 0.f)
@@ -1047,32 +1776,20 @@ float FLevelPipelineModule::EvaluateLevelQuality(UWorld* World, const FLevelPres
 TSharedPtr<FJsonObject> FLevelPipelineModule::BuildQualityReport(UWorld* World,
                                                                    const FLevelPreset& Preset)
 {
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Pipeline.BuildQualityReport");
 	TSharedPtr<FJsonObject> R = MakeShared<FJsonObject>();
 #if WITH_EDITOR
-	int32 ActorCount = 0;
-	for (TActorIterator<AActor> It(World); It; ++It)
-	{ if (IsValid(*It)) { ++ActorCount; } }
-
-	int32 LightCount = 0;
-	for (TActorIterator<APointLight> It(World); It; ++It)
-	{ if (IsValid(*It)) { ++LightCount; } }
-
-	bool bHasPlayerStart = false;
-	for (TActorIterator<APlayerStart> It(World); It; ++It)
-	{ if (IsValid(*It)) { bHasPlayerStart = true; break; } }
-
-	bool bHasNavMesh = false;
-	for (TActorIterator<ANavMeshBoundsVolume> It(World); It; ++It)
-	{ if (IsValid(*It)) { bHasNavMesh = true; break; } }
-
+	// One gather; the scores below reuse the cached stats.
+	const FAgentForgeWorldStats::FStats Stats = FAgentForgeWorldStats::Get().Gather(World);
 	const float HorrorSc = ComputeHorrorScore(World);
 
-	R->SetNumberField(TEXT("actor_count"),       static_cast<double>(ActorCount));
-	R->SetNumberField(TEXT("light_count"),       static_cast<double>(LightCount));
-	R->SetBoolField  (TEXT("has_player_start"),  bHasPlayerStart);
-	R->SetBoolField  (TEXT("has_navmesh"),       bHasNavMesh);
+	R->SetNumberField(TEXT("actor_count"),       static_cast<double>(Stats.Actors));
+	R->SetNumberField(TEXT("light_count"),       static_cast<double>(Stats.PointLights));
+	R->SetBoolField  (TEXT("has_player_start"),  Stats.PlayerStarts > 0);
+	R->SetBoolField  (TEXT("has_navmesh"),       Stats.NavMeshVolumes > 0);
 	R->SetNumberField(TEXT("horror_score"),      HorrorSc);
 	R->SetNumberField(TEXT("quality_score"),     EvaluateLevelQuality(World, Preset));
+	R->SetObjectField(TEXT("runtime_cost"),      FAgentForgeRuntimeCost::Estimate(World, FAgentForgeRuntimeCost::Get().GetBudget(Preset)).ToJson());
 #endif
 	return R;
 }
@@ -1080,203 +1797,401 @@ TSharedPtr<FJsonObject> FLevelPipelineModule::BuildQualityReport(UWorld* World,
 // ─────────────────────────────────────────────────────────────────────────────
 //  Master Orchestrator — GenerateFullQualityLevel
 // ─────────────────────────────────────────────────────────────────────────────
-FString FLevelPipelineModule::GenerateFullQualityLevel(const TSharedPtr<FJsonObject>& Args)
+namespace
 {
-#if WITH_EDITOR
-	if (!GEditor) { return ToJson(ErrObj(TEXT("GEditor not available."))); }
-	UWorld* World = GEditor->GetEditorWorldContext().World();
-	if (!World)   { return ToJson(ErrObj(TEXT("No editor world."))); }
-
-	// ── Parse top-level args ─────────────────────────────────────────────────
-	FString Mission           = TEXT("Create a level");
-	FString PresetName        = TEXT("Default");
-	double  MaxIterationsD    = 2.0;
-	double  QualityThresholdD = 0.75;
-
-	if (Args.IsValid())
+	// Props per room from a Phase III response's rooms array.
+	static void NoteRoomProps(FFullQualityRun& Run, const TSharedPtr<FJsonObject>& Phase3)
 	{
-		Args->TryGetStringField(TEXT("mission"),           Mission);
-		Args->TryGetStringField(TEXT("preset"),            PresetName);
-		Args->TryGetNumberField(TEXT("max_iterations"),    MaxIterationsD);
-		Args->TryGetNumberField(TEXT("quality_threshold"), QualityThresholdD);
+		const TArray<TSharedPtr<FJsonValue>>* Rooms = nullptr;
+		if (!Phase3.IsValid() || !Phase3->TryGetArrayField(TEXT("rooms"), Rooms)) { return; }
+		for (const TSharedPtr<FJsonValue>& V : *Rooms)
+		{
+			const TSharedPtr<FJsonObject>* Room = nullptr;
+			FString Label;
+			double  Props = 0.0;
+			if (V.IsValid() && V->TryGetObject(Room) && (*Room)->TryGetStringField(TEXT("label"), Label))
+			{
+				(*Room)->TryGetNumberField(TEXT("props"), Props);
+				Run.RoomProps.FindOrAdd(Label) += static_cast<int32>(Props);
+			}
+		}
 	}
 
-	const int32 MaxIter    = FMath::Clamp(static_cast<int32>(MaxIterationsD), 1, 5);
-	const float QualThresh = FMath::Clamp(static_cast<float>(QualityThresholdD), 0.f, 1.f);
+	/**
+	 * Maps each failed quality check to the phase output it reads and the rooms
+	 * that output is missing from. Checks no later phase can change (too many
+	 * actors, PlayerStart and nav volume from Phase I, darkness and fog, which
+	 * Phase IV sets from time_of_day and mood alone) are reported in Reasons
+	 * without a rerun.
+	 */
+	static FQualityShortfall FindQualityShortfall(const FFullQualityRun& Run)
+	{
+		FQualityShortfall Out;
+		const FAgentForgeWorldStats::FStats Stats = FAgentForgeWorldStats::Get().Gather(Run.World.Get());
+		const FLevelPreset& Preset = Run.Preset;
+		FAgentForgeActorIndex& ActorIndex = FAgentForgeActorIndex::Get();
 
-	// ── Load preset ───────────────────────────────────────────────────────────
-	if (FLevelPresetSystem::LoadedPresets.Num() == 0)
-		FLevelPresetSystem::RegisterBuiltinPresets();
-	FLevelPresetSystem::SetCurrentPreset(PresetName);
-	const FLevelPreset& Preset = FLevelPresetSystem::GetCurrentPresetData();
+		if (Stats.PointLights == 0)
+		{
+			// Rooms with no point light inside their bounds get their fill lights again.
+			Out.Reasons.Add(TEXT("no_fill_light"));
+			for (const TPair<FString, int32>& Room : Run.RoomProps)
+			{
+				AActor* RoomActor = ActorIndex.FindByLabel(Room.Key);
+				if (!RoomActor) { continue; }
+				FVector Origin, Extent;
+				RoomActor->GetActorBounds(false, Origin, Extent);
+				TArray<AActor*> Lights;
+				ActorIndex.QueryBox(FBox(Origin - Extent, Origin + Extent), Lights, APointLight::StaticClass());
+				if (Lights.IsEmpty()) { Out.LightRooms.Add(Room.Key); }
+			}
+		}
 
-	// ── Infer phase args from master args ─────────────────────────────────────
-	// Phase I.
-	TSharedPtr<FJsonObject> P1Args = MakeShared<FJsonObject>();
-	P1Args->SetStringField(TEXT("mission"),    Mission);
-	P1Args->SetStringField(TEXT("preset"),     PresetName);
-	P1Args->SetNumberField(TEXT("room_count"), 3.0);
-	P1Args->SetNumberField(TEXT("grid_size"),  400.0);
-	if (Args.IsValid())
-	{
-		double RC = 3.0; Args->TryGetNumberField(TEXT("room_count"), RC);
-		P1Args->SetNumberField(TEXT("room_count"), RC);
-		double GS = 400.0; Args->TryGetNumberField(TEXT("grid_size"), GS);
-		P1Args->SetNumberField(TEXT("grid_size"), GS);
-	}
+		bool bNeedProps = false;
+		if (Stats.Actors < Preset.MinActorCount)      { Out.Reasons.Add(TEXT("actor_count_low")); bNeedProps = true; }
+		if (Stats.Actors > Preset.MaxActorCount)      { Out.Reasons.Add(TEXT("actor_count_high")); }
+		if (Stats.PlayerStarts == 0)                  { Out.Reasons.Add(TEXT("no_player_start")); }
+		if (Stats.NavMeshVolumes == 0)                { Out.Reasons.Add(TEXT("no_navmesh")); }
+		if (Preset.MinHorrorScore > 0.f)
+		{
+			const FHorrorTerms Horror = ComputeHorrorTerms(Stats);
+			if (Horror.Total() < Preset.MinHorrorScore)
+			{
+				if (Horror.Props < 30.f)    { Out.Reasons.Add(TEXT("horror_props")); bNeedProps = true; }
+				if (Horror.Darkness < 40.f) { Out.Reasons.Add(TEXT("horror_darkness")); }
+				if (Horror.Fog < 30.f)      { Out.Reasons.Add(TEXT("horror_fog")); }
+			}
+		}
 
-	// Phase III.
-	TSharedPtr<FJsonObject> P3Args = MakeShared<FJsonObject>();
-	P3Args->SetStringField(TEXT("story_theme"),  Mission.Left(20));
-	P3Args->SetNumberField(TEXT("prop_density"),  Preset.SetDressingDensity);
+		if (bNeedProps)
+		{
+			// Rooms a pass left short first; when every room is full, another layer everywhere.
+			for (const TPair<FString, int32>& Room : Run.RoomProps)
+			{
+				if (Room.Value < Run.PropTarget) { Out.DressRooms.Add(Room.Key); }
+			}
+			if (Out.DressRooms.IsEmpty()) { Run.RoomProps.GetKeys(Out.DressRooms); }
+		}
+		return Out;
+	}
 
-	// Phase IV.
-	TSharedPtr<FJsonObject> P4Args = MakeShared<FJsonObject>();
-	P4Args->SetStringField(TEXT("time_of_day"),     TEXT("midnight"));
-	P4Args->SetStringField(TEXT("mood"),            TEXT("fearful"));
-	P4Args->SetBoolField  (TEXT("enable_god_rays"), Preset.bEnableGodRays);
-	if (Args.IsValid())
+	static TArray<TSharedPtr<FJsonValue>> ToJsonStrings(const TArray<FString>& Strings)
 	{
-		FString TOD; if (Args->TryGetStringField(TEXT("time_of_day"), TOD)) P4Args->SetStringField(TEXT("time_of_day"), TOD);
-		FString Md;  if (Args->TryGetStringField(TEXT("mood"),        Md))  P4Args->SetStringField(TEXT("mood"),        Md);
+		TArray<TSharedPtr<FJsonValue>> Arr;
+		for (const FString& S : Strings) { Arr.Add(MakeShared<FJsonValueString>(S)); }
+		return Arr;
 	}
+}
 
-	// Phase V.
-	TSharedPtr<FJsonObject> P5Args = MakeShared<FJsonObject>();
+FString FLevelPipelineModule::GenerateFullQualityLevel(const TSharedPtr<FJsonObject>& Args)
+{
+	return MakeGenerateFullQualityLevelJob(Args)->RunToCompletion();
+}
+
+TSharedRef<FAgentForgeJob> FLevelPipelineModule::MakeGenerateFullQualityLevelJob(const TSharedPtr<FJsonObject>& Args)
+{
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Pipeline.MakeGenerateFullQualityLevelJob");
+	TSharedRef<FAgentForgeJob> Job = MakeShared<FAgentForgeJob>(TEXT("generate_full_quality_level"));
+#if WITH_EDITOR
+	TSharedRef<FFullQualityRun> Run = MakeShared<FFullQualityRun>();
+
+	auto WorldLost = [](FAgentForgeJob& J)
+	{
+		J.Finish(ToJson(ErrObj(TEXT("Editor world changed while generate_full_quality_level was running."))));
+		return true;
+	};
+	auto ParseResult = [](const FString& Raw) -> TSharedPtr<FJsonObject>
+	{
+		TSharedPtr<FJsonObject> Obj;
+		TSharedRef<TJsonReader<>> R = TJsonReaderFactory<>::Create(Raw);
+		FJsonSerializer::Deserialize(R, Obj);
+		return Obj;
+	};
+
+	// ── Stage: prepare — parse top-level args, load preset, infer phase args ─
+	Job->AddStage(TEXT("prepare"), [Run, Args](FAgentForgeJob& J)
 	{
-		TArray<TSharedPtr<FJsonValue>> VfxArr;
-		VfxArr.Add(MakeShared<FJsonValueString>(TEXT("dust")));
-		VfxArr.Add(MakeShared<FJsonValueString>(TEXT("embers")));
-		P5Args->SetArrayField(TEXT("ambient_vfx"), VfxArr);
-		P5Args->SetStringField(TEXT("soundscape"), TEXT("ambient_atmosphere"));
+		if (!GEditor) { J.Finish(ToJson(ErrObj(TEXT("GEditor not available.")))); return true; }
+		UWorld* World = GEditor->GetEditorWorldContext().World();
+		if (!World)   { J.Finish(ToJson(ErrObj(TEXT("No editor world.")))); return true; }
+		Run->World = World;
+		Run->Args  = Args;
+
+		double MaxIterationsD    = 2.0;
+		double QualityThresholdD = 0.75;
 		if (Args.IsValid())
 		{
-			const TArray<TSharedPtr<FJsonValue>>* ArrPtr;
-			if (Args->TryGetArrayField(TEXT("ambient_vfx"), ArrPtr))
-				P5Args->SetArrayField(TEXT("ambient_vfx"), *ArrPtr);
-			FString SC; if (Args->TryGetStringField(TEXT("soundscape"), SC)) P5Args->SetStringField(TEXT("soundscape"), SC);
+			Args->TryGetStringField(TEXT("mission"),           Run->Mission);
+			Args->TryGetStringField(TEXT("preset"),            Run->PresetName);
+			Args->TryGetNumberField(TEXT("max_iterations"),    MaxIterationsD);
+			Args->TryGetNumberField(TEXT("quality_threshold"), QualityThresholdD);
 		}
-	}
 
-	// ── Phase I ───────────────────────────────────────────────────────────────
-	const FString P1Result = CreateBlockoutLevel(P1Args);
-	TSharedPtr<FJsonObject> P1Json;
-	{
-		TSharedRef<TJsonReader<>> R = TJsonReaderFactory<>::Create(P1Result);
-		FJsonSerializer::Deserialize(R, P1Json);
-	}
+		Run->MaxIter    = FMath::Clamp(static_cast<int32>(MaxIterationsD), 1, 5);
+		Run->QualThresh = FMath::Clamp(static_cast<float>(QualityThresholdD), 0.f, 1.f);
+
+		// ── Load preset ───────────────────────────────────────────────────────
+		FLevelPresetSystem::SetCurrentPreset(Run->PresetName);
+		Run->Preset = FLevelPresetSystem::GetCurrentPresetData();
+		const FLevelPreset& Preset = Run->Preset;
+
+		// ── Infer phase args from master args ─────────────────────────────────
+		// Phase I.
+		Run->P1Args = MakeShared<FJsonObject>();
+		Run->P1Args->SetStringField(TEXT("mission"),    Run->Mission);
+		Run->P1Args->SetStringField(TEXT("preset"),     Run->PresetName);
+		Run->P1Args->SetNumberField(TEXT("room_count"), 3.0);
+		Run->P1Args->SetNumberField(TEXT("grid_size"),  400.0);
+		if (Args.IsValid())
+		{
+			double RC = 3.0; Args->TryGetNumberField(TEXT("room_count"), RC);
+			Run->P1Args->SetNumberField(TEXT("room_count"), RC);
+			double GS = 400.0; Args->TryGetNumberField(TEXT("grid_size"), GS);
+			Run->P1Args->SetNumberField(TEXT("grid_size"), GS);
+		}
 
-	// ── Phase II ──────────────────────────────────────────────────────────────
-	// Use kit paths from preset if available.
-	TSharedPtr<FJsonObject> P2Args = MakeShared<FJsonObject>();
-	FString KitPath = Preset.PreferredModularKitPaths.IsEmpty()
-	                  ? TEXT("/Game/")
-	                  : Preset.PreferredModularKitPaths[0];
-	if (Args.IsValid()) { FString KP; if (Args->TryGetStringField(TEXT("kit_path"), KP)) KitPath = KP; }
-	P2Args->SetStringField(TEXT("kit_path"),  KitPath);
-	P2Args->SetNumberField(TEXT("snap_grid"), 50.0);
-
-	const FString P2Result = ConvertToWhiteboxModular(P2Args);
-	TSharedPtr<FJsonObject> P2Json;
-	{
-		TSharedRef<TJsonReader<>> R = TJsonReaderFactory<>::Create(P2Result);
-		FJsonSerializer::Deserialize(R, P2Json);
-	}
+		// Phase III.
+		Run->P3Args = MakeShared<FJsonObject>();
+		Run->P3Args->SetStringField(TEXT("story_theme"),  Run->Mission.Left(20));
+		Run->P3Args->SetNumberField(TEXT("prop_density"),  Preset.SetDressingDensity);
+		Run->PropTarget = FMath::Clamp(FMath::RoundToInt(FMath::Clamp(Preset.SetDressingDensity, 0.f, 1.f) * 8.f), 1, 12);
+		FString PropOutput;
+		if (Args.IsValid() && Args->TryGetStringField(TEXT("prop_output"), PropOutput))
+		{
+			Run->P3Args->SetStringField(TEXT("output"), PropOutput);
+		}
 
-	// ── Phase III ─────────────────────────────────────────────────────────────
-	const FString P3Result = ApplySetDressingAndStorytelling(P3Args);
-	TSharedPtr<FJsonObject> P3Json;
-	{
-		TSharedRef<TJsonReader<>> R = TJsonReaderFactory<>::Create(P3Result);
-		FJsonSerializer::Deserialize(R, P3Json);
-	}
+		// Phase IV.
+		Run->P4Args = MakeShared<FJsonObject>();
+		Run->P4Args->SetStringField(TEXT("time_of_day"),     TEXT("midnight"));
+		Run->P4Args->SetStringField(TEXT("mood"),            TEXT("fearful"));
+		Run->P4Args->SetBoolField  (TEXT("enable_god_rays"), Preset.bEnableGodRays);
+		if (Args.IsValid())
+		{
+			FString TOD; if (Args->TryGetStringField(TEXT("time_of_day"), TOD)) Run->P4Args->SetStringField(TEXT("time_of_day"), TOD);
+			FString Md;  if (Args->TryGetStringField(TEXT("mood"),        Md))  Run->P4Args->SetStringField(TEXT("mood"),        Md);
+		}
 
-	// ── Phase IV + V with closed-loop refinement ─────────────────────────────
-	float   QualScore    = 0.f;
-	int32   Iteration    = 0;
-	TSharedPtr<FJsonObject> P4Json, P5Json;
+		// Phase V.
+		Run->P5Args = MakeShared<FJsonObject>();
+		{
+			TArray<TSharedPtr<FJsonValue>> VfxArr;
+			VfxArr.Add(MakeShared<FJsonValueString>(TEXT("dust")));
+			VfxArr.Add(MakeShared<FJsonValueString>(TEXT("embers")));
+			Run->P5Args->SetArrayField(TEXT("ambient_vfx"), VfxArr);
+			Run->P5Args->SetStringField(TEXT("soundscape"), TEXT("ambient_atmosphere"));
+			if (Args.IsValid())
+			{
+				const TArray<TSharedPtr<FJsonValue>>* ArrPtr;
+				if (Args->TryGetArrayField(TEXT("ambient_vfx"), ArrPtr))
+					Run->P5Args->SetArrayField(TEXT("ambient_vfx"), *ArrPtr);
+				FString SC; if (Args->TryGetStringField(TEXT("soundscape"), SC)) Run->P5Args->SetStringField(TEXT("soundscape"), SC);
+			}
+		}
+		return true;
+	}, 0.1f);
 
-	do
+	// ── Stage: Phase I — blockout, advanced as a nested job ──────────────────
+	Job->AddStage(TEXT("phase1_blockout"), [Run, ParseResult](FAgentForgeJob& J)
 	{
-		++Iteration;
-		const FString P4Result = ApplyProfessionalLightingAndAtmosphere(P4Args);
-		{ TSharedRef<TJsonReader<>> R = TJsonReaderFactory<>::Create(P4Result); FJsonSerializer::Deserialize(R, P4Json); }
+		if (!Run->SubJob.IsValid())
+		{
+			Run->SubJob = MakeCreateBlockoutLevelJob(Run->P1Args);
+		}
+		const bool bDone = Run->SubJob->Step();
+		J.SetStageProgress(Run->SubJob->GetPercentComplete() / 100.f);
+		if (bDone)
+		{
+			Run->P1Json = ParseResult(Run->SubJob->GetResult());
+			J.AddPartialResult(Run->P1Json);
+			Run->SubJob.Reset();
+		}
+		return bDone;
+	}, 2.0f);
 
-		const FString P5Result = AddLivingSystemsAndPolish(P5Args);
-		{ TSharedRef<TJsonReader<>> R = TJsonReaderFactory<>::Create(P5Result); FJsonSerializer::Deserialize(R, P5Json); }
+	// ── Stage: Phase II — whitebox ───────────────────────────────────────────
+	Job->AddStage(TEXT("phase2_whitebox"), [Run, ParseResult, WorldLost](FAgentForgeJob& J)
+	{
+		if (!Run->World.IsValid()) { return WorldLost(J); }
 
-		QualScore = EvaluateLevelQuality(World, Preset);
-	}
-	while (QualScore < QualThresh && Iteration < MaxIter);
+		// Advanced as a nested job: kit planning and mesh streaming run across slices.
+		if (!Run->SubJob.IsValid())
+		{
+			// Use kit paths from preset if available.
+			TSharedPtr<FJsonObject> P2Args = MakeShared<FJsonObject>();
+			FString KitPath = Run->Preset.PreferredModularKitPaths.IsEmpty()
+			                  ? TEXT("/Game/")
+			                  : Run->Preset.PreferredModularKitPaths[0];
+			if (Run->Args.IsValid()) { FString KP; if (Run->Args->TryGetStringField(TEXT("kit_path"), KP)) KitPath = KP; }
+			P2Args->SetStringField(TEXT("kit_path"),  KitPath);
+			P2Args->SetNumberField(TEXT("snap_grid"), 50.0);
+			Run->SubJob = MakeConvertToWhiteboxModularJob(P2Args);
+		}
+		const bool bDone = Run->SubJob->Step();
+		J.SetStageProgress(Run->SubJob->GetPercentComplete() / 100.f);
+		if (bDone)
+		{
+			Run->P2Json = ParseResult(Run->SubJob->GetResult());
+			J.AddPartialResult(Run->P2Json);
+			Run->SubJob.Reset();
+		}
+		return bDone;
+	}, 1.0f);
 
-	// ── Screenshot ────────────────────────────────────────────────────────────
-	FString ScreenshotPath;
+	// ── Stage: Phase III — set dressing ──────────────────────────────────────
+	Job->AddStage(TEXT("phase3_set_dressing"), [Run, ParseResult, WorldLost](FAgentForgeJob& J)
 	{
-		const FString SSDir  = FPaths::ProjectSavedDir() / TEXT("Screenshots/WindowsEditor/");
-		const FString SSFile = SSDir + FString::Printf(
-			TEXT("Pipeline_%s.png"), *FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S")));
-		IFileManager::Get().MakeDirectory(*SSDir, true);
-		FScreenshotRequest::RequestScreenshot(SSFile, false, false);
-		ScreenshotPath = SSFile;
-	}
-
-	// ── Save level ────────────────────────────────────────────────────────────
-	const bool bShouldSaveLevel = !Args.IsValid() || !Args->HasField(TEXT("save_level")) || Args->GetBoolField(TEXT("save_level"));
-	bool bLevelSaved = false;
-	FString LevelSaveSkippedReason;
-	if (bShouldSaveLevel)
+		if (!Run->World.IsValid()) { return WorldLost(J); }
+		Run->P3Json = ParseResult(ApplySetDressingAndStorytelling(Run->P3Args));
+		NoteRoomProps(*Run, Run->P3Json);
+		J.AddPartialResult(Run->P3Json);
+		return true;
+	}, 1.0f);
+
+	// ── Stage: Phase IV + V closed-loop refinement, one iteration per slice ──
+	// The first iteration lights and populates the whole level. Later ones rerun
+	// only the phases the measured shortfall depends on, on the affected rooms:
+	// Phase IV on rooms without a fill light, Phase III on rooms short of props.
+	// Phase V feeds no quality check and is not rerun.
+	Job->AddStage(TEXT("phase4_5_refinement"), [Run, ParseResult, WorldLost](FAgentForgeJob& J)
 	{
-		TArray<UPackage*> DirtyPackages;
-		UPackage* PersistentPackage = World->PersistentLevel ? World->PersistentLevel->GetOutermost() : nullptr;
-		const FString PackageName = PersistentPackage ? PersistentPackage->GetName() : FString();
-		const bool bHasUntitledName = !PackageName.IsEmpty() && PackageName.Contains(TEXT("Untitled"));
-		const bool bRequiresSaveAs = PersistentPackage == nullptr
-			|| PersistentPackage->HasAnyPackageFlags(PKG_NewlyCreated)
-			|| PersistentPackage->GetLoadedPath().IsEmpty()
-			|| bHasUntitledName;
-		if (bRequiresSaveAs)
+		UWorld* World = Run->World.Get();
+		if (!World) { return WorldLost(J); }
+
+		++Run->Iteration;
+		TSharedPtr<FJsonObject> IterJ = MakeShared<FJsonObject>();
+		IterJ->SetNumberField(TEXT("iteration"), Run->Iteration);
+		if (Run->Iteration == 1)
 		{
-			LevelSaveSkippedReason = TEXT("Skipping level save for unsaved or untitled map in unattended flow.");
+			Run->P4Json = ParseResult(ApplyProfessionalLightingAndAtmosphere(Run->P4Args));
+			Run->P5Json = ParseResult(AddLivingSystemsAndPolish(Run->P5Args));
 		}
 		else
 		{
-			DirtyPackages.Add(PersistentPackage);
-			if (!DirtyPackages.IsEmpty())
+			const FQualityShortfall& Rerun = Run->Pending;
+			if (!Rerun.DressRooms.IsEmpty())
+			{
+				TSharedPtr<FJsonObject> P3 = ParseResult(ApplySetDressingAndStorytelling(WithRooms(Run->P3Args, Rerun.DressRooms)));
+				NoteRoomProps(*Run, P3);
+				if (P3.IsValid()) { IterJ->SetObjectField(TEXT("phase3"), P3); }
+			}
+			if (!Rerun.LightRooms.IsEmpty())
 			{
-				bLevelSaved = (FEditorFileUtils::PromptForCheckoutAndSave(DirtyPackages, false, false)
-				               == FEditorFileUtils::EPromptReturnCode::PR_Success);
+				TSharedPtr<FJsonObject> P4 = ParseResult(ApplyProfessionalLightingAndAtmosphere(WithRooms(Run->P4Args, Rerun.LightRooms)));
+				if (P4.IsValid()) { IterJ->SetObjectField(TEXT("phase4"), P4); }
 			}
 		}
-	}
-	else
+		Run->QualScore = EvaluateLevelQuality(World, Run->Preset);
+		IterJ->SetNumberField(TEXT("quality_score"), Run->QualScore);
+
+		bool bDone = Run->QualScore >= Run->QualThresh || Run->Iteration >= Run->MaxIter;
+		if (!bDone)
+		{
+			Run->Pending = FindQualityShortfall(*Run);
+			IterJ->SetArrayField(TEXT("shortfalls"),     ToJsonStrings(Run->Pending.Reasons));
+			IterJ->SetArrayField(TEXT("rerun_dressing"), ToJsonStrings(Run->Pending.DressRooms));
+			IterJ->SetArrayField(TEXT("rerun_lighting"), ToJsonStrings(Run->Pending.LightRooms));
+			if (!Run->Pending.CanRerun())
+			{
+				// Another pass would rebuild the same outputs for the same score.
+				Run->StopReason = TEXT("no_rerunnable_shortfall");
+				bDone = true;
+			}
+		}
+		else
+		{
+			Run->StopReason = Run->QualScore >= Run->QualThresh ? TEXT("quality_threshold_met") : TEXT("max_iterations");
+		}
+		Run->IterationLog.Add(MakeShared<FJsonValueObject>(IterJ));
+		J.AddPartialResult(IterJ);
+		J.SetStageProgress(static_cast<float>(Run->Iteration) / static_cast<float>(Run->MaxIter));
+		return bDone;
+	}, 2.0f);
+
+	// ── Finalize — screenshot, save, quality report, master response ─────────
+	Job->SetFinalizer([Run](FAgentForgeJob&) -> FString
 	{
-		LevelSaveSkippedReason = TEXT("save_level=false");
-	}
+		UWorld* World = Run->World.Get();
+		if (!World) { return ToJson(ErrObj(TEXT("Editor world changed while generate_full_quality_level was running."))); }
+		const TSharedPtr<FJsonObject>& Args = Run->Args;
 
-	// ── Quality report ────────────────────────────────────────────────────────
-	TSharedPtr<FJsonObject> QualReport = BuildQualityReport(World, Preset);
+		// ── Screenshot ────────────────────────────────────────────────────────
+		FString ScreenshotPath;
+		{
+			const FString SSDir  = FPaths::ProjectSavedDir() / TEXT("Screenshots/WindowsEditor/");
+			const FString SSFile = SSDir + FString::Printf(
+				TEXT("Pipeline_%s.png"), *FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S")));
+			IFileManager::Get().MakeDirectory(*SSDir, true);
+			FScreenshotRequest::RequestScreenshot(SSFile, false, false);
+			ScreenshotPath = SSFile;
+		}
 
-	// ── Compose master response ───────────────────────────────────────────────
-	TSharedPtr<FJsonObject> Resp = MakeShared<FJsonObject>();
-	Resp->SetBoolField  (TEXT("ok"),                  true);
-	Resp->SetStringField(TEXT("mission"),             Mission);
-	Resp->SetStringField(TEXT("preset"),              PresetName);
-	Resp->SetNumberField(TEXT("final_quality_score"), QualScore);
-	Resp->SetNumberField(TEXT("iterations"),          static_cast<double>(Iteration));
-	Resp->SetStringField(TEXT("screenshot_path"),     ScreenshotPath);
-	Resp->SetBoolField  (TEXT("level_saved"),         bLevelSaved);
-	if (!LevelSaveSkippedReason.IsEmpty())
-	{
-		Resp->SetStringField(TEXT("level_save_skipped_reason"), LevelSaveSkippedReason);
-	}
-	if (P1Json.IsValid()) Resp->SetObjectField(TEXT("phase1"), P1Json);
-	if (P2Json.IsValid()) Resp->SetObjectField(TEXT("phase2"), P2Json);
-	if (P3Json.IsValid()) Resp->SetObjectField(TEXT("phase3"), P3Json);
-	if (P4Json.IsValid()) Resp->SetObjectField(TEXT("phase4"), P4Json);
-	if (P5Json.IsValid()) Resp->SetObjectField(TEXT("phase5"), P5Json);
-	if (QualReport.IsValid()) Resp->SetObjectField(TEXT("quality_report"), QualReport);
-	return ToJson(Resp);
+		// ── Save level ────────────────────────────────────────────────────────
+		const bool bShouldSaveLevel = !Args.IsValid() || !Args->HasField(TEXT("save_level")) || Args->GetBoolField(TEXT("save_level"));
+		bool bLevelSaved = false;
+		FString LevelSaveSkippedReason;
+		if (bShouldSaveLevel)
+		{
+			TArray<UPackage*> DirtyPackages;
+			UPackage* PersistentPackage = World->PersistentLevel ? World->PersistentLevel->GetOutermost() : nullptr;
+			const FString PackageName = PersistentPackage ? PersistentPackage->GetName() : FString();
+			const bool bHasUntitledName = !PackageName.IsEmpty() && PackageName.Contains(TEXT("Untitled"));
+			const bool bRequiresSaveAs = PersistentPackage == nullptr
+				|| PersistentPackage->HasAnyPackageFlags(PKG_NewlyCreated)
+				|| PersistentPackage->GetLoadedPath().IsEmpty()
+				|| bHasUntitledName;
+			if (bRequiresSaveAs)
+			{
+				LevelSaveSkippedReason = TEXT("Skipping level save for unsaved or untitled map in unattended flow.");
+			}
+			else
+			{
+				DirtyPackages.Add(PersistentPackage);
+				if (!DirtyPackages.IsEmpty())
+				{
+					bLevelSaved = (FEditorFileUtils::PromptForCheckoutAndSave(DirtyPackages, false, false)
+					               == FEditorFileUtils::EPromptReturnCode::PR_Success);
+				}
+			}
+		}
+		else
+		{
+			LevelSaveSkippedReason = TEXT("save_level=false");
+		}
+
+		// ── Quality report ────────────────────────────────────────────────────
+		TSharedPtr<FJsonObject> QualReport = BuildQualityReport(World, Run->Preset);
+
+		// ── Compose master response ───────────────────────────────────────────
+		TSharedPtr<FJsonObject> Resp = MakeShared<FJsonObject>();
+		Resp->SetBoolField  (TEXT("ok"),                  true);
+		Resp->SetStringField(TEXT("mission"),             Run->Mission);
+		Resp->SetStringField(TEXT("preset"),              Run->PresetName);
+		Resp->SetNumberField(TEXT("final_quality_score"), Run->QualScore);
+		Resp->SetNumberField(TEXT("iterations"),          static_cast<double>(Run->Iteration));
+		Resp->SetStringField(TEXT("stop_reason"),         Run->StopReason);
+		Resp->SetArrayField (TEXT("iteration_log"),       Run->IterationLog);
+		Resp->SetStringField(TEXT("screenshot_path"),     ScreenshotPath);
+		Resp->SetBoolField  (TEXT("level_saved"),         bLevelSaved);
+		if (!LevelSaveSkippedReason.IsEmpty())
+		{
+			Resp->SetStringField(TEXT("level_save_skipped_reason"), LevelSaveSkippedReason);
+		}
+		if (Run->P1Json.IsValid()) Resp->SetObjectField(TEXT("phase1"), Run->P1Json);
+		if (Run->P2Json.IsValid()) Resp->SetObjectField(TEXT("phase2"), Run->P2Json);
+		if (Run->P3Json.IsValid()) Resp->SetObjectField(TEXT("phase3"), Run->P3Json);
+		if (Run->P4Json.IsValid()) Resp->SetObjectField(TEXT("phase4"), Run->P4Json);
+		if (Run->P5Json.IsValid()) Resp->SetObjectField(TEXT("phase5"), Run->P5Json);
+		if (QualReport.IsValid()) Resp->SetObjectField(TEXT("quality_report"), QualReport);
+		return ToJson(Resp);
+	});
+	Job->SetCancelHandler([Run](FAgentForgeJob&)
+	{
+		// Phases II–V commit their own transactions; only an in-flight blockout is rolled back.
+		if (Run->SubJob.IsValid()) { Run->SubJob->Cancel(); Run->SubJob.Reset(); }
+	});
 #else
-	return ToJson(ErrObj(TEXT("WITH_EDITOR required.")));
+	Job->AddStage(TEXT("prepare"), [](FAgentForgeJob& J) { J.Finish(ToJson(ErrObj(TEXT("WITH_EDITOR required.")))); return true; });
 #endif
+	return Job;
 }
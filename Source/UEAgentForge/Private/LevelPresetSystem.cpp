@@ -1,5 +1,5 @@
 // Copyright UEAgentForge Project. All Rights Reserved.
-// LevelPresetSystem.cpp — v0.4.0 preset registry implementation.
+// LevelPresetSystem.cpp — v0.4.0 preset registry implementation and header-indexed preset store.
 
 #include "LevelPresetSystem.h"
 
@@ -11,9 +11,12 @@
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
 #include "HAL/FileManager.h"
+#include "Modules/ModuleManager.h"
 #include "EngineUtils.h"
 
 #if WITH_EDITOR
+#include "DirectoryWatcherModule.h"
+#include "IDirectoryWatcher.h"
 #include "Editor.h"
 #include "Engine/PostProcessVolume.h"
 #include "Engine/ExponentialHeightFog.h"
@@ -25,6 +28,35 @@
 // ─────────────────────────────────────────────────────────────────────────────
 TMap<FString, FLevelPreset> FLevelPresetSystem::LoadedPresets;
 FString                     FLevelPresetSystem::CurrentPresetName = TEXT("Default");
+TMap<FString, FLevelPreset> FLevelPresetSystem::BuiltinPresets;
+TArray<FString>             FLevelPresetSystem::BuiltinOrder;
+TMap<FString, FLevelPresetSystem::FPresetHeader> FLevelPresetSystem::PresetFiles;
+TMap<FString, FString>      FLevelPresetSystem::PresetByName;
+
+namespace
+{
+	// Header fields are written first (PresetToJson), so a short read covers them.
+	static constexpr int64 PresetHeaderReadBytes = 4096;
+
+	struct FPresetStoreState
+	{
+		bool  bReady = false;
+		int64 HeaderReads = 0;
+		int64 FullParses = 0;
+		int64 WatcherEvents = 0;
+		int64 Rescans = 0;
+		FDelegateHandle SavedWatchHandle;
+		FDelegateHandle LegacyWatchHandle;
+		FString SavedWatchDir;
+		FString LegacyWatchDir;
+	};
+
+	static FPresetStoreState& GetPresetStore()
+	{
+		static FPresetStoreState State;
+		return State;
+	}
+}
 
 // ─────────────────────────────────────────────────────────────────────────────
 //  Helpers
@@ -39,6 +71,21 @@ static FString LegacyPresetDir()
 	return FPaths::ProjectContentDir() / TEXT("AgentForge/Presets/");
 }
 
+static FString NormalizePresetPath(const FString& Path)
+{
+	FString Full = FPaths::ConvertRelativePathToFull(Path);
+	FPaths::NormalizeFilename(Full);
+	return Full;
+}
+
+static bool LoadPresetJsonFile(const FString& FilePath, TSharedPtr<FJsonObject>& OutJson)
+{
+	FString JsonStr;
+	if (!FFileHelper::LoadFileToString(JsonStr, *FilePath)) { return false; }
+	TSharedRef<TJsonReader<>> R = TJsonReaderFactory<>::Create(JsonStr);
+	return FJsonSerializer::Deserialize(R, OutJson) && OutJson.IsValid();
+}
+
 static FString ToJson(const TSharedPtr<FJsonObject>& Obj)
 {
 	FString Out;
@@ -70,7 +117,13 @@ static bool TryGetPresetNameArg(const TSharedPtr<FJsonObject>& Args, FString& Ou
 TSharedPtr<FJsonObject> FLevelPresetSystem::PresetToJson(const FLevelPreset& P)
 {
 	TSharedPtr<FJsonObject> J = MakeShared<FJsonObject>();
+	// Header fields first: the preset store indexes files from their first few KB.
 	J->SetStringField(TEXT("preset_name"),             P.PresetName);
+	J->SetStringField(TEXT("genre"),                   P.Genre);
+	TArray<TSharedPtr<FJsonValue>> TagArr;
+	for (const FString& Tag : P.Tags)
+		TagArr.Add(MakeShared<FJsonValueString>(Tag));
+	J->SetArrayField (TEXT("tags"),                    TagArr);
 	J->SetStringField(TEXT("description"),             P.Description);
 	// Phase I
 	J->SetNumberField(TEXT("standard_door_width_cm"),     P.StandardDoorWidthCm);
@@ -107,6 +160,10 @@ TSharedPtr<FJsonObject> FLevelPresetSystem::PresetToJson(const FLevelPreset& P)
 	J->SetNumberField(TEXT("target_lighting_coverage"), P.TargetLightingCoverage);
 	J->SetNumberField(TEXT("min_actor_count"),          static_cast<double>(P.MinActorCount));
 	J->SetNumberField(TEXT("max_actor_count"),          static_cast<double>(P.MaxActorCount));
+	// Runtime budgets
+	J->SetNumberField(TEXT("max_shadow_light_overlap"), static_cast<double>(P.MaxShadowLightOverlap));
+	J->SetNumberField(TEXT("max_particle_overdraw"),    P.MaxParticleOverdraw);
+	J->SetNumberField(TEXT("max_audio_voices"),         static_cast<double>(P.MaxAudioVoices));
 	return J;
 }
 
@@ -116,6 +173,10 @@ FLevelPreset FLevelPresetSystem::JsonToPreset(const TSharedPtr<FJsonObject>& J)
 	if (!J.IsValid()) { return P; }
 
 	J->TryGetStringField(TEXT("preset_name"),             P.PresetName);
+	J->TryGetStringField(TEXT("genre"),                   P.Genre);
+	const TArray<TSharedPtr<FJsonValue>>* TagArr;
+	if (J->TryGetArrayField(TEXT("tags"), TagArr))
+		for (const auto& V : *TagArr) { FString S; if (V->TryGetString(S) && !S.IsEmpty()) { P.Tags.Add(S); } }
 	J->TryGetStringField(TEXT("description"),             P.Description);
 	// Phase I
 	J->TryGetNumberField(TEXT("standard_door_width_cm"),     P.StandardDoorWidthCm);
@@ -156,14 +217,28 @@ FLevelPreset FLevelPresetSystem::JsonToPreset(const TSharedPtr<FJsonObject>& J)
 	J->TryGetNumberField(TEXT("max_actor_count"), MaxA);
 	P.MinActorCount = static_cast<int32>(MinA);
 	P.MaxActorCount = static_cast<int32>(MaxA);
+	// Runtime budgets
+	J->TryGetNumberField(TEXT("max_shadow_light_overlap"), P.MaxShadowLightOverlap);
+	J->TryGetNumberField(TEXT("max_particle_overdraw"),    P.MaxParticleOverdraw);
+	J->TryGetNumberField(TEXT("max_audio_voices"),         P.MaxAudioVoices);
 	return P;
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
-//  RegisterBuiltinPresets — called once at module startup
+//  RegisterBuiltinPresets — once per session, from the first preset call
 // ─────────────────────────────────────────────────────────────────────────────
 void FLevelPresetSystem::RegisterBuiltinPresets()
 {
+	FPresetStoreState& Store = GetPresetStore();
+	if (Store.bReady) { return; }
+	Store.bReady = true;
+
+	auto AddBuiltin = [](const FLevelPreset& P)
+	{
+		BuiltinPresets.Add(P.PresetName, P);
+		BuiltinOrder.Add(P.PresetName);
+	};
+
 	// ── Default ──────────────────────────────────────────────────────────────
 	{
 		FLevelPreset P;
@@ -177,13 +252,14 @@ void FLevelPresetSystem::RegisterBuiltinPresets()
 		P.TargetLightingCoverage      = 0.7f;
 		P.MinActorCount               = 10;
 		P.MaxActorCount               = 500;
-		LoadedPresets.Add(TEXT("Default"), P);
+		AddBuiltin(P);
 	}
 
 	// ── Horror ───────────────────────────────────────────────────────────────
 	{
 		FLevelPreset P;
 		P.PresetName                  = TEXT("Horror");
+		P.Genre                       = TEXT("horror");
 		P.Description                 = TEXT("Dark survival horror — oppressive lighting, high particle density, optional god rays.");
 		P.StandardCeilingHeightCm     = 280.f;
 		P.MinCorridorWidthCm          = 130.f;
@@ -201,13 +277,14 @@ void FLevelPresetSystem::RegisterBuiltinPresets()
 		P.MaxActorCount               = 400;
 		P.PreferredModularKitPaths.Add(TEXT("/Game/Gothic_Cathedral/Meshes/"));
 		P.PreferredMaterialPaths.Add(TEXT("/Game/Gothic_Cathedral/Materials/"));
-		LoadedPresets.Add(TEXT("Horror"), P);
+		AddBuiltin(P);
 	}
 
 	// ── SciFi ─────────────────────────────────────────────────────────────────
 	{
 		FLevelPreset P;
 		P.PresetName                  = TEXT("SciFi");
+		P.Genre                       = TEXT("scifi");
 		P.Description                 = TEXT("Clean technological spaces — cool blue ambient, glow particles, minimal weathering.");
 		P.StandardCeilingHeightCm     = 350.f;
 		P.StandardDoorWidthCm         = 220.f;
@@ -224,13 +301,14 @@ void FLevelPresetSystem::RegisterBuiltinPresets()
 		P.MinActorCount               = 15;
 		P.MaxActorCount               = 500;
 		P.PreferredModularKitPaths.Add(TEXT("/Game/SciFi/Meshes/"));
-		LoadedPresets.Add(TEXT("SciFi"), P);
+		AddBuiltin(P);
 	}
 
 	// ── Fantasy ───────────────────────────────────────────────────────────────
 	{
 		FLevelPreset P;
 		P.PresetName                  = TEXT("Fantasy");
+		P.Genre                       = TEXT("fantasy");
 		P.Description                 = TEXT("Warm golden atmosphere — high ambient, rich set dressing, nature particles.");
 		P.StandardCeilingHeightCm     = 400.f;
 		P.AmbientLightColor           = FLinearColor(0.25f, 0.18f, 0.07f, 1.f);
@@ -246,13 +324,14 @@ void FLevelPresetSystem::RegisterBuiltinPresets()
 		P.MinActorCount               = 25;
 		P.MaxActorCount               = 600;
 		P.PreferredModularKitPaths.Add(TEXT("/Game/Fantasy/Meshes/"));
-		LoadedPresets.Add(TEXT("Fantasy"), P);
+		AddBuiltin(P);
 	}
 
 	// ── Military ──────────────────────────────────────────────────────────────
 	{
 		FLevelPreset P;
 		P.PresetName                  = TEXT("Military");
+		P.Genre                       = TEXT("military");
 		P.Description                 = TEXT("WW2 / modern military — olive/grey ambient, sparse prop density, functional corridors.");
 		P.StandardCeilingHeightCm     = 250.f;
 		P.StandardDoorWidthCm         = 180.f;
@@ -270,35 +349,288 @@ void FLevelPresetSystem::RegisterBuiltinPresets()
 		P.MinActorCount               = 15;
 		P.MaxActorCount               = 450;
 		P.PreferredModularKitPaths.Add(TEXT("/Game/Military/Meshes/"));
-		LoadedPresets.Add(TEXT("Military"), P);
+		AddBuiltin(P);
 	}
 
-	// Overlay any JSON presets found on disk.
+	// Index the preset files by header only; presets parse on first use.
 	ScanPresetDir();
+
+#if WITH_EDITOR
+	// Pick up edits without rescanning. A legacy folder created later is only seen after a restart.
+	if (FDirectoryWatcherModule* WatcherModule = FModuleManager::LoadModulePtr<FDirectoryWatcherModule>(TEXT("DirectoryWatcher")))
+	{
+		if (IDirectoryWatcher* Watcher = WatcherModule->Get())
+		{
+			IFileManager::Get().MakeDirectory(*PresetDir(), /*Tree=*/true);
+			Store.SavedWatchDir = NormalizePresetPath(PresetDir());
+			Watcher->RegisterDirectoryChangedCallback_Handle(Store.SavedWatchDir,
+				IDirectoryWatcher::FDirectoryChanged::CreateStatic(&FLevelPresetSystem::HandlePresetDirChanged, false),
+				Store.SavedWatchHandle, 0);
+			if (IFileManager::Get().DirectoryExists(*LegacyPresetDir()))
+			{
+				Store.LegacyWatchDir = NormalizePresetPath(LegacyPresetDir());
+				Watcher->RegisterDirectoryChangedCallback_Handle(Store.LegacyWatchDir,
+					IDirectoryWatcher::FDirectoryChanged::CreateStatic(&FLevelPresetSystem::HandlePresetDirChanged, true),
+					Store.LegacyWatchHandle, 0);
+			}
+		}
+	}
+#endif
+}
+
+void FLevelPresetSystem::ShutdownPresetStore()
+{
+#if WITH_EDITOR
+	FPresetStoreState& Store = GetPresetStore();
+	FDirectoryWatcherModule* WatcherModule = FModuleManager::GetModulePtr<FDirectoryWatcherModule>(TEXT("DirectoryWatcher"));
+	IDirectoryWatcher* Watcher = WatcherModule ? WatcherModule->Get() : nullptr;
+	if (Watcher && Store.SavedWatchHandle.IsValid())
+	{
+		Watcher->UnregisterDirectoryChangedCallback_Handle(Store.SavedWatchDir, Store.SavedWatchHandle);
+	}
+	if (Watcher && Store.LegacyWatchHandle.IsValid())
+	{
+		Watcher->UnregisterDirectoryChangedCallback_Handle(Store.LegacyWatchDir, Store.LegacyWatchHandle);
+	}
+	Store.SavedWatchHandle.Reset();
+	Store.LegacyWatchHandle.Reset();
+#endif
 }
 
+// ─────────────────────────────────────────────────────────────────────────────
+//  Preset store — header index, lazy parse, directory watcher upkeep
 // ─────────────────────────────────────────────────────────────────────────────
 void FLevelPresetSystem::ScanPresetDir()
 {
-	const TArray<FString> Dirs = { PresetDir(), LegacyPresetDir() };
-	for (const FString& Dir : Dirs)
+	++GetPresetStore().Rescans;
+	PresetFiles.Reset();
+	const TArray<TPair<FString, bool>> Dirs = { { PresetDir(), false }, { LegacyPresetDir(), true } };
+	for (const TPair<FString, bool>& Dir : Dirs)
 	{
 		TArray<FString> Files;
-		IFileManager::Get().FindFiles(Files, *(Dir + TEXT("*.json")), true, false);
+		IFileManager::Get().FindFiles(Files, *(Dir.Key + TEXT("*.json")), true, false);
 		for (const FString& File : Files)
 		{
-			FString JsonStr;
-			if (!FFileHelper::LoadFileToString(JsonStr, *(Dir + File))) { continue; }
-			TSharedPtr<FJsonObject> J;
-			TSharedRef<TJsonReader<>> R = TJsonReaderFactory<>::Create(JsonStr);
-			if (!FJsonSerializer::Deserialize(R, J) || !J.IsValid()) { continue; }
+			IndexPresetFile(NormalizePresetPath(Dir.Key + File), Dir.Value);
+		}
+	}
+	RebuildPresetNames();
+}
+
+void FLevelPresetSystem::IndexPresetFile(const FString& FilePath, bool bLegacy)
+{
+	FPresetHeader Header;
+	Header.bLegacy = bLegacy;
+	if (ReadPresetHeader(FilePath, Header))
+	{
+		PresetFiles.Add(FilePath, MoveTemp(Header));
+	}
+	else
+	{
+		PresetFiles.Remove(FilePath);
+	}
+}
+
+bool FLevelPresetSystem::ReadPresetHeader(const FString& FilePath, FPresetHeader& OutHeader)
+{
+	const FFileStatData Stat = IFileManager::Get().GetStatData(*FilePath);
+	if (!Stat.bIsValid || Stat.bIsDirectory) { return false; }
+	OutHeader.FilePath     = FilePath;
+	OutHeader.ModifiedTime = Stat.ModificationTime;
+	OutHeader.FileSize     = Stat.FileSize;
+	++GetPresetStore().HeaderReads;
+
+	// Read only the head of the file and token-scan its top-level fields; a
+	// truncated object just ends the scan.
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*FilePath));
+	if (!Reader) { return false; }
+	const int64 HeadBytes = FMath::Min(Reader->TotalSize(), PresetHeaderReadBytes);
+	TArray<uint8> Head;
+	Head.SetNumUninitialized(static_cast<int32>(HeadBytes));
+	Reader->Serialize(Head.GetData(), HeadBytes);
+	Reader.Reset();
+
+	FString HeadText;
+	FFileHelper::BufferToString(HeadText, Head.GetData(), Head.Num());
+
+	TSharedRef<TJsonReader<>> Json = TJsonReaderFactory<>::Create(HeadText);
+	EJsonNotation Notation;
+	int32 Depth = 0;
+	bool bInTags = false, bName = false, bGenre = false, bTags = false;
+	while (!(bName && bGenre && bTags) && Json->ReadNext(Notation))
+	{
+		if (Notation == EJsonNotation::ObjectStart || Notation == EJsonNotation::ArrayStart)
+		{
+			bInTags = Depth == 1 && Notation == EJsonNotation::ArrayStart && Json->GetIdentifier() == TEXT("tags");
+			++Depth;
+		}
+		else if (Notation == EJsonNotation::ObjectEnd || Notation == EJsonNotation::ArrayEnd)
+		{
+			if (--Depth <= 0) { break; }
+			if (bInTags && Depth == 1) { bInTags = false; bTags = true; }
+		}
+		else if (Notation == EJsonNotation::String)
+		{
+			if (bInTags && Depth == 2)                                          { OutHeader.Tags.Add(Json->GetValueAsString()); }
+			else if (Depth == 1 && Json->GetIdentifier() == TEXT("preset_name")) { OutHeader.Name  = Json->GetValueAsString(); bName = true; }
+			else if (Depth == 1 && Json->GetIdentifier() == TEXT("genre"))       { OutHeader.Genre = Json->GetValueAsString(); bGenre = true; }
+		}
+	}
+
+	// Hand-written files may put the name late; fall back to a full parse.
+	if (OutHeader.Name.IsEmpty() && HeadBytes < Stat.FileSize)
+	{
+		++GetPresetStore().FullParses;
+		TSharedPtr<FJsonObject> J;
+		if (LoadPresetJsonFile(FilePath, J))
+		{
+			const FLevelPreset P = JsonToPreset(J);
+			OutHeader.Name  = P.PresetName;
+			OutHeader.Genre = P.Genre;
+			OutHeader.Tags  = P.Tags;
+		}
+	}
+	return !OutHeader.Name.IsEmpty();
+}
+
+void FLevelPresetSystem::RebuildPresetNames()
+{
+	// Saved beats legacy; within a folder the lowest path wins, so the choice is stable.
+	PresetByName.Reset();
+	for (const TPair<FString, FPresetHeader>& File : PresetFiles)
+	{
+		const FPresetHeader& Header = File.Value;
+		FString* Existing = PresetByName.Find(Header.Name);
+		if (!Existing)
+		{
+			PresetByName.Add(Header.Name, File.Key);
+			continue;
+		}
+		const FPresetHeader& Current = PresetFiles[*Existing];
+		if ((Current.bLegacy && !Header.bLegacy) || (Current.bLegacy == Header.bLegacy && File.Key < *Existing))
+		{
+			*Existing = File.Key;
+		}
+	}
+}
+
+const FLevelPresetSystem::FPresetHeader* FLevelPresetSystem::FindPresetHeader(const FString& NameOrFile)
+{
+	if (const FString* Path = PresetByName.Find(NameOrFile))
+	{
+		return PresetFiles.Find(*Path);
+	}
+	// load_preset also accepts the file name.
+	for (const TPair<FString, FPresetHeader>& File : PresetFiles)
+	{
+		if (FPaths::GetBaseFilename(File.Key).Equals(NameOrFile, ESearchCase::IgnoreCase))
+		{
+			return PresetByName.FindRef(File.Value.Name) == File.Key ? &File.Value : nullptr;
+		}
+	}
+	return nullptr;
+}
+
+const FLevelPreset* FLevelPresetSystem::EnsurePresetParsed(const FString& Name)
+{
+	RegisterBuiltinPresets();
+	if (const FLevelPreset* Parsed = LoadedPresets.Find(Name))
+	{
+		return Parsed;
+	}
+
+	if (const FPresetHeader* Header = FindPresetHeader(Name))
+	{
+		if (const FLevelPreset* Parsed = LoadedPresets.Find(Header->Name))
+		{
+			return Parsed;
+		}
+		++GetPresetStore().FullParses;
+		TSharedPtr<FJsonObject> J;
+		if (LoadPresetJsonFile(Header->FilePath, J))
+		{
 			FLevelPreset P = JsonToPreset(J);
-			if (!P.PresetName.IsEmpty())
+			if (P.PresetName.IsEmpty()) { P.PresetName = Header->Name; }
+			const FString Key = P.PresetName;
+			return &LoadedPresets.Add(Key, MoveTemp(P));
+		}
+	}
+
+	if (const FLevelPreset* Builtin = BuiltinPresets.Find(Name))
+	{
+		return &LoadedPresets.Add(Builtin->PresetName, *Builtin);
+	}
+	return nullptr;
+}
+
+void FLevelPresetSystem::HandlePresetDirChanged(const TArray<FFileChangeData>& Changes, bool bLegacy)
+{
+#if WITH_EDITOR
+	FPresetStoreState& Store = GetPresetStore();
+	bool bRescan = false;
+	TSet<FString> Affected;
+	for (const FFileChangeData& Change : Changes)
+	{
+		++Store.WatcherEvents;
+		if (Change.Action == FFileChangeData::FCA_RescanRequired)
+		{
+			bRescan = true;
+			continue;
+		}
+		if (!FPaths::GetExtension(Change.Filename).Equals(TEXT("json"), ESearchCase::IgnoreCase))
+		{
+			continue;
+		}
+
+		const FString FilePath = NormalizePresetPath(Change.Filename);
+		const FPresetHeader* Old = PresetFiles.Find(FilePath);
+		if (Old)
+		{
+			// Editors and SavePreset fire several events per write; unchanged stamps are no-ops.
+			const FFileStatData Stat = IFileManager::Get().GetStatData(*FilePath);
+			if (Stat.bIsValid && Stat.ModificationTime == Old->ModifiedTime && Stat.FileSize == Old->FileSize)
 			{
-				LoadedPresets.Add(P.PresetName, P);
+				continue;
 			}
+			Affected.Add(Old->Name);
+		}
+		IndexPresetFile(FilePath, bLegacy);
+		if (const FPresetHeader* New = PresetFiles.Find(FilePath))
+		{
+			Affected.Add(New->Name);
 		}
 	}
+
+	if (bRescan)
+	{
+		ScanPresetDir();
+		LoadedPresets.Reset();
+		return;
+	}
+	if (Affected.Num() == 0)
+	{
+		return;
+	}
+	RebuildPresetNames();
+	for (const FString& Name : Affected)
+	{
+		LoadedPresets.Remove(Name);   // re-parsed (or the built-in restored) on next use
+	}
+#endif
+}
+
+TSharedPtr<FJsonObject> FLevelPresetSystem::GetStatsJson()
+{
+	const FPresetStoreState& Store = GetPresetStore();
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetNumberField(TEXT("headers"),        PresetFiles.Num());
+	Obj->SetNumberField(TEXT("parsed"),         LoadedPresets.Num());
+	Obj->SetNumberField(TEXT("header_reads"),   static_cast<double>(Store.HeaderReads));
+	Obj->SetNumberField(TEXT("full_parses"),    static_cast<double>(Store.FullParses));
+	Obj->SetNumberField(TEXT("watcher_events"), static_cast<double>(Store.WatcherEvents));
+	Obj->SetNumberField(TEXT("rescans"),        static_cast<double>(Store.Rescans));
+	Obj->SetBoolField  (TEXT("watching"),       Store.SavedWatchHandle.IsValid());
+	return Obj;
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
@@ -306,9 +638,9 @@ void FLevelPresetSystem::ScanPresetDir()
 // ─────────────────────────────────────────────────────────────────────────────
 bool FLevelPresetSystem::SetCurrentPreset(const FString& Name)
 {
-	if (LoadedPresets.Contains(Name))
+	if (const FLevelPreset* Found = EnsurePresetParsed(Name))
 	{
-		CurrentPresetName = Name;
+		CurrentPresetName = Found->PresetName;
 		return true;
 	}
 	return false;
@@ -317,7 +649,7 @@ bool FLevelPresetSystem::SetCurrentPreset(const FString& Name)
 const FLevelPreset& FLevelPresetSystem::GetCurrentPresetData()
 {
 	static FLevelPreset FallbackDefault;
-	const FLevelPreset* Found = LoadedPresets.Find(CurrentPresetName);
+	const FLevelPreset* Found = EnsurePresetParsed(CurrentPresetName);
 	return Found ? *Found : FallbackDefault;
 }
 
@@ -334,44 +666,11 @@ FString FLevelPresetSystem::LoadPreset(const TSharedPtr<FJsonObject>& Args)
 		return ToJson(Err);
 	}
 
-	// Ensure built-ins are available (idempotent if already registered).
-	if (LoadedPresets.Num() == 0) { RegisterBuiltinPresets(); }
-
-	// Try JSON file first.
-	const TArray<FString> CandidateFiles =
-	{
-		PresetDir() + Name + TEXT(".json"),
-		LegacyPresetDir() + Name + TEXT(".json"),
-	};
-	for (const FString& FilePath : CandidateFiles)
-	{
-		if (!IFileManager::Get().FileExists(*FilePath))
-		{
-			continue;
-		}
-
-		FString JsonStr;
-		if (!FFileHelper::LoadFileToString(JsonStr, *FilePath))
-		{
-			continue;
-		}
-
-		TSharedPtr<FJsonObject> J;
-		TSharedRef<TJsonReader<>> R = TJsonReaderFactory<>::Create(JsonStr);
-		if (FJsonSerializer::Deserialize(R, J) && J.IsValid())
-		{
-			FLevelPreset P = JsonToPreset(J);
-			LoadedPresets.Add(P.PresetName, P);
-			CurrentPresetName = P.PresetName;
-			return ToJson(PresetToJson(P));
-		}
-	}
-
-	// Check in-memory registry.
-	if (LoadedPresets.Contains(Name))
+	// Files (by preset or file name) before built-ins; parsed once, then served from the store.
+	if (const FLevelPreset* Found = EnsurePresetParsed(Name))
 	{
-		CurrentPresetName = Name;
-		return ToJson(PresetToJson(LoadedPresets[Name]));
+		CurrentPresetName = Found->PresetName;
+		return ToJson(PresetToJson(*Found));
 	}
 
 	TSharedPtr<FJsonObject> Err = MakeShared<FJsonObject>();
@@ -400,10 +699,17 @@ FString FLevelPresetSystem::SavePreset(const TSharedPtr<FJsonObject>& Args)
 	}
 
 	// Allow partial overrides on top of an existing preset.
-	if (LoadedPresets.Contains(P.PresetName)) { P = LoadedPresets[P.PresetName]; }
+	if (const FLevelPreset* Existing = EnsurePresetParsed(P.PresetName)) { P = *Existing; }
 	// Re-read name/desc after potential clobber.
 	TryGetPresetNameArg(Args, P.PresetName);
 	Args->TryGetStringField(TEXT("description"), P.Description);
+	Args->TryGetStringField(TEXT("genre"), P.Genre);
+	const TArray<TSharedPtr<FJsonValue>>* TagArr;
+	if (Args->TryGetArrayField(TEXT("tags"), TagArr))
+	{
+		P.Tags.Empty();
+		for (const auto& V : *TagArr) { FString S; if (V->TryGetString(S) && !S.IsEmpty()) { P.Tags.Add(S); } }
+	}
 	// Numeric fields
 	Args->TryGetNumberField(TEXT("standard_ceiling_height_cm"), P.StandardCeilingHeightCm);
 	Args->TryGetNumberField(TEXT("standard_door_width_cm"),     P.StandardDoorWidthCm);
@@ -420,6 +726,9 @@ FString FLevelPresetSystem::SavePreset(const TSharedPtr<FJsonObject>& Args)
 	Args->TryGetNumberField(TEXT("max_actor_count"), MaxA);
 	P.MinActorCount = static_cast<int32>(MinA);
 	P.MaxActorCount = static_cast<int32>(MaxA);
+	Args->TryGetNumberField(TEXT("max_shadow_light_overlap"),   P.MaxShadowLightOverlap);
+	Args->TryGetNumberField(TEXT("max_particle_overdraw"),      P.MaxParticleOverdraw);
+	Args->TryGetNumberField(TEXT("max_audio_voices"),           P.MaxAudioVoices);
 	// Bool fields
 	Args->TryGetBoolField(TEXT("enable_god_rays"),                P.bEnableGodRays);
 	Args->TryGetBoolField(TEXT("enable_ambient_particles"),       P.bEnableAmbientParticles);
@@ -455,6 +764,10 @@ FString FLevelPresetSystem::SavePreset(const TSharedPtr<FJsonObject>& Args)
 		IFileManager::Get().Delete(*LegacyFilePath, false, true, true);
 	}
 
+	// Index now rather than waiting for the watcher; its events for this write are then no-ops.
+	PresetFiles.Remove(NormalizePresetPath(LegacyFilePath));
+	IndexPresetFile(NormalizePresetPath(FilePath), false);
+	RebuildPresetNames();
 	LoadedPresets.Add(P.PresetName, P);
 	CurrentPresetName = P.PresetName;
 
@@ -467,15 +780,46 @@ FString FLevelPresetSystem::SavePreset(const TSharedPtr<FJsonObject>& Args)
 
 FString FLevelPresetSystem::ListPresets()
 {
-	if (LoadedPresets.Num() == 0) { RegisterBuiltinPresets(); }
-	ScanPresetDir();
+	RegisterBuiltinPresets();
+
+	// From the header index: nothing is parsed to list.
+	TArray<FString> FileNames;
+	PresetByName.GetKeys(FileNames);
+	FileNames.Sort();
 
 	TArray<TSharedPtr<FJsonValue>> Names;
-	for (const auto& KV : LoadedPresets)
-		Names.Add(MakeShared<FJsonValueString>(KV.Key));
+	TArray<TSharedPtr<FJsonValue>> Details;
+	auto AddEntry = [&](const FString& Name, const FString& Genre, const TArray<FString>& Tags, const TCHAR* Source)
+	{
+		Names.Add(MakeShared<FJsonValueString>(Name));
+		TSharedPtr<FJsonObject> D = MakeShared<FJsonObject>();
+		D->SetStringField(TEXT("name"),   Name);
+		D->SetStringField(TEXT("genre"),  Genre);
+		TArray<TSharedPtr<FJsonValue>> TagArr;
+		for (const FString& Tag : Tags)
+			TagArr.Add(MakeShared<FJsonValueString>(Tag));
+		D->SetArrayField (TEXT("tags"),   TagArr);
+		D->SetStringField(TEXT("source"), Source);
+		D->SetBoolField  (TEXT("parsed"), LoadedPresets.Contains(Name));
+		Details.Add(MakeShared<FJsonValueObject>(D));
+	};
+	for (const FString& Name : BuiltinOrder)
+	{
+		if (const FPresetHeader* Header = FindPresetHeader(Name))
+			AddEntry(Name, Header->Genre, Header->Tags, Header->bLegacy ? TEXT("legacy_file") : TEXT("file"));
+		else
+			AddEntry(Name, BuiltinPresets[Name].Genre, BuiltinPresets[Name].Tags, TEXT("builtin"));
+	}
+	for (const FString& Name : FileNames)
+	{
+		if (BuiltinPresets.Contains(Name)) { continue; }
+		const FPresetHeader& Header = PresetFiles[PresetByName[Name]];
+		AddEntry(Name, Header.Genre, Header.Tags, Header.bLegacy ? TEXT("legacy_file") : TEXT("file"));
+	}
 
 	TSharedPtr<FJsonObject> Resp = MakeShared<FJsonObject>();
 	Resp->SetArrayField(TEXT("presets"), Names);
+	Resp->SetArrayField(TEXT("details"), Details);
 	Resp->SetNumberField(TEXT("count"), static_cast<double>(Names.Num()));
 	return ToJson(Resp);
 }
@@ -483,7 +827,7 @@ FString FLevelPresetSystem::ListPresets()
 FString FLevelPresetSystem::SuggestPresetForProject()
 {
 #if WITH_EDITOR
-	if (LoadedPresets.Num() == 0) { RegisterBuiltinPresets(); }
+	RegisterBuiltinPresets();
 
 	FString SuggestedName = TEXT("Default");
 	FString Reasoning;
@@ -567,8 +911,7 @@ FString FLevelPresetSystem::SuggestPresetForProject()
 
 FString FLevelPresetSystem::GetCurrentPreset()
 {
-	if (LoadedPresets.Num() == 0) { RegisterBuiltinPresets(); }
-	const FLevelPreset* Found = LoadedPresets.Find(CurrentPresetName);
+	const FLevelPreset* Found = EnsurePresetParsed(CurrentPresetName);
 	if (!Found)
 	{
 		TSharedPtr<FJsonObject> Err = MakeShared<FJsonObject>();
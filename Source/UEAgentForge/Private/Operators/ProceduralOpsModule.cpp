@@ -3,15 +3,31 @@
 // ProceduralOpsModule.cpp - deterministic operator-centric procedural workflow.
 
 #include "Operators/ProceduralOpsModule.h"
+#include "AgentForgeActorIndex.h"
+#include "AgentForgeArgs.h"
+#include "AgentForgeCommandProfile.h"
+#include "AgentForgeJobManager.h"
+#include "AgentForgeMemoryMonitor.h"
+#include "AgentForgeTrace.h"
 #include "Distribution/BiomePartition.h"
 #include "Distribution/Clearings.h"
 #include "Distribution/DensityField.h"
 #include "Distribution/DistributionEngine.h"
 #include "Distribution/InteractionRules.h"
+#include "Distribution/PointCloud.h"
+#include "Distribution/PointMaterializer.h"
+#include "Distribution/SplineSampler.h"
 #include "Palette/PaletteManager.h"
+#include "AgentForgeProceduralCache.h"
+#include "AgentForgeRuntimeCost.h"
+#include "AgentForgeSurfaceTrace.h"
 #include "Terrain/TerrainGenerator.h"
+#include "Terrain/TerrainGpu.h"
+#include "Terrain/TiledTerrainGenerator.h"
 #include "Visual/SceneEvaluator.h"
 
+#include "Algo/IndexOf.h"
+#include "Async/Async.h"
 #include "Dom/JsonObject.h"
 #include "Dom/JsonValue.h"
 #include "HAL/PlatformTime.h"
@@ -19,10 +35,12 @@
 #include "Serialization/JsonSerializer.h"
 #include "Serialization/JsonWriter.h"
 #include "HAL/FileManager.h"
-#include "HAL/PlatformMemory.h"
 #include "Math/RandomStream.h"
 #include "Math/UnrealMathUtility.h"
+#include "Misc/ScopeLock.h"
 #include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
 #include "UObject/UnrealType.h"
 #include "UObject/UObjectGlobals.h"
 #include <limits>
@@ -32,6 +50,7 @@
 #include "EngineUtils.h"
 #include "Components/ActorComponent.h"
 #include "Components/SplineComponent.h"
+#include "Engine/Engine.h"
 #include "Engine/World.h"
 #include "GameFramework/Actor.h"
 #include "Interfaces/IPluginManager.h"
@@ -57,6 +76,7 @@ namespace
 
 	static FString ToJson(const TSharedPtr<FJsonObject>& Obj)
 	{
+		AGENTFORGE_TRACE_SCOPE("AgentForge.Serialize");
 		FString Out;
 		TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Out);
 		FJsonSerializer::Serialize(Obj.ToSharedRef(), Writer);
@@ -208,30 +228,7 @@ namespace
 		{
 			return nullptr;
 		}
-
-		if (UObject* Obj = StaticFindObject(UObject::StaticClass(), nullptr, *Id))
-		{
-			if (AActor* AsActor = Cast<AActor>(Obj))
-			{
-				return AsActor;
-			}
-		}
-
-		for (TActorIterator<AActor> It(World); It; ++It)
-		{
-			AActor* Actor = *It;
-			if (!Actor || !IsValid(Actor))
-			{
-				continue;
-			}
-			if (Actor->GetActorLabel().Equals(Id, ESearchCase::IgnoreCase) ||
-			    Actor->GetName().Equals(Id, ESearchCase::IgnoreCase) ||
-			    Actor->GetPathName().Equals(Id, ESearchCase::IgnoreCase))
-			{
-				return Actor;
-			}
-		}
-		return nullptr;
+		return FAgentForgeActorIndex::Get().FindByAnyId(Id, World);
 	}
 
 	static FProperty* FindPropertyIgnoreCase(UClass* Class, const FString& PropertyName)
@@ -553,7 +550,7 @@ namespace
 		return ClassObj;
 	}
 
-	static void GatherParameterObject(const TSharedPtr<FJsonObject>& Args, TMap<FString, TSharedPtr<FJsonValue>>& OutParams, const TSet<FString>& ReservedKeys)
+	static void GatherParameterObject(const TSharedPtr<FJsonObject>& Args, TMap<FString, TSharedPtr<FJsonValue>>& OutParams, const FAgentForgeArgNames& ReservedKeys)
 	{
 		OutParams.Empty();
 		if (!Args.IsValid())
@@ -572,8 +569,7 @@ namespace
 
 		for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : Args->Values)
 		{
-			const FString LowerKey = Pair.Key.ToLower();
-			if (ReservedKeys.Contains(LowerKey))
+			if (ReservedKeys.Contains(Pair.Key) || FAgentForgeArgNames::IsDispatchArg(Pair.Key))
 			{
 				continue;
 			}
@@ -621,6 +617,7 @@ namespace
 		bool bUseSlopeRange = false;
 		float MinSlope = 0.0f;
 		float MaxSlope = 90.0f;
+		ESurfaceTraceSource SurfaceSource = ESurfaceTraceSource::Physics;
 
 		bool bUseDistanceMask = false;
 		FVector DistanceOrigin = FVector::ZeroVector;
@@ -633,10 +630,13 @@ namespace
 		int32 DensityFieldResolution = 64;
 
 		bool bUseClearings = false;
+		bool bFusedMasks = false;
 		float ClearingDensity = 0.0f;
 		int32 ExplicitClearingCount = 0;
 		float ClearingRadiusMin = 200.0f;
 		float ClearingRadiusMax = 800.0f;
+		float ClearingMinGap = -1.0f;                 // < 0 allows overlap
+		FClearingMaskSettings ClearingMask;           // soft edges go through the clearing SDF
 
 		bool bUseBiomePartition = false;
 		int32 BiomeCount = 0;
@@ -650,6 +650,16 @@ namespace
 		TArray<FVector> PreferNearPoints;
 		float PreferRadius = 500.0f;
 		float PreferStrength = 0.5f;
+
+		EProceduralCacheMode CacheMode = EProceduralCacheMode::Memory;   // not part of the cache key
+	};
+
+	/** How one distribution graph node was resolved on this call. */
+	struct FDistributionNodeTiming
+	{
+		FString Name;
+		FString Status = TEXT("off");   // off | memo | computed | skipped
+		double Ms = 0.0;
 	};
 
 	struct FDistributionDiagnostics
@@ -671,30 +681,36 @@ namespace
 		bool bGenerationTimeExceeded = false;
 		TMap<FString, int32> BiomeHistogram;
 		FSceneEvaluationMetrics SceneMetrics;
+
+		FString CacheStatus = TEXT("off");   // off | miss | memory | disk
+		FString CacheKey;
+		TArray<FDistributionNodeTiming> Nodes;   // this call's graph evaluation; not cached
 	};
 
-	static bool ParseNumericArrayRange(const TSharedPtr<FJsonObject>& Args, const FString& Field, float& OutMin, float& OutMax)
+	static bool ParseNumericRange(const TSharedPtr<FJsonValue>& Value, float& OutMin, float& OutMax)
 	{
 		const TArray<TSharedPtr<FJsonValue>>* RangeArr = nullptr;
-		if (!Args.IsValid() || !Args->TryGetArrayField(Field, RangeArr) || !RangeArr || RangeArr->Num() < 2)
+		if (!Value.IsValid() || !Value->TryGetArray(RangeArr) || !RangeArr || RangeArr->Num() < 2)
 		{
 			return false;
 		}
-		if (!(*RangeArr)[0].IsValid() || !(*RangeArr)[1].IsValid())
+		double MinVal = 0.0;
+		double MaxVal = 0.0;
+		if (!FAgentForgeArgNames::ReadNumber((*RangeArr)[0], MinVal) || !FAgentForgeArgNames::ReadNumber((*RangeArr)[1], MaxVal))
 		{
 			return false;
 		}
-		const double MinVal = (*RangeArr)[0]->AsNumber();
-		const double MaxVal = (*RangeArr)[1]->AsNumber();
 		OutMin = (float)FMath::Min(MinVal, MaxVal);
 		OutMax = (float)FMath::Max(MinVal, MaxVal);
 		return true;
 	}
-	static bool ParseStringArrayField(const TSharedPtr<FJsonObject>& Args, const FString& Field, TArray<FString>& OutValues)
+
+	/** Lowercased, trimmed, non-empty strings of an array value. False when Value is not an array. */
+	static bool ParseStringArray(const TSharedPtr<FJsonValue>& Value, TArray<FString>& OutValues)
 	{
 		OutValues.Reset();
 		const TArray<TSharedPtr<FJsonValue>>* Arr = nullptr;
-		if (!Args.IsValid() || !Args->TryGetArrayField(Field, Arr) || !Arr)
+		if (!Value.IsValid() || !Value->TryGetArray(Arr) || !Arr)
 		{
 			return false;
 		}
@@ -703,34 +719,187 @@ namespace
 		{
 			if (Entry.IsValid() && Entry->Type == EJson::String)
 			{
-				const FString Value = Entry->AsString().TrimStartAndEnd().ToLower();
-				if (!Value.IsEmpty())
+				const FString Item = Entry->AsString().TrimStartAndEnd().ToLower();
+				if (!Item.IsEmpty())
 				{
-					OutValues.Add(Value);
+					OutValues.Add(Item);
 				}
 			}
 		}
-		return OutValues.Num() > 0;
+		return true;
 	}
 
-	static bool ParseVectorArrayField(const TSharedPtr<FJsonObject>& Args, const FString& Field, TArray<FVector>& OutValues)
+	/** {x,y,z} entries of an array value; others are skipped. False when Value is not an array. */
+	static bool ParseVectorArray(const TSharedPtr<FJsonValue>& Value, TArray<FVector>& OutValues)
 	{
 		OutValues.Reset();
 		const TArray<TSharedPtr<FJsonValue>>* Arr = nullptr;
-		if (!Args.IsValid() || !Args->TryGetArrayField(Field, Arr) || !Arr)
+		if (!Value.IsValid() || !Value->TryGetArray(Arr) || !Arr)
 		{
 			return false;
 		}
 
 		for (const TSharedPtr<FJsonValue>& Entry : *Arr)
 		{
-			FVector Value = FVector::ZeroVector;
-			if (JsonValueToVector(Entry, Value))
+			FVector Item = FVector::ZeroVector;
+			if (JsonValueToVector(Entry, Item))
 			{
-				OutValues.Add(Value);
+				OutValues.Add(Item);
 			}
 		}
-		return OutValues.Num() > 0;
+		return true;
+	}
+
+	using FDistributionArgSchema = TAgentForgeArgSchema<FDistributionRequest>;
+
+	// The clearing mask settings are a nested struct, out of reach of a member pointer.
+	static bool BindClearingFalloff(FDistributionRequest& Out, const TSharedPtr<FJsonValue>& Value)
+	{
+		double Number = 0.0;
+		if (!FAgentForgeArgNames::ReadNumber(Value, Number))
+		{
+			return false;
+		}
+		Out.ClearingMask.Falloff = FMath::Max(0.0f, (float)Number);
+		return true;
+	}
+
+	static bool BindClearingInnerDensity(FDistributionRequest& Out, const TSharedPtr<FJsonValue>& Value)
+	{
+		double Number = 0.0;
+		if (!FAgentForgeArgNames::ReadNumber(Value, Number))
+		{
+			return false;
+		}
+		Out.ClearingMask.InnerDensity = FMath::Clamp((float)Number, 0.0f, 1.0f);
+		return true;
+	}
+
+	/** Every distribution arg, built once. Nested objects bind after the flat fields and override them. */
+	static const FDistributionArgSchema& DistributionArgSchema()
+	{
+		using R = FDistributionRequest;
+
+		static const FDistributionArgSchema DistanceMask = FDistributionArgSchema()
+			.Float(TEXT("min"), &R::MinDistance).Min(0.0)
+			.Float(TEXT("max"), &R::MaxDistance)
+			.Custom(TEXT("origin"), [](R& Out, const TSharedPtr<FJsonValue>& Value) { return JsonValueToVector(Value, Out.DistanceOrigin); });
+
+		static const FDistributionArgSchema Clearings = FDistributionArgSchema()
+			.Float(TEXT("density"), &R::ClearingDensity).Min(0.0)
+			.Int(TEXT("count"), &R::ExplicitClearingCount).Min(0)
+			.Float(TEXT("radius_min"), &R::ClearingRadiusMin).Min(50.0)
+			.Float(TEXT("radius_max"), &R::ClearingRadiusMax)
+			.Custom(TEXT("falloff"), &BindClearingFalloff)
+			.Custom(TEXT("inner_density"), &BindClearingInnerDensity)
+			.Float(TEXT("min_gap"), &R::ClearingMinGap);
+
+		// Nested point lists replace the top-level ones only when they hold a point.
+		static const FDistributionArgSchema InteractionRules = FDistributionArgSchema()
+			.Custom(TEXT("avoid_points"), [](R& Out, const TSharedPtr<FJsonValue>& Value)
+			{
+				TArray<FVector> Points;
+				if (!ParseVectorArray(Value, Points))
+				{
+					return false;
+				}
+				if (Points.Num() > 0)
+				{
+					Out.AvoidPoints = MoveTemp(Points);
+				}
+				return true;
+			})
+			.Float(TEXT("avoid_radius"), &R::AvoidRadius).Min(1.0)
+			.Custom(TEXT("prefer_near_points"), [](R& Out, const TSharedPtr<FJsonValue>& Value)
+			{
+				TArray<FVector> Points;
+				if (!ParseVectorArray(Value, Points))
+				{
+					return false;
+				}
+				if (Points.Num() > 0)
+				{
+					Out.PreferNearPoints = MoveTemp(Points);
+				}
+				return true;
+			})
+			.Float(TEXT("prefer_radius"), &R::PreferRadius).Min(1.0)
+			.Float(TEXT("prefer_strength"), &R::PreferStrength).Range(0.0, 1.0);
+
+		static const FDistributionArgSchema Schema = FDistributionArgSchema()
+			.String(TEXT("distribution_mode"), &R::Mode)
+			.Custom(TEXT("cache"), [](R& Out, const TSharedPtr<FJsonValue>& Value)
+			{
+				FString Name;
+				return FAgentForgeArgNames::ReadString(Value, Name) && FAgentForgeProceduralCache::ParseMode(Name, Out.CacheMode);
+			})
+			.Float(TEXT("density"), &R::Density).Range(0.0, 1000.0)
+			.Float(TEXT("cluster_radius"), &R::ClusterRadius).Min(1.0)
+			.Float(TEXT("min_spacing"), &R::MinSpacing).Min(1.0)
+			.Int(TEXT("seed"), &R::Seed)
+			.Int({ TEXT("point_count"), TEXT("max_points") }, &R::ExplicitPointCount).Min(0)
+			.Int(TEXT("cluster_count"), &R::ExplicitClusterCount).Min(0)
+			.Int(TEXT("max_spawn_points"), &R::MaxSpawnPoints).Range(1, FDistributionEngine::MaxPoints)
+			.Int(TEXT("max_cluster_count"), &R::MaxClusterCount).Range(1, 16384)
+			.Float(TEXT("max_generation_time_ms"), &R::MaxGenerationTimeMs).Range(10.0, 600000.0)
+
+			.Bool(TEXT("use_density_gradient"), &R::bUseDensityGradient)
+			.Bool(TEXT("fused_masks"), &R::bFusedMasks)
+			.Float(TEXT("density_sigma"), &R::DensitySigma).Min(1.0)
+			.Float(TEXT("density_noise"), &R::DensityNoise).Range(0.0, 1.0)
+			.Int(TEXT("density_field_resolution"), &R::DensityFieldResolution).Range(8, 512)
+
+			.Custom(TEXT("height_range"), [](R& Out, const TSharedPtr<FJsonValue>& Value) { return ParseNumericRange(Value, Out.MinHeight, Out.MaxHeight); })
+			.Sets(&R::bUseHeightRange)
+			.Custom(TEXT("slope_range"), [](R& Out, const TSharedPtr<FJsonValue>& Value) { return ParseNumericRange(Value, Out.MinSlope, Out.MaxSlope); })
+			.Sets(&R::bUseSlopeRange)
+			.Custom(TEXT("surface_source"), [](R& Out, const TSharedPtr<FJsonValue>& Value)
+			{
+				FString Name;
+				return FAgentForgeArgNames::ReadString(Value, Name) && FAgentForgeSurfaceTrace::ParseSource(Name, Out.SurfaceSource);
+			})
+			.Object(TEXT("distance_mask"), DistanceMask).Sets(&R::bUseDistanceMask)
+
+			.Float(TEXT("clearing_density"), &R::ClearingDensity).Min(0.0)
+			.Int(TEXT("clearing_count"), &R::ExplicitClearingCount).Min(0)
+			.Float(TEXT("clearing_radius_min"), &R::ClearingRadiusMin).Min(50.0)
+			.Float(TEXT("clearing_radius_max"), &R::ClearingRadiusMax)
+			.Custom(TEXT("clearing_falloff"), &BindClearingFalloff)
+			.Custom(TEXT("clearing_inner_density"), &BindClearingInnerDensity)
+			.Float(TEXT("clearing_min_gap"), &R::ClearingMinGap)
+			.Object(TEXT("clearings"), Clearings)
+
+			.Int(TEXT("biome_count"), &R::BiomeCount).Range(1, 256).Sets(&R::bUseBiomePartition)
+			.Float(TEXT("biome_blend_distance"), &R::BiomeBlendDistance).Min(0.0)
+			.Custom(TEXT("biome_types"), [](R& Out, const TSharedPtr<FJsonValue>& Value)
+			{
+				if (!ParseStringArray(Value, Out.BiomeTypes))
+				{
+					return false;
+				}
+				Out.bUseBiomePartition |= Out.BiomeTypes.Num() > 0;
+				return true;
+			})
+			.Custom(TEXT("allowed_biomes"), [](R& Out, const TSharedPtr<FJsonValue>& Value)
+			{
+				TArray<FString> Biomes;
+				if (!ParseStringArray(Value, Biomes))
+				{
+					return false;
+				}
+				Out.AllowedBiomes.Append(Biomes);
+				Out.bUseBiomePartition |= Biomes.Num() > 0;
+				return true;
+			})
+
+			.Custom(TEXT("avoid_points"), [](R& Out, const TSharedPtr<FJsonValue>& Value) { return ParseVectorArray(Value, Out.AvoidPoints); })
+			.Float(TEXT("avoid_radius"), &R::AvoidRadius).Min(1.0)
+			.Custom(TEXT("prefer_near_points"), [](R& Out, const TSharedPtr<FJsonValue>& Value) { return ParseVectorArray(Value, Out.PreferNearPoints); })
+			.Float(TEXT("prefer_radius"), &R::PreferRadius).Min(1.0)
+			.Float(TEXT("prefer_strength"), &R::PreferStrength).Range(0.0, 1.0)
+			.Object(TEXT("interaction_rules"), InteractionRules);
+
+		return Schema;
 	}
 
 	static FDistributionRequest ParseDistributionRequest(const TSharedPtr<FJsonObject>& Args, AActor* TargetActor)
@@ -740,239 +909,378 @@ namespace
 		Request.MaxClusterCount = GOperatorPolicy.MaxClusterCount;
 		Request.MaxGenerationTimeMs = GOperatorPolicy.MaxGenerationTimeMs;
 
-		if (!Args.IsValid())
-		{
-			if (TargetActor)
-			{
-				Request.DistanceOrigin = TargetActor->GetActorLocation();
-			}
-			return Request;
-		}
+		// Op-specific keys are unknown here; the ops report what is left after their own names.
+		DistributionArgSchema().Bind(Args, Request);
+
+		// Cross-field rules, independent of key order.
+		Request.MaxDistance = FMath::Max(Request.MinDistance, Request.MaxDistance);
+		Request.ClearingRadiusMax = FMath::Max(Request.ClearingRadiusMin, Request.ClearingRadiusMax);
+		Request.bUseClearings = Request.ClearingDensity > KINDA_SMALL_NUMBER || Request.ExplicitClearingCount > 0;
+		Request.bUseInteractionRules = Request.AvoidPoints.Num() > 0 || Request.PreferNearPoints.Num() > 0;
 
-		Args->TryGetStringField(TEXT("distribution_mode"), Request.Mode);
-		if (Args->HasField(TEXT("density")))
+		if (TargetActor && !Request.bUseDistanceMask)
 		{
-			Request.Density = FMath::Clamp((float)Args->GetNumberField(TEXT("density")), 0.0f, 1000.0f);
+			Request.DistanceOrigin = TargetActor->GetActorLocation();
 		}
-		if (Args->HasField(TEXT("cluster_radius")))
+
+		return Request;
+	}
+
+	// ─── Distribution graph ─────────────────────────────────────────────────
+	//
+	// ComputeDistributionPoints runs the pipeline as a chain of nodes: base
+	// sampling, height, slope, distance, the mask nodes (density, clearings,
+	// biomes; one "masks" node when fused), interactions, finalize and
+	// evaluate. Each node's key is a hash of its parent's key and its own
+	// parameters, and its output (the point cloud with its survivor mask plus
+	// the diagnostics counters so far) is memoized under that key. Changing a
+	// parameter therefore re-runs only its node and the nodes after it; an
+	// avoid_radius tweak reuses everything up to the interaction node.
+	//
+	// Memoized outputs are shared and immutable. A node that has to run
+	// copies its parent's output first, so a run of hits copies nothing.
+
+	static const TCHAR* DistributionCacheKind = TEXT("distribution");
+	static const TCHAR* DistributionNodeKind = TEXT("distribution_node");
+	static constexpr int32 DistributionCacheVersion = 4;
+
+	static void AppendVectorsKey(FString& Out, const TArray<FVector>& Points)
+	{
+		for (const FVector& Point : Points)
 		{
-			Request.ClusterRadius = FMath::Max(1.0f, (float)Args->GetNumberField(TEXT("cluster_radius")));
+			Out += FString::Printf(TEXT("(%.9g,%.9g,%.9g)"), Point.X, Point.Y, Point.Z);
 		}
-		if (Args->HasField(TEXT("min_spacing")))
+	}
+
+	/** Canonical parameter string per node; empty for disabled stages. MaxGenerationTimeMs is left out everywhere. */
+	struct FDistributionNodeParams
+	{
+		FString Base;
+		FString Height;
+		FString Slope;
+		FString Distance;
+		FString Density;
+		FString Clearings;
+		FString Biomes;
+		FString Fused;
+		FString Interactions;
+	};
+
+	static FDistributionNodeParams MakeDistributionNodeParams(const FVector& Origin, const FVector& Extent, const FDistributionRequest& Request)
+	{
+		FDistributionNodeParams Params;
+		Params.Base = FString::Printf(TEXT("v%d|bounds(%.9g,%.9g,%.9g)(%.9g,%.9g,%.9g)|%s|%.9g,%.9g,%.9g|%d,%d,%d,%d,%d"),
+			DistributionCacheVersion,
+			Origin.X, Origin.Y, Origin.Z, Extent.X, Extent.Y, Extent.Z,
+			*Request.Mode.ToLower(),
+			Request.Density, Request.ClusterRadius, Request.MinSpacing,
+			Request.Seed, Request.ExplicitPointCount, Request.ExplicitClusterCount, Request.MaxSpawnPoints, Request.MaxClusterCount);
+		if (Request.bUseHeightRange)
 		{
-			Request.MinSpacing = FMath::Max(1.0f, (float)Args->GetNumberField(TEXT("min_spacing")));
+			Params.Height = FString::Printf(TEXT("|height%.9g,%.9g"), Request.MinHeight, Request.MaxHeight);
 		}
-		if (Args->HasField(TEXT("seed")))
+		if (Request.bUseSlopeRange)
 		{
-			Request.Seed = (int32)Args->GetNumberField(TEXT("seed"));
+			// The slope filter traces against level geometry, so any world edit invalidates it.
+			Params.Slope = FString::Printf(TEXT("|slope%.9g,%.9g:%s@%lld"), Request.MinSlope, Request.MaxSlope,
+				FAgentForgeSurfaceTrace::SourceName(Request.SurfaceSource), FAgentForgeActorIndex::Get().GetRevision());
 		}
-		if (Args->HasField(TEXT("point_count")))
+		if (Request.bUseDistanceMask)
 		{
-			Request.ExplicitPointCount = FMath::Max(0, (int32)Args->GetNumberField(TEXT("point_count")));
+			Params.Distance = FString::Printf(TEXT("|dist(%.9g,%.9g,%.9g)%.9g,%.9g"),
+				Request.DistanceOrigin.X, Request.DistanceOrigin.Y, Request.DistanceOrigin.Z, Request.MinDistance, Request.MaxDistance);
 		}
-		else if (Args->HasField(TEXT("max_points")))
+		if (Request.bUseDensityGradient)
 		{
-			Request.ExplicitPointCount = FMath::Max(0, (int32)Args->GetNumberField(TEXT("max_points")));
+			Params.Density = FString::Printf(TEXT("|grad%.9g,%.9g,%d"), Request.DensitySigma, Request.DensityNoise, Request.DensityFieldResolution);
 		}
-		if (Args->HasField(TEXT("cluster_count")))
+		if (Request.bUseClearings)
 		{
-			Request.ExplicitClusterCount = FMath::Max(0, (int32)Args->GetNumberField(TEXT("cluster_count")));
+			Params.Clearings = FString::Printf(TEXT("|clear%.9g,%d,%.9g,%.9g,%.9g,%.9g,%.9g"), Request.ClearingDensity, Request.ExplicitClearingCount, Request.ClearingRadiusMin, Request.ClearingRadiusMax,
+				Request.ClearingMinGap, Request.ClearingMask.Falloff, Request.ClearingMask.InnerDensity);
 		}
-		if (Args->HasField(TEXT("max_spawn_points")))
+		if (Request.bUseBiomePartition)
 		{
-			Request.MaxSpawnPoints = FMath::Clamp((int32)Args->GetNumberField(TEXT("max_spawn_points")), 1, 500000);
+			TArray<FString> Allowed = Request.AllowedBiomes.Array();
+			Allowed.Sort();
+			Params.Biomes = FString::Printf(TEXT("|biome%d,%.9g,[%s],[%s]"),
+				Request.BiomeCount, Request.BiomeBlendDistance, *FString::Join(Request.BiomeTypes, TEXT(",")), *FString::Join(Allowed, TEXT(",")));
 		}
-		if (Args->HasField(TEXT("max_cluster_count")))
+		if (Request.bFusedMasks)
 		{
-			Request.MaxClusterCount = FMath::Clamp((int32)Args->GetNumberField(TEXT("max_cluster_count")), 1, 16384);
+			Params.Fused = TEXT("|fused");
 		}
-		if (Args->HasField(TEXT("max_generation_time_ms")))
+		if (Request.bUseInteractionRules)
 		{
-			Request.MaxGenerationTimeMs = FMath::Clamp((float)Args->GetNumberField(TEXT("max_generation_time_ms")), 10.0f, 600000.0f);
+			Params.Interactions = FString::Printf(TEXT("|avoid%.9g"), Request.AvoidRadius);
+			AppendVectorsKey(Params.Interactions, Request.AvoidPoints);
+			Params.Interactions += FString::Printf(TEXT("|prefer%.9g,%.9g"), Request.PreferRadius, Request.PreferStrength);
+			AppendVectorsKey(Params.Interactions, Request.PreferNearPoints);
 		}
+		return Params;
+	}
 
-		if (Args->HasField(TEXT("use_density_gradient")))
-		{
-			Request.bUseDensityGradient = Args->GetBoolField(TEXT("use_density_gradient"));
-		}
-		if (Args->HasField(TEXT("density_sigma")))
+	/**
+	 * Everything ComputeDistributionPoints reads from the level, captured on the
+	 * game thread so the rest can run on a worker: the target bounds and the
+	 * node parameters (the slope key reads the actor index revision). World is
+	 * only used by the slope filter, whose traces keep slope-filtered requests
+	 * on the game thread.
+	 */
+	struct FDistributionInputs
+	{
+		UWorld* World = nullptr;
+		bool    bValid = false;
+		FVector Origin = FVector::ZeroVector;
+		FVector Extent = FVector::ZeroVector;
+		FDistributionNodeParams Params;
+
+		// spline_scatter spacing: arc-length samples along Spline replace the area sampler.
+		TSharedPtr<const FSplineSampler, ESPMode::ThreadSafe> Spline;
+		FSplineSampleSettings SplineSettings;
+	};
+
+	static FDistributionInputs CaptureDistributionInputs(UWorld* World, AActor* TargetActor, const FDistributionRequest& Request)
+	{
+		FDistributionInputs Inputs;
+		Inputs.World = World;
+		if (TargetActor)
 		{
-			Request.DensitySigma = FMath::Max(1.0f, (float)Args->GetNumberField(TEXT("density_sigma")));
+			TargetActor->GetActorBounds(true, Inputs.Origin, Inputs.Extent);
+			Inputs.Params = MakeDistributionNodeParams(Inputs.Origin, Inputs.Extent, Request);
+			Inputs.bValid = true;
 		}
-		if (Args->HasField(TEXT("density_noise")))
+		return Inputs;
+	}
+
+	/** Base the distribution on spline samples; bounds (for masks and biomes) become the sampled corridor. */
+	static void UseSplineBase(FDistributionInputs& Inputs, const FDistributionRequest& Request,
+		TSharedPtr<const FSplineSampler, ESPMode::ThreadSafe> Spline, const FSplineSampleSettings& Settings)
+	{
+		float MaxLaneOffset = 0.0f;
+		for (const float Offset : Settings.LaneOffsets)
 		{
-			Request.DensityNoise = FMath::Clamp((float)Args->GetNumberField(TEXT("density_noise")), 0.0f, 1.0f);
+			MaxLaneOffset = FMath::Max(MaxLaneOffset, FMath::Abs(Offset));
 		}
-		if (Args->HasField(TEXT("density_field_resolution")))
+		const FBox Corridor = Spline->GetBounds().ExpandBy(MaxLaneOffset);
+		Inputs.Origin = Corridor.GetCenter();
+		Inputs.Extent = Corridor.GetExtent();
+		Inputs.Params = MakeDistributionNodeParams(Inputs.Origin, Inputs.Extent, Request);
+		Inputs.Params.Base += FString::Printf(TEXT("|spline%s,%.9g,%.9g,%d,["),
+			*Spline->GetFingerprint(), Settings.Spacing, Settings.StartOffset, Settings.MaxSamples);
+		for (const float Offset : Settings.LaneOffsets)
 		{
-			Request.DensityFieldResolution = FMath::Clamp((int32)Args->GetNumberField(TEXT("density_field_resolution")), 8, 512);
+			Inputs.Params.Base += FString::Printf(TEXT("%.9g,"), Offset);
 		}
+		Inputs.Params.Base += TEXT("]");
+		Inputs.Spline = MoveTemp(Spline);
+		Inputs.SplineSettings = Settings;
+	}
+
+	/** Output of one graph node. */
+	struct FDistributionNodeState
+	{
+		FPointCloud Cloud;                      // uncompacted until the finalize node
+		TArray<FVector> Points;                 // set by the finalize node
+		FDistributionPointAttributes Attributes;   // set by the finalize node, parallel to Points
+		FDistributionDiagnostics Diagnostics;   // counters up to and including this node
 
-		if (ParseNumericArrayRange(Args, TEXT("height_range"), Request.MinHeight, Request.MaxHeight))
+		SIZE_T GetAllocatedSize() const
 		{
-			Request.bUseHeightRange = true;
+			SIZE_T Bytes = sizeof(*this) + Cloud.GetAllocatedSize() + Points.GetAllocatedSize() + Attributes.GetAllocatedSize() + Diagnostics.BiomeHistogram.GetAllocatedSize();
+			for (const TPair<FString, int32>& Pair : Diagnostics.BiomeHistogram)
+			{
+				Bytes += Pair.Key.GetAllocatedSize();
+			}
+			return Bytes;
 		}
+	};
+
+	/** Node outputs by node key, LRU-bounded in bytes. Follows the request's cache mode: "off" neither reads nor writes. */
+	class FDistributionNodeMemo
+	{
+	public:
+		using FStatePtr = TSharedPtr<const FDistributionNodeState, ESPMode::ThreadSafe>;
 
-		if (ParseNumericArrayRange(Args, TEXT("slope_range"), Request.MinSlope, Request.MaxSlope))
+		static constexpr int64 MemoryBudgetBytes = 256ll * 1024 * 1024;
+
+		static FDistributionNodeMemo& Get()
 		{
-			Request.bUseSlopeRange = true;
+			static FDistributionNodeMemo Instance;
+			return Instance;
 		}
 
-		if (Args->HasField(TEXT("distance_mask")))
+		FStatePtr Find(const FString& Key)
 		{
-			const TSharedPtr<FJsonObject>* DistObj = nullptr;
-			if (Args->TryGetObjectField(TEXT("distance_mask"), DistObj) && DistObj && DistObj->IsValid())
+			FScopeLock ScopeLock(&Lock);
+			if (FEntry* Entry = Entries.Find(Key))
 			{
-				Request.bUseDistanceMask = true;
-				if ((*DistObj)->HasField(TEXT("min")))
-				{
-					Request.MinDistance = FMath::Max(0.0f, (float)(*DistObj)->GetNumberField(TEXT("min")));
-				}
-				if ((*DistObj)->HasField(TEXT("max")))
-				{
-					Request.MaxDistance = FMath::Max(Request.MinDistance, (float)(*DistObj)->GetNumberField(TEXT("max")));
-				}
-
-				FVector ParsedOrigin = FVector::ZeroVector;
-				if ((*DistObj)->HasField(TEXT("origin")) && JsonValueToVector((*DistObj)->TryGetField(TEXT("origin")), ParsedOrigin))
-				{
-					Request.DistanceOrigin = ParsedOrigin;
-				}
+				Entry->LastUse = ++UseClock;
+				++Hits;
+				return Entry->State;
 			}
+			++Misses;
+			return nullptr;
 		}
 
-		if (Args->HasField(TEXT("clearing_density")))
-		{
-			Request.ClearingDensity = FMath::Max(0.0f, (float)Args->GetNumberField(TEXT("clearing_density")));
-			Request.bUseClearings = Request.ClearingDensity > KINDA_SMALL_NUMBER;
-		}
-		if (Args->HasField(TEXT("clearing_count")))
-		{
-			Request.ExplicitClearingCount = FMath::Max(0, (int32)Args->GetNumberField(TEXT("clearing_count")));
-			Request.bUseClearings = Request.ExplicitClearingCount > 0 || Request.bUseClearings;
-		}
-		if (Args->HasField(TEXT("clearing_radius_min")))
-		{
-			Request.ClearingRadiusMin = FMath::Max(50.0f, (float)Args->GetNumberField(TEXT("clearing_radius_min")));
-		}
-		if (Args->HasField(TEXT("clearing_radius_max")))
-		{
-			Request.ClearingRadiusMax = FMath::Max(Request.ClearingRadiusMin, (float)Args->GetNumberField(TEXT("clearing_radius_max")));
-		}
-		const TSharedPtr<FJsonObject>* ClearingsObj = nullptr;
-		if (Args->TryGetObjectField(TEXT("clearings"), ClearingsObj) && ClearingsObj && ClearingsObj->IsValid())
+		void Store(const FString& Key, const FStatePtr& State)
 		{
-			if ((*ClearingsObj)->HasField(TEXT("density")))
-			{
-				Request.ClearingDensity = FMath::Max(0.0f, (float)(*ClearingsObj)->GetNumberField(TEXT("density")));
-			}
-			if ((*ClearingsObj)->HasField(TEXT("count")))
+			const int64 Bytes = (int64)State->GetAllocatedSize();
+			if (Bytes > MemoryBudgetBytes)
 			{
-				Request.ExplicitClearingCount = FMath::Max(0, (int32)(*ClearingsObj)->GetNumberField(TEXT("count")));
+				return;
 			}
-			if ((*ClearingsObj)->HasField(TEXT("radius_min")))
+			FScopeLock ScopeLock(&Lock);
+			if (const FEntry* Existing = Entries.Find(Key))
 			{
-				Request.ClearingRadiusMin = FMath::Max(50.0f, (float)(*ClearingsObj)->GetNumberField(TEXT("radius_min")));
+				MemoryBytes -= Existing->Bytes;
 			}
-			if ((*ClearingsObj)->HasField(TEXT("radius_max")))
+			Entries.Add(Key, FEntry{ State, Bytes, ++UseClock });
+			MemoryBytes += Bytes;
+			++Stores;
+			while (MemoryBytes > MemoryBudgetBytes && Entries.Num() > 1)
 			{
-				Request.ClearingRadiusMax = FMath::Max(Request.ClearingRadiusMin, (float)(*ClearingsObj)->GetNumberField(TEXT("radius_max")));
+				const FString* Oldest = nullptr;
+				uint64 OldestUse = MAX_uint64;
+				for (const TPair<FString, FEntry>& Pair : Entries)
+				{
+					if (Pair.Value.LastUse < OldestUse)
+					{
+						OldestUse = Pair.Value.LastUse;
+						Oldest = &Pair.Key;
+					}
+				}
+				const FString OldestKey = *Oldest;
+				MemoryBytes -= Entries.FindChecked(OldestKey).Bytes;
+				Entries.Remove(OldestKey);
+				++Evictions;
 			}
-			Request.bUseClearings = Request.ClearingDensity > KINDA_SMALL_NUMBER || Request.ExplicitClearingCount > 0;
 		}
 
-		if (Args->HasField(TEXT("biome_count")))
-		{
-			Request.BiomeCount = FMath::Clamp((int32)Args->GetNumberField(TEXT("biome_count")), 1, 256);
-			Request.bUseBiomePartition = true;
-		}
-		if (Args->HasField(TEXT("biome_blend_distance")))
-		{
-			Request.BiomeBlendDistance = FMath::Max(0.0f, (float)Args->GetNumberField(TEXT("biome_blend_distance")));
-		}
-		ParseStringArrayField(Args, TEXT("biome_types"), Request.BiomeTypes);
-		if (Request.BiomeTypes.Num() > 0)
+		void Clear()
 		{
-			Request.bUseBiomePartition = true;
+			FScopeLock ScopeLock(&Lock);
+			Entries.Reset();
+			MemoryBytes = 0;
 		}
 
-		TArray<FString> AllowedBiomes;
-		if (ParseStringArrayField(Args, TEXT("allowed_biomes"), AllowedBiomes))
+		TSharedPtr<FJsonObject> GetStatsJson() const
 		{
-			Request.bUseBiomePartition = true;
-			for (const FString& Biome : AllowedBiomes)
-			{
-				Request.AllowedBiomes.Add(Biome);
-			}
+			FScopeLock ScopeLock(&Lock);
+			TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+			Obj->SetNumberField(TEXT("entries"), Entries.Num());
+			Obj->SetNumberField(TEXT("memory_mb"), MemoryBytes / (1024.0 * 1024.0));
+			Obj->SetNumberField(TEXT("budget_mb"), MemoryBudgetBytes / (1024.0 * 1024.0));
+			Obj->SetNumberField(TEXT("hits"), (double)Hits);
+			Obj->SetNumberField(TEXT("misses"), (double)Misses);
+			Obj->SetNumberField(TEXT("stores"), (double)Stores);
+			Obj->SetNumberField(TEXT("evictions"), (double)Evictions);
+			return Obj;
 		}
 
-		ParseVectorArrayField(Args, TEXT("avoid_points"), Request.AvoidPoints);
-		if (Args->HasField(TEXT("avoid_radius")))
-		{
-			Request.AvoidRadius = FMath::Max(1.0f, (float)Args->GetNumberField(TEXT("avoid_radius")));
-		}
-		ParseVectorArrayField(Args, TEXT("prefer_near_points"), Request.PreferNearPoints);
-		if (Args->HasField(TEXT("prefer_radius")))
+	private:
+		struct FEntry
 		{
-			Request.PreferRadius = FMath::Max(1.0f, (float)Args->GetNumberField(TEXT("prefer_radius")));
-		}
-		if (Args->HasField(TEXT("prefer_strength")))
+			FStatePtr State;
+			int64 Bytes = 0;
+			uint64 LastUse = 0;
+		};
+
+		mutable FCriticalSection Lock;
+		TMap<FString, FEntry> Entries;
+		int64 MemoryBytes = 0;
+		uint64 UseClock = 0;
+		int64 Hits = 0;
+		int64 Misses = 0;
+		int64 Stores = 0;
+		int64 Evictions = 0;
+	};
+
+	/** One evaluation of the node chain: carries the current output and records per-node timings. */
+	class FDistributionGraphRun
+	{
+	public:
+		FDistributionGraphRun(bool bInUseMemo, TFunction<bool()> InIsTimeExceeded)
+			: bUseMemo(bInUseMemo)
+			, IsTimeExceeded(MoveTemp(InIsTimeExceeded))
+			, Current(MakeShared<FDistributionNodeState, ESPMode::ThreadSafe>())
 		{
-			Request.PreferStrength = FMath::Clamp((float)Args->GetNumberField(TEXT("prefer_strength")), 0.0f, 1.0f);
 		}
 
-		const TSharedPtr<FJsonObject>* InteractionObj = nullptr;
-		if (Args->TryGetObjectField(TEXT("interaction_rules"), InteractionObj) && InteractionObj && InteractionObj->IsValid())
+		/**
+		 * Reuse the memoized output of node Name or run Compute on a copy of
+		 * the current output. Disabled nodes pass their input through. Timed
+		 * nodes are skipped once the generation time budget is spent; nothing
+		 * after a skip is memoized, since its input no longer matches its key.
+		 */
+		void Node(const TCHAR* Name, bool bEnabled, bool bTimed, const FString& Params, TFunctionRef<void(FDistributionNodeState&)> Compute)
 		{
-			TArray<FVector> ParsedPoints;
-			if (ParseVectorArrayField(*InteractionObj, TEXT("avoid_points"), ParsedPoints))
-			{
-				Request.AvoidPoints = ParsedPoints;
-			}
-			if ((*InteractionObj)->HasField(TEXT("avoid_radius")))
+			FDistributionNodeTiming& Timing = Timings.AddDefaulted_GetRef();
+			Timing.Name = Name;
+			if (!bEnabled)
 			{
-				Request.AvoidRadius = FMath::Max(1.0f, (float)(*InteractionObj)->GetNumberField(TEXT("avoid_radius")));
+				Timing.Status = TEXT("off");
+				return;
 			}
 
-			ParsedPoints.Reset();
-			if (ParseVectorArrayField(*InteractionObj, TEXT("prefer_near_points"), ParsedPoints))
+			const FString StageName = FAgentForgeCommandProfile::GetActive() ? FString::Printf(TEXT("Distribution.Node.%s"), Name) : FString();
+			FAgentForgeCommandProfile::FStageScope Stage(*StageName);
+			const double StartSeconds = FPlatformTime::Seconds();
+			ParentKey = FAgentForgeProceduralCache::MakeKey(DistributionNodeKind, FString::Printf(TEXT("%s|%s%s"), *ParentKey, Name, *Params));
+			const bool bMemoValid = bUseMemo && !bSkippedAny;
+			if (bMemoValid)
 			{
-				Request.PreferNearPoints = ParsedPoints;
+				if (FDistributionNodeMemo::FStatePtr Hit = FDistributionNodeMemo::Get().Find(ParentKey))
+				{
+					Current = MoveTemp(Hit);
+					Timing.Status = TEXT("memo");
+					Timing.Ms = (FPlatformTime::Seconds() - StartSeconds) * 1000.0;
+					return;
+				}
 			}
-			if ((*InteractionObj)->HasField(TEXT("prefer_radius")))
+			if (bTimed && IsTimeExceeded())
 			{
-				Request.PreferRadius = FMath::Max(1.0f, (float)(*InteractionObj)->GetNumberField(TEXT("prefer_radius")));
+				Timing.Status = TEXT("skipped");
+				bSkippedAny = true;
+				return;
 			}
-			if ((*InteractionObj)->HasField(TEXT("prefer_strength")))
+
+			TSharedRef<FDistributionNodeState, ESPMode::ThreadSafe> Next = MakeShared<FDistributionNodeState, ESPMode::ThreadSafe>(*Current);
+			Compute(*Next);
+			Current = Next;
+			if (bMemoValid)
 			{
-				Request.PreferStrength = FMath::Clamp((float)(*InteractionObj)->GetNumberField(TEXT("prefer_strength")), 0.0f, 1.0f);
+				FDistributionNodeMemo::Get().Store(ParentKey, Current);
 			}
+			Timing.Status = TEXT("computed");
+			Timing.Ms = (FPlatformTime::Seconds() - StartSeconds) * 1000.0;
 		}
-		Request.bUseInteractionRules = Request.AvoidPoints.Num() > 0 || Request.PreferNearPoints.Num() > 0;
 
-		if (TargetActor && !Request.bUseDistanceMask)
-		{
-			Request.DistanceOrigin = TargetActor->GetActorLocation();
-		}
+		const FDistributionNodeState& GetOutput() const { return *Current; }
+		const TArray<FDistributionNodeTiming>& GetTimings() const { return Timings; }
 
-		return Request;
-	}
+	private:
+		bool bUseMemo = true;
+		bool bSkippedAny = false;
+		TFunction<bool()> IsTimeExceeded;
+		FDistributionNodeMemo::FStatePtr Current;
+		FString ParentKey;
+		TArray<FDistributionNodeTiming> Timings;
+	};
 
-	static TArray<FVector> GenerateDistributionPoints(
-		UWorld* World,
-		AActor* TargetActor,
+	static TArray<FVector> ComputeDistributionPoints(
+		const FDistributionInputs& Inputs,
 		const FDistributionRequest& Request,
-		FDistributionDiagnostics* OutDiagnostics = nullptr)
+		FDistributionDiagnostics* OutDiagnostics = nullptr,
+		FDistributionPointAttributes* OutAttributes = nullptr)
 	{
-		TArray<FVector> Points;
-		if (!TargetActor)
+		if (!Inputs.bValid)
 		{
-			return Points;
+			return TArray<FVector>();
 		}
 
-		FDistributionDiagnostics Diagnostics;
 		const double StartSeconds = FPlatformTime::Seconds();
-		auto IsTimeExceeded = [&]() -> bool
+		auto IsTimeExceeded = [&Request, StartSeconds]() -> bool
 		{
 			if (Request.MaxGenerationTimeMs <= 0.0f)
 			{
@@ -982,9 +1290,8 @@ namespace
 			return ElapsedMs > (double)Request.MaxGenerationTimeMs;
 		};
 
-		FVector Origin = FVector::ZeroVector;
-		FVector Extent = FVector(2000.0f, 2000.0f, 500.0f);
-		TargetActor->GetActorBounds(true, Origin, Extent);
+		const FVector Origin = Inputs.Origin;
+		FVector Extent = Inputs.Extent;
 		Extent.X = FMath::Max(Extent.X, 200.0f);
 		Extent.Y = FMath::Max(Extent.Y, 200.0f);
 		Extent.Z = FMath::Max(Extent.Z, 200.0f);
@@ -996,66 +1303,9 @@ namespace
 			Request.ExplicitPointCount > 0 ? Request.ExplicitPointCount : EstimatedByDensity,
 			1,
 			Request.MaxSpawnPoints);
-		Diagnostics.RequestedPoints = TargetCount;
-
-		const FString ModeLower = Request.Mode.ToLower();
-		if (ModeLower == TEXT("cluster") || ModeLower == TEXT("clustered"))
-		{
-			const int32 ClusterCount = FMath::Clamp(
-				Request.ExplicitClusterCount > 0 ? Request.ExplicitClusterCount : FMath::RoundToInt(FMath::Sqrt((float)TargetCount) * 0.35f),
-				1,
-				Request.MaxClusterCount);
-			const TArray<FVector> Clustered = FDistributionEngine::GenerateClusterPoints(Bounds, TargetCount, ClusterCount, Request.ClusterRadius, Request.Seed);
-			const float MinDistSq = FMath::Square(FMath::Max(1.0f, Request.MinSpacing));
-			for (const FVector& Candidate : Clustered)
-			{
-				bool bAccept = true;
-				for (const FVector& Existing : Points)
-				{
-					if (FVector::DistSquared2D(Candidate, Existing) < MinDistSq)
-					{
-						bAccept = false;
-						break;
-					}
-				}
-				if (bAccept)
-				{
-					Points.Add(Candidate);
-				}
-			}
-		}
-		else if (ModeLower == TEXT("poisson") || ModeLower == TEXT("poisson_disk") || ModeLower == TEXT("poisson_disk_sampling"))
-		{
-			Points = FDistributionEngine::GeneratePoissonDiskPoints(Bounds, TargetCount, Request.MinSpacing, Request.Seed);
-		}
-		else
-		{
-			Points = FDistributionEngine::GenerateBlueNoisePoints(Bounds, TargetCount, Request.Seed, Request.MinSpacing);
-		}
-		Diagnostics.BaseGeneratedPoints = Points.Num();
-
-		if (Request.Mode.ToLower() == TEXT("cluster") && Request.MinSpacing > 1.0f)
-		{
-			Points = FInteractionRules::ApplySelfSpacing(Points, Request.MinSpacing);
-		}
-
-		if (Request.bUseHeightRange)
-		{
-			Points = FDistributionEngine::ApplyHeightFilter(Points, Request.MinHeight, Request.MaxHeight);
-		}
-		Diagnostics.AfterHeightFilter = Points.Num();
-		if (Request.bUseSlopeRange)
-		{
-			Points = FDistributionEngine::ApplySlopeFilter(Points, World, Request.MinSlope, Request.MaxSlope);
-		}
-		Diagnostics.AfterSlopeFilter = Points.Num();
-		if (Request.bUseDistanceMask)
-		{
-			Points = FDistributionEngine::ApplyDistanceMask(Points, Request.DistanceOrigin, Request.MinDistance, Request.MaxDistance);
-		}
-		Diagnostics.AfterDistanceMask = Points.Num();
 
-		if (!IsTimeExceeded() && Request.bUseDensityGradient && Points.Num() > 0)
+		const int32 DensityRes = FMath::Clamp(Request.DensityFieldResolution, 8, 512);
+		const auto MakeDensityConfig = [&]()
 		{
 			FDensityFieldConfig DensityConfig;
 			DensityConfig.BaseDensity = 1.0f;
@@ -1063,110 +1313,459 @@ namespace
 			DensityConfig.Center = Origin;
 			DensityConfig.NoiseBlend = Request.DensityNoise;
 			DensityConfig.Seed = Request.Seed;
-
-			const int32 DensityRes = FMath::Clamp(Request.DensityFieldResolution, 8, 512);
-			const TArray<float> DensityField = FDensityField::GenerateDensityField(Bounds, DensityRes, DensityRes, DensityConfig);
-			float SumDensity = 0.0f;
-			for (const float DensityValue : DensityField)
-			{
-				SumDensity += DensityValue;
-			}
-			Diagnostics.DensityFieldAverage = DensityField.Num() > 0 ? (SumDensity / (float)DensityField.Num()) : 0.0f;
-
-			Points = FDensityField::ApplyDensityGradient(Points, DensityField, DensityRes, DensityRes, Bounds, Request.Seed ^ 0x5B8D3D6A, 0.03f);
-		}
-		Diagnostics.AfterDensityGradient = Points.Num();
-
-		if (!IsTimeExceeded() && Request.bUseClearings && Points.Num() > 0)
+			return DensityConfig;
+		};
+		const auto MakeClearingRegions = [&]()
 		{
 			const int32 DerivedCount = FMath::Clamp(FMath::RoundToInt((AreaM2 / 2500.0f) * Request.ClearingDensity), 0, 2048);
 			const int32 ClearingCount = Request.ExplicitClearingCount > 0 ? Request.ExplicitClearingCount : DerivedCount;
-			const TArray<FClearingRegion> ClearingRegions = FClearings::GenerateClearings(
+			return FClearings::GenerateClearings(
 				Bounds,
 				ClearingCount,
 				Request.ClearingRadiusMin,
 				Request.ClearingRadiusMax,
-				Request.Seed ^ 0x1E35A7BD);
-			Diagnostics.ClearingCount = ClearingRegions.Num();
-			Points = FClearings::ApplyClearingMask(Points, ClearingRegions);
-		}
-		Diagnostics.AfterClearings = Points.Num();
-
-		if (!IsTimeExceeded() && Request.bUseBiomePartition && Points.Num() > 0)
+				Request.Seed ^ 0x1E35A7BD,
+				Request.ClearingMinGap);
+		};
+		const auto MakeBiomePartition = [&]()
 		{
 			const int32 BiomeCount = FMath::Clamp(Request.BiomeCount > 0 ? Request.BiomeCount : FMath::Max(2, Request.BiomeTypes.Num()), 1, 256);
-			const FBiomePartitionData Partition = FBiomePartition::GenerateVoronoiBiomes(
+			return FBiomePartition::GenerateVoronoiBiomes(
 				Bounds,
 				BiomeCount,
 				Request.BiomeTypes,
 				Request.Seed ^ 0x9E3779B9,
 				Request.BiomeBlendDistance);
-			Diagnostics.BiomeSeedCount = Partition.Seeds.Num();
-
-			TArray<FVector> BiomeFiltered;
-			BiomeFiltered.Reserve(Points.Num());
-			for (const FVector& Point : Points)
+		};
+		// Allowed flag per interned biome id; names are only touched once per biome, not per point.
+		const auto MakeAllowedBiomeIds = [&](const FBiomePartitionData& Partition)
+		{
+			TArray<bool> Allowed;
+			Allowed.Init(Request.AllowedBiomes.Num() == 0, Partition.BiomeNames.Num());
+			for (const FString& Name : Request.AllowedBiomes)
 			{
-				const FBiomeBlendSample Blend = FBiomePartition::BlendBiomeEdges(Partition, Point);
-				if (!Blend.PrimaryBiome.IsEmpty())
+				const int32 Id = FBiomePartition::FindBiomeId(Partition, Name);
+				if (Id != INDEX_NONE)
 				{
-					Diagnostics.BiomeHistogram.FindOrAdd(Blend.PrimaryBiome) += 1;
+					Allowed[Id] = true;
 				}
+			}
+			return Allowed;
+		};
+
+		const FDistributionNodeParams& Params = Inputs.Params;
+		FDistributionGraphRun Graph(Request.CacheMode != EProceduralCacheMode::Off, IsTimeExceeded);
+		const auto NumAlive = [&Graph]() { return Graph.GetOutput().Cloud.NumAlive(); };
+
+		// Stage counters are read after every node, including disabled and memoized ones, so they
+		// match a straight run of the pipeline.
+		FDistributionDiagnostics Counts;
+		Counts.RequestedPoints = Inputs.Spline.IsValid() ? Inputs.Spline->NumSamples(Inputs.SplineSettings) : TargetCount;
+
+		// Stages below clear survivor flags in place; the cloud is compacted once, by the finalize node.
+		Graph.Node(TEXT("base"), true, false, Params.Base, [&](FDistributionNodeState& State)
+		{
+			FPointCloud& Cloud = State.Cloud;
+			const FString ModeLower = Request.Mode.ToLower();
+			if (Inputs.Spline.IsValid())
+			{
+				Cloud = FSplineSampler::ToPointCloud(Inputs.Spline->Sample(Inputs.SplineSettings));
+			}
+			else if (ModeLower == TEXT("cluster") || ModeLower == TEXT("clustered"))
+			{
+				const int32 ClusterCount = FMath::Clamp(
+					Request.ExplicitClusterCount > 0 ? Request.ExplicitClusterCount : FMath::RoundToInt(FMath::Sqrt((float)TargetCount) * 0.35f),
+					1,
+					Request.MaxClusterCount);
+				Cloud = FPointCloud(FDistributionEngine::GenerateClusterPoints(Bounds, TargetCount, ClusterCount, Request.ClusterRadius, Request.Seed));
+				FInteractionRules::ApplySelfSpacing(Cloud, Request.MinSpacing);
+			}
+			else if (ModeLower == TEXT("poisson") || ModeLower == TEXT("poisson_disk") || ModeLower == TEXT("poisson_disk_sampling"))
+			{
+				Cloud = FPointCloud(FDistributionEngine::GeneratePoissonDiskPoints(Bounds, TargetCount, Request.MinSpacing, Request.Seed));
+			}
+			else
+			{
+				Cloud = FPointCloud(FDistributionEngine::GenerateBlueNoisePoints(Bounds, TargetCount, Request.Seed, Request.MinSpacing));
+			}
+		});
+		Counts.BaseGeneratedPoints = NumAlive();
+
+		Graph.Node(TEXT("height"), Request.bUseHeightRange, false, Params.Height, [&](FDistributionNodeState& State)
+		{
+			FDistributionEngine::ApplyHeightFilter(State.Cloud, Request.MinHeight, Request.MaxHeight);
+		});
+		Counts.AfterHeightFilter = NumAlive();
+		Graph.Node(TEXT("slope"), Request.bUseSlopeRange, false, Params.Slope, [&](FDistributionNodeState& State)
+		{
+			FDistributionEngine::ApplySlopeFilter(State.Cloud, Inputs.World, Request.MinSlope, Request.MaxSlope, Request.SurfaceSource);
+		});
+		Counts.AfterSlopeFilter = NumAlive();
+		Graph.Node(TEXT("distance"), Request.bUseDistanceMask, false, Params.Distance, [&](FDistributionNodeState& State)
+		{
+			FDistributionEngine::ApplyDistanceMask(State.Cloud, Request.DistanceOrigin, Request.MinDistance, Request.MaxDistance);
+		});
+		Counts.AfterDistanceMask = NumAlive();
 
-				if (Request.AllowedBiomes.Num() == 0)
+		// Fused: density, clearings and biome masks composited into one raster, one sample per point.
+		const bool bFused = Request.bFusedMasks && (Request.bUseDensityGradient || Request.bUseClearings || Request.bUseBiomePartition);
+		const FString MaskParams = Params.Density + Params.Clearings + Params.Biomes + Params.Fused;
+		Graph.Node(TEXT("masks"), bFused, true, MaskParams, [&](FDistributionNodeState& State)
+		{
+			FPointCloud& Cloud = State.Cloud;
+			FDistributionDiagnostics& Diagnostics = State.Diagnostics;
+			if (Cloud.NumAlive() > 0)
+			{
+				TArray<FClearingRegion> ClearingRegions;
+				if (Request.bUseClearings)
 				{
-					BiomeFiltered.Add(Point);
-					continue;
+					ClearingRegions = MakeClearingRegions();
+					Diagnostics.ClearingCount = ClearingRegions.Num();
 				}
-
-				if (Request.AllowedBiomes.Contains(Blend.PrimaryBiome))
+				const FClearingSdf ClearingSdf = FClearings::BuildClearingSdf(ClearingRegions, Bounds, Request.ClearingMask);
+				FBiomePartitionData Partition;
+				FDensityCompositeMasks Masks;
+				Masks.ClearingSdf = &ClearingSdf;
+				Masks.ClearingSettings = Request.ClearingMask;
+				Masks.MinKeepProbability = Request.bUseDensityGradient ? 0.03f : 1.0f;
+				if (Request.bUseBiomePartition)
 				{
-					BiomeFiltered.Add(Point);
-					continue;
+					Partition = MakeBiomePartition();
+					Diagnostics.BiomeSeedCount = Partition.Seeds.Num();
+					if (Request.AllowedBiomes.Num() > 0)
+					{
+						Masks.Biomes = &Partition;
+						Masks.AllowedBiomeIds = MakeAllowedBiomeIds(Partition);
+					}
 				}
 
-				if (!Blend.SecondaryBiome.IsEmpty() &&
-					Request.AllowedBiomes.Contains(Blend.SecondaryBiome) &&
-					Blend.BlendAlpha >= 0.5f)
+				const FDensityRaster Raster = FDensityField::GenerateCompositeField(Bounds, DensityRes, DensityRes, MakeDensityConfig(), Masks);
+				Diagnostics.DensityFieldAverage = Raster.Average();
+				FDensityField::ApplyDensityRaster(Cloud, Raster, Request.Seed ^ 0x5B8D3D6A);
+
+				if (Request.bUseBiomePartition)
 				{
-					BiomeFiltered.Add(Point);
+					TArray<int32> Histogram;
+					Histogram.SetNumZeroed(Partition.BiomeNames.Num());
+					Cloud.BiomeNames = Partition.BiomeNames;
+					Cloud.AddChannel(Cloud.BiomeId, (int32)INDEX_NONE);
+					Cloud.ForEachAlive([&](int32 Index)
+					{
+						const int32 Id = FBiomePartition::BlendBiomeIds(Partition, Cloud.GetPosition(Index)).PrimaryBiome;
+						if (Id != INDEX_NONE)
+						{
+							++Histogram[Id];
+							Cloud.BiomeId[Index] = Id;
+						}
+					});
+					for (int32 Id = 0; Id < Histogram.Num(); ++Id)
+					{
+						if (Histogram[Id] > 0)
+						{
+							Diagnostics.BiomeHistogram.Add(Partition.BiomeNames[Id], Histogram[Id]);
+						}
+					}
 				}
 			}
+		});
 
-			Points = MoveTemp(BiomeFiltered);
-		}
-		Diagnostics.AfterBiomeFilter = Points.Num();
-
-		if (!IsTimeExceeded() && Request.bUseInteractionRules && Points.Num() > 0)
+		Graph.Node(TEXT("density"), !bFused && Request.bUseDensityGradient, true, Params.Density, [&](FDistributionNodeState& State)
 		{
-			if (Request.AvoidPoints.Num() > 0)
+			if (State.Cloud.NumAlive() > 0)
 			{
-				Points = FInteractionRules::ApplyAvoidance(Points, Request.AvoidPoints, Request.AvoidRadius);
-			}
-			if (Request.PreferNearPoints.Num() > 0)
-			{
-				Points = FInteractionRules::ApplyAttractorBias(Points, Request.PreferNearPoints, Request.PreferRadius, Request.PreferStrength, Request.Seed ^ 0x7D2B4C91);
+				const TArray<float> DensityField = FDensityField::GenerateDensityField(Bounds, DensityRes, DensityRes, MakeDensityConfig());
+				float SumDensity = 0.0f;
+				for (const float DensityValue : DensityField)
+				{
+					SumDensity += DensityValue;
+				}
+				State.Diagnostics.DensityFieldAverage = DensityField.Num() > 0 ? (SumDensity / (float)DensityField.Num()) : 0.0f;
+
+				FDensityField::ApplyDensityGradient(State.Cloud, DensityField, DensityRes, DensityRes, Bounds, Request.Seed ^ 0x5B8D3D6A, 0.03f);
 			}
-		}
-		Diagnostics.AfterInteractionRules = Points.Num();
+		});
+		Counts.AfterDensityGradient = NumAlive();
 
-		if (Points.Num() > Request.MaxSpawnPoints)
+		Graph.Node(TEXT("clearings"), !bFused && Request.bUseClearings, true, Params.Clearings, [&](FDistributionNodeState& State)
 		{
-			Points.SetNum(Request.MaxSpawnPoints);
-		}
+			if (State.Cloud.NumAlive() > 0)
+			{
+				const TArray<FClearingRegion> ClearingRegions = MakeClearingRegions();
+				State.Diagnostics.ClearingCount = ClearingRegions.Num();
+				if (Request.ClearingMask.IsHard())
+				{
+					FClearings::ApplyClearingMask(State.Cloud, ClearingRegions);
+				}
+				else
+				{
+					const FClearingSdf ClearingSdf = FClearings::BuildClearingSdf(ClearingRegions, Bounds, Request.ClearingMask);
+					FClearings::ApplyClearingMask(State.Cloud, ClearingSdf, Request.ClearingMask, Request.Seed ^ 0x1E35A7BD);
+				}
+			}
+		});
+		Counts.AfterClearings = NumAlive();
+
+		Graph.Node(TEXT("biomes"), !bFused && Request.bUseBiomePartition, true, Params.Biomes, [&](FDistributionNodeState& State)
+		{
+			FPointCloud& Cloud = State.Cloud;
+			if (Cloud.NumAlive() == 0)
+			{
+				return;
+			}
+			const FBiomePartitionData Partition = MakeBiomePartition();
+			State.Diagnostics.BiomeSeedCount = Partition.Seeds.Num();
+
+			const int32 NumBiomes = Partition.BiomeNames.Num();
+			const TArray<bool> Allowed = MakeAllowedBiomeIds(Partition);
+			TArray<int32> Histogram;
+			Histogram.SetNumZeroed(NumBiomes);
+
+			Cloud.BiomeNames = Partition.BiomeNames;
+			Cloud.AddChannel(Cloud.BiomeId, (int32)INDEX_NONE);
+			for (int32 Index = 0; Index < Cloud.Num(); ++Index)
+			{
+				if (!Cloud.IsAlive(Index))
+				{
+					continue;
+				}
+				const FBiomeIdSample Blend = FBiomePartition::BlendBiomeIds(Partition, Cloud.GetPosition(Index));
+				if (Blend.PrimaryBiome != INDEX_NONE)
+				{
+					++Histogram[Blend.PrimaryBiome];
+					Cloud.BiomeId[Index] = Blend.PrimaryBiome;
+				}
+
+				const bool bKeep =
+					Request.AllowedBiomes.Num() == 0 ||
+					(Blend.PrimaryBiome != INDEX_NONE && Allowed[Blend.PrimaryBiome]) ||
+					(Blend.SecondaryBiome != INDEX_NONE && Allowed[Blend.SecondaryBiome] && Blend.BlendAlpha >= 0.5f);
+				if (!bKeep)
+				{
+					Cloud.Kill(Index);
+				}
+			}
+			for (int32 Id = 0; Id < NumBiomes; ++Id)
+			{
+				if (Histogram[Id] > 0)
+				{
+					State.Diagnostics.BiomeHistogram.Add(Partition.BiomeNames[Id], Histogram[Id]);
+				}
+			}
+		});
+		Counts.AfterBiomeFilter = NumAlive();
 
-		Diagnostics.FinalPoints = Points.Num();
-		Diagnostics.GenerationTimeMs = (FPlatformTime::Seconds() - StartSeconds) * 1000.0;
-		Diagnostics.bGenerationTimeExceeded = Request.MaxGenerationTimeMs > 0.0f && Diagnostics.GenerationTimeMs > (double)Request.MaxGenerationTimeMs;
-		Diagnostics.SceneMetrics = FSceneEvaluator::EvaluateScene(Points, Bounds, Request.ClusterRadius);
+		Graph.Node(TEXT("interactions"), Request.bUseInteractionRules, true, Params.Interactions, [&](FDistributionNodeState& State)
+		{
+			if (State.Cloud.NumAlive() == 0)
+			{
+				return;
+			}
+			if (Request.AvoidPoints.Num() > 0)
+			{
+				FInteractionRules::ApplyAvoidance(State.Cloud, Request.AvoidPoints, Request.AvoidRadius);
+			}
+			if (Request.PreferNearPoints.Num() > 0)
+			{
+				FInteractionRules::ApplyAttractorBias(State.Cloud, Request.PreferNearPoints, Request.PreferRadius, Request.PreferStrength, Request.Seed ^ 0x7D2B4C91);
+			}
+		});
+		Counts.AfterInteractionRules = NumAlive();
+
+		// MaxSpawnPoints is part of the base key, so finalize and evaluate need no parameters of their own.
+		Graph.Node(TEXT("finalize"), true, false, FString(), [&](FDistributionNodeState& State)
+		{
+			State.Cloud.TruncateAlive(Request.MaxSpawnPoints);
+			State.Cloud.Compact();
+			State.Points = State.Cloud.ToPoints();
+			State.Attributes.BiomeId    = MoveTemp(State.Cloud.BiomeId);
+			State.Attributes.BiomeNames = MoveTemp(State.Cloud.BiomeNames);
+			State.Attributes.Density    = MoveTemp(State.Cloud.Density);
+			State.Attributes.Normal     = MoveTemp(State.Cloud.Normal);
+			State.Cloud.Reset();
+		});
+		Graph.Node(TEXT("evaluate"), true, false, FString(), [&](FDistributionNodeState& State)
+		{
+			State.Diagnostics.SceneMetrics = FSceneEvaluator::EvaluateScene(State.Points, Bounds, Request.ClusterRadius);
+		});
+
+		const FDistributionNodeState& Output = Graph.GetOutput();
 		if (OutDiagnostics)
 		{
+			FDistributionDiagnostics Diagnostics = Output.Diagnostics;
+			Diagnostics.RequestedPoints = Counts.RequestedPoints;
+			Diagnostics.BaseGeneratedPoints = Counts.BaseGeneratedPoints;
+			Diagnostics.AfterHeightFilter = Counts.AfterHeightFilter;
+			Diagnostics.AfterSlopeFilter = Counts.AfterSlopeFilter;
+			Diagnostics.AfterDistanceMask = Counts.AfterDistanceMask;
+			Diagnostics.AfterDensityGradient = Counts.AfterDensityGradient;
+			Diagnostics.AfterClearings = Counts.AfterClearings;
+			Diagnostics.AfterBiomeFilter = Counts.AfterBiomeFilter;
+			Diagnostics.AfterInteractionRules = Counts.AfterInteractionRules;
+			Diagnostics.FinalPoints = Output.Points.Num();
+			Diagnostics.GenerationTimeMs = (FPlatformTime::Seconds() - StartSeconds) * 1000.0;
+			Diagnostics.bGenerationTimeExceeded = Request.MaxGenerationTimeMs > 0.0f && Diagnostics.GenerationTimeMs > (double)Request.MaxGenerationTimeMs;
+			Diagnostics.Nodes = Graph.GetTimings();
 			*OutDiagnostics = Diagnostics;
 		}
+		if (OutAttributes)
+		{
+			*OutAttributes = Output.Attributes;
+		}
+		return Output.Points;
+	}
+
+	// ─── Distribution cache ─────────────────────────────────────────────────
+
+	/** Every input that changes the output, in a fixed order: the node parameters concatenated. */
+	static FString MakeDistributionCacheInputs(const FDistributionNodeParams& Params)
+	{
+		return Params.Base + Params.Height + Params.Slope + Params.Distance
+			+ Params.Density + Params.Clearings + Params.Biomes + Params.Fused + Params.Interactions;
+	}
+
+	static void SerializeDistributionResult(FArchive& Ar, TArray<FVector>& Points, FDistributionPointAttributes& Attributes, FDistributionDiagnostics& Diagnostics)
+	{
+		int32 Version = DistributionCacheVersion;
+		Ar << Version;
+		if (Version != DistributionCacheVersion)
+		{
+			Ar.SetError();
+			return;
+		}
+		Ar << Points;
+		Ar << Attributes.BiomeId;
+		Ar << Attributes.BiomeNames;
+		Ar << Attributes.Density;
+		Ar << Attributes.Normal;
+		Ar << Diagnostics.RequestedPoints;
+		Ar << Diagnostics.BaseGeneratedPoints;
+		Ar << Diagnostics.AfterHeightFilter;
+		Ar << Diagnostics.AfterSlopeFilter;
+		Ar << Diagnostics.AfterDistanceMask;
+		Ar << Diagnostics.AfterDensityGradient;
+		Ar << Diagnostics.AfterClearings;
+		Ar << Diagnostics.AfterBiomeFilter;
+		Ar << Diagnostics.AfterInteractionRules;
+		Ar << Diagnostics.FinalPoints;
+		Ar << Diagnostics.ClearingCount;
+		Ar << Diagnostics.BiomeSeedCount;
+		Ar << Diagnostics.DensityFieldAverage;
+		Ar << Diagnostics.GenerationTimeMs;
+		Ar << Diagnostics.BiomeHistogram;
+		Ar << Diagnostics.SceneMetrics.DensityVarianceScore;
+		Ar << Diagnostics.SceneMetrics.ClusterScore;
+		Ar << Diagnostics.SceneMetrics.EmptySpaceScore;
+		Ar << Diagnostics.SceneMetrics.VisualBalanceScore;
+		Ar << Diagnostics.SceneMetrics.CombinedScore;
+	}
+
+	/** ComputeDistributionPoints behind the procedural cache (Request.CacheMode). */
+	static TArray<FVector> GenerateDistributionPoints(
+		const FDistributionInputs& Inputs,
+		const FDistributionRequest& Request,
+		FDistributionDiagnostics* OutDiagnostics = nullptr,
+		FDistributionPointAttributes* OutAttributes = nullptr)
+	{
+		if (!Inputs.bValid || Request.CacheMode == EProceduralCacheMode::Off)
+		{
+			return ComputeDistributionPoints(Inputs, Request, OutDiagnostics, OutAttributes);
+		}
+
+		FAgentForgeProceduralCache& Cache = FAgentForgeProceduralCache::Get();
+		const FString Key = FAgentForgeProceduralCache::MakeKey(DistributionCacheKind, MakeDistributionCacheInputs(Inputs.Params));
+
+		TArray<FVector> Points;
+		FDistributionPointAttributes Attributes;
+		FDistributionDiagnostics Diagnostics;
+		bool bFromDisk = false;
+		if (const FAgentForgeProceduralCache::FPayload Payload = Cache.Find(DistributionCacheKind, Key, Request.CacheMode, &bFromDisk))
+		{
+			FMemoryReader Reader(*Payload);
+			SerializeDistributionResult(Reader, Points, Attributes, Diagnostics);
+			if (!Reader.IsError())
+			{
+				Diagnostics.CacheStatus = bFromDisk ? TEXT("disk") : TEXT("memory");
+				Diagnostics.CacheKey = Key;
+				if (OutDiagnostics)
+				{
+					*OutDiagnostics = Diagnostics;
+				}
+				if (OutAttributes)
+				{
+					*OutAttributes = MoveTemp(Attributes);
+				}
+				return Points;
+			}
+			Points.Reset();
+			Attributes = FDistributionPointAttributes();
+			Diagnostics = FDistributionDiagnostics();
+		}
 
+		Points = ComputeDistributionPoints(Inputs, Request, &Diagnostics, &Attributes);
+		Diagnostics.CacheStatus = TEXT("miss");
+		Diagnostics.CacheKey = Key;
+		if (!Diagnostics.bGenerationTimeExceeded)
+		{
+			TArray<uint8> Bytes;
+			FMemoryWriter Writer(Bytes);
+			SerializeDistributionResult(Writer, Points, Attributes, Diagnostics);
+			Cache.Store(DistributionCacheKind, Key, MoveTemp(Bytes), Request.CacheMode);
+		}
+		if (OutDiagnostics)
+		{
+			*OutDiagnostics = Diagnostics;
+		}
+		if (OutAttributes)
+		{
+			*OutAttributes = MoveTemp(Attributes);
+		}
 		return Points;
 	}
 
+	// ─── Terrain cache ──────────────────────────────────────────────────────
+
+	static const TCHAR* TerrainCacheKind = TEXT("terrain");
+	static constexpr int32 TerrainCacheVersion = 1;
+
+	static FString NoiseCacheInputs(const FHeightmapNoiseSettings& Noise)
+	{
+		return FString::Printf(TEXT("%s,%d,%.9g,%.9g,%d,%.9g,%.9g,%.9g,%.9g"),
+			FHeightmapNoiseSettings::TypeName(Noise.Type), Noise.Seed, Noise.Frequency, Noise.Amplitude,
+			Noise.Octaves, Noise.Lacunarity, Noise.Gain, Noise.WarpStrength, Noise.WarpFrequency);
+	}
+
+	static FString HydraulicCacheInputs(const FHydraulicErosionSettings& Hydraulic)
+	{
+		return FString::Printf(TEXT("%d,%d,%d,%d,%d,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g"),
+			Hydraulic.Seed, Hydraulic.Droplets, Hydraulic.Batches, Hydraulic.MaxLifetime, Hydraulic.BrushRadius,
+			Hydraulic.Inertia, Hydraulic.SedimentCapacityFactor, Hydraulic.MinSedimentCapacity,
+			Hydraulic.ErodeSpeed, Hydraulic.DepositSpeed, Hydraulic.EvaporateSpeed,
+			Hydraulic.Gravity, Hydraulic.InitialWater, Hydraulic.InitialSpeed);
+	}
+
+	/** Raw (pre-normalization) heightmap plus the stats the response reports. */
+	static void SerializeTerrainResult(FArchive& Ar, FString& Backend, int32& Width, int32& Height,
+		int64& DropletsSimulated, int32& ErosionIterationsUsed, TArray<float>& Heightmap)
+	{
+		int32 Version = TerrainCacheVersion;
+		Ar << Version;
+		if (Version != TerrainCacheVersion)
+		{
+			Ar.SetError();
+			return;
+		}
+		Ar << Backend;
+		Ar << Width;
+		Ar << Height;
+		Ar << DropletsSimulated;
+		Ar << ErosionIterationsUsed;
+		Heightmap.BulkSerialize(Ar);
+		if (Ar.IsLoading() && Heightmap.Num() != Width * Height)
+		{
+			Ar.SetError();
+		}
+	}
+
 	static TArray<TSharedPtr<FJsonValue>> BuildPointSampleArray(const TArray<FVector>& Points, int32 MaxPoints = 64)
 	{
 		TArray<TSharedPtr<FJsonValue>> Arr;
@@ -1197,6 +1796,11 @@ namespace
 		Obj->SetNumberField(TEXT("density_field_average"), Diagnostics.DensityFieldAverage);
 		Obj->SetNumberField(TEXT("generation_time_ms"), Diagnostics.GenerationTimeMs);
 		Obj->SetBoolField(TEXT("generation_time_exceeded"), Diagnostics.bGenerationTimeExceeded);
+		Obj->SetStringField(TEXT("cache_status"), Diagnostics.CacheStatus);
+		if (!Diagnostics.CacheKey.IsEmpty())
+		{
+			Obj->SetStringField(TEXT("cache_key"), Diagnostics.CacheKey);
+		}
 
 		TArray<TSharedPtr<FJsonValue>> BiomeCountsArr;
 		for (const TPair<FString, int32>& Pair : Diagnostics.BiomeHistogram)
@@ -1208,6 +1812,23 @@ namespace
 		}
 		Obj->SetArrayField(TEXT("biome_histogram"), BiomeCountsArr);
 
+		TArray<TSharedPtr<FJsonValue>> NodesArr;
+		int32 MemoNodes = 0;
+		int32 ComputedNodes = 0;
+		for (const FDistributionNodeTiming& Node : Diagnostics.Nodes)
+		{
+			TSharedPtr<FJsonObject> Entry = MakeShared<FJsonObject>();
+			Entry->SetStringField(TEXT("node"), Node.Name);
+			Entry->SetStringField(TEXT("status"), Node.Status);
+			Entry->SetNumberField(TEXT("ms"), Node.Ms);
+			NodesArr.Add(MakeShared<FJsonValueObject>(Entry));
+			MemoNodes += Node.Status == TEXT("memo") ? 1 : 0;
+			ComputedNodes += Node.Status == TEXT("computed") ? 1 : 0;
+		}
+		Obj->SetArrayField(TEXT("nodes"), NodesArr);
+		Obj->SetNumberField(TEXT("memo_nodes"), MemoNodes);
+		Obj->SetNumberField(TEXT("computed_nodes"), ComputedNodes);
+
 		TSharedPtr<FJsonObject> SceneObj = MakeShared<FJsonObject>();
 		SceneObj->SetNumberField(TEXT("density_variance"), Diagnostics.SceneMetrics.DensityVarianceScore);
 		SceneObj->SetNumberField(TEXT("cluster_score"), Diagnostics.SceneMetrics.ClusterScore);
@@ -1230,17 +1851,259 @@ namespace
 			return true;
 		}
 
-		if (!FPaletteManager::LoadPaletteById(OutPaletteId, OutPalette, OutPaletteError))
+		// Cached by file timestamp; the referenced assets start streaming so they are resident before placement.
+		if (!FPaletteManager::LoadPaletteById(OutPaletteId, OutPalette, OutPaletteError, /*bPreloadAssets*/ true))
+		{
+			return false;
+		}
+		return true;
+	}
+
+	/** placement: "pcg" (default) hands the points to the target's PCG graph, "native" materializes them. */
+	static bool ParseNativePlacement(const TSharedPtr<FJsonObject>& Args, bool& bOutNative, FString& OutError)
+	{
+		bOutNative = false;
+		FString Placement;
+		if (!Args.IsValid() || !Args->TryGetStringField(TEXT("placement"), Placement) || Placement.IsEmpty()
+			|| Placement.Equals(TEXT("pcg"), ESearchCase::IgnoreCase))
+		{
+			return true;
+		}
+		if (Placement.Equals(TEXT("native"), ESearchCase::IgnoreCase))
+		{
+			bOutNative = true;
+			return true;
+		}
+		OutError = FString::Printf(TEXT("Unknown placement '%s' (expected pcg or native)."), *Placement);
+		return false;
+	}
+
+	/**
+	 * placement:"native": materializes Points as per-cell HISM actors labelled
+	 * <target>_<operator>_Cell_<x>_<y>. Re-running the operator for the same
+	 * target replaces the previous cells.
+	 */
+	static bool MaterializeDistributionPoints(
+		UWorld* World,
+		AActor* TargetActor,
+		const TCHAR* OperatorName,
+		const TArray<FVector>& Points,
+		const FDistributionPointAttributes& Attributes,
+		const TSharedPtr<FJsonObject>& Palette,
+		const TSharedPtr<FJsonObject>& Args,
+		int32 Seed,
+		TSharedPtr<FJsonObject>& OutJson,
+		FString& OutError)
+	{
+		FPointMaterializeSettings Settings;
+		Settings.Prefix = FString::Printf(TEXT("%s_%s"), *TargetActor->GetActorLabel(), OperatorName);
+		Settings.Tag = TEXT("AF_Operator_Materialized");
+		Settings.Seed = Seed;
+
+		double Number = 0.0;
+		if (Args->TryGetNumberField(TEXT("cell_size"), Number))
+		{
+			Settings.CellSize = FMath::Max(0.0, Number);
+		}
+		if (Args->TryGetNumberField(TEXT("cull_distance"), Number))
+		{
+			Settings.CullDistance = FMath::Max(0.0f, (float)Number);
+		}
+		if (Args->HasField(TEXT("align_to_normal")))
+		{
+			Settings.bAlignToNormal = Args->GetBoolField(TEXT("align_to_normal"));
+		}
+		if (Args->TryGetNumberField(TEXT("max_align_angle"), Number))
+		{
+			Settings.MaxAlignAngle = (float)Number;
+		}
+		const TArray<TSharedPtr<FJsonValue>>* Categories = nullptr;
+		if (Args->TryGetArrayField(TEXT("categories"), Categories))
+		{
+			for (const TSharedPtr<FJsonValue>& Value : *Categories)
+			{
+				FString Name;
+				if (Value.IsValid() && Value->TryGetString(Name) && !Name.IsEmpty())
+				{
+					Settings.Categories.Add(Name);
+				}
+			}
+		}
+
+		FPointMaterializeResult Result;
+		if (!FPointMaterializer::Materialize(World, Points, Attributes, Palette, Settings, Result, OutError))
 		{
 			return false;
 		}
+		OutJson = Result.ToJson();
+		OutJson->SetStringField(TEXT("cell_prefix"), Settings.Prefix + TEXT("_Cell_"));
+		OutJson->SetNumberField(TEXT("cell_size"), Settings.CellSize);
+		OutJson->SetBoolField(TEXT("align_to_normal"), Settings.bAlignToNormal);
 		return true;
 	}
+
+	// ─── Operator work ──────────────────────────────────────────────────────
+	//
+	// An operator call in three phases so run_operator_pipeline can overlap
+	// them: the operator's Prepare reads Args and captures what it needs from
+	// the level (game thread), Compute is the pure part and may run on a
+	// worker, Commit applies the result to the level and builds the response
+	// (game thread). The public operators run the three back to back.
+
+	class FOperatorWork
+	{
+	public:
+		virtual ~FOperatorWork() = default;
+
+		/** Compute reads the level (traces, GPU readback) and has to stay on the game thread. */
+		virtual bool ComputesOnGameThread() const { return false; }
+		/** Touches no UObject and no Args JSON; safe on a worker. */
+		virtual void Compute() {}
+		/**
+		 * Game-thread compute that waits on the GPU, one job slice per call: false
+		 * while it is still waiting. The pipeline yields between calls; the
+		 * default runs Compute in one go.
+		 */
+		virtual bool ComputeSlice() { Compute(); return true; }
+		virtual FString Commit() = 0;
+	};
+	using FOperatorWorkPtr = TSharedPtr<FOperatorWork>;
+
+	/** Nothing to compute: a prepare error, or an operator that is all game-thread work. */
+	class FOperatorCommitWork : public FOperatorWork
+	{
+	public:
+		explicit FOperatorCommitWork(TFunction<FString()> InCommit) : CommitFn(MoveTemp(InCommit)) {}
+		virtual bool ComputesOnGameThread() const override { return true; }   // nothing to hand to a worker
+		virtual FString Commit() override { return CommitFn(); }
+
+	private:
+		TFunction<FString()> CommitFn;
+	};
+
+	/** WorkType::Prepare(Args) returns an error response, or empty to go on; a failed prepare commits its error. */
+	template <typename WorkType>
+	static FOperatorWorkPtr PrepareOperatorWork(const TSharedPtr<FJsonObject>& Args)
+	{
+		TSharedRef<WorkType> Work = MakeShared<WorkType>();
+		FString Error = Work->Prepare(Args);
+		if (!Error.IsEmpty())
+		{
+			return MakeShared<FOperatorCommitWork>([Error = MoveTemp(Error)]() { return Error; });
+		}
+		return Work;
+	}
+
+	/** Operators that spawn and trace throughout (road_layout, stamp_poi): the whole call is the commit. */
+	template <FString (*Fn)(const TSharedPtr<FJsonObject>&)>
+	static FOperatorWorkPtr PrepareCommitOnlyWork(const TSharedPtr<FJsonObject>& Args)
+	{
+		return MakeShared<FOperatorCommitWork>([Args]() { return Fn(Args); });
+	}
+
+	static FString RunOperatorWork(FOperatorWork& Work)
+	{
+		Work.Compute();
+		return Work.Commit();
+	}
+
+	/**
+	 * Target lookup and distribution shared by the scatter operators. Prepare
+	 * captures the target, request and palette; Compute generates the points.
+	 * Commit starts from the weak pointers, since the target can go away
+	 * between the phases.
+	 */
+	class FDistributionOperatorWork : public FOperatorWork
+	{
+	public:
+		virtual bool ComputesOnGameThread() const override { return Distribution.bUseSlopeRange; }
+
+		virtual void Compute() override
+		{
+			AGENTFORGE_TRACE_SCOPE("AgentForge.Operators.ComputeDistribution");
+			DistributionPoints = GenerateDistributionPoints(Inputs, Distribution, &DistributionDiagnostics, &DistributionAttributes);
+		}
+
+	protected:
+		/** World, target and distribution request; returns an error response or empty. */
+		FString PrepareTarget(const TSharedPtr<FJsonObject>& InArgs, const TArray<FString>& TargetFields,
+			const TCHAR* MissingTargetError, const TCHAR* NotFoundPrefix)
+		{
+			Args = InArgs;
+			UWorld* World = GetEditorWorld();
+			if (!World)
+			{
+				return ErrorJson(TEXT("No editor world."));
+			}
+			const FString TargetId = FirstNonEmptyField(Args, TargetFields);
+			if (TargetId.IsEmpty())
+			{
+				return ErrorJson(MissingTargetError);
+			}
+			AActor* TargetActor = FindActorByAnyId(World, TargetId);
+			if (!TargetActor)
+			{
+				return ErrorJson(FString::Printf(TEXT("%s: %s"), NotFoundPrefix, *TargetId));
+			}
+			WeakWorld = World;
+			WeakTarget = TargetActor;
+			Distribution = ParseDistributionRequest(Args, TargetActor);
+			Inputs = CaptureDistributionInputs(World, TargetActor, Distribution);
+			return FString();
+		}
+
+		/** palette_id, and placement when the operator supports native placement. */
+		FString PreparePalette(bool bWithPlacement)
+		{
+			FString PlacementError;
+			if (bWithPlacement && !ParseNativePlacement(Args, bNativePlacement, PlacementError))
+			{
+				return ErrorJson(PlacementError);
+			}
+			FString PaletteError;
+			if (!ResolvePaletteIfPresent(Args, PaletteId, PaletteObj, PaletteError))
+			{
+				return ErrorJson(PaletteError);
+			}
+			if (bNativePlacement && !PaletteObj.IsValid())
+			{
+				return ErrorJson(TEXT("placement:\"native\" requires palette_id."));
+			}
+			return FString();
+		}
+
+		/** Null with OutError set when the world or target went away after Prepare. */
+		AActor* ResolveTarget(UWorld*& OutWorld, FString& OutError) const
+		{
+			OutWorld = WeakWorld.Get();
+			AActor* TargetActor = WeakTarget.Get();
+			if (!OutWorld || !TargetActor)
+			{
+				OutError = ErrorJson(TEXT("Target actor was removed before the operator committed."));
+				return nullptr;
+			}
+			return TargetActor;
+		}
+
+		TSharedPtr<FJsonObject> Args;
+		TWeakObjectPtr<UWorld> WeakWorld;
+		TWeakObjectPtr<AActor> WeakTarget;
+		FDistributionRequest Distribution;
+		FDistributionInputs Inputs;
+		bool bNativePlacement = false;
+		FString PaletteId;
+		TSharedPtr<FJsonObject> PaletteObj;
+
+		TArray<FVector> DistributionPoints;
+		FDistributionDiagnostics DistributionDiagnostics;
+		FDistributionPointAttributes DistributionAttributes;
+	};
 #endif // WITH_EDITOR
 }
 
 FString FProceduralOpsModule::GetOperatorPolicy()
 {
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Operators.GetOperatorPolicy");
 	TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
 	Root->SetBoolField(TEXT("ok"), true);
 	Root->SetBoolField(TEXT("operator_only"), GOperatorPolicy.bOperatorOnly);
@@ -1251,11 +2114,17 @@ FString FProceduralOpsModule::GetOperatorPolicy()
 	Root->SetNumberField(TEXT("max_spawn_points"), GOperatorPolicy.MaxSpawnPoints);
 	Root->SetNumberField(TEXT("max_cluster_count"), GOperatorPolicy.MaxClusterCount);
 	Root->SetNumberField(TEXT("max_generation_time_ms"), GOperatorPolicy.MaxGenerationTimeMs);
+	Root->SetNumberField(TEXT("cache_memory_mb"), FAgentForgeProceduralCache::Get().GetMemoryBudgetBytes() / (1024.0 * 1024.0));
+	const FAgentForgeRuntimeCost::FBudget& RuntimeCaps = FAgentForgeRuntimeCost::Get().GetPolicyCaps();
+	Root->SetNumberField(TEXT("max_shadow_light_overlap"), RuntimeCaps.MaxShadowLightOverlap);
+	Root->SetNumberField(TEXT("max_particle_overdraw"), RuntimeCaps.MaxParticleOverdraw);
+	Root->SetNumberField(TEXT("max_audio_voices"), RuntimeCaps.MaxAudioVoices);
 	return ToJson(Root);
 }
 
 FString FProceduralOpsModule::SetOperatorPolicy(const TSharedPtr<FJsonObject>& Args)
 {
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Operators.SetOperatorPolicy");
 	if (Args.IsValid())
 	{
 		if (Args->HasField(TEXT("operator_only")))
@@ -1280,7 +2149,7 @@ FString FProceduralOpsModule::SetOperatorPolicy(const TSharedPtr<FJsonObject>& A
 		}
 		if (Args->HasField(TEXT("max_spawn_points")))
 		{
-			GOperatorPolicy.MaxSpawnPoints = FMath::Clamp((int32)Args->GetNumberField(TEXT("max_spawn_points")), 1, 500000);
+			GOperatorPolicy.MaxSpawnPoints = FMath::Clamp((int32)Args->GetNumberField(TEXT("max_spawn_points")), 1, FDistributionEngine::MaxPoints);
 		}
 		if (Args->HasField(TEXT("max_cluster_count")))
 		{
@@ -1290,10 +2159,46 @@ FString FProceduralOpsModule::SetOperatorPolicy(const TSharedPtr<FJsonObject>& A
 		{
 			GOperatorPolicy.MaxGenerationTimeMs = FMath::Clamp((float)Args->GetNumberField(TEXT("max_generation_time_ms")), 10.0f, 600000.0f);
 		}
+		if (Args->HasField(TEXT("cache_memory_mb")))
+		{
+			const double CacheMB = FMath::Clamp(Args->GetNumberField(TEXT("cache_memory_mb")), 0.0, 65536.0);
+			FAgentForgeProceduralCache::Get().SetMemoryBudgetBytes((int64)(CacheMB * 1024.0 * 1024.0));
+		}
+
+		// Runtime-cost caps over the preset budgets of pipeline light / VFX / audio placement.
+		FAgentForgeRuntimeCost::FBudget RuntimeCaps = FAgentForgeRuntimeCost::Get().GetPolicyCaps();
+		if (Args->HasField(TEXT("max_shadow_light_overlap")))
+		{
+			RuntimeCaps.MaxShadowLightOverlap = FMath::Clamp((int32)Args->GetNumberField(TEXT("max_shadow_light_overlap")), 1, 64);
+		}
+		if (Args->HasField(TEXT("max_particle_overdraw")))
+		{
+			RuntimeCaps.MaxParticleOverdraw = FMath::Clamp((float)Args->GetNumberField(TEXT("max_particle_overdraw")), 0.0f, 256.0f);
+		}
+		if (Args->HasField(TEXT("max_audio_voices")))
+		{
+			RuntimeCaps.MaxAudioVoices = FMath::Clamp((int32)Args->GetNumberField(TEXT("max_audio_voices")), 1, 256);
+		}
+		FAgentForgeRuntimeCost::Get().SetPolicyCaps(RuntimeCaps);
 	}
 	return GetOperatorPolicy();
 }
 
+FString FProceduralOpsModule::ClearOperatorCache(const TSharedPtr<FJsonObject>& Args)
+{
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Operators.ClearOperatorCache");
+	const bool bIncludeDisk = (Args.IsValid() && Args->HasField(TEXT("include_disk"))) ? Args->GetBoolField(TEXT("include_disk")) : false;
+	FAgentForgeProceduralCache::Get().Clear(bIncludeDisk);
+	FDistributionNodeMemo::Get().Clear();
+
+	TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetBoolField(TEXT("ok"), true);
+	Root->SetBoolField(TEXT("include_disk"), bIncludeDisk);
+	Root->SetObjectField(TEXT("cache"), FAgentForgeProceduralCache::Get().GetStatsJson());
+	Root->SetObjectField(TEXT("distribution_graph"), FDistributionNodeMemo::Get().GetStatsJson());
+	return ToJson(Root);
+}
+
 bool FProceduralOpsModule::IsOperatorOnlyMode()
 {
 	return GOperatorPolicy.bOperatorOnly;
@@ -1301,6 +2206,7 @@ bool FProceduralOpsModule::IsOperatorOnlyMode()
 
 FString FProceduralOpsModule::GetProceduralCapabilities(const TSharedPtr<FJsonObject>& Args)
 {
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Operators.GetProceduralCapabilities");
 	TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
 	Root->SetBoolField(TEXT("ok"), true);
 
@@ -1428,302 +2334,892 @@ FString FProceduralOpsModule::GetProceduralCapabilities(const TSharedPtr<FJsonOb
 	return ToJson(Root);
 }
 
-FString FProceduralOpsModule::TerrainGenerate(const TSharedPtr<FJsonObject>& Args)
-{
 #if WITH_EDITOR
-	UWorld* World = GetEditorWorld();
-	if (!World)
+namespace
+{
+	/**
+	 * terrain_generate: noise, erosion, cache and file I/O in Compute. The GPU
+	 * path keeps it on the game thread, where ComputeSlice submits the passes
+	 * and then polls the readback once per slice.
+	 */
+	class FTerrainGenerateWork : public FOperatorWork
 	{
-		return ErrorJson(TEXT("No editor world."));
-	}
+	public:
+		FString Prepare(const TSharedPtr<FJsonObject>& Args);
+
+		virtual bool ComputesOnGameThread() const override { return Backend == TEXT("gpu"); }
+		virtual void Compute() override;
+		virtual bool ComputeSlice() override;
+		virtual FString Commit() override;
+
+	private:
+		/** Cache, tiled, import or GPU submit. True when a GPU readback is now pending. */
+		bool StartCompute();
+		/** CPU generation (unless a map is already in hand), cache store, normalize, export. */
+		void FinishCompute();
+
+		TWeakObjectPtr<UWorld> WeakWorld;
+
+		// Settings, from Prepare.
+		int32 Seed = 0;
+		int32 RequestedWidth = 0;
+		int32 RequestedHeight = 0;
+		int32 Width = 0;
+		int32 Height = 0;
+		float Frequency = 0.0f;
+		float Amplitude = 0.0f;
+		float RidgeStrength = 0.0f;
+		int32 ErosionIterations = 0;
+		float ErosionStrength = 0.0f;
+		float ErosionConvergence = 0.0f;
+		bool bSpawnLandscape = false;
+		EHeightmapPrecision Precision = EHeightmapPrecision::Float32;
+		FString ImportPath;
+		FString ExportPath;
+		bool bImported = false;
+		FString Backend;
+		FString GpuFallbackReason;
+		bool bTiled = false;
+		int32 TileSize = 0;
+		int32 TileBlend = 0;
+		int32 ImportWidth = 0;
+		int32 ImportHeight = 0;
+		FString ErosionMode;
+		bool bThermal = false;
+		bool bHydraulic = false;
+		FHydraulicErosionSettings Hydraulic;
+		FHeightmapNoiseSettings BaseNoise;
+		FHeightmapNoiseSettings RidgeNoise;
+		EProceduralCacheMode CacheMode = EProceduralCacheMode::Memory;
+		bool bCacheable = false;
+		FString CacheKey;
+		FString CacheStatus;
+
+		// Results, from Compute.
+		FString ComputeError;
+		TArray<float> Heightmap;
+		double NoiseMs = 0.0;
+		double ErosionMs = 0.0;
+		int64 DropletsSimulated = 0;
+		int32 ErosionIterationsUsed = 0;
+		FTerrainGpuStats GpuStats;
+		TUniquePtr<FTerrainGpuRun> GpuRun;
+		bool bUsedGpu = false;
+		bool bGpuFellBack = false;
+		FTiledTerrainResult Tiled;
+		FHeightmap Map;
+		double ImportMs = 0.0;
+		float MinH = TNumericLimits<float>::Max();
+		float MaxH = TNumericLimits<float>::Lowest();
+		float AvgH = 0.0f;
+		bool bCacheHit = false;
+	};
 
-	const int32 Seed = (Args.IsValid() && Args->HasField(TEXT("seed"))) ? (int32)Args->GetNumberField(TEXT("seed")) : 48293;
-	const int32 Width = (Args.IsValid() && Args->HasField(TEXT("width"))) ? (int32)Args->GetNumberField(TEXT("width")) : 257;
-	const int32 Height = (Args.IsValid() && Args->HasField(TEXT("height"))) ? (int32)Args->GetNumberField(TEXT("height")) : 257;
-	const float Frequency = (Args.IsValid() && Args->HasField(TEXT("frequency"))) ? (float)Args->GetNumberField(TEXT("frequency")) : 0.01f;
-	const float Amplitude = (Args.IsValid() && Args->HasField(TEXT("amplitude"))) ? (float)Args->GetNumberField(TEXT("amplitude")) : 1.0f;
-	const float RidgeStrength = (Args.IsValid() && Args->HasField(TEXT("ridge_strength"))) ? (float)Args->GetNumberField(TEXT("ridge_strength")) : 0.35f;
-	const int32 ErosionIterations = (Args.IsValid() && Args->HasField(TEXT("erosion_iterations"))) ? (int32)Args->GetNumberField(TEXT("erosion_iterations")) : 16;
-	const float ErosionStrength =
-		(Args.IsValid() && Args->HasField(TEXT("erosion_strength"))) ? (float)Args->GetNumberField(TEXT("erosion_strength")) :
-		((Args.IsValid() && Args->HasField(TEXT("sediment_strength"))) ? (float)Args->GetNumberField(TEXT("sediment_strength")) : 0.35f);
-	const bool bSpawnLandscape = (Args.IsValid() && Args->HasField(TEXT("spawn_landscape"))) ? Args->GetBoolField(TEXT("spawn_landscape")) : false;
+	FString FTerrainGenerateWork::Prepare(const TSharedPtr<FJsonObject>& Args)
+	{
+		UWorld* World = GetEditorWorld();
+		if (!World)
+		{
+			return ErrorJson(TEXT("No editor world."));
+		}
+		WeakWorld = World;
 
-	TArray<float> Heightmap = FTerrainGenerator::GenerateHeightmap(Width, Height, Seed, Frequency, Amplitude);
-	FTerrainGenerator::ApplyRidgedNoise(Heightmap, Width, Height, Seed ^ 0x18A1F6C3, RidgeStrength);
-	FTerrainGenerator::ApplyErosion(Heightmap, Width, Height, ErosionIterations, ErosionStrength);
-	FTerrainGenerator::NormalizeHeightmap(Heightmap, 0.0f, 1.0f);
+		Seed = (Args.IsValid() && Args->HasField(TEXT("seed"))) ? (int32)Args->GetNumberField(TEXT("seed")) : 48293;
+		RequestedWidth = (Args.IsValid() && Args->HasField(TEXT("width"))) ? (int32)Args->GetNumberField(TEXT("width")) : 257;
+		RequestedHeight = (Args.IsValid() && Args->HasField(TEXT("height"))) ? (int32)Args->GetNumberField(TEXT("height")) : 257;
+		Frequency = (Args.IsValid() && Args->HasField(TEXT("frequency"))) ? (float)Args->GetNumberField(TEXT("frequency")) : 0.01f;
+		Amplitude = (Args.IsValid() && Args->HasField(TEXT("amplitude"))) ? (float)Args->GetNumberField(TEXT("amplitude")) : 1.0f;
+		RidgeStrength = (Args.IsValid() && Args->HasField(TEXT("ridge_strength"))) ? (float)Args->GetNumberField(TEXT("ridge_strength")) : 0.35f;
+		ErosionIterations = (Args.IsValid() && Args->HasField(TEXT("erosion_iterations"))) ? (int32)Args->GetNumberField(TEXT("erosion_iterations")) : 16;
+		ErosionStrength =
+			(Args.IsValid() && Args->HasField(TEXT("erosion_strength"))) ? (float)Args->GetNumberField(TEXT("erosion_strength")) :
+			((Args.IsValid() && Args->HasField(TEXT("sediment_strength"))) ? (float)Args->GetNumberField(TEXT("sediment_strength")) : 0.35f);
+		bSpawnLandscape = (Args.IsValid() && Args->HasField(TEXT("spawn_landscape"))) ? Args->GetBoolField(TEXT("spawn_landscape")) : false;
 
-	float MinH = TNumericLimits<float>::Max();
-	float MaxH = TNumericLimits<float>::Lowest();
-	float AvgH = 0.0f;
-	for (const float Value : Heightmap)
-	{
-		MinH = FMath::Min(MinH, Value);
-		MaxH = FMath::Max(MaxH, Value);
-		AvgH += Value;
-	}
-	if (Heightmap.Num() > 0)
-	{
-		AvgH /= (float)Heightmap.Num();
+		FString PrecisionName;
+		if (Args.IsValid() && Args->TryGetStringField(TEXT("heightmap_precision"), PrecisionName) && !PrecisionName.IsEmpty() &&
+			!FHeightmap::ParsePrecision(PrecisionName, Precision))
+		{
+			return ErrorJson(FString::Printf(TEXT("Unknown heightmap_precision '%s' (float32|float16|uint16)."), *PrecisionName));
+		}
+
+		// Relative heightmap paths live under Saved/AgentForge/Heightmaps/.
+		if (Args.IsValid())
+		{
+			Args->TryGetStringField(TEXT("import_path"), ImportPath);
+			Args->TryGetStringField(TEXT("export_path"), ExportPath);
+		}
+		for (FString* Path : { &ImportPath, &ExportPath })
+		{
+			if (!Path->IsEmpty() && FPaths::IsRelative(*Path))
+			{
+				*Path = FPaths::ProjectSavedDir() / TEXT("AgentForge/Heightmaps") / *Path;
+			}
+		}
+		bImported = !ImportPath.IsEmpty();
+
+		Backend = TEXT("cpu");
+		if (Args.IsValid() && Args->HasField(TEXT("backend")))
+		{
+			Backend = Args->GetStringField(TEXT("backend")).ToLower();
+		}
+		if (Backend != TEXT("cpu") && Backend != TEXT("gpu"))
+		{
+			return ErrorJson(FString::Printf(TEXT("Unknown backend '%s' (cpu|gpu)."), *Backend));
+		}
+		if (Backend == TEXT("gpu") && !FTerrainGpu::IsAvailable(&GpuFallbackReason))
+		{
+			Backend = TEXT("cpu");
+		}
+
+		// The GPU path keeps larger maps; the CPU generator tops out at 4096. Beyond
+		// that (or on request) the map is generated in halo tiles and streamed to disk.
+		const int32 MaxSide = Backend == TEXT("gpu") ? FTerrainGpu::MaxResolution : 4096;
+		bTiled = !bImported && (
+			((Args.IsValid() && Args->HasField(TEXT("tiled"))) ? Args->GetBoolField(TEXT("tiled")) : false) ||
+			RequestedWidth > MaxSide || RequestedHeight > MaxSide);
+		if (bTiled && !ExportPath.IsEmpty())
+		{
+			return ErrorJson(TEXT("export_path is not supported for tiled maps; the tiles are already on disk (tile_cache_dir)."));
+		}
+		if (bTiled && Backend == TEXT("gpu"))
+		{
+			Backend = TEXT("cpu");
+			GpuFallbackReason = TEXT("Tiled generation runs on the CPU.");
+		}
+		const int32 MaxMapSide = bTiled ? FTiledTerrainGenerator::MaxResolution : MaxSide;
+		Width = FMath::Clamp(RequestedWidth, 2, MaxMapSide);
+		Height = FMath::Clamp(RequestedHeight, 2, MaxMapSide);
+
+		ErosionMode = TEXT("thermal");
+		if (Args.IsValid() && Args->HasField(TEXT("erosion_mode")))
+		{
+			ErosionMode = Args->GetStringField(TEXT("erosion_mode")).ToLower();
+		}
+		bThermal = ErosionMode == TEXT("thermal") || ErosionMode == TEXT("both");
+		bHydraulic = ErosionMode == TEXT("hydraulic") || ErosionMode == TEXT("both");
+		if (!bThermal && !bHydraulic && ErosionMode != TEXT("none"))
+		{
+			return ErrorJson(FString::Printf(TEXT("Unknown erosion_mode '%s' (thermal|hydraulic|both|none)."), *ErosionMode));
+		}
+
+		// Default droplet budget scales with the map: one droplet per 16 texels.
+		const int64 MapTexels = (int64)Width * Height;
+		Hydraulic.Seed = Seed ^ 0x2F6B1D37;
+		Hydraulic.Droplets = (Args.IsValid() && Args->HasField(TEXT("erosion_droplets")))
+			? (int32)Args->GetNumberField(TEXT("erosion_droplets"))
+			: (int32)FMath::Clamp<int64>(MapTexels / 16, 1000, bTiled ? 8000000 : 2000000);
+		Hydraulic.BrushRadius = (Args.IsValid() && Args->HasField(TEXT("erosion_radius"))) ? (int32)Args->GetNumberField(TEXT("erosion_radius")) : 3;
+		Hydraulic.MaxLifetime = (Args.IsValid() && Args->HasField(TEXT("erosion_lifetime"))) ? (int32)Args->GetNumberField(TEXT("erosion_lifetime")) : 30;
+		Hydraulic.ErodeSpeed = ErosionStrength;
+		Hydraulic.DepositSpeed = ErosionStrength;
+		Hydraulic = Hydraulic.Sanitized();
+		ErosionConvergence = (Args.IsValid() && Args->HasField(TEXT("erosion_convergence"))) ? (float)Args->GetNumberField(TEXT("erosion_convergence")) : 1.0e-6f;
+
+		BaseNoise.Seed = Seed;
+		BaseNoise.Frequency = Frequency;
+		BaseNoise.Amplitude = Amplitude;
+		FString NoiseType;
+		if (Args.IsValid() && Args->TryGetStringField(TEXT("noise_type"), NoiseType) && !NoiseType.IsEmpty() &&
+			!FHeightmapNoiseSettings::ParseType(NoiseType, BaseNoise.Type))
+		{
+			return ErrorJson(FString::Printf(TEXT("Unknown noise_type '%s' (fbm|ridged|billow)."), *NoiseType));
+		}
+		BaseNoise.Octaves = (Args.IsValid() && Args->HasField(TEXT("octaves"))) ? (int32)Args->GetNumberField(TEXT("octaves")) : 6;
+		BaseNoise.Lacunarity = (Args.IsValid() && Args->HasField(TEXT("lacunarity"))) ? (float)Args->GetNumberField(TEXT("lacunarity")) : 2.0f;
+		BaseNoise.Gain = (Args.IsValid() && Args->HasField(TEXT("gain"))) ? (float)Args->GetNumberField(TEXT("gain")) : 0.5f;
+		BaseNoise.WarpStrength = (Args.IsValid() && Args->HasField(TEXT("warp_strength"))) ? (float)Args->GetNumberField(TEXT("warp_strength")) : 0.0f;
+		BaseNoise.WarpFrequency = (Args.IsValid() && Args->HasField(TEXT("warp_frequency"))) ? (float)Args->GetNumberField(TEXT("warp_frequency")) : 0.0f;
+		BaseNoise = BaseNoise.Sanitized();
+
+		RidgeNoise = BaseNoise;
+		RidgeNoise.Type = EHeightmapNoiseType::Ridged;
+		RidgeNoise.Seed = Seed ^ 0x18A1F6C3;
+		RidgeNoise.Amplitude = 1.0f;
+		RidgeNoise.WarpStrength = 0.0f;
+		RidgeNoise.Frequency = (Args.IsValid() && Args->HasField(TEXT("ridge_frequency"))) ? (float)Args->GetNumberField(TEXT("ridge_frequency")) : 0.015f;
+		RidgeNoise.Octaves = (Args.IsValid() && Args->HasField(TEXT("ridge_octaves"))) ? (int32)Args->GetNumberField(TEXT("ridge_octaves")) : 4;
+		RidgeNoise = RidgeNoise.Sanitized();
+
+		FString CacheModeName;
+		if (Args.IsValid() && Args->TryGetStringField(TEXT("cache"), CacheModeName) && !CacheModeName.IsEmpty() &&
+			!FAgentForgeProceduralCache::ParseMode(CacheModeName, CacheMode))
+		{
+			return ErrorJson(FString::Printf(TEXT("Unknown cache '%s' (off|memory|disk)."), *CacheModeName));
+		}
+		// Tiled maps keep their own tile cache on disk; imports are already a file read.
+		bCacheable = !bTiled && !bImported && CacheMode != EProceduralCacheMode::Off;
+		CacheStatus = TEXT("off");
+		if (bCacheable)
+		{
+			CacheKey = FAgentForgeProceduralCache::MakeKey(TerrainCacheKind, FString::Printf(
+				TEXT("v%d|%s|%dx%d|base(%s)|ridge(%s)x%.9g|%s|hydraulic(%s)|thermal%d,%.9g,%.9g"),
+				TerrainCacheVersion, *Backend, Width, Height,
+				*NoiseCacheInputs(BaseNoise), *NoiseCacheInputs(RidgeNoise), RidgeStrength,
+				*ErosionMode, bHydraulic ? *HydraulicCacheInputs(Hydraulic) : TEXT(""),
+				bThermal ? ErosionIterations : 0, bThermal ? ErosionStrength : 0.0f, bThermal ? ErosionConvergence : 0.0f));
+			CacheStatus = TEXT("miss");
+		}
+
+		// Tiled and imported maps read these in Compute, which must not touch Args.
+		TileSize = (Args.IsValid() && Args->HasField(TEXT("tile_size"))) ? (int32)Args->GetNumberField(TEXT("tile_size")) : 1024;
+		TileBlend = (Args.IsValid() && Args->HasField(TEXT("tile_blend"))) ? (int32)Args->GetNumberField(TEXT("tile_blend")) : 32;
+		ImportWidth = (Args.IsValid() && Args->HasField(TEXT("width"))) ? RequestedWidth : 0;
+		ImportHeight = (Args.IsValid() && Args->HasField(TEXT("height"))) ? RequestedHeight : 0;
+		return FString();
 	}
 
-	bool bLandscapeSpawned = false;
-	FString SpawnMessage = TEXT("spawn_landscape=false");
-	if (bSpawnLandscape)
+	void FTerrainGenerateWork::Compute()
 	{
-		bLandscapeSpawned = FTerrainGenerator::SpawnLandscape(
-			World,
-			Heightmap,
-			Width,
-			Height,
-			FVector::ZeroVector,
-			FVector(100.0f, 100.0f, 100.0f),
-			SpawnMessage);
+		// Workers and inline callers have no slice to yield to.
+		while (!ComputeSlice())
+		{
+		}
 	}
 
-	TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
-	Root->SetBoolField(TEXT("ok"), true);
-	Root->SetStringField(TEXT("operator"), TEXT("terrain_generate"));
-	Root->SetNumberField(TEXT("seed"), Seed);
-	Root->SetNumberField(TEXT("width"), Width);
-	Root->SetNumberField(TEXT("height"), Height);
-	Root->SetNumberField(TEXT("frequency"), Frequency);
-	Root->SetNumberField(TEXT("amplitude"), Amplitude);
-	Root->SetNumberField(TEXT("ridge_strength"), RidgeStrength);
-	Root->SetNumberField(TEXT("erosion_iterations"), ErosionIterations);
-	Root->SetNumberField(TEXT("erosion_strength"), ErosionStrength);
-	Root->SetNumberField(TEXT("sediment_strength"), ErosionStrength);
-	Root->SetNumberField(TEXT("height_min"), MinH);
-	Root->SetNumberField(TEXT("height_max"), MaxH);
-	Root->SetNumberField(TEXT("height_avg"), AvgH);
-	Root->SetBoolField(TEXT("landscape_spawned"), bLandscapeSpawned);
-	Root->SetStringField(TEXT("landscape_message"), SpawnMessage);
-	return ToJson(Root);
-#else
-	return ErrorJson(TEXT("WITH_EDITOR required."));
-#endif
-}
+	bool FTerrainGenerateWork::ComputeSlice()
+	{
+		AGENTFORGE_TRACE_SCOPE("AgentForge.Operators.ComputeTerrain");
+		if (!GpuRun.IsValid())
+		{
+			if (StartCompute())
+			{
+				return false;
+			}
+		}
+		else
+		{
+			const FTerrainGpuRun::EStatus Status = GpuRun->Poll();
+			if (Status == FTerrainGpuRun::EStatus::Pending)
+			{
+				return false;
+			}
+			GpuStats = GpuRun->GetStats();
+			if (Status == FTerrainGpuRun::EStatus::Succeeded)
+			{
+				bUsedGpu = true;
+				Heightmap = MoveTemp(GpuRun->GetHeightmap());
+				DropletsSimulated = GpuStats.DropletsSimulated;
+				ErosionIterationsUsed = GpuStats.ThermalIterations;
+			}
+			else
+			{
+				GpuFallbackReason = GpuRun->GetError();
+				bGpuFellBack = true;
+				Backend = TEXT("cpu");
+				Width = FMath::Min(Width, 4096);
+				Height = FMath::Min(Height, 4096);
+			}
+		}
+		FinishCompute();
+		return true;
+	}
 
-FString FProceduralOpsModule::SurfaceScatter(const TSharedPtr<FJsonObject>& Args)
-{
-#if WITH_EDITOR
-	UWorld* World = GetEditorWorld();
-	if (!World)
+	bool FTerrainGenerateWork::StartCompute()
 	{
-		return ErrorJson(TEXT("No editor world."));
+		if (bCacheable)
+		{
+			bool bFromDisk = false;
+			if (const FAgentForgeProceduralCache::FPayload Payload = FAgentForgeProceduralCache::Get().Find(TerrainCacheKind, CacheKey, CacheMode, &bFromDisk))
+			{
+				FString CachedBackend;
+				int32 CachedWidth = 0;
+				int32 CachedHeight = 0;
+				int64 CachedDroplets = 0;
+				int32 CachedIterations = 0;
+				FMemoryReader Reader(*Payload);
+				SerializeTerrainResult(Reader, CachedBackend, CachedWidth, CachedHeight, CachedDroplets, CachedIterations, Heightmap);
+				if (!Reader.IsError())
+				{
+					bCacheHit = true;
+					CacheStatus = bFromDisk ? TEXT("disk") : TEXT("memory");
+					Backend = CachedBackend;
+					Width = CachedWidth;
+					Height = CachedHeight;
+					DropletsSimulated = CachedDroplets;
+					ErosionIterationsUsed = CachedIterations;
+				}
+				else
+				{
+					Heightmap.Reset();
+				}
+			}
+		}
+
+		if (bCacheHit)
+		{
+			// Heightmap holds the cached raw map; normalization below runs as usual.
+		}
+		else if (bTiled)
+		{
+			FTiledTerrainSettings TiledSettings;
+			TiledSettings.Width = Width;
+			TiledSettings.Height = Height;
+			TiledSettings.TileSize = TileSize;
+			TiledSettings.Blend = TileBlend;
+			TiledSettings.BaseNoise = BaseNoise;
+			TiledSettings.RidgeNoise = RidgeNoise;
+			TiledSettings.RidgeStrength = RidgeStrength;
+			TiledSettings.bHydraulic = bHydraulic;
+			TiledSettings.Hydraulic = Hydraulic;
+			TiledSettings.bThermal = bThermal;
+			TiledSettings.ThermalIterations = ErosionIterations;
+			TiledSettings.ThermalStrength = ErosionStrength;
+			if (!FTiledTerrainGenerator::Generate(TiledSettings, Tiled, ComputeError))
+			{
+				return false;
+			}
+			DropletsSimulated = Tiled.DropletsSimulated;
+			ErosionIterationsUsed = bThermal ? FMath::Clamp(ErosionIterations, 0, 256) : 0;
+
+			// Tiles hold raw heights; report the stats of the normalized map.
+			const float RawRange = Tiled.RawMax - Tiled.RawMin;
+			MinH = 0.0f;
+			MaxH = RawRange > KINDA_SMALL_NUMBER ? 1.0f : 0.0f;
+			AvgH = RawRange > KINDA_SMALL_NUMBER ? (Tiled.RawAvg - Tiled.RawMin) / RawRange : 0.0f;
+		}
+		else if (bImported)
+		{
+			const double ImportStart = FPlatformTime::Seconds();
+			if (!FHeightmap::Load(ImportPath, ImportWidth, ImportHeight, Map, ComputeError))
+			{
+				return false;
+			}
+			Width = Map.GetWidth();
+			Height = Map.GetHeight();
+			Backend = TEXT("cpu");
+			ImportMs = (FPlatformTime::Seconds() - ImportStart) * 1000.0;
+		}
+		else if (Backend == TEXT("gpu"))
+		{
+			FTerrainGpuJob Job;
+			Job.Width = Width;
+			Job.Height = Height;
+			Job.BaseNoise = BaseNoise;
+			Job.RidgeNoise = RidgeNoise;
+			Job.RidgeStrength = RidgeStrength;
+			Job.bHydraulic = bHydraulic;
+			Job.Hydraulic = Hydraulic;
+			Job.bThermal = bThermal;
+			Job.ThermalIterations = ErosionIterations;
+			Job.ThermalStrength = ErosionStrength;
+			GpuRun = MakeUnique<FTerrainGpuRun>();
+			if (GpuRun->Submit(Job, GpuFallbackReason))
+			{
+				return true;
+			}
+			bGpuFellBack = true;
+			Backend = TEXT("cpu");
+			Width = FMath::Min(Width, 4096);
+			Height = FMath::Min(Height, 4096);
+		}
+		return false;
 	}
 
-	const FString TargetId = FirstNonEmptyField(Args, { TEXT("target_label"), TEXT("pcg_volume_label"), TEXT("actor_label"), TEXT("target_actor") });
-	if (TargetId.IsEmpty())
+	void FTerrainGenerateWork::FinishCompute()
 	{
-		return ErrorJson(TEXT("op_surface_scatter requires target_label (or pcg_volume_label)."));
+		if (!ComputeError.IsEmpty())
+		{
+			return;
+		}
+		if (!bTiled && !bImported && !bUsedGpu && !bCacheHit)
+		{
+			const double NoiseStart = FPlatformTime::Seconds();
+			Heightmap = FTerrainGenerator::GenerateHeightmap(Width, Height, BaseNoise);
+			FTerrainGenerator::ApplyRidgedNoise(Heightmap, Width, Height, RidgeNoise, RidgeStrength);
+			NoiseMs = (FPlatformTime::Seconds() - NoiseStart) * 1000.0;
+
+			const double ErosionStart = FPlatformTime::Seconds();
+			if (bHydraulic)
+			{
+				DropletsSimulated = FTerrainGenerator::ApplyHydraulicErosion(Heightmap, Width, Height, Hydraulic);
+			}
+			if (bThermal)
+			{
+				ErosionIterationsUsed = FTerrainGenerator::ApplyErosion(Heightmap, Width, Height, ErosionIterations, ErosionStrength, ErosionConvergence);
+			}
+			ErosionMs = (FPlatformTime::Seconds() - ErosionStart) * 1000.0;
+		}
+		if (!bTiled)
+		{
+			// A GPU request that fell back produced a CPU map, possibly clamped to
+			// 4096; under the GPU key it would be served to later requests that the
+			// GPU could satisfy at full size, so it is not stored.
+			if (bCacheable && !bCacheHit && !bGpuFellBack)
+			{
+				TArray<uint8> Bytes;
+				FMemoryWriter Writer(Bytes);
+				SerializeTerrainResult(Writer, Backend, Width, Height, DropletsSimulated, ErosionIterationsUsed, Heightmap);
+				FAgentForgeProceduralCache::Get().Store(TerrainCacheKind, CacheKey, MoveTemp(Bytes), CacheMode);
+			}
+			if (!bImported)
+			{
+				Map = FHeightmap(MoveTemp(Heightmap), Width, Height);
+			}
+			FTerrainGenerator::NormalizeHeightmap(Map, 0.0f, 1.0f);
+			Map.SetPrecision(Precision, 0.0f, 1.0f);
+
+			TArray<float> RowScratch;
+			for (int32 Y = 0; Y < Map.GetHeight(); ++Y)
+			{
+				const float* Row = Map.ReadRow(Y, RowScratch);
+				for (int32 X = 0; X < Map.GetWidth(); ++X)
+				{
+					MinH = FMath::Min(MinH, Row[X]);
+					MaxH = FMath::Max(MaxH, Row[X]);
+					AvgH += Row[X];
+				}
+			}
+			if (Map.Num() > 0)
+			{
+				AvgH /= (float)Map.Num();
+			}
+
+			if (!ExportPath.IsEmpty() && !Map.Save(ExportPath, ComputeError))
+			{
+				return;
+			}
+		}
 	}
 
-	AActor* TargetActor = FindActorByAnyId(World, TargetId);
-	if (!TargetActor)
+	FString FTerrainGenerateWork::Commit()
 	{
-		return ErrorJson(FString::Printf(TEXT("Target actor not found: %s"), *TargetId));
+		if (!ComputeError.IsEmpty())
+		{
+			return ErrorJson(ComputeError);
+		}
+		UWorld* World = WeakWorld.Get();
+		if (!World)
+		{
+			return ErrorJson(TEXT("No editor world."));
+		}
+
+		bool bLandscapeSpawned = false;
+		FString SpawnMessage = TEXT("spawn_landscape=false");
+		if (bSpawnLandscape && bTiled)
+		{
+			SpawnMessage = TEXT("spawn_landscape is not supported for tiled maps; import the tiles from tile_cache_dir.");
+		}
+		else if (bSpawnLandscape)
+		{
+			bLandscapeSpawned = FTerrainGenerator::SpawnLandscape(
+				World,
+				Map,
+				FVector::ZeroVector,
+				FVector(100.0f, 100.0f, 100.0f),
+				SpawnMessage);
+		}
+
+		TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
+		Root->SetBoolField(TEXT("ok"), true);
+		Root->SetStringField(TEXT("operator"), TEXT("terrain_generate"));
+		Root->SetStringField(TEXT("backend"), Backend);
+		if (!GpuFallbackReason.IsEmpty())
+		{
+			Root->SetStringField(TEXT("gpu_fallback_reason"), GpuFallbackReason);
+		}
+		Root->SetNumberField(TEXT("seed"), Seed);
+		Root->SetNumberField(TEXT("width"), Width);
+		Root->SetNumberField(TEXT("height"), Height);
+		Root->SetNumberField(TEXT("frequency"), Frequency);
+		Root->SetNumberField(TEXT("amplitude"), Amplitude);
+		Root->SetStringField(TEXT("noise_type"), FHeightmapNoiseSettings::TypeName(BaseNoise.Type));
+		Root->SetNumberField(TEXT("octaves"), BaseNoise.Octaves);
+		Root->SetNumberField(TEXT("lacunarity"), BaseNoise.Lacunarity);
+		Root->SetNumberField(TEXT("gain"), BaseNoise.Gain);
+		Root->SetNumberField(TEXT("warp_strength"), BaseNoise.WarpStrength);
+		Root->SetNumberField(TEXT("warp_frequency"), BaseNoise.WarpFrequency);
+		Root->SetNumberField(TEXT("ridge_strength"), RidgeStrength);
+		Root->SetNumberField(TEXT("ridge_frequency"), RidgeNoise.Frequency);
+		Root->SetNumberField(TEXT("ridge_octaves"), RidgeNoise.Octaves);
+		Root->SetStringField(TEXT("erosion_mode"), ErosionMode);
+		Root->SetNumberField(TEXT("erosion_iterations"), ErosionIterations);
+		Root->SetNumberField(TEXT("erosion_iterations_used"), ErosionIterationsUsed);
+		Root->SetNumberField(TEXT("erosion_strength"), ErosionStrength);
+		Root->SetNumberField(TEXT("sediment_strength"), ErosionStrength);
+		if (bHydraulic)
+		{
+			Root->SetNumberField(TEXT("erosion_droplets"), (double)DropletsSimulated);
+			Root->SetNumberField(TEXT("erosion_radius"), Hydraulic.BrushRadius);
+			Root->SetNumberField(TEXT("erosion_lifetime"), Hydraulic.MaxLifetime);
+		}
+		Root->SetBoolField(TEXT("tiled"), bTiled);
+		{
+			TSharedPtr<FJsonObject> CacheObj = MakeShared<FJsonObject>();
+			CacheObj->SetStringField(TEXT("mode"), FAgentForgeProceduralCache::ModeName(CacheMode));
+			CacheObj->SetStringField(TEXT("status"), CacheStatus);
+			if (!CacheKey.IsEmpty())
+			{
+				CacheObj->SetStringField(TEXT("key"), CacheKey);
+			}
+			Root->SetObjectField(TEXT("cache"), CacheObj);
+		}
+		if (!bTiled)
+		{
+			Root->SetStringField(TEXT("heightmap_precision"), FHeightmap::PrecisionName(Map.GetPrecision()));
+			Root->SetNumberField(TEXT("heightmap_bytes"), (double)Map.GetAllocatedSize());
+		}
+		if (bImported)
+		{
+			Root->SetStringField(TEXT("import_path"), ImportPath);
+			Root->SetNumberField(TEXT("import_ms"), ImportMs);
+		}
+		if (!ExportPath.IsEmpty())
+		{
+			Root->SetStringField(TEXT("export_path"), ExportPath);
+		}
+		if (bTiled)
+		{
+			Root->SetStringField(TEXT("tile_cache_dir"), Tiled.CacheDirectory);
+			Root->SetStringField(TEXT("manifest"), Tiled.ManifestPath);
+			Root->SetNumberField(TEXT("tiles_x"), Tiled.TilesX);
+			Root->SetNumberField(TEXT("tiles_y"), Tiled.TilesY);
+			Root->SetNumberField(TEXT("tile_size"), Tiled.TileSize);
+			Root->SetNumberField(TEXT("tile_halo"), Tiled.Halo);
+			Root->SetNumberField(TEXT("tile_blend"), Tiled.Blend);
+			Root->SetBoolField(TEXT("cache_hit"), Tiled.bCacheHit);
+			Root->SetNumberField(TEXT("generate_ms"), Tiled.GenerateMs);
+			Root->SetNumberField(TEXT("stitch_ms"), Tiled.StitchMs);
+		}
+		else if (bUsedGpu)
+		{
+			Root->SetNumberField(TEXT("gpu_ms"), GpuStats.GpuMs);
+			Root->SetNumberField(TEXT("hydraulic_batches"), GpuStats.HydraulicBatches);
+		}
+		else
+		{
+			Root->SetNumberField(TEXT("noise_ms"), NoiseMs);
+			Root->SetNumberField(TEXT("erosion_ms"), ErosionMs);
+		}
+		Root->SetNumberField(TEXT("height_min"), MinH);
+		Root->SetNumberField(TEXT("height_max"), MaxH);
+		Root->SetNumberField(TEXT("height_avg"), AvgH);
+		Root->SetBoolField(TEXT("landscape_spawned"), bLandscapeSpawned);
+		Root->SetStringField(TEXT("landscape_message"), SpawnMessage);
+		return ToJson(Root);
 	}
+}
+#endif
 
-	const FDistributionRequest Distribution = ParseDistributionRequest(Args, TargetActor);
-	FDistributionDiagnostics DistributionDiagnostics;
-	const TArray<FVector> DistributionPoints = GenerateDistributionPoints(World, TargetActor, Distribution, &DistributionDiagnostics);
+FString FProceduralOpsModule::TerrainGenerate(const TSharedPtr<FJsonObject>& Args)
+{
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Operators.TerrainGenerate");
+#if WITH_EDITOR
+	return RunOperatorWork(*PrepareOperatorWork<FTerrainGenerateWork>(Args));
+#else
+	return ErrorJson(TEXT("WITH_EDITOR required."));
+#endif
+}
 
-	FString PaletteId;
-	TSharedPtr<FJsonObject> PaletteObj;
-	FString PaletteError;
-	if (!ResolvePaletteIfPresent(Args, PaletteId, PaletteObj, PaletteError))
+#if WITH_EDITOR
+namespace
+{
+	class FSurfaceScatterWork : public FDistributionOperatorWork
 	{
-		return ErrorJson(PaletteError);
-	}
+	public:
+		FString Prepare(const TSharedPtr<FJsonObject>& InArgs)
+		{
+			const FString Error = PrepareTarget(InArgs, { TEXT("target_label"), TEXT("pcg_volume_label"), TEXT("actor_label"), TEXT("target_actor") },
+				TEXT("op_surface_scatter requires target_label (or pcg_volume_label)."), TEXT("Target actor not found"));
+			return Error.IsEmpty() ? PreparePalette(true) : Error;
+		}
 
-	const TSet<FString> Reserved = {
-		TEXT("target_label"), TEXT("pcg_volume_label"), TEXT("actor_label"), TEXT("target_actor"),
-		TEXT("parameters"), TEXT("generate"),
-		TEXT("distribution_mode"), TEXT("density"), TEXT("cluster_radius"), TEXT("min_spacing"),
-		TEXT("height_range"), TEXT("slope_range"), TEXT("distance_mask"), TEXT("seed"),
-		TEXT("point_count"), TEXT("max_points"), TEXT("cluster_count"),
-		TEXT("max_spawn_points"), TEXT("max_cluster_count"), TEXT("max_generation_time_ms"),
-		TEXT("density_sigma"), TEXT("density_noise"), TEXT("density_field_resolution"), TEXT("use_density_gradient"),
-		TEXT("clearings"), TEXT("clearing_density"), TEXT("clearing_count"), TEXT("clearing_radius_min"), TEXT("clearing_radius_max"),
-		TEXT("biome_count"), TEXT("biome_types"), TEXT("allowed_biomes"), TEXT("biome_blend_distance"),
-		TEXT("avoid_points"), TEXT("avoid_radius"), TEXT("prefer_near_points"), TEXT("prefer_radius"), TEXT("prefer_strength"),
-		TEXT("interaction_rules"),
-		TEXT("palette_id")
+		virtual FString Commit() override;
 	};
 
-	TMap<FString, TSharedPtr<FJsonValue>> Params;
-	GatherParameterObject(Args, Params, Reserved);
+	FString FSurfaceScatterWork::Commit()
+	{
+		UWorld* World = nullptr;
+		FString TargetError;
+		AActor* TargetActor = ResolveTarget(World, TargetError);
+		if (!TargetActor)
+		{
+			return TargetError;
+		}
 
-	int32 AppliedCount = 0;
-	TArray<TSharedPtr<FJsonValue>> AppliedArr;
-	TArray<TSharedPtr<FJsonValue>> MissingArr;
+		static const FAgentForgeArgNames Reserved = FAgentForgeArgNames({
+			TEXT("target_label"), TEXT("pcg_volume_label"), TEXT("actor_label"), TEXT("target_actor"),
+			TEXT("parameters"), TEXT("generate"),
+			TEXT("palette_id"),
+			TEXT("placement"), TEXT("cell_size"), TEXT("cull_distance"), TEXT("align_to_normal"), TEXT("max_align_angle"), TEXT("categories")
+		}).Add(DistributionArgSchema());
 
-	for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : Params)
-	{
-		FString AppliedTarget;
-		FString AppliedProperty;
-		FString Error;
-		if (ApplySingleParam(TargetActor, Pair.Key, Pair.Value, AppliedTarget, AppliedProperty, Error))
+		TMap<FString, TSharedPtr<FJsonValue>> Params;
+		GatherParameterObject(Args, Params, Reserved);
+
+		int32 AppliedCount = 0;
+		TArray<TSharedPtr<FJsonValue>> AppliedArr;
+		TArray<TSharedPtr<FJsonValue>> MissingArr;
+
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : Params)
 		{
-			++AppliedCount;
-			TSharedPtr<FJsonObject> AppliedObj = MakeShared<FJsonObject>();
-			AppliedObj->SetStringField(TEXT("param"), Pair.Key);
-			AppliedObj->SetStringField(TEXT("target"), AppliedTarget);
-			AppliedObj->SetStringField(TEXT("property"), AppliedProperty);
-			AppliedArr.Add(MakeShared<FJsonValueObject>(AppliedObj));
+			FString AppliedTarget;
+			FString AppliedProperty;
+			FString Error;
+			if (ApplySingleParam(TargetActor, Pair.Key, Pair.Value, AppliedTarget, AppliedProperty, Error))
+			{
+				++AppliedCount;
+				TSharedPtr<FJsonObject> AppliedObj = MakeShared<FJsonObject>();
+				AppliedObj->SetStringField(TEXT("param"), Pair.Key);
+				AppliedObj->SetStringField(TEXT("target"), AppliedTarget);
+				AppliedObj->SetStringField(TEXT("property"), AppliedProperty);
+				AppliedArr.Add(MakeShared<FJsonValueObject>(AppliedObj));
+			}
+			else
+			{
+				MissingArr.Add(MakeShared<FJsonValueString>(Pair.Key));
+			}
 		}
-		else
+		// Native placement replaces the PCG graph unless generate is asked for explicitly.
+		const bool bGenerate = Args.IsValid() && Args->HasField(TEXT("generate")) ? Args->GetBoolField(TEXT("generate")) : !bNativePlacement;
+		const int32 Triggered = bGenerate ? TriggerProceduralGenerate(TargetActor) : 0;
+
+		TSharedPtr<FJsonObject> MaterializeObj;
+		if (bNativePlacement)
 		{
-			MissingArr.Add(MakeShared<FJsonValueString>(Pair.Key));
+			FString MaterializeError;
+			if (!MaterializeDistributionPoints(World, TargetActor, TEXT("SurfaceScatter"), DistributionPoints, DistributionAttributes, PaletteObj, Args, Distribution.Seed, MaterializeObj, MaterializeError))
+			{
+				return ErrorJson(MaterializeError);
+			}
 		}
-	}
-	const bool bGenerate = !Args.IsValid() || !Args->HasField(TEXT("generate")) || Args->GetBoolField(TEXT("generate"));
-	const int32 Triggered = bGenerate ? TriggerProceduralGenerate(TargetActor) : 0;
 
-	AddOperatorTag(TargetActor, TEXT("AF_Operator_SurfaceScatter"));
+		AddOperatorTag(TargetActor, TEXT("AF_Operator_SurfaceScatter"));
 
-	TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
-	Root->SetBoolField(TEXT("ok"), true);
-	Root->SetStringField(TEXT("operator"), TEXT("surface_scatter"));
-	Root->SetStringField(TEXT("target"), TargetActor->GetActorLabel());
-	Root->SetNumberField(TEXT("applied_params"), AppliedCount);
-	Root->SetArrayField(TEXT("applied"), AppliedArr);
-	Root->SetArrayField(TEXT("missing"), MissingArr);
-	Root->SetBoolField(TEXT("generated"), bGenerate);
-	Root->SetNumberField(TEXT("generated_components"), Triggered);
-	Root->SetStringField(TEXT("distribution_mode"), Distribution.Mode);
-	Root->SetNumberField(TEXT("distribution_points"), DistributionPoints.Num());
-	Root->SetArrayField(TEXT("distribution_point_sample"), BuildPointSampleArray(DistributionPoints));
-	Root->SetObjectField(TEXT("distribution_diagnostics"), BuildDistributionDiagnosticsJson(DistributionDiagnostics));
-	Root->SetBoolField(TEXT("generation_time_exceeded"), DistributionDiagnostics.bGenerationTimeExceeded);
-	Root->SetNumberField(TEXT("scene_score"), DistributionDiagnostics.SceneMetrics.CombinedScore);
-	if (!PaletteId.IsEmpty())
-	{
-		Root->SetStringField(TEXT("palette_id"), PaletteId);
-		Root->SetBoolField(TEXT("palette_resolved"), PaletteObj.IsValid());
+		TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
+		Root->SetBoolField(TEXT("ok"), true);
+		Root->SetStringField(TEXT("operator"), TEXT("surface_scatter"));
+		Root->SetStringField(TEXT("target"), TargetActor->GetActorLabel());
+		Root->SetNumberField(TEXT("applied_params"), AppliedCount);
+		Root->SetArrayField(TEXT("applied"), AppliedArr);
+		Root->SetArrayField(TEXT("missing"), MissingArr);
+		Root->SetBoolField(TEXT("generated"), bGenerate);
+		Root->SetNumberField(TEXT("generated_components"), Triggered);
+		Root->SetStringField(TEXT("placement"), bNativePlacement ? TEXT("native") : TEXT("pcg"));
+		if (MaterializeObj.IsValid())
+		{
+			Root->SetObjectField(TEXT("materialized"), MaterializeObj);
+		}
+		Root->SetStringField(TEXT("distribution_mode"), Distribution.Mode);
+		Root->SetNumberField(TEXT("distribution_points"), DistributionPoints.Num());
+		Root->SetArrayField(TEXT("distribution_point_sample"), BuildPointSampleArray(DistributionPoints));
+		Root->SetObjectField(TEXT("distribution_diagnostics"), BuildDistributionDiagnosticsJson(DistributionDiagnostics));
+		Root->SetBoolField(TEXT("generation_time_exceeded"), DistributionDiagnostics.bGenerationTimeExceeded);
+		Root->SetNumberField(TEXT("scene_score"), DistributionDiagnostics.SceneMetrics.CombinedScore);
+		if (!PaletteId.IsEmpty())
+		{
+			Root->SetStringField(TEXT("palette_id"), PaletteId);
+			Root->SetBoolField(TEXT("palette_resolved"), PaletteObj.IsValid());
+		}
+		return ToJson(Root);
 	}
-	return ToJson(Root);
+}
+#endif
+
+FString FProceduralOpsModule::SurfaceScatter(const TSharedPtr<FJsonObject>& Args)
+{
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Operators.SurfaceScatter");
+#if WITH_EDITOR
+	return RunOperatorWork(*PrepareOperatorWork<FSurfaceScatterWork>(Args));
 #else
 	return ErrorJson(TEXT("WITH_EDITOR required."));
 #endif
 }
 
-FString FProceduralOpsModule::SplineScatter(const TSharedPtr<FJsonObject>& Args)
-{
 #if WITH_EDITOR
-	UWorld* World = GetEditorWorld();
-	if (!World)
+namespace
+{
+	class FSplineScatterWork : public FDistributionOperatorWork
 	{
-		return ErrorJson(TEXT("No editor world."));
-	}
+	public:
+		FString Prepare(const TSharedPtr<FJsonObject>& InArgs)
+		{
+			FString Error = PrepareTarget(InArgs, { TEXT("spline_actor_label"), TEXT("target_label"), TEXT("actor_label"), TEXT("target_actor") },
+				TEXT("op_spline_scatter requires spline_actor_label (or target_label)."), TEXT("Spline actor not found"));
+			if (Error.IsEmpty())
+			{
+				Error = PrepareSplineBase();
+			}
+			return Error.IsEmpty() ? PreparePalette(true) : Error;
+		}
 
-	const FString TargetId = FirstNonEmptyField(Args, { TEXT("spline_actor_label"), TEXT("target_label"), TEXT("actor_label"), TEXT("target_actor") });
-	if (TargetId.IsEmpty())
-	{
-		return ErrorJson(TEXT("op_spline_scatter requires spline_actor_label (or target_label)."));
-	}
+		virtual FString Commit() override;
 
-	AActor* TargetActor = FindActorByAnyId(World, TargetId);
-	if (!TargetActor)
-	{
-		return ErrorJson(FString::Printf(TEXT("Spline actor not found: %s"), *TargetId));
-	}
+	private:
+		// spacing > 0 samples along the spline: control_points when given (as
+		// they will be applied), otherwise the target's spline component.
+		FString PrepareSplineBase()
+		{
+			double Spacing = 0.0;
+			if (!Args.IsValid() || !Args->TryGetNumberField(TEXT("spacing"), Spacing) || Spacing <= 0.0)
+			{
+				return FString();
+			}
+			FSplineSampleSettings Settings;
+			Settings.Spacing = (float)Spacing;
+			Settings.MaxSamples = Distribution.MaxSpawnPoints;
+			double StartOffset = 0.0;
+			if (Args->TryGetNumberField(TEXT("start_offset"), StartOffset))
+			{
+				Settings.StartOffset = FMath::Max(0.0f, (float)StartOffset);
+			}
+			const TArray<TSharedPtr<FJsonValue>>* LaneValues = nullptr;
+			if (Args->TryGetArrayField(TEXT("lane_offsets"), LaneValues))
+			{
+				for (const TSharedPtr<FJsonValue>& Value : *LaneValues)
+				{
+					double Offset = 0.0;
+					if (Value.IsValid() && Value->TryGetNumber(Offset))
+					{
+						Settings.LaneOffsets.Add((float)Offset);
+					}
+				}
+			}
 
-	const FDistributionRequest Distribution = ParseDistributionRequest(Args, TargetActor);
-	FDistributionDiagnostics DistributionDiagnostics;
-	const TArray<FVector> DistributionPoints = GenerateDistributionPoints(World, TargetActor, Distribution, &DistributionDiagnostics);
+			FSplineSampler Sampler;
+			const TArray<TSharedPtr<FJsonValue>>* ControlPoints = nullptr;
+			if (Args->TryGetArrayField(TEXT("control_points"), ControlPoints) || Args->TryGetArrayField(TEXT("spline_points"), ControlPoints))
+			{
+				TArray<FVector> Points;
+				for (const TSharedPtr<FJsonValue>& Value : *ControlPoints)
+				{
+					FVector Location = FVector::ZeroVector;
+					if (JsonValueToVector(Value, Location))
+					{
+						Points.Add(Location);
+					}
+				}
+				const bool bClosedLoop = Args->HasField(TEXT("closed_loop")) && Args->GetBoolField(TEXT("closed_loop"));
+				Sampler = FSplineSampler::FromPoints(Points, bClosedLoop);
+			}
+			else if (const USplineComponent* Spline = WeakTarget.IsValid() ? WeakTarget->FindComponentByClass<USplineComponent>() : nullptr)
+			{
+				Sampler = FSplineSampler::FromComponent(*Spline);
+			}
+			if (!Sampler.IsValid())
+			{
+				return ErrorJson(TEXT("spacing needs a spline with at least two points (control_points or a spline component on the target)."));
+			}
+			UseSplineBase(Inputs, Distribution, MakeShared<const FSplineSampler, ESPMode::ThreadSafe>(MoveTemp(Sampler)), Settings);
+			return FString();
+		}
+	};
 
-	FString PaletteId;
-	TSharedPtr<FJsonObject> PaletteObj;
-	FString PaletteError;
-	if (!ResolvePaletteIfPresent(Args, PaletteId, PaletteObj, PaletteError))
+	FString FSplineScatterWork::Commit()
 	{
-		return ErrorJson(PaletteError);
-	}
+		UWorld* World = nullptr;
+		FString TargetError;
+		AActor* TargetActor = ResolveTarget(World, TargetError);
+		if (!TargetActor)
+		{
+			return TargetError;
+		}
 
-	const bool bClosedLoop = Args.IsValid() && Args->HasField(TEXT("closed_loop")) ? Args->GetBoolField(TEXT("closed_loop")) : false;
-	int32 SplinePointCount = 0;
+		const bool bClosedLoop = Args.IsValid() && Args->HasField(TEXT("closed_loop")) ? Args->GetBoolField(TEXT("closed_loop")) : false;
+		int32 SplinePointCount = 0;
 
-	const TArray<TSharedPtr<FJsonValue>>* Points = nullptr;
-	if (Args.IsValid())
-	{
-		if (Args->TryGetArrayField(TEXT("control_points"), Points) || Args->TryGetArrayField(TEXT("spline_points"), Points))
+		const TArray<TSharedPtr<FJsonValue>>* Points = nullptr;
+		if (Args.IsValid())
 		{
-			SplinePointCount = ApplySplinePoints(TargetActor, *Points, bClosedLoop);
+			if (Args->TryGetArrayField(TEXT("control_points"), Points) || Args->TryGetArrayField(TEXT("spline_points"), Points))
+			{
+				SplinePointCount = ApplySplinePoints(TargetActor, *Points, bClosedLoop);
+			}
 		}
-	}
-	if (SplinePointCount == 0 && DistributionPoints.Num() > 0)
-	{
-		TArray<TSharedPtr<FJsonValue>> GeneratedPointValues;
-		GeneratedPointValues.Reserve(DistributionPoints.Num());
-		for (const FVector& Point : DistributionPoints)
+		// Area-sampled points become the spline when none were given; spline samples already lie on it.
+		if (SplinePointCount == 0 && DistributionPoints.Num() > 0 && !Inputs.Spline.IsValid())
 		{
-			GeneratedPointValues.Add(MakeShared<FJsonValueObject>(VecToObj(Point)));
+			TArray<TSharedPtr<FJsonValue>> GeneratedPointValues;
+			GeneratedPointValues.Reserve(DistributionPoints.Num());
+			for (const FVector& Point : DistributionPoints)
+			{
+				GeneratedPointValues.Add(MakeShared<FJsonValueObject>(VecToObj(Point)));
+			}
+			SplinePointCount = ApplySplinePoints(TargetActor, GeneratedPointValues, bClosedLoop);
 		}
-		SplinePointCount = ApplySplinePoints(TargetActor, GeneratedPointValues, bClosedLoop);
-	}
 
-	const TSet<FString> Reserved = {
-		TEXT("spline_actor_label"), TEXT("target_label"), TEXT("actor_label"), TEXT("target_actor"),
-		TEXT("control_points"), TEXT("spline_points"), TEXT("closed_loop"),
-		TEXT("parameters"), TEXT("generate"),
-		TEXT("distribution_mode"), TEXT("density"), TEXT("cluster_radius"), TEXT("min_spacing"),
-		TEXT("height_range"), TEXT("slope_range"), TEXT("distance_mask"), TEXT("seed"),
-		TEXT("point_count"), TEXT("max_points"), TEXT("cluster_count"),
-		TEXT("max_spawn_points"), TEXT("max_cluster_count"), TEXT("max_generation_time_ms"),
-		TEXT("density_sigma"), TEXT("density_noise"), TEXT("density_field_resolution"), TEXT("use_density_gradient"),
-		TEXT("clearings"), TEXT("clearing_density"), TEXT("clearing_count"), TEXT("clearing_radius_min"), TEXT("clearing_radius_max"),
-		TEXT("biome_count"), TEXT("biome_types"), TEXT("allowed_biomes"), TEXT("biome_blend_distance"),
-		TEXT("avoid_points"), TEXT("avoid_radius"), TEXT("prefer_near_points"), TEXT("prefer_radius"), TEXT("prefer_strength"),
-		TEXT("interaction_rules"),
-		TEXT("palette_id")
-	};
+		static const FAgentForgeArgNames Reserved = FAgentForgeArgNames({
+			TEXT("spline_actor_label"), TEXT("target_label"), TEXT("actor_label"), TEXT("target_actor"),
+			TEXT("control_points"), TEXT("spline_points"), TEXT("closed_loop"),
+			TEXT("spacing"), TEXT("start_offset"), TEXT("lane_offsets"),
+			TEXT("parameters"), TEXT("generate"),
+			TEXT("palette_id"),
+			TEXT("placement"), TEXT("cell_size"), TEXT("cull_distance"), TEXT("align_to_normal"), TEXT("max_align_angle"), TEXT("categories")
+		}).Add(DistributionArgSchema());
 
-	TMap<FString, TSharedPtr<FJsonValue>> Params;
-	GatherParameterObject(Args, Params, Reserved);
+		TMap<FString, TSharedPtr<FJsonValue>> Params;
+		GatherParameterObject(Args, Params, Reserved);
 
-	int32 AppliedCount = 0;
-	TArray<TSharedPtr<FJsonValue>> MissingArr;
-	for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : Params)
-	{
-		FString AppliedTarget;
-		FString AppliedProperty;
-		FString Error;
-		if (ApplySingleParam(TargetActor, Pair.Key, Pair.Value, AppliedTarget, AppliedProperty, Error))
+		int32 AppliedCount = 0;
+		TArray<TSharedPtr<FJsonValue>> MissingArr;
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : Params)
 		{
-			++AppliedCount;
+			FString AppliedTarget;
+			FString AppliedProperty;
+			FString Error;
+			if (ApplySingleParam(TargetActor, Pair.Key, Pair.Value, AppliedTarget, AppliedProperty, Error))
+			{
+				++AppliedCount;
+			}
+			else
+			{
+				MissingArr.Add(MakeShared<FJsonValueString>(Pair.Key));
+			}
 		}
-		else
+		const bool bGenerate = Args.IsValid() && Args->HasField(TEXT("generate")) ? Args->GetBoolField(TEXT("generate")) : !bNativePlacement;
+		const int32 Triggered = bGenerate ? TriggerProceduralGenerate(TargetActor) : 0;
+
+		TSharedPtr<FJsonObject> MaterializeObj;
+		if (bNativePlacement)
 		{
-			MissingArr.Add(MakeShared<FJsonValueString>(Pair.Key));
+			FString MaterializeError;
+			if (!MaterializeDistributionPoints(World, TargetActor, TEXT("SplineScatter"), DistributionPoints, DistributionAttributes, PaletteObj, Args, Distribution.Seed, MaterializeObj, MaterializeError))
+			{
+				return ErrorJson(MaterializeError);
+			}
 		}
-	}
-	const bool bGenerate = !Args.IsValid() || !Args->HasField(TEXT("generate")) || Args->GetBoolField(TEXT("generate"));
-	const int32 Triggered = bGenerate ? TriggerProceduralGenerate(TargetActor) : 0;
-	AddOperatorTag(TargetActor, TEXT("AF_Operator_SplineScatter"));
+		AddOperatorTag(TargetActor, TEXT("AF_Operator_SplineScatter"));
 
-	TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
-	Root->SetBoolField(TEXT("ok"), true);
-	Root->SetStringField(TEXT("operator"), TEXT("spline_scatter"));
-	Root->SetStringField(TEXT("target"), TargetActor->GetActorLabel());
-	Root->SetNumberField(TEXT("spline_points_applied"), SplinePointCount);
-	Root->SetNumberField(TEXT("applied_params"), AppliedCount);
-	Root->SetArrayField(TEXT("missing"), MissingArr);
-	Root->SetNumberField(TEXT("generated_components"), Triggered);
-	Root->SetStringField(TEXT("distribution_mode"), Distribution.Mode);
-	Root->SetNumberField(TEXT("distribution_points"), DistributionPoints.Num());
-	Root->SetArrayField(TEXT("distribution_point_sample"), BuildPointSampleArray(DistributionPoints));
-	Root->SetObjectField(TEXT("distribution_diagnostics"), BuildDistributionDiagnosticsJson(DistributionDiagnostics));
-	Root->SetBoolField(TEXT("generation_time_exceeded"), DistributionDiagnostics.bGenerationTimeExceeded);
-	Root->SetNumberField(TEXT("scene_score"), DistributionDiagnostics.SceneMetrics.CombinedScore);
-	if (!PaletteId.IsEmpty())
-	{
-		Root->SetStringField(TEXT("palette_id"), PaletteId);
-		Root->SetBoolField(TEXT("palette_resolved"), PaletteObj.IsValid());
+		TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
+		Root->SetBoolField(TEXT("ok"), true);
+		Root->SetStringField(TEXT("operator"), TEXT("spline_scatter"));
+		Root->SetStringField(TEXT("target"), TargetActor->GetActorLabel());
+		Root->SetNumberField(TEXT("spline_points_applied"), SplinePointCount);
+		if (Inputs.Spline.IsValid())
+		{
+			Root->SetNumberField(TEXT("spline_length"), Inputs.Spline->GetLength());
+			Root->SetNumberField(TEXT("spacing"), Inputs.SplineSettings.Spacing);
+			Root->SetNumberField(TEXT("lanes"), FMath::Max(1, Inputs.SplineSettings.LaneOffsets.Num()));
+		}
+		Root->SetNumberField(TEXT("applied_params"), AppliedCount);
+		Root->SetArrayField(TEXT("missing"), MissingArr);
+		Root->SetNumberField(TEXT("generated_components"), Triggered);
+		Root->SetStringField(TEXT("placement"), bNativePlacement ? TEXT("native") : TEXT("pcg"));
+		if (MaterializeObj.IsValid())
+		{
+			Root->SetObjectField(TEXT("materialized"), MaterializeObj);
+		}
+		Root->SetStringField(TEXT("distribution_mode"), Distribution.Mode);
+		Root->SetNumberField(TEXT("distribution_points"), DistributionPoints.Num());
+		Root->SetArrayField(TEXT("distribution_point_sample"), BuildPointSampleArray(DistributionPoints));
+		Root->SetObjectField(TEXT("distribution_diagnostics"), BuildDistributionDiagnosticsJson(DistributionDiagnostics));
+		Root->SetBoolField(TEXT("generation_time_exceeded"), DistributionDiagnostics.bGenerationTimeExceeded);
+		Root->SetNumberField(TEXT("scene_score"), DistributionDiagnostics.SceneMetrics.CombinedScore);
+		if (!PaletteId.IsEmpty())
+		{
+			Root->SetStringField(TEXT("palette_id"), PaletteId);
+			Root->SetBoolField(TEXT("palette_resolved"), PaletteObj.IsValid());
+		}
+		return ToJson(Root);
 	}
-	return ToJson(Root);
+}
+#endif
+
+FString FProceduralOpsModule::SplineScatter(const TSharedPtr<FJsonObject>& Args)
+{
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Operators.SplineScatter");
+#if WITH_EDITOR
+	return RunOperatorWork(*PrepareOperatorWork<FSplineScatterWork>(Args));
 #else
 	return ErrorJson(TEXT("WITH_EDITOR required."));
 #endif
@@ -1731,6 +3227,7 @@ FString FProceduralOpsModule::SplineScatter(const TSharedPtr<FJsonObject>& Args)
 
 FString FProceduralOpsModule::RoadLayout(const TSharedPtr<FJsonObject>& Args)
 {
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Operators.RoadLayout");
 #if WITH_EDITOR
 	UWorld* World = GetEditorWorld();
 	if (!World)
@@ -1802,11 +3299,11 @@ FString FProceduralOpsModule::RoadLayout(const TSharedPtr<FJsonObject>& Args)
 		const bool bClosedLoop = Args->HasField(TEXT("closed_loop")) ? Args->GetBoolField(TEXT("closed_loop")) : false;
 		SplinePointCount = ApplySplinePoints(RoadActor, *Centerline, bClosedLoop);
 	}
-	const TSet<FString> Reserved = {
+	static const FAgentForgeArgNames Reserved({
 		TEXT("road_actor_label"), TEXT("target_label"), TEXT("actor_label"), TEXT("road_class_path"),
 		TEXT("road_label"), TEXT("centerline_points"), TEXT("control_points"), TEXT("closed_loop"),
 		TEXT("parameters"), TEXT("generate")
-	};
+	});
 	TMap<FString, TSharedPtr<FJsonValue>> Params;
 	GatherParameterObject(Args, Params, Reserved);
 
@@ -1837,6 +3334,10 @@ FString FProceduralOpsModule::RoadLayout(const TSharedPtr<FJsonObject>& Args)
 	Root->SetStringField(TEXT("target"), RoadActor->GetActorLabel());
 	Root->SetBoolField(TEXT("spawned_actor"), bSpawnedActor);
 	Root->SetNumberField(TEXT("spline_points_applied"), SplinePointCount);
+	if (const USplineComponent* Spline = RoadActor->FindComponentByClass<USplineComponent>())
+	{
+		Root->SetNumberField(TEXT("road_length"), FSplineSampler::FromComponent(*Spline).GetLength());
+	}
 	Root->SetNumberField(TEXT("applied_params"), AppliedCount);
 	Root->SetArrayField(TEXT("missing"), MissingArr);
 	Root->SetNumberField(TEXT("generated_components"), Triggered);
@@ -1846,127 +3347,120 @@ FString FProceduralOpsModule::RoadLayout(const TSharedPtr<FJsonObject>& Args)
 #endif
 }
 
-FString FProceduralOpsModule::BiomeLayers(const TSharedPtr<FJsonObject>& Args)
-{
 #if WITH_EDITOR
-	UWorld* World = GetEditorWorld();
-	if (!World)
-	{
-		return ErrorJson(TEXT("No editor world."));
-	}
-
-	const FString TargetId = FirstNonEmptyField(Args, { TEXT("target_label"), TEXT("pcg_volume_label"), TEXT("actor_label"), TEXT("target_actor") });
-	if (TargetId.IsEmpty())
-	{
-		return ErrorJson(TEXT("op_biome_layers requires target_label."));
-	}
-
-	AActor* TargetActor = FindActorByAnyId(World, TargetId);
-	if (!TargetActor)
+namespace
+{
+	class FBiomeLayersWork : public FDistributionOperatorWork
 	{
-		return ErrorJson(FString::Printf(TEXT("Target actor not found: %s"), *TargetId));
-	}
+	public:
+		FString Prepare(const TSharedPtr<FJsonObject>& InArgs)
+		{
+			const FString Error = PrepareTarget(InArgs, { TEXT("target_label"), TEXT("pcg_volume_label"), TEXT("actor_label"), TEXT("target_actor") },
+				TEXT("op_biome_layers requires target_label."), TEXT("Target actor not found"));
+			return Error.IsEmpty() ? PreparePalette(false) : Error;
+		}
 
-	const FDistributionRequest Distribution = ParseDistributionRequest(Args, TargetActor);
-	FDistributionDiagnostics DistributionDiagnostics;
-	const TArray<FVector> DistributionPoints = GenerateDistributionPoints(World, TargetActor, Distribution, &DistributionDiagnostics);
+		virtual FString Commit() override;
+	};
 
-	FString PaletteId;
-	TSharedPtr<FJsonObject> PaletteObj;
-	FString PaletteError;
-	if (!ResolvePaletteIfPresent(Args, PaletteId, PaletteObj, PaletteError))
+	FString FBiomeLayersWork::Commit()
 	{
-		return ErrorJson(PaletteError);
-	}
+		UWorld* World = nullptr;
+		FString TargetError;
+		AActor* TargetActor = ResolveTarget(World, TargetError);
+		if (!TargetActor)
+		{
+			return TargetError;
+		}
 
-	TMap<FString, TSharedPtr<FJsonValue>> Params;
-	if (Args.IsValid())
-	{
-		const TSharedPtr<FJsonObject>* LayersObj = nullptr;
-		if (Args->TryGetObjectField(TEXT("layers"), LayersObj) && LayersObj && LayersObj->IsValid())
+		TMap<FString, TSharedPtr<FJsonValue>> Params;
+		if (Args.IsValid())
 		{
-			for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : (*LayersObj)->Values)
+			const TSharedPtr<FJsonObject>* LayersObj = nullptr;
+			if (Args->TryGetObjectField(TEXT("layers"), LayersObj) && LayersObj && LayersObj->IsValid())
 			{
-				Params.Add(Pair.Key, Pair.Value);
+				for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : (*LayersObj)->Values)
+				{
+					Params.Add(Pair.Key, Pair.Value);
+				}
 			}
 		}
-	}
-
-	const TSet<FString> Reserved = {
-		TEXT("target_label"), TEXT("pcg_volume_label"), TEXT("actor_label"), TEXT("target_actor"),
-		TEXT("layers"), TEXT("parameters"), TEXT("generate"),
-		TEXT("distribution_mode"), TEXT("density"), TEXT("cluster_radius"), TEXT("min_spacing"),
-		TEXT("height_range"), TEXT("slope_range"), TEXT("distance_mask"), TEXT("seed"),
-		TEXT("point_count"), TEXT("max_points"), TEXT("cluster_count"),
-		TEXT("max_spawn_points"), TEXT("max_cluster_count"), TEXT("max_generation_time_ms"),
-		TEXT("density_sigma"), TEXT("density_noise"), TEXT("density_field_resolution"), TEXT("use_density_gradient"),
-		TEXT("clearings"), TEXT("clearing_density"), TEXT("clearing_count"), TEXT("clearing_radius_min"), TEXT("clearing_radius_max"),
-		TEXT("biome_count"), TEXT("biome_types"), TEXT("allowed_biomes"), TEXT("biome_blend_distance"),
-		TEXT("avoid_points"), TEXT("avoid_radius"), TEXT("prefer_near_points"), TEXT("prefer_radius"), TEXT("prefer_strength"),
-		TEXT("interaction_rules"),
-		TEXT("palette_id")
-	};
-	TMap<FString, TSharedPtr<FJsonValue>> ExtraParams;
-	GatherParameterObject(Args, ExtraParams, Reserved);
-	for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : ExtraParams)
-	{
-		Params.Add(Pair.Key, Pair.Value);
-	}
 
-	auto AddAliasIfPresent = [&](const FString& Src, const FString& Alias)
-	{
-		if (Params.Contains(Src) && !Params.Contains(Alias))
+		static const FAgentForgeArgNames Reserved = FAgentForgeArgNames({
+			TEXT("target_label"), TEXT("pcg_volume_label"), TEXT("actor_label"), TEXT("target_actor"),
+			TEXT("layers"), TEXT("parameters"), TEXT("generate"),
+			TEXT("palette_id")
+		}).Add(DistributionArgSchema());
+		TMap<FString, TSharedPtr<FJsonValue>> ExtraParams;
+		GatherParameterObject(Args, ExtraParams, Reserved);
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : ExtraParams)
 		{
-			Params.Add(Alias, Params[Src]);
+			Params.Add(Pair.Key, Pair.Value);
 		}
-	};
-	AddAliasIfPresent(TEXT("groundcover_density"), TEXT("GroundcoverDensity"));
-	AddAliasIfPresent(TEXT("shrub_density"), TEXT("ShrubDensity"));
-	AddAliasIfPresent(TEXT("tree_density"), TEXT("TreeDensity"));
-	AddAliasIfPresent(TEXT("rock_density"), TEXT("RockDensity"));
-	AddAliasIfPresent(TEXT("path_width"), TEXT("PathWidth"));
-	AddAliasIfPresent(TEXT("rock_scale"), TEXT("RockScale"));
-	int32 AppliedCount = 0;
-	TArray<TSharedPtr<FJsonValue>> MissingArr;
 
-	for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : Params)
-	{
-		FString AppliedTarget;
-		FString AppliedProperty;
-		FString Error;
-		if (ApplySingleParam(TargetActor, Pair.Key, Pair.Value, AppliedTarget, AppliedProperty, Error))
-		{
-			++AppliedCount;
-		}
-		else
+		auto AddAliasIfPresent = [&](const FString& Src, const FString& Alias)
 		{
-			MissingArr.Add(MakeShared<FJsonValueString>(Pair.Key));
+			if (Params.Contains(Src) && !Params.Contains(Alias))
+			{
+				Params.Add(Alias, Params[Src]);
+			}
+		};
+		AddAliasIfPresent(TEXT("groundcover_density"), TEXT("GroundcoverDensity"));
+		AddAliasIfPresent(TEXT("shrub_density"), TEXT("ShrubDensity"));
+		AddAliasIfPresent(TEXT("tree_density"), TEXT("TreeDensity"));
+		AddAliasIfPresent(TEXT("rock_density"), TEXT("RockDensity"));
+		AddAliasIfPresent(TEXT("path_width"), TEXT("PathWidth"));
+		AddAliasIfPresent(TEXT("rock_scale"), TEXT("RockScale"));
+		int32 AppliedCount = 0;
+		TArray<TSharedPtr<FJsonValue>> MissingArr;
+
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : Params)
+		{
+			FString AppliedTarget;
+			FString AppliedProperty;
+			FString Error;
+			if (ApplySingleParam(TargetActor, Pair.Key, Pair.Value, AppliedTarget, AppliedProperty, Error))
+			{
+				++AppliedCount;
+			}
+			else
+			{
+				MissingArr.Add(MakeShared<FJsonValueString>(Pair.Key));
+			}
 		}
-	}
 
-	const bool bGenerate = !Args.IsValid() || !Args->HasField(TEXT("generate")) || Args->GetBoolField(TEXT("generate"));
-	const int32 Triggered = bGenerate ? TriggerProceduralGenerate(TargetActor) : 0;
-	AddOperatorTag(TargetActor, TEXT("AF_Operator_BiomeLayers"));
+		const bool bGenerate = !Args.IsValid() || !Args->HasField(TEXT("generate")) || Args->GetBoolField(TEXT("generate"));
+		const int32 Triggered = bGenerate ? TriggerProceduralGenerate(TargetActor) : 0;
+		AddOperatorTag(TargetActor, TEXT("AF_Operator_BiomeLayers"));
 
-	TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
-	Root->SetBoolField(TEXT("ok"), true);
-	Root->SetStringField(TEXT("operator"), TEXT("biome_layers"));
-	Root->SetStringField(TEXT("target"), TargetActor->GetActorLabel());
-	Root->SetNumberField(TEXT("applied_params"), AppliedCount);
-	Root->SetArrayField(TEXT("missing"), MissingArr);
-	Root->SetNumberField(TEXT("generated_components"), Triggered);
-	Root->SetStringField(TEXT("distribution_mode"), Distribution.Mode);
-	Root->SetNumberField(TEXT("distribution_points"), DistributionPoints.Num());
-	Root->SetArrayField(TEXT("distribution_point_sample"), BuildPointSampleArray(DistributionPoints));
-	Root->SetObjectField(TEXT("distribution_diagnostics"), BuildDistributionDiagnosticsJson(DistributionDiagnostics));
-	Root->SetBoolField(TEXT("generation_time_exceeded"), DistributionDiagnostics.bGenerationTimeExceeded);
-	Root->SetNumberField(TEXT("scene_score"), DistributionDiagnostics.SceneMetrics.CombinedScore);
-	if (!PaletteId.IsEmpty())
-	{
-		Root->SetStringField(TEXT("palette_id"), PaletteId);
-		Root->SetBoolField(TEXT("palette_resolved"), PaletteObj.IsValid());
+		TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
+		Root->SetBoolField(TEXT("ok"), true);
+		Root->SetStringField(TEXT("operator"), TEXT("biome_layers"));
+		Root->SetStringField(TEXT("target"), TargetActor->GetActorLabel());
+		Root->SetNumberField(TEXT("applied_params"), AppliedCount);
+		Root->SetArrayField(TEXT("missing"), MissingArr);
+		Root->SetNumberField(TEXT("generated_components"), Triggered);
+		Root->SetStringField(TEXT("distribution_mode"), Distribution.Mode);
+		Root->SetNumberField(TEXT("distribution_points"), DistributionPoints.Num());
+		Root->SetArrayField(TEXT("distribution_point_sample"), BuildPointSampleArray(DistributionPoints));
+		Root->SetObjectField(TEXT("distribution_diagnostics"), BuildDistributionDiagnosticsJson(DistributionDiagnostics));
+		Root->SetBoolField(TEXT("generation_time_exceeded"), DistributionDiagnostics.bGenerationTimeExceeded);
+		Root->SetNumberField(TEXT("scene_score"), DistributionDiagnostics.SceneMetrics.CombinedScore);
+		if (!PaletteId.IsEmpty())
+		{
+			Root->SetStringField(TEXT("palette_id"), PaletteId);
+			Root->SetBoolField(TEXT("palette_resolved"), PaletteObj.IsValid());
+		}
+		return ToJson(Root);
 	}
-	return ToJson(Root);
+}
+#endif
+
+FString FProceduralOpsModule::BiomeLayers(const TSharedPtr<FJsonObject>& Args)
+{
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Operators.BiomeLayers");
+#if WITH_EDITOR
+	return RunOperatorWork(*PrepareOperatorWork<FBiomeLayersWork>(Args));
 #else
 	return ErrorJson(TEXT("WITH_EDITOR required."));
 #endif
@@ -1974,6 +3468,7 @@ FString FProceduralOpsModule::BiomeLayers(const TSharedPtr<FJsonObject>& Args)
 
 FString FProceduralOpsModule::StampPOI(const TSharedPtr<FJsonObject>& Args)
 {
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Operators.StampPOI");
 #if WITH_EDITOR
 	UWorld* World = GetEditorWorld();
 	if (!World)
@@ -2146,130 +3641,290 @@ FString FProceduralOpsModule::StampPOI(const TSharedPtr<FJsonObject>& Args)
 #endif
 }
 
-FString FProceduralOpsModule::RunOperatorPipeline(const TSharedPtr<FJsonObject>& Args)
-{
 #if WITH_EDITOR
-	UWorld* World = GetEditorWorld();
-	if (!World)
-	{
-		return ErrorJson(TEXT("No editor world."));
-	}
-
-	const bool bAllowMenuLevel = Args.IsValid() && Args->HasField(TEXT("allow_menu_level")) && Args->GetBoolField(TEXT("allow_menu_level"));
-	const FString PackagePath = World->GetOutermost() ? World->GetOutermost()->GetName() : FString();
-	if (!bAllowMenuLevel && PackagePath.Contains(TEXT("MenuLevel"), ESearchCase::IgnoreCase))
+namespace
+{
+	// How run_operator_pipeline can be undone.
+	//   Full      one FScopedTransaction around every stage (editor undo; the
+	//             buffer grows with every spawned actor and component)
+	//   Snapshot  no transaction; the actors the pipeline spawns are recorded and
+	//             tagged, and rollback / undo_operator_pipeline destroys them
+	//   None      no transaction and no record; failures cannot be rolled back
+	enum class EPipelineUndoMode : uint8
 	{
-		return ErrorJson(TEXT("run_operator_pipeline blocked on MenuLevel. Load a gameplay/validation level first or pass allow_menu_level=true."));
-	}
+		Full,
+		Snapshot,
+		None
+	};
 
-	if (GOperatorPolicy.bOperatorOnly && Args.IsValid() && Args->HasField(TEXT("allow_atomic_placement")))
+	static const TCHAR* PipelineUndoModeName(EPipelineUndoMode Mode)
 	{
-		const bool bRequestAtomic = Args->GetBoolField(TEXT("allow_atomic_placement"));
-		if (bRequestAtomic && !GOperatorPolicy.bAllowAtomicPlacement)
+		switch (Mode)
 		{
-			return ErrorJson(TEXT("Policy blocks atomic placement. Use constrained operators only."));
+		case EPipelineUndoMode::Snapshot: return TEXT("snapshot");
+		case EPipelineUndoMode::None:     return TEXT("none");
+		default:                          return TEXT("full");
 		}
 	}
 
-	const int32 ActorCountBefore = CountWorldActors(World);
-	const FPlatformMemoryStats MemBefore = FPlatformMemory::GetStats();
-	const float UsedBeforeMB = (float)((double)MemBefore.UsedPhysical / (1024.0 * 1024.0));
+	static const FName GPipelineGeneratedTag(TEXT("AF_Operator_Pipeline"));
+
+	// Actors recorded by snapshot-mode pipelines, newest last. Game thread only.
+	struct FPipelineUndoRecord
+	{
+		FString                         PipelineId;
+		TWeakObjectPtr<UWorld>          World;
+		TArray<TWeakObjectPtr<AActor>>  Actors;
+	};
 
-	int32 MaxActorDelta = GOperatorPolicy.MaxActorDeltaPerPipeline;
-	float MaxMemoryMB = GOperatorPolicy.MaxMemoryUsedMB;
-	float MaxGenerationTimeMs = GOperatorPolicy.MaxGenerationTimeMs;
-	bool bStopOnError = true;
+	static constexpr int32 MaxPipelineUndoRecords = 8;
+	static TArray<FPipelineUndoRecord> GPipelineUndoRecords;
+	static int32 GPipelineUndoCounter = 0;
 
-	if (Args.IsValid())
+	static bool HasOperatorTag(const AActor* Actor)
 	{
-		if (Args->HasField(TEXT("max_actor_delta")))
-		{
-			MaxActorDelta = FMath::Clamp((int32)Args->GetNumberField(TEXT("max_actor_delta")), 1, 200000);
-		}
-		if (Args->HasField(TEXT("max_memory_used_mb")))
+		for (const FName& Tag : Actor->Tags)
 		{
-			MaxMemoryMB = FMath::Max(1024.0f, (float)Args->GetNumberField(TEXT("max_memory_used_mb")));
+			if (Tag.ToString().StartsWith(TEXT("AF_Operator_")))
+			{
+				return true;
+			}
 		}
-		if (Args->HasField(TEXT("max_generation_time_ms")))
+		return false;
+	}
+
+	// Destroys the recorded actors that still carry an AF_Operator_* tag; anything
+	// the user re-tagged since is treated as adopted and kept.
+	static int32 DestroyGeneratedActors(UWorld* World, const TArray<TWeakObjectPtr<AActor>>& Actors)
+	{
+		int32 Destroyed = 0;
+		if (!World)
 		{
-			MaxGenerationTimeMs = FMath::Clamp((float)Args->GetNumberField(TEXT("max_generation_time_ms")), 10.0f, 600000.0f);
+			return Destroyed;
 		}
-		if (Args->HasField(TEXT("stop_on_error")))
+		for (const TWeakObjectPtr<AActor>& Weak : Actors)
 		{
-			bStopOnError = Args->GetBoolField(TEXT("stop_on_error"));
+			AActor* Actor = Weak.Get();
+			if (Actor && IsValid(Actor) && Actor->GetWorld() == World && HasOperatorTag(Actor) && World->DestroyActor(Actor))
+			{
+				++Destroyed;
+			}
 		}
+		return Destroyed;
 	}
 
-	FScopedTransaction Transaction(NSLOCTEXT("UEAgentForge", "RunOperatorPipeline", "AgentForge: Run Operator Pipeline"));
-	TArray<TSharedPtr<FJsonValue>> StageResults;
-	bool bAnyFailure = false;
-	bool bTimeBudgetExceeded = false;
-	FString TimeBudgetFailureReason;
-	const double PipelineStartSeconds = FPlatformTime::Seconds();
+	// run_operator_pipeline stages in commit order. A stage prepares once the
+	// stage it DependsOn (an earlier row) has committed: scatter and POI
+	// projection need the terrain, the spline scatter needs the road. Roads
+	// come first so the road spline scatter computes while the terrain does.
+	struct FOperatorPipelineStageDef
+	{
+		const TCHAR* Name;
+		const TCHAR* PrimaryKey;
+		const TCHAR* SecondaryKey;
+		FOperatorWorkPtr (*Prepare)(const TSharedPtr<FJsonObject>&);
+		const TCHAR* DependsOn;
+		float Weight;
+	};
 
-	auto BuildStageArgs = [&](const FString& Primary, const FString& Secondary = FString()) -> TSharedPtr<FJsonObject>
+	static const FOperatorPipelineStageDef GOperatorPipelineStages[] =
 	{
-		if (!Args.IsValid())
+		{ TEXT("road_layout"),      TEXT("road_layout"),      TEXT("roads"),   &PrepareCommitOnlyWork<&FProceduralOpsModule::RoadLayout>, nullptr,                   1.0f },
+		{ TEXT("terrain_generate"), TEXT("terrain_generate"), TEXT("terrain"), &PrepareOperatorWork<FTerrainGenerateWork>,                nullptr,                   3.0f },
+		{ TEXT("biome_layers"),     TEXT("biome_layers"),     TEXT("biomes"),  &PrepareOperatorWork<FBiomeLayersWork>,                    TEXT("terrain_generate"),  1.0f },
+		{ TEXT("surface_scatter"),  TEXT("surface_scatter"),  TEXT("surface"), &PrepareOperatorWork<FSurfaceScatterWork>,                 TEXT("terrain_generate"),  2.0f },
+		{ TEXT("spline_scatter"),   TEXT("spline_scatter"),   TEXT("spline"),  &PrepareOperatorWork<FSplineScatterWork>,                  TEXT("road_layout"),       1.0f },
+		{ TEXT("stamp_poi"),        TEXT("stamp_poi"),        TEXT("poi"),     &PrepareCommitOnlyWork<&FProceduralOpsModule::StampPOI>,   TEXT("terrain_generate"),  1.0f },
+	};
+
+	// Shared state for run_operator_pipeline. Each operator runs as its own job
+	// stage so the async path can yield to the editor between operators; the
+	// synchronous command simply runs every stage back to back.
+	//
+	// Stages commit in table order, on the game thread. Compute phases start as
+	// soon as their dependency has committed, on the task graph, so independent
+	// operators overlap: the terrain with the road spline scatter, then the
+	// biome and surface scatters with each other. A stage whose compute has to
+	// stay on the game thread runs it just before its commit.
+	struct FOperatorPipelineRun
+	{
+		// One per GOperatorPipelineStages row.
+		struct FScheduledStage
+		{
+			TSharedPtr<FJsonObject> StageArgs;    // null when the stage was not requested
+			FOperatorWorkPtr        Work;         // from Prepare, released after Commit
+			TFuture<void>           Compute;      // valid when the compute went to a worker
+			double                  ComputeMs = 0.0;
+			bool                    bComputed = false;    // game-thread compute finished in IsReadyToCommit
+			bool                    bCommitted = false;
+		};
+
+		TSharedPtr<FJsonObject>        Args;
+		TWeakObjectPtr<UWorld>         World;
+		EPipelineUndoMode              UndoMode = EPipelineUndoMode::Full;
+		FDelegateHandle                ActorAddedHandle;
+		TArray<TWeakObjectPtr<AActor>> GeneratedActors;   // Snapshot mode only
+		int32                          ActorCountBefore = 0;
+		float                          UsedBeforeMB = 0.0f;
+		int32                          MaxActorDelta = 0;
+		float                          MaxMemoryMB = 0.0f;
+		float                          MaxGenerationTimeMs = 0.0f;
+		bool                           bStopOnError = true;
+		TUniquePtr<FScopedTransaction> Transaction;
+		TArray<TSharedPtr<FJsonValue>> StageResults;
+		bool                           bAnyFailure = false;
+		bool                           bTimeBudgetExceeded = false;
+		FString                        TimeBudgetFailureReason;
+		double                         PipelineStartSeconds = 0.0;
+		TArray<FScheduledStage>        Scheduled;
+
+		~FOperatorPipelineRun()
+		{
+			WaitForCompute();
+			StopRecording();
+		}
+
+		// Work items are referenced by their worker tasks until the task has run.
+		void WaitForCompute()
+		{
+			for (FScheduledStage& Stage : Scheduled)
+			{
+				if (Stage.Compute.IsValid())
+				{
+					Stage.Compute.Wait();
+				}
+			}
+		}
+
+		void HandleActorAdded(AActor* Actor)
 		{
-			return nullptr;
+			if (Actor && Actor->GetWorld() == World.Get())
+			{
+				GeneratedActors.Add(Actor);
+			}
 		}
 
-		const TSharedPtr<FJsonObject>* StageObj = nullptr;
-		if (Args->TryGetObjectField(Primary, StageObj) && StageObj && StageObj->IsValid())
+		void StopRecording()
 		{
-			TSharedPtr<FJsonObject> CopyObj = MakeShared<FJsonObject>();
-			for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : (*StageObj)->Values)
+			if (ActorAddedHandle.IsValid())
 			{
-				CopyObj->SetField(Pair.Key, Pair.Value);
+				if (GEngine)
+				{
+					GEngine->OnLevelActorAdded().Remove(ActorAddedHandle);
+				}
+				ActorAddedHandle.Reset();
 			}
-			if (Args->HasField(TEXT("seed")) && !CopyObj->HasField(TEXT("seed")))
+		}
+
+		// Returns an error response, or an empty string once the transaction (or
+		// the actor recorder) is in place.
+		FString Begin(const TSharedPtr<FJsonObject>& InArgs)
+		{
+			Args = InArgs;
+			UWorld* EditorWorld = GetEditorWorld();
+			if (!EditorWorld)
 			{
-				CopyObj->SetNumberField(TEXT("seed"), Args->GetNumberField(TEXT("seed")));
+				return ErrorJson(TEXT("No editor world."));
 			}
-			if (Args->HasField(TEXT("palette_id")) && !CopyObj->HasField(TEXT("palette_id")))
+			World = EditorWorld;
+
+			const bool bAllowMenuLevel = Args.IsValid() && Args->HasField(TEXT("allow_menu_level")) && Args->GetBoolField(TEXT("allow_menu_level"));
+			const FString PackagePath = EditorWorld->GetOutermost() ? EditorWorld->GetOutermost()->GetName() : FString();
+			if (!bAllowMenuLevel && PackagePath.Contains(TEXT("MenuLevel"), ESearchCase::IgnoreCase))
 			{
-				CopyObj->SetStringField(TEXT("palette_id"), Args->GetStringField(TEXT("palette_id")));
+				return ErrorJson(TEXT("run_operator_pipeline blocked on MenuLevel. Load a gameplay/validation level first or pass allow_menu_level=true."));
 			}
-			if (Args->HasField(TEXT("distribution_mode")) && !CopyObj->HasField(TEXT("distribution_mode")))
+
+			if (GOperatorPolicy.bOperatorOnly && Args.IsValid() && Args->HasField(TEXT("allow_atomic_placement")))
 			{
-				CopyObj->SetStringField(TEXT("distribution_mode"), Args->GetStringField(TEXT("distribution_mode")));
+				const bool bRequestAtomic = Args->GetBoolField(TEXT("allow_atomic_placement"));
+				if (bRequestAtomic && !GOperatorPolicy.bAllowAtomicPlacement)
+				{
+					return ErrorJson(TEXT("Policy blocks atomic placement. Use constrained operators only."));
+				}
 			}
-			if (Args->HasField(TEXT("density")) && !CopyObj->HasField(TEXT("density")))
+
+			ActorCountBefore = CountWorldActors(EditorWorld);
+			UsedBeforeMB = (float)FAgentForgeMemoryMonitor::Get().GetSample().UsedMB;
+
+			MaxActorDelta = GOperatorPolicy.MaxActorDeltaPerPipeline;
+			MaxMemoryMB = GOperatorPolicy.MaxMemoryUsedMB;
+			MaxGenerationTimeMs = GOperatorPolicy.MaxGenerationTimeMs;
+
+			if (Args.IsValid())
 			{
-				CopyObj->SetNumberField(TEXT("density"), Args->GetNumberField(TEXT("density")));
+				if (Args->HasField(TEXT("max_actor_delta")))
+				{
+					MaxActorDelta = FMath::Clamp((int32)Args->GetNumberField(TEXT("max_actor_delta")), 1, 200000);
+				}
+				if (Args->HasField(TEXT("max_memory_used_mb")))
+				{
+					MaxMemoryMB = FMath::Max(1024.0f, (float)Args->GetNumberField(TEXT("max_memory_used_mb")));
+				}
+				if (Args->HasField(TEXT("max_generation_time_ms")))
+				{
+					MaxGenerationTimeMs = FMath::Clamp((float)Args->GetNumberField(TEXT("max_generation_time_ms")), 10.0f, 600000.0f);
+				}
+				if (Args->HasField(TEXT("stop_on_error")))
+				{
+					bStopOnError = Args->GetBoolField(TEXT("stop_on_error"));
+				}
+				FString UndoModeName;
+				if (Args->TryGetStringField(TEXT("undo_mode"), UndoModeName) && !UndoModeName.IsEmpty())
+				{
+					if (UndoModeName.Equals(TEXT("full"), ESearchCase::IgnoreCase))          { UndoMode = EPipelineUndoMode::Full; }
+					else if (UndoModeName.Equals(TEXT("snapshot"), ESearchCase::IgnoreCase)) { UndoMode = EPipelineUndoMode::Snapshot; }
+					else if (UndoModeName.Equals(TEXT("none"), ESearchCase::IgnoreCase))     { UndoMode = EPipelineUndoMode::None; }
+					else
+					{
+						return ErrorJson(FString::Printf(TEXT("Unknown undo_mode '%s' (expected full, snapshot or none)."), *UndoModeName));
+					}
+				}
 			}
-			if (Args->HasField(TEXT("cluster_radius")) && !CopyObj->HasField(TEXT("cluster_radius")))
+
+			if (UndoMode == EPipelineUndoMode::Full)
 			{
-				CopyObj->SetNumberField(TEXT("cluster_radius"), Args->GetNumberField(TEXT("cluster_radius")));
+				Transaction = MakeUnique<FScopedTransaction>(NSLOCTEXT("UEAgentForge", "RunOperatorPipeline", "AgentForge: Run Operator Pipeline"));
 			}
-			if (Args->HasField(TEXT("min_spacing")) && !CopyObj->HasField(TEXT("min_spacing")))
+			else if (UndoMode == EPipelineUndoMode::Snapshot && GEngine)
 			{
-				CopyObj->SetNumberField(TEXT("min_spacing"), Args->GetNumberField(TEXT("min_spacing")));
+				ActorAddedHandle = GEngine->OnLevelActorAdded().AddRaw(this, &FOperatorPipelineRun::HandleActorAdded);
 			}
-			for (const TCHAR* SharedFieldName : {
-					TEXT("height_range"), TEXT("slope_range"), TEXT("distance_mask"), TEXT("point_count"), TEXT("max_points"), TEXT("cluster_count"),
-					TEXT("max_spawn_points"), TEXT("max_cluster_count"), TEXT("max_generation_time_ms"),
-					TEXT("density_sigma"), TEXT("density_noise"), TEXT("density_field_resolution"), TEXT("use_density_gradient"),
-					TEXT("clearings"), TEXT("clearing_density"), TEXT("clearing_count"), TEXT("clearing_radius_min"), TEXT("clearing_radius_max"),
-					TEXT("biome_count"), TEXT("biome_types"), TEXT("allowed_biomes"), TEXT("biome_blend_distance"),
-					TEXT("avoid_points"), TEXT("avoid_radius"), TEXT("prefer_near_points"), TEXT("prefer_radius"), TEXT("prefer_strength"),
-					TEXT("interaction_rules") })
+			// Start streaming the shared palette's assets now, so they load while the terrain stage runs.
+			FString SharedPaletteId;
+			if (Args.IsValid() && Args->TryGetStringField(TEXT("palette_id"), SharedPaletteId) && !SharedPaletteId.IsEmpty())
 			{
-				const FString SharedField(SharedFieldName);
-				if (!CopyObj->HasField(SharedField))
-				{
-					const TSharedPtr<FJsonValue>* Value = Args->Values.Find(SharedField);
-					if (Value && Value->IsValid())
-					{
-						CopyObj->SetField(SharedField, *Value);
-					}
-				}
+				TSharedPtr<FJsonObject> SharedPalette;
+				FString SharedPaletteError;
+				FPaletteManager::LoadPaletteById(SharedPaletteId, SharedPalette, SharedPaletteError, /*bPreloadAssets*/ true);
 			}
-			return CopyObj;
+
+			Scheduled.SetNum((int32)UE_ARRAY_COUNT(GOperatorPipelineStages));
+			for (int32 Index = 0; Index < Scheduled.Num(); ++Index)
+			{
+				Scheduled[Index].StageArgs = BuildStageArgs(GOperatorPipelineStages[Index].PrimaryKey, GOperatorPipelineStages[Index].SecondaryKey);
+			}
+
+			PipelineStartSeconds = FPlatformTime::Seconds();
+			return FString();
 		}
 
-		if (!Secondary.IsEmpty() && Args->TryGetObjectField(Secondary, StageObj) && StageObj && StageObj->IsValid())
+		TSharedPtr<FJsonObject> BuildStageArgs(const FString& Primary, const FString& Secondary = FString()) const
 		{
+			if (!Args.IsValid())
+			{
+				return nullptr;
+			}
+
+			const TSharedPtr<FJsonObject>* StageObj = nullptr;
+			const bool bFound =
+				(Args->TryGetObjectField(Primary, StageObj) && StageObj && StageObj->IsValid()) ||
+				(!Secondary.IsEmpty() && Args->TryGetObjectField(Secondary, StageObj) && StageObj && StageObj->IsValid());
+			if (!bFound)
+			{
+				return nullptr;
+			}
+
 			TSharedPtr<FJsonObject> CopyObj = MakeShared<FJsonObject>();
 			for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : (*StageObj)->Values)
 			{
@@ -2300,13 +3955,14 @@ FString FProceduralOpsModule::RunOperatorPipeline(const TSharedPtr<FJsonObject>&
 				CopyObj->SetNumberField(TEXT("min_spacing"), Args->GetNumberField(TEXT("min_spacing")));
 			}
 			for (const TCHAR* SharedFieldName : {
-					TEXT("height_range"), TEXT("slope_range"), TEXT("distance_mask"), TEXT("point_count"), TEXT("max_points"), TEXT("cluster_count"),
+					TEXT("height_range"), TEXT("slope_range"), TEXT("surface_source"), TEXT("distance_mask"), TEXT("point_count"), TEXT("max_points"), TEXT("cluster_count"),
 					TEXT("max_spawn_points"), TEXT("max_cluster_count"), TEXT("max_generation_time_ms"),
-					TEXT("density_sigma"), TEXT("density_noise"), TEXT("density_field_resolution"), TEXT("use_density_gradient"),
+					TEXT("density_sigma"), TEXT("density_noise"), TEXT("density_field_resolution"), TEXT("use_density_gradient"), TEXT("fused_masks"),
 					TEXT("clearings"), TEXT("clearing_density"), TEXT("clearing_count"), TEXT("clearing_radius_min"), TEXT("clearing_radius_max"),
+					TEXT("clearing_falloff"), TEXT("clearing_inner_density"), TEXT("clearing_min_gap"),
 					TEXT("biome_count"), TEXT("biome_types"), TEXT("allowed_biomes"), TEXT("biome_blend_distance"),
 					TEXT("avoid_points"), TEXT("avoid_radius"), TEXT("prefer_near_points"), TEXT("prefer_radius"), TEXT("prefer_strength"),
-					TEXT("interaction_rules") })
+					TEXT("interaction_rules"), TEXT("cache") })
 			{
 				const FString SharedField(SharedFieldName);
 				if (!CopyObj->HasField(SharedField))
@@ -2321,130 +3977,374 @@ FString FProceduralOpsModule::RunOperatorPipeline(const TSharedPtr<FJsonObject>&
 			return CopyObj;
 		}
 
-		return nullptr;
-	};
+		// Prepares every requested stage whose dependency has committed and hands
+		// its compute to the task graph. Game thread.
+		void LaunchReadyStages()
+		{
+			if (bTimeBudgetExceeded)
+			{
+				return;
+			}
+			for (int32 Index = 0; Index < Scheduled.Num(); ++Index)
+			{
+				FScheduledStage& Stage = Scheduled[Index];
+				if (!Stage.StageArgs.IsValid() || Stage.Work.IsValid() || Stage.bCommitted)
+				{
+					continue;
+				}
+				if (const TCHAR* DependsOn = GOperatorPipelineStages[Index].DependsOn)
+				{
+					const int32 DependencyIndex = Algo::IndexOfByPredicate(GOperatorPipelineStages,
+						[DependsOn](const FOperatorPipelineStageDef& Def) { return FCString::Strcmp(Def.Name, DependsOn) == 0; });
+					const FScheduledStage& Dependency = Scheduled[DependencyIndex];
+					if (Dependency.StageArgs.IsValid() && !Dependency.bCommitted)
+					{
+						continue;
+					}
+				}
 
-	auto RunStage = [&](const FString& Name, const TSharedPtr<FJsonObject>& StageArgs, TFunctionRef<FString(const TSharedPtr<FJsonObject>&)> Fn)
-	{
-		if (bTimeBudgetExceeded)
+				Stage.Work = GOperatorPipelineStages[Index].Prepare(Stage.StageArgs);
+				if (!Stage.Work->ComputesOnGameThread())
+				{
+					FOperatorWork* Work = Stage.Work.Get();
+					double* ComputeMs = &Stage.ComputeMs;
+					Stage.Compute = Async(EAsyncExecution::TaskGraph, [Work, ComputeMs]()
+					{
+						const double StartSeconds = FPlatformTime::Seconds();
+						Work->Compute();
+						*ComputeMs = (FPlatformTime::Seconds() - StartSeconds) * 1000.0;
+					});
+				}
+			}
+		}
+
+		// False while the stage's compute is still running: a worker task, or a
+		// game-thread compute waiting on the GPU, which gets one ComputeSlice per call.
+		bool IsReadyToCommit(int32 Index)
 		{
-			return;
+			FScheduledStage& Stage = Scheduled[Index];
+			if (Stage.Compute.IsValid())
+			{
+				return Stage.Compute.IsReady();
+			}
+			if (bTimeBudgetExceeded || !Stage.Work.IsValid() || Stage.bComputed)
+			{
+				return true;
+			}
+			const double SliceStart = FPlatformTime::Seconds();
+			Stage.bComputed = Stage.Work->ComputeSlice();
+			Stage.ComputeMs += (FPlatformTime::Seconds() - SliceStart) * 1000.0;
+			return Stage.bComputed;
 		}
-		if (!StageArgs.IsValid())
+
+		// Commits one stage, running its compute first when that stays on the game
+		// thread. Returns the stage result, or null if the stage was not requested
+		// or the time budget was already exhausted.
+		TSharedPtr<FJsonObject> CommitStage(int32 Index)
 		{
-			return;
+			LaunchReadyStages();
+			FScheduledStage& Stage = Scheduled[Index];
+			if (bTimeBudgetExceeded || !Stage.Work.IsValid())
+			{
+				return nullptr;
+			}
+
+			const bool bWorkerCompute = Stage.Compute.IsValid();
+			if (!bWorkerCompute && !Stage.bComputed)
+			{
+				const double ComputeStart = FPlatformTime::Seconds();
+				Stage.Work->Compute();
+				Stage.ComputeMs = (FPlatformTime::Seconds() - ComputeStart) * 1000.0;
+			}
+			const double CommitStart = FPlatformTime::Seconds();
+			const FString Raw = Stage.Work->Commit();
+			const double CommitMs = (FPlatformTime::Seconds() - CommitStart) * 1000.0;
+			Stage.Work.Reset();
+			Stage.bCommitted = true;
+
+			TSharedPtr<FJsonObject> Parsed = RecordStageResult(GOperatorPipelineStages[Index].Name, Raw);
+			Parsed->SetStringField(TEXT("compute_thread"), bWorkerCompute ? TEXT("worker") : TEXT("game"));
+			Parsed->SetNumberField(TEXT("compute_ms"), Stage.ComputeMs);
+			Parsed->SetNumberField(TEXT("commit_ms"), CommitMs);
+
+			// Dependents of this stage start computing before the next slice.
+			LaunchReadyStages();
+			return Parsed;
 		}
 
-		const FString Raw = Fn(StageArgs);
-		TSharedPtr<FJsonObject> Parsed = ParseJsonObjectOrNull(Raw);
-		if (!Parsed.IsValid())
+		// Parses a stage response into StageResults and checks the time budget.
+		TSharedPtr<FJsonObject> RecordStageResult(const FString& Name, const FString& Raw)
 		{
-			Parsed = MakeShared<FJsonObject>();
-			Parsed->SetBoolField(TEXT("ok"), false);
-			Parsed->SetStringField(TEXT("error"), TEXT("stage_returned_non_json"));
-			Parsed->SetStringField(TEXT("raw"), Raw);
+			TSharedPtr<FJsonObject> Parsed = ParseJsonObjectOrNull(Raw);
+			if (!Parsed.IsValid())
+			{
+				Parsed = MakeShared<FJsonObject>();
+				Parsed->SetBoolField(TEXT("ok"), false);
+				Parsed->SetStringField(TEXT("error"), TEXT("stage_returned_non_json"));
+				Parsed->SetStringField(TEXT("raw"), Raw);
+			}
+			Parsed->SetStringField(TEXT("stage"), Name);
+
+			if (Parsed->HasField(TEXT("error")))
+			{
+				bAnyFailure = true;
+			}
+
+			const double ElapsedMs = (FPlatformTime::Seconds() - PipelineStartSeconds) * 1000.0;
+			Parsed->SetNumberField(TEXT("pipeline_elapsed_ms"), ElapsedMs);
+			if (MaxGenerationTimeMs > 0.0f && ElapsedMs > (double)MaxGenerationTimeMs)
+			{
+				bTimeBudgetExceeded = true;
+				bAnyFailure = true;
+				TimeBudgetFailureReason = FString::Printf(
+					TEXT("Generation time %.1f ms exceeded max_generation_time_ms %.1f ms."),
+					ElapsedMs,
+					MaxGenerationTimeMs);
+				Parsed->SetBoolField(TEXT("time_budget_exceeded"), true);
+				Parsed->SetStringField(TEXT("error"), TimeBudgetFailureReason);
+			}
+
+			StageResults.Add(MakeShared<FJsonValueObject>(Parsed));
+			return Parsed;
 		}
-		Parsed->SetStringField(TEXT("stage"), Name);
 
-		if (Parsed->HasField(TEXT("error")))
+		// Undoes the run in its undo_mode. Returns false when nothing could be undone (none).
+		bool RollBack()
 		{
-			bAnyFailure = true;
+			WaitForCompute();
+			StopRecording();
+			if (Transaction.IsValid())
+			{
+				Transaction->Cancel();
+				Transaction.Reset();
+				return true;
+			}
+			if (UndoMode == EPipelineUndoMode::Snapshot)
+			{
+				DestroyGeneratedActors(World.Get(), GeneratedActors);
+				GeneratedActors.Reset();
+				return true;
+			}
+			return false;
 		}
 
-		const double ElapsedMs = (FPlatformTime::Seconds() - PipelineStartSeconds) * 1000.0;
-		Parsed->SetNumberField(TEXT("pipeline_elapsed_ms"), ElapsedMs);
-		if (MaxGenerationTimeMs > 0.0f && ElapsedMs > (double)MaxGenerationTimeMs)
+		// Keeps the generated actors and records them for undo_operator_pipeline.
+		void CommitSnapshotRecord(TSharedPtr<FJsonObject>& Root)
 		{
-			bTimeBudgetExceeded = true;
-			bAnyFailure = true;
-			TimeBudgetFailureReason = FString::Printf(
-				TEXT("Generation time %.1f ms exceeded max_generation_time_ms %.1f ms."),
-				ElapsedMs,
-				MaxGenerationTimeMs);
-			Parsed->SetBoolField(TEXT("time_budget_exceeded"), true);
-			Parsed->SetStringField(TEXT("error"), TimeBudgetFailureReason);
+			StopRecording();
+
+			FPipelineUndoRecord Record;
+			Record.PipelineId = FString::Printf(TEXT("pipeline_%d"), ++GPipelineUndoCounter);
+			Record.World = World;
+			for (const TWeakObjectPtr<AActor>& Weak : GeneratedActors)
+			{
+				if (AActor* Actor = Weak.Get())
+				{
+					AddOperatorTag(Actor, GPipelineGeneratedTag);
+					Record.Actors.Add(Actor);
+				}
+			}
+			GeneratedActors.Reset();
+
+			Root->SetStringField(TEXT("pipeline_id"), Record.PipelineId);
+			Root->SetNumberField(TEXT("generated_actor_count"), Record.Actors.Num());
+
+			GPipelineUndoRecords.Add(MoveTemp(Record));
+			if (GPipelineUndoRecords.Num() > MaxPipelineUndoRecords)
+			{
+				GPipelineUndoRecords.RemoveAt(0, GPipelineUndoRecords.Num() - MaxPipelineUndoRecords);
+			}
 		}
 
-		StageResults.Add(MakeShared<FJsonValueObject>(Parsed));
+		FString Finish()
+		{
+			if (bTimeBudgetExceeded)
+			{
+				const bool bRolledBack = RollBack();
+				TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
+				Root->SetBoolField(TEXT("ok"), false);
+				Root->SetStringField(TEXT("error"), TimeBudgetFailureReason);
+				Root->SetArrayField(TEXT("stages"), StageResults);
+				Root->SetBoolField(TEXT("rolled_back"), bRolledBack);
+				Root->SetStringField(TEXT("undo_mode"), PipelineUndoModeName(UndoMode));
+				Root->SetNumberField(TEXT("max_generation_time_ms"), MaxGenerationTimeMs);
+				Root->SetNumberField(TEXT("pipeline_elapsed_ms"), (FPlatformTime::Seconds() - PipelineStartSeconds) * 1000.0);
+				return ToJson(Root);
+			}
+
+			if (bAnyFailure && bStopOnError)
+			{
+				const bool bRolledBack = RollBack();
+				TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
+				Root->SetBoolField(TEXT("ok"), false);
+				Root->SetStringField(TEXT("error"), TimeBudgetFailureReason.IsEmpty() ? TEXT("Pipeline halted after a stage error.") : TimeBudgetFailureReason);
+				Root->SetArrayField(TEXT("stages"), StageResults);
+				Root->SetBoolField(TEXT("rolled_back"), bRolledBack);
+				Root->SetStringField(TEXT("undo_mode"), PipelineUndoModeName(UndoMode));
+				return ToJson(Root);
+			}
+
+			UWorld* EditorWorld = World.Get();
+			if (!EditorWorld)
+			{
+				RollBack();
+				return ErrorJson(TEXT("Editor world changed while run_operator_pipeline was running."));
+			}
+
+			const int32 ActorCountAfter = CountWorldActors(EditorWorld);
+			const int32 ActorDelta = ActorCountAfter - ActorCountBefore;
+			const float UsedAfterMB = (float)FAgentForgeMemoryMonitor::Get().GetSample().UsedMB;
+
+			bool bBudgetExceeded = false;
+			FString BudgetFailureReason;
+			if (ActorDelta > MaxActorDelta)
+			{
+				bBudgetExceeded = true;
+				BudgetFailureReason = FString::Printf(TEXT("Actor delta %d exceeded max_actor_delta %d."), ActorDelta, MaxActorDelta);
+			}
+			else if (UsedAfterMB > MaxMemoryMB)
+			{
+				bBudgetExceeded = true;
+				BudgetFailureReason = FString::Printf(TEXT("Memory %.1f MB exceeded max_memory_used_mb %.1f MB."), UsedAfterMB, MaxMemoryMB);
+			}
+
+			if (bBudgetExceeded)
+			{
+				const bool bRolledBack = RollBack();
+				TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
+				Root->SetBoolField(TEXT("ok"), false);
+				Root->SetStringField(TEXT("error"), BudgetFailureReason);
+				Root->SetArrayField(TEXT("stages"), StageResults);
+				Root->SetBoolField(TEXT("rolled_back"), bRolledBack);
+				Root->SetStringField(TEXT("undo_mode"), PipelineUndoModeName(UndoMode));
+				Root->SetNumberField(TEXT("actor_delta"), ActorDelta);
+				Root->SetNumberField(TEXT("memory_before_mb"), UsedBeforeMB);
+				Root->SetNumberField(TEXT("memory_after_mb"), UsedAfterMB);
+				return ToJson(Root);
+			}
+
+			Transaction.Reset();
+
+			TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
+			Root->SetBoolField(TEXT("ok"), !bAnyFailure);
+			Root->SetStringField(TEXT("operator_mode"), TEXT("deterministic_pipeline"));
+			Root->SetArrayField(TEXT("stages"), StageResults);
+			Root->SetBoolField(TEXT("rolled_back"), false);
+			Root->SetStringField(TEXT("undo_mode"), PipelineUndoModeName(UndoMode));
+			if (UndoMode == EPipelineUndoMode::Snapshot)
+			{
+				CommitSnapshotRecord(Root);
+			}
+			Root->SetNumberField(TEXT("actor_count_before"), ActorCountBefore);
+			Root->SetNumberField(TEXT("actor_count_after"), ActorCountAfter);
+			Root->SetNumberField(TEXT("actor_delta"), ActorDelta);
+			Root->SetNumberField(TEXT("memory_before_mb"), UsedBeforeMB);
+			Root->SetNumberField(TEXT("memory_after_mb"), UsedAfterMB);
+			Root->SetNumberField(TEXT("max_actor_delta"), MaxActorDelta);
+			Root->SetNumberField(TEXT("max_memory_used_mb"), MaxMemoryMB);
+			Root->SetNumberField(TEXT("max_generation_time_ms"), MaxGenerationTimeMs);
+			Root->SetNumberField(TEXT("pipeline_elapsed_ms"), (FPlatformTime::Seconds() - PipelineStartSeconds) * 1000.0);
+			return ToJson(Root);
+		}
 	};
+}
+#endif
+
+FString FProceduralOpsModule::RunOperatorPipeline(const TSharedPtr<FJsonObject>& Args)
+{
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Operators.RunOperatorPipeline");
+	return MakeOperatorPipelineJob(Args)->RunToCompletion();
+}
+
+TSharedRef<FAgentForgeJob> FProceduralOpsModule::MakeOperatorPipelineJob(const TSharedPtr<FJsonObject>& Args)
+{
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Operators.MakeOperatorPipelineJob");
+	TSharedRef<FAgentForgeJob> Job = MakeShared<FAgentForgeJob>(TEXT("run_operator_pipeline"));
+#if WITH_EDITOR
+	TSharedRef<FOperatorPipelineRun> Run = MakeShared<FOperatorPipelineRun>();
 
-	RunStage(TEXT("terrain_generate"), BuildStageArgs(TEXT("terrain_generate"), TEXT("terrain")), [](const TSharedPtr<FJsonObject>& StageArgs) { return FProceduralOpsModule::TerrainGenerate(StageArgs); });
-	RunStage(TEXT("road_layout"), BuildStageArgs(TEXT("road_layout"), TEXT("roads")), [](const TSharedPtr<FJsonObject>& StageArgs) { return FProceduralOpsModule::RoadLayout(StageArgs); });
-	RunStage(TEXT("biome_layers"), BuildStageArgs(TEXT("biome_layers"), TEXT("biomes")), [](const TSharedPtr<FJsonObject>& StageArgs) { return FProceduralOpsModule::BiomeLayers(StageArgs); });
-	RunStage(TEXT("surface_scatter"), BuildStageArgs(TEXT("surface_scatter"), TEXT("surface")), [](const TSharedPtr<FJsonObject>& StageArgs) { return FProceduralOpsModule::SurfaceScatter(StageArgs); });
-	RunStage(TEXT("spline_scatter"), BuildStageArgs(TEXT("spline_scatter"), TEXT("spline")), [](const TSharedPtr<FJsonObject>& StageArgs) { return FProceduralOpsModule::SplineScatter(StageArgs); });
-	RunStage(TEXT("stamp_poi"), BuildStageArgs(TEXT("stamp_poi"), TEXT("poi")), [](const TSharedPtr<FJsonObject>& StageArgs) { return FProceduralOpsModule::StampPOI(StageArgs); });
+	Job->AddStage(TEXT("prepare"), [Run, Args](FAgentForgeJob& J)
+	{
+		const FString Error = Run->Begin(Args);
+		if (!Error.IsEmpty()) { J.Finish(Error); }
+		return true;
+	}, 0.1f);
 
-	if (bTimeBudgetExceeded)
+	for (int32 Index = 0; Index < (int32)UE_ARRAY_COUNT(GOperatorPipelineStages); ++Index)
 	{
-		Transaction.Cancel();
-		TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
-		Root->SetBoolField(TEXT("ok"), false);
-		Root->SetStringField(TEXT("error"), TimeBudgetFailureReason);
-		Root->SetArrayField(TEXT("stages"), StageResults);
-		Root->SetBoolField(TEXT("rolled_back"), true);
-		Root->SetNumberField(TEXT("max_generation_time_ms"), MaxGenerationTimeMs);
-		Root->SetNumberField(TEXT("pipeline_elapsed_ms"), (FPlatformTime::Seconds() - PipelineStartSeconds) * 1000.0);
-		return ToJson(Root);
+		const FOperatorPipelineStageDef& Def = GOperatorPipelineStages[Index];
+		Job->AddStage(Def.Name, [Run, Index](FAgentForgeJob& J)
+		{
+			if (!Run->World.IsValid())
+			{
+				Run->RollBack();
+				J.Finish(ErrorJson(TEXT("Editor world changed while run_operator_pipeline was running.")));
+				return true;
+			}
+			Run->LaunchReadyStages();
+			if (!Run->IsReadyToCommit(Index))
+			{
+				J.YieldSlice();
+				return false;
+			}
+			J.AddPartialResult(Run->CommitStage(Index));
+			return true;
+		}, Def.Weight);
 	}
 
-	if (bAnyFailure && bStopOnError)
+	Job->SetFinalizer([Run](FAgentForgeJob&) { return Run->Finish(); });
+	Job->SetCancelHandler([Run](FAgentForgeJob&) { Run->RollBack(); });
+#else
+	Job->AddStage(TEXT("prepare"), [](FAgentForgeJob& J) { J.Finish(ErrorJson(TEXT("WITH_EDITOR required."))); return true; });
+#endif
+	return Job;
+}
+
+FString FProceduralOpsModule::UndoOperatorPipeline(const TSharedPtr<FJsonObject>& Args)
+{
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Operators.UndoOperatorPipeline");
+#if WITH_EDITOR
+	if (GPipelineUndoRecords.IsEmpty())
 	{
-		Transaction.Cancel();
-		TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
-		Root->SetBoolField(TEXT("ok"), false);
-		Root->SetStringField(TEXT("error"), TimeBudgetFailureReason.IsEmpty() ? TEXT("Pipeline halted after a stage error.") : TimeBudgetFailureReason);
-		Root->SetArrayField(TEXT("stages"), StageResults);
-		Root->SetBoolField(TEXT("rolled_back"), true);
-		return ToJson(Root);
+		return ErrorJson(TEXT("No recorded pipeline to undo. Only run_operator_pipeline with undo_mode=snapshot is recorded."));
 	}
 
-	const int32 ActorCountAfter = CountWorldActors(World);
-	const int32 ActorDelta = ActorCountAfter - ActorCountBefore;
-	const FPlatformMemoryStats MemAfter = FPlatformMemory::GetStats();
-	const float UsedAfterMB = (float)((double)MemAfter.UsedPhysical / (1024.0 * 1024.0));
-
-	bool bBudgetExceeded = false;
-	FString BudgetFailureReason;
-	if (ActorDelta > MaxActorDelta)
+	FString PipelineId;
+	if (Args.IsValid())
 	{
-		bBudgetExceeded = true;
-		BudgetFailureReason = FString::Printf(TEXT("Actor delta %d exceeded max_actor_delta %d."), ActorDelta, MaxActorDelta);
+		Args->TryGetStringField(TEXT("pipeline_id"), PipelineId);
 	}
-	else if (UsedAfterMB > MaxMemoryMB)
+
+	int32 RecordIndex = GPipelineUndoRecords.Num() - 1;
+	if (!PipelineId.IsEmpty())
 	{
-		bBudgetExceeded = true;
-		BudgetFailureReason = FString::Printf(TEXT("Memory %.1f MB exceeded max_memory_used_mb %.1f MB."), UsedAfterMB, MaxMemoryMB);
+		RecordIndex = GPipelineUndoRecords.IndexOfByPredicate([&PipelineId](const FPipelineUndoRecord& Record)
+		{
+			return Record.PipelineId == PipelineId;
+		});
+		if (RecordIndex == INDEX_NONE)
+		{
+			return ErrorJson(FString::Printf(TEXT("Unknown pipeline_id: %s"), *PipelineId));
+		}
 	}
 
-	if (bBudgetExceeded)
+	const FPipelineUndoRecord Record = GPipelineUndoRecords[RecordIndex];
+	GPipelineUndoRecords.RemoveAt(RecordIndex);
+
+	UWorld* World = Record.World.Get();
+	if (!World || World != GetEditorWorld())
 	{
-		Transaction.Cancel();
-		TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
-		Root->SetBoolField(TEXT("ok"), false);
-		Root->SetStringField(TEXT("error"), BudgetFailureReason);
-		Root->SetArrayField(TEXT("stages"), StageResults);
-		Root->SetBoolField(TEXT("rolled_back"), true);
-		Root->SetNumberField(TEXT("actor_delta"), ActorDelta);
-		Root->SetNumberField(TEXT("memory_before_mb"), UsedBeforeMB);
-		Root->SetNumberField(TEXT("memory_after_mb"), UsedAfterMB);
-		return ToJson(Root);
+		return ErrorJson(FString::Printf(TEXT("The level %s was generated in is no longer open."), *Record.PipelineId));
 	}
 
+	const int32 Destroyed = DestroyGeneratedActors(World, Record.Actors);
+
 	TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
-	Root->SetBoolField(TEXT("ok"), !bAnyFailure);
-	Root->SetStringField(TEXT("operator_mode"), TEXT("deterministic_pipeline"));
-	Root->SetArrayField(TEXT("stages"), StageResults);
-	Root->SetBoolField(TEXT("rolled_back"), false);
-	Root->SetNumberField(TEXT("actor_count_before"), ActorCountBefore);
-	Root->SetNumberField(TEXT("actor_count_after"), ActorCountAfter);
-	Root->SetNumberField(TEXT("actor_delta"), ActorDelta);
-	Root->SetNumberField(TEXT("memory_before_mb"), UsedBeforeMB);
-	Root->SetNumberField(TEXT("memory_after_mb"), UsedAfterMB);
-	Root->SetNumberField(TEXT("max_actor_delta"), MaxActorDelta);
-	Root->SetNumberField(TEXT("max_memory_used_mb"), MaxMemoryMB);
-	Root->SetNumberField(TEXT("max_generation_time_ms"), MaxGenerationTimeMs);
-	Root->SetNumberField(TEXT("pipeline_elapsed_ms"), (FPlatformTime::Seconds() - PipelineStartSeconds) * 1000.0);
+	Root->SetBoolField(TEXT("ok"), true);
+	Root->SetStringField(TEXT("pipeline_id"), Record.PipelineId);
+	Root->SetNumberField(TEXT("recorded_actor_count"), Record.Actors.Num());
+	Root->SetNumberField(TEXT("destroyed_actor_count"), Destroyed);
+	Root->SetNumberField(TEXT("remaining_records"), GPipelineUndoRecords.Num());
 	return ToJson(Root);
 #else
 	return ErrorJson(TEXT("WITH_EDITOR required."));
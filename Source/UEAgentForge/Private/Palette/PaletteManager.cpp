@@ -1,18 +1,115 @@
 // Copyright UEAgentForge Project. All Rights Reserved.
-// PaletteManager.cpp - palette discovery and JSON loading.
+// PaletteManager.cpp - palette discovery, timestamp-keyed JSON cache and asset preloading.
 
 #include "Palette/PaletteManager.h"
 
 #include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
 #include "HAL/FileManager.h"
 #include "Interfaces/IPluginManager.h"
 #include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
 #include "Misc/Paths.h"
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
 
 namespace
 {
+	struct FCachedPaletteFile
+	{
+		FDateTime ModificationTime;
+		int64 FileSize = -1;
+		TSharedPtr<FJsonObject> Palette;   // null when the file did not parse
+		FString Error;
+		TSharedPtr<FStreamableHandle> Preload;
+	};
+
+	struct FPaletteCache
+	{
+		TMap<FString, FCachedPaletteFile> Files;   // by absolute path
+		int64 Hits = 0;
+		int64 Parses = 0;
+		int64 ParseErrors = 0;
+		int64 Preloads = 0;
+		int64 PreloadAssets = 0;
+	};
+
+	static FPaletteCache& GetPaletteCache()
+	{
+		static FPaletteCache Cache;
+		return Cache;
+	}
+
+	/** The cache entry for Path, re-parsed when the file's timestamp or size changed; null when unreadable. */
+	static FCachedPaletteFile* FindOrParsePaletteFile(const FString& AbsoluteFilePath)
+	{
+		check(IsInGameThread());
+		FPaletteCache& Cache = GetPaletteCache();
+
+		const FFileStatData Stat = IFileManager::Get().GetStatData(*AbsoluteFilePath);
+		if (!Stat.bIsValid || Stat.bIsDirectory)
+		{
+			Cache.Files.Remove(AbsoluteFilePath);
+			return nullptr;
+		}
+
+		FCachedPaletteFile& Entry = Cache.Files.FindOrAdd(AbsoluteFilePath);
+		if (Entry.FileSize == Stat.FileSize && Entry.ModificationTime == Stat.ModificationTime)
+		{
+			++Cache.Hits;
+			return &Entry;
+		}
+
+		// New or changed file: drop the old parse and release its preloaded assets.
+		Entry = FCachedPaletteFile();
+		Entry.ModificationTime = Stat.ModificationTime;
+		Entry.FileSize = Stat.FileSize;
+		++Cache.Parses;
+
+		FString Text;
+		if (!FFileHelper::LoadFileToString(Text, *AbsoluteFilePath))
+		{
+			Cache.Files.Remove(AbsoluteFilePath);
+			return nullptr;
+		}
+
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Text);
+		if (!FJsonSerializer::Deserialize(Reader, Entry.Palette) || !Entry.Palette.IsValid())
+		{
+			Entry.Palette.Reset();
+			Entry.Error = FString::Printf(TEXT("Invalid palette JSON: %s"), *AbsoluteFilePath);
+			++Cache.ParseErrors;
+		}
+		return &Entry;
+	}
+
+	static void StartPalettePreload(FCachedPaletteFile& Entry)
+	{
+		if (Entry.Preload.IsValid() || !Entry.Palette.IsValid() || !UAssetManager::IsInitialized())
+		{
+			return;
+		}
+
+		TArray<FSoftObjectPath> Assets;
+		FPaletteManager::GetReferencedAssets(Entry.Palette, Assets);
+		if (Assets.Num() == 0)
+		{
+			return;
+		}
+
+		FPaletteCache& Cache = GetPaletteCache();
+		++Cache.Preloads;
+		Cache.PreloadAssets += Assets.Num();
+		Entry.Preload = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+			MoveTemp(Assets),
+			FStreamableDelegate(),
+			FStreamableManager::AsyncLoadHighPriority,
+			/*bManageActiveHandle*/ false,
+			/*bStartStalled*/ false,
+			TEXT("AgentForgePalettePreload"));
+	}
 	static TArray<FString> GetPaletteDirectoriesInternal()
 	{
 		TArray<FString> Directories;
@@ -68,7 +165,8 @@ TArray<FString> FPaletteManager::ListAvailablePalettes()
 bool FPaletteManager::LoadPaletteById(
 	const FString& PaletteId,
 	TSharedPtr<FJsonObject>& OutPalette,
-	FString& OutError)
+	FString& OutError,
+	bool bPreloadAssets)
 {
 	OutPalette.Reset();
 	OutError.Empty();
@@ -86,22 +184,25 @@ bool FPaletteManager::LoadPaletteById(
 		IFileManager::Get().FindFiles(Files, *(PaletteDir / TEXT("*.json")), true, false);
 		for (const FString& FileName : Files)
 		{
-			TSharedPtr<FJsonObject> Candidate;
-			FString FileError;
-			if (!LoadPaletteFromFile(PaletteDir / FileName, Candidate, FileError) || !Candidate.IsValid())
+			FCachedPaletteFile* Entry = FindOrParsePaletteFile(PaletteDir / FileName);
+			if (!Entry || !Entry->Palette.IsValid())
 			{
 				continue;
 			}
 
 			FString CandidateId;
-			if (!Candidate->TryGetStringField(TEXT("palette_id"), CandidateId))
+			if (!Entry->Palette->TryGetStringField(TEXT("palette_id"), CandidateId))
 			{
 				continue;
 			}
 
 			if (CandidateId.Equals(Wanted, ESearchCase::IgnoreCase))
 			{
-				OutPalette = Candidate;
+				if (bPreloadAssets)
+				{
+					StartPalettePreload(*Entry);
+				}
+				OutPalette = Entry->Palette;
 				return true;
 			}
 		}
@@ -119,19 +220,83 @@ bool FPaletteManager::LoadPaletteFromFile(
 	OutPalette.Reset();
 	OutError.Empty();
 
-	FString Text;
-	if (!FFileHelper::LoadFileToString(Text, *AbsoluteFilePath))
+	const FCachedPaletteFile* Entry = FindOrParsePaletteFile(AbsoluteFilePath);
+	if (!Entry)
 	{
 		OutError = FString::Printf(TEXT("Unable to read palette file: %s"), *AbsoluteFilePath);
 		return false;
 	}
-
-	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Text);
-	if (!FJsonSerializer::Deserialize(Reader, OutPalette) || !OutPalette.IsValid())
+	if (!Entry->Palette.IsValid())
 	{
-		OutError = FString::Printf(TEXT("Invalid palette JSON: %s"), *AbsoluteFilePath);
+		OutError = Entry->Error;
 		return false;
 	}
 
+	OutPalette = Entry->Palette;
 	return true;
 }
+
+bool FPaletteManager::IsMetadataField(const FString& FieldName)
+{
+	return FieldName == TEXT("palette_id") || FieldName == TEXT("scale_range") || FieldName == TEXT("biomes")
+		|| FieldName == TEXT("name") || FieldName == TEXT("description");
+}
+
+FString FPaletteManager::ToObjectPath(const FString& AssetPath)
+{
+	return AssetPath.Contains(TEXT(".")) ? AssetPath : FString::Printf(TEXT("%s.%s"), *AssetPath, *FPackageName::GetShortName(AssetPath));
+}
+
+void FPaletteManager::GetReferencedAssets(const TSharedPtr<FJsonObject>& Palette, TArray<FSoftObjectPath>& OutAssets)
+{
+	OutAssets.Reset();
+	if (!Palette.IsValid())
+	{
+		return;
+	}
+
+	for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Palette->Values)
+	{
+		const TArray<TSharedPtr<FJsonValue>>* Paths = nullptr;
+		if (IsMetadataField(Field.Key) || !Field.Value.IsValid() || !Field.Value->TryGetArray(Paths))
+		{
+			continue;
+		}
+		for (const TSharedPtr<FJsonValue>& PathValue : *Paths)
+		{
+			FString Path;
+			if (PathValue.IsValid() && PathValue->TryGetString(Path) && Path.StartsWith(TEXT("/")))
+			{
+				const FSoftObjectPath Asset(ToObjectPath(Path));
+				if (Asset.IsValid())
+				{
+					OutAssets.AddUnique(Asset);
+				}
+			}
+		}
+	}
+}
+
+TSharedPtr<FJsonObject> FPaletteManager::GetStatsJson()
+{
+	const FPaletteCache& Cache = GetPaletteCache();
+	int32 Pending = 0;
+	for (const TPair<FString, FCachedPaletteFile>& Pair : Cache.Files)
+	{
+		const TSharedPtr<FStreamableHandle>& Handle = Pair.Value.Preload;
+		if (Handle.IsValid() && Handle->IsLoadingInProgress())
+		{
+			++Pending;
+		}
+	}
+
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetNumberField(TEXT("files"),            Cache.Files.Num());
+	Obj->SetNumberField(TEXT("hits"),             static_cast<double>(Cache.Hits));
+	Obj->SetNumberField(TEXT("parses"),           static_cast<double>(Cache.Parses));
+	Obj->SetNumberField(TEXT("parse_errors"),     static_cast<double>(Cache.ParseErrors));
+	Obj->SetNumberField(TEXT("preloads"),         static_cast<double>(Cache.Preloads));
+	Obj->SetNumberField(TEXT("preload_assets"),   static_cast<double>(Cache.PreloadAssets));
+	Obj->SetNumberField(TEXT("preloads_pending"), Pending);
+	return Obj;
+}
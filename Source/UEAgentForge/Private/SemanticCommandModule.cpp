@@ -1,6 +1,9 @@
 // Copyright UEAgentForge Project. All Rights Reserved.
 
 #include "SemanticCommandModule.h"
+#include "AgentForgeActorIndex.h"
+#include "AgentForgeLightGrid.h"
+#include "AgentForgeSurfaceTrace.h"
 #include "Dom/JsonObject.h"
 #include "Dom/JsonValue.h"
 #include "Serialization/JsonSerializer.h"
@@ -100,15 +103,7 @@ FString FSemanticCommandModule::PlaceAssetThematically(const TSharedPtr<FJsonObj
 	else
 	{
 		// Default: use level bounding box centre.
-		FBox LevelBox(EForceInit::ForceInit);
-		for (TActorIterator<AActor> It(World); It; ++It)
-		{
-			if (!(*It)->IsA<AWorldSettings>())
-			{
-				FVector O, E; (*It)->GetActorBounds(false, O, E);
-				LevelBox += FBox(O - E, O + E);
-			}
-		}
+		const FBox LevelBox = FAgentForgeActorIndex::Get().GetLevelBounds();
 		if (LevelBox.IsValid) { AreaCentre = LevelBox.GetCenter(); }
 	}
 
@@ -119,16 +114,29 @@ FString FSemanticCommandModule::PlaceAssetThematically(const TSharedPtr<FJsonObj
 	// Generate candidate positions.
 	TArray<FVector> Candidates = FindDarkCorners(World, AreaCentre, AreaRadius, Count * 10);
 
-	// Score each candidate.
-	TArray<TPair<float, FVector>> Scored;
-	for (const FVector& Pos : Candidates)
+	// Score each candidate: darkness from the light grid, occlusion and floor snap in trace batches.
+	TArray<float> Darkness;
+	TArray<bool>  Occluded;
+	if (bPreferDark)     { EstimateDarkness(World, Candidates, Darkness); }
+	if (bPreferOccluded) { TraceOcclusion(World, Candidates, AreaCentre, Occluded); }
+
+	FSurfaceTraceSettings SnapSettings;
+	SnapSettings.UpExtent   = 200.f;
+	SnapSettings.DownExtent = 2000.f;
+	SnapSettings.Channel    = ECC_WorldStatic;
+	TArray<FSurfaceSample> Snapped;
+	FAgentForgeSurfaceTrace::Get().TraceDown(World, Candidates, SnapSettings, FCollisionQueryParams(), Snapped);
+
+	// (score, candidate index)
+	TArray<TPair<float, int32>> Scored;
+	for (int32 Idx = 0; Idx < Candidates.Num(); ++Idx)
 	{
 		float Score = 0.f;
-		if (bPreferDark)     { Score += EstimateDarknessAt(World, Pos, 1000.f); }
-		if (bPreferOccluded) { Score += IsOccluded(World, Pos, AreaCentre) ? 30.f : 0.f; }
-		Scored.Add({ Score, Pos });
+		if (bPreferDark)     { Score += Darkness[Idx]; }
+		if (bPreferOccluded) { Score += Occluded[Idx] ? 30.f : 0.f; }
+		Scored.Add({ Score, Idx });
 	}
-	Scored.Sort([](const TPair<float,FVector>& A, const TPair<float,FVector>& B)
+	Scored.StableSort([](const TPair<float,int32>& A, const TPair<float,int32>& B)
 		{ return A.Key > B.Key; });
 
 	// Spawn at top-scoring positions, enforcing min spacing.
@@ -139,11 +147,11 @@ FString FSemanticCommandModule::PlaceAssetThematically(const TSharedPtr<FJsonObj
 	FString Reasoning;
 	int32 PlacedCount = 0;
 
-	for (const TPair<float,FVector>& Candidate : Scored)
+	for (const TPair<float,int32>& Candidate : Scored)
 	{
 		if (PlacedCount >= Count) { break; }
 
-		const FVector& CandPos = Candidate.Value;
+		const FVector& CandPos = Candidates[Candidate.Value];
 
 		// Enforce spacing.
 		bool bTooClose = false;
@@ -153,16 +161,9 @@ FString FSemanticCommandModule::PlaceAssetThematically(const TSharedPtr<FJsonObj
 		}
 		if (bTooClose) { continue; }
 
-		// Snap to surface via downward trace.
-		FHitResult Hit;
-		FCollisionQueryParams Params;
-		FVector TraceStart = CandPos + FVector(0, 0, 200.f);
-		FVector TraceEnd   = CandPos - FVector(0, 0, 2000.f);
-		FVector SpawnLoc   = CandPos;
-		if (World->LineTraceSingleByChannel(Hit, TraceStart, TraceEnd, ECC_WorldStatic, Params))
-		{
-			SpawnLoc = Hit.ImpactPoint;
-		}
+		// Snap to surface (traced with the batch above).
+		const FSurfaceSample& Surface = Snapped[Candidate.Value];
+		const FVector SpawnLoc = Surface.bHit ? Surface.Location : CandPos;
 
 		FActorSpawnParameters SpawnParams;
 		SpawnParams.SpawnCollisionHandlingOverride =
@@ -243,14 +244,9 @@ FString FSemanticCommandModule::RefineLevelSection(const TSharedPtr<FJsonObject>
 		++IterationsRun;
 
 		// Count static mesh actors in area.
-		int32 InAreaCount = 0;
-		for (TActorIterator<AStaticMeshActor> It(World); It; ++It)
-		{
-			if (FVector::Dist((*It)->GetActorLocation(), AreaCentre) < AreaRadius)
-			{
-				++InAreaCount;
-			}
-		}
+		TArray<TPair<float, AActor*>> InArea;
+		FAgentForgeActorIndex::Get().QueryRadius(AreaCentre, AreaRadius, InArea, AStaticMeshActor::StaticClass());
+		const int32 InAreaCount = InArea.Num();
 		const float AreaM2  = PI * (AreaRadius / 100.f) * (AreaRadius / 100.f);
 		FinalDensity        = InAreaCount / FMath::Max(AreaM2, 1.f);
 
@@ -362,6 +358,7 @@ FString FSemanticCommandModule::ApplyGenreRules(const TSharedPtr<FJsonObject>& A
 			++LightsModified;
 		}
 	}
+	if (LightsModified > 0) { FAgentForgeLightGrid::Get().Invalidate(); }
 	Changes.Add(MakeShared<FJsonValueString>(
 		FString::Printf(TEXT("Modified %d point/spot lights (x%.2f intensity)"),
 		                LightsModified, LightMult)));
@@ -450,13 +447,13 @@ FString FSemanticCommandModule::CreateInEditorAsset(const TSharedPtr<FJsonObject
 TArray<FVector> FSemanticCommandModule::FindDarkCorners(UWorld* World, const FVector& Centre,
                                                          float Radius, int32 MaxCandidates)
 {
-	TArray<FVector> Candidates;
+	TArray<FVector> GridPoints;
 	const int32 GridSteps = FMath::CeilToInt(FMath::Sqrt((float)MaxCandidates));
 	const float Step      = (Radius * 2.f) / GridSteps;
 
-	for (int32 IX = 0; IX < GridSteps && Candidates.Num() < MaxCandidates; ++IX)
+	for (int32 IX = 0; IX < GridSteps; ++IX)
 	{
-		for (int32 IY = 0; IY < GridSteps && Candidates.Num() < MaxCandidates; ++IY)
+		for (int32 IY = 0; IY < GridSteps; ++IY)
 		{
 			const float X = Centre.X - Radius + IX * Step + Step * 0.5f;
 			const float Y = Centre.Y - Radius + IY * Step + Step * 0.5f;
@@ -464,49 +461,56 @@ TArray<FVector> FSemanticCommandModule::FindDarkCorners(UWorld* World, const FVe
 
 			// Only include if within radius.
 			if (FVector::Dist2D(Candidate, Centre) > Radius) { continue; }
-
-			// Snap to floor.
-			FHitResult Hit;
-			FCollisionQueryParams Params;
-			if (World->LineTraceSingleByChannel(Hit,
-				Candidate + FVector(0, 0, 500.f),
-				Candidate - FVector(0, 0, 2000.f),
-				ECC_WorldStatic, Params))
-			{
-				Candidates.Add(Hit.ImpactPoint + FVector(0, 0, 5.f));
-			}
+			GridPoints.Add(Candidate);
 		}
 	}
+
+	// Snap to floor, all points in one batch.
+	FSurfaceTraceSettings Settings;
+	Settings.UpExtent   = 500.f;
+	Settings.DownExtent = 2000.f;
+	Settings.Channel    = ECC_WorldStatic;
+	TArray<FSurfaceSample> Floor;
+	FAgentForgeSurfaceTrace::Get().TraceDown(World, GridPoints, Settings, FCollisionQueryParams(), Floor);
+
+	TArray<FVector> Candidates;
+	for (const FSurfaceSample& Sample : Floor)
+	{
+		if (Candidates.Num() >= MaxCandidates) { break; }
+		if (Sample.bHit) { Candidates.Add(Sample.Location + FVector(0, 0, 5.f)); }
+	}
 	return Candidates;
 }
 
-bool FSemanticCommandModule::IsOccluded(UWorld* World, const FVector& Position,
-                                         const FVector& LevelCentre)
+void FSemanticCommandModule::TraceOcclusion(UWorld* World, TArrayView<const FVector> Positions,
+                                             const FVector& LevelCentre, TArray<bool>& OutOccluded)
 {
-	FHitResult Hit;
-	FCollisionQueryParams Params;
-	const bool bHit = World->LineTraceSingleByChannel(
-		Hit, Position + FVector(0, 0, 60.f), LevelCentre, ECC_Visibility, Params);
-	return bHit; // hit = occluded (something blocks LoS to centre)
+	TArray<FVector> Starts, Ends;
+	Starts.Reserve(Positions.Num());
+	for (const FVector& Position : Positions)
+	{
+		Starts.Add(Position + FVector(0, 0, 60.f));
+	}
+	Ends.Init(LevelCentre, Positions.Num());
+
+	TArray<FSurfaceSample> Hits;
+	FAgentForgeSurfaceTrace::Get().TraceSegments(World, Starts, Ends, ECC_Visibility, FCollisionQueryParams(), Hits);
+
+	OutOccluded.SetNumUninitialized(Hits.Num());
+	for (int32 Index = 0; Index < Hits.Num(); ++Index)
+	{
+		OutOccluded[Index] = Hits[Index].bHit; // hit = occluded (something blocks LoS to centre)
+	}
 }
 
-float FSemanticCommandModule::EstimateDarknessAt(UWorld* World, const FVector& Position,
-                                                   float SearchRadius)
+void FSemanticCommandModule::EstimateDarkness(UWorld* World, TArrayView<const FVector> Positions,
+                                               TArray<float>& OutScores)
 {
-	// Sum all nearby point light contributions. Lower total = darker = higher score.
-	float TotalInfluence = 0.f;
-	for (TActorIterator<ALight> It(World); It; ++It)
+	// Summed point/spot light contributions. Lower total = darker = higher score.
+	FAgentForgeLightGrid::Get().Sample(World, Positions, OutScores);
+	for (float& Score : OutScores)
 	{
-		if ((*It)->IsA<ADirectionalLight>() || (*It)->IsA<ASkyLight>()) { continue; }
-		if (ULightComponent* LC = (*It)->GetLightComponent())
-		{
-			const float Dist = FVector::Dist((*It)->GetActorLocation(), Position);
-			if (Dist < SearchRadius)
-			{
-				TotalInfluence += LC->Intensity * (1.f - Dist / SearchRadius);
-			}
-		}
+		// Convert to a 0-100 darkness score (high = dark).
+		Score = FMath::Clamp(100.f - Score * 0.005f, 0.f, 100.f);
 	}
-	// Convert to a 0-100 darkness score (high = dark).
-	return FMath::Clamp(100.f - TotalInfluence * 0.005f, 0.f, 100.f);
 }
@@ -2,6 +2,11 @@
 // Precise surface-aware 3D placement and spatial analysis for AI agents.
 
 #include "SpatialControlModule.h"
+#include "AgentForgeActorIndex.h"
+#include "AgentForgeActorQuery.h"
+#include "AgentForgeResponseWriter.h"
+#include "AgentForgeSurfaceTrace.h"
+#include "AgentForgeWorldStats.h"
 #include "Dom/JsonObject.h"
 #include "Dom/JsonValue.h"
 #include "Serialization/JsonWriter.h"
@@ -100,18 +105,6 @@ static void MarkActorTransactionalSC(AActor* Actor)
 	}
 }
 
-/** Line-trace downward from Loc+Extent, return true + HitResult on hit. */
-static bool TraceDown(UWorld* World, FVector Loc, float DownExtent, FHitResult& OutHit)
-{
-	FCollisionQueryParams Params(NAME_None, /*bTraceComplex=*/true);
-	return World->LineTraceSingleByChannel(
-		OutHit,
-		Loc + FVector(0.f, 0.f, DownExtent * 0.5f),
-		Loc - FVector(0.f, 0.f, DownExtent),
-		ECC_WorldStatic,
-		Params);
-}
-
 #endif // WITH_EDITOR
 
 // ============================================================================
@@ -246,22 +239,38 @@ FString FSpatialControlModule::AlignActorsToSurface(const TSharedPtr<FJsonObject
 	UWorld* World = GetEditorWorld();
 	if (!World) return SpatialError(TEXT("No editor world."));
 
+	// Resolve every label first, then trace all found actors in one batch.
+	TArray<FString> Labels;
+	TArray<AActor*> Actors;
+	TArray<FVector> Queries;
+	for (const TSharedPtr<FJsonValue>& LabelVal : *LabelsArr)
+	{
+		AActor* Found = FAgentForgeActorIndex::Get().FindByLabel(LabelVal->AsString());
+		Labels.Add(LabelVal->AsString());
+		Actors.Add(Found);
+		if (Found)
+		{
+			Queries.Add(Found->GetActorLocation());
+		}
+	}
+
+	FSurfaceTraceSettings Settings;
+	Settings.UpExtent = DownExtent * 0.5f;
+	Settings.DownExtent = DownExtent;
+	Settings.Channel = ECC_WorldStatic;
+	TArray<FSurfaceSample> Surface;
+	FAgentForgeSurfaceTrace::Get().TraceDown(World, Queries, Settings, FCollisionQueryParams(NAME_None, /*bTraceComplex=*/true), Surface);
+
 	TArray<TSharedPtr<FJsonValue>> Results;
 	int32 AlignedCount = 0;
+	int32 QueryIndex = 0;
 
-	for (const TSharedPtr<FJsonValue>& LabelVal : *LabelsArr)
+	for (int32 Index = 0; Index < Labels.Num(); ++Index)
 	{
-		FString Label = LabelVal->AsString();
 		TSharedPtr<FJsonObject> Entry = MakeShared<FJsonObject>();
-		Entry->SetStringField(TEXT("label"), Label);
-
-		// Find actor by label
-		AActor* Found = nullptr;
-		for (TActorIterator<AActor> It(World); It; ++It)
-		{
-			if ((*It)->GetActorLabel() == Label) { Found = *It; break; }
-		}
+		Entry->SetStringField(TEXT("label"), Labels[Index]);
 
+		AActor* Found = Actors[Index];
 		if (!Found)
 		{
 			Entry->SetBoolField  (TEXT("ok"),    false);
@@ -271,11 +280,11 @@ FString FSpatialControlModule::AlignActorsToSurface(const TSharedPtr<FJsonObject
 		}
 
 		const float OldZ = Found->GetActorLocation().Z;
-		FHitResult Hit;
-		if (TraceDown(World, Found->GetActorLocation(), DownExtent, Hit))
+		const FSurfaceSample& Sample = Surface[QueryIndex++];
+		if (Sample.bHit)
 		{
 			FVector NewLoc = Found->GetActorLocation();
-			NewLoc.Z = Hit.ImpactPoint.Z;
+			NewLoc.Z = Sample.Location.Z;
 			Found->SetActorLocation(NewLoc);
 			++AlignedCount;
 
@@ -351,35 +360,14 @@ FString FSpatialControlModule::AnalyzeLevelComposition()
 	UWorld* World = GetEditorWorld();
 	if (!World) return SpatialError(TEXT("No editor world."));
 
-	int32 TotalCount = 0, StaticCount = 0, LightCount = 0, AICount = 0, OtherCount = 0;
-	FBox  WorldBounds(ForceInit);
-
-	for (TActorIterator<AActor> It(World); It; ++It)
-	{
-		AActor* Actor = *It;
-		if (!Actor || !IsValid(Actor)) { continue; }
-
-		++TotalCount;
-
-		const FString ClassName = Actor->GetClass()->GetName();
-		if (ClassName.Contains(TEXT("StaticMesh"))    ||
-		    ClassName.Contains(TEXT("Brush"))          ||
-		    ClassName.Contains(TEXT("Landscape")))     { ++StaticCount; }
-		else if (ClassName.Contains(TEXT("Light"))    ||
-		         ClassName.Contains(TEXT("Sky")))      { ++LightCount; }
-		else if (ClassName.Contains(TEXT("Character"))||
-		         ClassName.Contains(TEXT("AI"))        ||
-		         ClassName.Contains(TEXT("Warden")))   { ++AICount; }
-		else                                           { ++OtherCount; }
-
-		// Expand world bounds
-		FVector Origin, Extent;
-		Actor->GetActorBounds(false, Origin, Extent);
-		if (!Extent.IsNearlyZero())
-		{
-			WorldBounds += FBox::BuildAABB(Origin, Extent);
-		}
-	}
+	// Class buckets and bounds from the shared world stats (actor index cached bounds).
+	const FAgentForgeWorldStats::FStats Stats = FAgentForgeWorldStats::Get().Gather(World);
+	const int32 TotalCount  = Stats.Actors;
+	const int32 StaticCount = Stats.StaticActors;
+	const int32 LightCount  = Stats.LightActors;
+	const int32 AICount     = Stats.AIActors;
+	const int32 OtherCount  = Stats.OtherActors;
+	const FBox  WorldBounds = Stats.Bounds;
 
 	// ── Density score (actors per 10,000 m² horizontal) ──────────────────────
 	const FVector BoundsSize = WorldBounds.IsValid ? WorldBounds.GetSize() : FVector::ZeroVector;
@@ -420,6 +408,55 @@ FString FSpatialControlModule::AnalyzeLevelComposition()
 #endif
 }
 
+// Streams {ok, count, actors[], [total, next_cursor]} for (squared distance, actor)
+// pairs already filtered and sorted by the caller.
+static FString WriteActorListSC(const TSharedPtr<FJsonObject>& Args, const FAgentForgeActorQuery& Query,
+	const TArray<TPair<float, AActor*>>& Found)
+{
+	const int32 Begin = Query.GetBegin();
+	const int32 End   = Query.GetEnd(Found.Num());
+	FAgentForgeResponseWriter Writer(FAgentForgeResponseWriter::EncodingFromArgs(Args), 256 + (End - Begin) * 160);
+	Writer.WriteObjectStart();
+	Writer.WriteValue(TEXT("ok"),    true);
+	Writer.WriteValue(TEXT("count"), FMath::Max(0, End - Begin));
+	Writer.WriteArrayStart(TEXT("actors"));
+	for (int32 Idx = Begin; Idx < End; ++Idx)
+	{
+		const TPair<float, AActor*>& Pair = Found[Idx];
+		Writer.WriteObjectStart();
+		Query.WriteActorFields(Writer, Pair.Value);
+		if (Query.Wants(EAgentForgeActorField::Distance))
+		{
+			Writer.WriteValue(TEXT("distance"), (double)FMath::Sqrt(Pair.Key));
+		}
+		Writer.WriteObjectEnd();
+	}
+	Writer.WriteArrayEnd();
+	Query.WritePaging(Writer, Found.Num());
+	Writer.WriteObjectEnd();
+	return Writer.Finish();
+}
+
+static bool ReadVecSC(const TSharedPtr<FJsonObject>& Args, const TCHAR* Key, FVector& Out)
+{
+	const TSharedPtr<FJsonObject>* Obj = nullptr;
+	if (!Args->TryGetObjectField(Key, Obj) || !Obj || !(*Obj).IsValid()) { return false; }
+	double X = 0.0, Y = 0.0, Z = 0.0;
+	if (!(*Obj)->TryGetNumberField(TEXT("x"), X) ||
+	    !(*Obj)->TryGetNumberField(TEXT("y"), Y) ||
+	    !(*Obj)->TryGetNumberField(TEXT("z"), Z)) { return false; }
+	Out = FVector(X, Y, Z);
+	return true;
+}
+
+// Fields get_actors_in_radius / _in_box / get_nearest_actors can produce.
+static EAgentForgeActorField SupportedListFieldsSC()
+{
+	using EField = EAgentForgeActorField;
+	return EField::Name | EField::Label | EField::Class | EField::ObjectPath | EField::Location | EField::Rotation |
+		EField::Scale | EField::Tags | EField::Bounds | EField::Parent | EField::Visible | EField::Distance;
+}
+
 // ============================================================================
 //  GET_ACTORS_IN_RADIUS
 // ============================================================================
@@ -434,42 +471,128 @@ FString FSpatialControlModule::GetActorsInRadius(const TSharedPtr<FJsonObject>&
 	const float Z      = Args->HasField(TEXT("z"))      ? (float)Args->GetNumberField(TEXT("z"))      : 0.f;
 	const float Radius = Args->HasField(TEXT("radius")) ? (float)Args->GetNumberField(TEXT("radius")) : 1000.f;
 
+	using EField = EAgentForgeActorField;
+	const EField Defaults = EField::Label | EField::Class | EField::Distance | EField::Location;
+	FAgentForgeActorQuery Query;
+	FString QueryError;
+	if (!Query.Parse(Args, SupportedListFieldsSC(), Defaults, QueryError))
+	{
+		return SpatialError(QueryError);
+	}
+
 	const FVector Center(X, Y, Z);
 	UWorld* World = GetEditorWorld();
 	if (!World) return SpatialError(TEXT("No editor world."));
 
-	// Collect actors within radius, sort by distance
+	// Collect actors within radius from the spatial grid, sort by distance
 	TArray<TPair<float, AActor*>> Found;
-	for (TActorIterator<AActor> It(World); It; ++It)
+	FAgentForgeActorIndex::Get().QueryRadius(Center, Radius, Found);
+	Found.RemoveAllSwap([&Query](const TPair<float, AActor*>& Pair) { return !Query.Matches(Pair.Value); }, EAllowShrinking::No);
+	Found.Sort([](const TPair<float,AActor*>& A, const TPair<float,AActor*>& B){
+		return A.Key < B.Key;
+	});
+
+	return WriteActorListSC(Args, Query, Found);
+#else
+	return SpatialError(TEXT("Editor only."));
+#endif
+}
+
+// ============================================================================
+//  GET_ACTORS_IN_BOX
+// ============================================================================
+FString FSpatialControlModule::GetActorsInBox(const TSharedPtr<FJsonObject>& Args)
+{
+#if WITH_EDITOR
+	if (!Args.IsValid())
+		return SpatialError(TEXT("get_actors_in_box: invalid args."));
+
+	FVector Min, Max;
+	if (!ReadVecSC(Args, TEXT("min"), Min) || !ReadVecSC(Args, TEXT("max"), Max))
+		return SpatialError(TEXT("get_actors_in_box: requires min{x,y,z} and max{x,y,z}."));
+
+	using EField = EAgentForgeActorField;
+	const EField Defaults = EField::Label | EField::Class | EField::Location;
+	FAgentForgeActorQuery Query;
+	FString QueryError;
+	if (!Query.Parse(Args, SupportedListFieldsSC(), Defaults, QueryError))
+	{
+		return SpatialError(QueryError);
+	}
+
+	if (!GetEditorWorld()) return SpatialError(TEXT("No editor world."));
+
+	const FBox Box(Min.ComponentMin(Max), Min.ComponentMax(Max));
+	TArray<AActor*> InBox;
+	FAgentForgeActorIndex::Get().QueryBox(Box, InBox);
+
+	// Distance is to the box centre; sorting by it keeps cursor pages stable.
+	const FVector Centre = Box.GetCenter();
+	TArray<TPair<float, AActor*>> Found;
+	Found.Reserve(InBox.Num());
+	for (AActor* Actor : InBox)
 	{
-		AActor* Actor = *It;
-		if (!Actor || !IsValid(Actor)) { continue; }
-		const float Dist = FVector::Dist(Center, Actor->GetActorLocation());
-		if (Dist <= Radius)
+		if (Query.Matches(Actor))
 		{
-			Found.Emplace(Dist, Actor);
+			Found.Emplace(FVector::DistSquared(Centre, Actor->GetActorLocation()), Actor);
 		}
 	}
 	Found.Sort([](const TPair<float,AActor*>& A, const TPair<float,AActor*>& B){
 		return A.Key < B.Key;
 	});
+	return WriteActorListSC(Args, Query, Found);
+#else
+	return SpatialError(TEXT("Editor only."));
+#endif
+}
 
-	TArray<TSharedPtr<FJsonValue>> ResultArr;
-	for (const TPair<float, AActor*>& Pair : Found)
+// ============================================================================
+//  GET_NEAREST_ACTORS
+// ============================================================================
+FString FSpatialControlModule::GetNearestActors(const TSharedPtr<FJsonObject>& Args)
+{
+#if WITH_EDITOR
+	if (!Args.IsValid())
+		return SpatialError(TEXT("get_nearest_actors: invalid args."));
+
+	const float X         = Args->HasField(TEXT("x"))          ? (float)Args->GetNumberField(TEXT("x"))          : 0.f;
+	const float Y         = Args->HasField(TEXT("y"))          ? (float)Args->GetNumberField(TEXT("y"))          : 0.f;
+	const float Z         = Args->HasField(TEXT("z"))          ? (float)Args->GetNumberField(TEXT("z"))          : 0.f;
+	const int32 K         = Args->HasField(TEXT("k"))          ? (int32)Args->GetNumberField(TEXT("k"))          : 8;
+	const float MaxRadius = Args->HasField(TEXT("max_radius")) ? (float)Args->GetNumberField(TEXT("max_radius")) : 0.f;
+	if (K <= 0 || K > 10000)
+		return SpatialError(TEXT("get_nearest_actors: k must be in [1, 10000]."));
+
+	using EField = EAgentForgeActorField;
+	const EField Defaults = EField::Label | EField::Class | EField::Distance | EField::Location;
+	FAgentForgeActorQuery Query;
+	FString QueryError;
+	if (!Query.Parse(Args, SupportedListFieldsSC(), Defaults, QueryError))
 	{
-		TSharedPtr<FJsonObject> Entry = MakeShared<FJsonObject>();
-		Entry->SetStringField(TEXT("label"),    Pair.Value->GetActorLabel());
-		Entry->SetStringField(TEXT("class"),    Pair.Value->GetClass()->GetName());
-		Entry->SetNumberField(TEXT("distance"), Pair.Key);
-		Entry->SetObjectField(TEXT("location"), VecToJsonSC(Pair.Value->GetActorLocation()));
-		ResultArr.Add(MakeShared<FJsonValueObject>(Entry));
+		return SpatialError(QueryError);
 	}
 
-	TSharedPtr<FJsonObject> Resp = MakeShared<FJsonObject>();
-	Resp->SetBoolField  (TEXT("ok"),      true);
-	Resp->SetNumberField(TEXT("count"),   Found.Num());
-	Resp->SetArrayField (TEXT("actors"),  ResultArr);
-	return SpatialJson(Resp);
+	if (!GetEditorWorld()) return SpatialError(TEXT("No editor world."));
+
+	// Unfiltered nearest-K would drop matches hidden behind non-matching
+	// neighbours, so filtered queries grow the search until K matches remain.
+	const FVector Point(X, Y, Z);
+	TArray<TPair<float, AActor*>> Found;
+	for (int32 Want = K; ; Want *= 4)
+	{
+		FAgentForgeActorIndex::Get().QueryNearest(Point, Want, MaxRadius, Found);
+		const int32 Seen = Found.Num();
+		Found.RemoveAll([&Query](const TPair<float, AActor*>& Pair) { return !Query.Matches(Pair.Value); });
+		if (Found.Num() >= K || Seen < Want)
+		{
+			break;
+		}
+	}
+	if (Found.Num() > K)
+	{
+		Found.SetNum(K);
+	}
+	return WriteActorListSC(Args, Query, Found);
 #else
 	return SpatialError(TEXT("Editor only."));
 #endif
@@ -1,3 +1,367 @@
 // Copyright UEAgentForge Project. All Rights Reserved.
-// ErosionFilter.cpp - reserved for hydraulic/thermal erosion kernels.
+// ErosionFilter.cpp - tiled, deterministic droplet hydraulic erosion.
 
+#include "Terrain/ErosionFilter.h"
+
+#include "Async/ParallelFor.h"
+#include "Math/RandomStream.h"
+
+namespace
+{
+	struct FBrushTap
+	{
+		int32 DX = 0;
+		int32 DY = 0;
+		float Weight = 0.0f;
+	};
+
+	struct FErosionTile
+	{
+		int32 CoreX0 = 0, CoreY0 = 0, CoreX1 = 0, CoreY1 = 0;   // droplets spawn here
+		int32 X0 = 0, Y0 = 0, X1 = 0, Y1 = 0;                   // core + margin, clamped to the map
+		int64 Droplets = 0;
+
+		int32 RegionWidth() const { return X1 - X0; }
+		int32 RegionArea() const  { return (X1 - X0) * (Y1 - Y0); }
+	};
+
+	/** Weights fall off linearly from the centre and sum to 1. */
+	static void BuildBrush(int32 Radius, TArray<FBrushTap>& OutBrush)
+	{
+		OutBrush.Reset();
+		float WeightSum = 0.0f;
+		for (int32 DY = -Radius; DY <= Radius; ++DY)
+		{
+			for (int32 DX = -Radius; DX <= Radius; ++DX)
+			{
+				const float Distance = FMath::Sqrt((float)(DX * DX + DY * DY));
+				if (Distance < (float)Radius)
+				{
+					FBrushTap& Tap = OutBrush.AddDefaulted_GetRef();
+					Tap.DX = DX;
+					Tap.DY = DY;
+					Tap.Weight = 1.0f - Distance / (float)Radius;
+					WeightSum += Tap.Weight;
+				}
+			}
+		}
+		for (FBrushTap& Tap : OutBrush)
+		{
+			Tap.Weight /= WeightSum;
+		}
+	}
+
+	/** One tile's droplets for one round. Reads the shared map, writes only its own buffer. */
+	class FTileDroplets
+	{
+	public:
+		FTileDroplets(
+			const float* InMap,
+			int32 InMapWidth,
+			const FErosionTile& InTile,
+			float* InLocal,
+			const FHydraulicErosionSettings& InSettings,
+			const TArray<FBrushTap>& InBrush)
+			: Map(InMap)
+			, MapWidth(InMapWidth)
+			, Tile(InTile)
+			, Local(InLocal)
+			, Settings(InSettings)
+			, Brush(InBrush)
+		{
+		}
+
+		void Run(FRandomStream& Rng, int64 Count)
+		{
+			// Bilinear sampling reads X + 1 / Y + 1, so spawn strictly inside the last texel.
+			const float SpawnX0 = (float)Tile.CoreX0;
+			const float SpawnY0 = (float)Tile.CoreY0;
+			const float SpawnX1 = (float)FMath::Min(Tile.CoreX1, Tile.X1 - 1);
+			const float SpawnY1 = (float)FMath::Min(Tile.CoreY1, Tile.Y1 - 1);
+			if (SpawnX1 <= SpawnX0 || SpawnY1 <= SpawnY0)
+			{
+				return;   // one-texel sliver at the map edge
+			}
+			for (int64 Index = 0; Index < Count; ++Index)
+			{
+				const float X = FMath::Min(SpawnX0 + Rng.GetFraction() * (SpawnX1 - SpawnX0), SpawnX1 - 0.001f);
+				const float Y = FMath::Min(SpawnY0 + Rng.GetFraction() * (SpawnY1 - SpawnY0), SpawnY1 - 0.001f);
+				SimulateDroplet(X, Y);
+			}
+		}
+
+	private:
+		FORCEINLINE int32 LocalIndex(int32 X, int32 Y) const
+		{
+			return (Y - Tile.Y0) * Tile.RegionWidth() + (X - Tile.X0);
+		}
+
+		FORCEINLINE float HeightAt(int32 X, int32 Y) const
+		{
+			return Map[Y * MapWidth + X] + Local[LocalIndex(X, Y)];
+		}
+
+		FORCEINLINE bool IsInside(float X, float Y) const
+		{
+			return X >= (float)Tile.X0 && Y >= (float)Tile.Y0 && X < (float)(Tile.X1 - 1) && Y < (float)(Tile.Y1 - 1);
+		}
+
+		void HeightAndGradient(float X, float Y, float& OutHeight, float& OutGradX, float& OutGradY) const
+		{
+			const int32 IX = (int32)X;
+			const int32 IY = (int32)Y;
+			const float U = X - (float)IX;
+			const float V = Y - (float)IY;
+			const float H00 = HeightAt(IX, IY);
+			const float H10 = HeightAt(IX + 1, IY);
+			const float H01 = HeightAt(IX, IY + 1);
+			const float H11 = HeightAt(IX + 1, IY + 1);
+			OutGradX = (H10 - H00) * (1.0f - V) + (H11 - H01) * V;
+			OutGradY = (H01 - H00) * (1.0f - U) + (H11 - H10) * U;
+			OutHeight = H00 * (1.0f - U) * (1.0f - V) + H10 * U * (1.0f - V) + H01 * (1.0f - U) * V + H11 * U * V;
+		}
+
+		void Deposit(int32 IX, int32 IY, float U, float V, float Amount)
+		{
+			Local[LocalIndex(IX, IY)]         += Amount * (1.0f - U) * (1.0f - V);
+			Local[LocalIndex(IX + 1, IY)]     += Amount * U * (1.0f - V);
+			Local[LocalIndex(IX, IY + 1)]     += Amount * (1.0f - U) * V;
+			Local[LocalIndex(IX + 1, IY + 1)] += Amount * U * V;
+		}
+
+		void Erode(int32 IX, int32 IY, float Amount)
+		{
+			const int32 Radius = Settings.BrushRadius;
+			const bool bClipped =
+				IX - Radius < Tile.X0 || IY - Radius < Tile.Y0 || IX + Radius >= Tile.X1 || IY + Radius >= Tile.Y1;
+			float Scale = 1.0f;
+			if (bClipped)
+			{
+				// Renormalize over the taps that land inside the region so the droplet's sediment balances.
+				float InsideWeight = 0.0f;
+				for (const FBrushTap& Tap : Brush)
+				{
+					const int32 X = IX + Tap.DX;
+					const int32 Y = IY + Tap.DY;
+					if (X >= Tile.X0 && Y >= Tile.Y0 && X < Tile.X1 && Y < Tile.Y1)
+					{
+						InsideWeight += Tap.Weight;
+					}
+				}
+				Scale = InsideWeight > KINDA_SMALL_NUMBER ? 1.0f / InsideWeight : 0.0f;
+			}
+			for (const FBrushTap& Tap : Brush)
+			{
+				const int32 X = IX + Tap.DX;
+				const int32 Y = IY + Tap.DY;
+				if (!bClipped || (X >= Tile.X0 && Y >= Tile.Y0 && X < Tile.X1 && Y < Tile.Y1))
+				{
+					Local[LocalIndex(X, Y)] -= Amount * Tap.Weight * Scale;
+				}
+			}
+		}
+
+		void SimulateDroplet(float X, float Y)
+		{
+			float DirX = 0.0f;
+			float DirY = 0.0f;
+			float Speed = Settings.InitialSpeed;
+			float Water = Settings.InitialWater;
+			float Sediment = 0.0f;
+
+			for (int32 Step = 0; Step < Settings.MaxLifetime; ++Step)
+			{
+				const int32 IX = (int32)X;
+				const int32 IY = (int32)Y;
+				const float U = X - (float)IX;
+				const float V = Y - (float)IY;
+
+				float CurrentHeight = 0.0f, GradX = 0.0f, GradY = 0.0f;
+				HeightAndGradient(X, Y, CurrentHeight, GradX, GradY);
+
+				DirX = DirX * Settings.Inertia - GradX * (1.0f - Settings.Inertia);
+				DirY = DirY * Settings.Inertia - GradY * (1.0f - Settings.Inertia);
+				const float DirLength = FMath::Sqrt(DirX * DirX + DirY * DirY);
+				if (DirLength <= KINDA_SMALL_NUMBER)
+				{
+					break;   // flat spot: nowhere to flow
+				}
+				DirX /= DirLength;
+				DirY /= DirLength;
+				X += DirX;
+				Y += DirY;
+				if (!IsInside(X, Y))
+				{
+					break;
+				}
+
+				float NewHeight = 0.0f, UnusedX = 0.0f, UnusedY = 0.0f;
+				HeightAndGradient(X, Y, NewHeight, UnusedX, UnusedY);
+				const float DeltaHeight = NewHeight - CurrentHeight;
+
+				const float Capacity = FMath::Max(
+					-DeltaHeight * Speed * Water * Settings.SedimentCapacityFactor,
+					Settings.MinSedimentCapacity);
+
+				if (Sediment > Capacity || DeltaHeight > 0.0f)
+				{
+					// Uphill: fill the pit behind us. Overloaded: drop part of the excess.
+					const float Amount = DeltaHeight > 0.0f
+						? FMath::Min(DeltaHeight, Sediment)
+						: (Sediment - Capacity) * Settings.DepositSpeed;
+					Sediment -= Amount;
+					Deposit(IX, IY, U, V, Amount);
+				}
+				else
+				{
+					// Never dig deeper than the drop, or the droplet carves its own pit.
+					const float Amount = FMath::Min((Capacity - Sediment) * Settings.ErodeSpeed, -DeltaHeight);
+					Erode(IX, IY, Amount);
+					Sediment += Amount;
+				}
+
+				Speed = FMath::Sqrt(FMath::Max(0.0f, Speed * Speed - DeltaHeight * Settings.Gravity));
+				Water *= (1.0f - Settings.EvaporateSpeed);
+			}
+		}
+
+		const float*                     Map;
+		int32                            MapWidth;
+		const FErosionTile&              Tile;
+		float*                           Local;
+		const FHydraulicErosionSettings& Settings;
+		const TArray<FBrushTap>&         Brush;
+	};
+
+	static int32 TileSeed(int32 Seed, int32 TileIndex, int32 Round)
+	{
+		uint32 H = (uint32)Seed ^ ((uint32)TileIndex * 0x9E3779B1u) ^ ((uint32)Round * 0x85EBCA77u);
+		H ^= H >> 16;
+		H *= 0x7FEB352Du;
+		H ^= H >> 15;
+		return (int32)H;
+	}
+}
+
+FHydraulicErosionSettings FHydraulicErosionSettings::Sanitized() const
+{
+	FHydraulicErosionSettings Out = *this;
+	Out.Droplets               = FMath::Clamp(Droplets, 0, 8000000);
+	Out.Batches                = FMath::Clamp(Batches, 1, 64);
+	Out.MaxLifetime            = FMath::Clamp(MaxLifetime, 1, 128);
+	Out.BrushRadius            = FMath::Clamp(BrushRadius, 1, 8);
+	Out.Inertia                = FMath::Clamp(Inertia, 0.0f, 0.99f);
+	Out.SedimentCapacityFactor = FMath::Max(0.0f, SedimentCapacityFactor);
+	Out.MinSedimentCapacity    = FMath::Max(0.0f, MinSedimentCapacity);
+	Out.ErodeSpeed             = FMath::Clamp(ErodeSpeed, 0.0f, 1.0f);
+	Out.DepositSpeed           = FMath::Clamp(DepositSpeed, 0.0f, 1.0f);
+	Out.EvaporateSpeed         = FMath::Clamp(EvaporateSpeed, 0.0f, 1.0f);
+	Out.Gravity                = FMath::Clamp(Gravity, 0.0f, 100.0f);
+	Out.InitialWater           = FMath::Max(0.0f, InitialWater);
+	Out.InitialSpeed           = FMath::Max(0.0f, InitialSpeed);
+	return Out;
+}
+
+int64 FErosionFilter::ApplyHydraulicErosion(
+	TArray<float>& Heightmap,
+	int32 Width,
+	int32 Height,
+	const FHydraulicErosionSettings& InSettings)
+{
+	if (Heightmap.Num() != Width * Height || Width < 3 || Height < 3)
+	{
+		return 0;
+	}
+
+	const FHydraulicErosionSettings Settings = InSettings.Sanitized();
+	if (Settings.Droplets == 0)
+	{
+		return 0;
+	}
+
+	TArray<FBrushTap> Brush;
+	BuildBrush(Settings.BrushRadius, Brush);
+
+	// Tiles at least twice the margin wide keep same-phase regions disjoint.
+	const int32 Margin = Settings.MaxLifetime + Settings.BrushRadius + 2;
+	const int32 TileSize = FMath::Max(64, Margin * 2);
+	const int32 TilesX = FMath::DivideAndRoundUp(Width, TileSize);
+	const int32 TilesY = FMath::DivideAndRoundUp(Height, TileSize);
+
+	TArray<FErosionTile> Tiles;
+	TArray<int32> Phases[4];
+	Tiles.Reserve(TilesX * TilesY);
+	const int64 MapArea = (int64)Width * Height;
+	int64 CoveredArea = 0;
+	int64 Assigned = 0;
+	for (int32 TY = 0; TY < TilesY; ++TY)
+	{
+		for (int32 TX = 0; TX < TilesX; ++TX)
+		{
+			FErosionTile& Tile = Tiles.AddDefaulted_GetRef();
+			Tile.CoreX0 = TX * TileSize;
+			Tile.CoreY0 = TY * TileSize;
+			Tile.CoreX1 = FMath::Min(Width, Tile.CoreX0 + TileSize);
+			Tile.CoreY1 = FMath::Min(Height, Tile.CoreY0 + TileSize);
+			Tile.X0 = FMath::Max(0, Tile.CoreX0 - Margin);
+			Tile.Y0 = FMath::Max(0, Tile.CoreY0 - Margin);
+			Tile.X1 = FMath::Min(Width, Tile.CoreX1 + Margin);
+			Tile.Y1 = FMath::Min(Height, Tile.CoreY1 + Margin);
+
+			// Droplets in proportion to core area; cumulative rounding makes the shares sum exactly.
+			CoveredArea += (int64)(Tile.CoreX1 - Tile.CoreX0) * (Tile.CoreY1 - Tile.CoreY0);
+			const int64 Target = (int64)Settings.Droplets * CoveredArea / MapArea;
+			Tile.Droplets = Target - Assigned;
+			Assigned = Target;
+
+			Phases[(TX & 1) | ((TY & 1) << 1)].Add(Tiles.Num() - 1);
+		}
+	}
+
+	int32 MaxPhaseTiles = 0;
+	for (const TArray<int32>& Phase : Phases)
+	{
+		MaxPhaseTiles = FMath::Max(MaxPhaseTiles, Phase.Num());
+	}
+	TArray<TArray<float>> Buffers;
+	Buffers.SetNum(MaxPhaseTiles);
+
+	float* Map = Heightmap.GetData();
+	for (int32 Round = 0; Round < Settings.Batches; ++Round)
+	{
+		for (const TArray<int32>& Phase : Phases)
+		{
+			ParallelFor(Phase.Num(), [&](int32 Slot)
+			{
+				const int32 TileIndex = Phase[Slot];
+				const FErosionTile& Tile = Tiles[TileIndex];
+				TArray<float>& Local = Buffers[Slot];
+				Local.SetNumUninitialized(Tile.RegionArea(), EAllowShrinking::No);
+				FMemory::Memzero(Local.GetData(), sizeof(float) * Local.Num());
+
+				const int64 First = Tile.Droplets * Round / Settings.Batches;
+				const int64 Last = Tile.Droplets * (Round + 1) / Settings.Batches;
+				FRandomStream Rng(TileSeed(Settings.Seed, TileIndex, Round));
+				FTileDroplets(Map, Width, Tile, Local.GetData(), Settings, Brush).Run(Rng, Last - First);
+			});
+
+			// Merge in tile order once every tile in the phase has finished reading the map.
+			for (int32 Slot = 0; Slot < Phase.Num(); ++Slot)
+			{
+				const FErosionTile& Tile = Tiles[Phase[Slot]];
+				const float* Local = Buffers[Slot].GetData();
+				const int32 RegionWidth = Tile.RegionWidth();
+				for (int32 Y = Tile.Y0; Y < Tile.Y1; ++Y)
+				{
+					float* Row = Map + (int64)Y * Width + Tile.X0;
+					const float* LocalRow = Local + (int64)(Y - Tile.Y0) * RegionWidth;
+					for (int32 X = 0; X < RegionWidth; ++X)
+					{
+						Row[X] += LocalRow[X];
+					}
+				}
+			}
+		}
+	}
+	return Assigned;
+}
@@ -3,25 +3,159 @@
 
 #include "Terrain/ErosionSim.h"
 
+#include "Async/ParallelFor.h"
+#include "Math/VectorRegister.h"
+
 namespace
 {
+	static constexpr int32 RowsPerBlock = 32;
+	static constexpr int8  NoTarget = -1;
+
+	static const int32 NX[8] = { -1, 0, 1, -1, 1, -1, 0, 1 };
+	static const int32 NY[8] = { -1, -1, -1, 0, 0, 1, 1, 1 };
+
 	static FORCEINLINE int32 CellIndex(const int32 X, const int32 Y, const int32 Width)
 	{
 		return (Y * Width) + X;
 	}
+
+	/**
+	 * Pass 1 for one interior row: each cell's outflow toward its steepest lower
+	 * neighbour. Ties keep the first neighbour in NX / NY order. Returns the row's
+	 * total outflow.
+	 */
+	static double ComputeOutflowRow(
+		const float* Heights,
+		float* Outflow,
+		int8* Target,
+		int32 Width,
+		int32 Y,
+		float Talus,
+		float Transfer)
+	{
+		const float* Rows[3] =
+		{
+			Heights + (int64)(Y - 1) * Width,
+			Heights + (int64)Y * Width,
+			Heights + (int64)(Y + 1) * Width,
+		};
+		float* OutRow = Outflow + (int64)Y * Width;
+		int8* TargetRow = Target + (int64)Y * Width;
+		OutRow[0] = 0.0f;
+		OutRow[Width - 1] = 0.0f;
+		TargetRow[0] = NoTarget;
+		TargetRow[Width - 1] = NoTarget;
+
+		double Moved = 0.0;
+		int32 X = 1;
+
+		// Four cells per step; the eight neighbour reads are unaligned loads at fixed offsets.
+		const VectorRegister4Float TalusV = VectorSetFloat1(Talus);
+		const VectorRegister4Float TransferV = VectorSetFloat1(Transfer);
+		const VectorRegister4Float NoTargetV = VectorSetFloat1((float)NoTarget);
+		for (; X + 4 <= Width - 1; X += 4)
+		{
+			const VectorRegister4Float Center = VectorLoad(Rows[1] + X);
+			VectorRegister4Float MaxDrop = VectorZero();
+			VectorRegister4Float BestDir = NoTargetV;
+			for (int32 N = 0; N < 8; ++N)
+			{
+				const VectorRegister4Float Neighbor = VectorLoad(Rows[1 + NY[N]] + X + NX[N]);
+				const VectorRegister4Float Drop = VectorSubtract(Center, Neighbor);
+				const VectorRegister4Float Steeper = VectorCompareGT(Drop, MaxDrop);
+				MaxDrop = VectorSelect(Steeper, Drop, MaxDrop);
+				BestDir = VectorSelect(Steeper, VectorSetFloat1((float)N), BestDir);
+			}
+			const VectorRegister4Float Moves = VectorCompareGT(MaxDrop, TalusV);
+			const VectorRegister4Float Amount = VectorSelect(Moves, VectorMultiply(VectorSubtract(MaxDrop, TalusV), TransferV), VectorZero());
+			BestDir = VectorSelect(Moves, BestDir, NoTargetV);
+
+			float DirLanes[4];
+			VectorStore(Amount, OutRow + X);
+			VectorStore(BestDir, DirLanes);
+			for (int32 Lane = 0; Lane < 4; ++Lane)
+			{
+				TargetRow[X + Lane] = (int8)DirLanes[Lane];
+				Moved += OutRow[X + Lane];
+			}
+		}
+
+		for (; X < Width - 1; ++X)
+		{
+			const float CenterHeight = Rows[1][X];
+			float MaxDrop = 0.0f;
+			int8 BestDir = NoTarget;
+			for (int32 N = 0; N < 8; ++N)
+			{
+				const float Drop = CenterHeight - Rows[1 + NY[N]][X + NX[N]];
+				if (Drop > MaxDrop)
+				{
+					MaxDrop = Drop;
+					BestDir = (int8)N;
+				}
+			}
+			if (MaxDrop > Talus)
+			{
+				OutRow[X] = (MaxDrop - Talus) * Transfer;
+				TargetRow[X] = BestDir;
+			}
+			else
+			{
+				OutRow[X] = 0.0f;
+				TargetRow[X] = NoTarget;
+			}
+			Moved += OutRow[X];
+		}
+		return Moved;
+	}
+
+	/** Pass 2 for one row: Heights -= outflow, += inflow gathered from neighbours in fixed order. */
+	static void ApplyOutflowRow(
+		float* Heights,
+		const float* Outflow,
+		const int8* Target,
+		int32 Width,
+		int32 Height,
+		int32 Y)
+	{
+		const bool bBorderRow = Y == 0 || Y == Height - 1;
+		for (int32 X = 0; X < Width; ++X)
+		{
+			const int32 Index = CellIndex(X, Y, Width);
+			float Value = Heights[Index] - Outflow[Index];
+			const bool bBorder = bBorderRow || X == 0 || X == Width - 1;
+			for (int32 N = 0; N < 8; ++N)
+			{
+				// The neighbour that would flow into us through direction N sits at -N.
+				const int32 SX = X - NX[N];
+				const int32 SY = Y - NY[N];
+				if (bBorder && (SX < 0 || SY < 0 || SX >= Width || SY >= Height))
+				{
+					continue;
+				}
+				const int32 Source = CellIndex(SX, SY, Width);
+				if (Target[Source] == N)
+				{
+					Value += Outflow[Source];
+				}
+			}
+			Heights[Index] = Value;
+		}
+	}
 }
 
-void FErosionSim::ApplyThermalErosion(
+int32 FErosionSim::ApplyThermalErosion(
 	TArray<float>& Heightmap,
 	int32 Width,
 	int32 Height,
 	int32 Iterations,
 	float TalusThreshold,
-	float SedimentStrength)
+	float SedimentStrength,
+	float ConvergenceThreshold)
 {
 	if (Heightmap.Num() != Width * Height || Width < 3 || Height < 3)
 	{
-		return;
+		return 0;
 	}
 
 	const int32 StepCount = FMath::Clamp(Iterations, 0, 512);
@@ -29,59 +163,67 @@ void FErosionSim::ApplyThermalErosion(
 	const float Strength = FMath::Clamp(SedimentStrength, 0.0f, 1.0f);
 	if (StepCount == 0 || Strength <= KINDA_SMALL_NUMBER)
 	{
-		return;
+		return 0;
 	}
 
-	TArray<float> Delta;
-	Delta.SetNumZeroed(Heightmap.Num());
+	// Two passes per iteration keep the parallel rows race-free: outflow is computed from
+	// the heights alone, then every cell gathers its own inflow. Border cells only receive.
+	TArray<float> Outflow;
+	TArray<int8> Target;
+	Outflow.SetNumZeroed(Heightmap.Num());
+	Target.Init(NoTarget, Heightmap.Num());
 
-	const int32 NX[8] = { -1, 0, 1, -1, 1, -1, 0, 1 };
-	const int32 NY[8] = { -1, -1, -1, 0, 0, 1, 1, 1 };
+	const int32 InteriorRows = Height - 2;
+	const int32 InteriorBlocks = FMath::DivideAndRoundUp(InteriorRows, RowsPerBlock);
+	const int32 AllBlocks = FMath::DivideAndRoundUp(Height, RowsPerBlock);
+	TArray<double> BlockMoved;
+	BlockMoved.SetNumZeroed(InteriorBlocks);
 
+	const float Transfer = 0.5f * Strength;
+	const double StopBelow = (double)FMath::Max(0.0f, ConvergenceThreshold) * (double)Heightmap.Num();
+	float* Heights = Heightmap.GetData();
+
+	int32 IterationsUsed = 0;
 	for (int32 Iteration = 0; Iteration < StepCount; ++Iteration)
 	{
-		FMemory::Memzero(Delta.GetData(), sizeof(float) * Delta.Num());
-
-		for (int32 Y = 1; Y < Height - 1; ++Y)
+		ParallelFor(InteriorBlocks, [&](int32 Block)
 		{
-			for (int32 X = 1; X < Width - 1; ++X)
+			const int32 FirstRow = 1 + Block * RowsPerBlock;
+			const int32 LastRow = FMath::Min(FirstRow + RowsPerBlock, Height - 1);
+			double Moved = 0.0;
+			for (int32 Y = FirstRow; Y < LastRow; ++Y)
 			{
-				const int32 CenterIndex = CellIndex(X, Y, Width);
-				const float CenterHeight = Heightmap[CenterIndex];
-
-				float MaxDrop = 0.0f;
-				int32 TargetX = X;
-				int32 TargetY = Y;
-
-				for (int32 N = 0; N < 8; ++N)
-				{
-					const int32 SX = X + NX[N];
-					const int32 SY = Y + NY[N];
-					const float NeighborHeight = Heightmap[CellIndex(SX, SY, Width)];
-					const float Drop = CenterHeight - NeighborHeight;
-					if (Drop > MaxDrop)
-					{
-						MaxDrop = Drop;
-						TargetX = SX;
-						TargetY = SY;
-					}
-				}
+				Moved += ComputeOutflowRow(Heights, Outflow.GetData(), Target.GetData(), Width, Y, Talus, Transfer);
+			}
+			BlockMoved[Block] = Moved;
+		});
 
-				if (MaxDrop <= Talus)
-				{
-					continue;
-				}
+		// Summed in block order, so the convergence decision is the same on any thread count.
+		double TotalMoved = 0.0;
+		for (const double Moved : BlockMoved)
+		{
+			TotalMoved += Moved;
+		}
+		if (TotalMoved <= 0.0)
+		{
+			break;
+		}
 
-				const float Sediment = (MaxDrop - Talus) * 0.5f * Strength;
-				const int32 TargetIndex = CellIndex(TargetX, TargetY, Width);
-				Delta[CenterIndex] -= Sediment;
-				Delta[TargetIndex] += Sediment;
+		ParallelFor(AllBlocks, [&](int32 Block)
+		{
+			const int32 FirstRow = Block * RowsPerBlock;
+			const int32 LastRow = FMath::Min(FirstRow + RowsPerBlock, Height);
+			for (int32 Y = FirstRow; Y < LastRow; ++Y)
+			{
+				ApplyOutflowRow(Heights, Outflow.GetData(), Target.GetData(), Width, Height, Y);
 			}
-		}
+		});
 
-		for (int32 Index = 0; Index < Heightmap.Num(); ++Index)
+		++IterationsUsed;
+		if (TotalMoved < StopBelow)
 		{
-			Heightmap[Index] += Delta[Index];
+			break;
 		}
 	}
+	return IterationsUsed;
 }
@@ -0,0 +1,474 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// Heightmap.cpp - precision encoding, range queries, mapped R16/R32 I/O.
+
+#include "Terrain/Heightmap.h"
+
+#include "Async/MappedFileHandle.h"
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Math/Float16.h"
+#include "Misc/Paths.h"
+#include "Serialization/Archive.h"
+
+namespace
+{
+	enum class EHeightmapFile : uint8
+	{
+		Unknown,
+		R16,
+		R32,
+	};
+
+	static EHeightmapFile FileKindFor(const FString& Path)
+	{
+		const FString Extension = FPaths::GetExtension(Path).ToLower();
+		if (Extension == TEXT("r16") || Extension == TEXT("raw"))
+		{
+			return EHeightmapFile::R16;
+		}
+		if (Extension == TEXT("r32"))
+		{
+			return EHeightmapFile::R32;
+		}
+		return EHeightmapFile::Unknown;
+	}
+
+	static FORCEINLINE uint16 EncodeHalf(float Value)
+	{
+		return FFloat16(Value).Encoded;
+	}
+
+	static FORCEINLINE float DecodeHalf(uint16 Word)
+	{
+		FFloat16 Half;
+		Half.Encoded = Word;
+		return Half.GetFloat();
+	}
+
+	static FORCEINLINE uint16 EncodeUnorm(float Value, float Scale, float Offset)
+	{
+		const float Alpha = Scale != 0.0f ? (Value - Offset) / Scale : 0.0f;
+		return (uint16)FMath::Clamp(FMath::RoundToInt(Alpha * 65535.0f), 0, 65535);
+	}
+
+	static FORCEINLINE float DecodeUnorm(uint16 Word, float Scale, float Offset)
+	{
+		return Offset + (float)Word * (Scale / 65535.0f);
+	}
+
+	// Rows per ParallelFor task when re-encoding whole maps.
+	static constexpr int32 RowsPerTask = 16;
+
+	template <typename FRowFn>
+	static void ForEachRowBlock(int32 Height, FRowFn&& RowFn)
+	{
+		const int32 NumBlocks = FMath::DivideAndRoundUp(Height, RowsPerTask);
+		ParallelFor(NumBlocks, [&](int32 Block)
+		{
+			const int32 RowEnd = FMath::Min((Block + 1) * RowsPerTask, Height);
+			for (int32 Y = Block * RowsPerTask; Y < RowEnd; ++Y)
+			{
+				RowFn(Y);
+			}
+		});
+	}
+}
+
+FHeightmap::FHeightmap(int32 InWidth, int32 InHeight, EHeightmapPrecision InPrecision)
+	: Width(FMath::Max(InWidth, 0))
+	, Height(FMath::Max(InHeight, 0))
+	, Precision(InPrecision)
+{
+	if (Precision == EHeightmapPrecision::Float32)
+	{
+		Floats.SetNumZeroed(Num());
+	}
+	else
+	{
+		Words.SetNumUninitialized(Num());
+		const uint16 Zero = Precision == EHeightmapPrecision::Float16 ? EncodeHalf(0.0f) : (uint16)0;
+		for (uint16& Word : Words)
+		{
+			Word = Zero;
+		}
+	}
+}
+
+FHeightmap::FHeightmap(TArray<float>&& InValues, int32 InWidth, int32 InHeight)
+	: Width(InWidth)
+	, Height(InHeight)
+	, Floats(MoveTemp(InValues))
+{
+	if (Width <= 0 || Height <= 0 || Floats.Num() != Num())
+	{
+		Reset();
+	}
+}
+
+FHeightmap::FHeightmap(FHeightmap&& Other)
+	: Width(Other.Width)
+	, Height(Other.Height)
+	, Precision(Other.Precision)
+	, Scale(Other.Scale)
+	, Offset(Other.Offset)
+	, Floats(MoveTemp(Other.Floats))
+	, Words(MoveTemp(Other.Words))
+{
+	Other.Reset();
+}
+
+FHeightmap& FHeightmap::operator=(FHeightmap&& Other)
+{
+	if (this != &Other)
+	{
+		Width = Other.Width;
+		Height = Other.Height;
+		Precision = Other.Precision;
+		Scale = Other.Scale;
+		Offset = Other.Offset;
+		Floats = MoveTemp(Other.Floats);
+		Words = MoveTemp(Other.Words);
+		Other.Reset();
+	}
+	return *this;
+}
+
+void FHeightmap::Reset()
+{
+	Width = 0;
+	Height = 0;
+	Precision = EHeightmapPrecision::Float32;
+	Scale = 1.0f;
+	Offset = 0.0f;
+	Floats.Empty();
+	Words.Empty();
+}
+
+FHeightmap FHeightmap::Clone() const
+{
+	FHeightmap Copy;
+	Copy.Width = Width;
+	Copy.Height = Height;
+	Copy.Precision = Precision;
+	Copy.Scale = Scale;
+	Copy.Offset = Offset;
+	Copy.Floats = Floats;
+	Copy.Words = Words;
+	return Copy;
+}
+
+bool FHeightmap::IsValid() const
+{
+	if (Width <= 1 || Height <= 1)
+	{
+		return false;
+	}
+	return Precision == EHeightmapPrecision::Float32 ? Floats.Num() == Num() : Words.Num() == Num();
+}
+
+float FHeightmap::Get(int32 X, int32 Y) const
+{
+	const int64 Index = (int64)Y * Width + X;
+	switch (Precision)
+	{
+	case EHeightmapPrecision::Float16: return DecodeHalf(Words[Index]);
+	case EHeightmapPrecision::UInt16:  return DecodeUnorm(Words[Index], Scale, Offset);
+	default:                           return Floats[Index];
+	}
+}
+
+void FHeightmap::GetRow(int32 Y, float* Out) const
+{
+	const int64 RowStart = (int64)Y * Width;
+	switch (Precision)
+	{
+	case EHeightmapPrecision::Float16:
+		for (int32 X = 0; X < Width; ++X)
+		{
+			Out[X] = DecodeHalf(Words[RowStart + X]);
+		}
+		break;
+	case EHeightmapPrecision::UInt16:
+		for (int32 X = 0; X < Width; ++X)
+		{
+			Out[X] = DecodeUnorm(Words[RowStart + X], Scale, Offset);
+		}
+		break;
+	default:
+		FMemory::Memcpy(Out, Floats.GetData() + RowStart, Width * sizeof(float));
+		break;
+	}
+}
+
+const float* FHeightmap::ReadRow(int32 Y, TArray<float>& Scratch) const
+{
+	if (Precision == EHeightmapPrecision::Float32)
+	{
+		return Floats.GetData() + (int64)Y * Width;
+	}
+	Scratch.SetNumUninitialized(Width, EAllowShrinking::No);
+	GetRow(Y, Scratch.GetData());
+	return Scratch.GetData();
+}
+
+void FHeightmap::GetRange(float& OutMin, float& OutMax) const
+{
+	OutMin = 0.0f;
+	OutMax = 0.0f;
+	if (!IsValid())
+	{
+		return;
+	}
+	if (Precision == EHeightmapPrecision::UInt16)
+	{
+		uint16 Low = MAX_uint16;
+		uint16 High = 0;
+		for (const uint16 Word : Words)
+		{
+			Low = FMath::Min(Low, Word);
+			High = FMath::Max(High, Word);
+		}
+		OutMin = DecodeUnorm(Low, Scale, Offset);
+		OutMax = DecodeUnorm(High, Scale, Offset);
+		return;
+	}
+
+	OutMin = TNumericLimits<float>::Max();
+	OutMax = TNumericLimits<float>::Lowest();
+	TArray<float> Scratch;
+	for (int32 Y = 0; Y < Height; ++Y)
+	{
+		const float* Row = ReadRow(Y, Scratch);
+		for (int32 X = 0; X < Width; ++X)
+		{
+			OutMin = FMath::Min(OutMin, Row[X]);
+			OutMax = FMath::Max(OutMax, Row[X]);
+		}
+	}
+}
+
+TArray<float>& FHeightmap::EditFloats()
+{
+	SetPrecision(EHeightmapPrecision::Float32);
+	return Floats;
+}
+
+TArray<float> FHeightmap::ReleaseFloats()
+{
+	SetPrecision(EHeightmapPrecision::Float32);
+	TArray<float> Out = MoveTemp(Floats);
+	Reset();
+	return Out;
+}
+
+void FHeightmap::SetPrecision(EHeightmapPrecision NewPrecision, float RangeMin, float RangeMax)
+{
+	if (NewPrecision == Precision && NewPrecision != EHeightmapPrecision::UInt16)
+	{
+		return;
+	}
+	if (Num() == 0)
+	{
+		Precision = NewPrecision;
+		return;
+	}
+
+	if (NewPrecision == EHeightmapPrecision::Float32)
+	{
+		Floats.SetNumUninitialized(Num());
+		ForEachRowBlock(Height, [this](int32 Y)
+		{
+			GetRow(Y, Floats.GetData() + (int64)Y * Width);
+		});
+		Words.Empty();
+		Precision = NewPrecision;
+		Scale = 1.0f;
+		Offset = 0.0f;
+		return;
+	}
+
+	float NewScale = 1.0f;
+	float NewOffset = 0.0f;
+	if (NewPrecision == EHeightmapPrecision::UInt16)
+	{
+		if (RangeMin >= RangeMax)
+		{
+			GetRange(RangeMin, RangeMax);
+		}
+		NewOffset = RangeMin;
+		NewScale = FMath::Max(RangeMax - RangeMin, KINDA_SMALL_NUMBER);
+		if (Precision == EHeightmapPrecision::UInt16 && NewScale == Scale && NewOffset == Offset)
+		{
+			return;
+		}
+	}
+
+	// Each row decodes to floats (free for Float32 sources) and encodes into the new buffer.
+	TArray<uint16> NewWords;
+	NewWords.SetNumUninitialized(Num());
+	ForEachRowBlock(Height, [&](int32 Y)
+	{
+		TArray<float> Scratch;
+		const float* Row = ReadRow(Y, Scratch);
+		uint16* OutRow = NewWords.GetData() + (int64)Y * Width;
+		for (int32 X = 0; X < Width; ++X)
+		{
+			OutRow[X] = NewPrecision == EHeightmapPrecision::Float16 ? EncodeHalf(Row[X]) : EncodeUnorm(Row[X], NewScale, NewOffset);
+		}
+	});
+	Words = MoveTemp(NewWords);
+	Floats.Empty();
+	Precision = NewPrecision;
+	Scale = NewScale;
+	Offset = NewOffset;
+}
+
+bool FHeightmap::Save(const FString& Path, FString& OutError) const
+{
+	const EHeightmapFile Kind = FileKindFor(Path);
+	if (Kind == EHeightmapFile::Unknown)
+	{
+		OutError = FString::Printf(TEXT("Unsupported heightmap extension '%s' (.r16, .raw, .r32)."), *FPaths::GetExtension(Path));
+		return false;
+	}
+	if (!IsValid())
+	{
+		OutError = TEXT("Heightmap is empty.");
+		return false;
+	}
+
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(Path), true);
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*Path));
+	if (!Writer)
+	{
+		OutError = FString::Printf(TEXT("Cannot open %s for writing."), *Path);
+		return false;
+	}
+
+	// Matching storage goes out in one write; anything else is encoded a row at a time.
+	if (Kind == EHeightmapFile::R16 && Precision == EHeightmapPrecision::UInt16)
+	{
+		Writer->Serialize(const_cast<uint16*>(Words.GetData()), Num() * (int64)sizeof(uint16));
+	}
+	else if (Kind == EHeightmapFile::R32 && Precision == EHeightmapPrecision::Float32)
+	{
+		Writer->Serialize(const_cast<float*>(Floats.GetData()), Num() * (int64)sizeof(float));
+	}
+	else
+	{
+		TArray<float> Scratch;
+		TArray<uint16> RowWords;
+		for (int32 Y = 0; Y < Height; ++Y)
+		{
+			const float* Row = ReadRow(Y, Scratch);
+			if (Kind == EHeightmapFile::R32)
+			{
+				Writer->Serialize(const_cast<float*>(Row), Width * (int64)sizeof(float));
+				continue;
+			}
+			RowWords.SetNumUninitialized(Width, EAllowShrinking::No);
+			for (int32 X = 0; X < Width; ++X)
+			{
+				RowWords[X] = EncodeUnorm(Row[X], Scale, Offset);
+			}
+			Writer->Serialize(RowWords.GetData(), Width * (int64)sizeof(uint16));
+		}
+	}
+
+	if (!Writer->Close())
+	{
+		OutError = FString::Printf(TEXT("Failed writing %s."), *Path);
+		return false;
+	}
+	return true;
+}
+
+bool FHeightmap::Load(const FString& Path, int32 InWidth, int32 InHeight, FHeightmap& Out, FString& OutError, float InScale, float InOffset)
+{
+	const EHeightmapFile Kind = FileKindFor(Path);
+	if (Kind == EHeightmapFile::Unknown)
+	{
+		OutError = FString::Printf(TEXT("Unsupported heightmap extension '%s' (.r16, .raw, .r32)."), *FPaths::GetExtension(Path));
+		return false;
+	}
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	TUniquePtr<IMappedFileHandle> MappedFile(PlatformFile.OpenMapped(*Path));
+	if (!MappedFile)
+	{
+		OutError = FString::Printf(TEXT("Cannot map %s."), *Path);
+		return false;
+	}
+
+	const int64 FileSize = MappedFile->GetFileSize();
+	const int64 TexelBytes = Kind == EHeightmapFile::R16 ? sizeof(uint16) : sizeof(float);
+	if (InWidth <= 0 || InHeight <= 0)
+	{
+		const int32 Side = FMath::FloorToInt(FMath::Sqrt((double)(FileSize / TexelBytes)));
+		InWidth = Side;
+		InHeight = Side;
+	}
+	const int64 Bytes = (int64)InWidth * InHeight * TexelBytes;
+	if (InWidth <= 1 || InHeight <= 1 || FileSize != Bytes)
+	{
+		OutError = FString::Printf(TEXT("%s is %lld bytes; expected %dx%d texels (%lld bytes)."), *Path, FileSize, InWidth, InHeight, Bytes);
+		return false;
+	}
+
+	TUniquePtr<IMappedFileRegion> Region(MappedFile->MapRegion(0, Bytes, true));
+	if (!Region)
+	{
+		OutError = FString::Printf(TEXT("Cannot map %s."), *Path);
+		return false;
+	}
+
+	FHeightmap Loaded;
+	Loaded.Width = InWidth;
+	Loaded.Height = InHeight;
+	if (Kind == EHeightmapFile::R16)
+	{
+		Loaded.Precision = EHeightmapPrecision::UInt16;
+		Loaded.Scale = InScale;
+		Loaded.Offset = InOffset;
+		Loaded.Words.SetNumUninitialized(Loaded.Num());
+		FMemory::Memcpy(Loaded.Words.GetData(), Region->GetMappedPtr(), Bytes);
+	}
+	else
+	{
+		Loaded.Floats.SetNumUninitialized(Loaded.Num());
+		FMemory::Memcpy(Loaded.Floats.GetData(), Region->GetMappedPtr(), Bytes);
+	}
+	Out = MoveTemp(Loaded);
+	return true;
+}
+
+bool FHeightmap::ParsePrecision(const FString& Name, EHeightmapPrecision& OutPrecision)
+{
+	if (Name.Equals(TEXT("float32"), ESearchCase::IgnoreCase))
+	{
+		OutPrecision = EHeightmapPrecision::Float32;
+		return true;
+	}
+	if (Name.Equals(TEXT("float16"), ESearchCase::IgnoreCase))
+	{
+		OutPrecision = EHeightmapPrecision::Float16;
+		return true;
+	}
+	if (Name.Equals(TEXT("uint16"), ESearchCase::IgnoreCase))
+	{
+		OutPrecision = EHeightmapPrecision::UInt16;
+		return true;
+	}
+	return false;
+}
+
+const TCHAR* FHeightmap::PrecisionName(EHeightmapPrecision InPrecision)
+{
+	switch (InPrecision)
+	{
+	case EHeightmapPrecision::Float16: return TEXT("float16");
+	case EHeightmapPrecision::UInt16:  return TEXT("uint16");
+	default:                           return TEXT("float32");
+	}
+}
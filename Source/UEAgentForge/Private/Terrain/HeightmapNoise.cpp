@@ -1,3 +1,302 @@
 // Copyright UEAgentForge Project. All Rights Reserved.
-// HeightmapNoise.cpp - reserved for advanced multi-octave terrain noise.
+// HeightmapNoise.cpp - vectorized gradient noise and fractal evaluation.
 
+#include "Terrain/HeightmapNoise.h"
+
+#include "Async/ParallelFor.h"
+#include "Math/VectorRegister.h"
+
+namespace
+{
+	using FNoiseVec    = VectorRegister4Float;
+	using FNoiseVecInt = VectorRegister4Int;
+
+	static constexpr int32 MaxOctaves     = 12;
+	static constexpr int32 MaxWarpOctaves = 4;
+
+	// Gradient dot products peak well below 1; this brings the octave into roughly [-1, 1].
+	static constexpr float GradientScale = 1.4f;
+
+	// Integer-only lattice hash, so every lane and thread agrees exactly.
+	static FORCEINLINE FNoiseVecInt HashLattice(const FNoiseVecInt& IX, const FNoiseVecInt& IY, const FNoiseVecInt& Seed)
+	{
+		FNoiseVecInt H = VectorIntXor(
+			VectorIntMultiply(IX, VectorIntSet1(0x27d4eb2d)),
+			VectorIntMultiply(IY, VectorIntSet1(0x165667b1)));
+		H = VectorIntXor(H, Seed);
+		H = VectorIntXor(H, VectorShiftRightImmLogical(H, 15));
+		H = VectorIntMultiply(H, VectorIntSet1(0x2c1b3c6d));
+		H = VectorIntXor(H, VectorShiftRightImmLogical(H, 12));
+		H = VectorIntMultiply(H, VectorIntSet1(0x297a2d39));
+		H = VectorIntXor(H, VectorShiftRightImmLogical(H, 15));
+		return H;
+	}
+
+	// Dot with one of eight gradients (+-1, +-0.5) / (+-0.5, +-1), chosen by hash bits 0..2.
+	static FORCEINLINE FNoiseVec GradientDot(const FNoiseVecInt& Hash, const FNoiseVec& DX, const FNoiseVec& DY)
+	{
+		const FNoiseVec Swap = VectorCastIntToFloat(VectorIntCompareEQ(VectorIntAnd(Hash, VectorIntSet1(4)), VectorIntSet1(4)));
+		const FNoiseVec U = VectorSelect(Swap, DY, DX);
+		const FNoiseVec V = VectorSelect(Swap, DX, DY);
+		const FNoiseVecInt SignU = VectorShiftLeftImm(VectorIntAnd(Hash, VectorIntSet1(1)), 31);
+		const FNoiseVecInt SignV = VectorShiftLeftImm(VectorIntAnd(Hash, VectorIntSet1(2)), 30);
+		const FNoiseVec SU = VectorCastIntToFloat(VectorIntXor(VectorCastFloatToInt(U), SignU));
+		const FNoiseVec SV = VectorCastIntToFloat(VectorIntXor(VectorCastFloatToInt(V), SignV));
+		return VectorMultiplyAdd(SV, VectorSetFloat1(0.5f), SU);
+	}
+
+	// Quintic fade: t^3 (t (6t - 15) + 10).
+	static FORCEINLINE FNoiseVec Fade(const FNoiseVec& T)
+	{
+		const FNoiseVec Inner = VectorMultiplyAdd(T, VectorMultiplyAdd(T, VectorSetFloat1(6.0f), VectorSetFloat1(-15.0f)), VectorSetFloat1(10.0f));
+		return VectorMultiply(VectorMultiply(VectorMultiply(T, T), T), Inner);
+	}
+
+	static FORCEINLINE FNoiseVec GradientNoise(const FNoiseVec& X, const FNoiseVec& Y, const FNoiseVecInt& Seed)
+	{
+		const FNoiseVec FX = VectorFloor(X);
+		const FNoiseVec FY = VectorFloor(Y);
+		const FNoiseVecInt IX0 = VectorFloatToInt(FX);
+		const FNoiseVecInt IY0 = VectorFloatToInt(FY);
+		const FNoiseVecInt IX1 = VectorIntAdd(IX0, VectorIntSet1(1));
+		const FNoiseVecInt IY1 = VectorIntAdd(IY0, VectorIntSet1(1));
+
+		const FNoiseVec One = VectorOne();
+		const FNoiseVec DX0 = VectorSubtract(X, FX);
+		const FNoiseVec DY0 = VectorSubtract(Y, FY);
+		const FNoiseVec DX1 = VectorSubtract(DX0, One);
+		const FNoiseVec DY1 = VectorSubtract(DY0, One);
+
+		const FNoiseVec N00 = GradientDot(HashLattice(IX0, IY0, Seed), DX0, DY0);
+		const FNoiseVec N10 = GradientDot(HashLattice(IX1, IY0, Seed), DX1, DY0);
+		const FNoiseVec N01 = GradientDot(HashLattice(IX0, IY1, Seed), DX0, DY1);
+		const FNoiseVec N11 = GradientDot(HashLattice(IX1, IY1, Seed), DX1, DY1);
+
+		const FNoiseVec U = Fade(DX0);
+		const FNoiseVec V = Fade(DY0);
+		const FNoiseVec A = VectorMultiplyAdd(U, VectorSubtract(N10, N00), N00);
+		const FNoiseVec B = VectorMultiplyAdd(U, VectorSubtract(N11, N01), N01);
+		const FNoiseVec N = VectorMultiply(VectorMultiplyAdd(V, VectorSubtract(B, A), A), VectorSetFloat1(GradientScale));
+		return VectorMin(VectorMax(N, VectorSetFloat1(-1.0f)), One);
+	}
+
+	using FOctave = FHeightmapNoiseOctave;
+
+	static int32 MixSeed(int32 Seed, uint32 Salt)
+	{
+		uint32 H = (uint32)Seed ^ (Salt * 0x9E3779B9u);
+		H ^= H >> 16;
+		H *= 0x85EBCA6Bu;
+		H ^= H >> 13;
+		H *= 0xC2B2AE35u;
+		H ^= H >> 16;
+		return (int32)H;
+	}
+
+	/** Octave tables for one fractal, plus the 1 / sum-of-amplitudes normalizer. */
+	struct FFractal
+	{
+		EHeightmapNoiseType Type = EHeightmapNoiseType::Fbm;
+		FOctave Octaves[MaxOctaves];
+		int32   NumOctaves = 1;
+		float   Normalizer = 1.0f;
+
+		void Build(EHeightmapNoiseType InType, int32 Seed, float Frequency, int32 Count, float Lacunarity, float Gain)
+		{
+			Type = InType;
+			NumOctaves = FMath::Clamp(Count, 1, MaxOctaves);
+			float Freq = Frequency;
+			float Amp = 1.0f;
+			float AmpSum = 0.0f;
+			for (int32 Index = 0; Index < NumOctaves; ++Index)
+			{
+				FOctave& Octave = Octaves[Index];
+				Octave.Seed = MixSeed(Seed, (uint32)Index + 1u);
+				// Small per-octave shifts keep lattice points from lining up at the origin.
+				Octave.OffsetX = (float)(((uint32)Octave.Seed >> 8) & 1023u) * 0.1237f;
+				Octave.OffsetY = (float)(((uint32)Octave.Seed >> 20) & 1023u) * 0.1237f;
+				Octave.Frequency = Freq;
+				Octave.Amplitude = Amp;
+				AmpSum += Amp;
+				Freq *= Lacunarity;
+				Amp *= Gain;
+			}
+			Normalizer = AmpSum > 0.0f ? 1.0f / AmpSum : 1.0f;
+		}
+
+		FNoiseVec Evaluate(const FNoiseVec& X, const FNoiseVec& Y) const
+		{
+			const FNoiseVec One = VectorOne();
+			FNoiseVec Sum = VectorZero();
+			FNoiseVec Weight = One;
+			for (int32 Index = 0; Index < NumOctaves; ++Index)
+			{
+				const FOctave& Octave = Octaves[Index];
+				const FNoiseVec Freq = VectorSetFloat1(Octave.Frequency);
+				const FNoiseVec PX = VectorMultiplyAdd(X, Freq, VectorSetFloat1(Octave.OffsetX));
+				const FNoiseVec PY = VectorMultiplyAdd(Y, Freq, VectorSetFloat1(Octave.OffsetY));
+				const FNoiseVec N = GradientNoise(PX, PY, VectorIntSet1(Octave.Seed));
+				const FNoiseVec Amp = VectorSetFloat1(Octave.Amplitude);
+
+				switch (Type)
+				{
+				case EHeightmapNoiseType::Ridged:
+				{
+					// Each octave is weighted by the previous crest so detail gathers on ridges.
+					FNoiseVec Signal = VectorSubtract(One, VectorAbs(N));
+					Signal = VectorMultiply(VectorMultiply(Signal, Signal), Weight);
+					Weight = VectorMin(VectorMax(VectorMultiply(Signal, VectorSetFloat1(2.0f)), VectorZero()), One);
+					Sum = VectorMultiplyAdd(Signal, Amp, Sum);
+					break;
+				}
+				case EHeightmapNoiseType::Billow:
+					Sum = VectorMultiplyAdd(VectorMultiplyAdd(VectorAbs(N), VectorSetFloat1(2.0f), VectorSetFloat1(-1.0f)), Amp, Sum);
+					break;
+				default:
+					Sum = VectorMultiplyAdd(N, Amp, Sum);
+					break;
+				}
+			}
+			return VectorMultiply(Sum, VectorSetFloat1(Normalizer));
+		}
+	};
+
+	/** Sanitized settings compiled into octave tables; shared read-only by all rows. */
+	struct FNoisePlan
+	{
+		FFractal Main;
+		FFractal WarpX;
+		FFractal WarpY;
+		float    WarpStrength = 0.0f;
+
+		explicit FNoisePlan(const FHeightmapNoiseSettings& Settings)
+		{
+			Main.Build(Settings.Type, Settings.Seed, Settings.Frequency, Settings.Octaves, Settings.Lacunarity, Settings.Gain);
+			WarpStrength = Settings.WarpStrength;
+			if (WarpStrength > 0.0f)
+			{
+				const float WarpFreq = Settings.WarpFrequency > 0.0f ? Settings.WarpFrequency : Settings.Frequency;
+				const int32 WarpOctaves = FMath::Min(Settings.Octaves, MaxWarpOctaves);
+				WarpX.Build(EHeightmapNoiseType::Fbm, MixSeed(Settings.Seed, 0x5741u), WarpFreq, WarpOctaves, Settings.Lacunarity, Settings.Gain);
+				WarpY.Build(EHeightmapNoiseType::Fbm, MixSeed(Settings.Seed, 0x5742u), WarpFreq, WarpOctaves, Settings.Lacunarity, Settings.Gain);
+			}
+		}
+
+		FORCEINLINE FNoiseVec Evaluate(FNoiseVec X, FNoiseVec Y) const
+		{
+			if (WarpStrength > 0.0f)
+			{
+				const FNoiseVec Strength = VectorSetFloat1(WarpStrength);
+				const FNoiseVec WX = WarpX.Evaluate(X, Y);
+				const FNoiseVec WY = WarpY.Evaluate(X, Y);
+				X = VectorMultiplyAdd(WX, Strength, X);
+				Y = VectorMultiplyAdd(WY, Strength, Y);
+			}
+			return Main.Evaluate(X, Y);
+		}
+	};
+
+	static void EvaluateGrid(const FHeightmapNoiseSettings& Settings, FIntPoint Origin, int32 Width, int32 Height, float Scale, float* Out, bool bAccumulate)
+	{
+		const FHeightmapNoiseSettings Safe = Settings.Sanitized();
+		const FNoisePlan Plan(Safe);
+		const FNoiseVec OutScale = VectorSetFloat1(Safe.Amplitude * Scale);
+		const FNoiseVec LaneOffsets = MakeVectorRegisterFloat(0.0f, 1.0f, 2.0f, 3.0f);
+
+		// One row per task: a texel's value depends only on its coordinate, never on the split.
+		ParallelFor(Height, [&](int32 Y)
+		{
+			float* Row = Out + (int64)Y * Width;
+			const FNoiseVec YV = VectorSetFloat1((float)(Origin.Y + Y));
+			float Lanes[4];
+			for (int32 X = 0; X < Width; X += 4)
+			{
+				const FNoiseVec XV = VectorAdd(VectorSetFloat1((float)(Origin.X + X)), LaneOffsets);
+				VectorStore(VectorMultiply(Plan.Evaluate(XV, YV), OutScale), Lanes);
+				const int32 Count = FMath::Min(4, Width - X);
+				for (int32 Lane = 0; Lane < Count; ++Lane)
+				{
+					Row[X + Lane] = bAccumulate ? Row[X + Lane] + Lanes[Lane] : Lanes[Lane];
+				}
+			}
+		});
+	}
+}
+
+FHeightmapNoiseSettings FHeightmapNoiseSettings::Sanitized() const
+{
+	FHeightmapNoiseSettings Out = *this;
+	Out.Frequency     = FMath::Clamp(Frequency, 0.00001f, 10.0f);
+	Out.Amplitude     = FMath::Max(0.0f, Amplitude);
+	Out.Octaves       = FMath::Clamp(Octaves, 1, MaxOctaves);
+	Out.Lacunarity    = FMath::Clamp(Lacunarity, 1.0f, 4.0f);
+	Out.Gain          = FMath::Clamp(Gain, 0.0f, 1.0f);
+	Out.WarpStrength  = FMath::Clamp(WarpStrength, 0.0f, 4096.0f);
+	Out.WarpFrequency = FMath::Clamp(WarpFrequency, 0.0f, 10.0f);
+	return Out;
+}
+
+bool FHeightmapNoiseSettings::ParseType(const FString& Name, EHeightmapNoiseType& OutType)
+{
+	if (Name.Equals(TEXT("fbm"), ESearchCase::IgnoreCase))    { OutType = EHeightmapNoiseType::Fbm;    return true; }
+	if (Name.Equals(TEXT("ridged"), ESearchCase::IgnoreCase)) { OutType = EHeightmapNoiseType::Ridged; return true; }
+	if (Name.Equals(TEXT("billow"), ESearchCase::IgnoreCase)) { OutType = EHeightmapNoiseType::Billow; return true; }
+	return false;
+}
+
+const TCHAR* FHeightmapNoiseSettings::TypeName(EHeightmapNoiseType Type)
+{
+	switch (Type)
+	{
+	case EHeightmapNoiseType::Ridged: return TEXT("ridged");
+	case EHeightmapNoiseType::Billow: return TEXT("billow");
+	default:                          return TEXT("fbm");
+	}
+}
+
+void FHeightmapNoise::BuildTables(const FHeightmapNoiseSettings& Settings, FHeightmapNoiseTables& Out)
+{
+	const FHeightmapNoiseSettings Safe = Settings.Sanitized();
+	const FNoisePlan Plan(Safe);
+	Out.Type = Safe.Type;
+	Out.Main = TArray<FHeightmapNoiseOctave>(Plan.Main.Octaves, Plan.Main.NumOctaves);
+	Out.Normalizer = Plan.Main.Normalizer;
+	Out.WarpStrength = Plan.WarpStrength;
+	Out.Amplitude = Safe.Amplitude;
+	Out.WarpX.Reset();
+	Out.WarpY.Reset();
+	if (Plan.WarpStrength > 0.0f)
+	{
+		Out.WarpX = TArray<FHeightmapNoiseOctave>(Plan.WarpX.Octaves, Plan.WarpX.NumOctaves);
+		Out.WarpY = TArray<FHeightmapNoiseOctave>(Plan.WarpY.Octaves, Plan.WarpY.NumOctaves);
+		Out.WarpNormalizer = Plan.WarpX.Normalizer;   // X and Y share octave count and gain
+	}
+}
+
+void FHeightmapNoise::Fill(const FHeightmapNoiseSettings& Settings, int32 Width, int32 Height, TArray<float>& Out, FIntPoint Origin)
+{
+	Out.SetNumUninitialized(FMath::Max(0, Width) * FMath::Max(0, Height));
+	if (Out.Num() == 0)
+	{
+		return;
+	}
+	EvaluateGrid(Settings, Origin, Width, Height, 1.0f, Out.GetData(), false);
+}
+
+void FHeightmapNoise::Accumulate(const FHeightmapNoiseSettings& Settings, int32 Width, int32 Height, float Scale, TArray<float>& InOut, FIntPoint Origin)
+{
+	if (Width <= 0 || Height <= 0 || InOut.Num() != Width * Height)
+	{
+		return;
+	}
+	EvaluateGrid(Settings, Origin, Width, Height, Scale, InOut.GetData(), true);
+}
+
+float FHeightmapNoise::Sample(const FHeightmapNoiseSettings& Settings, float X, float Y)
+{
+	const FHeightmapNoiseSettings Safe = Settings.Sanitized();
+	const FNoisePlan Plan(Safe);
+	float Lanes[4];
+	VectorStore(VectorMultiply(Plan.Evaluate(VectorSetFloat1(X), VectorSetFloat1(Y)), VectorSetFloat1(Safe.Amplitude)), Lanes);
+	return Lanes[0];
+}
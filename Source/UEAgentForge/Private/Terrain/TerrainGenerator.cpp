@@ -4,8 +4,17 @@
 #include "Terrain/TerrainGenerator.h"
 #include "Terrain/ErosionSim.h"
 
+#include "AI/NavigationSystemBase.h"
+#include "Async/ParallelFor.h"
 #include "Engine/World.h"
-#include "Math/RandomStream.h"
+#include "HAL/PlatformTime.h"
+#include "Landscape.h"
+#include "LandscapeInfo.h"
+#include "LandscapeProxy.h"
+#include "LandscapeSubsystem.h"
+#include "Misc/ScopedSlowTask.h"
+#include "Misc/ITransaction.h"
+#include "WorldPartition/WorldPartition.h"
 
 namespace
 {
@@ -14,9 +23,103 @@ namespace
 		return Width > 1 && Height > 1 && Heightmap.Num() == (Width * Height);
 	}
 
-	static FORCEINLINE int32 HeightmapIndex(int32 X, int32 Y, int32 Width)
+	// Landscape heights are uint16 with 32768 at the actor's Z; one unit is 1/128 cm before scale.
+	static constexpr float LandscapeHalfRangeUnits = 256.0f;
+
+	// World Partition region edge, in quads, when splitting the landscape into streaming proxies.
+	static constexpr int32 WorldPartitionRegionQuads = 1024;
+
+	struct FLandscapeLayout
 	{
-		return Y * Width + X;
+		int32 QuadsPerSection = 63;
+		int32 SectionsPerComponent = 1;
+		int32 ComponentsX = 1;
+		int32 ComponentsY = 1;
+
+		int32 ComponentQuads() const { return QuadsPerSection * SectionsPerComponent; }
+		int32 VertsX() const { return ComponentsX * ComponentQuads() + 1; }
+		int32 VertsY() const { return ComponentsY * ComponentQuads() + 1; }
+	};
+
+	/**
+	 * Component layout whose vertex grid is closest to Width x Height, preferring
+	 * fewer, larger components (cheaper to create and to stream). A landscape is
+	 * always N * ComponentQuads + 1 vertices per side, so most maps resample slightly.
+	 */
+	static FLandscapeLayout ChooseLandscapeLayout(int32 Width, int32 Height)
+	{
+		static constexpr int32 QuadsPerSectionOptions[] = { 63, 127, 255 };
+		static constexpr int32 MaxComponentsPerSide = 32;
+
+		FLandscapeLayout Best;
+		int64 BestError = TNumericLimits<int64>::Max();
+		int32 BestComponents = TNumericLimits<int32>::Max();
+		for (const int32 Quads : QuadsPerSectionOptions)
+		{
+			for (int32 Sections = 1; Sections <= 2; ++Sections)
+			{
+				FLandscapeLayout Layout;
+				Layout.QuadsPerSection = Quads;
+				Layout.SectionsPerComponent = Sections;
+				const int32 ComponentQuads = Layout.ComponentQuads();
+				Layout.ComponentsX = FMath::Clamp(FMath::RoundToInt((float)(Width - 1) / (float)ComponentQuads), 1, MaxComponentsPerSide);
+				Layout.ComponentsY = FMath::Clamp(FMath::RoundToInt((float)(Height - 1) / (float)ComponentQuads), 1, MaxComponentsPerSide);
+
+				const int64 Error = FMath::Abs(Layout.VertsX() - Width) + FMath::Abs(Layout.VertsY() - Height);
+				const int32 Components = Layout.ComponentsX * Layout.ComponentsY;
+				if (Error < BestError || (Error == BestError && Components < BestComponents))
+				{
+					Best = Layout;
+					BestError = Error;
+					BestComponents = Components;
+				}
+			}
+		}
+		return Best;
+	}
+
+	/**
+	 * Quantize [0, 1] heights into OutHeights (VertsX x VertsY), resampling
+	 * bilinearly when the grids differ. ReadRow(Y, Scratch) returns source row Y.
+	 */
+	template <typename FRowReader>
+	static void QuantizeHeights(const FRowReader& ReadRow, int32 Width, int32 Height, int32 VertsX, int32 VertsY, TArray<uint16>& OutHeights)
+	{
+		OutHeights.SetNumUninitialized(VertsX * VertsY);
+		const bool bResample = VertsX != Width || VertsY != Height;
+		const float StepX = (float)(Width - 1) / (float)FMath::Max(VertsX - 1, 1);
+		const float StepY = (float)(Height - 1) / (float)FMath::Max(VertsY - 1, 1);
+
+		ParallelFor(VertsY, [&](int32 Y)
+		{
+			TArray<float> Scratch0;
+			TArray<float> Scratch1;
+			uint16* OutRow = OutHeights.GetData() + (int64)Y * VertsX;
+			if (!bResample)
+			{
+				const float* InRow = ReadRow(Y, Scratch0);
+				for (int32 X = 0; X < VertsX; ++X)
+				{
+					OutRow[X] = (uint16)FMath::Clamp(FMath::RoundToInt(InRow[X] * 65535.0f), 0, 65535);
+				}
+				return;
+			}
+
+			const float SrcY = Y * StepY;
+			const int32 Y0 = FMath::Min((int32)SrcY, Height - 2);
+			const float FY = SrcY - (float)Y0;
+			const float* Row0 = ReadRow(Y0, Scratch0);
+			const float* Row1 = ReadRow(Y0 + 1, Scratch1);
+			for (int32 X = 0; X < VertsX; ++X)
+			{
+				const float SrcX = X * StepX;
+				const int32 X0 = FMath::Min((int32)SrcX, Width - 2);
+				const float FX = SrcX - (float)X0;
+				const float Top = FMath::Lerp(Row0[X0], Row0[X0 + 1], FX);
+				const float Bottom = FMath::Lerp(Row1[X0], Row1[X0 + 1], FX);
+				OutRow[X] = (uint16)FMath::Clamp(FMath::RoundToInt(FMath::Lerp(Top, Bottom, FY) * 65535.0f), 0, 65535);
+			}
+		});
 	}
 }
 
@@ -26,29 +129,25 @@ TArray<float> FTerrainGenerator::GenerateHeightmap(
 	int32 Seed,
 	float Frequency,
 	float Amplitude)
+{
+	FHeightmapNoiseSettings Noise;
+	Noise.Seed = Seed;
+	Noise.Frequency = Frequency;
+	Noise.Amplitude = Amplitude;
+	Noise.Octaves = 1;
+	return GenerateHeightmap(Width, Height, Noise);
+}
+
+TArray<float> FTerrainGenerator::GenerateHeightmap(
+	int32 Width,
+	int32 Height,
+	const FHeightmapNoiseSettings& Noise)
 {
 	Width = FMath::Clamp(Width, 2, 4096);
 	Height = FMath::Clamp(Height, 2, 4096);
-	const float Freq = FMath::Max(0.0001f, Frequency);
-	const float Amp = FMath::Max(0.0f, Amplitude);
 
 	TArray<float> Heightmap;
-	Heightmap.SetNumZeroed(Width * Height);
-
-	FRandomStream Rng(Seed);
-	const float OffsetX = Rng.FRandRange(-100000.0f, 100000.0f);
-	const float OffsetY = Rng.FRandRange(-100000.0f, 100000.0f);
-
-	for (int32 Y = 0; Y < Height; ++Y)
-	{
-		for (int32 X = 0; X < Width; ++X)
-		{
-			const float NX = (float)X * Freq + OffsetX;
-			const float NY = (float)Y * Freq + OffsetY;
-			const float Noise = FMath::PerlinNoise2D(FVector2D(NX, NY));
-			Heightmap[HeightmapIndex(X, Y, Width)] = Noise * Amp;
-		}
-	}
+	FHeightmapNoise::Fill(Noise, Width, Height, Heightmap);
 	return Heightmap;
 }
 
@@ -58,6 +157,21 @@ void FTerrainGenerator::ApplyRidgedNoise(
 	int32 Height,
 	int32 Seed,
 	float Strength)
+{
+	FHeightmapNoiseSettings Noise;
+	Noise.Type = EHeightmapNoiseType::Ridged;
+	Noise.Seed = Seed ^ 0x6B8B4567;
+	Noise.Frequency = 0.015f;
+	Noise.Octaves = 1;
+	ApplyRidgedNoise(Heightmap, Width, Height, Noise, Strength);
+}
+
+void FTerrainGenerator::ApplyRidgedNoise(
+	TArray<float>& Heightmap,
+	int32 Width,
+	int32 Height,
+	const FHeightmapNoiseSettings& Noise,
+	float Strength)
 {
 	if (!IsValidHeightmapShape(Heightmap, Width, Height))
 	{
@@ -70,45 +184,46 @@ void FTerrainGenerator::ApplyRidgedNoise(
 		return;
 	}
 
-	FRandomStream Rng(Seed ^ 0x6B8B4567);
-	const float OffsetX = Rng.FRandRange(-100000.0f, 100000.0f);
-	const float OffsetY = Rng.FRandRange(-100000.0f, 100000.0f);
-
-	for (int32 Y = 0; Y < Height; ++Y)
-	{
-		for (int32 X = 0; X < Width; ++X)
-		{
-			const int32 Index = HeightmapIndex(X, Y, Width);
-			const float Base = FMath::PerlinNoise2D(FVector2D((float)X * 0.015f + OffsetX, (float)Y * 0.015f + OffsetY));
-			const float Ridged = 1.0f - FMath::Abs(Base);
-			Heightmap[Index] += Ridged * BlendStrength;
-		}
-	}
+	FHeightmapNoise::Accumulate(Noise, Width, Height, BlendStrength, Heightmap);
 }
 
-void FTerrainGenerator::ApplyErosion(
+int32 FTerrainGenerator::ApplyErosion(
 	TArray<float>& Heightmap,
 	int32 Width,
 	int32 Height,
 	int32 Iterations,
-	float Strength)
+	float Strength,
+	float ConvergenceThreshold)
 {
 	if (!IsValidHeightmapShape(Heightmap, Width, Height))
 	{
-		return;
+		return 0;
 	}
 
 	const int32 Steps = FMath::Clamp(Iterations, 0, 256);
 	const float ErodeStrength = FMath::Clamp(Strength, 0.0f, 1.0f);
 	if (Steps == 0 || ErodeStrength <= KINDA_SMALL_NUMBER)
 	{
-		return;
+		return 0;
 	}
 
 	// Thermal erosion creates more natural ridges/valleys than pure blur smoothing.
 	const float TalusThreshold = FMath::Lerp(0.06f, 0.01f, ErodeStrength);
 	const float SedimentStrength = ErodeStrength;
-	FErosionSim::ApplyThermalErosion(Heightmap, Width, Height, Steps, TalusThreshold, SedimentStrength);
+	return FErosionSim::ApplyThermalErosion(Heightmap, Width, Height, Steps, TalusThreshold, SedimentStrength, ConvergenceThreshold);
+}
+
+int64 FTerrainGenerator::ApplyHydraulicErosion(
+	TArray<float>& Heightmap,
+	int32 Width,
+	int32 Height,
+	const FHydraulicErosionSettings& Settings)
+{
+	if (!IsValidHeightmapShape(Heightmap, Width, Height))
+	{
+		return 0;
+	}
+	return FErosionFilter::ApplyHydraulicErosion(Heightmap, Width, Height, Settings);
 }
 
 void FTerrainGenerator::NormalizeHeightmap(TArray<float>& Heightmap, float MinOut, float MaxOut)
@@ -144,6 +259,141 @@ void FTerrainGenerator::NormalizeHeightmap(TArray<float>& Heightmap, float MinOu
 	}
 }
 
+void FTerrainGenerator::GenerateHeightmap(
+	int32 Width,
+	int32 Height,
+	const FHeightmapNoiseSettings& Noise,
+	FHeightmap& OutHeightmap)
+{
+	Width = FMath::Clamp(Width, 2, 4096);
+	Height = FMath::Clamp(Height, 2, 4096);
+	OutHeightmap = FHeightmap(GenerateHeightmap(Width, Height, Noise), Width, Height);
+}
+
+void FTerrainGenerator::ApplyRidgedNoise(FHeightmap& Heightmap, const FHeightmapNoiseSettings& Noise, float Strength)
+{
+	const EHeightmapPrecision Precision = Heightmap.GetPrecision();
+	ApplyRidgedNoise(Heightmap.EditFloats(), Heightmap.GetWidth(), Heightmap.GetHeight(), Noise, Strength);
+	Heightmap.SetPrecision(Precision);
+}
+
+int32 FTerrainGenerator::ApplyErosion(FHeightmap& Heightmap, int32 Iterations, float Strength, float ConvergenceThreshold)
+{
+	const EHeightmapPrecision Precision = Heightmap.GetPrecision();
+	const int32 IterationsUsed = ApplyErosion(Heightmap.EditFloats(), Heightmap.GetWidth(), Heightmap.GetHeight(), Iterations, Strength, ConvergenceThreshold);
+	Heightmap.SetPrecision(Precision);
+	return IterationsUsed;
+}
+
+int64 FTerrainGenerator::ApplyHydraulicErosion(FHeightmap& Heightmap, const FHydraulicErosionSettings& Settings)
+{
+	const EHeightmapPrecision Precision = Heightmap.GetPrecision();
+	const int64 Droplets = ApplyHydraulicErosion(Heightmap.EditFloats(), Heightmap.GetWidth(), Heightmap.GetHeight(), Settings);
+	Heightmap.SetPrecision(Precision);
+	return Droplets;
+}
+
+void FTerrainGenerator::NormalizeHeightmap(FHeightmap& Heightmap, float MinOut, float MaxOut)
+{
+	const EHeightmapPrecision Precision = Heightmap.GetPrecision();
+	NormalizeHeightmap(Heightmap.EditFloats(), MinOut, MaxOut);
+	Heightmap.SetPrecision(Precision, FMath::Min(MinOut, MaxOut), FMath::Max(MinOut, MaxOut));
+}
+
+#if WITH_EDITOR
+namespace
+{
+	template <typename FRowReader>
+	static bool ImportLandscape(
+		UWorld* World,
+		const FRowReader& ReadRow,
+		int32 Width,
+		int32 Height,
+		const FVector& Origin,
+		const FVector& Scale,
+		FString& OutMessage)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		const FLandscapeLayout Layout = ChooseLandscapeLayout(Width, Height);
+		const int32 VertsX = Layout.VertsX();
+		const int32 VertsY = Layout.VertsY();
+
+		FScopedSlowTask SlowTask(3.0f, NSLOCTEXT("UEAgentForge", "SpawnLandscape", "Importing generated landscape..."));
+
+		// Quantize straight into the buffer Import consumes; the map key is the default edit layer.
+		TMap<FGuid, TArray<uint16>> HeightDataPerLayer;
+		TMap<FGuid, TArray<FLandscapeImportLayerInfo>> MaterialLayerDataPerLayer;
+		TArray<uint16>& HeightData = HeightDataPerLayer.Add(FGuid());
+		MaterialLayerDataPerLayer.Add(FGuid());
+		SlowTask.EnterProgressFrame(1.0f);
+		QuantizeHeights(ReadRow, Width, Height, VertsX, VertsY, HeightData);
+
+		// Heightmap 0 sits at Origin.Z: uint16 0 is LandscapeHalfRangeUnits below the actor.
+		const FVector ActorScale(
+			Scale.X * (float)(Width - 1) / (float)(VertsX - 1),
+			Scale.Y * (float)(Height - 1) / (float)(VertsY - 1),
+			Scale.Z);
+		const FVector ActorLocation(Origin.X, Origin.Y, Origin.Z + LandscapeHalfRangeUnits * Scale.Z);
+
+		ALandscape* Landscape = nullptr;
+		int32 RegionProxies = 0;
+		{
+			// One navigation rebuild and no per-component undo records for the whole import.
+			FNavigationLockContext NavigationLock(World, ENavigationLockReason::Unknown);
+			TGuardValue<ITransaction*> UndoGuard(GUndo, nullptr);
+
+			Landscape = World->SpawnActor<ALandscape>(ALandscape::StaticClass(), FTransform(FRotator::ZeroRotator, ActorLocation, ActorScale));
+			if (!Landscape)
+			{
+				OutMessage = TEXT("SpawnLandscape failed: could not spawn ALandscape.");
+				return false;
+			}
+			Landscape->SetActorLabel(TEXT("AgentForge_Terrain"));
+
+			SlowTask.EnterProgressFrame(1.0f);
+			Landscape->Import(
+				FGuid::NewGuid(),
+				0, 0, VertsX - 1, VertsY - 1,
+				Layout.SectionsPerComponent,
+				Layout.QuadsPerSection,
+				HeightDataPerLayer,
+				nullptr,
+				MaterialLayerDataPerLayer,
+				ELandscapeImportAlphamapType::Additive);
+			HeightDataPerLayer.Empty();
+
+			ULandscapeInfo* LandscapeInfo = Landscape->GetLandscapeInfo();
+			if (LandscapeInfo)
+			{
+				LandscapeInfo->UpdateLayerInfoMap(Landscape);
+			}
+
+			// Partitioned worlds: move components into one streaming proxy per grid region in a single pass.
+			SlowTask.EnterProgressFrame(1.0f);
+			ULandscapeSubsystem* LandscapeSubsystem = World->GetSubsystem<ULandscapeSubsystem>();
+			if (World->GetWorldPartition() && LandscapeSubsystem && LandscapeInfo)
+			{
+				const uint32 GridSizeInComponents = (uint32)FMath::Max(1, WorldPartitionRegionQuads / Layout.ComponentQuads());
+				LandscapeSubsystem->ChangeGridSize(LandscapeInfo, GridSizeInComponents);
+				RegionProxies = LandscapeInfo->StreamingProxies.Num();
+			}
+
+			Landscape->PostEditChange();
+		}
+
+		OutMessage = FString::Printf(
+			TEXT("Spawned landscape %s: %dx%d verts, %dx%d components of %d quads (%d section(s) of %d), %d region proxies, %.1f ms."),
+			*Landscape->GetActorLabel(),
+			VertsX, VertsY,
+			Layout.ComponentsX, Layout.ComponentsY,
+			Layout.ComponentQuads(), Layout.SectionsPerComponent, Layout.QuadsPerSection,
+			RegionProxies,
+			(FPlatformTime::Seconds() - StartTime) * 1000.0);
+		return true;
+	}
+}
+#endif
+
 bool FTerrainGenerator::SpawnLandscape(
 	UWorld* World,
 	const TArray<float>& Heightmap,
@@ -164,12 +414,39 @@ bool FTerrainGenerator::SpawnLandscape(
 		return false;
 	}
 
-	// Phase 2 skeleton only: landscape authoring will be implemented by TerrainEngine.
-	OutMessage = FString::Printf(
-		TEXT("SpawnLandscape not implemented yet (width=%d height=%d origin=(%.1f,%.1f,%.1f) scale=(%.1f,%.1f,%.1f))."),
-		Width,
-		Height,
-		Origin.X, Origin.Y, Origin.Z,
-		Scale.X, Scale.Y, Scale.Z);
+#if WITH_EDITOR
+	const auto ReadRow = [&Heightmap, Width](int32 Y, TArray<float>&) { return Heightmap.GetData() + (int64)Y * Width; };
+	return ImportLandscape(World, ReadRow, Width, Height, Origin, Scale, OutMessage);
+#else
+	OutMessage = TEXT("SpawnLandscape requires WITH_EDITOR.");
+	return false;
+#endif
+}
+
+bool FTerrainGenerator::SpawnLandscape(
+	UWorld* World,
+	const FHeightmap& Heightmap,
+	const FVector& Origin,
+	const FVector& Scale,
+	FString& OutMessage)
+{
+	if (!World)
+	{
+		OutMessage = TEXT("SpawnLandscape failed: invalid world.");
+		return false;
+	}
+	if (!Heightmap.IsValid())
+	{
+		OutMessage = TEXT("SpawnLandscape failed: invalid heightmap dimensions.");
+		return false;
+	}
+
+#if WITH_EDITOR
+	// Compact storage decodes a row at a time; the full float map is never materialized.
+	const auto ReadRow = [&Heightmap](int32 Y, TArray<float>& Scratch) { return Heightmap.ReadRow(Y, Scratch); };
+	return ImportLandscape(World, ReadRow, Heightmap.GetWidth(), Heightmap.GetHeight(), Origin, Scale, OutMessage);
+#else
+	OutMessage = TEXT("SpawnLandscape requires WITH_EDITOR.");
 	return false;
+#endif
 }
@@ -0,0 +1,426 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// TerrainGpu.cpp - RDG dispatch of the terrain compute shaders and heightmap readback.
+
+#include "Terrain/TerrainGpu.h"
+
+#include "AgentForgeTerrainShaders.h"
+
+#include "GlobalShader.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Misc/App.h"
+#include "RHIGPUReadback.h"
+#include "RenderGraphBuilder.h"
+#include "RenderGraphUtils.h"
+#include "RenderingThread.h"
+#include <atomic>
+
+/** Shared between the game thread (polls) and the render thread (fills). */
+struct FTerrainReadbackState
+{
+	TUniquePtr<FRHIGPUBufferReadback> Readback;
+	TArray<float>                     Heights;
+	FThreadSafeBool                   bDone = false;
+	std::atomic<bool>                 bCheckQueued { false };
+};
+
+namespace
+{
+	static constexpr double ReadbackTimeoutSeconds = 60.0;
+	static constexpr int32  DropletsPerBatch = 32768;
+
+	struct FGpuNoisePass
+	{
+		TArray<FVector4f> Octaves;
+		TArray<int32>     Seeds;
+		uint32 Type = 0;
+		uint32 NumOctaves = 0;
+		uint32 NumWarpOctaves = 0;
+		float  Normalizer = 1.0f;
+		float  WarpNormalizer = 1.0f;
+		float  WarpStrength = 0.0f;
+		float  OutputScale = 1.0f;
+		bool   bAccumulate = false;
+	};
+
+	static FGpuNoisePass MakeNoisePass(const FHeightmapNoiseSettings& Settings, float Scale, bool bAccumulate)
+	{
+		FHeightmapNoiseTables Tables;
+		FHeightmapNoise::BuildTables(Settings, Tables);
+
+		FGpuNoisePass Pass;
+		for (const TArray<FHeightmapNoiseOctave>* Table : { &Tables.Main, &Tables.WarpX, &Tables.WarpY })
+		{
+			for (const FHeightmapNoiseOctave& Octave : *Table)
+			{
+				Pass.Octaves.Add(FVector4f(Octave.Frequency, Octave.Amplitude, Octave.OffsetX, Octave.OffsetY));
+				Pass.Seeds.Add(Octave.Seed);
+			}
+		}
+		Pass.Type = (uint32)Tables.Type;
+		Pass.NumOctaves = (uint32)Tables.Main.Num();
+		Pass.NumWarpOctaves = (uint32)Tables.WarpX.Num();
+		Pass.Normalizer = Tables.Normalizer;
+		Pass.WarpNormalizer = Tables.WarpNormalizer;
+		Pass.WarpStrength = Tables.WarpStrength;
+		Pass.OutputScale = Tables.Amplitude * Scale;
+		Pass.bAccumulate = bAccumulate;
+		return Pass;
+	}
+
+	static void BuildBrushTaps(int32 Radius, TArray<FVector4f>& OutTaps)
+	{
+		// Same linear falloff as FErosionFilter's CPU brush.
+		float WeightSum = 0.0f;
+		for (int32 DY = -Radius; DY <= Radius; ++DY)
+		{
+			for (int32 DX = -Radius; DX <= Radius; ++DX)
+			{
+				const float Distance = FMath::Sqrt((float)(DX * DX + DY * DY));
+				if (Distance < (float)Radius)
+				{
+					const float Weight = 1.0f - Distance / (float)Radius;
+					OutTaps.Add(FVector4f((float)DX, (float)DY, Weight, 0.0f));
+					WeightSum += Weight;
+				}
+			}
+		}
+		for (FVector4f& Tap : OutTaps)
+		{
+			Tap.Z /= WeightSum;
+		}
+	}
+
+	static void AddNoisePass(FRDGBuilder& GraphBuilder, FGlobalShaderMap* ShaderMap, const FGpuNoisePass& Noise, FIntPoint Size, FRDGBufferRef Heights)
+	{
+		FRDGBufferRef Octaves = CreateStructuredBuffer(
+			GraphBuilder, TEXT("AgentForge.Terrain.Octaves"), sizeof(FVector4f), Noise.Octaves.Num(),
+			Noise.Octaves.GetData(), Noise.Octaves.Num() * sizeof(FVector4f));
+		FRDGBufferRef Seeds = CreateStructuredBuffer(
+			GraphBuilder, TEXT("AgentForge.Terrain.OctaveSeeds"), sizeof(int32), Noise.Seeds.Num(),
+			Noise.Seeds.GetData(), Noise.Seeds.Num() * sizeof(int32));
+
+		FAgentForgeTerrainNoiseCS::FParameters* Parameters = GraphBuilder.AllocParameters<FAgentForgeTerrainNoiseCS::FParameters>();
+		Parameters->Size = Size;
+		Parameters->NoiseType = Noise.Type;
+		Parameters->NumOctaves = Noise.NumOctaves;
+		Parameters->NumWarpOctaves = Noise.NumWarpOctaves;
+		Parameters->Normalizer = Noise.Normalizer;
+		Parameters->WarpNormalizer = Noise.WarpNormalizer;
+		Parameters->WarpStrength = Noise.WarpStrength;
+		Parameters->OutputScale = Noise.OutputScale;
+		Parameters->bAccumulate = Noise.bAccumulate ? 1u : 0u;
+		Parameters->Octaves = GraphBuilder.CreateSRV(Octaves);
+		Parameters->OctaveSeeds = GraphBuilder.CreateSRV(Seeds);
+		Parameters->RWHeights = GraphBuilder.CreateUAV(Heights);
+
+		TShaderMapRef<FAgentForgeTerrainNoiseCS> Shader(ShaderMap);
+		FComputeShaderUtils::AddPass(
+			GraphBuilder, RDG_EVENT_NAME("AgentForge.TerrainNoise"), Shader, Parameters,
+			FComputeShaderUtils::GetGroupCount(Size, FIntPoint(AgentForgeTerrainShaders::GroupSize2D)));
+	}
+
+	static int32 AddHydraulicPasses(
+		FRDGBuilder& GraphBuilder,
+		FGlobalShaderMap* ShaderMap,
+		const FHydraulicErosionSettings& Settings,
+		const TArray<FVector4f>& Brush,
+		FIntPoint Size,
+		FRDGBufferRef Heights)
+	{
+		const int64 TexelCount = (int64)Size.X * Size.Y;
+		FRDGBufferRef Delta = GraphBuilder.CreateBuffer(
+			FRDGBufferDesc::CreateStructuredDesc(sizeof(int32), (uint32)TexelCount), TEXT("AgentForge.Terrain.ErosionDelta"));
+		AddClearUAVPass(GraphBuilder, GraphBuilder.CreateUAV(Delta), 0u);
+		FRDGBufferRef BrushBuffer = CreateStructuredBuffer(
+			GraphBuilder, TEXT("AgentForge.Terrain.Brush"), sizeof(FVector4f), Brush.Num(),
+			Brush.GetData(), Brush.Num() * sizeof(FVector4f));
+
+		TShaderMapRef<FAgentForgeHydraulicDropletCS> DropletShader(ShaderMap);
+		TShaderMapRef<FAgentForgeHydraulicMergeCS> MergeShader(ShaderMap);
+		const FIntVector MergeGroups = FComputeShaderUtils::GetGroupCount(Size, FIntPoint(AgentForgeTerrainShaders::GroupSize2D));
+
+		// Each batch sees the carving of the batches before it.
+		int32 Batches = 0;
+		for (int32 First = 0; First < Settings.Droplets; First += DropletsPerBatch, ++Batches)
+		{
+			const int32 Count = FMath::Min(DropletsPerBatch, Settings.Droplets - First);
+
+			FAgentForgeHydraulicDropletCS::FParameters* Parameters = GraphBuilder.AllocParameters<FAgentForgeHydraulicDropletCS::FParameters>();
+			Parameters->Size = Size;
+			Parameters->Seed = (uint32)Settings.Seed;
+			Parameters->DropletBase = (uint32)First;
+			Parameters->DropletCount = (uint32)Count;
+			Parameters->MaxLifetime = (uint32)Settings.MaxLifetime;
+			Parameters->BrushRadius = Settings.BrushRadius;
+			Parameters->NumBrushTaps = (uint32)Brush.Num();
+			Parameters->Inertia = Settings.Inertia;
+			Parameters->SedimentCapacityFactor = Settings.SedimentCapacityFactor;
+			Parameters->MinSedimentCapacity = Settings.MinSedimentCapacity;
+			Parameters->ErodeSpeed = Settings.ErodeSpeed;
+			Parameters->DepositSpeed = Settings.DepositSpeed;
+			Parameters->EvaporateSpeed = Settings.EvaporateSpeed;
+			Parameters->Gravity = Settings.Gravity;
+			Parameters->InitialWater = Settings.InitialWater;
+			Parameters->InitialSpeed = Settings.InitialSpeed;
+			Parameters->FixedScale = AgentForgeTerrainShaders::FixedPointScale;
+			Parameters->HeightsIn = GraphBuilder.CreateSRV(Heights);
+			Parameters->BrushTaps = GraphBuilder.CreateSRV(BrushBuffer);
+			Parameters->RWDelta = GraphBuilder.CreateUAV(Delta);
+			FComputeShaderUtils::AddPass(
+				GraphBuilder, RDG_EVENT_NAME("AgentForge.HydraulicDroplets"), DropletShader, Parameters,
+				FComputeShaderUtils::GetGroupCount(Count, AgentForgeTerrainShaders::DropletGroupSize));
+
+			FAgentForgeHydraulicMergeCS::FParameters* MergeParameters = GraphBuilder.AllocParameters<FAgentForgeHydraulicMergeCS::FParameters>();
+			MergeParameters->Size = Size;
+			MergeParameters->FixedScale = AgentForgeTerrainShaders::FixedPointScale;
+			MergeParameters->RWHeights = GraphBuilder.CreateUAV(Heights);
+			MergeParameters->RWDelta = GraphBuilder.CreateUAV(Delta);
+			FComputeShaderUtils::AddPass(
+				GraphBuilder, RDG_EVENT_NAME("AgentForge.HydraulicMerge"), MergeShader, MergeParameters, MergeGroups);
+		}
+		return Batches;
+	}
+
+	static void AddThermalPasses(
+		FRDGBuilder& GraphBuilder,
+		FGlobalShaderMap* ShaderMap,
+		int32 Iterations,
+		float Talus,
+		float Transfer,
+		FIntPoint Size,
+		FRDGBufferRef Heights)
+	{
+		const uint32 TexelCount = (uint32)((int64)Size.X * Size.Y);
+		FRDGBufferRef Outflow = GraphBuilder.CreateBuffer(
+			FRDGBufferDesc::CreateStructuredDesc(sizeof(float), TexelCount), TEXT("AgentForge.Terrain.Outflow"));
+		FRDGBufferRef Target = GraphBuilder.CreateBuffer(
+			FRDGBufferDesc::CreateStructuredDesc(sizeof(int32), TexelCount), TEXT("AgentForge.Terrain.OutflowTarget"));
+
+		TShaderMapRef<FAgentForgeThermalOutflowCS> OutflowShader(ShaderMap);
+		TShaderMapRef<FAgentForgeThermalApplyCS> ApplyShader(ShaderMap);
+		const FIntVector Groups = FComputeShaderUtils::GetGroupCount(Size, FIntPoint(AgentForgeTerrainShaders::GroupSize2D));
+
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			FAgentForgeThermalOutflowCS::FParameters* OutflowParameters = GraphBuilder.AllocParameters<FAgentForgeThermalOutflowCS::FParameters>();
+			OutflowParameters->Size = Size;
+			OutflowParameters->Talus = Talus;
+			OutflowParameters->Transfer = Transfer;
+			OutflowParameters->HeightsIn = GraphBuilder.CreateSRV(Heights);
+			OutflowParameters->RWOutflow = GraphBuilder.CreateUAV(Outflow);
+			OutflowParameters->RWTarget = GraphBuilder.CreateUAV(Target);
+			FComputeShaderUtils::AddPass(
+				GraphBuilder, RDG_EVENT_NAME("AgentForge.ThermalOutflow"), OutflowShader, OutflowParameters, Groups);
+
+			FAgentForgeThermalApplyCS::FParameters* ApplyParameters = GraphBuilder.AllocParameters<FAgentForgeThermalApplyCS::FParameters>();
+			ApplyParameters->Size = Size;
+			ApplyParameters->OutflowIn = GraphBuilder.CreateSRV(Outflow);
+			ApplyParameters->TargetIn = GraphBuilder.CreateSRV(Target);
+			ApplyParameters->RWHeights = GraphBuilder.CreateUAV(Heights);
+			FComputeShaderUtils::AddPass(
+				GraphBuilder, RDG_EVENT_NAME("AgentForge.ThermalApply"), ApplyShader, ApplyParameters, Groups);
+		}
+	}
+}
+
+bool FTerrainGpu::IsAvailable(FString* OutReason)
+{
+	auto Fail = [OutReason](const TCHAR* Reason)
+	{
+		if (OutReason)
+		{
+			*OutReason = Reason;
+		}
+		return false;
+	};
+
+	if (!FApp::CanEverRender() || !GDynamicRHI)
+	{
+		return Fail(TEXT("No RHI (running without rendering)."));
+	}
+	if (GMaxRHIFeatureLevel < ERHIFeatureLevel::SM5)
+	{
+		return Fail(TEXT("RHI feature level below SM5."));
+	}
+	FGlobalShaderMap* ShaderMap = GetGlobalShaderMap(GMaxRHIFeatureLevel);
+	if (!ShaderMap ||
+		!TShaderMapRef<FAgentForgeTerrainNoiseCS>(ShaderMap).IsValid() ||
+		!TShaderMapRef<FAgentForgeThermalOutflowCS>(ShaderMap).IsValid() ||
+		!TShaderMapRef<FAgentForgeThermalApplyCS>(ShaderMap).IsValid() ||
+		!TShaderMapRef<FAgentForgeHydraulicDropletCS>(ShaderMap).IsValid() ||
+		!TShaderMapRef<FAgentForgeHydraulicMergeCS>(ShaderMap).IsValid())
+	{
+		return Fail(TEXT("Terrain compute shaders are not compiled (UEAgentForgeShaders module)."));
+	}
+	return true;
+}
+
+bool FTerrainGpu::Run(const FTerrainGpuJob& Job, TArray<float>& OutHeightmap, FTerrainGpuStats& OutStats, FString& OutError)
+{
+	OutStats = FTerrainGpuStats();
+	FTerrainGpuRun GpuRun;
+	if (!GpuRun.Submit(Job, OutError))
+	{
+		return false;
+	}
+	// Inline callers hold the game thread anyway; the render thread checks the
+	// readback on its own, so this loop never flushes or sleeps.
+	FTerrainGpuRun::EStatus Status = GpuRun.Poll();
+	while (Status == FTerrainGpuRun::EStatus::Pending)
+	{
+		Status = GpuRun.Poll();
+	}
+	OutStats = GpuRun.GetStats();
+	if (Status == FTerrainGpuRun::EStatus::Failed)
+	{
+		OutError = GpuRun.GetError();
+		return false;
+	}
+	OutHeightmap = MoveTemp(GpuRun.GetHeightmap());
+	return true;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  FTerrainGpuRun
+// ─────────────────────────────────────────────────────────────────────────────
+FTerrainGpuRun::~FTerrainGpuRun()
+{
+	ReleaseReadback();
+}
+
+bool FTerrainGpuRun::Submit(const FTerrainGpuJob& Job, FString& OutError)
+{
+	check(IsInGameThread());
+	check(!State.IsValid());
+	if (!FTerrainGpu::IsAvailable(&OutError))
+	{
+		return false;
+	}
+	if (Job.Width < 2 || Job.Height < 2 || Job.Width > FTerrainGpu::MaxResolution || Job.Height > FTerrainGpu::MaxResolution)
+	{
+		OutError = FString::Printf(TEXT("GPU heightmap must be 2..%d texels per side."), FTerrainGpu::MaxResolution);
+		return false;
+	}
+
+	const FIntPoint Size(Job.Width, Job.Height);
+	TexelCount = (uint32)((int64)Job.Width * Job.Height);
+
+	const FGpuNoisePass BasePass = MakeNoisePass(Job.BaseNoise, 1.0f, false);
+	const bool bRidge = Job.RidgeStrength > KINDA_SMALL_NUMBER;
+	const FGpuNoisePass RidgePass = MakeNoisePass(Job.RidgeNoise, FMath::Max(0.0f, Job.RidgeStrength), true);
+
+	const FHydraulicErosionSettings Hydraulic = Job.Hydraulic.Sanitized();
+	const bool bHydraulic = Job.bHydraulic && Hydraulic.Droplets > 0;
+	TArray<FVector4f> Brush;
+	if (bHydraulic)
+	{
+		BuildBrushTaps(Hydraulic.BrushRadius, Brush);
+	}
+
+	// Thermal parameters mirror FTerrainGenerator::ApplyErosion.
+	const int32 ThermalSteps = Job.bThermal ? FMath::Clamp(Job.ThermalIterations, 0, 256) : 0;
+	const float ThermalStrength = FMath::Clamp(Job.ThermalStrength, 0.0f, 1.0f);
+	const bool bThermal = ThermalSteps > 0 && ThermalStrength > KINDA_SMALL_NUMBER;
+	const float Talus = FMath::Max(0.0001f, FMath::Lerp(0.06f, 0.01f, ThermalStrength));
+	const float Transfer = 0.5f * ThermalStrength;
+
+	State = MakeShared<FTerrainReadbackState, ESPMode::ThreadSafe>();
+	State->Readback = MakeUnique<FRHIGPUBufferReadback>(TEXT("AgentForge.Terrain.Readback"));
+
+	Stats = FTerrainGpuStats();
+	Stats.DropletsSimulated = bHydraulic ? Hydraulic.Droplets : 0;
+	Stats.HydraulicBatches = bHydraulic ? FMath::DivideAndRoundUp(Hydraulic.Droplets, DropletsPerBatch) : 0;
+	Stats.ThermalIterations = bThermal ? ThermalSteps : 0;
+
+	StartSeconds = FPlatformTime::Seconds();
+	Status = EStatus::Pending;
+	ENQUEUE_RENDER_COMMAND(AgentForgeTerrainGpu)(
+		[State = State, Size, TexelCount = TexelCount, BasePass, bRidge, RidgePass, bHydraulic, Hydraulic, Brush, bThermal, ThermalSteps, Talus, Transfer]
+		(FRHICommandListImmediate& RHICmdList)
+	{
+		FRDGBuilder GraphBuilder(RHICmdList);
+		FGlobalShaderMap* ShaderMap = GetGlobalShaderMap(GMaxRHIFeatureLevel);
+		FRDGBufferRef Heights = GraphBuilder.CreateBuffer(
+			FRDGBufferDesc::CreateStructuredDesc(sizeof(float), TexelCount), TEXT("AgentForge.Terrain.Heights"));
+
+		AddNoisePass(GraphBuilder, ShaderMap, BasePass, Size, Heights);
+		if (bRidge)
+		{
+			AddNoisePass(GraphBuilder, ShaderMap, RidgePass, Size, Heights);
+		}
+		if (bHydraulic)
+		{
+			AddHydraulicPasses(GraphBuilder, ShaderMap, Hydraulic, Brush, Size, Heights);
+		}
+		if (bThermal)
+		{
+			AddThermalPasses(GraphBuilder, ShaderMap, ThermalSteps, Talus, Transfer, Size, Heights);
+		}
+
+		AddEnqueueCopyPass(GraphBuilder, State->Readback.Get(), Heights, TexelCount * sizeof(float));
+		GraphBuilder.Execute();
+		// Submit now rather than at frame end: an inline caller holds the game
+		// thread, so the frame that would submit this may be a while off.
+		RHICmdList.ImmediateFlush(EImmediateFlushType::DispatchToRHIThread);
+	});
+	return true;
+}
+
+FTerrainGpuRun::EStatus FTerrainGpuRun::Poll()
+{
+	check(IsInGameThread());
+	if (Status != EStatus::Pending)
+	{
+		return Status;
+	}
+
+	if (State->bDone)
+	{
+		Stats.GpuMs = (FPlatformTime::Seconds() - StartSeconds) * 1000.0;
+		Heightmap = MoveTemp(State->Heights);
+		ReleaseReadback();
+		Status = EStatus::Succeeded;
+		return Status;
+	}
+	if (FPlatformTime::Seconds() - StartSeconds > ReadbackTimeoutSeconds)
+	{
+		Stats.GpuMs = (FPlatformTime::Seconds() - StartSeconds) * 1000.0;
+		Error = FString::Printf(TEXT("GPU terrain readback timed out after %.0f s."), ReadbackTimeoutSeconds);
+		ReleaseReadback();
+		Status = EStatus::Failed;
+		return Status;
+	}
+
+	// At most one check in flight; the game thread only reads bDone.
+	if (!State->bCheckQueued.exchange(true))
+	{
+		ENQUEUE_RENDER_COMMAND(AgentForgeTerrainGpuPoll)([State = State, TexelCount = TexelCount](FRHICommandListImmediate&)
+		{
+			if (!State->bDone && State->Readback->IsReady())
+			{
+				const float* Data = static_cast<const float*>(State->Readback->Lock(TexelCount * sizeof(float)));
+				State->Heights.SetNumUninitialized(TexelCount);
+				FMemory::Memcpy(State->Heights.GetData(), Data, TexelCount * sizeof(float));
+				State->Readback->Unlock();
+				State->bDone = true;
+			}
+			State->bCheckQueued.store(false);
+		});
+	}
+	return EStatus::Pending;
+}
+
+void FTerrainGpuRun::ReleaseReadback()
+{
+	if (!State.IsValid())
+	{
+		return;
+	}
+	// Readback RHI resources are released on the render thread.
+	ENQUEUE_RENDER_COMMAND(AgentForgeTerrainGpuRelease)([State = MoveTemp(State)](FRHICommandListImmediate&)
+	{
+		State->Readback.Reset();
+	});
+	State.Reset();
+}
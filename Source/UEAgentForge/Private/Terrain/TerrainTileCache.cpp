@@ -0,0 +1,109 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// TerrainTileCache.cpp - raw float tile files with rectangle reads.
+
+#include "Terrain/TerrainTileCache.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+#include "Serialization/Archive.h"
+
+namespace
+{
+	static constexpr uint32 TileMagic = 0x31544641;   // "AFT1"
+	static constexpr int64  HeaderBytes = sizeof(uint32) + sizeof(int32) * 2;
+
+	static bool ReadHeader(FArchive& Reader, int32& OutWidth, int32& OutHeight)
+	{
+		uint32 Magic = 0;
+		Reader << Magic;
+		Reader << OutWidth;
+		Reader << OutHeight;
+		return !Reader.IsError() && Magic == TileMagic && OutWidth > 0 && OutHeight > 0 &&
+			Reader.TotalSize() >= HeaderBytes + (int64)OutWidth * OutHeight * (int64)sizeof(float);
+	}
+}
+
+FTerrainTileCache::FTerrainTileCache(const FString& InDirectory)
+	: Directory(InDirectory)
+{
+	IFileManager::Get().MakeDirectory(*Directory, true);
+}
+
+FString FTerrainTileCache::DefaultRoot()
+{
+	return FPaths::ProjectSavedDir() / TEXT("AgentForge/TerrainTiles/");
+}
+
+FString FTerrainTileCache::TileName(const TCHAR* Prefix, int32 TileX, int32 TileY)
+{
+	return FString::Printf(TEXT("%s_%d_%d.r32"), Prefix, TileX, TileY);
+}
+
+FString FTerrainTileCache::GetPath(const FString& Name) const
+{
+	return FPaths::Combine(Directory, Name);
+}
+
+bool FTerrainTileCache::WriteTile(const FString& Name, int32 Width, int32 Height, const TArray<float>& Heights) const
+{
+	if (Width <= 0 || Height <= 0 || Heights.Num() != Width * Height)
+	{
+		return false;
+	}
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*GetPath(Name)));
+	if (!Writer)
+	{
+		return false;
+	}
+	uint32 Magic = TileMagic;
+	*Writer << Magic;
+	*Writer << Width;
+	*Writer << Height;
+	Writer->Serialize(const_cast<float*>(Heights.GetData()), (int64)Heights.Num() * sizeof(float));
+	return Writer->Close();
+}
+
+bool FTerrainTileCache::ReadTile(const FString& Name, int32& OutWidth, int32& OutHeight, TArray<float>& OutHeights) const
+{
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*GetPath(Name)));
+	if (!Reader || !ReadHeader(*Reader, OutWidth, OutHeight))
+	{
+		return false;
+	}
+	OutHeights.SetNumUninitialized(OutWidth * OutHeight);
+	Reader->Serialize(OutHeights.GetData(), (int64)OutHeights.Num() * sizeof(float));
+	return !Reader->IsError();
+}
+
+bool FTerrainTileCache::ReadRect(const FString& Name, FIntPoint Min, FIntPoint Size, TArray<float>& OutHeights) const
+{
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*GetPath(Name)));
+	int32 Width = 0;
+	int32 Height = 0;
+	if (!Reader || !ReadHeader(*Reader, Width, Height))
+	{
+		return false;
+	}
+	if (Min.X < 0 || Min.Y < 0 || Size.X <= 0 || Size.Y <= 0 || Min.X + Size.X > Width || Min.Y + Size.Y > Height)
+	{
+		return false;
+	}
+
+	OutHeights.SetNumUninitialized(Size.X * Size.Y);
+	for (int32 Row = 0; Row < Size.Y; ++Row)
+	{
+		Reader->Seek(HeaderBytes + ((int64)(Min.Y + Row) * Width + Min.X) * (int64)sizeof(float));
+		Reader->Serialize(OutHeights.GetData() + (int64)Row * Size.X, (int64)Size.X * sizeof(float));
+	}
+	return !Reader->IsError();
+}
+
+bool FTerrainTileCache::Exists(const FString& Name) const
+{
+	return IFileManager::Get().FileExists(*GetPath(Name));
+}
+
+void FTerrainTileCache::Delete(const FString& Name) const
+{
+	IFileManager::Get().Delete(*GetPath(Name), false, false, true);
+}
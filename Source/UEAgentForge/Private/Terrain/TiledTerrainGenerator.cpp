@@ -0,0 +1,407 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// TiledTerrainGenerator.cpp - halo tiles, parallel waves, tent-weight stitching.
+
+#include "Terrain/TiledTerrainGenerator.h"
+#include "Terrain/TerrainGenerator.h"
+#include "Terrain/TerrainTileCache.h"
+
+#include "Async/ParallelFor.h"
+#include "Dom/JsonObject.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Misc/Crc.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace
+{
+	static const TCHAR* ManifestSchema = TEXT("terrain_tiles_v1");
+	static const TCHAR* ManifestName = TEXT("manifest.json");
+
+	// Padded tiles held in memory at once, across a wave.
+	static constexpr int64 WaveTexelBudget = 64ll * 1024 * 1024;
+	static constexpr int32 MaxWaveTiles = 8;
+
+	struct FTileGeometry
+	{
+		FIntRect Core;       // texels this tile owns in the final map
+		FIntRect Padded;     // generated and eroded: core + halo
+		FIntRect Extended;   // saved for stitching: core + blend
+	};
+
+	static FIntRect ClampToMap(const FIntRect& Rect, int32 Width, int32 Height)
+	{
+		return FIntRect(
+			FMath::Max(Rect.Min.X, 0), FMath::Max(Rect.Min.Y, 0),
+			FMath::Min(Rect.Max.X, Width), FMath::Min(Rect.Max.Y, Height));
+	}
+
+	static FTileGeometry MakeTileGeometry(const FTiledTerrainSettings& Settings, int32 TileX, int32 TileY, int32 Halo)
+	{
+		FTileGeometry Geometry;
+		Geometry.Core = ClampToMap(
+			FIntRect(TileX * Settings.TileSize, TileY * Settings.TileSize, (TileX + 1) * Settings.TileSize, (TileY + 1) * Settings.TileSize),
+			Settings.Width, Settings.Height);
+		Geometry.Padded = ClampToMap(
+			FIntRect(Geometry.Core.Min - FIntPoint(Halo), Geometry.Core.Max + FIntPoint(Halo)),
+			Settings.Width, Settings.Height);
+		Geometry.Extended = ClampToMap(
+			FIntRect(Geometry.Core.Min - FIntPoint(Settings.Blend), Geometry.Core.Max + FIntPoint(Settings.Blend)),
+			Settings.Width, Settings.Height);
+		return Geometry;
+	}
+
+	/**
+	 * Tent weight of a tile at map coordinate Coord along one axis. Ramps over
+	 * [CoreMin - Blend, CoreMin + Blend] and mirrored at CoreMax, so adjacent
+	 * tiles sum to exactly one; sides on the map edge stay at one.
+	 */
+	static float BlendWeight(int32 Coord, int32 CoreMin, int32 CoreMax, int32 Blend, int32 MapSize)
+	{
+		if (Blend <= 0)
+		{
+			return (Coord >= CoreMin && Coord < CoreMax) ? 1.0f : 0.0f;
+		}
+		const float Span = 2.0f * (float)Blend;
+		float Weight = 1.0f;
+		if (CoreMin > 0)
+		{
+			Weight = FMath::Min(Weight, ((float)(Coord - (CoreMin - Blend)) + 0.5f) / Span);
+		}
+		if (CoreMax < MapSize)
+		{
+			Weight = FMath::Min(Weight, ((float)((CoreMax + Blend) - Coord) - 0.5f) / Span);
+		}
+		return FMath::Clamp(Weight, 0.0f, 1.0f);
+	}
+
+	static void AppendNoiseKey(FString& Out, const FHeightmapNoiseSettings& Noise)
+	{
+		Out += FString::Printf(TEXT("|%d,%d,%.9g,%.9g,%d,%.9g,%.9g,%.9g,%.9g"),
+			(int32)Noise.Type, Noise.Seed, Noise.Frequency, Noise.Amplitude, Noise.Octaves,
+			Noise.Lacunarity, Noise.Gain, Noise.WarpStrength, Noise.WarpFrequency);
+	}
+
+	static FString MakeCacheKey(const FTiledTerrainSettings& Settings)
+	{
+		FString Source = FString::Printf(TEXT("%s|%d,%d,%d,%d"), ManifestSchema, Settings.Width, Settings.Height, Settings.TileSize, Settings.Blend);
+		AppendNoiseKey(Source, Settings.BaseNoise);
+		AppendNoiseKey(Source, Settings.RidgeNoise);
+		Source += FString::Printf(TEXT("|%.9g"), Settings.RidgeStrength);
+		if (Settings.bHydraulic)
+		{
+			const FHydraulicErosionSettings& H = Settings.Hydraulic;
+			Source += FString::Printf(TEXT("|h%d,%d,%d,%d,%d,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g"),
+				H.Seed, H.Droplets, H.Batches, H.MaxLifetime, H.BrushRadius, H.Inertia, H.SedimentCapacityFactor,
+				H.MinSedimentCapacity, H.ErodeSpeed, H.DepositSpeed, H.EvaporateSpeed, H.Gravity, H.InitialWater, H.InitialSpeed);
+		}
+		if (Settings.bThermal)
+		{
+			Source += FString::Printf(TEXT("|t%d,%.9g"), Settings.ThermalIterations, Settings.ThermalStrength);
+		}
+		return FString::Printf(TEXT("%dx%d_%08x"), Settings.Width, Settings.Height, FCrc::StrCrc32(*Source));
+	}
+
+	static bool LoadCompleteManifest(const FString& Path, const FString& Key, FTiledTerrainResult& OutResult)
+	{
+		FString Text;
+		if (!FFileHelper::LoadFileToString(Text, *Path))
+		{
+			return false;
+		}
+		TSharedPtr<FJsonObject> Manifest;
+		const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Text);
+		if (!FJsonSerializer::Deserialize(Reader, Manifest) || !Manifest.IsValid())
+		{
+			return false;
+		}
+		bool bComplete = false;
+		FString StoredKey;
+		if (!Manifest->TryGetBoolField(TEXT("complete"), bComplete) || !bComplete ||
+			!Manifest->TryGetStringField(TEXT("key"), StoredKey) || StoredKey != Key)
+		{
+			return false;
+		}
+		OutResult.RawMin = (float)Manifest->GetNumberField(TEXT("raw_min"));
+		OutResult.RawMax = (float)Manifest->GetNumberField(TEXT("raw_max"));
+		OutResult.RawAvg = (float)Manifest->GetNumberField(TEXT("raw_avg"));
+		OutResult.DropletsSimulated = (int64)Manifest->GetNumberField(TEXT("droplets_simulated"));
+		return true;
+	}
+
+	static bool SaveManifest(const FString& Path, const FTiledTerrainSettings& Settings, const FTiledTerrainResult& Result)
+	{
+		TSharedPtr<FJsonObject> Manifest = MakeShared<FJsonObject>();
+		Manifest->SetStringField(TEXT("schema"), ManifestSchema);
+		Manifest->SetStringField(TEXT("key"), Result.Key);
+		Manifest->SetNumberField(TEXT("width"), Settings.Width);
+		Manifest->SetNumberField(TEXT("height"), Settings.Height);
+		Manifest->SetNumberField(TEXT("tile_size"), Result.TileSize);
+		Manifest->SetNumberField(TEXT("tiles_x"), Result.TilesX);
+		Manifest->SetNumberField(TEXT("tiles_y"), Result.TilesY);
+		Manifest->SetNumberField(TEXT("halo"), Result.Halo);
+		Manifest->SetNumberField(TEXT("blend"), Result.Blend);
+		Manifest->SetStringField(TEXT("tile_pattern"), TEXT("tile_{x}_{y}.r32"));
+		Manifest->SetStringField(TEXT("format"), TEXT("r32f_le"));
+		Manifest->SetNumberField(TEXT("raw_min"), Result.RawMin);
+		Manifest->SetNumberField(TEXT("raw_max"), Result.RawMax);
+		Manifest->SetNumberField(TEXT("raw_avg"), Result.RawAvg);
+		Manifest->SetNumberField(TEXT("droplets_simulated"), (double)Result.DropletsSimulated);
+		Manifest->SetBoolField(TEXT("complete"), true);
+
+		FString Text;
+		const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Text);
+		FJsonSerializer::Serialize(Manifest.ToSharedRef(), Writer);
+		return FFileHelper::SaveStringToFile(Text, *Path);
+	}
+
+	static int32 WaveSizeFor(int64 TexelsPerTile)
+	{
+		return (int32)FMath::Clamp<int64>(WaveTexelBudget / FMath::Max<int64>(TexelsPerTile, 1), 1, MaxWaveTiles);
+	}
+}
+
+bool FTiledTerrainGenerator::Generate(const FTiledTerrainSettings& InSettings, FTiledTerrainResult& OutResult, FString& OutError)
+{
+	FTiledTerrainSettings Settings = InSettings;
+	Settings.Width = FMath::Clamp(Settings.Width, 2, MaxResolution);
+	Settings.Height = FMath::Clamp(Settings.Height, 2, MaxResolution);
+	Settings.TileSize = FMath::Clamp(Settings.TileSize, 256, 4096);
+	Settings.Blend = FMath::Clamp(Settings.Blend, 0, Settings.TileSize / 4);
+	Settings.BaseNoise = Settings.BaseNoise.Sanitized();
+	Settings.RidgeNoise = Settings.RidgeNoise.Sanitized();
+	Settings.Hydraulic = Settings.Hydraulic.Sanitized();
+	Settings.ThermalIterations = FMath::Clamp(Settings.ThermalIterations, 0, 256);
+	Settings.ThermalStrength = FMath::Clamp(Settings.ThermalStrength, 0.0f, 1.0f);
+	Settings.bHydraulic = Settings.bHydraulic && Settings.Hydraulic.Droplets > 0;
+	Settings.bThermal = Settings.bThermal && Settings.ThermalIterations > 0 && Settings.ThermalStrength > KINDA_SMALL_NUMBER;
+
+	// Erosion reach: thermal moves material one texel per pass, a droplet
+	// travels MaxLifetime texels and erodes BrushRadius around its path.
+	int32 Reach = 0;
+	if (Settings.bThermal)
+	{
+		Reach += Settings.ThermalIterations + 1;
+	}
+	if (Settings.bHydraulic)
+	{
+		Reach += Settings.Hydraulic.MaxLifetime + Settings.Hydraulic.BrushRadius + 2;
+	}
+
+	FTiledTerrainResult Result;
+	Result.Key = MakeCacheKey(Settings);
+	Result.CacheDirectory = (Settings.CacheRoot.IsEmpty() ? FTerrainTileCache::DefaultRoot() : Settings.CacheRoot) / Result.Key;
+	Result.ManifestPath = FPaths::Combine(Result.CacheDirectory, ManifestName);
+	Result.TilesX = FMath::DivideAndRoundUp(Settings.Width, Settings.TileSize);
+	Result.TilesY = FMath::DivideAndRoundUp(Settings.Height, Settings.TileSize);
+	Result.TileSize = Settings.TileSize;
+	Result.Blend = Settings.Blend;
+	Result.Halo = Settings.Blend + Reach;
+
+	if (LoadCompleteManifest(Result.ManifestPath, Result.Key, Result))
+	{
+		Result.bCacheHit = true;
+		OutResult = Result;
+		return true;
+	}
+
+	const FTerrainTileCache Cache(Result.CacheDirectory);
+	const int32 NumTiles = Result.TilesX * Result.TilesY;
+	const int64 MapTexels = (int64)Settings.Width * Settings.Height;
+	const double DropletDensity = Settings.bHydraulic ? (double)Settings.Hydraulic.Droplets / (double)MapTexels : 0.0;
+
+	// ─── Phase 1: generate + erode padded tiles, keep core + blend ───────────
+
+	const double GenerateStart = FPlatformTime::Seconds();
+	const int64 PaddedSide = (int64)Settings.TileSize + 2 * Result.Halo;
+	const int32 GenerateWave = WaveSizeFor(PaddedSide * PaddedSide * 2);
+
+	TArray<int64> TileDroplets;
+	TileDroplets.SetNumZeroed(NumTiles);
+	FThreadSafeBool bFailed = false;
+
+	for (int32 WaveStart = 0; WaveStart < NumTiles && !bFailed; WaveStart += GenerateWave)
+	{
+		const int32 WaveCount = FMath::Min(GenerateWave, NumTiles - WaveStart);
+		ParallelFor(WaveCount, [&](int32 WaveIndex)
+		{
+			const int32 TileIndex = WaveStart + WaveIndex;
+			const int32 TileX = TileIndex % Result.TilesX;
+			const int32 TileY = TileIndex / Result.TilesX;
+			const FTileGeometry Geometry = MakeTileGeometry(Settings, TileX, TileY, Result.Halo);
+			const FIntPoint PadSize = Geometry.Padded.Size();
+
+			TArray<float> Heights;
+			FHeightmapNoise::Fill(Settings.BaseNoise, PadSize.X, PadSize.Y, Heights, Geometry.Padded.Min);
+			FTerrainGenerator::ApplyRidgedNoise(Heights, PadSize.X, PadSize.Y, Settings.RidgeNoise, Settings.RidgeStrength);
+			if (Settings.bHydraulic)
+			{
+				FHydraulicErosionSettings TileHydraulic = Settings.Hydraulic;
+				TileHydraulic.Seed = (int32)HashCombine((uint32)Settings.Hydraulic.Seed, HashCombine((uint32)TileX, (uint32)TileY));
+				TileHydraulic.Droplets = (int32)FMath::Min<double>(DropletDensity * (double)PadSize.X * (double)PadSize.Y, 8000000.0);
+				TileDroplets[TileIndex] = FTerrainGenerator::ApplyHydraulicErosion(Heights, PadSize.X, PadSize.Y, TileHydraulic);
+			}
+			if (Settings.bThermal)
+			{
+				// Fixed pass count: an early exit would differ between neighbours and open seams.
+				FTerrainGenerator::ApplyErosion(Heights, PadSize.X, PadSize.Y, Settings.ThermalIterations, Settings.ThermalStrength, 0.0f);
+			}
+
+			const FIntPoint ExtSize = Geometry.Extended.Size();
+			const FIntPoint ExtOffset = Geometry.Extended.Min - Geometry.Padded.Min;
+			TArray<float> Extended;
+			Extended.SetNumUninitialized(ExtSize.X * ExtSize.Y);
+			for (int32 Y = 0; Y < ExtSize.Y; ++Y)
+			{
+				FMemory::Memcpy(
+					Extended.GetData() + (int64)Y * ExtSize.X,
+					Heights.GetData() + (int64)(ExtOffset.Y + Y) * PadSize.X + ExtOffset.X,
+					ExtSize.X * sizeof(float));
+			}
+			if (!Cache.WriteTile(FTerrainTileCache::TileName(TEXT("ext"), TileX, TileY), ExtSize.X, ExtSize.Y, Extended))
+			{
+				bFailed = true;
+			}
+		});
+	}
+	Result.GenerateMs = (FPlatformTime::Seconds() - GenerateStart) * 1000.0;
+	if (bFailed)
+	{
+		OutError = FString::Printf(TEXT("Failed to write terrain tiles to %s."), *Result.CacheDirectory);
+		return false;
+	}
+	for (const int64 Droplets : TileDroplets)
+	{
+		Result.DropletsSimulated += Droplets;
+	}
+
+	// ─── Phase 2: stitch cores from the 3x3 neighbourhood ───────────────────
+
+	const double StitchStart = FPlatformTime::Seconds();
+	const int32 StitchWave = WaveSizeFor((int64)Settings.TileSize * Settings.TileSize * 3);
+
+	TArray<float> TileMin;
+	TArray<float> TileMax;
+	TArray<double> TileSum;
+	TileMin.SetNumUninitialized(NumTiles);
+	TileMax.SetNumUninitialized(NumTiles);
+	TileSum.SetNumZeroed(NumTiles);
+
+	for (int32 WaveStart = 0; WaveStart < NumTiles && !bFailed; WaveStart += StitchWave)
+	{
+		const int32 WaveCount = FMath::Min(StitchWave, NumTiles - WaveStart);
+		ParallelFor(WaveCount, [&](int32 WaveIndex)
+		{
+			const int32 TileIndex = WaveStart + WaveIndex;
+			const int32 TileX = TileIndex % Result.TilesX;
+			const int32 TileY = TileIndex / Result.TilesX;
+			const FTileGeometry Geometry = MakeTileGeometry(Settings, TileX, TileY, Result.Halo);
+			const FIntPoint CoreSize = Geometry.Core.Size();
+
+			TArray<float> Sum;
+			TArray<float> WeightSum;
+			Sum.SetNumZeroed(CoreSize.X * CoreSize.Y);
+			WeightSum.SetNumZeroed(CoreSize.X * CoreSize.Y);
+
+			TArray<float> Rect;
+			TArray<float> WeightX;
+			for (int32 NY = FMath::Max(TileY - 1, 0); NY <= FMath::Min(TileY + 1, Result.TilesY - 1); ++NY)
+			{
+				for (int32 NX = FMath::Max(TileX - 1, 0); NX <= FMath::Min(TileX + 1, Result.TilesX - 1); ++NX)
+				{
+					const FTileGeometry Neighbor = MakeTileGeometry(Settings, NX, NY, Result.Halo);
+					const FIntRect Overlap(
+						Neighbor.Extended.Min.ComponentMax(Geometry.Core.Min),
+						Neighbor.Extended.Max.ComponentMin(Geometry.Core.Max));
+					if (Overlap.Width() <= 0 || Overlap.Height() <= 0)
+					{
+						continue;
+					}
+					if (!Cache.ReadRect(FTerrainTileCache::TileName(TEXT("ext"), NX, NY), Overlap.Min - Neighbor.Extended.Min, Overlap.Size(), Rect))
+					{
+						bFailed = true;
+						return;
+					}
+
+					WeightX.SetNumUninitialized(Overlap.Width(), EAllowShrinking::No);
+					for (int32 X = 0; X < Overlap.Width(); ++X)
+					{
+						WeightX[X] = BlendWeight(Overlap.Min.X + X, Neighbor.Core.Min.X, Neighbor.Core.Max.X, Settings.Blend, Settings.Width);
+					}
+					for (int32 Y = 0; Y < Overlap.Height(); ++Y)
+					{
+						const float WeightY = BlendWeight(Overlap.Min.Y + Y, Neighbor.Core.Min.Y, Neighbor.Core.Max.Y, Settings.Blend, Settings.Height);
+						if (WeightY <= 0.0f)
+						{
+							continue;
+						}
+						const float* Src = Rect.GetData() + (int64)Y * Overlap.Width();
+						const int64 DstRow = (int64)(Overlap.Min.Y - Geometry.Core.Min.Y + Y) * CoreSize.X + (Overlap.Min.X - Geometry.Core.Min.X);
+						for (int32 X = 0; X < Overlap.Width(); ++X)
+						{
+							const float Weight = WeightX[X] * WeightY;
+							Sum[DstRow + X] += Src[X] * Weight;
+							WeightSum[DstRow + X] += Weight;
+						}
+					}
+				}
+			}
+
+			float MinValue = TNumericLimits<float>::Max();
+			float MaxValue = TNumericLimits<float>::Lowest();
+			double Total = 0.0;
+			for (int32 Index = 0; Index < Sum.Num(); ++Index)
+			{
+				const float Value = WeightSum[Index] > 0.0f ? Sum[Index] / WeightSum[Index] : 0.0f;
+				Sum[Index] = Value;
+				MinValue = FMath::Min(MinValue, Value);
+				MaxValue = FMath::Max(MaxValue, Value);
+				Total += Value;
+			}
+			TileMin[TileIndex] = MinValue;
+			TileMax[TileIndex] = MaxValue;
+			TileSum[TileIndex] = Total;
+
+			if (!Cache.WriteTile(FTerrainTileCache::TileName(TEXT("tile"), TileX, TileY), CoreSize.X, CoreSize.Y, Sum))
+			{
+				bFailed = true;
+			}
+		});
+	}
+	Result.StitchMs = (FPlatformTime::Seconds() - StitchStart) * 1000.0;
+
+	for (int32 TileY = 0; TileY < Result.TilesY; ++TileY)
+	{
+		for (int32 TileX = 0; TileX < Result.TilesX; ++TileX)
+		{
+			Cache.Delete(FTerrainTileCache::TileName(TEXT("ext"), TileX, TileY));
+		}
+	}
+	if (bFailed)
+	{
+		OutError = FString::Printf(TEXT("Failed to stitch terrain tiles in %s."), *Result.CacheDirectory);
+		return false;
+	}
+
+	Result.RawMin = TNumericLimits<float>::Max();
+	Result.RawMax = TNumericLimits<float>::Lowest();
+	double Total = 0.0;
+	for (int32 TileIndex = 0; TileIndex < NumTiles; ++TileIndex)
+	{
+		Result.RawMin = FMath::Min(Result.RawMin, TileMin[TileIndex]);
+		Result.RawMax = FMath::Max(Result.RawMax, TileMax[TileIndex]);
+		Total += TileSum[TileIndex];
+	}
+	Result.RawAvg = (float)(Total / (double)MapTexels);
+
+	if (!SaveManifest(Result.ManifestPath, Settings, Result))
+	{
+		OutError = FString::Printf(TEXT("Failed to write %s."), *Result.ManifestPath);
+		return false;
+	}
+	OutResult = Result;
+	return true;
+}
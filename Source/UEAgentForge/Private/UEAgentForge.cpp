@@ -1,6 +1,17 @@
 #include "Modules/ModuleManager.h"
 #include "ConstitutionParser.h"
 #include "AgentForgeLibrary.h"
+#include "AgentForgeCommandQueue.h"
+#include "AgentForgeCommandTrace.h"
+#include "AgentForgeMemoryMonitor.h"
+#include "AgentForgeActorIndex.h"
+#include "AgentForgeAssetCatalog.h"
+#include "AgentForgeSocketServer.h"
+#include "AgentForgeWorldSnapshot.h"
+#include "LevelPresetSystem.h"
+#include "UI/ForgeToolsPanel.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
 #include "Misc/CoreDelegates.h"
 
 #if WITH_EDITOR
@@ -43,6 +54,48 @@ public:
 			}
 		}
 
+		// Build the command registry once so dispatch is a single hash lookup.
+		UAgentForgeLibrary::RegisterBuiltinCommands();
+
+		// Off-thread requests are drained from this queue once per editor tick.
+		FAgentForgeCommandQueue::Get().Initialize();
+
+		// Sampled memory pressure for the command guard; GCs it asks for run between commands.
+		FAgentForgeMemoryMonitor::Get().Initialize();
+
+		// Label / name / path / tag lookups; built on first use, kept current from editor events.
+		FAgentForgeActorIndex::Get().Initialize();
+
+		// get_available_* indices; each kind builds on its first query, kept current from registry events.
+		FAgentForgeAssetCatalog::Get().Initialize();
+
+		// Forge Tools editor UI: Tools > Debug > AgentForge Performance (AgentForge.PerfDashboard).
+		FForgeToolsPanel::Initialize();
+
+		// Optional persistent socket transport: -AgentForgeSocketPort=30020
+		int32 SocketPort = 0;
+		if (FParse::Value(FCommandLine::Get(), TEXT("AgentForgeSocketPort="), SocketPort) && SocketPort > 0)
+		{
+			FString SocketError;
+			if (!FAgentForgeSocketServer::Get().Start(SocketPort, TEXT("127.0.0.1"), SocketError))
+			{
+				UE_LOG(LogTemp, Warning, TEXT("[UEAgentForge] Socket server not started: %s"), *SocketError);
+			}
+		}
+
+		// Optional command trace from the first request on: -AgentForgeTraceRecord=<path>
+		FString TracePath;
+		if (FParse::Value(FCommandLine::Get(), TEXT("AgentForgeTraceRecord="), TracePath) && !TracePath.IsEmpty())
+		{
+			FAgentForgeTraceRecordSettings TraceSettings;
+			TraceSettings.Path = TracePath;
+			FString TraceError;
+			if (!FAgentForgeCommandTrace::Get().Start(TraceSettings, TraceError))
+			{
+				UE_LOG(LogTemp, Warning, TEXT("[UEAgentForge] Command trace not started: %s"), *TraceError);
+			}
+		}
+
 		PreExitHandle = FCoreDelegates::OnPreExit.AddRaw(this, &FUEAgentForgeModule::HandleEnginePreExit);
 		EnginePreExitHandle = FCoreDelegates::OnEnginePreExit.AddRaw(this, &FUEAgentForgeModule::HandleEnginePreExit);
 #endif
@@ -72,6 +125,15 @@ private:
 		if (GShutdownRequested) { return; }
 		GShutdownRequested = true;
 		UAgentForgeLibrary::MarkEngineShuttingDown();
+		// Write the trace's last block.
+		FAgentForgeCommandTrace::Get().Stop();
+		// Close the dashboard tab spawner while Slate is still up; its widget reads the singletons below.
+		FForgeToolsPanel::Shutdown();
+		FAgentForgeMemoryMonitor::Get().Shutdown();
+		// Snapshots are written on the thread pool; let queued files land before it goes away.
+		FAgentForgeSnapshotStore::Get().Flush();
+		// Release the preset folder watches while the DirectoryWatcher module is still loaded.
+		FLevelPresetSystem::ShutdownPresetStore();
 	}
 
 	FDelegateHandle PreExitHandle;
@@ -0,0 +1,581 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// ForgePerfDashboard.cpp — Slate dashboard over the bridge's metrics and stats.
+
+#include "UI/ForgePerfDashboard.h"
+
+#include "AgentForgeCommandMetrics.h"
+#include "AgentForgeCommandQueue.h"
+#include "AgentForgeCommandTrace.h"
+#include "AgentForgeJobManager.h"
+#include "AgentForgeMemoryMonitor.h"
+#include "AgentForgeProceduralCache.h"
+#include "LLM/AgentForgeLLMCache.h"
+#include "LLM/AgentForgeLLMSubsystem.h"
+#include "LLM/AgentForgeVisionCache.h"
+
+#include "Dom/JsonValue.h"
+#include "Editor.h"
+#include "HAL/PlatformTime.h"
+#include "Rendering/DrawElements.h"
+#include "Styling/AppStyle.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Layout/SBorder.h"
+#include "Widgets/Layout/SBox.h"
+#include "Widgets/Layout/SGridPanel.h"
+#include "Widgets/Layout/SScrollBox.h"
+#include "Widgets/Layout/SSeparator.h"
+#include "Widgets/Notifications/SProgressBar.h"
+#include "Widgets/SBoxPanel.h"
+#include "Widgets/SLeafWidget.h"
+#include "Widgets/Text/STextBlock.h"
+#include "Widgets/Views/SHeaderRow.h"
+#include "Widgets/Views/STableRow.h"
+
+#define LOCTEXT_NAMESPACE "ForgePerfDashboard"
+
+namespace
+{
+	static const FName ColCommand  (TEXT("Command"));
+	static const FName ColRate     (TEXT("Rate"));
+	static const FName ColCalls    (TEXT("Calls"));
+	static const FName ColErrors   (TEXT("Errors"));
+	static const FName ColP50      (TEXT("P50"));
+	static const FName ColP95      (TEXT("P95"));
+	static const FName ColP99      (TEXT("P99"));
+	static const FName ColHistogram(TEXT("Histogram"));
+
+	static const FLinearColor FastColor(0.25f, 0.75f, 0.35f);
+	static const FLinearColor SlowColor(0.95f, 0.70f, 0.15f);
+	static const FLinearColor StallColor(0.90f, 0.25f, 0.20f);
+
+	/** Bars above one frame at 60 Hz are amber, above 100 ms red: that is where the editor visibly stalls. */
+	static FLinearColor LatencyColor(double Ms)
+	{
+		return Ms <= 16.7 ? FastColor : (Ms <= 100.0 ? SlowColor : StallColor);
+	}
+
+	static FText MsText(double Ms)
+	{
+		return FText::FromString(Ms < 10.0 ? FString::Printf(TEXT("%.2f"), Ms) : FString::Printf(TEXT("%.0f"), Ms));
+	}
+
+	static double NumberOr(const TSharedPtr<FJsonObject>& Obj, const TCHAR* Field, double Default = 0.0)
+	{
+		double Value = Default;
+		return Obj.IsValid() && Obj->TryGetNumberField(Field, Value) ? Value : Default;
+	}
+
+	// ─── Latency histogram: one bar per metrics bucket, scaled to the fullest ──
+	class SForgeLatencyHistogram : public SLeafWidget
+	{
+	public:
+		SLATE_BEGIN_ARGS(SForgeLatencyHistogram) : _MaxMs(0.0) {}
+			SLATE_ARGUMENT(TArray<int64>, Buckets)
+			SLATE_ARGUMENT(double, MaxMs)
+		SLATE_END_ARGS()
+
+		void Construct(const FArguments& InArgs)
+		{
+			Buckets = InArgs._Buckets;
+
+			FString Tip = FString::Printf(TEXT("max %.2f ms\n"), InArgs._MaxMs);
+			for (int32 i = 0; i < Buckets.Num(); ++i)
+			{
+				if (i < FAgentForgeCommandMetrics::NumBoundedBuckets)
+				{
+					Tip += FString::Printf(TEXT("<= %g ms: %lld\n"), FAgentForgeCommandMetrics::BucketUpperMs[i], Buckets[i]);
+				}
+				else
+				{
+					Tip += FString::Printf(TEXT("> %g ms: %lld"),
+						FAgentForgeCommandMetrics::BucketUpperMs[FAgentForgeCommandMetrics::NumBoundedBuckets - 1], Buckets[i]);
+				}
+			}
+			SetToolTipText(FText::FromString(Tip));
+		}
+
+		virtual FVector2D ComputeDesiredSize(float) const override
+		{
+			return FVector2D(FMath::Max(1, Buckets.Num()) * 7.0, 18.0);
+		}
+
+		virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+			FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override
+		{
+			int64 Peak = 0;
+			for (const int64 Count : Buckets)
+			{
+				Peak = FMath::Max(Peak, Count);
+			}
+			if (Peak <= 0)
+			{
+				return LayerId;
+			}
+
+			const FSlateBrush* Brush = FAppStyle::GetBrush(TEXT("WhiteBrush"));
+			const FVector2f Size = AllottedGeometry.GetLocalSize();
+			const float Slot = Size.X / Buckets.Num();
+			for (int32 i = 0; i < Buckets.Num(); ++i)
+			{
+				if (Buckets[i] <= 0)
+				{
+					continue;
+				}
+				// Any call at all gets a visible sliver so a rare slow call still shows.
+				const float Height = FMath::Max(2.0f, Size.Y * static_cast<float>(Buckets[i]) / static_cast<float>(Peak));
+				const double UpperMs = i < FAgentForgeCommandMetrics::NumBoundedBuckets
+					? FAgentForgeCommandMetrics::BucketUpperMs[i]
+					: TNumericLimits<double>::Max();
+				FSlateDrawElement::MakeBox(
+					OutDrawElements,
+					LayerId,
+					AllottedGeometry.ToPaintGeometry(FVector2f(FMath::Max(1.0f, Slot - 1.0f), Height),
+						FSlateLayoutTransform(FVector2f(i * Slot, Size.Y - Height))),
+					Brush,
+					ESlateDrawEffect::None,
+					LatencyColor(UpperMs) * InWidgetStyle.GetColorAndOpacityTint());
+			}
+			return LayerId;
+		}
+
+	private:
+		TArray<int64> Buckets;
+	};
+
+	// ─── Command list row ───────────────────────────────────────────────────────
+	class SForgePerfCommandTableRow : public SMultiColumnTableRow<TSharedPtr<FForgePerfCommandRow>>
+	{
+	public:
+		SLATE_BEGIN_ARGS(SForgePerfCommandTableRow) {}
+			SLATE_ARGUMENT(TSharedPtr<FForgePerfCommandRow>, Item)
+		SLATE_END_ARGS()
+
+		void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& Owner)
+		{
+			Item = InArgs._Item;
+			SMultiColumnTableRow<TSharedPtr<FForgePerfCommandRow>>::Construct(FSuperRowType::FArguments(), Owner);
+		}
+
+		virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override
+		{
+			const FForgePerfCommandRow& Row = *Item;
+			if (ColumnName == ColCommand)
+			{
+				return SNew(STextBlock).Text(FText::FromString(Row.Command));
+			}
+			if (ColumnName == ColRate)
+			{
+				return SNew(STextBlock).Text(FText::FromString(FString::Printf(TEXT("%.1f"), Row.CallsPerSecond)));
+			}
+			if (ColumnName == ColCalls)
+			{
+				return SNew(STextBlock).Text(FText::AsNumber(Row.Calls));
+			}
+			if (ColumnName == ColErrors)
+			{
+				return SNew(STextBlock)
+					.Text(FText::AsNumber(Row.Errors))
+					.ColorAndOpacity(Row.Errors > 0 ? FSlateColor(StallColor) : FSlateColor::UseForeground());
+			}
+			if (ColumnName == ColP50 || ColumnName == ColP95 || ColumnName == ColP99)
+			{
+				const double Ms = ColumnName == ColP50 ? Row.P50Ms : (ColumnName == ColP95 ? Row.P95Ms : Row.P99Ms);
+				return SNew(STextBlock).Text(MsText(Ms)).ColorAndOpacity(FSlateColor(LatencyColor(Ms)));
+			}
+			return SNew(SBox)
+				.Padding(FMargin(2.0f, 1.0f))
+				[
+					SNew(SForgeLatencyHistogram).Buckets(Row.Histogram).MaxMs(Row.MaxMs)
+				];
+		}
+
+	private:
+		TSharedPtr<FForgePerfCommandRow> Item;
+	};
+
+	static TSharedRef<SWidget> MakeSectionTitle(const FText& Title)
+	{
+		return SNew(STextBlock)
+			.Text(Title)
+			.Font(FAppStyle::GetFontStyle(TEXT("NormalFontBold")));
+	}
+}
+
+void SForgePerfDashboard::Construct(const FArguments& InArgs)
+{
+	MemoryColor = FSlateColor::UseForeground();
+
+	TSharedRef<SGridPanel> Summary = SNew(SGridPanel).FillColumn(1, 1.0f);
+	int32 SummaryRow = 0;
+	auto AddSummaryLine = [this, &Summary, &SummaryRow](const FText& Label, FText SForgePerfDashboard::* Value, bool bMemory = false)
+	{
+		Summary->AddSlot(0, SummaryRow)
+			.Padding(FMargin(0.0f, 2.0f, 12.0f, 2.0f))
+			[
+				SNew(STextBlock).Text(Label)
+			];
+		TSharedRef<STextBlock> ValueText = SNew(STextBlock).Text_Lambda([this, Value]() { return this->*Value; });
+		if (bMemory)
+		{
+			ValueText->SetColorAndOpacity(TAttribute<FSlateColor>::CreateLambda([this]() { return MemoryColor; }));
+		}
+		Summary->AddSlot(1, SummaryRow).Padding(FMargin(0.0f, 2.0f)) [ ValueText ];
+		++SummaryRow;
+	};
+	AddSummaryLine(LOCTEXT("Throughput", "Throughput"),        &SForgePerfDashboard::ThroughputText);
+	AddSummaryLine(LOCTEXT("Queue",      "Command queue"),     &SForgePerfDashboard::QueueText);
+	AddSummaryLine(LOCTEXT("Wait",       "Game-thread wait"),  &SForgePerfDashboard::WaitText);
+	AddSummaryLine(LOCTEXT("LLM",        "LLM requests"),      &SForgePerfDashboard::LLMText);
+	AddSummaryLine(LOCTEXT("Caches",     "Cache hit rates"),   &SForgePerfDashboard::CacheText);
+	AddSummaryLine(LOCTEXT("Memory",     "Memory guard"),      &SForgePerfDashboard::MemoryText, true);
+
+	SAssignNew(CommandList, SListView<TSharedPtr<FForgePerfCommandRow>>)
+		.ListItemsSource(&CommandRows)
+		.SelectionMode(ESelectionMode::None)
+		.OnGenerateRow(this, &SForgePerfDashboard::MakeCommandRow)
+		.HeaderRow
+		(
+			SNew(SHeaderRow)
+			+ SHeaderRow::Column(ColCommand).DefaultLabel(LOCTEXT("ColCommand", "Command")).FillWidth(0.30f)
+			+ SHeaderRow::Column(ColRate).DefaultLabel(LOCTEXT("ColRate", "Calls/s")).FillWidth(0.08f)
+			+ SHeaderRow::Column(ColCalls).DefaultLabel(LOCTEXT("ColCalls", "Calls")).FillWidth(0.08f)
+			+ SHeaderRow::Column(ColErrors).DefaultLabel(LOCTEXT("ColErrors", "Errors")).FillWidth(0.07f)
+			+ SHeaderRow::Column(ColP50).DefaultLabel(LOCTEXT("ColP50", "p50 ms")).FillWidth(0.07f)
+			+ SHeaderRow::Column(ColP95).DefaultLabel(LOCTEXT("ColP95", "p95 ms")).FillWidth(0.07f)
+			+ SHeaderRow::Column(ColP99).DefaultLabel(LOCTEXT("ColP99", "p99 ms")).FillWidth(0.07f)
+			+ SHeaderRow::Column(ColHistogram).DefaultLabel(LOCTEXT("ColHistogram", "Latency histogram")).FillWidth(0.26f)
+		);
+
+	ChildSlot
+	[
+		SNew(SBorder)
+		.BorderImage(FAppStyle::GetBrush(TEXT("ToolPanel.GroupBorder")))
+		.Padding(8.0f)
+		[
+			SNew(SScrollBox)
+
+			+ SScrollBox::Slot().Padding(0.0f, 0.0f, 0.0f, 6.0f)
+			[
+				MakeSectionTitle(LOCTEXT("BridgeLoad", "Agent traffic"))
+			]
+			+ SScrollBox::Slot()
+			[
+				Summary
+			]
+
+			+ SScrollBox::Slot().Padding(0.0f, 8.0f) [ SNew(SSeparator) ]
+			+ SScrollBox::Slot().Padding(0.0f, 0.0f, 0.0f, 4.0f)
+			[
+				MakeSectionTitle(LOCTEXT("Commands", "Busiest commands"))
+			]
+			+ SScrollBox::Slot()
+			[
+				SNew(SBox).MinDesiredHeight(120.0f)
+				[
+					CommandList.ToSharedRef()
+				]
+			]
+
+			+ SScrollBox::Slot().Padding(0.0f, 8.0f) [ SNew(SSeparator) ]
+			+ SScrollBox::Slot().Padding(0.0f, 0.0f, 0.0f, 4.0f)
+			[
+				MakeSectionTitle(LOCTEXT("Jobs", "Jobs in flight"))
+			]
+			+ SScrollBox::Slot()
+			[
+				SAssignNew(JobBox, SVerticalBox)
+			]
+
+			+ SScrollBox::Slot().Padding(0.0f, 8.0f) [ SNew(SSeparator) ]
+			+ SScrollBox::Slot().Padding(0.0f, 0.0f, 0.0f, 4.0f)
+			[
+				MakeSectionTitle(LOCTEXT("Trace", "Command trace"))
+			]
+			+ SScrollBox::Slot()
+			[
+				SNew(SHorizontalBox)
+				+ SHorizontalBox::Slot().AutoWidth().Padding(0.0f, 0.0f, 4.0f, 0.0f)
+				[
+					SNew(SButton)
+					.Text(LOCTEXT("StartTrace", "Start Recording"))
+					.ToolTipText(LOCTEXT("StartTraceTip", "Record every command to a new trace under Saved/AgentForgeTraces (same as start_command_trace with no args)."))
+					.IsEnabled_Lambda([]() { return !FAgentForgeCommandTrace::Get().IsRecording(); })
+					.OnClicked(this, &SForgePerfDashboard::OnStartTrace)
+				]
+				+ SHorizontalBox::Slot().AutoWidth().Padding(0.0f, 0.0f, 8.0f, 0.0f)
+				[
+					SNew(SButton)
+					.Text(LOCTEXT("StopTrace", "Stop Recording"))
+					.IsEnabled_Lambda([]() { return FAgentForgeCommandTrace::Get().IsRecording(); })
+					.OnClicked(this, &SForgePerfDashboard::OnStopTrace)
+				]
+				+ SHorizontalBox::Slot().FillWidth(1.0f).VAlign(VAlign_Center)
+				[
+					SNew(STextBlock).Text_Lambda([this]() { return TraceText; })
+				]
+			]
+		]
+	];
+
+	Refresh();
+	RegisterActiveTimer(RefreshSeconds, FWidgetActiveTimerDelegate::CreateSP(this, &SForgePerfDashboard::OnRefreshTimer));
+}
+
+EActiveTimerReturnType SForgePerfDashboard::OnRefreshTimer(double InCurrentTime, float InDeltaTime)
+{
+	Refresh();
+	return EActiveTimerReturnType::Continue;
+}
+
+void SForgePerfDashboard::Refresh()
+{
+	const double Now = FPlatformTime::Seconds();
+	const double Elapsed = PrevSeconds > 0.0 ? Now - PrevSeconds : 0.0;
+	PrevSeconds = Now;
+
+	RefreshCommands(FAgentForgeCommandMetrics::Get().GetMetricsJson(), Elapsed);
+	RefreshQueue();
+	RefreshJobs();
+	RefreshLLM();
+	RefreshMemory();
+	RefreshTrace();
+}
+
+void SForgePerfDashboard::RefreshCommands(const TSharedPtr<FJsonObject>& Metrics, double Elapsed)
+{
+	const TSharedPtr<FJsonObject>* Commands = nullptr;
+	if (!Metrics.IsValid() || !Metrics->TryGetObjectField(TEXT("commands"), Commands))
+	{
+		Commands = nullptr;
+	}
+
+	TArray<TSharedPtr<FForgePerfCommandRow>> Rows;
+	TMap<FString, int64> Calls;
+	int64 TotalCalls = 0;
+	int64 TotalErrors = 0;
+	double TotalRate = 0.0;
+	if (Commands)
+	{
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : (*Commands)->Values)
+		{
+			const TSharedPtr<FJsonObject> Obj = Pair.Value.IsValid() ? Pair.Value->AsObject() : nullptr;
+			if (!Obj.IsValid())
+			{
+				continue;
+			}
+			TSharedPtr<FForgePerfCommandRow> Row = MakeShared<FForgePerfCommandRow>();
+			Row->Command = Pair.Key;
+			Row->Calls   = static_cast<int64>(NumberOr(Obj, TEXT("calls")));
+			Row->Errors  = static_cast<int64>(NumberOr(Obj, TEXT("errors")));
+			Row->P50Ms   = NumberOr(Obj, TEXT("p50_ms"));
+			Row->P95Ms   = NumberOr(Obj, TEXT("p95_ms"));
+			Row->P99Ms   = NumberOr(Obj, TEXT("p99_ms"));
+			Row->MaxMs   = NumberOr(Obj, TEXT("max_ms"));
+			const TArray<TSharedPtr<FJsonValue>>* Histogram = nullptr;
+			if (Obj->TryGetArrayField(TEXT("histogram"), Histogram))
+			{
+				for (const TSharedPtr<FJsonValue>& Count : *Histogram)
+				{
+					Row->Histogram.Add(Count.IsValid() ? static_cast<int64>(Count->AsNumber()) : 0);
+				}
+			}
+
+			// A get_command_metrics reset drops the counts below the previous refresh; count from zero then.
+			const int64* Prev = PrevCalls.Find(Pair.Key);
+			const int64 Delta = Prev && *Prev <= Row->Calls ? Row->Calls - *Prev : Row->Calls;
+			Row->CallsPerSecond = Elapsed > 0.0 ? Delta / Elapsed : 0.0;
+
+			Calls.Add(Pair.Key, Row->Calls);
+			TotalCalls  += Row->Calls;
+			TotalErrors += Row->Errors;
+			TotalRate   += Row->CallsPerSecond;
+			Rows.Add(MoveTemp(Row));
+		}
+	}
+	PrevCalls = MoveTemp(Calls);
+
+	// Busiest now first; among idle commands the slowest tail first.
+	Rows.Sort([](const TSharedPtr<FForgePerfCommandRow>& A, const TSharedPtr<FForgePerfCommandRow>& B)
+	{
+		if (A->CallsPerSecond != B->CallsPerSecond)
+		{
+			return A->CallsPerSecond > B->CallsPerSecond;
+		}
+		return A->P95Ms > B->P95Ms;
+	});
+	if (Rows.Num() > MaxCommandRows)
+	{
+		Rows.SetNum(MaxCommandRows);
+	}
+	CommandRows = MoveTemp(Rows);
+	if (CommandList.IsValid())
+	{
+		CommandList->RequestListRefresh();
+	}
+
+	ThroughputText = FText::FromString(FString::Printf(
+		TEXT("%.1f calls/s    %lld calls, %lld errors since the last metrics reset"), TotalRate, TotalCalls, TotalErrors));
+}
+
+void SForgePerfDashboard::RefreshQueue()
+{
+	const TSharedPtr<FJsonObject> Queue = FAgentForgeCommandQueue::Get().GetStatsJson();
+	QueueText = FText::FromString(FString::Printf(
+		TEXT("depth %d (peak %d)    %lld executed, %lld coalesced, %lld rejected"),
+		static_cast<int32>(NumberOr(Queue, TEXT("depth"))),
+		static_cast<int32>(NumberOr(Queue, TEXT("max_depth"))),
+		static_cast<int64>(NumberOr(Queue, TEXT("executed"))),
+		static_cast<int64>(NumberOr(Queue, TEXT("coalesced"))),
+		static_cast<int64>(NumberOr(Queue, TEXT("rejected")))));
+	WaitText = FText::FromString(FString::Printf(
+		TEXT("avg %.2f ms, max %.2f ms    last drain %.2f ms for %d requests (budget %.1f ms, %lld drains over)"),
+		NumberOr(Queue, TEXT("avg_wait_ms")),
+		NumberOr(Queue, TEXT("max_wait_ms")),
+		NumberOr(Queue, TEXT("last_drain_ms")),
+		static_cast<int32>(NumberOr(Queue, TEXT("last_drain_count"))),
+		NumberOr(Queue, TEXT("frame_budget_ms")),
+		static_cast<int64>(NumberOr(Queue, TEXT("drains_over_budget")))));
+}
+
+void SForgePerfDashboard::RefreshJobs()
+{
+	if (!JobBox.IsValid())
+	{
+		return;
+	}
+	JobBox->ClearChildren();
+
+	FAgentForgeJobManager& Jobs = FAgentForgeJobManager::Get();
+	const TArray<TSharedRef<FAgentForgeJob>> All = Jobs.GetJobs();
+	const int32 NumPending = FMath::Min(Jobs.NumPendingJobs(), All.Num());   // pending jobs come first
+	for (int32 i = 0; i < NumPending; ++i)
+	{
+		const FAgentForgeJob& Job = *All[i];
+		const float Percent = Job.GetPercentComplete();
+		const FString Stage = Job.GetState() == EAgentForgeJobState::Queued ? TEXT("queued") : Job.GetCurrentStageName();
+		JobBox->AddSlot()
+			.AutoHeight()
+			.Padding(FMargin(0.0f, 2.0f))
+			[
+				SNew(SHorizontalBox)
+				+ SHorizontalBox::Slot().FillWidth(0.45f).VAlign(VAlign_Center).Padding(0.0f, 0.0f, 8.0f, 0.0f)
+				[
+					SNew(STextBlock).Text(FText::FromString(FString::Printf(
+						TEXT("%s  %s  (%s)"), *Job.GetId(), *Job.GetCommand(), *Stage)))
+				]
+				+ SHorizontalBox::Slot().FillWidth(0.45f).VAlign(VAlign_Center)
+				[
+					SNew(SProgressBar).Percent(Percent / 100.0f)
+				]
+				+ SHorizontalBox::Slot().FillWidth(0.10f).VAlign(VAlign_Center).Padding(8.0f, 0.0f, 0.0f, 0.0f)
+				[
+					SNew(STextBlock).Text(FText::FromString(FString::Printf(TEXT("%.0f%%"), Percent)))
+				]
+			];
+	}
+	if (NumPending == 0)
+	{
+		JobBox->AddSlot().AutoHeight()
+		[
+			SNew(STextBlock).Text(LOCTEXT("NoJobs", "No jobs queued or running."))
+		];
+	}
+}
+
+void SForgePerfDashboard::RefreshLLM()
+{
+	UAgentForgeLLMSubsystem* LLM = GEditor ? GEditor->GetEditorSubsystem<UAgentForgeLLMSubsystem>() : nullptr;
+	if (LLM)
+	{
+		const TSharedPtr<FJsonObject> Stats = LLM->GetStatsJson();
+		const TSharedPtr<FJsonObject>* Scheduler = nullptr;
+		const TSharedPtr<FJsonObject> Sched = Stats->TryGetObjectField(TEXT("scheduler"), Scheduler) ? *Scheduler : nullptr;
+		LLMText = FText::FromString(FString::Printf(
+			TEXT("%d in flight (peak %d), %d queued    %lld completed, %lld failed, %lld retries, %lld rate limited"),
+			static_cast<int32>(NumberOr(Stats, TEXT("in_flight"))),
+			static_cast<int32>(NumberOr(Stats, TEXT("max_in_flight"))),
+			static_cast<int32>(NumberOr(Stats, TEXT("queued"))),
+			static_cast<int64>(NumberOr(Stats, TEXT("completed"))),
+			static_cast<int64>(NumberOr(Stats, TEXT("failed"))),
+			static_cast<int64>(NumberOr(Sched, TEXT("retries"))),
+			static_cast<int64>(NumberOr(Sched, TEXT("rate_limited")))));
+	}
+	else
+	{
+		LLMText = LOCTEXT("NoLLM", "LLM subsystem not available");
+	}
+
+	const TSharedPtr<FJsonObject> LLMCache    = FAgentForgeLLMResponseCache::Get().GetStatsJson();
+	const TSharedPtr<FJsonObject> VisionCache = FAgentForgeVisionCache::Get().GetStatsJson();
+	const TSharedPtr<FJsonObject> ProcCache   = FAgentForgeProceduralCache::Get().GetStatsJson();
+	CacheText = FText::FromString(FString::Printf(
+		TEXT("LLM responses %.0f%% (%d entries)    vision %.0f%% (%d entries)    procedural %.0f%% (%d entries)"),
+		NumberOr(LLMCache,    TEXT("hit_rate")) * 100.0, static_cast<int32>(NumberOr(LLMCache,    TEXT("entries"))),
+		NumberOr(VisionCache, TEXT("hit_rate")) * 100.0, static_cast<int32>(NumberOr(VisionCache, TEXT("entries"))),
+		NumberOr(ProcCache,   TEXT("hit_rate")) * 100.0, static_cast<int32>(NumberOr(ProcCache,   TEXT("entries")))));
+}
+
+void SForgePerfDashboard::RefreshMemory()
+{
+	const TSharedPtr<FJsonObject> Memory = FAgentForgeMemoryMonitor::Get().GetStatsJson();
+	const double AvailableMB   = NumberOr(Memory, TEXT("available_mb"));
+	const double UsedPercent   = NumberOr(Memory, TEXT("used_percent"));
+	const double HeadroomMB    = AvailableMB - NumberOr(Memory, TEXT("enter_available_mb"));
+	const double HeadroomPct   = NumberOr(Memory, TEXT("enter_used_percent"), 100.0) - UsedPercent;
+	const bool   bPressure     = Memory->GetBoolField(TEXT("pressure"));
+
+	MemoryText = FText::FromString(FString::Printf(
+		TEXT("%s    %.0f MB / %.1f%% of headroom before the guard    %.0f MB free, %.1f%% used    %lld commands refused"),
+		bPressure ? TEXT("UNDER PRESSURE") : TEXT("ok"),
+		FMath::Max(0.0, HeadroomMB),
+		FMath::Max(0.0, HeadroomPct),
+		AvailableMB,
+		UsedPercent,
+		static_cast<int64>(NumberOr(Memory, TEXT("blocked")))));
+	MemoryColor = bPressure
+		? FSlateColor(StallColor)
+		: (HeadroomMB < LowHeadroomMB ? FSlateColor(SlowColor) : FSlateColor::UseForeground());
+}
+
+void SForgePerfDashboard::RefreshTrace()
+{
+	FAgentForgeCommandTrace& Trace = FAgentForgeCommandTrace::Get();
+	if (!Trace.IsRecording())
+	{
+		TraceText = TraceError.IsEmpty()
+			? LOCTEXT("TraceIdle", "Not recording.")
+			: FText::FromString(FString::Printf(TEXT("Not recording: %s"), *TraceError));
+		return;
+	}
+	const TSharedPtr<FJsonObject> Stats = Trace.GetStatsJson();
+	TraceText = FText::FromString(FString::Printf(
+		TEXT("Recording to %s    %lld records, %.1f KB written"),
+		*Stats->GetStringField(TEXT("path")),
+		static_cast<int64>(NumberOr(Stats, TEXT("records"))),
+		NumberOr(Stats, TEXT("compressed_bytes")) / 1024.0));
+}
+
+TSharedRef<ITableRow> SForgePerfDashboard::MakeCommandRow(TSharedPtr<FForgePerfCommandRow> Row, const TSharedRef<STableViewBase>& Owner)
+{
+	return SNew(SForgePerfCommandTableRow, Owner).Item(Row);
+}
+
+FReply SForgePerfDashboard::OnStartTrace()
+{
+	TraceError.Reset();
+	if (!FAgentForgeCommandTrace::Get().Start(FAgentForgeTraceRecordSettings(), TraceError))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[UEAgentForge] Command trace not started: %s"), *TraceError);
+	}
+	RefreshTrace();
+	return FReply::Handled();
+}
+
+FReply SForgePerfDashboard::OnStopTrace()
+{
+	FAgentForgeCommandTrace::Get().Stop();
+	RefreshTrace();
+	return FReply::Handled();
+}
+
+#undef LOCTEXT_NAMESPACE
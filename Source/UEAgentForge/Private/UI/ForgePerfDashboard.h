@@ -0,0 +1,90 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// ForgePerfDashboard — live view of the bridge's own load, for the Forge Tools tab.
+//
+// Everything shown is read from the same stats the get_forge_status and
+// get_command_metrics commands return, every RefreshSeconds:
+//
+//   throughput      calls per second across all commands, from the change in
+//                   command_metrics call counts since the previous refresh
+//   commands        the busiest commands with their rate, p50 / p95 / p99
+//                   (recent window) and the lifetime latency histogram
+//   queue           off-thread command queue depth and the time requests wait
+//                   for the game thread
+//   jobs            queued and running async jobs with their progress
+//   llm             scheduler concurrency, and the LLM response, vision and
+//                   procedural cache hit rates
+//   memory guard    free memory above the level at which the guard refuses
+//                   commands
+//   trace           start / stop command trace recording (default path)
+//
+// Game thread only.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"   // explicit with NoPCHs
+#include "Input/Reply.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/SListView.h"
+
+class SVerticalBox;
+
+/** One command in the dashboard's command list. */
+struct FForgePerfCommandRow
+{
+	FString Command;
+	double  CallsPerSecond = 0.0;
+	int64   Calls = 0;
+	int64   Errors = 0;
+	double  P50Ms = 0.0;
+	double  P95Ms = 0.0;
+	double  P99Ms = 0.0;
+	double  MaxMs = 0.0;
+	TArray<int64> Histogram;   // lifetime counts per FAgentForgeCommandMetrics::BucketUpperMs bucket
+};
+
+class SForgePerfDashboard : public SCompoundWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SForgePerfDashboard) {}
+	SLATE_END_ARGS()
+
+	static constexpr float  RefreshSeconds = 0.5f;
+	static constexpr int32  MaxCommandRows = 16;
+	/** Headroom below which the memory line turns amber before the guard engages. */
+	static constexpr double LowHeadroomMB = 1024.0;
+
+	void Construct(const FArguments& InArgs);
+
+private:
+	EActiveTimerReturnType OnRefreshTimer(double InCurrentTime, float InDeltaTime);
+	void Refresh();
+	void RefreshCommands(const TSharedPtr<FJsonObject>& Metrics, double Elapsed);
+	void RefreshQueue();
+	void RefreshJobs();
+	void RefreshLLM();
+	void RefreshMemory();
+	void RefreshTrace();
+
+	TSharedRef<ITableRow> MakeCommandRow(TSharedPtr<FForgePerfCommandRow> Row, const TSharedRef<STableViewBase>& Owner);
+
+	FReply OnStartTrace();
+	FReply OnStopTrace();
+
+	TArray<TSharedPtr<FForgePerfCommandRow>>                 CommandRows;
+	TSharedPtr<SListView<TSharedPtr<FForgePerfCommandRow>>>  CommandList;
+	TSharedPtr<SVerticalBox>                                 JobBox;
+
+	TMap<FString, int64> PrevCalls;    // per-command calls at the previous refresh
+	double PrevSeconds = 0.0;
+
+	FText ThroughputText;
+	FText QueueText;
+	FText WaitText;
+	FText LLMText;
+	FText CacheText;
+	FText MemoryText;
+	FText TraceText;
+	FSlateColor MemoryColor;
+	FString TraceError;
+};
@@ -1,3 +1,72 @@
 // Copyright UEAgentForge Project. All Rights Reserved.
-// ForgeToolsCommands.cpp - reserved for editor command bindings.
+// ForgeToolsCommands.cpp - editor tab and console command bindings.
 
+#include "UI/ForgeToolsCommands.h"
+#include "UI/ForgePerfDashboard.h"
+
+#include "Framework/Application/SlateApplication.h"
+#include "Framework/Docking/TabManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CoreMisc.h"
+#include "Widgets/Docking/SDockTab.h"
+#include "WorkspaceMenuStructure.h"
+#include "WorkspaceMenuStructureModule.h"
+
+#define LOCTEXT_NAMESPACE "ForgeToolsCommands"
+
+const FName FForgeToolsCommands::PerfDashboardTabId(TEXT("AgentForgePerfDashboard"));
+bool FForgeToolsCommands::bRegistered = false;
+
+namespace
+{
+	static TSharedRef<SDockTab> SpawnPerfDashboardTab(const FSpawnTabArgs& Args)
+	{
+		return SNew(SDockTab)
+			.TabRole(ETabRole::NomadTab)
+			[
+				SNew(SForgePerfDashboard)
+			];
+	}
+
+	static FAutoConsoleCommand OpenPerfDashboardCommand(
+		TEXT("AgentForge.PerfDashboard"),
+		TEXT("Opens the UEAgentForge performance dashboard (command throughput, latency, queue, jobs, LLM, memory guard)."),
+		FConsoleCommandDelegate::CreateStatic(&FForgeToolsCommands::OpenPerfDashboard));
+}
+
+void FForgeToolsCommands::Register()
+{
+	if (bRegistered || IsRunningCommandlet() || !FSlateApplication::IsInitialized())
+	{
+		return;
+	}
+
+	FGlobalTabmanager::Get()->RegisterNomadTabSpawner(PerfDashboardTabId, FOnSpawnTab::CreateStatic(&SpawnPerfDashboardTab))
+		.SetDisplayName(LOCTEXT("PerfDashboardTitle", "AgentForge Performance"))
+		.SetTooltipText(LOCTEXT("PerfDashboardTooltip", "Live view of agent command traffic and what it costs the editor."))
+		.SetGroup(WorkspaceMenu::GetMenuStructure().GetDeveloperToolsDebugCategory());
+	bRegistered = true;
+}
+
+void FForgeToolsCommands::Unregister()
+{
+	if (!bRegistered)
+	{
+		return;
+	}
+	bRegistered = false;
+	if (FSlateApplication::IsInitialized())
+	{
+		FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(PerfDashboardTabId);
+	}
+}
+
+void FForgeToolsCommands::OpenPerfDashboard()
+{
+	if (bRegistered)
+	{
+		FGlobalTabmanager::Get()->TryInvokeTab(PerfDashboardTabId);
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
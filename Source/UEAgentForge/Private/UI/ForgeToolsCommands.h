@@ -0,0 +1,26 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// ForgeToolsCommands - editor tab and console bindings for the Forge Tools panel.
+//
+// Registers the performance dashboard as a nomad tab under
+// Tools > Debug and the AgentForge.PerfDashboard console command that opens it.
+// Nothing is registered in commandlets or without a Slate application, so
+// headless workers and -unattended runs are unaffected.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FForgeToolsCommands
+{
+public:
+	static const FName PerfDashboardTabId;
+
+	static void Register();
+	static void Unregister();
+
+	/** Opens (or focuses) the dashboard tab. No-op when the tab is not registered. */
+	static void OpenPerfDashboard();
+
+private:
+	static bool bRegistered;
+};
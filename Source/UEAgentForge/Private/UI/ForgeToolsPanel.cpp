@@ -2,6 +2,7 @@
 // ForgeToolsPanel.cpp - UI lifetime scaffold.
 
 #include "UI/ForgeToolsPanel.h"
+#include "UI/ForgeToolsCommands.h"
 #include "Operators/ProceduralOpsModule.h"
 
 bool FForgeToolsPanel::bInitialized = false;
@@ -9,11 +10,22 @@ FForgeToolsSettings FForgeToolsPanel::Settings;
 
 void FForgeToolsPanel::Initialize()
 {
+	if (bInitialized)
+	{
+		return;
+	}
+	// Editor tabs (performance dashboard); skipped in commandlets.
+	FForgeToolsCommands::Register();
 	bInitialized = true;
 }
 
 void FForgeToolsPanel::Shutdown()
 {
+	if (!bInitialized)
+	{
+		return;
+	}
+	FForgeToolsCommands::Unregister();
 	bInitialized = false;
 }
 
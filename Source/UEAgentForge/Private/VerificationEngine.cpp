@@ -3,6 +3,9 @@
 
 #include "VerificationEngine.h"
 #include "ConstitutionParser.h"
+#include "AgentForgeWorldSnapshot.h"
+#include "AgentForgeWorldStats.h"
+#include "AgentForgeTrace.h"
 
 #if WITH_EDITOR
 #include "Editor.h"
@@ -16,9 +19,16 @@
 #include "Serialization/JsonWriter.h"
 #include "Serialization/JsonSerializer.h"
 #include "Kismet2/KismetEditorUtilities.h"
-#include "AssetRegistry/AssetRegistryModule.h"
 #include "Engine/Blueprint.h"
 #include "ScopedTransaction.h"        // FScopedTransaction — explicit with NoPCHs
+#include "Editor/Transactor.h"        // FTransaction::GetTransactionObjects
+#include "Engine/Engine.h"
+#include "Components/ActorComponent.h"
+#include "Misc/Crc.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/UObjectIterator.h"
+#include "UObject/Package.h"
+#include "Async/Async.h"
 #endif
 
 UVerificationEngine* UVerificationEngine::Singleton = nullptr;
@@ -49,33 +59,235 @@ static void CollectCurrentActorState(UWorld* World, TArray<FString>& OutLabels,
 	}
 }
 
-static FString BuildRollbackLeakSummary(const TArray<FString>& PrePaths, const TArray<FString>& PostPaths)
+static int32 CountCurrentActors(UWorld* World)
 {
-	TSet<FString> PreSet(PrePaths);
-	TSet<FString> PostSet(PostPaths);
-	TArray<FString> Added = PostSet.Difference(PreSet).Array();
-	Added.Sort();
+	return World ? FAgentForgeWorldStats::Get().Gather(World).Actors : 0;
+}
 
-	if (Added.IsEmpty())
+/** Loaded Blueprint assets that are dirty, in error, or sit in a dirty package. */
+static void CollectBuildCheckCandidates(TArray<UBlueprint*>& OutBlueprints)
+{
+	for (TObjectIterator<UBlueprint> It; It; ++It)
 	{
-		return TEXT("No extra actor paths detected; rollback leak source unresolved.");
+		UBlueprint* BP = *It;
+		if (!BP || !IsValid(BP) || BP->HasAnyFlags(RF_ClassDefaultObject | RF_Transient))
+		{
+			continue;
+		}
+
+		UPackage* Package = BP->GetOutermost();
+		if (!Package || Package == GetTransientPackage())
+		{
+			continue;
+		}
+
+		if (BP->Status == BS_Dirty || BP->Status == BS_Error || Package->IsDirty())
+		{
+			OutBlueprints.Add(BP);
+		}
+	}
+}
+
+/** Order-independent key over path, status and package dirtiness of each candidate. */
+static uint32 BuildCheckKeyOf(const TArray<UBlueprint*>& Blueprints)
+{
+	TArray<FString> Entries;
+	Entries.Reserve(Blueprints.Num());
+	for (const UBlueprint* BP : Blueprints)
+	{
+		Entries.Add(FString::Printf(TEXT("%s:%d:%d"),
+			*BP->GetPathName(), static_cast<int32>(BP->Status), BP->GetOutermost()->IsDirty() ? 1 : 0));
+	}
+	Entries.Sort();
+
+	uint32 Crc = 0;
+	for (const FString& Entry : Entries)
+	{
+		Crc = FCrc::StrCrc32(*Entry, Crc);
+	}
+	return Crc;
+}
+
+/** Label and transform; what a cancelled transaction must put back for a modified actor. */
+static uint32 RollbackSignatureOf(const AActor* Actor)
+{
+	const FTransform Transform = Actor->GetActorTransform();
+	const FVector Location = Transform.GetLocation();
+	const FQuat   Rotation = Transform.GetRotation();
+	const FVector Scale    = Transform.GetScale3D();
+	uint32 Crc = FCrc::StrCrc32(*Actor->GetActorLabel());
+	Crc = FCrc::MemCrc32(&Location, sizeof(Location), Crc);
+	Crc = FCrc::MemCrc32(&Rotation, sizeof(Rotation), Crc);
+	return FCrc::MemCrc32(&Scale, sizeof(Scale), Crc);
+}
+
+/**
+ * Records the actors a command touches while it runs: spawned and deleted
+ * actors from the editor's level actor events, modified actors from
+ * OnObjectModified (components count for their owner), captured before the
+ * change lands. Unsubscribes when destroyed.
+ */
+class FScopedActorChangeRecorder
+{
+public:
+	explicit FScopedActorChangeRecorder(UWorld* InWorld)
+		: World(InWorld)
+	{
+		if (GEngine)
+		{
+			AddedHandle   = GEngine->OnLevelActorAdded().AddRaw(this, &FScopedActorChangeRecorder::HandleAdded);
+			DeletedHandle = GEngine->OnLevelActorDeleted().AddRaw(this, &FScopedActorChangeRecorder::HandleDeleted);
+		}
+		ModifiedHandle = FCoreUObjectDelegates::OnObjectModified.AddRaw(this, &FScopedActorChangeRecorder::HandleModified);
+	}
+
+	~FScopedActorChangeRecorder()
+	{
+		Stop();
+	}
+
+	void Stop()
+	{
+		if (GEngine)
+		{
+			GEngine->OnLevelActorAdded().Remove(AddedHandle);
+			GEngine->OnLevelActorDeleted().Remove(DeletedHandle);
+		}
+		FCoreUObjectDelegates::OnObjectModified.Remove(ModifiedHandle);
+		AddedHandle.Reset();
+		DeletedHandle.Reset();
+		ModifiedHandle.Reset();
+	}
+
+	/** False when the open transaction recorded an actor the events never reported. */
+	bool CoversTransaction() const
+	{
+		if (!GEditor || !GEditor->Trans || !GEditor->IsTransactionActive()) { return true; }
+		const FTransaction* Transaction = GEditor->Trans->GetTransaction(GEditor->Trans->GetQueueLength() - 1);
+		if (!Transaction) { return true; }
+
+		TArray<UObject*> Objects;
+		Transaction->GetTransactionObjects(Objects);
+		for (UObject* Object : Objects)
+		{
+			const AActor* Actor = Cast<AActor>(Object);
+			if (!Actor)
+			{
+				const UActorComponent* Component = Cast<UActorComponent>(Object);
+				Actor = Component ? Component->GetOwner() : nullptr;
+			}
+			if (!Actor || Actor->GetWorld() != World) { continue; }
+
+			const TWeakObjectPtr<AActor> Weak(const_cast<AActor*>(Actor));
+			if (!Spawned.Contains(Weak) && !Deleted.Contains(Weak) && !Modified.Contains(Weak))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	int32 NumTouched() const { return Spawned.Num() + Deleted.Num() + Modified.Num(); }
+
+	/** After the transaction is cancelled: every touched actor must be back in its pre-command state. */
+	void FindRollbackProblems(TArray<FString>& OutLeaked, TArray<FString>& OutNotRestored, TArray<FString>& OutNotReverted) const
+	{
+		for (const TPair<TWeakObjectPtr<AActor>, FString>& Pair : Spawned)
+		{
+			if (AActor* Actor = Pair.Key.Get())
+			{
+				if (IsValid(Actor)) { OutLeaked.Add(Actor->GetPathName()); }
+			}
+		}
+		for (const TPair<TWeakObjectPtr<AActor>, FString>& Pair : Deleted)
+		{
+			AActor* Actor = Pair.Key.Get();
+			if (!Actor || !IsValid(Actor)) { OutNotRestored.Add(Pair.Value); }
+		}
+		for (const TPair<TWeakObjectPtr<AActor>, uint32>& Pair : Modified)
+		{
+			AActor* Actor = Pair.Key.Get();
+			if (Actor && IsValid(Actor) && RollbackSignatureOf(Actor) != Pair.Value)
+			{
+				OutNotReverted.Add(Actor->GetPathName());
+			}
+		}
 	}
 
-	const int32 MaxListed = FMath::Min(Added.Num(), 6);
-	TArray<FString> Trimmed;
-	for (int32 Index = 0; Index < MaxListed; ++Index)
+private:
+	void HandleAdded(AActor* Actor)
 	{
-		Trimmed.Add(Added[Index]);
+		if (Actor && Actor->GetWorld() == World)
+		{
+			Spawned.Add(Actor, Actor->GetPathName());
+		}
 	}
 
-	FString Summary = FString::Printf(TEXT("Leaked actors (%d): %s"), Added.Num(), *FString::Join(Trimmed, TEXT(", ")));
-	if (Added.Num() > MaxListed)
+	void HandleDeleted(AActor* Actor)
 	{
-		Summary += FString::Printf(TEXT(" ... +%d more"), Added.Num() - MaxListed);
+		if (!Actor || Actor->GetWorld() != World) { return; }
+		const TWeakObjectPtr<AActor> Weak(Actor);
+		// Spawned and deleted within the command: nothing to restore either way.
+		if (Spawned.Remove(Weak) == 0)
+		{
+			Deleted.Add(Weak, Actor->GetPathName());
+		}
+	}
+
+	void HandleModified(UObject* Object)
+	{
+		AActor* Actor = Cast<AActor>(Object);
+		if (!Actor)
+		{
+			const UActorComponent* Component = Cast<UActorComponent>(Object);
+			Actor = Component ? Component->GetOwner() : nullptr;
+		}
+		if (!Actor || !IsValid(Actor) || Actor->GetWorld() != World) { return; }
+
+		const TWeakObjectPtr<AActor> Weak(Actor);
+		// The first Modify() comes before any change, so that signature is the pre-command state.
+		if (!Spawned.Contains(Weak) && !Modified.Contains(Weak))
+		{
+			Modified.Add(Weak, RollbackSignatureOf(Actor));
+		}
+	}
+
+	UWorld* World = nullptr;
+	TMap<TWeakObjectPtr<AActor>, FString> Spawned;    // path
+	TMap<TWeakObjectPtr<AActor>, FString> Deleted;    // path, captured while alive
+	TMap<TWeakObjectPtr<AActor>, uint32>  Modified;   // signature before the first change
+
+	FDelegateHandle AddedHandle;
+	FDelegateHandle DeletedHandle;
+	FDelegateHandle ModifiedHandle;
+};
+
+static FString JoinTrimmed(const TCHAR* Heading, TArray<FString> Paths)
+{
+	Paths.Sort();
+	const int32 MaxListed = FMath::Min(Paths.Num(), 6);
+	TArray<FString> Trimmed(Paths.GetData(), MaxListed);
+	FString Summary = FString::Printf(TEXT("%s (%d): %s"), Heading, Paths.Num(), *FString::Join(Trimmed, TEXT(", ")));
+	if (Paths.Num() > MaxListed)
+	{
+		Summary += FString::Printf(TEXT(" ... +%d more"), Paths.Num() - MaxListed);
 	}
 	return Summary;
 }
 
+static FString BuildRollbackLeakSummary(const TArray<FString>& PrePaths, const TArray<FString>& PostPaths)
+{
+	TSet<FString> PreSet(PrePaths);
+	TSet<FString> PostSet(PostPaths);
+	TArray<FString> Added = PostSet.Difference(PreSet).Array();
+
+	if (Added.IsEmpty())
+	{
+		return TEXT("No extra actor paths detected; rollback leak source unresolved.");
+	}
+	return JoinTrimmed(TEXT("Leaked actors"), MoveTemp(Added));
+}
+
 static FString SerializeVerificationRun(
 	const int32 PhaseMask,
 	const FString& ActionDesc,
@@ -153,6 +365,7 @@ bool UVerificationEngine::RunPhases(
 	TArray<FVerificationPhaseResult>& OutResults,
 	TArray<FVerificationPhaseResult>* OutUnavailableResults)
 {
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Verification.RunPhases");
 	OutResults.Empty();
 	TArray<FVerificationPhaseResult> LocalUnavailableResults;
 	if (OutUnavailableResults)
@@ -224,6 +437,7 @@ bool UVerificationEngine::RunPhases(
 // ============================================================================
 FVerificationPhaseResult UVerificationEngine::RunPreFlight(const FString& ActionDesc)
 {
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Verification.RunPreFlight");
 	FVerificationPhaseResult Result;
 	Result.PhaseName = TEXT("PreFlight");
 
@@ -233,26 +447,48 @@ FVerificationPhaseResult UVerificationEngine::RunPreFlight(const FString& Action
 	// 1a. Constitution check
 	TArray<FString> Violations;
 	UConstitutionParser* Parser = UConstitutionParser::Get();
+	if (Parser)
+	{
+		Parser->ReloadIfChanged();
+	}
+
+	// The rule scan only reads the parser's immutable matcher, so it runs on the
+	// thread pool while the game thread captures the pre-state (actor iteration
+	// has to stay on the game thread). A reload can only happen on this thread,
+	// and it happened above.
+	TFuture<bool> ConstitutionCheck;
 	if (Parser && Parser->IsLoaded())
 	{
-		const bool bAllowed = Parser->ValidateAction(ActionDesc, Violations);
-		if (!bAllowed)
+		ConstitutionCheck = Async(EAsyncExecution::ThreadPool, [Parser, ActionDesc, &Violations]()
 		{
-			Result.Passed = false;
-			Result.Detail = FString::Printf(TEXT("Constitution violations: %s"),
-			                               *FString::Join(Violations, TEXT("; ")));
-			Result.DurationMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
-			return Result;
-		}
+			return Parser->ValidateAction(ActionDesc, Violations);
+		});
 	}
 
-	// 1b. Capture pre-state actor list
+	// 1b. Capture pre-state actor list. The scoped rollback test records what the
+	//     command touches as it runs, so it only needs the count here.
 	PreStateActorLabels.Empty();
 	PreStateActorPaths.Empty();
 	PreStateActorCount = 0;
 
 	UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
-	CollectCurrentActorState(World, PreStateActorLabels, PreStateActorPaths, PreStateActorCount);
+	if (RollbackScope == EVerificationRollbackScope::Full)
+	{
+		CollectCurrentActorState(World, PreStateActorLabels, PreStateActorPaths, PreStateActorCount);
+	}
+	else
+	{
+		PreStateActorCount = CountCurrentActors(World);
+	}
+
+	if (ConstitutionCheck.IsValid() && !ConstitutionCheck.Get())
+	{
+		Result.Passed = false;
+		Result.Detail = FString::Printf(TEXT("Constitution violations: %s"),
+		                               *FString::Join(Violations, TEXT("; ")));
+		Result.DurationMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+		return Result;
+	}
 
 	Result.Passed = true;
 	Result.Detail = FString::Printf(
@@ -271,27 +507,77 @@ FVerificationPhaseResult UVerificationEngine::RunPreFlight(const FString& Action
 FVerificationPhaseResult UVerificationEngine::RunSnapshotRollback(
 	TFunction<bool()> ExecuteCmd, const FString& SnapshotLabel)
 {
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Verification.RunSnapshotRollback");
 	FVerificationPhaseResult Result;
 	Result.PhaseName = TEXT("Snapshot+Rollback");
 
 	const double StartTime = FPlatformTime::Seconds();
 
 #if WITH_EDITOR
-	// Step 1: Create pre-execution snapshot
-	const FString SnapPath = CreateSnapshot(SnapshotLabel + TEXT("_pre"));
+	++RollbackTests;
+	UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+	const bool bScoped = (RollbackScope == EVerificationRollbackScope::Scoped);
+
+	// Step 1: Create pre-execution snapshot (full scope only; the scoped test records
+	// the touched actors instead of the whole level)
+	const FString SnapPath = bScoped ? FString() : CreateSnapshot(SnapshotLabel + TEXT("_pre"));
 
 	// Step 2: Execute the command inside a temporary sub-transaction
 	bool bExecuteSuccess = false;
+	TOptional<FScopedActorChangeRecorder> Recorder;
+	bool bRecorderCoversTransaction = true;
 	{
 		FScopedTransaction RollbackTest(FText::FromString(TEXT("AgentForge RollbackTest")));
+		if (bScoped)
+		{
+			Recorder.Emplace(World);
+		}
 		bExecuteSuccess = ExecuteCmd();
+		if (Recorder.IsSet())
+		{
+			Recorder->Stop();
+			bRecorderCoversTransaction = Recorder->CoversTransaction();
+		}
 		// Step 3: Intentionally cancel — this is the rollback test
 		RollbackTest.Cancel();
 	}
 	// At this point the undo system has rolled back the sub-transaction.
 
 	// Step 4: Verify state matches pre-snapshot
-	UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+	if (Recorder.IsSet() && bRecorderCoversTransaction)
+	{
+		LastTouchedActors = Recorder->NumTouched();
+
+		TArray<FString> Leaked, NotRestored, NotReverted;
+		Recorder->FindRollbackProblems(Leaked, NotRestored, NotReverted);
+		if (!Leaked.IsEmpty() || !NotRestored.IsEmpty() || !NotReverted.IsEmpty())
+		{
+			TArray<FString> Parts;
+			if (!Leaked.IsEmpty())      { Parts.Add(JoinTrimmed(TEXT("Leaked actors"), MoveTemp(Leaked))); }
+			if (!NotRestored.IsEmpty()) { Parts.Add(JoinTrimmed(TEXT("Deleted actors not restored"), MoveTemp(NotRestored))); }
+			if (!NotReverted.IsEmpty()) { Parts.Add(JoinTrimmed(TEXT("Modified actors not reverted"), MoveTemp(NotReverted))); }
+
+			Result.Passed = false;
+			Result.Detail = FString::Printf(
+				TEXT("Rollback verification FAILED (scoped, %d actors touched). %s"),
+				LastTouchedActors, *FString::Join(Parts, TEXT(" ")));
+			Result.DurationMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+			return Result;
+		}
+
+		Result.Passed = true;
+		Result.Detail = FString::Printf(
+			TEXT("Rollback verified OK (scoped: %d actors touched, all restored)."), LastTouchedActors);
+		Result.DurationMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+		return Result;
+	}
+
+	// Full scope, or the transaction holds actors the events did not report: check the whole level.
+	if (Recorder.IsSet())
+	{
+		++ScopedFallbacks;
+		LastTouchedActors = Recorder->NumTouched();
+	}
 	TArray<FString> PostRollbackLabels;
 	TArray<FString> PostRollbackPaths;
 	int32 PostRollbackCount = 0;
@@ -300,19 +586,35 @@ FVerificationPhaseResult UVerificationEngine::RunSnapshotRollback(
 	const bool bRollbackCorrect = (PostRollbackCount == PreStateActorCount);
 	if (!bRollbackCorrect)
 	{
+		// A scoped PreFlight kept only the count, so name the leaks from what the recorder saw.
+		FString LeakSummary;
+		if (Recorder.IsSet())
+		{
+			TArray<FString> Leaked, NotRestored, NotReverted;
+			Recorder->FindRollbackProblems(Leaked, NotRestored, NotReverted);
+			LeakSummary = Leaked.IsEmpty()
+				? FString(TEXT("No recorded spawns leaked; rollback leak source unresolved."))
+				: JoinTrimmed(TEXT("Leaked actors"), MoveTemp(Leaked));
+		}
+		else
+		{
+			LeakSummary = BuildRollbackLeakSummary(PreStateActorPaths, PostRollbackPaths);
+		}
+
 		Result.Passed = false;
 		Result.Detail = FString::Printf(
 			TEXT("Rollback verification FAILED: expected %d actors, got %d after undo. %s"),
-			PreStateActorCount, PostRollbackCount, *BuildRollbackLeakSummary(PreStateActorPaths, PostRollbackPaths));
+			PreStateActorCount, PostRollbackCount, *LeakSummary);
 		Result.DurationMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
 		return Result;
 	}
 
 	// Step 5: Re-execute for real (caller's responsibility to wrap in real transaction)
 	Result.Passed    = true;
-	Result.Detail    = FString::Printf(
-		TEXT("Rollback verified OK (%d actors restored). Snapshot: %s"),
-		PostRollbackCount, *FPaths::GetCleanFilename(SnapPath));
+	Result.Detail    = SnapPath.IsEmpty()
+		? FString::Printf(TEXT("Rollback verified OK (%d actors restored, full scan)."), PostRollbackCount)
+		: FString::Printf(TEXT("Rollback verified OK (%d actors restored). Snapshot: %s"),
+			PostRollbackCount, *FPaths::GetCleanFilename(SnapPath));
 #else
 	Result.Passed = true;
 	Result.Detail = TEXT("Editor not available — skipped.");
@@ -325,6 +627,7 @@ FVerificationPhaseResult UVerificationEngine::RunSnapshotRollback(
 // ============================================================================
 FVerificationPhaseResult UVerificationEngine::RunPostVerify(int32 ExpectedActorDelta)
 {
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Verification.RunPostVerify");
 	FVerificationPhaseResult Result;
 	Result.PhaseName = TEXT("PostVerify");
 
@@ -332,14 +635,7 @@ FVerificationPhaseResult UVerificationEngine::RunPostVerify(int32 ExpectedActorD
 
 #if WITH_EDITOR
 	UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
-	int32 PostActorCount = 0;
-	if (World)
-	{
-		for (TActorIterator<AActor> It(World); It; ++It)
-		{
-			if (*It && IsValid(*It)) { ++PostActorCount; }
-		}
-	}
+	const int32 PostActorCount = CountCurrentActors(World);
 
 	const int32 ActualDelta = PostActorCount - PreStateActorCount;
 	const bool  bDeltaOk    = (ActualDelta == ExpectedActorDelta);
@@ -365,35 +661,42 @@ FVerificationPhaseResult UVerificationEngine::RunPostVerify(int32 ExpectedActorD
 // ============================================================================
 FVerificationPhaseResult UVerificationEngine::RunBuildCheck()
 {
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Verification.RunBuildCheck");
 	FVerificationPhaseResult Result;
 	Result.PhaseName = TEXT("BuildCheck");
 
 	const double StartTime = FPlatformTime::Seconds();
 
 #if WITH_EDITOR
-	TArray<FString> Errors;
-	int32 BlueprintsChecked = 0;
+	++BuildChecks;
 
-	// Iterate all loaded Blueprint assets and recompile dirty ones
-	FAssetRegistryModule& RegistryModule =
-		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
-	IAssetRegistry& Registry = RegistryModule.Get();
+	// Only loaded Blueprints can have been edited; dirty or erroring ones are the candidates.
+	TArray<UBlueprint*> Candidates;
+	CollectBuildCheckCandidates(Candidates);
 
-	TArray<FAssetData> BlueprintAssets;
-	Registry.GetAssetsByClass(UBlueprint::StaticClass()->GetClassPathName(), BlueprintAssets);
-
-	for (const FAssetData& AssetData : BlueprintAssets)
+	const uint32 Key = BuildCheckKeyOf(Candidates);
+	if (bHasCachedBuildCheck && Key == CachedBuildCheckKey)
 	{
-		UBlueprint* BP = Cast<UBlueprint>(AssetData.GetAsset());
-		if (!BP || !BP->bBeingCompiled) { continue; }
+		++BuildCheckCacheHits;
+		Result = CachedBuildCheck;
+		Result.Detail += TEXT(" (cached)");
+		Result.DurationMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+		return Result;
+	}
 
+	TArray<FString> Errors;
+	int32 BlueprintsChecked = 0;
+	for (UBlueprint* BP : Candidates)
+	{
 		++BlueprintsChecked;
-		TArray<FCompilerResultsLog> Results;
-		FKismetEditorUtilities::CompileBlueprint(BP, EBlueprintCompileOptions::None);
+		if (BP->Status == BS_Dirty)
+		{
+			FKismetEditorUtilities::CompileBlueprint(BP, EBlueprintCompileOptions::None);
+		}
 
 		if (BP->Status == BS_Error)
 		{
-			Errors.Add(FString::Printf(TEXT("Blueprint compile error: %s"), *AssetData.AssetName.ToString()));
+			Errors.Add(FString::Printf(TEXT("Blueprint compile error: %s"), *BP->GetName()));
 		}
 	}
 
@@ -404,6 +707,13 @@ FVerificationPhaseResult UVerificationEngine::RunBuildCheck()
 		Errors.IsEmpty()
 		    ? TEXT("All clean.")
 		    : *FString::Join(Errors, TEXT("; ")));
+
+	// Keyed by the post-compile state, which is what the next check will see if nothing changes.
+	Candidates.Reset();
+	CollectBuildCheckCandidates(Candidates);
+	CachedBuildCheckKey  = BuildCheckKeyOf(Candidates);
+	CachedBuildCheck     = Result;
+	bHasCachedBuildCheck = true;
 #else
 	Result.Passed = true;
 	Result.Detail = TEXT("Editor not available — skipped.");
@@ -414,63 +724,17 @@ FVerificationPhaseResult UVerificationEngine::RunBuildCheck()
 }
 
 // ============================================================================
-FString UVerificationEngine::CreateSnapshot(const FString& SnapshotName)
+FString UVerificationEngine::CreateSnapshot(const FString& SnapshotName, bool bExportJson)
 {
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Verification.CreateSnapshot");
 #if WITH_EDITOR
 	UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
 	if (!World) { return FString(); }
 
-	// Build JSON array of actor states
-	TArray<TSharedPtr<FJsonValue>> ActorArray;
-	for (TActorIterator<AActor> It(World); It; ++It)
-	{
-		AActor* Actor = *It;
-		if (!Actor || !IsValid(Actor)) { continue; }
-
-		TSharedPtr<FJsonObject> ActorObj = MakeShared<FJsonObject>();
-		ActorObj->SetStringField(TEXT("label"),  Actor->GetActorLabel());
-		ActorObj->SetStringField(TEXT("class"),  Actor->GetClass()->GetName());
-		ActorObj->SetStringField(TEXT("path"),   Actor->GetPathName());
-
-		const FVector  Loc   = Actor->GetActorLocation();
-		const FRotator Rot   = Actor->GetActorRotation();
-		const FVector  Scale = Actor->GetActorScale3D();
-
-		TSharedPtr<FJsonObject> LocObj = MakeShared<FJsonObject>();
-		LocObj->SetNumberField(TEXT("x"), Loc.X);
-		LocObj->SetNumberField(TEXT("y"), Loc.Y);
-		LocObj->SetNumberField(TEXT("z"), Loc.Z);
-		ActorObj->SetObjectField(TEXT("location"), LocObj);
-
-		TSharedPtr<FJsonObject> RotObj = MakeShared<FJsonObject>();
-		RotObj->SetNumberField(TEXT("pitch"), Rot.Pitch);
-		RotObj->SetNumberField(TEXT("yaw"),   Rot.Yaw);
-		RotObj->SetNumberField(TEXT("roll"),  Rot.Roll);
-		ActorObj->SetObjectField(TEXT("rotation"), RotObj);
-
-		ActorArray.Add(MakeShared<FJsonValueObject>(ActorObj));
-	}
-
-	TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
-	Root->SetStringField(TEXT("snapshot_name"),  SnapshotName);
-	Root->SetStringField(TEXT("timestamp"),      FDateTime::Now().ToString());
-	Root->SetNumberField(TEXT("actor_count"),    static_cast<double>(ActorArray.Num()));
-	Root->SetArrayField(TEXT("actors"),          ActorArray);
-
-	FString JsonStr;
-	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonStr);
-	FJsonSerializer::Serialize(Root.ToSharedRef(), Writer);
-
-	// Save to ProjectSaved/AgentForgeSnapshots/
-	const FString Dir = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("AgentForgeSnapshots"));
-	IFileManager::Get().MakeDirectory(*Dir, true);
-
-	const FString Timestamp = FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S"));
-	const FString SafeName  = SnapshotName.IsEmpty() ? TEXT("snapshot") : SnapshotName;
-	const FString FilePath  = FPaths::Combine(Dir, FString::Printf(TEXT("%s_%s.json"), *SafeName, *Timestamp));
-
-	FFileHelper::SaveStringToFile(JsonStr, *FilePath);
-	return FilePath;
+	// Capture is the only part on the game thread; the file is written in the background.
+	FAgentForgeWorldSnapshotPtr Snapshot = MakeShared<FAgentForgeWorldSnapshot, ESPMode::ThreadSafe>(
+		FAgentForgeWorldSnapshot::Capture(World, SnapshotName));
+	return FAgentForgeSnapshotStore::Get().Write(Snapshot, bExportJson);
 #else
 	return FString();
 #endif
@@ -479,53 +743,77 @@ FString UVerificationEngine::CreateSnapshot(const FString& SnapshotName)
 // ============================================================================
 FString UVerificationEngine::DiffSnapshots(const FString& SnapshotPathA, const FString& SnapshotPathB)
 {
-	auto LoadActorLabels = [](const FString& Path) -> TSet<FString>
+	AGENTFORGE_TRACE_SCOPE("AgentForge.Verification.DiffSnapshots");
+	FString Error;
+	const FAgentForgeWorldSnapshotPtr A = FAgentForgeSnapshotStore::Get().Load(SnapshotPathA, &Error);
+	const FAgentForgeWorldSnapshotPtr B = A.IsValid() ? FAgentForgeSnapshotStore::Get().Load(SnapshotPathB, &Error) : nullptr;
+	if (!A.IsValid() || !B.IsValid())
 	{
-		TSet<FString> Labels;
-		FString JsonStr;
-		if (!FFileHelper::LoadFileToString(JsonStr, *Path)) { return Labels; }
-
-		TSharedPtr<FJsonObject> Root;
-		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonStr);
-		if (!FJsonSerializer::Deserialize(Reader, Root)) { return Labels; }
+		return FString::Printf(TEXT("Snapshot diff failed: %s"), *Error);
+	}
 
-		const TArray<TSharedPtr<FJsonValue>>* Actors;
-		if (!Root->TryGetArrayField(TEXT("actors"), Actors)) { return Labels; }
+	const FAgentForgeWorldSnapshot::FDiff Delta = FAgentForgeWorldSnapshot::Diff(*A, *B);
+	if (Delta.IsEmpty())
+	{
+		return TEXT("Snapshots identical.");
+	}
 
-		for (const TSharedPtr<FJsonValue>& V : *Actors)
+	auto JoinLabels = [](const FAgentForgeWorldSnapshot& Snapshot, const TArray<int32>& Indices)
+	{
+		TArray<FString> Labels;
+		Labels.Reserve(Indices.Num());
+		for (const int32 Index : Indices)
 		{
-			const TSharedPtr<FJsonObject>* Obj;
-			if (V->TryGetObject(Obj))
-			{
-				FString Label;
-				if ((*Obj)->TryGetStringField(TEXT("label"), Label))
-				{
-					Labels.Add(Label);
-				}
-			}
+			Labels.Add(Snapshot.GetLabel(Snapshot.Actors[Index]));
 		}
-		return Labels;
+		return FString::Join(Labels, TEXT(", "));
 	};
 
-	const TSet<FString> A = LoadActorLabels(SnapshotPathA);
-	const TSet<FString> B = LoadActorLabels(SnapshotPathB);
-
-	TArray<FString> Added   = B.Difference(A).Array();
-	TArray<FString> Removed = A.Difference(B).Array();
-
-	if (Added.IsEmpty() && Removed.IsEmpty())
+	FString Diff;
+	if (!Delta.Added.IsEmpty())
 	{
-		return TEXT("Snapshots identical.");
+		Diff += FString::Printf(TEXT("+ Added (%d): %s\n"), Delta.Added.Num(), *JoinLabels(*B, Delta.Added));
 	}
-
-	FString Diff;
-	if (!Added.IsEmpty())
+	if (!Delta.Removed.IsEmpty())
 	{
-		Diff += FString::Printf(TEXT("+ Added (%d): %s\n"), Added.Num(), *FString::Join(Added, TEXT(", ")));
+		Diff += FString::Printf(TEXT("- Removed (%d): %s\n"), Delta.Removed.Num(), *JoinLabels(*A, Delta.Removed));
 	}
-	if (!Removed.IsEmpty())
+	if (!Delta.Changed.IsEmpty())
 	{
-		Diff += FString::Printf(TEXT("- Removed (%d): %s\n"), Removed.Num(), *FString::Join(Removed, TEXT(", ")));
+		Diff += FString::Printf(TEXT("~ Changed (%d): %s\n"), Delta.Changed.Num(), *JoinLabels(*B, Delta.Changed));
 	}
 	return Diff.TrimEnd();
 }
+
+// ============================================================================
+bool UVerificationEngine::ParseRollbackScope(const FString& Name, EVerificationRollbackScope& OutScope)
+{
+	if (Name.Equals(TEXT("scoped"), ESearchCase::IgnoreCase))
+	{
+		OutScope = EVerificationRollbackScope::Scoped;
+		return true;
+	}
+	if (Name.Equals(TEXT("full"), ESearchCase::IgnoreCase))
+	{
+		OutScope = EVerificationRollbackScope::Full;
+		return true;
+	}
+	return false;
+}
+
+const TCHAR* UVerificationEngine::RollbackScopeName(EVerificationRollbackScope Scope)
+{
+	return Scope == EVerificationRollbackScope::Full ? TEXT("full") : TEXT("scoped");
+}
+
+TSharedPtr<FJsonObject> UVerificationEngine::GetStatsJson() const
+{
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetStringField(TEXT("rollback_scope"),      RollbackScopeName(RollbackScope));
+	Obj->SetNumberField(TEXT("rollback_tests"),      RollbackTests);
+	Obj->SetNumberField(TEXT("scoped_fallbacks"),    ScopedFallbacks);
+	Obj->SetNumberField(TEXT("last_touched_actors"), LastTouchedActors);
+	Obj->SetNumberField(TEXT("build_checks"),        BuildChecks);
+	Obj->SetNumberField(TEXT("build_check_cache_hits"), BuildCheckCacheHits);
+	return Obj;
+}
@@ -1,10 +1,387 @@
 // Copyright UEAgentForge Project. All Rights Reserved.
-// SceneCapture.cpp - baseline visual scoring helpers.
+// SceneCapture.cpp - batched SceneCapture2D rendering, GPU readback and PNG export.
 
 #include "Visual/SceneCapture.h"
 
+#include "Async/Async.h"
+#include "Components/SceneCaptureComponent2D.h"
+#include "Engine/TextureRenderTarget2D.h"
 #include "Engine/World.h"
+#include "Math/VectorRegister.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "IImageWrapperModule.h"
+#include "ImageUtils.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Modules/ModuleManager.h"
+#include "RHIGPUReadback.h"
+#include "RenderingThread.h"
+#include "TextureResource.h"
+#include "UObject/GCObject.h"
+#include "UObject/Package.h"
+#include <atomic>
 
+namespace
+{
+	static constexpr double ReadbackTimeoutSeconds = 30.0;
+	// Views rendered before their readbacks are drained; bounds pooled render-target memory.
+	static constexpr int32 MaxViewsPerBatch = 8;
+
+	/** Render targets reused across captures; referenced here so GC keeps them. */
+	class FSceneCaptureTargetPool : public FGCObject
+	{
+	public:
+		static FSceneCaptureTargetPool& Get()
+		{
+			static FSceneCaptureTargetPool Instance;
+			return Instance;
+		}
+
+		/** First Count pooled targets of Size. A size change drops the old targets. */
+		void Acquire(int32 Count, const FIntPoint& Size, TArray<UTextureRenderTarget2D*>& OutTargets)
+		{
+			if (Size != TargetSize)
+			{
+				Targets.Reset();
+				TargetSize = Size;
+			}
+			while (Targets.Num() < Count)
+			{
+				UTextureRenderTarget2D* Target = NewObject<UTextureRenderTarget2D>(GetTransientPackage(), NAME_None, RF_Transient);
+				Target->ClearColor = FLinearColor::Black;
+				Target->InitCustomFormat(Size.X, Size.Y, PF_B8G8R8A8, false);
+				Targets.Add(Target);
+			}
+			OutTargets.Reset(Count);
+			for (int32 Index = 0; Index < Count; ++Index)
+			{
+				OutTargets.Add(Targets[Index]);
+			}
+		}
+
+		virtual void AddReferencedObjects(FReferenceCollector& Collector) override
+		{
+			Collector.AddReferencedObjects(Targets);
+		}
+
+		virtual FString GetReferencerName() const override
+		{
+			return TEXT("FSceneCaptureTargetPool");
+		}
+
+	private:
+		TArray<TObjectPtr<UTextureRenderTarget2D>> Targets;
+		FIntPoint TargetSize = FIntPoint::ZeroValue;
+	};
+
+	static bool EncodePng(TArray<FColor> Pixels, FIntPoint Size, const FString& Path)
+	{
+		for (FColor& Pixel : Pixels)
+		{
+			Pixel.A = 255;
+		}
+		TArray64<uint8> Png;
+		FImageUtils::PNGCompressImageArray(Size.X, Size.Y, TArrayView64<const FColor>(Pixels.GetData(), Pixels.Num()), Png);
+		return Png.Num() > 0 && FFileHelper::SaveArrayToFile(Png, *Path);
+	}
+}
+
+/** One batch of readbacks, shared between the game thread (polls) and the render thread (fills). */
+struct FSceneCaptureReadbackState
+{
+	TArray<TUniquePtr<FRHIGPUTextureReadback>> Readbacks;
+	TArray<FTextureRenderTargetResource*>      Resources;
+	TArray<TArray<FColor>>                     Pixels;
+	TArray<bool>                               bRead;   // render thread only
+	FIntPoint                                  Size = FIntPoint::ZeroValue;
+	int32                                      FirstView = 0;
+	FThreadSafeCounter                         Remaining;
+	std::atomic<bool>                          bCheckQueued { false };
+};
+
+namespace
+{
+	/** Copy every readback whose fence has passed. Render thread. */
+	static void DrainReadyReadbacks(FSceneCaptureReadbackState& State)
+	{
+		const int32 Width = State.Size.X;
+		const int32 Height = State.Size.Y;
+		for (int32 View = 0; View < State.Readbacks.Num(); ++View)
+		{
+			if (State.bRead[View] || !State.Readbacks[View]->IsReady())
+			{
+				continue;
+			}
+			int32 RowPitch = 0;
+			const FColor* Data = static_cast<const FColor*>(State.Readbacks[View]->Lock(RowPitch));
+			TArray<FColor>& Pixels = State.Pixels[View];
+			Pixels.SetNumUninitialized(Width * Height);
+			for (int32 Y = 0; Y < Height; ++Y)
+			{
+				FMemory::Memcpy(&Pixels[Y * Width], Data + (int64)Y * RowPitch, Width * sizeof(FColor));
+			}
+			State.Readbacks[View]->Unlock();
+			State.bRead[View] = true;
+			State.Remaining.Decrement();
+		}
+	}
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  FSceneCaptureRun
+// ─────────────────────────────────────────────────────────────────────────────
+FSceneCaptureRun::FSceneCaptureRun(UWorld* InWorld, const TArray<FTransform>& CameraTransforms, const FSceneCaptureSettings& Settings)
+{
+	Start(InWorld, CameraTransforms, Settings);
+}
+
+FSceneCaptureRun::FSceneCaptureRun(UWorld* InWorld, const TArray<FTransform>& CameraTransforms, const FString& InOutputDirectory, const FSceneCaptureSettings& Settings)
+	: OutputDirectory(InOutputDirectory)
+{
+	if (OutputDirectory.IsEmpty())
+	{
+		Fail(TEXT("CaptureSceneImages failed: output directory is empty."));
+		return;
+	}
+	if (!IFileManager::Get().MakeDirectory(*OutputDirectory, true))
+	{
+		Fail(FString::Printf(TEXT("CaptureSceneImages failed: cannot create %s."), *OutputDirectory));
+		return;
+	}
+
+	const FString BaseName = Settings.BaseName.IsEmpty() ? FString(TEXT("capture")) : Settings.BaseName.Replace(TEXT(" "), TEXT("_"));
+	FilePrefix = FString::Printf(TEXT("%s_%s_"), *BaseName, *FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S_%s")));
+
+	// Loaded here so the encoder tasks never trigger a module load off the game thread.
+	FModuleManager::LoadModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"));
+	Start(InWorld, CameraTransforms, Settings);
+}
+
+FSceneCaptureRun::~FSceneCaptureRun()
+{
+	ReleaseBatch();
+	ReleaseCapture();
+}
+
+void FSceneCaptureRun::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	Collector.AddReferencedObject(Capture);
+}
+
+FString FSceneCaptureRun::GetReferencerName() const
+{
+	return TEXT("FSceneCaptureRun");
+}
+
+void FSceneCaptureRun::ReleaseCapture()
+{
+	if (Capture)
+	{
+		Capture->TextureTarget = nullptr;
+		Capture->UnregisterComponent();
+		Capture->MarkAsGarbage();
+		Capture = nullptr;
+	}
+}
+
+void FSceneCaptureRun::Start(UWorld* InWorld, const TArray<FTransform>& CameraTransforms, const FSceneCaptureSettings& Settings)
+{
+	check(IsInGameThread());
+	if (!InWorld)
+	{
+		Fail(TEXT("Scene capture failed: invalid world."));
+		return;
+	}
+	if (CameraTransforms.Num() == 0)
+	{
+		Fail(TEXT("Scene capture failed: no camera transforms provided."));
+		return;
+	}
+
+	World = InWorld;
+	Cameras = CameraTransforms;
+	Size = FIntPoint(
+		FMath::Clamp(Settings.Width, 16, FSceneCapture::MaxResolution),
+		FMath::Clamp(Settings.Height, 16, FSceneCapture::MaxResolution));
+	Images.Reserve(Cameras.Num());
+	Encoders.Reserve(Cameras.Num());
+
+	Capture = NewObject<USceneCaptureComponent2D>(GetTransientPackage(), NAME_None, RF_Transient);
+	Capture->bCaptureEveryFrame = false;
+	Capture->bCaptureOnMovement = false;
+	Capture->CaptureSource = ESceneCaptureSource::SCS_FinalColorLDR;
+	Capture->FOVAngle = FMath::Clamp(Settings.FOVDegrees, 5.0f, 170.0f);
+	Capture->RegisterComponentWithWorld(InWorld);
+	StartSeconds = FPlatformTime::Seconds();
+}
+
+FSceneCaptureRun::EStatus FSceneCaptureRun::Poll()
+{
+	check(IsInGameThread());
+	if (Status != EStatus::Pending)
+	{
+		return Status;
+	}
+	if (!World.IsValid() || !Capture)
+	{
+		return Fail(TEXT("Scene capture failed: the world went away during capture."));
+	}
+
+	if (Batch.IsValid())
+	{
+		if (Batch->Remaining.GetValue() > 0)
+		{
+			if (FPlatformTime::Seconds() - StartSeconds > ReadbackTimeoutSeconds)
+			{
+				return Fail(FString::Printf(TEXT("Scene capture failed: GPU readback timed out after %.0f s."), ReadbackTimeoutSeconds));
+			}
+			QueueFenceCheck();
+			return EStatus::Pending;
+		}
+		for (int32 View = 0; View < Batch->Pixels.Num(); ++View)
+		{
+			DeliverView(Batch->FirstView + View, MoveTemp(Batch->Pixels[View]));
+		}
+		ReleaseBatch();
+	}
+
+	if (NextView < Cameras.Num())
+	{
+		RenderNextBatch();
+		return EStatus::Pending;
+	}
+
+	// Every view is read back; PNGs may still be encoding.
+	for (const TFuture<bool>& Encoder : Encoders)
+	{
+		if (!Encoder.IsReady())
+		{
+			return EStatus::Pending;
+		}
+	}
+	bool bEncoded = true;
+	for (TFuture<bool>& Encoder : Encoders)
+	{
+		bEncoded &= Encoder.Get();
+	}
+	Encoders.Reset();
+	if (!bEncoded)
+	{
+		return Fail(FString::Printf(TEXT("CaptureSceneImages failed: could not write PNGs to %s."), *OutputDirectory));
+	}
+
+	ReleaseCapture();
+	Status = EStatus::Succeeded;
+	return Status;
+}
+
+float FSceneCaptureRun::GetProgress() const
+{
+	return Cameras.Num() > 0 ? (float)ViewsRead / (float)Cameras.Num() : 0.0f;
+}
+
+void FSceneCaptureRun::RenderNextBatch()
+{
+	const int32 BatchCount = FMath::Min(MaxViewsPerBatch, Cameras.Num() - NextView);
+	TArray<UTextureRenderTarget2D*> Targets;
+	FSceneCaptureTargetPool::Get().Acquire(BatchCount, Size, Targets);
+
+	Batch = MakeShared<FSceneCaptureReadbackState, ESPMode::ThreadSafe>();
+	Batch->Size = Size;
+	Batch->FirstView = NextView;
+	Batch->Pixels.SetNum(BatchCount);
+	Batch->bRead.Init(false, BatchCount);
+	Batch->Remaining.Set(BatchCount);
+
+	// Queue every view of the batch before reading any of them back.
+	for (int32 View = 0; View < BatchCount; ++View)
+	{
+		Capture->TextureTarget = Targets[View];
+		Capture->SetWorldTransform(Cameras[NextView + View]);
+		Capture->CaptureScene();
+		Batch->Readbacks.Add(MakeUnique<FRHIGPUTextureReadback>(TEXT("AgentForge.SceneCapture.Readback")));
+		Batch->Resources.Add(Targets[View]->GameThread_GetRenderTargetResource());
+	}
+	NextView += BatchCount;
+
+	ENQUEUE_RENDER_COMMAND(AgentForgeSceneCaptureCopy)([State = Batch](FRHICommandListImmediate& RHICmdList)
+	{
+		for (int32 View = 0; View < State->Readbacks.Num(); ++View)
+		{
+			State->Readbacks[View]->EnqueueCopy(RHICmdList, State->Resources[View]->GetRenderTargetTexture());
+		}
+		// Submit now rather than at frame end: an inline caller holds the game
+		// thread, so the frame that would submit these may be a while off.
+		RHICmdList.ImmediateFlush(EImmediateFlushType::DispatchToRHIThread);
+	});
+	QueueFenceCheck();
+}
+
+void FSceneCaptureRun::QueueFenceCheck()
+{
+	// At most one check in flight; the game thread only reads Remaining.
+	if (Batch->bCheckQueued.exchange(true))
+	{
+		return;
+	}
+	ENQUEUE_RENDER_COMMAND(AgentForgeSceneCapturePoll)([State = Batch](FRHICommandListImmediate&)
+	{
+		DrainReadyReadbacks(*State);
+		State->bCheckQueued.store(false);
+	});
+}
+
+void FSceneCaptureRun::ReleaseBatch()
+{
+	if (!Batch.IsValid())
+	{
+		return;
+	}
+	// Readback RHI resources are released on the render thread.
+	ENQUEUE_RENDER_COMMAND(AgentForgeSceneCaptureRelease)([State = MoveTemp(Batch)](FRHICommandListImmediate&)
+	{
+		State->Readbacks.Reset();
+	});
+	Batch.Reset();
+}
+
+void FSceneCaptureRun::DeliverView(int32 View, TArray<FColor>&& Pixels)
+{
+	++ViewsRead;
+	if (OutputDirectory.IsEmpty())
+	{
+		FSceneCaptureImage& Image = Images.AddDefaulted_GetRef();
+		Image.Pixels = MoveTemp(Pixels);
+		Image.Size = Size;
+		return;
+	}
+
+	// Encoding runs on the thread pool and overlaps the next batch's rendering.
+	const FString Path = FPaths::Combine(OutputDirectory, FString::Printf(TEXT("%s%d.png"), *FilePrefix, View));
+	ImagePaths.Add(Path);
+	Encoders.Add(Async(EAsyncExecution::ThreadPool, [Pixels = MoveTemp(Pixels), Size = Size, Path]() mutable
+	{
+		return EncodePng(MoveTemp(Pixels), Size, Path);
+	}));
+}
+
+FSceneCaptureRun::EStatus FSceneCaptureRun::Fail(const FString& Message)
+{
+	ReleaseBatch();
+	ReleaseCapture();
+	Error = Message;
+	Status = EStatus::Failed;
+	ImagePaths.Reset();
+	Images.Reset();
+	return Status;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  FSceneCapture
+// ─────────────────────────────────────────────────────────────────────────────
 bool FSceneCapture::CaptureSceneImages(
 	UWorld* World,
 	const TArray<FTransform>& CameraTransforms,
@@ -12,28 +389,58 @@ bool FSceneCapture::CaptureSceneImages(
 	TArray<FString>& OutImagePaths,
 	FString& OutError)
 {
+	return CaptureSceneImages(World, CameraTransforms, OutputDirectory, FSceneCaptureSettings(), OutImagePaths, OutError);
+}
+
+bool FSceneCapture::CaptureSceneImages(
+	UWorld* World,
+	const TArray<FTransform>& CameraTransforms,
+	const FString& OutputDirectory,
+	const FSceneCaptureSettings& Settings,
+	TArray<FString>& OutImagePaths,
+	FString& OutError)
+{
+	check(IsInGameThread());
 	OutImagePaths.Reset();
 	OutError.Empty();
 
-	if (!World)
+	// Inline callers hold the game thread anyway; the render thread drains
+	// the readbacks on its own, so this loop never flushes or sleeps.
+	FSceneCaptureRun Run(World, CameraTransforms, OutputDirectory, Settings);
+	while (Run.Poll() == FSceneCaptureRun::EStatus::Pending)
 	{
-		OutError = TEXT("CaptureSceneImages failed: invalid world.");
-		return false;
 	}
-	if (CameraTransforms.Num() == 0)
+	if (!Run.GetError().IsEmpty())
 	{
-		OutError = TEXT("CaptureSceneImages failed: no camera transforms provided.");
+		OutError = Run.GetError();
 		return false;
 	}
-	if (OutputDirectory.IsEmpty())
+	OutImagePaths = Run.GetImagePaths();
+	return true;
+}
+
+bool FSceneCapture::CaptureScenePixels(
+	UWorld* World,
+	const TArray<FTransform>& CameraTransforms,
+	const FSceneCaptureSettings& Settings,
+	TArray<FSceneCaptureImage>& OutImages,
+	FString& OutError)
+{
+	check(IsInGameThread());
+	OutImages.Reset();
+	OutError.Empty();
+
+	FSceneCaptureRun Run(World, CameraTransforms, Settings);
+	while (Run.Poll() == FSceneCaptureRun::EStatus::Pending)
+	{
+	}
+	if (!Run.GetError().IsEmpty())
 	{
-		OutError = TEXT("CaptureSceneImages failed: output directory is empty.");
+		OutError = Run.GetError();
 		return false;
 	}
-
-	// Phase 2 skeleton: SceneCapture2D export pipeline will be wired here.
-	OutError = TEXT("CaptureSceneImages not implemented yet.");
-	return false;
+	OutImages = MoveTemp(Run.GetImages());
+	return true;
 }
 
 float FSceneCapture::ComputeCompositionScore(const TArray<float>& Metrics)
@@ -73,16 +480,34 @@ float FSceneCapture::ComputeImageSimilarity(const TArray<float>& FeaturesA, cons
 		return 0.0f;
 	}
 
-	float Dot = 0.0f;
-	float LenA = 0.0f;
-	float LenB = 0.0f;
-	for (int32 Index = 0; Index < FeaturesA.Num(); ++Index)
+	const int32 Num = FeaturesA.Num();
+	const float* A = FeaturesA.GetData();
+	const float* B = FeaturesB.GetData();
+	VectorRegister4Float Dot4 = VectorZeroFloat();
+	VectorRegister4Float LenA4 = VectorZeroFloat();
+	VectorRegister4Float LenB4 = VectorZeroFloat();
+	int32 Index = 0;
+	for (; Index + 4 <= Num; Index += 4)
 	{
-		const float A = FeaturesA[Index];
-		const float B = FeaturesB[Index];
-		Dot += A * B;
-		LenA += A * A;
-		LenB += B * B;
+		const VectorRegister4Float VA = VectorLoad(A + Index);
+		const VectorRegister4Float VB = VectorLoad(B + Index);
+		Dot4 = VectorMultiplyAdd(VA, VB, Dot4);
+		LenA4 = VectorMultiplyAdd(VA, VA, LenA4);
+		LenB4 = VectorMultiplyAdd(VB, VB, LenB4);
+	}
+
+	alignas(16) float Lanes[3][4];
+	VectorStoreAligned(Dot4, Lanes[0]);
+	VectorStoreAligned(LenA4, Lanes[1]);
+	VectorStoreAligned(LenB4, Lanes[2]);
+	float Dot = (Lanes[0][0] + Lanes[0][1]) + (Lanes[0][2] + Lanes[0][3]);
+	float LenA = (Lanes[1][0] + Lanes[1][1]) + (Lanes[1][2] + Lanes[1][3]);
+	float LenB = (Lanes[2][0] + Lanes[2][1]) + (Lanes[2][2] + Lanes[2][3]);
+	for (; Index < Num; ++Index)
+	{
+		Dot += A[Index] * B[Index];
+		LenA += A[Index] * A[Index];
+		LenB += B[Index] * B[Index];
 	}
 
 	const float Denom = FMath::Sqrt(LenA * LenB);
@@ -93,3 +518,73 @@ float FSceneCapture::ComputeImageSimilarity(const TArray<float>& FeaturesA, cons
 	return FMath::Clamp(Dot / Denom, 0.0f, 1.0f);
 }
 
+void FSceneCapture::ComputeImageFeatures(const TArray<FColor>& Pixels, const FIntPoint& Size, TArray<float>& OutFeatures)
+{
+	constexpr int32 Grid = FeatureGridSize;
+	OutFeatures.Reset();
+	if (Size.X <= 0 || Size.Y <= 0 || Pixels.Num() != Size.X * Size.Y)
+	{
+		return;
+	}
+
+	TArray<float> Sums;
+	TArray<int32> Counts;
+	Sums.SetNumZeroed(Grid * Grid);
+	Counts.SetNumZeroed(Grid * Grid);
+	for (int32 Y = 0; Y < Size.Y; ++Y)
+	{
+		const int32 GY = FMath::Min(Grid - 1, (int32)((int64)Y * Grid / Size.Y));
+		const FColor* Row = Pixels.GetData() + (int64)Y * Size.X;
+		for (int32 X = 0; X < Size.X; ++X)
+		{
+			const int32 Cell = GY * Grid + FMath::Min(Grid - 1, (int32)((int64)X * Grid / Size.X));
+			// Rec. 601 luma on 0..255 gamma values.
+			Sums[Cell] += 0.299f * Row[X].R + 0.587f * Row[X].G + 0.114f * Row[X].B;
+			++Counts[Cell];
+		}
+	}
+
+	OutFeatures.SetNumUninitialized(Grid * Grid);
+	float Mean = 0.0f;
+	for (int32 Cell = 0; Cell < Grid * Grid; ++Cell)
+	{
+		OutFeatures[Cell] = Counts[Cell] > 0 ? Sums[Cell] / (255.0f * (float)Counts[Cell]) : 0.0f;
+		Mean += OutFeatures[Cell];
+	}
+	Mean /= (float)(Grid * Grid);
+	for (float& Value : OutFeatures)
+	{
+		Value -= Mean;
+	}
+}
+
+uint64 FSceneCapture::ComputePerceptualHash(const TArray<float>& Features)
+{
+	constexpr int32 Grid = FeatureGridSize;
+	constexpr int32 Block = Grid / 8;
+	if (Features.Num() != Grid * Grid)
+	{
+		return 0;
+	}
+
+	uint64 Hash = 0;
+	for (int32 BY = 0; BY < 8; ++BY)
+	{
+		for (int32 BX = 0; BX < 8; ++BX)
+		{
+			float Sum = 0.0f;
+			for (int32 Y = BY * Block; Y < (BY + 1) * Block; ++Y)
+			{
+				for (int32 X = BX * Block; X < (BX + 1) * Block; ++X)
+				{
+					Sum += Features[Y * Grid + X];
+				}
+			}
+			if (Sum > 0.0f)
+			{
+				Hash |= 1ull << (BY * 8 + BX);
+			}
+		}
+	}
+	return Hash;
+}
@@ -3,142 +3,257 @@
 
 #include "Visual/SceneEvaluator.h"
 
+#include "Distribution/SpatialFilters.h"
+
+#include "Async/ParallelFor.h"
+
 namespace
 {
+	// Grid resolutions and empty-space target used by EvaluateScene.
+	static constexpr int32 SceneDensityGrid = 10;
+	static constexpr int32 SceneEmptyGrid = 12;
+	static constexpr float SceneEmptyTarget = 0.28f;
+
+	// Points per ParallelFor work item in the nearest-neighbour pass.
+	static constexpr int32 ClusterChunkSize = 4096;
+
 	static FORCEINLINE int32 CellIndex(const int32 X, const int32 Y, const int32 Width)
 	{
 		return (Y * Width) + X;
 	}
 
+	/** Maps points to cells of a Grid x Grid occupancy grid over Bounds. */
+	struct FOccupancyBinner
+	{
+		FVector2D Min;
+		FVector2D Size;
+
+		explicit FOccupancyBinner(const FBox& Bounds)
+			: Min(Bounds.Min.X, Bounds.Min.Y)
+			, Size(
+				FMath::Max(1.0f, Bounds.Max.X - Bounds.Min.X),
+				FMath::Max(1.0f, Bounds.Max.Y - Bounds.Min.Y))
+		{
+		}
+
+		FORCEINLINE void UV(const FVector& Point, float& OutU, float& OutV) const
+		{
+			OutU = FMath::Clamp((Point.X - Min.X) / Size.X, 0.0f, 0.99999f);
+			OutV = FMath::Clamp((Point.Y - Min.Y) / Size.Y, 0.0f, 0.99999f);
+		}
+
+		static FORCEINLINE int32 Cell(const float U, const float V, const int32 Grid)
+		{
+			const int32 X = FMath::Clamp(FMath::FloorToInt(U * Grid), 0, Grid - 1);
+			const int32 Y = FMath::Clamp(FMath::FloorToInt(V * Grid), 0, Grid - 1);
+			return CellIndex(X, Y, Grid);
+		}
+	};
+
 	static TArray<int32> BuildOccupancyGrid(
 		const TArray<FVector>& Points,
 		const FBox& Bounds,
 		const int32 GridResolution)
-{
+	{
 		const int32 Grid = FMath::Max(2, GridResolution);
 		TArray<int32> Cells;
 		Cells.SetNumZeroed(Grid * Grid);
 
-		const FVector2D Size2D(
-			FMath::Max(1.0f, Bounds.Max.X - Bounds.Min.X),
-			FMath::Max(1.0f, Bounds.Max.Y - Bounds.Min.Y));
-
+		const FOccupancyBinner Binner(Bounds);
 		for (const FVector& Point : Points)
 		{
-			const float U = FMath::Clamp((Point.X - Bounds.Min.X) / Size2D.X, 0.0f, 0.99999f);
-			const float V = FMath::Clamp((Point.Y - Bounds.Min.Y) / Size2D.Y, 0.0f, 0.99999f);
-			const int32 X = FMath::Clamp(FMath::FloorToInt(U * Grid), 0, Grid - 1);
-			const int32 Y = FMath::Clamp(FMath::FloorToInt(V * Grid), 0, Grid - 1);
-			Cells[CellIndex(X, Y, Grid)] += 1;
+			float U, V;
+			Binner.UV(Point, U, V);
+			Cells[FOccupancyBinner::Cell(U, V, Grid)] += 1;
 		}
 
 		return Cells;
 	}
-}
 
-float FSceneEvaluator::ComputeObjectDensityVariance(
-	const TArray<FVector>& Points,
-	const FBox& Bounds,
-	int32 GridResolution)
-{
-	if (!Bounds.IsValid || Points.Num() == 0)
+	static FORCEINLINE int32 QuadrantIndex(const FVector& Point, const FVector2D& Center)
 	{
-		return 0.0f;
+		const bool bRight = Point.X >= Center.X;
+		const bool bTop = Point.Y >= Center.Y;
+		return (bTop ? 2 : 0) + (bRight ? 1 : 0);
 	}
 
-	const TArray<int32> Cells = BuildOccupancyGrid(Points, Bounds, GridResolution);
-	if (Cells.Num() == 0)
+	static FVector2D BoundsCenter2D(const FBox& Bounds)
 	{
-		return 0.0f;
+		return FVector2D((Bounds.Min.X + Bounds.Max.X) * 0.5f, (Bounds.Min.Y + Bounds.Max.Y) * 0.5f);
 	}
 
-	float Mean = 0.0f;
-	for (const int32 Count : Cells)
+	// ─── Metrics from binned counts ─────────────────────────────────────────
+
+	static float DensityVarianceFromCells(const TArray<int32>& Cells)
 	{
-		Mean += (float)Count;
+		if (Cells.Num() == 0)
+		{
+			return 0.0f;
+		}
+
+		float Mean = 0.0f;
+		for (const int32 Count : Cells)
+		{
+			Mean += (float)Count;
+		}
+		Mean /= (float)Cells.Num();
+
+		if (Mean <= KINDA_SMALL_NUMBER)
+		{
+			return 0.0f;
+		}
+
+		float Variance = 0.0f;
+		for (const int32 Count : Cells)
+		{
+			const float Delta = (float)Count - Mean;
+			Variance += Delta * Delta;
+		}
+		Variance /= (float)Cells.Num();
+
+		const float StdDev = FMath::Sqrt(FMath::Max(0.0f, Variance));
+		const float CoeffVar = StdDev / Mean;
+		const float TargetCoeffVar = 0.60f;
+		return FMath::Clamp(1.0f - FMath::Abs(CoeffVar - TargetCoeffVar), 0.0f, 1.0f);
 	}
-	Mean /= (float)Cells.Num();
 
-	if (Mean <= KINDA_SMALL_NUMBER)
+	static float EmptySpaceFromCells(const TArray<int32>& Cells, const float TargetEmptyRatio)
 	{
-		return 0.0f;
+		if (Cells.Num() == 0)
+		{
+			return 0.0f;
+		}
+
+		int32 Empty = 0;
+		for (const int32 Count : Cells)
+		{
+			if (Count == 0)
+			{
+				++Empty;
+			}
+		}
+
+		const float EmptyRatio = (float)Empty / (float)Cells.Num();
+		const float Target = FMath::Clamp(TargetEmptyRatio, 0.0f, 1.0f);
+		const float Error = FMath::Abs(EmptyRatio - Target);
+		return FMath::Clamp(1.0f - (Error * 2.0f), 0.0f, 1.0f);
 	}
 
-	float Variance = 0.0f;
-	for (const int32 Count : Cells)
+	static float BalanceFromQuadrants(const int32 (&Quadrants)[4], const int32 NumPoints)
 	{
-		const float Delta = (float)Count - Mean;
-		Variance += Delta * Delta;
-	}
-	Variance /= (float)Cells.Num();
+		const float Mean = (float)NumPoints / 4.0f;
+		float Deviation = 0.0f;
+		for (const int32 Count : Quadrants)
+		{
+			Deviation += FMath::Abs((float)Count - Mean) / FMath::Max(1.0f, Mean);
+		}
+		Deviation /= 4.0f;
 
-	const float StdDev = FMath::Sqrt(FMath::Max(0.0f, Variance));
-	const float CoeffVar = StdDev / Mean;
-	const float TargetCoeffVar = 0.60f;
-	return FMath::Clamp(1.0f - FMath::Abs(CoeffVar - TargetCoeffVar), 0.0f, 1.0f);
-}
+		return FMath::Clamp(1.0f - Deviation, 0.0f, 1.0f);
+	}
 
-float FSceneEvaluator::ComputeClusterScore(
-	const TArray<FVector>& Points,
-	float ClusterRadius)
-{
-	if (Points.Num() < 2)
+	/**
+	 * Index cell size for nearest-neighbour queries: about two points per
+	 * cell at the scene's average density, so a query touches a handful of
+	 * points whatever the cluster radius. Cells sized from the radius alone
+	 * pile hundreds of points into each cell when the radius is large and
+	 * the scatter dense, which degrades every query toward a linear scan.
+	 */
+	static float NearestCellSize(const int32 NumPoints, const FBox& Bounds, const float Fallback)
 	{
-		return 0.0f;
+		if (!Bounds.IsValid || NumPoints <= 0)
+		{
+			return Fallback;
+		}
+		const double Area = FMath::Max(1.0, (double)(Bounds.Max.X - Bounds.Min.X) * (double)(Bounds.Max.Y - Bounds.Min.Y));
+		return (float)FMath::Max(1.0, FMath::Sqrt(2.0 * Area / (double)NumPoints));
 	}
 
-	const float TargetDist = FMath::Max(50.0f, ClusterRadius * 0.35f);
-	float MeanNearest = 0.0f;
-
-	for (int32 Index = 0; Index < Points.Num(); ++Index)
+	/** Mean distance from each point to its nearest neighbour; fixed chunking keeps the sum order thread-independent. */
+	static float MeanNearestDistance(const TArray<FVector>& Points, const float CellSize)
 	{
-		float BestDistSq = TNumericLimits<float>::Max();
-		for (int32 Other = 0; Other < Points.Num(); ++Other)
+		const FPointSpatialIndex SpatialIndex(Points, CellSize);
+		const int32 NumChunks = FMath::DivideAndRoundUp(Points.Num(), ClusterChunkSize);
+		TArray<double> ChunkSums;
+		ChunkSums.SetNumZeroed(NumChunks);
+
+		ParallelFor(NumChunks, [&](int32 Chunk)
 		{
-			if (Other == Index)
+			const int32 Begin = Chunk * ClusterChunkSize;
+			const int32 End = FMath::Min(Begin + ClusterChunkSize, Points.Num());
+			double Sum = 0.0;
+			for (int32 PointIndex = Begin; PointIndex < End; ++PointIndex)
 			{
-				continue;
+				float BestDistSq = TNumericLimits<float>::Max();
+				SpatialIndex.FindNearest(Points[PointIndex], -1.0f, BestDistSq, PointIndex);
+				Sum += FMath::Sqrt(FMath::Max(0.0f, BestDistSq));
 			}
-			BestDistSq = FMath::Min(BestDistSq, FVector::DistSquared2D(Points[Index], Points[Other]));
+			ChunkSums[Chunk] = Sum;
+		}, NumChunks < 2 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+		double Total = 0.0;
+		for (const double Sum : ChunkSums)
+		{
+			Total += Sum;
 		}
-		MeanNearest += FMath::Sqrt(FMath::Max(0.0f, BestDistSq));
+		return (float)(Total / (double)Points.Num());
+	}
+
+	static float ClusterScoreFromMean(const float MeanNearest, const float TargetDist)
+	{
+		const float RelativeError = FMath::Abs(MeanNearest - TargetDist) / FMath::Max(1.0f, TargetDist);
+		return FMath::Clamp(1.0f - RelativeError, 0.0f, 1.0f);
 	}
 
-	MeanNearest /= (float)Points.Num();
-	const float RelativeError = FMath::Abs(MeanNearest - TargetDist) / FMath::Max(1.0f, TargetDist);
-	return FMath::Clamp(1.0f - RelativeError, 0.0f, 1.0f);
+	static float ClusterTargetDistance(const float ClusterRadius)
+	{
+		return FMath::Max(50.0f, ClusterRadius * 0.35f);
+	}
 }
 
-float FSceneEvaluator::ComputeEmptySpaceScore(
+float FSceneEvaluator::ComputeObjectDensityVariance(
 	const TArray<FVector>& Points,
 	const FBox& Bounds,
-	float TargetEmptyRatio,
 	int32 GridResolution)
 {
-	if (!Bounds.IsValid)
+	if (!Bounds.IsValid || Points.Num() == 0)
 	{
 		return 0.0f;
 	}
 
-	const TArray<int32> Cells = BuildOccupancyGrid(Points, Bounds, GridResolution);
-	if (Cells.Num() == 0)
+	return DensityVarianceFromCells(BuildOccupancyGrid(Points, Bounds, GridResolution));
+}
+
+float FSceneEvaluator::ComputeClusterScore(
+	const TArray<FVector>& Points,
+	float ClusterRadius)
+{
+	if (Points.Num() < 2)
 	{
 		return 0.0f;
 	}
 
-	int32 Empty = 0;
-	for (const int32 Count : Cells)
+	const float TargetDist = ClusterTargetDistance(ClusterRadius);
+	FBox PointBounds(ForceInit);
+	for (const FVector& Point : Points)
 	{
-		if (Count == 0)
-		{
-			++Empty;
-		}
+		PointBounds += Point;
+	}
+	return ClusterScoreFromMean(MeanNearestDistance(Points, NearestCellSize(Points.Num(), PointBounds, TargetDist)), TargetDist);
+}
+
+float FSceneEvaluator::ComputeEmptySpaceScore(
+	const TArray<FVector>& Points,
+	const FBox& Bounds,
+	float TargetEmptyRatio,
+	int32 GridResolution)
+{
+	if (!Bounds.IsValid)
+	{
+		return 0.0f;
 	}
 
-	const float EmptyRatio = (float)Empty / (float)Cells.Num();
-	const float Target = FMath::Clamp(TargetEmptyRatio, 0.0f, 1.0f);
-	const float Error = FMath::Abs(EmptyRatio - Target);
-	return FMath::Clamp(1.0f - (Error * 2.0f), 0.0f, 1.0f);
+	return EmptySpaceFromCells(BuildOccupancyGrid(Points, Bounds, GridResolution), TargetEmptyRatio);
 }
 
 float FSceneEvaluator::ComputeVisualBalance(
@@ -150,26 +265,13 @@ float FSceneEvaluator::ComputeVisualBalance(
 		return 0.0f;
 	}
 
-	const FVector2D Center((Bounds.Min.X + Bounds.Max.X) * 0.5f, (Bounds.Min.Y + Bounds.Max.Y) * 0.5f);
+	const FVector2D Center = BoundsCenter2D(Bounds);
 	int32 Quadrants[4] = { 0, 0, 0, 0 };
-
 	for (const FVector& Point : Points)
 	{
-		const bool bRight = Point.X >= Center.X;
-		const bool bTop = Point.Y >= Center.Y;
-		const int32 Index = (bTop ? 2 : 0) + (bRight ? 1 : 0);
-		Quadrants[Index] += 1;
+		Quadrants[QuadrantIndex(Point, Center)] += 1;
 	}
-
-	const float Mean = (float)Points.Num() / 4.0f;
-	float Deviation = 0.0f;
-	for (const int32 Count : Quadrants)
-	{
-		Deviation += FMath::Abs((float)Count - Mean) / FMath::Max(1.0f, Mean);
-	}
-	Deviation /= 4.0f;
-
-	return FMath::Clamp(1.0f - Deviation, 0.0f, 1.0f);
+	return BalanceFromQuadrants(Quadrants, Points.Num());
 }
 
 FSceneEvaluationMetrics FSceneEvaluator::EvaluateScene(
@@ -178,10 +280,46 @@ FSceneEvaluationMetrics FSceneEvaluator::EvaluateScene(
 	float ClusterRadius)
 {
 	FSceneEvaluationMetrics Metrics;
-	Metrics.DensityVarianceScore = ComputeObjectDensityVariance(Points, Bounds, 10);
-	Metrics.ClusterScore = ComputeClusterScore(Points, ClusterRadius);
-	Metrics.EmptySpaceScore = ComputeEmptySpaceScore(Points, Bounds, 0.28f, 12);
-	Metrics.VisualBalanceScore = ComputeVisualBalance(Points, Bounds);
+
+	// One pass bins every point into the density grid, the empty-space grid
+	// and the balance quadrants at once; the counts match what the separate
+	// Compute* functions would build.
+	if (Bounds.IsValid)
+	{
+		TArray<int32> DensityCells;
+		TArray<int32> EmptyCells;
+		DensityCells.SetNumZeroed(SceneDensityGrid * SceneDensityGrid);
+		EmptyCells.SetNumZeroed(SceneEmptyGrid * SceneEmptyGrid);
+		int32 Quadrants[4] = { 0, 0, 0, 0 };
+
+		const FOccupancyBinner Binner(Bounds);
+		const FVector2D Center = BoundsCenter2D(Bounds);
+		for (const FVector& Point : Points)
+		{
+			float U, V;
+			Binner.UV(Point, U, V);
+			DensityCells[FOccupancyBinner::Cell(U, V, SceneDensityGrid)] += 1;
+			EmptyCells[FOccupancyBinner::Cell(U, V, SceneEmptyGrid)] += 1;
+			Quadrants[QuadrantIndex(Point, Center)] += 1;
+		}
+
+		if (Points.Num() > 0)
+		{
+			Metrics.DensityVarianceScore = DensityVarianceFromCells(DensityCells);
+			Metrics.VisualBalanceScore = BalanceFromQuadrants(Quadrants, Points.Num());
+		}
+		Metrics.EmptySpaceScore = EmptySpaceFromCells(EmptyCells, SceneEmptyTarget);
+	}
+
+	// Cluster spacing through the spatial index: one nearest query per point,
+	// each touching a bounded number of cells, so the pass stays O(N).
+	if (Points.Num() >= 2)
+	{
+		const float TargetDist = ClusterTargetDistance(ClusterRadius);
+		Metrics.ClusterScore = ClusterScoreFromMean(
+			MeanNearestDistance(Points, NearestCellSize(Points.Num(), Bounds, TargetDist)),
+			TargetDist);
+	}
 
 	Metrics.CombinedScore =
 		(0.40f * Metrics.DensityVarianceScore) +
@@ -0,0 +1,203 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeActorIndex — incremental label / name / path / tag / spatial index for the editor world.
+//
+// Replaces the per-lookup TActorIterator scans that resolved actors by
+// comparing label, name and path on every actor, and the radius scans that
+// called GetActorLocation / GetActorBounds on every actor. Built lazily on
+// first use and kept current from engine events:
+//
+//   OnLevelActorAdded / OnLevelActorDeleted   insert / remove
+//   OnActorLabelChanged, OnActorMoved,
+//   OnObjectModified (actor or component)      actor re-keyed at the next lookup
+//   PostUndoRedo, MapChange, level add/remove  full rebuild at the next lookup
+//
+// Spatial queries use a hashed uniform grid over actor locations in XY
+// (GridCellSize cells, unbounded in Z), so a radius query touches only the
+// cells its circle overlaps. Distances are always computed from the live
+// actor location.
+//
+// The same events advance a world revision. Every change stamps the actor
+// with the new revision, so GetChangesSince(N) answers "what was added,
+// modified or removed after N" without diffing the world. Rebuilds triggered
+// by undo/redo or streaming diff the old entries against the new ones; a
+// different world (map load) drops the history and starts a new floor.
+//
+// Keys compare case-insensitively, like the scans they replace. Hits are
+// re-validated against the live actor, so a stale entry can cost a re-key but
+// never returns the wrong actor. Lookups against any world other than the
+// editor world (PIE, previews) fall back to a linear scan.
+//
+// Game thread only.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"   // explicit with NoPCHs
+#include "UObject/WeakObjectPtr.h"
+
+class AActor;
+class ULevel;
+class UObject;
+class UWorld;
+
+class UEAGENTFORGE_API FAgentForgeActorIndex
+{
+public:
+	static FAgentForgeActorIndex& Get();
+
+	/** Subscribe to engine / editor events. Called from StartupModule. */
+	void Initialize();
+	void Shutdown();
+
+	AActor* FindByLabel(const FString& Label);
+	AActor* FindByName(const FString& Name);
+	AActor* FindByPath(const FString& Path);
+
+	/** Label first, then object name. */
+	AActor* FindByLabelOrName(const FString& LabelOrName);
+
+	/** Object path (exact, via StaticFindObject), then label, name and path. World=nullptr means the editor world. */
+	AActor* FindByAnyId(const FString& Id, UWorld* World = nullptr);
+
+	/** Every actor carrying Tag. */
+	void FindByTag(FName Tag, TArray<AActor*>& OutActors);
+
+	// ─── Spatial ────────────────────────────────────────────────────────────
+	static constexpr float GridCellSize = 5000.0f;   // 50 m
+
+	/** Actors whose location is within Radius of Center, as (squared distance, actor), unsorted. Class=nullptr: any. */
+	void QueryRadius(const FVector& Center, float Radius, TArray<TPair<float, AActor*>>& OutActors, const UClass* Class = nullptr);
+
+	/** Actors whose location is inside Box. */
+	void QueryBox(const FBox& Box, TArray<AActor*>& OutActors, const UClass* Class = nullptr);
+
+	/** Up to K actors nearest to Point within MaxRadius (<= 0: unlimited), sorted by squared distance. */
+	void QueryNearest(const FVector& Point, int32 K, float MaxRadius, TArray<TPair<float, AActor*>>& OutActors, const UClass* Class = nullptr);
+
+	/** Union of every non-empty actor bounds box, from the bounds cached at (re)index time. */
+	FBox GetLevelBounds();
+
+	// ─── Revisions ──────────────────────────────────────────────────────────
+	struct FRemovedActor
+	{
+		FString Label;
+		FString Name;
+		FString Path;
+	};
+
+	struct FWorldDelta
+	{
+		int64                 Revision = 0;
+		TArray<AActor*>       Added;      // in revision order
+		TArray<AActor*>       Modified;
+		TArray<FRemovedActor> Removed;
+	};
+
+	/** Current revision of the editor world, or 0 when change tracking is unavailable. */
+	int64 GetRevision();
+
+	/**
+	 * Actors added, modified or removed after revision Since. Returns false when
+	 * Since predates the retained history (map change, overflow, tracking
+	 * unavailable) and the caller must resend the full state.
+	 */
+	bool GetChangesSince(int64 Since, FWorldDelta& OutDelta);
+
+	/** Drop everything; the next lookup rebuilds. */
+	void Invalidate() { bDirty = true; }
+
+	TSharedPtr<FJsonObject> GetStatsJson() const;
+
+private:
+	using FActorList = TArray<TWeakObjectPtr<AActor>, TInlineAllocator<1>>;
+
+	struct FEntry
+	{
+		FString      Label;
+		FString      Name;
+		FString      Path;
+		TArray<FName> Tags;
+		FIntPoint    Cell = FIntPoint::ZeroValue;
+		FBox         Bounds = FBox(ForceInit);
+		uint32       Signature = 0;   // label / transform / visibility / tags, for change sweeps
+	};
+
+	enum class EChange : uint8 { Added, Modified, Removed };
+
+	struct FChange
+	{
+		int64          Revision = 0;
+		int64          AddedRevision = 0;   // > 0 when the actor appeared after the floor
+		FRemovedActor  Identity;            // captured while the actor was still alive
+	};
+
+	static constexpr int32 MaxChangeHistory = 100000;
+
+	enum class EKey : uint8 { Label, Name, Path };
+
+	/** Rebuild or flush stale actors as needed. Returns the indexed world, or nullptr. */
+	UWorld* Prepare();
+	void    HookEngineEvents();
+	void    Rebuild(UWorld* World);
+	void    FlushStale();
+	void    AddActor(AActor* Actor);
+	bool    RemoveActor(const TWeakObjectPtr<AActor>& Actor, FEntry* OutEntry = nullptr);
+	bool    IsIndexable(const AActor* Actor) const;
+	AActor* FindInMap(EKey Key, const FString& Value);
+
+	static AActor* ScanWorld(UWorld* World, const FString& Id);
+	static FIntPoint CellOf(const FVector& Location);
+	static uint32    SignatureOf(const AActor* Actor);
+
+	/** Stamp Actor with a new revision. Known supplies its identity once the actor is gone. */
+	void NoteChange(const TWeakObjectPtr<AActor>& Actor, EChange Kind, const FEntry* Known = nullptr);
+	void ResetHistory();
+	void SweepSignatures();
+	void TrimHistory();
+
+	/** Visit indexed actors in the cells overlapping [Min, Max] (XY). Stale cells re-key lazily. */
+	template <typename FunctorType>
+	void ForEachInCells(const FVector& Min, const FVector& Max, const UClass* Class, FunctorType&& Visit);
+
+	void HandleActorAdded(AActor* Actor);
+	void HandleActorDeleted(AActor* Actor);
+	void HandleActorChanged(AActor* Actor);
+	void HandleObjectModified(UObject* Object);
+	void HandleLevelChanged(ULevel* Level, UWorld* World);
+	void HandleMapChange(uint32 Flags) { Invalidate(); }
+	void HandleUndoRedo()              { Invalidate(); }
+
+	TMap<TWeakObjectPtr<AActor>, FEntry> Entries;
+	TMap<FString, FActorList>            ByLabel;   // FString keys hash / compare case-insensitively
+	TMap<FString, FActorList>            ByName;
+	TMap<FString, FActorList>            ByPath;
+	TMap<FName, FActorList>              ByTag;
+	TMap<FIntPoint, FActorList>          Cells;
+	FBox                                 CachedLevelBounds = FBox(ForceInit);
+	bool                                 bLevelBoundsDirty = true;
+	TSet<TWeakObjectPtr<AActor>>         Stale;
+	TMap<TWeakObjectPtr<AActor>, FChange> Changes;
+	int64                                Revision = 0;
+	int64                                HistoryFloor = 0;   // deltas are answerable from here on
+	TWeakObjectPtr<UWorld>               IndexedWorld;
+	bool                                 bDirty = true;
+	bool                                 bInitialized = false;
+	bool                                 bEngineHooked = false;   // GEngine does not exist yet at StartupModule
+
+	FDelegateHandle ActorAddedHandle;
+	FDelegateHandle ActorDeletedHandle;
+	FDelegateHandle LabelChangedHandle;
+	FDelegateHandle ObjectModifiedHandle;
+	FDelegateHandle UndoRedoHandle;
+	FDelegateHandle MapChangeHandle;
+	FDelegateHandle LevelAddedHandle;
+	FDelegateHandle LevelRemovedHandle;
+	FDelegateHandle ActorMovedHandle;
+
+	int64 Rebuilds = 0;
+	int64 Lookups = 0;
+	int64 Rekeys = 0;
+	int64 FallbackScans = 0;
+	int64 SpatialQueries = 0;
+	double LastRebuildMs = 0.0;
+};
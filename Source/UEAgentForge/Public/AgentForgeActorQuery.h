@@ -0,0 +1,86 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeActorQuery — field projection, filters and cursor paging for actor enumeration.
+//
+// Shared by get_all_level_actors, get_actors_in_radius and get_world_context.
+// Parsed once per request from the command args:
+//
+//   fields  ["label","location"]        only these keys are gathered and written
+//   class   "StaticMeshActor"           actor class or any parent class, by name
+//   tag     "Objective"                 actor has this tag
+//   bounds  {min:{x,y,z}, max:{x,y,z}}  actor location inside the box
+//   limit   200                          page size (0 / absent = everything)
+//   cursor  "200"                        opaque; pass back the previous next_cursor
+//
+// Paged responses add {total, next_cursor} — next_cursor is null on the last page.
+// Cursors are offsets into a stable ordering of the filtered result, so a page
+// taken after the level changes may skip or repeat actors.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"   // explicit with NoPCHs
+
+class AActor;
+class FAgentForgeResponseWriter;
+
+enum class EAgentForgeActorField : uint32
+{
+	None           = 0,
+	Name           = 1 << 0,
+	Label          = 1 << 1,
+	Class          = 1 << 2,
+	ObjectPath     = 1 << 3,
+	Location       = 1 << 4,
+	Rotation       = 1 << 5,
+	Scale          = 1 << 6,
+	Tags           = 1 << 7,
+	Bounds         = 1 << 8,
+	Parent         = 1 << 9,
+	Visible        = 1 << 10,
+	Category       = 1 << 11,   // get_world_context only
+	Distance       = 1 << 12,   // "distance" / "distance_to_center_cm"
+	ComponentCount = 1 << 13,   // get_world_context with include_components
+};
+ENUM_CLASS_FLAGS(EAgentForgeActorField);
+
+class UEAGENTFORGE_API FAgentForgeActorQuery
+{
+public:
+	/**
+	 * Parse projection, filters and paging from Args.
+	 * Supported: fields this command can produce. Defaults: fields written when
+	 * args.fields is absent. Returns false with OutError on an unknown or
+	 * unsupported field, or a malformed cursor / bounds.
+	 */
+	bool Parse(const TSharedPtr<FJsonObject>& Args, EAgentForgeActorField Supported, EAgentForgeActorField Defaults, FString& OutError);
+
+	bool Wants(EAgentForgeActorField Field) const { return EnumHasAnyFlags(Fields, Field); }
+
+	/** Class / tag / bounds filters. Cheap checks first; no allocation. */
+	bool Matches(const AActor* Actor) const;
+
+	/** Paging over a result of Total entries: [GetBegin(), GetEnd(Total)). */
+	bool  IsPaged() const { return Limit > 0 || Offset > 0; }
+	int32 GetBegin() const { return Offset; }
+	int32 GetLimit() const { return Limit; }
+	int32 GetEnd(int32 Total) const;
+
+	/** Writes total and next_cursor when IsPaged(). */
+	void WritePaging(FAgentForgeResponseWriter& Writer, int32 Total) const;
+
+	/**
+	 * Writes the AActor-derived fields in canonical order: name, label, class,
+	 * object_path, location, rotation, scale, parent, is_visible, tags, bounds.
+	 * Caller writes command-specific fields (distance, category...) itself.
+	 */
+	void WriteActorFields(FAgentForgeResponseWriter& Writer, const AActor* Actor) const;
+
+private:
+	EAgentForgeActorField Fields = EAgentForgeActorField::None;
+	FName   ClassFilter;
+	FName   TagFilter;
+	FBox    BoundsFilter = FBox(ForceInit);
+	bool    bBoundsFilter = false;
+	int32   Limit = 0;
+	int32   Offset = 0;
+};
@@ -0,0 +1,300 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeArgs — typed, once-built argument schemas for command handlers.
+//
+// A handler declares its arguments once, as a function-local static schema
+// over a plain struct whose member initialisers are the defaults:
+//
+//   static const TAgentForgeArgSchema<FScatterArgs> Schema = TAgentForgeArgSchema<FScatterArgs>()
+//       .Float(TEXT("radius"), &FScatterArgs::Radius).Min(1.0f)
+//       .Int({ TEXT("point_count"), TEXT("max_points") }, &FScatterArgs::Count).Range(0, 4096)
+//       .Bool(TEXT("snap_to_surface"), &FScatterArgs::bSnap)
+//       .Known({ TEXT("target_label") });
+//
+// Bind walks Args->Values once. Each key costs one lookup in the schema's name
+// table (case-insensitive, like FJsonObject); the value is converted the way
+// GetNumberField / GetBoolField / GetStringField convert it, clamped to the
+// declared range and written to the member. Members the request leaves out
+// keep whatever Out held, so defaults that depend on runtime state (policy
+// limits) can be set before binding.
+//
+//   Aliases     the first listed name wins when several are present
+//   Sets        raises a bool member when the field binds
+//   Object      binds a nested object into the same struct, after the flat
+//               fields, so {"clearings": {"density": 2}} beats "clearing_density"
+//   Custom      hands the raw value to a callback (arrays, enums, vectors)
+//   Known       accepts a key without binding it; the handler reads it itself
+//
+// Keys the schema does not know go to FAgentForgeArgReport::Unknown in request
+// order ("clearings.densty" for nested ones); values of the wrong shape go to
+// Invalid and leave the member untouched. The dispatcher's own args (profile,
+// async) are never unknown. Schemas are immutable once built and safe to bind
+// from any thread.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"   // explicit with NoPCHs
+#include "Dom/JsonValue.h"
+#include "Templates/Function.h"
+#include <initializer_list>
+
+/** One name, or aliases with the preferred name first. */
+struct FAgentForgeArgKeys
+{
+	FAgentForgeArgKeys(const TCHAR* Name) : Names({ Name }) {}
+	FAgentForgeArgKeys(std::initializer_list<const TCHAR*> InNames) : Names(InNames) {}
+
+	TArray<const TCHAR*, TInlineAllocator<4>> Names;
+};
+
+/** Unknown and invalid fields seen by one Bind. */
+struct UEAGENTFORGE_API FAgentForgeArgReport
+{
+	TArray<FString> Unknown;
+	TArray<FString> Invalid;
+
+	bool IsClean() const { return Unknown.Num() == 0 && Invalid.Num() == 0; }
+
+	/** Adds "unknown_fields" / "invalid_fields" string arrays to Obj, each only when non-empty. */
+	void AppendTo(const TSharedPtr<FJsonObject>& Obj) const;
+};
+
+/** Case-insensitive set of the argument names a handler recognises. */
+class UEAGENTFORGE_API FAgentForgeArgNames
+{
+public:
+	FAgentForgeArgNames() = default;
+	explicit FAgentForgeArgNames(const FAgentForgeArgKeys& InNames) { Add(InNames); }
+
+	/** Recognised names that are not bound. */
+	FAgentForgeArgNames& Add(const FAgentForgeArgKeys& InNames);
+
+	/** Every name Other recognises, as unbound names. */
+	FAgentForgeArgNames& Add(const FAgentForgeArgNames& Other);
+
+	bool Contains(const FString& Name) const { return Entries.Contains(Name); }
+
+	/** Args ExecuteCommandJson reads for every command ("profile", "async"). */
+	static bool IsDispatchArg(const FString& Name);
+
+	/** Number value as GetNumberField reads it (numeric strings included). */
+	static bool ReadNumber(const TSharedPtr<FJsonValue>& Value, double& Out);
+	static bool ReadBool(const TSharedPtr<FJsonValue>& Value, bool& Out);
+	static bool ReadString(const TSharedPtr<FJsonValue>& Value, FString& Out);
+
+protected:
+	struct FEntry
+	{
+		int32 Field = INDEX_NONE;   // INDEX_NONE for unbound names
+		int32 Rank = 0;             // alias position, 0 = preferred
+	};
+
+	TMap<FString, FEntry> Entries;
+};
+
+template <typename StructType>
+class TAgentForgeArgSchema : public FAgentForgeArgNames
+{
+public:
+	using FCustomFn = TFunction<bool(StructType& Out, const TSharedPtr<FJsonValue>& Value)>;
+
+	TAgentForgeArgSchema() = default;
+
+	TAgentForgeArgSchema& Float(const FAgentForgeArgKeys& InNames, float StructType::* Member)
+	{
+		return AddField(InNames, [Member](const FField& Field, StructType& Out, const TSharedPtr<FJsonValue>& Value)
+		{
+			double Number = 0.0;
+			if (!ReadNumber(Value, Number))
+			{
+				return false;
+			}
+			Out.*Member = (float)FMath::Clamp(Number, Field.MinValue, Field.MaxValue);
+			return true;
+		});
+	}
+
+	TAgentForgeArgSchema& Int(const FAgentForgeArgKeys& InNames, int32 StructType::* Member)
+	{
+		return AddField(InNames, [Member](const FField& Field, StructType& Out, const TSharedPtr<FJsonValue>& Value)
+		{
+			double Number = 0.0;
+			if (!ReadNumber(Value, Number))
+			{
+				return false;
+			}
+			// Truncate first, as (int32)GetNumberField does, then clamp.
+			const double Whole = FMath::TruncToDouble(FMath::Clamp(Number, (double)MIN_int32, (double)MAX_int32));
+			Out.*Member = (int32)FMath::Clamp(Whole, Field.MinValue, Field.MaxValue);
+			return true;
+		});
+	}
+
+	TAgentForgeArgSchema& Bool(const FAgentForgeArgKeys& InNames, bool StructType::* Member)
+	{
+		return AddField(InNames, [Member](const FField&, StructType& Out, const TSharedPtr<FJsonValue>& Value)
+		{
+			return ReadBool(Value, Out.*Member);
+		});
+	}
+
+	TAgentForgeArgSchema& String(const FAgentForgeArgKeys& InNames, FString StructType::* Member)
+	{
+		return AddField(InNames, [Member](const FField&, StructType& Out, const TSharedPtr<FJsonValue>& Value)
+		{
+			return ReadString(Value, Out.*Member);
+		});
+	}
+
+	/** Fn returns false when the value has the wrong shape; the field is then reported invalid. */
+	TAgentForgeArgSchema& Custom(const FAgentForgeArgKeys& InNames, FCustomFn Fn)
+	{
+		return AddField(InNames, [Fn = MoveTemp(Fn)](const FField&, StructType& Out, const TSharedPtr<FJsonValue>& Value)
+		{
+			return Fn(Out, Value);
+		});
+	}
+
+	/** Nested must outlive this schema (a function-local static). */
+	TAgentForgeArgSchema& Object(const FAgentForgeArgKeys& InNames, const TAgentForgeArgSchema& Nested)
+	{
+		AddField(InNames, nullptr);
+		Fields.Last().Nested = &Nested;
+		return *this;
+	}
+
+	/** Clamp range of the last Float / Int field. */
+	TAgentForgeArgSchema& Range(double InMin, double InMax)
+	{
+		check(Fields.Num() > 0);
+		Fields.Last().MinValue = InMin;
+		Fields.Last().MaxValue = InMax;
+		return *this;
+	}
+
+	TAgentForgeArgSchema& Min(double InMin)
+	{
+		check(Fields.Num() > 0);
+		Fields.Last().MinValue = InMin;
+		return *this;
+	}
+
+	/** Sets Flag on Out when the last field binds. */
+	TAgentForgeArgSchema& Sets(bool StructType::* Flag)
+	{
+		check(Fields.Num() > 0);
+		Fields.Last().SetFlag = Flag;
+		return *this;
+	}
+
+	TAgentForgeArgSchema& Known(const FAgentForgeArgKeys& InNames)
+	{
+		Add(InNames);
+		return *this;
+	}
+
+	/** One pass over Args into Out. Report may be null. */
+	void Bind(const TSharedPtr<FJsonObject>& Args, StructType& Out, FAgentForgeArgReport* Report = nullptr) const
+	{
+		BindObject(Args, Out, Report, FString(), true);
+	}
+
+private:
+	struct FField
+	{
+		TFunction<bool(const FField&, StructType&, const TSharedPtr<FJsonValue>&)> Assign;
+		const TAgentForgeArgSchema* Nested = nullptr;
+		bool StructType::* SetFlag = nullptr;
+		double MinValue = -TNumericLimits<double>::Max();
+		double MaxValue = TNumericLimits<double>::Max();
+		FString Name;   // preferred name, for reports
+	};
+
+	template <typename AssignFn>
+	TAgentForgeArgSchema& AddField(const FAgentForgeArgKeys& InNames, AssignFn&& Assign)
+	{
+		check(InNames.Names.Num() > 0);
+		FField& Field = Fields.AddDefaulted_GetRef();
+		Field.Assign = Forward<AssignFn>(Assign);
+		Field.Name = InNames.Names[0];
+		int32 Rank = 0;
+		for (const TCHAR* Name : InNames.Names)
+		{
+			checkf(!Entries.Contains(Name), TEXT("Argument '%s' declared twice."), Name);
+			Entries.Add(Name, FEntry{ Fields.Num() - 1, Rank++ });
+		}
+		return *this;
+	}
+
+	void BindObject(const TSharedPtr<FJsonObject>& Args, StructType& Out, FAgentForgeArgReport* Report, const FString& Prefix, bool bTopLevel) const
+	{
+		if (!Args.IsValid())
+		{
+			return;
+		}
+
+		// Best alias rank bound so far per field; nested objects wait for the flat pass.
+		TArray<int32, TInlineAllocator<64>> BoundRank;
+		BoundRank.Init(MAX_int32, Fields.Num());
+		TArray<TPair<int32, const TSharedPtr<FJsonValue>*>, TInlineAllocator<4>> Deferred;
+
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : Args->Values)
+		{
+			const FEntry* Entry = Entries.Find(Pair.Key);
+			if (!Entry)
+			{
+				if (Report && !(bTopLevel && IsDispatchArg(Pair.Key)))
+				{
+					Report->Unknown.Add(Prefix + Pair.Key);
+				}
+				continue;
+			}
+			if (Entry->Field == INDEX_NONE || Entry->Rank > BoundRank[Entry->Field])
+			{
+				continue;
+			}
+
+			const FField& Field = Fields[Entry->Field];
+			if (Field.Nested)
+			{
+				Deferred.Emplace(Entry->Field, &Pair.Value);
+				BoundRank[Entry->Field] = Entry->Rank;
+				continue;
+			}
+			if (!Field.Assign(Field, Out, Pair.Value))
+			{
+				if (Report)
+				{
+					Report->Invalid.Add(Prefix + Pair.Key);
+				}
+				continue;
+			}
+			BoundRank[Entry->Field] = Entry->Rank;
+			if (Field.SetFlag)
+			{
+				Out.*Field.SetFlag = true;
+			}
+		}
+
+		for (const TPair<int32, const TSharedPtr<FJsonValue>*>& Pending : Deferred)
+		{
+			const FField& Field = Fields[Pending.Key];
+			const TSharedPtr<FJsonValue>& Value = *Pending.Value;
+			if (!Value.IsValid() || Value->Type != EJson::Object)
+			{
+				if (Report)
+				{
+					Report->Invalid.Add(Prefix + Field.Name);
+				}
+				continue;
+			}
+			Field.Nested->BindObject(Value->AsObject(), Out, Report, Prefix + Field.Name + TEXT("."), false);
+			if (Field.SetFlag)
+			{
+				Out.*Field.SetFlag = true;
+			}
+		}
+	}
+
+	TArray<FField> Fields;
+};
@@ -0,0 +1,147 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeAssetCatalog — cached, indexed asset lists for the get_available_* commands.
+//
+// get_available_meshes / materials / blueprints / textures / sounds used to run
+// a recursive IAssetRegistry::GetAssets on every call, sort the whole result
+// by name and lowercase every name for a substring test; the modular kit
+// conversion repeated the same registry query per call. On a large project
+// that is a walk over every asset of the class for each browse.
+//
+// The catalog keeps one index per asset kind, built from the registry on the
+// kind's first query and kept current from registry events:
+//
+//   OnAssetAdded / OnAssetRemoved   insert / tombstone
+//   OnAssetRenamed                  re-keyed under the new path and name
+//   OnAssetUpdated                  tags refreshed (reparented blueprints)
+//
+// Each index holds its entries in name order (case-insensitive, like the
+// sort it replaces) and a trigram map from every three-character run of a
+// lowercased name to the entries containing it. Queries resolve as:
+//
+//   search >= 3 chars   smallest posting list of the needle's trigrams, verified
+//   prefix              binary search of the name order
+//   search < 3 chars    walk of the name order, stopping at MaxResults
+//
+// Path and tag filters, and the caller's predicate, are checked on the
+// candidates that survive the name test. Results are always in name order.
+//
+// Until the registry finishes its initial scan the catalog does not build
+// and queries go to the registry directly, so early results match the old
+// behaviour. Removed entries are tombstoned and compacted once they make up
+// a quarter of an index.
+//
+// Editor, game thread only.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+#include "Dom/JsonObject.h"   // explicit with NoPCHs
+
+enum class EAgentForgeAssetKind : uint8
+{
+	StaticMesh,   // UStaticMesh
+	Material,     // UMaterial, UMaterialInstanceConstant
+	Blueprint,    // UBlueprint
+	Texture,      // UTexture2D
+	Sound,        // USoundWave, USoundCue
+	Num
+};
+
+struct FAgentForgeAssetQuery
+{
+	FString Search;       // case-insensitive substring of the asset name
+	FString Prefix;       // case-insensitive prefix of the asset name
+	FString PackagePath;  // recursive: the path itself and everything below it
+
+	/** Every tag must be present; a non-empty value must be a case-insensitive substring of the tag value. */
+	TArray<TPair<FName, FString>> Tags;
+
+	/** Extra per-asset test, run last. */
+	TFunction<bool(const FAssetData&)> Filter;
+
+	int32 MaxResults = 50;   // <= 0: unlimited
+};
+
+class UEAGENTFORGE_API FAgentForgeAssetCatalog
+{
+public:
+	static FAgentForgeAssetCatalog& Get();
+
+	/** Subscribe to asset registry events. Called from StartupModule. */
+	void Initialize();
+	void Shutdown();
+
+	/** Matching assets of Kind, in name order. */
+	void Query(EAgentForgeAssetKind Kind, const FAgentForgeAssetQuery& Request, TArray<FAssetData>& OutAssets);
+
+	/** "Key=Value,Key2" into (Key, Value) pairs; false with OutError on an empty key. */
+	static bool ParseTagQuery(const FString& Text, TArray<TPair<FName, FString>>& OutTags, FString& OutError);
+
+	/** Drop every index; each rebuilds on its next query. */
+	void Invalidate();
+
+	TSharedPtr<FJsonObject> GetStatsJson() const;
+
+private:
+	struct FEntry
+	{
+		FAssetData Asset;
+		FString    LowerName;
+		FString    LowerPath;   // package path
+		bool       bAlive = true;
+	};
+
+	struct FKindIndex
+	{
+		TArray<FTopLevelAssetPath>     ClassPaths;
+		TArray<FEntry>                 Entries;     // by id; removed entries stay as tombstones
+		TArray<int32>                  Order;       // live ids, sorted by LowerName
+		TMap<uint64, TArray<int32>>    Trigrams;    // may list tombstones; verified at query time
+		TMap<FSoftObjectPath, int32>   ByPath;
+		int32                          Dead = 0;
+		bool                           bBuilt = false;
+	};
+
+	void Build(EAgentForgeAssetKind Kind);
+	void Compact(FKindIndex& Index);
+	/** Appends the entry and its trigrams; the caller places the id in Order. */
+	int32 AddEntry(FKindIndex& Index, const FAssetData& Asset);
+	void  InsertEntry(FKindIndex& Index, const FAssetData& Asset);
+	void  RemoveEntry(FKindIndex& Index, int32 Id);
+	void  SortOrder(FKindIndex& Index);
+
+	/** Position in Order of the first entry not less than (LowerName, Id). */
+	static int32  LowerBound(const FKindIndex& Index, const FString& LowerName, int32 Id);
+	static uint64 TrigramKey(const TCHAR* Chars);
+
+	/** Tags and the caller's predicate; name and path are tested by the caller. */
+	static bool MatchesFilters(const FAssetData& Asset, const FAgentForgeAssetQuery& Request);
+	void QueryRegistry(const FKindIndex& Index, const FAgentForgeAssetQuery& Request, TArray<FAssetData>& OutAssets);
+
+	/** Index whose classes include Asset's class, or null when that index is not built. */
+	FKindIndex* FindBuiltIndex(const FAssetData& Asset);
+
+	void HandleAssetAdded(const FAssetData& Asset);
+	void HandleAssetRemoved(const FAssetData& Asset);
+	void HandleAssetRenamed(const FAssetData& Asset, const FString& OldObjectPath);
+	void HandleAssetUpdated(const FAssetData& Asset);
+
+	FKindIndex Indices[(int32)EAgentForgeAssetKind::Num];
+	bool bInitialized = false;
+
+	FDelegateHandle AssetAddedHandle;
+	FDelegateHandle AssetRemovedHandle;
+	FDelegateHandle AssetRenamedHandle;
+	FDelegateHandle AssetUpdatedHandle;
+
+	int64 Queries = 0;
+	int64 TrigramQueries = 0;
+	int64 PrefixQueries = 0;
+	int64 ScanQueries = 0;
+	int64 RegistryFallbacks = 0;
+	int64 Builds = 0;
+	int64 Events = 0;
+	double LastBuildMs = 0.0;
+	double LastQueryMs = 0.0;
+};
@@ -0,0 +1,95 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeBenchmark — performance suite for the Distribution and Terrain modules.
+//
+// Every case runs one library function on synthetic input:
+//
+//   Distribution  point counts (default 1k, 10k, 100k, 1M) over square bounds
+//                 sized for one point per square metre. Inputs are uniform
+//                 counter-RNG points, so a case measures the function, not the
+//                 sampler that fed it.
+//   Terrain       heightmap edges (default 256 to 4096) on a pre-generated
+//                 fBm map.
+//
+// Each case runs Repeats times. Input is rebuilt before every repeat, outside
+// the timed region. Reported per case: best and median wall time, ns per point
+// (or texel) from the median, and for the median run: the change in resident
+// memory and live UObject count across the timed region, and the peak
+// resident memory above its starting level (sampled about once a
+// millisecond, plus the OS high-water mark). All three are process-wide:
+// other threads' work shows up in them, so keep the editor idle while it
+// runs. Allocation counts are not reported; counting them would need a
+// wrapping allocator, and GMalloc cannot be swapped after startup.
+//
+// Reports go to Saved/AgentForgeBenchmarks/ as JSON and CSV. The plugin and
+// engine versions are stamped into both, so runs from different plugin
+// versions can be diffed.
+//
+// Entry points: the run_benchmarks command (one job stage per case and size,
+// so "async":true keeps the editor responsive between cases) and the
+// AgentForgeBenchmark commandlet for headless runs.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"   // explicit with NoPCHs
+
+class FAgentForgeJob;
+
+struct UEAGENTFORGE_API FBenchmarkSettings
+{
+	TArray<FString> Cases;   // empty = every case
+	TArray<int32> PointCounts = { 1000, 10000, 100000, 1000000 };
+	TArray<int32> HeightmapSizes = { 256, 512, 1024, 2048, 4096 };
+	int32 Repeats = 3;
+	int32 Seed = 1337;
+	FString OutputDir;       // empty = Saved/AgentForgeBenchmarks
+	FString Label;           // free-form tag stored in the report
+
+	/** cases[], point_counts[], heightmap_sizes[], repeats, seed, output_dir, label. */
+	static FBenchmarkSettings FromJson(const TSharedPtr<FJsonObject>& Args);
+};
+
+struct UEAGENTFORGE_API FBenchmarkResult
+{
+	FString Case;
+	FString Module;          // distribution | terrain
+	FString Unit;            // point | texel
+	int32   Size = 0;        // point count or heightmap edge
+	int64   Units = 0;       // points or texels processed per run
+	int32   Repeats = 0;
+	double  BestMs = 0.0;
+	double  MedianMs = 0.0;
+	double  NsPerUnit = 0.0;
+	double  UsedPhysicalDeltaMB = 0.0;   // process-wide, approximate
+	double  PeakUsedPhysicalMB = 0.0;    // peak above the pre-run level, process-wide, sampled
+	int32   UObjectsDelta = 0;          // net live UObjects, process-wide
+	int64   OutputCount = 0; // points kept / generated, or passes run
+
+	TSharedPtr<FJsonObject> ToJson() const;
+};
+
+class UEAGENTFORGE_API FAgentForgeBenchmark
+{
+public:
+	/** Case names in run order. */
+	static TArray<FString> GetCaseNames();
+
+	/** Run one case at one size. Returns false for an unknown case. */
+	static bool RunCase(const FString& Case, int32 Size, const FBenchmarkSettings& Settings, FBenchmarkResult& OutResult);
+
+	/**
+	 * Write <dir>/bench_<timestamp>.json and .csv. OutReport is the JSON
+	 * document that was written.
+	 */
+	static bool WriteReport(
+		const TArray<FBenchmarkResult>& Results,
+		const FBenchmarkSettings& Settings,
+		FString& OutJsonPath,
+		FString& OutCsvPath,
+		TSharedPtr<FJsonObject>& OutReport);
+
+	static FString GetDefaultOutputDir();
+
+	/** run_benchmarks: one stage per (case, size); each stage adds its result as a partial result. */
+	static TSharedRef<FAgentForgeJob> MakeBenchmarkJob(const TSharedPtr<FJsonObject>& Args);
+};
@@ -0,0 +1,26 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeBenchmarkCommandlet — headless entry point for the benchmark suite.
+//
+//   UnrealEditor-Cmd <Project>.uproject -run=AgentForgeBenchmark
+//       [-cases=blue_noise,thermal_erosion] [-points=1000,100000]
+//       [-sizes=256,1024] [-repeats=3] [-seed=1337] [-label=ci] [-output=<dir>]
+//
+// Runs the same job as the run_benchmarks command and writes the same JSON /
+// CSV report. Returns 0 when the report was written.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "AgentForgeBenchmarkCommandlet.generated.h"
+
+UCLASS()
+class UEAGENTFORGE_API UAgentForgeBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UAgentForgeBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
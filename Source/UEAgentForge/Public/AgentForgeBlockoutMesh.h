@@ -0,0 +1,56 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeBlockoutMesh — merged-mesh output for the room and corridor builders.
+//
+// create_room and create_corridor normally spawn one scaled cube actor per
+// floor, ceiling and wall segment: six to twenty actors and draw calls per
+// room. With output:"merged" the builders feed the same boxes into an
+// FAgentForgeBlockoutMesh instead, which appends them to one FDynamicMesh3
+// and puts it on a single UDynamicMeshComponent under the group actor.
+//
+// Openings need no boolean pass: the builders already lay walls out as
+// segments around doors and windows, so the gaps are left out of the mesh.
+// Each distinct material becomes one section (material slot). UVs are
+// world-aligned at build time, in world units (UVScale per cm, 1 tile per
+// metre by default): top and bottom faces project on XY, side faces on
+// their horizontal axis and Z. Collision is complex-as-simple.
+//
+// Editor, game thread only.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AActor;
+class UMaterialInterface;
+class UWorld;
+
+class UEAGENTFORGE_API FAgentForgeBlockoutMesh
+{
+public:
+	/** Dimensions are full extents in cm; Center is the box centre in world space. */
+	void AddBox(const FVector& Center, const FVector& DimensionsCm, const FRotator& Rotation, UMaterialInterface* Material);
+
+	int32 NumBoxes() const { return Boxes.Num(); }
+	int32 NumTriangles() const { return Boxes.Num() * 12; }
+	int32 NumMaterials() const { return Materials.Num(); }
+
+	/**
+	 * Spawns a group actor at Origin carrying the merged mesh, vertices
+	 * relative to Origin. Null with OutError when there are no boxes.
+	 */
+	AActor* BuildActor(UWorld* World, const FString& Label, const FVector& Origin, FString& OutError) const;
+
+	float UVScale = 0.01f;   // UV units per cm
+
+private:
+	struct FBlockoutBox
+	{
+		FVector  Center;
+		FVector  HalfExtent;
+		FRotator Rotation;
+		int32    MaterialIndex = 0;
+	};
+
+	TArray<FBlockoutBox> Boxes;
+	TArray<UMaterialInterface*> Materials;   // one per section; null keeps the engine default
+};
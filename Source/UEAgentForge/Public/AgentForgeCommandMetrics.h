@@ -0,0 +1,70 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeCommandMetrics — per-command latency histograms and byte counts.
+//
+// get_perf_stats describes the level; nothing measured the bridge itself.
+// ExecuteCommandJson records every call that resolves to a registered
+// command: wall time from lookup to response, request and response size in
+// UTF-8 bytes, and whether the response carries an error.
+//
+// Per command:
+//
+//   totals     calls, errors, bytes in / out, mean and max latency
+//   histogram  lifetime call counts per latency bucket (BucketUpperMs, last
+//              bucket unbounded)
+//   window     the latest WindowSize latencies, from which p50 / p95 / p99
+//              are taken (nearest rank), so percentiles follow recent load
+//              rather than the whole session
+//
+// Async submissions are timed up to the job_id response; the job's own time
+// is in get_job_status. Off-thread callers are timed once, when the game
+// thread runs their request.
+//
+// Game thread only.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"   // explicit with NoPCHs
+
+class UEAGENTFORGE_API FAgentForgeCommandMetrics
+{
+public:
+	static FAgentForgeCommandMetrics& Get();
+
+	/** Latest calls per command kept for percentiles. */
+	static constexpr int32 WindowSize = 256;
+
+	/** Histogram bucket upper bounds in ms; one more bucket catches the rest. */
+	static constexpr int32 NumBoundedBuckets = 15;
+	static constexpr double BucketUpperMs[NumBoundedBuckets] =
+		{ 0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0, 25.0, 50.0, 100.0, 250.0, 500.0, 1000.0, 2500.0, 5000.0 };
+
+	void Record(const FString& Cmd, double Ms, int64 BytesIn, int64 BytesOut, bool bError);
+
+	/** { bucket_le_ms:[], commands:{ name:{calls, errors, bytes_in, bytes_out, mean_ms,
+	 *  max_ms, p50_ms, p95_ms, p99_ms, window, histogram:[]} } }; Only limits it to one command. */
+	TSharedPtr<FJsonObject> GetMetricsJson(const FString& Only = FString()) const;
+
+	void Reset() { Commands.Reset(); }
+
+	/** commands, calls, errors, bytes_in, bytes_out. */
+	TSharedPtr<FJsonObject> GetStatsJson() const;
+
+private:
+	struct FCommandMetrics
+	{
+		int64  Calls = 0;
+		int64  Errors = 0;
+		int64  BytesIn = 0;
+		int64  BytesOut = 0;
+		double TotalMs = 0.0;
+		double MaxMs = 0.0;
+		int64  Buckets[NumBoundedBuckets + 1] = {};
+		TArray<float> Window;   // ring of the latest WindowSize latencies
+		int32  NextSlot = 0;
+	};
+
+	static TSharedPtr<FJsonObject> ToJson(const FCommandMetrics& M);
+
+	TMap<FString, FCommandMetrics> Commands;
+};
@@ -0,0 +1,108 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeCommandProfile — opt-in per-call timing breakdown ("profile": true).
+//
+// Any command accepts args.profile. ExecuteCommandJson then keeps one
+// FAgentForgeCommandProfile alive for the call and splices a "timings" object
+// into the response:
+//
+//   queue_wait_ms      enqueue (off-thread callers) or receipt (socket) to
+//                      execution on the game thread; 0 for direct calls
+//   parse_ms           request JSON parse
+//   handler_ms         dispatch, including verification and annotation
+//   verification_ms    time inside Verification.* stages
+//   serialize_ms       time inside Serialize stages (JSON writers)
+//   total_ms           parse to the response, before the splice
+//   stages             every AGENTFORGE_TRACE_SCOPE entered during the call,
+//                      plus distribution graph nodes, in first-entered order:
+//                      {name, depth, calls, ms}; ms is inclusive of nested
+//                      stages, repeated entries at one depth are summed
+//   categories         inclusive ms per stage prefix (text before the first
+//                      '.'), counting only the outermost stage of a category
+//   allocations        uobjects_created, used_physical_delta_mb
+//
+// The default allocator keeps no per-call heap allocation count, so
+// allocations reports UObject creations (counted by a create listener) and
+// the physical memory delta instead.
+//
+// A profiled request that reaches ExecuteCommandJson again with its own
+// "profile" nests a second profile; stages go to the innermost. Without an active profile a stage scope costs one pointer
+// check. Async submissions are profiled up to the job_id response.
+//
+// Game thread only. Off the game thread there is no active profile, so stage
+// scopes in worker compute (run_operator_pipeline) time nothing.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"   // explicit with NoPCHs
+
+class UEAGENTFORGE_API FAgentForgeCommandProfile
+{
+public:
+	FAgentForgeCommandProfile();
+	~FAgentForgeCommandProfile();
+
+	FAgentForgeCommandProfile(const FAgentForgeCommandProfile&) = delete;
+	FAgentForgeCommandProfile& operator=(const FAgentForgeCommandProfile&) = delete;
+
+	/** Innermost live profile, or null; always null off the game thread. */
+	static FAgentForgeCommandProfile* GetActive() { return IsInGameThread() ? Active : nullptr; }
+
+	/** Times one stage on the active profile; no-op without one. A leading "AgentForge." is dropped. */
+	class UEAGENTFORGE_API FStageScope
+	{
+	public:
+		explicit FStageScope(const TCHAR* Name);
+		~FStageScope();
+
+		FStageScope(const FStageScope&) = delete;
+		FStageScope& operator=(const FStageScope&) = delete;
+
+	private:
+		FAgentForgeCommandProfile* Profile = nullptr;
+		int32  Stage = INDEX_NONE;
+		bool   bOutermostOfCategory = false;
+		double StartSeconds = 0.0;
+	};
+
+	/** Transports set the wait of the request they are about to execute; ExecuteCommandJson takes it. */
+	static void   SetPendingWaitMs(double Ms) { PendingWaitMs = Ms; }
+	static double TakePendingWaitMs();
+
+	void SetQueueWaitMs(double Ms) { QueueWaitMs = Ms; }
+	void SetParseMs(double Ms)     { ParseMs = Ms; }
+	void SetHandlerMs(double Ms)   { HandlerMs = Ms; }
+
+	/** The timings object; TotalMs is measured by the caller. */
+	TSharedPtr<FJsonObject> ToJson(double TotalMs) const;
+
+	/** ResponseJson with "timings" added as its last field. Non-object responses are returned unchanged. */
+	static FString AttachTimings(const FString& ResponseJson, const TSharedPtr<FJsonObject>& Timings);
+
+private:
+	struct FStage
+	{
+		FString Name;
+		int32   Depth = 0;
+		int32   Calls = 0;
+		double  Ms = 0.0;
+	};
+	struct FObjectCounter;
+
+	int32 EnterStage(const FString& Name);
+	static FString CategoryOf(const FString& Name);
+
+	TArray<FStage>       Stages;
+	TMap<FString, int32> OpenCategories;   // category → open stage count
+	TMap<FString, double> Categories;
+	int32  Depth = 0;
+	double QueueWaitMs = 0.0;
+	double ParseMs = 0.0;
+	double HandlerMs = 0.0;
+	uint64 UsedPhysicalAtStart = 0;
+	TUniquePtr<FObjectCounter> ObjectCounter;
+	FAgentForgeCommandProfile* Previous = nullptr;
+
+	static FAgentForgeCommandProfile* Active;
+	static double PendingWaitMs;
+};
@@ -0,0 +1,92 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeCommandQueue — per-tick game-thread queue for off-thread requests.
+//
+// Remote Control (and any other transport) may call ExecuteCommandJson from a
+// worker thread. Rather than posting one AsyncTask per request and blocking on a
+// pooled FEvent, callers push onto a lock-free MPSC queue and wait on a TFuture.
+// A core ticker drains the queue once per frame under a millisecond budget, in
+// arrival order, so many agents sharing one editor cost a bounded slice of each
+// frame instead of an unbounded burst of game-thread tasks.
+//
+// Requests are parsed once, on the calling thread, and the parsed root goes
+// to dispatch with them. Identical pure-query requests (commands flagged
+// Coalescable) that land in the same drain share one execution, as long as no
+// other command ran in between.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "Containers/Queue.h"
+#include "Containers/Ticker.h"
+#include "Dom/JsonObject.h"   // explicit with NoPCHs
+#include <atomic>
+
+class UEAGENTFORGE_API FAgentForgeCommandQueue
+{
+public:
+	static FAgentForgeCommandQueue& Get();
+
+	static constexpr float DefaultFrameBudgetMs = 10.0f;
+
+	/** Register the drain ticker. Game thread (module startup). */
+	void Initialize();
+
+	/** Fail every queued request and stop draining. Safe to call more than once. */
+	void Shutdown();
+
+	/** Queue a request from any thread. Parses it here; the future completes on the game thread. */
+	TFuture<FString> Enqueue(const FString& RequestJson);
+
+	bool IsAcceptingRequests() const { return bAccepting.load(std::memory_order_acquire); }
+
+	void  SetFrameBudgetMs(float InBudgetMs);
+	float GetFrameBudgetMs() const { return FrameBudgetMs.load(std::memory_order_relaxed); }
+	void  SetCoalesceEnabled(bool bEnabled) { bCoalesce.store(bEnabled, std::memory_order_relaxed); }
+	bool  IsCoalesceEnabled() const { return bCoalesce.load(std::memory_order_relaxed); }
+
+	/**
+	 * True for pure queries (Coalescable) whose identical requests may share one
+	 * result. OutKey is cmd plus args, so requests tagged with different
+	 * request_ids still share; OutRequestIdJson is this request's id.
+	 * Root is the parsed request. Game thread only (reads the command registry).
+	 */
+	static bool MakeCoalesceKey(const TSharedPtr<FJsonObject>& Root, FString& OutKey, FString& OutRequestIdJson);
+
+	/** Queue depth / wait-time statistics for get_forge_status. */
+	TSharedPtr<FJsonObject> GetStatsJson() const;
+
+private:
+	struct FRequest
+	{
+		FString                 Json;
+		TSharedPtr<FJsonObject> Root;          // null when Json did not parse
+		double                  ParseMs = 0.0;
+		TPromise<FString>       Promise;
+		double                  EnqueueSeconds = 0.0;
+	};
+
+	bool Tick(float DeltaTime);
+	void Fail(FRequest& Request, const FString& Message);
+
+	TQueue<TUniquePtr<FRequest>, EQueueMode::Mpsc> Inbox;
+	FTSTicker::FDelegateHandle                     TickHandle;
+
+	std::atomic<bool>    bAccepting { false };
+	std::atomic<bool>    bCoalesce { true };
+	std::atomic<float>   FrameBudgetMs { DefaultFrameBudgetMs };
+	std::atomic<int32>   Depth { 0 };
+	std::atomic<int32>   MaxDepth { 0 };
+	std::atomic<int64>   TotalEnqueued { 0 };
+
+	// Game-thread only (written by Tick, read by GetStatsJson on the game thread).
+	int64  TotalExecuted = 0;
+	int64  TotalCoalesced = 0;
+	int64  TotalRejected = 0;
+	int64  Drains = 0;
+	int64  DrainsOverBudget = 0;
+	double TotalWaitMs = 0.0;
+	double MaxWaitMs = 0.0;
+	double LastDrainMs = 0.0;
+	int32  LastDrainCount = 0;
+};
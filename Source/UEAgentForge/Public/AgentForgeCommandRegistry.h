@@ -0,0 +1,142 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeCommandRegistry — hashed command table for ExecuteCommandJson.
+//
+// Every command the bridge understands is registered once at module startup with
+// its handler and routing metadata (mutating, operator-heavy, direct placement,
+// snapshot/rollback behaviour, post-verify hook, argument schema). Dispatch is a
+// single FName lookup instead of a chain of string comparisons, and the same
+// metadata drives the verification-mode inventory and the list_commands command.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"   // explicit with NoPCHs
+#include "VerificationEngine.h"
+
+class FAgentForgeJob;
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Routing flags
+// ─────────────────────────────────────────────────────────────────────────────
+enum class EAgentForgeCommandFlags : uint32
+{
+	None                     = 0,
+	Mutating                 = 1 << 0,  // Main path: ExecuteSafeTransaction (PreFlight + Snapshot + PostVerify)
+	OperatorHeavy            = 1 << 1,  // op_* / run_operator_pipeline — memory guarded
+	DirectPlacement          = 1 << 2,  // Blocked while operator-only mode is active
+	MemoryGuarded            = 1 << 3,  // Memory guard even though not main-path mutating (execute_python)
+	SkipSnapshotRollback     = 1 << 4,  // Not rollback-safe under the Phase 2 rollback test
+	RollbackLeaky            = 1 << 5,  // Rollback repro leaks actors; compensating cleanup probe instead
+	Bypass                   = 1 << 6,  // Mutates outside ExecuteSafeTransaction
+	ManualVerification       = 1 << 7,  // Bypass command that performs its own ad hoc verification
+	FinalizeResponse         = 1 << 8,  // Dispatcher annotates the response with verification metadata
+	SelfTransacting          = 1 << 9,  // Owns its transaction + verification pass (execute_batch); never nested
+	Coalescable              = 1 << 10, // Pure query: identical queued requests in one drain share a result
+	EditsBlueprints          = 1 << 11, // Main path also runs the (cached) Phase 4 BuildCheck
+};
+ENUM_CLASS_FLAGS(EAgentForgeCommandFlags);
+
+/** Handler signature shared by every registered command. */
+using FAgentForgeCommandHandler = TFunction<FString(const TSharedPtr<FJsonObject>& Args)>;
+
+/** Builds the staged job for commands that can run asynchronously ("async":true). */
+using FAgentForgeJobFactory = TFunction<TSharedRef<FAgentForgeJob>(const TSharedPtr<FJsonObject>& Args)>;
+
+/**
+ * Command-aware post verification hook. Receives the request args and the parsed
+ * command result, and fills OutResult.Passed/Detail. Presence of a hook is the
+ * "command-aware post-verify contract" for that command.
+ */
+using FAgentForgePostVerifyHook = void (*)(
+	const FString& Cmd,
+	const TSharedPtr<FJsonObject>& Args,
+	const TSharedPtr<FJsonObject>& ResultObj,
+	FVerificationPhaseResult& OutResult);
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  FAgentForgeVerificationPlan — which main-path checks a command gets
+// ─────────────────────────────────────────────────────────────────────────────
+struct UEAGENTFORGE_API FAgentForgeVerificationPlan
+{
+	bool bPreFlight              = false;
+	bool bSnapshotRollback       = false;
+	bool bCompensatingCleanup    = false;
+	bool bPostVerify             = false;
+	bool bCommandAwarePostVerify = false;
+	bool bBuildCheck             = false;
+
+	bool  IsEmpty() const { return !bPreFlight && !bSnapshotRollback && !bPostVerify && !bBuildCheck; }
+
+	/** EVerificationPhase bits of the phases the main path runs (the compensating probe has none). */
+	int32 GetPhaseMask() const;
+
+	TSharedPtr<FJsonObject> ToJson() const;
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  FAgentForgeCommandInfo — one registry entry
+// ─────────────────────────────────────────────────────────────────────────────
+struct UEAGENTFORGE_API FAgentForgeCommandInfo
+{
+	FName                     Name;
+	FString                   Category;
+	FString                   ArgSchema;              // e.g. "label, [x=0], [y=0]" (brackets = optional)
+	FString                   PreFlightDescription;   // Overrides the constitution action text; empty = command name
+	EAgentForgeCommandFlags   Flags = EAgentForgeCommandFlags::None;
+	FAgentForgeCommandHandler Handler;
+	FAgentForgePostVerifyHook PostVerify = nullptr;
+	FAgentForgeJobFactory     JobFactory;             // Set for time-sliced commands that accept "async":true
+
+	bool HasFlag(EAgentForgeCommandFlags Flag) const { return EnumHasAnyFlags(Flags, Flag); }
+	bool IsMutating() const             { return HasFlag(EAgentForgeCommandFlags::Mutating); }
+	bool IsOperatorHeavy() const        { return HasFlag(EAgentForgeCommandFlags::OperatorHeavy); }
+	bool IsDirectPlacement() const      { return HasFlag(EAgentForgeCommandFlags::DirectPlacement); }
+	bool HasPostVerifyContract() const  { return PostVerify != nullptr; }
+	bool SupportsAsync() const          { return static_cast<bool>(JobFactory); }
+	bool RequiresMemoryGuard() const
+	{
+		return HasFlag(EAgentForgeCommandFlags::Mutating | EAgentForgeCommandFlags::OperatorHeavy |
+			EAgentForgeCommandFlags::MemoryGuarded | EAgentForgeCommandFlags::SelfTransacting);
+	}
+
+	/** Static verification coverage for this command (see AgentForgeLibrary.cpp inventory). */
+	FString GetVerificationMode() const;
+
+	/**
+	 * The checks ExecuteSafeTransaction runs for this command, from its flags.
+	 * Empty for everything that is not main-path mutating; those route directly.
+	 */
+	FAgentForgeVerificationPlan PlanVerification() const;
+
+	/** Serialized metadata used by list_commands. */
+	TSharedPtr<FJsonObject> ToJson() const;
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  FAgentForgeCommandRegistry — process-wide FName → command table
+// ─────────────────────────────────────────────────────────────────────────────
+class UEAGENTFORGE_API FAgentForgeCommandRegistry
+{
+public:
+	static FAgentForgeCommandRegistry& Get();
+
+	/** Add or replace a command. Game thread only (module startup). */
+	void Register(FAgentForgeCommandInfo&& Info);
+
+	/** One hash lookup. Returns nullptr for unknown commands. */
+	const FAgentForgeCommandInfo* Find(FName Name) const;
+
+	/** Case-insensitive lookup that never adds unknown strings to the name table. */
+	const FAgentForgeCommandInfo* Find(const FString& Cmd) const;
+
+	bool  IsEmpty() const { return Commands.IsEmpty(); }
+	int32 Num() const     { return Commands.Num(); }
+	void  Reset();
+
+	/** Entries in registration order, optionally filtered by category. */
+	TArray<const FAgentForgeCommandInfo*> GetCommands(const FString& CategoryFilter = FString()) const;
+
+private:
+	TMap<FName, FAgentForgeCommandInfo> Commands;
+	TArray<FName>                       Order;
+};
@@ -0,0 +1,135 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeCommandTrace — append-only, compressed log of the command stream.
+//
+// While recording, ExecuteCommandJson appends one record per top-level call:
+// the request and response text, queue / parse / handler time, the error flag
+// and the world revision (FAgentForgeActorIndex) before and after the call.
+// Nested calls (execute_python re-entering the bridge) are part of their
+// outer call and are not recorded on their own.
+//
+// File layout (.aftrace). The file is a sequence of blocks, each one:
+//
+//   uint32 magic 'AFT1'   uint32 raw bytes   uint32 compressed bytes   zlib data
+//
+// All values are little-endian. Decompressed, a block is UTF-8 JSON lines. Each
+// start_command_trace appends a session header line:
+//
+//   {"type":"session","version":1,"map":"/Game/Maps/X","plugin_version":..,
+//    "engine_version":..,"started_utc":..,"revision":N}
+//
+// Then each call appends a record line:
+//
+//   {"type":"call","seq":N,"t":s,"cmd":..,"request":"<json text>",
+//    "response":"<json text>","response_bytes":N,"response_crc":N,
+//    "response_truncated":b,"error":b,"queue_wait_ms":..,"parse_ms":..,
+//    "handler_ms":..,"revision_before":N,"revision_after":N}
+//
+// A block is written once it holds BlockBytes of records, and when recording
+// stops. A crash therefore loses at most the last partial block, and a
+// truncated trailing block is skipped on load. Responses longer than
+// max_response_chars are cut: response_bytes and response_crc still describe
+// the full text. Python's zlib module reads the blocks directly.
+//
+// Start / stop: the start_command_trace / stop_command_trace commands, or
+// -AgentForgeTraceRecord=<path> on the editor command line. Replay:
+// FAgentForgeTraceReplay (AgentForgeTraceReplay.h).
+//
+// Game thread only.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"   // explicit with NoPCHs
+
+class FArchive;
+
+struct UEAGENTFORGE_API FAgentForgeTraceRecord
+{
+	int64   Sequence = 0;
+	double  TimeSeconds = 0.0;          // since the session started
+	FString Cmd;
+	FString Request;
+	FString Response;                   // cut to max_response_chars
+	int64   ResponseBytes = 0;          // UTF-8 length of the full response
+	uint32  ResponseCrc = 0;            // FCrc::StrCrc32 of the full response
+	bool    bResponseTruncated = false;
+	bool    bError = false;
+	double  QueueWaitMs = 0.0;
+	double  ParseMs = 0.0;
+	double  HandlerMs = 0.0;
+	int64   RevisionBefore = 0;
+	int64   RevisionAfter = 0;
+};
+
+struct UEAGENTFORGE_API FAgentForgeTraceSession
+{
+	FString Map;                        // long package name of the editor world
+	FString PluginVersion;
+	FString EngineVersion;
+	FString StartedUtc;
+	int64   Revision = 0;
+	TArray<FAgentForgeTraceRecord> Records;
+};
+
+struct UEAGENTFORGE_API FAgentForgeTraceRecordSettings
+{
+	FString Path;                       // empty = Saved/AgentForgeTraces/trace_<utc>.aftrace
+	int32   MaxResponseChars = 256 * 1024;
+	TSet<FString> Exclude;              // commands not recorded
+
+	/** path, max_response_chars, exclude[]. */
+	static FAgentForgeTraceRecordSettings FromJson(const TSharedPtr<FJsonObject>& Args);
+};
+
+class UEAGENTFORGE_API FAgentForgeCommandTrace
+{
+public:
+	static FAgentForgeCommandTrace& Get();
+
+	/** Raw record bytes buffered before a block is compressed and written. */
+	static constexpr int32 BlockBytes = 64 * 1024;
+
+	static FString GetDefaultDir();
+
+	/** Opens (or appends to) the trace file and writes a session header. Stops a running recording first. */
+	bool Start(const FAgentForgeTraceRecordSettings& Settings, FString& OutError);
+
+	/** Writes the pending block and closes the file. No-op when not recording. */
+	void Stop();
+
+	bool IsRecording() const { return Writer.IsValid(); }
+
+	/** Marks one ExecuteCommandJson call; only the outermost is recorded. */
+	struct FCallScope
+	{
+		FCallScope()  { ++Get().Depth; }
+		~FCallScope() { --Get().Depth; }
+		bool IsOutermost() const { return Get().Depth == 1; }
+	};
+
+	/** Appends a record; ignored when not recording, nested, or excluded. */
+	void Record(const FString& Cmd, const FString& Request, const FString& Response, bool bError,
+		double QueueWaitMs, double ParseMs, double HandlerMs, int64 RevisionBefore, int64 RevisionAfter);
+
+	/** recording, path, records, blocks, raw_bytes, compressed_bytes, pending_bytes. */
+	TSharedPtr<FJsonObject> GetStatsJson() const;
+
+	/** Every session in Path, oldest first. Skips a truncated trailing block. */
+	static bool Load(const FString& Path, TArray<FAgentForgeTraceSession>& OutSessions, FString& OutError);
+
+private:
+	void AppendLine(const TSharedRef<FJsonObject>& Line);
+	void FlushBlock();
+
+	FAgentForgeTraceRecordSettings Settings;
+	FString Path;
+	TUniquePtr<FArchive> Writer;
+	TArray<uint8> Pending;              // UTF-8 lines of the open block
+	double StartSeconds = 0.0;
+	int32  Depth = 0;
+	int64  NextSequence = 1;
+	int64  RecordsWritten = 0;          // this recording
+	int64  RawBytesWritten = 0;
+	int64  CompressedBytesWritten = 0;
+	int64  BlocksWritten = 0;
+};
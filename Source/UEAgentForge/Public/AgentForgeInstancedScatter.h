@@ -0,0 +1,65 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeInstancedScatter — writes scatter output as HISM instances.
+//
+// Scatter commands used to spawn one AStaticMeshActor per prop. Thousands of
+// actors cost a draw call, an editor tick and a saved object each. In
+// output:"instances" mode the same transforms go into one
+// UHierarchicalInstancedStaticMeshComponent per mesh and material on a single
+// owner actor, inserted with one AddInstances call.
+//
+// Every instance carries NumCustomData custom data floats:
+//
+//   [0..2]  tint (linear RGB)   -> PerInstanceCustomData 0..2 in the material
+//   [3]     uniform scale
+//
+// Materials that do not read PerInstanceCustomData render untinted.
+//
+// Editor, game thread only.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AActor;
+class UHierarchicalInstancedStaticMeshComponent;
+class UMaterialInterface;
+class UStaticMesh;
+
+enum class EAgentForgeScatterOutput : uint8
+{
+	Actors,      // one AStaticMeshActor per prop (default)
+	Instances    // one HISM per mesh + material
+};
+
+struct UEAGENTFORGE_API FAgentForgeInstanceBatch
+{
+	TArray<FTransform>   Transforms;   // world space
+	TArray<FLinearColor> Tints;        // empty = white
+	TArray<float>        Scales;       // empty = Transforms' X scale
+
+	void Reserve(int32 Num);
+	void Add(const FTransform& Transform, const FLinearColor& Tint, float Scale);
+	int32 Num() const { return Transforms.Num(); }
+};
+
+struct UEAGENTFORGE_API FAgentForgeInstancedScatter
+{
+	static constexpr int32 NumCustomData = 4;
+
+	/** "actors" | "instances", case-insensitive; empty keeps OutMode. */
+	static bool ParseOutput(const FString& Name, EAgentForgeScatterOutput& OutMode);
+	static const TCHAR* OutputName(EAgentForgeScatterOutput Mode);
+
+	/**
+	 * The HISM on Owner that renders Mesh with Material (null = mesh default),
+	 * created and registered on first use. Transactional, like the actors the
+	 * actor mode spawns.
+	 */
+	static UHierarchicalInstancedStaticMeshComponent* FindOrAddComponent(AActor* Owner, UStaticMesh* Mesh, UMaterialInterface* Material);
+
+	/** One AddInstances call, then the custom data of the new instances. Returns the first new index. */
+	static int32 AddInstances(UHierarchicalInstancedStaticMeshComponent* Component, const FAgentForgeInstanceBatch& Batch);
+
+	/** Instances across every HISM on Owner. */
+	static int32 CountInstances(const AActor* Owner);
+};
@@ -0,0 +1,166 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeJobManager — time-sliced jobs for long-running commands.
+//
+// Long commands (run_operator_pipeline, generate_full_quality_level,
+// create_blockout_level, enhance_horror_scene) are expressed as an ordered list
+// of stages. Called normally they run every stage inline (RunToCompletion) and
+// return the same response as before. Called with "async":true the dispatcher
+// submits the job here and returns a job_id immediately; the manager advances
+// the job from the core ticker under a per-frame millisecond budget so the
+// editor stays interactive and read-only queries are served between slices.
+//
+// Everything runs on the game thread — the ticker and the Remote Control HTTP
+// handlers are serialised there, so no job state needs locking.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Delegates/Delegate.h"
+#include "Dom/JsonObject.h"   // explicit with NoPCHs
+#include "Templates/SharedPointer.h"
+
+enum class EAgentForgeJobState : uint8
+{
+	Queued,
+	Running,
+	Succeeded,
+	Failed,
+	Cancelled,
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  FAgentForgeJob — one staged unit of work
+// ─────────────────────────────────────────────────────────────────────────────
+class UEAGENTFORGE_API FAgentForgeJob : public TSharedFromThis<FAgentForgeJob>
+{
+public:
+	/** Stage step. Return true when the stage is done; false to be called again on the next slice. */
+	using FStep = TFunction<bool(FAgentForgeJob& Job)>;
+	/** Builds the final response JSON once every stage has completed. */
+	using FFinalizer = TFunction<FString(FAgentForgeJob& Job)>;
+	/** Rolls back whatever the partially-run job has done (e.g. cancels its transaction). */
+	using FCancelHandler = TFunction<void(FAgentForgeJob& Job)>;
+	/** Post-processes the final response (verification annotation etc.). */
+	using FResultFilter = TFunction<FString(const FString& RawResult)>;
+
+	explicit FAgentForgeJob(const FString& InCommand);
+
+	// ─── Building ───────────────────────────────────────────────────────────
+	FAgentForgeJob& AddStage(const FString& Name, FStep Step, float Weight = 1.0f);
+	FAgentForgeJob& SetFinalizer(FFinalizer InFinalizer);
+	FAgentForgeJob& SetCancelHandler(FCancelHandler InHandler);
+	FAgentForgeJob& AddResultFilter(FResultFilter InFilter);
+
+	// ─── Called from inside a stage step ────────────────────────────────────
+	/** Fraction [0,1] of the current stage that is done; feeds percent_complete. */
+	void SetStageProgress(float Fraction);
+	/** Appended to partial_results (tagged with the current stage name). */
+	void AddPartialResult(const TSharedPtr<FJsonObject>& Partial);
+	/** End the job early with ResultJson (remaining stages and the finalizer are skipped). */
+	void Finish(const FString& ResultJson);
+	/** Stage is waiting on external work (e.g. an HTTP response): stop this tick's slice after the current step. */
+	void YieldSlice() { bYieldRequested = true; }
+
+	// ─── Execution ──────────────────────────────────────────────────────────
+	/** Run one step of the current stage. Returns true once the job has finished. */
+	bool Step();
+	/** Run every remaining stage inline and return the final response. */
+	FString RunToCompletion();
+	/** Cancel now: runs the cancel handler if the job had started. No-op once finished. */
+	void Cancel();
+
+	// ─── Introspection ──────────────────────────────────────────────────────
+	const FString&      GetId() const        { return Id; }
+	const FString&      GetCommand() const   { return Command; }
+	EAgentForgeJobState GetState() const     { return State; }
+	bool                IsFinished() const;
+	const FString&      GetResult() const    { return Result; }
+	float               GetPercentComplete() const;
+	FString             GetCurrentStageName() const;
+	float               FrameBudgetMs = 8.0f;
+
+	/** Status object for get_job_status. */
+	TSharedPtr<FJsonObject> ToJson(bool bIncludePartialResults, bool bIncludeResult) const;
+
+	static const TCHAR* StateToString(EAgentForgeJobState InState);
+
+private:
+	friend class FAgentForgeJobManager;
+
+	struct FStage
+	{
+		FString Name;
+		FStep   Step;
+		float   Weight = 1.0f;
+	};
+
+	void Complete(const FString& RawResult, EAgentForgeJobState FinalState);
+
+	FString                        Id;
+	FString                        Command;
+	TArray<FStage>                 Stages;
+	FFinalizer                     Finalizer;
+	FCancelHandler                 CancelHandler;
+	TArray<FResultFilter>          ResultFilters;
+
+	EAgentForgeJobState            State = EAgentForgeJobState::Queued;
+	int32                          StageIndex = 0;
+	float                          StageProgress = 0.0f;
+	int32                          Slices = 0;
+	double                         SubmitSeconds = 0.0;
+	double                         StartSeconds = 0.0;
+	double                         EndSeconds = 0.0;
+	double                         BusyMs = 0.0;
+	bool                           bFinishRequested = false;
+	bool                           bYieldRequested = false;
+	FString                        Result;
+	TArray<TSharedPtr<FJsonValue>> PartialResults;
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  FAgentForgeJobManager — FIFO job queue driven by the core ticker
+// ─────────────────────────────────────────────────────────────────────────────
+class UEAGENTFORGE_API FAgentForgeJobManager
+{
+public:
+	/** Fired after each tick that advanced a job (bFinished=false) and once when it finishes or is cancelled. */
+	DECLARE_MULTICAST_DELEGATE_TwoParams(FOnJobEvent, const FAgentForgeJob& /*Job*/, bool /*bFinished*/);
+
+	static FAgentForgeJobManager& Get();
+
+	static constexpr float DefaultFrameBudgetMs = 8.0f;
+	static constexpr int32 MaxPendingJobs = 16;
+	static constexpr int32 MaxFinishedJobsRetained = 32;
+
+	/** Queue a job; returns its job_id. Jobs run one at a time in submission order. */
+	FString Submit(const TSharedRef<FAgentForgeJob>& Job, float FrameBudgetMs = DefaultFrameBudgetMs);
+
+	TSharedPtr<FAgentForgeJob> Find(const FString& JobId) const;
+
+	/** Cancel a queued or running job. Returns false with OutError if it cannot be cancelled. */
+	bool Cancel(const FString& JobId, FString& OutError);
+
+	/** True while any job is queued or running. */
+	bool HasPendingJobs() const { return !Queue.IsEmpty(); }
+	int32 NumPendingJobs() const { return Queue.Num(); }
+
+	/** All tracked jobs, pending first (in run order) then finished (newest first). */
+	TArray<TSharedRef<FAgentForgeJob>> GetJobs() const;
+
+	/** Cancel everything and stop ticking (module shutdown / engine pre-exit). */
+	void Shutdown();
+
+	/** Progress / completion notifications (socket transport pushes these to clients). */
+	FOnJobEvent& OnJobEvent() { return JobEvent; }
+
+private:
+	bool Tick(float DeltaTime);
+	void Retire(const TSharedRef<FAgentForgeJob>& Job);
+
+	TArray<TSharedRef<FAgentForgeJob>>        Queue;      // Queue[0] is the running job
+	TArray<TSharedRef<FAgentForgeJob>>        Finished;   // Oldest first, bounded
+	FTSTicker::FDelegateHandle                TickHandle;
+	int32                                     NextJobSerial = 1;
+	FOnJobEvent                               JobEvent;
+};
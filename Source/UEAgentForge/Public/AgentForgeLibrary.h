@@ -5,6 +5,9 @@
 #include "Dom/JsonObject.h"           // FJsonObject, TSharedPtr — explicit with NoPCHs
 #include "AgentForgeLibrary.generated.h"
 
+class FAgentForgeJob;
+struct FAgentForgeCommandInfo;
+
 /**
  * UEAgentForge v0.5.0 — Enterprise-grade AI agent command surface.
  *
@@ -20,17 +23,50 @@
  *                           args: [phase_mask=15]   (bits: 1=PreFlight, 2=Snapshot, 4=PostVerify, 8=BuildCheck)
  *   enforce_constitution  → {allowed, violations[]}
  *                           args: action_description
- *   get_forge_status      → {version, constitution_rules_loaded, constitution_path, last_verification}
+ *   get_forge_status      → {version, constitution_rules_loaded, constitution_path, last_verification,
+ *                             pending_jobs, command_queue{depth, max_depth, avg_wait_ms, max_wait_ms, ...}}
+ *   list_commands         → {count, commands[{name, category, args, mutating, operator_heavy,
+ *                             direct_placement, memory_guarded, snapshot_rollback,
+ *                             post_verify_contract, verification_mode}]}
+ *                           args: [category]
+ *   execute_batch         → {ok, count, succeeded, failed, rolled_back, total_ms,
+ *                             verification_mode, results[{index, cmd, ok, duration_ms, result}]}
+ *                           args: commands[{cmd,args}], [transactional=true],
+ *                                 [stop_on_error=true], [verify=true]
+ *                           One game-thread hop, one FScopedTransaction, one PreFlight/PostVerify.
+ *   get_job_status        → {ok, job_id, cmd, state, stage, percent_complete, partial_results[], result}
+ *                           args: [job_id], [include_partial=true]   (no job_id → {pending_jobs, jobs[]})
+ *   cancel_job            → {ok, job_id, state:"cancelled", ...}
+ *                           args: job_id
+ *   set_command_queue_policy → {ok, frame_budget_ms, coalesce_read_only, depth, ...}
+ *                           args: [frame_budget_ms=10], [coalesce_read_only=true]
+ *                           Off-thread requests drain once per frame within this budget.
+ *   start_socket_server   → {ok, running, url, port, connections, ...}
+ *                           args: [port=30020], [bind_address=127.0.0.1]
+ *                           Persistent WebSocket transport: {id,cmd,args} in, {type,id,result} out,
+ *                           plus pushed events (job_progress, job_finished, stream_chunk).
+ *   stop_socket_server    → {ok}
+ *
+ *   Long-running commands (run_operator_pipeline, generate_full_quality_level,
+ *   create_blockout_level, enhance_horror_scene) accept "async":true and
+ *   [frame_budget_ms=8]: they return {ok, job_id, state:"queued"} at once and run
+ *   as time-sliced stages over editor ticks. While a job is pending only
+ *   read-only commands are accepted.
  *
  * ─── OBSERVATION ────────────────────────────────────────────────────────────
  *
  *   ping                  → {pong, version}
  *   get_current_level     → {package_path, world_path, actor_prefix, map_lock}
- *   get_world_context     → {schema, budget, level, semantic, composition, actors[],
+ *   get_world_context     → {schema, revision, budget, level, semantic, composition, actors[],
  *                             gameplay_anchors[], relationships[], llm_brief[]}
  *                           args: [max_actors=120], [max_relationships=48], [include_components=false]
+ *                                 [since_revision] → {schema:"world_context_delta_v1", revision,
+ *                                   added[], modified[], removed[{label,name,object_path}]}
+ *                                 + actor query args (see below)
  *   assert_current_level  → {ok, expected_level, current_package_path}
  *   get_all_level_actors  → [{name,label,class,object_path,location,rotation,scale,bounds}]
+ *                           args: actor query args — [fields[]], [class], [tag],
+ *                                 [bounds{min,max}], [limit], [cursor] (AgentForgeActorQuery.h)
  *   get_actor_components  → [{name,class,object_path}]       args: label
  *   get_actor_bounds      → {origin,extent,box_min,box_max}  args: label
  *   set_viewport_camera   → {ok, x,y,z, pitch,yaw,roll}
@@ -126,7 +162,11 @@
  *   analyze_level_composition → {ok, actor_count, static_count, light_count, ai_count,
  *                                bounds, density_score, recommendations[]}
  *   get_actors_in_radius     → {ok, count, actors[{label,class,distance,location}]}
- *                              args: x,y,z, radius
+ *                              args: x,y,z, radius + actor query args
+ *   get_actors_in_box        → {ok, count, actors[{label,class,location}]}
+ *                              args: min{x,y,z}, max{x,y,z} + actor query args
+ *   get_nearest_actors       → {ok, count, actors[{label,class,distance,location}]}
+ *                              args: x,y,z, [k=8], [max_radius] + actor query args
  *
  * ─── FAB INTEGRATION (v0.2.0) ───────────────────────────────────────────────
  *
@@ -152,6 +192,9 @@
  *   get_multi_view_capture   → {ok, angle, note, camera:{x,y,z,pitch,yaw}, preset_angles[]}
  *                              args: [angle="top"|"front"|"side"|"tension"],
  *                                    [center_x,center_y,center_z], [orbit_radius=3000]
+ *                              render=true → {ok, angle, angles[], image_paths[]}:
+ *                                    off-screen SceneCapture2D, angle "all" for every
+ *                                    preset, [width=1280], [height=720], [fov=90]
  *   get_level_hierarchy      → {ok, actor_count, actors:[{label, class, parent, tags,
  *                                is_visible, components[], location, bounds}]}
  *   get_deep_properties      → {ok, label, class, property_count, properties:{name:value}}
@@ -163,7 +206,8 @@
  *                                 density:{actor_count, static_count, light_count, ai_count,
  *                                   density_per_m2},
  *                                 level_bounds:{center, extent, area_m2},
- *                                 horror_score, horror_rating}
+ *                                 horror_score, horror_rating, revision}
+ *                              args: [since_revision] → {unchanged:true} or + changes{added,modified,removed}
  *
  * ─── SEMANTIC COMMANDS (v0.3.0) ──────────────────────────────────────────────
  *
@@ -204,6 +248,15 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "AgentForge|Core")
 	static FString ExecuteCommandJson(const FString& RequestJson);
 
+	/**
+	 * ExecuteCommandJson for a request the caller has already parsed, so the
+	 * command queue and socket server parse each request once. Root must be
+	 * RequestJson parsed; RequestJson is still used for metrics and traces.
+	 * ParseMs is what that parse cost, reported by "profile": true.
+	 * Game thread only.
+	 */
+	static FString ExecuteParsedCommandJson(const FString& RequestJson, const TSharedPtr<FJsonObject>& Root, double ParseMs = 0.0);
+
 	// Module lifecycle hook used by UEAgentForge module shutdown delegates.
 	// Marks command execution as unavailable and releases transient editor state.
 	static void MarkEngineShuttingDown();
@@ -211,6 +264,10 @@ public:
 	// True when the module has entered shutdown or the engine is exiting.
 	static bool IsEngineShuttingDown();
 
+	// Builds the FName → handler command registry. Called from StartupModule;
+	// ExecuteCommandJson also builds it lazily if it is still empty.
+	static void RegisterBuiltinCommands();
+
 	/**
 	 * Execute a command inside a full safe transaction with auto-snapshot and verification.
 	 * Returns false and cancels the transaction if any verification phase fails.
@@ -249,7 +306,7 @@ public:
 private:
 	// ─── Observation ──────────────────────────────────────────────────────────
 	static FString Cmd_Ping(const TSharedPtr<FJsonObject>& Args);
-	static FString Cmd_GetAllLevelActors();
+	static FString Cmd_GetAllLevelActors(const TSharedPtr<FJsonObject>& Args);
 	static FString Cmd_GetActorComponents(const TSharedPtr<FJsonObject>& Args);
 	static FString Cmd_GetCurrentLevel();
 	static FString Cmd_AssertCurrentLevel(const TSharedPtr<FJsonObject>& Args);
@@ -329,21 +386,53 @@ private:
 
 	// ─── Performance profiling ────────────────────────────────────────────────
 	static FString Cmd_GetPerfStats();
+	// get_command_metrics: args [cmd], [reset=false] — latency percentiles / histogram per command
+	static FString Cmd_GetCommandMetrics(const TSharedPtr<FJsonObject>& Args);
+	// start_command_trace: args [path], [max_response_chars], [exclude[]] — record requests / responses to a .aftrace file
+	static FString Cmd_StartCommandTrace(const TSharedPtr<FJsonObject>& Args);
+	static FString Cmd_StopCommandTrace();
+	// get_farm_status: args [spool], [job_ids[]], [cache=disk] — import finished farm results, list queue and workers
+	static FString Cmd_GetFarmStatus(const TSharedPtr<FJsonObject>& Args);
 
 	// ─── Forge meta-commands ──────────────────────────────────────────────────
 	static FString Cmd_RunVerification(const TSharedPtr<FJsonObject>& Args);
 	static FString Cmd_EnforceConstitution(const TSharedPtr<FJsonObject>& Args);
 	static FString Cmd_GetForgeStatus();
+	static FString Cmd_ListCommands(const TSharedPtr<FJsonObject>& Args);
+	static FString Cmd_ExecuteBatch(const TSharedPtr<FJsonObject>& Args);
+	// get_job_status: args [job_id], [include_partial=true] — no job_id lists every tracked job
+	static FString Cmd_GetJobStatus(const TSharedPtr<FJsonObject>& Args);
+	// cancel_job: args job_id — cancels a queued/running job and rolls back its open transaction
+	static FString Cmd_CancelJob(const TSharedPtr<FJsonObject>& Args);
+	// set_command_queue_policy: args [frame_budget_ms], [coalesce_read_only] — returns queue stats
+	static FString Cmd_SetCommandQueuePolicy(const TSharedPtr<FJsonObject>& Args);
+	// set_verification_policy: args [rollback_scope=scoped|full] — returns verification stats
+	static FString Cmd_SetVerificationPolicy(const TSharedPtr<FJsonObject>& Args);
+	// start_socket_server / stop_socket_server: optional WebSocket transport (AgentForgeSocketServer.h)
+	static FString Cmd_StartSocketServer(const TSharedPtr<FJsonObject>& Args);
+	static FString Cmd_StopSocketServer(const TSharedPtr<FJsonObject>& Args);
 
 	// ─── Scene setup ──────────────────────────────────────────────────────────
 	static FString Cmd_SetupTestLevel(const TSharedPtr<FJsonObject>& Args);
+	// llm_chat, llm_structured and vision_quality_score accept [fan_out[]], [fan_out_mode], [hedge_delay_ms]
+	// to race extra providers — returns the winning response plus winner_index and a fan_out[] row per candidate
 	static FString Cmd_LLMChat(const TSharedPtr<FJsonObject>& Args);
 	static FString Cmd_LLMStream(const TSharedPtr<FJsonObject>& Args);
+	// Job behind llm_stream "async":true; partial_results carry the chunks as they arrive.
+	static TSharedRef<FAgentForgeJob> MakeLLMStreamJob(const TSharedPtr<FJsonObject>& Args);
 	static FString Cmd_LLMStructured(const TSharedPtr<FJsonObject>& Args);
 	static FString Cmd_LLMSetKey(const TSharedPtr<FJsonObject>& Args);
 	static FString Cmd_LLMGetModels(const TSharedPtr<FJsonObject>& Args);
+	// set_llm_cache_policy: args [ttl_seconds], [memory_entries], [disk_budget_mb], [disk], [clear], [clear_disk] — returns cache stats
+	static FString Cmd_SetLLMCachePolicy(const TSharedPtr<FJsonObject>& Args);
+	// set_llm_scheduler_policy: args [provider], [max_concurrent], [max_retries], [backoff_base_ms], [backoff_max_ms] — returns scheduler stats
+	static FString Cmd_SetLLMSchedulerPolicy(const TSharedPtr<FJsonObject>& Args);
+	// validate_json: args value|json, schema|schema_name, [reload] — returns valid, error (first failing path), schema_nodes
+	static FString Cmd_ValidateJson(const TSharedPtr<FJsonObject>& Args);
 	static FString Cmd_VisionAnalyze(const TSharedPtr<FJsonObject>& Args);
 	static FString Cmd_VisionQualityScore(const TSharedPtr<FJsonObject>& Args);
+	// set_vision_cache_policy: args [enabled], [min_similarity], [max_hash_distance], [max_age_seconds], [capacity], [clear] — returns cache stats
+	static FString Cmd_SetVisionCachePolicy(const TSharedPtr<FJsonObject>& Args);
 
 	// ─── v0.2.0 Unified Orchestration ─────────────────────────────────────────
 	// enhance_current_level: analyze composition + spatial placement + verification + screenshot
@@ -359,6 +448,8 @@ private:
 	//   args: description, [intensity=1.0], [prop_count=5]
 	//   returns: {ok, actions_taken[], final_horror_score, screenshot_path}
 	static FString Cmd_EnhanceHorrorScene(const TSharedPtr<FJsonObject>& Args);
+	// Staged job behind enhance_horror_scene (sync handler and "async":true path).
+	static TSharedRef<FAgentForgeJob> MakeEnhanceHorrorSceneJob(const TSharedPtr<FJsonObject>& Args);
 
 	// ─── AI asset wiring ──────────────────────────────────────────────────────
 	// set_bt_blackboard: links a BlackboardData asset to a BehaviorTree via C++
@@ -383,4 +474,7 @@ private:
 	static AActor*         FindActorByLabelOrName(const FString& LabelOrName);
 	static TSharedPtr<FJsonObject> VecToJson(const FVector& V);
 	static bool            IsMutatingCommand(const FString& Cmd);
+	static FString         SubmitCommandJob(const FAgentForgeCommandInfo& Info, const FString& Cmd, const TSharedPtr<FJsonObject>& Args);
+	/** ExecuteSafeTransaction body for an already parsed and resolved command. */
+	static bool            RunSafeTransaction(const FAgentForgeCommandInfo& Info, const FString& Cmd, const TSharedPtr<FJsonObject>& Args, FString& OutResult);
 };
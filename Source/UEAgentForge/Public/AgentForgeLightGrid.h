@@ -0,0 +1,82 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeLightGrid — cached light-influence volume for semantic placement.
+//
+// place_asset_thematically scored darkness by running a radius query for
+// lights around every candidate and summing their intensities, so a
+// placement of N props over L lights cost N*10 spatial queries and the same
+// sums were redone on every refine_level_section iteration.
+//
+// The grid snapshots every local light (point, spot, rect) once — position,
+// intensity, attenuation radius — and accumulates
+//
+//   influence(p) = sum of Intensity * (1 - |p - light| / AttenuationRadius)
+//
+// at the corners of a coarse 3D grid over the queried region, one ParallelFor
+// work item per Z slab. Samples are trilinear between corners. Directional
+// and sky lights are ignored, as before.
+//
+// The grid is reused while the lights are unchanged. Changes are read from
+// the actor index revision: a delta that adds, modifies or removes an ALight
+// (moves, intensity and radius edits, undo/redo, map change) drops the grid,
+// anything else only advances the revision it was built at. A query outside
+// the cached region rebuilds over the new region.
+//
+// Game thread only.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"   // explicit with NoPCHs
+#include "UObject/WeakObjectPtr.h"
+
+class UWorld;
+
+class UEAGENTFORGE_API FAgentForgeLightGrid
+{
+public:
+	static FAgentForgeLightGrid& Get();
+
+	/** Grid corners are at least this far apart. */
+	static constexpr float MinCellSize = 100.0f;
+
+	/** Corners per axis are capped here; larger regions get coarser cells. */
+	static constexpr int32 MaxCellsPerAxis = 64;
+
+	/** Summed light influence at each point, same order. Builds the grid when stale or too small. */
+	void Sample(UWorld* World, TArrayView<const FVector> Points, TArray<float>& OutInfluence);
+
+	/** Drop the grid; the next Sample rebuilds. */
+	void Invalidate() { bValid = false; }
+
+	/** builds, reuses, samples, lights, cells, cell_size, last_build_ms. */
+	TSharedPtr<FJsonObject> GetStatsJson() const;
+
+private:
+	struct FLightSample
+	{
+		FVector Location = FVector::ZeroVector;
+		float   Intensity = 0.0f;
+		float   Radius = 0.0f;
+	};
+
+	/** True while the grid was built for World and no light changed since. */
+	bool IsCurrent(UWorld* World);
+	void Build(UWorld* World, const FBox& Region);
+	float SampleAt(const FVector& Point) const;
+
+	TArray<FLightSample>   Lights;
+	TSet<FString>          LightPaths;   // to recognise removed lights in a delta
+	TArray<float>          Corners;      // X fastest, then Y, then Z
+	FIntVector             Dims = FIntVector::ZeroValue;
+	FVector                Origin = FVector::ZeroVector;
+	float                  CellSize = MinCellSize;
+	FBox                   Region = FBox(ForceInit);
+	TWeakObjectPtr<UWorld> BuiltWorld;
+	int64                  BuiltRevision = 0;
+	bool                   bValid = false;
+
+	int64  Builds = 0;
+	int64  Reuses = 0;
+	int64  PointsSampled = 0;
+	double LastBuildMs = 0.0;
+};
@@ -0,0 +1,128 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeMemoryMonitor — sampled memory pressure for the command guard.
+//
+// The guard used to read FPlatformMemory::GetStats on every guarded command
+// and, under pressure, run a blocking full CollectGarbage inline before
+// re-checking. A full GC in the middle of an agent batch is a multi-second
+// hitch. Instead:
+//
+//   sampling    a core ticker starts one thread-pool sample every
+//               SampleIntervalSeconds; the result is published in atomics.
+//               When the engine is not ticking (a long batch, a commandlet)
+//               the first reader of a stale sample takes it inline, so there
+//               is still at most one GetStats per interval.
+//   hysteresis  pressure starts below EnterAvailableMB or at EnterUsedPercent
+//               and ends only above ExitAvailableMB and below ExitUsedPercent,
+//               so a process sitting on the limit does not flip per sample.
+//   prediction  each guarded command's used-memory growth is learned as an
+//               EWMA. A command whose estimate would carry the process into
+//               pressure requests a GC up front but still runs.
+//   GC          never inline. A request is handed to the engine
+//               (ForceGarbageCollection) from the ticker, between commands,
+//               and runs in the engine's next GC slot, with incremental purge
+//               where the engine has it enabled. The post-GC delegate resamples.
+//               Commandlets have no GC slot and collect from the ticker.
+//
+// While under pressure Check blocks guarded commands and asks for a GC; the
+// caller retries once one has run (gcs_completed in the status block).
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Dom/JsonObject.h"   // explicit with NoPCHs
+#include <atomic>
+
+/** One published reading. */
+struct FAgentForgeMemorySample
+{
+	double UsedMB = 0.0;
+	double AvailableMB = 0.0;
+	double TotalMB = 0.0;
+	double Seconds = 0.0;               // FPlatformTime::Seconds when taken
+	int64  Sequence = 0;                // 0 = no sample yet
+
+	double UsedPercent() const { return TotalMB > 0.0 ? UsedMB / TotalMB * 100.0 : 0.0; }
+};
+
+/** Outcome of one guard check. */
+struct FAgentForgeMemoryVerdict
+{
+	bool   bAllowed = true;
+	bool   bGcRequested = false;
+	double PredictedMB = 0.0;           // learned growth of this command
+	FAgentForgeMemorySample Sample;
+	FString Error;                      // set when !bAllowed
+};
+
+class UEAGENTFORGE_API FAgentForgeMemoryMonitor
+{
+public:
+	static FAgentForgeMemoryMonitor& Get();
+
+	static constexpr double SampleIntervalSeconds = 0.25;
+	static constexpr double EnterAvailableMB = 2048.0;
+	static constexpr double EnterUsedPercent = 92.0;
+	static constexpr double ExitAvailableMB = 2560.0;
+	static constexpr double ExitUsedPercent = 88.0;
+
+	/** Weight of the newest observation in a command's growth estimate. */
+	static constexpr double CostBlend = 0.3;
+
+	/** Register the ticker and post-GC delegate. Game thread (module startup). */
+	void Initialize();
+
+	/** Stop sampling and scheduling. Safe to call more than once. */
+	void Shutdown();
+
+	/** Latest sample; taken inline when older than two intervals. Any thread. */
+	FAgentForgeMemorySample GetSample();
+
+	bool IsUnderPressure() const { return bPressure.load(std::memory_order_acquire); }
+
+	/** Guard for Cmd. Never collects garbage itself. Game thread. */
+	FAgentForgeMemoryVerdict Check(const FString& Cmd);
+
+	/** Learns Cmd's growth from the sample taken at Check to the current one. Game thread. */
+	void RecordCost(const FString& Cmd, const FAgentForgeMemorySample& Before);
+
+	/** Ask for a GC between commands. Any thread. */
+	void RequestGarbageCollection();
+
+	/** sampling, used_mb, available_mb, used_percent, pressure, thresholds, counters. */
+	TSharedPtr<FJsonObject> GetStatsJson() const;
+
+private:
+	bool Tick(float DeltaTime);
+	void TakeSample();
+	void Publish(double UsedMB, double AvailableMB, double TotalMB);
+	void HandlePostGarbageCollect();
+
+	FTSTicker::FDelegateHandle TickHandle;
+	FDelegateHandle            PostGcHandle;
+
+	// Published by whichever thread sampled last; each field is atomic on its
+	// own, so a reader may combine fields of two adjacent samples.
+	std::atomic<double> UsedMB { 0.0 };
+	std::atomic<double> AvailableMB { 0.0 };
+	std::atomic<double> TotalMB { 0.0 };
+	std::atomic<double> SampleSeconds { 0.0 };
+	std::atomic<int64>  Sequence { 0 };
+	std::atomic<bool>   bPressure { false };
+	std::atomic<bool>   bSampleInFlight { false };
+	std::atomic<bool>   bGcWanted { false };
+	std::atomic<bool>   bActive { false };
+	std::atomic<double> PressureSinceSeconds { 0.0 };
+	std::atomic<int64>  PressureEntries { 0 };
+	std::atomic<int64>  GcRequests { 0 };
+
+	// Game-thread only.
+	TMap<FString, double> CostMB;       // learned growth per command
+	double LastTickSampleSeconds = 0.0;
+	int64  Checks = 0;
+	int64  Blocked = 0;
+	int64  Predicted = 0;
+	int64  GcScheduled = 0;             // handed to the engine
+	int64  GcCompleted = 0;
+	double LastGcSeconds = 0.0;
+};
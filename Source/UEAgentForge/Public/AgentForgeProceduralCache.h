@@ -0,0 +1,114 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeProceduralCache — content-addressed cache for generated intermediate data.
+//
+// Operators that are pure functions of their inputs (terrain heightmaps,
+// distribution point sets) hash every input that affects the result into a
+// key and store the serialized result under it. Iterative loops such as
+// generate_full_quality_level re-run operators with identical seeds, bounds
+// and parameters; those calls now deserialize instead of recomputing.
+//
+//   Memory tier  LRU by last use, bounded in bytes. Payloads are shared and
+//                immutable, so a hit hands out a reference, not a copy.
+//   Disk tier    Optional, per store: Saved/AgentForgeCache/<kind>/<key>.bin.
+//                A disk hit is promoted into memory.
+//
+// Keys are SHA-1 hex digests of a canonical input string, so they are stable
+// across sessions and safe as file names. Callers decide what goes into the
+// key; anything omitted must not change the output.
+//
+// Because a key names its result on any machine running the same plugin, a
+// capture (BeginCapture / EndCapture) collects every entry a farm worker
+// stored or hit, and the editor Stores them as is (AgentForgeWorkerFarm.h).
+//
+// Thread-safe.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"   // explicit with NoPCHs
+#include "HAL/CriticalSection.h"
+
+enum class EProceduralCacheMode : uint8
+{
+	Off,       // never read or write
+	Memory,    // memory tier only
+	Disk,      // memory + disk tier
+};
+
+class UEAGENTFORGE_API FAgentForgeProceduralCache
+{
+public:
+	using FPayload = TSharedPtr<const TArray<uint8>, ESPMode::ThreadSafe>;
+
+	struct FCapturedEntry
+	{
+		FString  Kind;
+		FString  Key;
+		FPayload Payload;
+	};
+
+	static FAgentForgeProceduralCache& Get();
+
+	static constexpr int64 DefaultMemoryBudgetBytes = 512ll * 1024 * 1024;
+
+	/** SHA-1 hex digest of Kind + Inputs. */
+	static FString MakeKey(const TCHAR* Kind, const FString& Inputs);
+
+	/** "off" | "memory" | "disk", case-insensitive. */
+	static bool ParseMode(const FString& Name, EProceduralCacheMode& OutMode);
+	static const TCHAR* ModeName(EProceduralCacheMode Mode);
+
+	/**
+	 * Memory first, then disk when Mode is Disk. OutFromDisk is set on a disk
+	 * hit. Counts a hit or a miss.
+	 */
+	FPayload Find(const TCHAR* Kind, const FString& Key, EProceduralCacheMode Mode, bool* OutFromDisk = nullptr);
+
+	/** Store into memory (evicting least recently used entries) and, for Disk, onto disk. */
+	void Store(const TCHAR* Kind, const FString& Key, TArray<uint8>&& Payload, EProceduralCacheMode Mode);
+
+	/** Record every entry stored or found from now on, whichever thread does it. */
+	void BeginCapture();
+
+	/** Stop recording. Distinct entries in first-use order. */
+	TArray<FCapturedEntry> EndCapture();
+
+	/** Drop the memory tier; bIncludeDisk also deletes Saved/AgentForgeCache. */
+	void Clear(bool bIncludeDisk);
+
+	void  SetMemoryBudgetBytes(int64 Bytes);
+	int64 GetMemoryBudgetBytes() const;
+
+	static FString GetDiskRoot();
+
+	/** Hit / miss / eviction counters and tier sizes for diagnostics. */
+	TSharedPtr<FJsonObject> GetStatsJson() const;
+
+private:
+	struct FEntry
+	{
+		FPayload Payload;
+		uint64   LastUse = 0;
+	};
+
+	FString DiskPath(const TCHAR* Kind, const FString& Key) const;
+	void    EvictToBudget();
+	void    CaptureLocked(const FString& EntryKey, const TCHAR* Kind, const FString& Key, const FPayload& Payload);
+
+	mutable FCriticalSection Lock;
+	TMap<FString, FEntry>    Entries;   // "<kind>/<key>"
+	int64  MemoryBytes = 0;
+	int64  MemoryBudgetBytes = DefaultMemoryBudgetBytes;
+	uint64 UseClock = 0;
+
+	bool                   bCapturing = false;
+	TArray<FCapturedEntry> Captured;
+	TSet<FString>          CapturedKeys;
+
+	int64 MemoryHits = 0;
+	int64 DiskHits = 0;
+	int64 Misses = 0;
+	int64 Stores = 0;
+	int64 DiskWrites = 0;
+	int64 Evictions = 0;
+};
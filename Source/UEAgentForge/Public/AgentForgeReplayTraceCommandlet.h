@@ -0,0 +1,29 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeReplayTraceCommandlet — headless entry point for trace replay.
+//
+//   UnrealEditor-Cmd <Project>.uproject -run=AgentForgeReplayTrace
+//       -trace=<file.aftrace> [-session=-1] [-map=/Game/Maps/X|none]
+//       [-repeats=1] [-tolerance=0.25] [-min_delta_ms=2] [-job_timeout=600]
+//       [-skip=cmd_a,cmd_b] [-ignore_keys=key_a,key_b] [-label=ci]
+//       [-output=<dir>] [-report_only]
+//
+// Replays one recorded session through FAgentForgeTraceReplay and writes its
+// JSON / CSV report. Returns 0 when the report was written and shows no
+// divergence or regression (-report_only: whenever it was written).
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "AgentForgeReplayTraceCommandlet.generated.h"
+
+UCLASS()
+class UEAGENTFORGE_API UAgentForgeReplayTraceCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UAgentForgeReplayTraceCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
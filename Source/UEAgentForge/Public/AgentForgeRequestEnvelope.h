@@ -0,0 +1,94 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeRequestEnvelope — client request ids and idempotent retry keys.
+//
+// ExecuteCommandJson accepts two optional top-level fields next to cmd/args:
+//
+//   request_id       a string or number chosen by the client. It is echoed as
+//                    the first field of the response, so a client with many
+//                    requests in flight (several keep-alive connections, the
+//                    socket transport, off-thread callers sharing the command
+//                    queue) matches replies by id rather than by arrival order.
+//   idempotency_key  a string, honoured for commands that change the level or
+//                    submit a job. A successful response is kept for
+//                    IdempotencyTtlSeconds under the key together with a hash
+//                    of cmd and args. A retry with the same key and body gets
+//                    that response back with "idempotent_replay": true and the
+//                    command does not run again; the same key with a different
+//                    body is rejected. Failed responses are not kept, so a retry
+//                    after a refusal (memory guard, pending jobs) runs normally.
+//
+// Read-only commands ignore the key: running them again is the correct retry.
+//
+// Game-thread only.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AgentForgeStringKeys.h"
+#include "Dom/JsonObject.h"   // explicit with NoPCHs
+
+class UEAGENTFORGE_API FAgentForgeRequestEnvelope
+{
+public:
+	static constexpr int32  MaxIdempotencyKeys    = 1024;
+	static constexpr int32  MaxIdempotencyKeyLen  = 128;
+	static constexpr double IdempotencyTtlSeconds = 600.0;
+
+	static FAgentForgeRequestEnvelope& Get();
+
+	/** request_id as condensed JSON ("7", "\"a1\""); empty when absent or not a string or number. */
+	static FString ReadRequestId(const TSharedPtr<FJsonObject>& Root);
+
+	/** Inserts FieldJson ("\"name\":value") as the first member of a JSON object response. */
+	static FString PrependField(const FString& ResponseJson, const FString& FieldJson);
+
+	/** The response with request_id first. Unchanged when RequestIdJson is empty. */
+	static FString StampRequestId(const FString& ResponseJson, const FString& RequestIdJson);
+
+	/** Undoes StampRequestId for the same id, so one coalesced result can be stamped per caller. */
+	static FString UnstampRequestId(const FString& ResponseJson, const FString& RequestIdJson);
+
+	/**
+	 * True when a command response reports failure: "error" or "ok": false
+	 * among its first fields. The one test behind metrics error counts,
+	 * idempotency storage, trace replay and worker farm results.
+	 */
+	static bool IsErrorResponse(const FString& ResponseJson);
+
+	/** Identifies one request body under an idempotency key. */
+	static uint32 HashBody(const FString& Cmd, const TSharedPtr<FJsonObject>& Args);
+
+	enum class ELookup : uint8
+	{
+		Miss,       // run the command
+		Replay,     // OutResponse holds the stored response, already marked as a replay
+		Conflict,   // the key was used for another body; OutResponse holds the error
+	};
+
+	ELookup Lookup(const FString& Key, uint32 BodyHash, FString& OutResponse);
+
+	/** Keeps a successful response under Key. Evicts expired keys, then the oldest. */
+	void Remember(const FString& Key, uint32 BodyHash, const FString& Response);
+
+	/** Stored keys, replays, conflicts and evictions for get_forge_status. */
+	TSharedPtr<FJsonObject> GetStatsJson() const;
+
+private:
+	struct FEntry
+	{
+		uint32  BodyHash = 0;
+		FString Response;
+		double  StoredSeconds = 0.0;
+	};
+
+	void Prune(double Now);
+
+	// Game-thread only.
+	// Keys are client tokens: "Abc" and "abc" are different keys.
+	TMap<FString, FEntry, FDefaultSetAllocator, TAgentForgeCaseSensitiveKeyFuncs<FEntry>> Entries;
+	TArray<FString>       Order;       // keys, oldest first
+	int64 Stored = 0;
+	int64 Replays = 0;
+	int64 Conflicts = 0;
+	int64 Evicted = 0;
+};
@@ -0,0 +1,88 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeResponseWriter — DOM-free response serialization for large payloads.
+//
+// Large observation commands (get_all_level_actors, get_level_hierarchy,
+// get_world_context) write their response field by field instead of building an
+// FJsonObject tree and serializing it through ToJsonString. The JSON backend is
+// a condensed TJsonWriter over a pre-reserved FString; the CBOR backend is an
+// FCborWriter over a byte buffer, negotiated per request with "encoding":"cbor".
+//
+// The command surface returns FString, so CBOR payloads travel as
+//   {"ok":true,"encoding":"cbor","bytes":N,"data":"<base64>"}
+// and clients decode data (RFC 8949, indefinite-length maps/arrays).
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"   // explicit with NoPCHs
+#include "Dom/JsonValue.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonWriter.h"
+
+enum class EAgentForgeResponseEncoding : uint8
+{
+	Json,
+	Cbor,
+};
+
+class UEAGENTFORGE_API FAgentForgeResponseWriter
+{
+public:
+	/** args.encoding: "json" (default) or "cbor". Unknown values fall back to JSON. */
+	static EAgentForgeResponseEncoding EncodingFromArgs(const TSharedPtr<FJsonObject>& Args);
+
+	/** ReserveHint: expected JSON length in characters (CBOR reserves about half). */
+	explicit FAgentForgeResponseWriter(EAgentForgeResponseEncoding InEncoding = EAgentForgeResponseEncoding::Json, int32 ReserveHint = 4096);
+	~FAgentForgeResponseWriter();
+
+	FAgentForgeResponseWriter(const FAgentForgeResponseWriter&) = delete;
+	FAgentForgeResponseWriter& operator=(const FAgentForgeResponseWriter&) = delete;
+
+	EAgentForgeResponseEncoding GetEncoding() const { return Encoding; }
+
+	// ─── Containers ─────────────────────────────────────────────────────────
+	void WriteObjectStart();
+	void WriteObjectStart(const FString& Name);
+	void WriteObjectEnd();
+	void WriteArrayStart();
+	void WriteArrayStart(const FString& Name);
+	void WriteArrayEnd();
+
+	// ─── Named fields (inside an object) ────────────────────────────────────
+	void WriteValue(const FString& Name, const FString& Value);
+	void WriteValue(const FString& Name, const TCHAR* Value);
+	void WriteValue(const FString& Name, double Value);
+	void WriteValue(const FString& Name, int32 Value);
+	void WriteValue(const FString& Name, int64 Value);
+	void WriteValue(const FString& Name, bool Value);
+	void WriteNull(const FString& Name);
+	/** {x, y, z} — same shape as VecToJson. */
+	void WriteVector(const FString& Name, const FVector& Value);
+	/** Embed an existing DOM sub-tree (small, already-built payloads). */
+	void WriteJsonValue(const FString& Name, const TSharedPtr<FJsonValue>& Value);
+	void WriteJsonObject(const FString& Name, const TSharedPtr<FJsonObject>& Value);
+
+	// ─── Array elements ─────────────────────────────────────────────────────
+	void WriteValue(const FString& Value);
+	void WriteValue(const TCHAR* Value);
+	void WriteValue(double Value);
+	void WriteValue(int32 Value);
+	void WriteValue(bool Value);
+
+	/** Close the writer and return the response string (JSON text or the CBOR envelope). Call once. */
+	FString Finish();
+
+private:
+	using FJsonTextWriter = TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>;
+
+	void WriteKey(const FString& Name);
+	void WriteCborJsonValue(const TSharedPtr<FJsonValue>& Value);
+
+	struct FCborState;   // FMemoryWriter + FCborWriter, kept out of the header
+
+	EAgentForgeResponseEncoding   Encoding;
+	FString                       Text;
+	TSharedPtr<FJsonTextWriter>   Json;
+	TUniquePtr<FCborState>        Cbor;
+	bool                          bFinished = false;
+};
@@ -0,0 +1,171 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeRuntimeCost — predicted runtime cost of pipeline lights, particles and audio.
+//
+// The Phase IV and V helpers placed lights, emitters and audio by aesthetic
+// rules only, so a generated level could carry dozens of overlapping
+// shadow-casting lights and stacked translucent emitters. Three costs are
+// estimated from what is in the world:
+//
+//   shadow overlap  shadow-casting, non-static local lights whose attenuation
+//                   spheres intersect one such light's, that light included.
+//                   Static lights are baked; the directional key is level-wide.
+//   overdraw        summed emitter weights (by effect name) within
+//                   OverdrawRadius of one emitter, that emitter included.
+//   audio voices    audio emitters whose audible bounds (extent plus
+//                   AudibleMargin) intersect one emitter's, that one included.
+//
+// Each is reported as the peak over its sources. Budgets come from the active
+// FLevelPreset, capped by the operator policy (set_operator_policy
+// max_shadow_light_overlap / max_particle_overdraw / max_audio_voices).
+//
+// FPlanner enforces them while placing, seeded with what the world already
+// holds. A light within MergeFraction of its radius from an existing point
+// light is merged into it; one that would push any overlap past the budget is
+// downgraded to stationary without shadows; one that would still exceed twice
+// the budget unshadowed is culled. Emitters past the overdraw budget are
+// culled. Audio past the voice budget is merged into the nearest emitter it
+// overlaps, whose bounds grow to cover both.
+//
+// Game thread only.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"   // explicit with NoPCHs
+#include "UObject/WeakObjectPtr.h"
+
+class AActor;
+class UWorld;
+struct FLevelPreset;
+
+class UEAGENTFORGE_API FAgentForgeRuntimeCost
+{
+public:
+	/** Emitters closer than this draw over the same screen area. */
+	static constexpr float OverdrawRadius = 600.0f;
+
+	/** Audible distance beyond an audio emitter's bounds. */
+	static constexpr float AudibleMargin = 1000.0f;
+
+	/** A light this close to a point light (fraction of the larger radius) merges into it. */
+	static constexpr float MergeFraction = 0.25f;
+
+	struct FBudget
+	{
+		int32 MaxShadowLightOverlap = 4;
+		float MaxParticleOverdraw   = 4.0f;
+		int32 MaxAudioVoices        = 16;
+
+		TSharedPtr<FJsonObject> ToJson() const;
+	};
+
+	struct FEstimate
+	{
+		int32   ShadowLights = 0;
+		int32   ShadowOverlapPeak = 0;
+		int32   Emitters = 0;
+		float   OverdrawPeak = 0.0f;
+		int32   AudioEmitters = 0;
+		int32   AudioVoicesPeak = 0;
+		FBudget Budget;
+
+		bool WithinBudget() const;
+		TSharedPtr<FJsonObject> ToJson() const;
+	};
+
+	/** What placement did to stay within budget. */
+	struct FActions
+	{
+		int32 LightsDowngraded = 0;
+		int32 LightsMerged = 0;
+		int32 LightsCulled = 0;
+		int32 EmittersCulled = 0;
+		int32 AudioMerged = 0;
+		int32 AudioCulled = 0;
+
+		/** Adds lights_downgraded, lights_merged, lights_culled, vfx_culled, audio_merged, audio_culled. */
+		void WriteTo(const TSharedPtr<FJsonObject>& Obj) const;
+	};
+
+	enum class EPlacement : uint8
+	{
+		Place,       // as requested
+		Downgrade,   // stationary, no shadows
+		Merge,       // fold into OutMergeInto instead of spawning
+		Cull,        // do not spawn
+	};
+
+	/** Budget admission for one placement pass. Accepted sources count against later ones. */
+	class UEAGENTFORGE_API FPlanner
+	{
+	public:
+		FPlanner(UWorld* World, const FBudget& InBudget);
+
+		/** Shadow-casting local light at Location. Merge sets OutMergeInto (only when bAllowMerge). */
+		EPlacement AddLight(const FVector& Location, float Radius, bool bAllowMerge, AActor*& OutMergeInto);
+
+		/** Emitter of Effect ("dust", "steam", ...) at Location. False: culled. */
+		bool AddEmitter(const FVector& Location, const FString& Effect);
+
+		/** Audio emitter over Bounds. Merge sets OutMergeInto and the bounds it should now cover. */
+		EPlacement AddAudio(const FBox& Bounds, AActor*& OutMergeInto, FBox& OutMergedBounds);
+
+		/** Actor spawned for the last Place / Downgrade result, so later sources can merge into it. */
+		void BindLast(AActor* Actor);
+
+		FEstimate GetEstimate() const;
+
+	private:
+		struct FLightSource
+		{
+			FVector Location = FVector::ZeroVector;
+			float   Radius = 0.0f;
+			bool    bShadowed = false;
+			bool    bMergeable = false;
+			int32   ShadowNeighbours = 0;   // shadowed sources intersecting this one
+			int32   Neighbours = 0;         // all sources intersecting this one
+			TWeakObjectPtr<AActor> Actor;
+		};
+		struct FEmitterSource
+		{
+			FVector Location = FVector::ZeroVector;
+			float   Weight = 1.0f;
+			float   Overdraw = 0.0f;        // summed weights within OverdrawRadius, own included
+		};
+		struct FAudioSource
+		{
+			FBox  Audible = FBox(ForceInit);   // bounds expanded by AudibleMargin
+			int32 Voices = 1;                  // own voice plus intersecting sources
+			TWeakObjectPtr<AActor> Actor;
+		};
+
+		void PushLight(const FVector& Location, float Radius, bool bShadowed, bool bMergeable, AActor* Actor);
+		void PushEmitter(const FVector& Location, float Weight);
+		void PushAudio(const FBox& Bounds, AActor* Actor);
+
+		FBudget                Budget;
+		TArray<FLightSource>   Lights;
+		TArray<FEmitterSource> Emitters;
+		TArray<FAudioSource>   Audio;
+		enum class ELast : uint8 { None, Light, Audio } Last = ELast::None;
+	};
+
+	static FAgentForgeRuntimeCost& Get();
+
+	/** Preset budgets, each capped by the operator policy. */
+	FBudget GetBudget(const FLevelPreset& Preset) const;
+
+	/** Operator policy caps (get/set_operator_policy). */
+	const FBudget& GetPolicyCaps() const { return PolicyCaps; }
+	void SetPolicyCaps(const FBudget& Caps) { PolicyCaps = Caps; }
+
+	/** Predicted cost of what World holds now. */
+	static FEstimate Estimate(UWorld* World, const FBudget& Budget);
+
+	/** Translucent layers one emitter of Effect adds. */
+	static float GetEmitterWeight(const FString& Effect);
+
+private:
+	// Stationary lights share four shadow channels, hence the light cap.
+	FBudget PolicyCaps = { 4, 8.0f, 32 };
+};
@@ -0,0 +1,113 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeSocketServer — optional persistent WebSocket transport for the bridge.
+//
+// Speaks the same {cmd,args} protocol as ExecuteCommandJson over one long-lived
+// connection, without the Remote Control envelope (no JSON-in-a-JSON-string,
+// no per-call HTTP request). Built on the engine's WebSocketNetworking plugin.
+//
+//   client → server   {"id": 7, "cmd": "get_current_level", "args": {}}
+//   server → client   {"type":"response", "id": 7, "result": {...}}
+//   server → client   {"type":"event", "event":"job_progress", "job_id":"job_2", "data": {...}}
+//
+// Responses carry the caller's id and may arrive in any order relative to
+// events and to other connections' traffic; clients match on id. Async jobs
+// submitted over a connection push job_progress / job_finished events to that
+// connection. "subscribe" / "unsubscribe" (args: events[]) opt a connection
+// into events from every client. Commands run on the game thread, drained once
+// per frame within the command-queue frame budget. A client may pipeline many
+// requests; identical pure queries in one drain share a result, as they do in
+// the command queue.
+//
+// Off by default. Start with start_socket_server or -AgentForgeSocketPort=N.
+// Binds to 127.0.0.1 unless told otherwise — there is no authentication.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Dom/JsonObject.h"   // explicit with NoPCHs
+
+class FAgentForgeJob;
+class INetworkingWebSocket;
+class IWebSocketServer;
+
+class UEAGENTFORGE_API FAgentForgeSocketServer
+{
+public:
+	static FAgentForgeSocketServer& Get();
+
+	static constexpr int32 DefaultPort = 30020;
+	static constexpr int32 MaxPendingRequests = 4096;
+
+	/** Begin listening. Game thread. Returns false with OutError if the port could not be bound. */
+	bool Start(int32 Port, const FString& BindAddress, FString& OutError);
+
+	/** Close every connection and stop listening. Deferred to the next tick while a request is executing. */
+	void Stop();
+
+	bool  IsRunning() const { return Server.IsValid(); }
+	int32 GetPort() const   { return ListenPort; }
+
+	/**
+	 * Push an event. Delivered to the connection whose request is currently
+	 * executing (tagged with its request id) and to every connection subscribed
+	 * to EventName. No-op when the server is not running.
+	 */
+	void PushEvent(const FString& EventName, const TSharedPtr<FJsonObject>& Data);
+
+	/** Same, for work that outlives its request: delivered to the connection that submitted JobId (tagged with the job id). */
+	void PushJobEvent(const FString& JobId, const FString& EventName, const TSharedPtr<FJsonObject>& Data);
+
+	TSharedPtr<FJsonObject> GetStatusJson() const;
+
+private:
+	struct FConnection
+	{
+		int32                            Id = 0;
+		TUniquePtr<INetworkingWebSocket> Socket;
+		FString                          RemoteEndPoint;
+		TSet<FString>                    Subscriptions;   // "*" = everything
+		bool                             bClosed = false;
+	};
+
+	struct FPendingRequest
+	{
+		int32   ConnectionId = 0;
+		FString IdJson;       // Serialized "id" value, spliced back verbatim ("null" when absent)
+		FString Message;      // Original {id,cmd,args} text; ExecuteCommandJson ignores "id"
+		TSharedPtr<FJsonObject> Root;    // Message, parsed once in HandleMessage
+		double  ParseMs = 0.0;
+		double  ReceivedSeconds = 0.0;   // reported as queue_wait_ms by "profile": true
+	};
+
+	bool Tick(float DeltaTime);
+	void StopNow();
+	void HandleClientConnected(INetworkingWebSocket* Socket);
+	void HandleMessage(int32 ConnectionId, const FString& Message);
+	void HandleSubscription(FConnection& Connection, const FString& IdJson, const TSharedPtr<FJsonObject>& Args, bool bSubscribe);
+	void HandleJobEvent(const FAgentForgeJob& Job, bool bFinished);
+	void SendResponse(int32 ConnectionId, const FString& IdJson, const FString& ResultJson);
+	void SendEvent(int32 ConnectionId, const FString& EventName, const FString& Extra, const FString& DataJson);
+	bool SendText(FConnection& Connection, const FString& Text);
+	FConnection* FindConnection(int32 ConnectionId);
+
+	TUniquePtr<IWebSocketServer>   Server;
+	TArray<TUniquePtr<FConnection>> Connections;
+	TArray<FPendingRequest>        Pending;
+	TMap<FString, int32>           JobOwners;           // job_id → connection that submitted it
+	TMap<FString, double>          JobLastProgressSent; // throttles job_progress per job
+	FTSTicker::FDelegateHandle     TickHandle;
+	FDelegateHandle                JobEventHandle;
+	FString                        BindAddress;
+	int32                          ListenPort = 0;
+	int32                          NextConnectionId = 1;
+	int32                          CurrentConnectionId = 0;
+	FString                        CurrentRequestIdJson;
+	bool                           bStopRequested = false;
+
+	int64  MessagesReceived = 0;
+	int64  ResponsesSent = 0;
+	int64  EventsSent = 0;
+	int64  RequestsRejected = 0;
+	int64  RequestsCoalesced = 0;
+};
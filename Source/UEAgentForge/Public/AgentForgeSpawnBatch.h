@@ -0,0 +1,81 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeSpawnBatch — deferred-construction actor spawning for the geometry builders.
+//
+// create_room, create_corridor, create_wall, create_staircase and the blockout
+// pipeline spawn dozens of cube actors per call. Spawned one at a time with
+// SpawnActor, each actor registers its components, and then SetStaticMesh,
+// SetMaterial and SetActorScale3D re-register render and physics state. On
+// top of that every spawn calls Modify on the world and level, the level
+// bounds actor recomputes, and each attach re-parents in the outliner.
+//
+// Spawns made while a batch is open instead:
+//
+//   spawn deferred (bDeferConstruction) -> set mesh, material, mobility,
+//   scale and label -> FinishSpawning
+//
+// so components register once, already in their final state. The world and
+// level are modified once per batch, level bounds auto-update is suspended
+// until the batch ends, and attachments are queued and applied in one sweep,
+// followed by a single viewport redraw.
+//
+// Batches nest: an inner batch joins the outermost one, which flushes. The
+// static spawn helpers work without an open batch and then flush at once.
+//
+// Editor, game thread only.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"   // explicit with NoPCHs
+#include "Engine/EngineTypes.h"
+
+class AActor;
+class ALevelBounds;
+class AStaticMeshActor;
+class UMaterialInterface;
+class UStaticMesh;
+class UWorld;
+
+struct FAgentForgeStaticMeshSpawn
+{
+	UStaticMesh*        Mesh = nullptr;
+	UMaterialInterface* Material = nullptr;   // null keeps the mesh material
+	FTransform          Transform;            // world space, including scale
+	FString             Label;
+	FName               CollisionProfile;     // None keeps the component default
+	ESpawnActorCollisionHandlingMethod Collision = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+};
+
+class UEAGENTFORGE_API FAgentForgeSpawnBatch : public FNoncopyable
+{
+public:
+	explicit FAgentForgeSpawnBatch(UWorld* InWorld);
+	~FAgentForgeSpawnBatch();
+
+	/** The outermost open batch, or null. */
+	static FAgentForgeSpawnBatch* GetActive();
+
+	/** Static AStaticMeshActor: mesh, material, scale and label applied before FinishSpawning. */
+	static AStaticMeshActor* SpawnStaticMeshActor(UWorld* World, const FAgentForgeStaticMeshSpawn& Spawn, FString& OutError);
+
+	/** Plain AActor with a static scene root, for grouping builder output. */
+	static AActor* SpawnGroupActor(UWorld* World, const FVector& Location, const FString& Label, FString& OutError);
+
+	/** KeepWorldTransform attach; queued until the active batch ends, immediate otherwise. */
+	static bool Attach(AActor* Child, AActor* Parent);
+
+	/** batches, actors_spawned, attachments, last_batch_actors, last_batch_ms. */
+	static TSharedPtr<FJsonObject> GetStatsJson();
+
+private:
+	void PrepareWorld();
+	void Flush();
+
+	TWeakObjectPtr<UWorld> World;
+	FAgentForgeSpawnBatch* Outer = nullptr;
+	bool bWorldPrepared = false;
+	TWeakObjectPtr<ALevelBounds> SuspendedBounds;
+	TArray<TPair<TWeakObjectPtr<AActor>, TWeakObjectPtr<AActor>>> PendingAttachments;
+	int32 ActorsSpawned = 0;
+	double StartSeconds = 0.0;
+};
@@ -0,0 +1,21 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeStringKeys — case-sensitive FString map keys.
+//
+// TMap<FString, ...> hashes and compares keys ignoring case. That is wrong
+// for keys that are client data rather than names: actor labels, idempotency
+// keys, and coalesce keys built from request args. "Wall" and "wall" there
+// are different keys.
+//
+//   TMap<FString, V, FDefaultSetAllocator, TAgentForgeCaseSensitiveKeyFuncs<V>>
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/Crc.h"
+
+template <typename ValueType>
+struct TAgentForgeCaseSensitiveKeyFuncs : TDefaultMapKeyFuncs<FString, ValueType, false>
+{
+	static FORCEINLINE bool Matches(const FString& A, const FString& B) { return A.Equals(B, ESearchCase::CaseSensitive); }
+	static FORCEINLINE uint32 GetKeyHash(const FString& Key) { return FCrc::StrCrc32(*Key); }
+};
@@ -0,0 +1,99 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeSurfaceTrace — batched downward surface queries.
+//
+// Slope filtering, scatter snapping and align-to-surface all need "what is
+// directly below this XY" for many points at once. Tracing one point at a
+// time on the game thread stalls the editor for tens of thousands of points,
+// so TraceDown takes the whole batch:
+//
+//   Physics    Line traces fanned out over worker threads with ParallelFor.
+//              Scene queries only take the physics scene read lock, which is
+//              what AsyncLineTraceByChannel's task-graph workers do too, but
+//              the results are available on return instead of next frame —
+//              commands run synchronously and cannot wait for a tick.
+//   Landscape  Samples landscape collision heightfields directly (height plus
+//              a central-difference normal), no ray casts. Points outside
+//              every landscape, or whose height is outside the trace window,
+//              fall back to a physics trace. Meshes standing on the landscape
+//              are not seen, so this is opt-in.
+//
+// TraceSegments runs the same fan-out for arbitrary start / end pairs
+// (line-of-sight and occlusion tests); it is always a physics trace.
+//
+// Results are written by input index, so output order never depends on
+// scheduling.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CollisionQueryParams.h"
+#include "Dom/JsonObject.h"   // explicit with NoPCHs
+#include "Engine/EngineTypes.h"
+
+class UWorld;
+
+enum class ESurfaceTraceSource : uint8
+{
+	Physics,
+	Landscape,
+};
+
+struct FSurfaceTraceSettings
+{
+	float UpExtent = 10000.0f;     // trace starts this far above each point
+	float DownExtent = 10000.0f;   // and ends this far below it
+	ECollisionChannel Channel = ECC_Visibility;
+	ESurfaceTraceSource Source = ESurfaceTraceSource::Physics;
+};
+
+struct FSurfaceSample
+{
+	FVector   Location = FVector::ZeroVector;
+	FVector3f Normal = FVector3f::UpVector;
+	TWeakObjectPtr<AActor> Actor;   // physics hits only
+	bool bHit = false;
+};
+
+class UEAGENTFORGE_API FAgentForgeSurfaceTrace
+{
+public:
+	static FAgentForgeSurfaceTrace& Get();
+
+	/** Batches smaller than this are traced on the calling thread. */
+	static constexpr int32 MinParallelBatch = 64;
+
+	/** "physics" | "landscape", case-insensitive. */
+	static bool ParseSource(const FString& Name, ESurfaceTraceSource& OutSource);
+	static const TCHAR* SourceName(ESurfaceTraceSource Source);
+
+	/** One sample per point, same order. Must be called on the game thread. */
+	void TraceDown(
+		UWorld* World,
+		TArrayView<const FVector> Points,
+		const FSurfaceTraceSettings& Settings,
+		const FCollisionQueryParams& Params,
+		TArray<FSurfaceSample>& OutSamples);
+
+	/** First blocking hit from Starts[i] to Ends[i], same order; the arrays must match in length. Game thread. */
+	void TraceSegments(
+		UWorld* World,
+		TArrayView<const FVector> Starts,
+		TArrayView<const FVector> Ends,
+		ECollisionChannel Channel,
+		const FCollisionQueryParams& Params,
+		TArray<FSurfaceSample>& OutSamples);
+
+	/** Batch / point / sample counters for diagnostics. */
+	TSharedPtr<FJsonObject> GetStatsJson() const;
+
+private:
+	// Updated on the game thread after each batch.
+	int64  Batches = 0;
+	int64  PointsTraced = 0;
+	int64  LandscapeSamples = 0;
+	int64  PhysicsTraces = 0;
+	int64  Segments = 0;
+	int64  Hits = 0;
+	double TotalMs = 0.0;
+	double LastBatchMs = 0.0;
+};
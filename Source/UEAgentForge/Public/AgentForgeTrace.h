@@ -0,0 +1,36 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeTrace — Unreal Insights scopes for the bridge and its modules.
+//
+// Every command dispatched by ExecuteCommandJson, every job slice and stage,
+// and the entry points of the pipeline, procedural operator, verification,
+// LLM provider and distribution modules open a CPU trace scope on the
+// AgentForge channel. Scopes are recorded when both the cpu and AgentForge
+// channels are enabled, e.g.
+//
+//   UnrealEditor.exe MyProject -trace=cpu,AgentForge
+//
+// or "Trace.Enable AgentForge" at runtime. Static scopes are named
+// "AgentForge.<Module>.<Function>"; command and job scopes use the command /
+// stage name. With tracing compiled out (UE_TRACE_ENABLED 0) the trace half
+// of the macros is empty.
+//
+// AGENTFORGE_TRACE_SCOPE also opens a stage on the active command profile
+// (args.profile, see AgentForgeCommandProfile.h), so every traced entry point
+// shows up in the response "timings" without a second annotation.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AgentForgeCommandProfile.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Trace/Trace.h"
+
+UE_TRACE_CHANNEL_EXTERN(AgentForgeChannel, UEAGENTFORGE_API);
+
+/** Scope with a literal name: AGENTFORGE_TRACE_SCOPE("AgentForge.Pipeline.CreateBlockoutLevel"). Also a profile stage. */
+#define AGENTFORGE_TRACE_SCOPE(NameStr) \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR(NameStr, AgentForgeChannel); \
+	FAgentForgeCommandProfile::FStageScope PREPROCESSOR_JOIN(AgentForgeProfileStage_, __LINE__)(TEXT(NameStr))
+
+/** Scope with a runtime name (const TCHAR*), e.g. the command being dispatched. */
+#define AGENTFORGE_TRACE_SCOPE_TEXT(Name) TRACE_CPUPROFILER_EVENT_SCOPE_TEXT_ON_CHANNEL(Name, AgentForgeChannel)
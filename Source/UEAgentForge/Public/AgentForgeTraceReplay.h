@@ -0,0 +1,67 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeTraceReplay — replays a recorded command trace and diffs it.
+//
+// One session of an .aftrace file (AgentForgeCommandTrace.h) is replayed in
+// order through ExecuteCommandJson against its recorded map, loaded fresh.
+// Async submissions are driven to completion before the next request, so
+// commands that follow a job see its result. For every call:
+//
+//   latency     replay wall time against the recorded parse + handler time
+//   divergence  the replay response against the recorded one: identical CRC,
+//               else both are canonicalized (keys sorted, numbers to 6
+//               significant digits, volatile keys dropped) and compared.
+//               A changed error status is always a divergence.
+//
+// Volatile keys: "timings", "job_id", anything ending in _ms, _seconds or
+// _utc, anything containing "revision", plus Settings.IgnoreKeys. Responses
+// that are session state by nature (job status, metrics, forge status) and
+// recorded responses cut at max_response_chars are checked for status only
+// and counted as unchecked.
+//
+// Per command the report keeps call count, recorded and replay median ms,
+// their ratio and the divergence count. A command regresses when its replay
+// median exceeds the recorded one by Tolerance and by at least MinDeltaMs.
+// Repeats > 1 reloads the map before every pass and takes each call's median
+// over the passes; divergence is checked on the first pass only.
+//
+// Revisions are per editor process. A request's args.since_revision is
+// rewritten to the replay revision observed after the recorded call that
+// ended on that revision (or at session start), so delta queries ask for the
+// same changes they asked for when recorded.
+//
+// Reports go to Saved/AgentForgeTraces/Replays/ as JSON and CSV, stamped with
+// the plugin and engine version like the benchmark reports. Entry point:
+// the AgentForgeReplayTrace commandlet.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"   // explicit with NoPCHs
+
+struct UEAGENTFORGE_API FTraceReplaySettings
+{
+	FString TracePath;
+	int32   Session = -1;               // index into the file's sessions; < 0 counts from the end
+	FString Map;                        // empty = the session's map; "none" = keep the current level
+	int32   Repeats = 1;
+	double  Tolerance = 0.25;
+	double  MinDeltaMs = 2.0;
+	double  JobTimeoutSeconds = 600.0;
+	int32   MaxListedDivergences = 50;
+	TSet<FString> Skip;                 // commands not replayed
+	TSet<FString> IgnoreKeys;           // response keys left out of the comparison
+	FString OutputDir;                  // empty = Saved/AgentForgeTraces/Replays
+	FString Label;
+};
+
+class UEAGENTFORGE_API FAgentForgeTraceReplay
+{
+public:
+	/** Replays and writes the report. False with OutError when the trace or map cannot be loaded. */
+	static bool Run(const FTraceReplaySettings& Settings, TSharedPtr<FJsonObject>& OutReport, FString& OutError);
+
+	/** Canonical text of a response for the divergence check (see above). Unparsable text is returned as is. */
+	static FString CanonicalizeResponse(const FString& ResponseJson, const TSet<FString>& IgnoreKeys);
+
+	static FString GetDefaultOutputDir();
+};
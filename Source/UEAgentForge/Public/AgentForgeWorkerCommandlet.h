@@ -0,0 +1,29 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeWorkerCommandlet — headless farm worker for procedural compute.
+//
+//   UnrealEditor-Cmd <Project>.uproject -run=AgentForgeWorker
+//       [-spool=<dir>] [-worker=<id>] [-poll=0.5] [-idle_exit=0] [-max_jobs=0]
+//
+// Claims jobs from the spool written by farm_precompute, runs each against
+// its map and writes back the cache entries it produced
+// (AgentForgeWorkerFarm.h). Start one per farm node, or several on a large
+// machine. -spool defaults to -AgentForgeFarmSpool= or Saved/AgentForgeFarm;
+// -idle_exit=<seconds> stops after that long without a job. Returns 0 when
+// no job failed.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "AgentForgeWorkerCommandlet.generated.h"
+
+UCLASS()
+class UEAGENTFORGE_API UAgentForgeWorkerCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UAgentForgeWorkerCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,139 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeWorkerFarm — procedural compute on headless worker processes.
+//
+// Terrain, distribution point clouds, their quality metrics and graph room
+// layouts are pure functions of their inputs and already land in the
+// procedural cache under content keys. A worker farm therefore only has to
+// fill that cache: the editor submits the exact commands it is about to run,
+// headless workers (the AgentForgeWorker commandlet, one per core group or
+// farm node) run them and ship back every cache entry the run produced, and
+// the editor imports the entries. When the editor then runs the same commands
+// each compute phase is a cache hit and only the commit is left.
+//
+// Transport is a spool directory, local or on a share every node can reach:
+//
+//   jobs/<id>.json               one command; a worker claims it by renaming
+//                                it to claimed/ (first rename wins)
+//   claimed/<id>.<worker>.json   in progress
+//   results/<id>.afres           binary result, written as .tmp and renamed
+//   workers/<worker>.json        heartbeat, rewritten every HeartbeatSeconds
+//
+// A result holds a JSON header (status, worker, timings) and the entries as
+// zlib blocks: procedural cache entries by kind and key, and the files of a
+// tiled terrain's tile directory (TileFileKind), which the editor writes into
+// its own tile cache with the manifest last.
+//
+// Workers load the job's map from their own copy of the project before every
+// job and run the command there, commit included, so a scatter sees the
+// terrain an earlier pipeline stage made. Their level is never saved. Keys
+// cover the target bounds, so a worker that loaded a different version of the
+// map produces entries the editor simply never hits; save the level before
+// submitting. A job from another plugin version is failed, not run.
+//
+// Claims of a worker whose heartbeat is older than StaleWorkerSeconds are put
+// back into jobs/ by the editor, so a crashed node only delays its job.
+//
+// Editor side: game thread only. Worker side: RunWorker, from the commandlet.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AgentForgeProceduralCache.h"
+#include "Dom/JsonObject.h"   // explicit with NoPCHs
+
+class FAgentForgeJob;
+
+/** One command for the farm. */
+struct UEAGENTFORGE_API FFarmJobSpec
+{
+	FString Cmd;
+	TSharedPtr<FJsonObject> Args;
+};
+
+struct UEAGENTFORGE_API FFarmWorkerSettings
+{
+	FString Spool;                      // empty = FAgentForgeWorkerFarm::GetDefaultSpool()
+	FString WorkerId;                   // empty = <computer>-<pid>
+	double  PollSeconds = 0.5;
+	double  IdleExitSeconds = 0.0;      // 0 = wait for jobs until the process is stopped
+	int32   MaxJobs = 0;                // 0 = unlimited
+};
+
+class UEAGENTFORGE_API FAgentForgeWorkerFarm
+{
+public:
+	static FAgentForgeWorkerFarm& Get();
+
+	static constexpr double HeartbeatSeconds = 5.0;
+	static constexpr double StaleWorkerSeconds = 120.0;
+	static constexpr double CollectIntervalSeconds = 0.5;
+
+	/** Result entry kind for a file of a tiled terrain; its key is "<tile dir>/<file>". */
+	static const TCHAR* const TileFileKind;
+
+	/** -AgentForgeFarmSpool=<dir> when given, else Saved/AgentForgeFarm. */
+	static FString GetDefaultSpool();
+
+	/** The commands a worker runs: the op_* compute operators, run_operator_pipeline, create_blockout_level. */
+	static bool IsFarmable(const FString& Cmd);
+
+	// ── Editor side ─────────────────────────────────────────────────────────
+
+	/** Writes one job file per spec into Spool/jobs. OutJobIds follows Jobs. */
+	bool Submit(const FString& Spool, const FString& Map, const TArray<FFarmJobSpec>& Jobs, TArray<FString>& OutJobIds, FString& OutError);
+
+	/**
+	 * Imports the results of this session's jobs found in Spool/results
+	 * (ImportMode Disk also writes the disk tier) and requeues stale claims.
+	 * Returns the number of jobs finished by this call.
+	 */
+	int32 Collect(const FString& Spool, EProceduralCacheMode ImportMode);
+
+	/** True once the job's result was imported (or failed). Unknown ids count as finished. */
+	bool IsFinished(const FString& JobId) const;
+
+	/** Deletes the job file of every listed job no worker has claimed yet. */
+	void Withdraw(const TArray<FString>& JobIds);
+
+	/** job_id, cmd, status (queued|done|failed), worker, compute_ms, entries, raw / packed bytes, error. */
+	TSharedPtr<FJsonObject> GetJobJson(const FString& JobId) const;
+
+	/** Queue, claim and result counts plus the heartbeat of every worker in Spool. */
+	static TSharedPtr<FJsonObject> GetSpoolJson(const FString& Spool);
+
+	/** farm_precompute: submit, wait for the results, import them. */
+	static TSharedRef<FAgentForgeJob> MakePrecomputeJob(const TSharedPtr<FJsonObject>& Args);
+
+	/** Session counters for get_forge_status. */
+	TSharedPtr<FJsonObject> GetStatsJson() const;
+
+	// ── Worker side ─────────────────────────────────────────────────────────
+
+	/** Claims and runs jobs until idle, MaxJobs or engine exit. Returns the number of failed jobs. */
+	static int32 RunWorker(const FFarmWorkerSettings& Settings);
+
+private:
+	struct FTrackedJob
+	{
+		FString Cmd;
+		FString Spool;
+		FString Status = TEXT("queued");
+		FString Worker;
+		FString Error;
+		double  ComputeMs = 0.0;
+		int32   Entries = 0;
+		int64   RawBytes = 0;
+		int64   PackedBytes = 0;
+	};
+
+	void RequeueStaleClaims(const FString& Spool);
+
+	// Game-thread only.
+	TMap<FString, FTrackedJob> Tracked;
+	int64 Submitted = 0;
+	int64 Completed = 0;
+	int64 Failed = 0;
+	int64 Requeued = 0;
+	int64 ImportedEntries = 0;
+	int64 ImportedBytes = 0;
+};
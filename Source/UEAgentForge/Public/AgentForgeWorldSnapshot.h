@@ -0,0 +1,133 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeWorldSnapshot — compact binary level snapshots and hash-based diffs.
+//
+// Replaces the per-actor FJsonObject snapshots written by
+// UVerificationEngine::CreateSnapshot. A snapshot is
+//
+//   String table   labels, class names and actor paths, each stored once
+//   Actor records  string indices, a packed transform (double location,
+//                  float rotation and scale) and a 64-bit content hash
+//
+// serialized as Saved/AgentForgeSnapshots/<name>_<timestamp>.afsnap. The hash
+// covers label, class and transform, so a diff resolves every actor with one
+// path lookup and compares hashes instead of fields.
+//
+// Capture runs on the game thread. Writing runs on the thread pool; until a
+// write lands, Load serves the in-memory copy, so a snapshot can be diffed
+// right after it is taken. JSON export of the same data is opt-in, and Load
+// still reads JSON snapshots from older versions.
+//
+// Thread-safe.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"   // explicit with NoPCHs
+#include "HAL/CriticalSection.h"
+
+class UWorld;
+
+struct UEAGENTFORGE_API FAgentForgeWorldSnapshot
+{
+	static constexpr uint32 FileMagic   = 0x4E534641;   // "AFSN"
+	static constexpr uint32 FileVersion = 1;
+
+	struct FTransformData
+	{
+		FVector    Location = FVector::ZeroVector;
+		FRotator3f Rotation = FRotator3f::ZeroRotator;
+		FVector3f  Scale    = FVector3f::OneVector;
+	};
+
+	struct FActorRecord
+	{
+		int32          PathIndex  = INDEX_NONE;
+		int32          LabelIndex = INDEX_NONE;
+		int32          ClassIndex = INDEX_NONE;
+		FTransformData Transform;
+		uint64         Hash = 0;
+	};
+
+	/** Indices into the snapshots being compared. */
+	struct FDiff
+	{
+		TArray<int32> Added;     // into B
+		TArray<int32> Removed;   // into A
+		TArray<int32> Changed;   // into B: same path, different hash
+
+		bool IsEmpty() const { return Added.IsEmpty() && Removed.IsEmpty() && Changed.IsEmpty(); }
+	};
+
+	FString   Name;
+	FDateTime Timestamp;
+	TArray<FString>      Strings;
+	TArray<FActorRecord> Actors;
+
+	/** Every valid actor in World. Game thread only. */
+	static FAgentForgeWorldSnapshot Capture(UWorld* World, const FString& SnapshotName);
+
+	/**
+	 * O(A + B) for distinct keys: actors are matched by path (label when a
+	 * snapshot has no paths) through one case-sensitive hash map. Records
+	 * sharing a key pair up one to one; surplus ones are added or removed.
+	 */
+	static FDiff Diff(const FAgentForgeWorldSnapshot& A, const FAgentForgeWorldSnapshot& B);
+
+	const FString& GetPath(const FActorRecord& Actor) const  { return GetString(Actor.PathIndex); }
+	const FString& GetLabel(const FActorRecord& Actor) const { return GetString(Actor.LabelIndex); }
+	const FString& GetClass(const FActorRecord& Actor) const { return GetString(Actor.ClassIndex); }
+
+	void Serialize(FArchive& Ar);
+	TArray<uint8> ToBytes() const;
+	bool FromBytes(const TArray<uint8>& Bytes, FString* OutError = nullptr);
+
+	/** The layout of the original JSON snapshots, plus "scale" and "hash". */
+	TSharedPtr<FJsonObject> ToJson() const;
+	bool FromJson(const TSharedPtr<FJsonObject>& Root, FString* OutError = nullptr);
+
+private:
+	const FString& GetString(int32 Index) const;
+	static uint64 HashActor(const FString& Label, const FString& Class, const FTransformData& Transform);
+};
+
+using FAgentForgeWorldSnapshotPtr = TSharedPtr<const FAgentForgeWorldSnapshot, ESPMode::ThreadSafe>;
+
+/**
+ * Writes snapshots in the background and reads them back by path (.afsnap or
+ * legacy .json).
+ */
+class UEAGENTFORGE_API FAgentForgeSnapshotStore
+{
+public:
+	static FAgentForgeSnapshotStore& Get();
+
+	/** Saved/AgentForgeSnapshots */
+	static FString GetDirectory();
+
+	/**
+	 * Queues Snapshot for writing and returns its .afsnap path right away.
+	 * bExportJson also writes the JSON form next to it (OutJsonPath).
+	 */
+	FString Write(FAgentForgeWorldSnapshotPtr Snapshot, bool bExportJson = false, FString* OutJsonPath = nullptr);
+
+	/** A snapshot still being written is returned from memory. Null with OutError on failure. */
+	FAgentForgeWorldSnapshotPtr Load(const FString& Path, FString* OutError = nullptr);
+
+	/** Blocks until every queued write has finished. */
+	void Flush();
+
+	/** written, pending, write_errors, bytes_written, last_write_ms, json_exports. */
+	TSharedPtr<FJsonObject> GetStatsJson() const;
+
+private:
+	void FinishWrite(const FString& Path, const FAgentForgeWorldSnapshotPtr& Snapshot, bool bSucceeded, int64 Bytes, double Seconds, bool bJson);
+
+	mutable FCriticalSection Lock;
+	TMap<FString, FAgentForgeWorldSnapshotPtr> Pending;   // by full path
+	int32  PendingWrites = 0;
+	int64  Written = 0;
+	int64  WriteErrors = 0;
+	int64  BytesWritten = 0;
+	int64  JsonExports = 0;
+	double LastWriteSeconds = 0.0;
+};
@@ -0,0 +1,136 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeWorldStats — one-pass, revision-cached world statistics.
+//
+// The quality scoring, lighting analysis, composition analysis, perf stats
+// and verification actor counts each walked the whole world with
+// TActorIterator, several times per quality-loop iteration of
+// generate_full_quality_level. They now read one shared FStats:
+//
+//   counts       actors, components and the class categories each caller
+//                tested (composition buckets, point lights, player starts,
+//                nav mesh volumes, "Prop_" meshes, sky lights)
+//   light lists  ALight, fog and "Prop_Instances_" actors, read live when the
+//                stats are composed, so intensity / density / instance edits
+//                never go stale
+//   bounds       the actor index's cached level bounds (editor world only)
+//
+// For the editor world the per-actor contributions are kept between calls
+// and updated from the actor index revision: Gather applies the delta since
+// the revision it last saw (added, modified, removed actors) instead of
+// rescanning, and a delta the index can no longer answer (map change, history
+// overflow) rebuilds with one pass. Any other world, or the editor world
+// while change tracking is unavailable, is scanned once per call.
+//
+// Game thread only.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"   // explicit with NoPCHs
+#include "UObject/WeakObjectPtr.h"
+
+class AActor;
+class UWorld;
+
+class UEAGENTFORGE_API FAgentForgeWorldStats
+{
+public:
+	struct FStats
+	{
+		int32 Actors = 0;
+		int32 Components = 0;
+
+		// analyze_level_composition buckets (class-name heuristics; each actor is in one).
+		int32 StaticActors = 0;
+		int32 LightActors = 0;
+		int32 AIActors = 0;
+		int32 OtherActors = 0;
+
+		int32 PointLights = 0;            // APointLight actors
+		int32 PointLightComponents = 0;   // of those, with a UPointLightComponent
+		float PointLightIntensity = 0.f;  // summed over those components
+		int32 PlayerStarts = 0;
+		int32 NavMeshVolumes = 0;
+		int32 Props = 0;                  // "Prop_" static mesh actors + "Prop_Instances_" instances
+
+		// Every ALight except directional lights, with a light component.
+		int32        Lights = 0;
+		float        LightIntensitySum = 0.f;
+		float        LightIntensityMax = 0.f;
+		FLinearColor LightColorSum = FLinearColor::Black;   // LightColor * Intensity / 10000, summed
+		bool         bHasDirectionalLight = false;
+		bool         bHasSkyLight = false;
+
+		bool  bHasFog = false;
+		float FogDensity = 0.f;   // first AExponentialHeightFog with a component
+
+		FBox Bounds = FBox(ForceInit);
+	};
+
+	static FAgentForgeWorldStats& Get();
+
+	/** Current statistics for World (nullptr: empty stats). */
+	FStats Gather(UWorld* World);
+
+	/** Drop the cached contributions; the next Gather rescans. */
+	void Invalidate() { bValid = false; }
+
+	/** gathers, cache_hits, incremental_updates, actors_updated, rebuilds, full_scans, actors, last_rebuild_ms. */
+	TSharedPtr<FJsonObject> GetStatsJson() const;
+
+private:
+	enum EActorFlag : uint16
+	{
+		Flag_Static        = 1 << 0,
+		Flag_LightBucket   = 1 << 1,
+		Flag_AI            = 1 << 2,
+		Flag_Other         = 1 << 3,
+		Flag_PointLight    = 1 << 4,
+		Flag_PlayerStart   = 1 << 5,
+		Flag_NavMesh       = 1 << 6,
+		Flag_PropMesh      = 1 << 7,
+		Flag_PropInstances = 1 << 8,
+		Flag_Light         = 1 << 9,    // any ALight
+		Flag_SkyLight      = 1 << 10,
+		Flag_Fog           = 1 << 11,
+	};
+	static constexpr int32 NumFlags = 12;
+
+	struct FContribution
+	{
+		TWeakObjectPtr<AActor> Actor;
+		uint16 Flags = 0;
+		int32  Components = 0;
+	};
+
+	/** Accumulator shared by the cached and the one-shot paths. */
+	struct FTally
+	{
+		TMap<FString, FContribution> ByPath;
+		TSet<TWeakObjectPtr<AActor>> Live;   // light, fog and instanced prop actors, read at Compose
+		int32 FlagCounts[NumFlags] = {};
+		int32 Components = 0;
+
+		void Add(AActor* Actor);
+		void Remove(const FString& Path);
+		void Reset();
+	};
+
+	static FContribution Describe(AActor* Actor);
+	void  Rebuild(UWorld* World, int64 Revision);
+	static void  Scan(UWorld* World, FTally& Out);
+	static FStats Compose(const FTally& Tally, bool bEditorWorld);
+
+	FTally                 Cached;
+	TWeakObjectPtr<UWorld> CachedWorld;
+	int64                  CachedRevision = 0;
+	bool                   bValid = false;
+
+	int64  Gathers = 0;
+	int64  CacheHits = 0;
+	int64  IncrementalUpdates = 0;
+	int64  ActorsUpdated = 0;
+	int64  Rebuilds = 0;
+	int64  FullScans = 0;
+	double LastRebuildMs = 0.0;
+};
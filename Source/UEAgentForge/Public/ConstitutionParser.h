@@ -85,7 +85,37 @@ public:
 	/** Whether a constitution has been successfully loaded. */
 	bool IsLoaded() const { return Rules.Num() > 0; }
 
+	/**
+	 * Re-parse the loaded file if its timestamp changed since it was read.
+	 * Checks the disk at most once per ReloadCheckIntervalSeconds.
+	 * Returns true if the rules were reloaded.
+	 */
+	bool ReloadIfChanged();
+
+	/** States in the compiled keyword matcher (0 when nothing is loaded). */
+	int32 GetMatcherStateCount() const { return MatcherNodes.Num(); }
+
+	/** Number of times the file was re-parsed after a change on disk. */
+	int32 GetReloadCount() const { return ReloadCount; }
+
+	static constexpr double ReloadCheckIntervalSeconds = 1.0;
+
 private:
+	/**
+	 * One state of the Aho-Corasick automaton built over every rule's lowercased
+	 * trigger keywords. Matches lists the rules whose keyword ends here, including
+	 * those reached through the fail chain.
+	 */
+	struct FMatcherNode
+	{
+		TMap<TCHAR, int32> Next;
+		int32              Fail = 0;
+		TArray<int32>      Matches;
+	};
+
+	/** Rebuild the automaton from Rules. Called at the end of every load. */
+	void BuildMatcher();
+
 	/** Parse a single markdown bullet line into a FConstitutionRule. */
 	FConstitutionRule ParseBulletLine(const FString& Line, int32 RuleIndex) const;
 
@@ -94,6 +124,10 @@ private:
 
 	TArray<FConstitutionRule> Rules;
 	FString                   LoadedFilePath;
+	FDateTime                 LoadedFileTimestamp;
+	double                    LastReloadCheck = 0.0;
+	int32                     ReloadCount = 0;
+	TArray<FMatcherNode>      MatcherNodes;   // root is node 0
 
 	static UConstitutionParser* Singleton;
 };
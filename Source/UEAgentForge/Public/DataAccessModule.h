@@ -12,6 +12,8 @@
 #include "CoreMinimal.h"
 #include "Dom/JsonObject.h"
 
+class FAgentForgeJob;
+
 
 class UEAGENTFORGE_API FDataAccessModule
 {
@@ -27,9 +29,14 @@ public:
 	 *
 	 * Note: screenshot is async (written at next frame-end). Allow ~0.5 s before reading.
 	 * Call four times (one per angle) for a complete multi-view set.
+	 *
+	 * [render=true] captures off-screen instead: {ok, angle, angles[], image_paths[]}.
 	 */
 	static FString GetMultiViewCapture(const TSharedPtr<FJsonObject>& Args);
 
+	/** Job form for "async":true; the render stage yields until the GPU readbacks are ready. */
+	static TSharedRef<FAgentForgeJob> MakeMultiViewCaptureJob(const TSharedPtr<FJsonObject>& Args);
+
 	/**
 	 * Returns the complete level Outliner hierarchy as structured JSON.
 	 *
@@ -37,7 +44,7 @@ public:
 	 *           has_navmesh_coverage, components:[{name,class}],
 	 *           location:{x,y,z}, bounds:{min,max,extent_cm}}]}
 	 */
-	static FString GetLevelHierarchy();
+	static FString GetLevelHierarchy(const TSharedPtr<FJsonObject>& Args);
 
 	/**
 	 * Dumps all exposed UPROPERTY values on the named actor.
@@ -62,15 +69,25 @@ public:
 	 *   density:{actor_count, static_count, light_count, ai_count, density_per_m2},
 	 *   level_bounds:{center:{x,y,z}, extent:{x,y,z}, area_m2},
 	 *   performance:{frame_ms, draw_calls, primitives},
-	 *   horror_score  — 0-100, higher = more atmospheric horror
+	 *   horror_score  — 0-100, higher = more atmospheric horror,
+	 *   revision      — world revision the snapshot describes
 	 * }
+	 *
+	 * Args: [since_revision] — revision from an earlier snapshot. Nothing changed:
+	 *       {ok, revision, since_revision, delta:true, unchanged:true} only.
+	 *       Otherwise the full snapshot plus delta:true and
+	 *       changes:{added[], modified[], removed[]} (actor labels). delta:false
+	 *       means the revision was too old to diff and the snapshot stands alone.
 	 */
-	static FString GetSemanticEnvironmentSnapshot();
+	static FString GetSemanticEnvironmentSnapshot(const TSharedPtr<FJsonObject>& Args = nullptr);
 
 private:
 	/** Computes the bounding box centre of all actors in the world. */
 	static FVector ComputeLevelCenter(UWorld* World);
 
+	/** center_x/y/z from Args, else the level centre. */
+	static FVector ComputeMultiViewCentre(UWorld* World, const TSharedPtr<FJsonObject>& Args);
+
 	/** Reads lit intensity of all point/spot lights and returns aggregate stats. */
 	static void GatherLightingStats(UWorld* World,
 	                                int32& OutCount, float& OutAvg, float& OutMax,
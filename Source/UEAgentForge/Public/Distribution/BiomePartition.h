@@ -1,5 +1,13 @@
 // Copyright UEAgentForge Project. All Rights Reserved.
 // BiomePartition - deterministic Voronoi biome partitioning helpers.
+//
+// Biome types are interned into FBiomePartitionData::BiomeNames and seeds
+// carry an integer BiomeId, so per-point classification never touches
+// strings. GenerateVoronoiBiomes also rasterizes the partition: each raster
+// cell stores the few seeds that can be nearest or second nearest anywhere
+// inside it, so a lookup is one cell fetch plus a handful of exact distance
+// checks instead of a scan over every seed. Results match the scan exactly,
+// including ties.
 
 #pragma once
 
@@ -9,6 +17,7 @@ struct UEAGENTFORGE_API FBiomeSeedPoint
 {
 	FVector Position = FVector::ZeroVector;
 	FString BiomeType = TEXT("forest");
+	int32 BiomeId = 0;   // index into FBiomePartitionData::BiomeNames
 };
 
 struct UEAGENTFORGE_API FBiomeBlendSample
@@ -18,10 +27,33 @@ struct UEAGENTFORGE_API FBiomeBlendSample
 	float BlendAlpha = 0.0f;
 };
 
+struct UEAGENTFORGE_API FBiomeIdSample
+{
+	int32 PrimaryBiome = INDEX_NONE;
+	int32 SecondaryBiome = INDEX_NONE;
+	float BlendAlpha = 0.0f;
+};
+
+/** Seed candidates per cell, in seed order (CSR layout). Empty until built. */
+struct UEAGENTFORGE_API FBiomeRaster
+{
+	FVector2D Origin = FVector2D::ZeroVector;
+	double CellSize = 1.0;
+	double InvCellSize = 1.0;
+	int32 Width = 0;
+	int32 Height = 0;
+	TArray<int32> CellStart;    // Width * Height + 1 offsets into Candidates
+	TArray<uint8> Candidates;   // seed indices (at most 256 seeds)
+
+	bool IsBuilt() const { return Width > 0; }
+};
+
 struct UEAGENTFORGE_API FBiomePartitionData
 {
 	FBox Bounds;
 	TArray<FBiomeSeedPoint> Seeds;
+	TArray<FString> BiomeNames;   // unique, lower-case
+	FBiomeRaster Raster;
 	float BlendDistance = 300.0f;
 	int32 Seed = 1337;
 };
@@ -43,4 +75,15 @@ public:
 	static FBiomeBlendSample BlendBiomeEdges(
 		const FBiomePartitionData& Partition,
 		const FVector& Location);
+
+	/** BlendBiomeEdges with biome ids instead of names. */
+	static FBiomeIdSample BlendBiomeIds(
+		const FBiomePartitionData& Partition,
+		const FVector& Location);
+
+	/** Case-insensitive id of a biome name, INDEX_NONE if the partition does not use it. */
+	static int32 FindBiomeId(const FBiomePartitionData& Partition, const FString& Name);
+
+	/** (Re)build Partition.Raster from its seeds; GenerateVoronoiBiomes calls this. */
+	static void BuildRaster(FBiomePartitionData& Partition);
 };
@@ -1,27 +1,96 @@
 // Copyright UEAgentForge Project. All Rights Reserved.
 // Clearings - deterministic negative-space generation for natural biomes.
+//
+// Clearings can be applied as exact circles (ApplyClearingMask with the
+// region list) or through a signed-distance raster (FClearingSdf) built once
+// per region set. The SDF stores, per grid node, the distance to the nearest
+// clearing edge (negative inside), clamped to a narrow band, so a point or a
+// density texel classifies with one bilinear sample however many clearings
+// there are. FClearingMaskSettings turns that distance into a keep factor
+// with a soft edge and a non-zero density inside the clearing.
 
 #pragma once
 
 #include "CoreMinimal.h"
 
+struct FPointCloud;
+
 struct UEAGENTFORGE_API FClearingRegion
 {
 	FVector Center = FVector::ZeroVector;
 	float Radius = 300.0f;
 };
 
+struct UEAGENTFORGE_API FClearingMaskSettings
+{
+	float Falloff = 0.0f;        // edge ramp width inside the boundary (cm); 0 = hard edge
+	float InnerDensity = 0.0f;   // keep factor at the clearing core; 0 = fully cleared
+
+	bool IsHard() const { return Falloff <= KINDA_SMALL_NUMBER && InnerDensity <= 0.0f; }
+};
+
+struct UEAGENTFORGE_API FClearingSdf
+{
+	FVector2D Origin = FVector2D::ZeroVector;
+	double CellSize = 1.0;
+	double InvCellSize = 1.0;
+	int32 Width = 0;            // grid nodes, including both borders
+	int32 Height = 0;
+	float Band = 0.0f;          // distances are clamped to +Band outside
+	TArray<float> Distance;
+
+	bool IsValid() const { return Width > 0 && Height > 0; }
+
+	/** Bilinear signed distance at Location's XY; +Band when the SDF is empty. */
+	float Sample(const FVector& Location) const;
+};
+
 class UEAGENTFORGE_API FClearings
 {
 public:
+	/** Upper bound on SDF grid nodes; the cell size grows to stay below it. */
+	static constexpr int32 MaxSdfNodes = 4 * 1024 * 1024;
+
+	/**
+	 * MinGap >= 0 prevents overlap: each clearing (in generation order) is
+	 * shrunk to keep MinGap from the earlier ones, and dropped if that would
+	 * leave less than half the minimum radius.
+	 */
 	static TArray<FClearingRegion> GenerateClearings(
 		const FBox& Bounds,
 		int32 ClearingCount,
 		float MinRadius,
 		float MaxRadius,
-		int32 Seed);
+		int32 Seed,
+		float MinGap = -1.0f);
+
+	/**
+	 * SDF over Bounds' XY. CellSize <= 0 picks a quarter of the smallest
+	 * radius. Nodes farther than the falloff plus two cells from every edge
+	 * hold +Band.
+	 */
+	static FClearingSdf BuildClearingSdf(
+		const TArray<FClearingRegion>& Clearings,
+		const FBox& Bounds,
+		const FClearingMaskSettings& Settings,
+		float CellSize = 0.0f);
+
+	/** Keep factor for a signed distance: 1 outside, ramping to InnerDensity over Falloff inside. */
+	static float KeepFactor(float SignedDistance, const FClearingMaskSettings& Settings);
 
 	static TArray<FVector> ApplyClearingMask(
 		const TArray<FVector>& Points,
 		const TArray<FClearingRegion>& Clearings);
+
+	/** In-place form: kills survivors inside any clearing. */
+	static void ApplyClearingMask(
+		FPointCloud& Cloud,
+		const TArray<FClearingRegion>& Clearings);
+
+	/** SDF form: keeps each survivor with probability KeepFactor(Sdf.Sample(point)). */
+	static void ApplyClearingMask(
+		FPointCloud& Cloud,
+		const FClearingSdf& Sdf,
+		const FClearingMaskSettings& Settings,
+		int32 Seed);
 };
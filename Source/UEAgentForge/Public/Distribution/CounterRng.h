@@ -0,0 +1,108 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// CounterRng - stateless counter-based random numbers for the distribution generators.
+//
+// A draw is a pure function of (seed, stream, substream, counter): the key is
+// SplitMix64-mixed from seed / stream / substream once, and each counter is
+// mixed with the key through two more SplitMix64 finalizer rounds. Nothing
+// is carried between draws, so element N of a generator can be produced on
+// any thread, in any order, and the result is the same. Only integer
+// arithmetic is used up to the final exact int->float conversion, so output
+// is also identical across compilers and machines.
+//
+// Generators address draws as (element index, draw number) so that adding a
+// draw to one element never shifts the values of another. Sequential
+// algorithms (Bridson sampling) use FCounterRngSequence, which just walks
+// the counter.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Stream ids; one per generator so their outputs are uncorrelated for the same seed. */
+namespace CounterRngStream
+{
+	static constexpr uint32 ClusterCenters  = 0x1C3A0001;
+	static constexpr uint32 ClusterPoints   = 0x1C3A0002;
+	static constexpr uint32 PoissonDisk     = 0x1C3A0003;
+	static constexpr uint32 PoissonTile     = 0x1C3A0004;
+	static constexpr uint32 AttractorBias   = 0x1C3A0005;
+	static constexpr uint32 DensityGradient = 0x1C3A0006;
+	static constexpr uint32 DensityNoise    = 0x1C3A0007;
+	static constexpr uint32 ClearingRadius  = 0x1C3A0008;
+	static constexpr uint32 BiomeSeeds      = 0x1C3A0009;
+	static constexpr uint32 ClearingMask    = 0x1C3A000A;
+	static constexpr uint32 BenchmarkInput  = 0x1C3A000B;
+	static constexpr uint32 Materialize     = 0x1C3A000C;
+}
+
+struct FCounterRng
+{
+	uint64 Key = 0;
+
+	FCounterRng(int32 Seed, uint32 Stream, uint64 SubStream = 0)
+		: Key(Mix(Mix(((uint64)Stream << 32) | (uint32)Seed) ^ (SubStream * Golden)))
+	{
+	}
+
+	/** 64 random bits for Counter. */
+	FORCEINLINE uint64 Bits(uint64 Counter) const
+	{
+		return Mix(Mix(Key ^ (Counter * Golden)) + Key);
+	}
+
+	/** Counter for draw Draw of element Index when each element uses at most DrawsPerElement draws. */
+	static FORCEINLINE uint64 Slot(uint64 Index, uint32 Draw, uint32 DrawsPerElement)
+	{
+		return Index * DrawsPerElement + Draw;
+	}
+
+	/** Uniform in [0, 1), 24-bit resolution. */
+	FORCEINLINE float FRand(uint64 Counter) const
+	{
+		return (float)(Bits(Counter) >> 40) * (1.0f / 16777216.0f);
+	}
+
+	FORCEINLINE float FRandRange(uint64 Counter, float Min, float Max) const
+	{
+		return Min + (Max - Min) * FRand(Counter);
+	}
+
+	FORCEINLINE double FRandRange(uint64 Counter, double Min, double Max) const
+	{
+		return Min + (Max - Min) * (double)FRand(Counter);
+	}
+
+	/** Uniform integer in [Min, Max] (inclusive). */
+	FORCEINLINE int32 RandRange(uint64 Counter, int32 Min, int32 Max) const
+	{
+		const uint64 Range = (uint64)((int64)Max - (int64)Min + 1);
+		return Range <= 1 ? Min : (int32)((int64)Min + (int64)(((Bits(Counter) >> 32) * Range) >> 32));
+	}
+
+private:
+	static constexpr uint64 Golden = 0x9E3779B97F4A7C15ull;
+
+	static FORCEINLINE uint64 Mix(uint64 Z)
+	{
+		Z = (Z ^ (Z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		Z = (Z ^ (Z >> 27)) * 0x94D049BB133111EBull;
+		return Z ^ (Z >> 31);
+	}
+};
+
+/** FRandomStream-style sequential view over an FCounterRng. */
+struct FCounterRngSequence
+{
+	FCounterRng Rng;
+	uint64 Counter = 0;
+
+	FCounterRngSequence(int32 Seed, uint32 Stream, uint64 SubStream = 0)
+		: Rng(Seed, Stream, SubStream)
+	{
+	}
+
+	FORCEINLINE float FRand() { return Rng.FRand(Counter++); }
+	FORCEINLINE float FRandRange(float Min, float Max) { return Rng.FRandRange(Counter++, Min, Max); }
+	FORCEINLINE double FRandRange(double Min, double Max) { return Rng.FRandRange(Counter++, Min, Max); }
+	FORCEINLINE int32 RandRange(int32 Min, int32 Max) { return Rng.RandRange(Counter++, Min, Max); }
+};
@@ -4,6 +4,10 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Distribution/Clearings.h"
+
+struct FPointCloud;
+struct FBiomePartitionData;
 
 struct UEAGENTFORGE_API FDensityFieldConfig
 {
@@ -14,6 +18,35 @@ struct UEAGENTFORGE_API FDensityFieldConfig
 	int32 Seed = 1337;
 };
 
+/** Optional masks folded into a composite field; null / empty entries are skipped. */
+struct UEAGENTFORGE_API FDensityCompositeMasks
+{
+	const FClearingSdf* ClearingSdf = nullptr;            // texels scaled by the clearing keep factor
+	FClearingMaskSettings ClearingSettings;
+	const FBiomePartitionData* Biomes = nullptr;          // texels outside AllowedBiomeIds are 0
+	TArray<bool> AllowedBiomeIds;                         // by biome id; empty allows all
+	float MinKeepProbability = 0.05f;                     // density floor, applied before the masks
+};
+
+/**
+ * Keep-probability raster with a box-filtered mip chain. Mips[0] is the full
+ * resolution grid; each level halves both axes down to 1x1, so the last level
+ * is the field average.
+ */
+struct UEAGENTFORGE_API FDensityRaster
+{
+	FBox Bounds = FBox(ForceInit);
+	TArray<FIntPoint> MipSizes;
+	TArray<TArray<float>> Mips;
+
+	bool IsValid() const { return Mips.Num() > 0; }
+	int32 NumLevels() const { return Mips.Num(); }
+
+	/** Bilinear sample of Level at Location (clamped to the bounds). */
+	float Sample(const FVector& Location, int32 Level = 0) const;
+	float Average() const { return IsValid() ? Mips.Last()[0] : 0.0f; }
+};
+
 class UEAGENTFORGE_API FDensityField
 {
 public:
@@ -39,4 +72,30 @@ public:
 		const FBox& Bounds,
 		int32 Seed,
 		float MinKeepProbability = 0.05f);
+
+	/**
+	 * Gaussian falloff, noise, fringe, clearings and biome masks in one
+	 * raster, built row-parallel. Texel values are the final keep probability
+	 * (density floored at MinKeepProbability, times the clearing keep factor,
+	 * zeroed outside the allowed biomes).
+	 */
+	static FDensityRaster GenerateCompositeField(
+		const FBox& Bounds,
+		int32 Width,
+		int32 Height,
+		const FDensityFieldConfig& Config,
+		const FDensityCompositeMasks& Masks);
+
+	/** One bilinear sample per survivor: kills with probability 1 - Sample; records it in Density. */
+	static void ApplyDensityRaster(FPointCloud& Cloud, const FDensityRaster& Raster, int32 Seed);
+
+	/** In-place form: kills rejected survivors and records the sampled density per point. */
+	static void ApplyDensityGradient(
+		FPointCloud& Cloud,
+		const TArray<float>& Field,
+		int32 Width,
+		int32 Height,
+		const FBox& Bounds,
+		int32 Seed,
+		float MinKeepProbability = 0.05f);
 };
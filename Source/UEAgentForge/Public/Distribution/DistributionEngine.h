@@ -4,12 +4,20 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "AgentForgeSurfaceTrace.h"
 
 class UWorld;
+struct FPointCloud;
 
 class UEAGENTFORGE_API FDistributionEngine
 {
 public:
+	/** Ceiling for every generator's point count (and for max_spawn_points). */
+	static constexpr int32 MaxPoints = 4000000;
+
+	/** GeneratePoissonDiskPoints switches to the tiled sampler above this many points. */
+	static constexpr int32 TiledPoissonThreshold = 16384;
+
 	static TArray<FVector> GenerateBlueNoisePoints(
 		const FBox& Bounds,
 		int32 TargetCount,
@@ -23,12 +31,29 @@ public:
 		float ClusterRadius,
 		int32 Seed);
 
+	/**
+	 * Bridson Poisson-disk sampling grown from a single seed point. Requests
+	 * above TiledPoissonThreshold are forwarded to GeneratePoissonDiskPointsTiled.
+	 */
 	static TArray<FVector> GeneratePoissonDiskPoints(
 		const FBox& Bounds,
 		int32 TargetCount,
 		float MinSpacing,
 		int32 Seed);
 
+	/**
+	 * Bridson sampling per tile. Tiles are coloured in a 2x2 pattern and run
+	 * as four phases; tiles in a phase are never adjacent, so they run in
+	 * parallel against one shared grid. Each tile gets an area-proportional
+	 * share of TargetCount and its own random stream, so the output depends only
+	 * on the seed, not on thread count or scheduling.
+	 */
+	static TArray<FVector> GeneratePoissonDiskPointsTiled(
+		const FBox& Bounds,
+		int32 TargetCount,
+		float MinSpacing,
+		int32 Seed);
+
 	// Backward-compatible alias.
 	static TArray<FVector> GeneratePoissonPoints(
 		const FBox& Bounds,
@@ -40,7 +65,8 @@ public:
 		const TArray<FVector>& Points,
 		UWorld* World,
 		float MinSlopeDegrees,
-		float MaxSlopeDegrees);
+		float MaxSlopeDegrees,
+		ESurfaceTraceSource Source = ESurfaceTraceSource::Physics);
 
 	static TArray<FVector> ApplyHeightFilter(
 		const TArray<FVector>& Points,
@@ -52,4 +78,12 @@ public:
 		const FVector& Origin,
 		float MinDistance,
 		float MaxDistance);
+
+	// In-place forms: clear survivor flags instead of copying. The slope filter
+	// also moves survivors onto the traced surface and fills the Normal channel;
+	// its surface queries go through FAgentForgeSurfaceTrace as one batch.
+	static void ApplySlopeFilter(FPointCloud& Cloud, UWorld* World, float MinSlopeDegrees, float MaxSlopeDegrees,
+		ESurfaceTraceSource Source = ESurfaceTraceSource::Physics);
+	static void ApplyHeightFilter(FPointCloud& Cloud, float MinHeight, float MaxHeight);
+	static void ApplyDistanceMask(FPointCloud& Cloud, const FVector& Origin, float MinDistance, float MaxDistance);
 };
@@ -5,6 +5,8 @@
 
 #include "CoreMinimal.h"
 
+struct FPointCloud;
+
 class UEAGENTFORGE_API FInteractionRules
 {
 public:
@@ -23,4 +25,9 @@ public:
 	static TArray<FVector> ApplySelfSpacing(
 		const TArray<FVector>& CandidatePoints,
 		float MinDistance);
+
+	// In-place forms over the survivors of Cloud.
+	static void ApplyAvoidance(FPointCloud& Cloud, const TArray<FVector>& BlockingPoints, float MinDistance);
+	static void ApplyAttractorBias(FPointCloud& Cloud, const TArray<FVector>& AttractorPoints, float AttractionRadius, float AttractionStrength, int32 Seed);
+	static void ApplySelfSpacing(FPointCloud& Cloud, float MinDistance);
 };
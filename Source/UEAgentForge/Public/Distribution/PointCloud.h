@@ -0,0 +1,114 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// PointCloud - structure-of-arrays point set with a survivor mask.
+//
+// Distribution filters clear survivor flags in place instead of copying the
+// surviving points into a new array; Compact() removes the dead points from
+// every channel once, at the end of the pipeline. Positions live in separate
+// X / Y / Z arrays and the mask is one byte per point, so a filter is a flat
+// loop over contiguous values.
+//
+// Attribute channels are empty until a stage fills them (AddChannel) and are
+// kept in step with the positions by Compact().
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/ParallelFor.h"
+
+struct UEAGENTFORGE_API FPointCloud
+{
+	TArray<FVector::FReal> X;
+	TArray<FVector::FReal> Y;
+	TArray<FVector::FReal> Z;
+	TArray<uint8>          Alive;     // 1 = survivor
+
+	// Optional channels
+	TArray<int32>          BiomeId;   // index into BiomeNames, INDEX_NONE when unassigned
+	TArray<FString>        BiomeNames;
+	TArray<float>          Density;
+	TArray<float>          Scale;
+	TArray<FVector3f>      Normal;
+
+	FPointCloud() = default;
+	explicit FPointCloud(const TArray<FVector>& Points);
+
+	void Reset(int32 ReserveCount = 0);
+	int32 Add(const FVector& Point);
+
+	int32 Num() const { return X.Num(); }
+	int32 NumAlive() const { return AliveCount; }
+	bool IsAlive(int32 Index) const { return Alive[Index] != 0; }
+	FVector GetPosition(int32 Index) const { return FVector(X[Index], Y[Index], Z[Index]); }
+	void SetPosition(int32 Index, const FVector& Point);
+
+	void Kill(int32 Index)
+	{
+		AliveCount -= Alive[Index];
+		Alive[Index] = 0;
+	}
+
+	/** Recount survivors after a stage wrote Alive directly. */
+	void RecountAlive();
+
+	/** Keep only the first Count survivors. */
+	void TruncateAlive(int32 Count);
+
+	/** Size a channel to Num() with Default for every point; no-op when already sized. */
+	template <typename T>
+	void AddChannel(TArray<T>& Channel, const T& Default)
+	{
+		if (Channel.Num() != Num())
+		{
+			Channel.Init(Default, Num());
+		}
+	}
+
+	/** Remove dead points from positions and every filled channel, preserving order. */
+	void Compact();
+
+	/** Surviving positions, in order. */
+	TArray<FVector> ToPoints() const;
+
+	/** Heap bytes held by positions, mask and channels. */
+	SIZE_T GetAllocatedSize() const;
+
+	/** Call Visit(Index) for each survivor, in order. */
+	template <typename FVisitor>
+	void ForEachAlive(FVisitor&& Visit) const
+	{
+		const int32 Count = Num();
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			if (Alive[Index])
+			{
+				Visit(Index);
+			}
+		}
+	}
+
+	/**
+	 * Kill every survivor for which Keep(Index) returns false, in parallel.
+	 * Keep must be thread-safe and may only write per-index channel entries.
+	 */
+	template <typename FPredicate>
+	void ParallelFilter(FPredicate&& Keep)
+	{
+		static constexpr int32 ChunkSize = 1024;
+		const int32 Count = Num();
+		ParallelFor(FMath::DivideAndRoundUp(Count, ChunkSize), [&](int32 Chunk)
+		{
+			const int32 End = FMath::Min(Count, (Chunk + 1) * ChunkSize);
+			for (int32 Index = Chunk * ChunkSize; Index < End; ++Index)
+			{
+				if (Alive[Index] && !Keep(Index))
+				{
+					Alive[Index] = 0;
+				}
+			}
+		});
+		RecountAlive();
+	}
+
+private:
+	int32 AliveCount = 0;
+};
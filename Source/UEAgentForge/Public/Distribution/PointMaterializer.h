@@ -0,0 +1,100 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// PointMaterializer - turns a filtered distribution point cloud into instanced meshes.
+//
+// op_surface_scatter / op_spline_scatter compute their points natively but
+// used to hand placement to PCG (TriggerProceduralGenerate), which re-runs
+// its own graph and ignores the biome, density and normal the distribution
+// graph already worked out. placement:"native" materializes the points
+// directly:
+//
+//   Resolve   palette categories -> loaded static meshes (game thread).
+//             The optional palette "biomes" object maps a biome name to the
+//             categories allowed in it.
+//   Map       per point, in parallel: mesh choice, yaw, scale and
+//             align-to-normal, from stateless counter RNG draws, so the
+//             result never depends on scheduling.
+//   Bucket    by (grid cell, mesh). Each cell becomes one actor holding one
+//             HISM per mesh, so cells cull, stream (World Partition) and
+//             can be deleted independently of each other.
+//
+// Scale is the palette scale_range of the category times a density factor:
+// points that survived in sparse regions come out smaller, like the thinning
+// edge of a forest.
+//
+// Editor, game thread only; the Map stage fans out internally.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"   // explicit with NoPCHs
+
+class UWorld;
+
+/** Per-point attributes the distribution graph keeps next to the positions. Empty channels were not computed. */
+struct UEAGENTFORGE_API FDistributionPointAttributes
+{
+	TArray<int32>     BiomeId;      // index into BiomeNames, INDEX_NONE when unassigned
+	TArray<FString>   BiomeNames;
+	TArray<float>     Density;      // 0..1
+	TArray<FVector3f> Normal;       // surface normal from the slope filter
+
+	SIZE_T GetAllocatedSize() const
+	{
+		SIZE_T Bytes = BiomeId.GetAllocatedSize() + BiomeNames.GetAllocatedSize() + Density.GetAllocatedSize() + Normal.GetAllocatedSize();
+		for (const FString& Name : BiomeNames)
+		{
+			Bytes += Name.GetAllocatedSize();
+		}
+		return Bytes;
+	}
+};
+
+struct UEAGENTFORGE_API FPointMaterializeSettings
+{
+	FString Prefix;                       // cell actors are labelled <Prefix>_Cell_<x>_<y>
+	FName   Tag;                          // added to every cell actor
+	int32   Seed = 1337;
+	double  CellSize = 5000.0;            // cm; <= 0 puts everything in one cell
+	bool    bAlignToNormal = true;
+	float   MaxAlignAngle = 30.0f;        // degrees; steeper normals are clamped
+	float   CullDistance = 0.0f;          // cm; 0 keeps the mesh default
+	FVector2f DensityScale = FVector2f(0.7f, 1.0f);   // scale factor at density 0 and 1
+	TArray<FString> Categories;           // palette categories to use; empty = all
+};
+
+struct UEAGENTFORGE_API FPointMaterializeResult
+{
+	int32 Instances = 0;
+	int32 Cells = 0;
+	int32 Components = 0;
+	int32 Meshes = 0;
+	int32 RemovedCells = 0;               // from an earlier materialization with the same prefix
+	int32 TracedNormals = 0;              // normals that had to be traced because the cloud had none
+	TArray<FString> MissingMeshes;        // palette paths that did not load
+	TMap<FString, int32> CategoryCounts;
+	double MapMs = 0.0;
+	double BuildMs = 0.0;
+
+	TSharedPtr<FJsonObject> ToJson() const;
+};
+
+class UEAGENTFORGE_API FPointMaterializer
+{
+public:
+	/**
+	 * Replaces the cells of an earlier run with the same prefix, then builds
+	 * the new ones. Attributes may be empty or partial. False with OutError
+	 * when the palette yields no loadable mesh.
+	 */
+	static bool Materialize(
+		UWorld* World,
+		const TArray<FVector>& Points,
+		const FDistributionPointAttributes& Attributes,
+		const TSharedPtr<FJsonObject>& Palette,
+		const FPointMaterializeSettings& Settings,
+		FPointMaterializeResult& OutResult,
+		FString& OutError);
+
+	/** Destroys the cell actors labelled <Prefix>_Cell_*. Returns how many. */
+	static int32 RemoveCells(UWorld* World, const FString& Prefix);
+};
@@ -0,0 +1,85 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// SpatialFilters - uniform-grid 2D point index shared by the distribution filters.
+//
+// Points are bucketed by XY into square cells over a fixed rect; each cell is
+// a singly linked chain through flat arrays, so building is one pass and
+// points can also be added incrementally (self-spacing). Queries visit only
+// the cells a radius overlaps. Z is ignored everywhere, matching the
+// DistSquared2D checks the filters used before.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UEAGENTFORGE_API FPointSpatialIndex
+{
+public:
+	FPointSpatialIndex() = default;
+
+	/** Index Points with cells of about CellSize (usually the query radius). */
+	FPointSpatialIndex(const TArray<FVector>& Points, float CellSize);
+
+	/**
+	 * Empty index over Rect for incremental Add. The cell size grows when
+	 * Rect / CellSize would need far more cells than ExpectedPoints.
+	 */
+	void Init(const FBox2D& Rect, float CellSize, int32 ExpectedPoints);
+
+	/** Add a point; points outside the rect land in the nearest edge cell. Returns its index. */
+	int32 Add(const FVector& Point);
+
+	int32 Num() const { return Points.Num(); }
+	bool IsEmpty() const { return Points.Num() == 0; }
+	const FVector2D& GetPoint(int32 Index) const { return Points[Index]; }
+
+	/** True when an indexed point lies strictly inside Radius of Query. */
+	bool AnyWithin(const FVector& Query, float Radius) const;
+
+	/**
+	 * Nearest indexed point (other than IgnoreIndex) within MaxRadius; a
+	 * negative MaxRadius searches without limit. Returns INDEX_NONE if none.
+	 */
+	int32 FindNearest(const FVector& Query, float MaxRadius, float& OutDistSq, int32 IgnoreIndex = INDEX_NONE) const;
+
+	/** Visit (Index, DistSq) for every point within Radius (inclusive); return false to stop. */
+	template <typename FVisitor>
+	void ForEachWithin(const FVector& Query, float Radius, FVisitor&& Visit) const
+	{
+		if (Points.Num() == 0)
+		{
+			return;
+		}
+		const FVector2D Q(Query.X, Query.Y);
+		const double RadiusSq = (double)Radius * Radius;
+		const int32 X0 = CellX(Q.X - Radius);
+		const int32 X1 = CellX(Q.X + Radius);
+		const int32 Y1 = CellY(Q.Y + Radius);
+		for (int32 Y = CellY(Q.Y - Radius); Y <= Y1; ++Y)
+		{
+			for (int32 X = X0; X <= X1; ++X)
+			{
+				for (int32 Index = Heads[Y * Width + X]; Index != INDEX_NONE; Index = Next[Index])
+				{
+					const double DistSq = FVector2D::DistSquared(Q, Points[Index]);
+					if (DistSq <= RadiusSq && !Visit(Index, (float)DistSq))
+					{
+						return;
+					}
+				}
+			}
+		}
+	}
+
+private:
+	int32 CellX(double X) const { return FMath::Clamp(FMath::FloorToInt32((X - Origin.X) * InvCellSize), 0, Width - 1); }
+	int32 CellY(double Y) const { return FMath::Clamp(FMath::FloorToInt32((Y - Origin.Y) * InvCellSize), 0, Height - 1); }
+
+	FVector2D Origin = FVector2D::ZeroVector;
+	double CellSize = 1.0;
+	double InvCellSize = 1.0;
+	int32 Width = 0;
+	int32 Height = 0;
+	TArray<int32> Heads;        // first point per cell, INDEX_NONE when empty
+	TArray<int32> Next;         // next point in the same cell
+	TArray<FVector2D> Points;
+};
@@ -0,0 +1,89 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// SplineSampler - arc-length sampling of spline curves, off the game thread.
+//
+// A spline is captured once into a world-space FInterpCurveVector, either
+// from a USplineComponent (game thread) or from control points that have not
+// been applied yet, curved the way USplineComponent::UpdateSpline would curve
+// them. Capturing builds an arc-length table: every segment is split into
+// StepsPerSegment chords and the running length is stored against the input
+// key. Sampling maps an even distance grid onto input keys by binary search in
+// that table, then evaluates position and tangent per sample in parallel, so
+// spacing stays even through curves and nothing refers back to the component.
+//
+// Frames: Tangent is the unit direction of travel, Right = Up x Tangent with
+// Up = +Z (+X for vertical tangents), Normal = Tangent x Right. Lane offsets
+// move a sample along Right; positive is right of the direction of travel.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/InterpCurve.h"
+
+class USplineComponent;
+struct FPointCloud;
+
+struct UEAGENTFORGE_API FSplineSample
+{
+	FVector Position = FVector::ZeroVector;
+	FVector Tangent = FVector::ForwardVector;
+	FVector Right = FVector::RightVector;
+	FVector Normal = FVector::UpVector;
+	float   Distance = 0.0f;   // along the curve, cm
+	int32   Lane = 0;          // index into LaneOffsets, 0 without lanes
+};
+
+struct UEAGENTFORGE_API FSplineSampleSettings
+{
+	float Spacing = 500.0f;          // cm between samples along the curve
+	float StartOffset = 0.0f;        // distance of the first sample
+	TArray<float> LaneOffsets;       // lateral offsets in cm; empty samples the centerline
+	int32 MaxSamples = 100000;       // over all lanes
+};
+
+class UEAGENTFORGE_API FSplineSampler
+{
+public:
+	/** Chords per segment in the arc-length table. */
+	static constexpr int32 StepsPerSegment = 16;
+
+	FSplineSampler() = default;
+
+	/** World-space copy of Spline's position curve. Game thread. */
+	static FSplineSampler FromComponent(const USplineComponent& Spline);
+
+	/** Points curved as AddSplinePoint + UpdateSpline would (auto tangents, free endpoints). */
+	static FSplineSampler FromPoints(const TArray<FVector>& Points, bool bClosedLoop);
+
+	bool IsValid() const { return Distances.Num() >= 2; }
+	float GetLength() const { return Distances.Num() > 0 ? Distances.Last() : 0.0f; }
+	bool IsClosedLoop() const { return Curve.bIsLooped; }
+
+	/** Bounds of the table's chord points; the curve itself can bulge slightly past them. */
+	FBox GetBounds() const { return Bounds; }
+
+	/** Hex digest of the curve, for cache keys. */
+	FString GetFingerprint() const;
+
+	/** Input key at Distance along the curve, clamped to [0, GetLength()]. */
+	float KeyAtDistance(float Distance) const;
+
+	/** Centerline sample at Distance. */
+	FSplineSample SampleAtDistance(float Distance) const;
+
+	/** Sample count Sample(Settings) returns. */
+	int32 NumSamples(const FSplineSampleSettings& Settings) const;
+
+	/** Evenly spaced samples, distance-major: each distance's lanes are adjacent. Thread-safe. */
+	TArray<FSplineSample> Sample(const FSplineSampleSettings& Settings) const;
+
+	/** Sample positions as a point cloud for the distribution filters. */
+	static FPointCloud ToPointCloud(const TArray<FSplineSample>& Samples);
+
+private:
+	void BuildTable();
+
+	FInterpCurveVector Curve;
+	TArray<float> Keys;        // table input keys, ascending
+	TArray<float> Distances;   // running length at Keys, from 0
+	FBox Bounds = FBox(ForceInit);
+};
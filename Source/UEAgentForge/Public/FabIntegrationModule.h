@@ -2,6 +2,9 @@
 
 #include "CoreMinimal.h"
 #include "Dom/JsonObject.h"
+#include "Templates/SharedPointer.h"
+
+class FAgentForgeJob;
 
 /**
  * UEAgentForge — FabIntegrationModule
@@ -20,6 +23,8 @@
  *                           args: query, [max_results=20], [free_only=true]
  *                           NOTE: Uses Fab.com's public web API (best-effort; may require
  *                           updates if the endpoint changes). Returns free assets only by default.
+ *                           Responses are cached per (query, max_results, free_only) for
+ *                           [cache_ttl_seconds=300]; 0 always queries.
  *
  *   download_fab_asset    → {error, message, workaround}
  *                           args: asset_id
@@ -30,6 +35,17 @@
  *                           Imports a file already on disk (FBX, OBJ, PNG, WAV, etc.)
  *                           into the UE Content Browser.
  *
+ *   import_asset_batch    → {ok, count, imported, failed, bytes_downloaded, resumed, saved_packages, items[]}
+ *                           args: assets[{url|file_path, [file_name], [destination_path]}],
+ *                                 [destination_path], [max_concurrent=4], [chunk_mb=8],
+ *                                 [save=true], [replace_existing=true], [timeout_seconds=600]
+ *                           Downloads every url entry concurrently (max_concurrent requests in
+ *                           flight) in chunk_mb HTTP Range requests appended to a .part file
+ *                           under Saved/AgentForge/Downloads/, so an interrupted batch resumes
+ *                           where it stopped. All files, downloaded or local, then go through one
+ *                           IAssetTools::ImportAssetTasks call and one package save pass.
+ *                           "async":true runs it as a job (download, import stages).
+ *
  *   list_imported_assets  → [{asset_name, asset_path, type}]
  *                           args: content_path (e.g., "/Game/FabImports/")
  */
@@ -45,6 +61,15 @@ public:
 	/** Import a local file (FBX/OBJ/PNG/WAV) into the UE Content Browser. */
 	static FString ImportLocalAsset(const TSharedPtr<FJsonObject>& Args);
 
+	/** Download (concurrent, resumable) and import many assets in one batch; waits inline. */
+	static FString ImportAssetBatch(const TSharedPtr<FJsonObject>& Args);
+
+	/** import_asset_batch as a time-sliced job for "async":true. */
+	static TSharedRef<FAgentForgeJob> MakeImportAssetBatchJob(const TSharedPtr<FJsonObject>& Args);
+
 	/** List assets in a Content Browser folder. */
 	static FString ListImportedAssets(const TSharedPtr<FJsonObject>& Args);
+
+	/** search_queries, search_cache_hits, batches, downloads, downloads_resumed, download_failures, bytes_downloaded, imports, import_failures. */
+	static TSharedPtr<FJsonObject> GetStatsJson();
 };
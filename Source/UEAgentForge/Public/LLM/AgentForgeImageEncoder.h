@@ -0,0 +1,73 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "LLM/AgentForgeLLMTypes.h"
+
+#include <atomic>
+
+struct FSceneCaptureImage;
+
+enum class EAgentForgeImageFormat : uint8
+{
+	Jpeg,
+	Png
+};
+
+/** Target size and codec for images attached to a vision request. */
+struct UEAGENTFORGE_API FAgentForgeImageEncodeSettings
+{
+	int32 MaxLongEdge = 1568;
+	int32 MaxShortEdge = 0;      // 0 = no limit
+	EAgentForgeImageFormat Format = EAgentForgeImageFormat::Jpeg;
+	int32 Quality = 85;          // JPEG only
+
+	/** Largest size each provider uses without downscaling it again server-side. */
+	static FAgentForgeImageEncodeSettings ForProvider(EAgentForgeLLMProvider Provider);
+};
+
+struct UEAGENTFORGE_API FAgentForgeEncodedImage
+{
+	FString   Base64;
+	FString   MediaType;
+	FIntPoint Size = FIntPoint::ZeroValue;
+	int64     Bytes = 0;
+	double    EncodeMs = 0.0;
+};
+
+/**
+ * Downscale + compress + base64 for vision requests, entirely in memory.
+ * Encode is safe on any thread; EncodeAll spreads images across workers.
+ */
+class UEAGENTFORGE_API FAgentForgeImageEncoder
+{
+public:
+	static FAgentForgeImageEncoder& Get();
+
+	bool Encode(
+		TArray<FColor> Pixels,
+		const FIntPoint& Size,
+		const FAgentForgeImageEncodeSettings& Settings,
+		FAgentForgeEncodedImage& OutImage,
+		FString& OutError);
+
+	/** Consumes Images' pixels. OutImages is in input order. */
+	bool EncodeAll(
+		TArray<FSceneCaptureImage>& Images,
+		const FAgentForgeImageEncodeSettings& Settings,
+		TArray<FAgentForgeEncodedImage>& OutImages,
+		FString& OutError);
+
+	/** Decode a PNG/JPEG/BMP file on disk to BGRA pixels. */
+	static bool DecodeFile(const FString& Path, TArray<FColor>& OutPixels, FIntPoint& OutSize, FString& OutError);
+
+	TSharedPtr<FJsonObject> GetStatsJson() const;
+
+private:
+	std::atomic<int64> Images { 0 };
+	std::atomic<int64> SourceBytes { 0 };     // raw BGRA bytes before resize
+	std::atomic<int64> EncodedBytes { 0 };
+	std::atomic<int64> EncodeMicros { 0 };
+	std::atomic<int64> LastEncodeMicros { 0 };
+	std::atomic<int64> Failures { 0 };
+};
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "HAL/CriticalSection.h"
+#include "LLM/AgentForgeLLMTypes.h"
+
+/**
+ * Opt-in cache for repeatable LLM calls (FAgentForgeLLMSettings::CacheMode).
+ * The key is a SHA-1 of everything that shapes the completion: provider,
+ * model, endpoint, system prompt, messages (images by hash), response schema,
+ * temperature and max tokens. Only successful responses are stored.
+ *
+ *   Memory tier  LRU bounded by entry count.
+ *   Disk tier    Saved/AgentForgeLLMCache/<key>.json, bounded in bytes (oldest
+ *                files go first). A disk hit is promoted into memory.
+ *
+ * Entries older than the TTL are ignored and dropped on either tier. Set the
+ * limits with set_llm_cache_policy. Thread-safe.
+ */
+class UEAGENTFORGE_API FAgentForgeLLMResponseCache
+{
+public:
+	static constexpr int32  DefaultMemoryEntries = 256;
+	static constexpr int64  DefaultDiskBudgetBytes = 256ll * 1024 * 1024;
+	static constexpr double DefaultTtlSeconds = 7.0 * 24.0 * 3600.0;
+
+	static FAgentForgeLLMResponseCache& Get();
+
+	/** "bypass" | "prefer" | "only", case-insensitive. */
+	static bool ParseMode(const FString& Name, EAgentForgeLLMCacheMode& OutMode);
+	static const TCHAR* ModeName(EAgentForgeLLMCacheMode Mode);
+
+	static FString MakeKey(const FAgentForgeLLMSettings& Settings);
+
+	/** Memory first, then disk. OutFromDisk is set on a disk hit. Counts a hit or a miss. */
+	bool Find(const FString& Key, FAgentForgeLLMResponse& OutResponse, bool* OutFromDisk = nullptr);
+	void Store(const FString& Key, const FAgentForgeLLMResponse& Response);
+
+	/** Drop the memory tier; bIncludeDisk also deletes Saved/AgentForgeLLMCache. */
+	void Clear(bool bIncludeDisk);
+
+	/** ttl_seconds, memory_entries, disk_budget_mb, disk (bool). */
+	void ApplyPolicy(const TSharedPtr<FJsonObject>& Args);
+
+	static FString GetDiskRoot();
+
+	TSharedPtr<FJsonObject> GetStatsJson() const;
+
+private:
+	struct FEntry
+	{
+		FAgentForgeLLMResponse Response;
+		int64  StoredAt = 0;   // UTC unix seconds, so disk entries age across sessions
+		uint64 LastUse = 0;
+	};
+
+	struct FDiskEntry
+	{
+		int64 Bytes = 0;
+		int64 StoredAt = 0;
+	};
+
+	FString DiskPath(const FString& Key) const;
+	bool    IsExpired(int64 StoredAt) const;
+	void    ScanDisk();
+	void    EvictMemory();
+	void    EvictDisk();
+
+	mutable FCriticalSection  Lock;
+	TMap<FString, FEntry>     Entries;
+	TMap<FString, FDiskEntry> DiskEntries;
+	bool   bDiskScanned = false;
+	bool   bDiskEnabled = true;
+	int32  MemoryEntries = DefaultMemoryEntries;
+	int64  DiskBudgetBytes = DefaultDiskBudgetBytes;
+	int64  DiskBytes = 0;
+	double TtlSeconds = DefaultTtlSeconds;
+	uint64 UseClock = 0;
+
+	int64 MemoryHits = 0;
+	int64 DiskHits = 0;
+	int64 Misses = 0;
+	int64 Stores = 0;
+	int64 Expired = 0;
+	int64 Evictions = 0;
+};
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "HAL/CriticalSection.h"
+#include "Interfaces/IHttpResponse.h"
+#include "LLM/AgentForgeLLMTypes.h"
+
+/**
+ * Admission control in front of the network for UAgentForgeLLMSubsystem.
+ * Each provider has a lane with:
+ *
+ *   Concurrency cap   at most MaxConcurrent requests on the wire. Background
+ *                     requests leave the last slot to interactive ones.
+ *   Token bucket      sized from the provider's request limit headers
+ *                     (anthropic-ratelimit-requests-*, x-ratelimit-*-requests)
+ *                     and refilled per minute. Off until a response reports a limit.
+ *   Pause             a 429, an exhausted token budget or a Retry-After header
+ *                     holds the whole lane, not just the request that hit it.
+ *
+ * Failed attempts that are worth repeating (429, 408, 5xx, 529, connection
+ * errors) are re-queued after exponential backoff with jitter, up to
+ * MaxRetries. Queued requests are admitted interactive first, then in
+ * arrival order. Thread-safe; Pump runs the admitted requests on the caller's thread.
+ */
+class UEAGENTFORGE_API FAgentForgeLLMScheduler
+{
+public:
+	static constexpr int32  DefaultMaxConcurrent = 4;
+	static constexpr int32  DefaultMaxRetries = 4;
+	static constexpr double DefaultBackoffBaseSeconds = 1.0;
+	static constexpr double DefaultBackoffMaxSeconds = 60.0;
+
+	FAgentForgeLLMScheduler();
+
+	/** Start runs once the lane admits the request; Abort if it is cancelled while still queued. */
+	void Enqueue(
+		int32 RequestId,
+		EAgentForgeLLMProvider Provider,
+		EAgentForgeLLMPriority Priority,
+		TFunction<void()> Start,
+		TFunction<void()> Abort,
+		double DelaySeconds = 0.0);
+
+	/** Starts every queued request its lane has room for. */
+	void Pump();
+
+	/** Frees the lane slot and folds the response's rate-limit headers into the lane. Response may be null. */
+	void OnFinished(EAgentForgeLLMProvider Provider, const FHttpResponsePtr& Response);
+
+	/**
+	 * Delay before retrying a finished attempt (Attempt counts from 0), or a
+	 * negative value when it should not be retried. A rate-limited attempt
+	 * also pauses its lane for that long.
+	 */
+	double GetRetryDelay(EAgentForgeLLMProvider Provider, const FHttpResponsePtr& Response, bool bSucceeded, int32 Attempt);
+
+	/** Removes a queued request and calls its Abort. False when it is not queued. */
+	bool Cancel(int32 RequestId);
+
+	/** Drops every queued request without calling Abort (subsystem shutdown). */
+	void Reset();
+
+	bool HasQueued() const;
+
+	/** max_concurrent, max_retries, backoff_base_ms, backoff_max_ms. Limits apply to Provider only when it is set. */
+	void ApplyPolicy(const TSharedPtr<FJsonObject>& Args, const EAgentForgeLLMProvider* Provider = nullptr);
+
+	/** queued, in_flight, max_in_flight, retries, rate_limited, max_queue_wait_ms, policy and per-provider lanes. */
+	TSharedPtr<FJsonObject> GetStatsJson() const;
+
+private:
+	struct FQueued
+	{
+		int32  RequestId = 0;
+		EAgentForgeLLMProvider Provider = EAgentForgeLLMProvider::Anthropic;
+		EAgentForgeLLMPriority Priority = EAgentForgeLLMPriority::Interactive;
+		double EnqueuedAt = 0.0;
+		double NotBefore = 0.0;
+		uint64 Sequence = 0;
+		TFunction<void()> Start;
+		TFunction<void()> Abort;
+	};
+
+	struct FLane
+	{
+		int32  MaxConcurrent = DefaultMaxConcurrent;
+		int32  InFlight = 0;
+		double BucketCapacity = 0.0;   // 0 = no limit reported yet
+		double BucketTokens = 0.0;
+		double RefillPerSecond = 0.0;
+		double LastRefill = 0.0;
+		double PausedUntil = 0.0;
+		int64  Started = 0;
+		int64  Retries = 0;
+		int64  RateLimited = 0;
+	};
+
+	FLane& GetLane(EAgentForgeLLMProvider Provider);
+	bool   CanAdmit(FLane& Lane, EAgentForgeLLMPriority Priority, double Now);
+	void   ReadRateLimitHeaders(FLane& Lane, const FHttpResponsePtr& Response, double Now);
+
+	mutable FCriticalSection Lock;
+	TArray<FQueued> Queue;
+	TMap<EAgentForgeLLMProvider, FLane> Lanes;
+	uint64 NextSequence = 0;
+	int32  MaxRetries = DefaultMaxRetries;
+	double BackoffBaseSeconds = DefaultBackoffBaseSeconds;
+	double BackoffMaxSeconds = DefaultBackoffMaxSeconds;
+	int32  InFlight = 0;
+	int32  MaxInFlight = 0;
+	double MaxQueueWaitSeconds = 0.0;
+	int64  TotalRetries = 0;
+	int64  TotalRateLimited = 0;
+};
@@ -1,12 +1,22 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Dom/JsonObject.h"
 #include "EditorSubsystem.h"
+#include "HAL/CriticalSection.h"
+#include "Interfaces/IHttpRequest.h"
 #include "LLM/AgentForgeLLMTypes.h"
 #include "AgentForgeLLMSubsystem.generated.h"
 
+class FAgentForgeLLMScheduler;
 class IAgentForgeLLMProvider;
 
+using FAgentForgeLLMCompletion = TFunction<void(const FAgentForgeLLMResponse&)>;
+using FAgentForgeLLMChunkHandler = TFunction<void(const FString&)>;
+using FAgentForgeLLMAcceptor = TFunction<bool(const FAgentForgeLLMResponse&)>;
+using FAgentForgeLLMFanOutCompletion = TFunction<void(const FAgentForgeLLMFanOutResult&)>;
+
 UCLASS()
 class UEAGENTFORGE_API UAgentForgeLLMSubsystem : public UEditorSubsystem
 {
@@ -41,15 +51,127 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "AgentForge|LLM")
 	static TArray<FString> GetAvailableModels(EAgentForgeLLMProvider Provider);
 
-	FAgentForgeLLMResponse SendChatRequestBlocking(const FAgentForgeLLMSettings& Settings);
+	/**
+	 * Non-blocking request. OnComplete runs on the game thread once the HTTP
+	 * response arrives (or immediately on a setup error or a cache hit). The
+	 * request goes through the scheduler (FAgentForgeLLMScheduler): it waits
+	 * in Settings.Priority's lane while its provider is at its concurrency cap
+	 * or rate limit, and transient failures are retried with backoff before
+	 * OnComplete sees them. Returns the request id, 0 when the request
+	 * completed without being sent.
+	 *
+	 * With Settings.bStreamResponse the provider is asked for server-sent
+	 * events and OnChunk receives each text delta (game thread) as it is
+	 * read from the body. Without it, OnChunk gets the whole content once.
+	 */
+	int32 SendChatRequestAsync(
+		const FAgentForgeLLMSettings& Settings,
+		FAgentForgeLLMCompletion OnComplete,
+		FAgentForgeLLMChunkHandler OnChunk = nullptr);
+
+	/**
+	 * Waits for this request only: the scheduler and HTTP manager are ticked
+	 * until it completes, so other in-flight requests keep running instead of
+	 * being flushed along with it. OnChunk is called from inside the wait.
+	 */
+	FAgentForgeLLMResponse SendChatRequestBlocking(
+		const FAgentForgeLLMSettings& Settings,
+		FAgentForgeLLMChunkHandler OnChunk = nullptr);
 	FAgentForgeLLMResponse SendStructuredRequestBlocking(
 		const FString& Prompt,
 		const FString& JsonSchema,
 		const FAgentForgeLLMSettings& Settings);
 
+	/**
+	 * Sends the same request to every candidate (one FAgentForgeLLMSettings per
+	 * provider/model) and races them. A response counts once Acceptor passes it;
+	 * the default accepts a successful response whose content validates against
+	 * Settings.ResponseSchema when one is set.
+	 *
+	 * First mode completes with the first accepted response and cancels the
+	 * candidates still queued or on the wire; All mode waits for every candidate.
+	 * Candidates after the first are hedged: they wait HedgeDelaySeconds in the
+	 * scheduler, so a primary that answers within it costs no backup calls.
+	 * OnComplete runs on the game thread.
+	 */
+	void SendFanOutRequestAsync(
+		const TArray<FAgentForgeLLMSettings>& Candidates,
+		EAgentForgeLLMFanOutMode Mode,
+		double HedgeDelaySeconds,
+		FAgentForgeLLMFanOutCompletion OnComplete,
+		FAgentForgeLLMAcceptor Acceptor = nullptr);
+	FAgentForgeLLMFanOutResult SendFanOutRequestBlocking(
+		const TArray<FAgentForgeLLMSettings>& Candidates,
+		EAgentForgeLLMFanOutMode Mode,
+		double HedgeDelaySeconds,
+		FAgentForgeLLMAcceptor Acceptor = nullptr);
+
+	/** Cancels a queued or in-flight request; its completion reports as failed. */
+	void CancelRequest(int32 RequestId);
+
+	/** Requests that have not completed yet, queued or on the wire. */
+	int32 GetNumInFlightRequests() const;
+
+	/** See FAgentForgeLLMScheduler::ApplyPolicy. */
+	void ApplySchedulerPolicy(const TSharedPtr<FJsonObject>& Args, const EAgentForgeLLMProvider* Provider = nullptr);
+
+	/**
+	 * in_flight (on the wire), queued, max_in_flight, dispatched, streamed, completed, failed,
+	 * cancelled, fan_outs, fan_out_cancelled (candidates dropped once a race was won), the
+	 * prompt_tokens / cached_prompt_tokens / cache_write_tokens totals of provider responses,
+	 * and the scheduler's stats under "scheduler".
+	 */
+	TSharedPtr<FJsonObject> GetStatsJson() const;
+
 private:
+	struct FRequestContext;
+	using FRequestContextRef = TSharedRef<FRequestContext, ESPMode::ThreadSafe>;
+
 	TMap<EAgentForgeLLMProvider, TSharedPtr<IAgentForgeLLMProvider>> Providers;
+	TSharedPtr<FAgentForgeLLMScheduler, ESPMode::ThreadSafe> Scheduler;
+	FTSTicker::FDelegateHandle TickHandle;
+
+	mutable FCriticalSection InFlightLock;
+	TMap<int32, FRequestContextRef> InFlight;   // dispatched and not yet completed
+	int32 NextRequestId = 1;
+	int64 Dispatched = 0;
+	int64 Streamed = 0;
+	int64 Completed = 0;
+	int64 Failed = 0;
+	int64 Cancelled = 0;
+	int64 PromptTokens = 0;
+	int64 CachedPromptTokens = 0;
+	int64 CacheWriteTokens = 0;
+	int64 FanOuts = 0;
+	int64 FanOutCancelled = 0;
 
 	TSharedPtr<IAgentForgeLLMProvider> GetOrCreateProvider(EAgentForgeLLMProvider Provider);
-	FAgentForgeLLMResponse ExecuteBlockingRequest(const FAgentForgeLLMSettings& Settings);
+
+	bool Tick(float DeltaTime);
+	void StartAttempt(const FRequestContextRef& Context);
+	static void EnqueueAttempt(TWeakObjectPtr<UAgentForgeLLMSubsystem> WeakThis, const FRequestContextRef& Context, double DelaySeconds);
+	static void FinishRequest(TWeakObjectPtr<UAgentForgeLLMSubsystem> WeakThis, const FRequestContextRef& Context, FAgentForgeLLMResponse&& Response, bool bWholeChunk);
+
+	/**
+	 * bCompleteInline: call OnChunk / OnComplete on whichever thread the HTTP callback fires (blocking waits).
+	 * StartDelaySeconds holds the first attempt in the scheduler (hedged fan-out candidates).
+	 */
+	int32 DispatchRequest(
+		const FAgentForgeLLMSettings& Settings,
+		FAgentForgeLLMCompletion OnComplete,
+		FAgentForgeLLMChunkHandler OnChunk,
+		bool bCompleteInline,
+		double StartDelaySeconds = 0.0);
+	/** Returns the request ids in candidate order (0 where a candidate completed without being sent or was never dispatched). */
+	TArray<int32> DispatchFanOut(
+		const TArray<FAgentForgeLLMSettings>& Candidates,
+		EAgentForgeLLMFanOutMode Mode,
+		double HedgeDelaySeconds,
+		FAgentForgeLLMFanOutCompletion OnComplete,
+		FAgentForgeLLMAcceptor Acceptor,
+		bool bCompleteInline);
+	FAgentForgeLLMResponse ExecuteBlockingRequest(const FAgentForgeLLMSettings& Settings, FAgentForgeLLMChunkHandler OnChunk = nullptr);
+
+	/** Pumps the scheduler and HTTP manager until IsDone; past the blocking timeout the requests are cancelled. False on timeout. */
+	bool WaitForRequests(const TArray<int32>& RequestIds, const TFunction<bool()>& IsDone);
 };
@@ -12,6 +12,31 @@ enum class EAgentForgeLLMProvider : uint8
 	OpenAICompatible UMETA(DisplayName = "OpenAI-Compatible")
 };
 
+/** How a request uses FAgentForgeLLMResponseCache. */
+UENUM(BlueprintType)
+enum class EAgentForgeLLMCacheMode : uint8
+{
+	Bypass UMETA(DisplayName = "Bypass"),
+	Prefer UMETA(DisplayName = "Prefer"),
+	Only UMETA(DisplayName = "Only")
+};
+
+/** Scheduler lane. Interactive requests are admitted first; background ones never take a provider's last free slot. */
+UENUM(BlueprintType)
+enum class EAgentForgeLLMPriority : uint8
+{
+	Interactive UMETA(DisplayName = "Interactive"),
+	Background UMETA(DisplayName = "Background")
+};
+
+/** How a fan-out request settles. First: the first acceptable response wins and the rest are cancelled. All: wait for every candidate. */
+UENUM(BlueprintType)
+enum class EAgentForgeLLMFanOutMode : uint8
+{
+	First UMETA(DisplayName = "First Acceptable"),
+	All UMETA(DisplayName = "All")
+};
+
 USTRUCT(BlueprintType)
 struct FAgentForgeChatMessage
 {
@@ -28,6 +53,10 @@ struct FAgentForgeChatMessage
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AgentForge|LLM")
 	TArray<FString> ImageMediaTypes;
+
+	/** With FAgentForgeLLMSettings::bCachePrompt, ends a cacheable prefix after this message (Anthropic keeps the last three). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AgentForge|LLM")
+	bool bCacheBreakpoint = false;
 };
 
 USTRUCT(BlueprintType)
@@ -61,6 +90,21 @@ struct FAgentForgeLLMSettings
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AgentForge|LLM")
 	bool bStreamResponse = false;
+
+	/** Prefer: replay a cached response when one matches, else call and store. Only: never call the provider. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AgentForge|LLM")
+	EAgentForgeLLMCacheMode CacheMode = EAgentForgeLLMCacheMode::Bypass;
+
+	/**
+	 * Ask the provider to cache the static prompt prefix (system prompt + schema, then any
+	 * bCacheBreakpoint messages). Anthropic: cache_control blocks. OpenAI: prompt_cache_key.
+	 * DeepSeek and most compatible servers cache prefixes on their own.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AgentForge|LLM")
+	bool bCachePrompt = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AgentForge|LLM")
+	EAgentForgeLLMPriority Priority = EAgentForgeLLMPriority::Interactive;
 };
 
 USTRUCT(BlueprintType)
@@ -83,11 +127,52 @@ struct FAgentForgeLLMResponse
 	UPROPERTY(BlueprintReadOnly, Category = "AgentForge|LLM")
 	FString ReasoningContent;
 
+	/** Every prompt token, including the cached ones below. */
 	UPROPERTY(BlueprintReadOnly, Category = "AgentForge|LLM")
 	int32 PromptTokens = 0;
 
+	/** Prompt tokens the provider read from its prompt cache. */
+	UPROPERTY(BlueprintReadOnly, Category = "AgentForge|LLM")
+	int32 CachedPromptTokens = 0;
+
+	/** Prompt tokens written to the provider's prompt cache by this call (Anthropic only). */
+	UPROPERTY(BlueprintReadOnly, Category = "AgentForge|LLM")
+	int32 CacheWriteTokens = 0;
+
 	UPROPERTY(BlueprintReadOnly, Category = "AgentForge|LLM")
 	int32 CompletionTokens = 0;
+
+	/** Served from the vision capture cache or the LLM response cache instead of a provider call. */
+	UPROPERTY(BlueprintReadOnly, Category = "AgentForge|LLM")
+	bool bFromCache = false;
+};
+
+/** One provider/model a fan-out request is sent to; the rest of the settings are shared. */
+USTRUCT(BlueprintType)
+struct FAgentForgeLLMCandidate
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AgentForge|LLM")
+	EAgentForgeLLMProvider Provider = EAgentForgeLLMProvider::Anthropic;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AgentForge|LLM")
+	FString Model;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AgentForge|LLM")
+	FString CustomEndpoint;
+};
+
+/** Outcome of a fan-out request; the arrays are in candidate order. */
+struct FAgentForgeLLMFanOutResult
+{
+	TArray<FAgentForgeLLMResponse> Responses;
+	TArray<double> LatencyMs;       // dispatch to completion
+	TArray<bool> Accepted;
+	TArray<bool> Cancelled;         // settled by another candidate before it answered
+	int32 WinnerIndex = INDEX_NONE; // first accepted response to arrive
+
+	bool HasWinner() const { return Responses.IsValidIndex(WinnerIndex); }
 };
 
 DECLARE_DYNAMIC_DELEGATE_OneParam(FOnLLMResponseReceived, const FAgentForgeLLMResponse&, Response);
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "HAL/CriticalSection.h"
+
+/**
+ * A JSON schema compiled into a flat validator tree. Local $refs ("#/definitions/x",
+ * "#/$defs/x") are resolved to node indices at compile time, so recursive schemas
+ * share nodes instead of being walked again. Each node keeps its required keys,
+ * its properties as a hash map and string enums as a hash set. Immutable once
+ * built, so one compiled schema can be used from any thread.
+ *
+ * Supported keywords match the original walker: type (object, array, string,
+ * number, integer, boolean), properties, required, additionalProperties: false,
+ * items and enum. Other keywords are accepted without being checked.
+ */
+class UEAGENTFORGE_API FAgentForgeCompiledSchema
+{
+public:
+	/** OutError names the first failing path, e.g. "$.issues[2] must be a string.". */
+	bool Validate(const TSharedPtr<FJsonValue>& Value, FString* OutError = nullptr) const;
+	bool Validate(const TSharedPtr<FJsonObject>& Object, FString* OutError = nullptr) const;
+
+	int32 NumNodes() const { return Nodes.Num(); }
+
+private:
+	friend struct FAgentForgeSchemaCompiler;
+
+	enum class EType : uint8
+	{
+		Any,
+		Object,
+		Array,
+		String,
+		Number,
+		Integer,
+		Boolean
+	};
+
+	struct FNode
+	{
+		EType Type = EType::Any;
+		bool  bHasEnum = false;
+		bool  bClosed = false;                   // additionalProperties: false next to properties
+		TSet<FString> EnumStrings;
+		TArray<TSharedPtr<FJsonValue>> EnumOthers;   // numbers, booleans, null
+		TArray<FString> Required;
+		TMap<FString, int32> Properties;         // property name -> node
+		int32 Items = INDEX_NONE;
+	};
+
+	/** Path is only built (non-null) on the second pass that reports an error. */
+	bool ValidateNode(int32 NodeIndex, const TSharedPtr<FJsonValue>& Value, const FString* Path, FString* OutError) const;
+
+	TArray<FNode> Nodes;   // root is node 0
+};
+
+using FAgentForgeCompiledSchemaPtr = TSharedPtr<const FAgentForgeCompiledSchema, ESPMode::ThreadSafe>;
+
+/**
+ * Process-wide cache of compiled schemas, keyed by schema text, plus the bundled
+ * schema files (Content/AgentForge/Schemas, project first, then plugin), which
+ * are read from disk once. Thread-safe.
+ */
+class UEAGENTFORGE_API FAgentForgeSchemaRegistry
+{
+public:
+	static constexpr int32 DefaultCapacity = 128;
+
+	static FAgentForgeSchemaRegistry& Get();
+
+	/** Compiled on first use. Null with OutError when the text is not a JSON object. */
+	FAgentForgeCompiledSchemaPtr Compile(const FString& SchemaString, FString* OutError = nullptr);
+
+	/** Bundled schema by file name (".json" optional). */
+	FAgentForgeCompiledSchemaPtr FindByName(const FString& SchemaFileName, FString* OutError = nullptr);
+	bool LoadSchemaText(const FString& SchemaFileName, FString& OutText);
+
+	/** Forget compiled schemas and loaded files, e.g. after editing a schema on disk. */
+	void Clear();
+
+	/** compiled, capacity, files, hits, misses, compile_errors. */
+	TSharedPtr<FJsonObject> GetStatsJson() const;
+
+private:
+	mutable FCriticalSection Lock;
+	TMap<FString, FAgentForgeCompiledSchemaPtr> Compiled;   // by schema text
+	TMap<FString, FString> Files;                           // normalized file name -> text
+	int64 Hits = 0;
+	int64 Misses = 0;
+	int64 CompileErrors = 0;
+};
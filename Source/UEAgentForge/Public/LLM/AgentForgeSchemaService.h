@@ -1,6 +1,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Dom/JsonValue.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "LLM/AgentForgeLLMTypes.h"
 #include "AgentForgeSchemaService.generated.h"
@@ -25,6 +26,9 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "AgentForge|Schema")
 	static bool ValidateJsonAgainstSchema(const FString& JsonString, const FString& SchemaString);
 
+	/** Validates an already parsed value; the schema is compiled once (FAgentForgeSchemaRegistry). */
+	static bool ValidateJsonValue(const TSharedPtr<FJsonValue>& Value, const FString& SchemaString, FString& OutError);
+
 	static FAgentForgeLLMResponse RequestStructuredOutputBlocking(
 		const FString& Prompt,
 		const FString& JsonSchemaString,
@@ -33,5 +37,6 @@ public:
 		const FString& SystemPrompt = FString(),
 		int32 MaxTokens = 1024,
 		float Temperature = 0.2f,
-		const FString& CustomEndpoint = FString());
+		const FString& CustomEndpoint = FString(),
+		EAgentForgeLLMCacheMode CacheMode = EAgentForgeLLMCacheMode::Bypass);
 };
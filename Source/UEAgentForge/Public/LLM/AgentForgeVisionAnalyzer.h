@@ -33,24 +33,46 @@ public:
 		EAgentForgeLLMProvider Provider = EAgentForgeLLMProvider::Anthropic,
 		const FString& Model = TEXT("claude-sonnet-4-20250514"));
 
+	/**
+	 * Blocking variants. With bUseCaptureCache, a frame set that matches a
+	 * recent request perceptually (FAgentForgeVisionCache) returns the stored
+	 * response with bFromCache set instead of calling the provider.
+	 */
 	static FAgentForgeLLMResponse AnalyzeViewportBlocking(
 		const FString& AnalysisPrompt,
 		EAgentForgeLLMProvider Provider = EAgentForgeLLMProvider::Anthropic,
-		const FString& Model = TEXT("claude-sonnet-4-20250514"));
+		const FString& Model = TEXT("claude-sonnet-4-20250514"),
+		bool bUseCaptureCache = true);
 
 	static FAgentForgeLLMResponse AnalyzeScreenshotBlocking(
 		const FString& ScreenshotPath,
 		const FString& AnalysisPrompt,
 		EAgentForgeLLMProvider Provider = EAgentForgeLLMProvider::Anthropic,
-		const FString& Model = TEXT("claude-sonnet-4-20250514"));
+		const FString& Model = TEXT("claude-sonnet-4-20250514"),
+		bool bUseCaptureCache = true);
 
 	static FAgentForgeLLMResponse AnalyzeMultiViewBlocking(
 		const FString& AnalysisPrompt,
 		EAgentForgeLLMProvider Provider = EAgentForgeLLMProvider::Anthropic,
-		const FString& Model = TEXT("claude-sonnet-4-20250514"));
+		const FString& Model = TEXT("claude-sonnet-4-20250514"),
+		bool bUseCaptureCache = true);
 
 	static FAgentForgeLLMResponse RequestQualityScoreBlocking(
 		EAgentForgeLLMProvider Provider = EAgentForgeLLMProvider::Anthropic,
 		const FString& Model = TEXT("claude-sonnet-4-20250514"),
-		bool bMultiView = false);
+		bool bMultiView = false,
+		bool bUseCaptureCache = true);
+
+	/**
+	 * Scores one capture with every candidate (UAgentForgeLLMSubsystem::SendFanOutRequestAsync).
+	 * The frames are captured and fingerprinted once and encoded once per provider; each
+	 * candidate consults the capture cache under its own provider/model. Accepted responses
+	 * are schema-valid and are stored in the cache.
+	 */
+	static FAgentForgeLLMFanOutResult RequestQualityScoreFanOutBlocking(
+		const TArray<FAgentForgeLLMCandidate>& Candidates,
+		EAgentForgeLLMFanOutMode Mode = EAgentForgeLLMFanOutMode::First,
+		double HedgeDelaySeconds = 0.0,
+		bool bMultiView = false,
+		bool bUseCaptureCache = true);
 };
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "HAL/CriticalSection.h"
+#include "LLM/AgentForgeLLMTypes.h"
+
+/** Perceptual fingerprint of one captured frame (see FSceneCapture::ComputeImageFeatures). */
+struct UEAGENTFORGE_API FAgentForgeFrameFingerprint
+{
+	TArray<float> Features;
+	uint64        Hash = 0;
+};
+
+/**
+ * Recent vision responses keyed by request (provider, model, prompt, schema)
+ * and the perceptual fingerprints of the frames sent with it. A lookup hits
+ * when the request key matches and every frame is within MaxHashDistance
+ * bits and at least MinSimilarity correlated with the stored frame, so an
+ * unchanged viewport between quality-loop iterations does not pay for
+ * another model call. Only successful responses are stored.
+ */
+class UEAGENTFORGE_API FAgentForgeVisionCache
+{
+public:
+	static constexpr int32  DefaultCapacity = 32;
+	static constexpr double DefaultMaxAgeSeconds = 600.0;
+	static constexpr float  DefaultMinSimilarity = 0.985f;
+	static constexpr int32  DefaultMaxHashDistance = 6;
+
+	static FAgentForgeVisionCache& Get();
+
+	static FString MakeRequestKey(EAgentForgeLLMProvider Provider, const FString& Model, const FString& Prompt, const FString& ResponseSchema);
+
+	bool Find(const FString& RequestKey, const TArray<FAgentForgeFrameFingerprint>& Frames, FAgentForgeLLMResponse& OutResponse);
+	void Store(const FString& RequestKey, TArray<FAgentForgeFrameFingerprint> Frames, const FAgentForgeLLMResponse& Response);
+	void Clear();
+
+	/** min_similarity, max_hash_distance, max_age_seconds, capacity, enabled. */
+	void ApplyPolicy(const TSharedPtr<FJsonObject>& Args);
+	bool IsEnabled() const;
+
+	TSharedPtr<FJsonObject> GetStatsJson() const;
+
+private:
+	struct FEntry
+	{
+		FString                             RequestKey;
+		TArray<FAgentForgeFrameFingerprint> Frames;
+		FAgentForgeLLMResponse              Response;
+		double                              StoredAt = 0.0;
+	};
+
+	mutable FCriticalSection Lock;
+	TArray<FEntry> Entries;       // most recent last
+	bool   bEnabled = true;
+	int32  Capacity = DefaultCapacity;
+	double MaxAgeSeconds = DefaultMaxAgeSeconds;
+	float  MinSimilarity = DefaultMinSimilarity;
+	int32  MaxHashDistance = DefaultMaxHashDistance;
+	int64  Hits = 0;
+	int64  Misses = 0;
+	int64  Stores = 0;
+	float  LastSimilarity = 0.0f;
+};
@@ -5,6 +5,19 @@
 #include "Interfaces/IHttpResponse.h"
 #include "LLM/AgentForgeLLMTypes.h"
 
+/** Accumulated state of one server-sent-event completion. */
+struct FAgentForgeLLMStreamState
+{
+	FString Content;
+	FString ReasoningContent;
+	FString ErrorMessage;
+	int32 PromptTokens = 0;
+	int32 CachedPromptTokens = 0;
+	int32 CacheWriteTokens = 0;
+	int32 CompletionTokens = 0;
+	bool bDone = false;
+};
+
 class IAgentForgeLLMProvider
 {
 public:
@@ -20,6 +33,18 @@ public:
 		const FHttpResponsePtr& HttpResponse,
 		bool bSucceeded) const = 0;
 
+	/** True when PrepareRequest asks for an SSE body while Settings.bStreamResponse is set. */
+	virtual bool SupportsStreaming() const { return false; }
+
+	/** Folds one SSE frame into State; OutDelta receives the text it added, if any. */
+	virtual void ParseStreamEvent(
+		const FString& EventName,
+		const FString& Data,
+		FAgentForgeLLMStreamState& State,
+		FString& OutDelta) const
+	{
+	}
+
 	virtual FString GetDefaultEndpoint(const FAgentForgeLLMSettings& Settings) const = 0;
 	virtual TArray<FString> GetAvailableModels() const = 0;
 };
@@ -0,0 +1,101 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// RoomGraphLayout — overlap-free room placement, graph connectivity and corridor routing.
+//
+// create_blockout_level's original layout is a linear chain. layout:"graph"
+// plans large blockouts (up to a few hundred rooms) in four passes, all on a
+// cell grid of CellSize cm:
+//
+//   Place     rooms of RoomCells min..max side are dropped at random free
+//             positions on an occupancy grid; a room must keep Padding empty
+//             cells to every other room, so rooms never overlap or touch.
+//             The grid grows when a room finds no free spot.
+//   Connect   Delaunay triangulation of the room centres (Bowyer-Watson),
+//             its minimum spanning tree (Kruskal), plus LoopFraction of the
+//             remaining Delaunay edges so the graph has cycles.
+//   Order     entry and exit are the two ends of the graph diameter; rooms
+//             are ordered by hop depth from the entry, with the climax (the
+//             deepest neighbour of the exit) second to last and the exit last.
+//   Route     A* on the grid per edge, shortest first: other rooms block,
+//             turns cost extra and cells an earlier corridor already uses
+//             cost less, so corridors merge instead of running in parallel.
+//
+// Generate is pure computation with no UObject access, so the blockout job
+// runs it on the thread pool and only spawns on the game thread. The layout is
+// a function of its settings alone, so the job keeps it in the procedural
+// cache under MakeCacheKey; farm workers (AgentForgeWorkerFarm.h) fill the
+// same entries from other machines.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"   // explicit with NoPCHs
+
+struct UEAGENTFORGE_API FRoomLayoutSettings
+{
+	int32     RoomCount = 12;
+	int32     Seed = 1337;
+	float     CellSize = 400.0f;               // cm per grid cell
+	FIntPoint RoomCells = FIntPoint(2, 4);     // min / max room side, in cells
+	int32     Padding = 1;                     // empty cells kept between rooms (>= 1)
+	float     LoopFraction = 0.15f;            // share of non-tree Delaunay edges kept
+	float     TurnCost = 0.5f;                 // extra A* cost per corridor bend
+	float     ReuseCost = 0.5f;                // A* step cost on existing corridor cells
+};
+
+struct UEAGENTFORGE_API FLayoutRoom
+{
+	FIntRect Cells;          // Min inclusive, Max exclusive
+	FString  Role;           // Entry, Exploration, Climax, Exit
+	int32    Depth = 0;      // graph hops from the entry
+};
+
+struct UEAGENTFORGE_API FLayoutCorridor
+{
+	int32 RoomA = INDEX_NONE;
+	int32 RoomB = INDEX_NONE;
+	bool  bLoop = false;
+	TArray<FVector2D> Points;   // polyline in cell units, room wall to room wall; bends only
+};
+
+struct UEAGENTFORGE_API FRoomLayout
+{
+	TArray<FLayoutRoom>     Rooms;       // entry first, exit last
+	TArray<FLayoutCorridor> Corridors;   // routed edges only
+	FIntPoint GridSize = FIntPoint::ZeroValue;
+	float     CellSize = 400.0f;
+	FVector2D OriginCell = FVector2D::ZeroVector;   // cell position mapped to world (0,0): the entry centre
+
+	int32  DelaunayEdges = 0;
+	int32  TreeEdges = 0;
+	int32  LoopEdges = 0;
+	int32  Unrouted = 0;
+	int32  CorridorCells = 0;
+	int32  GridGrowths = 0;
+	double PlaceMs = 0.0;
+	double GraphMs = 0.0;
+	double RouteMs = 0.0;
+
+	/** Cell-space point to world cm at Z = 0. */
+	FVector ToWorld(const FVector2D& Cell) const;
+	FVector RoomCenter(int32 Room) const;
+	/** Width (X) and depth (Y) in cm. */
+	FVector2D RoomSize(int32 Room) const;
+
+	TSharedPtr<FJsonObject> GetStatsJson() const;
+};
+
+class UEAGENTFORGE_API FRoomGraphLayout
+{
+public:
+	/** Thread-safe. False with OutError only for invalid settings. */
+	static bool Generate(const FRoomLayoutSettings& Settings, FRoomLayout& OutLayout, FString& OutError);
+
+	/** Procedural cache kind of serialized layouts. */
+	static const TCHAR* const CacheKind;
+
+	/** Cache key over every setting Generate reads. */
+	static FString MakeCacheKey(const FRoomLayoutSettings& Settings);
+
+	/** Versioned binary form for the cache. A version mismatch sets the archive error. */
+	static void Serialize(FArchive& Ar, FRoomLayout& Layout);
+};
@@ -15,8 +15,13 @@
 
 #include "CoreMinimal.h"
 #include "Dom/JsonObject.h"   // explicit with NoPCHs
+#include "AgentForgeRuntimeCost.h"
 #include "LevelPresetSystem.h"
 
+class FAgentForgeJob;
+struct FAgentForgeInstanceBatch;
+struct FAssetData;
+
 class UEAGENTFORGE_API FLevelPipelineModule
 {
 public:
@@ -28,35 +33,49 @@ public:
 	 *  Parses the mission description for room intent, generates a bubble-diagram
 	 *  layout, and places BSP-style box actors as blockout rooms + corridors.
 	 *
-	 *  args: { "mission": "...", "preset": "Horror", "room_count": 3, "grid_size": 400 }
+	 *  args: { "mission": "...", "preset": "Horror", "room_count": 3, "grid_size": 400,
+	 *          "layout": "chain"|"graph", "seed": 1337 }
 	 *  returns: { ok, rooms_placed, corridors_placed, total_area_sqm,
 	 *             room_positions:[{label,x,y,z,width,depth,height}],
-	 *             navmesh_placed, player_start_placed } */
+	 *             navmesh_placed, player_start_placed, layout, [layout_stats] }
+	 *  "graph" (up to 500 rooms) plans with FRoomGraphLayout on the thread pool. */
 	static FString CreateBlockoutLevel(const TSharedPtr<FJsonObject>& Args);
 
 	/** Phase II — Architectural Whitebox.
 	 *  Locates Blockout_* actors, lists kit meshes from kit_path, snaps to grid,
-	 *  replaces primitives with modular wall/floor/ceiling pieces.
+	 *  replaces primitives with modular wall/floor/ceiling pieces. Each piece
+	 *  gets the kit mesh (by ApproxSize tag, yaw 0 or 90) it scales to most
+	 *  uniformly; assignments are planned on the thread pool, the distinct
+	 *  meshes stream in as one async batch, and the swaps spawn batched.
 	 *
 	 *  args: { "kit_path": "/Game/Gothic_Cathedral/Meshes", "snap_grid": 50 }
-	 *  returns: { ok, pieces_placed, blockout_replaced, snap_grid,
-	 *             arch_labels:[] } */
+	 *  returns: { ok, pieces_placed, blockout_replaced, snap_grid, kit_meshes,
+	 *             meshes_requested, meshes_loaded, size_matched, cube_fallbacks,
+	 *             plan_ms, load_ms, swap_ms, arch_labels:[] } */
 	static FString ConvertToWhiteboxModular(const TSharedPtr<FJsonObject>& Args);
 
 	/** Phase III — Beauty Pass & Set Dressing.
 	 *  For each room, determines story context from story_theme, scatters props
 	 *  at thematically appropriate positions, builds micro-story arrangements.
 	 *
-	 *  args: { "story_theme": "abandoned asylum", "prop_density": 0.5 }
-	 *  returns: { ok, props_placed, micro_stories, rooms_dressed } */
+	 *  args: { "story_theme": "abandoned asylum", "prop_density": 0.5,
+	 *          "output": "actors"|"instances", "rooms": ["Blockout_Room_03"] }
+	 *  returns: { ok, props_placed, micro_stories, rooms_dressed, output,
+	 *             rooms:[{label, props}], [instance_actor] }
+	 *  "instances" writes every prop into one HISM on a Prop_Instances_* actor.
+	 *  "rooms" limits the pass to those room labels; props are added to what is there. */
 	static FString ApplySetDressingAndStorytelling(const TSharedPtr<FJsonObject>& Args);
 
 	/** Phase IV — Lighting & Atmosphere.
 	 *  Places key/fill/rim lights by time_of_day and mood, applies PP from preset,
 	 *  adds ExponentialHeightFog, optionally places god-ray SpotLight.
 	 *
-	 *  args: { "time_of_day": "midnight", "mood": "fearful", "enable_god_rays": false }
-	 *  returns: { ok, lights_placed, horror_score, atmosphere, fog_density } */
+	 *  args: { "time_of_day": "midnight", "mood": "fearful", "enable_god_rays": false,
+	 *          "rooms": ["Blockout_Room_03"] }
+	 *  returns: { ok, lights_placed, horror_score, atmosphere, fog_density,
+	 *             lights_downgraded, lights_merged, lights_culled, runtime_cost:{} }
+	 *  "rooms" places fill lights for those rooms only and keeps an existing
+	 *  Pipeline_KeyLight / Pipeline_GodRay. */
 	static FString ApplyProfessionalLightingAndAtmosphere(const TSharedPtr<FJsonObject>& Args);
 
 	/** Phase V — Living Systems.
@@ -64,19 +83,40 @@ public:
 	 *  places AudioVolume actors for localised soundscapes.
 	 *
 	 *  args: { "ambient_vfx": ["dust","embers"], "soundscape": "asylum_ambience" }
-	 *  returns: { ok, vfx_placed, audio_placed, vfx_names:[] } */
+	 *  returns: { ok, vfx_placed, audio_placed, vfx_names:[], vfx_culled,
+	 *             audio_merged, audio_culled, runtime_cost:{} } */
 	static FString AddLivingSystemsAndPolish(const TSharedPtr<FJsonObject>& Args);
 
 	/** Master orchestrator — runs all 5 phases in sequence with closed-loop quality.
 	 *  If EvaluateLevelQuality() < quality_threshold and iteration < max_iterations,
-	 *  the loop re-runs Phase IV + Phase V to improve atmospheric quality.
+	 *  the failed checks are traced to the phase output they read and only that
+	 *  phase reruns, on the affected rooms: Phase III where props or actors are
+	 *  short, Phase IV where no fill light exists. Phase V runs once. The loop
+	 *  stops early when no failed check can be changed by a rerun.
 	 *
 	 *  args: { "mission": "...", "preset": "Horror", "max_iterations": 3,
 	 *          "quality_threshold": 0.75 }
 	 *  returns: { ok, phase1:{}, phase2:{}, phase3:{}, phase4:{}, phase5:{},
-	 *             final_quality_score, iterations, screenshot_path, level_saved } */
+	 *             final_quality_score, iterations, stop_reason,
+	 *             iteration_log:[{iteration, quality_score, shortfalls,
+	 *             rerun_dressing, rerun_lighting, [phase3], [phase4]}],
+	 *             screenshot_path, level_saved } */
 	static FString GenerateFullQualityLevel(const TSharedPtr<FJsonObject>& Args);
 
+	// ──────────────────────────────────────────────────────────────────────────
+	//  Staged job forms (used for "async":true; the FString entry points above
+	//  run the same job inline via RunToCompletion)
+	// ──────────────────────────────────────────────────────────────────────────
+
+	/** Phase I as a job: layout → plan (graph layout wait) → rooms (batched per slice) → corridors → navigation. */
+	static TSharedRef<FAgentForgeJob> MakeCreateBlockoutLevelJob(const TSharedPtr<FJsonObject>& Args);
+
+	/** Phase II as a job: collect → plan (thread-pool assignment wait) → load (one streaming batch) → swap (batched per slice). */
+	static TSharedRef<FAgentForgeJob> MakeConvertToWhiteboxModularJob(const TSharedPtr<FJsonObject>& Args);
+
+	/** Full pipeline as a job: Phase I (nested job) → II (nested job) → III → IV+V (one iteration per slice). */
+	static TSharedRef<FAgentForgeJob> MakeGenerateFullQualityLevelJob(const TSharedPtr<FJsonObject>& Args);
+
 private:
 	// ──────────────────────────────────────────────────────────────────────────
 	//  Phase I helpers
@@ -99,30 +139,33 @@ private:
 	                                       const TArray<FVector>& RoomCenters,
 	                                       float CorridorWidth, float CeilingHeight);
 
+	/** Spawn one box per straight run of each routed graph-layout corridor
+	 *  (Blockout_Corridor_NN_MM). Returns the number of corridors placed. */
+	static int32 PlaceLayoutCorridors(UWorld* World,
+	                                  const TArray<TArray<FVector>>& Paths,
+	                                  float CorridorWidth, float CeilingHeight);
+
 	// ──────────────────────────────────────────────────────────────────────────
 	//  Phase II helpers
 	// ──────────────────────────────────────────────────────────────────────────
 
-	/** Return all asset paths inside KitPath that look like wall/floor/ceiling meshes. */
-	static TArray<FString> FindModularKitMeshes(const FString& KitPath);
+	/** Return all static meshes inside KitPath (wall/floor/ceiling kit pieces), from the asset catalog. */
+	static TArray<FAssetData> FindModularKitMeshes(const FString& KitPath);
 
 	/** Snap Value to the nearest multiple of GridSize. */
 	static float SnapToGrid(float Value, float GridSize);
 
-	/** Replace Blockout_* actors in World with modular pieces from KitPath.
-	 *  New actors are labeled Arch_Room_NN_Wall/Floor/Ceiling_XX. */
-	static int32 ReplaceBlockoutWithModular(UWorld* World, const FString& KitPath,
-	                                         float SnapGrid);
-
 	// ──────────────────────────────────────────────────────────────────────────
 	//  Phase III helpers
 	// ──────────────────────────────────────────────────────────────────────────
 
 	/** Scatter generic StaticMeshActors (cubes) as prop stand-ins within a room
-	 *  radius, biased towards dark corners / occluded spots via SemanticCommandModule. */
+	 *  radius, biased towards dark corners / occluded spots via SemanticCommandModule.
+	 *  With OutInstances the transforms are appended there instead of spawned. */
 	static int32 ScatterPropsInRoom(UWorld* World, const FVector& RoomCenter,
 	                                 float Radius, float Density,
-	                                 const FString& StoryTheme, int32 RoomIndex);
+	                                 const FString& StoryTheme, int32 RoomIndex,
+	                                 FAgentForgeInstanceBatch* OutInstances = nullptr);
 
 	/** Raycast downward from random points inside a disc to find a valid floor hit. */
 	static FVector FindPropPlacementPoint(UWorld* World, const FVector& Center,
@@ -133,9 +176,14 @@ private:
 	// ──────────────────────────────────────────────────────────────────────────
 
 	/** Spawn and configure the primary key light (DirectionalLight or skylight
-	 *  proxy) based on time-of-day string. */
+	 *  proxy) based on time-of-day string. Fill lights and the god ray go
+	 *  through a runtime-cost planner: merged, downgraded or culled to stay
+	 *  within Budget, recorded in OutActions. */
 	static int32 SetupKeyLighting(UWorld* World, const FString& TimeOfDay,
-	                               const FString& Mood, const FLevelPreset& Preset);
+	                               const FString& Mood, const FLevelPreset& Preset,
+	                               const TSet<FString>& RoomFilter,
+	                               const FAgentForgeRuntimeCost::FBudget& Budget,
+	                               FAgentForgeRuntimeCost::FActions& OutActions);
 
 	/** Add or update ExponentialHeightFog with preset density and colour. */
 	static void ApplyAtmosphericScattering(UWorld* World, float FogDensity,
@@ -149,15 +197,19 @@ private:
 	// ──────────────────────────────────────────────────────────────────────────
 
 	/** Spawn NiagaraActor stand-ins (labeled VFX_{name}_NN) at scattered positions.
-	 *  Returns count placed. */
+	 *  Emitters past the overdraw budget are culled.  Returns count placed. */
 	static int32 SpawnAmbientParticles(UWorld* World,
 	                                    const TArray<FString>& VfxNames,
-	                                    float Density);
+	                                    float Density,
+	                                    const FAgentForgeRuntimeCost::FBudget& Budget,
+	                                    FAgentForgeRuntimeCost::FActions& OutActions);
 
 	/** Place AudioVolume actors (labeled Audio_{soundscape}_NN) near room centres.
-	 *  Returns count placed. */
+	 *  Past the voice budget a room is merged into the nearest emitter.  Returns count placed. */
 	static int32 PlaceAmbientAudioEmitters(UWorld* World,
-	                                        const FString& Soundscape);
+	                                        const FString& Soundscape,
+	                                        const FAgentForgeRuntimeCost::FBudget& Budget,
+	                                        FAgentForgeRuntimeCost::FActions& OutActions);
 
 	// ──────────────────────────────────────────────────────────────────────────
 	//  Quality evaluation
@@ -168,7 +220,8 @@ private:
 	 *          navmesh volume present, horror score vs preset threshold. */
 	static float EvaluateLevelQuality(UWorld* World, const FLevelPreset& Preset);
 
-	/** Return a human-readable quality report JSON object. */
+	/** Return a human-readable quality report JSON object, with the predicted
+	 *  runtime_cost of lights, particles and audio against the preset budget. */
 	static TSharedPtr<FJsonObject> BuildQualityReport(UWorld* World,
 	                                                   const FLevelPreset& Preset);
 };
@@ -6,7 +6,15 @@
 // magic numbers scattered across the codebase.
 //
 // Built-in presets: Default, Horror, SciFi, Fantasy, Military.
-// Custom presets are persisted as JSON in Content/AgentForge/Presets/.
+// Custom presets are persisted as JSON in Saved/AgentForge/Presets/ (the
+// legacy Content/AgentForge/Presets/ is still read; Saved wins on a clash).
+//
+// Preset store: the first preset call indexes only each file's header
+// (preset_name, genre, tags) from its first few KB, plus its timestamp. A
+// preset is parsed into LoadedPresets the first time it is used and served
+// from there afterwards. Directory watchers on both folders re-read the
+// header of a changed file and drop its parsed copy, so nothing rescans the
+// folders per command.
 
 #pragma once
 
@@ -14,6 +22,8 @@
 #include "Dom/JsonObject.h"   // explicit with NoPCHs
 #include "Math/Color.h"
 
+struct FFileChangeData;
+
 // ─────────────────────────────────────────────────────────────────────────────
 //  FLevelPreset — one complete art/gameplay configuration bundle
 // ─────────────────────────────────────────────────────────────────────────────
@@ -21,6 +31,8 @@
 struct UEAGENTFORGE_API FLevelPreset
 {
 	FString PresetName;
+	FString Genre;
+	TArray<FString> Tags;
 	FString Description;
 
 	// ── Phase I metrics (gameplay / blockout scale) ───────────────────────────
@@ -53,6 +65,11 @@ struct UEAGENTFORGE_API FLevelPreset
 	float   TargetLightingCoverage  = 0.7f;
 	int32   MinActorCount           = 10;
 	int32   MaxActorCount           = 500;
+
+	// ── Runtime budgets (placement stays within these, see AgentForgeRuntimeCost) ──
+	int32   MaxShadowLightOverlap   = 4;      // shadow-casting lights overlapping any one
+	float   MaxParticleOverdraw     = 4.f;    // emitter weight near any one emitter
+	int32   MaxAudioVoices          = 16;     // audio emitters audible together
 };
 
 // ─────────────────────────────────────────────────────────────────────────────
@@ -74,8 +91,8 @@ public:
 	 *  Returns: { ok, saved_path } */
 	static FString SavePreset(const TSharedPtr<FJsonObject>& Args);
 
-	/** Return all known preset names (built-in + discovered JSON files).
-	 *  Returns: { presets: ["Default","Horror","SciFi","Fantasy","Military",...] } */
+	/** Return all known preset names (built-in + indexed JSON headers), without parsing presets.
+	 *  Returns: { presets: ["Default","Horror","SciFi","Fantasy","Military",...], details: [{name, genre, tags, source, parsed}] } */
 	static FString ListPresets();
 
 	/** Analyse the current level + project content and recommend the best preset.
@@ -89,23 +106,54 @@ public:
 
 	// ── Internal helpers ──────────────────────────────────────────────────────
 
-	/** Set the active preset by name.  Returns false if not found. */
+	/** Set the active preset by name, parsing it on first use.  Returns false if not found. */
 	static bool SetCurrentPreset(const FString& Name);
 
-	/** Register all built-in presets.  Called once during module startup. */
+	/** Register the built-in presets, index preset file headers and start the directory watchers.
+	 *  Idempotent; every preset entry point calls it. */
 	static void RegisterBuiltinPresets();
 
+	/** Stop the directory watchers.  Called at engine pre-exit. */
+	static void ShutdownPresetStore();
+
 	/** Return the active FLevelPreset (read-only ref for pipeline phases). */
 	static const FLevelPreset& GetCurrentPresetData();
 
-	// ── Static storage (initialised by RegisterBuiltinPresets) ───────────────
-	static TMap<FString, FLevelPreset> LoadedPresets;
+	/** headers, parsed, header_reads, full_parses, watcher_events, rescans, watching. */
+	static TSharedPtr<FJsonObject> GetStatsJson();
+
+	// ── Static storage ───────────────────────────────────────────────────────
+	static TMap<FString, FLevelPreset> LoadedPresets;   // parsed presets (built-ins + files used so far)
 	static FString                     CurrentPresetName;
 
 private:
+	struct FPresetHeader
+	{
+		FString         Name;
+		FString         Genre;
+		TArray<FString> Tags;
+		FString         FilePath;
+		FDateTime       ModifiedTime;
+		int64           FileSize = -1;
+		bool            bLegacy = false;
+	};
+
 	// Serialisation helpers
 	static TSharedPtr<FJsonObject> PresetToJson(const FLevelPreset& P);
 	static FLevelPreset            JsonToPreset(const TSharedPtr<FJsonObject>& Json);
-	static FString                 PresetDir();           // Content/AgentForge/Presets/
-	static void                    ScanPresetDir();       // load JSON files from disk
+	static FString                 PresetDir();           // Saved/AgentForge/Presets/
+
+	// Preset store
+	static void                 ScanPresetDir();                                     // index every file header (startup, rescan)
+	static void                 IndexPresetFile(const FString& FilePath, bool bLegacy);
+	static bool                 ReadPresetHeader(const FString& FilePath, FPresetHeader& OutHeader);
+	static void                 RebuildPresetNames();
+	static const FPresetHeader* FindPresetHeader(const FString& NameOrFile);
+	static const FLevelPreset*  EnsurePresetParsed(const FString& Name);
+	static void                 HandlePresetDirChanged(const TArray<FFileChangeData>& Changes, bool bLegacy);
+
+	static TMap<FString, FLevelPreset>  BuiltinPresets;
+	static TArray<FString>              BuiltinOrder;
+	static TMap<FString, FPresetHeader> PresetFiles;     // by absolute file path
+	static TMap<FString, FString>       PresetByName;    // preset name -> winning file path
 };
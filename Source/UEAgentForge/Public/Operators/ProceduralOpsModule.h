@@ -6,6 +6,8 @@
 #include "CoreMinimal.h"
 #include "Dom/JsonObject.h"
 
+class FAgentForgeJob;
+
 /**
  * Operator-centric procedural command surface.
  *
@@ -22,6 +24,8 @@ public:
 	static FString GetOperatorPolicy();
 	static FString SetOperatorPolicy(const TSharedPtr<FJsonObject>& Args);
 	static bool IsOperatorOnlyMode();
+	// Drops cached heightmaps / distribution point sets (include_disk also clears Saved/AgentForgeCache).
+	static FString ClearOperatorCache(const TSharedPtr<FJsonObject>& Args);
 
 	// Constrained operators
 	static FString TerrainGenerate(const TSharedPtr<FJsonObject>& Args);
@@ -33,5 +37,9 @@ public:
 
 	// Deterministic orchestration
 	static FString RunOperatorPipeline(const TSharedPtr<FJsonObject>& Args);
+	// Staged form of RunOperatorPipeline (one job stage per operator) for async execution.
+	static TSharedRef<FAgentForgeJob> MakeOperatorPipelineJob(const TSharedPtr<FJsonObject>& Args);
+	// Destroys the actors recorded by an undo_mode=snapshot pipeline (pipeline_id, default the latest).
+	static FString UndoOperatorPipeline(const TSharedPtr<FJsonObject>& Args);
 };
 
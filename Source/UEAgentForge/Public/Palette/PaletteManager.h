@@ -1,10 +1,24 @@
 // Copyright UEAgentForge Project. All Rights Reserved.
 // PaletteManager - curated asset palette loading utilities.
+//
+// Palette files are parsed once and cached by absolute path; a cached entry
+// is reused while the file's modification time and size are unchanged, so
+// the op_* stages of a pipeline share one parse. The returned object is the
+// cached one and must be treated as read-only.
+//
+// With bPreloadAssets, resolving a palette also starts one async
+// FStreamableManager batch load of every asset path it references. The
+// handle is held with the cache entry, so the assets stay resident until the
+// file changes, and a later LoadObject at placement time finds them in
+// memory instead of loading each mesh synchronously.
+//
+// Game thread only.
 
 #pragma once
 
 #include "CoreMinimal.h"
 #include "Dom/JsonObject.h"
+#include "UObject/SoftObjectPath.h"
 
 class UEAGENTFORGE_API FPaletteManager
 {
@@ -15,11 +29,23 @@ public:
 	static bool LoadPaletteById(
 		const FString& PaletteId,
 		TSharedPtr<FJsonObject>& OutPalette,
-		FString& OutError);
+		FString& OutError,
+		bool bPreloadAssets = false);
 
 	static bool LoadPaletteFromFile(
 		const FString& AbsoluteFilePath,
 		TSharedPtr<FJsonObject>& OutPalette,
 		FString& OutError);
-};
 
+	/** Fields that describe the palette rather than list asset paths. */
+	static bool IsMetadataField(const FString& FieldName);
+
+	/** "/Game/Trees/Pine_01" -> "/Game/Trees/Pine_01.Pine_01"; full object paths pass through. */
+	static FString ToObjectPath(const FString& AssetPath);
+
+	/** Every asset path listed by the palette's category arrays, deduplicated. */
+	static void GetReferencedAssets(const TSharedPtr<FJsonObject>& Palette, TArray<FSoftObjectPath>& OutAssets);
+
+	/** files, hits, parses, parse_errors, preloads, preload_assets, preloads_pending. */
+	static TSharedPtr<FJsonObject> GetStatsJson();
+};
@@ -80,13 +80,14 @@ public:
 
 private:
 	/** Returns a list of "dark corner" candidate positions in the world.
-	 *  Positions are far from light sources and near walls (evaluated via line traces). */
+	 *  Grid points over the area, snapped to the floor in one batched surface trace. */
 	static TArray<FVector> FindDarkCorners(UWorld* World, const FVector& AreaCentre,
 	                                        float AreaRadius, int32 MaxCandidates);
 
-	/** Returns true if a world position is not in direct line of sight from LevelCentre. */
-	static bool IsOccluded(UWorld* World, const FVector& Position, const FVector& LevelCentre);
+	/** Per position: true if it is not in direct line of sight from LevelCentre. One trace batch. */
+	static void TraceOcclusion(UWorld* World, TArrayView<const FVector> Positions,
+	                           const FVector& LevelCentre, TArray<bool>& OutOccluded);
 
-	/** Estimates darkness at a world position by querying nearby light intensities. */
-	static float EstimateDarknessAt(UWorld* World, const FVector& Position, float SearchRadius);
+	/** Per position: 0-100 darkness score (high = dark) sampled from the cached light grid. */
+	static void EstimateDarkness(UWorld* World, TArrayView<const FVector> Positions, TArray<float>& OutScores);
 };
@@ -26,7 +26,17 @@
  *                                bounds{min,max,size}, density_score, recommendations[]}
  *
  *   get_actors_in_radius     → [{label, class, distance, location}]
- *                              args: x,y,z, radius
+ *                              args: x,y,z, radius, [fields[]], [class], [tag],
+ *                                    [bounds], [limit], [cursor] (AgentForgeActorQuery.h)
+ *
+ *   get_actors_in_box        → [{label, class, location}], nearest the box centre first
+ *                              args: min{x,y,z}, max{x,y,z} + actor query args
+ *
+ *   get_nearest_actors       → [{label, class, distance, location}], k closest
+ *                              args: x,y,z, [k=8], [max_radius=unlimited] + actor query args
+ *
+ * Radius, box and nearest queries are answered from the actor index's spatial
+ * grid (AgentForgeActorIndex.h) rather than a scan of every actor.
  */
 class UEAGENTFORGE_API FSpatialControlModule
 {
@@ -45,4 +55,10 @@ public:
 
 	/** Return all actors within a sphere radius, sorted by distance. */
 	static FString GetActorsInRadius(const TSharedPtr<FJsonObject>& Args);
+
+	/** Return all actors whose location lies inside an axis-aligned box. */
+	static FString GetActorsInBox(const TSharedPtr<FJsonObject>& Args);
+
+	/** Return the k actors closest to a point, sorted by distance. */
+	static FString GetNearestActors(const TSharedPtr<FJsonObject>& Args);
 };
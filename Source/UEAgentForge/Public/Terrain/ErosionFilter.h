@@ -0,0 +1,47 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// ErosionFilter - deterministic particle-based hydraulic erosion.
+//
+// Droplets roll downhill, eroding through a precomputed radial brush and
+// depositing bilinearly where they slow down. The map is split into tiles
+// and each tile owns a fixed share of the droplets. Tiles run on worker
+// threads in four checkerboard phases; a droplet never leaves its tile plus
+// a margin of MaxLifetime + BrushRadius texels, so tiles in the same phase
+// touch disjoint regions. Each tile accumulates into its own buffer and the
+// buffers are merged in tile order after every phase, so the result depends
+// only on the settings and seed, never on the thread count.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct UEAGENTFORGE_API FHydraulicErosionSettings
+{
+	int32 Seed = 0;
+	int32 Droplets = 70000;
+	int32 Batches = 4;                     // rounds over all tiles; later rounds see earlier carving
+	int32 MaxLifetime = 30;                // steps per droplet, one texel each
+	int32 BrushRadius = 3;                 // erosion footprint in texels
+	float Inertia = 0.05f;                 // 0 = follow the gradient, 1 = keep direction
+	float SedimentCapacityFactor = 4.0f;
+	float MinSedimentCapacity = 0.01f;
+	float ErodeSpeed = 0.3f;
+	float DepositSpeed = 0.3f;
+	float EvaporateSpeed = 0.01f;
+	float Gravity = 4.0f;
+	float InitialWater = 1.0f;
+	float InitialSpeed = 1.0f;
+
+	/** Copy clamped to supported ranges. */
+	FHydraulicErosionSettings Sanitized() const;
+};
+
+class UEAGENTFORGE_API FErosionFilter
+{
+public:
+	/** Erode Heightmap in place. Returns the number of droplets simulated. */
+	static int64 ApplyHydraulicErosion(
+		TArray<float>& Heightmap,
+		int32 Width,
+		int32 Height,
+		const FHydraulicErosionSettings& Settings);
+};
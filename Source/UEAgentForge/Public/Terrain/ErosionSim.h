@@ -8,11 +8,17 @@
 class UEAGENTFORGE_API FErosionSim
 {
 public:
-	static void ApplyThermalErosion(
+	/**
+	 * Up to Iterations passes (parallel rows, deterministic). Stops early once the
+	 * material moved in a pass falls below ConvergenceThreshold per cell.
+	 * Returns the number of passes that moved material.
+	 */
+	static int32 ApplyThermalErosion(
 		TArray<float>& Heightmap,
 		int32 Width,
 		int32 Height,
 		int32 Iterations,
 		float TalusThreshold,
-		float SedimentStrength);
+		float SedimentStrength,
+		float ConvergenceThreshold = 1.0e-6f);
 };
@@ -0,0 +1,97 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// Heightmap - move-only heightmap container with selectable storage precision.
+//
+// Float32 is exact and is what noise and erosion write. Float16 and UInt16
+// halve the resident size for maps kept between pipeline stages; UInt16 is
+// the landscape's native format and decodes as Offset + q / 65535 * Scale.
+// Copies must be explicit (Clone); everything else moves.
+//
+// Files are headerless little-endian rows, the format the landscape importer
+// reads: .r16 / .raw hold uint16, .r32 holds float32. Loads map the file and
+// copy it once into the container; no parsing, no intermediate buffers.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class EHeightmapPrecision : uint8
+{
+	Float32,   // 4 bytes per texel
+	Float16,   // 2 bytes, ~3 significant digits
+	UInt16,    // 2 bytes, Offset + q / 65535 * Scale
+};
+
+class UEAGENTFORGE_API FHeightmap
+{
+public:
+	FHeightmap() = default;
+	FHeightmap(int32 InWidth, int32 InHeight, EHeightmapPrecision InPrecision = EHeightmapPrecision::Float32);
+
+	/** Take ownership of Width * Height float values. */
+	FHeightmap(TArray<float>&& InValues, int32 InWidth, int32 InHeight);
+
+	FHeightmap(FHeightmap&& Other);
+	FHeightmap& operator=(FHeightmap&& Other);
+	FHeightmap(const FHeightmap&) = delete;
+	FHeightmap& operator=(const FHeightmap&) = delete;
+
+	FHeightmap Clone() const;
+
+	bool IsValid() const;
+	int32 GetWidth() const { return Width; }
+	int32 GetHeight() const { return Height; }
+	int64 Num() const { return (int64)Width * Height; }
+	EHeightmapPrecision GetPrecision() const { return Precision; }
+	float GetScale() const { return Scale; }
+	float GetOffset() const { return Offset; }
+	SIZE_T GetAllocatedSize() const { return Floats.GetAllocatedSize() + Words.GetAllocatedSize(); }
+
+	float Get(int32 X, int32 Y) const;
+
+	/** Decode row Y into Out (Width floats). */
+	void GetRow(int32 Y, float* Out) const;
+
+	/** Row Y as floats: points into the storage for Float32, otherwise decoded into Scratch. */
+	const float* ReadRow(int32 Y, TArray<float>& Scratch) const;
+
+	void GetRange(float& OutMin, float& OutMax) const;
+
+	/** Float32 storage for in-place edits; re-encodes to Float32 first if stored compactly. */
+	TArray<float>& EditFloats();
+
+	/** Float32 values, moved out when already Float32. Leaves the heightmap empty. */
+	TArray<float> ReleaseFloats();
+
+	/** Raw 16-bit words for Float16 / UInt16 storage, empty otherwise. */
+	const TArray<uint16>& GetWords() const { return Words; }
+
+	/**
+	 * Re-encode in place. UInt16 maps [RangeMin, RangeMax] onto 0..65535; an
+	 * empty range (RangeMin >= RangeMax) uses the current min / max.
+	 */
+	void SetPrecision(EHeightmapPrecision NewPrecision, float RangeMin = 0.0f, float RangeMax = 0.0f);
+
+	/** Write .r16 / .raw (uint16) or .r32 (float32). Values outside Offset..Offset+Scale clamp in .r16. */
+	bool Save(const FString& Path, FString& OutError) const;
+
+	/**
+	 * Memory-mapped load. Width / Height <= 0 infers a square map from the file
+	 * size. .r16 / .raw load as UInt16 with the given Scale / Offset, .r32 as Float32.
+	 */
+	static bool Load(const FString& Path, int32 InWidth, int32 InHeight, FHeightmap& Out, FString& OutError, float InScale = 1.0f, float InOffset = 0.0f);
+
+	/** Parse "float32" | "float16" | "uint16", case-insensitive. */
+	static bool ParsePrecision(const FString& Name, EHeightmapPrecision& OutPrecision);
+	static const TCHAR* PrecisionName(EHeightmapPrecision InPrecision);
+
+private:
+	void Reset();
+
+	int32 Width = 0;
+	int32 Height = 0;
+	EHeightmapPrecision Precision = EHeightmapPrecision::Float32;
+	float Scale = 1.0f;
+	float Offset = 0.0f;
+	TArray<float>  Floats;   // Float32
+	TArray<uint16> Words;    // Float16 / UInt16
+};
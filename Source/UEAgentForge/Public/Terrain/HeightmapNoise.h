@@ -0,0 +1,80 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// HeightmapNoise - deterministic multi-octave gradient noise for heightmaps.
+//
+// fBm, ridged and billow fractals with octaves, lacunarity, gain and optional
+// domain warp. Grids are evaluated row by row with ParallelFor, four texels at
+// a time through the engine's VectorRegister4Float math. Every texel goes
+// through the same vector kernel (Sample included), so results are
+// bit-identical for a given seed regardless of thread count or scheduling.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class EHeightmapNoiseType : uint8
+{
+	Fbm,      // octave sum, roughly [-1, 1]
+	Ridged,   // sharp crests where the base noise crosses zero, [0, 1]
+	Billow,   // folded |noise| for rounded hills, roughly [-1, 1]
+};
+
+struct UEAGENTFORGE_API FHeightmapNoiseSettings
+{
+	EHeightmapNoiseType Type = EHeightmapNoiseType::Fbm;
+	int32 Seed = 0;
+	float Frequency = 0.01f;     // cycles per texel for the first octave
+	float Amplitude = 1.0f;      // output scale; octave sums are normalized first
+	int32 Octaves = 6;
+	float Lacunarity = 2.0f;     // frequency multiplier per octave
+	float Gain = 0.5f;           // amplitude multiplier per octave
+	float WarpStrength = 0.0f;   // domain warp offset in texels, 0 = off
+	float WarpFrequency = 0.0f;  // <= 0 uses Frequency
+
+	/** Copy clamped to supported ranges (1..12 octaves, positive frequency...). */
+	FHeightmapNoiseSettings Sanitized() const;
+
+	/** "fbm" | "ridged" | "billow", case-insensitive. */
+	static bool ParseType(const FString& Name, EHeightmapNoiseType& OutType);
+	static const TCHAR* TypeName(EHeightmapNoiseType Type);
+};
+
+struct FHeightmapNoiseOctave
+{
+	float Frequency = 1.0f;
+	float Amplitude = 1.0f;
+	float OffsetX   = 0.0f;
+	float OffsetY   = 0.0f;
+	int32 Seed      = 0;
+};
+
+/** The octave tables the CPU kernel evaluates, for backends that run the same noise elsewhere (GPU). */
+struct FHeightmapNoiseTables
+{
+	EHeightmapNoiseType           Type = EHeightmapNoiseType::Fbm;
+	TArray<FHeightmapNoiseOctave> Main;
+	TArray<FHeightmapNoiseOctave> WarpX;    // empty when warp is off
+	TArray<FHeightmapNoiseOctave> WarpY;
+	float Normalizer     = 1.0f;
+	float WarpNormalizer = 1.0f;
+	float WarpStrength   = 0.0f;
+	float Amplitude      = 1.0f;
+};
+
+class UEAGENTFORGE_API FHeightmapNoise
+{
+public:
+	/** Sanitize Settings and expand them into per-octave tables. */
+	static void BuildTables(const FHeightmapNoiseSettings& Settings, FHeightmapNoiseTables& Out);
+
+	/**
+	 * Out = noise * Amplitude over a Width x Height grid sampled at texel coordinates
+	 * Origin + (x, y). Tiles of a larger map pass their offset so they line up exactly.
+	 */
+	static void Fill(const FHeightmapNoiseSettings& Settings, int32 Width, int32 Height, TArray<float>& Out, FIntPoint Origin = FIntPoint::ZeroValue);
+
+	/** InOut += noise * Amplitude * Scale. InOut must hold Width * Height values. */
+	static void Accumulate(const FHeightmapNoiseSettings& Settings, int32 Width, int32 Height, float Scale, TArray<float>& InOut, FIntPoint Origin = FIntPoint::ZeroValue);
+
+	/** One sample at texel coordinate (X, Y); matches the grid value at integer coordinates exactly. */
+	static float Sample(const FHeightmapNoiseSettings& Settings, float X, float Y);
+};
@@ -4,6 +4,9 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Terrain/ErosionFilter.h"
+#include "Terrain/Heightmap.h"
+#include "Terrain/HeightmapNoise.h"
 
 class UWorld;
 
@@ -17,6 +20,12 @@ public:
 		float Frequency,
 		float Amplitude);
 
+	/** Multi-octave heightmap; Width / Height are clamped to 2..4096. */
+	static TArray<float> GenerateHeightmap(
+		int32 Width,
+		int32 Height,
+		const FHeightmapNoiseSettings& Noise);
+
 	static void ApplyRidgedNoise(
 		TArray<float>& Heightmap,
 		int32 Width,
@@ -24,18 +33,40 @@ public:
 		int32 Seed,
 		float Strength);
 
-	static void ApplyErosion(
+	/** Heightmap += Strength * noise, normally a ridged fractal. */
+	static void ApplyRidgedNoise(
 		TArray<float>& Heightmap,
 		int32 Width,
 		int32 Height,
-		int32 Iterations,
+		const FHeightmapNoiseSettings& Noise,
 		float Strength);
 
+	/** Thermal erosion. Returns the iterations actually run (early exit on convergence). */
+	static int32 ApplyErosion(
+		TArray<float>& Heightmap,
+		int32 Width,
+		int32 Height,
+		int32 Iterations,
+		float Strength,
+		float ConvergenceThreshold = 1.0e-6f);
+
+	/** Droplet hydraulic erosion. Returns the number of droplets simulated. */
+	static int64 ApplyHydraulicErosion(
+		TArray<float>& Heightmap,
+		int32 Width,
+		int32 Height,
+		const FHydraulicErosionSettings& Settings);
+
 	static void NormalizeHeightmap(
 		TArray<float>& Heightmap,
 		float MinOut = 0.0f,
 		float MaxOut = 1.0f);
 
+	/**
+	 * Import a [0, 1] heightmap as an ALandscape at Origin (height 0 at Origin.Z).
+	 * Scale is cm per texel and the landscape Z scale. Partitioned worlds get one
+	 * streaming proxy per grid region.
+	 */
 	static bool SpawnLandscape(
 		UWorld* World,
 		const TArray<float>& Heightmap,
@@ -44,5 +75,32 @@ public:
 		const FVector& Origin,
 		const FVector& Scale,
 		FString& OutMessage);
+
+	// ─── FHeightmap overloads ───────────────────────────────────────────────
+	// Compact (Float16 / UInt16) maps are edited as Float32 and re-encoded to
+	// their original precision afterwards, so they stay compact between stages.
+
+	static void GenerateHeightmap(
+		int32 Width,
+		int32 Height,
+		const FHeightmapNoiseSettings& Noise,
+		FHeightmap& OutHeightmap);
+
+	static void ApplyRidgedNoise(FHeightmap& Heightmap, const FHeightmapNoiseSettings& Noise, float Strength);
+
+	static int32 ApplyErosion(FHeightmap& Heightmap, int32 Iterations, float Strength, float ConvergenceThreshold = 1.0e-6f);
+
+	static int64 ApplyHydraulicErosion(FHeightmap& Heightmap, const FHydraulicErosionSettings& Settings);
+
+	/** UInt16 maps keep [MinOut, MaxOut] as their encoded range. */
+	static void NormalizeHeightmap(FHeightmap& Heightmap, float MinOut = 0.0f, float MaxOut = 1.0f);
+
+	/** Rows of compact maps are decoded one at a time while quantizing. */
+	static bool SpawnLandscape(
+		UWorld* World,
+		const FHeightmap& Heightmap,
+		const FVector& Origin,
+		const FVector& Scale,
+		FString& OutMessage);
 };
 
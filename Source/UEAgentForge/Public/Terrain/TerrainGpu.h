@@ -0,0 +1,98 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// TerrainGpu - optional RDG compute backend for the op_terrain_generate pipeline.
+//
+// Runs noise, ridge blend, hydraulic and thermal erosion as compute passes on a
+// structured-buffer heightmap, then copies the result back once through an
+// async GPU readback. FTerrainGpuRun::Poll checks that readback on the render
+// thread and returns at once, so a job stage can yield until it lands.
+// Shaders live in the UEAgentForgeShaders module (Shaders/Private/TerrainNoise.usf,
+// TerrainErosion.usf).
+//
+// The GPU path matches the CPU algorithms but not bit for bit: noise differs by
+// float rounding, and hydraulic droplets in a batch read the heights from before
+// the batch. Thermal erosion runs every requested iteration (no convergence
+// check, which would need a readback per pass).
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Terrain/ErosionFilter.h"
+#include "Terrain/HeightmapNoise.h"
+
+struct FTerrainReadbackState;
+
+struct FTerrainGpuJob
+{
+	int32 Width = 257;
+	int32 Height = 257;
+
+	FHeightmapNoiseSettings BaseNoise;
+	FHeightmapNoiseSettings RidgeNoise;
+	float RidgeStrength = 0.0f;
+
+	bool                      bHydraulic = false;
+	FHydraulicErosionSettings Hydraulic;
+
+	bool  bThermal = false;
+	int32 ThermalIterations = 0;
+	float ThermalStrength = 0.0f;   // as FTerrainGenerator::ApplyErosion
+};
+
+struct FTerrainGpuStats
+{
+	double GpuMs = 0.0;             // submit to the poll that saw the readback complete
+	int64  DropletsSimulated = 0;
+	int32  ThermalIterations = 0;
+	int32  HydraulicBatches = 0;
+};
+
+class UEAGENTFORGE_API FTerrainGpu
+{
+public:
+	static constexpr int32 MaxResolution = 8192;
+
+	/** SM5 RHI with the terrain shaders compiled. OutReason explains a false result. */
+	static bool IsAvailable(FString* OutReason = nullptr);
+
+	/** Submit the job and poll it until the heightmap is back (game thread; no flush or sleep). */
+	static bool Run(const FTerrainGpuJob& Job, TArray<float>& OutHeightmap, FTerrainGpuStats& OutStats, FString& OutError);
+};
+
+/** One GPU terrain job in flight. Game thread only. */
+class UEAGENTFORGE_API FTerrainGpuRun
+{
+public:
+	enum class EStatus : uint8
+	{
+		Pending,
+		Succeeded,
+		Failed,
+	};
+
+	FTerrainGpuRun() = default;
+	~FTerrainGpuRun();
+
+	FTerrainGpuRun(const FTerrainGpuRun&) = delete;
+	FTerrainGpuRun& operator=(const FTerrainGpuRun&) = delete;
+
+	/** Queue the passes and the readback. False with OutError if the GPU cannot run Job. */
+	bool Submit(const FTerrainGpuJob& Job, FString& OutError);
+
+	/** Advance without blocking. Pending means call again later (next job slice). */
+	EStatus Poll();
+
+	TArray<float>&          GetHeightmap() { return Heightmap; }
+	const FTerrainGpuStats& GetStats() const { return Stats; }
+	const FString&          GetError() const { return Error; }
+
+private:
+	void ReleaseReadback();
+
+	TSharedPtr<FTerrainReadbackState, ESPMode::ThreadSafe> State;
+	TArray<float>    Heightmap;
+	FTerrainGpuStats Stats;
+	uint32           TexelCount = 0;
+	double           StartSeconds = 0.0;
+	EStatus          Status = EStatus::Failed;   // until Submit
+	FString          Error;
+};
@@ -0,0 +1,38 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// TerrainTileCache - disk-backed storage for heightmap tiles.
+//
+// One file per tile: the "AFT1" magic, int32 width, int32 height, then
+// width * height little-endian float32 heights, row-major. Rectangles can be
+// read without loading the whole tile, so stitching only touches the overlap
+// strips of neighbouring tiles.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UEAGENTFORGE_API FTerrainTileCache
+{
+public:
+	explicit FTerrainTileCache(const FString& InDirectory);
+
+	/** Saved/AgentForge/TerrainTiles/ */
+	static FString DefaultRoot();
+
+	/** "<Prefix>_<TX>_<TY>.r32" */
+	static FString TileName(const TCHAR* Prefix, int32 TileX, int32 TileY);
+
+	const FString& GetDirectory() const { return Directory; }
+	FString GetPath(const FString& Name) const;
+
+	bool WriteTile(const FString& Name, int32 Width, int32 Height, const TArray<float>& Heights) const;
+	bool ReadTile(const FString& Name, int32& OutWidth, int32& OutHeight, TArray<float>& OutHeights) const;
+
+	/** Read the Size rectangle at Min (tile-local texels) into OutHeights, row-major. */
+	bool ReadRect(const FString& Name, FIntPoint Min, FIntPoint Size, TArray<float>& OutHeights) const;
+
+	bool Exists(const FString& Name) const;
+	void Delete(const FString& Name) const;
+
+private:
+	FString Directory;
+};
@@ -0,0 +1,70 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// TiledTerrainGenerator - streamed terrain generation for maps beyond one buffer.
+//
+// The map is cut into square tiles. Each tile is generated on a padded rect
+// (core + halo) so noise lines up exactly across tiles and erosion near the
+// core edge sees real terrain instead of a border. The halo covers the reach
+// of a droplet (MaxLifetime + BrushRadius) or of thermal flow (one texel per
+// iteration), plus a blend band. Neighbouring tiles erode the blend band
+// independently; the stitch pass cross-fades them with tent weights that sum
+// to one, so there is no seam. Tiles are processed in parallel waves and
+// written to an FTerrainTileCache; only a wave of padded tiles is in memory.
+//
+// Heights are stored raw (un-normalized). The manifest records the global
+// min / max so readers can normalize without a second pass over the tiles.
+// Output depends only on the settings: the same request hits the cache.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Terrain/ErosionFilter.h"
+#include "Terrain/HeightmapNoise.h"
+
+struct FTiledTerrainSettings
+{
+	int32 Width = 8192;
+	int32 Height = 8192;
+	int32 TileSize = 1024;            // core texels per side, 256..4096
+	int32 Blend = 32;                 // cross-fade half width, <= TileSize / 4
+
+	FHeightmapNoiseSettings BaseNoise;
+	FHeightmapNoiseSettings RidgeNoise;
+	float RidgeStrength = 0.0f;
+
+	bool                      bHydraulic = false;
+	FHydraulicErosionSettings Hydraulic;   // Droplets is the budget for the whole map
+
+	bool  bThermal = false;
+	int32 ThermalIterations = 0;      // run in full on every tile (no early exit)
+	float ThermalStrength = 0.0f;     // as FTerrainGenerator::ApplyErosion
+
+	FString CacheRoot;                // empty = FTerrainTileCache::DefaultRoot()
+};
+
+struct FTiledTerrainResult
+{
+	FString CacheDirectory;
+	FString ManifestPath;
+	FString Key;
+	int32 TilesX = 0;
+	int32 TilesY = 0;
+	int32 TileSize = 0;
+	int32 Halo = 0;
+	int32 Blend = 0;
+	float RawMin = 0.0f;
+	float RawMax = 0.0f;
+	float RawAvg = 0.0f;
+	bool  bCacheHit = false;
+	double GenerateMs = 0.0;          // noise + erosion on padded tiles
+	double StitchMs = 0.0;
+	int64 DropletsSimulated = 0;
+};
+
+class UEAGENTFORGE_API FTiledTerrainGenerator
+{
+public:
+	static constexpr int32 MaxResolution = 32768;
+
+	/** Generate (or find in the cache) the tiled map. Tiles are "tile_<x>_<y>.r32" in CacheDirectory. */
+	static bool Generate(const FTiledTerrainSettings& Settings, FTiledTerrainResult& OutResult, FString& OutError);
+};
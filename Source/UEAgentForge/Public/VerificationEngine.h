@@ -1,6 +1,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Dom/JsonObject.h"   // explicit with NoPCHs
 #include "UObject/NoExportTypes.h"
 #include "VerificationEngine.generated.h"
 
@@ -18,6 +19,18 @@ enum class EVerificationPhase : uint8
 	All         = 0x0F,  // All phases
 };
 
+/**
+ * What the Snapshot+Rollback phase inspects.
+ *   Scoped  only the actors the command spawned, deleted or modified, recorded
+ *           from editor events while it runs (default)
+ *   Full    every actor in the level, plus a world snapshot file
+ */
+enum class EVerificationRollbackScope : uint8
+{
+	Scoped,
+	Full,
+};
+
 /**
  * Result from a single verification phase.
  */
@@ -40,10 +53,11 @@ struct UEAGENTFORGE_API FVerificationPhaseResult
  *   - Serialize pre-state (actor transforms, properties) for later comparison
  *
  * Phase 2 (Snapshot + Rollback Test):
- *   - Create named snapshot of current level state
- *   - Execute the command in a sub-transaction
+ *   - Create named snapshot of current level state (Full scope only)
+ *   - Execute the command in a sub-transaction, recording the actors it touches (Scoped)
  *   - Inject a simulated failure → undo the sub-transaction
- *   - Verify level state exactly matches the pre-snapshot (byte-level actor count + labels)
+ *   - Scoped: spawned actors are gone, deleted ones are back, modified ones are reverted
+ *   - Full: level state exactly matches the pre-snapshot (byte-level actor count + labels)
  *   - Re-execute the command for real
  *
  * Phase 3 (PostVerify):
@@ -52,9 +66,9 @@ struct UEAGENTFORGE_API FVerificationPhaseResult
  *   - Flag unexpected side-effects
  *
  * Phase 4 (BuildCheck):
- *   - Iterate all dirty Blueprints and attempt compilation
+ *   - Iterate loaded Blueprints that are dirty or in error and compile the dirty ones
  *   - Collect compilation errors
- *   - On error: undo the transaction and report
+ *   - The result is cached by the set of candidates; an unchanged set reuses it
  */
 UCLASS(NotBlueprintable)
 class UEAGENTFORGE_API UVerificationEngine : public UObject
@@ -89,15 +103,33 @@ public:
 	/** Phase 3: Post-execution state comparison against pre-state. */
 	FVerificationPhaseResult RunPostVerify(int32 ExpectedActorDelta = 0);
 
-	/** Phase 4: Compile all dirty Blueprints and check for errors. */
+	/**
+	 * Phase 4: Compile dirty loaded Blueprints and check for errors. When the
+	 * dirty/error set is unchanged since the last check, the cached result is
+	 * returned without compiling.
+	 */
 	FVerificationPhaseResult RunBuildCheck();
 
-	/** Create a JSON snapshot of all actors in the current level. Returns snapshot file path. */
-	FString CreateSnapshot(const FString& SnapshotName);
+	/**
+	 * Snapshot all actors in the current level (see FAgentForgeWorldSnapshot).
+	 * Returns the .afsnap path; the file is written in the background.
+	 * bExportJson also writes the JSON form next to it.
+	 */
+	FString CreateSnapshot(const FString& SnapshotName, bool bExportJson = false);
 
-	/** Compare two snapshots and return a human-readable diff summary. */
+	/** Compare two snapshots (.afsnap or .json) and return a human-readable diff summary. */
 	FString DiffSnapshots(const FString& SnapshotPathA, const FString& SnapshotPathB);
 
+	EVerificationRollbackScope GetRollbackScope() const { return RollbackScope; }
+	void SetRollbackScope(EVerificationRollbackScope Scope) { RollbackScope = Scope; }
+
+	/** "scoped" | "full", case-insensitive. */
+	static bool ParseRollbackScope(const FString& Name, EVerificationRollbackScope& OutScope);
+	static const TCHAR* RollbackScopeName(EVerificationRollbackScope Scope);
+
+	/** rollback_scope, rollback_tests, scoped_fallbacks, last_touched_actors, build_checks, build_check_cache_hits. */
+	TSharedPtr<FJsonObject> GetStatsJson() const;
+
 	/** Record the last verification run result (JSON). */
 	FString LastVerificationResult;
 
@@ -107,5 +139,16 @@ private:
 	TArray<FString> PreStateActorPaths;
 	int32           PreStateActorCount = 0;
 
+	EVerificationRollbackScope RollbackScope = EVerificationRollbackScope::Scoped;
+	int32 RollbackTests = 0;
+	int32 ScopedFallbacks = 0;      // scoped tests that fell back to a full actor scan
+	int32 LastTouchedActors = 0;
+
+	int32  BuildChecks = 0;
+	int32  BuildCheckCacheHits = 0;
+	uint32 CachedBuildCheckKey = 0;
+	bool   bHasCachedBuildCheck = false;
+	FVerificationPhaseResult CachedBuildCheck;
+
 	static UVerificationEngine* Singleton;
 };
@@ -1,25 +1,150 @@
 // Copyright UEAgentForge Project. All Rights Reserved.
-// SceneCapture - visual scoring and capture scaffolding.
+// SceneCapture - multi-camera scene capture and visual scoring helpers.
+//
+// FSceneCaptureRun renders one SceneCapture2D pass per camera transform
+// into pooled render targets. All passes of a batch are queued before any
+// readback, and each target gets an FRHIGPUTextureReadback copy. Poll never
+// waits on the GPU: it queues the next batch or a render-thread check of the
+// batch's readback fences, then returns, so a job stage can yield between
+// calls. PNG encoding and file writes run on worker threads. The editor
+// viewport is never moved.
+//
+// CaptureSceneImages and CaptureScenePixels are the inline forms: they call
+// Poll until the run settles, without flushing rendering or sleeping.
 
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "UObject/GCObject.h"
+#include "UObject/ObjectPtr.h"
+#include "UObject/WeakObjectPtr.h"
 
 class UWorld;
+class USceneCaptureComponent2D;
+struct FSceneCaptureReadbackState;
+
+struct UEAGENTFORGE_API FSceneCaptureSettings
+{
+	int32   Width = 1280;
+	int32   Height = 720;
+	float   FOVDegrees = 90.0f;
+	FString BaseName = TEXT("capture");   // files are <BaseName>_<timestamp>_<index>.png
+};
+
+struct UEAGENTFORGE_API FSceneCaptureImage
+{
+	TArray<FColor> Pixels;   // BGRA8, row-major, Size.X * Size.Y
+	FIntPoint      Size = FIntPoint::ZeroValue;
+};
+
+/** One capture in flight. Game thread only; keep it alive until Poll settles. */
+class UEAGENTFORGE_API FSceneCaptureRun : public FGCObject
+{
+public:
+	enum class EStatus : uint8
+	{
+		Pending,
+		Succeeded,
+		Failed,
+	};
+
+	/** Keeps the pixels in memory (alpha is left as rendered). */
+	FSceneCaptureRun(UWorld* World, const TArray<FTransform>& CameraTransforms, const FSceneCaptureSettings& Settings);
+	/** Writes each view to OutputDirectory as <BaseName>_<timestamp>_<index>.png. */
+	FSceneCaptureRun(UWorld* World, const TArray<FTransform>& CameraTransforms, const FString& OutputDirectory, const FSceneCaptureSettings& Settings);
+	~FSceneCaptureRun();
+
+	FSceneCaptureRun(const FSceneCaptureRun&) = delete;
+	FSceneCaptureRun& operator=(const FSceneCaptureRun&) = delete;
+
+	/** Advance without blocking. Pending means call again later (next job slice). */
+	EStatus Poll();
+
+	/** Fraction [0,1] of views read back. */
+	float GetProgress() const;
+	const FString& GetError() const { return Error; }
+
+	/** In CameraTransforms order, once Poll has succeeded. */
+	TArray<FSceneCaptureImage>& GetImages() { return Images; }
+	const TArray<FString>&      GetImagePaths() const { return ImagePaths; }
+
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+	virtual FString GetReferencerName() const override;
+
+private:
+	void Start(UWorld* InWorld, const TArray<FTransform>& CameraTransforms, const FSceneCaptureSettings& InSettings);
+	void RenderNextBatch();
+	void QueueFenceCheck();
+	void ReleaseBatch();
+	void ReleaseCapture();
+	void DeliverView(int32 View, TArray<FColor>&& Pixels);
+	EStatus Fail(const FString& Message);
+
+	TWeakObjectPtr<UWorld>                           World;
+	TObjectPtr<USceneCaptureComponent2D>             Capture;   // referenced here so GC keeps it between slices
+	TArray<FTransform>                               Cameras;
+	FIntPoint                                        Size = FIntPoint::ZeroValue;
+	FString                                          OutputDirectory;   // empty: keep pixels
+	FString                                          FilePrefix;
+	TSharedPtr<FSceneCaptureReadbackState, ESPMode::ThreadSafe> Batch;   // batch in flight
+	int32                                            NextView = 0;      // first view not yet rendered
+	int32                                            ViewsRead = 0;
+	double                                           StartSeconds = 0.0;
+	TArray<FSceneCaptureImage>                       Images;
+	TArray<FString>                                  ImagePaths;
+	TArray<TFuture<bool>>                            Encoders;
+	EStatus                                          Status = EStatus::Pending;
+	FString                                          Error;
+};
 
 class UEAGENTFORGE_API FSceneCapture
 {
 public:
+	/** Largest capture edge in texels. */
+	static constexpr int32 MaxResolution = 4096;
+
+	static bool CaptureSceneImages(
+		UWorld* World,
+		const TArray<FTransform>& CameraTransforms,
+		const FString& OutputDirectory,
+		TArray<FString>& OutImagePaths,
+		FString& OutError);
+
+	/** OutImagePaths is in CameraTransforms order. Game thread only. */
 	static bool CaptureSceneImages(
 		UWorld* World,
 		const TArray<FTransform>& CameraTransforms,
 		const FString& OutputDirectory,
+		const FSceneCaptureSettings& Settings,
 		TArray<FString>& OutImagePaths,
 		FString& OutError);
 
+	/** Same batched render and readback, but the pixels stay in memory (alpha is left as rendered). */
+	static bool CaptureScenePixels(
+		UWorld* World,
+		const TArray<FTransform>& CameraTransforms,
+		const FSceneCaptureSettings& Settings,
+		TArray<FSceneCaptureImage>& OutImages,
+		FString& OutError);
+
 	static float ComputeCompositionScore(const TArray<float>& Metrics);
 	static float ComputeDensityScore(int32 ActorCount, float BoundsAreaM2);
 	static float ComputeSceneComplexity(int32 ActorCount, int32 ComponentCount, float DrawCalls);
+	/** Cosine similarity clamped to [0, 1]; four lanes per vector op. */
 	static float ComputeImageSimilarity(const TArray<float>& FeaturesA, const TArray<float>& FeaturesB);
+
+	/** Edge of the luminance grid produced by ComputeImageFeatures. */
+	static constexpr int32 FeatureGridSize = 32;
+
+	/**
+	 * Perceptual features: the frame box-filtered to a FeatureGridSize^2
+	 * luminance grid, mean-centred, so that ComputeImageSimilarity on two
+	 * feature sets is their correlation and ignores uniform exposure shifts.
+	 */
+	static void ComputeImageFeatures(const TArray<FColor>& Pixels, const FIntPoint& Size, TArray<float>& OutFeatures);
+
+	/** 64-bit average hash of the features (8x8 block means above zero); a cheap prefilter for similarity. */
+	static uint64 ComputePerceptualHash(const TArray<float>& Features);
 };
 
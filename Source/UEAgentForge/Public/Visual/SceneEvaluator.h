@@ -36,6 +36,11 @@ public:
 		const TArray<FVector>& Points,
 		const FBox& Bounds);
 
+	/**
+	 * All four metrics in one binning pass (10x10 density grid, 12x12
+	 * empty-space grid at a 0.28 target, quadrants) plus one nearest-neighbour
+	 * query per point through FPointSpatialIndex. O(N) in the point count.
+	 */
 	static FSceneEvaluationMetrics EvaluateScene(
 		const TArray<FVector>& Points,
 		const FBox& Bounds,
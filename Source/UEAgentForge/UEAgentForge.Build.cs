@@ -18,6 +18,13 @@ public class UEAgentForge : ModuleRules
 			"EditorSubsystem",
 			"Projects",               // IPluginManager runtime plugin capability scan
 			"LevelEditor",
+			"TraceLog",               // AgentForge Insights trace channel
+
+			// Forge Tools editor UI (performance dashboard tab)
+			"Slate",
+			"SlateCore",
+			"InputCore",
+			"WorkspaceMenuStructure", // Tools > Debug tab group
 
 			// JSON transport (Remote Control API payload format)
 			"Json",
@@ -26,6 +33,7 @@ public class UEAgentForge : ModuleRules
 			// Asset management
 			"AssetRegistry",
 			"AssetTools",             // rename_asset, move_asset, delete_asset
+			"DirectoryWatcher",       // preset store: picks up edited preset files without rescanning
 			// ObjectTools is part of UnrealEd — no separate module in UE 5.7
 
 			// Screenshot capture
@@ -33,6 +41,9 @@ public class UEAgentForge : ModuleRules
 			"RenderCore",
 			"Renderer",
 
+			// GPU terrain backend (RDG compute shaders registered at PostConfigInit)
+			"UEAgentForgeShaders",
+
 			// Blueprint graph manipulation
 			"Kismet",                 // FKismetEditorUtilities::CompileBlueprint
 			"KismetCompiler",         // blueprint compilation pipeline
@@ -43,6 +54,13 @@ public class UEAgentForge : ModuleRules
 			// Material instancing
 			// (covered by Engine + UnrealEd)
 
+			// Terrain landscape import (ALandscape::Import, World Partition grid split)
+			"Landscape",
+
+			// Merged blockout geometry (create_room / create_corridor output:"merged")
+			"GeometryCore",           // FDynamicMesh3
+			"GeometryFramework",      // UDynamicMeshComponent
+
 			// Spatial awareness
 			"NavigationSystem",       // query_navmesh
 
@@ -57,6 +75,7 @@ public class UEAgentForge : ModuleRules
 
 			// v0.2.0 FAB integration — HTTP requests + audio/sound factory
 			"HTTP",                   // FHttpModule, IHttpRequest, FGenericPlatformHttp::UrlEncode
+			"WebSocketNetworking",    // Optional persistent socket transport (AgentForgeSocketServer)
 			"AudioEditor",            // USoundFactory (WAV import in FabIntegrationModule)
 		});
 	}
@@ -0,0 +1,44 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeTerrainShaders.cpp - global shader registration for terrain compute passes.
+
+#include "AgentForgeTerrainShaders.h"
+
+#include "DataDrivenShaderPlatformInfo.h"
+
+namespace
+{
+	static bool ShouldCompileTerrainShader(const FGlobalShaderPermutationParameters& Parameters)
+	{
+		return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
+	}
+
+	static void SetGroupSize(FShaderCompilerEnvironment& OutEnvironment, int32 GroupSize)
+	{
+		OutEnvironment.SetDefine(TEXT("THREADGROUP_SIZE"), GroupSize);
+	}
+}
+
+#define AGENTFORGE_TERRAIN_SHADER(ShaderClass, GroupSize) \
+	bool ShaderClass::ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters) \
+	{ \
+		return ShouldCompileTerrainShader(Parameters); \
+	} \
+	void ShaderClass::ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment) \
+	{ \
+		FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment); \
+		SetGroupSize(OutEnvironment, GroupSize); \
+	}
+
+AGENTFORGE_TERRAIN_SHADER(FAgentForgeTerrainNoiseCS,     AgentForgeTerrainShaders::GroupSize2D)
+AGENTFORGE_TERRAIN_SHADER(FAgentForgeThermalOutflowCS,   AgentForgeTerrainShaders::GroupSize2D)
+AGENTFORGE_TERRAIN_SHADER(FAgentForgeThermalApplyCS,     AgentForgeTerrainShaders::GroupSize2D)
+AGENTFORGE_TERRAIN_SHADER(FAgentForgeHydraulicDropletCS, AgentForgeTerrainShaders::DropletGroupSize)
+AGENTFORGE_TERRAIN_SHADER(FAgentForgeHydraulicMergeCS,   AgentForgeTerrainShaders::GroupSize2D)
+
+#undef AGENTFORGE_TERRAIN_SHADER
+
+IMPLEMENT_GLOBAL_SHADER(FAgentForgeTerrainNoiseCS,     "/UEAgentForgeShaders/Private/TerrainNoise.usf",   "MainCS",             SF_Compute);
+IMPLEMENT_GLOBAL_SHADER(FAgentForgeThermalOutflowCS,   "/UEAgentForgeShaders/Private/TerrainErosion.usf", "ThermalOutflowCS",   SF_Compute);
+IMPLEMENT_GLOBAL_SHADER(FAgentForgeThermalApplyCS,     "/UEAgentForgeShaders/Private/TerrainErosion.usf", "ThermalApplyCS",     SF_Compute);
+IMPLEMENT_GLOBAL_SHADER(FAgentForgeHydraulicDropletCS, "/UEAgentForgeShaders/Private/TerrainErosion.usf", "HydraulicDropletCS", SF_Compute);
+IMPLEMENT_GLOBAL_SHADER(FAgentForgeHydraulicMergeCS,   "/UEAgentForgeShaders/Private/TerrainErosion.usf", "HydraulicMergeCS",   SF_Compute);
@@ -0,0 +1,27 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// UEAgentForgeShaders.cpp - maps the plugin's Shaders/ directory for global compute shaders.
+
+#include "Modules/ModuleManager.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/Paths.h"
+#include "ShaderCore.h"
+
+class FUEAgentForgeShadersModule : public IModuleInterface
+{
+public:
+	virtual void StartupModule() override
+	{
+		const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("UEAgentForge"));
+		if (!Plugin.IsValid())
+		{
+			return;
+		}
+		const FString VirtualPath = TEXT("/UEAgentForgeShaders");
+		if (!AllShaderSourceDirectoryMappings().Contains(VirtualPath))
+		{
+			AddShaderSourceDirectoryMapping(VirtualPath, FPaths::Combine(Plugin->GetBaseDir(), TEXT("Shaders")));
+		}
+	}
+};
+
+IMPLEMENT_MODULE(FUEAgentForgeShadersModule, UEAgentForgeShaders)
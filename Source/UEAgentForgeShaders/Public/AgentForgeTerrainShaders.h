@@ -0,0 +1,139 @@
+// Copyright UEAgentForge Project. All Rights Reserved.
+// AgentForgeTerrainShaders - RDG compute shaders for heightmap noise and erosion.
+//
+// Heightmaps live in a structured float buffer (row-major, Size.x * Size.y).
+// Dispatch lives in the editor module (Terrain/TerrainGpu); this module only
+// declares the shader types so they register at PostConfigInit.
+//
+//   FAgentForgeTerrainNoiseCS        fBm / ridged / billow with domain warp, write or accumulate
+//   FAgentForgeThermalOutflowCS      per-cell outflow toward the steepest lower neighbour
+//   FAgentForgeThermalApplyCS        gather inflow, subtract outflow (in place)
+//   FAgentForgeHydraulicDropletCS    one droplet per thread, fixed-point atomic erosion deltas
+//   FAgentForgeHydraulicMergeCS      fold the deltas into the heightmap and clear them
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GlobalShader.h"
+#include "ShaderParameterStruct.h"
+#include "RenderGraphResources.h"
+
+namespace AgentForgeTerrainShaders
+{
+	static constexpr int32 GroupSize2D      = 8;
+	static constexpr int32 DropletGroupSize = 64;
+
+	/** Erosion deltas are accumulated as int32 * 2^-20 so atomic adds stay order-independent. */
+	static constexpr float FixedPointScale = 1048576.0f;
+}
+
+class UEAGENTFORGESHADERS_API FAgentForgeTerrainNoiseCS : public FGlobalShader
+{
+public:
+	DECLARE_GLOBAL_SHADER(FAgentForgeTerrainNoiseCS);
+	SHADER_USE_PARAMETER_STRUCT(FAgentForgeTerrainNoiseCS, FGlobalShader);
+
+	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+		SHADER_PARAMETER(FIntPoint, Size)
+		SHADER_PARAMETER(uint32, NoiseType)          // EHeightmapNoiseType
+		SHADER_PARAMETER(uint32, NumOctaves)
+		SHADER_PARAMETER(uint32, NumWarpOctaves)     // per axis; WarpX follows Main, WarpY follows WarpX
+		SHADER_PARAMETER(float, Normalizer)
+		SHADER_PARAMETER(float, WarpNormalizer)
+		SHADER_PARAMETER(float, WarpStrength)
+		SHADER_PARAMETER(float, OutputScale)          // amplitude * blend strength
+		SHADER_PARAMETER(uint32, bAccumulate)
+		SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float4>, Octaves)     // frequency, amplitude, offset x, offset y
+		SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<int>, OctaveSeeds)
+		SHADER_PARAMETER_RDG_BUFFER_UAV(RWStructuredBuffer<float>, RWHeights)
+	END_SHADER_PARAMETER_STRUCT()
+
+	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters);
+	static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment);
+};
+
+class UEAGENTFORGESHADERS_API FAgentForgeThermalOutflowCS : public FGlobalShader
+{
+public:
+	DECLARE_GLOBAL_SHADER(FAgentForgeThermalOutflowCS);
+	SHADER_USE_PARAMETER_STRUCT(FAgentForgeThermalOutflowCS, FGlobalShader);
+
+	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+		SHADER_PARAMETER(FIntPoint, Size)
+		SHADER_PARAMETER(float, Talus)
+		SHADER_PARAMETER(float, Transfer)
+		SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float>, HeightsIn)
+		SHADER_PARAMETER_RDG_BUFFER_UAV(RWStructuredBuffer<float>, RWOutflow)
+		SHADER_PARAMETER_RDG_BUFFER_UAV(RWStructuredBuffer<int>, RWTarget)
+	END_SHADER_PARAMETER_STRUCT()
+
+	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters);
+	static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment);
+};
+
+class UEAGENTFORGESHADERS_API FAgentForgeThermalApplyCS : public FGlobalShader
+{
+public:
+	DECLARE_GLOBAL_SHADER(FAgentForgeThermalApplyCS);
+	SHADER_USE_PARAMETER_STRUCT(FAgentForgeThermalApplyCS, FGlobalShader);
+
+	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+		SHADER_PARAMETER(FIntPoint, Size)
+		SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float>, OutflowIn)
+		SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<int>, TargetIn)
+		SHADER_PARAMETER_RDG_BUFFER_UAV(RWStructuredBuffer<float>, RWHeights)
+	END_SHADER_PARAMETER_STRUCT()
+
+	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters);
+	static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment);
+};
+
+class UEAGENTFORGESHADERS_API FAgentForgeHydraulicDropletCS : public FGlobalShader
+{
+public:
+	DECLARE_GLOBAL_SHADER(FAgentForgeHydraulicDropletCS);
+	SHADER_USE_PARAMETER_STRUCT(FAgentForgeHydraulicDropletCS, FGlobalShader);
+
+	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+		SHADER_PARAMETER(FIntPoint, Size)
+		SHADER_PARAMETER(uint32, Seed)
+		SHADER_PARAMETER(uint32, DropletBase)        // global index of this batch's first droplet
+		SHADER_PARAMETER(uint32, DropletCount)
+		SHADER_PARAMETER(uint32, MaxLifetime)
+		SHADER_PARAMETER(int32, BrushRadius)
+		SHADER_PARAMETER(uint32, NumBrushTaps)
+		SHADER_PARAMETER(float, Inertia)
+		SHADER_PARAMETER(float, SedimentCapacityFactor)
+		SHADER_PARAMETER(float, MinSedimentCapacity)
+		SHADER_PARAMETER(float, ErodeSpeed)
+		SHADER_PARAMETER(float, DepositSpeed)
+		SHADER_PARAMETER(float, EvaporateSpeed)
+		SHADER_PARAMETER(float, Gravity)
+		SHADER_PARAMETER(float, InitialWater)
+		SHADER_PARAMETER(float, InitialSpeed)
+		SHADER_PARAMETER(float, FixedScale)
+		SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float>, HeightsIn)
+		SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float4>, BrushTaps)   // dx, dy, weight, unused
+		SHADER_PARAMETER_RDG_BUFFER_UAV(RWStructuredBuffer<int>, RWDelta)
+	END_SHADER_PARAMETER_STRUCT()
+
+	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters);
+	static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment);
+};
+
+class UEAGENTFORGESHADERS_API FAgentForgeHydraulicMergeCS : public FGlobalShader
+{
+public:
+	DECLARE_GLOBAL_SHADER(FAgentForgeHydraulicMergeCS);
+	SHADER_USE_PARAMETER_STRUCT(FAgentForgeHydraulicMergeCS, FGlobalShader);
+
+	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+		SHADER_PARAMETER(FIntPoint, Size)
+		SHADER_PARAMETER(float, FixedScale)
+		SHADER_PARAMETER_RDG_BUFFER_UAV(RWStructuredBuffer<float>, RWHeights)
+		SHADER_PARAMETER_RDG_BUFFER_UAV(RWStructuredBuffer<int>, RWDelta)
+	END_SHADER_PARAMETER_STRUCT()
+
+	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters);
+	static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment);
+};
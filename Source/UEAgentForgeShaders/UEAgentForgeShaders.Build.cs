@@ -0,0 +1,23 @@
+using UnrealBuildTool;
+
+public class UEAgentForgeShaders : ModuleRules
+{
+	public UEAgentForgeShaders(ReadOnlyTargetRules Target) : base(Target)
+	{
+		// Global shader types must register before the shader map is built, so this
+		// module loads at PostConfigInit, ahead of the editor module that dispatches them.
+		PCHUsage = PCHUsageMode.NoPCHs;
+
+		PrivateDependencyModuleNames.AddRange(new string[]
+		{
+			"Core",
+			"Projects",               // IPluginManager, for the Shaders/ directory mapping
+		});
+
+		PublicDependencyModuleNames.AddRange(new string[]
+		{
+			"RenderCore",             // FGlobalShader, RDG parameter structs
+			"RHI",
+		});
+	}
+}